@@ -10,14 +10,17 @@ include($$ROOT_DIR/common.pri)
 SOURCES += \
     base.cpp \
     bwt.cpp \
+    cache_registry.cpp \
     condition.cpp \
     deferred_task.cpp \
     exception.cpp \
     gmtime.cpp \
     internal/message.cpp \
     levenshtein_dfa.cpp \
+    levenshtein_dfa_cache.cpp \
     logging.cpp \
     lower_case.cpp \
+    memory_counters.cpp \
     move_to_front.cpp \
     normalize_unicode.cpp \
     pprof.cpp \
@@ -29,13 +32,16 @@ SOURCES += \
     strings_bundle.cpp \
     suffix_array.cpp \
     sunrise_sunset.cpp \
+    task_executor.cpp \
     thread.cpp \
     thread_checker.cpp \
     thread_pool.cpp \
     threaded_container.cpp \
     timegm.cpp \
     timer.cpp \
+    tracing.cpp \
     uni_string_dfa.cpp \
+    work_stealing_thread_pool.cpp \
     worker_thread.cpp \
 
 HEADERS += \
@@ -47,9 +53,11 @@ HEADERS += \
     buffer_vector.hpp \
     bwt.hpp \
     cache.hpp \
+    cache_registry.hpp \
     cancellable.hpp \
     checked_cast.hpp \
     collection_cast.hpp \
+    concurrent_lru_cache.hpp \
     condition.hpp \
     deferred_task.hpp \
     dfa_helpers.hpp \
@@ -58,15 +66,18 @@ HEADERS += \
     gmtime.hpp \
     internal/message.hpp \
     levenshtein_dfa.hpp \
+    levenshtein_dfa_cache.hpp \
     limited_priority_queue.hpp \
     logging.hpp \
     macros.hpp \
     math.hpp \
     matrix.hpp \
     mem_trie.hpp \
+    memory_counters.hpp \
     move_to_front.hpp \
     mutex.hpp \
     newtype.hpp \
+    object_arena.hpp \
     observer_list.hpp \
     pprof.hpp \
     random.hpp \
@@ -89,6 +100,7 @@ HEADERS += \
     strings_bundle.hpp \
     suffix_array.hpp \
     sunrise_sunset.hpp \
+    task_executor.hpp \
     task_loop.hpp \
     thread.hpp \
     thread_checker.hpp \
@@ -98,6 +110,8 @@ HEADERS += \
     threaded_priority_queue.hpp \
     timegm.hpp \
     timer.hpp \
+    tracing.hpp \
     uni_string_dfa.hpp \
     waiter.hpp \
+    work_stealing_thread_pool.hpp \
     worker_thread.hpp \
@@ -18,8 +18,10 @@ SOURCES += \
   bits_test.cpp \
   buffer_vector_test.cpp \
   bwt_tests.cpp \
+  cache_registry_test.cpp \
   cache_test.cpp \
   collection_cast_test.cpp \
+  concurrent_lru_cache_test.cpp \
   condition_test.cpp \
   containers_test.cpp \
   levenshtein_dfa_test.cpp \
@@ -28,7 +30,9 @@ SOURCES += \
   math_test.cpp \
   matrix_test.cpp \
   mem_trie_test.cpp \
+  memory_counters_test.cpp \
   move_to_front_tests.cpp \
+  object_arena_test.cpp \
   observer_list_test.cpp \
   range_iterator_test.cpp \
   ref_counted_tests.cpp \
@@ -42,12 +46,15 @@ SOURCES += \
   string_utils_test.cpp \
   suffix_array_tests.cpp \
   sunrise_sunset_test.cpp \
+  task_executor_test.cpp \
   thread_pool_tests.cpp \
   threaded_list_test.cpp \
   threads_test.cpp \
   timegm_test.cpp \
   timer_test.cpp \
+  tracing_test.cpp \
   uni_string_dfa_test.cpp \
+  work_stealing_thread_pool_test.cpp \
   worker_thread_tests.cpp \
 
 HEADERS +=
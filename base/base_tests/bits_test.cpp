@@ -103,6 +103,14 @@ UNIT_TEST(NumHiZeroBits64)
   TEST_EQUAL(bits::NumHiZeroBits64(0x000000000000FDEFULL), 48, ());
 }
 
+UNIT_TEST(NumLoZeroBits64)
+{
+  TEST_EQUAL(bits::NumLoZeroBits64(0x1), 0, ());
+  TEST_EQUAL(bits::NumLoZeroBits64(0xFFFFFFFFFFFFFFFFULL), 0, ());
+  TEST_EQUAL(bits::NumLoZeroBits64(0x0FABCDEF0FABCDE0ULL), 5, ());
+  TEST_EQUAL(bits::NumLoZeroBits64(0x8000000000000000ULL), 63, ());
+}
+
 UNIT_TEST(NumUsedBits)
 {
   TEST_EQUAL(bits::NumUsedBits(0), 0, ());
@@ -0,0 +1,37 @@
+#include "testing/testing.hpp"
+
+#include "base/cache_registry.hpp"
+
+#include <string>
+#include <vector>
+
+using namespace base;
+
+namespace
+{
+UNIT_TEST(CacheRegistry_Tiers)
+{
+  std::vector<std::string> shed;
+  {
+    SheddableCache high("high", CacheRegistry::Priority::High, [&shed]() { shed.push_back("high"); });
+    SheddableCache low("low", CacheRegistry::Priority::Low, [&shed]() { shed.push_back("low"); });
+    SheddableCache normal("normal", CacheRegistry::Priority::Normal,
+                          [&shed]() { shed.push_back("normal"); });
+
+    TEST_EQUAL(CacheRegistry::Instance().Shed(CacheRegistry::Pressure::Moderate), 1, ());
+    TEST_EQUAL(shed, std::vector<std::string>({"low"}), ());
+
+    shed.clear();
+    TEST_EQUAL(CacheRegistry::Instance().Shed(CacheRegistry::Pressure::Serious), 2, ());
+    TEST_EQUAL(shed, std::vector<std::string>({"low", "normal"}), ());
+
+    shed.clear();
+    TEST_EQUAL(CacheRegistry::Instance().Shed(CacheRegistry::Pressure::Critical), 3, ());
+    TEST_EQUAL(shed, std::vector<std::string>({"low", "normal", "high"}), ());
+  }
+
+  shed.clear();
+  TEST_EQUAL(CacheRegistry::Instance().Shed(CacheRegistry::Pressure::Critical), 0, ());
+  TEST(shed.empty(), ());
+}
+}  // namespace
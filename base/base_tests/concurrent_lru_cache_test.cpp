@@ -0,0 +1,109 @@
+#include "testing/testing.hpp"
+
+#include "base/concurrent_lru_cache.hpp"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace my;
+using namespace std;
+
+namespace
+{
+struct StringWeigher
+{
+  size_t operator()(int /* key */, string const & value) const { return value.size(); }
+};
+
+UNIT_TEST(ConcurrentLRUCache_Smoke)
+{
+  // One shard to check the order of eviction.
+  ConcurrentLRUCache<int, string> cache(3 /* capacity */, 1 /* shardsCount */);
+
+  string value;
+  TEST(!cache.Find(1, value), ());
+
+  cache.Put(1, "a");
+  cache.Put(2, "b");
+  cache.Put(3, "c");
+  TEST_EQUAL(cache.GetSize(), 3, ());
+
+  // 1 becomes the most recently used, so 2 is evicted.
+  TEST(cache.Find(1, value), ());
+  TEST_EQUAL(value, "a", ());
+  cache.Put(4, "d");
+  TEST_EQUAL(cache.GetSize(), 3, ());
+  TEST(!cache.Find(2, value), ());
+  TEST(cache.Find(3, value), ());
+  TEST(cache.Find(4, value), ());
+
+  // Put replaces a value.
+  cache.Put(4, "e");
+  TEST(cache.Find(4, value), ());
+  TEST_EQUAL(value, "e", ());
+  TEST_EQUAL(cache.GetSize(), 3, ());
+
+  cache.Erase(4);
+  TEST(!cache.Find(4, value), ());
+
+  TEST_EQUAL(cache.GetAccessCount(), 7, ());
+  TEST_EQUAL(cache.GetMissCount(), 3, ());
+  TEST_ALMOST_EQUAL_ULPS(cache.GetCacheMiss(), 3.0 / 7.0, ());
+
+  cache.Reset();
+  TEST_EQUAL(cache.GetSize(), 0, ());
+  TEST_EQUAL(cache.GetAccessCount(), 0, ());
+  TEST_EQUAL(cache.GetCacheMiss(), 0.0, ());
+}
+
+UNIT_TEST(ConcurrentLRUCache_Weights)
+{
+  ConcurrentLRUCache<int, string, hash<int>, StringWeigher> cache(10 /* capacity */,
+                                                                  1 /* shardsCount */);
+  cache.Put(1, "aaaa");
+  cache.Put(2, "bbbb");
+  TEST_EQUAL(cache.GetWeight(), 8, ());
+
+  // Too heavy values aren't cached.
+  cache.Put(3, string(11, 'c'));
+  string value;
+  TEST(!cache.Find(3, value), ());
+  TEST_EQUAL(cache.GetWeight(), 8, ());
+
+  // The least recently used value is evicted to fit the new one.
+  cache.Put(4, "dddd");
+  TEST(!cache.Find(1, value), ());
+  TEST(cache.Find(2, value), ());
+  TEST(cache.Find(4, value), ());
+  TEST_EQUAL(cache.GetWeight(), 8, ());
+
+  TEST_EQUAL(cache.FindOrLoad(5, [] { return string("ee"); }), "ee", ());
+  TEST_EQUAL(cache.GetWeight(), 10, ());
+  TEST_EQUAL(cache.FindOrLoad(5, [] { return string("ff"); }), "ee", ());
+}
+
+UNIT_TEST(ConcurrentLRUCache_Threads)
+{
+  size_t const kThreads = 4;
+  int const kKeys = 1000;
+
+  ConcurrentLRUCache<int, int> cache(kKeys / 2 /* capacity */, 4 /* shardsCount */);
+  vector<thread> threads;
+  for (size_t i = 0; i < kThreads; ++i)
+  {
+    threads.emplace_back([&cache]() {
+      for (int j = 0; j < 10 * kKeys; ++j)
+      {
+        int const key = j % kKeys;
+        TEST_EQUAL(cache.FindOrLoad(key, [key] { return key * key; }), key * key, ());
+      }
+    });
+  }
+  for (auto & t : threads)
+    t.join();
+
+  TEST_LESS_OR_EQUAL(cache.GetSize(), kKeys / 2, ());
+  TEST_EQUAL(cache.GetAccessCount(), kThreads * 10 * kKeys, ());
+}
+}  // namespace
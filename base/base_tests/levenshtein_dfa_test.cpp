@@ -2,6 +2,7 @@
 
 #include "base/dfa_helpers.hpp"
 #include "base/levenshtein_dfa.hpp"
+#include "base/levenshtein_dfa_cache.hpp"
 
 #include <sstream>
 #include <string>
@@ -182,4 +183,33 @@ UNIT_TEST(LevenshteinDFA_ErrorsMade)
     TEST_EQUAL(GetResult(dfa, "кафер"), Result(Status::Accepts, 1 /* errorsMade */), ());
   }
 }
+
+UNIT_TEST(LevenshteinDFACache_Smoke)
+{
+  LevenshteinDFACache cache(2 /* maxSize */);
+
+  auto const moscow = MakeUniString("москва");
+  auto const dfa = cache.Get(moscow, 1 /* prefixCharsToKeep */, 1 /* maxErrors */);
+  TEST_EQUAL(cache.GetSize(), 1, ());
+  TEST(Accepts(dfa, "масква"), ());
+  TEST(Rejects(dfa, "иосква"), ());
+
+  // Automata with different parameters are different entries.
+  auto const exact = cache.Get(moscow, 1 /* prefixCharsToKeep */, 0 /* maxErrors */);
+  TEST_EQUAL(cache.GetSize(), 2, ());
+  TEST(Rejects(exact, "масква"), ());
+
+  auto const cached = cache.Get(moscow, 1 /* prefixCharsToKeep */, 1 /* maxErrors */);
+  TEST_EQUAL(cache.GetSize(), 2, ());
+  TEST_EQUAL(cached.GetNumStates(), dfa.GetNumStates(), ());
+  TEST(Accepts(cached, "масква"), ());
+
+  // The cache is cleared when it's full.
+  auto const fuzzy = cache.Get(moscow, 0 /* prefixCharsToKeep */, 1 /* maxErrors */);
+  TEST_EQUAL(cache.GetSize(), 1, ());
+  TEST(Accepts(fuzzy, "иосква"), ());
+
+  cache.Clear();
+  TEST_EQUAL(cache.GetSize(), 0, ());
+}
 }  // namespace
@@ -0,0 +1,45 @@
+#include "testing/testing.hpp"
+
+#include "base/memory_counters.hpp"
+
+#include <memory>
+#include <string>
+
+using namespace base;
+
+namespace
+{
+uint64_t GetCounter(std::string const & name)
+{
+  auto const snapshot = MemoryCounters::Instance().GetSnapshot();
+  auto const it = snapshot.find(name);
+  return it == snapshot.end() ? 0 : it->second;
+}
+
+UNIT_TEST(MemoryCounters_Smoke)
+{
+  uint64_t const total = MemoryCounters::Instance().GetTotal();
+  {
+    MemoryCounter first("memory_counters_test.first");
+    MemoryCounter second("memory_counters_test.first");
+    MemoryCounter third("memory_counters_test.third");
+
+    first.Set(100);
+    second.Set(20);
+    third.Set(3);
+    TEST_EQUAL(GetCounter("memory_counters_test.first"), 120, ());
+    TEST_EQUAL(GetCounter("memory_counters_test.third"), 3, ());
+    TEST_EQUAL(MemoryCounters::Instance().GetTotal(), total + 123, ());
+
+    first.Set(10);
+    TEST_EQUAL(first.Get(), 10, ());
+    TEST_EQUAL(GetCounter("memory_counters_test.first"), 30, ());
+
+    third.Set(0);
+    auto const snapshot = MemoryCounters::Instance().GetSnapshot();
+    TEST(snapshot.find("memory_counters_test.third") == snapshot.end(), ());
+  }
+  TEST_EQUAL(GetCounter("memory_counters_test.first"), 0, ());
+  TEST_EQUAL(MemoryCounters::Instance().GetTotal(), total, ());
+}
+}  // namespace
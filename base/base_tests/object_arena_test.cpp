@@ -0,0 +1,69 @@
+#include "testing/testing.hpp"
+
+#include "base/object_arena.hpp"
+
+#include <string>
+#include <vector>
+
+using namespace base;
+
+namespace
+{
+struct Counted
+{
+  Counted(int value, int & numAlive) : m_value(value), m_numAlive(numAlive) { ++m_numAlive; }
+  ~Counted() { --m_numAlive; }
+
+  int m_value;
+  int & m_numAlive;
+};
+}  // namespace
+
+UNIT_TEST(ObjectArena_Smoke)
+{
+  int numAlive = 0;
+  ObjectArena<Counted, 4 /* ChunkSize */> arena;
+  TEST_EQUAL(arena.Size(), 0, ());
+  TEST_EQUAL(arena.Capacity(), 0, ());
+
+  std::vector<Counted *> objects;
+  for (int i = 0; i < 10; ++i)
+    objects.push_back(arena.Emplace(i, numAlive));
+  TEST_EQUAL(numAlive, 10, ());
+  TEST_EQUAL(arena.Size(), 10, ());
+  TEST_EQUAL(arena.Capacity(), 12, ());
+
+  // Pointers are stable when new chunks are allocated.
+  for (int i = 0; i < 10; ++i)
+    TEST_EQUAL(objects[i]->m_value, i, ());
+
+  arena.Clear();
+  TEST_EQUAL(numAlive, 0, ());
+  TEST_EQUAL(arena.Size(), 0, ());
+  TEST_EQUAL(arena.Capacity(), 12, ());
+
+  // Memory is reused after Clear().
+  auto * object = arena.Emplace(42, numAlive);
+  TEST_EQUAL(object, objects[0], ());
+  TEST_EQUAL(object->m_value, 42, ());
+
+  arena.Release();
+  TEST_EQUAL(numAlive, 0, ());
+  TEST_EQUAL(arena.Capacity(), 0, ());
+}
+
+UNIT_TEST(ObjectArena_Destructor)
+{
+  int numAlive = 0;
+  {
+    ObjectArena<Counted> arena;
+    arena.Emplace(1, numAlive);
+    arena.Emplace(2, numAlive);
+    TEST_EQUAL(numAlive, 2, ());
+  }
+  TEST_EQUAL(numAlive, 0, ());
+
+  ObjectArena<std::string, 2 /* ChunkSize */> strings;
+  for (int i = 0; i < 5; ++i)
+    TEST_EQUAL(*strings.Emplace(i, 'a'), std::string(i, 'a'), ());
+}
@@ -130,6 +130,36 @@ UNIT_TEST(MakeLowerCase)
   TEST_EQUAL(cus, strings::MakeLowerCase(us), ());
 }
 
+UNIT_TEST(MakeLowerCase_FastPaths)
+{
+  // All ASCII chars are lowercased by the fast path as by the table.
+  strings::UniString ascii;
+  for (strings::UniChar c = 0; c < 0x80; ++c)
+    ascii.push_back(c);
+  strings::UniString expected;
+  for (auto const c : ascii)
+    expected.push_back(strings::LowerUniChar(c));
+  TEST_EQUAL(strings::MakeLowerCase(ascii), expected, ());
+
+  std::string asciiUtf8 = strings::ToUtf8(ascii);
+  strings::MakeLowerCaseInplace(asciiUtf8);
+  TEST_EQUAL(asciiUtf8, strings::ToUtf8(expected), ());
+
+  // Chars which are folded to several chars go after the inplace prefix.
+  TEST_EQUAL(strings::ToUtf8(strings::MakeLowerCase(strings::MakeUniString("ABC\xc3\x9f" "DE"))),
+             "abcssde", ());
+  TEST_EQUAL(strings::ToUtf8(strings::MakeLowerCase(strings::MakeUniString("\xc3\x9f"))), "ss", ());
+  TEST_EQUAL(strings::MakeLowerCase(strings::UniString()), strings::UniString(), ());
+}
+
+UNIT_TEST(IsASCIIString)
+{
+  TEST(strings::IsASCIIString(""), ());
+  TEST(strings::IsASCIIString("Hello, World! 0123456789"), ());
+  TEST(!strings::IsASCIIString("Hola! 99-\xD0\xA3"), ());
+  TEST(!strings::IsASCIIString(std::string(100, 'a') + "\xc3\x9f"), ());
+}
+
 UNIT_TEST(EqualNoCase)
 {
   TEST(strings::EqualNoCase("HaHaHa", "hahaha"), ());
@@ -0,0 +1,222 @@
+#include "testing/testing.hpp"
+
+#include "base/task_executor.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace threads;
+
+namespace
+{
+// Blocks tasks until it's opened.
+class Gate
+{
+public:
+  void Open()
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_opened = true;
+    m_cv.notify_all();
+  }
+
+  void Wait()
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_cv.wait(lock, [this]() { return m_opened; });
+  }
+
+private:
+  std::mutex m_mutex;
+  std::condition_variable m_cv;
+  bool m_opened = false;
+};
+
+template <typename T>
+bool IsCancelled(TaskFuture<T> const & future)
+{
+  try
+  {
+    future.Get();
+  }
+  catch (TaskCancelledException const &)
+  {
+    return true;
+  }
+  return false;
+}
+}  // namespace
+
+UNIT_TEST(TaskExecutor_Submit)
+{
+  TaskExecutor executor(4 /* threadsCount */);
+
+  std::vector<TaskFuture<int>> futures;
+  for (int i = 0; i < 100; ++i)
+    futures.push_back(executor.Submit([i](my::Cancellable const &) { return i * i; }));
+
+  for (int i = 0; i < 100; ++i)
+    TEST_EQUAL(futures[i].Get(), i * i, ());
+
+  std::atomic<int> counter(0);
+  auto f = executor.Submit([&counter](my::Cancellable const &) { ++counter; });
+  f.Get();
+  TEST(f.IsReady(), ());
+  TEST_EQUAL(counter, 1, ());
+}
+
+UNIT_TEST(TaskExecutor_Then)
+{
+  TaskExecutor executor(2 /* threadsCount */);
+
+  auto a = executor.Submit([](my::Cancellable const &) { return 20; });
+  auto b = executor.Then(a, [](int v, my::Cancellable const &) { return v + 1; });
+  auto c = executor.Then(b, [](int v, my::Cancellable const &) { return std::to_string(v * 2); });
+  TEST_EQUAL(c.Get(), "42", ());
+
+  std::atomic<int> counter(0);
+  auto d = executor.Submit([&counter](my::Cancellable const &) { ++counter; });
+  auto e = executor.Then(d, [&counter](my::Cancellable const &) { return counter.load(); });
+  TEST_EQUAL(e.Get(), 1, ());
+
+  // Continuations of finished tasks are run too.
+  auto g = executor.Then(a, [](int v, my::Cancellable const &) { return v * 3; });
+  TEST_EQUAL(g.Get(), 60, ());
+}
+
+UNIT_TEST(TaskExecutor_WhenAll)
+{
+  TaskExecutor executor(4 /* threadsCount */);
+
+  std::vector<TaskFuture<int>> parts;
+  std::vector<TaskHandle> handles;
+  for (int i = 1; i <= 10; ++i)
+  {
+    parts.push_back(executor.Submit([i](my::Cancellable const &) { return i; }));
+    handles.push_back(parts.back().GetHandle());
+  }
+
+  auto sum = executor.WhenAll(handles, [&parts](my::Cancellable const &) {
+    int result = 0;
+    for (auto const & part : parts)
+      result += part.Get();
+    return result;
+  });
+  TEST_EQUAL(sum.Get(), 55, ());
+}
+
+UNIT_TEST(TaskExecutor_Exceptions)
+{
+  TaskExecutor executor(2 /* threadsCount */);
+
+  auto a = executor.Submit([](my::Cancellable const &) -> int { throw std::runtime_error("a"); });
+  std::atomic<bool> called(false);
+  auto b = executor.Then(a, [&called](int v, my::Cancellable const &) {
+    called = true;
+    return v;
+  });
+
+  std::string message;
+  try
+  {
+    b.Get();
+  }
+  catch (std::runtime_error const & e)
+  {
+    message = e.what();
+  }
+  TEST_EQUAL(message, "a", ());
+  TEST(!called, ());
+}
+
+UNIT_TEST(TaskExecutor_Cancel)
+{
+  TaskExecutor executor(1 /* threadsCount */);
+
+  Gate gate;
+  auto blocker = executor.Submit([&gate](my::Cancellable const &) { gate.Wait(); });
+  std::atomic<bool> called(false);
+  auto a = executor.Submit([&called](my::Cancellable const &) {
+    called = true;
+    return 1;
+  });
+  auto b = executor.Then(a, [](int v, my::Cancellable const &) { return v + 1; });
+
+  a.Cancel();
+  gate.Open();
+
+  TEST(IsCancelled(a), ());
+  TEST(IsCancelled(b), ());
+  TEST(!called, ());
+  blocker.Get();
+}
+
+UNIT_TEST(TaskExecutor_CancelRunning)
+{
+  TaskExecutor executor(1 /* threadsCount */);
+
+  Gate started;
+  auto a = executor.Submit([&started](my::Cancellable const & cancellable) {
+    started.Open();
+    while (!cancellable.IsCancelled())
+      ;
+    return 1;
+  });
+
+  started.Wait();
+  a.Cancel();
+  TEST(IsCancelled(a), ());
+}
+
+UNIT_TEST(TaskExecutor_Priorities)
+{
+  TaskExecutor executor(1 /* threadsCount */);
+
+  Gate gate;
+  auto blocker = executor.Submit([&gate](my::Cancellable const &) { gate.Wait(); });
+
+  std::mutex mu;
+  std::vector<int> order;
+  auto const push = [&](int v) {
+    std::lock_guard<std::mutex> lock(mu);
+    order.push_back(v);
+  };
+
+  std::vector<TaskFuture<void>> futures;
+  for (int i = 0; i < 3; ++i)
+  {
+    futures.push_back(executor.Submit([&push, i](my::Cancellable const &) { push(i); },
+                                      TaskExecutor::Priority::Normal));
+  }
+  for (int i = 3; i < 6; ++i)
+  {
+    futures.push_back(executor.Submit([&push, i](my::Cancellable const &) { push(i); },
+                                      TaskExecutor::Priority::High));
+  }
+
+  gate.Open();
+  for (auto const & f : futures)
+    f.Get();
+
+  std::vector<int> const expected = {3, 4, 5, 0, 1, 2};
+  TEST_EQUAL(order, expected, ());
+}
+
+UNIT_TEST(TaskExecutor_Stop)
+{
+  TaskExecutor executor(0 /* threadsCount */);
+
+  auto a = executor.Submit([](my::Cancellable const &) { return 1; });
+  auto b = executor.Then(a, [](int v, my::Cancellable const &) { return v; });
+  executor.Stop();
+
+  TEST(IsCancelled(a), ());
+  TEST(IsCancelled(b), ());
+
+  auto c = executor.Submit([](my::Cancellable const &) { return 1; });
+  TEST(IsCancelled(c), ());
+}
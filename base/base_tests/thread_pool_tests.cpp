@@ -6,6 +6,7 @@
 #include "base/condition.hpp"
 
 #include <functional>
+#include <list>
 #include <vector>
 
 namespace
@@ -155,3 +156,47 @@ UNIT_TEST(ThreadPool_EmptyTest)
   threads::Sleep(100);
   pool.Stop();
 }
+
+namespace
+{
+  class IdTask : public threads::IRoutine
+  {
+  public:
+    explicit IdTask(int id) : m_id(id) {}
+
+    virtual void Do() {}
+
+    int GetId() const { return m_id; }
+
+  private:
+    int m_id;
+  };
+}
+
+UNIT_TEST(ThreadPool_ProcessTasksTest)
+{
+  int finishCounter = 0;
+  threads::Condition cond;
+  // Pool without threads keeps all tasks in the queue.
+  threads::ThreadPool pool(0, std::bind(&JoinFinishFunction, std::placeholders::_1,
+                                        std::ref(finishCounter), std::ref(cond)));
+
+  for (int i = 0; i < TASK_COUNT; ++i)
+    pool.PushBack(new IdTask(i));
+
+  pool.ProcessTasks([](std::list<threads::IRoutine *> & tasks) { tasks.reverse(); });
+
+  std::vector<int> ids;
+  pool.ProcessTasks([&ids](std::list<threads::IRoutine *> & tasks)
+                    {
+                      for (auto const task : tasks)
+                        ids.push_back(static_cast<IdTask *>(task)->GetId());
+                    });
+
+  TEST_EQUAL(ids.size(), TASK_COUNT, ());
+  for (int i = 0; i < TASK_COUNT; ++i)
+    TEST_EQUAL(ids[i], TASK_COUNT - 1 - i, ());
+
+  pool.Stop();
+  TEST_EQUAL(finishCounter, TASK_COUNT, ());
+}
@@ -0,0 +1,128 @@
+#include "testing/testing.hpp"
+
+#include "base/tracing.hpp"
+
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace my::tracing;
+
+UNIT_TEST(Tracing_DisabledByDefault)
+{
+  Tracer tracer;
+  TEST(!tracer.IsEnabled(), ());
+  {
+    ScopedSpan span(tracer, "test", "span");
+  }
+  TEST(tracer.GetSpans().empty(), ());
+}
+
+UNIT_TEST(Tracing_Spans)
+{
+  Tracer tracer;
+  tracer.SetEnabled(true);
+  {
+    ScopedSpan outer(tracer, "test", "outer");
+    {
+      ScopedSpan inner(tracer, "test", "inner");
+    }
+  }
+
+  auto const spans = tracer.GetSpans();
+  TEST_EQUAL(spans.size(), 2, ());
+  TEST_EQUAL(std::string(spans[0].m_name), "outer", ());
+  TEST_EQUAL(std::string(spans[1].m_name), "inner", ());
+  TEST_LESS_OR_EQUAL(spans[0].m_startNs, spans[1].m_startNs, ());
+  TEST_GREATER_OR_EQUAL(spans[0].m_startNs + spans[0].m_durationNs,
+                        spans[1].m_startNs + spans[1].m_durationNs, ());
+  TEST_EQUAL(spans[0].m_threadIndex, spans[1].m_threadIndex, ());
+
+  tracer.Clear();
+  TEST(tracer.GetSpans().empty(), ());
+}
+
+UNIT_TEST(Tracing_RingBuffer)
+{
+  Tracer tracer(4 /* bufferCapacity */);
+  tracer.SetEnabled(true);
+  for (uint64_t i = 0; i < 10; ++i)
+    tracer.AddSpan("test", "span", i, 1);
+
+  auto const spans = tracer.GetSpans();
+  TEST_EQUAL(spans.size(), 4, ());
+  for (size_t i = 0; i < spans.size(); ++i)
+    TEST_EQUAL(spans[i].m_startNs, 6 + i, ());
+  TEST_EQUAL(tracer.GetDroppedCount(), 6, ());
+}
+
+UNIT_TEST(Tracing_Threads)
+{
+  size_t const kThreads = 4;
+  size_t const kSpans = 1000;
+
+  Tracer tracer;
+  tracer.SetEnabled(true);
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < kThreads; ++i)
+  {
+    threads.emplace_back([&tracer]() {
+      for (size_t j = 0; j < kSpans; ++j)
+        ScopedSpan span(tracer, "test", "span");
+    });
+  }
+  for (auto & thread : threads)
+    thread.join();
+
+  auto const spans = tracer.GetSpans();
+  TEST_EQUAL(spans.size(), kThreads * kSpans, ());
+  for (size_t i = 1; i < spans.size(); ++i)
+    TEST_LESS_OR_EQUAL(spans[i - 1].m_startNs, spans[i].m_startNs, ());
+}
+
+UNIT_TEST(Tracing_CountersAndHistograms)
+{
+  Counter counter("test.counter");
+  counter.Add();
+  counter.Add(4);
+  TEST_EQUAL(counter.Get(), 5, ());
+
+  TEST_EQUAL(Histogram::GetBucketIndex(0), 0, ());
+  TEST_EQUAL(Histogram::GetBucketIndex(1), 1, ());
+  TEST_EQUAL(Histogram::GetBucketIndex(3), 2, ());
+  TEST_EQUAL(Histogram::GetBucketIndex(4), 3, ());
+  TEST_EQUAL(Histogram::GetBucketIndex(~static_cast<uint64_t>(0)), 64, ());
+
+  Histogram histogram("test.histogram");
+  histogram.Add(0);
+  histogram.Add(2);
+  histogram.Add(3);
+  TEST_EQUAL(histogram.GetCount(), 3, ());
+  TEST_EQUAL(histogram.GetSum(), 5, ());
+  TEST_EQUAL(histogram.GetBucket(0), 1, ());
+  TEST_EQUAL(histogram.GetBucket(2), 2, ());
+
+  std::ostringstream os;
+  Tracer::Instance().ExportChromeTrace(os);
+  std::string const json = os.str();
+  TEST(json.find("\"name\":\"test.counter\"") != std::string::npos, (json));
+  TEST(json.find("\"args\":{\"value\":5}") != std::string::npos, (json));
+  TEST(json.find("\"args\":{\"count\":3,\"sum\":5,\"<1\":1,\"<4\":2}") != std::string::npos,
+       (json));
+}
+
+UNIT_TEST(Tracing_ExportChromeTrace)
+{
+  Tracer tracer;
+  tracer.SetEnabled(true);
+  tracer.AddSpan("test", "quoted \"name\"", 1500, 2001);
+
+  std::ostringstream os;
+  tracer.ExportChromeTrace(os);
+  std::string const json = os.str();
+  TEST(json.find("{\"traceEvents\":[") == 0, (json));
+  TEST(json.find("\"ph\":\"X\"") != std::string::npos, (json));
+  TEST(json.find("\"name\":\"quoted \\\"name\\\"\"") != std::string::npos, (json));
+  TEST(json.find("\"ts\":1.500,\"dur\":2.001") != std::string::npos, (json));
+}
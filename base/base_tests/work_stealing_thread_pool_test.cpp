@@ -0,0 +1,137 @@
+#include "testing/testing.hpp"
+
+#include "base/thread.hpp"
+#include "base/work_stealing_thread_pool.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+using namespace threads;
+
+namespace
+{
+size_t constexpr kNumTasks = 1000;
+
+class Waiter
+{
+public:
+  void OnFinished(IRoutine * routine)
+  {
+    delete routine;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    ++m_numFinished;
+    m_cv.notify_all();
+  }
+
+  void Wait(size_t numFinished)
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_cv.wait(lock, [&]() { return m_numFinished >= numFinished; });
+  }
+
+  size_t GetNumFinished()
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_numFinished;
+  }
+
+private:
+  std::mutex m_mutex;
+  std::condition_variable m_cv;
+  size_t m_numFinished = 0;
+};
+
+class CountingTask : public IRoutine
+{
+public:
+  explicit CountingTask(std::atomic<size_t> & counter) : m_counter(counter) {}
+
+  void Do() override { ++m_counter; }
+
+private:
+  std::atomic<size_t> & m_counter;
+};
+
+// Pushes |m_numChildren| counting tasks to the pool from a worker.
+class SpawningTask : public IRoutine
+{
+public:
+  SpawningTask(WorkStealingThreadPool & pool, std::atomic<size_t> & counter, size_t numChildren)
+    : m_pool(pool), m_counter(counter), m_numChildren(numChildren)
+  {
+  }
+
+  void Do() override
+  {
+    for (size_t i = 0; i < m_numChildren; ++i)
+      m_pool.PushBack(new CountingTask(m_counter));
+  }
+
+private:
+  WorkStealingThreadPool & m_pool;
+  std::atomic<size_t> & m_counter;
+  size_t m_numChildren;
+};
+
+class FailingTask : public IRoutine
+{
+public:
+  void Do() override { TEST(false, ("Cancelled task must not be executed.")); }
+};
+}  // namespace
+
+UNIT_TEST(WorkStealingThreadPool_Smoke)
+{
+  std::atomic<size_t> counter(0);
+  Waiter waiter;
+  WorkStealingThreadPool pool(4, std::bind(&Waiter::OnFinished, &waiter, std::placeholders::_1));
+
+  for (size_t i = 0; i < kNumTasks; ++i)
+  {
+    if (i % 2 == 0)
+      pool.PushBack(new CountingTask(counter));
+    else
+      pool.PushFront(new CountingTask(counter));
+  }
+
+  waiter.Wait(kNumTasks);
+  TEST_EQUAL(counter, kNumTasks, ());
+  pool.Stop();
+  TEST_EQUAL(waiter.GetNumFinished(), kNumTasks, ());
+}
+
+UNIT_TEST(WorkStealingThreadPool_LocalPush)
+{
+  size_t constexpr kNumSpawners = 10;
+  size_t constexpr kNumChildren = 100;
+
+  std::atomic<size_t> counter(0);
+  Waiter waiter;
+  WorkStealingThreadPool pool(3, std::bind(&Waiter::OnFinished, &waiter, std::placeholders::_1));
+
+  for (size_t i = 0; i < kNumSpawners; ++i)
+    pool.PushBack(new SpawningTask(pool, counter, kNumChildren));
+
+  waiter.Wait(kNumSpawners * (kNumChildren + 1));
+  TEST_EQUAL(counter, kNumSpawners * kNumChildren, ());
+}
+
+UNIT_TEST(WorkStealingThreadPool_Stop)
+{
+  Waiter waiter;
+  // Routines of a pool without workers are finished only on Stop().
+  WorkStealingThreadPool pool(0, std::bind(&Waiter::OnFinished, &waiter, std::placeholders::_1));
+
+  for (size_t i = 0; i < 10; ++i)
+    pool.PushBack(new FailingTask());
+  TEST_EQUAL(waiter.GetNumFinished(), 0, ());
+
+  pool.Stop();
+  TEST_EQUAL(waiter.GetNumFinished(), 10, ());
+
+  pool.PushBack(new FailingTask());
+  TEST_EQUAL(waiter.GetNumFinished(), 11, ());
+}
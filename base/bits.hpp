@@ -190,6 +190,16 @@ namespace bits
     while ((n & (uint64_t(1) << 63)) == 0) { ++result; n <<= 1; }
     return result;
   }
+
+  // Returns the number of trailing zero bits, |n| must not be zero.
+  inline uint32_t NumLoZeroBits64(uint64_t n)
+  {
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<uint32_t>(__builtin_ctzll(n));
+#else
+    return FloorLog(n & (~n + 1));
+#endif
+  }
   
   // Computes number of bits needed to store the number, it is not equal to number of ones.
   // E.g. if we have a number (in bit representation) 00001000b then NumUsedBits is 4.
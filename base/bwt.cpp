@@ -14,125 +14,67 @@ namespace
 {
 size_t const kNumBytes = 256;
 
-// Fake trailing '$' for the BWT, used for original string
-// reconstruction.
-uint32_t const kEOS = 256;
-
-// FirstColumn represents the first column in the BWT matrix. As
-// during reverse BWT we need to reconstruct canonical first column,
-// with '$' as the first element, this wrapper is used. Also note that
-// other characters in the first column are sorted, so we actually
-// don't need to store them explicitly, it's enough to store start
-// positions of the corresponding groups of consecutive characters.
-class FirstColumn
+// Fills |next| for the reverse BWT: for the i-th row of the canonical BWT
+// matrix, i.e. the matrix with the trailing '$', next[i] is the row whose
+// last symbol is the same occurrence of the first symbol of the i-th row.
+// The first column is sorted, so the rows of the occurrences of a byte in
+// the first column start from the number of smaller bytes plus one for
+// the '$' and go in the same order as the occurrences in the last column.
+//
+// The canonical last column is s[start] + s[0, start) + '$' + s(start, n),
+// i.e. s[i] is the last symbol of the row i + 1 except s[start], which is
+// the last symbol of the row 0.
+template <typename T>
+void FillNext(size_t n, size_t start, uint8_t const * s, vector<T> & next)
 {
-public:
-  FirstColumn(size_t n, uint8_t const * s) : m_n(n), m_starts({})
-  {
-    m_starts.fill(0);
-    for (size_t i = 0; i < n; ++i)
-      ++m_starts[s[i]];
-
-    size_t offset = 0;
-    for (size_t i = 0; i < m_starts.size(); ++i)
-    {
-      auto const count = m_starts[i];
-      m_starts[i] = offset;
-      offset += count;
-    }
-  }
-
-  size_t Size() const { return m_n + 1; }
+  array<size_t, kNumBytes> rows;
+  rows.fill(0);
+  for (size_t i = 0; i < n; ++i)
+    ++rows[s[i]];
 
-  uint32_t operator[](size_t i) const
+  size_t row = 1;
+  for (auto & r : rows)
   {
-    ASSERT_LESS(i, Size(), ());
-    if (i == 0)
-      return kEOS;
-
-    --i;
-    auto it = upper_bound(m_starts.begin(), m_starts.end(), i);
-    ASSERT(it != m_starts.begin(), ());
-    --it;
-    return static_cast<uint32_t>(distance(m_starts.begin(), it));
+    auto const count = r;
+    r = row;
+    row += count;
   }
 
-  // Returns the rank of the i-th symbol among symbols with the same
-  // value.
-  size_t Rank(size_t i) const
+  next.resize(n + 1);
+  next[rows[s[start]]++] = 0;
+  for (size_t i = 0; i < n; ++i)
   {
-    ASSERT_LESS(i, Size(), ());
-    if (i == 0)
-      return 0;
-
-    --i;
-    auto it = upper_bound(m_starts.begin(), m_starts.end(), i);
-    if (it == m_starts.begin())
-      return i;
-    --it;
-    return i - *it;
+    if (i != start)
+      next[rows[s[i]]++] = static_cast<T>(i + 1);
   }
+}
 
-private:
-  size_t const m_n;
-  array<size_t, kNumBytes> m_starts;
-};
-
-// LastColumn represents the last column in the BWT matrix. As during
-// reverse BWT we need to reconstruct canonical last column, |s| is
-// replaced by s[start] + s[0, start) + '$' + s[start, n).
-class LastColumn
+// Returns the last symbol of the |row| of the canonical BWT matrix.
+uint8_t GetLast(size_t start, uint8_t const * s, size_t row)
 {
-public:
-  LastColumn(size_t n, size_t start, uint8_t const * s) : m_n(n), m_start(start), m_s(s)
-  {
-    for (size_t i = 0; i < Size(); ++i)
-    {
-      auto const b = (*this)[i];
-      if (b == kEOS)
-        continue;
-      ASSERT_LESS(b, kNumBytes, ());
-      m_table[b].push_back(i);
-    }
-  }
-
-  size_t Size() const { return m_n + 1; }
-
-  uint32_t operator[](size_t i) const
-  {
-    if (i == 0)
-    {
-      ASSERT_LESS(m_start, m_n, ());
-      return m_s[m_start];
-    }
-
-    if (i == m_start + 1)
-      return kEOS;
+  if (row == 0)
+    return s[start];
+  ASSERT_NOT_EQUAL(row, start + 1, ());
+  return s[row - 1];
+}
 
-    ASSERT_LESS_OR_EQUAL(i, m_n, ());
-    return m_s[i - 1];
-  }
+template <typename T>
+void RevBWTImpl(size_t n, size_t start, uint8_t const * s, uint8_t * r)
+{
+  vector<T> next;
+  FillNext(n, start, s, next);
 
-  // Returns the index of the |rank|-th |byte| in the canonical BWT
-  // last column.
-  size_t Select(uint32_t byte, size_t rank)
+  // The row 0 starts with '$', so the original string is the row start + 1.
+  size_t curr = start + 1;
+  for (size_t i = 0; i < n; ++i)
   {
-    if (byte == kEOS)
-    {
-      ASSERT_EQUAL(rank, 0, ());
-      return 0;
-    }
-
-    ASSERT_LESS(rank, m_table[byte].size(), (byte, rank));
-    return m_table[byte][rank];
+    curr = next[curr];
+    r[i] = GetLast(start, s, curr);
   }
 
-private:
-  size_t const m_n;
-  size_t const m_start;
-  uint8_t const * const m_s;
-  array<vector<size_t>, kNumBytes> m_table;
-};
+  // The row of the '$' is reached at the end.
+  ASSERT_EQUAL(curr, 0, ());
+}
 }  // namespace
 
 namespace base
@@ -170,20 +112,11 @@ void RevBWT(size_t n, size_t start, uint8_t const * s, uint8_t * r)
   if (n == 0)
     return;
 
-  FirstColumn first(n, s);
-  LastColumn last(n, start, s);
-
-  auto curr = start + 1;
-  for (size_t i = 0; i < n; ++i)
-  {
-    ASSERT_LESS(curr, first.Size(), ());
-    ASSERT(first[curr] != kEOS, ());
-
-    r[i] = first[curr];
-    curr = last.Select(r[i], first.Rank(curr));
-  }
-
-  ASSERT_EQUAL(first[curr], kEOS, ());
+  ASSERT_LESS(start, n, ());
+  if (n < numeric_limits<uint32_t>::max())
+    RevBWTImpl<uint32_t>(n, start, s, r);
+  else
+    RevBWTImpl<uint64_t>(n, start, s, r);
 }
 
 void RevBWT(size_t start, string const & s, string & r)
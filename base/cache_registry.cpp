@@ -0,0 +1,76 @@
+#include "base/cache_registry.hpp"
+
+#include "base/assert.hpp"
+#include "base/logging.hpp"
+
+#include <algorithm>
+#include <vector>
+
+namespace base
+{
+// static
+CacheRegistry & CacheRegistry::Instance()
+{
+  static CacheRegistry registry;
+  return registry;
+}
+
+size_t CacheRegistry::Shed(Pressure pressure)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  std::vector<Entry const *> caches;
+  for (auto const & cache : m_caches)
+  {
+    if (static_cast<int>(cache.second.m_priority) <= static_cast<int>(pressure))
+      caches.push_back(&cache.second);
+  }
+  std::stable_sort(caches.begin(), caches.end(), [](Entry const * lhs, Entry const * rhs) {
+    return lhs->m_priority < rhs->m_priority;
+  });
+
+  for (auto const * cache : caches)
+  {
+    LOG(LINFO, ("Shedding", cache->m_name, "on", pressure, "memory pressure"));
+    cache->m_fn();
+  }
+  return caches.size();
+}
+
+uint64_t CacheRegistry::Register(std::string const & name, Priority priority, TShrinkFn const & fn)
+{
+  ASSERT(fn, (name));
+  std::lock_guard<std::mutex> lock(m_mutex);
+  uint64_t const id = m_nextId++;
+  m_caches.emplace(id, Entry{name, priority, fn});
+  return id;
+}
+
+void CacheRegistry::Unregister(uint64_t id)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto const erased = m_caches.erase(id);
+  ASSERT_EQUAL(erased, 1, ());
+  UNUSED_VALUE(erased);
+}
+
+SheddableCache::SheddableCache(std::string const & name, CacheRegistry::Priority priority,
+                               CacheRegistry::TShrinkFn const & fn)
+  : m_id(CacheRegistry::Instance().Register(name, priority, fn))
+{
+}
+
+SheddableCache::~SheddableCache() { CacheRegistry::Instance().Unregister(m_id); }
+
+std::string DebugPrint(CacheRegistry::Pressure pressure)
+{
+  switch (pressure)
+  {
+  case CacheRegistry::Pressure::Moderate: return "Moderate";
+  case CacheRegistry::Pressure::Serious: return "Serious";
+  case CacheRegistry::Pressure::Critical: return "Critical";
+  }
+  ASSERT(false, ());
+  return {};
+}
+}  // namespace base
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "base/macros.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+
+namespace base
+{
+// Process-wide registry of caches which may be shed under memory pressure,
+// e.g. on memory warnings of the OS. Caches are shed by tiers: caches of
+// low priority go first, so hot data is kept until the pressure is critical.
+class CacheRegistry
+{
+public:
+  enum class Priority
+  {
+    Low,
+    Normal,
+    High
+  };
+
+  enum class Pressure
+  {
+    // Sheds caches of low priority.
+    Moderate,
+    // Sheds caches of low and normal priorities.
+    Serious,
+    // Sheds all caches.
+    Critical
+  };
+
+  using TShrinkFn = std::function<void()>;
+
+  static CacheRegistry & Instance();
+
+  // Calls shrink functions of caches which are shed on |pressure|, from
+  // low priorities to high ones. Returns the number of shed caches.
+  size_t Shed(Pressure pressure);
+
+private:
+  friend class SheddableCache;
+
+  struct Entry
+  {
+    std::string m_name;
+    Priority m_priority;
+    TShrinkFn m_fn;
+  };
+
+  CacheRegistry() = default;
+
+  uint64_t Register(std::string const & name, Priority priority, TShrinkFn const & fn);
+  void Unregister(uint64_t id);
+
+  // Is held while shrink functions are called, so a cache isn't destroyed
+  // during the call.
+  std::mutex m_mutex;
+  std::map<uint64_t, Entry> m_caches;
+  uint64_t m_nextId = 0;
+
+  DISALLOW_COPY_AND_MOVE(CacheRegistry);
+};
+
+// Registration of a cache, the cache is unregistered on destruction, so
+// the registration is declared after the data which |fn| touches. |fn| may
+// be called from any thread, the cache posts the work to its own thread
+// when it isn't thread-safe. |fn| must not register or unregister caches.
+class SheddableCache
+{
+public:
+  SheddableCache(std::string const & name, CacheRegistry::Priority priority,
+                 CacheRegistry::TShrinkFn const & fn);
+  ~SheddableCache();
+
+private:
+  uint64_t const m_id;
+
+  DISALLOW_COPY_AND_MOVE(SheddableCache);
+};
+
+std::string DebugPrint(CacheRegistry::Pressure pressure);
+}  // namespace base
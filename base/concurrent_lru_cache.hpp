@@ -0,0 +1,221 @@
+#pragma once
+
+#include "base/assert.hpp"
+#include "base/macros.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace my
+{
+// Weight of every entry is one, so a capacity of a cache is a number of entries.
+struct UnitWeigher
+{
+  template <typename TKey, typename TValue>
+  size_t operator()(TKey const & /* key */, TValue const & /* value */) const
+  {
+    return 1;
+  }
+};
+
+// LRU cache which may be used from several threads. Keys are distributed between shards by
+// a hash, every shard has its own mutex and LRU list, so threads which use different shards
+// don't wait for each other. Every shard keeps at most |capacity / shardsCount| of weight,
+// weights are returned by TWeigher, e.g. bytes of memory which are held by values.
+// Values are returned by copies, so TValue should be cheap to copy, e.g. shared_ptr.
+//
+// Statistics have the same meaning as of CacheWithStat.
+//
+// *NOTE* This class is thread-safe.
+template <typename TKey, typename TValue, typename THasher = std::hash<TKey>,
+          typename TWeigher = UnitWeigher>
+class ConcurrentLRUCache
+{
+public:
+  ConcurrentLRUCache(size_t capacity, size_t shardsCount = 8, THasher const & hasher = THasher(),
+                     TWeigher const & weigher = TWeigher())
+    : m_hasher(hasher), m_weigher(weigher), m_miss(0), m_access(0)
+  {
+    ASSERT_GREATER(shardsCount, 0, ());
+    size_t const shardCapacity = std::max(capacity / shardsCount, static_cast<size_t>(1));
+    m_shards.reserve(shardsCount);
+    for (size_t i = 0; i < shardsCount; ++i)
+      m_shards.emplace_back(new Shard(shardCapacity, hasher));
+  }
+
+  // Returns true and copies a value to |value| when |key| is found.
+  bool Find(TKey const & key, TValue & value)
+  {
+    ++m_access;
+    Shard & shard = GetShard(key);
+    {
+      std::lock_guard<std::mutex> lock(shard.m_mutex);
+      auto const it = shard.m_index.find(key);
+      if (it != shard.m_index.end())
+      {
+        shard.m_entries.splice(shard.m_entries.begin(), shard.m_entries, it->second);
+        value = it->second->m_value;
+        return true;
+      }
+    }
+    ++m_miss;
+    return false;
+  }
+
+  // Returns a cached value for |key| or the one returned by |load|, which is cached then.
+  // |load| is called without locks, so values for the same key may be loaded by several
+  // threads concurrently, the last one is kept.
+  template <typename TLoad>
+  TValue FindOrLoad(TKey const & key, TLoad && load)
+  {
+    TValue value;
+    if (Find(key, value))
+      return value;
+
+    value = load();
+    Put(key, value);
+    return value;
+  }
+
+  void Put(TKey const & key, TValue const & value)
+  {
+    size_t const weight = m_weigher(key, value);
+    Shard & shard = GetShard(key);
+    std::lock_guard<std::mutex> lock(shard.m_mutex);
+
+    auto const it = shard.m_index.find(key);
+    if (it != shard.m_index.end())
+      shard.Erase(it);
+
+    // Too heavy values aren't cached.
+    if (weight > shard.m_capacity)
+      return;
+
+    shard.m_entries.push_front({key, value, weight});
+    shard.m_index.emplace(key, shard.m_entries.begin());
+    shard.m_weight += weight;
+    while (shard.m_weight > shard.m_capacity)
+      shard.Erase(shard.m_index.find(shard.m_entries.back().m_key));
+  }
+
+  void Erase(TKey const & key)
+  {
+    Shard & shard = GetShard(key);
+    std::lock_guard<std::mutex> lock(shard.m_mutex);
+    auto const it = shard.m_index.find(key);
+    if (it != shard.m_index.end())
+      shard.Erase(it);
+  }
+
+  void Clear()
+  {
+    for (auto & shard : m_shards)
+    {
+      std::lock_guard<std::mutex> lock(shard->m_mutex);
+      shard->m_index.clear();
+      shard->m_entries.clear();
+      shard->m_weight = 0;
+    }
+  }
+
+  // Resets statistics and clears the cache.
+  void Reset()
+  {
+    Clear();
+    m_miss = 0;
+    m_access = 0;
+  }
+
+  size_t GetSize() const
+  {
+    size_t size = 0;
+    for (auto const & shard : m_shards)
+    {
+      std::lock_guard<std::mutex> lock(shard->m_mutex);
+      size += shard->m_entries.size();
+    }
+    return size;
+  }
+
+  size_t GetWeight() const
+  {
+    size_t weight = 0;
+    for (auto const & shard : m_shards)
+    {
+      std::lock_guard<std::mutex> lock(shard->m_mutex);
+      weight += shard->m_weight;
+    }
+    return weight;
+  }
+
+  double GetCacheMiss() const
+  {
+    uint64_t const access = m_access;
+    if (access == 0)
+      return 0.0;
+    return static_cast<double>(m_miss) / static_cast<double>(access);
+  }
+
+  uint64_t GetAccessCount() const { return m_access; }
+  uint64_t GetMissCount() const { return m_miss; }
+
+private:
+  struct Entry
+  {
+    TKey m_key;
+    TValue m_value;
+    size_t m_weight;
+  };
+
+  using Entries = std::list<Entry>;
+  using Index = std::unordered_map<TKey, typename Entries::iterator, THasher>;
+
+  struct Shard
+  {
+    Shard(size_t capacity, THasher const & hasher) : m_index(0, hasher), m_capacity(capacity) {}
+
+    void Erase(typename Index::iterator it)
+    {
+      ASSERT_GREATER_OR_EQUAL(m_weight, it->second->m_weight, ());
+      m_weight -= it->second->m_weight;
+      m_entries.erase(it->second);
+      m_index.erase(it);
+    }
+
+    mutable std::mutex m_mutex;
+    // Recently used entries go first.
+    Entries m_entries;
+    Index m_index;
+    size_t const m_capacity;
+    size_t m_weight = 0;
+  };
+
+  Shard & GetShard(TKey const & key)
+  {
+    // Buckets of shards' indices are chosen by the same hash, so it's mixed before a shard
+    // is chosen.
+    uint64_t h = static_cast<uint64_t>(m_hasher(key));
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    return *m_shards[h % m_shards.size()];
+  }
+
+  THasher m_hasher;
+  TWeigher m_weigher;
+  std::vector<std::unique_ptr<Shard>> m_shards;
+  std::atomic<uint64_t> m_miss;
+  std::atomic<uint64_t> m_access;
+
+  DISALLOW_COPY_AND_MOVE(ConcurrentLRUCache);
+};
+}  // namespace my
@@ -4,6 +4,8 @@
 #include "base/stl_helpers.hpp"
 
 #include <algorithm>
+#include <limits>
+#include <map>
 #include <queue>
 #include <set>
 #include <sstream>
@@ -188,15 +190,15 @@ LevenshteinDFA::LevenshteinDFA(UniString const & s, size_t prefixCharsToKeep, si
 
   auto pushState = [&states, &visited, this](State const & state, size_t id)
   {
-    ASSERT_EQUAL(id, m_transitions.size(), ());
+    ASSERT_EQUAL(id, GetNumStates(), ());
     ASSERT_EQUAL(visited.count(state), 0, (state, id));
 
-    ASSERT_EQUAL(m_transitions.size(), m_accepting.size(), ());
-    ASSERT_EQUAL(m_transitions.size(), m_errorsMade.size(), ());
+    ASSERT_EQUAL(m_transitions.size(), GetNumStates() * m_alphabet.size(), ());
+    ASSERT_EQUAL(m_accepting.size(), m_errorsMade.size(), ());
 
     states.emplace(state);
     visited[state] = id;
-    m_transitions.emplace_back(m_alphabet.size());
+    m_transitions.resize(m_transitions.size() + m_alphabet.size());
     m_accepting.push_back(false);
     m_errorsMade.push_back(ErrorsMade(state));
   };
@@ -214,7 +216,7 @@ LevenshteinDFA::LevenshteinDFA(UniString const & s, size_t prefixCharsToKeep, si
 
     ASSERT_GREATER(visited.count(curr), 0, (curr));
     auto const id = visited[curr];
-    ASSERT_LESS(id, m_transitions.size(), ());
+    ASSERT_LESS(id, GetNumStates(), ());
 
     if (IsAccepting(curr))
       m_accepting[id] = true;
@@ -237,7 +239,8 @@ LevenshteinDFA::LevenshteinDFA(UniString const & s, size_t prefixCharsToKeep, si
         nid = it->second;
       }
 
-      m_transitions[id][i] = nid;
+      ASSERT_LESS_OR_EQUAL(nid, std::numeric_limits<uint32_t>::max(), ());
+      m_transitions[id * m_alphabet.size() + i] = static_cast<uint32_t>(nid);
     }
   }
 }
@@ -325,7 +328,7 @@ size_t LevenshteinDFA::Move(size_t s, UniChar c) const
   else
     i = distance(m_alphabet.begin(), it);
 
-  return m_transitions[s][i];
+  return m_transitions[s * m_alphabet.size() + i];
 }
 
 std::string DebugPrint(LevenshteinDFA::Position const & p)
@@ -3,6 +3,7 @@
 #include "base/string_utils.hpp"
 
 #include <cstddef>
+#include <cstdint>
 #include <vector>
 
 namespace strings
@@ -101,7 +102,7 @@ public:
 
   inline Iterator Begin() const { return Iterator(*this); }
 
-  size_t GetNumStates() const { return m_transitions.size(); }
+  size_t GetNumStates() const { return m_accepting.size(); }
   size_t GetAlphabetSize() const { return m_alphabet.size(); }
 
 private:
@@ -131,7 +132,10 @@ private:
 
   std::vector<UniChar> m_alphabet;
 
-  std::vector<std::vector<size_t>> m_transitions;
+  // Transitions of all states packed into a single table, row by
+  // row: the transition from the state |s| by the |i|-th alphabet
+  // character is stored at |s * m_alphabet.size() + i|.
+  std::vector<uint32_t> m_transitions;
   std::vector<bool> m_accepting;
   std::vector<size_t> m_errorsMade;
 };
@@ -0,0 +1,51 @@
+#include "base/levenshtein_dfa_cache.hpp"
+
+#include "base/assert.hpp"
+
+#include <utility>
+
+namespace strings
+{
+// static
+size_t constexpr LevenshteinDFACache::kDefaultMaxSize;
+
+LevenshteinDFACache::LevenshteinDFACache(size_t maxSize) : m_maxSize(maxSize)
+{
+  CHECK_GREATER(m_maxSize, 0, ());
+}
+
+LevenshteinDFA LevenshteinDFACache::Get(UniString const & s, size_t prefixCharsToKeep,
+                                        size_t maxErrors)
+{
+  Key key(s, prefixCharsToKeep, maxErrors);
+
+  {
+    std::lock_guard<std::mutex> lock(m_mu);
+    auto const it = m_dfas.find(key);
+    if (it != m_dfas.end())
+      return it->second;
+  }
+
+  // The DFA is built without the lock, so concurrent queries don't
+  // wait for each other.
+  LevenshteinDFA dfa(s, prefixCharsToKeep, maxErrors);
+
+  std::lock_guard<std::mutex> lock(m_mu);
+  if (m_dfas.size() >= m_maxSize)
+    m_dfas.clear();
+  m_dfas.emplace(std::move(key), dfa);
+  return dfa;
+}
+
+size_t LevenshteinDFACache::GetSize() const
+{
+  std::lock_guard<std::mutex> lock(m_mu);
+  return m_dfas.size();
+}
+
+void LevenshteinDFACache::Clear()
+{
+  std::lock_guard<std::mutex> lock(m_mu);
+  m_dfas.clear();
+}
+}  // namespace strings
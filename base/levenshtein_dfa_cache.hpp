@@ -0,0 +1,42 @@
+#pragma once
+
+#include "base/levenshtein_dfa.hpp"
+#include "base/string_utils.hpp"
+
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <tuple>
+
+namespace strings
+{
+// Cache of compiled LevenshteinDFAs. Construction of a DFA is much
+// more expensive than a copy of its tables, and the same automata
+// are built again and again for the tokens of a query: for every
+// mwm, for every ranked feature and for type-ahead queries.
+//
+// When the cache is full, it's cleared entirely: the tokens of the
+// current query are compiled again right away.
+//
+// *NOTE* The class *IS* thread-safe.
+class LevenshteinDFACache
+{
+public:
+  static size_t constexpr kDefaultMaxSize = 256;
+
+  explicit LevenshteinDFACache(size_t maxSize = kDefaultMaxSize);
+
+  LevenshteinDFA Get(UniString const & s, size_t prefixCharsToKeep, size_t maxErrors);
+
+  size_t GetSize() const;
+  void Clear();
+
+private:
+  using Key = std::tuple<UniString, size_t, size_t>;
+
+  size_t const m_maxSize;
+
+  mutable std::mutex m_mu;
+  std::map<Key, LevenshteinDFA> m_dfas;
+};
+}  // namespace strings
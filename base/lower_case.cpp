@@ -177,10 +177,31 @@ static size_t w(UniChar c, UniChar * buf)
 void MakeLowerCaseInplace(UniString & s)
 {
   size_t const size = s.size();
+  UniChar * const data = s.data();
+
+  if (impl::MaxChar(data, size) < 0x80)
+  {
+    impl::LowerASCIIChars(data, size);
+    return;
+  }
+
+  // Most chars are folded to one char, so the string is changed inplace
+  // until the first char which is folded to several chars.
+  size_t i = 0;
+  for (; i < size; ++i)
+  {
+    UniChar const c = LowerUniChar(data[i]);
+    if (c == 0)
+      break;
+    data[i] = c;
+  }
+  if (i == size)
+    return;
 
   UniString r;
-  r.reserve(size);
-  for (size_t i = 0; i < size; ++i)
+  r.reserve(size + 2);
+  r.append(s.begin(), s.begin() + i);
+  for (; i < size; ++i)
   {
     UniChar const c = LowerUniChar(s[i]);
     if (c != 0)
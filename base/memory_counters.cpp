@@ -0,0 +1,54 @@
+#include "base/memory_counters.hpp"
+
+#include "base/assert.hpp"
+
+namespace base
+{
+// static
+MemoryCounters & MemoryCounters::Instance()
+{
+  static MemoryCounters counters;
+  return counters;
+}
+
+std::map<std::string, uint64_t> MemoryCounters::GetSnapshot() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_counters;
+}
+
+uint64_t MemoryCounters::GetTotal() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  uint64_t total = 0;
+  for (auto const & counter : m_counters)
+    total += counter.second;
+  return total;
+}
+
+void MemoryCounters::Add(std::string const & name, uint64_t bytes)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_counters[name] += bytes;
+}
+
+void MemoryCounters::Subtract(std::string const & name, uint64_t bytes)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto it = m_counters.find(name);
+  CHECK(it != m_counters.end(), (name));
+  ASSERT_GREATER_OR_EQUAL(it->second, bytes, (name));
+  it->second -= bytes;
+  if (it->second == 0)
+    m_counters.erase(it);
+}
+
+void MemoryCounter::Set(uint64_t bytes)
+{
+  if (bytes > m_bytes)
+    MemoryCounters::Instance().Add(m_name, bytes - m_bytes);
+  else if (bytes < m_bytes)
+    MemoryCounters::Instance().Subtract(m_name, m_bytes - bytes);
+  m_bytes = bytes;
+}
+}  // namespace base
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "base/macros.hpp"
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+
+namespace base
+{
+// Process-wide registry of bytes of memory which are held by subsystems,
+// e.g. by the cache of mwm values or by routing graphs. Subsystems report
+// their memory by MemoryCounter, so the registry may be read from any
+// thread without touching structures of subsystems. Counters with the same
+// name are summed, e.g. caches of several search threads.
+class MemoryCounters
+{
+public:
+  static MemoryCounters & Instance();
+
+  // Returns bytes by names of counters, zero counters are skipped.
+  std::map<std::string, uint64_t> GetSnapshot() const;
+  uint64_t GetTotal() const;
+
+private:
+  friend class MemoryCounter;
+
+  MemoryCounters() = default;
+
+  void Add(std::string const & name, uint64_t bytes);
+  void Subtract(std::string const & name, uint64_t bytes);
+
+  mutable std::mutex m_mutex;
+  std::map<std::string, uint64_t> m_counters;
+
+  DISALLOW_COPY_AND_MOVE(MemoryCounters);
+};
+
+// Memory of one object of a subsystem, e.g. of a cache. The object sets
+// its memory when it changes, the memory is removed from the registry on
+// destruction of the counter. Set() isn't synchronized, the owner calls it
+// under its own synchronization.
+class MemoryCounter
+{
+public:
+  explicit MemoryCounter(std::string const & name) : m_name(name) {}
+  ~MemoryCounter() { Set(0); }
+
+  void Set(uint64_t bytes);
+  uint64_t Get() const { return m_bytes; }
+
+private:
+  std::string const m_name;
+  uint64_t m_bytes = 0;
+
+  DISALLOW_COPY_AND_MOVE(MemoryCounter);
+};
+}  // namespace base
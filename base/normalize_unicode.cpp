@@ -22,6 +22,10 @@ void NormalizeInplace(strings::UniString & s)
 {
   size_t const size = s.size();
 
+  // Strings without chars which can be decomposed are kept as is.
+  if (impl::MaxChar(s.data(), size) < 0xa0)
+    return;
+
   strings::UniString r;
   r.reserve(size);
   for (size_t i = 0; i < size; ++i)
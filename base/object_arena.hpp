@@ -0,0 +1,81 @@
+#pragma once
+
+#include "base/assert.hpp"
+#include "base/macros.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace base
+{
+// A monotonic arena of objects of type |T|.
+//
+// Objects are constructed in chunks of |ChunkSize| preallocated
+// slots and are never freed one by one: Clear() destroys all of them
+// at once but keeps the chunks for reuse. Therefore, when the arena
+// is reused for similar workloads (e.g. search queries), Emplace()
+// doesn't touch the heap allocator after a warm-up.
+//
+// Pointers returned by Emplace() are stable until Clear() or
+// Release().
+//
+// *NOTE* This class *IS NOT* thread safe.
+template <typename T, size_t ChunkSize = 256>
+class ObjectArena
+{
+public:
+  static_assert(ChunkSize > 0, "");
+
+  ObjectArena() = default;
+  ~ObjectArena() { Clear(); }
+
+  template <typename... Args>
+  T * Emplace(Args &&... args)
+  {
+    if (m_size == m_chunks.size() * ChunkSize)
+      m_chunks.emplace_back(new Slot[ChunkSize]);
+
+    void * place = &m_chunks[m_size / ChunkSize][m_size % ChunkSize];
+    T * object = new (place) T(std::forward<Args>(args)...);
+    ++m_size;
+    return object;
+  }
+
+  // Destroys all objects. Memory is kept for the next objects.
+  void Clear()
+  {
+    for (size_t i = 0; i < m_size; ++i)
+      Get(i)->~T();
+    m_size = 0;
+  }
+
+  // Destroys all objects and frees all memory.
+  void Release()
+  {
+    Clear();
+    m_chunks.clear();
+    m_chunks.shrink_to_fit();
+  }
+
+  size_t Size() const { return m_size; }
+  size_t Capacity() const { return m_chunks.size() * ChunkSize; }
+
+private:
+  using Slot = typename std::aligned_storage<sizeof(T), alignof(T)>::type;
+
+  T * Get(size_t i)
+  {
+    ASSERT_LESS(i, m_size, ());
+    return reinterpret_cast<T *>(&m_chunks[i / ChunkSize][i % ChunkSize]);
+  }
+
+  std::vector<std::unique_ptr<Slot[]>> m_chunks;
+  size_t m_size = 0;
+
+  DISALLOW_COPY_AND_MOVE(ObjectArena);
+};
+}  // namespace base
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "base/cache_registry.hpp"
 #include "base/mutex.hpp"
 
 #include <list>
@@ -19,6 +20,9 @@ private:
   threads::Mutex m_mutex;
   shared_buffers_t m_sharedBuffers;
 
+  base::SheddableCache m_reservedShedding{"shared_buffers", base::CacheRegistry::Priority::Low,
+                                          [this]() { clearReserved(); }};
+
 public:
   static SharedBufferManager & instance();
 
@@ -129,6 +129,12 @@ UniString MakeLowerCase(UniString const & s)
 
 void MakeLowerCaseInplace(std::string & s)
 {
+  if (IsASCIIString(s))
+  {
+    impl::LowerASCIIChars(&s[0], s.size());
+    return;
+  }
+
   UniString uniStr;
   utf8::unchecked::utf8to32(s.begin(), s.end(), std::back_inserter(uniStr));
   MakeLowerCaseInplace(uniStr);
@@ -238,10 +244,11 @@ std::string ToUtf8(UniString const & s)
 
 bool IsASCIIString(std::string const & str)
 {
+  // No early exits, so the loop is vectorized.
+  char bits = 0;
   for (size_t i = 0; i < str.size(); ++i)
-    if (str[i] & 0x80)
-      return false;
-  return true;
+    bits |= str[i];
+  return (bits & 0x80) == 0;
 }
 
 bool IsASCIIDigit(UniChar c) { return c >= '0' && c <= '9'; }
@@ -51,6 +51,32 @@ public:
   }
 };
 
+namespace impl
+{
+// Fast paths for ASCII strings. Loops have no early exits and table lookups,
+// so they are vectorized by compilers.
+
+template <typename Char>
+Char MaxChar(Char const * s, size_t n)
+{
+  Char m = 0;
+  for (size_t i = 0; i < n; ++i)
+    m = std::max(m, s[i]);
+  return m;
+}
+
+template <typename Char>
+void LowerASCIIChars(Char * s, size_t n)
+{
+  using UChar = typename std::make_unsigned<Char>::type;
+  for (size_t i = 0; i < n; ++i)
+  {
+    Char const c = s[i];
+    s[i] = static_cast<Char>(c + (static_cast<Char>(static_cast<UChar>(c - 'A') < 26) << 5));
+  }
+}
+}  // namespace impl
+
 /// Performs full case folding for string to make it search-compatible according
 /// to rules in ftp://ftp.unicode.org/Public/UNIDATA/CaseFolding.txt
 /// For implementation @see base/lower_case.cpp
@@ -0,0 +1,239 @@
+#include "base/task_executor.hpp"
+
+#include "base/assert.hpp"
+#include "base/thread.hpp"
+#include "base/work_stealing_thread_pool.hpp"
+
+#include <atomic>
+#include <deque>
+
+namespace threads
+{
+namespace detail
+{
+TaskStateBase::Status TaskStateBase::GetStatus() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_status;
+}
+
+std::exception_ptr TaskStateBase::GetException() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_exception;
+}
+
+void TaskStateBase::Wait() const
+{
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_cv.wait(lock, [this]() { return m_status != Status::Pending; });
+}
+
+void TaskStateBase::AddContinuation(std::function<void()> && fn)
+{
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_status == Status::Pending)
+    {
+      m_continuations.push_back(std::move(fn));
+      return;
+    }
+  }
+  fn();
+}
+
+void TaskStateBase::SetFailed(std::exception_ptr exception)
+{
+  Finish(Status::Failed, exception);
+}
+
+void TaskStateBase::SetCancelled()
+{
+  Cancel();
+  Finish(Status::Cancelled);
+}
+
+void TaskStateBase::CheckDone() const
+{
+  Wait();
+  switch (GetStatus())
+  {
+  case Status::Pending: ASSERT(false, ()); break;
+  case Status::Done: break;
+  case Status::Failed: std::rethrow_exception(GetException());
+  case Status::Cancelled: MYTHROW(TaskCancelledException, ("Task is cancelled."));
+  }
+}
+
+void TaskStateBase::Finish(Status status, std::exception_ptr exception)
+{
+  std::vector<std::function<void()>> continuations;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_status != Status::Pending)
+      return;
+    m_status = status;
+    m_exception = exception;
+    continuations.swap(m_continuations);
+  }
+  m_cv.notify_all();
+
+  // Continuations are called without the lock, as they may finish other tasks.
+  for (auto & continuation : continuations)
+    continuation();
+}
+}  // namespace detail
+
+namespace
+{
+struct Task
+{
+  TaskHandle m_state;
+  std::vector<TaskHandle> m_dependencies;
+  std::function<void()> m_run;
+};
+
+void RunTask(Task & task)
+{
+  auto & state = *task.m_state;
+  if (state.IsCancelled())
+  {
+    state.SetCancelled();
+    return;
+  }
+
+  for (auto const & dependency : task.m_dependencies)
+  {
+    switch (dependency->GetStatus())
+    {
+    case detail::TaskStateBase::Status::Pending: ASSERT(false, ()); break;
+    case detail::TaskStateBase::Status::Done: break;
+    case detail::TaskStateBase::Status::Failed: state.SetFailed(dependency->GetException()); return;
+    case detail::TaskStateBase::Status::Cancelled: state.SetCancelled(); return;
+    }
+  }
+
+  task.m_run();
+}
+}  // namespace
+
+// Tasks which are ready to run are kept in lanes by priorities. Every ready task pushes
+// a token to the pool, and a token runs the first task of the highest non-empty lane,
+// so the pool is free to steal tokens while priorities are kept.
+class TaskExecutor::Impl
+{
+public:
+  explicit Impl(size_t threadsCount)
+    : m_pool(threadsCount, [](IRoutine * routine) { delete routine; })
+  {
+  }
+
+  void Schedule(std::shared_ptr<Task> const & task, Priority priority)
+  {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      if (!m_stopped)
+      {
+        (priority == Priority::High ? m_high : m_normal).push_back(task);
+        m_pool.PushBack(new Token(*this));
+        return;
+      }
+    }
+    task->m_state->SetCancelled();
+  }
+
+  void Stop()
+  {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      if (m_stopped)
+        return;
+      m_stopped = true;
+    }
+    m_pool.Stop();
+
+    std::deque<std::shared_ptr<Task>> tasks;
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      tasks.swap(m_high);
+      tasks.insert(tasks.end(), m_normal.begin(), m_normal.end());
+      m_normal.clear();
+    }
+    for (auto const & task : tasks)
+      task->m_state->SetCancelled();
+  }
+
+private:
+  class Token : public IRoutine
+  {
+  public:
+    // The pool is owned by |impl| and joined before it's destroyed, so a raw reference is enough.
+    explicit Token(Impl & impl) : m_impl(impl) {}
+
+    // IRoutine overrides:
+    void Do() override { m_impl.RunNext(); }
+
+  private:
+    Impl & m_impl;
+  };
+
+  void RunNext()
+  {
+    std::shared_ptr<Task> task;
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      auto & lane = m_high.empty() ? m_normal : m_high;
+      if (lane.empty())
+        return;
+      task = lane.front();
+      lane.pop_front();
+    }
+    RunTask(*task);
+  }
+
+  std::mutex m_mutex;
+  std::deque<std::shared_ptr<Task>> m_high;
+  std::deque<std::shared_ptr<Task>> m_normal;
+  bool m_stopped = false;
+
+  WorkStealingThreadPool m_pool;
+};
+
+TaskExecutor::TaskExecutor(size_t threadsCount) : m_impl(std::make_shared<Impl>(threadsCount)) {}
+
+TaskExecutor::~TaskExecutor() { Stop(); }
+
+void TaskExecutor::Stop() { m_impl->Stop(); }
+
+void TaskExecutor::Add(TaskHandle const & state, std::vector<TaskHandle> const & dependencies,
+                       std::function<void()> && run, Priority priority)
+{
+  auto task = std::make_shared<Task>();
+  task->m_state = state;
+  task->m_dependencies = dependencies;
+  task->m_run = std::move(run);
+
+  if (dependencies.empty())
+  {
+    m_impl->Schedule(task, priority);
+    return;
+  }
+
+  // Continuations keep a weak pointer, so tasks which depend on tasks of a destroyed
+  // executor are cancelled instead of keeping the executor alive.
+  std::weak_ptr<Impl> weakImpl = m_impl;
+  auto remaining = std::make_shared<std::atomic<size_t>>(dependencies.size());
+  for (auto const & dependency : dependencies)
+  {
+    ASSERT(dependency, ());
+    dependency->AddContinuation([weakImpl, task, remaining, priority]() {
+      if (--*remaining != 0)
+        return;
+      if (auto impl = weakImpl.lock())
+        impl->Schedule(task, priority);
+      else
+        task->m_state->SetCancelled();
+    });
+  }
+}
+}  // namespace threads
@@ -0,0 +1,261 @@
+#pragma once
+
+#include "base/cancellable.hpp"
+#include "base/exception.hpp"
+#include "base/macros.hpp"
+
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace threads
+{
+DECLARE_EXCEPTION(TaskCancelledException, RootException);
+
+namespace detail
+{
+// Shared state of a task and its futures. A task is cancellable by its futures, the task
+// itself gets its state as my::Cancellable to check it.
+class TaskStateBase : public my::Cancellable
+{
+public:
+  enum class Status
+  {
+    Pending,
+    Done,
+    Failed,
+    Cancelled
+  };
+
+  Status GetStatus() const;
+  bool IsReady() const { return GetStatus() != Status::Pending; }
+  std::exception_ptr GetException() const;
+
+  void Wait() const;
+
+  // Calls |fn| when the task is finished, or immediately when it's finished already.
+  void AddContinuation(std::function<void()> && fn);
+
+  void SetFailed(std::exception_ptr exception);
+  void SetCancelled();
+
+protected:
+  // Waits for the task and throws its exception when it isn't done.
+  void CheckDone() const;
+
+  // Sets |status| and calls continuations. Does nothing when the task is finished already.
+  void Finish(Status status, std::exception_ptr exception = std::exception_ptr());
+
+  mutable std::mutex m_mutex;
+  mutable std::condition_variable m_cv;
+  Status m_status = Status::Pending;
+  std::exception_ptr m_exception;
+  std::vector<std::function<void()>> m_continuations;
+};
+
+template <typename T>
+class TaskState : public TaskStateBase
+{
+public:
+  void SetValue(T && value)
+  {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      if (m_status != Status::Pending)
+        return;
+      m_value.reset(new T(std::move(value)));
+    }
+    Finish(Status::Done);
+  }
+
+  T const & GetValue() const
+  {
+    CheckDone();
+    return *m_value;
+  }
+
+private:
+  std::unique_ptr<T> m_value;
+};
+
+template <>
+class TaskState<void> : public TaskStateBase
+{
+public:
+  void SetValue() { Finish(Status::Done); }
+  void GetValue() const { CheckDone(); }
+};
+
+// Runs |fn| and sets its result to |state|. A task which is cancelled while it's running
+// is cancelled, whatever it returns.
+template <typename R>
+struct TaskRunner
+{
+  template <typename Fn>
+  static void Run(TaskState<R> & state, Fn & fn)
+  {
+    R result = fn(static_cast<my::Cancellable const &>(state));
+    if (state.IsCancelled())
+      state.SetCancelled();
+    else
+      state.SetValue(std::move(result));
+  }
+};
+
+template <>
+struct TaskRunner<void>
+{
+  template <typename Fn>
+  static void Run(TaskState<void> & state, Fn & fn)
+  {
+    fn(static_cast<my::Cancellable const &>(state));
+    if (state.IsCancelled())
+      state.SetCancelled();
+    else
+      state.SetValue();
+  }
+};
+
+template <typename T>
+struct TaskResult
+{
+  using Type = T const &;
+};
+
+template <>
+struct TaskResult<void>
+{
+  using Type = void;
+};
+}  // namespace detail
+
+using TaskHandle = std::shared_ptr<detail::TaskStateBase>;
+
+// Result of a task of TaskExecutor.
+template <typename T>
+class TaskFuture
+{
+public:
+  TaskFuture() = default;
+  explicit TaskFuture(std::shared_ptr<detail::TaskState<T>> const & state) : m_state(state) {}
+
+  bool IsValid() const { return static_cast<bool>(m_state); }
+  bool IsReady() const { return m_state->IsReady(); }
+  void Wait() const { m_state->Wait(); }
+
+  // Waits for the task and returns its result. Rethrows an exception of the task,
+  // throws TaskCancelledException when the task is cancelled.
+  typename detail::TaskResult<T>::Type Get() const { return m_state->GetValue(); }
+
+  // A task which isn't started yet won't be run, a running task may check
+  // its my::Cancellable. Tasks which depend on the task are cancelled too.
+  void Cancel() const { m_state->Cancel(); }
+
+  TaskHandle GetHandle() const { return m_state; }
+
+private:
+  std::shared_ptr<detail::TaskState<T>> m_state;
+};
+
+// Executor of tasks with dependencies on a work stealing thread pool. Task functions get
+// my::Cancellable const & of the task as the last argument and return the result of the task.
+// A task runs when all its dependencies are done. When a dependency fails or is cancelled,
+// the task fails the same way without running.
+//
+// High priority tasks which are ready to run go before all normal priority ones.
+//
+// *NOTE* Tasks must not wait for futures of other tasks of the executor, use dependencies
+// instead. This class is thread-safe.
+class TaskExecutor
+{
+public:
+  enum class Priority
+  {
+    High,
+    Normal
+  };
+
+  explicit TaskExecutor(size_t threadsCount);
+  // Stops the executor.
+  ~TaskExecutor();
+
+  // Runs |fn(cancellable)|.
+  template <typename Fn>
+  TaskFuture<typename std::result_of<Fn(my::Cancellable const &)>::type> Submit(
+      Fn && fn, Priority priority = Priority::Normal)
+  {
+    using R = typename std::result_of<Fn(my::Cancellable const &)>::type;
+    return AddTask<R>(std::forward<Fn>(fn), {} /* dependencies */, priority);
+  }
+
+  // Runs |fn(dependency.Get(), cancellable)| when |dependency| is done.
+  template <typename T, typename Fn>
+  TaskFuture<typename std::result_of<Fn(T const &, my::Cancellable const &)>::type> Then(
+      TaskFuture<T> const & dependency, Fn && fn, Priority priority = Priority::Normal)
+  {
+    using R = typename std::result_of<Fn(T const &, my::Cancellable const &)>::type;
+    typename std::decay<Fn>::type f(std::forward<Fn>(fn));
+    return AddTask<R>([dependency, f](my::Cancellable const & cancellable) mutable {
+      return f(dependency.Get(), cancellable);
+    }, {dependency.GetHandle()}, priority);
+  }
+
+  // Runs |fn(cancellable)| when |dependency| is done.
+  template <typename Fn>
+  TaskFuture<typename std::result_of<Fn(my::Cancellable const &)>::type> Then(
+      TaskFuture<void> const & dependency, Fn && fn, Priority priority = Priority::Normal)
+  {
+    using R = typename std::result_of<Fn(my::Cancellable const &)>::type;
+    return AddTask<R>(std::forward<Fn>(fn), {dependency.GetHandle()}, priority);
+  }
+
+  // Runs |fn(cancellable)| when all |dependencies| are done.
+  template <typename Fn>
+  TaskFuture<typename std::result_of<Fn(my::Cancellable const &)>::type> WhenAll(
+      std::vector<TaskHandle> const & dependencies, Fn && fn, Priority priority = Priority::Normal)
+  {
+    using R = typename std::result_of<Fn(my::Cancellable const &)>::type;
+    return AddTask<R>(std::forward<Fn>(fn), dependencies, priority);
+  }
+
+  // Waits for running tasks and cancels all other ones. Tasks added after Stop()
+  // are cancelled immediately.
+  void Stop();
+
+private:
+  class Impl;
+
+  template <typename R, typename Fn>
+  TaskFuture<R> AddTask(Fn && fn, std::vector<TaskHandle> const & dependencies, Priority priority)
+  {
+    auto state = std::make_shared<detail::TaskState<R>>();
+    typename std::decay<Fn>::type f(std::forward<Fn>(fn));
+    detail::TaskState<R> * const rawState = state.get();
+    Add(state, dependencies, [rawState, f]() mutable {
+      try
+      {
+        detail::TaskRunner<R>::Run(*rawState, f);
+      }
+      catch (...)
+      {
+        rawState->SetFailed(std::current_exception());
+      }
+    }, priority);
+    return TaskFuture<R>(state);
+  }
+
+  // |run| is called while the task keeps |state|.
+  void Add(TaskHandle const & state, std::vector<TaskHandle> const & dependencies,
+           std::function<void()> && run, Priority priority);
+
+  std::shared_ptr<Impl> m_impl;
+
+  DISALLOW_COPY_AND_MOVE(TaskExecutor);
+};
+}  // namespace threads
@@ -3,12 +3,14 @@
 #include "base/base.hpp"
 
 #include <functional>
+#include <list>
 
 namespace threads
 {
   class IRoutine;
 
   typedef std::function<void(threads::IRoutine *)> TFinishRoutineFn;
+  typedef std::function<void(std::list<threads::IRoutine *> &)> TProcessTasksFn;
 
   class ThreadPool
   {
@@ -19,6 +21,12 @@ namespace threads
     // ThreadPool will not delete routine. You can delete it in finish_routine_fn if need
     void PushBack(threads::IRoutine * routine);
     void PushFront(threads::IRoutine * routine);
+
+    // Calls |fn| under the lock with the list of routines which are not
+    // started yet, e.g. to reorder them. |fn| must not add or remove
+    // routines.
+    void ProcessTasks(TProcessTasksFn const & fn);
+
     void Stop();
 
   private:
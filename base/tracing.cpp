@@ -0,0 +1,291 @@
+#include "base/tracing.hpp"
+
+#include "base/assert.hpp"
+#include "base/bits.hpp"
+#include "base/stl_add.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <ostream>
+#include <thread>
+
+namespace my
+{
+namespace tracing
+{
+namespace
+{
+void WriteString(std::ostream & out, char const * s)
+{
+  out << '"';
+  for (; s && *s; ++s)
+  {
+    char const c = *s;
+    switch (c)
+    {
+    case '"': out << "\\\""; break;
+    case '\\': out << "\\\\"; break;
+    case '\n': out << "\\n"; break;
+    case '\t': out << "\\t"; break;
+    default:
+      if (static_cast<unsigned char>(c) < 0x20)
+      {
+        out << "\\u" << std::hex << std::setw(4) << std::setfill('0')
+            << static_cast<int>(c) << std::dec << std::setfill(' ');
+      }
+      else
+      {
+        out << c;
+      }
+    }
+  }
+  out << '"';
+}
+
+// Chrome trace times are in microseconds.
+void WriteMicros(std::ostream & out, uint64_t ns)
+{
+  out << ns / 1000 << '.' << std::setw(3) << std::setfill('0') << ns % 1000 << std::setfill(' ');
+}
+}  // namespace
+
+// Counter -----------------------------------------------------------------------------------------
+Counter::Counter(char const * name) : m_name(name), m_value(0)
+{
+  Tracer::Instance().Register(this);
+}
+
+Counter::~Counter() { Tracer::Instance().Unregister(this); }
+
+// Histogram ---------------------------------------------------------------------------------------
+size_t constexpr Histogram::kBucketsCount;
+
+Histogram::Histogram(char const * name) : m_name(name), m_count(0), m_sum(0)
+{
+  for (auto & bucket : m_buckets)
+    bucket = 0;
+  Tracer::Instance().Register(this);
+}
+
+Histogram::~Histogram() { Tracer::Instance().Unregister(this); }
+
+void Histogram::Add(uint64_t value)
+{
+  m_count.fetch_add(1, std::memory_order_relaxed);
+  m_sum.fetch_add(value, std::memory_order_relaxed);
+  m_buckets[GetBucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+}
+
+// static
+size_t Histogram::GetBucketIndex(uint64_t value)
+{
+  return value == 0 ? 0 : bits::FloorLog(value) + 1;
+}
+
+// Tracer ------------------------------------------------------------------------------------------
+size_t constexpr Tracer::kMaxThreads;
+size_t constexpr Tracer::kDefaultBufferCapacity;
+
+struct Tracer::Buffer
+{
+  explicit Buffer(uint32_t index) : m_index(index), m_key(0) {}
+
+  uint32_t const m_index;
+  // Hash of the id of the thread which owns the buffer, zero for free buffers.
+  std::atomic<size_t> m_key;
+
+  // The mutex is locked by the owner on every span, so it's almost never contended.
+  std::mutex m_mutex;
+  // Ring of spans, it's allocated on the first span.
+  std::vector<SpanEvent> m_events;
+  uint64_t m_written = 0;
+};
+
+Tracer::Tracer(size_t bufferCapacity)
+  : m_bufferCapacity(std::max(bufferCapacity, static_cast<size_t>(1))), m_enabled(false), m_dropped(0)
+{
+  for (size_t i = 0; i < m_buffers.size(); ++i)
+    m_buffers[i] = my::make_unique<Buffer>(static_cast<uint32_t>(i));
+}
+
+Tracer::~Tracer() = default;
+
+// static
+Tracer & Tracer::Instance()
+{
+  static Tracer tracer;
+  return tracer;
+}
+
+// static
+uint64_t Tracer::NowNs()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+Tracer::Buffer * Tracer::GetBuffer()
+{
+  // Ids of running threads are distinct, and so are their hashes for all standard
+  // libraries we use.
+  size_t key = std::hash<std::thread::id>()(std::this_thread::get_id());
+  if (key == 0)
+    key = 1;
+
+  size_t const start = key % kMaxThreads;
+  for (size_t i = 0; i < kMaxThreads; ++i)
+  {
+    Buffer & buffer = *m_buffers[(start + i) % kMaxThreads];
+    size_t k = buffer.m_key.load(std::memory_order_acquire);
+    if (k == 0 && buffer.m_key.compare_exchange_strong(k, key, std::memory_order_acq_rel))
+      return &buffer;
+    if (k == key)
+      return &buffer;
+  }
+  return nullptr;
+}
+
+void Tracer::AddSpan(char const * category, char const * name, uint64_t startNs,
+                     uint64_t durationNs)
+{
+  Buffer * buffer = GetBuffer();
+  if (!buffer)
+  {
+    m_dropped.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(buffer->m_mutex);
+  if (buffer->m_events.empty())
+    buffer->m_events.resize(m_bufferCapacity);
+  if (buffer->m_written >= m_bufferCapacity)
+    m_dropped.fetch_add(1, std::memory_order_relaxed);
+
+  SpanEvent & e = buffer->m_events[buffer->m_written % m_bufferCapacity];
+  e.m_category = category;
+  e.m_name = name;
+  e.m_startNs = startNs;
+  e.m_durationNs = durationNs;
+  e.m_threadIndex = buffer->m_index;
+  ++buffer->m_written;
+}
+
+std::vector<SpanEvent> Tracer::GetSpans() const
+{
+  std::vector<SpanEvent> spans;
+  for (auto const & buffer : m_buffers)
+  {
+    std::lock_guard<std::mutex> lock(buffer->m_mutex);
+    uint64_t const count = std::min(buffer->m_written, static_cast<uint64_t>(m_bufferCapacity));
+    for (uint64_t i = buffer->m_written - count; i < buffer->m_written; ++i)
+      spans.push_back(buffer->m_events[i % m_bufferCapacity]);
+  }
+
+  std::stable_sort(spans.begin(), spans.end(), [](SpanEvent const & lhs, SpanEvent const & rhs) {
+    return lhs.m_startNs < rhs.m_startNs;
+  });
+  return spans;
+}
+
+void Tracer::Clear()
+{
+  for (auto const & buffer : m_buffers)
+  {
+    std::lock_guard<std::mutex> lock(buffer->m_mutex);
+    buffer->m_written = 0;
+  }
+  m_dropped = 0;
+}
+
+void Tracer::Register(Counter * counter)
+{
+  ASSERT(counter, ());
+  std::lock_guard<std::mutex> lock(m_registryMutex);
+  m_counters.push_back(counter);
+}
+
+void Tracer::Unregister(Counter * counter)
+{
+  std::lock_guard<std::mutex> lock(m_registryMutex);
+  m_counters.erase(std::remove(m_counters.begin(), m_counters.end(), counter), m_counters.end());
+}
+
+void Tracer::Register(Histogram * histogram)
+{
+  ASSERT(histogram, ());
+  std::lock_guard<std::mutex> lock(m_registryMutex);
+  m_histograms.push_back(histogram);
+}
+
+void Tracer::Unregister(Histogram * histogram)
+{
+  std::lock_guard<std::mutex> lock(m_registryMutex);
+  m_histograms.erase(std::remove(m_histograms.begin(), m_histograms.end(), histogram),
+                     m_histograms.end());
+}
+
+void Tracer::ExportChromeTrace(std::ostream & out) const
+{
+  bool first = true;
+  auto const startEvent = [&]() {
+    out << (first ? "\n" : ",\n");
+    first = false;
+  };
+
+  out << "{\"traceEvents\":[";
+  for (auto const & span : GetSpans())
+  {
+    startEvent();
+    out << "{\"ph\":\"X\",\"pid\":0,\"tid\":" << span.m_threadIndex << ",\"cat\":";
+    WriteString(out, span.m_category);
+    out << ",\"name\":";
+    WriteString(out, span.m_name);
+    out << ",\"ts\":";
+    WriteMicros(out, span.m_startNs);
+    out << ",\"dur\":";
+    WriteMicros(out, span.m_durationNs);
+    out << "}";
+  }
+
+  uint64_t const nowNs = NowNs();
+  std::lock_guard<std::mutex> lock(m_registryMutex);
+  for (auto const * counter : m_counters)
+  {
+    startEvent();
+    out << "{\"ph\":\"C\",\"pid\":0,\"tid\":0,\"name\":";
+    WriteString(out, counter->GetName());
+    out << ",\"ts\":";
+    WriteMicros(out, nowNs);
+    out << ",\"args\":{\"value\":" << counter->Get() << "}}";
+  }
+
+  for (auto const * histogram : m_histograms)
+  {
+    startEvent();
+    out << "{\"ph\":\"C\",\"pid\":0,\"tid\":0,\"name\":";
+    WriteString(out, histogram->GetName());
+    out << ",\"ts\":";
+    WriteMicros(out, nowNs);
+    out << ",\"args\":{\"count\":" << histogram->GetCount() << ",\"sum\":" << histogram->GetSum();
+    for (size_t i = 0; i < Histogram::kBucketsCount; ++i)
+    {
+      uint64_t const count = histogram->GetBucket(i);
+      if (count == 0)
+        continue;
+      // Buckets are named by their upper bounds.
+      out << ",\"<";
+      if (i == Histogram::kBucketsCount - 1)
+        out << "inf";
+      else
+        out << (static_cast<uint64_t>(1) << i);
+      out << "\":" << count;
+    }
+    out << "}}";
+  }
+  out << "\n],\"displayTimeUnit\":\"ms\"}\n";
+}
+}  // namespace tracing
+}  // namespace my
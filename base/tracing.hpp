@@ -0,0 +1,182 @@
+#pragma once
+
+#include "base/macros.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace my
+{
+namespace tracing
+{
+// A finished span. Names are not copied, so they must be string literals or
+// outlive the tracer.
+struct SpanEvent
+{
+  char const * m_category = nullptr;
+  char const * m_name = nullptr;
+  uint64_t m_startNs = 0;
+  uint64_t m_durationNs = 0;
+  uint32_t m_threadIndex = 0;
+};
+
+// Monotonic named counter. Counters are usually static objects, they register themselves
+// in Tracer::Instance() and are exported with spans.
+class Counter
+{
+public:
+  explicit Counter(char const * name);
+  ~Counter();
+
+  void Add(uint64_t delta = 1) { m_value.fetch_add(delta, std::memory_order_relaxed); }
+  uint64_t Get() const { return m_value.load(std::memory_order_relaxed); }
+  char const * GetName() const { return m_name; }
+
+private:
+  char const * const m_name;
+  std::atomic<uint64_t> m_value;
+
+  DISALLOW_COPY_AND_MOVE(Counter);
+};
+
+// Histogram of values with power-of-two buckets: bucket 0 is for zeros and bucket i > 0
+// is for values in [2^(i - 1), 2^i). Registers itself in Tracer::Instance() as Counter does.
+class Histogram
+{
+public:
+  static size_t constexpr kBucketsCount = 65;
+
+  explicit Histogram(char const * name);
+  ~Histogram();
+
+  void Add(uint64_t value);
+
+  uint64_t GetCount() const { return m_count.load(std::memory_order_relaxed); }
+  uint64_t GetSum() const { return m_sum.load(std::memory_order_relaxed); }
+  uint64_t GetBucket(size_t bucket) const
+  {
+    return m_buckets[bucket].load(std::memory_order_relaxed);
+  }
+  char const * GetName() const { return m_name; }
+
+  static size_t GetBucketIndex(uint64_t value);
+
+private:
+  char const * const m_name;
+  std::atomic<uint64_t> m_count;
+  std::atomic<uint64_t> m_sum;
+  std::array<std::atomic<uint64_t>, kBucketsCount> m_buckets;
+
+  DISALLOW_COPY_AND_MOVE(Histogram);
+};
+
+// Collects spans to per-thread ring buffers, so threads don't contend while tracing, and
+// old spans are overwritten when a buffer is full. Tracing is disabled by default, then
+// a span costs a relaxed load only.
+//
+// Buffers are found by thread ids among kMaxThreads slots without a global lock. Spans of
+// threads which come when all slots are taken are dropped.
+//
+// *NOTE* This class is thread-safe.
+class Tracer
+{
+public:
+  static size_t constexpr kMaxThreads = 256;
+  static size_t constexpr kDefaultBufferCapacity = 1 << 14;
+
+  explicit Tracer(size_t bufferCapacity = kDefaultBufferCapacity);
+  ~Tracer();
+
+  static Tracer & Instance();
+
+  // Monotonic time which is used by spans.
+  static uint64_t NowNs();
+
+  void SetEnabled(bool enabled) { m_enabled.store(enabled, std::memory_order_relaxed); }
+  bool IsEnabled() const { return m_enabled.load(std::memory_order_relaxed); }
+
+  void AddSpan(char const * category, char const * name, uint64_t startNs, uint64_t durationNs);
+
+  // Returns spans of all threads sorted by start times.
+  std::vector<SpanEvent> GetSpans() const;
+  uint64_t GetDroppedCount() const { return m_dropped.load(std::memory_order_relaxed); }
+
+  // Clears spans, counters and histograms are kept.
+  void Clear();
+
+  void Register(Counter * counter);
+  void Unregister(Counter * counter);
+  void Register(Histogram * histogram);
+  void Unregister(Histogram * histogram);
+
+  // Writes spans, counters and histograms in Chrome trace event format, which is
+  // also read by Perfetto. Spans are complete ("X") events, counters and histograms
+  // are counter ("C") events at the time of the export.
+  void ExportChromeTrace(std::ostream & out) const;
+
+private:
+  struct Buffer;
+
+  Buffer * GetBuffer();
+
+  size_t const m_bufferCapacity;
+  std::atomic<bool> m_enabled;
+  std::atomic<uint64_t> m_dropped;
+  std::array<std::unique_ptr<Buffer>, kMaxThreads> m_buffers;
+
+  mutable std::mutex m_registryMutex;
+  std::vector<Counter *> m_counters;
+  std::vector<Histogram *> m_histograms;
+
+  DISALLOW_COPY_AND_MOVE(Tracer);
+};
+
+// Adds a span from its construction to its destruction, when tracing is enabled.
+class ScopedSpan
+{
+public:
+  ScopedSpan(char const * category, char const * name)
+    : ScopedSpan(Tracer::Instance(), category, name)
+  {
+  }
+
+  ScopedSpan(Tracer & tracer, char const * category, char const * name)
+    : m_tracer(tracer), m_category(category), m_name(name)
+  {
+    if (PREDICT_FALSE(m_tracer.IsEnabled()))
+    {
+      m_enabled = true;
+      m_startNs = Tracer::NowNs();
+    }
+  }
+
+  ~ScopedSpan()
+  {
+    if (PREDICT_FALSE(m_enabled))
+      m_tracer.AddSpan(m_category, m_name, m_startNs, Tracer::NowNs() - m_startNs);
+  }
+
+private:
+  Tracer & m_tracer;
+  char const * const m_category;
+  char const * const m_name;
+  uint64_t m_startNs = 0;
+  bool m_enabled = false;
+
+  DISALLOW_COPY_AND_MOVE(ScopedSpan);
+};
+}  // namespace tracing
+}  // namespace my
+
+#define TRACE_SCOPE_IMPL2(category, name, line) \
+  ::my::tracing::ScopedSpan traceScope##line(category, name)
+#define TRACE_SCOPE_IMPL(category, name, line) TRACE_SCOPE_IMPL2(category, name, line)
+
+// Traces the rest of the current scope, e.g. TRACE_SCOPE("search", "Geocoder::GoImpl").
+#define TRACE_SCOPE(category, name) TRACE_SCOPE_IMPL(category, name, __LINE__)
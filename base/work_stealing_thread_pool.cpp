@@ -0,0 +1,190 @@
+#include "base/work_stealing_thread_pool.hpp"
+
+#include "base/assert.hpp"
+#include "base/stl_add.hpp"
+#include "base/thread.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace threads
+{
+class WorkStealingThreadPool::Impl
+{
+public:
+  Impl(size_t size, TFinishRoutineFn const & finishFn) : m_finishFn(finishFn)
+  {
+    // A pool without workers keeps routines until Stop(), so it needs
+    // a queue anyway.
+    m_queues.resize(std::max(size, static_cast<size_t>(1)));
+    for (auto & queue : m_queues)
+      queue = my::make_unique<Queue>();
+
+    m_threads.reserve(size);
+    for (size_t i = 0; i < size; ++i)
+      m_threads.emplace_back(&Impl::Work, this, i);
+  }
+
+  ~Impl() { Stop(); }
+
+  void Push(IRoutine * routine, bool front)
+  {
+    ASSERT(routine, ());
+    if (m_stopped)
+    {
+      routine->Cancel();
+      m_finishFn(routine);
+      return;
+    }
+
+    auto & queue = *m_queues[GetQueueIndex()];
+    {
+      std::lock_guard<std::mutex> lock(queue.m_mutex);
+      if (front)
+        queue.m_routines.push_front(routine);
+      else
+        queue.m_routines.push_back(routine);
+    }
+
+    // Both counters are sequentially consistent, so either a worker
+    // going to sleep sees the new routine, or the routine is pushed
+    // after the worker is counted as sleeping and it's woken up here.
+    ++m_numPending;
+    if (m_numSleeping > 0)
+    {
+      { std::lock_guard<std::mutex> lock(m_sleepMutex); }
+      m_sleepCondition.notify_one();
+    }
+  }
+
+  void Stop()
+  {
+    {
+      std::lock_guard<std::mutex> lock(m_sleepMutex);
+      if (m_stopped)
+        return;
+      m_stopped = true;
+    }
+    m_sleepCondition.notify_all();
+
+    for (auto & thread : m_threads)
+      thread.join();
+    m_threads.clear();
+
+    for (auto & queue : m_queues)
+    {
+      std::deque<IRoutine *> routines;
+      {
+        std::lock_guard<std::mutex> lock(queue->m_mutex);
+        routines.swap(queue->m_routines);
+      }
+      for (auto routine : routines)
+      {
+        routine->Cancel();
+        m_finishFn(routine);
+      }
+    }
+  }
+
+private:
+  struct Queue
+  {
+    std::mutex m_mutex;
+    std::deque<IRoutine *> m_routines;
+  };
+
+  // Returns the queue of the current worker, or the next queue in
+  // round-robin order when the current thread is not a worker.
+  size_t GetQueueIndex()
+  {
+    auto const id = std::this_thread::get_id();
+    for (size_t i = 0; i < m_threads.size(); ++i)
+    {
+      if (m_threads[i].get_id() == id)
+        return i;
+    }
+    return m_nextQueue++ % m_queues.size();
+  }
+
+  IRoutine * Pop(size_t index)
+  {
+    IRoutine * routine = nullptr;
+    {
+      auto & queue = *m_queues[index];
+      std::lock_guard<std::mutex> lock(queue.m_mutex);
+      if (!queue.m_routines.empty())
+      {
+        routine = queue.m_routines.front();
+        queue.m_routines.pop_front();
+      }
+    }
+
+    // Steals from the back of other queues, i.e. the routines their
+    // owners would take last.
+    for (size_t i = 1; !routine && i < m_queues.size(); ++i)
+    {
+      auto & queue = *m_queues[(index + i) % m_queues.size()];
+      std::lock_guard<std::mutex> lock(queue.m_mutex);
+      if (!queue.m_routines.empty())
+      {
+        routine = queue.m_routines.back();
+        queue.m_routines.pop_back();
+      }
+    }
+
+    if (routine)
+      --m_numPending;
+    return routine;
+  }
+
+  void Work(size_t index)
+  {
+    while (!m_stopped)
+    {
+      IRoutine * routine = Pop(index);
+      if (routine)
+      {
+        if (!routine->IsCancelled())
+          routine->Do();
+        m_finishFn(routine);
+        continue;
+      }
+
+      std::unique_lock<std::mutex> lock(m_sleepMutex);
+      ++m_numSleeping;
+      m_sleepCondition.wait(lock, [this]() { return m_stopped || m_numPending > 0; });
+      --m_numSleeping;
+    }
+  }
+
+  TFinishRoutineFn m_finishFn;
+
+  std::vector<std::unique_ptr<Queue>> m_queues;
+  std::vector<SimpleThread> m_threads;
+  std::atomic<size_t> m_nextQueue{0};
+
+  std::atomic<size_t> m_numPending{0};
+  std::atomic<size_t> m_numSleeping{0};
+  std::atomic<bool> m_stopped{false};
+  std::mutex m_sleepMutex;
+  std::condition_variable m_sleepCondition;
+};
+
+WorkStealingThreadPool::WorkStealingThreadPool(size_t size, TFinishRoutineFn const & finishFn)
+  : m_impl(my::make_unique<Impl>(size, finishFn))
+{
+}
+
+WorkStealingThreadPool::~WorkStealingThreadPool() { m_impl->Stop(); }
+
+void WorkStealingThreadPool::PushBack(IRoutine * routine) { m_impl->Push(routine, false /* front */); }
+
+void WorkStealingThreadPool::PushFront(IRoutine * routine) { m_impl->Push(routine, true /* front */); }
+
+void WorkStealingThreadPool::Stop() { m_impl->Stop(); }
+}  // namespace threads
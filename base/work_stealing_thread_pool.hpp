@@ -0,0 +1,45 @@
+#pragma once
+
+#include "base/macros.hpp"
+#include "base/thread_pool.hpp"
+
+#include <cstddef>
+#include <memory>
+
+namespace threads
+{
+class IRoutine;
+
+// A thread pool with the same interface as ThreadPool, but with a
+// queue of routines per worker instead of a single shared queue.
+//
+// Routines pushed from a worker go to its own queue, other routines
+// are distributed between the queues in round-robin order. A worker
+// takes routines from the front of its own queue, and when it's
+// empty, steals them from the back of the queues of other workers.
+// Therefore producers and workers contend on a queue only when the
+// pool is almost out of work.
+//
+// There is no global order of routines: PushFront() puts a routine
+// in front of the routines of one queue only.
+class WorkStealingThreadPool
+{
+public:
+  WorkStealingThreadPool(size_t size, TFinishRoutineFn const & finishFn);
+  ~WorkStealingThreadPool();
+
+  // The pool doesn't delete routines, as ThreadPool does. Routines
+  // pushed after Stop() are cancelled and finished immediately.
+  void PushBack(IRoutine * routine);
+  void PushFront(IRoutine * routine);
+
+  // Joins all workers, cancels and finishes not started routines.
+  void Stop();
+
+private:
+  class Impl;
+  std::unique_ptr<Impl> m_impl;
+
+  DISALLOW_COPY_AND_MOVE(WorkStealingThreadPool);
+};
+}  // namespace threads
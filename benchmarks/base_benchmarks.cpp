@@ -0,0 +1,70 @@
+#include "benchmarks/benchmark.hpp"
+
+#include "base/dfa_helpers.hpp"
+#include "base/levenshtein_dfa.hpp"
+#include "base/string_utils.hpp"
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace benchmarks;
+using namespace strings;
+
+namespace
+{
+std::vector<UniString> MakeWords(size_t count)
+{
+  std::mt19937 rng(0);
+  std::uniform_int_distribution<int> length(3, 12);
+  std::uniform_int_distribution<int> letter('a', 'z');
+
+  std::vector<UniString> words(count);
+  for (auto & word : words)
+  {
+    for (int i = length(rng); i > 0; --i)
+      word.push_back(static_cast<UniChar>(letter(rng)));
+  }
+  return words;
+}
+
+// Arg is the count of errors.
+void LevenshteinDFA_Build(State & state)
+{
+  auto const maxErrors = static_cast<size_t>(state.GetArg());
+  auto const words = MakeWords(256);
+
+  size_t i = 0;
+  while (state.KeepRunning())
+  {
+    LevenshteinDFA const dfa(words[i++ % words.size()], maxErrors);
+    DoNotOptimize(dfa.GetNumStates());
+  }
+  state.SetItemsProcessed(state.GetIterations());
+}
+
+// Matches a dictionary with a DFA, Arg is the count of errors.
+void LevenshteinDFA_Match(State & state)
+{
+  auto const maxErrors = static_cast<size_t>(state.GetArg());
+  auto const words = MakeWords(4096);
+  LevenshteinDFA const dfa(MakeUniString("moscow"), maxErrors);
+
+  while (state.KeepRunning())
+  {
+    size_t accepted = 0;
+    for (auto const & word : words)
+    {
+      auto it = dfa.Begin();
+      DFAMove(it, word);
+      accepted += it.Accepts() ? 1 : 0;
+    }
+    DoNotOptimize(accepted);
+  }
+  state.SetItemsProcessed(state.GetIterations() * words.size());
+}
+}  // namespace
+
+BENCHMARK(LevenshteinDFA_Build)->Arg(0)->Arg(1)->Arg(2);
+BENCHMARK(LevenshteinDFA_Match)->Arg(0)->Arg(1)->Arg(2);
@@ -0,0 +1,344 @@
+#include "benchmarks/benchmark.hpp"
+
+#include "base/assert.hpp"
+#include "base/macros.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <numeric>
+#include <regex>
+#include <sstream>
+
+namespace benchmarks
+{
+namespace
+{
+uint64_t constexpr kMaxIterations = 1000000000;
+
+struct Run
+{
+  Benchmark const * m_benchmark;
+  std::vector<int64_t> m_args;
+  std::string m_name;
+};
+
+struct Result
+{
+  std::string m_name;
+  uint64_t m_iterations = 0;
+  double m_seconds = 0.0;
+  uint64_t m_items = 0;
+  uint64_t m_bytes = 0;
+  std::string m_label;
+  std::string m_error;
+
+  double GetNsPerIteration() const
+  {
+    return m_iterations == 0 ? 0.0 : m_seconds * 1e9 / m_iterations;
+  }
+  double GetItemsRate() const { return m_seconds > 0 ? m_items / m_seconds : 0.0; }
+  double GetBytesRate() const { return m_seconds > 0 ? m_bytes / m_seconds : 0.0; }
+};
+
+std::vector<std::unique_ptr<Benchmark>> & GetBenchmarks()
+{
+  static std::vector<std::unique_ptr<Benchmark>> benchmarks;
+  return benchmarks;
+}
+
+std::vector<Run> GetRuns(std::string const & filter)
+{
+  std::regex const re(filter);
+  std::vector<Run> runs;
+  for (auto const & benchmark : GetBenchmarks())
+  {
+    auto const addRun = [&](std::vector<int64_t> const & args)
+    {
+      std::ostringstream name;
+      name << benchmark->GetName();
+      for (auto const arg : args)
+        name << '/' << arg;
+      if (std::regex_search(name.str(), re))
+        runs.push_back({benchmark.get(), args, name.str()});
+    };
+
+    if (benchmark->GetArgs().empty())
+      addRun({});
+    for (auto const & args : benchmark->GetArgs())
+      addRun(args);
+  }
+  return runs;
+}
+
+Result RunIterations(Run const & run, uint64_t iterations)
+{
+  State state(iterations, run.m_args);
+  run.m_benchmark->GetFn()(state);
+
+  Result result;
+  result.m_name = run.m_name;
+  result.m_iterations = iterations;
+  result.m_seconds = state.GetElapsedSeconds();
+  result.m_items = state.GetItemsProcessed();
+  result.m_bytes = state.GetBytesProcessed();
+  result.m_label = state.GetLabel();
+  result.m_error = state.GetError();
+  return result;
+}
+
+// Increases the count of iterations until the run takes |minSeconds|.
+Result RunCalibrated(Run const & run, double minSeconds, uint64_t & iterations)
+{
+  iterations = 1;
+  while (true)
+  {
+    Result result = RunIterations(run, iterations);
+    if (!result.m_error.empty() || result.m_seconds >= minSeconds || iterations >= kMaxIterations)
+      return result;
+
+    // Predicts the count by the elapsed time with a margin, when the time
+    // is too short to predict, the count is increased by ten times.
+    double multiplier = minSeconds * 1.4 / std::max(result.m_seconds, 1e-9);
+    if (result.m_seconds / minSeconds <= 0.1)
+      multiplier = std::min(multiplier, 10.0);
+    auto const next = static_cast<uint64_t>(std::llround(iterations * multiplier));
+    iterations = std::min(std::max(next, iterations + 1), kMaxIterations);
+  }
+}
+
+std::string FormatTime(double ns)
+{
+  std::ostringstream os;
+  os << std::fixed << std::setprecision(ns < 10 ? 2 : (ns < 100 ? 1 : 0));
+  if (ns < 1e4)
+    os << ns << " ns";
+  else if (ns < 1e7)
+    os << ns / 1e3 << " us";
+  else
+    os << ns / 1e6 << " ms";
+  return os.str();
+}
+
+std::string FormatRate(double rate, char const * unit)
+{
+  if (rate <= 0)
+    return {};
+
+  char const * prefixes[] = {"", "k", "M", "G", "T"};
+  size_t i = 0;
+  for (; rate >= 1000 && i + 1 < ARRAY_SIZE(prefixes); ++i)
+    rate /= 1000;
+
+  std::ostringstream os;
+  os << std::fixed << std::setprecision(rate < 10 ? 2 : 1) << rate << prefixes[i] << ' ' << unit
+     << "/s";
+  return os.str();
+}
+
+class Reporter
+{
+public:
+  Reporter(Options::Format format, std::ostream & out) : m_format(format), m_out(out) {}
+
+  void Header()
+  {
+    if (m_format == Options::Format::Csv)
+    {
+      m_out << "name,iterations,ns_per_iteration,items_per_second,bytes_per_second,label,error"
+            << std::endl;
+      return;
+    }
+
+    m_out << std::left << std::setw(kNameWidth) << "Benchmark" << std::right << std::setw(14)
+          << "Time" << std::setw(14) << "Iterations"
+          << "  Rates" << std::endl;
+    m_out << std::string(kNameWidth + 28 + 24, '-') << std::endl;
+  }
+
+  void Report(Result const & r)
+  {
+    if (m_format == Options::Format::Csv)
+    {
+      m_out << r.m_name << ',' << r.m_iterations << ',' << r.GetNsPerIteration() << ','
+            << r.GetItemsRate() << ',' << r.GetBytesRate() << ",\"" << r.m_label << "\",\""
+            << r.m_error << '"' << std::endl;
+      return;
+    }
+
+    m_out << std::left << std::setw(kNameWidth) << r.m_name << std::right;
+    if (!r.m_error.empty())
+    {
+      m_out << "  ERROR: " << r.m_error << std::endl;
+      return;
+    }
+
+    m_out << std::setw(14) << FormatTime(r.GetNsPerIteration()) << std::setw(14)
+          << r.m_iterations;
+    for (auto const & rate :
+         {FormatRate(r.GetItemsRate(), "items"), FormatRate(r.GetBytesRate(), "B")})
+    {
+      if (!rate.empty())
+        m_out << "  " << rate;
+    }
+    if (!r.m_label.empty())
+      m_out << "  " << r.m_label;
+    m_out << std::endl;
+  }
+
+private:
+  static int constexpr kNameWidth = 48;
+
+  Options::Format m_format;
+  std::ostream & m_out;
+};
+
+// static
+int constexpr Reporter::kNameWidth;
+
+// Aggregates of repetitions: results with the same count of iterations
+// and mean, median and stddev of times and rates.
+void ReportAggregates(std::vector<Result> const & results, Reporter & reporter)
+{
+  ASSERT(!results.empty(), ());
+
+  auto const makeResult = [&](char const * suffix, double seconds)
+  {
+    Result r = results.front();
+    r.m_name += suffix;
+    r.m_seconds = seconds;
+    return r;
+  };
+
+  std::vector<double> seconds;
+  for (auto const & r : results)
+    seconds.push_back(r.m_seconds);
+
+  double const mean = std::accumulate(seconds.begin(), seconds.end(), 0.0) / seconds.size();
+
+  std::vector<double> sorted = seconds;
+  std::sort(sorted.begin(), sorted.end());
+  size_t const n = sorted.size();
+  double const median = n % 2 == 1 ? sorted[n / 2] : (sorted[n / 2 - 1] + sorted[n / 2]) / 2;
+
+  double sum = 0.0;
+  for (auto const s : seconds)
+    sum += (s - mean) * (s - mean);
+  double const stddev = n > 1 ? std::sqrt(sum / (n - 1)) : 0.0;
+
+  reporter.Report(makeResult("_mean", mean));
+  reporter.Report(makeResult("_median", median));
+
+  Result r = makeResult("_stddev", stddev);
+  // Rates of the deviation make no sense.
+  r.m_items = r.m_bytes = 0;
+  reporter.Report(r);
+}
+}  // namespace
+
+State::State(uint64_t iterations, std::vector<int64_t> const & args)
+  : m_iterations(iterations), m_args(args)
+{
+}
+
+void State::PauseTiming()
+{
+  ASSERT(m_isTiming, ());
+  m_elapsed += TClock::now() - m_start;
+  m_isTiming = false;
+}
+
+void State::ResumeTiming()
+{
+  ASSERT(!m_isTiming, ());
+  m_isTiming = true;
+  m_start = TClock::now();
+}
+
+void State::SkipWithError(std::string const & error)
+{
+  m_error = error;
+  m_iterations = 0;
+  if (m_isTiming)
+    PauseTiming();
+}
+
+int64_t State::GetArg(size_t i) const
+{
+  CHECK_LESS(i, m_args.size(), ());
+  return m_args[i];
+}
+
+Benchmark * Benchmark::Arg(int64_t arg) { return Args({arg}); }
+
+Benchmark * Benchmark::Args(std::vector<int64_t> const & args)
+{
+  m_args.push_back(args);
+  return this;
+}
+
+Benchmark * Benchmark::Range(int64_t first, int64_t last, int64_t multiplier)
+{
+  CHECK_LESS_OR_EQUAL(first, last, ());
+  CHECK_GREATER(multiplier, 1, ());
+
+  Arg(first);
+  for (int64_t arg = 1; arg < last; arg *= multiplier)
+  {
+    if (arg > first)
+      Arg(arg);
+  }
+  if (last != first)
+    Arg(last);
+  return this;
+}
+
+Benchmark * RegisterBenchmark(char const * name, TBenchmarkFn fn)
+{
+  GetBenchmarks().emplace_back(new Benchmark(name, fn));
+  return GetBenchmarks().back().get();
+}
+
+std::vector<std::string> ListBenchmarks(std::string const & filter)
+{
+  std::vector<std::string> names;
+  for (auto const & run : GetRuns(filter))
+    names.push_back(run.m_name);
+  return names;
+}
+
+bool RunBenchmarks(Options const & options, std::ostream & out)
+{
+  CHECK_GREATER(options.m_repetitions, 0, ());
+
+  Reporter reporter(options.m_format, out);
+  reporter.Header();
+
+  bool ok = true;
+  for (auto const & run : GetRuns(options.m_filter))
+  {
+    uint64_t iterations = 0;
+    std::vector<Result> results = {RunCalibrated(run, options.m_minSeconds, iterations)};
+    for (uint32_t i = 1; i < options.m_repetitions && results.front().m_error.empty(); ++i)
+      results.push_back(RunIterations(run, iterations));
+
+    for (auto const & result : results)
+    {
+      reporter.Report(result);
+      if (!result.m_error.empty())
+        ok = false;
+    }
+
+    if (results.size() > 1)
+      ReportAggregates(results, reporter);
+  }
+  return ok;
+}
+
+namespace impl
+{
+void UseCharPointer(char const volatile *) {}
+}  // namespace impl
+}  // namespace benchmarks
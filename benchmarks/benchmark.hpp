@@ -0,0 +1,158 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace benchmarks
+{
+// State of a run of a benchmark. A benchmark measures its loop
+//
+//   while (state.KeepRunning())
+//     ...;
+//
+// and the harness chooses the count of iterations so that the loop runs
+// for the min time at least. Preparation before the loop isn't measured.
+class State
+{
+public:
+  State(uint64_t iterations, std::vector<int64_t> const & args);
+
+  bool KeepRunning()
+  {
+    if (m_iteration < m_iterations)
+    {
+      if (m_iteration++ == 0)
+        ResumeTiming();
+      return true;
+    }
+    if (m_isTiming)
+      PauseTiming();
+    return false;
+  }
+
+  // Excludes the code between PauseTiming() and ResumeTiming() from the measurement.
+  void PauseTiming();
+  void ResumeTiming();
+
+  // Marks the run as failed, the loop isn't entered after the call.
+  void SkipWithError(std::string const & error);
+
+  // Counts of items and bytes processed by all iterations, they are
+  // reported as rates.
+  void SetItemsProcessed(uint64_t items) { m_items = items; }
+  void SetBytesProcessed(uint64_t bytes) { m_bytes = bytes; }
+  void SetLabel(std::string const & label) { m_label = label; }
+
+  int64_t GetArg(size_t i = 0) const;
+  uint64_t GetIterations() const { return m_iterations; }
+
+  uint64_t GetItemsProcessed() const { return m_items; }
+  uint64_t GetBytesProcessed() const { return m_bytes; }
+  std::string const & GetLabel() const { return m_label; }
+  std::string const & GetError() const { return m_error; }
+  double GetElapsedSeconds() const { return m_elapsed.count(); }
+
+private:
+  using TClock = std::chrono::steady_clock;
+
+  uint64_t m_iterations;
+  uint64_t m_iteration = 0;
+  std::vector<int64_t> const & m_args;
+
+  bool m_isTiming = false;
+  TClock::time_point m_start;
+  std::chrono::duration<double> m_elapsed{0};
+
+  uint64_t m_items = 0;
+  uint64_t m_bytes = 0;
+  std::string m_label;
+  std::string m_error;
+};
+
+using TBenchmarkFn = void (*)(State & state);
+
+// A registered benchmark, it's run once for every set of arguments, or
+// once without arguments.
+class Benchmark
+{
+public:
+  Benchmark(std::string const & name, TBenchmarkFn fn) : m_name(name), m_fn(fn) {}
+
+  Benchmark * Arg(int64_t arg);
+  Benchmark * Args(std::vector<int64_t> const & args);
+  // Adds runs for |first|, powers of |multiplier| in (first, last) and |last|.
+  Benchmark * Range(int64_t first, int64_t last, int64_t multiplier = 8);
+
+  std::string const & GetName() const { return m_name; }
+  TBenchmarkFn GetFn() const { return m_fn; }
+  std::vector<std::vector<int64_t>> const & GetArgs() const { return m_args; }
+
+private:
+  std::string m_name;
+  TBenchmarkFn m_fn;
+  std::vector<std::vector<int64_t>> m_args;
+};
+
+// Benchmarks are registered by BENCHMARK() during static initialization.
+Benchmark * RegisterBenchmark(char const * name, TBenchmarkFn fn);
+
+struct Options
+{
+  enum class Format
+  {
+    Console,
+    Csv
+  };
+
+  // Regular expression for names of runs, e.g. "Varint_.*/8".
+  std::string m_filter = ".*";
+  double m_minSeconds = 0.5;
+  // When there are several repetitions, mean, median and stddev of them
+  // are reported too.
+  uint32_t m_repetitions = 1;
+  Format m_format = Format::Console;
+};
+
+// Names of runs which match |filter|.
+std::vector<std::string> ListBenchmarks(std::string const & filter);
+
+// Runs benchmarks which names match the filter, returns false when
+// some of them failed.
+bool RunBenchmarks(Options const & options, std::ostream & out);
+
+namespace impl
+{
+void UseCharPointer(char const volatile * p);
+}  // namespace impl
+
+// Prevents the compiler from optimizing out computation of |value|.
+template <typename T>
+inline void DoNotOptimize(T const & value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+  asm volatile("" : : "r,m"(value) : "memory");
+#else
+  impl::UseCharPointer(&reinterpret_cast<char const volatile &>(value));
+#endif
+}
+
+// Forces writes of all pending values to memory.
+inline void ClobberMemory()
+{
+#if defined(__GNUC__) || defined(__clang__)
+  asm volatile("" : : : "memory");
+#endif
+}
+}  // namespace benchmarks
+
+#define BENCHMARK_CONCAT_IMPL(a, b) a##b
+#define BENCHMARK_CONCAT(a, b) BENCHMARK_CONCAT_IMPL(a, b)
+
+// Registers |fn|, arguments are added by a chain of calls:
+//   BENCHMARK(Varint_Read)->Arg(1)->Arg(4);
+#define BENCHMARK(fn)                                                           \
+  static ::benchmarks::Benchmark * BENCHMARK_CONCAT(g_benchmark_, __LINE__) = \
+      ::benchmarks::RegisterBenchmark(#fn, &fn)
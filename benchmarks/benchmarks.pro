@@ -0,0 +1,32 @@
+# Micro-benchmarks of core libraries.
+
+TARGET = benchmarks
+CONFIG += console warn_on
+CONFIG -= app_bundle
+TEMPLATE = app
+
+ROOT_DIR = ..
+
+DEPENDENCIES = indexer editor platform geometry coding base gflags protobuf succinct pugixml \
+               opening_hours oauthcpp stats_client icu jansson
+
+include($$ROOT_DIR/common.pri)
+
+INCLUDEPATH *= $$ROOT_DIR/3party/gflags/src
+
+QT *= core
+
+macx-* {
+  LIBS *= "-framework IOKit" "-framework SystemConfiguration"
+}
+
+SOURCES += \
+    base_benchmarks.cpp \
+    benchmark.cpp \
+    benchmarks_main.cpp \
+    coding_benchmarks.cpp \
+    geometry_benchmarks.cpp \
+    indexer_benchmarks.cpp \
+
+HEADERS += \
+    benchmark.hpp \
@@ -0,0 +1,43 @@
+#include "benchmarks/benchmark.hpp"
+
+#include <algorithm>
+#include <iostream>
+
+#include "3party/gflags/src/gflags/gflags.h"
+
+DEFINE_string(filter, ".*", "Regular expression for names of benchmarks to run.");
+DEFINE_double(min_time, 0.5, "Min time of a measurement in seconds.");
+DEFINE_uint64(repetitions, 1,
+              "Count of measurements of every benchmark, mean, median and stddev are reported "
+              "when there are several of them.");
+DEFINE_string(format, "console", "Format of results: console or csv.");
+DEFINE_bool(list, false, "Print names of benchmarks which match the filter and exit.");
+
+int main(int argc, char ** argv)
+{
+  google::SetUsageMessage("Micro-benchmarks of base, coding, geometry and indexer kernels.");
+  google::ParseCommandLineFlags(&argc, &argv, true);
+
+  if (FLAGS_list)
+  {
+    for (auto const & name : benchmarks::ListBenchmarks(FLAGS_filter))
+      std::cout << name << std::endl;
+    return 0;
+  }
+
+  benchmarks::Options options;
+  options.m_filter = FLAGS_filter;
+  options.m_minSeconds = FLAGS_min_time;
+  options.m_repetitions = static_cast<uint32_t>(std::max<uint64_t>(FLAGS_repetitions, 1));
+  if (FLAGS_format == "csv")
+  {
+    options.m_format = benchmarks::Options::Format::Csv;
+  }
+  else if (FLAGS_format != "console")
+  {
+    std::cerr << "Unknown format: " << FLAGS_format << std::endl;
+    return 1;
+  }
+
+  return benchmarks::RunBenchmarks(options, std::cout) ? 0 : 1;
+}
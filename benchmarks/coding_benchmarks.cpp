@@ -0,0 +1,197 @@
+#include "benchmarks/benchmark.hpp"
+
+#include "coding/byte_stream.hpp"
+#include "coding/compressed_bit_vector.hpp"
+#include "coding/multilang_utf8_string.hpp"
+#include "coding/varint.hpp"
+#include "coding/writer.hpp"
+
+#include "base/macros.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace benchmarks;
+
+namespace
+{
+size_t constexpr kValuesCount = 4096;
+
+// Values of varuints of |bytes| bytes at most.
+std::vector<uint64_t> MakeValues(int64_t bytes)
+{
+  std::mt19937_64 rng(0);
+  uint64_t const mask = bytes >= 9 ? ~uint64_t{0} : (uint64_t{1} << (7 * bytes)) - 1;
+  std::vector<uint64_t> values(kValuesCount);
+  for (auto & value : values)
+    value = rng() & mask;
+  return values;
+}
+
+std::vector<uint8_t> EncodeValues(std::vector<uint64_t> const & values)
+{
+  std::vector<uint8_t> buffer;
+  MemWriter<std::vector<uint8_t>> writer(buffer);
+  for (auto const value : values)
+    WriteVarUint(writer, value);
+  return buffer;
+}
+
+// Arg is the max length of varuints in bytes.
+void Varint_WriteVarUint(State & state)
+{
+  auto const values = MakeValues(state.GetArg());
+  std::vector<uint8_t> buffer;
+  buffer.reserve(kValuesCount * 10);
+
+  while (state.KeepRunning())
+  {
+    buffer.clear();
+    MemWriter<std::vector<uint8_t>> writer(buffer);
+    for (auto const value : values)
+      WriteVarUint(writer, value);
+    DoNotOptimize(buffer.data());
+  }
+  state.SetItemsProcessed(state.GetIterations() * kValuesCount);
+  state.SetBytesProcessed(state.GetIterations() * buffer.size());
+}
+
+void Varint_ReadVarUint(State & state)
+{
+  auto const buffer = EncodeValues(MakeValues(state.GetArg()));
+
+  while (state.KeepRunning())
+  {
+    ArrayByteSource src(buffer.data());
+    uint64_t sum = 0;
+    for (size_t i = 0; i < kValuesCount; ++i)
+      sum += ReadVarUint<uint64_t>(src);
+    DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.GetIterations() * kValuesCount);
+  state.SetBytesProcessed(state.GetIterations() * buffer.size());
+}
+
+void Varint_ReadVarUint64Buffer(State & state)
+{
+  auto const buffer = EncodeValues(MakeValues(state.GetArg()));
+  std::vector<uint64_t> values;
+  values.reserve(kValuesCount);
+
+  while (state.KeepRunning())
+  {
+    values.clear();
+    ReadVarUint64Buffer(buffer.data(), buffer.data() + buffer.size(), values);
+    DoNotOptimize(values.data());
+  }
+  state.SetItemsProcessed(state.GetIterations() * kValuesCount);
+  state.SetBytesProcessed(state.GetIterations() * buffer.size());
+}
+
+uint64_t constexpr kBitVectorSize = 1 << 22;
+
+// Makes a vector of |kBitVectorSize| bits with |count| random set bits at most.
+std::unique_ptr<coding::CompressedBitVector> MakeBitVector(int64_t count, uint32_t seed)
+{
+  std::mt19937 rng(seed);
+  std::uniform_int_distribution<uint64_t> position(0, kBitVectorSize - 1);
+  std::vector<uint64_t> bits(static_cast<size_t>(count));
+  for (auto & bit : bits)
+    bit = position(rng);
+  std::sort(bits.begin(), bits.end());
+  bits.erase(std::unique(bits.begin(), bits.end()), bits.end());
+  return coding::CompressedBitVectorBuilder::FromBitPositions(std::move(bits));
+}
+
+// Arg is the count of set bits of every vector, so small counts are
+// sparse vectors and large ones are dense.
+void CompressedBitVector_Intersect(State & state)
+{
+  auto const lhs = MakeBitVector(state.GetArg(), 1 /* seed */);
+  auto const rhs = MakeBitVector(state.GetArg(), 2 /* seed */);
+
+  while (state.KeepRunning())
+    DoNotOptimize(coding::CompressedBitVector::Intersect(*lhs, *rhs)->PopCount());
+  state.SetItemsProcessed(state.GetIterations());
+}
+
+void CompressedBitVector_Union(State & state)
+{
+  auto const lhs = MakeBitVector(state.GetArg(), 1 /* seed */);
+  auto const rhs = MakeBitVector(state.GetArg(), 2 /* seed */);
+
+  while (state.KeepRunning())
+    DoNotOptimize(coding::CompressedBitVector::Union(*lhs, *rhs)->PopCount());
+  state.SetItemsProcessed(state.GetIterations());
+}
+
+void CompressedBitVector_ForEach(State & state)
+{
+  auto const cbv = MakeBitVector(state.GetArg(), 1 /* seed */);
+
+  while (state.KeepRunning())
+  {
+    uint64_t sum = 0;
+    coding::CompressedBitVectorEnumerator::ForEach(*cbv, [&sum](uint64_t bit) { sum += bit; });
+    DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.GetIterations() * cbv->PopCount());
+}
+
+StringUtf8Multilang MakeNames()
+{
+  StringUtf8Multilang names;
+  for (auto const * lang : {"default", "en", "ru", "de", "fr", "es", "it", "ja", "zh", "ar"})
+    names.AddString(lang, std::string("Name of a feature in ") + lang);
+  return names;
+}
+
+void StringUtf8Multilang_GetString(State & state)
+{
+  auto const names = MakeNames();
+  int8_t const langs[] = {StringUtf8Multilang::GetLangIndex("en"),
+                          StringUtf8Multilang::GetLangIndex("ar"),
+                          StringUtf8Multilang::GetLangIndex("ko")};
+
+  std::string name;
+  while (state.KeepRunning())
+  {
+    for (auto const lang : langs)
+    {
+      names.GetString(lang, name);
+      DoNotOptimize(name.data());
+    }
+  }
+  state.SetItemsProcessed(state.GetIterations() * ARRAY_SIZE(langs));
+}
+
+void StringUtf8Multilang_ForEach(State & state)
+{
+  auto const names = MakeNames();
+
+  while (state.KeepRunning())
+  {
+    size_t size = 0;
+    names.ForEach([&size](int8_t /* lang */, std::string const & name)
+    {
+      size += name.size();
+      return true;
+    });
+    DoNotOptimize(size);
+  }
+  state.SetItemsProcessed(state.GetIterations());
+}
+}  // namespace
+
+BENCHMARK(Varint_WriteVarUint)->Arg(1)->Arg(2)->Arg(4)->Arg(9);
+BENCHMARK(Varint_ReadVarUint)->Arg(1)->Arg(2)->Arg(4)->Arg(9);
+BENCHMARK(Varint_ReadVarUint64Buffer)->Arg(1)->Arg(2)->Arg(4)->Arg(9);
+BENCHMARK(CompressedBitVector_Intersect)->Range(64, 1 << 20, 32);
+BENCHMARK(CompressedBitVector_Union)->Range(64, 1 << 20, 32);
+BENCHMARK(CompressedBitVector_ForEach)->Range(64, 1 << 20, 32);
+BENCHMARK(StringUtf8Multilang_GetString);
+BENCHMARK(StringUtf8Multilang_ForEach);
@@ -0,0 +1,80 @@
+#include "benchmarks/benchmark.hpp"
+
+#include "geometry/rect2d.hpp"
+#include "geometry/tree4d.hpp"
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using namespace benchmarks;
+
+namespace
+{
+struct Object
+{
+  m2::RectD const & GetLimitRect() const { return m_rect; }
+  bool operator==(Object const & rhs) const { return m_id == rhs.m_id; }
+
+  m2::RectD m_rect;
+  uint32_t m_id;
+};
+
+// Random rects of size up to 1% of the world [0, 1000] x [0, 1000].
+std::vector<m2::RectD> MakeRects(size_t count, uint32_t seed)
+{
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<double> coord(0.0, 1000.0);
+  std::uniform_real_distribution<double> size(0.0, 10.0);
+
+  std::vector<m2::RectD> rects(count);
+  for (auto & rect : rects)
+  {
+    double const x = coord(rng);
+    double const y = coord(rng);
+    rect = m2::RectD(x, y, x + size(rng), y + size(rng));
+  }
+  return rects;
+}
+
+// Arg is the count of objects.
+void Tree4d_Add(State & state)
+{
+  auto const rects = MakeRects(static_cast<size_t>(state.GetArg()), 1 /* seed */);
+
+  while (state.KeepRunning())
+  {
+    m4::Tree<Object> tree;
+    for (uint32_t i = 0; i < rects.size(); ++i)
+      tree.Add({rects[i], i}, rects[i]);
+    DoNotOptimize(tree.GetSize());
+  }
+  state.SetItemsProcessed(state.GetIterations() * rects.size());
+}
+
+// Queries of rects of sizes up to 1% of the world, Arg is the count of objects.
+void Tree4d_ForEachInRect(State & state)
+{
+  auto const rects = MakeRects(static_cast<size_t>(state.GetArg()), 1 /* seed */);
+  auto const queries = MakeRects(1024, 2 /* seed */);
+
+  m4::Tree<Object> tree;
+  for (uint32_t i = 0; i < rects.size(); ++i)
+    tree.Add({rects[i], i}, rects[i]);
+
+  size_t i = 0;
+  while (state.KeepRunning())
+  {
+    uint64_t found = 0;
+    tree.ForEachInRect(queries[i++ % queries.size()], [&found](Object const & obj)
+    {
+      found += obj.m_id;
+    });
+    DoNotOptimize(found);
+  }
+  state.SetItemsProcessed(state.GetIterations());
+}
+}  // namespace
+
+BENCHMARK(Tree4d_Add)->Range(1 << 10, 1 << 16);
+BENCHMARK(Tree4d_ForEachInRect)->Range(1 << 10, 1 << 16);
@@ -0,0 +1,138 @@
+#include "benchmarks/benchmark.hpp"
+
+#include "indexer/classificator_loader.hpp"
+#include "indexer/feature.hpp"
+#include "indexer/features_vector.hpp"
+#include "indexer/geometry_coding.hpp"
+
+#include "platform/platform.hpp"
+
+#include "base/array_adapters.hpp"
+#include "base/macros.hpp"
+
+#include "defines.hpp"
+
+#include "3party/gflags/src/gflags/gflags.h"
+
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+DEFINE_string(mwm, "", "Path to the mwm for FeatureType benchmarks, by default it's "
+                       "minsk-pass in the writable dir.");
+
+using namespace benchmarks;
+
+namespace
+{
+uint32_t constexpr kMaxCoord = (1 << 30) - 1;
+
+// A random walk, so deltas are small like deltas of real polylines.
+std::vector<m2::PointU> MakePolyline(size_t count)
+{
+  std::mt19937 rng(0);
+  std::uniform_int_distribution<int32_t> step(-1000, 1000);
+
+  std::vector<m2::PointU> points(count);
+  int64_t x = kMaxCoord / 2;
+  int64_t y = kMaxCoord / 2;
+  for (auto & point : points)
+  {
+    x += step(rng);
+    y += step(rng);
+    point = m2::PointU(static_cast<uint32_t>(x), static_cast<uint32_t>(y));
+  }
+  return points;
+}
+
+m2::PointU const kBasePoint(kMaxCoord / 2, kMaxCoord / 2);
+m2::PointU const kMaxPoint(kMaxCoord, kMaxCoord);
+
+// Arg is the count of points.
+void GeometryCoding_EncodePolyline(State & state)
+{
+  auto const points = MakePolyline(static_cast<size_t>(state.GetArg()));
+  std::vector<uint64_t> deltas(points.size());
+
+  while (state.KeepRunning())
+  {
+    geo_coding::OutDeltasT out(deltas);
+    geo_coding::EncodePolyline(make_read_adapter(points), kBasePoint, kMaxPoint, out);
+    DoNotOptimize(deltas.data());
+  }
+  state.SetItemsProcessed(state.GetIterations() * points.size());
+}
+
+void GeometryCoding_DecodePolyline(State & state)
+{
+  auto const points = MakePolyline(static_cast<size_t>(state.GetArg()));
+  std::vector<uint64_t> deltas(points.size());
+  {
+    geo_coding::OutDeltasT out(deltas);
+    geo_coding::EncodePolyline(make_read_adapter(points), kBasePoint, kMaxPoint, out);
+  }
+
+  std::vector<m2::PointU> decoded(points.size());
+  while (state.KeepRunning())
+  {
+    geo_coding::OutPointsT out(decoded);
+    geo_coding::DecodePolyline(make_read_adapter(deltas), kBasePoint, kMaxPoint, out);
+    DoNotOptimize(decoded.data());
+  }
+  state.SetItemsProcessed(state.GetIterations() * points.size());
+}
+
+std::string GetMwmPath()
+{
+  if (!FLAGS_mwm.empty())
+    return FLAGS_mwm;
+  return GetPlatform().WritablePathForFile(std::string("minsk-pass") + DATA_FILE_EXTENSION);
+}
+
+// Features are parsed one by one in the order of the mwm, an iteration
+// is one feature.
+void FeatureType_ParseEverything(State & state)
+{
+  auto const path = GetMwmPath();
+  if (!GetPlatform().IsFileExistsByFullPath(path))
+  {
+    state.SkipWithError("No mwm " + path);
+    return;
+  }
+
+  static bool const classificatorLoaded = []()
+  {
+    classificator::Load();
+    return true;
+  }();
+  UNUSED_VALUE(classificatorLoaded);
+
+  FeaturesVectorTest features(path);
+  auto const & featuresVector = features.GetVector();
+  auto const count = featuresVector.GetNumFeatures();
+  if (count == 0)
+  {
+    state.SkipWithError("No features table in " + path);
+    return;
+  }
+
+  FeatureType ft;
+  uint32_t i = 0;
+  while (state.KeepRunning())
+  {
+    featuresVector.GetByIndex(i, ft);
+    ft.ParseEverything();
+    DoNotOptimize(ft.GetTypesCount());
+    if (++i == count)
+      i = 0;
+  }
+  state.SetItemsProcessed(state.GetIterations());
+  state.SetLabel(path);
+}
+}  // namespace
+
+BENCHMARK(GeometryCoding_EncodePolyline)->Range(8, 4096);
+BENCHMARK(GeometryCoding_DecodePolyline)->Range(8, 4096);
+BENCHMARK(FeatureType_ParseEverything);
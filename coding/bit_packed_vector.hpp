@@ -0,0 +1,199 @@
+#pragma once
+
+#include "coding/endianness.hpp"
+
+#include "base/assert.hpp"
+#include "base/macros.hpp"
+
+#include "std/algorithm.hpp"
+#include "std/array.hpp"
+#include "std/cstdint.hpp"
+#include "std/cstring.hpp"
+#include "std/limits.hpp"
+#include "std/type_traits.hpp"
+#include "std/utility.hpp"
+
+namespace coding
+{
+// Access to a buffer of Bits-wide unsigned values which are packed
+// without gaps: the i'th value takes bits [i * Bits, (i + 1) * Bits) of
+// the buffer, lower bits of a byte go first. It's the layout produced
+// by BitWriter::WriteAtMost32Bits().
+//
+// The width is a compile-time constant, so all shifts and masks are
+// constants too. Unpack() decodes groups of eight values which take
+// exactly Bits bytes each, so a compiler unrolls the loop over a group
+// and vectorizes it where it's possible.
+template <uint8_t Bits>
+class BitPacking
+{
+public:
+  static_assert(Bits > 0 && Bits <= 32, "");
+
+  static uint64_t constexpr kMask = (uint64_t{1} << Bits) - 1;
+  static size_t constexpr kGroupSize = CHAR_BIT;
+
+  static uint64_t GetBytesCount(uint64_t count) { return (count * Bits + CHAR_BIT - 1) / CHAR_BIT; }
+
+  // Returns the value which starts at |shift| bit of |block|, |block| is
+  // a little-endian word read from the buffer.
+  static uint32_t Extract(uint64_t block, uint8_t shift)
+  {
+    ASSERT_LESS(shift, CHAR_BIT, ());
+    return static_cast<uint32_t>((SwapIfBigEndian(block) >> shift) & kMask);
+  }
+
+  // |size| is the size of |data| in bytes.
+  static uint32_t Get(uint8_t const * data, uint64_t size, uint64_t i)
+  {
+    uint64_t const bitsOffset = i * Bits;
+    uint64_t const bytesOffset = bitsOffset / CHAR_BIT;
+    ASSERT_LESS(bytesOffset, size, ());
+
+    uint64_t block = 0;
+    if (bytesOffset + sizeof(block) <= size)
+      memcpy(&block, data + bytesOffset, sizeof(block));
+    else
+      memcpy(&block, data + bytesOffset, static_cast<size_t>(size - bytesOffset));
+    return Extract(block, static_cast<uint8_t>(bitsOffset % CHAR_BIT));
+  }
+
+  // Writes values [first, first + count) to |out|.
+  template <typename TValue>
+  static void Unpack(uint8_t const * data, uint64_t size, uint64_t first, size_t count,
+                     TValue * out)
+  {
+    for (; count != 0 && first % kGroupSize != 0; --count)
+      *out++ = static_cast<TValue>(Get(data, size, first++));
+
+    // Groups are decoded by words which are read directly from the buffer,
+    // so the last groups of the buffer are decoded by Get().
+    for (; count >= kGroupSize && first / kGroupSize * Bits + Bits + sizeof(uint64_t) <= size;
+         count -= kGroupSize, first += kGroupSize, out += kGroupSize)
+    {
+      UnpackGroup(data + first / kGroupSize * Bits, out);
+    }
+
+    for (; count != 0; --count)
+      *out++ = static_cast<TValue>(Get(data, size, first++));
+  }
+
+private:
+  template <typename TValue>
+  static void UnpackGroup(uint8_t const * group, TValue * out)
+  {
+    if (Bits <= CHAR_BIT)
+    {
+      // The whole group fits into one word.
+      uint64_t block;
+      memcpy(&block, group, sizeof(block));
+      block = SwapIfBigEndian(block);
+      for (size_t j = 0; j < kGroupSize; ++j)
+        out[j] = static_cast<TValue>((block >> (j * Bits)) & kMask);
+      return;
+    }
+
+    for (size_t j = 0; j < kGroupSize; ++j)
+    {
+      uint64_t block;
+      memcpy(&block, group + j * Bits / CHAR_BIT, sizeof(block));
+      out[j] = static_cast<TValue>(Extract(block, (j * Bits) % CHAR_BIT));
+    }
+  }
+};
+
+// Read-only view of |size| values in a bit-packed buffer of Bits-wide
+// values, see BitPacking.
+template <uint8_t Bits>
+class BitPackedVector
+{
+public:
+  using TPacking = BitPacking<Bits>;
+
+  BitPackedVector() = default;
+  BitPackedVector(uint8_t const * data, uint64_t size)
+    : m_data(data), m_bytesSize(TPacking::GetBytesCount(size)), m_size(size)
+  {
+  }
+
+  uint64_t Size() const { return m_size; }
+  bool Empty() const { return m_size == 0; }
+
+  uint32_t Get(uint64_t i) const
+  {
+    ASSERT_LESS(i, m_size, ());
+    return TPacking::Get(m_data, m_bytesSize, i);
+  }
+
+  template <typename TValue>
+  void Unpack(uint64_t first, size_t count, TValue * out) const
+  {
+    ASSERT_LESS_OR_EQUAL(first + count, m_size, ());
+    TPacking::Unpack(m_data, m_bytesSize, first, count, out);
+  }
+
+  template <typename TFn>
+  void ForEach(TFn && fn) const
+  {
+    size_t constexpr kChunkSize = 256;
+    array<uint32_t, kChunkSize> values;
+    for (uint64_t first = 0; first < m_size; first += kChunkSize)
+    {
+      size_t const count =
+          static_cast<size_t>(min(static_cast<uint64_t>(kChunkSize), m_size - first));
+      Unpack(first, count, values.data());
+      for (size_t i = 0; i < count; ++i)
+        fn(values[i]);
+    }
+  }
+
+private:
+  uint8_t const * m_data = nullptr;
+  uint64_t m_bytesSize = 0;
+  uint64_t m_size = 0;
+};
+
+namespace impl
+{
+template <uint8_t Bits>
+struct BitsWidthDispatcher
+{
+  template <typename TFn>
+  static void Call(uint8_t bits, TFn && fn)
+  {
+    if (bits == Bits)
+      fn(integral_constant<uint8_t, Bits>());
+    else
+      BitsWidthDispatcher<Bits + 1>::Call(bits, forward<TFn>(fn));
+  }
+};
+
+template <>
+struct BitsWidthDispatcher<33>
+{
+  template <typename TFn>
+  static void Call(uint8_t bits, TFn && /* fn */)
+  {
+    UNUSED_VALUE(bits);
+    ASSERT(false, ("Unsupported width of values:", bits));
+  }
+};
+}  // namespace impl
+
+// Calls |fn| with integral_constant<uint8_t, bits>, so a width which
+// is read at runtime, e.g. from a header of a table, selects the
+// instantiation with compile-time constants:
+//
+// struct Sum
+// {
+//   template <typename TBits>
+//   void operator()(TBits) { BitPackedVector<TBits::value>(data, size).ForEach(...); }
+// };
+// DispatchBitsWidth(header.m_bits, Sum());
+template <typename TFn>
+void DispatchBitsWidth(uint8_t bits, TFn && fn)
+{
+  ASSERT(bits > 0 && bits <= 32, (bits));
+  impl::BitsWidthDispatcher<1>::Call(bits, forward<TFn>(fn));
+}
+}  // namespace coding
@@ -0,0 +1,195 @@
+#include "coding/buffered_file_writer.hpp"
+
+#include "coding/internal/file_data.hpp"
+
+#include "base/assert.hpp"
+#include "base/logging.hpp"
+
+#include "std/algorithm.hpp"
+#include "std/cstring.hpp"
+
+// static
+size_t constexpr BufferedFileWriter::kAlignment;
+
+BufferedFileWriter::BufferedFileWriter(string const & fileName, FileWriter::Op op)
+  : BufferedFileWriter(fileName, op, Params())
+{
+}
+
+BufferedFileWriter::BufferedFileWriter(string const & fileName, FileWriter::Op op,
+                                       Params const & params)
+  : m_file(new my::FileData(fileName, static_cast<my::FileData::Op>(op)))
+  , m_op(op)
+  , m_params(params)
+  , m_capacity((max(params.m_bufferSize, size_t{1}) + kAlignment - 1) / kAlignment * kAlignment)
+{
+  // Full buffers are written by one call, so stdio buffer is an extra copy only.
+  m_file->DisableBuffering();
+
+  if (m_params.m_directIO && !(m_file->SetDirectIO(true) && m_file->SetDirectIO(false)))
+  {
+    LOG(LWARNING, ("Direct io is not supported for", fileName));
+    m_params.m_directIO = false;
+  }
+
+  m_pos = m_op == FileWriter::OP_APPEND ? m_file->Size() : m_file->Pos();
+  InitBuffer(m_current);
+  m_current.m_offset = m_pos;
+
+  if (m_params.m_asyncFlush)
+  {
+    InitBuffer(m_pending);
+    m_thread = thread(&BufferedFileWriter::ThreadRoutine, this);
+  }
+}
+
+BufferedFileWriter::~BufferedFileWriter()
+{
+  try
+  {
+    Flush();
+  }
+  catch (RootException const & e)
+  {
+    LOG(LCRITICAL, ("Can't write", GetName(), e.Msg()));
+  }
+
+  if (m_thread.joinable())
+  {
+    {
+      lock_guard<mutex> lock(m_mutex);
+      m_shutdown = true;
+    }
+    m_cv.notify_all();
+    m_thread.join();
+  }
+}
+
+void BufferedFileWriter::Seek(uint64_t pos)
+{
+  ASSERT_NOT_EQUAL(m_op, FileWriter::OP_APPEND, (GetName(), pos));
+  if (pos == m_pos)
+    return;
+
+  Submit();
+  m_pos = pos;
+  m_current.m_offset = pos;
+}
+
+void BufferedFileWriter::Write(void const * p, size_t size)
+{
+  uint8_t const * data = static_cast<uint8_t const *>(p);
+  while (size != 0)
+  {
+    size_t const toCopy = min(size, m_capacity - m_current.m_size);
+    memcpy(m_current.m_data + m_current.m_size, data, toCopy);
+    m_current.m_size += toCopy;
+    m_pos += toCopy;
+    data += toCopy;
+    size -= toCopy;
+
+    if (m_current.m_size == m_capacity)
+      Submit();
+  }
+}
+
+void BufferedFileWriter::Flush()
+{
+  Submit();
+  WaitForPending();
+  m_file->Flush();
+}
+
+string const & BufferedFileWriter::GetName() const { return m_file->GetName(); }
+
+void BufferedFileWriter::InitBuffer(Buffer & buffer)
+{
+  buffer.m_memory.resize(m_capacity + kAlignment - 1);
+  uintptr_t const address = reinterpret_cast<uintptr_t>(buffer.m_memory.data());
+  buffer.m_data = buffer.m_memory.data() + (kAlignment - address % kAlignment) % kAlignment;
+}
+
+void BufferedFileWriter::Submit()
+{
+  if (m_current.m_size != 0)
+  {
+    if (m_params.m_asyncFlush)
+    {
+      WaitForPending();
+      {
+        lock_guard<mutex> lock(m_mutex);
+        swap(m_current, m_pending);
+        m_hasPending = true;
+      }
+      m_cv.notify_all();
+    }
+    else
+    {
+      WriteBuffer(m_current);
+    }
+  }
+
+  m_current.m_size = 0;
+  m_current.m_offset = m_pos;
+}
+
+void BufferedFileWriter::WaitForPending()
+{
+  if (!m_params.m_asyncFlush)
+    return;
+
+  exception_ptr exception;
+  {
+    unique_lock<mutex> lock(m_mutex);
+    m_cv.wait(lock, [this]() { return !m_hasPending; });
+    swap(exception, m_exception);
+  }
+  if (exception)
+    rethrow_exception(exception);
+}
+
+void BufferedFileWriter::WriteBuffer(Buffer const & buffer)
+{
+  if (m_op != FileWriter::OP_APPEND)
+    m_file->Seek(buffer.m_offset);
+
+  if (m_params.m_directIO)
+  {
+    bool const isAligned = buffer.m_offset % kAlignment == 0 && buffer.m_size % kAlignment == 0;
+    if (isAligned != m_isDirectIO)
+    {
+      if (!m_file->SetDirectIO(isAligned))
+        MYTHROW(Writer::WriteException, (GetName(), "Can't switch direct io", isAligned));
+      m_isDirectIO = isAligned;
+    }
+  }
+
+  m_file->Write(buffer.m_data, buffer.m_size);
+}
+
+void BufferedFileWriter::ThreadRoutine()
+{
+  unique_lock<mutex> lock(m_mutex);
+  while (true)
+  {
+    m_cv.wait(lock, [this]() { return m_hasPending || m_shutdown; });
+    if (!m_hasPending)
+      return;
+
+    exception_ptr exception;
+    lock.unlock();
+    try
+    {
+      WriteBuffer(m_pending);
+    }
+    catch (RootException const &)
+    {
+      exception = current_exception();
+    }
+    lock.lock();
+
+    m_exception = exception;
+    m_hasPending = false;
+    m_cv.notify_all();
+  }
+}
@@ -0,0 +1,101 @@
+#pragma once
+
+#include "coding/file_writer.hpp"
+#include "coding/writer.hpp"
+
+#include "base/macros.hpp"
+
+#include "std/condition_variable.hpp"
+#include "std/cstdint.hpp"
+#include "std/exception.hpp"
+#include "std/mutex.hpp"
+#include "std/string.hpp"
+#include "std/thread.hpp"
+#include "std/unique_ptr.hpp"
+#include "std/vector.hpp"
+
+namespace my { class FileData; }
+
+// Writer for write-heavy workloads with many small writes, e.g. for
+// intermediate data of the generator. Data is collected in two large
+// buffers which are aligned by kAlignment and a full buffer is written
+// by one call while the other one is filled. Stdio buffering is not used.
+//
+// When async flush is on, full buffers are written on a background
+// thread and an error of writing is thrown by the next call of Write(),
+// Seek() or Flush(). When direct io is on, buffers which are aligned
+// by kAlignment both in memory and in the file bypass the page cache.
+//
+// Not thread safe, like FileWriter.
+class BufferedFileWriter : public Writer
+{
+public:
+  struct Params
+  {
+    // Size of each of two buffers, it's rounded up by kAlignment.
+    size_t m_bufferSize = 8 * 1024 * 1024;
+    bool m_asyncFlush = true;
+    // O_DIRECT is supported on Linux only, the option is ignored
+    // with a warning on other platform and file systems.
+    bool m_directIO = false;
+  };
+
+  static size_t constexpr kAlignment = 4096;
+
+  explicit BufferedFileWriter(string const & fileName,
+                              FileWriter::Op op = FileWriter::OP_WRITE_TRUNCATE);
+  BufferedFileWriter(string const & fileName, FileWriter::Op op, Params const & params);
+  ~BufferedFileWriter() override;
+
+  // Seek() to the current position is free, otherwise the buffered data
+  // is passed to writing.
+  void Seek(uint64_t pos) override;
+  uint64_t Pos() const override { return m_pos; }
+  void Write(void const * p, size_t size) override;
+
+  // Writes all buffered data to the file and waits for it.
+  void Flush();
+
+  string const & GetName() const;
+
+private:
+  struct Buffer
+  {
+    vector<uint8_t> m_memory;
+    // Aligned beginning of the buffer in m_memory.
+    uint8_t * m_data = nullptr;
+    size_t m_size = 0;
+    // Position of the buffer in the file.
+    uint64_t m_offset = 0;
+  };
+
+  void InitBuffer(Buffer & buffer);
+  // Passes the current buffer to writing and starts a new one at m_pos.
+  void Submit();
+  void WaitForPending();
+  void WriteBuffer(Buffer const & buffer);
+  void ThreadRoutine();
+
+  unique_ptr<my::FileData> m_file;
+  FileWriter::Op const m_op;
+  Params m_params;
+  size_t m_capacity;
+
+  Buffer m_current;
+  uint64_t m_pos = 0;
+
+  // Used by the thread which is writing buffers only.
+  bool m_isDirectIO = false;
+
+  // Guarded by m_mutex.
+  Buffer m_pending;
+  bool m_hasPending = false;
+  bool m_shutdown = false;
+  exception_ptr m_exception;
+
+  mutex m_mutex;
+  condition_variable m_cv;
+  thread m_thread;
+
+  DISALLOW_COPY_AND_MOVE(BufferedFileWriter);
+};
@@ -80,7 +80,7 @@ public:
     huffman.ReadEncoding(source);
 
     bwtBuffer.clear();
-    huffman.ReadAndDecode(source, std::back_inserter(bwtBuffer));
+    huffman.ReadAndDecodeWithTable(source, std::back_inserter(bwtBuffer));
 
     size_t const n = bwtBuffer.size();
     base::MoveToFront mtf;
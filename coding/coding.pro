@@ -12,6 +12,7 @@ include($$ROOT_DIR/common.pri)
 
 SOURCES += \
     base64.cpp \
+    buffered_file_writer.cpp \
     compressed_bit_vector.cpp \
     csv_file_reader.cpp \
     file_container.cpp \
@@ -23,15 +24,19 @@ SOURCES += \
     internal/file_data.cpp \
     mmap_reader.cpp \
     multilang_utf8_string.cpp \
+    partitioned_elias_fano.cpp \
     point_to_integer.cpp \
     reader.cpp \
     reader_streambuf.cpp \
     reader_writer_ops.cpp \
+    section_hashes.cpp \
+    shared_page_cache.cpp \
     simple_dense_coding.cpp \
     traffic.cpp \
     transliteration.cpp \
     uri.cpp \
 #    varint_vector.cpp \
+    xxhash.cpp \
     zip_creator.cpp \
     zip_reader.cpp \
     zlib.cpp \
@@ -39,8 +44,10 @@ SOURCES += \
 HEADERS += \
     $$ROOT_DIR/3party/expat/expat_impl.h \
     base64.hpp \
+    bit_packed_vector.hpp \
     bit_streams.hpp \
     buffer_reader.hpp \
+    buffered_file_writer.hpp \
     bwt_coder.hpp \
     byte_stream.hpp \
     coder.hpp \
@@ -71,6 +78,7 @@ HEADERS += \
     mmap_reader.hpp \
     multilang_utf8_string.hpp \
     parse_xml.hpp \
+    partitioned_elias_fano.hpp \
     point_to_integer.hpp \
     polymorph_reader.hpp \
     read_write_utils.hpp \
@@ -79,6 +87,8 @@ HEADERS += \
     reader_streambuf.hpp \
     reader_wrapper.hpp \
     reader_writer_ops.hpp \
+    section_hashes.hpp \
+    shared_page_cache.hpp \
     simple_dense_coding.hpp \
     streams.hpp \
     streams_common.hpp \
@@ -97,6 +107,7 @@ HEADERS += \
 #    varint_vector.hpp \
     write_to_sink.hpp \
     writer.hpp \
+    xxhash.hpp \
     zip_creator.hpp \
     zip_reader.hpp \
     zlib.hpp \
@@ -0,0 +1,122 @@
+#include "testing/testing.hpp"
+
+#include "coding/bit_packed_vector.hpp"
+#include "coding/bit_streams.hpp"
+#include "coding/reader.hpp"
+#include "coding/writer.hpp"
+
+#include "base/logging.hpp"
+#include "base/timer.hpp"
+
+#include "std/random.hpp"
+#include "std/vector.hpp"
+
+using namespace coding;
+
+namespace
+{
+vector<uint8_t> Pack(vector<uint32_t> const & values, uint8_t bits)
+{
+  vector<uint8_t> buffer;
+  {
+    MemWriter<vector<uint8_t>> writer(buffer);
+    BitWriter<MemWriter<vector<uint8_t>>> bitWriter(writer);
+    for (auto const v : values)
+      bitWriter.WriteAtMost32Bits(v, bits);
+  }
+  return buffer;
+}
+
+struct CheckWidth
+{
+  template <typename TBits>
+  void operator()(TBits) const
+  {
+    uint8_t constexpr kBits = TBits::value;
+    TEST_EQUAL(kBits, m_bits, ());
+
+    mt19937 rng(kBits);
+    vector<uint32_t> values(m_size);
+    for (auto & v : values)
+      v = static_cast<uint32_t>(rng() & BitPacking<kBits>::kMask);
+
+    auto const buffer = Pack(values, kBits);
+    BitPackedVector<kBits> const vec(buffer.data(), values.size());
+    TEST_EQUAL(vec.Size(), values.size(), ());
+
+    for (size_t i = 0; i < values.size(); ++i)
+      TEST_EQUAL(vec.Get(i), values[i], (kBits, i));
+
+    // Ranges with all offsets inside of a group and all tails.
+    vector<uint32_t> unpacked;
+    for (size_t first = 0; first < min(values.size(), size_t{20}); ++first)
+    {
+      for (size_t count = 0; first + count <= values.size(); count += 7)
+      {
+        unpacked.assign(count, 0);
+        vec.Unpack(first, count, unpacked.data());
+        TEST(equal(unpacked.begin(), unpacked.end(), values.begin() + first), (kBits, first, count));
+      }
+    }
+
+    unpacked.clear();
+    vec.ForEach([&unpacked](uint32_t v) { unpacked.push_back(v); });
+    TEST_EQUAL(unpacked, values, (kBits));
+  }
+
+  uint8_t m_bits;
+  size_t m_size;
+};
+
+struct SumValues
+{
+  template <typename TBits>
+  void operator()(TBits) const
+  {
+    BitPackedVector<TBits::value>(m_data, m_size).ForEach([this](uint32_t v) { m_sum += v; });
+  }
+
+  uint8_t const * m_data;
+  uint64_t m_size;
+  uint64_t & m_sum;
+};
+}  // namespace
+
+UNIT_TEST(BitPackedVector_AllWidths)
+{
+  for (uint8_t bits = 1; bits <= 32; ++bits)
+  {
+    for (size_t size : {size_t{0}, size_t{1}, size_t{7}, size_t{8}, size_t{9}, size_t{300}})
+      DispatchBitsWidth(bits, CheckWidth{bits, size});
+  }
+}
+
+UNIT_TEST(BitPackedVector_Benchmark)
+{
+  uint8_t constexpr kBits = 3;
+  size_t constexpr kSize = 10000000;
+
+  mt19937 rng(0);
+  vector<uint32_t> values(kSize);
+  for (auto & v : values)
+    v = rng() % (1 << kBits);
+  auto const buffer = Pack(values, kBits);
+
+  my::Timer timer;
+  uint64_t sum1 = 0;
+  {
+    MemReader reader(buffer.data(), buffer.size());
+    ReaderSource<MemReader> src(reader);
+    BitReader<ReaderSource<MemReader>> bitReader(src);
+    for (size_t i = 0; i < kSize; ++i)
+      sum1 += bitReader.ReadAtMost32Bits(kBits);
+  }
+  LOG(LINFO, ("BitReader:", timer.ElapsedSeconds()));
+
+  timer.Reset();
+  uint64_t sum2 = 0;
+  DispatchBitsWidth(kBits, SumValues{buffer.data(), kSize, sum2});
+  LOG(LINFO, ("BitPackedVector:", timer.ElapsedSeconds()));
+
+  TEST_EQUAL(sum1, sum2, ());
+}
@@ -0,0 +1,128 @@
+#include "testing/testing.hpp"
+
+#include "coding/buffered_file_writer.hpp"
+#include "coding/file_reader.hpp"
+#include "coding/file_writer.hpp"
+
+#include "base/timer.hpp"
+
+#include "std/random.hpp"
+#include "std/string.hpp"
+#include "std/vector.hpp"
+
+namespace
+{
+string const kTestFile = "buffered_file_writer_test.tmp";
+string const kExpectedFile = "buffered_file_writer_test_expected.tmp";
+
+string ReadFile(string const & fileName)
+{
+  FileReader reader(fileName);
+  string data(static_cast<size_t>(reader.Size()), '\0');
+  reader.Read(0, &data[0], data.size());
+  return data;
+}
+
+// Writes the same sequence of small writes and seeks by both writers.
+template <typename TWriter>
+void WriteRandomData(TWriter & writer, uint32_t seed)
+{
+  mt19937 rng(seed);
+  vector<uint8_t> data;
+  uint64_t end = 0;
+  for (size_t i = 0; i < 5000; ++i)
+  {
+    if (rng() % 50 == 0)
+      writer.Seek(rng() % (end + 1));
+
+    data.resize(rng() % 100 + 1);
+    for (auto & c : data)
+      c = static_cast<uint8_t>(rng());
+    writer.Write(data.data(), data.size());
+    end = max(end, writer.Pos());
+  }
+}
+
+void TestParams(BufferedFileWriter::Params const & params)
+{
+  for (uint32_t seed = 0; seed < 3; ++seed)
+  {
+    {
+      FileWriter writer(kExpectedFile);
+      WriteRandomData(writer, seed);
+    }
+    {
+      BufferedFileWriter writer(kTestFile, FileWriter::OP_WRITE_TRUNCATE, params);
+      WriteRandomData(writer, seed);
+    }
+    TEST_EQUAL(ReadFile(kTestFile), ReadFile(kExpectedFile), (seed));
+  }
+
+  FileWriter::DeleteFileX(kTestFile);
+  FileWriter::DeleteFileX(kExpectedFile);
+}
+}  // namespace
+
+UNIT_TEST(BufferedFileWriter_Smoke)
+{
+  {
+    BufferedFileWriter writer(kTestFile);
+    TEST_EQUAL(writer.Pos(), 0, ());
+    writer.Write("abcdef", 6);
+    TEST_EQUAL(writer.Pos(), 6, ());
+    writer.Seek(2);
+    writer.Write("XY", 2);
+    TEST_EQUAL(writer.Pos(), 4, ());
+    writer.Flush();
+    TEST_EQUAL(ReadFile(kTestFile), "abXYef", ());
+  }
+  {
+    BufferedFileWriter writer(kTestFile, FileWriter::OP_APPEND);
+    TEST_EQUAL(writer.Pos(), 6, ());
+    writer.Write("gh", 2);
+  }
+  TEST_EQUAL(ReadFile(kTestFile), "abXYefgh", ());
+  FileWriter::DeleteFileX(kTestFile);
+}
+
+UNIT_TEST(BufferedFileWriter_Params)
+{
+  BufferedFileWriter::Params params;
+  // Small buffers are filled many times.
+  params.m_bufferSize = 100;
+  TestParams(params);
+
+  params.m_asyncFlush = false;
+  TestParams(params);
+
+  params.m_bufferSize = BufferedFileWriter::kAlignment;
+  params.m_directIO = true;
+  TestParams(params);
+
+  params.m_asyncFlush = true;
+  TestParams(params);
+}
+
+UNIT_TEST(BufferedFileWriter_Benchmark)
+{
+  size_t constexpr kRecordsCount = 10000000;
+  uint64_t const record = 0x0123456789ABCDEF;
+
+  my::Timer timer;
+  {
+    FileWriter writer(kTestFile);
+    for (size_t i = 0; i < kRecordsCount; ++i)
+      writer.Write(&record, sizeof(record));
+  }
+  LOG(LINFO, ("FileWriter:", timer.ElapsedSeconds()));
+
+  timer.Reset();
+  {
+    BufferedFileWriter writer(kTestFile);
+    for (size_t i = 0; i < kRecordsCount; ++i)
+      writer.Write(&record, sizeof(record));
+  }
+  LOG(LINFO, ("BufferedFileWriter:", timer.ElapsedSeconds()));
+
+  FileWriter::DeleteFileX(kTestFile);
+}
@@ -22,7 +22,9 @@ DEFINES += OMIM_UNIT_TEST_DISABLE_PLATFORM_INIT
 
 SOURCES += ../../testing/testingmain.cpp \
     base64_test.cpp \
+    bit_packed_vector_test.cpp \
     bit_streams_test.cpp \
+    buffered_file_writer_test.cpp \
     bwt_coder_tests.cpp \
     coder_util_test.cpp \
     compressed_bit_vector_test.cpp \
@@ -41,11 +43,14 @@ SOURCES += ../../testing/testingmain.cpp \
     mem_file_reader_test.cpp \
     mem_file_writer_test.cpp \
     multilang_utf8_string_test.cpp \
+    partitioned_elias_fano_test.cpp \
     png_decoder_test.cpp \
     point_to_integer_test.cpp \
     reader_cache_test.cpp \
     reader_test.cpp \
     reader_writer_ops_test.cpp \
+    section_hashes_test.cpp \
+    shared_page_cache_test.cpp \
     simple_dense_coding_test.cpp \
     succinct_mapper_test.cpp \
     text_storage_tests.cpp \
@@ -58,6 +63,7 @@ SOURCES += ../../testing/testingmain.cpp \
     varint_test.cpp \
 #    varint_vector_test.cpp \
     writer_test.cpp \
+    xxhash_test.cpp \
     zip_creator_test.cpp \
     zip_reader_test.cpp \
     zlib_test.cpp \
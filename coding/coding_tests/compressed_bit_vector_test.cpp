@@ -3,8 +3,12 @@
 #include "coding/compressed_bit_vector.hpp"
 #include "coding/writer.hpp"
 
+#include "base/logging.hpp"
+#include "base/timer.hpp"
+
 #include "std/algorithm.hpp"
 #include "std/iterator.hpp"
+#include "std/random.hpp"
 #include "std/set.hpp"
 
 namespace
@@ -295,6 +299,81 @@ UNIT_TEST(CompressedBitVector_Union4)
              coding::CompressedBitVector::StorageStrategy::Sparse /* resultStrategy */);
 }
 
+UNIT_TEST(CompressedBitVector_Subtract5)
+{
+  vector<uint64_t> setBits1;
+  for (size_t i = 0; i < 200; ++i)
+    setBits1.push_back(i);
+  vector<uint64_t> setBits2 = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+
+  auto cbv1 = coding::CompressedBitVectorBuilder::FromBitPositions(setBits1);
+  auto cbv2 = coding::CompressedBitVectorBuilder::FromBitPositions(setBits2);
+  TEST_EQUAL(coding::CompressedBitVector::StorageStrategy::Dense, cbv1->GetStorageStrategy(), ());
+  TEST_EQUAL(coding::CompressedBitVector::StorageStrategy::Dense, cbv2->GetStorageStrategy(), ());
+
+  // Groups of the first vector beyond the end of the second one are kept.
+  auto cbv3 = coding::CompressedBitVector::Subtract(*cbv1, *cbv2);
+  TEST(cbv3.get(), ());
+  CheckSubtraction(setBits1, setBits2, *cbv3);
+}
+
+UNIT_TEST(CompressedBitVector_Union5)
+{
+  vector<uint64_t> setBits1;
+  for (size_t i = 0; i < 64; ++i)
+    setBits1.push_back(i);
+
+  // The only bit of the sparse vector is the first bit of the next group.
+  vector<uint64_t> setBits2 = {64};
+  CheckUnion(setBits1, coding::CompressedBitVector::StorageStrategy::Dense /* strategy1 */,
+             setBits2, coding::CompressedBitVector::StorageStrategy::Sparse /* strategy2 */,
+             coding::CompressedBitVector::StorageStrategy::Dense /* resultStrategy */);
+
+  // Common bits are not duplicated.
+  setBits1 = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+  setBits2 = {5, 1000};
+  CheckUnion(setBits1, coding::CompressedBitVector::StorageStrategy::Dense /* strategy1 */,
+             setBits2, coding::CompressedBitVector::StorageStrategy::Sparse /* strategy2 */,
+             coding::CompressedBitVector::StorageStrategy::Sparse /* resultStrategy */);
+}
+
+UNIT_TEST(CompressedBitVector_RandomOps)
+{
+  mt19937 rng(0);
+  for (size_t test = 0; test < 200; ++test)
+  {
+    // Densities from very sparse to full make all pairs of strategies.
+    uint64_t const maxBit = uniform_int_distribution<uint64_t>(1, 1000)(rng);
+    auto generate = [&]()
+    {
+      uniform_int_distribution<uint32_t> percents(0, 100);
+      uint32_t const density = percents(rng);
+      vector<uint64_t> setBits;
+      for (uint64_t bit = 0; bit < maxBit; ++bit)
+      {
+        if (percents(rng) < density)
+          setBits.push_back(bit);
+      }
+      return setBits;
+    };
+
+    vector<uint64_t> setBits1 = generate();
+    vector<uint64_t> setBits2 = generate();
+    auto cbv1 = coding::CompressedBitVectorBuilder::FromBitPositions(setBits1);
+    auto cbv2 = coding::CompressedBitVectorBuilder::FromBitPositions(setBits2);
+
+    CheckIntersection(setBits1, setBits2, *coding::CompressedBitVector::Intersect(*cbv1, *cbv2));
+    CheckSubtraction(setBits1, setBits2, *coding::CompressedBitVector::Subtract(*cbv1, *cbv2));
+    CheckSubtraction(setBits2, setBits1, *coding::CompressedBitVector::Subtract(*cbv2, *cbv1));
+    CheckUnion(setBits1, setBits2, *coding::CompressedBitVector::Union(*cbv1, *cbv2));
+
+    vector<uint64_t> visited;
+    coding::CompressedBitVectorEnumerator::ForEach(
+        *cbv1, [&visited](uint64_t bit) { visited.push_back(bit); });
+    TEST_EQUAL(setBits1, visited, ());
+  }
+}
+
 UNIT_TEST(CompressedBitVector_SerializationDense)
 {
   int const kNumBits = 100;
@@ -467,3 +546,58 @@ UNIT_TEST(CompressedBitVector_SparseLeaveFirstNBits)
   for (uint64_t bit = 0; bit < (1 << 10); ++bit)
     TEST(!cbv->GetBit(bit), (bit));
 }
+
+UNIT_TEST(CompressedBitVector_SparseIntersectBenchmark)
+{
+  mt19937 rng(0);
+  auto generate = [&rng](size_t size, uint64_t maxBit)
+  {
+    uniform_int_distribution<uint64_t> bits(0, maxBit);
+    vector<uint64_t> setBits;
+    for (size_t i = 0; i < size; ++i)
+      setBits.push_back(bits(rng));
+    sort(setBits.begin(), setBits.end());
+    setBits.erase(unique(setBits.begin(), setBits.end()), setBits.end());
+    return setBits;
+  };
+
+  uint64_t const kMaxBit = 100000000;
+  vector<uint64_t> setBits1 = generate(1000, kMaxBit);
+  vector<uint64_t> setBits2 = generate(1000000, kMaxBit);
+  // Some positions are common for sure.
+  for (size_t i = 0; i < setBits1.size(); i += 2)
+    setBits2.push_back(setBits1[i]);
+  sort(setBits2.begin(), setBits2.end());
+  setBits2.erase(unique(setBits2.begin(), setBits2.end()), setBits2.end());
+
+  auto const cbv1 = coding::CompressedBitVectorBuilder::FromBitPositions(setBits1);
+  auto const cbv2 = coding::CompressedBitVectorBuilder::FromBitPositions(setBits2);
+  TEST_EQUAL(cbv1->GetStorageStrategy(), coding::CompressedBitVector::StorageStrategy::Sparse, ());
+  TEST_EQUAL(cbv2->GetStorageStrategy(), coding::CompressedBitVector::StorageStrategy::Sparse, ());
+
+  size_t const kNumRuns = 100;
+  vector<uint64_t> expected;
+  my::Timer timer;
+  for (size_t i = 0; i < kNumRuns; ++i)
+  {
+    expected.clear();
+    set_intersection(setBits1.begin(), setBits1.end(), setBits2.begin(), setBits2.end(),
+                     back_inserter(expected));
+  }
+  double const mergeTime = timer.ElapsedSeconds();
+
+  unique_ptr<coding::CompressedBitVector> result;
+  timer.Reset();
+  for (size_t i = 0; i < kNumRuns; ++i)
+    result = coding::CompressedBitVector::Intersect(*cbv1, *cbv2);
+  double const skipTime = timer.ElapsedSeconds();
+
+  TEST_GREATER_OR_EQUAL(expected.size(), setBits1.size() / 2, ());
+  vector<uint64_t> actual;
+  coding::CompressedBitVectorEnumerator::ForEach(
+      *result, [&actual](uint64_t bit) { actual.push_back(bit); });
+  TEST_EQUAL(actual, expected, ());
+
+  LOG(LINFO, ("Merge of vectors:", mergeTime, "seconds, skipping intersection:", skipTime,
+              "seconds"));
+}
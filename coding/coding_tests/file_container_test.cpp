@@ -206,6 +206,61 @@ UNIT_TEST(FilesContainer_RewriteExisting)
   FileWriter::DeleteFileX(fName);
 }
 
+UNIT_TEST(FilesContainer_WriteFiles)
+{
+  string const fName = "file_container.tmp";
+  char const * tags[] = { "small", "large", "empty" };
+  string const files[] = { "file_container_small.tmp", "file_container_large.tmp",
+                           "file_container_empty.tmp" };
+  MY_SCOPE_GUARD(deleteContainer, bind(&FileWriter::DeleteFileX, fName));
+  MY_SCOPE_GUARD(deleteFiles, [&files]()
+  {
+    for (auto const & file : files)
+      FileWriter::DeleteFileX(file);
+  });
+
+  vector<vector<uint8_t>> data(ARRAY_SIZE(files));
+  data[0] = {1, 2, 3};
+  for (size_t i = 0; i < 1000000; ++i)
+    data[1].push_back(static_cast<uint8_t>(i % 251));
+
+  for (size_t i = 0; i < ARRAY_SIZE(files); ++i)
+  {
+    FileWriter w(files[i]);
+    w.Write(data[i].data(), data[i].size());
+  }
+
+  {
+    FilesContainerW writer(fName);
+    writer.Write(vector<char>{'v'}, "version");
+    for (size_t i = 0; i < ARRAY_SIZE(files); ++i)
+      writer.Write(files[i], tags[i]);
+  }
+
+  // Replace the first section in the existing container.
+  data[0] = {4, 5};
+  {
+    FileWriter w(files[0]);
+    w.Write(data[0].data(), data[0].size());
+  }
+  {
+    FilesContainerW writer(fName, FileWriter::OP_WRITE_EXISTING);
+    writer.Write(files[0], tags[0]);
+  }
+
+  FilesContainerR reader(fName);
+  for (size_t i = 0; i < ARRAY_SIZE(files); ++i)
+  {
+    TEST(reader.IsExist(tags[i]), (tags[i]));
+    auto const r = reader.GetReader(tags[i]);
+    TEST_EQUAL(r.Size(), data[i].size(), (tags[i]));
+
+    vector<uint8_t> section(data[i].size());
+    r.Read(0, section.data(), section.size());
+    TEST_EQUAL(section, data[i], (tags[i]));
+  }
+}
+
 UNIT_TEST(FilesMappingContainer_Handle)
 {
   string const fName = "file_container.tmp";
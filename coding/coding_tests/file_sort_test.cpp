@@ -4,7 +4,11 @@
 #include "coding/write_to_sink.hpp"
 #include "coding/reader.hpp"
 
+#include "platform/platform.hpp"
+
 #include "std/random.hpp"
+#include "std/string.hpp"
+#include "std/utility.hpp"
 
 namespace
 {
@@ -49,3 +53,45 @@ UNIT_TEST(FileSorter_Random)
 
   TestFileSorter(data, "file_sorter_test_random.tmp", data.size() / 10);
 }
+
+namespace
+{
+  void TestRecordsFileSorter(size_t bufferBytes, char const * tmpFileName)
+  {
+    mt19937 rng(0);
+
+    // Records are strings of random size, keys are often repeated.
+    vector<pair<uint32_t, string>> records;
+    for (size_t i = 0; i < 1000; ++i)
+      records.emplace_back(rng() % 100, string(rng() % 50, static_cast<char>('a' + i % 26)));
+
+    vector<pair<uint32_t, string>> result;
+    {
+      RecordsFileSorter<uint32_t> sorter(bufferBytes, tmpFileName);
+      for (auto const & r : records)
+        sorter.Add(r.first, r.second.data(), r.second.size());
+      sorter.SortAndFinish([&result](uint32_t key, char const * data, size_t size)
+      {
+        result.emplace_back(key, string(data, size));
+      });
+    }
+    TEST(!Platform::IsFileExistsByFullPath(tmpFileName), ());
+
+    stable_sort(records.begin(), records.end(),
+                [](pair<uint32_t, string> const & a, pair<uint32_t, string> const & b)
+    {
+      return a.first < b.first;
+    });
+    TEST_EQUAL(result, records, ());
+  }
+}
+
+UNIT_TEST(RecordsFileSorter_InMemory)
+{
+  TestRecordsFileSorter(1024 * 1024, "records_file_sorter_test_memory.tmp");
+}
+
+UNIT_TEST(RecordsFileSorter_SeveralRuns)
+{
+  TestRecordsFileSorter(1000, "records_file_sorter_test_runs.tmp");
+}
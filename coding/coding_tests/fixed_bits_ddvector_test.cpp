@@ -76,4 +76,6 @@ UNIT_TEST(FixedBitsDDVector_Rand)
   TestWithData<7>(v);
   TestWithData<8>(v);
   TestWithData<9>(v);
+  TestWithData<20>(v);
+  TestWithData<24>(v);
 }
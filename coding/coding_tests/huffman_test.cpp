@@ -4,8 +4,11 @@
 #include "coding/reader.hpp"
 #include "coding/writer.hpp"
 
+#include "base/logging.hpp"
 #include "base/string_utils.hpp"
+#include "base/timer.hpp"
 
+#include "std/random.hpp"
 #include "std/vector.hpp"
 
 namespace
@@ -25,6 +28,36 @@ void TestDecode(coding::HuffmanCoder const & h, uint32_t bits, uint32_t len, uin
   TEST(h.Decode(code, received), ("Could not decode", code.bits, "( length", code.len, ")"));
   TEST_EQUAL(expected, received, ());
 }
+
+// Makes strings with a skewed distribution of symbols, so some of
+// the codes are longer than a byte.
+vector<strings::UniString> MakeRandomStrings(size_t count, uint32_t alphabetSize)
+{
+  mt19937 rng(0);
+  uniform_int_distribution<size_t> lengths(0, 40);
+
+  vector<strings::UniString> result(count);
+  for (auto & s : result)
+  {
+    s.resize(lengths(rng));
+    for (auto & c : s)
+    {
+      uniform_int_distribution<uint32_t> bounds(0, alphabetSize - 1);
+      uniform_int_distribution<uint32_t> symbols(0, bounds(rng));
+      c = 0x400 + symbols(rng);
+    }
+  }
+  return result;
+}
+
+vector<uint8_t> EncodeStrings(coding::HuffmanCoder const & h, vector<strings::UniString> const & strs)
+{
+  vector<uint8_t> buf;
+  MemWriter<vector<uint8_t>> writer(buf);
+  for (auto const & s : strs)
+    h.EncodeAndWrite(writer, s);
+  return buf;
+}
 }  // namespace
 
 namespace coding
@@ -127,4 +160,88 @@ UNIT_TEST(Huffman_Serialization_Data)
   TEST_EQUAL(expected, received, ());
 }
 
+UNIT_TEST(Huffman_TableDecoding)
+{
+  auto const strs = MakeRandomStrings(1000 /* count */, 200 /* alphabetSize */);
+  HuffmanCoder h;
+  h.Init(strs);
+  h.BuildDecoderTable();
+
+  size_t maxCodeLen = 0;
+  for (auto const & s : strs)
+  {
+    for (auto const c : s)
+    {
+      HuffmanCoder::Code code;
+      TEST(h.Encode(c, code), ());
+      maxCodeLen = max(maxCodeLen, code.len);
+    }
+  }
+  TEST_GREATER(maxCodeLen, CHAR_BIT, ());
+
+  vector<uint8_t> const buf = EncodeStrings(h, strs);
+  MemReader memReader(buf.data(), buf.size());
+  ReaderSource<MemReader> reader(memReader);
+  ReaderSource<MemReader> bitwiseReader(memReader);
+  for (auto const & s : strs)
+  {
+    strings::UniString received;
+    h.ReadAndDecode(reader, back_inserter(received));
+    TEST_EQUAL(s, received, ());
+
+    received.clear();
+    h.ReadAndDecodeBitwise(bitwiseReader, back_inserter(received));
+    TEST_EQUAL(s, received, ());
+    TEST_EQUAL(reader.Pos(), bitwiseReader.Pos(), ());
+  }
+  TEST_EQUAL(reader.Size(), 0, ());
+}
+
+UNIT_TEST(Huffman_DecodingBenchmark)
+{
+  auto const strs = MakeRandomStrings(100000 /* count */, 200 /* alphabetSize */);
+  my::Timer timer;
+  HuffmanCoder h;
+  h.Init(strs);
+  double const initTime = timer.ElapsedSeconds();
+  timer.Reset();
+  h.BuildDecoderTable();
+  double const tableTime = timer.ElapsedSeconds();
+  vector<uint8_t> const buf = EncodeStrings(h, strs);
+
+  size_t tableSymbols = 0;
+  size_t bitwiseSymbols = 0;
+  strings::UniString received;
+
+  timer.Reset();
+  {
+    MemReader memReader(buf.data(), buf.size());
+    ReaderSource<MemReader> reader(memReader);
+    for (size_t i = 0; i < strs.size(); ++i)
+    {
+      received.clear();
+      h.ReadAndDecode(reader, back_inserter(received));
+      tableSymbols += received.size();
+    }
+  }
+  double const tableDecodingTime = timer.ElapsedSeconds();
+
+  timer.Reset();
+  {
+    MemReader memReader(buf.data(), buf.size());
+    ReaderSource<MemReader> reader(memReader);
+    for (size_t i = 0; i < strs.size(); ++i)
+    {
+      received.clear();
+      h.ReadAndDecodeBitwise(reader, back_inserter(received));
+      bitwiseSymbols += received.size();
+    }
+  }
+  double const bitwiseTime = timer.ElapsedSeconds();
+
+  TEST_EQUAL(tableSymbols, bitwiseSymbols, ());
+  LOG(LINFO, ("Init:", initTime, "s, building of the table:", tableTime, "s"));
+  LOG(LINFO, ("Decoding of", tableSymbols, "symbols by table:", tableDecodingTime,
+              "s, bit by bit:", bitwiseTime, "s"));
+}
 }  // namespace coding
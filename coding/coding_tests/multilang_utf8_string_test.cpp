@@ -129,4 +129,60 @@ UNIT_TEST(MultilangString_HasString)
   
   TEST(!s.HasString(1), ());
   TEST(!s.HasString(32), ());
+  TEST(!s.HasString(StringUtf8Multilang::kUnsupportedLanguageCode), ());
+
+  // Languages are restored after deserialization.
+  vector<uint8_t> buffer;
+  {
+    MemWriter<vector<uint8_t>> writer(buffer);
+    s.Write(writer);
+  }
+  StringUtf8Multilang copy;
+  copy.AddString(1, "www");
+  MemReader reader(buffer.data(), buffer.size());
+  ReaderSource<MemReader> src(reader);
+  copy.Read(src);
+  TEST_EQUAL(copy, s, ());
+  TEST(copy.HasString(0), ());
+  TEST(copy.HasString(18), ());
+  TEST(copy.HasString(63), ());
+  TEST(!copy.HasString(1), ());
+
+  // Replacing of a string keeps other ones.
+  copy.AddString(18, "\xD0\xA0\xD0\xB0");
+  string str;
+  TEST(copy.GetString(18, str), ());
+  TEST_EQUAL(str, "\xD0\xA0\xD0\xB0", ());
+  TEST(copy.GetString(63, str), ());
+  TEST_EQUAL(str, "zzz", ());
+
+  copy.Clear();
+  TEST(!copy.HasString(0), ());
+  TEST(!copy.GetString(0, str), ());
+}
+
+UNIT_TEST(MultilangString_ForEachRef)
+{
+  StringUtf8Multilang s;
+  for (size_t i = 0; i < ARRAY_SIZE(gArr); ++i)
+    s.AddString(gArr[i].m_lang, gArr[i].m_str);
+
+  size_t index = 0;
+  s.ForEachRef([&index](int8_t lang, char const * name, size_t size)
+  {
+    TEST_LESS(index, ARRAY_SIZE(gArr), ());
+    TEST_EQUAL(lang, StringUtf8Multilang::GetLangIndex(gArr[index].m_lang), ());
+    TEST_EQUAL(string(name, size), gArr[index].m_str, ());
+    ++index;
+    return true;
+  });
+  TEST_EQUAL(index, ARRAY_SIZE(gArr), ());
+
+  index = 0;
+  s.ForEachRef([&index](int8_t /* lang */, char const * /* name */, size_t /* size */)
+  {
+    ++index;
+    return index < 2;
+  });
+  TEST_EQUAL(index, 2, ());
 }
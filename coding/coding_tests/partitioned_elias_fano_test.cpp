@@ -0,0 +1,144 @@
+#include "testing/testing.hpp"
+
+#include "coding/partitioned_elias_fano.hpp"
+
+#include "std/algorithm.hpp"
+#include "std/random.hpp"
+
+using namespace coding;
+
+namespace
+{
+void CheckSequence(vector<uint64_t> const & values)
+{
+  PartitionedEliasFano const ef(values);
+  TEST_EQUAL(ef.Size(), values.size(), ());
+  TEST_EQUAL(ef.Empty(), values.empty(), ());
+
+  vector<uint64_t> decoded;
+  ef.ForEach([&decoded](uint64_t value) { decoded.push_back(value); });
+  TEST_EQUAL(decoded, values, ());
+
+  decoded.clear();
+  for (PartitionedEliasFano::Iterator it(ef); it.IsValid(); it.Next())
+  {
+    TEST_EQUAL(it.GetIndex(), decoded.size(), ());
+    decoded.push_back(*it);
+  }
+  TEST_EQUAL(decoded, values, ());
+
+  for (size_t i = 0; i < values.size(); ++i)
+  {
+    TEST_EQUAL(ef.Select(i), values[i], (i));
+    TEST(ef.Contains(values[i]), (i));
+  }
+
+  if (values.empty())
+    return;
+
+  TEST_EQUAL(ef.Front(), values.front(), ());
+  TEST_EQUAL(ef.Back(), values.back(), ());
+  if (values.front() != 0)
+    TEST(!ef.Contains(values.front() - 1), ());
+  TEST(!ef.Contains(values.back() + 1), ());
+}
+}  // namespace
+
+UNIT_TEST(PartitionedEliasFano_Smoke)
+{
+  CheckSequence({});
+  CheckSequence({0});
+  CheckSequence({5});
+  CheckSequence({0, 1, 2, 3, 4, 5});
+  CheckSequence({1, 1, 1, 7, 7, 100});
+  CheckSequence({0, uint64_t{1} << 40, (uint64_t{1} << 62) + 1});
+
+  vector<uint64_t> values;
+  for (uint64_t i = 0; i < 1000; ++i)
+    values.push_back(i * i);
+  CheckSequence(values);
+
+  PartitionedEliasFano const ef(values);
+  TEST(!ef.Contains(2), ());
+  TEST(!ef.Contains(998 * 998 + 1), ());
+}
+
+UNIT_TEST(PartitionedEliasFano_Random)
+{
+  mt19937 rng(0);
+  for (size_t test = 0; test < 100; ++test)
+  {
+    size_t const size = uniform_int_distribution<size_t>(0, 2000)(rng);
+    // Ranges from dense sequences to very sparse ones.
+    uint64_t const maxGap = uint64_t{1} << uniform_int_distribution<uint32_t>(0, 40)(rng);
+    uniform_int_distribution<uint64_t> gaps(0, maxGap);
+
+    vector<uint64_t> values;
+    uint64_t value = gaps(rng);
+    for (size_t i = 0; i < size; ++i)
+    {
+      values.push_back(value);
+      value += gaps(rng);
+    }
+    CheckSequence(values);
+  }
+}
+
+UNIT_TEST(PartitionedEliasFano_NextGEQ)
+{
+  mt19937 rng(0);
+  vector<uint64_t> values;
+  for (uint64_t value = 10; values.size() < 10000; value += uniform_int_distribution<uint64_t>(1, 50)(rng))
+    values.push_back(value);
+  PartitionedEliasFano const ef(values);
+
+  {
+    PartitionedEliasFano::Iterator it(ef);
+    it.NextGEQ(0);
+    TEST(it.IsValid(), ());
+    TEST_EQUAL(*it, values.front(), ());
+
+    // The iterator is never moved back.
+    it.NextGEQ(values[5000]);
+    TEST_EQUAL(it.GetIndex(), 5000, ());
+    it.NextGEQ(values[100]);
+    TEST_EQUAL(it.GetIndex(), 5000, ());
+
+    it.NextGEQ(values.back() + 1);
+    TEST(!it.IsValid(), ());
+    it.NextGEQ(values.back() + 2);
+    TEST(!it.IsValid(), ());
+  }
+
+  for (size_t test = 0; test < 100; ++test)
+  {
+    PartitionedEliasFano::Iterator it(ef);
+    uint64_t target = 0;
+    while (true)
+    {
+      target += uniform_int_distribution<uint64_t>(0, 2000)(rng);
+      it.NextGEQ(target);
+
+      auto const expected = lower_bound(values.begin(), values.end(), target);
+      if (expected == values.end())
+      {
+        TEST(!it.IsValid(), (target));
+        break;
+      }
+      TEST(it.IsValid(), (target));
+      TEST_EQUAL(*it, *expected, (target));
+      TEST_EQUAL(it.GetIndex(), distance(values.begin(), expected), (target));
+    }
+  }
+}
+
+UNIT_TEST(PartitionedEliasFano_Size)
+{
+  vector<uint64_t> values;
+  for (uint64_t i = 0; i < 100000; ++i)
+    values.push_back(i * 16 + i % 7);
+  PartitionedEliasFano const ef(values);
+
+  // About 2 + log(16) bits per value and the bounds of partitions.
+  TEST_LESS(ef.GetBytesSize(), values.size(), ());
+}
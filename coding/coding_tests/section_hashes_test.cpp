@@ -0,0 +1,99 @@
+#include "testing/testing.hpp"
+
+#include "coding/file_container.hpp"
+#include "coding/file_writer.hpp"
+#include "coding/section_hashes.hpp"
+
+#include "base/logging.hpp"
+#include "base/timer.hpp"
+
+#include "defines.hpp"
+
+#include "std/random.hpp"
+#include "std/string.hpp"
+#include "std/vector.hpp"
+
+using namespace coding;
+
+namespace
+{
+string const kTestFile = "section_hashes_test.tmp";
+
+void WriteContainer(vector<pair<string, size_t>> const & sections)
+{
+  mt19937 rng(0);
+  FilesContainerW cont(kTestFile);
+  for (auto const & section : sections)
+  {
+    vector<uint8_t> data(section.second);
+    for (auto & c : data)
+      c = static_cast<uint8_t>(rng());
+    // Empty buffers are skipped by Write().
+    cont.GetWriter(section.first).Write(data.data(), data.size());
+  }
+}
+
+uint64_t GetOffset(string const & tag)
+{
+  return FilesContainerR(kTestFile).GetAbsoluteOffsetAndSize(tag).first;
+}
+
+void Corrupt(uint64_t pos)
+{
+  FileWriter writer(kTestFile, FileWriter::OP_WRITE_EXISTING);
+  writer.Seek(pos);
+  uint8_t const c = 0xAA;
+  writer.Write(&c, sizeof(c));
+}
+}  // namespace
+
+UNIT_TEST(SectionHashes_Smoke)
+{
+  // "big" takes several chunks.
+  size_t const kBigSize = 2 * SectionHashes::kChunkSize + 100;
+  WriteContainer({{"empty", 0}, {"small", 100}, {"big", kBigSize}});
+
+  TEST_EQUAL(SectionHashes::Verify(kTestFile), SectionHashes::Status::NoHashes, ());
+
+  SectionHashes::Write(kTestFile, 3);
+  TEST(FilesContainerR(kTestFile).IsExist(SECTION_HASHES_FILE_TAG), ());
+
+  // Hashes don't depend on the number of threads.
+  auto const hashes = SectionHashes::Compute(kTestFile, 1);
+  TEST_EQUAL(hashes.size(), 3, ());
+  TEST_EQUAL(hashes, SectionHashes::Compute(kTestFile, 4), ());
+
+  vector<string> corrupted;
+  TEST_EQUAL(SectionHashes::Verify(kTestFile, 2, corrupted), SectionHashes::Status::Ok, ());
+  TEST(corrupted.empty(), (corrupted));
+
+  Corrupt(GetOffset("big") + SectionHashes::kChunkSize + 1);
+  TEST_EQUAL(SectionHashes::Verify(kTestFile, 0, corrupted), SectionHashes::Status::Corrupted, ());
+  TEST_EQUAL(corrupted, vector<string>{"big"}, ());
+
+  // A section which is listed in the table is missing.
+  FilesContainerW(kTestFile, FileWriter::OP_WRITE_EXISTING).DeleteSection("small");
+  TEST_EQUAL(SectionHashes::Verify(kTestFile, 0, corrupted), SectionHashes::Status::Corrupted, ());
+  TEST_EQUAL(corrupted, vector<string>({"small", "big"}), ());
+
+  // Hashes are rewritten.
+  SectionHashes::Write(kTestFile);
+  TEST_EQUAL(SectionHashes::Verify(kTestFile), SectionHashes::Status::Ok, ());
+
+  FileWriter::DeleteFileX(kTestFile);
+}
+
+UNIT_TEST(SectionHashes_Benchmark)
+{
+  WriteContainer({{"0", 32 * 1024 * 1024}, {"1", 16 * 1024 * 1024}, {"2", 16 * 1024 * 1024}});
+  SectionHashes::Write(kTestFile);
+
+  for (size_t threadsCount : {size_t{1}, size_t{0}})
+  {
+    my::Timer timer;
+    TEST_EQUAL(SectionHashes::Verify(kTestFile, threadsCount), SectionHashes::Status::Ok, ());
+    LOG(LINFO, ("Threads:", threadsCount, "verification of 64 MB:", timer.ElapsedSeconds()));
+  }
+
+  FileWriter::DeleteFileX(kTestFile);
+}
@@ -0,0 +1,112 @@
+#include "testing/testing.hpp"
+
+#include "coding/file_reader.hpp"
+#include "coding/file_writer.hpp"
+#include "coding/shared_page_cache.hpp"
+
+#include "base/scope_guard.hpp"
+
+#include "std/algorithm.hpp"
+#include "std/bind.hpp"
+#include "std/random.hpp"
+#include "std/string.hpp"
+#include "std/vector.hpp"
+
+namespace
+{
+SharedPageCache::Page MakePage(size_t size, char c)
+{
+  return make_shared<vector<char> const>(size, c);
+}
+}  // namespace
+
+UNIT_TEST(SharedPageCache_Smoke)
+{
+  SharedPageCache cache(1 /* shardsCount */);
+  cache.SetCapacity(300);
+
+  uint32_t const id = cache.RegisterFile("file", 7);
+  TEST_EQUAL(cache.RegisterFile("file", 7), id, ());
+  TEST_NOT_EQUAL(cache.RegisterFile("file", 8), id, ());
+  TEST_NOT_EQUAL(cache.RegisterFile("other", 7), id, ());
+
+  cache.Put(id, 0, MakePage(100, 'a'));
+  cache.Put(id, 1, MakePage(100, 'b'));
+  cache.Put(id, 2, MakePage(100, 'c'));
+  TEST_EQUAL(cache.GetSize(), 300, ());
+
+  // Page 0 becomes the most recently used one, so page 1 is evicted.
+  TEST(cache.Get(id, 0), ());
+  cache.Put(id, 3, MakePage(100, 'd'));
+  TEST_EQUAL(cache.GetSize(), 300, ());
+  TEST(!cache.Get(id, 1), ());
+  TEST(cache.Contains(id, 0), ());
+  TEST(cache.Contains(id, 2), ());
+  TEST_EQUAL(cache.Get(id, 3)->front(), 'd', ());
+
+  cache.SetCapacity(100);
+  TEST_EQUAL(cache.GetSize(), 100, ());
+  TEST(cache.Contains(id, 3), ());
+
+  cache.Clear();
+  TEST_EQUAL(cache.GetSize(), 0, ());
+}
+
+UNIT_TEST(SharedPageCache_NewIdAfterUnregistration)
+{
+  SharedPageCache cache;
+  uint32_t const id = cache.RegisterFile("file", 10);
+  TEST_EQUAL(cache.RegisterFile("file", 10), id, ());
+
+  cache.UnregisterFile("file", 10);
+  TEST_EQUAL(cache.RegisterFile("file", 10), id, ());
+
+  cache.UnregisterFile("file", 10);
+  cache.UnregisterFile("file", 10);
+  TEST_NOT_EQUAL(cache.RegisterFile("file", 10), id, ());
+}
+
+UNIT_TEST(SharedPageCache_FileReaders)
+{
+  string const fileName = "shared_page_cache_test.bin";
+  MY_SCOPE_GUARD(deleter, bind(FileWriter::DeleteFileX, fileName));
+
+  vector<char> data(100000);
+  for (size_t i = 0; i < data.size(); ++i)
+    data[i] = static_cast<char>(i % 253);
+  {
+    FileWriter writer(fileName);
+    writer.Write(data.data(), data.size());
+  }
+
+  SharedPageCache & cache = SharedPageCache::Instance();
+  cache.SetCapacity(1 << 20);
+  MY_SCOPE_GUARD(disabler, bind(&SharedPageCache::SetCapacity, &cache, 0));
+
+  FileReader const reader1(fileName, false /* withExceptions */, 10 /* logPageSize */);
+  FileReader const reader2(fileName, false /* withExceptions */, 10 /* logPageSize */);
+
+  // Sequential reads.
+  for (size_t pos = 0; pos < data.size(); pos += 100)
+  {
+    size_t const len = min(static_cast<size_t>(100), data.size() - pos);
+    string read(len, '0');
+    reader1.Read(pos, &read[0], len);
+    TEST_EQUAL(read, string(data.begin() + pos, data.begin() + pos + len), (pos));
+  }
+
+  // Pages are already read by the first reader.
+  uint64_t const size = cache.GetSize();
+  TEST_GREATER_OR_EQUAL(size, data.size(), ());
+
+  mt19937 rng(0);
+  for (size_t i = 0; i < 10000; ++i)
+  {
+    size_t const pos = rng() % data.size();
+    size_t const len = min(static_cast<size_t>(1 + (rng() % 3000)), data.size() - pos);
+    string read(len, '0');
+    reader2.Read(pos, &read[0], len);
+    TEST_EQUAL(read, string(data.begin() + pos, data.begin() + pos + len), (pos, len, i));
+  }
+  TEST_EQUAL(cache.GetSize(), size, ());
+}
@@ -129,4 +129,48 @@ UNIT_TEST(TextStorage_Random)
   for (size_t i = ts.GetNumStrings() - 1; i < ts.GetNumStrings(); --i)
     TEST_EQUAL(ts.ExtractString(i), strings[i], ());
 }
+
+UNIT_TEST(TextStorage_Cache)
+{
+  int const kSeed = 42;
+  int const kNumStrings = 1000;
+  int const kBlockSize = 1000;
+  size_t const kMaxCachedBlocks = 3;
+  mt19937 engine(kSeed);
+
+  vector<string> strings;
+  for (int i = 0; i < kNumStrings; ++i)
+    strings.push_back(GenerateRandomString(engine));
+
+  vector<uint8_t> buffer;
+  DumpStrings(strings, kBlockSize, buffer);
+
+  MemReader reader(buffer.data(), buffer.size());
+  BlockedTextStorage<decltype(reader)> ts(reader, kMaxCachedBlocks);
+  TEST_EQUAL(ts.GetNumCachedBlocks(), 0, ());
+
+  uniform_int_distribution<size_t> uid(0, strings.size() - 1);
+  for (size_t i = 0; i < 1000; ++i)
+  {
+    auto const stringIx = uid(engine);
+    TEST_EQUAL(ts.ExtractString(stringIx), strings[stringIx], ());
+    TEST_LESS_OR_EQUAL(ts.GetNumCachedBlocks(), kMaxCachedBlocks, ());
+  }
+  TEST_EQUAL(ts.GetNumCachedBlocks(), kMaxCachedBlocks, ());
+
+  vector<size_t> stringIxs;
+  for (size_t i = 0; i < 1000; ++i)
+    stringIxs.push_back(uid(engine));
+  stringIxs.push_back(stringIxs.front());
+
+  auto const extracted = ts.ExtractStrings(stringIxs);
+  TEST_EQUAL(extracted.size(), stringIxs.size(), ());
+  for (size_t i = 0; i < stringIxs.size(); ++i)
+    TEST_EQUAL(extracted[i], strings[stringIxs[i]], ());
+  TEST_LESS_OR_EQUAL(ts.GetNumCachedBlocks(), kMaxCachedBlocks, ());
+
+  ts.ClearCache();
+  TEST_EQUAL(ts.GetNumCachedBlocks(), 0, ());
+  TEST(ts.ExtractStrings({}).empty(), ());
+}
 }  // namespace
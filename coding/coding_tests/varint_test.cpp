@@ -178,3 +178,39 @@ UNIT_TEST(ReadVarInt64Array)
   }
 }
 
+UNIT_TEST(ReadVarUint64Buffer)
+{
+  uint64_t const baseValues[] =
+  {
+    0, 1, 127, 128, 16383, 16384, (1ULL << 28) - 1, 1ULL << 28, 0xFFFFFFFF,
+    (1ULL << 56) - 1, 1ULL << 56, 1ULL << 63, 0xFFFFFFFFFFFFFFFFULL
+  };
+
+  // Runs of single byte values are mixed with longer values at different offsets.
+  for (size_t shift = 0; shift < 9; ++shift)
+  {
+    for (size_t i = 0; i < ARRAY_SIZE(baseValues); ++i)
+    {
+      vector<uint64_t> values;
+      for (size_t j = 0; j < shift; ++j)
+        values.push_back(j);
+      for (size_t j = i; j < ARRAY_SIZE(baseValues); ++j)
+      {
+        values.push_back(baseValues[j]);
+        values.push_back(j);
+      }
+
+      vector<unsigned char> data;
+      {
+        PushBackByteSink<vector<unsigned char> > dst(data);
+        for (auto const value : values)
+          WriteVarUint(dst, value);
+      }
+
+      vector<uint64_t> result;
+      void const * pEnd = ReadVarUint64Buffer(data.data(), data.data() + data.size(), result);
+      TEST_EQUAL(pEnd, data.data() + data.size(), (shift, i));
+      TEST_EQUAL(result, values, (shift, i));
+    }
+  }
+}
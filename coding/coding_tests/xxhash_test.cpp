@@ -0,0 +1,42 @@
+#include "testing/testing.hpp"
+
+#include "coding/xxhash.hpp"
+
+#include "std/algorithm.hpp"
+#include "std/string.hpp"
+#include "std/vector.hpp"
+
+using namespace coding;
+
+UNIT_TEST(XXHash64_ReferenceValues)
+{
+  auto const hash = [](string const & s, uint64_t seed) {
+    return XXHash64::Hash(s.data(), s.size(), seed);
+  };
+
+  TEST_EQUAL(hash("", 0), 0xEF46DB3751D8E999ULL, ());
+  TEST_EQUAL(hash("abc", 0), 0x44BC2CF5AD770999ULL, ());
+  TEST_EQUAL(hash("Nobody inspects the spammish repetition", 0), 0xFBCEA83C8A378BF1ULL, ());
+}
+
+UNIT_TEST(XXHash64_Streaming)
+{
+  vector<uint8_t> data(1000);
+  for (size_t i = 0; i < data.size(); ++i)
+    data[i] = static_cast<uint8_t>(i * 31 + 7);
+
+  for (uint64_t seed : {uint64_t{0}, uint64_t{12345}})
+  {
+    for (size_t size : {size_t{0}, size_t{3}, size_t{31}, size_t{32}, size_t{33}, size_t{1000}})
+    {
+      uint64_t const expected = XXHash64::Hash(data.data(), size, seed);
+      for (size_t step : {size_t{1}, size_t{5}, size_t{32}, size_t{100}})
+      {
+        XXHash64 hash(seed);
+        for (size_t i = 0; i < size; i += step)
+          hash.Update(data.data() + i, min(step, size - i));
+        TEST_EQUAL(hash.Digest(), expected, (seed, size, step));
+      }
+    }
+  }
+}
@@ -1,5 +1,7 @@
 #include "testing/testing.hpp"
 
+#include "coding/reader.hpp"
+#include "coding/writer.hpp"
 #include "coding/zlib.hpp"
 
 #include "base/macros.hpp"
@@ -84,4 +86,78 @@ UNIT_TEST(GZip_ForeignData)
   TEST(inflate(data, ARRAY_SIZE(data), back_inserter(s)), ());
   TEST_EQUAL(s, "Hello, World!", ());
 }
+
+UNIT_TEST(ZLib_Streaming)
+{
+  string original;
+  for (size_t i = 0; i < 100000; ++i)
+    original += strings::to_string(i * i);
+
+  for (auto const & p : g_combinations)
+  {
+    string compressed;
+    {
+      MemWriter<string> writer(compressed);
+      ZLib::DeflateWriter deflateWriter(writer, p.first /* format */,
+                                        Deflate::Level::DefaultCompression);
+      // Writes of different sizes, including the ones larger than the buffer.
+      for (size_t i = 0, size = 1; i < original.size(); i += size, size = size * 2 % 100000 + 1)
+        deflateWriter.Write(original.data() + i, min(size, original.size() - i));
+      TEST_EQUAL(deflateWriter.Pos(), original.size(), ());
+      deflateWriter.Finish();
+    }
+
+    string decompressed;
+    TEST(Inflate(p.second /* format */)(compressed, back_inserter(decompressed)), ());
+    TEST_EQUAL(original, decompressed, ());
+
+    MemReader reader(compressed.data(), compressed.size());
+    ZLib::InflateSource src(reader, p.second /* format */);
+    string streamed(original.size(), '\0');
+    src.Read(&streamed[0], 10);
+    src.Skip(ZLib::InflateSource::kBufferSize);
+    auto const pos = src.Pos();
+    TEST_EQUAL(pos, 10 + ZLib::InflateSource::kBufferSize, ());
+    src.Read(&streamed[pos], streamed.size() - pos);
+    TEST_EQUAL(streamed.substr(0, 10), original.substr(0, 10), ());
+    TEST_EQUAL(streamed.substr(pos), original.substr(pos), ());
+
+    // The data is over.
+    char c;
+    TEST_ANY_THROW(src.Read(&c, 1), ());
+  }
+}
+
+UNIT_TEST(ZLib_StreamingErrors)
+{
+  string compressed;
+  {
+    MemWriter<string> writer(compressed);
+    ZLib::DeflateWriter deflateWriter(writer, Deflate::Format::ZLib, Deflate::Level::BestSpeed);
+    string const s(10000, 'a');
+    deflateWriter.Write(s.data(), s.size());
+    TEST_ANY_THROW(deflateWriter.Seek(0), ());
+    // The data is flushed by the destructor.
+  }
+
+  string s(10000, '\0');
+  {
+    MemReader reader(compressed.data(), compressed.size() / 2);
+    ZLib::InflateSource src(reader, Inflate::Format::ZLib);
+    TEST_ANY_THROW(src.Read(&s[0], s.size()), ());
+  }
+
+  {
+    string corrupted = compressed;
+    corrupted[0] = 0;
+    MemReader reader(corrupted.data(), corrupted.size());
+    ZLib::InflateSource src(reader, Inflate::Format::ZLib);
+    TEST_ANY_THROW(src.Read(&s[0], s.size()), ());
+  }
+
+  MemReader reader(compressed.data(), compressed.size());
+  ZLib::InflateSource src(reader, Inflate::Format::ZLib);
+  src.Read(&s[0], s.size());
+  TEST_EQUAL(s, string(10000, 'a'), ());
+}
 }  // namespace
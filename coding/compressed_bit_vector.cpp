@@ -11,6 +11,31 @@ namespace coding
 {
 namespace
 {
+// Word-wise kernel for the bit groups of dense vectors. The loop has
+// neither range checks nor branches, so compilers vectorize it with
+// the instructions of the target platform (SSE2/AVX2, NEON) and no
+// platform-specific intrinsics are needed.
+template <typename TWordOp>
+void CombineBitGroups(uint64_t const * a, uint64_t const * b, size_t n, TWordOp const & op,
+                      uint64_t * res)
+{
+  for (size_t i = 0; i < n; ++i)
+    res[i] = op(a[i], b[i]);
+}
+
+// The same as DenseCBV::GetBit() but without a virtual call.
+bool TestBit(coding::DenseCBV const & cbv, uint64_t pos)
+{
+  uint64_t const group = pos / DenseCBV::kBlockSize;
+  return group < cbv.NumBitGroups() &&
+         ((cbv.GetBitGroups()[group] >> (pos % DenseCBV::kBlockSize)) & 1) != 0;
+}
+
+uint64_t GetBitMask(uint64_t pos)
+{
+  return static_cast<uint64_t>(1) << (pos % DenseCBV::kBlockSize);
+}
+
 struct IntersectOp
 {
   IntersectOp() {}
@@ -18,11 +43,9 @@ struct IntersectOp
   unique_ptr<coding::CompressedBitVector> operator()(coding::DenseCBV const & a,
                                                      coding::DenseCBV const & b) const
   {
-    size_t sizeA = a.NumBitGroups();
-    size_t sizeB = b.NumBitGroups();
-    vector<uint64_t> resGroups(min(sizeA, sizeB));
-    for (size_t i = 0; i < resGroups.size(); ++i)
-      resGroups[i] = a.GetBitGroup(i) & b.GetBitGroup(i);
+    vector<uint64_t> resGroups(min(a.NumBitGroups(), b.NumBitGroups()));
+    CombineBitGroups(a.GetBitGroups(), b.GetBitGroups(), resGroups.size(),
+                     [](uint64_t x, uint64_t y) { return x & y; }, resGroups.data());
     return coding::CompressedBitVectorBuilder::FromBitGroups(move(resGroups));
   }
 
@@ -30,12 +53,13 @@ struct IntersectOp
   unique_ptr<coding::CompressedBitVector> operator()(coding::DenseCBV const & a,
                                                      coding::SparseCBV const & b) const
   {
+    uint64_t const numBits = a.NumBitGroups() * DenseCBV::kBlockSize;
     vector<uint64_t> resPos;
-    for (size_t i = 0; i < b.PopCount(); ++i)
+    resPos.reserve(min(a.PopCount(), b.PopCount()));
+    for (auto it = b.Begin(); it.IsValid() && *it < numBits; it.Next())
     {
-      auto pos = b.Select(i);
-      if (a.GetBit(pos))
-        resPos.push_back(pos);
+      if (TestBit(a, *it))
+        resPos.push_back(*it);
     }
     return make_unique<coding::SparseCBV>(move(resPos));
   }
@@ -49,8 +73,29 @@ struct IntersectOp
   unique_ptr<coding::CompressedBitVector> operator()(coding::SparseCBV const & a,
                                                      coding::SparseCBV const & b) const
   {
+    // Both iterators skip to the current position of each other, so
+    // runs of positions which are absent in the other vector are
+    // skipped partition by partition.
     vector<uint64_t> resPos;
-    set_intersection(a.Begin(), a.End(), b.Begin(), b.End(), back_inserter(resPos));
+    auto i = a.Begin();
+    auto j = b.Begin();
+    while (i.IsValid() && j.IsValid())
+    {
+      if (*i < *j)
+      {
+        i.NextGEQ(*j);
+      }
+      else if (*j < *i)
+      {
+        j.NextGEQ(*i);
+      }
+      else
+      {
+        resPos.push_back(*i);
+        i.Next();
+        j.Next();
+      }
+    }
     return make_unique<coding::SparseCBV>(move(resPos));
   }
 };
@@ -62,39 +107,20 @@ struct SubtractOp
   unique_ptr<coding::CompressedBitVector> operator()(coding::DenseCBV const & a,
                                                      coding::DenseCBV const & b) const
   {
-    size_t sizeA = a.NumBitGroups();
-    size_t sizeB = b.NumBitGroups();
-    vector<uint64_t> resGroups(min(sizeA, sizeB));
-    for (size_t i = 0; i < resGroups.size(); ++i)
-      resGroups[i] = a.GetBitGroup(i) & ~b.GetBitGroup(i);
+    // Groups of |a| which are beyond the end of |b| are kept as is.
+    vector<uint64_t> resGroups(a.GetBitGroups(), a.GetBitGroups() + a.NumBitGroups());
+    CombineBitGroups(resGroups.data(), b.GetBitGroups(), min(a.NumBitGroups(), b.NumBitGroups()),
+                     [](uint64_t x, uint64_t y) { return x & ~y; }, resGroups.data());
     return CompressedBitVectorBuilder::FromBitGroups(move(resGroups));
   }
 
   unique_ptr<coding::CompressedBitVector> operator()(coding::DenseCBV const & a,
                                                      coding::SparseCBV const & b) const
   {
-    vector<uint64_t> resGroups(a.NumBitGroups());
-
-    size_t i = 0;
-    auto j = b.Begin();
-    for (; i < resGroups.size() && j < b.End(); ++i)
-    {
-      uint64_t const kBitsBegin = i * DenseCBV::kBlockSize;
-      uint64_t const kBitsEnd = (i + 1) * DenseCBV::kBlockSize;
-
-      uint64_t mask = 0;
-      for (; j < b.End() && *j < kBitsEnd; ++j)
-      {
-        ASSERT_GREATER_OR_EQUAL(*j, kBitsBegin, ());
-        mask |= static_cast<uint64_t>(1) << (*j - kBitsBegin);
-      }
-
-      resGroups[i] = a.GetBitGroup(i) & ~mask;
-    }
-
-    for (; i < resGroups.size(); ++i)
-      resGroups[i] = a.GetBitGroup(i);
-
+    uint64_t const numBits = a.NumBitGroups() * DenseCBV::kBlockSize;
+    vector<uint64_t> resGroups(a.GetBitGroups(), a.GetBitGroups() + a.NumBitGroups());
+    for (auto it = b.Begin(); it.IsValid() && *it < numBits; it.Next())
+      resGroups[*it / DenseCBV::kBlockSize] &= ~GetBitMask(*it);
     return CompressedBitVectorBuilder::FromBitGroups(move(resGroups));
   }
 
@@ -102,10 +128,11 @@ struct SubtractOp
                                                      coding::DenseCBV const & b) const
   {
     vector<uint64_t> resPos;
-    copy_if(a.Begin(), a.End(), back_inserter(resPos), [&](uint64_t bit)
-            {
-              return !b.GetBit(bit);
-            });
+    a.ForEach([&](uint64_t bit)
+              {
+                if (!TestBit(b, bit))
+                  resPos.push_back(bit);
+              });
     return CompressedBitVectorBuilder::FromBitPositions(move(resPos));
   }
 
@@ -113,7 +140,13 @@ struct SubtractOp
                                                      coding::SparseCBV const & b) const
   {
     vector<uint64_t> resPos;
-    set_difference(a.Begin(), a.End(), b.Begin(), b.End(), back_inserter(resPos));
+    auto j = b.Begin();
+    a.ForEach([&](uint64_t bit)
+              {
+                j.NextGEQ(bit);
+                if (!j.IsValid() || *j != bit)
+                  resPos.push_back(bit);
+              });
     return CompressedBitVectorBuilder::FromBitPositions(move(resPos));
   }
 };
@@ -125,71 +158,50 @@ struct UnionOp
   unique_ptr<coding::CompressedBitVector> operator()(coding::DenseCBV const & a,
                                                      coding::DenseCBV const & b) const
   {
-    size_t sizeA = a.NumBitGroups();
-    size_t sizeB = b.NumBitGroups();
-
-    size_t commonSize = min(sizeA, sizeB);
-    size_t resultSize = max(sizeA, sizeB);
-    vector<uint64_t> resGroups(resultSize);
-    for (size_t i = 0; i < commonSize; ++i)
-      resGroups[i] = a.GetBitGroup(i) | b.GetBitGroup(i);
-    if (a.NumBitGroups() == resultSize)
-    {
-      for (size_t i = commonSize; i < resultSize; ++i)
-        resGroups[i] = a.GetBitGroup(i);
-    }
-    else
-    {
-      for (size_t i = commonSize; i < resultSize; ++i)
-        resGroups[i] = b.GetBitGroup(i);
-    }
+    DenseCBV const & longer = a.NumBitGroups() >= b.NumBitGroups() ? a : b;
+    DenseCBV const & shorter = a.NumBitGroups() >= b.NumBitGroups() ? b : a;
+
+    vector<uint64_t> resGroups(longer.GetBitGroups(),
+                               longer.GetBitGroups() + longer.NumBitGroups());
+    CombineBitGroups(resGroups.data(), shorter.GetBitGroups(), shorter.NumBitGroups(),
+                     [](uint64_t x, uint64_t y) { return x | y; }, resGroups.data());
     return CompressedBitVectorBuilder::FromBitGroups(move(resGroups));
   }
 
   unique_ptr<coding::CompressedBitVector> operator()(coding::DenseCBV const & a,
                                                      coding::SparseCBV const & b) const
   {
-    size_t sizeA = a.NumBitGroups();
-    size_t sizeB = b.PopCount() == 0 ? 0 : (b.Select(b.PopCount() - 1) + DenseCBV::kBlockSize - 1) /
-                                               DenseCBV::kBlockSize;
+    size_t const sizeA = a.NumBitGroups();
+    size_t const sizeB = b.PopCount() == 0 ? 0 : b.Back() / DenseCBV::kBlockSize + 1;
     if (sizeB > sizeA)
     {
       vector<uint64_t> resPos;
+      resPos.reserve(a.PopCount() + b.PopCount());
       auto j = b.Begin();
       auto merge = [&](uint64_t va)
       {
-        while (j < b.End() && *j < va)
+        while (j.IsValid() && *j < va)
         {
           resPos.push_back(*j);
-          ++j;
+          j.Next();
         }
+        if (j.IsValid() && *j == va)
+          j.Next();
         resPos.push_back(va);
       };
       a.ForEach(merge);
-      for (; j < b.End(); ++j)
+      for (; j.IsValid(); j.Next())
         resPos.push_back(*j);
       return CompressedBitVectorBuilder::FromBitPositions(move(resPos));
     }
 
-    vector<uint64_t> resGroups(sizeA);
-
-    size_t i = 0;
-    auto j = b.Begin();
-    for (; i < sizeA || j < b.End(); ++i)
-    {
-      uint64_t const kBitsBegin = i * DenseCBV::kBlockSize;
-      uint64_t const kBitsEnd = (i + 1) * DenseCBV::kBlockSize;
-
-      uint64_t mask = i < sizeA ? a.GetBitGroup(i) : 0;
-      for (; j < b.End() && *j < kBitsEnd; ++j)
-      {
-        ASSERT_GREATER_OR_EQUAL(*j, kBitsBegin, ());
-        mask |= static_cast<uint64_t>(1) << (*j - kBitsBegin);
-      }
-
-      resGroups[i] = mask;
-    }
-
+    // All bits of |b| are inside the groups of |a|.
+    vector<uint64_t> resGroups(a.GetBitGroups(), a.GetBitGroups() + sizeA);
+    b.ForEach([&](uint64_t bit)
+              {
+                ASSERT_LESS(bit / DenseCBV::kBlockSize, sizeA, ());
+                resGroups[bit / DenseCBV::kBlockSize] |= GetBitMask(bit);
+              });
     return CompressedBitVectorBuilder::FromBitGroups(move(resGroups));
   }
 
@@ -203,7 +215,28 @@ struct UnionOp
                                                      coding::SparseCBV const & b) const
   {
     vector<uint64_t> resPos;
-    set_union(a.Begin(), a.End(), b.Begin(), b.End(), back_inserter(resPos));
+    resPos.reserve(a.PopCount() + b.PopCount());
+    auto i = a.Begin();
+    auto j = b.Begin();
+    while (i.IsValid() && j.IsValid())
+    {
+      if (*i <= *j)
+      {
+        if (*i == *j)
+          j.Next();
+        resPos.push_back(*i);
+        i.Next();
+      }
+      else
+      {
+        resPos.push_back(*j);
+        j.Next();
+      }
+    }
+    for (; i.IsValid(); i.Next())
+      resPos.push_back(*i);
+    for (; j.IsValid(); j.Next())
+      resPos.push_back(*j);
     return CompressedBitVectorBuilder::FromBitPositions(move(resPos));
   }
 };
@@ -359,34 +392,33 @@ unique_ptr<CompressedBitVector> DenseCBV::Clone() const
   return unique_ptr<CompressedBitVector>(cbv);
 }
 
-SparseCBV::SparseCBV(vector<uint64_t> const & setBits) : m_positions(setBits)
+uint64_t DenseCBV::GetMemorySize() const
 {
-  ASSERT(is_sorted(m_positions.begin(), m_positions.end()), ());
+  return sizeof(*this) + m_bitGroups.capacity() * sizeof(uint64_t);
 }
 
-SparseCBV::SparseCBV(vector<uint64_t> && setBits) : m_positions(move(setBits))
-{
-  ASSERT(is_sorted(m_positions.begin(), m_positions.end()), ());
-}
+SparseCBV::SparseCBV(vector<uint64_t> const & setBits) : m_positions(setBits) {}
+
+SparseCBV::SparseCBV(vector<uint64_t> && setBits) : m_positions(setBits) {}
 
 uint64_t SparseCBV::Select(size_t i) const
 {
-  ASSERT_LESS(i, m_positions.size(), ());
-  return m_positions[i];
+  ASSERT_LESS(i, m_positions.Size(), ());
+  return m_positions.Select(i);
 }
 
-uint64_t SparseCBV::PopCount() const { return m_positions.size(); }
+uint64_t SparseCBV::PopCount() const { return m_positions.Size(); }
 
-bool SparseCBV::GetBit(uint64_t pos) const
-{
-  return binary_search(m_positions.begin(), m_positions.end(), pos);
-}
+bool SparseCBV::GetBit(uint64_t pos) const { return m_positions.Contains(pos); }
 
 unique_ptr<CompressedBitVector> SparseCBV::LeaveFirstSetNBits(uint64_t n) const
 {
   if (PopCount() <= n)
     return Clone();
-  vector<uint64_t> positions(m_positions.begin(), m_positions.begin() + n);
+  vector<uint64_t> positions;
+  positions.reserve(n);
+  for (auto it = Begin(); positions.size() < n; it.Next())
+    positions.push_back(*it);
   return CompressedBitVectorBuilder::FromBitPositions(move(positions));
 }
 
@@ -399,7 +431,11 @@ void SparseCBV::Serialize(Writer & writer) const
 {
   uint8_t header = static_cast<uint8_t>(GetStorageStrategy());
   WriteToSink(writer, header);
-  rw::WriteVectorOfPOD(writer, m_positions);
+
+  vector<uint64_t> positions;
+  positions.reserve(m_positions.Size());
+  m_positions.ForEach([&positions](uint64_t pos) { positions.push_back(pos); });
+  rw::WriteVectorOfPOD(writer, positions);
 }
 
 unique_ptr<CompressedBitVector> SparseCBV::Clone() const
@@ -409,6 +445,8 @@ unique_ptr<CompressedBitVector> SparseCBV::Clone() const
   return unique_ptr<CompressedBitVector>(cbv);
 }
 
+uint64_t SparseCBV::GetMemorySize() const { return sizeof(*this) + m_positions.GetBytesSize(); }
+
 // static
 unique_ptr<CompressedBitVector> CompressedBitVectorBuilder::FromBitPositions(
     vector<uint64_t> const & setBits)
@@ -440,18 +478,22 @@ unique_ptr<CompressedBitVector> CompressedBitVectorBuilder::FromBitGroups(
     popCount += bits::PopCount(bitGroups[i]);
 
   if (DenseEnough(popCount, maxBit))
-    return DenseCBV::BuildFromBitGroups(move(bitGroups));
+  {
+    // The pop count is already known, so DenseCBV::BuildFromBitGroups() isn't used.
+    unique_ptr<DenseCBV> cbv(new DenseCBV());
+    cbv->m_bitGroups = move(bitGroups);
+    cbv->m_popCount = popCount;
+    return move(cbv);
+  }
 
   vector<uint64_t> setBits;
+  setBits.reserve(popCount);
   for (size_t i = 0; i < bitGroups.size(); ++i)
   {
-    for (size_t j = 0; j < kBlockSize; ++j)
-    {
-      if (((bitGroups[i] >> j) & 1) > 0)
-        setBits.push_back(kBlockSize * i + j);
-    }
+    for (uint64_t group = bitGroups[i]; group != 0; group &= group - 1)
+      setBits.push_back(kBlockSize * i + bits::NumLoZeroBits64(group));
   }
-  return make_unique<SparseCBV>(setBits);
+  return make_unique<SparseCBV>(move(setBits));
 }
 
 string DebugPrint(CompressedBitVector::StorageStrategy strat)
@@ -1,10 +1,12 @@
 #pragma once
 
+#include "coding/partitioned_elias_fano.hpp"
 #include "coding/read_write_utils.hpp"
 #include "coding/reader.hpp"
 #include "coding/writer.hpp"
 
 #include "base/assert.hpp"
+#include "base/bits.hpp"
 #include "base/ref_counted.hpp"
 
 #include "std/algorithm.hpp"
@@ -79,6 +81,9 @@ public:
 
   // Copies a bit vector and returns a pointer to the copy.
   virtual unique_ptr<CompressedBitVector> Clone() const = 0;
+
+  // Returns bytes of memory which are held by the bit vector.
+  virtual uint64_t GetMemorySize() const = 0;
 };
 
 string DebugPrint(CompressedBitVector::StorageStrategy strat);
@@ -105,17 +110,19 @@ public:
   {
     for (size_t i = 0; i < m_bitGroups.size(); ++i)
     {
-      for (size_t j = 0; j < kBlockSize; ++j)
-      {
-        if (((m_bitGroups[i] >> j) & 1) > 0)
-          f(kBlockSize * i + j);
-      }
+      // Visits set bits only, from the lowest one to the highest one.
+      for (uint64_t group = m_bitGroups[i]; group != 0; group &= group - 1)
+        f(kBlockSize * i + bits::NumLoZeroBits64(group));
     }
   }
 
   // Returns 0 if the group number is too large to be contained in m_bits.
   uint64_t GetBitGroup(size_t i) const;
 
+  // Returns a pointer to NumBitGroups() groups, may be used by the word-wise
+  // operations which don't need the range checks of GetBitGroup().
+  uint64_t const * GetBitGroups() const { return m_bitGroups.data(); }
+
   // CompressedBitVector overrides:
   uint64_t PopCount() const override;
   bool GetBit(uint64_t pos) const override;
@@ -123,6 +130,7 @@ public:
   StorageStrategy GetStorageStrategy() const override;
   void Serialize(Writer & writer) const override;
   unique_ptr<CompressedBitVector> Clone() const override;
+  uint64_t GetMemorySize() const override;
 
 private:
   vector<uint64_t> m_bitGroups;
@@ -133,7 +141,7 @@ class SparseCBV : public CompressedBitVector
 {
 public:
   friend class CompressedBitVectorBuilder;
-  using TIterator = vector<uint64_t>::const_iterator;
+  using TIterator = PartitionedEliasFano::Iterator;
 
   SparseCBV() = default;
 
@@ -147,8 +155,7 @@ public:
   template <typename TFn>
   void ForEach(TFn && f) const
   {
-    for (auto const & position : m_positions)
-      f(position);
+    m_positions.ForEach(f);
   }
 
   // CompressedBitVector overrides:
@@ -158,13 +165,18 @@ public:
   StorageStrategy GetStorageStrategy() const override;
   void Serialize(Writer & writer) const override;
   unique_ptr<CompressedBitVector> Clone() const override;
+  uint64_t GetMemorySize() const override;
+
+  // Returns an iterator over positions of the set bits, the iterator
+  // is able to skip to the next position not less than a given one.
+  inline TIterator Begin() const { return TIterator(m_positions); }
 
-  inline TIterator Begin() const { return m_positions.cbegin(); }
-  inline TIterator End() const { return m_positions.cend(); }
+  // Returns the position of the last set bit, the vector must not be empty.
+  inline uint64_t Back() const { return m_positions.Back(); }
 
 private:
   // 0-based positions of the set bits.
-  vector<uint64_t> m_positions;
+  PartitionedEliasFano m_positions;
 };
 
 class CompressedBitVectorBuilder
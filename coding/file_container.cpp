@@ -426,7 +426,17 @@ FileWriter FilesContainerW::GetWriter(Tag const & tag)
 
 void FilesContainerW::Write(string const & fPath, Tag const & tag)
 {
-  Write(ModelReaderPtr(make_unique<FileReader>(fPath)), tag);
+  uint64_t pos;
+  {
+    FileWriter writer = GetWriter(tag);
+    pos = writer.Pos();
+  }
+
+  // The section is written through a writer which isn't opened for append,
+  // since the kernel doesn't copy data to such files.
+  FileWriter writer(m_name, FileWriter::OP_WRITE_EXISTING);
+  writer.Seek(pos);
+  writer.WriteFile(fPath);
 }
 
 void FilesContainerW::Write(ModelReaderPtr reader, Tag const & tag)
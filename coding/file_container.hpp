@@ -235,6 +235,9 @@ public:
 
   FileWriter GetWriter(Tag const & tag);
 
+  /// Appends the file as a section. Sections may be prepared independently,
+  /// e.g. in parallel, in temporary files, which are copied here without
+  /// buffers in the user space when it's possible.
   void Write(string const & fPath, Tag const & tag);
   void Write(ModelReaderPtr reader, Tag const & tag);
   void Write(vector<char> const & buffer, Tag const & tag);
@@ -2,6 +2,8 @@
 #include "coding/reader_cache.hpp"
 #include "coding/internal/file_data.hpp"
 
+#include "std/unique_ptr.hpp"
+
 #ifndef LOG_FILE_READER_STATS
 #define LOG_FILE_READER_STATS 0
 #endif // LOG_FILE_READER_STATS
@@ -33,6 +35,11 @@ public:
   FileReaderData(string const & fileName, uint32_t logPageSize, uint32_t logPageCount)
     : m_FileData(fileName), m_ReaderCache(logPageSize, logPageCount)
   {
+    if (SharedPageCache::Instance().IsEnabled())
+    {
+      m_SharedCache =
+          make_unique<SharedReaderCache<FileDataWithCachedSize>>(fileName, logPageSize);
+    }
 #if LOG_FILE_READER_STATS
     m_ReadCallCount = 0;
 #endif
@@ -41,7 +48,7 @@ public:
   ~FileReaderData()
   {
 #if LOG_FILE_READER_STATS
-    LOG(LINFO, ("FileReader", GetName(), m_ReaderCache.GetStatsStr()));
+    LOG(LINFO, ("FileReader", GetName(), GetStatsStr()));
 #endif
   }
 
@@ -52,16 +59,25 @@ public:
 #if LOG_FILE_READER_STATS
     if (((++m_ReadCallCount) & LOG_FILE_READER_EVERY_N_READS_MASK) == 0)
     {
-      LOG(LINFO, ("FileReader", GetName(), m_ReaderCache.GetStatsStr()));
+      LOG(LINFO, ("FileReader", GetName(), GetStatsStr()));
     }
 #endif
 
+    if (m_SharedCache)
+      return m_SharedCache->Read(m_FileData, pos, p, size);
     return m_ReaderCache.Read(m_FileData, pos, p, size);
   }
 
 private:
+  string GetStatsStr() const
+  {
+    return m_SharedCache ? m_SharedCache->GetStatsStr() : m_ReaderCache.GetStatsStr();
+  }
+
   FileDataWithCachedSize m_FileData;
   ReaderCache<FileDataWithCachedSize, LOG_FILE_READER_STATS> m_ReaderCache;
+  // Is used instead of |m_ReaderCache| when SharedPageCache is enabled at creation.
+  unique_ptr<SharedReaderCache<FileDataWithCachedSize>> m_SharedCache;
 
 #if LOG_FILE_READER_STATS
   uint32_t m_ReadCallCount;
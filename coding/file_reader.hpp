@@ -6,6 +6,7 @@
 // FileReader, cheap to copy, not thread safe.
 // It is assumed that file is not modified during FireReader lifetime,
 // because of caching and assumption that Size() is constant.
+// Readers which are created while SharedPageCache is enabled share pages of the file.
 class FileReader : public ModelReader
 {
   using BaseType = ModelReader;
@@ -1,11 +1,13 @@
 #pragma once
 #include "coding/file_reader.hpp"
 #include "coding/file_writer.hpp"
+#include "base/assert.hpp"
 #include "base/base.hpp"
 #include "base/logging.hpp"
 #include "base/exception.hpp"
 #include "std/algorithm.hpp"
 #include "std/cstdlib.hpp"
+#include "std/cstring.hpp"
 #include "std/functional.hpp"
 #include "std/queue.hpp"
 #include "std/unique_ptr.hpp"
@@ -139,3 +141,226 @@ private:
   uint32_t m_ItemCount;
   LessT m_Less;
 };
+
+// Sorts records of arbitrary size by their keys when records don't fit in memory.
+// Records are accumulated in memory up to |bufferBytes|, sorted and written as runs
+// to a temporary file. Then runs are merged, every run is read sequentially through
+// its own buffer, so there are no random reads of records. When all records fit in
+// the memory, the temporary file isn't created. The sort is stable.
+// TKey must be trivially copyable.
+template <typename TKey, typename TLess = less<TKey>>
+class RecordsFileSorter
+{
+public:
+  RecordsFileSorter(size_t bufferBytes, string const & tmpFileName, TLess fLess = TLess())
+    : m_tmpFileName(tmpFileName), m_bufferBytes(bufferBytes), m_less(fLess)
+  {
+  }
+
+  ~RecordsFileSorter()
+  {
+    m_tmpWriter.reset();
+    if (m_tmpFileCreated)
+      FileWriter::DeleteFileX(m_tmpFileName);
+  }
+
+  void Add(TKey const & key, void const * data, size_t size)
+  {
+    if (!m_records.empty() &&
+        m_data.size() + size + (m_records.size() + 1) * sizeof(Record) > m_bufferBytes)
+    {
+      FlushRun();
+    }
+
+    m_records.push_back({key, m_data.size(), static_cast<uint32_t>(size)});
+    char const * p = static_cast<char const *>(data);
+    m_data.insert(m_data.end(), p, p + size);
+  }
+
+  // Calls |fn|(key, data, size) for all records in the order of keys.
+  template <typename TFn>
+  void SortAndFinish(TFn && fn)
+  {
+    if (m_runs.empty())
+    {
+      SortRecords();
+      for (auto const & r : m_records)
+        fn(r.m_key, m_data.data() + r.m_offset, static_cast<size_t>(r.m_size));
+      ClearBuffer();
+      return;
+    }
+
+    FlushRun();
+    m_tmpWriter.reset();
+    // Memory of records is given to buffers of runs.
+    ClearBuffer();
+
+    FileReader reader(m_tmpFileName);
+    size_t const kMinRunBufferBytes = 64 * 1024;
+    size_t const runBufferBytes = max(kMinRunBufferBytes, m_bufferBytes / m_runs.size());
+
+    vector<unique_ptr<RunReader>> runs;
+    KeyIndexPairGreater fGreater(m_less);
+    priority_queue<pair<TKey, size_t>, vector<pair<TKey, size_t>>, KeyIndexPairGreater> q(
+        fGreater);
+    for (size_t i = 0; i < m_runs.size(); ++i)
+    {
+      runs.emplace_back(new RunReader(reader, m_runs[i].first, m_runs[i].second, runBufferBytes));
+      if (runs.back()->Next())
+        q.emplace(runs.back()->GetKey(), i);
+    }
+
+    while (!q.empty())
+    {
+      size_t const i = q.top().second;
+      q.pop();
+
+      RunReader & run = *runs[i];
+      fn(run.GetKey(), run.GetData(), run.GetSize());
+      if (run.Next())
+        q.emplace(run.GetKey(), i);
+    }
+    m_runs.clear();
+  }
+
+private:
+  struct Record
+  {
+    TKey m_key;
+    size_t m_offset;
+    uint32_t m_size;
+  };
+
+  // Reads records of a run from [begin, end) of the temporary file.
+  class RunReader
+  {
+  public:
+    RunReader(FileReader const & reader, uint64_t begin, uint64_t end, size_t bufferBytes)
+      : m_reader(reader), m_pos(begin), m_end(end), m_bufferBytes(bufferBytes)
+    {
+    }
+
+    // Returns false at the end of the run.
+    bool Next()
+    {
+      if (m_pos == m_end && m_bufferPos == m_buffer.size())
+        return false;
+
+      uint32_t size = 0;
+      Read(&m_key, sizeof(m_key));
+      Read(&size, sizeof(size));
+      m_data.resize(size);
+      if (size != 0)
+        Read(&m_data[0], size);
+      return true;
+    }
+
+    TKey const & GetKey() const { return m_key; }
+    char const * GetData() const { return m_data.data(); }
+    size_t GetSize() const { return m_data.size(); }
+
+  private:
+    void Read(void * p, size_t size)
+    {
+      char * out = static_cast<char *>(p);
+      while (size != 0)
+      {
+        if (m_bufferPos == m_buffer.size())
+          FillBuffer();
+
+        size_t const count = min(size, m_buffer.size() - m_bufferPos);
+        memcpy(out, &m_buffer[m_bufferPos], count);
+        m_bufferPos += count;
+        out += count;
+        size -= count;
+      }
+    }
+
+    void FillBuffer()
+    {
+      size_t const count = static_cast<size_t>(min(static_cast<uint64_t>(m_bufferBytes),
+                                                   m_end - m_pos));
+      CHECK_GREATER(count, 0, ("Truncated run of the sorted records."));
+      m_buffer.resize(count);
+      m_reader.Read(m_pos, &m_buffer[0], count);
+      m_pos += count;
+      m_bufferPos = 0;
+    }
+
+    FileReader const & m_reader;
+    uint64_t m_pos;
+    uint64_t const m_end;
+    size_t const m_bufferBytes;
+    vector<char> m_buffer;
+    size_t m_bufferPos = 0;
+
+    TKey m_key;
+    vector<char> m_data;
+  };
+
+  // Items with equal keys are ordered by indices of their runs to keep the sort stable.
+  struct KeyIndexPairGreater
+  {
+    explicit KeyIndexPairGreater(TLess fLess) : m_less(fLess) {}
+    bool operator()(pair<TKey, size_t> const & a, pair<TKey, size_t> const & b) const
+    {
+      if (m_less(b.first, a.first))
+        return true;
+      if (m_less(a.first, b.first))
+        return false;
+      return a.second > b.second;
+    }
+    TLess m_less;
+  };
+
+  void SortRecords()
+  {
+    stable_sort(m_records.begin(), m_records.end(), [this](Record const & a, Record const & b)
+    {
+      return m_less(a.m_key, b.m_key);
+    });
+  }
+
+  void FlushRun()
+  {
+    if (m_records.empty())
+      return;
+
+    if (!m_tmpWriter)
+    {
+      m_tmpWriter.reset(new FileWriter(m_tmpFileName));
+      m_tmpFileCreated = true;
+    }
+
+    SortRecords();
+    uint64_t const begin = m_tmpWriter->Pos();
+    for (auto const & r : m_records)
+    {
+      m_tmpWriter->Write(&r.m_key, sizeof(r.m_key));
+      m_tmpWriter->Write(&r.m_size, sizeof(r.m_size));
+      m_tmpWriter->Write(m_data.data() + r.m_offset, r.m_size);
+    }
+    m_runs.emplace_back(begin, m_tmpWriter->Pos());
+
+    m_records.clear();
+    m_data.clear();
+  }
+
+  void ClearBuffer()
+  {
+    vector<Record>().swap(m_records);
+    vector<char>().swap(m_data);
+  }
+
+  string const m_tmpFileName;
+  size_t const m_bufferBytes;
+  TLess m_less;
+
+  vector<Record> m_records;
+  vector<char> m_data;
+
+  // Bounds of sorted runs in the temporary file.
+  vector<pair<uint64_t, uint64_t>> m_runs;
+  unique_ptr<FileWriter> m_tmpWriter;
+  bool m_tmpFileCreated = false;
+};
@@ -38,6 +38,12 @@ void FileWriter::Write(void const * p, size_t size)
   m_pFileData->Write(p, size);
 }
 
+void FileWriter::WriteFile(string const & fPath)
+{
+  fdata_t src(fPath, fdata_t::OP_READ);
+  m_pFileData->Write(src);
+}
+
 void FileWriter::WritePaddingByEnd(size_t factor) { WritePadding(Size(), factor); }
 
 void FileWriter::WritePaddingByPos(size_t factor) { WritePadding(Pos(), factor); }
@@ -34,6 +34,10 @@ public:
   void Seek(uint64_t pos) override;
   uint64_t Pos() const override;
   void Write(void const * p, size_t size) override;
+  // Writes the whole content of the file at the current position. The file is
+  // copied by the kernel when it's possible, so this writer shouldn't be opened
+  // for append for the best performance.
+  void WriteFile(string const & fPath);
 
   void WritePaddingByEnd(size_t factor);
   void WritePaddingByPos(size_t factor);
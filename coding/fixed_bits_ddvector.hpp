@@ -1,5 +1,6 @@
 #pragma once
 
+#include "bit_packed_vector.hpp"
 #include "bit_streams.hpp"
 #include "byte_stream.hpp"
 #include "dd_vector.hpp"
@@ -34,11 +35,11 @@ class FixedBitsDDVector
 {
   static_assert(is_unsigned<TSize>::value, "");
   static_assert(is_unsigned<TValue>::value, "");
-  // 16 - is the maximum bits count to get all needed bits in random access within uint32_t.
   static_assert(Bits > 0, "");
-  static_assert(Bits <= 16, "");
+  static_assert(Bits <= 32, "");
 
   using TSelf = FixedBitsDDVector<Bits, TReader, TSize, TValue>;
+  using TPacking = coding::BitPacking<static_cast<uint8_t>(Bits)>;
 
   struct IndexValue
   {
@@ -61,7 +62,7 @@ class FixedBitsDDVector
     return max(count, static_cast<uint64_t>(sizeof(TBlock)));
   }
 
-  static TBlock constexpr kMask = (1 << Bits) - 1;
+  static TBlock constexpr kMask = static_cast<TBlock>(TPacking::kMask);
   static TBlock constexpr kLargeValue = kMask - 1;
   static TBlock constexpr kUndefined = kMask;
 
@@ -87,7 +88,7 @@ public:
     TSize const size = ReadPrimitiveFromPos<TSize>(reader, 0);
 
     uint64_t const off1 = sizeof(TSize);
-    uint64_t const off2 = AlignBytesCount((size * Bits + CHAR_BIT - 1) / CHAR_BIT) + off1;
+    uint64_t const off2 = AlignBytesCount(TPacking::GetBytesCount(size)) + off1;
     return unique_ptr<TSelf>(new TSelf(reader.SubReader(off1, off2 - off1),
                                        reader.SubReader(off2, reader.Size() - off2),
                                        size));
@@ -97,15 +98,14 @@ public:
   {
     ASSERT_LESS(index, m_size, ());
     uint64_t const bitsOffset = index * Bits;
-
-    uint64_t bytesOffset = bitsOffset / CHAR_BIT;
-    size_t constexpr kBlockSize = sizeof(TBlock);
-    if (bytesOffset + kBlockSize > m_bits.Size())
-      bytesOffset = m_bits.Size() - kBlockSize;
-
-    TBlock v = ReadPrimitiveFromPos<TBlock>(m_bits, bytesOffset);
-    v >>= (bitsOffset - bytesOffset * CHAR_BIT);
-    v &= kMask;
+    uint64_t const bytesOffset = bitsOffset / CHAR_BIT;
+
+    // A word starting from the first byte of the value holds all its bits.
+    uint64_t block = 0;
+    m_bits.Read(bytesOffset, &block,
+                static_cast<size_t>(min(static_cast<uint64_t>(sizeof(block)),
+                                        m_bits.Size() - bytesOffset)));
+    TBlock const v = TPacking::Extract(block, static_cast<uint8_t>(bitsOffset % CHAR_BIT));
     if (v == kUndefined)
       return false;
 
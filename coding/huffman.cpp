@@ -4,6 +4,13 @@
 
 namespace coding
 {
+// static
+uint32_t constexpr HuffmanCoder::Node::kNoState;
+// static
+size_t constexpr HuffmanCoder::kTableBits;
+// static
+size_t constexpr HuffmanCoder::kTableSize;
+
 HuffmanCoder::~HuffmanCoder()
 {
   DeleteHuffmanTree(m_root);
@@ -42,12 +49,69 @@ void HuffmanCoder::BuildTables(Node * root, uint32_t path)
   BuildTables(root->r, path + (static_cast<uint32_t>(1) << root->depth));
 }
 
+void HuffmanCoder::BuildDecoderTable()
+{
+  m_table.clear();
+  m_tableSymbols.clear();
+  if (!m_root || m_root->isLeaf)
+    return;
+
+  vector<Node *> states;
+  AddTableStates(m_root, states);
+
+  m_table.resize(states.size() * kTableSize);
+  vector<uint32_t> symbols;
+  for (size_t i = 0; i < states.size(); ++i)
+    FillTable(states[i], states[i], 0 /* depth */, 0 /* bits */, symbols);
+}
+
+void HuffmanCoder::FillTable(Node const * state, Node const * cur, size_t depth, uint32_t bits,
+                             vector<uint32_t> & symbols)
+{
+  if (cur != nullptr && cur->isLeaf)
+  {
+    symbols.push_back(cur->symbol);
+    FillTable(state, m_root, depth, bits, symbols);
+    symbols.pop_back();
+    return;
+  }
+
+  if (cur == nullptr || depth == kTableBits)
+  {
+    // All the entries with these low bits are the same when the walk leads out of the tree.
+    for (uint32_t high = 0; (high << depth) < kTableSize; ++high)
+    {
+      TableEntry & entry = m_table[state->state * kTableSize + (bits | (high << depth))];
+      entry.symbols = base::asserted_cast<uint32_t>(m_tableSymbols.size());
+      entry.count = base::asserted_cast<uint32_t>(symbols.size());
+      entry.next = cur;
+    }
+    m_tableSymbols.insert(m_tableSymbols.end(), symbols.begin(), symbols.end());
+    return;
+  }
+
+  FillTable(state, cur->l, depth + 1, bits, symbols);
+  FillTable(state, cur->r, depth + 1, bits | (1 << depth), symbols);
+}
+
+void HuffmanCoder::AddTableStates(Node * root, vector<Node *> & states)
+{
+  if (!root || root->isLeaf || root->depth >= kTableBits)
+    return;
+  root->state = base::asserted_cast<uint32_t>(states.size());
+  states.push_back(root);
+  AddTableStates(root->l, states);
+  AddTableStates(root->r, states);
+}
+
 void HuffmanCoder::Clear()
 {
   DeleteHuffmanTree(m_root);
   m_root = nullptr;
   m_encoderTable.clear();
   m_decoderTable.clear();
+  m_table.clear();
+  m_tableSymbols.clear();
 }
 
 void HuffmanCoder::DeleteHuffmanTree(Node * root)
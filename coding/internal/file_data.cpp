@@ -6,14 +6,17 @@
 
 #include "base/exception.hpp"
 #include "base/logging.hpp"
+#include "base/macros.hpp"
 #include "base/string_utils.hpp"
 
+#include "std/algorithm.hpp"
 #include "std/cerrno.hpp"
 #include "std/cstring.hpp"
 #include "std/exception.hpp"
 #include "std/fstream.hpp"
 #include "std/target_os.hpp"
 #include "std/thread.hpp"
+#include "std/vector.hpp"
 
 #ifdef OMIM_OS_WINDOWS
   #include <io.h>
@@ -23,6 +26,14 @@
 #include "tizen/inc/FIo.hpp"
 #endif
 
+#if defined(OMIM_OS_LINUX) || defined(OMIM_OS_ANDROID)
+  #include <sys/sendfile.h>
+#endif
+
+#ifdef OMIM_OS_LINUX
+  #include <fcntl.h>
+#endif
+
 
 namespace my
 {
@@ -180,6 +191,43 @@ void FileData::Write(void const * p, size_t size)
 #endif
 }
 
+void FileData::Write(FileData & src)
+{
+  uint64_t const size = src.Size();
+  uint64_t pos = 0;
+
+#if defined(OMIM_OS_LINUX) || defined(OMIM_OS_ANDROID)
+  // Buffered data must be written before the file is changed by the kernel.
+  Flush();
+  uint64_t const begin = Pos();
+  off_t offset = 0;
+  while (pos < size)
+  {
+    // sendfile fails for files opened for append and on some file systems,
+    // the rest of the data is copied through the buffer then.
+    ssize_t const copied = sendfile(fileno(m_File), fileno(src.m_File), &offset,
+                                    static_cast<size_t>(min(size - pos, uint64_t{1} << 30)));
+    if (copied <= 0)
+      break;
+    pos += copied;
+  }
+  if (pos != 0 && fseek64(m_File, begin + pos, SEEK_SET))
+    MYTHROW(Writer::SeekException, (GetErrorProlog(), begin + pos));
+#endif
+
+  if (pos == size)
+    return;
+
+  vector<char> buffer(static_cast<size_t>(min(size - pos, uint64_t{READ_FILE_BUFFER_SIZE})));
+  while (pos < size)
+  {
+    size_t const toCopy = static_cast<size_t>(min(size - pos, uint64_t{buffer.size()}));
+    src.Read(pos, buffer.data(), toCopy);
+    Write(buffer.data(), toCopy);
+    pos += toCopy;
+  }
+}
+
 void FileData::Flush()
 {
 #ifdef OMIM_OS_TIZEN
@@ -206,6 +254,28 @@ void FileData::Truncate(uint64_t sz)
     MYTHROW(Writer::WriteException, (GetErrorProlog(), sz));
 }
 
+void FileData::DisableBuffering()
+{
+#ifndef OMIM_OS_TIZEN
+  if (setvbuf(m_File, nullptr, _IONBF, 0))
+    MYTHROW(Writer::WriteException, (GetErrorProlog()));
+#endif
+}
+
+bool FileData::SetDirectIO(bool enable)
+{
+#ifdef OMIM_OS_LINUX
+  int const fd = fileno(m_File);
+  int const flags = fcntl(fd, F_GETFL);
+  if (flags == -1)
+    return false;
+  return fcntl(fd, F_SETFL, enable ? (flags | O_DIRECT) : (flags & ~O_DIRECT)) == 0;
+#else
+  UNUSED_VALUE(enable);
+  return false;
+#endif
+}
+
 bool GetFileSize(string const & fName, uint64_t & sz)
 {
   try
@@ -37,10 +37,20 @@ public:
 
   void Read(uint64_t pos, void * p, size_t size);
   void Write(void const * p, size_t size);
+  /// Writes the whole content of |src| at the current position. When it's possible,
+  /// data is copied by the kernel, without buffers in the user space.
+  void Write(FileData & src);
 
   void Flush();
   void Truncate(uint64_t sz);
 
+  /// Turns off buffering in the user space, must be called before any other operation.
+  void DisableBuffering();
+  /// Turns on or off O_DIRECT, i.e. writes which bypass the page cache.
+  /// @return false if it's not supported by the platform or by the file system.
+  /// @note Currently it's supported on Linux only.
+  bool SetDirectIO(bool enable);
+
   string const & GetName() const { return m_FileName; }
 
 private:
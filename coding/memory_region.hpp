@@ -1,7 +1,9 @@
 #pragma once
 
 #include "coding/file_container.hpp"
+#include "coding/mmap_reader.hpp"
 
+#include "base/assert.hpp"
 #include "base/macros.hpp"
 
 #include "std/cstdint.hpp"
@@ -30,6 +32,28 @@ private:
   DISALLOW_COPY(MappedMemoryRegion);
 };
 
+// Memory of a reader which is mapped by MmapReader, see MmapReader::GetMappedData().
+// The region keeps the mapping alive.
+class MmapMemoryRegion : public MemoryRegion
+{
+public:
+  explicit MmapMemoryRegion(ModelReaderPtr const & reader)
+    : m_reader(reader), m_data(MmapReader::GetMappedData(*m_reader.GetPtr()))
+  {
+    ASSERT(m_data, (m_reader.GetName()));
+  }
+
+  // MemoryRegion overrides:
+  uint64_t Size() const override { return m_reader.Size(); }
+  uint8_t const * ImmutableData() const override { return m_data; }
+
+private:
+  ModelReaderPtr m_reader;
+  uint8_t const * m_data;
+
+  DISALLOW_COPY(MmapMemoryRegion);
+};
+
 class CopiedMemoryRegion : public MemoryRegion
 {
 public:
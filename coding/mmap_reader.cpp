@@ -2,6 +2,7 @@
 
 #include "std/target_os.hpp"
 #include "std/cstring.hpp"
+#include "std/vector.hpp"
 
 // @TODO we don't support windows at the moment
 #ifndef OMIM_OS_WINDOWS
@@ -91,9 +92,70 @@ uint8_t * MmapReader::Data() const
   return m_data->m_memory;
 }
 
+// static
+uint8_t const * MmapReader::GetMappedData(Reader const & reader)
+{
+  auto const * mapped = dynamic_cast<MmapReader const *>(&reader);
+  if (!mapped)
+    return nullptr;
+  return mapped->m_data->m_memory + mapped->m_offset;
+}
+
 void MmapReader::SetOffsetAndSize(uint64_t offset, uint64_t size)
 {
   ASSERT_LESS_OR_EQUAL(offset + size, Size(), (offset, size));
   m_offset = offset;
   m_size = size;
 }
+
+void MmapReader::Advise(Advice advice, uint64_t pos, uint64_t size) const
+{
+  ASSERT_LESS_OR_EQUAL(pos + size, Size(), (pos, size));
+  // @TODO add windows support
+#ifndef OMIM_OS_WINDOWS
+  int flag = MADV_NORMAL;
+  switch (advice)
+  {
+  case Advice::Normal: flag = MADV_NORMAL; break;
+  case Advice::Random: flag = MADV_RANDOM; break;
+  case Advice::Sequential: flag = MADV_SEQUENTIAL; break;
+  case Advice::WillNeed: flag = MADV_WILLNEED; break;
+  case Advice::DontNeed: flag = MADV_DONTNEED; break;
+  }
+
+  // madvise() needs an address which is aligned by a page.
+  uint64_t const pageSize = static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+  uint64_t const begin = m_offset + pos;
+  uint64_t const alignedBegin = begin - begin % pageSize;
+  if (size != 0)
+    madvise(m_data->m_memory + alignedBegin, begin + size - alignedBegin, flag);
+#endif
+}
+
+uint64_t MmapReader::GetResidentBytes() const
+{
+  // @TODO add windows support
+#ifndef OMIM_OS_WINDOWS
+  if (m_size == 0)
+    return 0;
+
+  uint64_t const pageSize = static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+  uint64_t const alignedBegin = m_offset - m_offset % pageSize;
+  uint64_t const length = m_offset + m_size - alignedBegin;
+
+#if defined(OMIM_OS_MAC) || defined(OMIM_OS_IPHONE)
+  vector<char> pages((length + pageSize - 1) / pageSize);
+#else
+  vector<unsigned char> pages((length + pageSize - 1) / pageSize);
+#endif
+  if (mincore(m_data->m_memory + alignedBegin, length, pages.data()) != 0)
+    return 0;
+
+  uint64_t residentPages = 0;
+  for (auto const page : pages)
+    residentPages += (page & 1);
+  return residentPages * pageSize;
+#else
+  return 0;
+#endif
+}
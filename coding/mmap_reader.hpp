@@ -17,6 +17,16 @@ class MmapReader : public ModelReader
   MmapReader(MmapReader const & reader, uint64_t offset, uint64_t size);
 
 public:
+  /// Hints about the pattern of access to the mapped memory, see madvise(2).
+  enum class Advice
+  {
+    Normal,
+    Random,
+    Sequential,
+    WillNeed,
+    DontNeed
+  };
+
   explicit MmapReader(string const & fileName);
 
   uint64_t Size() const override;
@@ -26,6 +36,19 @@ public:
   /// Direct file/memory access
   uint8_t * Data() const;
 
+  /// Returns memory of |reader| when it's a MmapReader and nullptr otherwise. The file
+  /// is mapped read-only and shared, so structures which are used in place of the memory
+  /// share physical pages with all processes which map the file.
+  static uint8_t const * GetMappedData(Reader const & reader);
+
+  /// Gives |advice| for [pos, pos + size) of this reader. It's only a hint,
+  /// errors are ignored.
+  void Advise(Advice advice, uint64_t pos, uint64_t size) const;
+  void Advise(Advice advice) const { Advise(advice, 0, Size()); }
+
+  /// Returns the size of pages of this reader which are in physical memory now.
+  uint64_t GetResidentBytes() const;
+
 protected:
   // Used in special derived readers.
   void SetOffsetAndSize(uint64_t offset, uint64_t size);
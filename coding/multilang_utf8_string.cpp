@@ -127,34 +127,60 @@ char const * StringUtf8Multilang::GetTransliteratorIdByCode(int8_t langCode)
   return g_languages[langCode].m_transliteratorId;
 }
 
-size_t StringUtf8Multilang::GetNextIndex(size_t i) const
+// static
+size_t StringUtf8Multilang::GetNextIndex(char const * s, size_t sz, size_t i)
 {
   ++i;
-  size_t const sz = m_s.size();
 
-  while (i < sz && (m_s[i] & 0xC0) != 0x80)
+  while (i < sz && (s[i] & 0xC0) != 0x80)
   {
-    if ((m_s[i] & 0x80) == 0)
+    if ((s[i] & 0x80) == 0)
       i += 1;
-    else if ((m_s[i] & 0xFE) == 0xFE)
+    else if ((s[i] & 0xFE) == 0xFE)
       i += 7;
-    else if ((m_s[i] & 0xFC) == 0xFC)
+    else if ((s[i] & 0xFC) == 0xFC)
       i += 6;
-    else if ((m_s[i] & 0xF8) == 0xF8)
+    else if ((s[i] & 0xF8) == 0xF8)
       i += 5;
-    else if ((m_s[i] & 0xF0) == 0xF0)
+    else if ((s[i] & 0xF0) == 0xF0)
       i += 4;
-    else if ((m_s[i] & 0xE0) == 0xE0)
+    else if ((s[i] & 0xE0) == 0xE0)
       i += 3;
-    else if ((m_s[i] & 0xC0) == 0xC0)
+    else if ((s[i] & 0xC0) == 0xC0)
       i += 2;
   }
 
   return i;
 }
 
+size_t StringUtf8Multilang::GetNextIndex(size_t i) const
+{
+  return GetNextIndex(m_s.data(), m_s.size(), i);
+}
+
+void StringUtf8Multilang::UpdateLangs()
+{
+  m_langs = 0;
+  for (size_t i = 0; i < m_s.size(); i = GetNextIndex(i))
+    m_langs |= uint64_t{1} << (m_s[i] & 0x3F);
+}
+
 void StringUtf8Multilang::AddString(int8_t lang, string const & utf8s)
 {
+  if (lang < 0 || lang >= kMaxSupportedLanguages)
+  {
+    ASSERT(false, ("Invalid language code", lang));
+    return;
+  }
+
+  if (!HasString(lang))
+  {
+    m_langs |= uint64_t{1} << lang;
+    m_s.push_back(lang | 0x80);
+    m_s.insert(m_s.end(), utf8s.begin(), utf8s.end());
+    return;
+  }
+
   size_t i = 0;
   size_t const sz = m_s.size();
 
@@ -172,12 +198,14 @@ void StringUtf8Multilang::AddString(int8_t lang, string const & utf8s)
     i = next;
   }
 
-  m_s.push_back(lang | 0x80);
-  m_s.insert(m_s.end(), utf8s.begin(), utf8s.end());
+  ASSERT(false, ("Language", lang, "is not found in", m_s));
 }
 
 bool StringUtf8Multilang::GetString(int8_t lang, string & utf8s) const
 {
+  if (!HasString(lang))
+    return false;
+
   size_t i = 0;
   size_t const sz = m_s.size();
 
@@ -200,13 +228,9 @@ bool StringUtf8Multilang::GetString(int8_t lang, string & utf8s) const
 
 bool StringUtf8Multilang::HasString(int8_t lang) const
 {
-  for(size_t i = 0; i < m_s.size(); i = GetNextIndex(i))
-  {
-    if ((m_s[i] & 0x3F) == lang)
-      return true;
-  }
-  
-  return false;
+  if (lang < 0 || lang >= kMaxSupportedLanguages)
+    return false;
+  return (m_langs >> lang) & 1;
 }
 
 namespace
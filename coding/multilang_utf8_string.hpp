@@ -6,7 +6,9 @@
 
 #include "base/assert.hpp"
 
+#include "std/algorithm.hpp"
 #include "std/array.hpp"
+#include "std/cstdint.hpp"
 #include "std/string.hpp"
 
 namespace utils
@@ -41,8 +43,13 @@ void ReadString(TSource & src, string & s)
 class StringUtf8Multilang
 {
   string m_s;
+  // The i'th bit is set when there is a string for the language with code i,
+  // so lookups of missing languages don't scan m_s.
+  uint64_t m_langs = 0;
 
+  static size_t GetNextIndex(char const * s, size_t size, size_t i);
   size_t GetNextIndex(size_t i) const;
+  void UpdateLangs();
 
 public:
   static int8_t constexpr kUnsupportedLanguageCode = -1;
@@ -85,7 +92,11 @@ public:
     return !(*this == rhs);
   }
 
-  inline void Clear() { m_s.clear(); }
+  inline void Clear()
+  {
+    m_s.clear();
+    m_langs = 0;
+  }
   inline bool IsEmpty() const { return m_s.empty(); }
 
   void AddString(int8_t lang, string const & utf8s);
@@ -99,17 +110,42 @@ public:
   template <class T>
   void ForEach(T && fn) const
   {
+    // The same buffer is reused for all strings.
+    string utf8s;
     size_t i = 0;
     size_t const sz = m_s.size();
     while (i < sz)
     {
       size_t const next = GetNextIndex(i);
-      if (!fn((m_s[i] & 0x3F), m_s.substr(i + 1, next - i - 1)))
+      utf8s.assign(m_s, i + 1, next - i - 1);
+      if (!fn((m_s[i] & 0x3F), utf8s))
         return;
       i = next;
     }
   }
 
+  /// Calls |fn(int8_t lang, char const * utf8s, size_t size)| for every string of
+  /// serialized |data| of |size| bytes without copying of strings.
+  template <class T>
+  static void ForEachRef(char const * data, size_t size, T && fn)
+  {
+    size_t i = 0;
+    while (i < size)
+    {
+      // Broken utf8 sequence at the end mustn't lead out of |data|.
+      size_t const next = min(GetNextIndex(data, size, i), size);
+      if (!fn((data[i] & 0x3F), data + i + 1, next - i - 1))
+        return;
+      i = next;
+    }
+  }
+
+  template <class T>
+  void ForEachRef(T && fn) const
+  {
+    ForEachRef(m_s.data(), m_s.size(), fn);
+  }
+
   bool GetString(int8_t lang, string & utf8s) const;
   bool GetString(string const & lang, string & utf8s) const
   {
@@ -132,6 +168,7 @@ public:
   template <class TSource> void Read(TSource & src)
   {
     utils::ReadString(src, m_s);
+    UpdateLangs();
   }
 };
 
@@ -0,0 +1,196 @@
+#include "coding/partitioned_elias_fano.hpp"
+
+#include "base/bits.hpp"
+
+#include "std/algorithm.hpp"
+
+namespace coding
+{
+namespace
+{
+uint64_t constexpr kWordBits = 64;
+
+void WriteBits(vector<uint64_t> & bits, uint64_t pos, uint64_t value, uint8_t numBits)
+{
+  if (numBits == 0)
+    return;
+  ASSERT_LESS(numBits, kWordBits, ());
+  size_t const word = static_cast<size_t>(pos / kWordBits);
+  uint64_t const shift = pos % kWordBits;
+  bits[word] |= value << shift;
+  if (shift + numBits > kWordBits)
+    bits[word + 1] |= value >> (kWordBits - shift);
+}
+
+uint64_t ReadBits(vector<uint64_t> const & bits, uint64_t pos, uint8_t numBits)
+{
+  if (numBits == 0)
+    return 0;
+  size_t const word = static_cast<size_t>(pos / kWordBits);
+  uint64_t const shift = pos % kWordBits;
+  uint64_t value = bits[word] >> shift;
+  if (shift + numBits > kWordBits)
+    value |= bits[word + 1] << (kWordBits - shift);
+  return value & ((uint64_t{1} << numBits) - 1);
+}
+
+// Returns the number of lower bits which minimizes the size of an
+// Elias-Fano encoding of |count| values from the range [0, maxValue].
+uint8_t GetNumLowBits(uint64_t maxValue, size_t count)
+{
+  uint64_t const ratio = maxValue / count;
+  return ratio == 0 ? 0 : bits::FloorLog(ratio);
+}
+}  // namespace
+
+// static
+size_t constexpr PartitionedEliasFano::kPartitionSize;
+
+PartitionedEliasFano::Iterator::Iterator(PartitionedEliasFano const & ef) : m_ef(&ef)
+{
+  LoadPartition(0);
+}
+
+void PartitionedEliasFano::Iterator::NextGEQ(uint64_t value)
+{
+  if (!IsValid() || m_values[m_index] >= value)
+    return;
+
+  auto const & upperBounds = m_ef->m_upperBounds;
+  if (value > upperBounds[m_partition])
+  {
+    auto const it = lower_bound(upperBounds.begin() + m_partition + 1, upperBounds.end(), value);
+    LoadPartition(static_cast<size_t>(distance(upperBounds.begin(), it)));
+    if (!IsValid())
+      return;
+  }
+
+  auto const begin = m_values.begin();
+  m_index = static_cast<size_t>(distance(begin, lower_bound(begin + m_index, begin + m_count, value)));
+  ASSERT_LESS(m_index, m_count, ());
+}
+
+void PartitionedEliasFano::Iterator::LoadPartition(size_t partition)
+{
+  m_partition = partition;
+  m_index = 0;
+  m_count = IsValid() ? m_ef->DecodePartition(partition, m_values.data()) : 0;
+}
+
+PartitionedEliasFano::PartitionedEliasFano(vector<uint64_t> const & values) : m_size(values.size())
+{
+  ASSERT(is_sorted(values.begin(), values.end()), ());
+
+  size_t const numPartitions = (m_size + kPartitionSize - 1) / kPartitionSize;
+  m_lowerBounds.reserve(numPartitions);
+  m_upperBounds.reserve(numPartitions);
+  m_offsets.reserve(numPartitions);
+  m_numLowBits.reserve(numPartitions);
+
+  uint64_t numBits = 0;
+  for (size_t partition = 0; partition < numPartitions; ++partition)
+  {
+    size_t const begin = partition * kPartitionSize;
+    size_t const count = GetPartitionSize(partition);
+    uint64_t const lowerBound = values[begin];
+    uint64_t const maxValue = values[begin + count - 1] - lowerBound;
+    uint8_t const numLowBits = GetNumLowBits(maxValue, count);
+
+    m_lowerBounds.push_back(lowerBound);
+    m_upperBounds.push_back(values[begin + count - 1]);
+    m_offsets.push_back(numBits);
+    m_numLowBits.push_back(numLowBits);
+
+    // Lower bits, then one set bit per value and one unset bit per
+    // each possible value of upper bits.
+    numBits += count * numLowBits + count + (maxValue >> numLowBits) + 1;
+  }
+
+  m_bits.resize(static_cast<size_t>((numBits + kWordBits - 1) / kWordBits));
+  for (size_t partition = 0; partition < numPartitions; ++partition)
+  {
+    size_t const begin = partition * kPartitionSize;
+    size_t const count = GetPartitionSize(partition);
+    uint8_t const numLowBits = m_numLowBits[partition];
+    uint64_t const lowMask = (uint64_t{1} << numLowBits) - 1;
+    uint64_t const highBegin = m_offsets[partition] + count * numLowBits;
+
+    for (size_t i = 0; i < count; ++i)
+    {
+      uint64_t const value = values[begin + i] - m_lowerBounds[partition];
+      WriteBits(m_bits, m_offsets[partition] + i * numLowBits, value & lowMask, numLowBits);
+      uint64_t const pos = highBegin + (value >> numLowBits) + i;
+      m_bits[static_cast<size_t>(pos / kWordBits)] |= uint64_t{1} << (pos % kWordBits);
+    }
+  }
+}
+
+uint64_t PartitionedEliasFano::Select(size_t i) const
+{
+  ASSERT_LESS(i, m_size, ());
+  array<uint64_t, kPartitionSize> values;
+  DecodePartition(i / kPartitionSize, values.data());
+  return values[i % kPartitionSize];
+}
+
+bool PartitionedEliasFano::Contains(uint64_t value) const
+{
+  auto const it = lower_bound(m_upperBounds.begin(), m_upperBounds.end(), value);
+  if (it == m_upperBounds.end())
+    return false;
+
+  size_t const partition = static_cast<size_t>(distance(m_upperBounds.begin(), it));
+  if (value == *it || value == m_lowerBounds[partition])
+    return true;
+  if (value < m_lowerBounds[partition])
+    return false;
+
+  array<uint64_t, kPartitionSize> values;
+  size_t const count = DecodePartition(partition, values.data());
+  return binary_search(values.begin(), values.begin() + count, value);
+}
+
+size_t PartitionedEliasFano::GetBytesSize() const
+{
+  return (m_lowerBounds.size() + m_upperBounds.size() + m_offsets.size() + m_bits.size()) *
+             sizeof(uint64_t) +
+         m_numLowBits.size();
+}
+
+size_t PartitionedEliasFano::GetPartitionSize(size_t partition) const
+{
+  size_t const begin = partition * kPartitionSize;
+  ASSERT_LESS(begin, m_size, ());
+  return min(kPartitionSize, m_size - begin);
+}
+
+size_t PartitionedEliasFano::DecodePartition(size_t partition, uint64_t * values) const
+{
+  size_t const count = GetPartitionSize(partition);
+  uint8_t const numLowBits = m_numLowBits[partition];
+  uint64_t const lowerBound = m_lowerBounds[partition];
+  uint64_t const offset = m_offsets[partition];
+
+  for (size_t i = 0; i < count; ++i)
+    values[i] = ReadBits(m_bits, offset + i * numLowBits, numLowBits);
+
+  // The i'th set bit of the upper bits is at the position
+  // (value >> numLowBits) + i.
+  uint64_t const highBegin = offset + count * numLowBits;
+  size_t word = static_cast<size_t>(highBegin / kWordBits);
+  uint64_t bits = m_bits[word] & (~uint64_t{0} << (highBegin % kWordBits));
+  size_t i = 0;
+  while (true)
+  {
+    for (; bits != 0 && i < count; ++i, bits &= bits - 1)
+    {
+      uint64_t const pos = word * kWordBits + bits::NumLoZeroBits64(bits) - highBegin;
+      values[i] = lowerBound + (((pos - i) << numLowBits) | values[i]);
+    }
+    if (i == count)
+      break;
+    bits = m_bits[++word];
+  }
+  return count;
+}
+}  // namespace coding
@@ -0,0 +1,125 @@
+#pragma once
+
+#include "base/assert.hpp"
+
+#include "std/array.hpp"
+#include "std/cstdint.hpp"
+#include "std/vector.hpp"
+
+namespace coding
+{
+// Compact representation of a sorted sequence of uint64_t values.
+//
+// Values are split into partitions of kPartitionSize consecutive
+// values and each partition is encoded by Elias-Fano relative to its
+// first value, so a partition with a small range of values takes
+// about 2 + log(range / kPartitionSize) bits per value. The first and
+// the last values of partitions are kept in plain vectors, therefore
+// Iterator::NextGEQ() skips whole partitions by a binary search
+// instead of decoding of them. It makes intersections of sequences
+// of different lengths much faster than a linear merge.
+//
+// For details, see Giuseppe Ottaviano, Rossano Venturini,
+// "Partitioned Elias-Fano Indexes", SIGIR 2014.
+class PartitionedEliasFano
+{
+public:
+  static size_t constexpr kPartitionSize = 128;
+
+  // Forward iterator over the values, iterator decodes a partition
+  // at once when it's entered.
+  class Iterator
+  {
+  public:
+    explicit Iterator(PartitionedEliasFano const & ef);
+
+    bool IsValid() const { return m_partition < m_ef->m_lowerBounds.size(); }
+
+    uint64_t operator*() const
+    {
+      ASSERT(IsValid(), ());
+      return m_values[m_index];
+    }
+
+    // Index of the current value in the whole sequence.
+    size_t GetIndex() const { return m_partition * kPartitionSize + m_index; }
+
+    void Next()
+    {
+      ASSERT(IsValid(), ());
+      if (++m_index == m_count)
+        LoadPartition(m_partition + 1);
+    }
+
+    // Moves the iterator to the first value which is not less than
+    // |value|. The iterator is never moved back.
+    void NextGEQ(uint64_t value);
+
+  private:
+    void LoadPartition(size_t partition);
+
+    PartitionedEliasFano const * m_ef;
+    size_t m_partition = 0;
+    size_t m_index = 0;
+    size_t m_count = 0;
+    array<uint64_t, kPartitionSize> m_values;
+  };
+
+  PartitionedEliasFano() = default;
+
+  // |values| must be sorted.
+  explicit PartitionedEliasFano(vector<uint64_t> const & values);
+
+  size_t Size() const { return m_size; }
+  bool Empty() const { return m_size == 0; }
+
+  // Returns the i'th value.
+  uint64_t Select(size_t i) const;
+
+  uint64_t Front() const
+  {
+    ASSERT(!Empty(), ());
+    return m_lowerBounds.front();
+  }
+
+  uint64_t Back() const
+  {
+    ASSERT(!Empty(), ());
+    return m_upperBounds.back();
+  }
+
+  bool Contains(uint64_t value) const;
+
+  template <typename TFn>
+  void ForEach(TFn && fn) const
+  {
+    array<uint64_t, kPartitionSize> values;
+    for (size_t partition = 0; partition < m_lowerBounds.size(); ++partition)
+    {
+      size_t const count = DecodePartition(partition, values.data());
+      for (size_t i = 0; i < count; ++i)
+        fn(values[i]);
+    }
+  }
+
+  // Returns the number of bytes used by the encoded values.
+  size_t GetBytesSize() const;
+
+private:
+  size_t GetPartitionSize(size_t partition) const;
+  // Writes values of the partition to |values| and returns their number.
+  size_t DecodePartition(size_t partition, uint64_t * values) const;
+
+  size_t m_size = 0;
+
+  // The first and the last values of the partitions.
+  vector<uint64_t> m_lowerBounds;
+  vector<uint64_t> m_upperBounds;
+
+  // Offset of the lower bits of each partition in m_bits, the upper
+  // bits of a partition immediately follow the lower bits.
+  vector<uint64_t> m_offsets;
+  vector<uint8_t> m_numLowBits;
+  vector<uint64_t> m_bits;
+};
+}  // namespace coding
@@ -1,12 +1,17 @@
 #pragma once
 
+#include "coding/shared_page_cache.hpp"
+
 #include "base/base.hpp"
 #include "base/cache.hpp"
 #include "base/stats.hpp"
 
 #include "std/algorithm.hpp"
 #include "std/cstring.hpp"
+#include "std/limits.hpp"
+#include "std/shared_ptr.hpp"
 #include "std/sstream.hpp"
+#include "std/string.hpp"
 #include "std/vector.hpp"
 
 
@@ -105,3 +110,107 @@ private:
   uint32_t const m_LogPageSize;
   impl::ReaderCacheStats<bStats> m_Stats;
 };
+
+/// Cache of pages of a reader which keeps them in SharedPageCache, so they are shared
+/// with other readers of the same file. Sequential reads of pages double the count
+/// of pages which are read in advance up to |kMaxReadAheadPages|, a random read resets it.
+template <class ReaderT>
+class SharedReaderCache
+{
+public:
+  static uint32_t constexpr kMaxReadAheadPages = 32;
+
+  SharedReaderCache(string const & fileName, uint32_t logPageSize)
+    : m_FileName(fileName)
+    , m_LogPageSize(logPageSize)
+    , m_FileId(SharedPageCache::Instance().RegisterFile(fileName, logPageSize))
+  {
+  }
+
+  ~SharedReaderCache() { SharedPageCache::Instance().UnregisterFile(m_FileName, m_LogPageSize); }
+
+  void Read(ReaderT & reader, uint64_t pos, void * p, size_t size)
+  {
+    if (size == 0)
+      return;
+    ASSERT_LESS_OR_EQUAL(pos + size, reader.Size(), (pos, size, reader.Size()));
+    char * pDst = static_cast<char *>(p);
+    uint64_t pageNum = pos >> m_LogPageSize;
+    size_t pageOffset = static_cast<size_t>(pos - (pageNum << m_LogPageSize));
+    while (size > 0)
+    {
+      SharedPageCache::Page const page = ReadPage(reader, pageNum);
+      size_t const copySize = min(size, PageSize() - pageOffset);
+      ASSERT_LESS_OR_EQUAL(pageOffset + copySize, page->size(), ());
+      memcpy(pDst, page->data() + pageOffset, copySize);
+      size -= copySize;
+      pDst += copySize;
+      pageOffset = 0;
+      ++pageNum;
+    }
+  }
+
+  string GetStatsStr() const
+  {
+    ostringstream out;
+    out << "LogPageSize: " << m_LogPageSize << " ReadAheadWindow: " << m_ReadAheadPages << " "
+        << SharedPageCache::Instance().GetStatsStr();
+    return out.str();
+  }
+
+private:
+  inline size_t PageSize() const { return 1 << m_LogPageSize; }
+
+  SharedPageCache::Page ReadPage(ReaderT & reader, uint64_t pageNum)
+  {
+    if (pageNum == m_LastPageNum + 1)
+      m_ReadAheadPages = min(2 * m_ReadAheadPages, kMaxReadAheadPages);
+    else if (pageNum != m_LastPageNum)
+      m_ReadAheadPages = 1;
+    m_LastPageNum = pageNum;
+
+    SharedPageCache & cache = SharedPageCache::Instance();
+    SharedPageCache::Page page = cache.Get(m_FileId, pageNum);
+    if (page)
+      return page;
+
+    // The page and the following ones which aren't cached yet are read by one call.
+    uint64_t const pos = pageNum << m_LogPageSize;
+    uint64_t const pagesCount = (reader.Size() + PageSize() - 1) >> m_LogPageSize;
+    uint32_t count = 1;
+    while (count < m_ReadAheadPages && pageNum + count < pagesCount &&
+           !cache.Contains(m_FileId, pageNum + count))
+    {
+      ++count;
+    }
+
+    size_t const bytes =
+        static_cast<size_t>(min(static_cast<uint64_t>(count) << m_LogPageSize, reader.Size() - pos));
+    m_Buffer.resize(bytes);
+    reader.Read(pos, m_Buffer.data(), bytes);
+
+    for (uint32_t i = 0; i < count; ++i)
+    {
+      auto const begin = m_Buffer.begin() + (static_cast<size_t>(i) << m_LogPageSize);
+      auto const end = m_Buffer.begin() + min(static_cast<size_t>(i + 1) << m_LogPageSize, bytes);
+      auto const current = make_shared<vector<char> const>(begin, end);
+      cache.Put(m_FileId, pageNum + i, current);
+      if (i == 0)
+        page = current;
+    }
+    cache.AddReadAheadPages(count - 1);
+    return page;
+  }
+
+  string const m_FileName;
+  uint32_t const m_LogPageSize;
+  uint32_t const m_FileId;
+
+  uint64_t m_LastPageNum = numeric_limits<uint64_t>::max() - 1;
+  uint32_t m_ReadAheadPages = 1;
+  vector<char> m_Buffer;
+};
+
+// static
+template <class ReaderT>
+uint32_t constexpr SharedReaderCache<ReaderT>::kMaxReadAheadPages;
@@ -0,0 +1,225 @@
+#include "coding/section_hashes.hpp"
+
+#include "coding/endianness.hpp"
+#include "coding/file_container.hpp"
+#include "coding/internal/file_data.hpp"
+#include "coding/read_write_utils.hpp"
+#include "coding/reader.hpp"
+#include "coding/varint.hpp"
+#include "coding/write_to_sink.hpp"
+#include "coding/writer.hpp"
+#include "coding/xxhash.hpp"
+
+#include "base/assert.hpp"
+#include "base/logging.hpp"
+
+#include "defines.hpp"
+
+#include "std/algorithm.hpp"
+#include "std/atomic.hpp"
+#include "std/exception.hpp"
+#include "std/mutex.hpp"
+#include "std/thread.hpp"
+
+namespace coding
+{
+namespace
+{
+struct Chunk
+{
+  uint64_t m_offset;
+  uint64_t m_size;
+};
+
+size_t GetThreadsCount(size_t threadsCount, size_t tasksCount)
+{
+  if (threadsCount == 0)
+    threadsCount = max(thread::hardware_concurrency(), 1U);
+  return max(min(threadsCount, tasksCount), size_t{1});
+}
+
+SectionHashes::THashes ReadHashes(FilesContainerR const & cont)
+{
+  auto reader = cont.GetReader(SECTION_HASHES_FILE_TAG);
+  ReaderSource<FilesContainerR::TReader> src(reader);
+
+  auto const version = static_cast<SectionHashes::Version>(ReadPrimitiveFromSource<uint8_t>(src));
+  if (version != SectionHashes::Version::V0)
+    MYTHROW(Reader::ReadException, ("Unknown version of section hashes:", static_cast<int>(version)));
+
+  SectionHashes::THashes hashes(static_cast<size_t>(ReadVarUint<uint64_t>(src)));
+  for (auto & hash : hashes)
+  {
+    rw::Read(src, hash.first);
+    hash.second = ReadPrimitiveFromSource<uint64_t>(src);
+  }
+  return hashes;
+}
+}  // namespace
+
+// static
+uint64_t constexpr SectionHashes::kChunkSize;
+
+// static
+SectionHashes::THashes SectionHashes::Compute(string const & fileName, size_t threadsCount)
+{
+  vector<string> tags;
+  FilesContainerR(fileName).ForEachTag([&tags](string const & tag) {
+    if (tag != SECTION_HASHES_FILE_TAG)
+      tags.push_back(tag);
+  });
+  sort(tags.begin(), tags.end());
+  return Compute(fileName, tags, threadsCount);
+}
+
+// static
+void SectionHashes::Write(string const & fileName, size_t threadsCount)
+{
+  auto const hashes = Compute(fileName, threadsCount);
+
+  vector<uint8_t> buffer;
+  {
+    MemWriter<vector<uint8_t>> writer(buffer);
+    WriteToSink(writer, static_cast<uint8_t>(Version::Latest));
+    WriteVarUint(writer, static_cast<uint64_t>(hashes.size()));
+    for (auto const & hash : hashes)
+    {
+      rw::Write(writer, hash.first);
+      WriteToSink(writer, hash.second);
+    }
+  }
+
+  FilesContainerW(fileName, FileWriter::OP_WRITE_EXISTING).Write(buffer, SECTION_HASHES_FILE_TAG);
+}
+
+// static
+SectionHashes::Status SectionHashes::Verify(string const & fileName, size_t threadsCount,
+                                            vector<string> & corrupted)
+{
+  corrupted.clear();
+
+  THashes expected;
+  vector<string> tags;
+  {
+    FilesContainerR cont(fileName);
+    if (!cont.IsExist(SECTION_HASHES_FILE_TAG))
+      return Status::NoHashes;
+
+    for (auto const & hash : ReadHashes(cont))
+    {
+      if (cont.IsExist(hash.first))
+      {
+        expected.push_back(hash);
+        tags.push_back(hash.first);
+      }
+      else
+      {
+        corrupted.push_back(hash.first);
+      }
+    }
+  }
+
+  auto const actual = Compute(fileName, tags, threadsCount);
+  ASSERT_EQUAL(actual.size(), expected.size(), ());
+  for (size_t i = 0; i < actual.size(); ++i)
+  {
+    if (actual[i].second != expected[i].second)
+      corrupted.push_back(expected[i].first);
+  }
+
+  if (corrupted.empty())
+    return Status::Ok;
+
+  LOG(LWARNING, ("Corrupted sections of", fileName, ":", corrupted));
+  return Status::Corrupted;
+}
+
+// static
+SectionHashes::THashes SectionHashes::Compute(string const & fileName, vector<string> const & tags,
+                                              size_t threadsCount)
+{
+  // Sections are split into chunks which are hashed independently, an
+  // empty section is one empty chunk.
+  vector<Chunk> chunks;
+  vector<size_t> firstChunks;
+  {
+    FilesContainerR cont(fileName);
+    for (size_t i = 0; i < tags.size(); ++i)
+    {
+      firstChunks.push_back(chunks.size());
+      auto const offsetAndSize = cont.GetAbsoluteOffsetAndSize(tags[i]);
+      uint64_t const end = offsetAndSize.first + offsetAndSize.second;
+      uint64_t offset = offsetAndSize.first;
+      do
+      {
+        uint64_t const size = min(kChunkSize, end - offset);
+        chunks.push_back({offset, size});
+        offset += size;
+      } while (offset < end);
+    }
+    firstChunks.push_back(chunks.size());
+  }
+
+  vector<uint64_t> chunkHashes(chunks.size());
+  atomic<size_t> next(0);
+  exception_ptr error;
+  mutex errorMutex;
+
+  auto const worker = [&]() {
+    try
+    {
+      // Each thread reads by its own descriptor, positioned reads don't
+      // share anything, so threads don't wait for each other.
+      my::FileData file(fileName, my::FileData::OP_READ);
+      vector<uint8_t> buffer;
+      for (size_t i = next++; i < chunks.size(); i = next++)
+      {
+        auto const & chunk = chunks[i];
+        buffer.resize(static_cast<size_t>(chunk.m_size));
+        file.Read(chunk.m_offset, buffer.data(), buffer.size());
+        chunkHashes[i] = SwapIfBigEndian(XXHash64::Hash(buffer.data(), buffer.size()));
+      }
+    }
+    catch (...)
+    {
+      lock_guard<mutex> lock(errorMutex);
+      if (!error)
+        error = current_exception();
+      next = chunks.size();
+    }
+  };
+
+  vector<thread> threads;
+  size_t const count = GetThreadsCount(threadsCount, chunks.size());
+  for (size_t i = 1; i < count; ++i)
+    threads.emplace_back(worker);
+  worker();
+  for (auto & t : threads)
+    t.join();
+
+  if (error)
+    rethrow_exception(error);
+
+  THashes hashes;
+  hashes.reserve(tags.size());
+  for (size_t i = 0; i < tags.size(); ++i)
+  {
+    uint64_t const * first = chunkHashes.data() + firstChunks[i];
+    size_t const size = (firstChunks[i + 1] - firstChunks[i]) * sizeof(uint64_t);
+    hashes.emplace_back(tags[i], XXHash64::Hash(first, size));
+  }
+  return hashes;
+}
+
+string DebugPrint(SectionHashes::Status status)
+{
+  switch (status)
+  {
+  case SectionHashes::Status::Ok: return "Ok";
+  case SectionHashes::Status::NoHashes: return "NoHashes";
+  case SectionHashes::Status::Corrupted: return "Corrupted";
+  }
+  ASSERT(false, ());
+  return {};
+}
+}  // namespace coding
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "std/cstdint.hpp"
+#include "std/string.hpp"
+#include "std/utility.hpp"
+#include "std/vector.hpp"
+
+namespace coding
+{
+// Table of hashes of sections of a files container, it's stored in the
+// container as SECTION_HASHES_FILE_TAG section, so mwms without the
+// table are still readable.
+//
+// A hash of a section is XXHash64 of little-endian XXHash64 values of
+// consecutive kChunkSize blocks of the section, so chunks of one section
+// are hashed in parallel too, and a large file is verified by all cores.
+//
+// Format:
+// uint8_t version
+// varuint count
+// (tag, uint64_t hash) * count, sorted by tag
+class SectionHashes
+{
+public:
+  enum class Version : uint8_t
+  {
+    V0 = 0,
+    Latest = V0
+  };
+
+  enum class Status
+  {
+    Ok,
+    NoHashes,
+    Corrupted
+  };
+
+  using THashes = vector<pair<string, uint64_t>>;
+
+  static uint64_t constexpr kChunkSize = 16 * 1024 * 1024;
+
+  // Hashes all sections of |fileName| except the table itself in
+  // |threadsCount| threads, 0 means the number of cores.
+  static THashes Compute(string const & fileName, size_t threadsCount = 0);
+
+  // Computes hashes of sections of |fileName| and writes them to the file.
+  // It must be the last modification of the file.
+  static void Write(string const & fileName, size_t threadsCount = 0);
+
+  // Verifies sections listed in the table of |fileName|, tags of broken and
+  // missing sections are written to |corrupted|.
+  static Status Verify(string const & fileName, size_t threadsCount,
+                       vector<string> & corrupted);
+  static Status Verify(string const & fileName, size_t threadsCount = 0)
+  {
+    vector<string> corrupted;
+    return Verify(fileName, threadsCount, corrupted);
+  }
+
+private:
+  static THashes Compute(string const & fileName, vector<string> const & tags,
+                         size_t threadsCount);
+};
+
+string DebugPrint(SectionHashes::Status status);
+}  // namespace coding
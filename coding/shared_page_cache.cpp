@@ -0,0 +1,175 @@
+#include "coding/shared_page_cache.hpp"
+
+#include "base/assert.hpp"
+
+#include <algorithm>
+#include <sstream>
+
+using namespace std;
+
+namespace
+{
+string MakeFileKey(string const & fileName, uint32_t logPageSize)
+{
+  return fileName + '\0' + to_string(logPageSize);
+}
+}  // namespace
+
+// static
+SharedPageCache & SharedPageCache::Instance()
+{
+  static SharedPageCache cache;
+  return cache;
+}
+
+SharedPageCache::SharedPageCache(size_t shardsCount)
+  : m_shards(max(shardsCount, size_t(1)))
+  , m_capacity(0)
+  , m_hits(0)
+  , m_misses(0)
+  , m_evictions(0)
+  , m_readAheadPages(0)
+{
+}
+
+void SharedPageCache::SetCapacity(uint64_t bytes)
+{
+  m_capacity = bytes;
+  for (auto & shard : m_shards)
+  {
+    lock_guard<mutex> lock(shard.m_mutex);
+    Shrink(shard);
+  }
+}
+
+uint32_t SharedPageCache::RegisterFile(string const & fileName, uint32_t logPageSize)
+{
+  lock_guard<mutex> lock(m_filesMutex);
+  auto const it = m_files.emplace(MakeFileKey(fileName, logPageSize), FileInfo{m_nextFileId, 0});
+  if (it.second)
+    ++m_nextFileId;
+  ++it.first->second.m_readers;
+  return it.first->second.m_id;
+}
+
+void SharedPageCache::UnregisterFile(string const & fileName, uint32_t logPageSize)
+{
+  lock_guard<mutex> lock(m_filesMutex);
+  auto const it = m_files.find(MakeFileKey(fileName, logPageSize));
+  ASSERT(it != m_files.end(), (fileName));
+  if (it != m_files.end() && --it->second.m_readers == 0)
+    m_files.erase(it);
+}
+
+SharedPageCache::Page SharedPageCache::Get(uint32_t fileId, uint64_t pageNum)
+{
+  uint64_t const key = MakeKey(fileId, pageNum);
+  Shard & shard = GetShard(key);
+  lock_guard<mutex> lock(shard.m_mutex);
+
+  auto const it = shard.m_index.find(key);
+  if (it == shard.m_index.end())
+  {
+    ++m_misses;
+    return nullptr;
+  }
+
+  ++m_hits;
+  shard.m_pages.splice(shard.m_pages.begin(), shard.m_pages, it->second);
+  return it->second->m_page;
+}
+
+bool SharedPageCache::Contains(uint32_t fileId, uint64_t pageNum) const
+{
+  uint64_t const key = MakeKey(fileId, pageNum);
+  Shard const & shard = GetShard(key);
+  lock_guard<mutex> lock(shard.m_mutex);
+  return shard.m_index.count(key) != 0;
+}
+
+void SharedPageCache::Put(uint32_t fileId, uint64_t pageNum, Page const & page)
+{
+  ASSERT(page, ());
+  uint64_t const key = MakeKey(fileId, pageNum);
+  Shard & shard = GetShard(key);
+  lock_guard<mutex> lock(shard.m_mutex);
+
+  auto const it = shard.m_index.find(key);
+  if (it != shard.m_index.end())
+  {
+    shard.m_bytes -= it->second->m_page->size();
+    shard.m_pages.erase(it->second);
+    shard.m_index.erase(it);
+  }
+
+  shard.m_pages.push_front(Entry{key, page});
+  shard.m_index.emplace(key, shard.m_pages.begin());
+  shard.m_bytes += page->size();
+  Shrink(shard);
+}
+
+void SharedPageCache::Clear()
+{
+  for (auto & shard : m_shards)
+  {
+    lock_guard<mutex> lock(shard.m_mutex);
+    shard.m_index.clear();
+    shard.m_pages.clear();
+    shard.m_bytes = 0;
+  }
+}
+
+uint64_t SharedPageCache::GetSize() const
+{
+  uint64_t size = 0;
+  for (auto const & shard : m_shards)
+  {
+    lock_guard<mutex> lock(shard.m_mutex);
+    size += shard.m_bytes;
+  }
+  return size;
+}
+
+string SharedPageCache::GetStatsStr() const
+{
+  uint64_t const hits = m_hits;
+  uint64_t const misses = m_misses;
+
+  ostringstream out;
+  out << "Capacity: " << GetCapacity() << " Size: " << GetSize();
+  out << " Hits: " << hits << " Misses: " << misses;
+  out << " HitRatio: " << (hits + 1.0) / (hits + misses + 1.0);
+  out << " Evictions: " << m_evictions << " ReadAheadPages: " << m_readAheadPages;
+  return out.str();
+}
+
+// static
+uint64_t SharedPageCache::MakeKey(uint32_t fileId, uint64_t pageNum)
+{
+  ASSERT_LESS(pageNum, uint64_t(1) << 32, ());
+  return (static_cast<uint64_t>(fileId) << 32) | pageNum;
+}
+
+SharedPageCache::Shard & SharedPageCache::GetShard(uint64_t key)
+{
+  // Neighbouring pages of a file are spread among all shards.
+  return m_shards[key % m_shards.size()];
+}
+
+SharedPageCache::Shard const & SharedPageCache::GetShard(uint64_t key) const
+{
+  return m_shards[key % m_shards.size()];
+}
+
+void SharedPageCache::Shrink(Shard & shard)
+{
+  uint64_t const capacity = GetCapacity() / m_shards.size();
+  while (shard.m_bytes > capacity && !shard.m_pages.empty())
+  {
+    auto const & entry = shard.m_pages.back();
+    shard.m_bytes -= entry.m_page->size();
+    shard.m_index.erase(entry.m_key);
+    shard.m_pages.pop_back();
+    ++m_evictions;
+  }
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/// Process-wide LRU cache of pages of files. Pages are shared by all readers of a file
+/// which are alive at the same time, so readers which are opened independently for the
+/// same mwm (e.g. on different threads) don't duplicate pages. Pages are distributed
+/// among shards, every shard has its own lock. The cache is disabled while its capacity
+/// is zero. Thread-safe.
+class SharedPageCache
+{
+public:
+  using Page = std::shared_ptr<std::vector<char> const>;
+
+  static SharedPageCache & Instance();
+
+  explicit SharedPageCache(size_t shardsCount = 16);
+
+  /// Evicts pages which don't fit in |bytes|.
+  void SetCapacity(uint64_t bytes);
+  uint64_t GetCapacity() const { return m_capacity; }
+  bool IsEnabled() const { return GetCapacity() != 0; }
+
+  /// \returns id of pages of |fileName| with pages of |1 << logPageSize| bytes. Readers
+  /// of the same file get the same id until all of them unregister it. A new id is
+  /// given after that, since the file may be changed, and old pages are evicted in time.
+  uint32_t RegisterFile(std::string const & fileName, uint32_t logPageSize);
+  void UnregisterFile(std::string const & fileName, uint32_t logPageSize);
+
+  /// \returns nullptr if there is no such page in the cache.
+  Page Get(uint32_t fileId, uint64_t pageNum);
+  bool Contains(uint32_t fileId, uint64_t pageNum) const;
+  void Put(uint32_t fileId, uint64_t pageNum, Page const & page);
+
+  /// Pages which are read by readers in advance.
+  void AddReadAheadPages(uint64_t count) { m_readAheadPages += count; }
+
+  void Clear();
+
+  /// \returns bytes of cached pages.
+  uint64_t GetSize() const;
+
+  std::string GetStatsStr() const;
+
+private:
+  struct Entry
+  {
+    uint64_t m_key;
+    Page m_page;
+  };
+
+  struct Shard
+  {
+    using TList = std::list<Entry>;
+
+    mutable std::mutex m_mutex;
+    // The most recently used pages are at the front.
+    TList m_pages;
+    std::unordered_map<uint64_t, TList::iterator> m_index;
+    uint64_t m_bytes = 0;
+  };
+
+  struct FileInfo
+  {
+    uint32_t m_id;
+    size_t m_readers;
+  };
+
+  static uint64_t MakeKey(uint32_t fileId, uint64_t pageNum);
+
+  Shard & GetShard(uint64_t key);
+  Shard const & GetShard(uint64_t key) const;
+
+  // Evicts the least recently used pages of |shard| which don't fit in its capacity.
+  void Shrink(Shard & shard);
+
+  std::vector<Shard> m_shards;
+  std::atomic<uint64_t> m_capacity;
+
+  std::mutex m_filesMutex;
+  std::unordered_map<std::string, FileInfo> m_files;
+  uint32_t m_nextFileId = 0;
+
+  std::atomic<uint64_t> m_hits;
+  std::atomic<uint64_t> m_misses;
+  std::atomic<uint64_t> m_evictions;
+  std::atomic<uint64_t> m_readAheadPages;
+};
@@ -9,8 +9,12 @@
 
 #include <algorithm>
 #include <cstdint>
+#include <list>
+#include <numeric>
 #include <sstream>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 namespace coding
 {
@@ -134,6 +138,8 @@ public:
     // Returns the index of the first string from the next block.
     uint64_t To() const { return m_from + m_subs; }
 
+    bool Contains(uint64_t stringIx) const { return stringIx >= From() && stringIx < To(); }
+
     uint64_t m_offset = 0;  // offset of the block from the beginning of the section
     uint64_t m_from = 0;    // index of the first string in the block
     uint64_t m_subs = 0;    // number of strings in the block
@@ -205,9 +211,19 @@ private:
   std::vector<BlockInfo> m_blocks;
 };
 
+// Reads strings from the blocked text storage. Decompressed blocks are
+// cached, at most |maxCachedBlocks| most recently used blocks are kept.
 class BlockedTextStorageReader
 {
 public:
+  static size_t constexpr kDefaultMaxCachedBlocks = 16;
+
+  explicit BlockedTextStorageReader(size_t maxCachedBlocks = kDefaultMaxCachedBlocks)
+    : m_maxCachedBlocks(maxCachedBlocks)
+  {
+    CHECK_GREATER(m_maxCachedBlocks, 0, ());
+  }
+
   template <typename Reader>
   void InitializeIfNeeded(Reader & reader)
   {
@@ -230,49 +246,47 @@ public:
 
     auto const blockIx = m_index.GetBlockIx(stringIx);
     CHECK_LESS(blockIx, m_index.GetNumBlockInfos(), ());
+    return ExtractString(GetBlock(reader, blockIx), m_index.GetBlockInfo(blockIx), stringIx);
+  }
 
-    if (blockIx >= m_cache.size())
-      m_cache.resize(blockIx + 1);
-    ASSERT_LESS(blockIx, m_cache.size(), ());
+  // Returns the strings in the order of |stringIxs|. Strings are extracted
+  // in the order of blocks, so every block is decompressed at most once
+  // regardless of the size of the cache.
+  template <typename Reader>
+  std::vector<std::string> ExtractStrings(Reader & reader, std::vector<size_t> const & stringIxs)
+  {
+    InitializeIfNeeded(reader);
 
-    auto const & bi = m_index.GetBlockInfo(blockIx);
+    std::vector<size_t> order(stringIxs.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(),
+              [&stringIxs](size_t lhs, size_t rhs) { return stringIxs[lhs] < stringIxs[rhs]; });
 
-    auto & entry = m_cache[blockIx];
-    if (!entry.m_valid)
+    std::vector<std::string> result(stringIxs.size());
+    size_t blockIx = m_index.GetNumBlockInfos();
+    CacheEntry const * entry = nullptr;
+    for (auto const i : order)
     {
-      NonOwningReaderSource source(reader);
-      source.Skip(bi.m_offset);
-
-      entry.m_value.clear();
-      entry.m_subs.resize(bi.m_subs);
-
-      uint64_t offset = 0;
-      for (size_t i = 0; i < entry.m_subs.size(); ++i)
+      auto const stringIx = stringIxs[i];
+      if (blockIx == m_index.GetNumBlockInfos() ||
+          !m_index.GetBlockInfo(blockIx).Contains(stringIx))
       {
-        auto & sub = entry.m_subs[i];
-        sub.m_offset = offset;
-        sub.m_length = ReadVarUint<uint64_t>(source);
-        CHECK_GREATER_OR_EQUAL(sub.m_offset + sub.m_length, sub.m_offset, ());
-        offset += sub.m_length;
+        blockIx = m_index.GetBlockIx(stringIx);
+        CHECK_LESS(blockIx, m_index.GetNumBlockInfos(), ());
+        entry = &GetBlock(reader, blockIx);
       }
-      BWTCoder::ReadAndDecodeBlock(source, std::back_inserter(entry.m_value));
-      entry.m_valid = true;
+      result[i] = ExtractString(*entry, m_index.GetBlockInfo(blockIx), stringIx);
     }
-    ASSERT(entry.m_valid, ());
-
-    ASSERT_GREATER_OR_EQUAL(stringIx, bi.From(), ());
-    ASSERT_LESS(stringIx, bi.To(), ());
-
-    stringIx -= bi.From();
-    ASSERT_LESS(stringIx, entry.m_subs.size(), ());
+    return result;
+  }
 
-    auto const & si = entry.m_subs[stringIx];
-    auto const & value = entry.m_value;
-    ASSERT_LESS_OR_EQUAL(si.m_offset + si.m_length, value.size(), ());
-    return value.substr(si.m_offset, si.m_length);
+  void ClearCache()
+  {
+    m_cache.clear();
+    m_lru.clear();
   }
 
-  void ClearCache() { m_cache.clear(); }
+  size_t GetNumCachedBlocks() const { return m_cache.size(); }
 
 private:
   struct StringInfo
@@ -288,11 +302,69 @@ private:
   {
     std::string m_value;             // concatenation of the strings
     std::vector<StringInfo> m_subs;  // indices of individual strings
-    bool m_valid = false;
+    std::list<size_t>::iterator m_lruIt;
   };
 
+  // Returns the decompressed block. The reference is valid until
+  // the next call.
+  template <typename Reader>
+  CacheEntry const & GetBlock(Reader & reader, size_t blockIx)
+  {
+    auto it = m_cache.find(blockIx);
+    if (it != m_cache.end())
+    {
+      m_lru.splice(m_lru.begin(), m_lru, it->second.m_lruIt);
+      return it->second;
+    }
+
+    auto const & bi = m_index.GetBlockInfo(blockIx);
+    NonOwningReaderSource source(reader);
+    source.Skip(bi.m_offset);
+
+    CacheEntry entry;
+    entry.m_subs.resize(bi.m_subs);
+
+    uint64_t offset = 0;
+    for (size_t i = 0; i < entry.m_subs.size(); ++i)
+    {
+      auto & sub = entry.m_subs[i];
+      sub.m_offset = offset;
+      sub.m_length = ReadVarUint<uint64_t>(source);
+      CHECK_GREATER_OR_EQUAL(sub.m_offset + sub.m_length, sub.m_offset, ());
+      offset += sub.m_length;
+    }
+    BWTCoder::ReadAndDecodeBlock(source, std::back_inserter(entry.m_value));
+
+    if (m_cache.size() >= m_maxCachedBlocks)
+    {
+      m_cache.erase(m_lru.back());
+      m_lru.pop_back();
+    }
+    m_lru.push_front(blockIx);
+    entry.m_lruIt = m_lru.begin();
+    return m_cache.emplace(blockIx, std::move(entry)).first->second;
+  }
+
+  static std::string ExtractString(CacheEntry const & entry,
+                                   BlockedTextStorageIndex::BlockInfo const & bi, size_t stringIx)
+  {
+    ASSERT_GREATER_OR_EQUAL(stringIx, bi.From(), ());
+    ASSERT_LESS(stringIx, bi.To(), ());
+
+    stringIx -= bi.From();
+    ASSERT_LESS(stringIx, entry.m_subs.size(), ());
+
+    auto const & si = entry.m_subs[stringIx];
+    auto const & value = entry.m_value;
+    ASSERT_LESS_OR_EQUAL(si.m_offset + si.m_length, value.size(), ());
+    return value.substr(si.m_offset, si.m_length);
+  }
+
   BlockedTextStorageIndex m_index;
-  std::vector<CacheEntry> m_cache;
+  std::unordered_map<size_t, CacheEntry> m_cache;
+  // Indices of the cached blocks, the most recently used first.
+  std::list<size_t> m_lru;
+  size_t const m_maxCachedBlocks;
   bool m_initialized = false;
 };
 
@@ -300,14 +372,22 @@ template <typename Reader>
 class BlockedTextStorage
 {
 public:
-  explicit BlockedTextStorage(Reader & reader) : m_reader(reader)
+  explicit BlockedTextStorage(
+      Reader & reader,
+      size_t maxCachedBlocks = BlockedTextStorageReader::kDefaultMaxCachedBlocks)
+    : m_storage(maxCachedBlocks), m_reader(reader)
   {
     m_storage.InitializeIfNeeded(m_reader);
   }
 
   size_t GetNumStrings() const { return m_storage.GetNumStrings(); }
   std::string ExtractString(size_t stringIx) { return m_storage.ExtractString(m_reader, stringIx); }
+  std::vector<std::string> ExtractStrings(std::vector<size_t> const & stringIxs)
+  {
+    return m_storage.ExtractStrings(m_reader, stringIxs);
+  }
   void ClearCache() { m_storage.ClearCache(); }
+  size_t GetNumCachedBlocks() const { return m_storage.GetNumCachedBlocks(); }
 
 private:
   BlockedTextStorageReader m_storage;
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "coding/endianness.hpp"
 #include "coding/write_to_sink.hpp"
 
 #include "base/assert.hpp"
@@ -8,6 +9,7 @@
 #include "base/exception.hpp"
 #include "base/stl_add.hpp"
 
+#include "std/cstring.hpp"
 #include "std/string.hpp"
 #include "std/type_traits.hpp"
 
@@ -274,3 +276,74 @@ void const * ReadVarUint64Array(void const * pBeg, size_t count, F f)
   return impl::ReadVarInt64Array(pBeg, impl::ReadVarInt64ArrayGivenSize(count), f, IdFunctor());
 }
 
+namespace impl
+{
+
+uint64_t constexpr kVarUintStopBits = 0x8080808080808080ULL;
+
+/// Merges 7-bit groups of up to 8 bytes of a varuint, |x| must contain bytes of one varuint only.
+inline uint64_t CompactVarUintBytes(uint64_t x)
+{
+  return (x & 0x7FULL) | ((x >> 1) & 0x3F80ULL) | ((x >> 2) & 0x1FC000ULL) |
+         ((x >> 3) & 0xFE00000ULL) | ((x >> 4) & 0x7F0000000ULL) |
+         ((x >> 5) & 0x3F800000000ULL) | ((x >> 6) & 0x1FC0000000000ULL) |
+         ((x >> 7) & 0xFE000000000000ULL);
+}
+
+inline uint64_t LoadVarUintWord(uint8_t const * p)
+{
+  uint64_t word;
+  memcpy(&word, p, sizeof(word));
+  return SwapIfBigEndian(word);
+}
+
+}
+
+/// Reads all varuints from [pBeg, pEnd) to |values| like ReadVarUint64Array(), but 8 bytes are
+/// decoded at once: stop bytes of varuints are found by the mask of high bits of a word and
+/// every varuint of the word is merged without branches on its bytes.
+/// The tail of the buffer and varuints longer than 8 bytes are decoded byte by byte.
+template <class TCont>
+void const * ReadVarUint64Buffer(void const * pBeg, void const * pEnd, TCont & values)
+{
+  uint8_t const * p = static_cast<uint8_t const *>(pBeg);
+  uint8_t const * const end = static_cast<uint8_t const *>(pEnd);
+
+  while (end - p >= static_cast<ptrdiff_t>(sizeof(uint64_t)))
+  {
+    uint64_t const word = impl::LoadVarUintWord(p);
+    uint64_t stops = ~word & impl::kVarUintStopBits;
+
+    if (stops == impl::kVarUintStopBits)
+    {
+      // Eight single byte varuints, the most frequent case for geometry deltas.
+      for (size_t i = 0; i < sizeof(word); ++i)
+        values.push_back((word >> (i << 3)) & 0x7F);
+      p += sizeof(word);
+      continue;
+    }
+
+    if (stops == 0)
+    {
+      // A varuint which is longer than 8 bytes, it's at most 10 bytes long.
+      if (end - p < 10)
+        break;
+      p = static_cast<uint8_t const *>(ReadVarUint64Array(p, size_t(1), MakeBackInsertFunctor(values)));
+      continue;
+    }
+
+    uint32_t consumed = 0;
+    while (stops != 0)
+    {
+      uint32_t const next = (bits::NumLoZeroBits64(stops) >> 3) + 1;
+      uint32_t const bytes = next - consumed;
+      uint64_t const mask = bytes == sizeof(word) ? ~0ULL : (1ULL << (bytes << 3)) - 1;
+      values.push_back(impl::CompactVarUintBytes((word >> (consumed << 3)) & mask));
+      consumed = next;
+      stops &= stops - 1;
+    }
+    p += consumed;
+  }
+
+  return ReadVarUint64Array(p, end, MakeBackInsertFunctor(values));
+}
@@ -0,0 +1,134 @@
+#include "coding/xxhash.hpp"
+
+#include "coding/endianness.hpp"
+
+#include "base/assert.hpp"
+
+#include "std/algorithm.hpp"
+
+namespace coding
+{
+namespace
+{
+uint64_t constexpr kPrime1 = 11400714785074694791ULL;
+uint64_t constexpr kPrime2 = 14029467366897019727ULL;
+uint64_t constexpr kPrime3 = 1609587929392839161ULL;
+uint64_t constexpr kPrime4 = 9650029242287828579ULL;
+uint64_t constexpr kPrime5 = 2870177450012600261ULL;
+
+uint64_t RotateLeft(uint64_t v, uint8_t n) { return (v << n) | (v >> (64 - n)); }
+
+uint64_t Read64(uint8_t const * p)
+{
+  uint64_t v;
+  memcpy(&v, p, sizeof(v));
+  return SwapIfBigEndian(v);
+}
+
+uint32_t Read32(uint8_t const * p)
+{
+  uint32_t v;
+  memcpy(&v, p, sizeof(v));
+  return SwapIfBigEndian(v);
+}
+
+uint64_t Round(uint64_t acc, uint64_t input)
+{
+  acc += input * kPrime2;
+  acc = RotateLeft(acc, 31);
+  return acc * kPrime1;
+}
+
+uint64_t MergeRound(uint64_t acc, uint64_t value)
+{
+  acc ^= Round(0, value);
+  return acc * kPrime1 + kPrime4;
+}
+
+void ProcessStripe(uint64_t (&acc)[4], uint8_t const * p)
+{
+  for (size_t i = 0; i < 4; ++i)
+    acc[i] = Round(acc[i], Read64(p + i * sizeof(uint64_t)));
+}
+}  // namespace
+
+// static
+size_t constexpr XXHash64::kStripeSize;
+
+XXHash64::XXHash64(uint64_t seed) : m_seed(seed)
+{
+  m_acc[0] = seed + kPrime1 + kPrime2;
+  m_acc[1] = seed + kPrime2;
+  m_acc[2] = seed;
+  m_acc[3] = seed - kPrime1;
+}
+
+void XXHash64::Update(void const * data, size_t size)
+{
+  uint8_t const * p = static_cast<uint8_t const *>(data);
+  uint8_t const * const end = p + size;
+  m_totalSize += size;
+
+  if (m_bufferSize != 0)
+  {
+    size_t const toCopy = min(kStripeSize - m_bufferSize, size);
+    memcpy(m_buffer + m_bufferSize, p, toCopy);
+    m_bufferSize += toCopy;
+    p += toCopy;
+    if (m_bufferSize < kStripeSize)
+      return;
+    ProcessStripe(m_acc, m_buffer);
+    m_bufferSize = 0;
+  }
+
+  for (; end - p >= static_cast<ptrdiff_t>(kStripeSize); p += kStripeSize)
+    ProcessStripe(m_acc, p);
+
+  m_bufferSize = static_cast<size_t>(end - p);
+  memcpy(m_buffer, p, m_bufferSize);
+}
+
+uint64_t XXHash64::Digest() const
+{
+  uint64_t h;
+  if (m_totalSize >= kStripeSize)
+  {
+    h = RotateLeft(m_acc[0], 1) + RotateLeft(m_acc[1], 7) + RotateLeft(m_acc[2], 12) +
+        RotateLeft(m_acc[3], 18);
+    for (size_t i = 0; i < 4; ++i)
+      h = MergeRound(h, m_acc[i]);
+  }
+  else
+  {
+    h = m_seed + kPrime5;
+  }
+
+  h += m_totalSize;
+
+  uint8_t const * p = m_buffer;
+  uint8_t const * const end = m_buffer + m_bufferSize;
+  for (; end - p >= 8; p += 8)
+  {
+    h ^= Round(0, Read64(p));
+    h = RotateLeft(h, 27) * kPrime1 + kPrime4;
+  }
+  if (end - p >= 4)
+  {
+    h ^= static_cast<uint64_t>(Read32(p)) * kPrime1;
+    h = RotateLeft(h, 23) * kPrime2 + kPrime3;
+    p += 4;
+  }
+  for (; p != end; ++p)
+  {
+    h ^= *p * kPrime5;
+    h = RotateLeft(h, 11) * kPrime1;
+  }
+
+  h ^= h >> 33;
+  h *= kPrime2;
+  h ^= h >> 29;
+  h *= kPrime3;
+  h ^= h >> 32;
+  return h;
+}
+}  // namespace coding
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "std/cstdint.hpp"
+#include "std/cstring.hpp"
+
+namespace coding
+{
+// Streaming XXH64, a fast non-cryptographic 64-bit hash by Yann Collet.
+// Values are the same as ones of the reference implementation, see
+// https://github.com/Cyan4973/xxHash/blob/dev/doc/xxhash_spec.md.
+class XXHash64
+{
+public:
+  explicit XXHash64(uint64_t seed = 0);
+
+  void Update(void const * data, size_t size);
+  uint64_t Digest() const;
+
+  static uint64_t Hash(void const * data, size_t size, uint64_t seed = 0)
+  {
+    XXHash64 hash(seed);
+    hash.Update(data, size);
+    return hash.Digest();
+  }
+
+private:
+  static size_t constexpr kStripeSize = 32;
+
+  uint64_t m_acc[4];
+  uint64_t m_seed;
+  uint64_t m_totalSize = 0;
+  uint8_t m_buffer[kStripeSize];
+  size_t m_bufferSize = 0;
+};
+}  // namespace coding
@@ -38,6 +38,18 @@ private:
   string const m_path;
   bool m_completed;
 };
+
+class UnzipWriterDelegate : public ZipFileReader::Delegate
+{
+public:
+  explicit UnzipWriterDelegate(Writer & writer) : m_writer(writer) {}
+
+  // ZipFileReader::Delegate overrides:
+  void OnBlockUnzipped(size_t size, char const * data) override { m_writer.Write(data, size); }
+
+private:
+  Writer & m_writer;
+};
 }  // namespace
 
 ZipFileReader::ZipFileReader(string const & container, string const & file,
@@ -147,3 +159,11 @@ void ZipFileReader::UnzipFile(string const & zipContainer, string const & fileIn
   UnzipFileDelegate delegate(outPath);
   UnzipFile(zipContainer, fileInZip, delegate);
 }
+
+// static
+void ZipFileReader::UnzipFile(string const & zipContainer, string const & fileInZip,
+                              Writer & writer)
+{
+  UnzipWriterDelegate delegate(writer);
+  UnzipFile(zipContainer, fileInZip, delegate);
+}
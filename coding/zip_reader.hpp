@@ -45,6 +45,8 @@ public:
   static void UnzipFile(string const & zipContainer, string const & fileInZip, Delegate & delegate);
   static void UnzipFile(string const & zipContainer, string const & fileInZip,
                         string const & outPath);
+  /// Writes the unzipped file to |writer| by blocks, so the whole file is never kept in memory.
+  static void UnzipFile(string const & zipContainer, string const & fileInZip, Writer & writer);
 
   static void FilesList(string const & zipContainer, FileListT & filesList);
 
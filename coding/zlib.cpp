@@ -1,5 +1,6 @@
 #include "coding/zlib.hpp"
 
+#include "std/limits.hpp"
 #include "std/target_os.hpp"
 
 namespace coding
@@ -20,6 +21,42 @@ int ToInt(ZLib::Deflate::Level level)
   case Level::DefaultCompression: return Z_DEFAULT_COMPRESSION;
   }
 }
+
+int ToWindowBits(ZLib::Deflate::Format format)
+{
+  using Format = ZLib::Deflate::Format;
+  switch (format)
+  {
+  case Format::ZLib: return MAX_WBITS;
+  case Format::GZip: return MAX_WBITS | kGzipBits;
+  }
+}
+
+int ToWindowBits(ZLib::Inflate::Format format)
+{
+  using Format = ZLib::Inflate::Format;
+  switch (format)
+  {
+  case Format::ZLib: return MAX_WBITS;
+  case Format::GZip: return MAX_WBITS | kGzipBits;
+  case Format::Both: return MAX_WBITS | kBothBits;
+  }
+}
+
+void InitStream(z_stream & stream)
+{
+  stream.next_in = Z_NULL;
+  stream.avail_in = 0;
+  stream.zalloc = Z_NULL;
+  stream.zfree = Z_NULL;
+  stream.opaque = Z_NULL;
+}
+
+// zlib takes sizes as unsigned int.
+unsigned int ToChunkSize(uint64_t size)
+{
+  return static_cast<unsigned int>(min(size, static_cast<uint64_t>(numeric_limits<unsigned int>::max())));
+}
 }  // namespace
 
 // ZLib::Processor ---------------------------------------------------------------------------------
@@ -58,16 +95,9 @@ ZLib::DeflateProcessor::DeflateProcessor(Deflate::Format format, Deflate::Level
                                          void const * data, size_t size) noexcept
   : Processor(data, size)
 {
-  auto bits = MAX_WBITS;
-  switch (format)
-  {
-  case Deflate::Format::ZLib: break;
-  case Deflate::Format::GZip: bits = bits | kGzipBits; break;
-  }
-
-  int const ret =
-      deflateInit2(&m_stream, ToInt(level) /* level */, Z_DEFLATED /* method */,
-                   bits /* windowBits */, 8 /* memLevel */, Z_DEFAULT_STRATEGY /* strategy */);
+  int const ret = deflateInit2(&m_stream, ToInt(level) /* level */, Z_DEFLATED /* method */,
+                               ToWindowBits(format) /* windowBits */, 8 /* memLevel */,
+                               Z_DEFAULT_STRATEGY /* strategy */);
   m_init = (ret == Z_OK);
 }
 
@@ -88,14 +118,7 @@ ZLib::InflateProcessor::InflateProcessor(Inflate::Format format, void const * da
                                          size_t size) noexcept
   : Processor(data, size)
 {
-  auto bits = MAX_WBITS;
-  switch (format)
-  {
-  case Inflate::Format::ZLib: break;
-  case Inflate::Format::GZip: bits = bits | kGzipBits; break;
-  case Inflate::Format::Both: bits = bits | kBothBits; break;
-  }
-  int const ret = inflateInit2(&m_stream, bits);
+  int const ret = inflateInit2(&m_stream, ToWindowBits(format));
   m_init = (ret == Z_OK);
 }
 
@@ -110,4 +133,136 @@ int ZLib::InflateProcessor::Process(int flush)
   ASSERT(IsInit(), ());
   return inflate(&m_stream, flush);
 }
+
+// ZLib::InflateSource -----------------------------------------------------------------------------
+// static
+size_t constexpr ZLib::InflateSource::kBufferSize;
+
+ZLib::InflateSource::InflateSource(Reader const & reader, Inflate::Format format)
+  : m_reader(reader), m_buffer(kBufferSize)
+{
+  InitStream(m_stream);
+  int const ret = inflateInit2(&m_stream, ToWindowBits(format));
+  if (ret != Z_OK)
+    MYTHROW(Reader::OpenException, ("Can't initialize inflating:", ret));
+}
+
+ZLib::InflateSource::~InflateSource() { inflateEnd(&m_stream); }
+
+void ZLib::InflateSource::Read(void * p, size_t size)
+{
+  m_stream.next_out = static_cast<unsigned char *>(p);
+  uint64_t rest = size;
+  while (rest != 0)
+  {
+    m_stream.avail_out = ToChunkSize(rest);
+    rest -= m_stream.avail_out;
+    while (m_stream.avail_out != 0)
+    {
+      if (m_finished)
+        MYTHROW(Reader::ReadException, ("Inflated data is too short:", m_pos, size));
+
+      if (m_stream.avail_in == 0)
+        FillInput();
+
+      int const ret = inflate(&m_stream, Z_NO_FLUSH);
+      if (ret == Z_STREAM_END)
+        m_finished = true;
+      else if (ret != Z_OK)
+        MYTHROW(Reader::ReadException, ("Can't inflate data:", ret, m_pos));
+    }
+  }
+  m_pos += size;
+}
+
+void ZLib::InflateSource::Skip(uint64_t size)
+{
+  unsigned char buffer[1024];
+  while (size != 0)
+  {
+    auto const chunk = static_cast<size_t>(min(size, static_cast<uint64_t>(ARRAY_SIZE(buffer))));
+    Read(buffer, chunk);
+    size -= chunk;
+  }
+}
+
+void ZLib::InflateSource::FillInput()
+{
+  ASSERT_LESS_OR_EQUAL(m_readerPos, m_reader.Size(), ());
+  auto const size = static_cast<size_t>(
+      min(m_reader.Size() - m_readerPos, static_cast<uint64_t>(m_buffer.size())));
+  m_reader.Read(m_readerPos, m_buffer.data(), size);
+  m_readerPos += size;
+
+  m_stream.next_in = m_buffer.data();
+  m_stream.avail_in = static_cast<unsigned int>(size);
+}
+
+// ZLib::DeflateWriter -----------------------------------------------------------------------------
+// static
+size_t constexpr ZLib::DeflateWriter::kBufferSize;
+
+ZLib::DeflateWriter::DeflateWriter(Writer & writer, Deflate::Format format, Deflate::Level level)
+  : m_writer(writer), m_buffer(kBufferSize)
+{
+  InitStream(m_stream);
+  int const ret = deflateInit2(&m_stream, ToInt(level) /* level */, Z_DEFLATED /* method */,
+                               ToWindowBits(format) /* windowBits */, 8 /* memLevel */,
+                               Z_DEFAULT_STRATEGY /* strategy */);
+  if (ret != Z_OK)
+    MYTHROW(Writer::OpenException, ("Can't initialize deflating:", ret));
+}
+
+ZLib::DeflateWriter::~DeflateWriter()
+{
+  if (!m_finished)
+    Finish();
+  deflateEnd(&m_stream);
+}
+
+void ZLib::DeflateWriter::Seek(uint64_t pos)
+{
+  if (pos != m_pos)
+    MYTHROW(Writer::SeekException, ("Deflated data can't be rewritten:", pos, m_pos));
+}
+
+void ZLib::DeflateWriter::Write(void const * p, size_t size)
+{
+  ASSERT(!m_finished, ());
+  // See the comment about next_in in the constructor of Processor.
+  m_stream.next_in = static_cast<unsigned char *>(const_cast<void *>(p));
+  uint64_t rest = size;
+  while (rest != 0)
+  {
+    m_stream.avail_in = ToChunkSize(rest);
+    rest -= m_stream.avail_in;
+    Process(Z_NO_FLUSH);
+  }
+  m_pos += size;
+}
+
+void ZLib::DeflateWriter::Finish()
+{
+  ASSERT(!m_finished, ());
+  m_finished = true;
+  Process(Z_FINISH);
+}
+
+void ZLib::DeflateWriter::Process(int flush)
+{
+  // With Z_NO_FLUSH all the input is consumed when some output space is
+  // left. With Z_FINISH deflate is called until the end of the stream.
+  while (true)
+  {
+    m_stream.next_out = m_buffer.data();
+    m_stream.avail_out = static_cast<unsigned int>(m_buffer.size());
+    int const ret = deflate(&m_stream, flush);
+    if (ret == Z_STREAM_ERROR)
+      MYTHROW(Writer::WriteException, ("Can't deflate data:", m_pos));
+
+    m_writer.Write(m_buffer.data(), m_buffer.size() - m_stream.avail_out);
+    if (flush == Z_FINISH ? ret == Z_STREAM_END : m_stream.avail_out != 0)
+      break;
+  }
+}
 }  // namespace coding
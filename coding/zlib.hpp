@@ -1,10 +1,14 @@
 #pragma once
 
+#include "coding/reader.hpp"
+#include "coding/writer.hpp"
+
 #include "base/assert.hpp"
 #include "base/macros.hpp"
 
 #include "std/algorithm.hpp"
 #include "std/string.hpp"
+#include "std/vector.hpp"
 
 #include "zlib.h"
 
@@ -89,6 +93,76 @@ public:
     Level const m_level;
   };
 
+  // Inflates the data of |reader| on the fly, so only a bounded buffer of
+  // the compressed data is kept in memory. Has the interface of a source,
+  // i.e. may be used with ReadPrimitiveFromSource, ReadVarUint, BitReader
+  // etc. instead of ReaderSource over the inflated data.
+  //
+  // Throws Reader::OpenException when zlib can't be initialized and
+  // Reader::ReadException when the data is corrupted or is shorter than
+  // requested.
+  class InflateSource
+  {
+  public:
+    static size_t constexpr kBufferSize = 16 * 1024;
+
+    InflateSource(Reader const & reader, Inflate::Format format);
+    ~InflateSource();
+
+    void Read(void * p, size_t size);
+    void Skip(uint64_t size);
+
+    // Returns the number of inflated bytes read so far.
+    uint64_t Pos() const { return m_pos; }
+
+  private:
+    void FillInput();
+
+    Reader const & m_reader;
+    uint64_t m_readerPos = 0;
+    uint64_t m_pos = 0;
+    bool m_finished = false;
+
+    z_stream m_stream;
+    vector<unsigned char> m_buffer;
+
+    DISALLOW_COPY_AND_MOVE(InflateSource);
+  };
+
+  // Deflates the written data on the fly to |writer| by chunks of at most
+  // kBufferSize bytes. Seek is supported to the current position only.
+  // The rest of the data is flushed by Finish or by the destructor.
+  //
+  // Throws Writer::OpenException when zlib can't be initialized.
+  class DeflateWriter : public Writer
+  {
+  public:
+    static size_t constexpr kBufferSize = 16 * 1024;
+
+    DeflateWriter(Writer & writer, Deflate::Format format, Deflate::Level level);
+    ~DeflateWriter() override;
+
+    // Writer overrides:
+    void Seek(uint64_t pos) override;
+    uint64_t Pos() const override { return m_pos; }
+    void Write(void const * p, size_t size) override;
+
+    // Nothing may be written after it.
+    void Finish();
+
+  private:
+    void Process(int flush);
+
+    Writer & m_writer;
+    uint64_t m_pos = 0;
+    bool m_finished = false;
+
+    z_stream m_stream;
+    vector<unsigned char> m_buffer;
+
+    DISALLOW_COPY_AND_MOVE(DeflateWriter);
+  };
+
 private:
   class Processor
   {
@@ -9,6 +9,9 @@
 #define EXTENSION_TMP ".tmp"
 #define ADDR_FILE_EXTENSION ".addr"
 #define RAW_GEOM_FILE_EXTENSION ".rawgeom"
+#define FEATURES_SORT_FILE_EXTENSION ".sort.tmp"
+#define STAGES_REPORT_FILE_EXTENSION ".stages.json"
+#define TRANSIT_FILE_EXTENSION ".transit.json"
 
 #define NODES_FILE "nodes.dat"
 #define WAYS_FILE "ways.dat"
@@ -18,7 +21,12 @@
 #define ID2REL_EXT ".id2rel"
 
 #define CENTERS_FILE_TAG "centers"
+#define LOCALITIES_GRID_FILE_TAG "locgrid"
+#define HOTELS_FILE_TAG "hotels"
+#define HOUSE_NUMBERS_FILE_TAG "hnidx"
+#define TYPES_INDEX_FILE_TAG "typesidx"
 #define DATA_FILE_TAG "dat"
+#define COMPRESSED_DATA_FILE_TAG "cdat"
 #define GEOMETRY_FILE_TAG "geom"
 #define TRIANGLE_FILE_TAG "trg"
 #define INDEX_FILE_TAG "idx"
@@ -30,9 +38,15 @@
 #define METADATA_INDEX_FILE_TAG "metaidx"
 #define ALTITUDES_FILE_TAG "altitudes"
 #define ROAD_ACCESS_FILE_TAG "roadaccess"
+#define ROAD_SPEEDS_FILE_TAG "roadspeeds"
+#define ROAD_GRID_FILE_TAG "roadgrid"
+#define SPEED_CAMERAS_FILE_TAG "speedcams"
+#define SPEED_PROFILES_FILE_TAG "speedprofiles"
 #define RESTRICTIONS_FILE_TAG "restrictions"
 #define ROUTING_FILE_TAG "routing"
 #define CROSS_MWM_FILE_TAG "cross_mwm"
+#define SHORTCUTS_FILE_TAG "shortcuts"
+#define LANDMARKS_FILE_TAG "landmarks"
 #define FEATURE_OFFSETS_FILE_TAG "offs"
 #define RANKS_FILE_TAG "ranks"
 #define REGION_INFO_FILE_TAG "rgninfo"
@@ -41,6 +55,7 @@
 #define SEARCH_TOKENS_FILE_TAG "addrtags"
 #define TRAFFIC_KEYS_FILE_TAG "traffic"
 #define TRANSIT_FILE_TAG "transit"
+#define SECTION_HASHES_FILE_TAG "sectionhashes"
 
 #define ROUTING_MATRIX_FILE_TAG "mercedes"
 #define ROUTING_EDGEDATA_FILE_TAG "daewoo"
@@ -55,6 +70,7 @@
 #define RESUME_FILE_EXTENSION ".resume"
 #define DOWNLOADING_FILE_EXTENSION ".downloading"
 #define BOOKMARKS_FILE_EXTENSION ".kml"
+#define BOOKMARKS_CACHE_FILE_EXTENSION ".cache"
 #define ROUTING_FILE_EXTENSION ".routing"
 #define NOROUTING_FILE_EXTENSION ".norouting"
 
@@ -65,6 +81,7 @@
 #define COUNTRIES_FILE "countries.txt"
 #define COUNTRIES_META_FILE "countries_meta.txt"
 #define COUNTRIES_OBSOLETE_FILE "countries_obsolete.txt"
+#define LOCAL_MAPS_MANIFEST_FILE "local_maps.manifest"
 
 #define WORLD_FILE_NAME "World"
 #define WORLD_COASTS_FILE_NAME "WorldCoasts"
@@ -75,13 +92,19 @@
 
 #define SEARCH_CATEGORIES_FILE_NAME "categories.txt"
 
+#define CLASSIFICATOR_FILE "classificator.txt"
+#define CLASSIFICATOR_BIN_FILE "classificator.bin"
+#define TYPES_FILE "types.txt"
+
 #define PACKED_POLYGONS_INFO_TAG "info"
+#define PACKED_POLYGONS_GRID_TAG "grid"
 #define PACKED_POLYGONS_FILE "packed_polygons.bin"
 #define PACKED_POLYGONS_OBSOLETE_FILE "packed_polygons_obsolete.bin"
 
 #define EXTERNAL_RESOURCES_FILE "external_resources.txt"
 
 #define GPS_TRACK_FILENAME "gps_track.dat"
+#define MWMS_SNAPSHOT_FILENAME "mwms_snapshot.bin"
 #define RESTRICTIONS_FILENAME "restrictions.csv"
 #define ROAD_ACCESS_FILENAME "road_access.csv"
 #define METALINES_FILENAME "metalines.bin"
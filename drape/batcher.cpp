@@ -191,14 +191,21 @@ void Batcher::EndSession()
 {
   Flush();
   m_flushInterface = TFlushFn();
+  m_preflushFn = TPreflushFn();
 }
 
 void Batcher::ResetSession()
 {
   m_flushInterface = TFlushFn();
+  m_preflushFn = TPreflushFn();
   m_buckets.clear();
 }
 
+void Batcher::SetPreflushFn(TPreflushFn const & preflushFn)
+{
+  m_preflushFn = preflushFn;
+}
+
 void Batcher::SetFeatureMinZoom(int minZoom)
 {
   m_featureMinZoom = minZoom;
@@ -239,6 +246,8 @@ void Batcher::FinalizeBucket(GLState const & state)
   drape_ptr<RenderBucket> bucket = move(it->second);
   m_buckets.erase(state);
 
+  if (m_preflushFn)
+    m_preflushFn(state, make_ref(bucket));
   bucket->GetBuffer()->Preflush();
   m_flushInterface(state, move(bucket));
 }
@@ -249,6 +258,8 @@ void Batcher::Flush()
   for_each(m_buckets.begin(), m_buckets.end(), [this](TBuckets::value_type & bucket)
   {
     ASSERT(bucket.second != nullptr, ());
+    if (m_preflushFn)
+      m_preflushFn(bucket.first, make_ref(bucket.second));
     bucket.second->GetBuffer()->Preflush();
     m_flushInterface(bucket.first, move(bucket.second));
   });
@@ -58,6 +58,14 @@ public:
   void StartSession(TFlushFn const & flusher);
   void EndSession();
   void ResetSession();
+  // Passes all the filled buckets to the flusher and keeps the session open.
+  void Flush();
+
+  // Called for every finished bucket right before its buffers are moved
+  // to GPU, i.e. while their CPU copies are still available. The function
+  // is reset at the end of the session.
+  typedef function<void (GLState const &, ref_ptr<RenderBucket>)> TPreflushFn;
+  void SetPreflushFn(TPreflushFn const & preflushFn);
 
   void SetFeatureMinZoom(int minZoom);
 
@@ -72,9 +80,9 @@ private:
   ref_ptr<RenderBucket> GetBucket(GLState const & state);
 
   void FinalizeBucket(GLState const & state);
-  void Flush();
 
   TFlushFn m_flushInterface;
+  TPreflushFn m_preflushFn;
 
   using TBuckets = map<GLState, drape_ptr<RenderBucket>>;
   TBuckets m_buckets;
@@ -14,19 +14,19 @@ ref_ptr<DataBufferBase> DataBuffer::GetBuffer() const
   return make_ref(m_impl);
 }
 
-void DataBuffer::MoveToGPU(GPUBuffer::Target target)
+void DataBuffer::MoveToGPU(GPUBuffer::Target target, bool isPooled)
 {
   // If currentSize is 0 buffer hasn't been filled on preparation stage, let it be filled further.
   uint32_t const currentSize = m_impl->GetCurrentSize();
   if (currentSize != 0)
   {
     m_impl = make_unique_dp<GpuBufferImpl>(target, m_impl->Data(), m_impl->GetElementSize(),
-                                           currentSize);
+                                           currentSize, isPooled);
   }
   else
   {
     m_impl = make_unique_dp<GpuBufferImpl>(target, nullptr, m_impl->GetElementSize(),
-                                           m_impl->GetAvailableSize());
+                                           m_impl->GetAvailableSize(), isPooled);
   }
 }
 
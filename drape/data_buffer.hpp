@@ -15,6 +15,8 @@ public:
   virtual uint8_t GetElementSize() const = 0;
   virtual void Seek(uint32_t elementNumber) = 0;
   virtual void const * Data() const = 0;
+  // Offset of data in the bound GL buffer.
+  virtual uint32_t GetByteOffset() const = 0;
 
   virtual void UploadData(void const * data, uint32_t elementCount) = 0;
   virtual void UpdateData(void * destPtr, void const * srcPtr, uint32_t elementOffset,
@@ -31,7 +33,8 @@ public:
   DataBuffer(uint8_t elementSize, uint32_t capacity);
 
   ref_ptr<DataBufferBase> GetBuffer() const;
-  void MoveToGPU(GPUBuffer::Target target);
+  // Pooled buffers are sub-allocated from large pages, see GPUBufferPool.
+  void MoveToGPU(GPUBuffer::Target target, bool isPooled = false);
 
 private:
   drape_ptr<DataBufferBase> m_impl;
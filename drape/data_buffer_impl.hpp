@@ -35,6 +35,7 @@ public:
   {}
 
   void const * Data() const override { return m_buffer->Data(); }
+  uint32_t GetByteOffset() const override { return 0; }
   void UploadData(void const * data, uint32_t elementCount) override
   {
     m_buffer->UploadData(data, elementCount);
@@ -72,6 +73,8 @@ public:
     return nullptr;
   }
 
+  uint32_t GetByteOffset() const override { return m_buffer->GetByteOffset(); }
+
   void UploadData(void const * data, uint32_t elementCount) override
   {
     m_buffer->UploadData(data, elementCount);
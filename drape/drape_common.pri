@@ -19,13 +19,16 @@ SOURCES += \
     $$DRAPE_DIR/glstate.cpp \
     $$DRAPE_DIR/glyph_manager.cpp \
     $$DRAPE_DIR/gpu_buffer.cpp \
+    $$DRAPE_DIR/gpu_buffer_pool.cpp \
     $$DRAPE_DIR/gpu_program.cpp \
     $$DRAPE_DIR/gpu_program_manager.cpp \
     $$DRAPE_DIR/hw_texture.cpp \
     $$DRAPE_DIR/index_buffer.cpp \
     $$DRAPE_DIR/index_buffer_mutator.cpp \
     $$DRAPE_DIR/index_storage.cpp \
+    $$DRAPE_DIR/object_pool.cpp \
     $$DRAPE_DIR/oglcontextfactory.cpp \
+    $$DRAPE_DIR/overlay_grid.cpp \
     $$DRAPE_DIR/overlay_handle.cpp \
     $$DRAPE_DIR/overlay_tree.cpp \
     $$DRAPE_DIR/pointers.cpp \
@@ -41,8 +44,10 @@ SOURCES += \
     $$DRAPE_DIR/uniform_value.cpp \
     $$DRAPE_DIR/uniform_values_storage.cpp \
     $$DRAPE_DIR/utils/glyph_usage_tracker.cpp \
+    $$DRAPE_DIR/utils/glyph_warm_up_list.cpp \
     $$DRAPE_DIR/utils/gpu_mem_tracker.cpp \
     $$DRAPE_DIR/utils/projection.cpp \
+    $$DRAPE_DIR/utils/render_counters.cpp \
     $$DRAPE_DIR/utils/vertex_decl.cpp \
     $$DRAPE_DIR/vertex_array_buffer.cpp \
     $$DRAPE_DIR/viewport.cpp \
@@ -75,6 +80,7 @@ HEADERS += \
     $$DRAPE_DIR/glstate.hpp \
     $$DRAPE_DIR/glyph_manager.hpp \
     $$DRAPE_DIR/gpu_buffer.hpp \
+    $$DRAPE_DIR/gpu_buffer_pool.hpp \
     $$DRAPE_DIR/gpu_program.hpp \
     $$DRAPE_DIR/gpu_program_info.hpp \
     $$DRAPE_DIR/gpu_program_manager.hpp \
@@ -85,6 +91,7 @@ HEADERS += \
     $$DRAPE_DIR/object_pool.hpp \
     $$DRAPE_DIR/oglcontext.hpp \
     $$DRAPE_DIR/oglcontextfactory.hpp \
+    $$DRAPE_DIR/overlay_grid.hpp \
     $$DRAPE_DIR/overlay_handle.hpp \
     $$DRAPE_DIR/overlay_tree.hpp \
     $$DRAPE_DIR/pointers.hpp \
@@ -100,8 +107,10 @@ HEADERS += \
     $$DRAPE_DIR/uniform_value.hpp \
     $$DRAPE_DIR/uniform_values_storage.hpp \
     $$DRAPE_DIR/utils/glyph_usage_tracker.hpp \
+    $$DRAPE_DIR/utils/glyph_warm_up_list.hpp \
     $$DRAPE_DIR/utils/gpu_mem_tracker.hpp \
     $$DRAPE_DIR/utils/projection.hpp \
+    $$DRAPE_DIR/utils/render_counters.hpp \
     $$DRAPE_DIR/utils/vertex_decl.hpp \
     $$DRAPE_DIR/vertex_array_buffer.hpp \
     $$DRAPE_DIR/viewport.hpp \
@@ -4,6 +4,7 @@
 
 #include "drape/data_buffer.hpp"
 #include "drape/gpu_buffer.hpp"
+#include "drape/gpu_buffer_pool.hpp"
 #include "drape/index_buffer.hpp"
 #include "drape/index_storage.hpp"
 
@@ -101,3 +102,65 @@ UNIT_TEST(ParticalUploadDataTest)
 
   buffer->MoveToGPU(GPUBuffer::ElementBuffer);
 }
+
+UNIT_TEST(PooledDataBuffersTest)
+{
+  GPUBufferPool & pool = GPUBufferPool::Instance();
+  pool.SetEnabled(true);
+
+  {
+    InSequence s;
+    // Both buffers are sub-allocated from one page.
+    EXPECTGL(glGenBuffer()).WillOnce(Return(1));
+    EXPECTGL(glBindBuffer(1, gl_const::GLArrayBuffer));
+    EXPECTGL(glBufferData(gl_const::GLArrayBuffer, GPUBufferPool::kPageSize, NULL,
+                          gl_const::GLDynamicDraw));
+    EXPECTGL(glBindBuffer(1, gl_const::GLArrayBuffer));
+    EXPECTGL(glBindBuffer(1, gl_const::GLArrayBuffer));
+    // A buffer which is too big for pages gets own GL object.
+    EXPECTGL(glGenBuffer()).WillOnce(Return(2));
+    EXPECTGL(glBindBuffer(2, gl_const::GLArrayBuffer));
+    EXPECTGL(glBufferData(gl_const::GLArrayBuffer, GPUBufferPool::kPageSize, NULL,
+                          gl_const::GLDynamicDraw));
+    EXPECTGL(glBindBuffer(0, gl_const::GLArrayBuffer));
+    EXPECTGL(glDeleteBuffer(2));
+    // The empty page is kept until resources are released.
+    EXPECTGL(glBindBuffer(0, gl_const::GLArrayBuffer));
+    EXPECTGL(glDeleteBuffer(1));
+
+    unique_ptr<DataBuffer> buffer1(new DataBuffer(3 * sizeof(float), 10));
+    buffer1->MoveToGPU(GPUBuffer::ElementBuffer, true /* isPooled */);
+    unique_ptr<DataBuffer> buffer2(new DataBuffer(3 * sizeof(float), 100));
+    buffer2->MoveToGPU(GPUBuffer::ElementBuffer, true /* isPooled */);
+    unique_ptr<DataBuffer> buffer3(new DataBuffer(1, GPUBufferPool::kPageSize));
+    buffer3->MoveToGPU(GPUBuffer::ElementBuffer, true /* isPooled */);
+
+    TEST_EQUAL(buffer1->GetBuffer()->GetByteOffset(), 0, ());
+    // Offsets are aligned.
+    TEST_EQUAL(buffer2->GetBuffer()->GetByteOffset(), 128, ());
+    TEST_EQUAL(buffer3->GetBuffer()->GetByteOffset(), 0, ());
+
+    auto statistic = pool.GetStatistic();
+    TEST_EQUAL(statistic.m_pagesCount, 1, ());
+    TEST_EQUAL(statistic.m_allocationsCount, 2, ());
+    TEST_EQUAL(statistic.m_usedBytes, 128 + 1200, ());
+
+    buffer3.reset();
+    buffer1.reset();
+    statistic = pool.GetStatistic();
+    TEST_EQUAL(statistic.m_allocationsCount, 1, ());
+    TEST_EQUAL(statistic.m_freeRangesCount, 2, ());
+
+    // Free ranges are merged.
+    buffer2.reset();
+    statistic = pool.GetStatistic();
+    TEST_EQUAL(statistic.m_pagesCount, 1, ());
+    TEST_EQUAL(statistic.m_freeRangesCount, 1, ());
+    TEST_EQUAL(statistic.m_usedBytes, 0, ());
+
+    pool.ReleaseGpuResources();
+    TEST_EQUAL(pool.GetStatistic().m_pagesCount, 0, ());
+  }
+
+  pool.SetEnabled(false);
+}
@@ -37,8 +37,10 @@ SOURCES += \
     glmock_functions.cpp \
     glyph_mng_tests.cpp \
     glyph_packer_test.cpp \
+    glyph_warm_up_list_tests.cpp \
     img.cpp \
     object_pool_tests.cpp \
+    overlay_tree_tests.cpp \
     pointers_tests.cpp \
     static_texture_tests.cpp \
     stipple_pen_tests.cpp \
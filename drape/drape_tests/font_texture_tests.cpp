@@ -60,7 +60,9 @@ class DummyGlyphIndex : public GlyphIndex
   typedef GlyphIndex TBase;
 
 public:
-  DummyGlyphIndex(m2::PointU size, ref_ptr<GlyphManager> mng) : TBase(size, mng) {}
+  DummyGlyphIndex(m2::PointU size, ref_ptr<GlyphManager> mng, ref_ptr<GlyphGenerator> generator)
+    : TBase(size, mng, generator)
+  {}
   ref_ptr<Texture::ResourceInfo> MapResource(GlyphKey const & key)
   {
     bool dummy = false;
@@ -88,7 +90,8 @@ UNIT_TEST(UploadingGlyphs)
   GetPlatform().GetFontNames(args.m_fonts);
 
   GlyphManager mng(args);
-  DummyGlyphIndex index(m2::PointU(128, 128), make_ref(&mng));
+  GlyphGenerator generator(make_ref(&mng), 2 /* threadsCount */);
+  DummyGlyphIndex index(m2::PointU(128, 128), make_ref(&mng), make_ref(&generator));
   size_t count = 1;  // invalid symbol glyph has mapped internally.
   count += (index.MapResource(GlyphKey(0x58, GlyphManager::kDynamicGlyphSize)) != nullptr) ? 1 : 0;
   count += (index.MapResource(GlyphKey(0x59, GlyphManager::kDynamicGlyphSize)) != nullptr) ? 1 : 0;
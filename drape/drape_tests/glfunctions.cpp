@@ -314,8 +314,14 @@ void GLFunctions::glUnmapBuffer(glConst target) {}
 void GLFunctions::glDrawElements(glConst primitive, uint32_t sizeOfIndex,
                                  uint32_t indexCount, uint32_t startIndex) {}
 
+void GLFunctions::glDrawElementsInstanced(glConst primitive, uint32_t sizeOfIndex,
+                                          uint32_t indexCount, uint32_t instanceCount,
+                                          uint32_t startIndex) {}
+
 void GLFunctions::glDrawArrays(glConst mode, int32_t first, uint32_t count) {}
 
+void GLFunctions::glVertexAttribDivisor(int32_t attrLocation, uint32_t divisor) {}
+
 void GLFunctions::glPixelStore(glConst name, uint32_t value) {}
 
 void GLFunctions::glStencilOpSeparate(glConst face, glConst sfail, glConst dpfail, glConst dppass) {}
@@ -24,3 +24,23 @@ UNIT_TEST(SimplePackTest)
   TEST(packer.IsFull(), ());
   TEST_EQUAL(r, m2::RectU(0, 15, 7, 25), ());
 }
+
+UNIT_TEST(PackerUsedHeightTest)
+{
+  dp::GlyphPacker packer(m2::PointU(32, 32));
+  TEST_EQUAL(packer.GetUsedHeight(), 0, ());
+
+  m2::RectU r;
+  TEST(packer.PackGlyph(20, 10, r), ());
+  TEST_EQUAL(packer.GetUsedHeight(), 10, ());
+
+  TEST(packer.PackGlyph(10, 12, r), ());
+  TEST_EQUAL(packer.GetUsedHeight(), 12, ());
+
+  // The next row starts.
+  TEST(packer.PackGlyph(10, 5, r), ());
+  TEST_EQUAL(packer.GetUsedHeight(), 17, ());
+
+  TEST(!packer.PackGlyph(10, 21, r), ());
+  TEST_EQUAL(packer.GetUsedHeight(), 17, ());
+}
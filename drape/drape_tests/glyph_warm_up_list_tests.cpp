@@ -0,0 +1,54 @@
+#include "testing/testing.hpp"
+
+#include "drape/utils/glyph_warm_up_list.hpp"
+
+#include "platform/platform.hpp"
+
+#include "coding/file_name_utils.hpp"
+
+#include "base/scope_guard.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <vector>
+
+using namespace dp;
+
+UNIT_TEST(GlyphWarmUpList_Smoke)
+{
+  std::string const fileName = my::JoinPath(GetPlatform().WritableDir(), "glyphs_test.txt");
+  MY_SCOPE_GUARD(removeFile, [&fileName] { std::remove(fileName.c_str()); });
+
+  {
+    GlyphWarmUpList list(fileName, 2 /* maxGlyphsCount */);
+    TEST(!list.Load(), ());
+    TEST(list.IsEmpty(), ());
+
+    list.AddUsage(strings::MakeUniString("abacaba"));
+    list.AddUsage(strings::MakeUniString("cc"));
+    // a: 4, b: 2, c: 3.
+    std::vector<strings::UniChar> const expected = {'a', 'c'};
+    TEST_EQUAL(list.GetGlyphs(), expected, ());
+    TEST(list.Save(), ());
+  }
+
+  {
+    // Counters are halved on loading, so 'b' leaves the list after the next saving.
+    GlyphWarmUpList list(fileName, 3 /* maxGlyphsCount */);
+    TEST(list.Load(), ());
+    std::vector<strings::UniChar> const expected = {'a', 'c'};
+    TEST_EQUAL(list.GetGlyphs(), expected, ());
+
+    list.AddUsage(strings::MakeUniString("bbbb"));
+    std::vector<strings::UniChar> const expected2 = {'b', 'a', 'c'};
+    TEST_EQUAL(list.GetGlyphs(), expected2, ());
+  }
+
+  {
+    std::ofstream stream(fileName, std::ios::trunc);
+    stream << "97 10\nabc\n";
+  }
+  GlyphWarmUpList list(fileName, 2 /* maxGlyphsCount */);
+  TEST(!list.Load(), ());
+  TEST(list.IsEmpty(), ());
+}
@@ -1,6 +1,10 @@
 #include "testing/testing.hpp"
 
 #include "drape/object_pool.hpp"
+#include "drape/pointers.hpp"
+
+#include <cstdint>
+#include <vector>
 
 class vec2
 {
@@ -73,3 +77,76 @@ UNIT_TEST(ObjectPoolClearing_2)
 
   TEST_EQUAL(vec2::m_counter, 0, ());
 }
+
+UNIT_TEST(ObjectAllocator_Reuse)
+{
+  dp::ObjectAllocator allocator;
+
+  void * p1 = allocator.Allocate(24);
+  void * p2 = allocator.Allocate(32);
+  TEST_EQUAL(reinterpret_cast<uintptr_t>(p1) % dp::ObjectAllocator::kGranularity, 0, ());
+  TEST_NOT_EQUAL(p1, p2, ());
+
+  // Both sizes are in the same size class, so only one chunk is taken from the heap.
+  auto stats = allocator.GetStats();
+  TEST_EQUAL(stats.m_allocations, 2, ());
+  TEST_EQUAL(stats.m_heapAllocations, 1, ());
+
+  allocator.Deallocate(p1, 24);
+  void * p3 = allocator.Allocate(17);
+  TEST_EQUAL(p1, p3, ());
+
+  allocator.Deallocate(p2, 32);
+  allocator.Deallocate(p3, 17);
+
+  std::vector<void *> blocks;
+  for (size_t i = 0; i < 2 * dp::ObjectAllocator::kBlocksPerChunk; ++i)
+    blocks.push_back(allocator.Allocate(100));
+  for (void * p : blocks)
+    allocator.Deallocate(p, 100);
+  for (size_t i = 0; i < 2 * dp::ObjectAllocator::kBlocksPerChunk; ++i)
+    blocks[i] = allocator.Allocate(100);
+  for (void * p : blocks)
+    allocator.Deallocate(p, 100);
+
+  void * large = allocator.Allocate(dp::ObjectAllocator::kMaxBlockSize + 1);
+  allocator.Deallocate(large, dp::ObjectAllocator::kMaxBlockSize + 1);
+
+  stats = allocator.GetStats();
+  TEST_EQUAL(stats.m_allocations, stats.m_deallocations, ());
+  TEST_EQUAL(stats.m_heapAllocations, 4, ());
+}
+
+namespace
+{
+class PooledBase : public dp::PooledObject
+{
+public:
+  virtual ~PooledBase() = default;
+};
+
+class PooledDerived : public PooledBase
+{
+public:
+  explicit PooledDerived(int value) { m_values[0] = value; }
+
+  int m_values[64];
+};
+}  // namespace
+
+UNIT_TEST(PooledObject_Hierarchy)
+{
+  auto & allocator = dp::ObjectAllocator::Instance();
+  auto const before = allocator.GetStats();
+  {
+    std::vector<drape_ptr<PooledBase>> objects;
+    for (int i = 0; i < 10; ++i)
+    {
+      objects.push_back(make_unique_dp<PooledBase>());
+      objects.push_back(make_unique_dp<PooledDerived>(i));
+    }
+  }
+  auto const after = allocator.GetStats();
+  TEST_EQUAL(after.m_allocations - before.m_allocations, 20, ());
+  TEST_EQUAL(after.m_deallocations - before.m_deallocations, 20, ());
+}
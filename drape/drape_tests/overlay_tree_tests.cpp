@@ -0,0 +1,148 @@
+#include "testing/testing.hpp"
+
+#include "drape/overlay_grid.hpp"
+#include "drape/overlay_handle.hpp"
+#include "drape/overlay_tree.hpp"
+
+#include "geometry/any_rect2d.hpp"
+#include "geometry/screenbase.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+using namespace dp;
+
+namespace
+{
+using THandles = std::vector<std::unique_ptr<SquareHandle>>;
+
+// Creates a row of squares of 30 pixels, every next one intersects the
+// previous one and has a greater priority.
+THandles CreateHandles(ScreenBase const & screen, size_t count)
+{
+  THandles handles;
+  for (size_t i = 0; i < count; ++i)
+  {
+    OverlayID const id(FeatureID(MwmSet::MwmId(), static_cast<uint32_t>(i)));
+    m2::PointD const pivot = screen.PtoG(m2::PointD(100.0 + 20.0 * i, 240.0));
+    handles.emplace_back(new SquareHandle(id, dp::Center, pivot,
+                                          m2::PointD(30.0, 30.0), m2::PointD(0.0, 0.0),
+                                          i /* priority */, false /* isBound */, ""));
+  }
+  return handles;
+}
+
+void PlaceHandles(OverlayTree & tree, ScreenBase const & screen, THandles const & handles,
+                  std::vector<size_t> const & skipped = {})
+{
+  while (!tree.Frame())
+    ;
+
+  tree.StartOverlayPlacing(screen);
+  for (size_t i = 0; i < handles.size(); ++i)
+  {
+    if (std::find(skipped.begin(), skipped.end(), i) == skipped.end())
+      tree.Add(make_ref(handles[i].get()));
+  }
+  tree.EndOverlayPlacing();
+}
+
+std::vector<bool> GetVisibility(THandles const & handles)
+{
+  std::vector<bool> result;
+  for (auto const & handle : handles)
+    result.push_back(handle->IsVisible());
+  return result;
+}
+}  // namespace
+
+UNIT_TEST(OverlayGrid_Smoke)
+{
+  THandles handles = CreateHandles(ScreenBase(), 3);
+  OverlayGrid grid(10.0 /* cellSize */);
+  grid.Reset(m2::RectD(0.0, 0.0, 100.0, 100.0));
+
+  grid.Add(make_ref(handles[0].get()), m2::RectD(5.0, 5.0, 25.0, 25.0));
+  grid.Add(make_ref(handles[1].get()), m2::RectD(50.0, 50.0, 60.0, 60.0));
+  // Handles out of the grid rect are found too.
+  grid.Add(make_ref(handles[2].get()), m2::RectD(150.0, 150.0, 160.0, 160.0));
+  TEST_EQUAL(grid.GetSize(), 3, ());
+
+  auto const select = [&grid](m2::RectD const & rect)
+  {
+    std::vector<ref_ptr<OverlayHandle>> result;
+    grid.ForEachInRect(rect, [&result](ref_ptr<OverlayHandle> const & h) { result.push_back(h); });
+    return result;
+  };
+
+  // A handle is found once, even if it's in many cells.
+  auto result = select(m2::RectD(0.0, 0.0, 30.0, 30.0));
+  TEST_EQUAL(result.size(), 1, ());
+  TEST(result.front() == make_ref(handles[0].get()), ());
+
+  TEST(select(m2::RectD(30.0, 30.0, 45.0, 45.0)).empty(), ());
+  TEST_EQUAL(select(m2::RectD(0.0, 0.0, 200.0, 200.0)).size(), 3, ());
+  TEST_EQUAL(select(m2::RectD(155.0, 155.0, 156.0, 156.0)).size(), 1, ());
+
+  grid.Erase(make_ref(handles[0].get()));
+  TEST_EQUAL(grid.GetSize(), 2, ());
+  TEST(select(m2::RectD(0.0, 0.0, 30.0, 30.0)).empty(), ());
+
+  // Erased entries are reused.
+  grid.Add(make_ref(handles[0].get()), m2::RectD(52.0, 52.0, 55.0, 55.0));
+  TEST_EQUAL(select(m2::RectD(51.0, 51.0, 53.0, 53.0)).size(), 2, ());
+
+  grid.Clear();
+  TEST_EQUAL(grid.GetSize(), 0, ());
+  TEST(select(m2::RectD(0.0, 0.0, 200.0, 200.0)).empty(), ());
+}
+
+UNIT_TEST(OverlayTree_IncrementalPlacing)
+{
+  size_t const kHandlesCount = 20;
+  ScreenBase screen(m2::RectI(0, 0, 640, 480), m2::AnyRectD(m2::RectD(0.0, 0.0, 640.0, 480.0)));
+
+  // Results of incremental placing are compared with results of full
+  // placing of the same handles.
+  THandles handles = CreateHandles(screen, kHandlesCount);
+  THandles fullHandles = CreateHandles(screen, kHandlesCount);
+  OverlayTree tree(1.0 /* visualScale */);
+  OverlayTree fullTree(1.0 /* visualScale */);
+  fullTree.SetIncrementalPlacingEnabled(false);
+
+  auto const place = [&](std::vector<size_t> const & skipped)
+  {
+    PlaceHandles(tree, screen, handles, skipped);
+    PlaceHandles(fullTree, screen, fullHandles, skipped);
+    TEST_EQUAL(GetVisibility(handles), GetVisibility(fullHandles), ());
+  };
+
+  place({});
+  auto const visibility = GetVisibility(handles);
+  // Every odd handle displaces the previous one.
+  for (size_t i = 0; i < kHandlesCount; ++i)
+    TEST_EQUAL(visibility[i], i % 2 == 1, (i));
+
+  // Nothing is changed when the screen stays the same or when it's panned.
+  place({});
+  TEST_EQUAL(GetVisibility(handles), visibility, ());
+
+  screen.Move(7.0, 3.0);
+  place({});
+  TEST_EQUAL(GetVisibility(handles), visibility, ());
+
+  // Handles which were displayed last time win, so the neighbours of
+  // the removed handle stay hidden.
+  place({5} /* skipped */);
+  TEST(!handles[4]->IsVisible(), ());
+  TEST(!handles[6]->IsVisible(), ());
+
+  // A handle which was displaced takes space of the removed one.
+  place({1, 5} /* skipped */);
+  TEST(handles[0]->IsVisible(), ());
+
+  screen.Move(-20.0, 0.0);
+  place({1, 5} /* skipped */);
+  TEST(handles[0]->IsVisible(), ());
+}
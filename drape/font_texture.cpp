@@ -1,10 +1,12 @@
 #include "drape/font_texture.hpp"
 #include "drape/pointers.hpp"
+#include "drape/utils/gpu_mem_tracker.hpp"
 
 #include "platform/platform.hpp"
 #include "coding/reader.hpp"
 
 #include "base/logging.hpp"
+#include "base/math.hpp"
 #include "base/string_utils.hpp"
 #include "base/stl_add.hpp"
 
@@ -12,7 +14,6 @@
 #include "std/string.hpp"
 #include "std/vector.hpp"
 #include "std/map.hpp"
-#include "std/bind.hpp"
 
 namespace dp
 {
@@ -88,73 +89,142 @@ m2::RectF GlyphPacker::MapTextureCoords(const m2::RectU & pixelRect) const
 
 bool GlyphPacker::IsFull() const { return m_isFull; }
 
-GlyphGenerator::GlyphGenerator(ref_ptr<GlyphManager> mng, TCompletionHandler const & completionHandler)
+namespace
+{
+// Count of glyphs which a thread of the generator takes at once.
+size_t const kGlyphsBatchSize = 16;
+uint32_t const kMaxGeneratorThreadsCount = 4;
+}  // namespace
+
+GlyphGenerator::GlyphGenerator(ref_ptr<GlyphManager> mng, uint32_t threadsCount)
   : m_mng(mng)
-  , m_completionHandler(completionHandler)
-  , m_isRunning(true)
-  , m_isSuspended(false)
-  , m_thread(&GlyphGenerator::Routine, this)
 {
-  ASSERT(m_completionHandler != nullptr, ());
+  ASSERT_GREATER(threadsCount, 0, ());
+  m_threads.reserve(threadsCount);
+  for (uint32_t i = 0; i < threadsCount; ++i)
+    m_threads.emplace_back(&GlyphGenerator::Routine, this);
 }
 
 GlyphGenerator::~GlyphGenerator()
 {
-  m_isRunning = false;
-  m_condition.notify_one();
-  m_thread.join();
-  m_completionHandler = nullptr;
+  {
+    lock_guard<mutex> lock(m_mutex);
+    m_isRunning = false;
+  }
+  m_queueCondition.notify_all();
+  for (auto & t : m_threads)
+    t.join();
+  m_threads.clear();
 
+  ASSERT(m_listeners.empty(), ("All listeners must be unregistered."));
   for (GlyphGenerationData & data : m_queue)
     data.m_glyph.m_image.Destroy();
   m_queue.clear();
 }
 
-void GlyphGenerator::WaitForGlyph(list<GlyphGenerationData> & queue)
+// static
+uint32_t GlyphGenerator::GetDefaultThreadsCount()
 {
-  unique_lock<mutex> lock(m_queueLock);
-  m_isSuspended = true;
-  m_condition.wait(lock, [this] { return !m_queue.empty() || !m_isRunning; });
-  m_isSuspended = false;
-  queue.swap(m_queue);
+  // Half of cores is left for the renderers and the readers of tiles.
+  uint32_t const count = thread::hardware_concurrency() / 2;
+  return my::clamp(count, 1u, kMaxGeneratorThreadsCount);
+}
+
+void GlyphGenerator::RegisterListener(ref_ptr<Listener> listener)
+{
+  lock_guard<mutex> lock(m_mutex);
+  m_listeners.emplace(listener, 0);
+}
+
+void GlyphGenerator::UnregisterListener(ref_ptr<Listener> listener)
+{
+  unique_lock<mutex> lock(m_mutex);
+  for (auto it = m_queue.begin(); it != m_queue.end();)
+  {
+    if (it->m_listener == listener)
+    {
+      it->m_glyph.m_image.Destroy();
+      it = m_queue.erase(it);
+    }
+    else
+    {
+      ++it;
+    }
+  }
+
+  m_completionCondition.wait(lock, [this, listener]
+  {
+    auto const it = m_listeners.find(listener);
+    return it == m_listeners.end() || it->second == 0;
+  });
+  m_listeners.erase(listener);
 }
 
 bool GlyphGenerator::IsSuspended() const
 {
-  lock_guard<mutex> lock(m_queueLock);
-  return m_isSuspended;
+  lock_guard<mutex> lock(m_mutex);
+  return m_queue.empty() && m_activeGlyphsCount == 0;
 }
 
-void GlyphGenerator::Routine(GlyphGenerator * generator)
+void GlyphGenerator::Routine()
 {
-  ASSERT(generator != nullptr, ());
-  while (generator->m_isRunning)
+  vector<GlyphGenerationData> batch;
+  batch.reserve(kGlyphsBatchSize);
+  while (true)
   {
-    list<GlyphGenerationData> queue;
-    generator->WaitForGlyph(queue);
+    {
+      unique_lock<mutex> lock(m_mutex);
+      m_queueCondition.wait(lock, [this] { return !m_queue.empty() || !m_isRunning; });
+      if (!m_isRunning)
+        return;
+
+      while (!m_queue.empty() && batch.size() < kGlyphsBatchSize)
+      {
+        batch.push_back(m_queue.front());
+        m_queue.pop_front();
+        ++m_listeners[batch.back().m_listener];
+      }
+      m_activeGlyphsCount += static_cast<uint32_t>(batch.size());
+    }
 
-    // generate glyphs
-    for (GlyphGenerationData & data : queue)
+    for (GlyphGenerationData & data : batch)
     {
-      GlyphManager::Glyph glyph = generator->m_mng->GenerateGlyph(data.m_glyph);
+      GlyphManager::Glyph glyph = m_mng->GenerateGlyph(data.m_glyph);
       data.m_glyph.m_image.Destroy();
-      generator->m_completionHandler(data.m_rect, glyph);
+      data.m_listener->OnCompleteGlyphGeneration(data.m_rect, glyph);
+    }
+
+    {
+      lock_guard<mutex> lock(m_mutex);
+      for (GlyphGenerationData const & data : batch)
+        --m_listeners[data.m_listener];
+      m_activeGlyphsCount -= static_cast<uint32_t>(batch.size());
     }
+    m_completionCondition.notify_all();
+    batch.clear();
   }
 }
 
-void GlyphGenerator::GenerateGlyph(m2::RectU const & rect, GlyphManager::Glyph const & glyph)
+void GlyphGenerator::GenerateGlyph(ref_ptr<Listener> listener, m2::RectU const & rect,
+                                   GlyphManager::Glyph const & glyph)
 {
-  lock_guard<mutex> lock(m_queueLock);
-  m_queue.emplace_back(rect, glyph);
-  m_condition.notify_one();
+  {
+    lock_guard<mutex> lock(m_mutex);
+    ASSERT(m_listeners.find(listener) != m_listeners.end(), ());
+    m_queue.emplace_back(listener, rect, glyph);
+  }
+  m_queueCondition.notify_one();
 }
 
-GlyphIndex::GlyphIndex(m2::PointU size, ref_ptr<GlyphManager> mng)
+GlyphIndex::GlyphIndex(m2::PointU size, ref_ptr<GlyphManager> mng,
+                       ref_ptr<GlyphGenerator> generator)
   : m_packer(size)
   , m_mng(mng)
-  , m_generator(new GlyphGenerator(mng, bind(&GlyphIndex::OnGlyphGenerationCompletion, this, _1, _2)))
+  , m_generator(generator)
+  , m_usedHeight(0)
 {
+  m_generator->RegisterListener(make_ref(this));
+
   // Cache invalid glyph.
   GlyphKey const key = GlyphKey(m_mng->GetInvalidGlyph(GlyphManager::kDynamicGlyphSize).m_code,
                                 GlyphManager::kDynamicGlyphSize);
@@ -164,7 +234,7 @@ GlyphIndex::GlyphIndex(m2::PointU size, ref_ptr<GlyphManager> mng)
 
 GlyphIndex::~GlyphIndex()
 {
-  m_generator.reset();
+  m_generator->UnregisterListener(make_ref(this));
   {
     threads::MutexGuard g(m_lock);
     for_each(m_pendingNodes.begin(), m_pendingNodes.end(), [](TPendingNode & node)
@@ -184,7 +254,8 @@ ref_ptr<Texture::ResourceInfo> GlyphIndex::MapResource(GlyphKey const & key, boo
 
   newResource = true;
 
-  GlyphManager::Glyph glyph = m_mng->GetGlyph(key.GetUnicodePoint(), key.GetFixedSize());
+  // Only metrics are calculated here, the glyph is rasterized by the generator.
+  GlyphManager::Glyph glyph = m_mng->GetGlyphMetrics(key.GetUnicodePoint(), key.GetFixedSize());
   m2::RectU r;
   if (!m_packer.PackGlyph(glyph.m_image.m_width, glyph.m_image.m_height, r))
   {
@@ -201,7 +272,8 @@ ref_ptr<Texture::ResourceInfo> GlyphIndex::MapResource(GlyphKey const & key, boo
     return nullptr;
   }
 
-  m_generator->GenerateGlyph(r, glyph);
+  m_generator->GenerateGlyph(make_ref(this), r, glyph);
+  m_usedHeight = m_packer.GetUsedHeight();
 
   auto res = m_index.emplace(key, GlyphInfo(m_packer.MapTextureCoords(r), glyph.m_metrics));
   ASSERT(res.second, ());
@@ -232,7 +304,8 @@ size_t GlyphIndex::GetPendingNodesCount()
   return m_pendingNodes.size();
 }
 
-void GlyphIndex::OnGlyphGenerationCompletion(m2::RectU const & rect, GlyphManager::Glyph const & glyph)
+void GlyphIndex::OnCompleteGlyphGeneration(m2::RectU const & rect,
+                                           GlyphManager::Glyph const & glyph)
 {
   threads::MutexGuard g(m_lock);
   m_pendingNodes.emplace_back(rect, glyph);
@@ -292,4 +365,18 @@ uint32_t GlyphIndex::GetAbsentGlyphsCount(strings::UniString const & text, int f
   return count;
 }
 
+void FontTexture::UpdateState()
+{
+  TBase::UpdateState();
+
+#if defined(TRACK_GPU_MEM)
+  uint32_t const usedHeight = m_index.GetUsedHeight();
+  if (usedHeight != m_reportedUsedHeight)
+  {
+    m_reportedUsedHeight = usedHeight;
+    dp::GPUMemTracker::Inst().SetUsed("Texture", GetID(),
+                                      usedHeight * GetWidth() * GetBytesPerPixel(GetFormat()));
+  }
+#endif
+}
 } // namespace dp
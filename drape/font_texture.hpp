@@ -5,6 +5,7 @@
 #include "drape/glyph_manager.hpp"
 #include "drape/dynamic_texture.hpp"
 
+#include "std/algorithm.hpp"
 #include "std/atomic.hpp"
 #include "std/condition_variable.hpp"
 #include "std/list.hpp"
@@ -25,6 +26,8 @@ public:
   m2::RectF MapTextureCoords(m2::RectU const & pixelRect) const;
   bool IsFull() const;
   m2::PointU const & GetSize() const { return m_size; }
+  // Height of the packed rows including the current one.
+  uint32_t GetUsedHeight() const { return std::min(m_cursor.y + m_yStep, m_size.y); }
 
 private:
   m2::PointU m_size = m2::PointU(0, 0);
@@ -73,48 +76,69 @@ private:
   GlyphManager::GlyphMetrics m_metrics;
 };
 
+// Pool of threads which generate images of glyphs for all font textures.
+// Glyphs are taken by batches, so a thread doesn't wake up for every glyph.
 class GlyphGenerator
 {
 public:
-  using TCompletionHandler = function<void(m2::RectU const &, GlyphManager::Glyph const &)>;
+  class Listener
+  {
+  public:
+    virtual ~Listener() = default;
+    // Called on a thread of the generator.
+    virtual void OnCompleteGlyphGeneration(m2::RectU const & rect,
+                                           GlyphManager::Glyph const & glyph) = 0;
+  };
 
   struct GlyphGenerationData
   {
+    ref_ptr<Listener> m_listener;
     m2::RectU m_rect;
     GlyphManager::Glyph m_glyph;
 
-    GlyphGenerationData(m2::RectU const & rect, GlyphManager::Glyph const & glyph)
-      : m_rect(rect), m_glyph(glyph)
+    GlyphGenerationData(ref_ptr<Listener> listener, m2::RectU const & rect,
+                        GlyphManager::Glyph const & glyph)
+      : m_listener(listener), m_rect(rect), m_glyph(glyph)
     {}
   };
 
-  GlyphGenerator(ref_ptr<GlyphManager> mng, TCompletionHandler const & completionHandler);
+  GlyphGenerator(ref_ptr<GlyphManager> mng, uint32_t threadsCount);
   ~GlyphGenerator();
 
-  void GenerateGlyph(m2::RectU const & rect, GlyphManager::Glyph const & glyph);
+  // Count of threads which is used when nothing else is known.
+  static uint32_t GetDefaultThreadsCount();
+
+  void RegisterListener(ref_ptr<Listener> listener);
+  // Drops glyphs of the listener which aren't generated yet and waits until
+  // the listener gets all callbacks which are in progress.
+  void UnregisterListener(ref_ptr<Listener> listener);
+
+  void GenerateGlyph(ref_ptr<Listener> listener, m2::RectU const & rect,
+                     GlyphManager::Glyph const & glyph);
 
   bool IsSuspended() const;
 
 private:
-  static void Routine(GlyphGenerator * generator);
-  void WaitForGlyph(list<GlyphGenerationData> & queue);
+  void Routine();
 
   ref_ptr<GlyphManager> m_mng;
-  TCompletionHandler m_completionHandler;
 
   list<GlyphGenerationData> m_queue;
-  mutable mutex m_queueLock;
-
-  atomic<bool> m_isRunning;
-  condition_variable m_condition;
-  bool m_isSuspended;
-  thread m_thread;
+  // Counts of glyphs which are being generated for listeners.
+  map<ref_ptr<Listener>, uint32_t> m_listeners;
+  uint32_t m_activeGlyphsCount = 0;
+  mutable mutex m_mutex;
+  condition_variable m_queueCondition;
+  condition_variable m_completionCondition;
+
+  bool m_isRunning = true;
+  vector<thread> m_threads;
 };
 
-class GlyphIndex
+class GlyphIndex : public GlyphGenerator::Listener
 {
 public:
-  GlyphIndex(m2::PointU size, ref_ptr<GlyphManager> mng);
+  GlyphIndex(m2::PointU size, ref_ptr<GlyphManager> mng, ref_ptr<GlyphGenerator> generator);
   ~GlyphIndex();
 
   // This function can return nullptr.
@@ -127,15 +151,20 @@ public:
 
   uint32_t GetAbsentGlyphsCount(strings::UniString const & text, int fixedHeight) const;
 
+  // Height of the part of the texture which is occupied by glyphs. It may
+  // be called on any thread.
+  uint32_t GetUsedHeight() const { return m_usedHeight; }
+
   // ONLY for unit-tests. DO NOT use this function anywhere else.
   size_t GetPendingNodesCount();
 
-private:
-  void OnGlyphGenerationCompletion(m2::RectU const & rect, GlyphManager::Glyph const & glyph);
+  void OnCompleteGlyphGeneration(m2::RectU const & rect,
+                                 GlyphManager::Glyph const & glyph) override;
 
+private:
   GlyphPacker m_packer;
   ref_ptr<GlyphManager> m_mng;
-  unique_ptr<GlyphGenerator> m_generator;
+  ref_ptr<GlyphGenerator> m_generator;
 
   typedef map<GlyphKey, GlyphInfo> TResourceMapping;
   typedef pair<m2::RectU, GlyphManager::Glyph> TPendingNode;
@@ -144,14 +173,16 @@ private:
   TResourceMapping m_index;
   TPendingNodes m_pendingNodes;
   threads::Mutex m_lock;
+  atomic<uint32_t> m_usedHeight;
 };
 
 class FontTexture : public DynamicTexture<GlyphIndex, GlyphKey, Texture::Glyph>
 {
   using TBase = DynamicTexture<GlyphIndex, GlyphKey, Texture::Glyph>;
 public:
-  FontTexture(m2::PointU const & size, ref_ptr<GlyphManager> glyphMng, ref_ptr<HWTextureAllocator> allocator)
-    : m_index(size, glyphMng)
+  FontTexture(m2::PointU const & size, ref_ptr<GlyphManager> glyphMng,
+              ref_ptr<GlyphGenerator> glyphGenerator, ref_ptr<HWTextureAllocator> allocator)
+    : m_index(size, glyphMng, glyphGenerator)
   {
     TBase::TextureParams params{size, TextureFormat::ALPHA, gl_const::GLLinear, true /* m_usePixelBuffer */};
     TBase::Init(allocator, make_ref(&m_index), params);
@@ -174,7 +205,10 @@ public:
     return m_index.GetAbsentGlyphsCount(text, fixedHeight);
   }
 
+  void UpdateState() override;
+
 private:
   GlyphIndex m_index;
+  uint32_t m_reportedUsedHeight = 0;
 };
 }  // namespace dp
@@ -95,6 +95,18 @@
   #define GL_FUNC_REVERSE_SUBTRACT 0x800B
 #endif
 
+#if !defined(GL_TIME_ELAPSED)
+  #define GL_TIME_ELAPSED 0x88BF
+#endif
+
+#if !defined(GL_QUERY_RESULT)
+  #define GL_QUERY_RESULT 0x8866
+#endif
+
+#if !defined(GL_QUERY_RESULT_AVAILABLE)
+  #define GL_QUERY_RESULT_AVAILABLE 0x8867
+#endif
+
 namespace gl_const
 {
 
@@ -251,4 +263,8 @@ const glConst GLDepthStencilAttachment = GL_DEPTH_STENCIL_ATTACHMENT;
 
 const glConst GLFramebufferComplete = GL_FRAMEBUFFER_COMPLETE;
 
+const glConst GLTimeElapsed         = GL_TIME_ELAPSED;
+const glConst GLQueryResult         = GL_QUERY_RESULT;
+const glConst GLQueryResultAvailable = GL_QUERY_RESULT_AVAILABLE;
+
 } // namespace GLConst
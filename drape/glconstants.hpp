@@ -187,4 +187,9 @@ extern const glConst GLDepthStencilAttachment;
 /// Framebuffer status
 extern const glConst GLFramebufferComplete;
 
+/// Query targets and parameters
+extern const glConst GLTimeElapsed;
+extern const glConst GLQueryResult;
+extern const glConst GLQueryResultAvailable;
+
 } // namespace GLConst
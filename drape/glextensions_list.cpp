@@ -37,9 +37,15 @@ GLExtensionsList::GLExtensionsList(dp::ApiVersion apiVersion)
     SetExtension(VertexArrayObject, true);
     SetExtension(UintIndices, true);
   }
+#ifdef OMIM_OS_ANDROID
+  CheckExtension(TimerQuery, "GL_EXT_disjoint_timer_query");
+#else
+  SetExtension(TimerQuery, false);
+#endif
 #elif defined(OMIM_OS_WINDOWS)
   SetExtension(MapBuffer, true);
   SetExtension(UintIndices, true);
+  CheckExtension(TimerQuery, "GL_ARB_timer_query");
   if (apiVersion == dp::ApiVersion::OpenGLES2)
   {
     SetExtension(VertexArrayObject, false);
@@ -63,6 +69,12 @@ GLExtensionsList::GLExtensionsList(dp::ApiVersion apiVersion)
     SetExtension(VertexArrayObject, true);
     SetExtension(MapBufferRange, true);
   }
+#ifdef OMIM_OS_MAC
+  // Timer queries are in the core profile, which is used for OpenGL ES 3 emulation.
+  SetExtension(TimerQuery, apiVersion == dp::ApiVersion::OpenGLES3);
+#else
+  CheckExtension(TimerQuery, "GL_ARB_timer_query");
+#endif
 #endif
 }
 
@@ -17,7 +17,8 @@ public:
     VertexArrayObject,
     MapBuffer,
     UintIndices,
-    MapBufferRange
+    MapBufferRange,
+    TimerQuery
   };
 
   static GLExtensionsList & Instance();
@@ -1,6 +1,7 @@
 #include "drape/glfunctions.hpp"
 #include "drape/glIncludes.hpp"
 #include "drape/glextensions_list.hpp"
+#include "drape/utils/render_counters.hpp"
 
 #include "base/assert.hpp"
 #include "base/logging.hpp"
@@ -118,6 +119,18 @@ typedef GLenum(DP_APIENTRY * TglCheckFramebufferStatusFn)(GLenum target);
 
 typedef GLubyte const * (DP_APIENTRY * TglGetStringiFn) (GLenum name, GLuint index);
 
+typedef void(DP_APIENTRY * TglVertexAttribDivisorFn)(GLuint index, GLuint divisor);
+typedef void(DP_APIENTRY * TglDrawElementsInstancedFn)(GLenum mode, GLsizei count, GLenum type,
+                                                       GLvoid const * indices,
+                                                       GLsizei instanceCount);
+
+typedef void(DP_APIENTRY * TglGenQueriesFn)(GLsizei n, GLuint * ids);
+typedef void(DP_APIENTRY * TglDeleteQueriesFn)(GLsizei n, GLuint const * ids);
+typedef void(DP_APIENTRY * TglBeginQueryFn)(GLenum target, GLuint id);
+typedef void(DP_APIENTRY * TglEndQueryFn)(GLenum target);
+typedef void(DP_APIENTRY * TglGetQueryObjectuivFn)(GLuint id, GLenum name, GLuint * params);
+typedef void(DP_APIENTRY * TglGetQueryObjectui64vFn)(GLuint id, GLenum name, GLuint64 * params);
+
 TglClearColorFn glClearColorFn = nullptr;
 TglClearFn glClearFn = nullptr;
 TglViewportFn glViewportFn = nullptr;
@@ -189,6 +202,18 @@ TglCheckFramebufferStatusFn glCheckFramebufferStatusFn = nullptr;
 
 TglGetStringiFn glGetStringiFn = nullptr;
 
+/// Instancing
+TglVertexAttribDivisorFn glVertexAttribDivisorFn = nullptr;
+TglDrawElementsInstancedFn glDrawElementsInstancedFn = nullptr;
+
+/// Queries
+TglGenQueriesFn glGenQueriesFn = nullptr;
+TglDeleteQueriesFn glDeleteQueriesFn = nullptr;
+TglBeginQueryFn glBeginQueryFn = nullptr;
+TglEndQueryFn glEndQueryFn = nullptr;
+TglGetQueryObjectuivFn glGetQueryObjectuivFn = nullptr;
+TglGetQueryObjectui64vFn glGetQueryObjectui64vFn = nullptr;
+
 #if !defined(GL_NUM_EXTENSIONS)
   #define GL_NUM_EXTENSIONS 0x821D
 #endif
@@ -316,6 +341,61 @@ void GLFunctions::Init(dp::ApiVersion apiVersion)
   glUnmapBufferFn = LOAD_GL_FUNC(TglUnmapBufferFn, glUnmapBuffer);
 #endif
 
+/// Instancing
+  if (CurrentApiVersion == dp::ApiVersion::OpenGLES3)
+  {
+#if defined(OMIM_OS_ANDROID)
+    glVertexAttribDivisorFn = ::glVertexAttribDivisor;
+    glDrawElementsInstancedFn = ::glDrawElementsInstanced;
+#elif defined(OMIM_OS_WINDOWS)
+    glVertexAttribDivisorFn = LOAD_GL_FUNC(TglVertexAttribDivisorFn, glVertexAttribDivisor);
+    glDrawElementsInstancedFn =
+        LOAD_GL_FUNC(TglDrawElementsInstancedFn, glDrawElementsInstanced);
+#else
+    glVertexAttribDivisorFn = &::glVertexAttribDivisor;
+    glDrawElementsInstancedFn = &::glDrawElementsInstanced;
+#endif
+  }
+
+/// Timer queries
+#if defined(OMIM_OS_MAC)
+  if (CurrentApiVersion == dp::ApiVersion::OpenGLES3)
+  {
+    glGenQueriesFn = &::glGenQueries;
+    glDeleteQueriesFn = &::glDeleteQueries;
+    glBeginQueryFn = &::glBeginQuery;
+    glEndQueryFn = &::glEndQuery;
+    glGetQueryObjectuivFn = &::glGetQueryObjectuiv;
+    glGetQueryObjectui64vFn = &::glGetQueryObjectui64v;
+  }
+#elif defined(OMIM_OS_LINUX)
+  glGenQueriesFn = &::glGenQueries;
+  glDeleteQueriesFn = &::glDeleteQueries;
+  glBeginQueryFn = &::glBeginQuery;
+  glEndQueryFn = &::glEndQuery;
+  glGetQueryObjectuivFn = &::glGetQueryObjectuiv;
+  glGetQueryObjectui64vFn = &::glGetQueryObjectui64v;
+#elif defined(OMIM_OS_ANDROID)
+  // GL_EXT_disjoint_timer_query is the same for both versions of API.
+  glGenQueriesFn = (TglGenQueriesFn)eglGetProcAddress("glGenQueriesEXT");
+  glDeleteQueriesFn = (TglDeleteQueriesFn)eglGetProcAddress("glDeleteQueriesEXT");
+  glBeginQueryFn = (TglBeginQueryFn)eglGetProcAddress("glBeginQueryEXT");
+  glEndQueryFn = (TglEndQueryFn)eglGetProcAddress("glEndQueryEXT");
+  glGetQueryObjectuivFn = (TglGetQueryObjectuivFn)eglGetProcAddress("glGetQueryObjectuivEXT");
+  glGetQueryObjectui64vFn =
+      (TglGetQueryObjectui64vFn)eglGetProcAddress("glGetQueryObjectui64vEXT");
+#elif defined(OMIM_OS_WINDOWS)
+  if (dp::GLExtensionsList::Instance().IsSupported(dp::GLExtensionsList::TimerQuery))
+  {
+    glGenQueriesFn = LOAD_GL_FUNC(TglGenQueriesFn, glGenQueries);
+    glDeleteQueriesFn = LOAD_GL_FUNC(TglDeleteQueriesFn, glDeleteQueries);
+    glBeginQueryFn = LOAD_GL_FUNC(TglBeginQueryFn, glBeginQuery);
+    glEndQueryFn = LOAD_GL_FUNC(TglEndQueryFn, glEndQuery);
+    glGetQueryObjectuivFn = LOAD_GL_FUNC(TglGetQueryObjectuivFn, glGetQueryObjectuiv);
+    glGetQueryObjectui64vFn = LOAD_GL_FUNC(TglGetQueryObjectui64vFn, glGetQueryObjectui64v);
+  }
+#endif
+
   glClearColorFn = LOAD_GL_FUNC(TglClearColorFn, glClearColor);
   glClearFn = LOAD_GL_FUNC(TglClearFn, glClear);
   glViewportFn = LOAD_GL_FUNC(TglViewportFn, glViewport);
@@ -768,6 +848,12 @@ void GLFunctions::glVertexAttributePointer(int attrLocation, uint32_t count, glC
                                      reinterpret_cast<void *>(offset)));
 }
 
+void GLFunctions::glVertexAttribDivisor(int32_t attrLocation, uint32_t divisor)
+{
+  ASSERT(glVertexAttribDivisorFn != nullptr, ());
+  GLCHECK(glVertexAttribDivisorFn(attrLocation, divisor));
+}
+
 void GLFunctions::glGetActiveUniform(uint32_t programID, uint32_t uniformIndex,
                                      int32_t * uniformSize, glConst * type, std::string & name)
 {
@@ -958,11 +1044,24 @@ void GLFunctions::glDrawElements(glConst primitive, uint32_t sizeOfIndex, uint32
   GLCHECK(::glDrawElements(primitive, indexCount,
                            sizeOfIndex == sizeof(uint32_t) ? GL_UNSIGNED_INT : GL_UNSIGNED_SHORT,
                            reinterpret_cast<GLvoid *>(startIndex * sizeOfIndex)));
+  dp::RenderCounters::Instance().AddDrawCall();
+}
+
+void GLFunctions::glDrawElementsInstanced(glConst primitive, uint32_t sizeOfIndex,
+                                          uint32_t indexCount, uint32_t instanceCount,
+                                          uint32_t startIndex)
+{
+  ASSERT(glDrawElementsInstancedFn != nullptr, ());
+  GLCHECK(glDrawElementsInstancedFn(
+      primitive, indexCount, sizeOfIndex == sizeof(uint32_t) ? GL_UNSIGNED_INT : GL_UNSIGNED_SHORT,
+      reinterpret_cast<GLvoid *>(startIndex * sizeOfIndex), instanceCount));
+  dp::RenderCounters::Instance().AddDrawCall();
 }
 
 void GLFunctions::glDrawArrays(glConst mode, int32_t first, uint32_t count)
 {
   GLCHECK(::glDrawArrays(mode, first, count));
+  dp::RenderCounters::Instance().AddDrawCall();
 }
 
 void GLFunctions::glGenFramebuffer(uint32_t * fbo)
@@ -997,6 +1096,48 @@ uint32_t GLFunctions::glCheckFramebufferStatus()
   return result;
 }
 
+uint32_t GLFunctions::glGenQuery()
+{
+  ASSERT(glGenQueriesFn != nullptr, ());
+  GLuint result = 0;
+  GLCHECK(glGenQueriesFn(1, &result));
+  return result;
+}
+
+void GLFunctions::glDeleteQuery(uint32_t queryID)
+{
+  ASSERT(glDeleteQueriesFn != nullptr, ());
+  GLCHECK(glDeleteQueriesFn(1, &queryID));
+}
+
+void GLFunctions::glBeginQuery(glConst target, uint32_t queryID)
+{
+  ASSERT(glBeginQueryFn != nullptr, ());
+  GLCHECK(glBeginQueryFn(target, queryID));
+}
+
+void GLFunctions::glEndQuery(glConst target)
+{
+  ASSERT(glEndQueryFn != nullptr, ());
+  GLCHECK(glEndQueryFn(target));
+}
+
+uint32_t GLFunctions::glGetQueryObjectui(uint32_t queryID, glConst name)
+{
+  ASSERT(glGetQueryObjectuivFn != nullptr, ());
+  GLuint result = 0;
+  GLCHECK(glGetQueryObjectuivFn(queryID, name, &result));
+  return result;
+}
+
+uint64_t GLFunctions::glGetQueryObjectui64(uint32_t queryID, glConst name)
+{
+  ASSERT(glGetQueryObjectui64vFn != nullptr, ());
+  GLuint64 result = 0;
+  GLCHECK(glGetQueryObjectui64vFn(queryID, name, &result));
+  return result;
+}
+
 void GLFunctions::glLineWidth(uint32_t value)
 {
   GLCHECK(::glLineWidth(static_cast<float>(value)));
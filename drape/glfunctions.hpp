@@ -103,6 +103,9 @@ public:
   /// value
   static void glVertexAttributePointer(int32_t attrLocation, uint32_t count, glConst type,
                                        bool needNormalize, uint32_t stride, uint32_t offset);
+  /// Attribute advances once per |divisor| instances, 0 means once per vertex.
+  /// Available only on OpenGL ES 3.
+  static void glVertexAttribDivisor(int32_t attrLocation, uint32_t divisor);
 
   static void glGetActiveUniform(uint32_t programID, uint32_t uniformIndex, int32_t * uniformSize,
                                  glConst * type, std::string & name);
@@ -140,6 +143,9 @@ public:
   // Draw support
   static void glDrawElements(glConst primitive, uint32_t sizeOfIndex, uint32_t indexCount,
                              uint32_t startIndex = 0);
+  /// Available only on OpenGL ES 3.
+  static void glDrawElementsInstanced(glConst primitive, uint32_t sizeOfIndex, uint32_t indexCount,
+                                      uint32_t instanceCount, uint32_t startIndex = 0);
   static void glDrawArrays(glConst mode, int32_t first, uint32_t count);
 
   // FBO support
@@ -148,6 +154,16 @@ public:
   static void glBindFramebuffer(uint32_t fbo);
   static void glFramebufferTexture2D(glConst attachment, glConst texture);
   static uint32_t glCheckFramebufferStatus();
+
+  // Queries support
+  static uint32_t glGenQuery();
+  static void glDeleteQuery(uint32_t queryID);
+  /// target = { gl_const::GLTimeElapsed }
+  static void glBeginQuery(glConst target, uint32_t queryID);
+  static void glEndQuery(glConst target);
+  /// name = { gl_const::GLQueryResult, gl_const::GLQueryResultAvailable }
+  static uint32_t glGetQueryObjectui(uint32_t queryID, glConst name);
+  static uint64_t glGetQueryObjectui64(uint32_t queryID, glConst name);
 };
 
 void CheckGLError(my::SrcPoint const & src);
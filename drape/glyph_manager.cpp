@@ -10,8 +10,11 @@
 #include "base/math.hpp"
 #include "base/timer.hpp"
 
+#include <algorithm>
+#include <cstring>
 #include <limits>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <sstream>
 
@@ -19,6 +22,7 @@
 #include FT_TYPES_H
 #include FT_SYSTEM_H
 #include FT_FREETYPE_H
+#include FT_OUTLINE_H
 #include FT_STROKER_H
 #include FT_CACHE_H
 
@@ -176,84 +180,72 @@ public:
 
   bool HasGlyph(strings::UniChar unicodePoint) const
   {
+    std::lock_guard<std::mutex> lock(m_faceMutex);
     return FT_Get_Char_Index(m_fontFace, unicodePoint) != 0;
   }
 
   GlyphManager::Glyph GetGlyph(strings::UniChar unicodePoint, uint32_t baseHeight, bool isSdf) const
   {
-    uint32_t glyphHeight = isSdf ? baseHeight * m_sdfScale : baseHeight;
+    std::lock_guard<std::mutex> lock(m_faceMutex);
+    LoadGlyph(unicodePoint, baseHeight, isSdf, true /* render */);
 
-    FREETYPE_CHECK(FT_Set_Pixel_Sizes(m_fontFace, glyphHeight, glyphHeight));
-    FREETYPE_CHECK(FT_Load_Glyph(m_fontFace, FT_Get_Char_Index(m_fontFace, unicodePoint), FT_LOAD_RENDER));
-
-    FT_Glyph glyph;
-    FREETYPE_CHECK(FT_Get_Glyph(m_fontFace->glyph, &glyph));
-
-    FT_BBox bbox;
-    FT_Glyph_Get_CBox(glyph, FT_GLYPH_BBOX_PIXELS , &bbox);
-
-    FT_Bitmap bitmap = m_fontFace->glyph->bitmap;
+    FT_Bitmap const & bitmap = m_fontFace->glyph->bitmap;
+    GlyphManager::Glyph result = CreateGlyph(unicodePoint, baseHeight, isSdf, bitmap.pitch,
+                                             bitmap.rows);
+    if (bitmap.buffer != nullptr)
+      result.m_image.m_data = CopyBitmap(bitmap, isSdf, result.m_image);
+    return result;
+  }
 
-    float const scale = isSdf ? 1.0f / m_sdfScale : 1.0f;
+  // Returns a glyph without an image, only sizes of the image are calculated.
+  // The image is rasterized by RasterizeGlyph() with the same sizes.
+  GlyphManager::Glyph GetGlyphMetrics(strings::UniChar unicodePoint, uint32_t baseHeight,
+                                      bool isSdf) const
+  {
+    std::lock_guard<std::mutex> lock(m_faceMutex);
+    LoadGlyph(unicodePoint, baseHeight, isSdf, false /* render */);
 
-    SharedBufferManager::shared_buffer_ptr_t data;
-    uint32_t imageWidth = bitmap.width;
-    uint32_t imageHeight = bitmap.rows;
-    if (bitmap.buffer != nullptr)
+    FT_GlyphSlot const slot = m_fontFace->glyph;
+    if (slot->format != FT_GLYPH_FORMAT_OUTLINE)
     {
-      if (isSdf)
-      {
-        sdf_image::SdfImage img(bitmap.rows, bitmap.pitch, bitmap.buffer, m_sdfScale * kSdfBorder);
-        imageWidth = img.GetWidth() * scale;
-        imageHeight = img.GetHeight() * scale;
+      // Bitmap glyphs are cheap to copy.
+      FREETYPE_CHECK(FT_Render_Glyph(slot, FT_RENDER_MODE_NORMAL));
+      GlyphManager::Glyph result = CreateGlyph(unicodePoint, baseHeight, isSdf,
+                                               slot->bitmap.pitch, slot->bitmap.rows);
+      if (slot->bitmap.buffer != nullptr)
+        result.m_image.m_data = CopyBitmap(slot->bitmap, isSdf, result.m_image);
+      return result;
+    }
 
-        size_t const bufferSize = bitmap.rows * bitmap.pitch;
-        data = SharedBufferManager::instance().reserveSharedBuffer(bufferSize);
-        memcpy(&(*data)[0], bitmap.buffer, bufferSize);
-      }
-      else
-      {
-        int const border = kSdfBorder;
-        imageHeight += 2 * border;
-        imageWidth += 2 * border;
+    // The same sizes of a bitmap are calculated by the smooth renderer of FreeType.
+    FT_BBox cbox;
+    FT_Outline_Get_CBox(&slot->outline, &cbox);
+    auto const pixFloor = [](FT_Pos x) { return x & ~static_cast<FT_Pos>(63); };
+    auto const pixCeil = [&pixFloor](FT_Pos x) { return pixFloor(x + 63); };
+    auto const width = static_cast<int>((pixCeil(cbox.xMax) - pixFloor(cbox.xMin)) >> 6);
+    auto const rows = static_cast<uint32_t>((pixCeil(cbox.yMax) - pixFloor(cbox.yMin)) >> 6);
+    return CreateGlyph(unicodePoint, baseHeight, isSdf, width, rows);
+  }
 
-        size_t const bufferSize = imageWidth * imageHeight;
-        data = SharedBufferManager::instance().reserveSharedBuffer(bufferSize);
-        memset(data->data(), 0, data->size());
+  SharedBufferManager::shared_buffer_ptr_t RasterizeGlyph(GlyphManager::Glyph const & glyph,
+                                                          uint32_t baseHeight) const
+  {
+    bool const isSdf = glyph.m_fixedSize < 0;
 
-        for (size_t row = border; row < bitmap.rows + border; ++row)
-        {
-          size_t const dstBaseIndex = row * imageWidth + border;
-          size_t const srcBaseIndex = (row - border) * bitmap.pitch;
-          for (int column = 0; column < bitmap.pitch; ++column)
-            data->data()[dstBaseIndex + column] = bitmap.buffer[srcBaseIndex + column];
-        }
-      }
-    }
+    std::lock_guard<std::mutex> lock(m_faceMutex);
+    LoadGlyph(glyph.m_code, baseHeight, isSdf, true /* render */);
 
-    GlyphManager::Glyph result;
-    result.m_image = GlyphManager::GlyphImage
-    {
-      imageWidth, imageHeight,
-      bitmap.rows, bitmap.pitch,
-      data
-    };
+    FT_Bitmap const & bitmap = m_fontFace->glyph->bitmap;
+    if (bitmap.buffer == nullptr)
+      return nullptr;
 
-    result.m_metrics = GlyphManager::GlyphMetrics
+    if (static_cast<uint32_t>(bitmap.rows) != glyph.m_image.m_bitmapRows ||
+        bitmap.pitch != glyph.m_image.m_bitmapPitch)
     {
-      static_cast<float>(glyph->advance.x >> 16) * scale,
-      static_cast<float>(glyph->advance.y >> 16) * scale,
-      static_cast<float>(bbox.xMin) * scale,
-      static_cast<float>(bbox.yMin) * scale,
-      true
-    };
-
-    result.m_code = unicodePoint;
-    result.m_fixedSize = isSdf ? GlyphManager::kDynamicGlyphSize
-                               : static_cast<int>(baseHeight);
-    FT_Done_Glyph(glyph);
-
-    return result;
+      LOG(LWARNING, ("Unexpected size of glyph", glyph.m_code, "rows =", bitmap.rows,
+                     "pitch =", bitmap.pitch));
+    }
+    return CopyBitmap(bitmap, isSdf, glyph.m_image);
   }
 
   GlyphManager::Glyph GenerateGlyph(GlyphManager::Glyph const & glyph) const
@@ -300,6 +292,7 @@ public:
 
   void GetCharcodes(vector<FT_ULong> & charcodes)
   {
+    std::lock_guard<std::mutex> lock(m_faceMutex);
     FT_UInt gindex;
     charcodes.push_back(FT_Get_First_Char(m_fontFace, &gindex));
     while (gindex)
@@ -333,10 +326,99 @@ public:
   }
 
 private:
+  // Must be called under the lock of the face.
+  void LoadGlyph(strings::UniChar unicodePoint, uint32_t baseHeight, bool isSdf, bool render) const
+  {
+    uint32_t const glyphHeight = isSdf ? baseHeight * m_sdfScale : baseHeight;
+    FREETYPE_CHECK(FT_Set_Pixel_Sizes(m_fontFace, glyphHeight, glyphHeight));
+    FREETYPE_CHECK(FT_Load_Glyph(m_fontFace, FT_Get_Char_Index(m_fontFace, unicodePoint),
+                                 render ? FT_LOAD_RENDER : FT_LOAD_DEFAULT));
+  }
+
+  // Fills metrics of the glyph which is loaded to the slot of the face and
+  // sizes of its image for a bitmap of |bitmapPitch| x |bitmapRows|.
+  GlyphManager::Glyph CreateGlyph(strings::UniChar unicodePoint, uint32_t baseHeight, bool isSdf,
+                                  int bitmapPitch, uint32_t bitmapRows) const
+  {
+    FT_Glyph glyph;
+    FREETYPE_CHECK(FT_Get_Glyph(m_fontFace->glyph, &glyph));
+
+    FT_BBox bbox;
+    FT_Glyph_Get_CBox(glyph, FT_GLYPH_BBOX_PIXELS , &bbox);
+
+    float const scale = isSdf ? 1.0f / m_sdfScale : 1.0f;
+
+    uint32_t imageWidth = static_cast<uint32_t>(bitmapPitch);
+    uint32_t imageHeight = bitmapRows;
+    if (bitmapPitch != 0 && bitmapRows != 0)
+    {
+      if (isSdf)
+      {
+        uint32_t const doubleBorder = 2 * m_sdfScale * kSdfBorder;
+        imageWidth = static_cast<uint32_t>((imageWidth + doubleBorder) * scale);
+        imageHeight = static_cast<uint32_t>((imageHeight + doubleBorder) * scale);
+      }
+      else
+      {
+        imageWidth += 2 * kSdfBorder;
+        imageHeight += 2 * kSdfBorder;
+      }
+    }
+
+    GlyphManager::Glyph result;
+    result.m_image = GlyphManager::GlyphImage
+    {
+      imageWidth, imageHeight,
+      bitmapRows, bitmapPitch,
+      nullptr
+    };
+
+    result.m_metrics = GlyphManager::GlyphMetrics
+    {
+      static_cast<float>(glyph->advance.x >> 16) * scale,
+      static_cast<float>(glyph->advance.y >> 16) * scale,
+      static_cast<float>(bbox.xMin) * scale,
+      static_cast<float>(bbox.yMin) * scale,
+      true
+    };
+
+    result.m_code = unicodePoint;
+    result.m_fixedSize = isSdf ? GlyphManager::kDynamicGlyphSize
+                               : static_cast<int>(baseHeight);
+    FT_Done_Glyph(glyph);
+
+    return result;
+  }
+
+  // Copies |bitmap| to a buffer of the layout which |image| expects. SDF glyphs
+  // keep the bitmap as is, the others get a border.
+  static SharedBufferManager::shared_buffer_ptr_t CopyBitmap(FT_Bitmap const & bitmap, bool isSdf,
+                                                             GlyphManager::GlyphImage const & image)
+  {
+    uint32_t const border = isSdf ? 0 : kSdfBorder;
+    uint32_t const dstWidth = isSdf ? static_cast<uint32_t>(image.m_bitmapPitch) : image.m_width;
+    uint32_t const dstHeight = isSdf ? image.m_bitmapRows : image.m_height;
+
+    size_t const bufferSize = dstWidth * dstHeight;
+    auto data = SharedBufferManager::instance().reserveSharedBuffer(bufferSize);
+    memset(data->data(), 0, data->size());
+
+    uint32_t const rows = std::min(static_cast<uint32_t>(bitmap.rows), image.m_bitmapRows);
+    uint32_t const columns = static_cast<uint32_t>(std::min(bitmap.pitch, image.m_bitmapPitch));
+    for (uint32_t row = 0; row < rows; ++row)
+    {
+      memcpy(data->data() + (row + border) * dstWidth + border,
+             bitmap.buffer + row * bitmap.pitch, columns);
+    }
+    return data;
+  }
+
   ReaderPtr<Reader> m_fontReader;
   FT_StreamRec_ m_stream;
   FT_Face m_fontFace;
   uint32_t m_sdfScale;
+  // FreeType faces can't be used on several threads simultaneously.
+  mutable std::mutex m_faceMutex;
 
   std::set<pair<strings::UniChar, int>> m_readyGlyphs;
 };
@@ -611,12 +693,38 @@ GlyphManager::Glyph GlyphManager::GetGlyph(strings::UniChar unicodePoint, int fi
   return glyph;
 }
 
+GlyphManager::Glyph GlyphManager::GetGlyphMetrics(strings::UniChar unicodePoint, int fixedHeight)
+{
+  int const fontIndex = GetFontIndex(unicodePoint);
+  if (fontIndex == kInvalidFont)
+    return GetInvalidGlyph(fixedHeight);
+
+  auto const & f = m_impl->m_fonts[fontIndex];
+  bool const isSdf = fixedHeight < 0;
+  Glyph glyph = f->GetGlyphMetrics(unicodePoint, isSdf ? m_impl->m_baseGlyphHeight : fixedHeight,
+                                   isSdf);
+  glyph.m_fontIndex = fontIndex;
+  return glyph;
+}
+
 GlyphManager::Glyph GlyphManager::GenerateGlyph(Glyph const & glyph) const
 {
   ASSERT_NOT_EQUAL(glyph.m_fontIndex, -1, ());
   ASSERT_LESS(glyph.m_fontIndex, static_cast<int>(m_impl->m_fonts.size()), ());
   auto const & f = m_impl->m_fonts[glyph.m_fontIndex];
-  return f->GenerateGlyph(glyph);
+
+  bool const needRasterize = glyph.m_image.m_data == nullptr &&
+                             glyph.m_image.m_bitmapRows != 0 && glyph.m_image.m_bitmapPitch != 0;
+  if (!needRasterize)
+    return f->GenerateGlyph(glyph);
+
+  bool const isSdf = glyph.m_fixedSize < 0;
+  Glyph rasterizedGlyph = glyph;
+  rasterizedGlyph.m_image.m_data = f->RasterizeGlyph(
+      glyph, isSdf ? m_impl->m_baseGlyphHeight : static_cast<uint32_t>(glyph.m_fixedSize));
+  Glyph result = f->GenerateGlyph(rasterizedGlyph);
+  rasterizedGlyph.m_image.Destroy();
+  return result;
 }
 
 void GlyphManager::ForEachUnicodeBlock(GlyphManager::TUniBlockCallback const & fn) const
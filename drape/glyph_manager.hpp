@@ -77,6 +77,11 @@ public:
   ~GlyphManager();
 
   Glyph GetGlyph(strings::UniChar unicodePoints, int fixedHeight);
+  // Returns the glyph without an image if it can be rasterized later,
+  // GenerateGlyph() rasterizes such glyphs. Images of glyphs of the same
+  // font are rasterized one by one, so GenerateGlyph() can be called on
+  // several threads.
+  Glyph GetGlyphMetrics(strings::UniChar unicodePoint, int fixedHeight);
   Glyph GenerateGlyph(Glyph const & glyph) const;
 
   void MarkGlyphReady(Glyph const & glyph);
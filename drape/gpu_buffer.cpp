@@ -1,7 +1,9 @@
 #include "drape/gpu_buffer.hpp"
 #include "drape/glextensions_list.hpp"
 #include "drape/glfunctions.hpp"
+#include "drape/gpu_buffer_pool.hpp"
 #include "drape/utils/gpu_mem_tracker.hpp"
+#include "drape/utils/render_counters.hpp"
 
 #include "base/assert.hpp"
 
@@ -29,7 +31,8 @@ glConst glTarget(GPUBuffer::Target t)
 }
 }  // namespace
 
-GPUBuffer::GPUBuffer(Target t, void const * data, uint8_t elementSize, uint32_t capacity)
+GPUBuffer::GPUBuffer(Target t, void const * data, uint8_t elementSize, uint32_t capacity,
+                     bool isPooled)
   : TBase(elementSize, capacity)
   , m_t(t)
   , m_mappingOffset(0)
@@ -37,11 +40,36 @@ GPUBuffer::GPUBuffer(Target t, void const * data, uint8_t elementSize, uint32_t
   , m_isMapped(false)
 #endif
 {
-  m_bufferID = GLFunctions::glGenBuffer();
+  if (isPooled)
+  {
+    auto const allocation = GPUBufferPool::Instance().Allocate(t, capacity * elementSize);
+    if (allocation.IsValid())
+    {
+      m_bufferID = allocation.m_bufferId;
+      m_byteOffset = allocation.m_offset;
+      m_pageId = allocation.m_pageId;
+      m_allocatedSize = allocation.m_size;
+    }
+  }
+
+  if (m_pageId == 0)
+    m_bufferID = GLFunctions::glGenBuffer();
   Resize(data, capacity);
 }
+
 GPUBuffer::~GPUBuffer()
 {
+  if (m_pageId != 0)
+  {
+    GPUBufferPool::Allocation allocation;
+    allocation.m_pageId = m_pageId;
+    allocation.m_bufferId = m_bufferID;
+    allocation.m_offset = m_byteOffset;
+    allocation.m_size = m_allocatedSize;
+    GPUBufferPool::Instance().Free(allocation);
+    return;
+  }
+
   GLFunctions::glBindBuffer(0, glTarget(m_t));
   GLFunctions::glDeleteBuffer(m_bufferID);
 
@@ -62,16 +90,19 @@ void GPUBuffer::UploadData(void const * data, uint32_t elementCount)
 
 #if defined(CHECK_VBO_BOUNDS)
   int32_t size = GLFunctions::glGetBufferParameter(glTarget(m_t), gl_const::GLBufferSize);
-  ASSERT_EQUAL(GetCapacity() * elementSize, size, ());
-  ASSERT_LESS_OR_EQUAL((elementCount + currentSize) * elementSize, size, ());
+  if (m_pageId == 0)
+    ASSERT_EQUAL(GetCapacity() * elementSize, size, ());
+  ASSERT_LESS_OR_EQUAL(m_byteOffset + (elementCount + currentSize) * elementSize, size, ());
 #endif
 
   GLFunctions::glBufferSubData(glTarget(m_t), elementCount * elementSize, data,
-                               currentSize * elementSize);
+                               m_byteOffset + currentSize * elementSize);
   TBase::UploadData(elementCount);
+  RenderCounters::Instance().AddUploadedBytes(elementCount * elementSize);
 
 #if defined(TRACK_GPU_MEM)
-  dp::GPUMemTracker::Inst().SetUsed("VBO", m_bufferID, (currentSize + elementCount) * elementSize);
+  if (m_pageId == 0)
+    dp::GPUMemTracker::Inst().SetUsed("VBO", m_bufferID, (currentSize + elementCount) * elementSize);
 #endif
 }
 
@@ -83,6 +114,8 @@ void * GPUBuffer::Map(uint32_t elementOffset, uint32_t elementCount)
   ASSERT(!m_isMapped, ());
   m_isMapped = true;
 #endif
+  // Mapping of a page would stall on buffers which are being rendered.
+  ASSERT_EQUAL(m_pageId, 0, ("Pooled buffers can't be mapped."));
 
   if (GLFunctions::CurrentApiVersion == dp::ApiVersion::OpenGLES2)
   {
@@ -134,6 +167,7 @@ void GPUBuffer::UpdateData(void * gpuPtr, void const * data, uint32_t elementOff
     else
       GLFunctions::glBufferSubData(glTarget(m_t), byteCount, data, byteOffset);
   }
+  RenderCounters::Instance().AddUploadedBytes(byteCount);
 }
 
 void GPUBuffer::Unmap()
@@ -152,12 +186,30 @@ void GPUBuffer::Resize(void const * data, uint32_t elementCount)
 {
   TBase::Resize(elementCount);
   Bind();
+
+  if (m_pageId != 0)
+  {
+    // Capacity of sub-allocated buffers can't be changed.
+    ASSERT_LESS_OR_EQUAL(GetCapacity() * GetElementSize(), m_allocatedSize, ());
+    if (data != nullptr)
+    {
+      GLFunctions::glBufferSubData(glTarget(m_t), elementCount * GetElementSize(), data,
+                                   m_byteOffset);
+      SetDataSize(elementCount);
+      RenderCounters::Instance().AddUploadedBytes(elementCount * GetElementSize());
+    }
+    return;
+  }
+
   GLFunctions::glBufferData(glTarget(m_t), GetCapacity() * GetElementSize(), data,
                             gl_const::GLDynamicDraw);
 
   // If we have set up data already (in glBufferData), we have to call SetDataSize.
   if (data != nullptr)
+  {
     SetDataSize(elementCount);
+    RenderCounters::Instance().AddUploadedBytes(elementCount * GetElementSize());
+  }
 
 #if defined(TRACK_GPU_MEM)
   dp::GPUMemTracker & memTracker = dp::GPUMemTracker::Inst();
@@ -3,6 +3,8 @@
 #include "drape/buffer_base.hpp"
 #include "drape/pointers.hpp"
 
+#include <cstdint>
+
 namespace dp
 {
 class GPUBuffer : public BufferBase
@@ -17,12 +19,18 @@ public:
   };
 
 public:
-  GPUBuffer(Target t, void const * data, uint8_t elementSize, uint32_t capacity);
+  // Pooled buffers are sub-allocated from pages of GPUBufferPool if it's enabled.
+  // They can't be mapped.
+  GPUBuffer(Target t, void const * data, uint8_t elementSize, uint32_t capacity,
+            bool isPooled = false);
   ~GPUBuffer();
 
   void UploadData(void const * data, uint32_t elementCount);
   void Bind();
 
+  // Offset of the buffer in the GL object, it isn't 0 for sub-allocated buffers.
+  uint32_t GetByteOffset() const { return m_byteOffset; }
+
   void * Map(uint32_t elementOffset, uint32_t elementCount);
   void UpdateData(void * gpuPtr, void const * data, uint32_t elementOffset, uint32_t elementCount);
   void Unmap();
@@ -36,6 +44,10 @@ private:
   Target m_t;
   uint32_t m_bufferID;
   uint32_t m_mappingOffset;
+  uint32_t m_byteOffset = 0;
+  // Identifier of the page of GPUBufferPool, 0 if the buffer has own GL object.
+  uint64_t m_pageId = 0;
+  uint32_t m_allocatedSize = 0;
 
 #ifdef DEBUG
   bool m_isMapped;
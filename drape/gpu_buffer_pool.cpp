@@ -0,0 +1,290 @@
+#include "drape/gpu_buffer_pool.hpp"
+#include "drape/glfunctions.hpp"
+#include "drape/utils/gpu_mem_tracker.hpp"
+
+#include "base/assert.hpp"
+
+#include <iterator>
+#include <sstream>
+
+namespace dp
+{
+namespace
+{
+// Offsets are aligned, so attributes and indices of any type can start there.
+uint32_t const kAlignment = 16;
+uint32_t const kMaxEmptyPagesCount = 1;
+
+uint32_t AlignSize(uint32_t size) { return (size + kAlignment - 1) / kAlignment * kAlignment; }
+
+glConst glTarget(GPUBuffer::Target t)
+{
+  if (t == GPUBuffer::ElementBuffer)
+    return gl_const::GLArrayBuffer;
+
+  return gl_const::GLElementArrayBuffer;
+}
+}  // namespace
+
+uint32_t const GPUBufferPool::kPageSize = 1024 * 1024;
+uint32_t const GPUBufferPool::kMaxAllocationSize = GPUBufferPool::kPageSize / 4;
+
+std::string GPUBufferPool::Statistic::ToString() const
+{
+  std::ostringstream ss;
+  ss << " ----- GPU buffer pool ----- \n";
+  ss << " Pages = " << m_pagesCount << "\n";
+  ss << " Allocations = " << m_allocationsCount << "\n";
+  ss << " Free ranges = " << m_freeRangesCount << "\n";
+  ss << " Allocated = " << m_allocatedBytes << " bytes\n";
+  ss << " Used = " << m_usedBytes << " bytes\n";
+  return ss.str();
+}
+
+// static
+GPUBufferPool & GPUBufferPool::Instance()
+{
+  static GPUBufferPool pool;
+  return pool;
+}
+
+void GPUBufferPool::SetEnabled(bool enabled)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_isEnabled = enabled;
+}
+
+bool GPUBufferPool::IsEnabled() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_isEnabled;
+}
+
+GPUBufferPool::Allocation GPUBufferPool::Allocate(GPUBuffer::Target target, uint32_t size)
+{
+  Allocation result;
+  if (size == 0 || size > kMaxAllocationSize)
+    return result;
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (!m_isEnabled)
+    return result;
+
+  uint32_t const alignedSize = AlignSize(size);
+
+  // The fullest page is taken to leave other pages a chance to become empty.
+  auto bestIt = m_pages.end();
+  for (auto it = m_pages.begin(); it != m_pages.end(); ++it)
+  {
+    Page const & page = it->second;
+    if (page.m_isObsolete || page.m_target != target || page.m_freeSize < alignedSize)
+      continue;
+    if (bestIt == m_pages.end() || page.m_freeSize < bestIt->second.m_freeSize)
+      bestIt = it;
+  }
+
+  uint32_t offset = 0;
+  // Free space of the page can be fragmented, the next pages are checked then.
+  if (bestIt != m_pages.end() && AllocateInPage(bestIt->second, alignedSize, offset))
+  {
+    result.m_pageId = bestIt->first;
+    result.m_bufferId = bestIt->second.m_bufferId;
+  }
+  else
+  {
+    bool found = false;
+    for (auto it = m_pages.begin(); it != m_pages.end() && !found; ++it)
+    {
+      Page & page = it->second;
+      if (it == bestIt || page.m_isObsolete || page.m_target != target ||
+          page.m_freeSize < alignedSize)
+      {
+        continue;
+      }
+      if (AllocateInPage(page, alignedSize, offset))
+      {
+        result.m_pageId = it->first;
+        result.m_bufferId = page.m_bufferId;
+        found = true;
+      }
+    }
+
+    if (!found)
+    {
+      Page & page = CreatePage(target, result.m_pageId);
+      VERIFY(AllocateInPage(page, alignedSize, offset), ());
+      result.m_bufferId = page.m_bufferId;
+    }
+  }
+
+  result.m_offset = offset;
+  result.m_size = alignedSize;
+
+#if defined(TRACK_GPU_MEM)
+  Page const & page = m_pages[result.m_pageId];
+  dp::GPUMemTracker::Inst().SetUsed("VBOPage", page.m_bufferId, kPageSize - page.m_freeSize);
+#endif
+  return result;
+}
+
+void GPUBufferPool::Free(Allocation const & allocation)
+{
+  ASSERT(allocation.IsValid(), ());
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto const it = m_pages.find(allocation.m_pageId);
+  ASSERT(it != m_pages.end(), ());
+  if (it == m_pages.end())
+    return;
+
+  Page & page = it->second;
+  FreeInPage(page, allocation.m_offset, allocation.m_size);
+  if (page.m_allocationsCount != 0)
+  {
+#if defined(TRACK_GPU_MEM)
+    dp::GPUMemTracker::Inst().SetUsed("VBOPage", page.m_bufferId, kPageSize - page.m_freeSize);
+#endif
+    return;
+  }
+
+  if (page.m_isObsolete)
+  {
+    // The GL object has been destroyed with its context.
+    m_pages.erase(it);
+    return;
+  }
+
+  uint32_t emptyPagesCount = 0;
+  for (auto const & p : m_pages)
+  {
+    if (!p.second.m_isObsolete && p.second.m_target == page.m_target &&
+        p.second.m_allocationsCount == 0)
+    {
+      ++emptyPagesCount;
+    }
+  }
+
+  if (emptyPagesCount > kMaxEmptyPagesCount)
+    DeletePage(it);
+}
+
+void GPUBufferPool::ReleaseGpuResources()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  for (auto it = m_pages.begin(); it != m_pages.end();)
+  {
+    if (it->second.m_allocationsCount == 0)
+    {
+      if (!it->second.m_isObsolete)
+        DeletePage(it++);
+      else
+        it = m_pages.erase(it);
+    }
+    else
+    {
+      it->second.m_isObsolete = true;
+      ++it;
+    }
+  }
+}
+
+GPUBufferPool::Statistic GPUBufferPool::GetStatistic() const
+{
+  Statistic result;
+  std::lock_guard<std::mutex> lock(m_mutex);
+  for (auto const & p : m_pages)
+  {
+    Page const & page = p.second;
+    ++result.m_pagesCount;
+    result.m_allocationsCount += page.m_allocationsCount;
+    result.m_freeRangesCount += static_cast<uint32_t>(page.m_freeRanges.size());
+    result.m_allocatedBytes += kPageSize;
+    result.m_usedBytes += kPageSize - page.m_freeSize;
+  }
+  return result;
+}
+
+// static
+bool GPUBufferPool::AllocateInPage(Page & page, uint32_t size, uint32_t & offset)
+{
+  // Best fit keeps big ranges for big buffers.
+  auto bestIt = page.m_freeRanges.end();
+  for (auto it = page.m_freeRanges.begin(); it != page.m_freeRanges.end(); ++it)
+  {
+    if (it->second >= size && (bestIt == page.m_freeRanges.end() || it->second < bestIt->second))
+      bestIt = it;
+  }
+
+  if (bestIt == page.m_freeRanges.end())
+    return false;
+
+  offset = bestIt->first;
+  uint32_t const rest = bestIt->second - size;
+  page.m_freeRanges.erase(bestIt);
+  if (rest != 0)
+    page.m_freeRanges.emplace(offset + size, rest);
+
+  page.m_freeSize -= size;
+  ++page.m_allocationsCount;
+  return true;
+}
+
+// static
+void GPUBufferPool::FreeInPage(Page & page, uint32_t offset, uint32_t size)
+{
+  ASSERT_GREATER(page.m_allocationsCount, 0, ());
+  --page.m_allocationsCount;
+  page.m_freeSize += size;
+
+  // Neighbouring free ranges are merged.
+  auto next = page.m_freeRanges.lower_bound(offset);
+  ASSERT(next == page.m_freeRanges.end() || next->first >= offset + size, ());
+  if (next != page.m_freeRanges.end() && next->first == offset + size)
+  {
+    size += next->second;
+    next = page.m_freeRanges.erase(next);
+  }
+
+  if (next != page.m_freeRanges.begin())
+  {
+    auto prev = std::prev(next);
+    ASSERT_LESS_OR_EQUAL(prev->first + prev->second, offset, ());
+    if (prev->first + prev->second == offset)
+    {
+      prev->second += size;
+      return;
+    }
+  }
+  page.m_freeRanges.emplace_hint(next, offset, size);
+}
+
+GPUBufferPool::Page & GPUBufferPool::CreatePage(GPUBuffer::Target target, uint64_t & pageId)
+{
+  pageId = m_nextPageId++;
+  Page & page = m_pages[pageId];
+  page.m_target = target;
+  page.m_bufferId = GLFunctions::glGenBuffer();
+  page.m_freeRanges.emplace(0, kPageSize);
+  page.m_freeSize = kPageSize;
+
+  GLFunctions::glBindBuffer(page.m_bufferId, glTarget(target));
+  GLFunctions::glBufferData(glTarget(target), kPageSize, nullptr, gl_const::GLDynamicDraw);
+
+#if defined(TRACK_GPU_MEM)
+  dp::GPUMemTracker::Inst().AddAllocated("VBOPage", page.m_bufferId, kPageSize);
+#endif
+  return page;
+}
+
+void GPUBufferPool::DeletePage(std::map<uint64_t, Page>::iterator it)
+{
+  Page const & page = it->second;
+  GLFunctions::glBindBuffer(0, glTarget(page.m_target));
+  GLFunctions::glDeleteBuffer(page.m_bufferId);
+
+#if defined(TRACK_GPU_MEM)
+  dp::GPUMemTracker::Inst().RemoveDeallocated("VBOPage", page.m_bufferId);
+#endif
+  m_pages.erase(it);
+}
+}  // namespace dp
@@ -0,0 +1,96 @@
+#pragma once
+
+#include "drape/gpu_buffer.hpp"
+
+#include "base/macros.hpp"
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+
+namespace dp
+{
+// Pool of large GPU buffers (pages), small buffers are sub-allocated from
+// them. It saves creation and deletion of thousands of GL objects when
+// tiles come and go. Free ranges of a page are merged, and new buffers are
+// put into the fullest pages which they fit, so sparse pages become empty
+// and get released. An empty page is kept for reuse while the buffers of
+// evicted tiles are replaced by new ones.
+//
+// The pool is thread-safe. It's disabled by default, then buffers get own
+// GL objects.
+class GPUBufferPool
+{
+public:
+  struct Allocation
+  {
+    bool IsValid() const { return m_bufferId != 0; }
+
+    uint64_t m_pageId = 0;
+    uint32_t m_bufferId = 0;
+    uint32_t m_offset = 0;
+    uint32_t m_size = 0;
+  };
+
+  struct Statistic
+  {
+    std::string ToString() const;
+
+    uint32_t m_pagesCount = 0;
+    uint32_t m_allocationsCount = 0;
+    // Count of free ranges, it's a measure of fragmentation.
+    uint32_t m_freeRangesCount = 0;
+    uint64_t m_allocatedBytes = 0;
+    uint64_t m_usedBytes = 0;
+  };
+
+  static uint32_t const kPageSize;
+  // Bigger buffers get own GL objects.
+  static uint32_t const kMaxAllocationSize;
+
+  static GPUBufferPool & Instance();
+
+  void SetEnabled(bool enabled);
+  bool IsEnabled() const;
+
+  // Returns an invalid allocation if the pool is disabled or |size| is too big.
+  // The page of the allocation is bound to the target.
+  Allocation Allocate(GPUBuffer::Target target, uint32_t size);
+  void Free(Allocation const & allocation);
+
+  // Must be called before destruction of the context. Empty pages are deleted,
+  // the others are forgotten when their buffers are freed.
+  void ReleaseGpuResources();
+
+  Statistic GetStatistic() const;
+
+private:
+  struct Page
+  {
+    GPUBuffer::Target m_target;
+    uint32_t m_bufferId = 0;
+    // Offsets and sizes of free ranges.
+    std::map<uint32_t, uint32_t> m_freeRanges;
+    uint32_t m_freeSize = 0;
+    uint32_t m_allocationsCount = 0;
+    // Pages of a destroyed context can't be used anymore.
+    bool m_isObsolete = false;
+  };
+
+  GPUBufferPool() = default;
+
+  static bool AllocateInPage(Page & page, uint32_t size, uint32_t & offset);
+  static void FreeInPage(Page & page, uint32_t offset, uint32_t size);
+
+  Page & CreatePage(GPUBuffer::Target target, uint64_t & pageId);
+  void DeletePage(std::map<uint64_t, Page>::iterator it);
+
+  bool m_isEnabled = false;
+  uint64_t m_nextPageId = 1;
+  std::map<uint64_t, Page> m_pages;
+  mutable std::mutex m_mutex;
+
+  DISALLOW_COPY_AND_MOVE(GPUBufferPool);
+};
+}  // namespace dp
@@ -0,0 +1,113 @@
+#include "drape/object_pool.hpp"
+
+#include <new>
+
+namespace dp
+{
+size_t constexpr ObjectAllocator::kGranularity;
+size_t constexpr ObjectAllocator::kMaxBlockSize;
+size_t constexpr ObjectAllocator::kBlocksPerChunk;
+size_t constexpr ObjectAllocator::kClassesCount;
+
+// static
+ObjectAllocator & ObjectAllocator::Instance()
+{
+  static ObjectAllocator * allocator = new ObjectAllocator();
+  return *allocator;
+}
+
+ObjectAllocator::~ObjectAllocator()
+{
+  for (auto & sizeClass : m_classes)
+  {
+    for (void * chunk : sizeClass.m_chunks)
+      ::operator delete(chunk);
+  }
+}
+
+void * ObjectAllocator::Allocate(size_t size)
+{
+  if (size == 0 || size > kMaxBlockSize)
+  {
+    {
+      std::lock_guard<std::mutex> lock(m_largeMutex);
+      ++m_largeStats.m_allocations;
+      ++m_largeStats.m_heapAllocations;
+    }
+    return ::operator new(size);
+  }
+
+  size_t const classIndex = (size - 1) / kGranularity;
+  SizeClass & sizeClass = m_classes[classIndex];
+  std::lock_guard<std::mutex> lock(sizeClass.m_mutex);
+  ++sizeClass.m_stats.m_allocations;
+
+  if (sizeClass.m_free == nullptr)
+  {
+    // Chunks are aligned for any type and block sizes are multiples of kGranularity,
+    // so all blocks are aligned too.
+    size_t const blockSize = (classIndex + 1) * kGranularity;
+    size_t const chunkSize = blockSize * kBlocksPerChunk;
+    char * chunk = static_cast<char *>(::operator new(chunkSize));
+    sizeClass.m_chunks.push_back(chunk);
+    ++sizeClass.m_stats.m_heapAllocations;
+    sizeClass.m_stats.m_reservedBytes += chunkSize;
+
+    for (size_t i = kBlocksPerChunk; i > 0; --i)
+    {
+      FreeBlock * block = reinterpret_cast<FreeBlock *>(chunk + (i - 1) * blockSize);
+      block->m_next = sizeClass.m_free;
+      sizeClass.m_free = block;
+    }
+  }
+
+  FreeBlock * block = sizeClass.m_free;
+  sizeClass.m_free = block->m_next;
+  return block;
+}
+
+void ObjectAllocator::Deallocate(void * p, size_t size)
+{
+  if (p == nullptr)
+    return;
+
+  if (size == 0 || size > kMaxBlockSize)
+  {
+    {
+      std::lock_guard<std::mutex> lock(m_largeMutex);
+      ++m_largeStats.m_deallocations;
+    }
+    ::operator delete(p);
+    return;
+  }
+
+  SizeClass & sizeClass = m_classes[(size - 1) / kGranularity];
+  FreeBlock * block = static_cast<FreeBlock *>(p);
+  std::lock_guard<std::mutex> lock(sizeClass.m_mutex);
+  ++sizeClass.m_stats.m_deallocations;
+  block->m_next = sizeClass.m_free;
+  sizeClass.m_free = block;
+}
+
+ObjectAllocator::Stats ObjectAllocator::GetStats() const
+{
+  Stats result;
+  auto const add = [&result](Stats const & stats)
+  {
+    result.m_allocations += stats.m_allocations;
+    result.m_deallocations += stats.m_deallocations;
+    result.m_heapAllocations += stats.m_heapAllocations;
+    result.m_reservedBytes += stats.m_reservedBytes;
+  };
+
+  for (auto const & sizeClass : m_classes)
+  {
+    std::lock_guard<std::mutex> lock(sizeClass.m_mutex);
+    add(sizeClass.m_stats);
+  }
+
+  std::lock_guard<std::mutex> lock(m_largeMutex);
+  add(m_largeStats);
+  return result;
+}
+}  // namespace dp
@@ -3,10 +3,14 @@
 #include "base/assert.hpp"
 #include "base/logging.hpp"
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
 #include <list>
 #include <mutex>
 #include <set>
 #include <string>
+#include <vector>
 
 #define LOG_OBJECT_POOL
 
@@ -85,5 +89,74 @@ private:
   Factory m_factory;
   std::mutex m_lock;
 };
+
+// Allocator of small objects by size classes. Freed blocks go to free lists of their size classes
+// and are reused, so objects which are created and destroyed for every tile don't go to the heap
+// in the steady state. Blocks are taken from the heap by chunks and are never returned to it.
+// Objects are often created and destroyed on different threads, so every size class has its
+// own lock.
+//
+// *NOTE* This class is thread-safe.
+class ObjectAllocator final
+{
+public:
+  struct Stats
+  {
+    uint64_t m_allocations = 0;
+    uint64_t m_deallocations = 0;
+    // Allocations of chunks and of objects which are too large for size classes.
+    uint64_t m_heapAllocations = 0;
+    size_t m_reservedBytes = 0;
+  };
+
+  static size_t constexpr kGranularity = 16;
+  static size_t constexpr kMaxBlockSize = 512;
+  static size_t constexpr kBlocksPerChunk = 64;
+
+  // The allocator is never destroyed, as objects may be deleted by destructors of statics.
+  static ObjectAllocator & Instance();
+
+  ObjectAllocator() = default;
+  ~ObjectAllocator();
+
+  void * Allocate(size_t size);
+  void Deallocate(void * p, size_t size);
+
+  Stats GetStats() const;
+
+private:
+  static size_t constexpr kClassesCount = kMaxBlockSize / kGranularity;
+
+  struct FreeBlock
+  {
+    FreeBlock * m_next;
+  };
+
+  struct SizeClass
+  {
+    mutable std::mutex m_mutex;
+    FreeBlock * m_free = nullptr;
+    std::vector<void *> m_chunks;
+    Stats m_stats;
+  };
+
+  std::array<SizeClass, kClassesCount> m_classes;
+
+  mutable std::mutex m_largeMutex;
+  Stats m_largeStats;
+};
+
+// Objects of classes derived from PooledObject are allocated by ObjectAllocator. Derived classes
+// with virtual destructors are deallocated by sizes of their dynamic types, so whole
+// hierarchies may be pooled by their base classes.
+class PooledObject
+{
+public:
+  static void * operator new(size_t size) { return ObjectAllocator::Instance().Allocate(size); }
+  static void operator delete(void * p, size_t size)
+  {
+    ObjectAllocator::Instance().Deallocate(p, size);
+  }
+};
 }  // namespace dp
 
@@ -0,0 +1,139 @@
+#include "drape/overlay_grid.hpp"
+
+#include "base/assert.hpp"
+#include "base/math.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace dp
+{
+namespace
+{
+uint32_t const kMaxCellsPerSide = 128;
+
+uint32_t GetCellsCountPerSide(double length, double cellSize)
+{
+  if (length <= 0.0)
+    return 1;
+  auto const count = static_cast<uint32_t>(std::ceil(length / cellSize));
+  return my::clamp(count, 1u, kMaxCellsPerSide);
+}
+}  // namespace
+
+OverlayGrid::OverlayGrid(double cellSize) : m_minCellSize(cellSize)
+{
+  ASSERT_GREATER(m_minCellSize, 0.0, ());
+}
+
+void OverlayGrid::Reset(m2::RectD const & rect)
+{
+  Clear();
+
+  m_rect = rect;
+  m_width = GetCellsCountPerSide(rect.SizeX(), m_minCellSize);
+  m_height = GetCellsCountPerSide(rect.SizeY(), m_minCellSize);
+  m_cellSizeX = std::max(rect.SizeX() / m_width, m_minCellSize);
+  m_cellSizeY = std::max(rect.SizeY() / m_height, m_minCellSize);
+
+  // Lists of cells keep their capacity when the grid keeps its size.
+  m_cells.resize(static_cast<size_t>(m_width) * m_height);
+}
+
+void OverlayGrid::Clear()
+{
+  for (auto & cell : m_cells)
+    cell.clear();
+  m_entries.clear();
+  m_freeEntries.clear();
+  m_index.clear();
+}
+
+void OverlayGrid::Add(ref_ptr<OverlayHandle> handle, m2::RectD const & rect)
+{
+  ASSERT(m_index.find(handle) == m_index.end(), ());
+
+  uint32_t entryIndex;
+  if (m_freeEntries.empty())
+  {
+    entryIndex = static_cast<uint32_t>(m_entries.size());
+    m_entries.emplace_back();
+  }
+  else
+  {
+    entryIndex = m_freeEntries.back();
+    m_freeEntries.pop_back();
+  }
+
+  Entry & entry = m_entries[entryIndex];
+  entry.m_handle = handle;
+  entry.m_rect = rect;
+  entry.m_queryIndex = 0;
+  m_index.emplace(handle, entryIndex);
+
+  ForEachCell(rect, [this, entryIndex](size_t cellIndex)
+  {
+    m_cells[cellIndex].push_back(entryIndex);
+  });
+}
+
+void OverlayGrid::Erase(ref_ptr<OverlayHandle> handle)
+{
+  auto const it = m_index.find(handle);
+  if (it == m_index.end())
+    return;
+
+  uint32_t const entryIndex = it->second;
+  m_index.erase(it);
+
+  Entry & entry = m_entries[entryIndex];
+  ForEachCell(entry.m_rect, [this, entryIndex](size_t cellIndex)
+  {
+    auto & cell = m_cells[cellIndex];
+    auto const cellIt = std::find(cell.begin(), cell.end(), entryIndex);
+    ASSERT(cellIt != cell.end(), ());
+    if (cellIt != cell.end())
+    {
+      *cellIt = cell.back();
+      cell.pop_back();
+    }
+  });
+
+  entry.m_handle = nullptr;
+  m_freeEntries.push_back(entryIndex);
+}
+
+void OverlayGrid::GetCellsRange(m2::RectD const & rect, uint32_t & minX, uint32_t & minY,
+                                uint32_t & maxX, uint32_t & maxY) const
+{
+  minX = GetCellX(rect.minX());
+  maxX = GetCellX(rect.maxX());
+  minY = GetCellY(rect.minY());
+  maxY = GetCellY(rect.maxY());
+}
+
+uint32_t OverlayGrid::GetCellX(double x) const
+{
+  double const cell = std::floor((x - m_rect.minX()) / m_cellSizeX);
+  return static_cast<uint32_t>(my::clamp(cell, 0.0, static_cast<double>(m_width - 1)));
+}
+
+uint32_t OverlayGrid::GetCellY(double y) const
+{
+  double const cell = std::floor((y - m_rect.minY()) / m_cellSizeY);
+  return static_cast<uint32_t>(my::clamp(cell, 0.0, static_cast<double>(m_height - 1)));
+}
+
+uint32_t OverlayGrid::NextQueryIndex() const
+{
+  // Zero is never used as an index of a query, so marks must be reset
+  // when indices come around.
+  if (++m_queryIndex == 0)
+  {
+    for (auto const & entry : m_entries)
+      entry.m_queryIndex = 0;
+    m_queryIndex = 1;
+  }
+  return m_queryIndex;
+}
+}  // namespace dp
@@ -0,0 +1,118 @@
+#pragma once
+
+#include "drape/overlay_handle.hpp"
+#include "drape/pointers.hpp"
+
+#include "geometry/rect2d.hpp"
+
+#include "base/macros.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+namespace dp
+{
+namespace detail
+{
+struct OverlayHasher
+{
+  std::hash<OverlayHandle *> m_hasher;
+
+  size_t operator()(ref_ptr<OverlayHandle> const & handle) const
+  {
+    return m_hasher(handle.get());
+  }
+};
+}  // namespace detail
+
+// Uniform grid of screen cells, which is used to find overlay handles
+// which pixel rects intersect a rect. Unlike a kd-tree it's cheap to
+// rebuild every frame, and insertion and removal don't depend on the
+// count of handles. Handles out of the grid rect get into border cells.
+class OverlayGrid
+{
+public:
+  // Cells are enlarged if |cellSize| gives too many of them.
+  explicit OverlayGrid(double cellSize);
+
+  // Removes all handles and covers |rect| with cells.
+  void Reset(m2::RectD const & rect);
+  // Removes all handles, cells stay the same.
+  void Clear();
+
+  // A handle can be added only once until it's erased.
+  void Add(ref_ptr<OverlayHandle> handle, m2::RectD const & rect);
+  void Erase(ref_ptr<OverlayHandle> handle);
+
+  size_t GetSize() const { return m_index.size(); }
+  size_t GetCellsCount() const { return m_cells.size(); }
+
+  // Calls |toDo| once for every handle which rect intersects |rect|.
+  template <typename ToDo>
+  void ForEachInRect(m2::RectD const & rect, ToDo && toDo) const
+  {
+    uint32_t const queryIndex = NextQueryIndex();
+    ForEachCell(rect, [&](size_t cellIndex)
+    {
+      for (auto const entryIndex : m_cells[cellIndex])
+      {
+        Entry const & entry = m_entries[entryIndex];
+        if (entry.m_queryIndex == queryIndex)
+          continue;
+        entry.m_queryIndex = queryIndex;
+        if (entry.m_rect.IsIntersect(rect))
+          toDo(entry.m_handle);
+      }
+    });
+  }
+
+  // Calls |toDo| with indices of cells which |rect| covers.
+  template <typename ToDo>
+  void ForEachCell(m2::RectD const & rect, ToDo && toDo) const
+  {
+    if (m_cells.empty())
+      return;
+
+    uint32_t minX, minY, maxX, maxY;
+    GetCellsRange(rect, minX, minY, maxX, maxY);
+    for (uint32_t y = minY; y <= maxY; ++y)
+    {
+      for (uint32_t x = minX; x <= maxX; ++x)
+        toDo(static_cast<size_t>(y) * m_width + x);
+    }
+  }
+
+private:
+  struct Entry
+  {
+    ref_ptr<OverlayHandle> m_handle;
+    m2::RectD m_rect;
+    mutable uint32_t m_queryIndex = 0;
+  };
+
+  void GetCellsRange(m2::RectD const & rect, uint32_t & minX, uint32_t & minY, uint32_t & maxX,
+                     uint32_t & maxY) const;
+  uint32_t GetCellX(double x) const;
+  uint32_t GetCellY(double y) const;
+  uint32_t NextQueryIndex() const;
+
+  double const m_minCellSize;
+  m2::RectD m_rect;
+  double m_cellSizeX = 1.0;
+  double m_cellSizeY = 1.0;
+  uint32_t m_width = 0;
+  uint32_t m_height = 0;
+
+  // Cells contain indices of entries.
+  std::vector<std::vector<uint32_t>> m_cells;
+  std::vector<Entry> m_entries;
+  std::vector<uint32_t> m_freeEntries;
+  std::unordered_map<ref_ptr<OverlayHandle>, uint32_t, detail::OverlayHasher> m_index;
+
+  mutable uint32_t m_queryIndex = 0;
+
+  DISALLOW_COPY_AND_MOVE(OverlayGrid);
+};
+}  // namespace dp
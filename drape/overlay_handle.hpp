@@ -5,6 +5,7 @@
 #include "drape/binding_info.hpp"
 #include "drape/index_buffer_mutator.hpp"
 #include "drape/index_storage.hpp"
+#include "drape/object_pool.hpp"
 #include "drape/attribute_buffer_mutator.hpp"
 
 #include "indexer/feature_decl.hpp"
@@ -86,7 +87,8 @@ struct OverlayID
   }
 };
 
-class OverlayHandle
+// Handles are created for every overlay of every tile, so they are pooled.
+class OverlayHandle : public PooledObject
 {
 public:
   using Rects = std::vector<m2::RectF>;
@@ -3,7 +3,11 @@
 #include "drape/constants.hpp"
 #include "drape/debug_rect_renderer.hpp"
 
+#include "base/math.hpp"
+
 #include <algorithm>
+#include <cmath>
+#include <set>
 
 namespace dp
 {
@@ -16,8 +20,42 @@ uint32_t const kMaxHandlesCount = 1000;
 size_t const kAverageHandlesCount[dp::OverlayRanksCount] = { 300, 200, 50 };
 int const kInvalidFrame = -1;
 
+// Size of cells of the grid in pixels, it's multiplied by visual scale.
+double const kGridCellSize = 64.0;
+
+// Handles which moved relative to the map by less than this count of
+// pixels (multiplied by visual scale) keep their visibility.
+double const kMovementThreshold = 0.5;
+// If a greater part of handles must be placed again, all of them are placed.
+double const kMaxDirtyHandlesRatio = 0.25;
+// Mistakes of incremental placing (e.g. a handle which stays hidden when
+// its displacer was displaced by another one) are fixed periodically.
+uint32_t const kMaxIncrementalPlacingsCount = 8;
+
 namespace
 {
+// Returns false if |to| differs from |from| by something but panning.
+bool GetPixelShift(ScreenBase const & from, ScreenBase const & to, m2::PointD & shift)
+{
+  double const kEps = 1e-7;
+  if (from.isPerspective() || to.isPerspective() || from.PixelRect() != to.PixelRect() ||
+      !my::AlmostEqualRel(from.GetScale(), to.GetScale(), kEps) ||
+      !my::AlmostEqualAbs(from.GetAngle(), to.GetAngle(), kEps))
+  {
+    return false;
+  }
+
+  m2::PointD const pt = from.GetOrg();
+  shift = to.GtoP(pt) - from.GtoP(pt);
+  return true;
+}
+
+bool IsAlmostEqual(m2::RectD const & r1, m2::RectD const & r2, double eps)
+{
+  return std::fabs(r1.minX() - r2.minX()) <= eps && std::fabs(r1.minY() - r2.minY()) <= eps &&
+         std::fabs(r1.maxX() - r2.maxX()) <= eps && std::fabs(r1.maxY() - r2.maxY()) <= eps;
+}
+
 class HandleComparator
 {
 public:
@@ -67,9 +105,16 @@ private:
 }  // namespace
 
 OverlayTree::OverlayTree(double visualScale)
-  : m_frameCounter(kInvalidFrame)
+  : m_grid(kGridCellSize * visualScale)
+  , m_frameCounter(kInvalidFrame)
   , m_isDisplacementEnabled(true)
   , m_frameUpdatePeriod(kMinFrameUpdatePeriod)
+  , m_frameUpdatePeriodFactor(1)
+  , m_isIncrementalPlacingEnabled(true)
+  , m_hasPlacedHandles(false)
+  , m_placingIndex(0)
+  , m_incrementalPlacingsCount(0)
+  , m_deletedHandlesCount(0)
 {
   m_traits.SetVisualScale(visualScale);
   for (size_t i = 0; i < m_handles.size(); i++)
@@ -79,11 +124,12 @@ OverlayTree::OverlayTree(double visualScale)
 void OverlayTree::Clear()
 {
   m_frameCounter = kInvalidFrame;
-  TBase::Clear();
+  m_grid.Clear();
   m_handlesCache.clear();
   for (auto & handles : m_handles)
     handles.clear();
   m_displacers.clear();
+  ResetPlacedHandles();
 }
 
 bool OverlayTree::Frame()
@@ -104,7 +150,7 @@ bool OverlayTree::Frame()
   }
 
   m_frameCounter++;
-  if (m_frameCounter >= m_frameUpdatePeriod)
+  if (m_frameCounter >= m_frameUpdatePeriod * m_frameUpdatePeriodFactor)
     m_frameCounter = kInvalidFrame;
 
   return IsNeedUpdate();
@@ -118,10 +164,11 @@ bool OverlayTree::IsNeedUpdate() const
 void OverlayTree::StartOverlayPlacing(ScreenBase const & screen)
 {
   ASSERT(IsNeedUpdate(), ());
-  TBase::Clear();
   m_handlesCache.clear();
   m_traits.SetModelView(screen);
+  m_grid.Reset(m_traits.GetExtendedScreenRect());
   m_displacementInfo.clear();
+  m_deletedHandlesCount = 0;
 }
 
 void OverlayTree::Remove(ref_ptr<OverlayHandle> handle)
@@ -191,7 +238,7 @@ void OverlayTree::InsertHandle(ref_ptr<OverlayHandle> handle, int currentRank,
   if (!m_isDisplacementEnabled)
   {
     m_handlesCache.insert(handle);
-    TBase::Add(handle, pixelRect);
+    m_grid.Add(handle, pixelRect);
     return;
   }
 
@@ -200,7 +247,7 @@ void OverlayTree::InsertHandle(ref_ptr<OverlayHandle> handle, int currentRank,
 
   // Find elements that already on OverlayTree and it's pixel rect
   // intersect with handle pixel rect ("Intersected elements").
-  ForEachInRect(pixelRect, [&] (ref_ptr<OverlayHandle> const & h)
+  m_grid.ForEachInRect(pixelRect, [&] (ref_ptr<OverlayHandle> const & h)
   {
     bool const isParent = (h == parentOverlay) ||
                           (h->GetOverlayID() == handle->GetOverlayID() &&
@@ -261,7 +308,7 @@ void OverlayTree::InsertHandle(ref_ptr<OverlayHandle> handle, int currentRank,
       {
         if ((*it)->GetOverlayID() == rivalHandle->GetOverlayID())
         {
-          Erase(*it);
+          EraseHandle(*it);
           StoreDisplacementInfo(2 /* case index */, handle, *it);
           it = m_handlesCache.erase(it);
         }
@@ -279,19 +326,55 @@ void OverlayTree::InsertHandle(ref_ptr<OverlayHandle> handle, int currentRank,
   }
 
   m_handlesCache.insert(handle);
-  TBase::Add(handle, pixelRect);
+  m_grid.Add(handle, pixelRect);
 }
 
 void OverlayTree::EndOverlayPlacing()
 {
   ASSERT(IsNeedUpdate(), ());
 
-  m_displacers.clear();
-
 #ifdef DEBUG_OVERLAYS_OUTPUT
   LOG(LINFO, ("- BEGIN OVERLAYS PLACING"));
 #endif
 
+  if (PlaceHandlesIncrementally())
+  {
+    m_incrementalPlacingsCount++;
+  }
+  else
+  {
+    PlaceAllHandles();
+    m_incrementalPlacingsCount = 0;
+  }
+
+  if (m_isIncrementalPlacingEnabled)
+    StorePlacedHandles();
+
+  for (int rank = 0; rank < dp::OverlayRanksCount; rank++)
+  {
+    for (auto const & handle : m_handles[rank])
+      handle->SetDisplayFlag(false);
+    m_handles[rank].clear();
+  }
+
+  for (auto const & handle : m_handlesCache)
+  {
+    handle->SetDisplayFlag(true);
+    handle->SetIsVisible(true);
+    handle->SetCachingEnable(false);
+  }
+
+  m_frameCounter = 0;
+
+#ifdef DEBUG_OVERLAYS_OUTPUT
+  LOG(LINFO, ("- END OVERLAYS PLACING"));
+#endif
+}
+
+void OverlayTree::PlaceAllHandles()
+{
+  m_displacers.clear();
+
   HandleComparator comparator(false /* enableMask */);
 
   for (int rank = 0; rank < dp::OverlayRanksCount; rank++)
@@ -306,26 +389,197 @@ void OverlayTree::EndOverlayPlacing()
       InsertHandle(handle, rank, parentOverlay);
     }
   }
-  
+}
+
+bool OverlayTree::PlaceHandlesIncrementally()
+{
+  if (!m_isIncrementalPlacingEnabled || !m_hasPlacedHandles || !m_isDisplacementEnabled ||
+      m_incrementalPlacingsCount >= kMaxIncrementalPlacingsCount)
+  {
+    return false;
+  }
+
+  ScreenBase const & modelView = GetModelView();
+  m2::PointD shift;
+  if (!GetPixelShift(m_placingModelView, modelView, shift))
+    return false;
+
+  double const threshold = kMovementThreshold * m_traits.GetVisualScale();
+  uint32_t const placingIndex = m_placingIndex + 1;
+
+  // Space of handles which are placed again or removed may be taken by
+  // handles which were displaced last time.
+  std::vector<bool> freedCells(m_grid.GetCellsCount(), false);
+  auto const markFreedCells = [this, &freedCells](m2::RectD const & rect)
+  {
+    m_grid.ForEachCell(rect, [&freedCells](size_t cellIndex) { freedCells[cellIndex] = true; });
+  };
+
+  // Handles with the same overlay ID are placed again together, since
+  // handles of higher ranks depend on their parents.
+  std::set<OverlayID> dirtyGroups;
+  size_t dirtyCount = 0;
+  std::array<std::vector<PlacedHandle *>, dp::OverlayRanksCount> placedHandles;
+  size_t candidatesCount = 0;
   for (int rank = 0; rank < dp::OverlayRanksCount; rank++)
   {
+    placedHandles[rank].reserve(m_handles[rank].size());
     for (auto const & handle : m_handles[rank])
-      handle->SetDisplayFlag(false);
-    m_handles[rank].clear();
+    {
+      candidatesCount++;
+      auto const it = m_placedHandles.find(handle);
+      if (it == m_placedHandles.end())
+      {
+        dirtyGroups.insert(handle->GetOverlayID());
+        placedHandles[rank].push_back(nullptr);
+        continue;
+      }
+
+      PlacedHandle & placed = it->second;
+      placed.m_pixelRect.Offset(shift);
+      placed.m_placingIndex = placingIndex;
+
+      // A new handle may be created at the address of a removed one.
+      if (placed.m_overlayId != handle->GetOverlayID())
+      {
+        dirtyCount++;
+        dirtyGroups.insert(placed.m_overlayId);
+        dirtyGroups.insert(handle->GetOverlayID());
+        if (placed.m_isPlaced)
+          markFreedCells(placed.m_pixelRect);
+        placedHandles[rank].push_back(nullptr);
+        continue;
+      }
+
+      if (!IsAlmostEqual(handle->GetExtendedPixelRect(modelView), placed.m_pixelRect, threshold))
+        dirtyGroups.insert(placed.m_overlayId);
+      placedHandles[rank].push_back(&placed);
+    }
   }
 
-  for (auto const & handle : m_handlesCache)
+  for (auto & p : m_placedHandles)
   {
-    handle->SetDisplayFlag(true);
-    handle->SetIsVisible(true);
-    handle->SetCachingEnable(false);
+    if (p.second.m_placingIndex == placingIndex)
+      continue;
+    // Removed handles are never dereferenced, they may be destroyed already.
+    dirtyCount++;
+    dirtyGroups.insert(p.second.m_overlayId);
+    if (p.second.m_isPlaced)
+    {
+      p.second.m_pixelRect.Offset(shift);
+      markFreedCells(p.second.m_pixelRect);
+    }
   }
 
-  m_frameCounter = 0;
+  std::array<std::vector<ref_ptr<OverlayHandle>>, dp::OverlayRanksCount> dirtyHandles;
+  std::vector<ref_ptr<OverlayHandle>> keptHandles;
+  std::vector<std::pair<int, ref_ptr<OverlayHandle>>> hiddenHandles;
+  for (int rank = 0; rank < dp::OverlayRanksCount; rank++)
+  {
+    for (size_t i = 0; i < m_handles[rank].size(); i++)
+    {
+      auto const & handle = m_handles[rank][i];
+      PlacedHandle const * placed = placedHandles[rank][i];
+      if (placed == nullptr ||
+          (!dirtyGroups.empty() && dirtyGroups.find(placed->m_overlayId) != dirtyGroups.end()))
+      {
+        dirtyHandles[rank].push_back(handle);
+        if (placed != nullptr && placed->m_isPlaced)
+          markFreedCells(placed->m_pixelRect);
+      }
+      else if (placed->m_isPlaced)
+      {
+        keptHandles.push_back(handle);
+      }
+      else
+      {
+        hiddenHandles.emplace_back(rank, handle);
+      }
+    }
+  }
 
-#ifdef DEBUG_OVERLAYS_OUTPUT
-  LOG(LINFO, ("- END OVERLAYS PLACING"));
-#endif
+  for (auto const & p : hiddenHandles)
+  {
+    bool isFreed = false;
+    m_grid.ForEachCell(p.second->GetExtendedPixelRect(modelView), [&](size_t cellIndex)
+    {
+      isFreed = isFreed || freedCells[cellIndex];
+    });
+    if (isFreed)
+      dirtyHandles[p.first].push_back(p.second);
+  }
+
+  for (auto const & handles : dirtyHandles)
+    dirtyCount += handles.size();
+  if (dirtyCount > kMaxDirtyHandlesRatio * candidatesCount)
+    return false;
+
+  for (auto const & handle : keptHandles)
+  {
+    m_handlesCache.insert(handle);
+    m_grid.Add(handle, handle->GetExtendedPixelRect(modelView));
+  }
+
+  HandleComparator comparator(false /* enableMask */);
+  for (int rank = 0; rank < dp::OverlayRanksCount; rank++)
+  {
+    std::sort(dirtyHandles[rank].begin(), dirtyHandles[rank].end(), comparator);
+    for (auto const & handle : dirtyHandles[rank])
+    {
+      ref_ptr<OverlayHandle> parentOverlay;
+      if (!CheckHandle(handle, rank, parentOverlay))
+        continue;
+
+      InsertHandle(handle, rank, parentOverlay);
+    }
+  }
+
+  // A displaced handle could let other handles appear or lose their
+  // parents, so all handles are placed from scratch in this case.
+  if (m_deletedHandlesCount != 0)
+  {
+    m_grid.Clear();
+    m_handlesCache.clear();
+    m_displacementInfo.clear();
+    return false;
+  }
+
+  return true;
+}
+
+void OverlayTree::StorePlacedHandles()
+{
+  ScreenBase const & modelView = GetModelView();
+  uint32_t const placingIndex = ++m_placingIndex;
+  for (auto const & handles : m_handles)
+  {
+    for (auto const & handle : handles)
+    {
+      PlacedHandle & placed = m_placedHandles[handle];
+      placed.m_overlayId = handle->GetOverlayID();
+      placed.m_pixelRect = handle->GetExtendedPixelRect(modelView);
+      placed.m_isPlaced = m_handlesCache.find(handle) != m_handlesCache.end();
+      placed.m_placingIndex = placingIndex;
+    }
+  }
+
+  for (auto it = m_placedHandles.begin(); it != m_placedHandles.end();)
+  {
+    if (it->second.m_placingIndex != placingIndex)
+      it = m_placedHandles.erase(it);
+    else
+      ++it;
+  }
+
+  m_placingModelView = modelView;
+  m_hasPlacedHandles = true;
+}
+
+void OverlayTree::ResetPlacedHandles()
+{
+  m_placedHandles.clear();
+  m_hasPlacedHandles = false;
+  m_incrementalPlacingsCount = 0;
 }
 
 bool OverlayTree::CheckHandle(ref_ptr<OverlayHandle> handle, int currentRank,
@@ -354,7 +608,13 @@ void OverlayTree::DeleteHandle(ref_ptr<OverlayHandle> const & handle)
 {
   size_t const deletedCount = m_handlesCache.erase(handle);
   if (deletedCount != 0)
-    Erase(handle);
+    EraseHandle(handle);
+}
+
+void OverlayTree::EraseHandle(ref_ptr<OverlayHandle> const & handle)
+{
+  m_grid.Erase(handle);
+  m_deletedHandlesCount++;
 }
 
 void OverlayTree::DeleteHandleWithParents(ref_ptr<OverlayHandle> handle, int currentRank)
@@ -406,7 +666,7 @@ void OverlayTree::Select(m2::PointD const & glbPoint, TOverlayContainer & result
 void OverlayTree::Select(m2::RectD const & rect, TOverlayContainer & result) const
 {
   ScreenBase screen = GetModelView();
-  ForEachInRect(rect, [&](ref_ptr<OverlayHandle> const & h)
+  m_grid.ForEachInRect(rect, [&](ref_ptr<OverlayHandle> const & h)
   {
     if (!h->HasLinearFeatureShape() && h->IsVisible() && h->GetOverlayID().m_featureId.IsValid())
     {
@@ -430,11 +690,28 @@ void OverlayTree::SetDisplacementEnabled(bool enabled)
     return;
   m_isDisplacementEnabled = enabled;
   m_frameCounter = kInvalidFrame;
+  ResetPlacedHandles();
+}
+
+void OverlayTree::SetFrameUpdatePeriodFactor(uint32_t factor)
+{
+  ASSERT_GREATER(factor, 0, ());
+  m_frameUpdatePeriodFactor = factor;
+}
+
+void OverlayTree::SetIncrementalPlacingEnabled(bool enabled)
+{
+  m_isIncrementalPlacingEnabled = enabled;
+  if (!enabled)
+    ResetPlacedHandles();
 }
 
 void OverlayTree::SetSelectedFeature(FeatureID const & featureID)
 {
+  if (m_selectedFeatureID == featureID)
+    return;
   m_selectedFeatureID = featureID;
+  ResetPlacedHandles();
 }
 
 OverlayTree::TDisplacementInfo const & OverlayTree::GetDisplacementInfo() const
@@ -1,15 +1,16 @@
 #pragma once
 
 #include "drape/drape_diagnostics.hpp"
+#include "drape/overlay_grid.hpp"
 #include "drape/overlay_handle.hpp"
 
 #include "geometry/screenbase.hpp"
-#include "geometry/tree4d.hpp"
 
 #include "base/buffer_vector.hpp"
 
 #include <array>
 #include <memory>
+#include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
@@ -25,6 +26,7 @@ public:
     return handle->GetExtendedPixelRect(m_modelView);
   }
   ScreenBase const & GetModelView() const { return m_modelView; }
+  double GetVisualScale() const { return m_visualScale; }
   m2::RectD const & GetExtendedScreenRect() const { return m_extendedScreenRect; }
   m2::RectD const & GetDisplacersFreeRect() const { return m_displacersFreeRect; }
 
@@ -37,24 +39,12 @@ private:
   m2::RectD m_extendedScreenRect;
   m2::RectD m_displacersFreeRect;
 };
-
-struct OverlayHasher
-{
-  std::hash<OverlayHandle *> m_hasher;
-
-  size_t operator()(ref_ptr<OverlayHandle> const & handle) const
-  {
-    return m_hasher(handle.get());
-  }
-};
 }  // namespace detail
 
 using TOverlayContainer = buffer_vector<ref_ptr<OverlayHandle>, 8>;
 
-class OverlayTree : public m4::Tree<ref_ptr<OverlayHandle>, detail::OverlayTraits>
+class OverlayTree
 {
-  using TBase = m4::Tree<ref_ptr<OverlayHandle>, detail::OverlayTraits>;
-
 public:
   using HandlesCache = std::unordered_set<ref_ptr<OverlayHandle>, detail::OverlayHasher>;
 
@@ -76,6 +66,16 @@ public:
 
   void SetDisplacementEnabled(bool enabled);
 
+  // The tree is rebuilt |factor| times less often than usual. It's used
+  // to save time of frames on slow devices.
+  void SetFrameUpdatePeriodFactor(uint32_t factor);
+
+  // When incremental placing is enabled and the screen is only panned
+  // since the previous placing, only new handles, handles which moved
+  // relative to the map and handles which may take freed space are
+  // placed again, the others keep their visibility.
+  void SetIncrementalPlacingEnabled(bool enabled);
+
   void SetSelectedFeature(FeatureID const & featureID);
   bool GetSelectedFeatureRect(ScreenBase const & screen, m2::RectD & featureRect);
 
@@ -93,18 +93,35 @@ public:
   TDisplacementInfo const & GetDisplacementInfo() const;
 
 private:
+  struct PlacedHandle
+  {
+    OverlayID m_overlayId = OverlayID(FeatureID());
+    m2::RectD m_pixelRect;
+    bool m_isPlaced = false;
+    uint32_t m_placingIndex = 0;
+  };
+  using TPlacedHandles =
+      std::unordered_map<ref_ptr<OverlayHandle>, PlacedHandle, detail::OverlayHasher>;
+
   ScreenBase const & GetModelView() const { return m_traits.GetModelView(); }
+  void PlaceAllHandles();
+  bool PlaceHandlesIncrementally();
+  void StorePlacedHandles();
+  void ResetPlacedHandles();
   void InsertHandle(ref_ptr<OverlayHandle> handle, int currentRank,
                     ref_ptr<OverlayHandle> const & parentOverlay);
   bool CheckHandle(ref_ptr<OverlayHandle> handle, int currentRank,
                    ref_ptr<OverlayHandle> & parentOverlay) const;
   void DeleteHandle(ref_ptr<OverlayHandle> const & handle);
+  void EraseHandle(ref_ptr<OverlayHandle> const & handle);
 
   ref_ptr<OverlayHandle> FindParent(ref_ptr<OverlayHandle> handle, int searchingRank) const;
   void DeleteHandleWithParents(ref_ptr<OverlayHandle> handle, int currentRank);
 
   void StoreDisplacementInfo(int caseIndex, ref_ptr<OverlayHandle> displacerHandle,
                              ref_ptr<OverlayHandle> displacedHandle);
+  detail::OverlayTraits m_traits;
+  OverlayGrid m_grid;
   int m_frameCounter;
   std::array<std::vector<ref_ptr<OverlayHandle>>, dp::OverlayRanksCount> m_handles;
   HandlesCache m_handlesCache;
@@ -117,5 +134,16 @@ private:
 
   HandlesCache m_displacers;
   uint32_t m_frameUpdatePeriod;
+  uint32_t m_frameUpdatePeriodFactor;
+
+  // State of the previous placing, which is used for incremental placing.
+  bool m_isIncrementalPlacingEnabled;
+  bool m_hasPlacedHandles;
+  ScreenBase m_placingModelView;
+  TPlacedHandles m_placedHandles;
+  uint32_t m_placingIndex;
+  uint32_t m_incrementalPlacingsCount;
+  // Count of handles deleted from the tree during the current placing.
+  uint32_t m_deletedHandlesCount;
 };
 }  // namespace dp
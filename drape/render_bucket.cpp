@@ -4,6 +4,7 @@
 #include "drape/debug_rect_renderer.hpp"
 #include "drape/overlay_handle.hpp"
 #include "drape/overlay_tree.hpp"
+#include "drape/utils/render_counters.hpp"
 #include "drape/vertex_array_buffer.hpp"
 
 #include "base/stl_add.hpp"
@@ -119,6 +120,7 @@ void RenderBucket::Render(bool drawAsLine)
     m_buffer->ApplyMutation(hasIndexMutation ? rfpIndex : nullptr, rfpAttrib);
   }
   m_buffer->Render(drawAsLine);
+  RenderCounters::Instance().AddBucket();
 }
 
 void RenderBucket::SetFeatureMinZoom(int minZoom)
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "drape/object_pool.hpp"
 #include "drape/pointers.hpp"
 
 #include "std/function.hpp"
@@ -20,7 +21,8 @@ class OverlayHandle;
 class OverlayTree;
 class VertexArrayBuffer;
 
-class RenderBucket
+// Buckets are created for every batch of every tile, so they are pooled.
+class RenderBucket : public PooledObject
 {
   friend class df::BatchMergeHelper;
 public:
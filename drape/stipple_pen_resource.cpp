@@ -1,6 +1,7 @@
 #include "drape/stipple_pen_resource.hpp"
 
 #include "drape/texture.hpp"
+#include "drape/utils/gpu_mem_tracker.hpp"
 
 #include "base/shared_buffer_manager.hpp"
 
@@ -190,6 +191,27 @@ void StipplePenIndex::UploadResources(ref_ptr<Texture> texture)
   mng.freeSharedBuffer(reserveBufferSize, ptr);
 }
 
+uint32_t StipplePenIndex::GetUsedHeight()
+{
+  lock_guard<mutex> g(m_mappingLock);
+  return m_packer.GetUsedHeight();
+}
+
+void StipplePenTexture::UpdateState()
+{
+  TBase::UpdateState();
+
+#if defined(TRACK_GPU_MEM)
+  uint32_t const usedHeight = m_index.GetUsedHeight();
+  if (usedHeight != m_reportedUsedHeight)
+  {
+    m_reportedUsedHeight = usedHeight;
+    dp::GPUMemTracker::Inst().SetUsed("Texture", GetID(),
+                                      usedHeight * GetWidth() * GetBytesPerPixel(GetFormat()));
+  }
+#endif
+}
+
 void StipplePenTexture::ReservePattern(buffer_vector<uint8_t, 8> const & pattern)
 {
   bool newResource = false;
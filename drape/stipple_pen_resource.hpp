@@ -86,6 +86,7 @@ public:
 
   m2::RectU PackResource(uint32_t width);
   m2::RectF MapTextureCoords(m2::RectU const & pixelRect) const;
+  uint32_t GetUsedHeight() const { return m_currentRow; }
 
 private:
   m2::PointU m_canvasSize;
@@ -100,6 +101,9 @@ public:
   ref_ptr<Texture::ResourceInfo> MapResource(StipplePenKey const & key, bool & newResource);
   void UploadResources(ref_ptr<Texture> texture);
 
+  // Height of the part of the texture which is occupied by pens.
+  uint32_t GetUsedHeight();
+
 private:
   typedef map<StipplePenHandle, StipplePenResourceInfo> TResourceMapping;
   typedef pair<m2::RectU, StipplePenRasterizator> TPendingNode;
@@ -131,7 +135,10 @@ public:
 
   void ReservePattern(buffer_vector<uint8_t, 8> const & pattern);
 
+  void UpdateState() override;
+
 private:
   StipplePenIndex m_index;
+  uint32_t m_reportedUsedHeight = 0;
 };
 }  // namespace dp
@@ -54,6 +54,10 @@ void SupportManager::Init()
   m_maxLineWidth = std::max(1, GLFunctions::glGetMaxLineWidth());
   LOG(LINFO, ("Max line width =", m_maxLineWidth));
 
+  // Instanced drawing is in the core of OpenGL ES 3, vertex array objects
+  // are always used there, so divisors of attributes never leak to other buffers.
+  m_isInstancingSupported = (GLFunctions::CurrentApiVersion == dp::ApiVersion::OpenGLES3);
+
   // Set up default antialiasing value.
   // Turn off AA for a while by energy-saving issues.
 //  bool val;
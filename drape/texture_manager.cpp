@@ -28,6 +28,7 @@ uint32_t const kMaxTextureSize = 1024;
 uint32_t const kStippleTextureWidth = 512;
 uint32_t const kMinStippleTextureHeight = 64;
 uint32_t const kMinColorTextureSize = 32;
+size_t const kMaxWarmUpGlyphsCount = 512;
 size_t const kInvalidGlyphGroup = numeric_limits<size_t>::max();
 
 // number of glyphs (since 0) which will be in each texture
@@ -36,6 +37,10 @@ size_t const kDuplicatedGlyphsCount = 128;
 uint32_t const kReservedPatterns = 10;
 size_t const kReservedColors = 20;
 
+// Number of glyphs which must fit a shared glyph texture to give it to
+// one more glyph group.
+uint32_t const kSharedGlyphsReserve = 256;
+
 float const kGlyphAreaMultiplier = 1.2f;
 float const kGlyphAreaCoverage = 0.9f;
 
@@ -236,6 +241,7 @@ void TextureManager::Release()
 {
   m_glyphGroups.clear();
   m_hybridGlyphGroups.clear();
+  m_sharedGlyphTexture = nullptr;
 
   m_symbolTextures.clear();
   m_stipplePenTexture.reset();
@@ -247,6 +253,16 @@ void TextureManager::Release()
   m_smaaSearchTexture.reset();
 
   m_glyphTextures.clear();
+  m_glyphGenerator.reset();
+
+  {
+    std::lock_guard<std::mutex> lock(m_calcGlyphsMutex);
+    if (m_glyphWarmUpList != nullptr)
+    {
+      m_glyphWarmUpList->Save();
+      m_glyphWarmUpList.reset();
+    }
+  }
 
   m_glyphManager.reset();
 }
@@ -289,10 +305,18 @@ ref_ptr<Texture> TextureManager::AllocateGlyphTexture()
   std::lock_guard<std::mutex> lock(m_glyphTexturesMutex);
   m2::PointU size(m_maxTextureSize, m_maxTextureSize);
   m_glyphTextures.push_back(make_unique_dp<FontTexture>(size, make_ref(m_glyphManager),
+                                                        make_ref(m_glyphGenerator),
                                                         make_ref(m_textureAllocator)));
   return make_ref(m_glyphTextures.back());
 }
 
+ref_ptr<Texture> TextureManager::AcquireGlyphTexture(GlyphGroup const & /* group */)
+{
+  if (m_sharedGlyphTexture == nullptr || !m_sharedGlyphTexture->HasEnoughSpace(kSharedGlyphsReserve))
+    m_sharedGlyphTexture = AllocateGlyphTexture();
+  return m_sharedGlyphTexture;
+}
+
 void TextureManager::GetRegionBase(ref_ptr<Texture> tex, TextureManager::BaseRegion & region,
                                    Texture::Key const & key)
 {
@@ -492,6 +516,8 @@ void TextureManager::Init(Params const & params)
 
   // Initialize glyphs.
   m_glyphManager = make_unique_dp<GlyphManager>(params.m_glyphMngParams);
+  m_glyphGenerator = make_unique_dp<GlyphGenerator>(make_ref(m_glyphManager),
+                                                    GlyphGenerator::GetDefaultThreadsCount());
 
   uint32_t const textureSquare = m_maxTextureSize * m_maxTextureSize;
   uint32_t const baseGlyphHeight =
@@ -516,6 +542,27 @@ void TextureManager::Init(Params const & params)
     else
       m_glyphGroups.push_back(GlyphGroup(start, end));
   });
+
+  if (!params.m_glyphsWarmUpFile.empty())
+  {
+    std::lock_guard<std::mutex> lock(m_calcGlyphsMutex);
+    m_glyphWarmUpList = my::make_unique<GlyphWarmUpList>(params.m_glyphsWarmUpFile,
+                                                         kMaxWarmUpGlyphsCount);
+    if (m_glyphWarmUpList->Load())
+      WarmUpGlyphs();
+  }
+}
+
+void TextureManager::WarmUpGlyphs()
+{
+  // Glyphs are rasterized asynchronously, so it doesn't delay initialization.
+  TGlyphsBuffer regions;
+  for (auto const c : m_glyphWarmUpList->GetGlyphs())
+  {
+    regions.clear();
+    CalcGlyphRegions<strings::UniString, TGlyphsBuffer>(strings::UniString(1, c),
+                                                        GlyphManager::kDynamicGlyphSize, regions);
+  }
 }
 
 void TextureManager::OnSwitchMapStyle()
@@ -570,6 +617,11 @@ void TextureManager::GetGlyphRegions(TMultilineText const & text, int fixedHeigh
                                      TMultilineGlyphsBuffer & buffers)
 {
   std::lock_guard<std::mutex> lock(m_calcGlyphsMutex);
+  if (m_glyphWarmUpList != nullptr && fixedHeight == GlyphManager::kDynamicGlyphSize)
+  {
+    for (auto const & str : text)
+      m_glyphWarmUpList->AddUsage(str);
+  }
   CalcGlyphRegions<TMultilineText, TMultilineGlyphsBuffer>(text, fixedHeight, buffers);
 }
 
@@ -577,6 +629,8 @@ void TextureManager::GetGlyphRegions(strings::UniString const & text, int fixedH
                                      TGlyphsBuffer & regions)
 {
   std::lock_guard<std::mutex> lock(m_calcGlyphsMutex);
+  if (m_glyphWarmUpList != nullptr && fixedHeight == GlyphManager::kDynamicGlyphSize)
+    m_glyphWarmUpList->AddUsage(text);
   CalcGlyphRegions<strings::UniString, TGlyphsBuffer>(text, fixedHeight, regions);
 }
 
@@ -5,11 +5,13 @@
 #include "drape/pointers.hpp"
 #include "drape/texture.hpp"
 #include "drape/font_texture.hpp"
+#include "drape/utils/glyph_warm_up_list.hpp"
 
 #include "base/string_utils.hpp"
 
 #include <atomic>
 #include <list>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <vector>
@@ -76,6 +78,9 @@ public:
     std::string m_colors;
     std::string m_patterns;
     GlyphManager::Params m_glyphMngParams;
+    // Glyphs used most often are put into textures on initialization,
+    // the list is empty if the file name is.
+    std::string m_glyphsWarmUpFile;
   };
 
   TextureManager();
@@ -141,6 +146,14 @@ private:
   uint32_t m_maxGlypsCount;
 
   ref_ptr<Texture> AllocateGlyphTexture();
+  // Usually only a few glyphs of a unicode block are used, so groups share
+  // a texture while it has enough space. Texts of a group which don't fit
+  // the shared texture go to hybrid groups.
+  ref_ptr<Texture> AcquireGlyphTexture(GlyphGroup const & group);
+  ref_ptr<Texture> AcquireGlyphTexture(HybridGlyphGroup const & group)
+  {
+    return AllocateGlyphTexture();
+  }
   void GetRegionBase(ref_ptr<Texture> tex, TextureManager::BaseRegion & region, Texture::Key const & key);
 
   size_t FindGlyphsGroup(strings::UniChar const & c) const;
@@ -162,7 +175,7 @@ private:
                         TGlyphsBuffer & regions)
   {
     if (group.m_texture == nullptr)
-      group.m_texture = AllocateGlyphTexture();
+      group.m_texture = AcquireGlyphTexture(group);
 
     regions.reserve(text.size());
     for (strings::UniChar const & c : text)
@@ -228,6 +241,7 @@ private:
                                 int fixedHeight) const;
 
   void UpdateGlyphTextures();
+  void WarmUpGlyphs();
   bool HasAsyncRoutines() const;
 
   static constexpr size_t GetInvalidGlyphGroup();
@@ -246,10 +260,15 @@ private:
   drape_ptr<Texture> m_smaaSearchTexture;
 
   drape_ptr<GlyphManager> m_glyphManager;
+  drape_ptr<GlyphGenerator> m_glyphGenerator;
   drape_ptr<HWTextureAllocator> m_textureAllocator;
+  // Guarded by m_calcGlyphsMutex.
+  std::unique_ptr<GlyphWarmUpList> m_glyphWarmUpList;
 
   buffer_vector<GlyphGroup, 64> m_glyphGroups;
   buffer_vector<HybridGlyphGroup, 4> m_hybridGlyphGroups;
+  // The texture which is shared between glyph groups.
+  ref_ptr<Texture> m_sharedGlyphTexture;
 
   std::atomic_flag m_nothingToUpload;
   std::mutex m_calcGlyphsMutex;
@@ -0,0 +1,90 @@
+#include "drape/utils/glyph_warm_up_list.hpp"
+
+#include "base/logging.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <limits>
+#include <utility>
+
+namespace dp
+{
+GlyphWarmUpList::GlyphWarmUpList(std::string const & fileName, size_t maxGlyphsCount)
+  : m_fileName(fileName), m_maxGlyphsCount(maxGlyphsCount)
+{}
+
+bool GlyphWarmUpList::Load()
+{
+  m_usages.clear();
+
+  std::ifstream stream(m_fileName);
+  if (!stream.is_open())
+    return false;
+
+  uint32_t code;
+  uint32_t count;
+  while (stream >> code >> count)
+  {
+    // Old usages weigh less than new ones.
+    count /= 2;
+    if (count != 0)
+      m_usages[static_cast<strings::UniChar>(code)] = count;
+  }
+
+  if (!stream.eof())
+  {
+    LOG(LWARNING, ("Corrupted list of glyphs", m_fileName));
+    m_usages.clear();
+    return false;
+  }
+  return true;
+}
+
+bool GlyphWarmUpList::Save() const
+{
+  std::ofstream stream(m_fileName, std::ios::trunc);
+  if (!stream.is_open())
+  {
+    LOG(LWARNING, ("Can't save list of glyphs", m_fileName));
+    return false;
+  }
+
+  for (auto const c : GetGlyphs())
+    stream << c << " " << m_usages.find(c)->second << "\n";
+  return static_cast<bool>(stream);
+}
+
+void GlyphWarmUpList::AddUsage(strings::UniString const & text)
+{
+  for (auto const c : text)
+  {
+    auto & count = m_usages[c];
+    if (count < std::numeric_limits<uint32_t>::max())
+      ++count;
+  }
+}
+
+std::vector<strings::UniChar> GlyphWarmUpList::GetGlyphs() const
+{
+  std::vector<std::pair<uint32_t, strings::UniChar>> usages;
+  usages.reserve(m_usages.size());
+  for (auto const & usage : m_usages)
+    usages.emplace_back(usage.second, usage.first);
+
+  size_t const count = std::min(usages.size(), m_maxGlyphsCount);
+  std::partial_sort(usages.begin(), usages.begin() + count, usages.end(),
+                    [](std::pair<uint32_t, strings::UniChar> const & lhs,
+                       std::pair<uint32_t, strings::UniChar> const & rhs)
+  {
+    if (lhs.first != rhs.first)
+      return lhs.first > rhs.first;
+    return lhs.second < rhs.second;
+  });
+
+  std::vector<strings::UniChar> result;
+  result.reserve(count);
+  for (size_t i = 0; i < count; ++i)
+    result.push_back(usages[i].second);
+  return result;
+}
+}  // namespace dp
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "base/string_utils.hpp"
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace dp
+{
+// List of glyphs which were used most often in previous sessions. The glyphs
+// are put into the atlas on start, so the first frames don't wait for their
+// rasterization. Counters of usages are halved on every loading, so the list
+// follows changes of the language and the places which the user looks at.
+class GlyphWarmUpList
+{
+public:
+  GlyphWarmUpList(std::string const & fileName, size_t maxGlyphsCount);
+
+  // Returns false if the file doesn't exist or it's corrupted.
+  bool Load();
+  bool Save() const;
+
+  void AddUsage(strings::UniString const & text);
+
+  // Returns glyphs ordered by decrease of usages, not more than the max count.
+  std::vector<strings::UniChar> GetGlyphs() const;
+
+  bool IsEmpty() const { return m_usages.empty(); }
+
+private:
+  std::string const m_fileName;
+  size_t const m_maxGlyphsCount;
+  std::map<strings::UniChar, uint32_t> m_usages;
+};
+}  // namespace dp
@@ -63,7 +63,10 @@ GPUMemTracker::GPUMemorySnapshot GPUMemTracker::GetMemorySnapshot()
 void GPUMemTracker::AddAllocated(string const & tag, uint32_t id, uint32_t size)
 {
   threads::MutexGuard g(m_mutex);
-  m_memTracker[make_pair(tag, id)].first = size;
+  uint32_t & allocated = m_memTracker[make_pair(tag, id)].first;
+  m_allocated = m_allocated - allocated + size;
+  allocated = size;
+  m_allocatedMemory.Set(m_allocated);
 }
 
 void GPUMemTracker::SetUsed(string const & tag, uint32_t id, uint32_t size)
@@ -77,7 +80,12 @@ void GPUMemTracker::SetUsed(string const & tag, uint32_t id, uint32_t size)
 void GPUMemTracker::RemoveDeallocated(string const & tag, uint32_t id)
 {
   threads::MutexGuard g(m_mutex);
-  m_memTracker.erase(make_pair(tag, id));
+  auto const it = m_memTracker.find(make_pair(tag, id));
+  if (it == m_memTracker.end())
+    return;
+  m_allocated -= it->second.first;
+  m_allocatedMemory.Set(m_allocated);
+  m_memTracker.erase(it);
 }
 
 } // namespace dp
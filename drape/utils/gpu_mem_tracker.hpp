@@ -2,6 +2,7 @@
 
 #include "drape/drape_diagnostics.hpp"
 
+#include "base/memory_counters.hpp"
 #include "base/mutex.hpp"
 
 #include "std/map.hpp"
@@ -46,6 +47,9 @@ private:
   typedef pair<uint32_t, uint32_t> TAlocUsedMem;
   typedef pair<string, uint32_t> TMemTag;
   map<TMemTag, TAlocUsedMem> m_memTracker;
+  // Allocated bytes of all objects are reported to base::MemoryCounters.
+  uint64_t m_allocated = 0;
+  base::MemoryCounter m_allocatedMemory{"drape.gpu_buffers"};
 
   threads::Mutex m_mutex;
 };
@@ -0,0 +1,27 @@
+#include "drape/utils/render_counters.hpp"
+
+namespace dp
+{
+// static
+RenderCounters & RenderCounters::Instance()
+{
+  static RenderCounters counters;
+  return counters;
+}
+
+void RenderCounters::SetEnabled(bool enabled)
+{
+  m_isEnabled = enabled;
+  if (!enabled)
+    Take();
+}
+
+RenderCounters::Snapshot RenderCounters::Take()
+{
+  Snapshot snapshot;
+  snapshot.m_drawCallsCount = m_drawCallsCount.exchange(0, std::memory_order_relaxed);
+  snapshot.m_bucketsCount = m_bucketsCount.exchange(0, std::memory_order_relaxed);
+  snapshot.m_uploadedBytes = m_uploadedBytes.exchange(0, std::memory_order_relaxed);
+  return snapshot;
+}
+}  // namespace dp
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "base/macros.hpp"
+
+#include <atomic>
+#include <cstdint>
+
+namespace dp
+{
+// Counters of rendering work, which are taken by the frame profiler
+// once per frame. Counting is off until the profiler enables it, so
+// the overhead is a relaxed atomic load per counted call.
+//
+// Uploads happen on both renderer threads, so all counters are atomic.
+class RenderCounters
+{
+public:
+  struct Snapshot
+  {
+    uint32_t m_drawCallsCount = 0;
+    uint32_t m_bucketsCount = 0;
+    uint64_t m_uploadedBytes = 0;
+  };
+
+  static RenderCounters & Instance();
+
+  void SetEnabled(bool enabled);
+  bool IsEnabled() const { return m_isEnabled.load(std::memory_order_relaxed); }
+
+  void AddDrawCall()
+  {
+    if (IsEnabled())
+      m_drawCallsCount.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  void AddBucket()
+  {
+    if (IsEnabled())
+      m_bucketsCount.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  void AddUploadedBytes(uint64_t bytes)
+  {
+    if (IsEnabled())
+      m_uploadedBytes.fetch_add(bytes, std::memory_order_relaxed);
+  }
+
+  // Returns the counters accumulated since the previous call and resets them.
+  Snapshot Take();
+
+private:
+  RenderCounters() = default;
+
+  std::atomic<bool> m_isEnabled{false};
+  std::atomic<uint32_t> m_drawCallsCount{0};
+  std::atomic<uint32_t> m_bucketsCount{0};
+  std::atomic<uint64_t> m_uploadedBytes{0};
+
+  DISALLOW_COPY_AND_MOVE(RenderCounters);
+};
+}  // namespace dp
@@ -51,6 +51,7 @@ VertexArrayBuffer::~VertexArrayBuffer()
   m_indexBuffer.reset();
   m_staticBuffers.clear();
   m_dynamicBuffers.clear();
+  m_instanceBuffers.clear();
 
   if (m_VAO != 0)
   {
@@ -72,15 +73,19 @@ void VertexArrayBuffer::PreflushImpl()
 {
   ASSERT(!m_isPreflushed, ());
 
-  // Buffers are ready, so moving them from CPU to GPU.
+  // Buffers are ready, so moving them from CPU to GPU. Dynamic buffers are
+  // mapped on mutations, so they aren't sub-allocated from shared pages.
   for (auto & buffer : m_staticBuffers)
-    buffer.second->MoveToGPU(GPUBuffer::ElementBuffer);
+    buffer.second->MoveToGPU(GPUBuffer::ElementBuffer, true /* isPooled */);
 
   for (auto & buffer : m_dynamicBuffers)
     buffer.second->MoveToGPU(GPUBuffer::ElementBuffer);
 
+  for (auto & buffer : m_instanceBuffers)
+    buffer.second->MoveToGPU(GPUBuffer::ElementBuffer, true /* isPooled */);
+
   ASSERT(m_indexBuffer != nullptr, ());
-  m_indexBuffer->MoveToGPU(GPUBuffer::IndexBuffer);
+  m_indexBuffer->MoveToGPU(GPUBuffer::IndexBuffer, true /* isPooled */);
 
   GLFunctions::glBindBuffer(0, gl_const::GLElementArrayBuffer);
   GLFunctions::glBindBuffer(0, gl_const::GLArrayBuffer);
@@ -105,9 +110,23 @@ void VertexArrayBuffer::RenderRange(bool drawAsLine, IndicesRange const & range)
 
     BindDynamicBuffers();
     GetIndexBuffer()->Bind();
-    GLFunctions::glDrawElements(drawAsLine ? gl_const::GLLines : gl_const::GLTriangles,
-                                dp::IndexStorage::SizeOfIndex(), range.m_idxCount,
-                                range.m_idxStart);
+    glConst const primitive = drawAsLine ? gl_const::GLLines : gl_const::GLTriangles;
+    uint32_t const idxStart = range.m_idxStart + GetIndexBuffer()->GetByteOffset() /
+                                                 dp::IndexStorage::SizeOfIndex();
+    if (IsInstanced())
+    {
+      uint32_t const instanceCount = GetInstanceCount();
+      if (instanceCount > 0)
+      {
+        GLFunctions::glDrawElementsInstanced(primitive, dp::IndexStorage::SizeOfIndex(),
+                                             range.m_idxCount, instanceCount, idxStart);
+      }
+    }
+    else
+    {
+      GLFunctions::glDrawElements(primitive, dp::IndexStorage::SizeOfIndex(), range.m_idxCount,
+                                  idxStart);
+    }
 
     Unbind();
   }
@@ -151,6 +170,47 @@ void VertexArrayBuffer::UploadData(BindingInfo const & bindingInfo, void const *
   buffer->GetBuffer()->UploadData(data, count);
 }
 
+void VertexArrayBuffer::UploadInstanceData(BindingInfo const & bindingInfo, void const * data,
+                                           uint32_t count)
+{
+  ASSERT(SupportManager::Instance().IsInstancingSupported(), ());
+  ASSERT(!bindingInfo.IsDynamic(), ("Instance attributes can't be mutated by overlay handles"));
+
+  auto it = m_instanceBuffers.find(bindingInfo);
+  if (it == m_instanceBuffers.end())
+  {
+    it = m_instanceBuffers
+             .insert(std::make_pair(bindingInfo, make_unique_dp<DataBuffer>(
+                                                     bindingInfo.GetElementSize(), m_dataBufferSize)))
+             .first;
+  }
+
+  if (count > 0)
+    m_isChanged = true;
+  it->second->GetBuffer()->UploadData(data, count);
+}
+
+uint32_t VertexArrayBuffer::GetAvailableInstanceCount() const
+{
+  if (m_instanceBuffers.empty())
+    return m_dataBufferSize;
+  return m_instanceBuffers.begin()->second->GetBuffer()->GetAvailableSize();
+}
+
+uint32_t VertexArrayBuffer::GetInstanceCount() const
+{
+  if (m_instanceBuffers.empty())
+    return 0;
+
+#ifdef DEBUG
+  uint32_t const count = m_instanceBuffers.begin()->second->GetBuffer()->GetCurrentSize();
+  for (auto const & buffer : m_instanceBuffers)
+    ASSERT_EQUAL(count, buffer.second->GetBuffer()->GetCurrentSize(), ());
+#endif
+
+  return m_instanceBuffers.begin()->second->GetBuffer()->GetCurrentSize();
+}
+
 ref_ptr<DataBuffer> VertexArrayBuffer::GetOrCreateDynamicBuffer(BindingInfo const & bindingInfo)
 {
   return GetOrCreateBuffer(bindingInfo, true);
@@ -252,6 +312,29 @@ void VertexArrayBuffer::UploadIndexes(void const * data, uint32_t count)
   GetIndexBuffer()->UploadData(data, count);
 }
 
+bool VertexArrayBuffer::GetCpuData(TBuffersData & staticData, std::vector<uint8_t> & indices) const
+{
+  if (m_isPreflushed || !m_dynamicBuffers.empty() || IsInstanced())
+    return false;
+
+  auto const copyData = [](ref_ptr<DataBufferBase> buffer, std::vector<uint8_t> & result)
+  {
+    auto const data = static_cast<uint8_t const *>(buffer->Data());
+    result.assign(data, data + buffer->GetCurrentSize() * buffer->GetElementSize());
+  };
+
+  staticData.clear();
+  staticData.reserve(m_staticBuffers.size());
+  for (auto const & buffer : m_staticBuffers)
+  {
+    staticData.emplace_back(buffer.first, std::vector<uint8_t>());
+    copyData(buffer.second->GetBuffer(), staticData.back().second);
+  }
+
+  copyData(GetIndexBuffer(), indices);
+  return true;
+}
+
 void VertexArrayBuffer::ApplyMutation(ref_ptr<IndexBufferMutator> indexMutator,
                                       ref_ptr<AttributeBufferMutator> attrMutator)
 {
@@ -265,7 +348,7 @@ void VertexArrayBuffer::ApplyMutation(ref_ptr<IndexBufferMutator> indexMutator,
     if (indexMutator->GetCapacity() > m_indexBuffer->GetBuffer()->GetCapacity())
     {
       m_indexBuffer = make_unique_dp<IndexBuffer>(indexMutator->GetCapacity());
-      m_indexBuffer->MoveToGPU(GPUBuffer::IndexBuffer);
+      m_indexBuffer->MoveToGPU(GPUBuffer::IndexBuffer, true /* isPooled */);
     }
     m_indexBuffer->UpdateData(indexMutator->GetIndexes(), indexMutator->GetIndexCount());
   }
@@ -317,17 +400,22 @@ void VertexArrayBuffer::Unbind() const
     GLFunctions::glBindVertexArray(0);
 }
 
-void VertexArrayBuffer::BindStaticBuffers() const { BindBuffers(m_staticBuffers); }
+void VertexArrayBuffer::BindStaticBuffers() const
+{
+  BindBuffers(m_staticBuffers, 0 /* divisor */);
+  BindBuffers(m_instanceBuffers, 1 /* divisor */);
+}
 
-void VertexArrayBuffer::BindDynamicBuffers() const { BindBuffers(m_dynamicBuffers); }
+void VertexArrayBuffer::BindDynamicBuffers() const { BindBuffers(m_dynamicBuffers, 0 /* divisor */); }
 
-void VertexArrayBuffer::BindBuffers(BuffersMap const & buffers) const
+void VertexArrayBuffer::BindBuffers(BuffersMap const & buffers, uint32_t divisor) const
 {
   for (auto it = buffers.begin(); it != buffers.end(); ++it)
   {
     BindingInfo const & binding = it->first;
     ref_ptr<DataBuffer> buffer = make_ref(it->second);
     buffer->GetBuffer()->Bind();
+    uint32_t const byteOffset = buffer->GetBuffer()->GetByteOffset();
 
     for (uint16_t i = 0; i < binding.GetCount(); ++i)
     {
@@ -337,7 +425,10 @@ void VertexArrayBuffer::BindBuffers(BuffersMap const & buffers) const
       GLFunctions::glEnableVertexAttribute(attributeLocation);
       GLFunctions::glVertexAttributePointer(attributeLocation, decl.m_componentCount,
                                             decl.m_componentType, false, decl.m_stride,
-                                            decl.m_offset);
+                                            byteOffset + decl.m_offset);
+      // Divisors are a state of VAO, which is always used with instancing.
+      if (divisor != 0)
+        GLFunctions::glVertexAttribDivisor(attributeLocation, divisor);
     }
   }
 }
@@ -9,6 +9,8 @@
 #include "drape/pointers.hpp"
 
 #include <map>
+#include <utility>
+#include <vector>
 
 namespace df
 {
@@ -55,9 +57,23 @@ public:
   void UploadData(BindingInfo const & bindingInfo, void const * data, uint32_t count);
   void UploadIndexes(void const * data, uint32_t count);
 
+  // Per-instance attributes. When the buffer has them, indices describe
+  // geometry of one instance, and it's drawn once per uploaded instance.
+  // Must be used only if SupportManager::IsInstancingSupported().
+  void UploadInstanceData(BindingInfo const & bindingInfo, void const * data, uint32_t count);
+  uint32_t GetAvailableInstanceCount() const;
+  uint32_t GetInstanceCount() const;
+  bool IsInstanced() const { return !m_instanceBuffers.empty(); }
+
   void ApplyMutation(ref_ptr<IndexBufferMutator> indexMutator,
                      ref_ptr<AttributeBufferMutator> attrMutator);
 
+  // Copies data of static buffers and indices, which is available until
+  // Preflush() moves it to GPU. Returns false when there are dynamic
+  // buffers, since they are changed by overlay handles later.
+  using TBuffersData = std::vector<std::pair<BindingInfo, std::vector<uint8_t>>>;
+  bool GetCpuData(TBuffersData & staticData, std::vector<uint8_t> & indices) const;
+
   void ResetChangingTracking() { m_isChanged = false; }
   bool IsChanged() const { return m_isChanged; }
 private:
@@ -71,7 +87,7 @@ private:
   void Unbind() const;
   void BindStaticBuffers() const;
   void BindDynamicBuffers() const;
-  void BindBuffers(BuffersMap const & buffers) const;
+  void BindBuffers(BuffersMap const & buffers, uint32_t divisor) const;
 
   ref_ptr<DataBufferBase> GetIndexBuffer() const;
 
@@ -82,6 +98,7 @@ private:
   int m_VAO;
   BuffersMap m_staticBuffers;
   BuffersMap m_dynamicBuffers;
+  BuffersMap m_instanceBuffers;
 
   drape_ptr<IndexBuffer> m_indexBuffer;
   uint32_t m_dataBufferSize;
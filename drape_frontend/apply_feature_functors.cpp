@@ -669,104 +669,18 @@ void ApplyAreaFeature::ProcessBuildingPolygon(m2::PointD const & p1, m2::PointD
   if (fabs(crossProduct) < kEps)
     return;
 
+  // The outline is reconstructed from the triangles (see CalculateBuildingOutline()).
   if (crossProduct < 0)
   {
     m_triangles.push_back(p1);
     m_triangles.push_back(p2);
     m_triangles.push_back(p3);
-    BuildEdges(GetIndex(p1), GetIndex(p2), GetIndex(p3));
   }
   else
   {
     m_triangles.push_back(p1);
     m_triangles.push_back(p3);
     m_triangles.push_back(p2);
-    BuildEdges(GetIndex(p1), GetIndex(p3), GetIndex(p2));
-  }
-}
-
-int ApplyAreaFeature::GetIndex(m2::PointD const & pt)
-{
-  for (size_t i = 0; i < m_points.size(); i++)
-  {
-    if (pt.EqualDxDy(m_points[i], 1e-7))
-      return static_cast<int>(i);
-  }
-  m_points.push_back(pt);
-  return static_cast<int>(m_points.size()) - 1;
-}
-
-bool ApplyAreaFeature::EqualEdges(TEdge const & edge1, TEdge const & edge2) const
-{
-  return (edge1.first == edge2.first && edge1.second == edge2.second) ||
-         (edge1.first == edge2.second && edge1.second == edge2.first);
-}
-
-bool ApplyAreaFeature::FindEdge(TEdge const & edge)
-{
-  for (size_t i = 0; i < m_edges.size(); i++)
-  {
-    if (EqualEdges(m_edges[i].first, edge))
-    {
-      m_edges[i].second = -1;
-      return true;
-    }
-  }
-  return false;
-}
-
-m2::PointD ApplyAreaFeature::CalculateNormal(m2::PointD const & p1, m2::PointD const & p2,
-                                             m2::PointD const & p3) const
-{
-  m2::PointD const tangent = (p2 - p1).Normalize();
-  m2::PointD normal = m2::PointD(-tangent.y, tangent.x);
-  m2::PointD const v = ((p1 + p2) * 0.5 - p3).Normalize();
-  if (m2::DotProduct(normal, v) < 0.0)
-    normal = -normal;
-
-  return normal;
-}
-
-void ApplyAreaFeature::BuildEdges(int vertexIndex1, int vertexIndex2, int vertexIndex3)
-{
-  // Check if triangle is degenerate.
-  if (vertexIndex1 == vertexIndex2 || vertexIndex2 == vertexIndex3 || vertexIndex1 == vertexIndex3)
-    return;
-
-  TEdge edge1 = make_pair(vertexIndex1, vertexIndex2);
-  if (!FindEdge(edge1))
-    m_edges.push_back(make_pair(move(edge1), vertexIndex3));
-
-  TEdge edge2 = make_pair(vertexIndex2, vertexIndex3);
-  if (!FindEdge(edge2))
-    m_edges.push_back(make_pair(move(edge2), vertexIndex1));
-
-  TEdge edge3 = make_pair(vertexIndex3, vertexIndex1);
-  if (!FindEdge(edge3))
-    m_edges.push_back(make_pair(move(edge3), vertexIndex2));
-}
-
-void ApplyAreaFeature::CalculateBuildingOutline(bool calculateNormals, BuildingOutline & outline)
-{
-  outline.m_vertices = move(m_points);
-  outline.m_indices.reserve(m_edges.size() * 2);
-  if (calculateNormals)
-    outline.m_normals.reserve(m_edges.size());
-
-  for (auto & e : m_edges)
-  {
-    if (e.second < 0)
-      continue;
-
-    outline.m_indices.push_back(e.first.first);
-    outline.m_indices.push_back(e.first.second);
-
-    if (calculateNormals)
-    {
-      outline.m_normals.emplace_back(CalculateNormal(outline.m_vertices[e.first.first],
-                                                     outline.m_vertices[e.first.second],
-                                                     outline.m_vertices[e.second]));
-    }
   }
 }
 
@@ -797,9 +711,11 @@ void ApplyAreaFeature::ProcessAreaRule(Stylist::TRuleWrapper const & rule)
                                   areaRule->border().width() > 0.0;
       if (outline.m_generateOutline)
         params.m_outlineColor = ToDrapeColor(areaRule->border().color());
-      bool const calculateNormals = m_posZ > 0.0;
-      CalculateBuildingOutline(calculateNormals, outline);
-      params.m_is3D = !outline.m_indices.empty() && calculateNormals;
+      // Outlines of 3d buildings are calculated with their extrusion by the second
+      // stage of tile reading (see AreaShape::Prepare()).
+      params.m_is3D = m_posZ > 0.0;
+      if (!params.m_is3D)
+        CalculateBuildingOutline(m_triangles, false /* calculateNormals */, outline);
     }
 
     m_insertShape(make_unique_dp<AreaShape>(move(m_triangles), move(outline), params));
@@ -873,7 +789,7 @@ void ApplyLineFeatureGeometry::ProcessLineRule(Stylist::TRuleWrapper const & rul
   if (pLineRule == nullptr)
     return;
 
-  m_clippedSplines = m2::ClipSplineByRect(m_tileRect, m_spline);
+  ClipSpline();
   if (m_clippedSplines.empty())
     return;
 
@@ -905,11 +821,27 @@ void ApplyLineFeatureGeometry::ProcessLineRule(Stylist::TRuleWrapper const & rul
     params.m_baseGtoPScale = m_currentScaleGtoP;
     params.m_zoomLevel = m_tileKey.m_zoomLevel;
 
-    for (auto const & spline : m_clippedSplines)
-      m_insertShape(make_unique_dp<LineShape>(spline, params));
+    if (m_centrelines.empty())
+    {
+      m_centrelines.reserve(m_clippedSplines.size());
+      for (auto const & spline : m_clippedSplines)
+        m_centrelines.push_back(std::make_shared<LineCentreline>(spline, params.m_tileCenter));
+    }
+
+    for (auto const & centreline : m_centrelines)
+      m_insertShape(make_unique_dp<LineShape>(centreline, params));
   }
 }
 
+void ApplyLineFeatureGeometry::ClipSpline()
+{
+  // The tile rect is the same for all rules of the feature.
+  if (m_isClipped)
+    return;
+  m_clippedSplines = m2::ClipSplineByRect(m_tileRect, m_spline);
+  m_isClipped = true;
+}
+
 void ApplyLineFeatureGeometry::Finish()
 {
 #ifdef CALC_FILTERED_POINTS
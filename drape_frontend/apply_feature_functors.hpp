@@ -15,6 +15,7 @@
 #include "geometry/polyline2d.hpp"
 #include "geometry/spline.hpp"
 
+#include <memory>
 #include <vector>
 
 class CaptionDefProto;
@@ -30,10 +31,9 @@ class TextureManager;
 
 namespace df
 {
-
 struct TextViewParams;
+class LineCentreline;
 class MapShape;
-struct BuildingOutline;
 
 using TInsertShapeFn = function<void(drape_ptr<MapShape> && shape)>;
 
@@ -119,21 +119,10 @@ public:
   void ProcessAreaRule(Stylist::TRuleWrapper const & rule);
 
 private:
-  using TEdge = pair<int, int>;
-
   void ProcessBuildingPolygon(m2::PointD const & p1, m2::PointD const & p2, m2::PointD const & p3);
-  void CalculateBuildingOutline(bool calculateNormals, BuildingOutline & outline);
-  int GetIndex(m2::PointD const & pt);
-  void BuildEdges(int vertexIndex1, int vertexIndex2, int vertexIndex3);
-  bool EqualEdges(TEdge const & edge1, TEdge const & edge2) const;
-  bool FindEdge(TEdge const & edge);
-  m2::PointD CalculateNormal(m2::PointD const & p1, m2::PointD const & p2, m2::PointD const & p3) const;
 
   std::vector<m2::PointD> m_triangles;
 
-  buffer_vector<m2::PointD, kBuildingOutlineSize> m_points;
-  buffer_vector<pair<TEdge, int>, kBuildingOutlineSize> m_edges;
-
   float const m_minPosZ;
   bool const m_isBuilding;
   bool const m_skipAreaGeometry;
@@ -158,8 +147,14 @@ public:
   std::vector<m2::SharedSpline> const & GetClippedSplines() const { return m_clippedSplines; }
 
 private:
+  void ClipSpline();
+
   m2::SharedSpline m_spline;
   std::vector<m2::SharedSpline> m_clippedSplines;
+  bool m_isClipped = false;
+  // Centrelines of the clipped splines are shared by line shapes of all
+  // line rules of the feature.
+  std::vector<std::shared_ptr<LineCentreline const>> m_centrelines;
   float m_currentScaleGtoP;
   double m_sqrScale;
   m2::PointD m_lastAddedPoint;
@@ -16,15 +16,166 @@
 
 namespace df
 {
+namespace
+{
+using TEdge = pair<int, int>;
+using TEdges = buffer_vector<pair<TEdge, int>, kBuildingOutlineSize>;
+
+int GetIndex(m2::PointD const & pt, BuildingOutline & outline)
+{
+  auto & points = outline.m_vertices;
+  for (size_t i = 0; i < points.size(); i++)
+  {
+    if (pt.EqualDxDy(points[i], 1e-7))
+      return static_cast<int>(i);
+  }
+  points.push_back(pt);
+  return static_cast<int>(points.size()) - 1;
+}
+
+bool EqualEdges(TEdge const & edge1, TEdge const & edge2)
+{
+  return (edge1.first == edge2.first && edge1.second == edge2.second) ||
+         (edge1.first == edge2.second && edge1.second == edge2.first);
+}
+
+bool FindEdge(TEdge const & edge, TEdges & edges)
+{
+  for (size_t i = 0; i < edges.size(); i++)
+  {
+    if (EqualEdges(edges[i].first, edge))
+    {
+      edges[i].second = -1;
+      return true;
+    }
+  }
+  return false;
+}
+
+void BuildEdges(int vertexIndex1, int vertexIndex2, int vertexIndex3, TEdges & edges)
+{
+  // Check if triangle is degenerate.
+  if (vertexIndex1 == vertexIndex2 || vertexIndex2 == vertexIndex3 || vertexIndex1 == vertexIndex3)
+    return;
+
+  TEdge edge1 = make_pair(vertexIndex1, vertexIndex2);
+  if (!FindEdge(edge1, edges))
+    edges.push_back(make_pair(move(edge1), vertexIndex3));
+
+  TEdge edge2 = make_pair(vertexIndex2, vertexIndex3);
+  if (!FindEdge(edge2, edges))
+    edges.push_back(make_pair(move(edge2), vertexIndex1));
+
+  TEdge edge3 = make_pair(vertexIndex3, vertexIndex1);
+  if (!FindEdge(edge3, edges))
+    edges.push_back(make_pair(move(edge3), vertexIndex2));
+}
+
+m2::PointD CalculateNormal(m2::PointD const & p1, m2::PointD const & p2, m2::PointD const & p3)
+{
+  m2::PointD const tangent = (p2 - p1).Normalize();
+  m2::PointD normal = m2::PointD(-tangent.y, tangent.x);
+  m2::PointD const v = ((p1 + p2) * 0.5 - p3).Normalize();
+  if (m2::DotProduct(normal, v) < 0.0)
+    normal = -normal;
+
+  return normal;
+}
+}  // namespace
+
+void CalculateBuildingOutline(vector<m2::PointD> const & triangles, bool calculateNormals,
+                              BuildingOutline & outline)
+{
+  ASSERT_EQUAL(triangles.size() % 3, 0, ());
+
+  TEdges edges;
+  for (size_t i = 0; i + 2 < triangles.size(); i += 3)
+  {
+    BuildEdges(GetIndex(triangles[i], outline), GetIndex(triangles[i + 1], outline),
+               GetIndex(triangles[i + 2], outline), edges);
+  }
+
+  outline.m_indices.reserve(edges.size() * 2);
+  if (calculateNormals)
+    outline.m_normals.reserve(edges.size());
+
+  for (auto & e : edges)
+  {
+    if (e.second < 0)
+      continue;
+
+    outline.m_indices.push_back(e.first.first);
+    outline.m_indices.push_back(e.first.second);
+
+    if (calculateNormals)
+    {
+      outline.m_normals.emplace_back(CalculateNormal(outline.m_vertices[e.first.first],
+                                                     outline.m_vertices[e.first.second],
+                                                     outline.m_vertices[e.second]));
+    }
+  }
+}
+
 AreaShape::AreaShape(vector<m2::PointD> && triangleList, BuildingOutline && buildingOutline,
                      AreaViewParams const & params)
   : m_vertexes(move(triangleList))
   , m_buildingOutline(move(buildingOutline))
   , m_params(params)
+  , m_is3D(params.m_is3D)
 {}
 
+MapShapeType AreaShape::GetType() const
+{
+  return m_params.m_is3D ? MapShapeType::Geometry3dType : MapShapeType::GeometryType;
+}
+
+void AreaShape::Prepare(ref_ptr<dp::TextureManager> /* textures */) const
+{
+  if (!m_params.m_is3D || m_isPrepared)
+    return;
+  m_isPrepared = true;
+
+  CalculateBuildingOutline(m_vertexes, true /* calculateNormals */, m_buildingOutline);
+  m_is3D = !m_buildingOutline.m_indices.empty();
+  if (!m_is3D)
+    return;
+
+  m_vertexes3d.reserve(m_vertexes.size() + m_buildingOutline.m_normals.size() * 6);
+
+  glsl::vec2 const uv(0.0f, 0.0f);
+  for (size_t i = 0; i < m_buildingOutline.m_normals.size(); i++)
+  {
+    int const startIndex = m_buildingOutline.m_indices[i * 2];
+    int const endIndex = m_buildingOutline.m_indices[i * 2 + 1];
+
+    glsl::vec2 const startPt = glsl::ToVec2(ConvertToLocal(m_buildingOutline.m_vertices[startIndex],
+                                                           m_params.m_tileCenter, kShapeCoordScalar));
+    glsl::vec2 const endPt = glsl::ToVec2(ConvertToLocal(m_buildingOutline.m_vertices[endIndex],
+                                                         m_params.m_tileCenter, kShapeCoordScalar));
+
+    glsl::vec3 normal(glsl::ToVec2(m_buildingOutline.m_normals[i]), 0.0f);
+    m_vertexes3d.emplace_back(gpu::Area3dVertex(glsl::vec3(startPt, -m_params.m_minPosZ), normal, uv));
+    m_vertexes3d.emplace_back(gpu::Area3dVertex(glsl::vec3(endPt, -m_params.m_minPosZ), normal, uv));
+    m_vertexes3d.emplace_back(gpu::Area3dVertex(glsl::vec3(startPt, -m_params.m_posZ), normal, uv));
+
+    m_vertexes3d.emplace_back(gpu::Area3dVertex(glsl::vec3(startPt, -m_params.m_posZ), normal, uv));
+    m_vertexes3d.emplace_back(gpu::Area3dVertex(glsl::vec3(endPt, -m_params.m_minPosZ), normal, uv));
+    m_vertexes3d.emplace_back(gpu::Area3dVertex(glsl::vec3(endPt, -m_params.m_posZ), normal, uv));
+  }
+
+  glsl::vec3 const normal(0.0f, 0.0f, -1.0f);
+  for (auto const & vertex : m_vertexes)
+  {
+    glsl::vec2 const pt = glsl::ToVec2(ConvertToLocal(vertex, m_params.m_tileCenter, kShapeCoordScalar));
+    m_vertexes3d.emplace_back(gpu::Area3dVertex(glsl::vec3(pt, -m_params.m_posZ), normal, uv));
+  }
+}
+
 void AreaShape::Draw(ref_ptr<dp::Batcher> batcher, ref_ptr<dp::TextureManager> textures) const
 {
+  // Does nothing if the shape is prepared already.
+  Prepare(textures);
+
   dp::TextureManager::ColorRegion region;
   textures->GetColorRegion(m_params.m_color, region);
   m2::PointD const colorUv = region.GetTexRect().Center();
@@ -37,7 +188,7 @@ void AreaShape::Draw(ref_ptr<dp::Batcher> batcher, ref_ptr<dp::TextureManager> t
     outlineUv = outlineRegion.GetTexRect().Center();
   }
 
-  if (m_params.m_is3D)
+  if (m_is3D)
     DrawArea3D(batcher, colorUv, outlineUv, region.GetTexture());
   else if (m_params.m_hatching)
     DrawHatchingArea(batcher, colorUv, region.GetTexture(), textures->GetHatchingTexture());
@@ -125,47 +276,18 @@ void AreaShape::DrawHatchingArea(ref_ptr<dp::Batcher> batcher, m2::PointD const
 void AreaShape::DrawArea3D(ref_ptr<dp::Batcher> batcher, m2::PointD const & colorUv, m2::PointD const & outlineUv,
                            ref_ptr<dp::Texture> texture) const
 {
-  ASSERT(!m_buildingOutline.m_indices.empty(), ());
-  ASSERT(!m_buildingOutline.m_normals.empty(), ());
+  ASSERT(!m_vertexes3d.empty(), ());
 
   glsl::vec2 const uv = glsl::ToVec2(colorUv);
-
-  vector<gpu::Area3dVertex> vertexes;
-  vertexes.reserve(m_vertexes.size() + m_buildingOutline.m_normals.size() * 6);
-
-  for (size_t i = 0; i < m_buildingOutline.m_normals.size(); i++)
-  {
-    int const startIndex = m_buildingOutline.m_indices[i * 2];
-    int const endIndex = m_buildingOutline.m_indices[i * 2 + 1];
-
-    glsl::vec2 const startPt = glsl::ToVec2(ConvertToLocal(m_buildingOutline.m_vertices[startIndex],
-                                                           m_params.m_tileCenter, kShapeCoordScalar));
-    glsl::vec2 const endPt = glsl::ToVec2(ConvertToLocal(m_buildingOutline.m_vertices[endIndex],
-                                                         m_params.m_tileCenter, kShapeCoordScalar));
-
-    glsl::vec3 normal(glsl::ToVec2(m_buildingOutline.m_normals[i]), 0.0f);
-    vertexes.emplace_back(gpu::Area3dVertex(glsl::vec3(startPt, -m_params.m_minPosZ), normal, uv));
-    vertexes.emplace_back(gpu::Area3dVertex(glsl::vec3(endPt, -m_params.m_minPosZ), normal, uv));
-    vertexes.emplace_back(gpu::Area3dVertex(glsl::vec3(startPt, -m_params.m_posZ), normal, uv));
-
-    vertexes.emplace_back(gpu::Area3dVertex(glsl::vec3(startPt, -m_params.m_posZ), normal, uv));
-    vertexes.emplace_back(gpu::Area3dVertex(glsl::vec3(endPt, -m_params.m_minPosZ), normal, uv));
-    vertexes.emplace_back(gpu::Area3dVertex(glsl::vec3(endPt, -m_params.m_posZ), normal, uv));
-  }
-
-  glsl::vec3 const normal(0.0f, 0.0f, -1.0f);
-  for (auto const & vertex : m_vertexes)
-  {
-    glsl::vec2 const pt = glsl::ToVec2(ConvertToLocal(vertex, m_params.m_tileCenter, kShapeCoordScalar));
-    vertexes.emplace_back(gpu::Area3dVertex(glsl::vec3(pt, -m_params.m_posZ), normal, uv));
-  }
+  for (auto & vertex : m_vertexes3d)
+    vertex.m_colorTexCoord = uv;
 
   auto state = CreateGLState(gpu::AREA_3D_PROGRAM, RenderState::Geometry3dLayer);
   state.SetColorTexture(texture);
   state.SetBlending(dp::Blending(false /* isEnabled */));
 
-  dp::AttributeProvider provider(1, static_cast<uint32_t>(vertexes.size()));
-  provider.InitStream(0, gpu::Area3dVertex::GetBindingInfo(), make_ref(vertexes.data()));
+  dp::AttributeProvider provider(1, static_cast<uint32_t>(m_vertexes3d.size()));
+  provider.InitStream(0, gpu::Area3dVertex::GetBindingInfo(), make_ref(m_vertexes3d.data()));
   batcher->InsertTriangleList(state, make_ref(&provider));
 
   // Generate outline.
@@ -4,6 +4,7 @@
 #include "drape_frontend/shape_view_params.hpp"
 
 #include "drape/pointers.hpp"
+#include "drape/utils/vertex_decl.hpp"
 
 #include "geometry/point2d.hpp"
 #include "std/vector.hpp"
@@ -19,13 +20,22 @@ struct BuildingOutline
   bool m_generateOutline = false;
 };
 
+// Reconstructs the outline of a building from its triangles. Normals of the edges are
+// calculated for extrusion of 3d buildings only.
+void CalculateBuildingOutline(vector<m2::PointD> const & triangles, bool calculateNormals,
+                              BuildingOutline & outline);
+
 class AreaShape : public MapShape
 {
 public:
   AreaShape(vector<m2::PointD> && triangleList, BuildingOutline && buildingOutline,
             AreaViewParams const & params);
 
+  // The outline and the extrusion of a 3d building are heavy, so they are generated
+  // here by the second stage of tile reading, after flat geometry is shown.
+  void Prepare(ref_ptr<dp::TextureManager> textures) const override;
   void Draw(ref_ptr<dp::Batcher> batcher, ref_ptr<dp::TextureManager> textures) const override;
+  MapShapeType GetType() const override;
 
 private:
   void DrawArea(ref_ptr<dp::Batcher> batcher, m2::PointD const & colorUv,
@@ -36,8 +46,14 @@ private:
                         ref_ptr<dp::Texture> texture, ref_ptr<dp::Texture> hatchingTexture) const;
 
   vector<m2::PointD> m_vertexes;
-  BuildingOutline m_buildingOutline;
+  mutable BuildingOutline m_buildingOutline;
   AreaViewParams m_params;
+
+  // A 3d building is drawn flat if its outline is empty.
+  mutable bool m_is3D;
+  mutable bool m_isPrepared = false;
+  // Extruded vertices of the 3d building, texture coordinates are set on drawing.
+  mutable vector<gpu::Area3dVertex> m_vertexes3d;
 };
 
 } // namespace df
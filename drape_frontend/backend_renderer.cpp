@@ -15,9 +15,13 @@
 
 #include "drape/texture_manager.hpp"
 
+#include "indexer/map_style_reader.hpp"
 #include "indexer/scales.hpp"
 
 #include "platform/platform.hpp"
+#include "platform/preferred_languages.hpp"
+
+#include "coding/file_name_utils.hpp"
 
 #include "base/logging.hpp"
 
@@ -30,12 +34,19 @@ BackendRenderer::BackendRenderer(Params && params)
   : BaseRenderer(ThreadsCommutator::ResourceUploadThread, params)
   , m_model(params.m_model)
   , m_readManager(make_unique_dp<ReadManager>(params.m_commutator, m_model,
-                                              params.m_allow3dBuildings, params.m_trafficEnabled))
+                                              params.m_allow3dBuildings, params.m_trafficEnabled,
+                                              bind(&BackendRenderer::UploadCachedGeometry, this, _1, _2, _3),
+                                              params.m_isTileGeometryCacheEnabled ?
+                                                  ReadManager::TStartPrefetchingFn(
+                                                      bind(&BackendRenderer::StartPrefetchingGeometry,
+                                                           this, _1, _2, _3)) :
+                                                  ReadManager::TStartPrefetchingFn()))
   , m_trafficGenerator(make_unique_dp<TrafficGenerator>(bind(&BackendRenderer::FlushTrafficRenderData, this, _1)))
   , m_userMarkGenerator(make_unique_dp<UserMarkGenerator>(bind(&BackendRenderer::FlushUserMarksRenderData, this, _1)))
   , m_requestedTiles(params.m_requestedTiles)
   , m_updateCurrentCountryFn(params.m_updateCurrentCountryFn)
   , m_metalineManager(make_unique_dp<MetalineManager>(params.m_commutator, m_model))
+  , m_isTileGeometryCacheEnabled(params.m_isTileGeometryCacheEnabled)
 {
 #ifdef DEBUG
   m_isTeardowned = false;
@@ -117,6 +128,7 @@ void BackendRenderer::AcceptMessage(ref_ptr<Message> message)
         m_requestedTiles->GetParams(screen, have3dBuildings, forceRequest, forceUserMarksRequest);
         m_readManager->UpdateCoverage(screen, have3dBuildings, forceRequest, forceUserMarksRequest,
                                       tiles, m_texMng, make_ref(m_metalineManager));
+        DropCancelledPrefetching();
         m_updateCurrentCountryFn(screen.ClipRect().Center(), (*tiles.begin()).m_zoomLevel);
       }
       break;
@@ -125,6 +137,7 @@ void BackendRenderer::AcceptMessage(ref_ptr<Message> message)
   case Message::InvalidateReadManagerRect:
     {
       ref_ptr<InvalidateReadManagerRectMessage> msg = message;
+      InvalidateGeometryCache(msg->GetTilesForInvalidate(), msg->NeedRestartReading());
       if (msg->NeedRestartReading())
         m_readManager->Restart();
       else
@@ -161,15 +174,34 @@ void BackendRenderer::AcceptMessage(ref_ptr<Message> message)
   case Message::TileReadStarted:
     {
       ref_ptr<TileReadStartMessage> msg = message;
-      m_batchersPool->ReserveBatcher(msg->GetKey());
+      if (msg->IsPrefetch())
+        m_prefetchBatchersPool->ReserveBatcher(msg->GetKey());
+      else
+        m_batchersPool->ReserveBatcher(msg->GetKey());
+      break;
+    }
+
+  case Message::TileReadFlushed:
+    {
+      ref_ptr<TileReadFlushMessage> msg = message;
+      m_batchersPool->FlushBatcher(msg->GetKey());
       break;
     }
 
   case Message::TileReadEnded:
     {
       ref_ptr<TileReadEndMessage> msg = message;
-      m_batchersPool->ReleaseBatcher(msg->GetKey());
-      m_userMarkGenerator->GenerateUserMarksGeometry(msg->GetKey(), m_texMng);
+      auto const & tileKey = msg->GetKey();
+      if (msg->IsPrefetch())
+      {
+        m_prefetchBatchersPool->ReleaseBatcher(tileKey);
+        FinishCachingGeometry(m_prefetchingGeometry, tileKey,
+                              m_readManager->IsPrefetchTileKey(tileKey));
+        break;
+      }
+      m_batchersPool->ReleaseBatcher(tileKey);
+      FinishCachingGeometry(m_cachingGeometry, tileKey, m_readManager->CheckTileKey(tileKey));
+      m_userMarkGenerator->GenerateUserMarksGeometry(tileKey, m_texMng);
       break;
     }
 
@@ -190,6 +222,9 @@ void BackendRenderer::AcceptMessage(ref_ptr<Message> message)
 
   case Message::FinishReading:
     {
+      // All tiles are read, so geometry of cancelled ones is dropped.
+      m_cachingGeometry.clear();
+
       TOverlaysRenderData overlays;
       overlays.swap(m_overlays);
       m_commutator->PostMessage(ThreadsCommutator::RenderThread,
@@ -208,9 +243,14 @@ void BackendRenderer::AcceptMessage(ref_ptr<Message> message)
     {
       ref_ptr<MapShapeReadedMessage> msg = message;
       auto const & tileKey = msg->GetKey();
-      if (m_requestedTiles->CheckTileKey(tileKey) && m_readManager->CheckTileKey(tileKey))
+      bool const isPrefetch = msg->IsPrefetch();
+      bool const isActual = isPrefetch ? m_readManager->IsPrefetchTileKey(tileKey) :
+                                         m_requestedTiles->CheckTileKey(tileKey) &&
+                                         m_readManager->CheckTileKey(tileKey);
+      if (isActual)
       {
-        ref_ptr<dp::Batcher> batcher = m_batchersPool->GetBatcher(tileKey);
+        ref_ptr<dp::Batcher> batcher = isPrefetch ? m_prefetchBatchersPool->GetBatcher(tileKey) :
+                                                    m_batchersPool->GetBatcher(tileKey);
 #if defined(DRAPE_MEASURER) && defined(GENERATING_STATISTIC)
         DrapeMeasurer::Instance().StartShapesGeneration();
 #endif
@@ -223,6 +263,14 @@ void BackendRenderer::AcceptMessage(ref_ptr<Message> message)
         DrapeMeasurer::Instance().EndShapesGeneration(static_cast<uint32_t>(msg->GetShapes().size()));
 #endif
       }
+      else
+      {
+        // Geometry of the tile is incomplete.
+        if (isPrefetch)
+          m_prefetchingGeometry.erase(tileKey);
+        else
+          m_cachingGeometry.erase(tileKey);
+      }
       break;
     }
 
@@ -328,6 +376,7 @@ void BackendRenderer::AcceptMessage(ref_ptr<Message> message)
   case Message::SwitchMapStyle:
     {
       m_texMng->OnSwitchMapStyle();
+      InvalidateGeometryCache(TTilesCollection(), true /* invalidateAll */);
       RecacheMapShapes();
       m_trafficGenerator->InvalidateTexturesCache();
       break;
@@ -394,10 +443,21 @@ void BackendRenderer::AcceptMessage(ref_ptr<Message> message)
   case Message::UpdateTraffic:
     {
       ref_ptr<UpdateTrafficMessage> msg = message;
-      m_trafficGenerator->UpdateColoring(msg->GetSegmentsColoring());
-      m_commutator->PostMessage(ThreadsCommutator::RenderThread,
-                                make_unique_dp<RegenerateTrafficMessage>(),
-                                MessagePriority::Normal);
+      auto const & coloring = msg->GetSegmentsColoring();
+      if (m_trafficGenerator->UpdateColoring(coloring))
+      {
+        // The same segments are visible, so only their colors are updated.
+        m_commutator->PostMessage(ThreadsCommutator::RenderThread,
+                                  make_unique_dp<UpdateTrafficColorsMessage>(
+                                      coloring, m_trafficGenerator->GetTexCoords(m_texMng)),
+                                  MessagePriority::Normal);
+      }
+      else
+      {
+        m_commutator->PostMessage(ThreadsCommutator::RenderThread,
+                                  make_unique_dp<RegenerateTrafficMessage>(),
+                                  MessagePriority::Normal);
+      }
       break;
     }
 
@@ -449,11 +509,15 @@ void BackendRenderer::AcceptMessage(ref_ptr<Message> message)
   case Message::SetCustomFeatures:
     {
       ref_ptr<SetCustomFeaturesMessage> msg = message;
-      if (m_readManager->SetCustomFeatures(msg->AcceptFeatures()))
+      bool const changed = msg->IsMwmOnly()
+                           ? m_readManager->SetCustomFeatures(msg->GetMwmId(), msg->AcceptFeatures())
+                           : m_readManager->SetCustomFeatures(msg->AcceptFeatures());
+      if (changed)
       {
         m_commutator->PostMessage(ThreadsCommutator::RenderThread,
                                   make_unique_dp<UpdateCustomFeaturesMessage>(
-                                    m_readManager->GetCustomFeaturesArray()),
+                                    m_readManager->GetCustomFeaturesArray(),
+                                    msg->AcceptChangedPositions()),
                                   MessagePriority::Normal);
       }
       break;
@@ -491,6 +555,13 @@ void BackendRenderer::AcceptMessage(ref_ptr<Message> message)
       break;
     }
 
+  case Message::ShrinkCaches:
+    {
+      if (m_geometryCache != nullptr)
+        m_geometryCache->Clear();
+      break;
+    }
+
   default:
     ASSERT(false, ());
     break;
@@ -504,6 +575,10 @@ void BackendRenderer::ReleaseResources()
   m_readManager.reset();
   m_metalineManager.reset();
   m_batchersPool.reset();
+  m_prefetchBatchersPool.reset();
+  m_cachingGeometry.clear();
+  m_prefetchingGeometry.clear();
+  m_geometryCache.reset();
   m_routeBuilder.reset();
   m_overlays.clear();
   m_trafficGenerator.reset();
@@ -530,6 +605,10 @@ void BackendRenderer::OnContextDestroy()
   LOG(LINFO, ("On context destroy."));
   m_readManager->Stop();
   m_batchersPool.reset();
+  m_prefetchBatchersPool.reset();
+  m_cachingGeometry.clear();
+  m_prefetchingGeometry.clear();
+  m_geometryCache.reset();
   m_metalineManager->Stop();
   m_texMng->Release();
   m_overlays.clear();
@@ -557,9 +636,32 @@ void BackendRenderer::Routine::Do()
 void BackendRenderer::InitGLDependentResource()
 {
   uint32_t constexpr kBatchSize = 5000;
-  m_batchersPool = make_unique_dp<BatchersPool<TileKey, TileKeyStrictComparator>>(kReadingThreadsCount,
-                                               bind(&BackendRenderer::FlushGeometry, this, _1, _2, _3),
-                                               kBatchSize, kBatchSize);
+  using TBatchersPool = BatchersPool<TileKey, TileKeyStrictComparator>;
+  TBatchersPool::TPreflushFn preflushFn;
+  if (m_isTileGeometryCacheEnabled)
+  {
+    // Textures are recreated along with the context, so the cache is too.
+    TileGeometryCache::Params cacheParams;
+    cacheParams.m_spillDir = my::JoinPath(GetPlatform().TmpDir(), "tile_geometry");
+    m_geometryCache = make_unique_dp<TileGeometryCache>(cacheParams);
+    preflushFn = [this](TileKey const & key, dp::GLState const & state,
+                        ref_ptr<dp::RenderBucket> buffer)
+    {
+      CacheGeometry(m_cachingGeometry, key, state, buffer);
+    };
+
+    // Buckets of prefetched tiles are dropped after caching.
+    m_prefetchBatchersPool = make_unique_dp<TBatchersPool>(
+        1, [](TileKey const &, dp::GLState const &, drape_ptr<dp::RenderBucket> &&) {},
+        kBatchSize, kBatchSize,
+        [this](TileKey const & key, dp::GLState const & state, ref_ptr<dp::RenderBucket> buffer)
+        {
+          CacheGeometry(m_prefetchingGeometry, key, state, buffer);
+        });
+  }
+  m_batchersPool = make_unique_dp<TBatchersPool>(kReadingThreadsCount,
+                                                 bind(&BackendRenderer::FlushGeometry, this, _1, _2, _3),
+                                                 kBatchSize, kBatchSize, preflushFn);
   m_trafficGenerator->Init();
 
   dp::TextureManager::Params params;
@@ -578,6 +680,9 @@ void BackendRenderer::InitGLDependentResource()
   params.m_glyphMngParams.m_sdfScale = VisualParams::Instance().GetGlyphSdfScale();
   params.m_glyphMngParams.m_baseGlyphHeight = VisualParams::Instance().GetGlyphBaseSize();
   GetPlatform().GetFontNames(params.m_glyphMngParams.m_fonts);
+  // Glyphs depend on the language, so every language has its own list.
+  params.m_glyphsWarmUpFile = my::JoinPath(GetPlatform().WritableDir(),
+                                           "glyphs_" + languages::GetCurrentNorm() + ".txt");
 
   m_texMng->Init(params);
 
@@ -607,6 +712,103 @@ void BackendRenderer::FlushGeometry(TileKey const & key, dp::GLState const & sta
                             MessagePriority::Normal);
 }
 
+bool BackendRenderer::UploadCachedGeometry(TileKey const & tileKey, bool is3dBuildings,
+                                           bool isTrafficEnabled)
+{
+  if (m_geometryCache == nullptr)
+    return false;
+
+  m_cachingGeometry.erase(tileKey);
+
+  TileGeometryCache::Key const key(tileKey, GetStyleReader().GetCurrentStyle(), is3dBuildings,
+                                   isTrafficEnabled);
+  auto const buckets = m_geometryCache->Get(key);
+  if (buckets == nullptr)
+  {
+    m_cachingGeometry.emplace(tileKey, CachingTileGeometry(key));
+    return false;
+  }
+
+  for (auto const & bucket : *buckets)
+    FlushGeometry(tileKey, bucket.m_state, TileGeometryCache::CreateRenderBucket(bucket));
+  return true;
+}
+
+bool BackendRenderer::StartPrefetchingGeometry(TileKey const & tileKey, bool is3dBuildings,
+                                               bool isTrafficEnabled)
+{
+  if (m_geometryCache == nullptr)
+    return false;
+
+  TileGeometryCache::Key const key(tileKey, GetStyleReader().GetCurrentStyle(), is3dBuildings,
+                                   isTrafficEnabled);
+  if (m_geometryCache->Contains(key))
+    return false;
+
+  m_prefetchingGeometry.erase(tileKey);
+  m_prefetchingGeometry.emplace(tileKey, CachingTileGeometry(key));
+  return true;
+}
+
+void BackendRenderer::CacheGeometry(TCachingGeometry & cachingGeometry, TileKey const & key,
+                                    dp::GLState const & state, ref_ptr<dp::RenderBucket> buffer)
+{
+  auto it = cachingGeometry.find(key);
+  if (it == cachingGeometry.end() || !it->second.m_isCacheable)
+    return;
+
+  auto & buckets = it->second.m_buckets;
+  buckets.emplace_back(state);
+  if (!TileGeometryCache::CopyBucket(state, buffer, buckets.back()))
+  {
+    it->second.m_isCacheable = false;
+    buckets.clear();
+  }
+}
+
+void BackendRenderer::FinishCachingGeometry(TCachingGeometry & cachingGeometry,
+                                            TileKey const & key, bool isActual)
+{
+  auto it = cachingGeometry.find(key);
+  if (it == cachingGeometry.end())
+    return;
+
+  // Geometry of a cancelled tile may be incomplete.
+  if (it->second.m_isCacheable && isActual)
+    m_geometryCache->Put(it->second.m_key, std::move(it->second.m_buckets));
+  cachingGeometry.erase(it);
+}
+
+void BackendRenderer::DropCancelledPrefetching()
+{
+  // Tasks of tiles which are cancelled before reading don't report the end.
+  for (auto it = m_prefetchingGeometry.begin(); it != m_prefetchingGeometry.end();)
+  {
+    if (m_readManager->IsPrefetchTileKey(it->first))
+      ++it;
+    else
+      it = m_prefetchingGeometry.erase(it);
+  }
+}
+
+void BackendRenderer::InvalidateGeometryCache(TTilesCollection const & tiles, bool invalidateAll)
+{
+  m_cachingGeometry.clear();
+  m_prefetchingGeometry.clear();
+  if (m_geometryCache == nullptr)
+    return;
+
+  if (invalidateAll)
+  {
+    m_geometryCache->Clear();
+    return;
+  }
+
+  // Cached tiles of other zoom levels are affected too.
+  for (auto const & tileKey : tiles)
+    m_geometryCache->Erase(tileKey.GetGlobalRect());
+}
+
 void BackendRenderer::FlushTrafficRenderData(TrafficRenderData && renderData)
 {
   m_commutator->PostMessage(ThreadsCommutator::RenderThread,
@@ -8,12 +8,15 @@
 #include "drape_frontend/map_data_provider.hpp"
 #include "drape_frontend/overlay_batcher.hpp"
 #include "drape_frontend/requested_tiles.hpp"
+#include "drape_frontend/tile_geometry_cache.hpp"
 #include "drape_frontend/traffic_generator.hpp"
 #include "drape_frontend/user_mark_generator.hpp"
 
 #include "drape/pointers.hpp"
 #include "drape/viewport.hpp"
 
+#include <map>
+
 namespace dp
 {
 class OGLContextFactory;
@@ -55,6 +58,7 @@ public:
     bool m_allow3dBuildings;
     bool m_trafficEnabled;
     bool m_simplifiedTrafficColors;
+    bool m_isTileGeometryCacheEnabled = false;
   };
 
   BackendRenderer(Params && params);
@@ -95,6 +99,10 @@ private:
   void InitGLDependentResource();
   void FlushGeometry(TileKey const & key, dp::GLState const & state, drape_ptr<dp::RenderBucket> && buffer);
 
+  bool UploadCachedGeometry(TileKey const & tileKey, bool is3dBuildings, bool isTrafficEnabled);
+  bool StartPrefetchingGeometry(TileKey const & tileKey, bool is3dBuildings, bool isTrafficEnabled);
+  void InvalidateGeometryCache(TTilesCollection const & tiles, bool invalidateAll);
+
   void FlushTrafficRenderData(TrafficRenderData && renderData);
   void FlushUserMarksRenderData(TUserMarksRenderData && renderData);
 
@@ -102,6 +110,9 @@ private:
 
   MapDataProvider m_model;
   drape_ptr<BatchersPool<TileKey, TileKeyStrictComparator>> m_batchersPool;
+  // Batchers of tiles which are read ahead of the viewport. Their buckets
+  // are cached only and aren't sent to the frontend.
+  drape_ptr<BatchersPool<TileKey, TileKeyStrictComparator>> m_prefetchBatchersPool;
   drape_ptr<ReadManager> m_readManager;
   drape_ptr<RouteBuilder> m_routeBuilder;
   drape_ptr<TrafficGenerator> m_trafficGenerator;
@@ -117,6 +128,30 @@ private:
 
   drape_ptr<MetalineManager> m_metalineManager;
 
+  // Geometry of a tile which is being read, it's put to the cache when
+  // reading is finished.
+  struct CachingTileGeometry
+  {
+    explicit CachingTileGeometry(TileGeometryCache::Key const & key) : m_key(key) {}
+
+    TileGeometryCache::Key m_key;
+    TileGeometryCache::TBuckets m_buckets;
+    bool m_isCacheable = true;
+  };
+  using TCachingGeometry = std::map<TileKey, CachingTileGeometry, TileKeyStrictComparator>;
+
+  void CacheGeometry(TCachingGeometry & cachingGeometry, TileKey const & key,
+                     dp::GLState const & state, ref_ptr<dp::RenderBucket> buffer);
+  // Puts geometry of the tile to the cache if the tile is still |isActual|.
+  void FinishCachingGeometry(TCachingGeometry & cachingGeometry, TileKey const & key,
+                             bool isActual);
+  void DropCancelledPrefetching();
+
+  bool const m_isTileGeometryCacheEnabled;
+  drape_ptr<TileGeometryCache> m_geometryCache;
+  TCachingGeometry m_cachingGeometry;
+  TCachingGeometry m_prefetchingGeometry;
+
 #ifdef DEBUG
   bool m_isTeardowned;
 #endif
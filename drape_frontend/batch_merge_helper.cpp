@@ -4,8 +4,62 @@
 #include "drape/render_bucket.hpp"
 #include "drape/vertex_array_buffer.hpp"
 
+#include "drape_frontend/shape_view_params.hpp"
+
+#include <cstring>
+
 namespace df
 {
+namespace
+{
+uint32_t constexpr kIndexBufferSize = 30000;
+uint32_t constexpr kVertexBufferSize = 20000;
+
+using TBuffer = dp::VertexArrayBuffer;
+using TBucket = dp::RenderBucket;
+
+bool IsPositionDecl(dp::BindingDecl const & decl)
+{
+  return decl.m_attributeName == "a_position" && decl.m_componentType == gl_const::GLFloatType &&
+         decl.m_componentCount >= 2;
+}
+
+template <typename TBuffersMap>
+bool HasPosition(TBuffersMap const & buffers)
+{
+  for (auto const & vboNode : buffers)
+  {
+    dp::BindingInfo const & binding = vboNode.first;
+    for (uint16_t i = 0; i < binding.GetCount(); ++i)
+    {
+      if (IsPositionDecl(binding.GetBindingDecl(i)))
+        return true;
+    }
+  }
+  return false;
+}
+
+void ShiftPositions(dp::BindingInfo const & binding, uint8_t * data, uint32_t vertexCount,
+                    glsl::vec2 const & offset)
+{
+  for (uint16_t i = 0; i < binding.GetCount(); ++i)
+  {
+    dp::BindingDecl const & decl = binding.GetBindingDecl(i);
+    if (!IsPositionDecl(decl))
+      continue;
+
+    uint32_t const stride = decl.m_stride != 0 ? decl.m_stride : binding.GetElementSize();
+    for (uint32_t v = 0; v < vertexCount; ++v)
+    {
+      uint8_t * positionPtr = data + v * stride + decl.m_offset;
+      glsl::vec2 position;
+      memcpy(&position, positionPtr, sizeof(position));
+      position += offset;
+      memcpy(positionPtr, &position, sizeof(position));
+    }
+  }
+}
+}  // namespace
 
 void ReadBufferData(void * dst, glConst target, uint32_t size)
 {
@@ -71,41 +125,125 @@ void BatchMergeHelper::MergeBatches(vector<drape_ptr<RenderGroup>> & batches,
     return;
   }
 
-  uint32_t const kIndexBufferSize = 30000;
-  uint32_t const kVertexBufferSize = 20000;
+  std::vector<ref_ptr<RenderGroup>> groups;
+  groups.reserve(batches.size());
+  for (drape_ptr<RenderGroup> const & group : batches)
+    groups.push_back(make_ref(group));
+
+  ref_ptr<RenderGroup> oldGroup = groups.front();
+  CopyBuckets(groups, std::vector<glsl::vec2>(groups.size(), glsl::vec2(0.0f, 0.0f)),
+              [&](drape_ptr<TBucket> && bucket, ref_ptr<TBuffer> buffer)
+  {
+    drape_ptr<RenderGroup> newGroup = make_unique_dp<RenderGroup>(oldGroup->GetState(), oldGroup->GetTileKey());
+    SetupGroup(make_ref(newGroup), oldGroup, move(bucket), buffer, isPerspective);
+    mergedBatches.push_back(move(newGroup));
+  });
+}
+
+drape_ptr<MergedRenderGroup> BatchMergeHelper::MergeTiles(std::vector<ref_ptr<RenderGroup>> const & groups,
+                                                          bool isPerspective)
+{
+  if (groups.size() < 2)
+    return nullptr;
+
+  ref_ptr<RenderGroup> const anchor = groups.front();
+  m2::PointD const anchorCenter = anchor->GetTileKey().GetGlobalRect().Center();
+
+  std::vector<ref_ptr<RenderGroup>> mergedGroups;
+  std::vector<glsl::vec2> offsets;
+  mergedGroups.reserve(groups.size());
+  offsets.reserve(groups.size());
+  for (ref_ptr<RenderGroup> group : groups)
+  {
+    ASSERT(group->GetState() == anchor->GetState(), ());
+    ASSERT_EQUAL(group->GetTileKey().m_zoomLevel, anchor->GetTileKey().m_zoomLevel, ());
+    bool const needShift = !group->GetTileKey().EqualStrict(anchor->GetTileKey());
+    if (!CanBeCopied(group, needShift))
+      continue;
+
+    // Vertices are in the local coordinates of their tile (see MapShape::ConvertToLocal()).
+    m2::PointD const center = group->GetTileKey().GetGlobalRect().Center();
+    mergedGroups.push_back(group);
+    offsets.push_back(glsl::ToVec2((center - anchorCenter) * kShapeCoordScalar));
+  }
+
+  if (mergedGroups.size() < 2)
+    return nullptr;
+
+  drape_ptr<MergedRenderGroup> mergedGroup =
+      make_unique_dp<MergedRenderGroup>(anchor->GetState(), mergedGroups.front()->GetTileKey());
+  CopyBuckets(mergedGroups, offsets, [&](drape_ptr<TBucket> && bucket, ref_ptr<TBuffer> buffer)
+  {
+    SetupGroup(make_ref(mergedGroup), mergedGroups.front(), move(bucket), buffer, isPerspective);
+  });
+
+  for (ref_ptr<RenderGroup> group : mergedGroups)
+    mergedGroup->AddSource(group);
+
+  return mergedGroup;
+}
+
+bool BatchMergeHelper::CanMergeTiles(ref_ptr<RenderGroup> group)
+{
+  return CanBeCopied(group, true /* needShift */);
+}
+
+bool BatchMergeHelper::CanBeCopied(ref_ptr<RenderGroup> group, bool needShift)
+{
+  for (drape_ptr<TBucket> const & b : group->m_renderBuckets)
+  {
+    ref_ptr<TBuffer> buffer = b->GetBuffer();
+    if (!b->m_overlay.empty() || buffer->IsInstanced() ||
+        buffer->GetStartIndexValue() > kVertexBufferSize ||
+        buffer->GetIndexCount() > kIndexBufferSize)
+    {
+      return false;
+    }
+
+    if (needShift && !HasPosition(buffer->m_staticBuffers) && !HasPosition(buffer->m_dynamicBuffers))
+      return false;
+  }
+  return true;
+}
+
+void BatchMergeHelper::SetupGroup(ref_ptr<RenderGroup> group, ref_ptr<RenderGroup> source,
+                                  drape_ptr<TBucket> && bucket, ref_ptr<TBuffer> buffer,
+                                  bool isPerspective)
+{
+  group->m_shader = source->m_shader;
+  group->m_shader3d = source->m_shader3d;
+  group->m_uniforms = source->m_uniforms;
+  group->m_generalUniforms = source->m_generalUniforms;
+  group->AddBucket(move(bucket));
+
+  buffer->Preflush();
+  if (isPerspective)
+    group->m_shader3d->Bind();
+  else
+    group->m_shader->Bind();
+  buffer->Build(isPerspective ? group->m_shader3d : group->m_shader);
+}
 
-  using TBuffer = dp::VertexArrayBuffer;
-  using TBucket = dp::RenderBucket;
+void BatchMergeHelper::CopyBuckets(std::vector<ref_ptr<RenderGroup>> const & groups,
+                                   std::vector<glsl::vec2> const & offsets, TFlushFn const & flushBucketFn)
+{
+  ASSERT_EQUAL(groups.size(), offsets.size(), ());
 
   auto flushFn = [&](drape_ptr<TBucket> && bucket, ref_ptr<TBuffer> buffer)
   {
     if (buffer->GetIndexCount() == 0)
       return;
-
-    ref_ptr<RenderGroup> oldGroup = make_ref(batches.front());
-    drape_ptr<RenderGroup> newGroup = make_unique_dp<RenderGroup>(oldGroup->GetState(), oldGroup->GetTileKey());
-    newGroup->m_shader = oldGroup->m_shader;
-    newGroup->m_shader3d = oldGroup->m_shader3d;
-    newGroup->m_uniforms = oldGroup->m_uniforms;
-    newGroup->m_generalUniforms = oldGroup->m_generalUniforms;
-    newGroup->AddBucket(move(bucket));
-
-    buffer->Preflush();
-    if (isPerspective)
-      newGroup->m_shader3d->Bind();
-    else
-      newGroup->m_shader->Bind();
-    buffer->Build(isPerspective ? newGroup->m_shader3d : newGroup->m_shader);
-    mergedBatches.push_back(move(newGroup));
+    flushBucketFn(move(bucket), buffer);
   };
 
-  auto allocateFn = [=](drape_ptr<TBucket> & bucket, ref_ptr<TBuffer> & buffer)
+  auto allocateFn = [](drape_ptr<TBucket> & bucket, ref_ptr<TBuffer> & buffer)
   {
     bucket = make_unique_dp<TBucket>(make_unique_dp<TBuffer>(kIndexBufferSize, kVertexBufferSize));
     buffer = bucket->GetBuffer();
   };
 
   auto copyVertecesFn = [](TBuffer::BuffersMap::value_type const & vboNode,
+                           glsl::vec2 const & offset,
                            vector<uint8_t> & rawDataBuffer,
                            ref_ptr<TBuffer> newBuffer)
   {
@@ -120,6 +258,9 @@ void BatchMergeHelper::MergeBatches(vector<drape_ptr<RenderGroup>> & batches,
     ReadBufferData(rawDataBuffer.data(), gl_const::GLArrayBuffer, bufferLength);
     GLFunctions::glUnmapBuffer(gl_const::GLArrayBuffer);
 
+    if (offset.x != 0.0f || offset.y != 0.0f)
+      ShiftPositions(binding, rawDataBuffer.data(), vertexCount, offset);
+
     newBuffer->UploadData(binding, rawDataBuffer.data(), vertexCount);
   };
 
@@ -129,17 +270,19 @@ void BatchMergeHelper::MergeBatches(vector<drape_ptr<RenderGroup>> & batches,
 
   vector<uint8_t> rawDataBuffer;
 
-  for (drape_ptr<RenderGroup> const & group : batches)
+  for (size_t groupIndex = 0; groupIndex < groups.size(); ++groupIndex)
   {
-    for (drape_ptr<TBucket> const & b : group->m_renderBuckets)
+    glsl::vec2 const & offset = offsets[groupIndex];
+    for (drape_ptr<TBucket> const & b : groups[groupIndex]->m_renderBuckets)
     {
       ASSERT(b->m_overlay.empty(), ());
       ref_ptr<TBuffer> buffer = b->GetBuffer();
+      ASSERT(!buffer->IsInstanced(), ());
       uint32_t vertexCount = buffer->GetStartIndexValue();
       uint32_t indexCount = buffer->GetIndexCount();
 
-      if (newBuffer->GetAvailableIndexCount() < vertexCount ||
-          newBuffer->GetAvailableVertexCount() < indexCount)
+      if (newBuffer->GetAvailableVertexCount() < vertexCount ||
+          newBuffer->GetAvailableIndexCount() < indexCount)
       {
         flushFn(move(bucket), newBuffer);
         allocateFn(bucket, newBuffer);
@@ -151,12 +294,12 @@ void BatchMergeHelper::MergeBatches(vector<drape_ptr<RenderGroup>> & batches,
 
       for (auto const & vboNode : buffer->m_staticBuffers)
       {
-        copyVertecesFn(vboNode, rawDataBuffer, newBuffer);
+        copyVertecesFn(vboNode, offset, rawDataBuffer, newBuffer);
       }
 
       for (auto const & vboNode : buffer->m_dynamicBuffers)
       {
-        copyVertecesFn(vboNode, rawDataBuffer, newBuffer);
+        copyVertecesFn(vboNode, offset, rawDataBuffer, newBuffer);
       }
 
       uint32_t indexByteCount = indexCount * dp::IndexStorage::SizeOfIndex();
@@ -176,11 +319,7 @@ void BatchMergeHelper::MergeBatches(vector<drape_ptr<RenderGroup>> & batches,
     }
   }
 
-  if (newBuffer->GetIndexCount() > 0)
-  {
-    flushFn(move(bucket), newBuffer);
-    allocateFn(bucket, newBuffer);
-  }
+  flushFn(move(bucket), newBuffer);
 }
 
 }
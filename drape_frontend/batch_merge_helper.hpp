@@ -1,8 +1,12 @@
 #pragma once
 
+#include "drape/glsl_types.hpp"
 #include "drape/pointers.hpp"
 #include "drape_frontend/render_group.hpp"
 
+#include <functional>
+#include <vector>
+
 namespace dp
 {
 class VertexArrayBuffer;
@@ -19,6 +23,31 @@ public:
   static void MergeBatches(vector<drape_ptr<RenderGroup>> & batches,
                            vector<drape_ptr<RenderGroup>> & mergedBatches,
                            bool isPerspective);
+
+  // Returns true if buckets of the group can be moved to another tile by MergeTiles().
+  static bool CanMergeTiles(ref_ptr<RenderGroup> group);
+
+  // Copies buckets of groups with the same state from adjacent tiles of the same
+  // zoom level to the merged group, which belongs to the tile of the first group.
+  // Groups which can't be merged (see CanMergeTiles()) are skipped. Returns nullptr if less than 2 groups
+  // are merged.
+  static drape_ptr<MergedRenderGroup> MergeTiles(std::vector<ref_ptr<RenderGroup>> const & groups,
+                                                 bool isPerspective);
+
+private:
+  using TFlushFn = std::function<void(drape_ptr<dp::RenderBucket> && bucket,
+                                      ref_ptr<dp::VertexArrayBuffer> buffer)>;
+
+  static bool CanBeCopied(ref_ptr<RenderGroup> group, bool needShift);
+
+  // Copies buckets of the groups to new buckets of limited size. Positions of vertices
+  // of each group are shifted by the offset of the group.
+  static void CopyBuckets(std::vector<ref_ptr<RenderGroup>> const & groups,
+                          std::vector<glsl::vec2> const & offsets, TFlushFn const & flushFn);
+
+  static void SetupGroup(ref_ptr<RenderGroup> group, ref_ptr<RenderGroup> source,
+                         drape_ptr<dp::RenderBucket> && bucket,
+                         ref_ptr<dp::VertexArrayBuffer> buffer, bool isPerspective);
 };
 
 }
@@ -17,10 +17,14 @@ class BatchersPool final
 public:
   using TFlushFn = std::function<void (TKey const & key, dp::GLState const & state,
                                        drape_ptr<dp::RenderBucket> && buffer)>;
+  using TPreflushFn = std::function<void (TKey const & key, dp::GLState const & state,
+                                          ref_ptr<dp::RenderBucket> buffer)>;
 
   BatchersPool(int initBatchersCount, TFlushFn const & flushFn,
-               uint32_t indexBufferSize, uint32_t vertexBufferSize)
+               uint32_t indexBufferSize, uint32_t vertexBufferSize,
+               TPreflushFn const & preflushFn = TPreflushFn())
     : m_flushFn(flushFn)
+    , m_preflushFn(preflushFn)
     , m_pool(initBatchersCount, dp::BatcherFactory(indexBufferSize, vertexBufferSize))
   {}
 
@@ -48,6 +52,8 @@ public:
     using namespace std::placeholders;
     m_batchers.insert(std::make_pair(key, make_pair(batcher, 1)));
     batcher->StartSession(std::bind(m_flushFn, key, _1, _2));
+    if (m_preflushFn)
+      batcher->SetPreflushFn(std::bind(m_preflushFn, key, _1, _2));
   }
 
   ref_ptr<dp::Batcher> GetBatcher(TKey const & key)
@@ -57,6 +63,14 @@ public:
     return make_ref(it->second.first);
   }
 
+  // Flushes the buckets of the batcher without finishing its session.
+  void FlushBatcher(TKey const & key)
+  {
+    auto it = m_batchers.find(key);
+    if (it != m_batchers.end())
+      it->second.first->Flush();
+  }
+
   void ReleaseBatcher(TKey const & key)
   {
     auto it = m_batchers.find(key);
@@ -75,6 +89,7 @@ private:
   using TBatcherPair = std::pair<dp::Batcher *, int>;
   using TBatcherMap = std::map<TKey, TBatcherPair, TKeyComparator>;
   TFlushFn m_flushFn;
+  TPreflushFn m_preflushFn;
 
   dp::ObjectPool<dp::Batcher, dp::BatcherFactory> m_pool;
   TBatcherMap m_batchers;
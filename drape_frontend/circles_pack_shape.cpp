@@ -7,6 +7,8 @@
 #include "drape/glsl_types.hpp"
 #include "drape/texture_manager.hpp"
 
+#include <algorithm>
+
 namespace df
 {
 namespace
@@ -58,31 +60,38 @@ dp::BindingInfo const & GetCirclesPackDynamicBindingInfo()
 
 CirclesPackHandle::CirclesPackHandle(size_t pointsCount)
   : OverlayHandle(FeatureID(), dp::Anchor::Center, 0, false)
-  , m_needUpdate(false)
+  , m_dirtyBegin(0)
+  , m_dirtyEnd(0)
+  , m_usedCount(0)
 {
   m_buffer.resize(pointsCount * dp::Batcher::VertexPerQuad);
 }
 
 void CirclesPackHandle::GetAttributeMutation(ref_ptr<dp::AttributeBufferMutator> mutator) const
 {
-  if (!m_needUpdate)
+  if (m_dirtyBegin >= m_dirtyEnd)
     return;
 
   TOffsetNode const & node = GetOffsetNode(kDynamicStreamID);
   ASSERT(node.first.GetElementSize() == sizeof(CirclesPackDynamicVertex), ());
   ASSERT(node.second.m_count == m_buffer.size(), ());
 
-  uint32_t const byteCount =
-      static_cast<uint32_t>(m_buffer.size()) * sizeof(CirclesPackDynamicVertex);
+  auto const firstVertex = static_cast<uint32_t>(m_dirtyBegin * dp::Batcher::VertexPerQuad);
+  auto const verticesCount =
+      static_cast<uint32_t>((m_dirtyEnd - m_dirtyBegin) * dp::Batcher::VertexPerQuad);
+  ASSERT_LESS_OR_EQUAL(firstVertex + verticesCount, m_buffer.size(), ());
+
+  uint32_t const byteCount = verticesCount * sizeof(CirclesPackDynamicVertex);
   void * buffer = mutator->AllocateMutationBuffer(byteCount);
-  memcpy(buffer, m_buffer.data(), byteCount);
+  memcpy(buffer, m_buffer.data() + firstVertex, byteCount);
 
   dp::MutateNode mutateNode;
-  mutateNode.m_region = node.second;
+  mutateNode.m_region = dp::MutateRegion(node.second.m_offset + firstVertex, verticesCount);
   mutateNode.m_data = make_ref(buffer);
   mutator->AddMutation(node.first, mutateNode);
 
-  m_needUpdate = false;
+  m_dirtyBegin = 0;
+  m_dirtyEnd = 0;
 }
 
 bool CirclesPackHandle::Update(ScreenBase const & screen)
@@ -119,13 +128,31 @@ void CirclesPackHandle::SetPoint(size_t index, m2::PointD const & position, floa
     m_buffer[bufferIndex + i].m_position = glsl::vec3(position.x, position.y, radius);
     m_buffer[bufferIndex + i].m_color = glsl::ToVec4(color);
   }
-  m_needUpdate = true;
+  m_usedCount = std::max(m_usedCount, index + 1);
+  MarkDirty(index, index + 1);
 }
 
 void CirclesPackHandle::Clear()
 {
-  memset(m_buffer.data(), 0, m_buffer.size() * sizeof(CirclesPackDynamicVertex));
-  m_needUpdate = true;
+  if (m_usedCount == 0)
+    return;
+
+  memset(m_buffer.data(), 0,
+         m_usedCount * dp::Batcher::VertexPerQuad * sizeof(CirclesPackDynamicVertex));
+  MarkDirty(0, m_usedCount);
+  m_usedCount = 0;
+}
+
+void CirclesPackHandle::MarkDirty(size_t beginPoint, size_t endPoint)
+{
+  if (m_dirtyBegin >= m_dirtyEnd)
+  {
+    m_dirtyBegin = beginPoint;
+    m_dirtyEnd = endPoint;
+    return;
+  }
+  m_dirtyBegin = std::min(m_dirtyBegin, beginPoint);
+  m_dirtyEnd = std::max(m_dirtyEnd, endPoint);
 }
 
 size_t CirclesPackHandle::GetPointsCount() const
@@ -60,8 +60,14 @@ public:
   size_t GetPointsCount() const;
 
 private:
+  void MarkDirty(size_t beginPoint, size_t endPoint);
+
   std::vector<CirclesPackDynamicVertex> m_buffer;
-  mutable bool m_needUpdate;
+  // Only points which are changed since the previous mutation are uploaded.
+  mutable size_t m_dirtyBegin;
+  mutable size_t m_dirtyEnd;
+  // Points in [0, m_usedCount) may be set since the previous clearing.
+  size_t m_usedCount;
 };
 
 class CirclesPackShape
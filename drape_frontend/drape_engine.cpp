@@ -5,6 +5,7 @@
 #include "drape_frontend/my_position_controller.hpp"
 #include "drape_frontend/visual_params.hpp"
 
+#include "drape/gpu_buffer_pool.hpp"
 #include "drape/support_manager.hpp"
 
 #include "platform/settings.hpp"
@@ -26,6 +27,7 @@ DrapeEngine::DrapeEngine(Params && params)
   guiSubsystem.SetSurfaceSize(m2::PointF(m_viewport.GetWidth(), m_viewport.GetHeight()));
 
   m_textureManager = make_unique_dp<dp::TextureManager>();
+  dp::GPUBufferPool::Instance().SetEnabled(true);
   m_threadCommutator = make_unique_dp<ThreadsCommutator>();
   m_requestedTiles = make_unique_dp<RequestedTiles>();
 
@@ -96,6 +98,7 @@ DrapeEngine::DrapeEngine(Params && params)
                                    params.m_allow3dBuildings,
                                    params.m_trafficEnabled,
                                    params.m_simplifiedTrafficColors);
+  brParams.m_isTileGeometryCacheEnabled = params.m_isTileGeometryCacheEnabled;
 
   m_backend = make_unique_dp<BackendRenderer>(std::move(brParams));
 
@@ -108,10 +111,21 @@ DrapeEngine::DrapeEngine(Params && params)
     EnableChoosePositionMode(true, std::move(params.m_boundAreaTriangles), false, m2::PointD());
 
   ResizeImpl(m_viewport.GetWidth(), m_viewport.GetHeight());
+
+  m_cachesShedding = make_unique_dp<base::SheddableCache>(
+      "drape", base::CacheRegistry::Priority::Normal, [this]()
+  {
+    m_threadCommutator->PostMessage(ThreadsCommutator::ResourceUploadThread,
+                                    make_unique_dp<ShrinkCachesMessage>(),
+                                    MessagePriority::Normal);
+  });
 }
 
 DrapeEngine::~DrapeEngine()
 {
+  // Caches mustn't be shed while threads are stopped.
+  m_cachesShedding.reset();
+
   // Call Teardown explicitly! We must wait for threads completion.
   m_frontend->Teardown();
   m_backend->Teardown();
@@ -701,7 +715,7 @@ void DrapeEngine::SetFontScaleFactor(double scaleFactor)
 
 void DrapeEngine::RunScenario(ScenarioManager::ScenarioData && scenarioData,
                               ScenarioManager::ScenarioCallback const & onStartFn,
-                              ScenarioManager::ScenarioCallback const & onFinishFn)
+                              ScenarioManager::ScenarioFinishCallback const & onFinishFn)
 {
   auto const & manager = m_frontend->GetScenarioManager();
   if (manager != nullptr)
@@ -715,6 +729,15 @@ void DrapeEngine::SetCustomFeatures(std::set<FeatureID> && ids)
                                   MessagePriority::Normal);
 }
 
+void DrapeEngine::SetCustomFeaturesForMwm(MwmSet::MwmId const & mwmId, std::set<FeatureID> && ids,
+                                          std::vector<m2::PointD> && changedPositions)
+{
+  m_threadCommutator->PostMessage(ThreadsCommutator::ResourceUploadThread,
+                                  make_unique_dp<SetCustomFeaturesMessage>(
+                                    mwmId, std::move(ids), std::move(changedPositions)),
+                                  MessagePriority::Normal);
+}
+
 void DrapeEngine::RemoveCustomFeatures(MwmSet::MwmId const & mwmId)
 {
   m_threadCommutator->PostMessage(ThreadsCommutator::ResourceUploadThread,
@@ -748,4 +771,14 @@ void DrapeEngine::RunFirstLaunchAnimation()
                                   make_unique_dp<RunFirstLaunchAnimationMessage>(),
                                   MessagePriority::Normal);
 }
+
+void DrapeEngine::EnableFrameProfiler(bool enabled)
+{
+  FrameProfiler::Instance().SetEnabled(enabled);
+}
+
+FrameProfiler::Statistic DrapeEngine::GetFrameProfilerStatistic()
+{
+  return FrameProfiler::Instance().TakeStatistic();
+}
 }  // namespace df
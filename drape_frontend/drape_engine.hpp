@@ -3,6 +3,7 @@
 #include "drape_frontend/backend_renderer.hpp"
 #include "drape_frontend/color_constants.hpp"
 #include "drape_frontend/drape_hints.hpp"
+#include "drape_frontend/frame_profiler.hpp"
 #include "drape_frontend/frontend_renderer.hpp"
 #include "drape_frontend/route_shape.hpp"
 #include "drape_frontend/overlays_tracker.hpp"
@@ -24,6 +25,7 @@
 #include "geometry/screenbase.hpp"
 #include "geometry/triangle2d.hpp"
 
+#include "base/cache_registry.hpp"
 #include "base/strings_bundle.hpp"
 
 #include <functional>
@@ -107,6 +109,8 @@ public:
     bool m_isAutozoomEnabled;
     bool m_simplifiedTrafficColors;
     OverlaysShowStatsCallback m_overlaysShowStatsCallback;
+    // Keeps geometry of recently shown tiles, see TileGeometryCache.
+    bool m_isTileGeometryCacheEnabled = false;
   };
 
   DrapeEngine(Params && params);
@@ -201,11 +205,14 @@ public:
 
   void RunScenario(ScenarioManager::ScenarioData && scenarioData,
                    ScenarioManager::ScenarioCallback const & onStartFn,
-                   ScenarioManager::ScenarioCallback const & onFinishFn);
+                   ScenarioManager::ScenarioFinishCallback const & onFinishFn);
 
   // Custom features are features which we do not render usual way.
   // All these features will be skipped in process of geometry generation.
   void SetCustomFeatures(std::set<FeatureID> && ids);
+  // Replaces custom features of the mwm. Only tiles containing |changedPositions| are reread.
+  void SetCustomFeaturesForMwm(MwmSet::MwmId const & mwmId, std::set<FeatureID> && ids,
+                               std::vector<m2::PointD> && changedPositions);
   void RemoveCustomFeatures(MwmSet::MwmId const & mwmId);
   void RemoveAllCustomFeatures();
 
@@ -213,6 +220,11 @@ public:
 
   void RunFirstLaunchAnimation();
 
+  // The profiler is disabled by default. The statistic is accumulated
+  // since the previous call of GetFrameProfilerStatistic().
+  void EnableFrameProfiler(bool enabled);
+  FrameProfiler::Statistic GetFrameProfilerStatistic();
+
 private:
   void AddUserEvent(drape_ptr<UserEvent> && e);
   void PostUserEvent(drape_ptr<UserEvent> && e);
@@ -250,6 +262,9 @@ private:
   std::mutex m_drapeIdGeneratorMutex;
   dp::DrapeID m_drapeIdGenerator = 0;
 
+  // Sheds caches of tiles geometry under memory pressure.
+  drape_ptr<base::SheddableCache> m_cachesShedding;
+
   friend class DrapeApi;
 };
 }  // namespace df
@@ -55,6 +55,8 @@ SOURCES += \
     drape_engine.cpp \
     drape_measurer.cpp \
     engine_context.cpp \
+    frame_budget_controller.cpp \
+    frame_profiler.cpp \
     frontend_renderer.cpp \
     gps_track_renderer.cpp \
     line_shape.cpp \
@@ -90,11 +92,13 @@ SOURCES += \
     screen_quad_renderer.cpp \
     selection_shape.cpp \
     shader_def.cpp \
+    shaped_text_cache.cpp \
     stylist.cpp \
     text_handle.cpp \
     text_layout.cpp \
     text_shape.cpp \
     threads_commutator.cpp \
+    tile_geometry_cache.cpp \
     tile_info.cpp \
     tile_key.cpp \
     tile_utils.cpp \
@@ -155,6 +159,8 @@ HEADERS += \
     drape_hints.hpp \
     drape_measurer.hpp \
     engine_context.hpp \
+    frame_budget_controller.hpp \
+    frame_profiler.hpp \
     frontend_renderer.hpp \
     gps_track_point.hpp \
     gps_track_renderer.hpp \
@@ -195,11 +201,13 @@ HEADERS += \
     selection_shape.hpp \
     shader_def.hpp \
     shape_view_params.hpp \
+    shaped_text_cache.hpp \
     stylist.hpp \
     text_handle.hpp \
     text_layout.hpp \
     text_shape.hpp \
     threads_commutator.hpp \
+    tile_geometry_cache.hpp \
     tile_info.hpp \
     tile_key.hpp \
     tile_utils.hpp \
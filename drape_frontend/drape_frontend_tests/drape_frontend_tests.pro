@@ -34,9 +34,15 @@ win32*|linux* {
 SOURCES += \
   ../../testing/testingmain.cpp \
   compile_shaders_test.cpp \
+  frame_budget_controller_test.cpp \
+  frame_profiler_test.cpp \
+  merged_render_group_test.cpp \
+  message_queue_test.cpp \
   navigator_test.cpp \
   path_text_test.cpp \
   shader_def_for_tests.cpp \
+  shaped_text_cache_test.cpp \
+  tile_geometry_cache_test.cpp \
   user_event_stream_tests.cpp \
 
 HEADERS += \
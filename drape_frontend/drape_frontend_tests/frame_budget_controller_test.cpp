@@ -0,0 +1,98 @@
+#include "testing/testing.hpp"
+
+#include "drape_frontend/frame_budget_controller.hpp"
+
+using namespace df;
+
+namespace
+{
+double constexpr kTargetFrameTime = 1.0 / 60.0;
+double constexpr kSlowFrameTime = 1.0 / 30.0;
+
+// Returns true if the level is changed by some of the windows.
+bool AddWindows(FrameBudgetController & controller, uint32_t windowsCount, double frameTime)
+{
+  bool isChanged = false;
+  for (uint32_t i = 0; i < windowsCount * FrameBudgetController::kFramesInWindow; ++i)
+    isChanged |= controller.AddFrame(frameTime);
+  return isChanged;
+}
+}  // namespace
+
+UNIT_TEST(FrameBudgetController_ScaleDownAndUp)
+{
+  FrameBudgetController controller;
+  controller.SetTargetFrameTime(kTargetFrameTime);
+  TEST_EQUAL(controller.GetLevel(), FrameBudgetController::Level::Full, ());
+  TEST(controller.IsAntialiasingAllowed(), ());
+
+  TEST(!AddWindows(controller, 10, kTargetFrameTime), ());
+  TEST_EQUAL(controller.GetLevel(), FrameBudgetController::Level::Full, ());
+
+  TEST(AddWindows(controller, 1, kSlowFrameTime), ());
+  TEST_EQUAL(controller.GetLevel(), FrameBudgetController::Level::NoAntialiasing, ());
+  TEST(!controller.IsAntialiasingAllowed(), ());
+  TEST(controller.Is3dFramebufferAllowed(), ());
+
+  AddWindows(controller, 2, kSlowFrameTime);
+  TEST_EQUAL(controller.GetLevel(), FrameBudgetController::Level::DelayedOverlays, ());
+  TEST(!controller.Is3dFramebufferAllowed(), ());
+  TEST_EQUAL(controller.GetOverlaysUpdateFactor(), 2, ());
+
+  // The lowest level is kept.
+  TEST(!AddWindows(controller, 1, kSlowFrameTime), ());
+  TEST_EQUAL(controller.GetLevel(), FrameBudgetController::Level::DelayedOverlays, ());
+
+  // A feature is restored after several windows in budget only.
+  TEST(!AddWindows(controller, FrameBudgetController::kMinRestoreWindows - 1, kTargetFrameTime),
+       ());
+  TEST(AddWindows(controller, 1, kTargetFrameTime), ());
+  TEST_EQUAL(controller.GetLevel(), FrameBudgetController::Level::Simplified3d, ());
+  TEST_EQUAL(controller.GetOverlaysUpdateFactor(), 1, ());
+
+  controller.Reset();
+  TEST_EQUAL(controller.GetLevel(), FrameBudgetController::Level::Full, ());
+}
+
+UNIT_TEST(FrameBudgetController_Hysteresis)
+{
+  FrameBudgetController controller;
+  controller.SetTargetFrameTime(kTargetFrameTime);
+
+  // Frames between the thresholds don't change the level.
+  double const borderFrameTime = kTargetFrameTime * 0.5 *
+      (FrameBudgetController::kInBudgetFactor + FrameBudgetController::kOverBudgetFactor);
+  TEST(!AddWindows(controller, 10, borderFrameTime), ());
+  TEST_EQUAL(controller.GetLevel(), FrameBudgetController::Level::Full, ());
+
+  TEST(AddWindows(controller, 1, kSlowFrameTime), ());
+  TEST(!AddWindows(controller, 10, borderFrameTime), ());
+  TEST_EQUAL(controller.GetLevel(), FrameBudgetController::Level::NoAntialiasing, ());
+
+  uint32_t restoreWindows = FrameBudgetController::kMinRestoreWindows;
+  TEST(AddWindows(controller, restoreWindows, kTargetFrameTime), ());
+  TEST_EQUAL(controller.GetLevel(), FrameBudgetController::Level::Full, ());
+
+  // The budget is exceeded right after restoring, so the next restoring
+  // takes twice as many windows.
+  TEST(AddWindows(controller, 1, kSlowFrameTime), ());
+  restoreWindows *= 2;
+  TEST(!AddWindows(controller, restoreWindows - 1, kTargetFrameTime), ());
+  TEST_EQUAL(controller.GetLevel(), FrameBudgetController::Level::NoAntialiasing, ());
+  TEST(AddWindows(controller, 1, kTargetFrameTime), ());
+  TEST_EQUAL(controller.GetLevel(), FrameBudgetController::Level::Full, ());
+}
+
+UNIT_TEST(FrameBudgetController_TargetFrameTime)
+{
+  FrameBudgetController controller;
+  controller.SetTargetFrameTime(kSlowFrameTime);
+
+  // 30 fps fits the budget of following mode.
+  TEST(!AddWindows(controller, 10, kSlowFrameTime), ());
+  TEST_EQUAL(controller.GetLevel(), FrameBudgetController::Level::Full, ());
+
+  controller.SetTargetFrameTime(kTargetFrameTime);
+  TEST(AddWindows(controller, 1, kSlowFrameTime), ());
+  TEST_EQUAL(controller.GetLevel(), FrameBudgetController::Level::NoAntialiasing, ());
+}
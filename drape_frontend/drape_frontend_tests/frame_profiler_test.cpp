@@ -0,0 +1,87 @@
+#include "testing/testing.hpp"
+
+#include "drape_frontend/frame_profiler.hpp"
+
+#include "drape/utils/render_counters.hpp"
+
+#include <chrono>
+#include <thread>
+
+using namespace df;
+
+namespace
+{
+void RenderFrame(uint32_t drawCallsCount)
+{
+  FrameProfiler & profiler = FrameProfiler::Instance();
+  profiler.BeginFrame();
+  {
+    FrameProfiler::PhaseGuard guard(FrameProfiler::Phase::Geometry2d);
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    for (uint32_t i = 0; i < drawCallsCount; ++i)
+    {
+      dp::RenderCounters::Instance().AddDrawCall();
+      dp::RenderCounters::Instance().AddBucket();
+    }
+    dp::RenderCounters::Instance().AddUploadedBytes(100);
+  }
+  profiler.BeginOverlayTreeRebuild();
+  profiler.EndOverlayTreeRebuild();
+  profiler.EndFrame();
+}
+}  // namespace
+
+UNIT_TEST(FrameProfiler_Smoke)
+{
+  FrameProfiler & profiler = FrameProfiler::Instance();
+  profiler.SetEnabled(true);
+  profiler.TakeStatistic();
+
+  RenderFrame(10 /* drawCallsCount */);
+  RenderFrame(20 /* drawCallsCount */);
+
+  auto const statistic = profiler.TakeStatistic();
+  TEST_EQUAL(statistic.m_frameTime.m_count, 2, ());
+  TEST_GREATER_OR_EQUAL(statistic.m_frameTime.m_maxTimeInUs, statistic.m_frameTime.m_avgTimeInUs,
+                        ());
+
+  auto const & geometry =
+      statistic.m_cpuPhaseTime[static_cast<size_t>(FrameProfiler::Phase::Geometry2d)];
+  TEST_EQUAL(geometry.m_count, 2, ());
+  TEST_GREATER_OR_EQUAL(geometry.m_avgTimeInUs, 2000, ());
+  TEST_GREATER_OR_EQUAL(statistic.m_frameTime.m_avgTimeInUs, geometry.m_avgTimeInUs, ());
+
+  // There are no GPU timings without timer queries.
+  for (auto const & time : statistic.m_gpuPhaseTime)
+    TEST_EQUAL(time.m_count, 0, ());
+
+  TEST_EQUAL(statistic.m_overlayTreeRebuildTime.m_count, 2, ());
+  TEST_EQUAL(statistic.m_avgDrawCallsCount, 15, ());
+  TEST_EQUAL(statistic.m_maxDrawCallsCount, 20, ());
+  TEST_EQUAL(statistic.m_avgBucketsCount, 15, ());
+  TEST_EQUAL(statistic.m_maxBucketsCount, 20, ());
+  TEST_EQUAL(statistic.m_uploadedBytes, 200, ());
+
+  // The statistic is reset when it's taken.
+  auto const empty = profiler.TakeStatistic();
+  TEST_EQUAL(empty.m_frameTime.m_count, 0, ());
+  TEST_EQUAL(empty.m_uploadedBytes, 0, ());
+
+  profiler.SetEnabled(false);
+}
+
+UNIT_TEST(FrameProfiler_Disabled)
+{
+  FrameProfiler & profiler = FrameProfiler::Instance();
+  profiler.SetEnabled(false);
+  profiler.TakeStatistic();
+
+  RenderFrame(10 /* drawCallsCount */);
+
+  auto const statistic = profiler.TakeStatistic();
+  TEST_EQUAL(statistic.m_frameTime.m_count, 0, ());
+  TEST_EQUAL(statistic.m_overlayTreeRebuildTime.m_count, 0, ());
+  TEST_EQUAL(statistic.m_maxDrawCallsCount, 0, ());
+  TEST_EQUAL(statistic.m_uploadedBytes, 0, ());
+  TEST(!dp::RenderCounters::Instance().IsEnabled(), ());
+}
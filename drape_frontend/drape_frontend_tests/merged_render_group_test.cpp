@@ -0,0 +1,80 @@
+#include "testing/testing.hpp"
+
+#include "drape_frontend/render_group.hpp"
+#include "drape_frontend/render_state.hpp"
+#include "drape_frontend/tile_key.hpp"
+
+#include "drape/pointers.hpp"
+
+using namespace df;
+
+namespace
+{
+dp::GLState MakeState()
+{
+  return CreateGLState(0 /* gpuProgramIndex */, RenderState::GeometryLayer);
+}
+
+drape_ptr<RenderGroup> MakeGroup(int x, int y)
+{
+  return make_unique_dp<RenderGroup>(MakeState(), TileKey(x, y, 10 /* zoomLevel */));
+}
+}  // namespace
+
+UNIT_TEST(MergedRenderGroup_Sources)
+{
+  auto group1 = MakeGroup(0, 0);
+  auto group2 = MakeGroup(1, 0);
+
+  MergedRenderGroup mergedGroup(MakeState(), group1->GetTileKey());
+  TEST(!mergedGroup.IsValid(), ());
+  mergedGroup.AddSource(make_ref(group1));
+  mergedGroup.AddSource(make_ref(group2));
+
+  TEST(mergedGroup.IsValid(), ());
+  TEST_EQUAL(mergedGroup.GetSourcesCount(), 2, ());
+  TEST(mergedGroup.IsFirstSource(make_ref(group1)), ());
+  TEST(!mergedGroup.IsFirstSource(make_ref(group2)), ());
+  TEST(group1->GetMergedGroup() == &mergedGroup, ());
+  TEST(group2->GetMergedGroup() == &mergedGroup, ());
+
+  mergedGroup.Invalidate();
+  TEST(!mergedGroup.IsValid(), ());
+  TEST(group1->GetMergedGroup() == nullptr, ());
+  TEST(group2->GetMergedGroup() == nullptr, ());
+}
+
+UNIT_TEST(MergedRenderGroup_InvalidatedBySources)
+{
+  auto group1 = MakeGroup(0, 0);
+  auto group2 = MakeGroup(0, 1);
+
+  {
+    MergedRenderGroup mergedGroup(MakeState(), group1->GetTileKey());
+    mergedGroup.AddSource(make_ref(group1));
+    mergedGroup.AddSource(make_ref(group2));
+
+    group2->DeleteLater();
+    TEST(!mergedGroup.IsValid(), ());
+    TEST(group1->GetMergedGroup() == nullptr, ());
+  }
+
+  {
+    auto group3 = MakeGroup(1, 1);
+    MergedRenderGroup mergedGroup(MakeState(), group1->GetTileKey());
+    mergedGroup.AddSource(make_ref(group1));
+    mergedGroup.AddSource(make_ref(group3));
+
+    group3.reset();
+    TEST(!mergedGroup.IsValid(), ());
+    TEST(group1->GetMergedGroup() == nullptr, ());
+  }
+
+  {
+    // Destroying of the merged group detaches the sources.
+    auto mergedGroup = make_unique_dp<MergedRenderGroup>(MakeState(), group1->GetTileKey());
+    mergedGroup->AddSource(make_ref(group1));
+    mergedGroup.reset();
+    TEST(group1->GetMergedGroup() == nullptr, ());
+  }
+}
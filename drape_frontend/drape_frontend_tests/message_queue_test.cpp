@@ -0,0 +1,122 @@
+#include "testing/testing.hpp"
+
+#include "drape_frontend/message.hpp"
+#include "drape_frontend/message_queue.hpp"
+
+#include "drape/pointers.hpp"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace df;
+
+namespace
+{
+class TestMessage : public Message
+{
+public:
+  TestMessage(Type type, int id) : m_type(type), m_id(id) {}
+
+  Type GetType() const override { return m_type; }
+  int GetId() const { return m_id; }
+
+private:
+  Type m_type;
+  int m_id;
+};
+
+void Push(MessageQueue & queue, int id, MessagePriority priority,
+          Message::Type type = Message::Unknown)
+{
+  queue.PushMessage(make_unique_dp<TestMessage>(type, id), priority);
+}
+
+std::vector<int> PopAll(MessageQueue & queue)
+{
+  std::vector<int> ids;
+  while (true)
+  {
+    auto message = queue.PopMessage(false /* waitForMessage */);
+    if (message == nullptr)
+      break;
+    ids.push_back(static_cast<TestMessage *>(message.get())->GetId());
+  }
+  return ids;
+}
+}  // namespace
+
+UNIT_TEST(MessageQueue_Priorities)
+{
+  MessageQueue queue;
+  Push(queue, 1, MessagePriority::Normal);
+  Push(queue, 2, MessagePriority::Low);
+  Push(queue, 3, MessagePriority::High);
+  Push(queue, 4, MessagePriority::Normal);
+  Push(queue, 5, MessagePriority::UberHighSingleton, Message::UpdateReadManager);
+  // A singleton is not added when the same message is already queued.
+  Push(queue, 6, MessagePriority::UberHighSingleton, Message::UpdateReadManager);
+  Push(queue, 7, MessagePriority::High);
+
+  // High priority messages are placed right after singletons, so
+  // the last one goes first.
+  auto const ids = PopAll(queue);
+  TEST_EQUAL(ids, std::vector<int>({5, 7, 3, 1, 4, 2}), ());
+}
+
+UNIT_TEST(MessageQueue_Filter)
+{
+  MessageQueue queue;
+  for (int i = 0; i < 6; ++i)
+    Push(queue, i, i % 2 == 0 ? MessagePriority::Normal : MessagePriority::Low);
+
+  queue.FilterMessages([](ref_ptr<Message> message)
+  {
+    return static_cast<TestMessage *>(message.get())->GetId() % 3 == 0;
+  });
+  auto ids = PopAll(queue);
+  TEST_EQUAL(ids, std::vector<int>({2, 4, 1, 5}), ());
+
+  Push(queue, 1, MessagePriority::Normal);
+  queue.ClearQuery();
+  Push(queue, 2, MessagePriority::Normal);
+  ids = PopAll(queue);
+  TEST_EQUAL(ids, std::vector<int>({2}), ());
+}
+
+UNIT_TEST(MessageQueue_Producers)
+{
+  int constexpr kNumProducers = 4;
+  int constexpr kNumMessages = 10000;
+
+  MessageQueue queue;
+  std::vector<std::thread> producers;
+  for (int i = 0; i < kNumProducers; ++i)
+  {
+    producers.emplace_back([&queue, i]()
+    {
+      for (int j = 0; j < kNumMessages; ++j)
+        Push(queue, i * kNumMessages + j, MessagePriority::Normal);
+    });
+  }
+
+  // Messages of every producer are popped in order of pushing.
+  std::vector<int> last(kNumProducers, -1);
+  int numPopped = 0;
+  while (numPopped < kNumProducers * kNumMessages)
+  {
+    auto message = queue.PopMessage(true /* waitForMessage */);
+    if (message == nullptr)
+      continue;
+    int const id = static_cast<TestMessage *>(message.get())->GetId();
+    int const producer = id / kNumMessages;
+    TEST_LESS(last[producer], id, ());
+    last[producer] = id;
+    ++numPopped;
+  }
+
+  for (auto & producer : producers)
+    producer.join();
+  auto const ids = PopAll(queue);
+  TEST(ids.empty(), ());
+}
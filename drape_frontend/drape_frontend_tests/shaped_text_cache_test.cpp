@@ -0,0 +1,80 @@
+#include "testing/testing.hpp"
+
+#include "drape_frontend/shaped_text_cache.hpp"
+
+#include "base/string_utils.hpp"
+
+#include <cstddef>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace df;
+
+namespace
+{
+UNIT_TEST(ShapedTextCache_Smoke)
+{
+  ShapedTextCache cache(2 /* maxSize */);
+  size_t calls = 0;
+  auto shape = [&calls](strings::UniString const & text, ShapedTextCache::ShapedText & shaped) {
+    ++calls;
+    shaped.m_visibleText = text;
+    shaped.m_splitText = text;
+    shaped.m_delimIndexes.push_back(text.size());
+  };
+
+  auto const first = cache.Get(strings::MakeUniString("Tverskaya"), shape);
+  TEST_EQUAL(calls, 1, ());
+  TEST_EQUAL(strings::ToUtf8(first->m_visibleText), "Tverskaya", ());
+
+  auto const second = cache.Get(strings::MakeUniString("Tverskaya"), shape);
+  TEST_EQUAL(calls, 1, ());
+  TEST_EQUAL(first.get(), second.get(), ());
+  TEST_EQUAL(cache.GetSize(), 1, ());
+
+  cache.Get(strings::MakeUniString("Arbat"), shape);
+  TEST_EQUAL(calls, 2, ());
+  TEST_EQUAL(cache.GetSize(), 2, ());
+
+  // The cache is full, so it's cleared, but the shaped texts given away stay valid.
+  cache.Get(strings::MakeUniString("Petrovka"), shape);
+  TEST_EQUAL(calls, 3, ());
+  TEST_EQUAL(cache.GetSize(), 1, ());
+  TEST_EQUAL(strings::ToUtf8(first->m_splitText), "Tverskaya", ());
+
+  cache.Get(strings::MakeUniString("Tverskaya"), shape);
+  TEST_EQUAL(calls, 4, ());
+
+  cache.Clear();
+  TEST_EQUAL(cache.GetSize(), 0, ());
+}
+
+UNIT_TEST(ShapedTextCache_Threads)
+{
+  size_t constexpr kNumThreads = 4;
+  size_t constexpr kNumTexts = 100;
+
+  ShapedTextCache cache;
+  auto shape = [](strings::UniString const & text, ShapedTextCache::ShapedText & shaped) {
+    shaped.m_visibleText = text;
+  };
+
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < kNumThreads; ++i)
+  {
+    threads.emplace_back([&cache, &shape]() {
+      for (size_t j = 0; j < kNumTexts; ++j)
+      {
+        auto const text = strings::MakeUniString("Street " + strings::to_string(j));
+        auto const shaped = cache.Get(text, shape);
+        TEST(shaped->m_visibleText == text, ());
+      }
+    });
+  }
+  for (auto & thread : threads)
+    thread.join();
+
+  TEST_EQUAL(cache.GetSize(), kNumTexts, ());
+}
+}  // namespace
@@ -0,0 +1,149 @@
+#include "testing/testing.hpp"
+
+#include "drape_frontend/render_state.hpp"
+#include "drape_frontend/tile_geometry_cache.hpp"
+#include "drape_frontend/tile_key.hpp"
+
+#include "drape/binding_info.hpp"
+
+#include "platform/platform.hpp"
+
+#include "coding/file_name_utils.hpp"
+
+#include <cstdint>
+#include <vector>
+
+using namespace df;
+
+namespace
+{
+size_t constexpr kBufferSize = 1000;
+
+TileGeometryCache::Key MakeKey(int x, int y, int zoomLevel)
+{
+  return TileGeometryCache::Key(TileKey(x, y, zoomLevel), MapStyleClear, false /* is3dBuildings */,
+                                false /* isTrafficEnabled */);
+}
+
+// Returns a bucket with |kBufferSize| bytes of vertices and indices,
+// all of them are equal to |value|.
+TileGeometryCache::TBuckets MakeBuckets(uint8_t value)
+{
+  TileGeometryCache::TBuckets buckets;
+  buckets.emplace_back(CreateGLState(0 /* gpuProgramIndex */, RenderState::GeometryLayer));
+  auto & bucket = buckets.back();
+  bucket.m_buffers.emplace_back(dp::BindingInfo(1 /* count */),
+                                std::vector<uint8_t>(kBufferSize / 2, value));
+  bucket.m_indices.assign(kBufferSize / 2, value);
+  return buckets;
+}
+
+void TestBuckets(TileGeometryCache::TBuckets const * buckets, uint8_t value)
+{
+  TEST(buckets != nullptr, ());
+  TEST_EQUAL(buckets->size(), 1, ());
+  auto const & bucket = buckets->front();
+  TEST_EQUAL(bucket.GetDataSize(), kBufferSize, ());
+  TEST_EQUAL(bucket.m_buffers.size(), 1, ());
+  TEST_EQUAL(bucket.m_buffers.front().second, std::vector<uint8_t>(kBufferSize / 2, value), ());
+  TEST_EQUAL(bucket.m_indices, std::vector<uint8_t>(kBufferSize / 2, value), ());
+}
+}  // namespace
+
+UNIT_TEST(TileGeometryCache_Smoke)
+{
+  TileGeometryCache cache(TileGeometryCache::Params{});
+
+  cache.Put(MakeKey(1, 2, 10), MakeBuckets(1));
+  cache.Put(MakeKey(2, 1, 10), MakeBuckets(2));
+  TEST_EQUAL(cache.GetMemorySize(), 2 * kBufferSize, ());
+
+  TestBuckets(cache.Get(MakeKey(1, 2, 10)), 1);
+  TestBuckets(cache.Get(MakeKey(2, 1, 10)), 2);
+  TEST(cache.Get(MakeKey(1, 2, 11)) == nullptr, ());
+
+  // Tiles read with other flags of the engine are different.
+  TileGeometryCache::Key const key3d(TileKey(1, 2, 10), MapStyleClear, true /* is3dBuildings */,
+                                     false /* isTrafficEnabled */);
+  TEST(cache.Get(key3d) == nullptr, ());
+
+  // A tile is replaced when it's put again.
+  cache.Put(MakeKey(1, 2, 10), MakeBuckets(3));
+  TestBuckets(cache.Get(MakeKey(1, 2, 10)), 3);
+  TEST_EQUAL(cache.GetMemorySize(), 2 * kBufferSize, ());
+
+  cache.Clear();
+  TEST_EQUAL(cache.GetMemorySize(), 0, ());
+  TEST(cache.Get(MakeKey(2, 1, 10)) == nullptr, ());
+}
+
+UNIT_TEST(TileGeometryCache_MemoryLimit)
+{
+  TileGeometryCache::Params params;
+  params.m_memoryLimit = 2 * kBufferSize;
+  TileGeometryCache cache(params);
+
+  cache.Put(MakeKey(0, 0, 10), MakeBuckets(0));
+  cache.Put(MakeKey(1, 0, 10), MakeBuckets(1));
+
+  // The first tile becomes the most recently used one.
+  auto const buckets = cache.Get(MakeKey(0, 0, 10));
+  TestBuckets(buckets, 0);
+
+  // There is no disk to spill the tiles, so the least recently used one is dropped.
+  cache.Put(MakeKey(2, 0, 10), MakeBuckets(2));
+  TEST_EQUAL(cache.GetMemorySize(), 2 * kBufferSize, ());
+  TEST_EQUAL(cache.GetDiskSize(), 0, ());
+  TEST(cache.Get(MakeKey(1, 0, 10)) == nullptr, ());
+  TestBuckets(cache.Get(MakeKey(0, 0, 10)), 0);
+  TestBuckets(cache.Get(MakeKey(2, 0, 10)), 2);
+}
+
+UNIT_TEST(TileGeometryCache_Spill)
+{
+  TileGeometryCache::Params params;
+  params.m_memoryLimit = kBufferSize;
+  params.m_diskLimit = 2 * kBufferSize;
+  params.m_spillDir = my::JoinPath(GetPlatform().WritableDir(), "tile_geometry_cache_test");
+  {
+    TileGeometryCache cache(params);
+
+    for (int i = 0; i < 3; ++i)
+      cache.Put(MakeKey(i, 0, 10), MakeBuckets(static_cast<uint8_t>(i)));
+    TEST_EQUAL(cache.GetMemorySize(), kBufferSize, ());
+    TEST_EQUAL(cache.GetDiskSize(), 2 * kBufferSize, ());
+
+    // The spilled tile is read back, and the last put one is spilled instead.
+    TestBuckets(cache.Get(MakeKey(0, 0, 10)), 0);
+    TEST_EQUAL(cache.GetMemorySize(), kBufferSize, ());
+    TEST_EQUAL(cache.GetDiskSize(), 2 * kBufferSize, ());
+    TestBuckets(cache.Get(MakeKey(2, 0, 10)), 2);
+    TestBuckets(cache.Get(MakeKey(1, 0, 10)), 1);
+
+    // The disk limit is exceeded, so the least recently used tile is dropped.
+    cache.Put(MakeKey(3, 0, 10), MakeBuckets(3));
+    TEST_EQUAL(cache.GetDiskSize(), 2 * kBufferSize, ());
+    TEST(cache.Get(MakeKey(0, 0, 10)) == nullptr, ());
+    TestBuckets(cache.Get(MakeKey(2, 0, 10)), 2);
+  }
+
+  Platform::FilesList files;
+  Platform::GetFilesByExt(params.m_spillDir, ".geom", files);
+  TEST(files.empty(), (files));
+  Platform::RmDirRecursively(params.m_spillDir);
+}
+
+UNIT_TEST(TileGeometryCache_Erase)
+{
+  TileGeometryCache cache(TileGeometryCache::Params{});
+
+  cache.Put(MakeKey(0, 0, 10), MakeBuckets(0));
+  cache.Put(MakeKey(5, 5, 10), MakeBuckets(1));
+  cache.Put(MakeKey(0, 0, 11), MakeBuckets(2));
+
+  cache.Erase(TileKey(0, 0, 12).GetGlobalRect());
+  TEST(cache.Get(MakeKey(0, 0, 10)) == nullptr, ());
+  TEST(cache.Get(MakeKey(0, 0, 11)) == nullptr, ());
+  TestBuckets(cache.Get(MakeKey(5, 5, 10)), 1);
+  TEST_EQUAL(cache.GetMemorySize(), kBufferSize, ());
+}
@@ -301,6 +301,7 @@ std::string DrapeMeasurer::GPUMemoryStatistic::ToString() const
   ss << m_maxMemoryValues.ToString();
   ss << "\n --Average memory values:\n";
   ss << m_averageMemoryValues.ToString();
+  ss << "\n" << m_bufferPoolStatistic.ToString();
   ss << " ----- GPU memory report ----- \n";
 
   return ss.str();
@@ -367,6 +368,7 @@ DrapeMeasurer::GPUMemoryStatistic DrapeMeasurer::GetGPUMemoryStatistic()
     statistic.m_averageMemoryValues.m_summaryAllocatedInMb /= m_numberOfSnapshots;
     statistic.m_averageMemoryValues.m_summaryUsedInMb /= m_numberOfSnapshots;
   }
+  statistic.m_bufferPoolStatistic = dp::GPUBufferPool::Instance().GetStatistic();
   return statistic;
 }
 #endif
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "drape/drape_diagnostics.hpp"
+#include "drape/gpu_buffer_pool.hpp"
 #include "drape/utils/gpu_mem_tracker.hpp"
 #include "drape/utils/glyph_usage_tracker.hpp"
 
@@ -86,6 +87,7 @@ public:
 
     dp::GPUMemTracker::GPUMemorySnapshot m_averageMemoryValues;
     dp::GPUMemTracker::GPUMemorySnapshot m_maxMemoryValues;
+    dp::GPUBufferPool::Statistic m_bufferPoolStatistic;
   };
 
   GPUMemoryStatistic GetGPUMemoryStatistic();
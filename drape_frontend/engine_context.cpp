@@ -15,7 +15,9 @@ EngineContext::EngineContext(TileKey tileKey,
                              CustomFeaturesContextWeakPtr customFeaturesContext,
                              bool is3dBuildingsEnabled,
                              bool isTrafficEnabled,
-                             int displacementMode)
+                             int displacementMode,
+                             bool isGeometryCached,
+                             bool isPrefetch)
   : m_tileKey(tileKey)
   , m_commutator(commutator)
   , m_texMng(texMng)
@@ -24,6 +26,8 @@ EngineContext::EngineContext(TileKey tileKey,
   , m_3dBuildingsEnabled(is3dBuildingsEnabled)
   , m_trafficEnabled(isTrafficEnabled)
   , m_displacementMode(displacementMode)
+  , m_isGeometryCached(isGeometryCached)
+  , m_isPrefetch(isPrefetch)
 {}
 
 ref_ptr<dp::TextureManager> EngineContext::GetTextureManager() const
@@ -38,29 +42,40 @@ ref_ptr<MetalineManager> EngineContext::GetMetalineManager() const
 
 void EngineContext::BeginReadTile()
 {
-  PostMessage(make_unique_dp<TileReadStartMessage>(m_tileKey));
+  PostMessage(make_unique_dp<TileReadStartMessage>(m_tileKey, m_isPrefetch));
 }
 
 void EngineContext::Flush(TMapShapes && shapes)
 {
-  PostMessage(make_unique_dp<MapShapeReadedMessage>(m_tileKey, move(shapes)));
+  PostMessage(make_unique_dp<MapShapeReadedMessage>(m_tileKey, move(shapes), m_isPrefetch));
 }
 
 void EngineContext::FlushOverlays(TMapShapes && shapes)
 {
+  if (m_isPrefetch)
+    return;
   PostMessage(make_unique_dp<OverlayMapShapeReadedMessage>(m_tileKey, move(shapes)));
 }
 
 void EngineContext::FlushTrafficGeometry(TrafficSegmentsGeometry && geometry)
 {
+  if (m_isPrefetch)
+    return;
   m_commutator->PostMessage(ThreadsCommutator::ResourceUploadThread,
                             make_unique_dp<FlushTrafficGeometryMessage>(m_tileKey, move(geometry)),
                             MessagePriority::Low);
 }
 
+void EngineContext::FlushTileGeometry()
+{
+  if (m_isPrefetch)
+    return;
+  PostMessage(make_unique_dp<TileReadFlushMessage>(m_tileKey));
+}
+
 void EngineContext::EndReadTile()
 {
-  PostMessage(make_unique_dp<TileReadEndMessage>(m_tileKey));
+  PostMessage(make_unique_dp<TileReadEndMessage>(m_tileKey, m_isPrefetch));
 }
 
 void EngineContext::PostMessage(drape_ptr<Message> && message)
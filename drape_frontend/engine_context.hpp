@@ -29,12 +29,20 @@ public:
                 CustomFeaturesContextWeakPtr customFeaturesContext,
                 bool is3dBuildingsEnabled,
                 bool isTrafficEnabled,
-                int displacementMode);
+                int displacementMode,
+                bool isGeometryCached,
+                bool isPrefetch);
 
   TileKey const & GetTileKey() const { return m_tileKey; }
   bool Is3dBuildingsEnabled() const { return m_3dBuildingsEnabled; }
   bool IsTrafficEnabled() const { return m_trafficEnabled; }
   int GetDisplacementMode() const { return m_displacementMode; }
+  // Geometry of the tile is uploaded from TileGeometryCache, so only
+  // overlays are needed.
+  bool IsGeometryCached() const { return m_isGeometryCached; }
+  // The tile is read ahead of the viewport to cache its geometry, so
+  // overlays and traffic aren't needed.
+  bool IsPrefetch() const { return m_isPrefetch; }
   CustomFeaturesContextWeakPtr GetCustomFeaturesContext() const { return m_customFeaturesContext; }
   ref_ptr<dp::TextureManager> GetTextureManager() const;
   ref_ptr<MetalineManager> GetMetalineManager() const;
@@ -43,6 +51,8 @@ public:
   void Flush(TMapShapes && shapes);
   void FlushOverlays(TMapShapes && shapes);
   void FlushTrafficGeometry(TrafficSegmentsGeometry && geometry);
+  // Shows the geometry flushed so far while the reading of the tile continues.
+  void FlushTileGeometry();
   void EndReadTile();
 
 private:
@@ -56,5 +66,7 @@ private:
   bool m_3dBuildingsEnabled;
   bool m_trafficEnabled;
   int m_displacementMode;
+  bool m_isGeometryCached;
+  bool m_isPrefetch;
 };
 }  // namespace df
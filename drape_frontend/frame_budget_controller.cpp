@@ -0,0 +1,113 @@
+#include "drape_frontend/frame_budget_controller.hpp"
+
+#include "base/assert.hpp"
+
+#include <algorithm>
+
+namespace df
+{
+namespace
+{
+double constexpr kDefaultTargetFrameTime = 1.0 / 60.0;
+}  // namespace
+
+// static
+uint32_t constexpr FrameBudgetController::kFramesInWindow;
+// static
+uint32_t constexpr FrameBudgetController::kMinRestoreWindows;
+// static
+uint32_t constexpr FrameBudgetController::kMaxRestoreWindows;
+// static
+double constexpr FrameBudgetController::kOverBudgetFactor;
+// static
+double constexpr FrameBudgetController::kInBudgetFactor;
+
+FrameBudgetController::FrameBudgetController() : m_targetFrameTime(kDefaultTargetFrameTime) {}
+
+void FrameBudgetController::SetTargetFrameTime(double frameTimeInSeconds)
+{
+  ASSERT_GREATER(frameTimeInSeconds, 0.0, ());
+  if (m_targetFrameTime == frameTimeInSeconds)
+    return;
+
+  m_targetFrameTime = frameTimeInSeconds;
+  m_inBudgetWindowsCount = 0;
+  ResetWindow();
+}
+
+bool FrameBudgetController::AddFrame(double frameTimeInSeconds)
+{
+  m_windowTime += frameTimeInSeconds;
+  if (++m_windowFramesCount < kFramesInWindow)
+    return false;
+
+  double const avgFrameTime = m_windowTime / m_windowFramesCount;
+  ResetWindow();
+
+  if (m_wasRestored && ++m_windowsSinceRestore > kMaxRestoreWindows)
+  {
+    // The restored level is stable, so the next restoring may be fast.
+    m_wasRestored = false;
+    m_restoreWindowsCount = kMinRestoreWindows;
+  }
+
+  if (avgFrameTime > m_targetFrameTime * kOverBudgetFactor)
+  {
+    m_inBudgetWindowsCount = 0;
+    if (m_wasRestored && m_windowsSinceRestore <= m_restoreWindowsCount)
+      m_restoreWindowsCount = std::min(2 * m_restoreWindowsCount, kMaxRestoreWindows);
+    m_wasRestored = false;
+
+    auto const next = static_cast<uint8_t>(m_level) + 1;
+    if (next == static_cast<uint8_t>(Level::Count))
+      return false;
+    m_level = static_cast<Level>(next);
+    return true;
+  }
+
+  if (avgFrameTime >= m_targetFrameTime * kInBudgetFactor || m_level == Level::Full)
+  {
+    m_inBudgetWindowsCount = 0;
+    return false;
+  }
+
+  if (++m_inBudgetWindowsCount < m_restoreWindowsCount)
+    return false;
+
+  m_inBudgetWindowsCount = 0;
+  m_level = static_cast<Level>(static_cast<uint8_t>(m_level) - 1);
+  m_wasRestored = true;
+  m_windowsSinceRestore = 0;
+  return true;
+}
+
+void FrameBudgetController::Reset()
+{
+  m_level = Level::Full;
+  m_inBudgetWindowsCount = 0;
+  m_restoreWindowsCount = kMinRestoreWindows;
+  m_windowsSinceRestore = 0;
+  m_wasRestored = false;
+  ResetWindow();
+}
+
+void FrameBudgetController::ResetWindow()
+{
+  m_windowTime = 0.0;
+  m_windowFramesCount = 0;
+}
+
+std::string DebugPrint(FrameBudgetController::Level level)
+{
+  switch (level)
+  {
+  case FrameBudgetController::Level::Full: return "Full";
+  case FrameBudgetController::Level::NoAntialiasing: return "NoAntialiasing";
+  case FrameBudgetController::Level::Simplified3d: return "Simplified3d";
+  case FrameBudgetController::Level::DelayedOverlays: return "DelayedOverlays";
+  case FrameBudgetController::Level::Count: return "Count";
+  }
+  ASSERT(false, ());
+  return {};
+}
+}  // namespace df
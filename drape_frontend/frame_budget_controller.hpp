@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace df
+{
+// Adapts quality of rendering to the time of frames. Times of frames are
+// averaged over windows of kFramesInWindow frames. When the average time
+// of a window exceeds the budget, the next feature is scaled down. When
+// the average time of several windows in a row fits the budget, the last
+// scaled down feature is restored. If the budget is exceeded again soon
+// after restoring, more windows are required for the next restoring, so
+// levels don't flip on the border of the budget.
+//
+// Times of frames must include the time of presenting, so the time of
+// GPU work affects them too.
+class FrameBudgetController
+{
+public:
+  enum class Level : uint8_t
+  {
+    // All features are enabled.
+    Full,
+    // Postprocess antialiasing is disabled.
+    NoAntialiasing,
+    // 3D buildings are rendered directly, without the offscreen framebuffer.
+    Simplified3d,
+    // The overlay tree is rebuilt less often.
+    DelayedOverlays,
+    Count
+  };
+
+  static uint32_t constexpr kFramesInWindow = 30;
+  static uint32_t constexpr kMinRestoreWindows = 3;
+  static uint32_t constexpr kMaxRestoreWindows = 48;
+
+  // The frame is over the budget when it's longer than the target time
+  // multiplied by kOverBudgetFactor and fits the budget when it's shorter
+  // than the target time multiplied by kInBudgetFactor. The factors are
+  // greater than 1, since the time includes waiting for vsync.
+  static double constexpr kOverBudgetFactor = 1.25;
+  static double constexpr kInBudgetFactor = 1.1;
+
+  FrameBudgetController();
+
+  // Changing of the target time starts a new window.
+  void SetTargetFrameTime(double frameTimeInSeconds);
+  double GetTargetFrameTime() const { return m_targetFrameTime; }
+
+  // Returns true when the level is changed.
+  bool AddFrame(double frameTimeInSeconds);
+  void Reset();
+
+  Level GetLevel() const { return m_level; }
+
+  bool IsAntialiasingAllowed() const { return m_level < Level::NoAntialiasing; }
+  bool Is3dFramebufferAllowed() const { return m_level < Level::Simplified3d; }
+  uint32_t GetOverlaysUpdateFactor() const { return m_level < Level::DelayedOverlays ? 1 : 2; }
+
+private:
+  void ResetWindow();
+
+  double m_targetFrameTime;
+  Level m_level = Level::Full;
+
+  double m_windowTime = 0.0;
+  uint32_t m_windowFramesCount = 0;
+
+  uint32_t m_inBudgetWindowsCount = 0;
+  uint32_t m_restoreWindowsCount = kMinRestoreWindows;
+  // Number of windows since the last restoring of a feature.
+  uint32_t m_windowsSinceRestore = 0;
+  bool m_wasRestored = false;
+};
+
+std::string DebugPrint(FrameBudgetController::Level level);
+}  // namespace df
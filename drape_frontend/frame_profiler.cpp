@@ -0,0 +1,314 @@
+#include "drape_frontend/frame_profiler.hpp"
+
+#include "drape/glfunctions.hpp"
+#include "drape/utils/render_counters.hpp"
+
+#include "base/assert.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <sstream>
+
+namespace df
+{
+namespace
+{
+void PrintTime(std::ostringstream & ss, std::string const & name,
+               FrameProfiler::TimeStatistic const & time)
+{
+  ss << " " << name << ": count = " << time.m_count << ", avg = " << time.m_avgTimeInUs
+     << "us, max = " << time.m_maxTimeInUs << "us\n";
+}
+}  // namespace
+
+std::string FrameProfiler::Statistic::ToString() const
+{
+  std::ostringstream ss;
+  ss << "\n ===== Frame profiler statistic =====\n";
+  PrintTime(ss, "Frame", m_frameTime);
+  for (size_t i = 0; i < kPhasesCount; ++i)
+  {
+    std::string const name = DebugPrint(static_cast<Phase>(i));
+    PrintTime(ss, name + " CPU", m_cpuPhaseTime[i]);
+    if (m_gpuPhaseTime[i].m_count != 0)
+      PrintTime(ss, name + " GPU", m_gpuPhaseTime[i]);
+  }
+  PrintTime(ss, "Overlay tree rebuild", m_overlayTreeRebuildTime);
+  ss << " Draw calls per frame: avg = " << m_avgDrawCallsCount
+     << ", max = " << m_maxDrawCallsCount << "\n";
+  ss << " Buckets per frame: avg = " << m_avgBucketsCount << ", max = " << m_maxBucketsCount
+     << "\n";
+  ss << " Uploaded bytes = " << m_uploadedBytes << "\n";
+  return ss.str();
+}
+
+FrameProfiler::PhaseGuard::PhaseGuard(Phase phase) : m_phase(phase)
+{
+  FrameProfiler::Instance().BeginPhase(m_phase);
+}
+
+FrameProfiler::PhaseGuard::~PhaseGuard() { FrameProfiler::Instance().EndPhase(m_phase); }
+
+void FrameProfiler::TimeAccumulator::Add(uint64_t timeInUs)
+{
+  m_sum += timeInUs;
+  ++m_count;
+  m_max = std::max(m_max, static_cast<uint32_t>(
+                              std::min<uint64_t>(timeInUs, std::numeric_limits<uint32_t>::max())));
+}
+
+FrameProfiler::TimeStatistic FrameProfiler::TimeAccumulator::Get() const
+{
+  TimeStatistic result;
+  result.m_count = m_count;
+  result.m_maxTimeInUs = m_max;
+  if (m_count != 0)
+    result.m_avgTimeInUs = static_cast<uint32_t>(m_sum / m_count);
+  return result;
+}
+
+// static
+FrameProfiler & FrameProfiler::Instance()
+{
+  static FrameProfiler profiler;
+  return profiler;
+}
+
+// static
+uint64_t FrameProfiler::ToMicroseconds(TClock::duration const & duration)
+{
+  return static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::microseconds>(duration).count());
+}
+
+void FrameProfiler::SetEnabled(bool enabled)
+{
+  m_isEnabled = enabled;
+  dp::RenderCounters::Instance().SetEnabled(enabled);
+}
+
+void FrameProfiler::SetGpuTimerSupported(bool isSupported)
+{
+  ASSERT(!m_hasQueries, ());
+  m_isGpuTimerSupported = isSupported;
+}
+
+void FrameProfiler::ReleaseGpuResources()
+{
+  DeleteQueries();
+  m_isGpuTimerSupported = false;
+}
+
+bool FrameProfiler::IsGpuTimerUsed() const { return m_isGpuTimerSupported && m_isFrameProfiled; }
+
+void FrameProfiler::CreateQueries()
+{
+  if (m_hasQueries)
+    return;
+
+  for (auto & frame : m_gpuFrames)
+  {
+    for (auto & query : frame.m_queries)
+      query = GLFunctions::glGenQuery();
+  }
+  m_hasQueries = true;
+}
+
+void FrameProfiler::DeleteQueries()
+{
+  if (!m_hasQueries)
+    return;
+
+  for (auto & frame : m_gpuFrames)
+  {
+    for (auto & query : frame.m_queries)
+      GLFunctions::glDeleteQuery(query);
+    frame = GpuFrame();
+  }
+  m_gpuFrameIndex = 0;
+  m_hasQueries = false;
+}
+
+bool FrameProfiler::CollectGpuResults(GpuFrame & frame)
+{
+  ASSERT(frame.m_isPending, ());
+
+  // Queries are completed in order, so it's enough to check the last one.
+  for (size_t i = kPhasesCount; i > 0; --i)
+  {
+    if (!frame.m_isQueried[i - 1])
+      continue;
+    if (GLFunctions::glGetQueryObjectui(frame.m_queries[i - 1],
+                                        gl_const::GLQueryResultAvailable) == 0)
+    {
+      return false;
+    }
+    break;
+  }
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  for (size_t i = 0; i < kPhasesCount; ++i)
+  {
+    if (!frame.m_isQueried[i])
+      continue;
+    uint64_t const timeInNs =
+        GLFunctions::glGetQueryObjectui64(frame.m_queries[i], gl_const::GLQueryResult);
+    m_gpuPhaseTime[i].Add(timeInNs / 1000);
+    frame.m_isQueried[i] = false;
+  }
+  frame.m_isPending = false;
+  return true;
+}
+
+void FrameProfiler::BeginFrame()
+{
+  m_isFrameProfiled = m_isEnabled;
+  m_isGpuFrameProfiled = false;
+  if (!m_isFrameProfiled)
+  {
+    // Queries are kept only while the profiler is enabled.
+    DeleteQueries();
+    return;
+  }
+
+  m_phaseTimeInUs.fill(0);
+  m_frameStartTime = TClock::now();
+
+  if (!IsGpuTimerUsed())
+    return;
+
+  CreateQueries();
+  // The frame is measured by GPU only if results of the frame which
+  // used the same queries are ready.
+  GpuFrame & frame = m_gpuFrames[m_gpuFrameIndex];
+  m_isGpuFrameProfiled = !frame.m_isPending || CollectGpuResults(frame);
+}
+
+void FrameProfiler::EndFrame()
+{
+  if (!m_isFrameProfiled)
+    return;
+
+  uint64_t const frameTime = ToMicroseconds(TClock::now() - m_frameStartTime);
+  auto const counters = dp::RenderCounters::Instance().Take();
+
+  if (m_isGpuFrameProfiled)
+  {
+    GpuFrame & frame = m_gpuFrames[m_gpuFrameIndex];
+    frame.m_isPending =
+        std::any_of(frame.m_isQueried.begin(), frame.m_isQueried.end(), [](bool v) { return v; });
+    m_gpuFrameIndex = (m_gpuFrameIndex + 1) % kGpuFramesCount;
+  }
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_frameTime.Add(frameTime);
+  for (size_t i = 0; i < kPhasesCount; ++i)
+    m_cpuPhaseTime[i].Add(m_phaseTimeInUs[i]);
+
+  m_drawCallsCount += counters.m_drawCallsCount;
+  m_maxDrawCallsCount = std::max(m_maxDrawCallsCount, counters.m_drawCallsCount);
+  m_bucketsCount += counters.m_bucketsCount;
+  m_maxBucketsCount = std::max(m_maxBucketsCount, counters.m_bucketsCount);
+  m_uploadedBytes += counters.m_uploadedBytes;
+}
+
+void FrameProfiler::BeginPhase(Phase phase)
+{
+  if (!m_isFrameProfiled)
+    return;
+
+  auto const index = static_cast<size_t>(phase);
+  m_phaseStartTime[index] = TClock::now();
+
+  // Time elapsed queries can't be nested, and a phase is measured by GPU
+  // once per frame.
+  GpuFrame & frame = m_gpuFrames[m_gpuFrameIndex];
+  if (m_isGpuFrameProfiled && !frame.m_isQueried[index])
+    GLFunctions::glBeginQuery(gl_const::GLTimeElapsed, frame.m_queries[index]);
+}
+
+void FrameProfiler::EndPhase(Phase phase)
+{
+  if (!m_isFrameProfiled)
+    return;
+
+  auto const index = static_cast<size_t>(phase);
+  m_phaseTimeInUs[index] += ToMicroseconds(TClock::now() - m_phaseStartTime[index]);
+
+  GpuFrame & frame = m_gpuFrames[m_gpuFrameIndex];
+  if (m_isGpuFrameProfiled && !frame.m_isQueried[index])
+  {
+    GLFunctions::glEndQuery(gl_const::GLTimeElapsed);
+    frame.m_isQueried[index] = true;
+  }
+}
+
+void FrameProfiler::BeginOverlayTreeRebuild()
+{
+  if (m_isFrameProfiled)
+    m_overlayTreeRebuildStartTime = TClock::now();
+}
+
+void FrameProfiler::EndOverlayTreeRebuild()
+{
+  if (!m_isFrameProfiled)
+    return;
+
+  uint64_t const time = ToMicroseconds(TClock::now() - m_overlayTreeRebuildStartTime);
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_overlayTreeRebuildTime.Add(time);
+}
+
+FrameProfiler::Statistic FrameProfiler::TakeStatistic()
+{
+  Statistic result;
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  result.m_frameTime = m_frameTime.Get();
+  for (size_t i = 0; i < kPhasesCount; ++i)
+  {
+    result.m_cpuPhaseTime[i] = m_cpuPhaseTime[i].Get();
+    result.m_gpuPhaseTime[i] = m_gpuPhaseTime[i].Get();
+  }
+  result.m_overlayTreeRebuildTime = m_overlayTreeRebuildTime.Get();
+
+  uint32_t const framesCount = result.m_frameTime.m_count;
+  if (framesCount != 0)
+  {
+    result.m_avgDrawCallsCount = static_cast<uint32_t>(m_drawCallsCount / framesCount);
+    result.m_avgBucketsCount = static_cast<uint32_t>(m_bucketsCount / framesCount);
+  }
+  result.m_maxDrawCallsCount = m_maxDrawCallsCount;
+  result.m_maxBucketsCount = m_maxBucketsCount;
+  result.m_uploadedBytes = m_uploadedBytes;
+
+  m_frameTime = TimeAccumulator();
+  m_cpuPhaseTime.fill(TimeAccumulator());
+  m_gpuPhaseTime.fill(TimeAccumulator());
+  m_overlayTreeRebuildTime = TimeAccumulator();
+  m_drawCallsCount = 0;
+  m_maxDrawCallsCount = 0;
+  m_bucketsCount = 0;
+  m_maxBucketsCount = 0;
+  m_uploadedBytes = 0;
+  return result;
+}
+
+std::string DebugPrint(FrameProfiler::Phase phase)
+{
+  switch (phase)
+  {
+  case FrameProfiler::Phase::Geometry2d: return "Geometry2d";
+  case FrameProfiler::Phase::UserLines: return "UserLines";
+  case FrameProfiler::Phase::TrafficAndRoute: return "TrafficAndRoute";
+  case FrameProfiler::Phase::Geometry3d: return "Geometry3d";
+  case FrameProfiler::Phase::Overlays: return "Overlays";
+  case FrameProfiler::Phase::UserMarks: return "UserMarks";
+  case FrameProfiler::Phase::MyPosition: return "MyPosition";
+  case FrameProfiler::Phase::Gui: return "Gui";
+  case FrameProfiler::Phase::Postprocess: return "Postprocess";
+  case FrameProfiler::Phase::Count: ASSERT(false, ()); return "Count";
+  }
+  return {};
+}
+}  // namespace df
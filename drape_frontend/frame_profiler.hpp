@@ -0,0 +1,167 @@
+#pragma once
+
+#include "base/macros.hpp"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+namespace df
+{
+// Runtime profiler of frames of the frontend renderer. When it's
+// enabled, it measures CPU time of phases of a frame, GPU time of the
+// same phases (if timer queries are supported), counts of draw calls
+// and render buckets, bytes uploaded to vertex and index buffers and
+// time of overlay tree rebuilding. The statistic is accumulated until
+// somebody takes it, e.g. to send it to telemetry.
+//
+// All methods except SetEnabled(), IsEnabled() and TakeStatistic() must
+// be called on the frontend renderer thread. GPU timings come a few
+// frames later than CPU ones, since results of queries are read without
+// stalling the pipeline.
+class FrameProfiler
+{
+public:
+  enum class Phase : uint8_t
+  {
+    Geometry2d,
+    UserLines,
+    TrafficAndRoute,
+    Geometry3d,
+    Overlays,
+    UserMarks,
+    MyPosition,
+    Gui,
+    Postprocess,
+    Count
+  };
+
+  static size_t constexpr kPhasesCount = static_cast<size_t>(Phase::Count);
+
+  struct TimeStatistic
+  {
+    uint32_t m_count = 0;
+    uint32_t m_avgTimeInUs = 0;
+    uint32_t m_maxTimeInUs = 0;
+  };
+
+  struct Statistic
+  {
+    std::string ToString() const;
+
+    TimeStatistic m_frameTime;
+    std::array<TimeStatistic, kPhasesCount> m_cpuPhaseTime;
+    // Counts are numbers of frames with GPU timings.
+    std::array<TimeStatistic, kPhasesCount> m_gpuPhaseTime;
+    TimeStatistic m_overlayTreeRebuildTime;
+
+    uint32_t m_avgDrawCallsCount = 0;
+    uint32_t m_maxDrawCallsCount = 0;
+    uint32_t m_avgBucketsCount = 0;
+    uint32_t m_maxBucketsCount = 0;
+    uint64_t m_uploadedBytes = 0;
+  };
+
+  class PhaseGuard
+  {
+  public:
+    explicit PhaseGuard(Phase phase);
+    ~PhaseGuard();
+
+  private:
+    Phase const m_phase;
+    DISALLOW_COPY_AND_MOVE(PhaseGuard);
+  };
+
+  static FrameProfiler & Instance();
+
+  void SetEnabled(bool enabled);
+  bool IsEnabled() const { return m_isEnabled; }
+
+  // Timer queries are used only after the renderer checks that they
+  // are supported by the context. Resources must be released before
+  // destruction of the context.
+  void SetGpuTimerSupported(bool isSupported);
+  void ReleaseGpuResources();
+
+  void BeginFrame();
+  void EndFrame();
+
+  void BeginPhase(Phase phase);
+  void EndPhase(Phase phase);
+
+  void BeginOverlayTreeRebuild();
+  void EndOverlayTreeRebuild();
+
+  // Returns the statistic accumulated since the previous call and resets it.
+  Statistic TakeStatistic();
+
+private:
+  using TClock = std::chrono::steady_clock;
+
+  class TimeAccumulator
+  {
+  public:
+    void Add(uint64_t timeInUs);
+    TimeStatistic Get() const;
+
+  private:
+    uint64_t m_sum = 0;
+    uint32_t m_count = 0;
+    uint32_t m_max = 0;
+  };
+
+  struct GpuFrame
+  {
+    std::array<uint32_t, kPhasesCount> m_queries = {};
+    std::array<bool, kPhasesCount> m_isQueried = {};
+    bool m_isPending = false;
+  };
+
+  // Queries of a frame are reused when the frame comes around again.
+  static size_t constexpr kGpuFramesCount = 4;
+
+  FrameProfiler() = default;
+
+  static uint64_t ToMicroseconds(TClock::duration const & duration);
+
+  bool IsGpuTimerUsed() const;
+  void CreateQueries();
+  void DeleteQueries();
+  // Returns false if results aren't ready yet.
+  bool CollectGpuResults(GpuFrame & frame);
+
+  std::atomic<bool> m_isEnabled{false};
+
+  // State of the current frame.
+  bool m_isFrameProfiled = false;
+  bool m_isGpuFrameProfiled = false;
+  TClock::time_point m_frameStartTime;
+  std::array<TClock::time_point, kPhasesCount> m_phaseStartTime;
+  std::array<uint64_t, kPhasesCount> m_phaseTimeInUs = {};
+  TClock::time_point m_overlayTreeRebuildStartTime;
+
+  bool m_isGpuTimerSupported = false;
+  bool m_hasQueries = false;
+  std::array<GpuFrame, kGpuFramesCount> m_gpuFrames;
+  size_t m_gpuFrameIndex = 0;
+
+  std::mutex m_mutex;
+  TimeAccumulator m_frameTime;
+  std::array<TimeAccumulator, kPhasesCount> m_cpuPhaseTime;
+  std::array<TimeAccumulator, kPhasesCount> m_gpuPhaseTime;
+  TimeAccumulator m_overlayTreeRebuildTime;
+  uint64_t m_drawCallsCount = 0;
+  uint32_t m_maxDrawCallsCount = 0;
+  uint64_t m_bucketsCount = 0;
+  uint32_t m_maxBucketsCount = 0;
+  uint64_t m_uploadedBytes = 0;
+
+  DISALLOW_COPY_AND_MOVE(FrameProfiler);
+};
+
+std::string DebugPrint(FrameProfiler::Phase phase);
+}  // namespace df
@@ -3,6 +3,7 @@
 #include "drape_frontend/animation_system.hpp"
 #include "drape_frontend/batch_merge_helper.hpp"
 #include "drape_frontend/drape_measurer.hpp"
+#include "drape_frontend/frame_profiler.hpp"
 #include "drape_frontend/gui/drape_gui.hpp"
 #include "drape_frontend/gui/ruler_helper.hpp"
 #include "drape_frontend/message_subclasses.hpp"
@@ -16,6 +17,8 @@
 
 #include "drape/debug_rect_renderer.hpp"
 #include "drape/framebuffer.hpp"
+#include "drape/glextensions_list.hpp"
+#include "drape/gpu_buffer_pool.hpp"
 #include "drape/support_manager.hpp"
 #include "drape/utils/glyph_usage_tracker.hpp"
 #include "drape/utils/gpu_mem_tracker.hpp"
@@ -64,6 +67,42 @@ struct MergedGroupKey
   }
 };
 
+// Groups of adjacent tiles are merged by cells of kMergeCellSize x kMergeCellSize tiles.
+int constexpr kMergeCellSize = 4;
+// Merging reads buffers back from GPU, so the number of cells merged at once is limited.
+size_t constexpr kMaxMergedCellsCount = 8;
+
+struct MergedTilesKey
+{
+  dp::GLState m_state;
+  int m_zoomLevel;
+  int m_cellX;
+  int m_cellY;
+
+  MergedTilesKey(dp::GLState const & state, TileKey const & tileKey)
+    : m_state(state)
+    , m_zoomLevel(tileKey.m_zoomLevel)
+    , m_cellX(GetCell(tileKey.m_x))
+    , m_cellY(GetCell(tileKey.m_y))
+  {}
+
+  bool operator <(MergedTilesKey const & other) const
+  {
+    if (!(m_state == other.m_state))
+      return m_state < other.m_state;
+    if (m_zoomLevel != other.m_zoomLevel)
+      return m_zoomLevel < other.m_zoomLevel;
+    if (m_cellX != other.m_cellX)
+      return m_cellX < other.m_cellX;
+    return m_cellY < other.m_cellY;
+  }
+
+  static int GetCell(int tileCoord)
+  {
+    return tileCoord >= 0 ? tileCoord / kMergeCellSize : (tileCoord + 1) / kMergeCellSize - 1;
+  }
+};
+
 template <typename ToDo>
 bool RemoveGroups(ToDo & filter, std::vector<drape_ptr<RenderGroup>> & groups,
                   ref_ptr<dp::OverlayTree> tree)
@@ -280,6 +319,10 @@ void FrontendRenderer::AcceptMessage(ref_ptr<Message> message)
       if (changed)
         UpdateCanBeDeletedStatus();
 
+#ifdef SCENARIO_ENABLE
+      m_scenarioManager->OnTilesRead(msg->GetTiles().size(), m_notFinishedTiles.empty());
+#endif
+
       if (m_notFinishedTiles.empty())
       {
 #if defined(DRAPE_MEASURER) && defined(GENERATING_STATISTIC)
@@ -556,6 +599,7 @@ void FrontendRenderer::AcceptMessage(ref_ptr<Message> message)
       // Clear all graphics.
       for (RenderLayer & layer : m_layers)
       {
+        layer.m_mergedGroups.clear();
         layer.m_renderGroups.clear();
         layer.m_isDirty = false;
       }
@@ -755,6 +799,15 @@ void FrontendRenderer::AcceptMessage(ref_ptr<Message> message)
       break;
     }
 
+  case Message::UpdateTrafficColors:
+    {
+      if (!m_trafficEnabled)
+        break;
+      ref_ptr<UpdateTrafficColorsMessage> msg = message;
+      m_trafficRenderer->UpdateTraffic(msg->GetSegmentsColoring(), msg->GetTexCoords());
+      break;
+    }
+
   case Message::ClearTrafficData:
     {
       ref_ptr<ClearTrafficDataMessage> msg = message;
@@ -784,6 +837,8 @@ void FrontendRenderer::AcceptMessage(ref_ptr<Message> message)
       ref_ptr<UpdateCustomFeaturesMessage> msg = message;
       m_overlaysTracker->SetTrackedOverlaysFeatures(msg->AcceptFeatures());
       m_forceUpdateScene = true;
+      // Only tiles with changed custom features are reread.
+      InvalidatePoints(msg->AcceptChangedPositions());
       break;
     }
 
@@ -876,7 +931,7 @@ bool FrontendRenderer::CheckRouteRecaching(ref_ptr<BaseRouteData> routeData)
 
 void FrontendRenderer::InvalidateRect(m2::RectD const & gRect)
 {
-  ScreenBase screen = m_userEventStream.GetCurrentScreen();
+  ScreenBase const & screen = m_userEventStream.GetCurrentScreen();
   m2::RectD rect = gRect;
   if (rect.Intersect(screen.ClipRect()))
   {
@@ -889,34 +944,59 @@ void FrontendRenderer::InvalidateRect(m2::RectD const & gRect)
       if (rect.IsIntersect(key.GetGlobalRect()))
         tiles.insert(key);
     });
+    InvalidateTiles(tiles);
+  }
+}
 
-    // Remove tiles to invalidate from screen.
-    auto eraseFunction = [&tiles](drape_ptr<RenderGroup> const & group)
-    {
-      return tiles.find(group->GetTileKey()) != tiles.end();
-    };
-    for (RenderLayer & layer : m_layers)
-    {
-      RemoveGroups(eraseFunction, layer.m_renderGroups, make_ref(m_overlayTree));
-      layer.m_isDirty = true;
-    }
+void FrontendRenderer::InvalidatePoints(std::vector<m2::PointD> const & points)
+{
+  ScreenBase const & screen = m_userEventStream.GetCurrentScreen();
+  m2::RectD const clipRect = screen.ClipRect();
+  int const dataZoomLevel = ClipTileZoomByMaxDataZoom(m_currentZoomLevel);
 
-    // Remove tiles to invalidate from backend renderer.
-    BaseBlockingMessage::Blocker blocker;
-    m_commutator->PostMessage(ThreadsCommutator::ResourceUploadThread,
-                              make_unique_dp<InvalidateReadManagerRectMessage>(blocker, tiles),
-                              MessagePriority::High);
-    blocker.Wait();
+  TTilesCollection tiles;
+  for (auto const & pt : points)
+  {
+    if (!clipRect.IsPointInside(pt))
+      continue;
+    TileKey const key = GetTileKeyByPoint(pt, dataZoomLevel);
+    tiles.insert(TileKey(key.m_x, key.m_y, m_currentZoomLevel));
+  }
 
-    // Request new tiles.
-    m_lastReadedModelView = screen;
-    m_requestedTiles->Set(screen, m_isIsometry || screen.isPerspective(),
-                          m_forceUpdateScene, m_forceUpdateUserMarks,
-                          ResolveTileKeys(screen));
-    m_commutator->PostMessage(ThreadsCommutator::ResourceUploadThread,
-                              make_unique_dp<UpdateReadManagerMessage>(),
-                              MessagePriority::UberHighSingleton);
+  if (!tiles.empty())
+    InvalidateTiles(tiles);
+}
+
+void FrontendRenderer::InvalidateTiles(TTilesCollection const & tiles)
+{
+  ScreenBase const screen = m_userEventStream.GetCurrentScreen();
+
+  // Remove tiles to invalidate from screen.
+  auto eraseFunction = [&tiles](drape_ptr<RenderGroup> const & group)
+  {
+    return tiles.find(group->GetTileKey()) != tiles.end();
+  };
+  for (RenderLayer & layer : m_layers)
+  {
+    RemoveGroups(eraseFunction, layer.m_renderGroups, make_ref(m_overlayTree));
+    layer.m_isDirty = true;
   }
+
+  // Remove tiles to invalidate from backend renderer.
+  BaseBlockingMessage::Blocker blocker;
+  m_commutator->PostMessage(ThreadsCommutator::ResourceUploadThread,
+                            make_unique_dp<InvalidateReadManagerRectMessage>(blocker, tiles),
+                            MessagePriority::High);
+  blocker.Wait();
+
+  // Request new tiles.
+  m_lastReadedModelView = screen;
+  m_requestedTiles->Set(screen, m_isIsometry || screen.isPerspective(),
+                        m_forceUpdateScene, m_forceUpdateUserMarks,
+                        ResolveTileKeys(screen));
+  m_commutator->PostMessage(ThreadsCommutator::ResourceUploadThread,
+                            make_unique_dp<UpdateReadManagerMessage>(),
+                            MessagePriority::UberHighSingleton);
 }
 
 void FrontendRenderer::OnResize(ScreenBase const & screen)
@@ -1125,6 +1205,9 @@ void FrontendRenderer::RenderScene(ScreenBase const & modelView)
   DrapeMeasurer::Instance().BeforeRenderFrame();
 #endif
 
+  FrameProfiler & profiler = FrameProfiler::Instance();
+  profiler.BeginFrame();
+
   m_postprocessRenderer->BeginFrame();
 
   GLFunctions::glEnable(gl_const::GLDepthTest);
@@ -1132,17 +1215,32 @@ void FrontendRenderer::RenderScene(ScreenBase const & modelView)
   RefreshBgColor();
   GLFunctions::glClear(gl_const::GLColorBit | gl_const::GLDepthBit | gl_const::GLStencilBit);
 
-  Render2dLayer(modelView);
-  RenderUserMarksLayer(modelView, RenderState::UserLineLayer);
+  {
+    FrameProfiler::PhaseGuard guard(FrameProfiler::Phase::Geometry2d);
+    Render2dLayer(modelView);
+  }
 
-  if (m_buildingsFramebuffer->IsSupported())
   {
-    RenderTrafficAndRouteLayer(modelView);
+    FrameProfiler::PhaseGuard guard(FrameProfiler::Phase::UserLines);
+    RenderUserMarksLayer(modelView, RenderState::UserLineLayer);
+  }
+
+  if (m_buildingsFramebuffer->IsSupported() && m_frameBudgetController.Is3dFramebufferAllowed())
+  {
+    {
+      FrameProfiler::PhaseGuard guard(FrameProfiler::Phase::TrafficAndRoute);
+      RenderTrafficAndRouteLayer(modelView);
+    }
+    FrameProfiler::PhaseGuard guard(FrameProfiler::Phase::Geometry3d);
     Render3dLayer(modelView, true /* useFramebuffer */);
   }
   else
   {
-    Render3dLayer(modelView, false /* useFramebuffer */);
+    {
+      FrameProfiler::PhaseGuard guard(FrameProfiler::Phase::Geometry3d);
+      Render3dLayer(modelView, false /* useFramebuffer */);
+    }
+    FrameProfiler::PhaseGuard guard(FrameProfiler::Phase::TrafficAndRoute);
     RenderTrafficAndRouteLayer(modelView);
   }
 
@@ -1167,6 +1265,7 @@ void FrontendRenderer::RenderScene(ScreenBase const & modelView)
   }
 
   {
+    FrameProfiler::PhaseGuard profilerGuard(FrameProfiler::Phase::Overlays);
     StencilWriterGuard guard(make_ref(m_postprocessRenderer));
     RenderOverlayLayer(modelView);
     RenderUserMarksLayer(modelView, RenderState::LocalAdsMarkLayer);
@@ -1183,18 +1282,23 @@ void FrontendRenderer::RenderScene(ScreenBase const & modelView)
   }
 
   {
+    FrameProfiler::PhaseGuard profilerGuard(FrameProfiler::Phase::UserMarks);
     StencilWriterGuard guard(make_ref(m_postprocessRenderer));
     RenderUserMarksLayer(modelView, RenderState::UserMarkLayer);
     RenderUserMarksLayer(modelView, RenderState::RoutingMarkLayer);
   }
 
-  m_myPositionController->Render(modelView, m_currentZoomLevel, make_ref(m_gpuProgramManager),
-                                 m_generalUniforms);
+  {
+    FrameProfiler::PhaseGuard guard(FrameProfiler::Phase::MyPosition);
+    m_myPositionController->Render(modelView, m_currentZoomLevel, make_ref(m_gpuProgramManager),
+                                   m_generalUniforms);
+  }
 
   m_drapeApiRenderer->Render(modelView, make_ref(m_gpuProgramManager), m_generalUniforms);
 
   if (m_guiRenderer != nullptr)
   {
+    FrameProfiler::PhaseGuard profilerGuard(FrameProfiler::Phase::Gui);
     StencilWriterGuard guard(make_ref(m_postprocessRenderer));
     m_guiRenderer->Render(make_ref(m_gpuProgramManager), m_myPositionController->IsInRouting(),
                           modelView);
@@ -1203,7 +1307,12 @@ void FrontendRenderer::RenderScene(ScreenBase const & modelView)
   for (auto const & arrow : m_overlayTree->GetDisplacementInfo())
     dp::DebugRectRenderer::Instance().DrawArrow(modelView, arrow);
 
-  m_postprocessRenderer->EndFrame(make_ref(m_gpuProgramManager));
+  {
+    FrameProfiler::PhaseGuard guard(FrameProfiler::Phase::Postprocess);
+    m_postprocessRenderer->EndFrame(make_ref(m_gpuProgramManager));
+  }
+
+  profiler.EndFrame();
 
 #if defined(DRAPE_MEASURER) && (defined(RENDER_STATISTIC) || defined(TRACK_GPU_MEM))
   DrapeMeasurer::Instance().AfterRenderFrame();
@@ -1218,7 +1327,7 @@ void FrontendRenderer::Render2dLayer(ScreenBase const & modelView)
   layer2d.Sort(make_ref(m_overlayTree));
 
   for (drape_ptr<RenderGroup> const & group : layer2d.m_renderGroups)
-    RenderSingleGroup(modelView, make_ref(group));
+    RenderGeometryGroup(modelView, make_ref(group));
 }
 
 void FrontendRenderer::Render3dLayer(ScreenBase const & modelView, bool useFramebuffer)
@@ -1244,7 +1353,7 @@ void FrontendRenderer::Render3dLayer(ScreenBase const & modelView, bool useFrame
 
   layer.Sort(make_ref(m_overlayTree));
   for (drape_ptr<RenderGroup> const & group : layer.m_renderGroups)
-    RenderSingleGroup(modelView, make_ref(group));
+    RenderGeometryGroup(modelView, make_ref(group));
 
   if (useFramebuffer)
   {
@@ -1310,6 +1419,10 @@ void FrontendRenderer::BuildOverlayTree(ScreenBase const & modelView)
                                                         RenderState::NavigationLayer,
                                                         RenderState::RoutingMarkLayer};
   BeginUpdateOverlayTree(modelView);
+  bool const isRebuilt = m_overlayTree->IsNeedUpdate();
+  if (isRebuilt)
+    FrameProfiler::Instance().BeginOverlayTreeRebuild();
+
   for (auto const & layerId : layers)
   {
     RenderLayer & overlay = m_layers[layerId];
@@ -1318,6 +1431,9 @@ void FrontendRenderer::BuildOverlayTree(ScreenBase const & modelView)
       UpdateOverlayTree(modelView, group);
   }
   EndUpdateOverlayTree();
+
+  if (isRebuilt)
+    FrameProfiler::Instance().EndOverlayTreeRebuild();
 }
 
 void FrontendRenderer::PrepareBucket(dp::GLState const & state, drape_ptr<dp::RenderBucket> & bucket)
@@ -1337,6 +1453,17 @@ void FrontendRenderer::MergeBuckets()
   if (!BatchMergeHelper::IsMergeSupported())
     return;
 
+  for (size_t const layerId : {RenderState::GeometryLayer, RenderState::Geometry3dLayer})
+  {
+    auto & mergedGroups = m_layers[layerId].m_mergedGroups;
+    mergedGroups.erase(std::remove_if(mergedGroups.begin(), mergedGroups.end(),
+                                      [](drape_ptr<MergedRenderGroup> const & group)
+                                      {
+                                        return !group->IsValid();
+                                      }),
+                       mergedGroups.end());
+  }
+
   ++m_mergeBucketsCounter;
   if (m_mergeBucketsCounter < 60)
     return;
@@ -1385,9 +1512,59 @@ void FrontendRenderer::MergeBuckets()
     layer.m_isDirty = true;
   };
 
+  size_t mergedCellsCount = 0;
+  auto mergeTilesFn = [&mergedCellsCount](RenderLayer & layer, bool isPerspective)
+  {
+    using TCellsMap = map<MergedTilesKey, std::vector<ref_ptr<RenderGroup>>>;
+    TCellsMap cells;
+    for (drape_ptr<RenderGroup> const & group : layer.m_renderGroups)
+    {
+      ref_ptr<RenderGroup> g = make_ref(group);
+      if (!g->IsPendingOnDelete() && BatchMergeHelper::CanMergeTiles(g))
+        cells[MergedTilesKey(g->GetState(), g->GetTileKey())].push_back(g);
+    }
+
+    for (TCellsMap::value_type & node : cells)
+    {
+      std::vector<ref_ptr<RenderGroup>> const & groups = node.second;
+      if (groups.size() < 2)
+        continue;
+
+      ref_ptr<MergedRenderGroup> const mergedGroup = groups.front()->GetMergedGroup();
+      bool const isMerged = mergedGroup != nullptr &&
+                            mergedGroup->GetSourcesCount() == groups.size() &&
+                            std::all_of(groups.begin(), groups.end(), [&mergedGroup](ref_ptr<RenderGroup> g)
+                            {
+                              return g->GetMergedGroup() == mergedGroup;
+                            });
+      if (isMerged || mergedCellsCount == kMaxMergedCellsCount)
+        continue;
+
+      // The cell is changed since the last merging, so it's merged again.
+      for (ref_ptr<RenderGroup> g : groups)
+      {
+        if (g->GetMergedGroup() != nullptr)
+          g->GetMergedGroup()->Invalidate();
+      }
+
+      drape_ptr<MergedRenderGroup> newGroup = BatchMergeHelper::MergeTiles(groups, isPerspective);
+      if (newGroup != nullptr)
+        layer.m_mergedGroups.push_back(std::move(newGroup));
+      ++mergedCellsCount;
+    }
+  };
+
   bool const isPerspective = m_userEventStream.GetCurrentScreen().isPerspective();
   mergeFn(m_layers[RenderState::GeometryLayer], isPerspective);
   mergeFn(m_layers[RenderState::Geometry3dLayer], isPerspective);
+
+  // Tiles are merged when all of them are read, so the merged groups aren't
+  // invalidated by the tiles which are being read right away.
+  if (m_notFinishedTiles.empty())
+  {
+    mergeTilesFn(m_layers[RenderState::GeometryLayer], isPerspective);
+    mergeTilesFn(m_layers[RenderState::Geometry3dLayer], isPerspective);
+  }
 }
 
 void FrontendRenderer::RenderSingleGroup(ScreenBase const & modelView, ref_ptr<BaseRenderGroup> group)
@@ -1396,6 +1573,16 @@ void FrontendRenderer::RenderSingleGroup(ScreenBase const & modelView, ref_ptr<B
   group->Render(modelView);
 }
 
+void FrontendRenderer::RenderGeometryGroup(ScreenBase const & modelView, ref_ptr<RenderGroup> group)
+{
+  // Groups are sorted by state, so the merged group is rendered in place of its first source.
+  ref_ptr<MergedRenderGroup> mergedGroup = group->GetMergedGroup();
+  if (mergedGroup == nullptr)
+    RenderSingleGroup(modelView, group);
+  else if (mergedGroup->IsFirstSource(group))
+    RenderSingleGroup(modelView, mergedGroup);
+}
+
 void FrontendRenderer::RefreshProjection(ScreenBase const & screen)
 {
   std::array<float, 16> m;
@@ -1703,6 +1890,10 @@ TTilesCollection FrontendRenderer::ResolveTileKeys(ScreenBase const & screen)
   DrapeMeasurer::Instance().StartScenePreparing();
 #endif
 
+#ifdef SCENARIO_ENABLE
+  m_scenarioManager->OnTilesRequested(tiles.size());
+#endif
+
   return tiles;
 }
 
@@ -1713,6 +1904,7 @@ void FrontendRenderer::OnContextDestroy()
   // Clear all graphics.
   for (RenderLayer & layer : m_layers)
   {
+    layer.m_mergedGroups.clear();
     layer.m_renderGroups.clear();
     layer.m_isDirty = false;
   }
@@ -1734,6 +1926,8 @@ void FrontendRenderer::OnContextDestroy()
   m_postprocessRenderer->ClearGLDependentResources();
 
   dp::DebugRectRenderer::Instance().Destroy();
+  FrameProfiler::Instance().ReleaseGpuResources();
+  dp::GPUBufferPool::Instance().ReleaseGpuResources();
 
   m_gpuProgramManager.reset();
   m_contextFactory->getDrawContext()->doneCurrent();
@@ -1778,6 +1972,9 @@ void FrontendRenderer::OnContextCreate()
   dp::DebugRectRenderer::Instance().SetEnabled(true);
 #endif
 
+  FrameProfiler::Instance().SetGpuTimerSupported(
+      dp::GLExtensionsList::Instance().IsSupported(dp::GLExtensionsList::TimerQuery));
+
   // Resources recovering.
   m_screenQuadRenderer.reset(new ScreenQuadRenderer());
 
@@ -1793,6 +1990,10 @@ void FrontendRenderer::OnContextCreate()
   {
     m_postprocessRenderer->OnFramebufferFallback();
   });
+
+  // A new context may have other performance.
+  m_frameBudgetController.Reset();
+  ApplyFrameBudget();
 }
 
 FrontendRenderer::Routine::Routine(FrontendRenderer & renderer) : m_renderer(renderer) {}
@@ -1811,6 +2012,7 @@ void FrontendRenderer::Routine::Do()
   double const kShowOverlaysEventsPeriod = 5.0;
 
   my::Timer timer;
+  my::Timer renderTimer;
   my::Timer activityTimer;
   my::Timer showOverlaysEventsTimer;
 
@@ -1836,10 +2038,14 @@ void FrontendRenderer::Routine::Do()
     isActiveFrame |= m_renderer.m_texMng->UpdateDynamicTextures();
     m_renderer.m_routeRenderer->UpdatePreview(modelView);
 
+    // Time of messages processing isn't included to the time of a frame,
+    // since it doesn't depend on the quality of rendering.
+    renderTimer.Reset();
     m_renderer.RenderScene(modelView);
 
     if (modelViewChanged || m_renderer.m_forceUpdateScene || m_renderer.m_forceUpdateUserMarks)
       m_renderer.UpdateScene(modelView);
+    double renderTime = renderTimer.ElapsedSeconds();
 
     isActiveFrame |= InterpolationHolder::Instance().Advance(frameTime);
     AnimationSystem::Instance().Advance(frameTime);
@@ -1848,6 +2054,7 @@ void FrontendRenderer::Routine::Do()
 
     if (isActiveFrame)
       activityTimer.Reset();
+    bool const isActiveRendering = isActiveFrame;
 
     bool isValidFrameTime = true;
     if (activityTimer.ElapsedSeconds() > kMaxInactiveSeconds)
@@ -1874,10 +2081,21 @@ void FrontendRenderer::Routine::Do()
       while (availableTime > 0.0);
     }
 
+    renderTimer.Reset();
     context->present();
+    renderTime += renderTimer.ElapsedSeconds();
     frameTime = timer.ElapsedSeconds();
     timer.Reset();
 
+    if (isValidFrameTime && isActiveRendering)
+      m_renderer.UpdateFrameBudget(renderTime);
+
+#ifdef SCENARIO_ENABLE
+    m_renderer.m_scenarioManager->OnFrame(frameTime, isValidFrameTime && isActiveRendering,
+                                          AnimationSystem::Instance().HasAnimations() ||
+                                          m_renderer.m_userEventStream.IsWaitingForActionCompletion());
+#endif
+
     // Limit fps in following mode.
     double constexpr kFrameTime = 1.0 / 30.0;
     if (isValidFrameTime &&
@@ -1901,10 +2119,34 @@ void FrontendRenderer::Routine::Do()
   m_renderer.ReleaseResources();
 }
 
+void FrontendRenderer::UpdateFrameBudget(double frameTime)
+{
+  // Fps is limited in following mode (see Routine::Do()).
+  double constexpr kFrameTime = 1.0 / 60.0;
+  double constexpr kFollowingModeFrameTime = 1.0 / 30.0;
+  m_frameBudgetController.SetTargetFrameTime(m_myPositionController->IsRouteFollowingActive() ?
+                                             kFollowingModeFrameTime : kFrameTime);
+  if (!m_frameBudgetController.AddFrame(frameTime))
+    return;
+
+  LOG(LINFO, ("Frame budget level:", m_frameBudgetController.GetLevel()));
+  ApplyFrameBudget();
+}
+
+void FrontendRenderer::ApplyFrameBudget()
+{
+  m_postprocessRenderer->SetEffectSuppressed(PostprocessRenderer::Antialiasing,
+                                             !m_frameBudgetController.IsAntialiasingAllowed());
+  m_overlayTree->SetFrameUpdatePeriodFactor(m_frameBudgetController.GetOverlaysUpdateFactor());
+}
+
 void FrontendRenderer::ReleaseResources()
 {
   for (RenderLayer & layer : m_layers)
+  {
+    layer.m_mergedGroups.clear();
     layer.m_renderGroups.clear();
+  }
 
   m_guiRenderer.reset();
   m_myPositionController.reset();
@@ -1914,6 +2156,8 @@ void FrontendRenderer::ReleaseResources()
   m_screenQuadRenderer.reset();
   m_trafficRenderer.reset();
   m_postprocessRenderer.reset();
+  FrameProfiler::Instance().ReleaseGpuResources();
+  dp::GPUBufferPool::Instance().ReleaseGpuResources();
 
   m_gpuProgramManager.reset();
   m_contextFactory->getDrawContext()->doneCurrent();
@@ -7,6 +7,7 @@
 #include "drape_frontend/backend_renderer.hpp"
 #include "drape_frontend/base_renderer.hpp"
 #include "drape_frontend/drape_api_renderer.hpp"
+#include "drape_frontend/frame_budget_controller.hpp"
 #include "drape_frontend/gps_track_renderer.hpp"
 #include "drape_frontend/my_position_controller.hpp"
 #include "drape_frontend/navigator.hpp"
@@ -144,6 +145,7 @@ private:
   void PrepareBucket(dp::GLState const & state, drape_ptr<dp::RenderBucket> & bucket);
   void MergeBuckets();
   void RenderSingleGroup(ScreenBase const & modelView, ref_ptr<BaseRenderGroup> group);
+  void RenderGeometryGroup(ScreenBase const & modelView, ref_ptr<RenderGroup> group);
   void RefreshProjection(ScreenBase const & screen);
   void RefreshZScale(ScreenBase const & screen);
   void RefreshPivotTransform(ScreenBase const & screen);
@@ -152,6 +154,9 @@ private:
   struct RenderLayer
   {
     std::vector<drape_ptr<RenderGroup>> m_renderGroups;
+    // Groups of adjacent tiles merged by MergeBuckets(). They must be destroyed
+    // before the source groups, so they are declared after them.
+    std::vector<drape_ptr<MergedRenderGroup>> m_mergedGroups;
     bool m_isDirty = false;
 
     void Sort(ref_ptr<dp::OverlayTree> overlayTree);
@@ -225,6 +230,8 @@ private:
   bool CheckRouteRecaching(ref_ptr<BaseRouteData> routeData);
 
   void InvalidateRect(m2::RectD const & gRect);
+  void InvalidatePoints(std::vector<m2::PointD> const & points);
+  void InvalidateTiles(TTilesCollection const & tiles);
   bool CheckTileGenerations(TileKey const & tileKey);
   void UpdateCanBeDeletedStatus();
 
@@ -243,6 +250,10 @@ private:
 
   void CheckAndRunFirstLaunchAnimation();
 
+  // Scales features of rendering down and up by times of active frames.
+  void UpdateFrameBudget(double frameTime);
+  void ApplyFrameBudget();
+
   drape_ptr<dp::GpuProgramManager> m_gpuProgramManager;
 
   std::array<RenderLayer, RenderState::LayersCount> m_layers;
@@ -317,6 +328,7 @@ private:
   bool m_forceUpdateUserMarks;
 
   drape_ptr<PostprocessRenderer> m_postprocessRenderer;
+  FrameBudgetController m_frameBudgetController;
 
   drape_ptr<ScenarioManager> m_scenarioManager;
 
@@ -100,7 +100,7 @@ void GpsTrackRenderer::ClearRenderData()
 void GpsTrackRenderer::UpdatePoints(std::vector<GpsTrackPoint> const & toAdd,
                                     std::vector<uint32_t> const & toRemove)
 {
-  bool wasChanged = false;
+  bool wasRemoved = false;
   if (!toRemove.empty())
   {
     auto removePredicate = [&toRemove](GpsTrackPoint const & pt)
@@ -109,7 +109,7 @@ void GpsTrackRenderer::UpdatePoints(std::vector<GpsTrackPoint> const & toAdd,
     };
     m_points.erase(std::remove_if(m_points.begin(), m_points.end(), removePredicate),
                    m_points.end());
-    wasChanged = true;
+    wasRemoved = true;
   }
 
   if (!toAdd.empty())
@@ -118,15 +118,21 @@ void GpsTrackRenderer::UpdatePoints(std::vector<GpsTrackPoint> const & toAdd,
     if (!m_points.empty())
       ASSERT(GpsPointsSortPredicate(m_points.back(), toAdd.front()), ());
     m_points.insert(m_points.end(), toAdd.begin(), toAdd.end());
-    wasChanged = true;
   }
 
-  if (wasChanged)
+  if (wasRemoved)
   {
     m_pointsSpline = m2::Spline(m_points.size());
     for (size_t i = 0; i < m_points.size(); i++)
       m_pointsSpline.AddPoint(m_points[i].m_point);
   }
+  else
+  {
+    // Points are added to the end of the track only, so the spline is
+    // extended instead of rebuilding.
+    for (auto const & pt : toAdd)
+      m_pointsSpline.AddPoint(pt.m_point);
+  }
 
   m_needUpdate = true;
 }
@@ -244,6 +250,11 @@ void GpsTrackRenderer::RenderTrack(ScreenBase const & screen, int zoomLevel,
     }
     else
     {
+      double const step = diameterMercator + kDistanceScalar * diameterMercator;
+      double const fullLength = m_pointsSpline.GetLength();
+      // The length from the start is accumulated by steps, since
+      // m2::Spline::iterator::GetLength() is linear in the number of points.
+      double lengthFromStart = 0.0;
       m2::Spline::iterator it;
       it.Attach(m_pointsSpline);
       while (!it.BeginAgain())
@@ -254,7 +265,7 @@ void GpsTrackRenderer::RenderTrack(ScreenBase const & screen, int zoomLevel,
         if (screen.ClipRect().IsIntersect(pointRect))
         {
           dp::Color const color = CalculatePointColor(it.GetIndex(), pt,
-                                                      it.GetLength(), it.GetFullLength());
+                                                      lengthFromStart, fullLength);
           m2::PointD const convertedPt = MapShape::ConvertToLocal(pt, m_pivot, kShapeCoordScalar);
           m_handlesCache[cacheIndex].first->SetPoint(m_handlesCache[cacheIndex].second,
                                                      convertedPt, m_radius, color);
@@ -269,7 +280,8 @@ void GpsTrackRenderer::RenderTrack(ScreenBase const & screen, int zoomLevel,
             return;
           }
         }
-        it.Advance(diameterMercator + kDistanceScalar * diameterMercator);
+        it.Advance(step);
+        lengthFromStart += step;
       }
 
 #ifdef SHOW_RAW_POINTS
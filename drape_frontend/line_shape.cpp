@@ -342,6 +342,32 @@ private:
 
 } // namespace
 
+LineCentreline::LineCentreline(m2::SharedSpline const & spline, m2::PointD const & tileCenter)
+  : m_spline(spline)
+  , m_tileCenter(tileCenter)
+{
+  vector<m2::PointD> const & path = m_spline->GetPath();
+  ASSERT_GREATER(path.size(), 1, ());
+
+  m_points.reserve(path.size());
+  for (auto const & pt : path)
+    m_points.push_back(glsl::ToVec2(MapShape::ConvertToLocal(pt, m_tileCenter, kShapeCoordScalar)));
+
+  m_segments.reserve(path.size() - 1);
+  for (size_t i = 1; i < path.size(); ++i)
+  {
+    if (path[i].EqualDxDy(path[i - 1], 1.0E-5))
+      continue;
+
+    Segment segment;
+    segment.m_index = static_cast<uint32_t>(i);
+    CalculateTangentAndNormals(m_points[i - 1], m_points[i], segment.m_tangent,
+                               segment.m_leftNormal, segment.m_rightNormal);
+    segment.m_globalLength = static_cast<float>((path[i] - path[i - 1]).Length());
+    m_segments.push_back(segment);
+  }
+}
+
 LineShape::LineShape(m2::SharedSpline const & spline, LineViewParams const & params)
   : m_params(params)
   , m_spline(spline)
@@ -350,6 +376,16 @@ LineShape::LineShape(m2::SharedSpline const & spline, LineViewParams const & par
   ASSERT_GREATER(m_spline->GetPath().size(), 1, ());
 }
 
+LineShape::LineShape(shared_ptr<LineCentreline const> const & centreline,
+                     LineViewParams const & params)
+  : m_params(params)
+  , m_spline(centreline->GetSpline())
+  , m_centreline(centreline)
+  , m_isSimple(false)
+{
+  ASSERT(m_centreline->GetTileCenter() == m_params.m_tileCenter, ());
+}
+
 template <typename TBuilder>
 void LineShape::Construct(TBuilder & builder) const
 {
@@ -360,22 +396,16 @@ void LineShape::Construct(TBuilder & builder) const
 template <>
 void LineShape::Construct<DashedLineBuilder>(DashedLineBuilder & builder) const
 {
-  vector<m2::PointD> const & path = m_spline->GetPath();
-  ASSERT_GREATER(path.size(), 1, ());
+  vector<glsl::vec2> const & points = m_centreline->GetPoints();
 
   // build geometry
-  for (size_t i = 1; i < path.size(); ++i)
+  for (auto const & segment : m_centreline->GetSegments())
   {
-    if (path[i].EqualDxDy(path[i - 1], 1.0E-5))
-      continue;
-
-    glsl::vec2 const p1 = glsl::ToVec2(ConvertToLocal(path[i - 1], m_params.m_tileCenter, kShapeCoordScalar));
-    glsl::vec2 const p2 = glsl::ToVec2(ConvertToLocal(path[i], m_params.m_tileCenter, kShapeCoordScalar));
-    glsl::vec2 tangent, leftNormal, rightNormal;
-    CalculateTangentAndNormals(p1, p2, tangent, leftNormal, rightNormal);
+    glsl::vec2 const & p1 = points[segment.m_index - 1];
+    glsl::vec2 const & p2 = points[segment.m_index];
 
     // calculate number of steps to cover line segment
-    float const initialGlobalLength = static_cast<float>((path[i] - path[i - 1]).Length());
+    float const initialGlobalLength = segment.m_globalLength;
     int const steps = max(1, builder.GetDashesCount(initialGlobalLength));
     float const maskSize = glsl::length(p2 - p1) / steps;
     float const offsetSize = initialGlobalLength / steps;
@@ -386,12 +416,12 @@ void LineShape::Construct<DashedLineBuilder>(DashedLineBuilder & builder) const
     for (int step = 0; step < steps; step++)
     {
       currentSize += maskSize;
-      glsl::vec3 const newPivot = glsl::vec3(p1 + tangent * currentSize, m_params.m_depth);
+      glsl::vec3 const newPivot = glsl::vec3(p1 + segment.m_tangent * currentSize, m_params.m_depth);
 
-      builder.SubmitVertex(currentStartPivot, rightNormal, false /* isLeft */, 0.0);
-      builder.SubmitVertex(currentStartPivot, leftNormal, true /* isLeft */, 0.0);
-      builder.SubmitVertex(newPivot, rightNormal, false /* isLeft */, offsetSize);
-      builder.SubmitVertex(newPivot, leftNormal, true /* isLeft */, offsetSize);
+      builder.SubmitVertex(currentStartPivot, segment.m_rightNormal, false /* isLeft */, 0.0);
+      builder.SubmitVertex(currentStartPivot, segment.m_leftNormal, true /* isLeft */, 0.0);
+      builder.SubmitVertex(newPivot, segment.m_rightNormal, false /* isLeft */, offsetSize);
+      builder.SubmitVertex(newPivot, segment.m_leftNormal, true /* isLeft */, offsetSize);
 
       currentStartPivot = newPivot;
     }
@@ -402,8 +432,8 @@ void LineShape::Construct<DashedLineBuilder>(DashedLineBuilder & builder) const
 template <>
 void LineShape::Construct<SolidLineBuilder>(SolidLineBuilder & builder) const
 {
-  vector<m2::PointD> const & path = m_spline->GetPath();
-  ASSERT_GREATER(path.size(), 1, ());
+  vector<glsl::vec2> const & points = m_centreline->GetPoints();
+  vector<LineCentreline::Segment> const & segments = m_centreline->GetSegments();
 
   // skip joins generation
   float const kJoinsGenerationThreshold = 2.5f;
@@ -412,39 +442,28 @@ void LineShape::Construct<SolidLineBuilder>(SolidLineBuilder & builder) const
     generateJoins = false;
 
   // build geometry
-  glsl::vec2 firstPoint = glsl::ToVec2(ConvertToLocal(path.front(), m_params.m_tileCenter, kShapeCoordScalar));
-  glsl::vec2 lastPoint;
-  bool hasConstructedSegments = false;
-  for (size_t i = 1; i < path.size(); ++i)
+  for (auto const & segment : segments)
   {
-    if (path[i].EqualDxDy(path[i - 1], 1.0E-5))
-      continue;
-
-    glsl::vec2 const p1 = glsl::ToVec2(ConvertToLocal(path[i - 1], m_params.m_tileCenter, kShapeCoordScalar));
-    glsl::vec2 const p2 = glsl::ToVec2(ConvertToLocal(path[i], m_params.m_tileCenter, kShapeCoordScalar));
-    glsl::vec2 tangent, leftNormal, rightNormal;
-    CalculateTangentAndNormals(p1, p2, tangent, leftNormal, rightNormal);
+    glsl::vec2 const & p1 = points[segment.m_index - 1];
+    glsl::vec2 const & p2 = points[segment.m_index];
 
     glsl::vec3 const startPoint = glsl::vec3(p1, m_params.m_depth);
     glsl::vec3 const endPoint = glsl::vec3(p2, m_params.m_depth);
 
-    builder.SubmitVertex(startPoint, rightNormal, false /* isLeft */);
-    builder.SubmitVertex(startPoint, leftNormal, true /* isLeft */);
-    builder.SubmitVertex(endPoint, rightNormal, false /* isLeft */);
-    builder.SubmitVertex(endPoint, leftNormal, true /* isLeft */);
+    builder.SubmitVertex(startPoint, segment.m_rightNormal, false /* isLeft */);
+    builder.SubmitVertex(startPoint, segment.m_leftNormal, true /* isLeft */);
+    builder.SubmitVertex(endPoint, segment.m_rightNormal, false /* isLeft */);
+    builder.SubmitVertex(endPoint, segment.m_leftNormal, true /* isLeft */);
 
     // generate joins
-    if (generateJoins && i < path.size() - 1)
+    if (generateJoins && segment.m_index < points.size() - 1)
       builder.SubmitJoin(p2);
-
-    lastPoint = p2;
-    hasConstructedSegments = true;
   }
 
-  if (hasConstructedSegments)
+  if (!segments.empty())
   {
-    builder.SubmitCap(firstPoint);
-    builder.SubmitCap(lastPoint);
+    builder.SubmitCap(points.front());
+    builder.SubmitCap(points[segments.back().m_index]);
   }
 }
 
@@ -452,15 +471,9 @@ void LineShape::Construct<SolidLineBuilder>(SolidLineBuilder & builder) const
 template <>
 void LineShape::Construct<SimpleSolidLineBuilder>(SimpleSolidLineBuilder & builder) const
 {
-  vector<m2::PointD> const & path = m_spline->GetPath();
-  ASSERT_GREATER(path.size(), 1, ());
-
   // Build geometry.
-  for (size_t i = 0; i < path.size(); ++i)
-  {
-    glsl::vec2 const p = glsl::ToVec2(ConvertToLocal(path[i], m_params.m_tileCenter, kShapeCoordScalar));
+  for (auto const & p : m_centreline->GetPoints())
     builder.SubmitVertex(glsl::vec3(p, m_params.m_depth));
-  }
 }
 
 bool LineShape::CanBeSimplified(int & lineWidth) const
@@ -482,6 +495,9 @@ bool LineShape::CanBeSimplified(int & lineWidth) const
 
 void LineShape::Prepare(ref_ptr<dp::TextureManager> textures) const
 {
+  if (m_centreline == nullptr)
+    m_centreline = make_shared<LineCentreline>(m_spline, m_params.m_tileCenter);
+
   float const pxHalfWidth = m_params.m_width / 2.0f;
 
   dp::TextureManager::ColorRegion colorRegion;
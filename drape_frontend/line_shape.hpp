@@ -5,10 +5,13 @@
 #include "drape_frontend/shape_view_params.hpp"
 
 #include "drape/binding_info.hpp"
+#include "drape/glsl_types.hpp"
 
 #include "geometry/spline.hpp"
 
+#include "std/shared_ptr.hpp"
 #include "std/unique_ptr.hpp"
+#include "std/vector.hpp"
 
 namespace df
 {
@@ -33,10 +36,45 @@ public:
   virtual uint32_t GetCapSize() = 0;
 };
 
+// Width independent part of the geometry of a line in a tile: points of
+// the spline in local coordinates of the tile and tangents and normals of
+// its segments. Line shapes of different rules of a feature (e.g. casing
+// and fill of a road) share it, so it's computed once per feature.
+class LineCentreline
+{
+public:
+  struct Segment
+  {
+    // Index of the end point of the segment, the start point precedes it.
+    uint32_t m_index;
+    glsl::vec2 m_tangent;
+    glsl::vec2 m_leftNormal;
+    glsl::vec2 m_rightNormal;
+    float m_globalLength;
+  };
+
+  LineCentreline(m2::SharedSpline const & spline, m2::PointD const & tileCenter);
+
+  m2::SharedSpline const & GetSpline() const { return m_spline; }
+  m2::PointD const & GetTileCenter() const { return m_tileCenter; }
+
+  vector<glsl::vec2> const & GetPoints() const { return m_points; }
+  // Segments of zero length are skipped.
+  vector<Segment> const & GetSegments() const { return m_segments; }
+
+private:
+  m2::SharedSpline const m_spline;
+  m2::PointD const m_tileCenter;
+  vector<glsl::vec2> m_points;
+  vector<Segment> m_segments;
+};
+
 class LineShape : public MapShape
 {
 public:
   LineShape(m2::SharedSpline const & spline, LineViewParams const & params);
+  // |centreline| must be built for the tile center of |params|.
+  LineShape(shared_ptr<LineCentreline const> const & centreline, LineViewParams const & params);
 
   void Prepare(ref_ptr<dp::TextureManager> textures) const override;
   void Draw(ref_ptr<dp::Batcher> batcher, ref_ptr<dp::TextureManager> textures) const override;
@@ -49,6 +87,7 @@ private:
 
   LineViewParams m_params;
   m2::SharedSpline m_spline;
+  mutable shared_ptr<LineCentreline const> m_centreline;
   mutable unique_ptr<ILineShapeInfo> m_lineShapeInfo;
   mutable bool m_isSimple;
 };
@@ -3,6 +3,7 @@
 #include "drape_frontend/message.hpp"
 #include "drape_frontend/tile_key.hpp"
 
+#include "drape/object_pool.hpp"
 #include "drape/pointers.hpp"
 
 #include "geometry/point2d.hpp"
@@ -22,11 +23,14 @@ enum MapShapeType
 {
   GeometryType = 0,
   OverlayType,
+  // Shapes of 3d buildings, which are generated after flat geometry of the tile.
+  Geometry3dType,
 
   MapShapeTypeCount
 };
 
-class MapShape
+// Shapes are created for every feature of every tile, so they are pooled.
+class MapShape : public dp::PooledObject
 {
 public:
   virtual ~MapShape(){}
@@ -51,20 +55,25 @@ using TMapShapes = vector<drape_ptr<MapShape>>;
 class MapShapeMessage : public Message
 {
 public:
-  MapShapeMessage(TileKey const & key)
-    : m_tileKey(key)
+  MapShapeMessage(TileKey const & key, bool isPrefetch = false)
+    : m_tileKey(key), m_isPrefetch(isPrefetch)
   {}
 
   TileKey const & GetKey() const { return m_tileKey; }
+  // The tile is read ahead of the viewport, its geometry is cached only.
+  bool IsPrefetch() const { return m_isPrefetch; }
 
 private:
   TileKey m_tileKey;
+  bool m_isPrefetch;
 };
 
 class TileReadStartMessage : public MapShapeMessage
 {
 public:
-  TileReadStartMessage(TileKey const & key) : MapShapeMessage(key) {}
+  TileReadStartMessage(TileKey const & key, bool isPrefetch)
+    : MapShapeMessage(key, isPrefetch)
+  {}
   Type GetType() const override { return Message::TileReadStarted; }
   bool IsGLContextDependent() const override { return true; }
 };
@@ -72,16 +81,28 @@ public:
 class TileReadEndMessage : public MapShapeMessage
 {
 public:
-  TileReadEndMessage(TileKey const & key) : MapShapeMessage(key) {}
+  TileReadEndMessage(TileKey const & key, bool isPrefetch)
+    : MapShapeMessage(key, isPrefetch)
+  {}
   Type GetType() const override { return Message::TileReadEnded; }
   bool IsGLContextDependent() const override { return true; }
 };
 
+class TileReadFlushMessage : public MapShapeMessage
+{
+public:
+  explicit TileReadFlushMessage(TileKey const & key)
+    : MapShapeMessage(key)
+  {}
+  Type GetType() const override { return Message::TileReadFlushed; }
+  bool IsGLContextDependent() const override { return true; }
+};
+
 class MapShapeReadedMessage : public MapShapeMessage
 {
 public:
-  MapShapeReadedMessage(TileKey const & key, TMapShapes && shapes)
-    : MapShapeMessage(key), m_shapes(move(shapes))
+  MapShapeReadedMessage(TileKey const & key, TMapShapes && shapes, bool isPrefetch = false)
+    : MapShapeMessage(key, isPrefetch), m_shapes(move(shapes))
   {}
 
   Type GetType() const override { return Message::MapShapeReaded; }
@@ -11,6 +11,7 @@ public:
     Unknown,
     TileReadStarted,
     TileReadEnded,
+    TileReadFlushed,
     FinishReading,
     FinishTileRead,
     FlushTile,
@@ -69,6 +70,7 @@ public:
     FlushTrafficGeometry,
     RegenerateTraffic,
     UpdateTraffic,
+    UpdateTrafficColors,
     FlushTrafficData,
     ClearTrafficData,
     SetSimplifiedTrafficColors,
@@ -83,6 +85,7 @@ public:
     RunFirstLaunchAnimation,
     UpdateMetalines,
     PostUserEvent,
+    ShrinkCaches,
   };
 
   virtual ~Message() {}
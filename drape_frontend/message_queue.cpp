@@ -9,27 +9,39 @@ namespace df
 {
 
 MessageQueue::MessageQueue()
-  : m_isWaiting(false)
+  : m_pushed(nullptr)
+  , m_clearRequested(false)
+  , m_isWaiting(false)
 {
 }
 
 MessageQueue::~MessageQueue()
 {
-  CancelWaitImpl();
-  ClearQuery();
+  CancelWait();
+  DeleteNodes(m_pushed.exchange(nullptr));
+  m_messages.clear();
+  m_lowPriorityMessages.clear();
 }
 
 drape_ptr<Message> MessageQueue::PopMessage(bool waitForMessage)
 {
-  unique_lock<mutex> lock(m_mutex);
-  if (waitForMessage && m_messages.empty() && m_lowPriorityMessages.empty())
+  TakePushedMessages();
+
+  if (waitForMessage && IsEmptyImpl())
   {
+    unique_lock<mutex> lock(m_mutex);
+    // The flag is set before the last check of pushed messages, and
+    // producers check the flag after pushing, so either a message is
+    // seen here or the producer wakes us up.
     m_isWaiting = true;
-    m_condition.wait(lock, [this]() { return !m_isWaiting; });
+    m_condition.wait(lock, [this]() { return !m_isWaiting || m_pushed.load() != nullptr; });
     m_isWaiting = false;
+    lock.unlock();
+
+    TakePushedMessages();
   }
 
-  if (m_messages.empty() && m_lowPriorityMessages.empty())
+  if (IsEmptyImpl())
     return nullptr;
 
   if (!m_messages.empty())
@@ -46,8 +58,51 @@ drape_ptr<Message> MessageQueue::PopMessage(bool waitForMessage)
 
 void MessageQueue::PushMessage(drape_ptr<Message> && message, MessagePriority priority)
 {
-  lock_guard<mutex> lock(m_mutex);
+  Node * node = new Node(move(message), priority);
+  node->m_next = m_pushed.load(std::memory_order_relaxed);
+  while (!m_pushed.compare_exchange_weak(node->m_next, node, std::memory_order_seq_cst,
+                                         std::memory_order_relaxed))
+  {
+  }
+
+  if (m_isWaiting)
+  {
+    lock_guard<mutex> lock(m_mutex);
+    CancelWaitImpl();
+  }
+}
+
+void MessageQueue::TakePushedMessages()
+{
+  if (m_clearRequested.exchange(false))
+  {
+    m_messages.clear();
+    m_lowPriorityMessages.clear();
+  }
 
+  Node * head = m_pushed.exchange(nullptr, std::memory_order_acquire);
+
+  // Restores the order of pushing.
+  Node * reversed = nullptr;
+  while (head != nullptr)
+  {
+    Node * next = head->m_next;
+    head->m_next = reversed;
+    reversed = head;
+    head = next;
+  }
+
+  while (reversed != nullptr)
+  {
+    Node * next = reversed->m_next;
+    InsertMessage(move(reversed->m_message), reversed->m_priority);
+    delete reversed;
+    reversed = next;
+  }
+}
+
+void MessageQueue::InsertMessage(drape_ptr<Message> && message, MessagePriority priority)
+{
   switch (priority)
   {
   case MessagePriority::Normal:
@@ -88,15 +143,13 @@ void MessageQueue::PushMessage(drape_ptr<Message> && message, MessagePriority pr
   default:
     ASSERT(false, ("Unknown message priority type"));
   }
-
-  CancelWaitImpl();
 }
 
 void MessageQueue::FilterMessages(TFilterMessageFn needFilterMessageFn)
 {
   ASSERT(needFilterMessageFn != nullptr, ());
 
-  lock_guard<mutex> lock(m_mutex);
+  TakePushedMessages();
   for (auto it = m_messages.begin(); it != m_messages.end(); )
   {
     if (needFilterMessageFn(make_ref(it->first)))
@@ -114,18 +167,26 @@ void MessageQueue::FilterMessages(TFilterMessageFn needFilterMessageFn)
   }
 }
 
+bool MessageQueue::IsEmptyImpl() const
+{
+  return m_messages.empty() && m_lowPriorityMessages.empty();
+}
+
 #ifdef DEBUG_MESSAGE_QUEUE
 
 bool MessageQueue::IsEmpty() const
 {
-  lock_guard<mutex> lock(m_mutex);
-  return m_messages.empty() && m_lowPriorityMessages.empty();
+  return IsEmptyImpl() && m_pushed.load() == nullptr;
 }
 
 size_t MessageQueue::GetSize() const
 {
-  lock_guard<mutex> lock(m_mutex);
-  return m_messages.size() + m_lowPriorityMessages.size();
+  // Pushed nodes are deleted by the consumer and ClearQuery() only,
+  // so it's safe to walk them on the consumer thread.
+  size_t size = m_messages.size() + m_lowPriorityMessages.size();
+  for (Node const * node = m_pushed.load(); node != nullptr; node = node->m_next)
+    ++size;
+  return size;
 }
 
 #endif
@@ -147,8 +208,19 @@ void MessageQueue::CancelWaitImpl()
 
 void MessageQueue::ClearQuery()
 {
-  m_messages.clear();
-  m_lowPriorityMessages.clear();
+  DeleteNodes(m_pushed.exchange(nullptr, std::memory_order_acquire));
+  m_clearRequested = true;
+}
+
+// static
+void MessageQueue::DeleteNodes(Node * head)
+{
+  while (head != nullptr)
+  {
+    Node * next = head->m_next;
+    delete head;
+    head = next;
+  }
 }
 
 } // namespace df
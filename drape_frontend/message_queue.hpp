@@ -6,6 +6,7 @@
 
 #include "base/condition.hpp"
 
+#include "std/atomic.hpp"
 #include "std/condition_variable.hpp"
 #include "std/deque.hpp"
 #include "std/functional.hpp"
@@ -16,6 +17,14 @@ namespace df
 
 //#define DEBUG_MESSAGE_QUEUE
 
+// A queue with many producers and the only consumer, the thread of
+// the message acceptor.
+//
+// Producers push messages to a lock-free list and never wait for the
+// consumer or each other, except waking up the consumer when it waits
+// for a message. The consumer takes all pushed messages at once and
+// sorts them by priority into its own queues, so priorities and
+// FilterMessages() work without locks too.
 class MessageQueue
 {
 public:
@@ -23,25 +32,53 @@ public:
   ~MessageQueue();
 
   /// if queue is empty then return NULL
+  /// Must be called on the consumer thread.
   drape_ptr<Message> PopMessage(bool waitForMessage);
   void PushMessage(drape_ptr<Message> && message, MessagePriority priority);
   void CancelWait();
   void ClearQuery();
 
   using TFilterMessageFn = function<bool(ref_ptr<Message>)>;
+  /// Must be called on the consumer thread.
   void FilterMessages(TFilterMessageFn needFilterMessageFn);
 
 #ifdef DEBUG_MESSAGE_QUEUE
+  /// Must be called on the consumer thread.
   bool IsEmpty() const;
   size_t GetSize() const;
 #endif
 
 private:
+  struct Node
+  {
+    Node(drape_ptr<Message> && message, MessagePriority priority)
+      : m_message(move(message)), m_priority(priority)
+    {
+    }
+
+    drape_ptr<Message> m_message;
+    MessagePriority m_priority;
+    Node * m_next = nullptr;
+  };
+
+  // Moves pushed messages to the consumer queues.
+  void TakePushedMessages();
+  void InsertMessage(drape_ptr<Message> && message, MessagePriority priority);
+  bool IsEmptyImpl() const;
   void CancelWaitImpl();
+  static void DeleteNodes(Node * head);
+
+  // The last pushed message, nodes are linked in reverse order.
+  atomic<Node *> m_pushed;
+  // ClearQuery() may be called on any thread, so the consumer clears
+  // its queues on the next PopMessage() call.
+  atomic<bool> m_clearRequested;
 
   mutable mutex m_mutex;
   condition_variable m_condition;
-  bool m_isWaiting;
+  atomic<bool> m_isWaiting;
+
+  // Consumer queues.
   using TMessageNode = pair<drape_ptr<Message>, MessagePriority>;
   deque<TMessageNode> m_messages;
   deque<drape_ptr<Message>> m_lowPriorityMessages;
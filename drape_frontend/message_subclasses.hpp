@@ -1020,6 +1020,25 @@ private:
   TrafficSegmentsColoring m_segmentsColoring;
 };
 
+class UpdateTrafficColorsMessage : public Message
+{
+public:
+  UpdateTrafficColorsMessage(TrafficSegmentsColoring const & segmentsColoring,
+                             TrafficTexCoords const & texCoords)
+    : m_segmentsColoring(segmentsColoring)
+    , m_texCoords(texCoords)
+  {}
+
+  Type GetType() const override { return Message::UpdateTrafficColors; }
+
+  TrafficSegmentsColoring const & GetSegmentsColoring() const { return m_segmentsColoring; }
+  TrafficTexCoords const & GetTexCoords() const { return m_texCoords; }
+
+private:
+  TrafficSegmentsColoring const m_segmentsColoring;
+  TrafficTexCoords const m_texCoords;
+};
+
 class FlushTrafficDataMessage : public Message
 {
 public:
@@ -1123,12 +1142,27 @@ public:
     : m_features(std::move(ids))
   {}
 
+  // Replaces custom features of the mwm only, tiles with |changedPositions| are reread.
+  SetCustomFeaturesMessage(MwmSet::MwmId const & mwmId, std::set<FeatureID> && ids,
+                           std::vector<m2::PointD> && changedPositions)
+    : m_features(std::move(ids))
+    , m_mwmId(mwmId)
+    , m_changedPositions(std::move(changedPositions))
+    , m_mwmOnly(true)
+  {}
+
   Type GetType() const override { return Message::SetCustomFeatures; }
 
   std::set<FeatureID> && AcceptFeatures() { return std::move(m_features); }
+  bool IsMwmOnly() const { return m_mwmOnly; }
+  MwmSet::MwmId const & GetMwmId() const { return m_mwmId; }
+  std::vector<m2::PointD> && AcceptChangedPositions() { return std::move(m_changedPositions); }
 
 private:
   std::set<FeatureID> m_features;
+  MwmSet::MwmId m_mwmId;
+  std::vector<m2::PointD> m_changedPositions;
+  bool m_mwmOnly = false;
 };
 
 class RemoveCustomFeaturesMessage : public Message
@@ -1155,12 +1189,20 @@ public:
     : m_features(std::move(features))
   {}
 
+  UpdateCustomFeaturesMessage(std::vector<FeatureID> && features,
+                              std::vector<m2::PointD> && changedPositions)
+    : m_features(std::move(features))
+    , m_changedPositions(std::move(changedPositions))
+  {}
+
   Type GetType() const override { return Message::UpdateCustomFeatures; }
 
   std::vector<FeatureID> && AcceptFeatures() { return std::move(m_features); }
+  std::vector<m2::PointD> && AcceptChangedPositions() { return std::move(m_changedPositions); }
 
 private:
   std::vector<FeatureID> m_features;
+  std::vector<m2::PointD> m_changedPositions;
 };
 
 class SetPostprocessStaticTexturesMessage : public Message
@@ -1222,4 +1264,10 @@ public:
 private:
   drape_ptr<UserEvent> m_event;
 };
+
+class ShrinkCachesMessage : public Message
+{
+public:
+  Type GetType() const override { return Message::ShrinkCaches; }
+};
 }  // namespace df
@@ -30,7 +30,7 @@ void MetalineManager::Start()
 
   using namespace std::placeholders;
   uint8_t constexpr kThreadsCount = 2;
-  m_threadsPool = make_unique_dp<threads::ThreadPool>(
+  m_threadsPool = make_unique_dp<threads::WorkStealingThreadPool>(
       kThreadsCount, std::bind(&MetalineManager::OnTaskFinished, this, _1));
 }
 
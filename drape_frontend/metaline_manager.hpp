@@ -7,6 +7,8 @@
 
 #include "indexer/feature_decl.hpp"
 
+#include "base/work_stealing_thread_pool.hpp"
+
 #include <mutex>
 #include <set>
 
@@ -41,7 +43,7 @@ private:
   std::mutex m_mwmsMutex;
 
   TasksPool m_tasksPool;
-  drape_ptr<threads::ThreadPool> m_threadsPool;
+  drape_ptr<threads::WorkStealingThreadPool> m_threadsPool;
   ref_ptr<ThreadsCommutator> m_commutator;
 };
 }  // namespace df
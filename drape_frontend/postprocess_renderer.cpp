@@ -167,6 +167,7 @@ bool IsSupported(drape_ptr<dp::Framebuffer> const & framebuffer)
 PostprocessRenderer::PostprocessRenderer()
   : m_isEnabled(false)
   , m_effects(0)
+  , m_suppressedEffects(0)
   , m_width(0)
   , m_height(0)
   , m_edgesRendererContext(make_unique_dp<EdgesRendererContext>())
@@ -220,13 +221,13 @@ void PostprocessRenderer::SetEnabled(bool enabled)
 
 bool PostprocessRenderer::IsEnabled() const
 {
-  if (!m_isEnabled || m_effects == 0 || m_staticTextures == nullptr)
+  if (!m_isEnabled || (m_effects & ~m_suppressedEffects) == 0 || m_staticTextures == nullptr)
     return false;
 
   if (!IsSupported(m_mainFramebuffer))
     return false;
 
-  if (IsEffectEnabled(Effect::Antialiasing) &&
+  if (IsEffectActive(Effect::Antialiasing) &&
       (!IsSupported(m_edgesFramebuffer) || !IsSupported(m_blendingWeightFramebuffer)))
   {
     return false;
@@ -252,6 +253,17 @@ bool PostprocessRenderer::IsEffectEnabled(Effect effect) const
   return (m_effects & static_cast<uint32_t>(effect)) > 0;
 }
 
+void PostprocessRenderer::SetEffectSuppressed(Effect effect, bool suppressed)
+{
+  uint32_t const effectMask = static_cast<uint32_t>(effect);
+  m_suppressedEffects = (m_suppressedEffects & ~effectMask) | (suppressed ? effectMask : 0);
+}
+
+bool PostprocessRenderer::IsEffectActive(Effect effect) const
+{
+  return IsEffectEnabled(effect) && (m_suppressedEffects & static_cast<uint32_t>(effect)) == 0;
+}
+
 void PostprocessRenderer::BeginFrame()
 {
   if (!IsEnabled())
@@ -284,7 +296,7 @@ void PostprocessRenderer::EndFrame(ref_ptr<dp::GpuProgramManager> gpuProgramMana
   bool wasPostEffect = false;
 
   // Subpixel Morphological Antialiasing (SMAA).
-  if (IsEffectEnabled(Effect::Antialiasing))
+  if (IsEffectActive(Effect::Antialiasing))
   {
     wasPostEffect = true;
 
@@ -40,6 +40,10 @@ public:
   bool IsEnabled() const;
   void SetEffectEnabled(Effect effect, bool enabled);
   bool IsEffectEnabled(Effect effect) const;
+  // A suppressed effect isn't rendered, but its framebuffers are kept, so
+  // the effect is restored without reallocations. It's used to save time
+  // of frames on slow devices.
+  void SetEffectSuppressed(Effect effect, bool suppressed);
 
   void OnFramebufferFallback();
 
@@ -51,9 +55,11 @@ public:
 
 private:
   void UpdateFramebuffers(uint32_t width, uint32_t height);
+  bool IsEffectActive(Effect effect) const;
 
   bool m_isEnabled;
   uint32_t m_effects;
+  uint32_t m_suppressedEffects;
 
   drape_ptr<ScreenQuadRenderer> m_screenQuadRenderer;
   dp::FramebufferFallback m_framebufferFallback;
@@ -5,11 +5,17 @@
 
 #include "drape/constants.hpp"
 
+#include "geometry/mercator.hpp"
+
 #include "base/buffer_vector.hpp"
 #include "base/stl_add.hpp"
 
 #include <algorithm>
 #include <functional>
+#include <list>
+#include <tuple>
+#include <utility>
+#include <vector>
 
 namespace df
 {
@@ -35,6 +41,38 @@ struct LessCoverageCell
     return l->GetTileKey() < r->GetTileKey();
   }
 };
+
+// Maximum number of tiles which are read ahead of the viewport. Memory
+// of their geometry is limited by TileGeometryCache.
+size_t constexpr kMaxPrefetchTilesCount = 32;
+
+// Tiles are read in order of the distance from the viewport center
+// to tile centers. Prefetched tiles and tiles of other zoom levels go
+// last, the latter are going to be dropped. Cancelled tasks go first,
+// since they aren't executed and just return to the tasks pool.
+struct TaskPriority
+{
+  TaskPriority(TileKey const & tileKey, bool isCancelled, bool isPrefetch,
+               m2::PointD const & center, int zoomLevel)
+    : m_isActive(!isCancelled)
+    , m_isPrefetch(isPrefetch)
+    , m_isOtherZoom(tileKey.m_zoomLevel != zoomLevel)
+  {
+    m2::RectD const rect = tileKey.GetGlobalRect(false /* clipByDataMaxZoom */);
+    m_distance = rect.Center().SquareLength(center);
+  }
+
+  bool operator<(TaskPriority const & rhs) const
+  {
+    return std::tie(m_isActive, m_isPrefetch, m_isOtherZoom, m_distance) <
+           std::tie(rhs.m_isActive, rhs.m_isPrefetch, rhs.m_isOtherZoom, rhs.m_distance);
+  }
+
+  bool m_isActive;
+  bool m_isPrefetch;
+  bool m_isOtherZoom;
+  double m_distance;
+};
 }  // namespace
 
 bool ReadManager::LessByTileInfo::operator()(std::shared_ptr<TileInfo> const & l,
@@ -44,9 +82,13 @@ bool ReadManager::LessByTileInfo::operator()(std::shared_ptr<TileInfo> const & l
 }
 
 ReadManager::ReadManager(ref_ptr<ThreadsCommutator> commutator, MapDataProvider & model,
-                         bool allow3dBuildings, bool trafficEnabled)
+                         bool allow3dBuildings, bool trafficEnabled,
+                         TUploadCachedGeometryFn const & uploadCachedGeometryFn,
+                         TStartPrefetchingFn const & startPrefetchingFn)
   : m_commutator(commutator)
   , m_model(model)
+  , m_uploadCachedGeometryFn(uploadCachedGeometryFn)
+  , m_startPrefetchingFn(startPrefetchingFn)
   , m_have3dBuildings(false)
   , m_allow3dBuildings(allow3dBuildings)
   , m_trafficEnabled(trafficEnabled)
@@ -68,14 +110,21 @@ void ReadManager::Start()
   using namespace std::placeholders;
   m_pool = make_unique_dp<threads::ThreadPool>(kReadingThreadsCount,
                                                std::bind(&ReadManager::OnTaskFinished, this, _1));
+  m_deferredShapesPool = make_unique_dp<threads::ThreadPool>(kDeferredShapesThreadsCount,
+                                                             std::bind(&ReadManager::OnTaskFinished,
+                                                                       this, _1));
 }
 
 void ReadManager::Stop()
 {
   InvalidateAll();
+  // Tasks of the first stage are passed to the second one, so it's stopped after the first one.
   if (m_pool != nullptr)
     m_pool->Stop();
   m_pool.reset();
+  if (m_deferredShapesPool != nullptr)
+    m_deferredShapesPool->Stop();
+  m_deferredShapesPool.reset();
 }
 
 void ReadManager::Restart()
@@ -89,6 +138,21 @@ void ReadManager::OnTaskFinished(threads::IRoutine * task)
   ASSERT(dynamic_cast<ReadMWMTask *>(task) != NULL, ());
   auto t = static_cast<ReadMWMTask *>(task);
 
+  // The tile is finished by the second stage of reading.
+  if (!task->IsCancelled() && t->HasDeferredShapes())
+  {
+    m_deferredShapesPool->PushBack(t);
+    return;
+  }
+
+  // Prefetched tiles aren't counted.
+  if (t->IsPrefetch())
+  {
+    t->Reset();
+    m_tasksPool.Return(t);
+    return;
+  }
+
   // finish tiles
   {
     std::lock_guard<std::mutex> lock(m_finishedTilesMutex);
@@ -136,13 +200,14 @@ void ReadManager::UpdateCoverage(ScreenBase const & screen, bool have3dBuildings
     for (auto const & info : m_tileInfos)
       CancelTileInfo(info);
     m_tileInfos.clear();
+    CancelPrefetch();
 
     IncreaseCounter(static_cast<int>(tiles.size()));
     ++m_generationCounter;
     ++m_userMarksGenerationCounter;
 
-    for (auto const & tileKey : tiles)
-      PushTaskBackForTileKey(tileKey, texMng, metalineMng);
+    PushTasksForTileKeys(screen, tiles, texMng, metalineMng);
+    UpdatePrefetch(screen, tiles, m2::PointD::Zero(), texMng, metalineMng);
   }
   else
   {
@@ -171,8 +236,16 @@ void ReadManager::UpdateCoverage(ScreenBase const & screen, bool have3dBuildings
     if (forceUpdateUserMarks)
       ++m_userMarksGenerationCounter;
     CheckFinishedTiles(readyTiles, forceUpdateUserMarks);
-    for (auto const & tileKey : newTiles)
-      PushTaskBackForTileKey(tileKey, texMng, metalineMng);
+
+    PushTasksForTileKeys(screen, newTiles, texMng, metalineMng);
+
+    m2::PointD const motion = screen.GlobalRect().GlobalCenter() -
+                              m_currentViewport.GlobalRect().GlobalCenter();
+    UpdatePrefetch(screen, tiles, motion, texMng, metalineMng);
+
+    // Tasks of the previous coverage and prefetched tiles which are
+    // still in the queue are reordered for the new viewport.
+    ReorderTasks(screen);
   }
 
   m_currentViewport = screen;
@@ -192,6 +265,19 @@ void ReadManager::Invalidate(TTilesCollection const & keyStorage)
     CancelTileInfo(info);
     m_tileInfos.erase(info);
   }
+
+  for (auto it = m_prefetchTileInfos.begin(); it != m_prefetchTileInfos.end();)
+  {
+    if (keyStorage.find((*it)->GetTileKey()) != keyStorage.end())
+    {
+      (*it)->Cancel();
+      it = m_prefetchTileInfos.erase(it);
+    }
+    else
+    {
+      ++it;
+    }
+  }
 }
 
 void ReadManager::InvalidateAll()
@@ -199,6 +285,7 @@ void ReadManager::InvalidateAll()
   for (auto const & info : m_tileInfos)
     CancelTileInfo(info);
   m_tileInfos.clear();
+  CancelPrefetch();
 
   m_modeChanged = true;
 }
@@ -213,6 +300,16 @@ bool ReadManager::CheckTileKey(TileKey const & tileKey) const
   return false;
 }
 
+bool ReadManager::IsPrefetchTileKey(TileKey const & tileKey) const
+{
+  for (auto const & tileInfo : m_prefetchTileInfos)
+  {
+    if (tileInfo->GetTileKey().EqualStrict(tileKey))
+      return !tileInfo->IsCancelled();
+  }
+  return false;
+}
+
 bool ReadManager::MustDropAllTiles(ScreenBase const & screen) const
 {
   int const oldScale = df::GetDrawTileScale(m_currentViewport);
@@ -222,26 +319,196 @@ bool ReadManager::MustDropAllTiles(ScreenBase const & screen) const
 
 void ReadManager::PushTaskBackForTileKey(TileKey const & tileKey,
                                          ref_ptr<dp::TextureManager> texMng,
-                                         ref_ptr<MetalineManager> metalineMng)
+                                         ref_ptr<MetalineManager> metalineMng,
+                                         bool isPrefetch)
 {
   ASSERT(m_pool != nullptr, ());
-  auto context = make_unique_dp<EngineContext>(TileKey(tileKey, m_generationCounter, m_userMarksGenerationCounter),
-                                               m_commutator, texMng, metalineMng,
-                                               m_customFeaturesContext,
-                                               m_have3dBuildings && m_allow3dBuildings,
-                                               m_trafficEnabled, m_displacementMode);
+  TileKey const key(tileKey, m_generationCounter, m_userMarksGenerationCounter);
+  bool const is3dBuildings = m_have3dBuildings && m_allow3dBuildings;
+  bool isGeometryCached = false;
+  if (isPrefetch)
+  {
+    ASSERT(m_startPrefetchingFn != nullptr, ());
+    if (!m_startPrefetchingFn(key, is3dBuildings, m_trafficEnabled))
+      return;
+  }
+  else
+  {
+    isGeometryCached = m_uploadCachedGeometryFn != nullptr &&
+                       m_uploadCachedGeometryFn(key, is3dBuildings, m_trafficEnabled);
+  }
+  auto context = make_unique_dp<EngineContext>(key, m_commutator, texMng, metalineMng,
+                                               m_customFeaturesContext, is3dBuildings,
+                                               m_trafficEnabled, m_displacementMode,
+                                               isGeometryCached, isPrefetch);
   std::shared_ptr<TileInfo> tileInfo = std::make_shared<TileInfo>(std::move(context));
-  m_tileInfos.insert(tileInfo);
   ReadMWMTask * task = m_tasksPool.Get();
-
   task->Init(tileInfo);
+
+  if (isPrefetch)
+  {
+    m_prefetchTileInfos.insert(tileInfo);
+  }
+  else
   {
+    m_tileInfos.insert(tileInfo);
     std::lock_guard<std::mutex> lock(m_finishedTilesMutex);
     m_activeTiles.insert(tileKey);
   }
   m_pool->PushBack(task);
 }
 
+template <typename TTiles>
+void ReadManager::PushTasksForTileKeys(ScreenBase const & screen, TTiles const & tiles,
+                                       ref_ptr<dp::TextureManager> texMng,
+                                       ref_ptr<MetalineManager> metalineMng)
+{
+  m2::PointD const center = screen.GlobalRect().GlobalCenter();
+  int const zoomLevel = df::GetDrawTileScale(screen);
+
+  std::vector<std::pair<TaskPriority, TileKey>> orderedTiles;
+  orderedTiles.reserve(tiles.size());
+  for (auto const & tileKey : tiles)
+  {
+    orderedTiles.emplace_back(TaskPriority(tileKey, false /* isCancelled */,
+                                           false /* isPrefetch */, center, zoomLevel),
+                              tileKey);
+  }
+  std::sort(orderedTiles.begin(), orderedTiles.end(),
+            [](std::pair<TaskPriority, TileKey> const & l,
+               std::pair<TaskPriority, TileKey> const & r) { return l.first < r.first; });
+
+  for (auto const & tile : orderedTiles)
+    PushTaskBackForTileKey(tile.second, texMng, metalineMng);
+}
+
+void ReadManager::ReorderTasks(ScreenBase const & screen)
+{
+  ASSERT(m_pool != nullptr, ());
+
+  m2::PointD const center = screen.GlobalRect().GlobalCenter();
+  int const zoomLevel = df::GetDrawTileScale(screen);
+
+  m_pool->ProcessTasks([&center, zoomLevel](std::list<threads::IRoutine *> & tasks)
+  {
+    using TOrderedTask = std::pair<TaskPriority, threads::IRoutine *>;
+
+    std::vector<TOrderedTask> orderedTasks;
+    orderedTasks.reserve(tasks.size());
+    for (auto task : tasks)
+    {
+      ASSERT(dynamic_cast<ReadMWMTask *>(task) != nullptr, ());
+      auto const readTask = static_cast<ReadMWMTask *>(task);
+      orderedTasks.emplace_back(TaskPriority(readTask->GetTileKey(), task->IsCancelled(),
+                                             readTask->IsPrefetch(), center, zoomLevel),
+                                task);
+    }
+    std::stable_sort(orderedTasks.begin(), orderedTasks.end(),
+                     [](TOrderedTask const & l, TOrderedTask const & r) { return l.first < r.first; });
+
+    auto it = tasks.begin();
+    for (auto const & task : orderedTasks)
+      *it++ = task.second;
+  });
+}
+
+void ReadManager::UpdatePrefetch(ScreenBase const & screen, TTilesCollection const & tiles,
+                                 m2::PointD const & motion, ref_ptr<dp::TextureManager> texMng,
+                                 ref_ptr<MetalineManager> metalineMng)
+{
+  if (m_startPrefetchingFn == nullptr || tiles.empty())
+  {
+    CancelPrefetch();
+    return;
+  }
+
+  int const zoomLevel = tiles.begin()->m_zoomLevel;
+  int minX = tiles.begin()->m_x;
+  int maxX = minX;
+  int minY = tiles.begin()->m_y;
+  int maxY = minY;
+  for (auto const & tileKey : tiles)
+  {
+    minX = std::min(minX, tileKey.m_x);
+    maxX = std::max(maxX, tileKey.m_x);
+    minY = std::min(minY, tileKey.m_y);
+    maxY = std::max(maxY, tileKey.m_y);
+  }
+
+  // The ring of tiles around the coverage and one more row or column of
+  // tiles ahead of the motion. The viewport follows the position while
+  // driving, so its motion is the heading.
+  --minX;
+  ++maxX;
+  --minY;
+  ++maxY;
+  if (motion.x > 0.0)
+    ++maxX;
+  else if (motion.x < 0.0)
+    --minX;
+  if (motion.y > 0.0)
+    ++maxY;
+  else if (motion.y < 0.0)
+    --minY;
+
+  // Tiles closer to the expected center of the next viewport go first.
+  m2::PointD const center = screen.GlobalRect().GlobalCenter() + motion;
+  m2::RectD const worldRect = MercatorBounds::FullRect();
+  std::vector<std::pair<TaskPriority, TileKey>> orderedTiles;
+  for (int x = minX; x <= maxX; ++x)
+  {
+    for (int y = minY; y <= maxY; ++y)
+    {
+      TileKey const tileKey(x, y, zoomLevel);
+      if (tiles.find(tileKey) != tiles.end() ||
+          !worldRect.IsIntersect(tileKey.GetGlobalRect(false /* clipByDataMaxZoom */)))
+      {
+        continue;
+      }
+      orderedTiles.emplace_back(TaskPriority(tileKey, false /* isCancelled */,
+                                             true /* isPrefetch */, center, zoomLevel),
+                                tileKey);
+    }
+  }
+  std::sort(orderedTiles.begin(), orderedTiles.end(),
+            [](std::pair<TaskPriority, TileKey> const & l,
+               std::pair<TaskPriority, TileKey> const & r) { return l.first < r.first; });
+  if (orderedTiles.size() > kMaxPrefetchTilesCount)
+    orderedTiles.erase(orderedTiles.begin() + kMaxPrefetchTilesCount, orderedTiles.end());
+
+  TTilesCollection prefetchTiles;
+  for (auto const & tile : orderedTiles)
+    prefetchTiles.insert(tile.second);
+
+  // Tiles which go out of the ring or into the coverage are cancelled.
+  TTilesCollection readTiles;
+  for (auto it = m_prefetchTileInfos.begin(); it != m_prefetchTileInfos.end();)
+  {
+    TileKey const & tileKey = (*it)->GetTileKey();
+    if (prefetchTiles.find(tileKey) == prefetchTiles.end())
+    {
+      (*it)->Cancel();
+      it = m_prefetchTileInfos.erase(it);
+      continue;
+    }
+    readTiles.insert(tileKey);
+    ++it;
+  }
+
+  for (auto const & tile : orderedTiles)
+  {
+    if (readTiles.find(tile.second) == readTiles.end())
+      PushTaskBackForTileKey(tile.second, texMng, metalineMng, true /* isPrefetch */);
+  }
+}
+
+void ReadManager::CancelPrefetch()
+{
+  for (auto const & info : m_prefetchTileInfos)
+    info->Cancel();
+  m_prefetchTileInfos.clear();
+}
+
 void ReadManager::CheckFinishedTiles(TTileInfoCollection const & requestedTiles, bool forceUpdateUserMarks)
 {
   if (requestedTiles.empty())
@@ -323,10 +590,31 @@ void ReadManager::SetDisplacementMode(int displacementMode)
 
 bool ReadManager::SetCustomFeatures(std::set<FeatureID> && ids)
 {
-  size_t const sz = m_customFeaturesContext ? m_customFeaturesContext->m_features.size() : 0;
+  if (m_customFeaturesContext && m_customFeaturesContext->m_features == ids)
+    return false;
+
+  bool const changed = m_customFeaturesContext || !ids.empty();
   m_customFeaturesContext = std::make_shared<CustomFeaturesContext>(std::move(ids));
+  return changed;
+}
 
-  return sz != m_customFeaturesContext->m_features.size();
+bool ReadManager::SetCustomFeatures(MwmSet::MwmId const & mwmId, std::set<FeatureID> && ids)
+{
+  std::set<FeatureID> features;
+  if (m_customFeaturesContext)
+  {
+    for (auto const & s : m_customFeaturesContext->m_features)
+    {
+      if (s.m_mwmId != mwmId)
+        features.insert(s);
+    }
+  }
+  for (auto const & id : ids)
+  {
+    ASSERT_EQUAL(id.m_mwmId, mwmId, ());
+    features.insert(id);
+  }
+  return SetCustomFeatures(std::move(features));
 }
 
 std::vector<FeatureID> ReadManager::GetCustomFeaturesArray() const
@@ -12,6 +12,7 @@
 
 #include "base/thread_pool.hpp"
 
+#include <functional>
 #include <memory>
 #include <mutex>
 #include <set>
@@ -29,12 +30,25 @@ class CoverageUpdateDescriptor;
 class MetalineManager;
 
 uint8_t constexpr kReadingThreadsCount = 2;
+uint8_t constexpr kDeferredShapesThreadsCount = 2;
 
 class ReadManager
 {
 public:
+  // Uploads cached geometry of a tile which is going to be read and
+  // returns true, or returns false when there is no such geometry.
+  using TUploadCachedGeometryFn = std::function<bool(TileKey const & tileKey, bool is3dBuildings,
+                                                     bool isTrafficEnabled)>;
+  // Prepares caching of geometry of a tile which is going to be read
+  // ahead of the viewport and returns true, or returns false when the
+  // geometry is cached already. Tiles aren't prefetched without it.
+  using TStartPrefetchingFn = std::function<bool(TileKey const & tileKey, bool is3dBuildings,
+                                                 bool isTrafficEnabled)>;
+
   ReadManager(ref_ptr<ThreadsCommutator> commutator, MapDataProvider & model,
-              bool allow3dBuildings, bool trafficEnabled);
+              bool allow3dBuildings, bool trafficEnabled,
+              TUploadCachedGeometryFn const & uploadCachedGeometryFn,
+              TStartPrefetchingFn const & startPrefetchingFn = TStartPrefetchingFn());
 
   void Start();
   void Stop();
@@ -48,6 +62,8 @@ public:
   void InvalidateAll();
 
   bool CheckTileKey(TileKey const & tileKey) const;
+  // Returns true for tiles which are read ahead of the viewport.
+  bool IsPrefetchTileKey(TileKey const & tileKey) const;
   void Allow3dBuildings(bool allow3dBuildings);
 
   void SetTrafficEnabled(bool trafficEnabled);
@@ -55,6 +71,7 @@ public:
   void SetDisplacementMode(int displacementMode);
 
   bool SetCustomFeatures(std::set<FeatureID> && ids);
+  bool SetCustomFeatures(MwmSet::MwmId const & mwmId, std::set<FeatureID> && ids);
   std::vector<FeatureID> GetCustomFeaturesArray() const;
   bool RemoveCustomFeatures(MwmSet::MwmId const & mwmId);
   bool RemoveAllCustomFeatures();
@@ -66,13 +83,37 @@ private:
   bool MustDropAllTiles(ScreenBase const & screen) const;
 
   void PushTaskBackForTileKey(TileKey const & tileKey, ref_ptr<dp::TextureManager> texMng,
-                              ref_ptr<MetalineManager> metalineMng);
+                              ref_ptr<MetalineManager> metalineMng, bool isPrefetch = false);
+
+  // Pushes tasks for |tiles| in order of their priorities for |screen|.
+  template <typename TTiles>
+  void PushTasksForTileKeys(ScreenBase const & screen, TTiles const & tiles,
+                            ref_ptr<dp::TextureManager> texMng,
+                            ref_ptr<MetalineManager> metalineMng);
+
+  // Reorders the tasks which are not started yet by their priorities
+  // for |screen|, so the tiles in the center of the new viewport are
+  // read first after a pan and prefetched tiles are read last.
+  void ReorderTasks(ScreenBase const & screen);
+
+  // Reads the ring of tiles around |tiles| and the tiles ahead of the
+  // |motion| of the viewport, so their geometry is cached before they
+  // get into the viewport. Prefetched tiles which go out of the ring
+  // are cancelled.
+  void UpdatePrefetch(ScreenBase const & screen, TTilesCollection const & tiles,
+                      m2::PointD const & motion, ref_ptr<dp::TextureManager> texMng,
+                      ref_ptr<MetalineManager> metalineMng);
+  void CancelPrefetch();
 
   ref_ptr<ThreadsCommutator> m_commutator;
 
   MapDataProvider & m_model;
+  TUploadCachedGeometryFn m_uploadCachedGeometryFn;
+  TStartPrefetchingFn m_startPrefetchingFn;
 
   drape_ptr<threads::ThreadPool> m_pool;
+  // Workers of the second stage of reading, which generate deferred shapes of tiles.
+  drape_ptr<threads::ThreadPool> m_deferredShapesPool;
 
   ScreenBase m_currentViewport;
   bool m_have3dBuildings;
@@ -89,6 +130,9 @@ private:
 
   using TTileSet = std::set<std::shared_ptr<TileInfo>, LessByTileInfo>;
   TTileSet m_tileInfos;
+  // Prefetched tiles aren't the part of the coverage, they are neither
+  // counted nor reported as finished.
+  TTileSet m_prefetchTileInfos;
 
   dp::ObjectPool<ReadMWMTask, ReadMWMTaskFactory> m_tasksPool;
 
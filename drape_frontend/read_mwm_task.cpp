@@ -3,7 +3,8 @@
 namespace df
 {
 ReadMWMTask::ReadMWMTask(MapDataProvider & model)
-  : m_model(model)
+  : m_isPrefetch(false)
+  , m_model(model)
 {
 #ifdef DEBUG
   m_checker = false;
@@ -14,6 +15,7 @@ void ReadMWMTask::Init(shared_ptr<TileInfo> const & tileInfo)
 {
   m_tileInfo = tileInfo;
   m_tileKey = tileInfo->GetTileKey();
+  m_isPrefetch = tileInfo->IsPrefetch();
 #ifdef DEBUG
   m_checker = true;
 #endif
@@ -37,6 +39,12 @@ bool ReadMWMTask::IsCancelled() const
   return tile->IsCancelled() || IRoutine::IsCancelled();
 }
 
+bool ReadMWMTask::HasDeferredShapes() const
+{
+  shared_ptr<TileInfo> tile = m_tileInfo.lock();
+  return tile != nullptr && tile->HasDeferredShapes();
+}
+
 void ReadMWMTask::Do()
 {
 #ifdef DEBUG
@@ -48,7 +56,10 @@ void ReadMWMTask::Do()
     return;
   try
   {
-    tile->ReadFeatures(m_model);
+    if (tile->HasDeferredShapes())
+      tile->GenerateDeferredShapes();
+    else
+      tile->ReadFeatures(m_model);
   }
   catch (TileInfo::ReadCanceledException &)
   {
@@ -21,10 +21,14 @@ public:
   void Reset() override;
   bool IsCancelled() const override;
   TileKey const & GetTileKey() const { return m_tileKey; }
+  bool IsPrefetch() const { return m_isPrefetch; }
+  // The task is passed to the second stage of reading (see TileInfo::GenerateDeferredShapes()).
+  bool HasDeferredShapes() const;
 
 private:
   weak_ptr<TileInfo> m_tileInfo;
   TileKey m_tileKey;
+  bool m_isPrefetch;
   MapDataProvider & m_model;
 
 #ifdef DEBUG
@@ -46,6 +46,7 @@ RenderGroup::RenderGroup(dp::GLState const & state, df::TileKey const & tileKey)
 
 RenderGroup::~RenderGroup()
 {
+  DetachMergedGroup();
   m_renderBuckets.clear();
 }
 
@@ -149,9 +150,22 @@ void RenderGroup::Render(ScreenBase const & screen)
 
 void RenderGroup::AddBucket(drape_ptr<dp::RenderBucket> && bucket)
 {
+  DetachMergedGroup();
   m_renderBuckets.push_back(std::move(bucket));
 }
 
+void RenderGroup::DeleteLater() const
+{
+  DetachMergedGroup();
+  m_pendingOnDelete = true;
+}
+
+void RenderGroup::DetachMergedGroup() const
+{
+  if (m_mergedGroup != nullptr)
+    m_mergedGroup->Invalidate();
+}
+
 bool RenderGroup::IsOverlay() const
 {
   auto const depthLayer = GetDepthLayer(m_state);
@@ -191,6 +205,37 @@ bool RenderGroup::UpdateCanBeDeletedStatus(bool canBeDeleted, int currentZoom, r
   return m_canBeDeleted;
 }
 
+MergedRenderGroup::MergedRenderGroup(dp::GLState const & state, TileKey const & tileKey)
+  : TBase(state, tileKey)
+{}
+
+MergedRenderGroup::~MergedRenderGroup()
+{
+  Invalidate();
+}
+
+void MergedRenderGroup::AddSource(ref_ptr<RenderGroup> group)
+{
+  ASSERT(group->m_mergedGroup == nullptr, ());
+  group->m_mergedGroup = make_ref(this);
+  m_sources.push_back(make_ref(group.get()));
+}
+
+bool MergedRenderGroup::IsFirstSource(ref_ptr<RenderGroup> group) const
+{
+  return !m_sources.empty() && m_sources.front() == group;
+}
+
+void MergedRenderGroup::Invalidate()
+{
+  for (auto & group : m_sources)
+  {
+    ASSERT(group->m_mergedGroup == this, ());
+    group->m_mergedGroup = nullptr;
+  }
+  m_sources.clear();
+}
+
 bool RenderGroupComparator::operator()(drape_ptr<RenderGroup> const & l, drape_ptr<RenderGroup> const & r)
 {
   m_pendingOnDeleteFound |= (l->IsPendingOnDelete() || r->IsPendingOnDelete());
@@ -49,6 +49,8 @@ private:
   TileKey m_tileKey;
 };
 
+class MergedRenderGroup;
+
 class RenderGroup : public BaseRenderGroup
 {
   using TBase = BaseRenderGroup;
@@ -67,7 +69,7 @@ public:
 
   bool IsEmpty() const { return m_renderBuckets.empty(); }
 
-  void DeleteLater() const { m_pendingOnDelete = true; }
+  void DeleteLater() const;
   bool IsPendingOnDelete() const { return m_pendingOnDelete; }
   bool CanBeDeleted() const { return m_canBeDeleted; }
 
@@ -76,15 +78,48 @@ public:
   bool IsOverlay() const;
   bool IsUserMark() const;
 
+  // The group is rendered as a part of the merged group while it's set.
+  ref_ptr<MergedRenderGroup> GetMergedGroup() const { return m_mergedGroup; }
+
 private:
+  friend class MergedRenderGroup;
+
+  void DetachMergedGroup() const;
+
   std::vector<drape_ptr<dp::RenderBucket>> m_renderBuckets;
   mutable bool m_pendingOnDelete;
   mutable bool m_canBeDeleted;
+  mutable ref_ptr<MergedRenderGroup> m_mergedGroup;
 
 private:
   friend std::string DebugPrint(RenderGroup const & group);
 };
 
+// A render group with buckets of render groups with the same state from
+// adjacent tiles. The buckets are copied to shared buffers and their vertices
+// are moved to the tile of the merged group, so the groups are drawn by fewer
+// draw calls. The merged group is rendered instead of the source groups until
+// any of them is changed or deleted.
+class MergedRenderGroup : public RenderGroup
+{
+  using TBase = RenderGroup;
+
+public:
+  MergedRenderGroup(dp::GLState const & state, TileKey const & tileKey);
+  ~MergedRenderGroup() override;
+
+  void AddSource(ref_ptr<RenderGroup> group);
+  bool IsFirstSource(ref_ptr<RenderGroup> group) const;
+  size_t GetSourcesCount() const { return m_sources.size(); }
+
+  // Detaches the source groups, so they are rendered on their own again.
+  void Invalidate();
+  bool IsValid() const { return !m_sources.empty(); }
+
+private:
+  std::vector<ref_ptr<RenderGroup>> m_sources;
+};
+
 class RenderGroupComparator
 {
 public:
@@ -231,6 +231,18 @@ void BuildBuckets(RouteRenderProperty const & renderProperty, ref_ptr<dp::GpuPro
     bucket->GetBuffer()->Build(mng->GetProgram(renderProperty.m_state.GetProgramIndex()));
 }
 
+// Returns geometry of |routeData| with details which match the zoom level of |screen|.
+RouteRenderProperty const & GetRenderProperty(RouteData const & routeData, ScreenBase const & screen)
+{
+  double const zoom = GetZoomLevel(screen.GetScale());
+  for (auto const & lod : routeData.m_lods)
+  {
+    if (zoom < lod->m_zoomLevel && !lod->m_renderProperty.m_buckets.empty())
+      return lod->m_renderProperty;
+  }
+  return routeData.m_renderProperty;
+}
+
 dp::Color GetOutlineColor(SubrouteConstPtr const & subroute)
 {
   if (subroute->m_routeType == RouteType::Car || subroute->m_routeType == RouteType::Taxi)
@@ -390,7 +402,8 @@ void RouteRenderer::RenderRouteData(drape_ptr<RouteData> const & routeData,
                                     ref_ptr<dp::GpuProgramManager> mng,
                                     dp::UniformValuesStorage const & commonUniforms)
 {
-  if (routeData->m_renderProperty.m_buckets.empty())
+  RouteRenderProperty const & renderProperty = GetRenderProperty(*routeData, screen);
+  if (renderProperty.m_buckets.empty())
     return;
 
   // Skip rendering of hidden subroutes.
@@ -403,7 +416,7 @@ void RouteRenderer::RenderRouteData(drape_ptr<RouteData> const & routeData,
   if (m_followingEnabled)
     dist = static_cast<float>(m_distanceFromBegin - routeData->m_subroute->m_baseDistance);
 
-  dp::GLState const & state = routeData->m_renderProperty.m_state;
+  dp::GLState const & state = renderProperty.m_state;
   auto const & subroute = routeData->m_subroute;
 
   // Set up uniforms.
@@ -443,7 +456,7 @@ void RouteRenderer::RenderRouteData(drape_ptr<RouteData> const & routeData,
   dp::ApplyUniforms(uniforms, prg);
 
   // Render buckets.
-  for (auto const & bucket : routeData->m_renderProperty.m_buckets)
+  for (auto const & bucket : renderProperty.m_buckets)
     bucket->Render(state.GetDrawAsLine());
 }
 
@@ -535,6 +548,8 @@ void RouteRenderer::AddRouteData(drape_ptr<RouteData> && routeData,
   // Add new route data.
   m_routeData.push_back(std::move(routeData));
   BuildBuckets(m_routeData.back()->m_renderProperty, mng);
+  for (auto const & lod : m_routeData.back()->m_lods)
+    BuildBuckets(lod->m_renderProperty, mng);
   std::sort(m_routeData.begin(), m_routeData.end(),
             [](drape_ptr<RouteData> const & d1, drape_ptr<RouteData> const & d2)
   {
@@ -625,7 +640,10 @@ void RouteRenderer::ClearGLDependentResources()
 {
   // Here we clear only GL-dependent part of route data.
   for (auto & routeData : m_routeData)
+  {
     routeData->m_renderProperty = RouteRenderProperty();
+    routeData->m_lods.clear();
+  }
 
   // All additional data (like arrows) will be regenerated, so clear them all.
   m_routeAdditional.clear();
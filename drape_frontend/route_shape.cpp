@@ -4,6 +4,7 @@
 #include "drape_frontend/shape_view_params.hpp"
 #include "drape_frontend/tile_utils.hpp"
 #include "drape_frontend/traffic_generator.hpp"
+#include "drape_frontend/visual_params.hpp"
 
 #include "drape/attribute_provider.hpp"
 #include "drape/batcher.hpp"
@@ -11,6 +12,9 @@
 #include "drape/glsl_types.hpp"
 #include "drape/texture_manager.hpp"
 
+#include "geometry/distance.hpp"
+#include "geometry/simplification.hpp"
+
 #include "base/logging.hpp"
 
 namespace df
@@ -80,6 +84,89 @@ std::vector<m2::PointD> CalculatePoints(m2::PolylineD const & polyline,
   return result;
 }
 
+// Returns true if |lhs| means a heavier traffic than |rhs|.
+bool IsHeavierTraffic(traffic::SpeedGroup lhs, traffic::SpeedGroup rhs)
+{
+  auto const severity = [](traffic::SpeedGroup sg)
+  {
+    if (sg == traffic::SpeedGroup::TempBlock)
+      return 0;
+    if (sg == traffic::SpeedGroup::Unknown)
+      return static_cast<int>(traffic::SpeedGroup::Count);
+    return static_cast<int>(sg) + 1;
+  };
+  return severity(lhs) < severity(rhs);
+}
+
+// Simplifies |path| by Douglas-Peucker algorithm. A segment of the simplified path gets
+// the heaviest traffic of segments it replaces. |outDistances| are distances of
+// the simplified points along |path|, so the passed part and arrows match the full geometry.
+void SimplifyRoute(std::vector<m2::PointD> const & path,
+                   std::vector<traffic::SpeedGroup> const & traffic, double epsilon,
+                   std::vector<m2::PointD> & outPath,
+                   std::vector<traffic::SpeedGroup> & outTraffic,
+                   std::vector<double> & outDistances)
+{
+  outPath.clear();
+  outTraffic.clear();
+  outDistances.clear();
+
+  std::vector<size_t> indices;
+  SimplifyDP(path.cbegin(), path.cend(), epsilon * epsilon, m2::DistanceToLineSquare<m2::PointD>(),
+             [&path, &indices](m2::PointD const & pt)
+  {
+    indices.push_back(static_cast<size_t>(&pt - path.data()));
+  });
+  if (indices.empty() || indices.back() + 1 != path.size())
+    indices.push_back(path.size() - 1);
+
+  // Points of degenerated segments are skipped, so every point makes a segment
+  // like in ConstructLineSegments().
+  auto const isClose = [](m2::PointD const & p1, m2::PointD const & p2)
+  {
+    return m2::PointF(p1.x, p1.y).EqualDxDy(m2::PointF(p2.x, p2.y), 1.0E-5);
+  };
+  std::vector<size_t> kept;
+  kept.reserve(indices.size());
+  for (size_t const index : indices)
+  {
+    if (!kept.empty() && isClose(path[kept.back()], path[index]))
+    {
+      // The last point of the path is always kept.
+      if (index + 1 == path.size() && kept.size() > 1)
+        kept.back() = index;
+      continue;
+    }
+    kept.push_back(index);
+  }
+  if (kept.size() < 2)
+    return;
+
+  double distance = 0.0;
+  size_t current = 0;
+  outPath.reserve(kept.size());
+  outDistances.reserve(kept.size());
+  for (size_t i = 0; i < kept.size(); ++i)
+  {
+    for (; current < kept[i]; ++current)
+      distance += path[current].Length(path[current + 1]);
+    outPath.push_back(path[kept[i]]);
+    outDistances.push_back(distance);
+
+    if (traffic.empty() || i == 0)
+      continue;
+
+    ASSERT_EQUAL(traffic.size() + 1, path.size(), ());
+    traffic::SpeedGroup heaviest = traffic[kept[i - 1]];
+    for (size_t j = kept[i - 1] + 1; j < kept[i]; ++j)
+    {
+      if (IsHeavierTraffic(traffic[j], heaviest))
+        heaviest = traffic[j];
+    }
+    outTraffic.push_back(heaviest);
+  }
+}
+
 float SideByNormal(glsl::vec2 const & normal, bool isLeft)
 {
   float const kEps = 1e-5;
@@ -134,7 +221,8 @@ void GenerateArrowsTriangles(glsl::vec4 const & pivot, std::vector<glsl::vec2> c
 } // namespace
 
 void RouteShape::PrepareGeometry(std::vector<m2::PointD> const & path, m2::PointD const & pivot,
-                                 std::vector<glsl::vec4> const & segmentsColors, float baseDepth,
+                                 std::vector<glsl::vec4> const & segmentsColors,
+                                 std::vector<double> const & distances, float baseDepth,
                                  TGeometryBuffer & geometry, TGeometryBuffer & joinsGeometry,
                                  double & outputLength)
 {
@@ -150,8 +238,16 @@ void RouteShape::PrepareGeometry(std::vector<m2::PointD> const & path, m2::Point
 
   // Build geometry.
   float length = 0.0f;
-  for (size_t i = 0; i < segments.size() ; ++i)
-    length += glsl::length(segments[i].m_points[EndPoint] - segments[i].m_points[StartPoint]);
+  if (distances.empty())
+  {
+    for (size_t i = 0; i < segments.size() ; ++i)
+      length += glsl::length(segments[i].m_points[EndPoint] - segments[i].m_points[StartPoint]);
+  }
+  else
+  {
+    ASSERT_EQUAL(distances.size(), segments.size() + 1, ());
+    length = static_cast<float>(distances.back());
+  }
   outputLength = length;
 
   float depth = baseDepth;
@@ -171,7 +267,9 @@ void RouteShape::PrepareGeometry(std::vector<m2::PointD> const & path, m2::Point
     glsl::vec3 const endPivot = glsl::vec3(glsl::ToVec2(endPt), depth);
     depth += depthStep;
 
-    float const startLength = length - glsl::length(segments[i].m_points[EndPoint] - segments[i].m_points[StartPoint]);
+    float const startLength = distances.empty()
+        ? length - glsl::length(segments[i].m_points[EndPoint] - segments[i].m_points[StartPoint])
+        : static_cast<float>(distances[i]);
 
     glsl::vec2 const leftNormalStart = GetNormal(segments[i], true /* isLeft */, StartNormal);
     glsl::vec2 const rightNormalStart = GetNormal(segments[i], false /* isLeft */, StartNormal);
@@ -397,10 +495,43 @@ void RouteShape::CacheRouteArrows(ref_ptr<dp::TextureManager> mng, m2::PolylineD
 }
 
 void RouteShape::CacheRoute(ref_ptr<dp::TextureManager> textures, RouteData & routeData)
+{
+  auto const & subroute = *routeData.m_subroute;
+  std::vector<m2::PointD> const & path = subroute.m_polyline.GetPoints();
+  CacheRouteGeometry(textures, routeData, path, subroute.m_traffic, {} /* distances */,
+                     routeData.m_renderProperty, routeData.m_length);
+
+  std::vector<m2::PointD> lodPath;
+  std::vector<traffic::SpeedGroup> lodTraffic;
+  std::vector<double> lodDistances;
+  for (int const zoomLevel : kRouteLodZoomLevels)
+  {
+    SimplifyRoute(path, subroute.m_traffic, 0.5 * df::GetScale(zoomLevel), lodPath, lodTraffic,
+                  lodDistances);
+
+    // Simplified geometry isn't worth memory if it's close to the full one.
+    if (lodPath.size() < 2 || 2 * lodPath.size() > path.size())
+      continue;
+
+    auto lod = make_unique_dp<RouteLod>();
+    lod->m_zoomLevel = zoomLevel;
+    double length = 0.0;
+    CacheRouteGeometry(textures, routeData, lodPath, lodTraffic, lodDistances,
+                       lod->m_renderProperty, length);
+    routeData.m_lods.push_back(std::move(lod));
+  }
+}
+
+void RouteShape::CacheRouteGeometry(ref_ptr<dp::TextureManager> textures,
+                                    RouteData const & routeData,
+                                    std::vector<m2::PointD> const & path,
+                                    std::vector<traffic::SpeedGroup> const & traffic,
+                                    std::vector<double> const & distances,
+                                    RouteRenderProperty & property, double & outputLength)
 {
   std::vector<glsl::vec4> segmentsColors;
-  segmentsColors.reserve(routeData.m_subroute->m_traffic.size());
-  for (auto speedGroup : routeData.m_subroute->m_traffic)
+  segmentsColors.reserve(traffic.size());
+  for (auto speedGroup : traffic)
   {
     speedGroup = TrafficGenerator::CheckColorsSimplification(speedGroup);
     auto const colorConstant = TrafficGenerator::GetColorBySpeedGroup(speedGroup, true /* route */);
@@ -413,9 +544,9 @@ void RouteShape::CacheRoute(ref_ptr<dp::TextureManager> textures, RouteData & ro
 
   TGeometryBuffer geometry;
   TGeometryBuffer joinsGeometry;
-  PrepareGeometry(routeData.m_subroute->m_polyline.GetPoints(), routeData.m_pivot, segmentsColors,
+  PrepareGeometry(path, routeData.m_pivot, segmentsColors, distances,
                   static_cast<float>(routeData.m_subroute->m_baseDepthIndex * kDepthPerSubroute),
-                  geometry, joinsGeometry, routeData.m_length);
+                  geometry, joinsGeometry, outputLength);
 
   auto state = CreateGLState(routeData.m_subroute->m_pattern.m_isDashed ?
                              gpu::ROUTE_DASH_PROGRAM : gpu::ROUTE_PROGRAM,
@@ -424,7 +555,7 @@ void RouteShape::CacheRoute(ref_ptr<dp::TextureManager> textures, RouteData & ro
 
   BatchGeometry(state, make_ref(geometry.data()), static_cast<uint32_t>(geometry.size()),
                 make_ref(joinsGeometry.data()), static_cast<uint32_t>(joinsGeometry.size()),
-                RV::GetBindingInfo(), routeData.m_renderProperty);
+                RV::GetBindingInfo(), property);
 }
 
 void RouteShape::BatchGeometry(dp::GLState const & state, ref_ptr<void> geometry, uint32_t geomSize,
@@ -34,6 +34,11 @@ float const kArrowTailFactor = static_cast<float>(2.0 * kArrowTailTextureWidth /
 double const kArrowHeightFactor = kArrowTextureHeight / kArrowBodyHeight;
 double const kArrowAspect = kArrowTextureWidth / kArrowTextureHeight;
 
+// Zoom levels of simplified route geometry from the coarsest one. The geometry of
+// a level is simplified with a half-pixel tolerance of the zoom level and it's rendered
+// on smaller zoom levels. The route is rendered by the full geometry on others.
+int const kRouteLodZoomLevels[] = {8, 11, 14};
+
 enum class RouteType : uint8_t
 {
   Car,
@@ -88,10 +93,18 @@ struct BaseRouteData
   RouteRenderProperty m_renderProperty;
 };
 
+struct RouteLod
+{
+  int m_zoomLevel = 0;
+  RouteRenderProperty m_renderProperty;
+};
+
 struct RouteData : public BaseRouteData
 {
   SubrouteConstPtr m_subroute;
   double m_length = 0.0;
+  // Simplified geometry by zoom levels in ascending order.
+  std::vector<drape_ptr<RouteLod>> m_lods;
 };
 
 struct RouteArrowsData : public BaseRouteData {};
@@ -118,14 +131,22 @@ public:
                                RouteArrowsData & routeArrowsData);
 
 private:
+  // |distances| are distances of |path| points from the beginning. They're calculated
+  // by |path| when they're empty.
   static void PrepareGeometry(std::vector<m2::PointD> const & path, m2::PointD const & pivot,
-                              std::vector<glsl::vec4> const & segmentsColors, float baseDepth,
+                              std::vector<glsl::vec4> const & segmentsColors,
+                              std::vector<double> const & distances, float baseDepth,
                               TGeometryBuffer & geometry, TGeometryBuffer & joinsGeometry,
                               double & outputLength);
   static void PrepareArrowGeometry(std::vector<m2::PointD> const & path, m2::PointD const & pivot,
                                    m2::RectF const & texRect, float depthStep, float depth,
                                    TArrowGeometryBuffer & geometry,
                                    TArrowGeometryBuffer & joinsGeometry);
+  static void CacheRouteGeometry(ref_ptr<dp::TextureManager> textures, RouteData const & routeData,
+                                 std::vector<m2::PointD> const & path,
+                                 std::vector<traffic::SpeedGroup> const & traffic,
+                                 std::vector<double> const & distances,
+                                 RouteRenderProperty & property, double & outputLength);
   static void BatchGeometry(dp::GLState const & state, ref_ptr<void> geometry, uint32_t geomSize,
                             ref_ptr<void> joinsGeometry, uint32_t joinsGeomSize,
                             dp::BindingInfo const & bindingInfo, RouteRenderProperty & property);
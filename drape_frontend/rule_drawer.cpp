@@ -218,6 +218,13 @@ RuleDrawer::~RuleDrawer()
   m_context->FlushTrafficGeometry(std::move(m_trafficGeometry));
 }
 
+TMapShapes RuleDrawer::MoveDeferredShapes()
+{
+  TMapShapes shapes;
+  shapes.swap(m_mapShapes[df::Geometry3dType]);
+  return shapes;
+}
+
 bool RuleDrawer::CheckCancelled()
 {
   m_wasCancelled = m_checkCancelled();
@@ -313,7 +320,9 @@ void RuleDrawer::ProcessAreaStyle(FeatureType const & f, Stylist const & s,
                          m_context->Is3dBuildingsEnabled() && isBuildingOutline,
                          areaMinHeight, areaHeight, minVisibleScale, f.GetRank(),
                          s.GetCaptionDescription(), hatchingArea);
-  f.ForEachTriangle(apply, zoomLevel);
+  // Triangles are used by area shapes only, which are cached.
+  if (!m_context->IsGeometryCached())
+    f.ForEachTriangle(apply, zoomLevel);
   apply.SetHotelData(ExtractHotelData(f));
   if (applyPointStyle)
     apply(featureCenter, true /* hasArea */);
@@ -378,7 +387,8 @@ void RuleDrawer::ProcessLineStyle(FeatureType const & f, Stylist const & s,
                            m_generatedRoadShields);
   }
 
-  if (m_context->IsTrafficEnabled() && zoomLevel >= kRoadClass0ZoomLevel)
+  if (m_context->IsTrafficEnabled() && !m_context->IsPrefetch() &&
+      zoomLevel >= kRoadClass0ZoomLevel)
   {
     struct Checker
     {
@@ -483,6 +493,11 @@ void RuleDrawer::operator()(FeatureType const & f)
     int const index = static_cast<int>(shape->GetType());
     ASSERT_LESS(index, static_cast<int>(m_mapShapes.size()), ());
 
+    if ((index == df::GeometryType || index == df::Geometry3dType) && m_context->IsGeometryCached())
+      return;
+    if (index == df::OverlayType && m_context->IsPrefetch())
+      return;
+
     shape->SetFeatureMinZoom(minVisibleScale);
     m_mapShapes[index].push_back(std::move(shape));
   };
@@ -42,6 +42,13 @@ public:
 
   void operator()(FeatureType const & f);
 
+  // Returns true when the last feature was skipped because the tile was cancelled.
+  bool WasCancelled() const { return m_wasCancelled; }
+
+  // Shapes of 3d buildings aren't flushed with the features, they are generated
+  // by the second stage of tile reading (see TileInfo::GenerateDeferredShapes()).
+  TMapShapes MoveDeferredShapes();
+
 private:
   void ProcessAreaStyle(FeatureType const & f, Stylist const & s, TInsertShapeFn const & insertShape,
                         int & minVisibleScale);
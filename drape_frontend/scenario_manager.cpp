@@ -2,8 +2,90 @@
 
 #include "drape_frontend/user_event_stream.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <sstream>
+
 namespace df
 {
+namespace
+{
+double ToMilliseconds(std::chrono::steady_clock::duration const & duration)
+{
+  return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+// Nearest-rank percentile of sorted times.
+double GetPercentile(std::vector<double> const & sortedTimes, double percentile)
+{
+  ASSERT(!sortedTimes.empty(), ());
+  auto const rank = static_cast<size_t>(std::ceil(percentile / 100.0 * sortedTimes.size()));
+  return sortedTimes[std::min(std::max(rank, size_t{1}), sortedTimes.size()) - 1];
+}
+
+ScenarioManager::FrameTimeStatistic GetFrameTimeStatistic(std::vector<double> times)
+{
+  ScenarioManager::FrameTimeStatistic statistic;
+  if (times.empty())
+    return statistic;
+
+  std::sort(times.begin(), times.end());
+  statistic.m_framesCount = static_cast<uint32_t>(times.size());
+  statistic.m_avgTimeInMs = std::accumulate(times.begin(), times.end(), 0.0) / times.size();
+  statistic.m_medianTimeInMs = GetPercentile(times, 50.0);
+  statistic.m_p90TimeInMs = GetPercentile(times, 90.0);
+  statistic.m_p99TimeInMs = GetPercentile(times, 99.0);
+  statistic.m_maxTimeInMs = times.back();
+  return statistic;
+}
+
+void PrintFrameTime(std::ostringstream & ss, ScenarioManager::FrameTimeStatistic const & time)
+{
+  ss << "frames = " << time.m_framesCount << ", avg = " << time.m_avgTimeInMs
+     << "ms, median = " << time.m_medianTimeInMs << "ms, p90 = " << time.m_p90TimeInMs
+     << "ms, p99 = " << time.m_p99TimeInMs << "ms, max = " << time.m_maxTimeInMs << "ms";
+}
+
+std::string DebugPrint(ScenarioManager::ActionType type)
+{
+  switch (type)
+  {
+  case ScenarioManager::ActionType::CenterViewport: return "CenterViewport";
+  case ScenarioManager::ActionType::WaitForTime: return "WaitForTime";
+  case ScenarioManager::ActionType::WaitForTiles: return "WaitForTiles";
+  }
+  ASSERT(false, ());
+  return {};
+}
+}  // namespace
+
+std::string ScenarioManager::ScenarioReport::ToString() const
+{
+  std::ostringstream ss;
+  ss << "\n ===== Scenario " << m_name << (m_isInterrupted ? " (interrupted)" : "") << " =====\n";
+  for (size_t i = 0; i < m_steps.size(); ++i)
+  {
+    auto const & step = m_steps[i];
+    ss << " " << i << ". " << DebugPrint(step.m_actionType) << ": duration = "
+       << step.m_durationInMs << "ms";
+    if (step.m_actionType == ActionType::WaitForTiles)
+    {
+      if (step.m_tilesCompleteTimeInMs < 0.0)
+        ss << ", tiles aren't complete";
+      else
+        ss << ", tiles complete = " << step.m_tilesCompleteTimeInMs << "ms";
+    }
+    ss << ", tiles requested = " << step.m_tilesRequestedCount
+       << ", tiles read = " << step.m_tilesReadCount << "\n   ";
+    PrintFrameTime(ss, step.m_frameTime);
+    ss << "\n";
+  }
+  ss << " Total: ";
+  PrintFrameTime(ss, m_frameTime);
+  ss << "\n";
+  return ss.str();
+}
 
 ScenarioManager::ScenarioManager(FrontendRenderer * frontendRenderer)
   : m_frontendRenderer(frontendRenderer)
@@ -29,7 +111,8 @@ void ScenarioManager::Interrupt()
   InterruptImpl();
 }
 
-bool ScenarioManager::RunScenario(ScenarioData && scenarioData, ScenarioCallback const & onStartFn, ScenarioCallback const & onFinishFn)
+bool ScenarioManager::RunScenario(ScenarioData && scenarioData, ScenarioCallback const & onStartFn,
+                                  ScenarioFinishCallback const & onFinishFn)
 {
   std::lock_guard<std::mutex> lock(m_mutex);
   if (m_thread != nullptr)
@@ -70,6 +153,19 @@ void ScenarioManager::ThreadRoutine()
   if (m_onStartHandler != nullptr)
     m_onStartHandler(scenarioName);
 
+  ScenarioReport report;
+  report.m_name = scenarioName;
+  std::vector<double> allFrameTimes;
+
+  {
+    std::lock_guard<std::mutex> lock(m_statMutex);
+    m_framesCount = 0;
+    m_minCompleteFrame = 0;
+    m_allTilesRead = true;
+    m_isAnimating = false;
+  }
+  m_isMeasuring = true;
+
   for (auto const & action : m_scenarioData.m_scenario)
   {
     // Interrupt scenario if it's necessary.
@@ -78,18 +174,28 @@ void ScenarioManager::ThreadRoutine()
       if (m_needInterrupt)
       {
         m_needInterrupt = false;
+        report.m_isInterrupted = true;
         break;
       }
     }
 
+    StartStep();
+    auto const startTime = std::chrono::steady_clock::now();
+    double tilesCompleteTime = -1.0;
+
     switch(action->GetType())
     {
     case ActionType::CenterViewport:
       {
         CenterViewportAction * centerViewportAction = static_cast<CenterViewportAction *>(action.get());
+        {
+          // The event is processed by the frontend on the next frame at the latest.
+          std::lock_guard<std::mutex> lock(m_statMutex);
+          m_minCompleteFrame = m_framesCount + 2;
+        }
         m_frontendRenderer->AddUserEvent(make_unique_dp<SetCenterEvent>(centerViewportAction->GetCenter(),
                                                                         centerViewportAction->GetZoomLevel(),
-                                                                        true /* isAnim */,
+                                                                        centerViewportAction->IsAnim(),
                                                                         false /* trackVisibleViewport */));
         break;
       }
@@ -101,12 +207,25 @@ void ScenarioManager::ThreadRoutine()
         break;
       }
 
+    case ActionType::WaitForTiles:
+      {
+        WaitForTilesAction * waitForTilesAction = static_cast<WaitForTilesAction *>(action.get());
+        tilesCompleteTime = WaitForTiles(waitForTilesAction->GetTimeout());
+        break;
+      }
+
     default:
       LOG(LINFO, ("Unknown action in scenario"));
     }
+
+    FinishStep(action->GetType(), startTime, report, allFrameTimes);
+    report.m_steps.back().m_tilesCompleteTimeInMs = tilesCompleteTime;
   }
 
-  ScenarioCallback handler = nullptr;
+  m_isMeasuring = false;
+  report.m_frameTime = GetFrameTimeStatistic(std::move(allFrameTimes));
+
+  ScenarioFinishCallback handler = nullptr;
   {
     std::lock_guard<std::mutex> lock(m_mutex);
     m_scenarioData.m_scenario.clear();
@@ -119,7 +238,87 @@ void ScenarioManager::ThreadRoutine()
   }
 
   if (handler != nullptr)
-    handler(scenarioName);
+    handler(report);
+}
+
+void ScenarioManager::StartStep()
+{
+  std::lock_guard<std::mutex> lock(m_statMutex);
+  m_frameTimesInMs.clear();
+  m_tilesRequestedCount = 0;
+  m_tilesReadCount = 0;
+}
+
+void ScenarioManager::FinishStep(ActionType actionType,
+                                 std::chrono::steady_clock::time_point const & startTime,
+                                 ScenarioReport & report, std::vector<double> & allFrameTimes)
+{
+  StepReport step;
+  step.m_actionType = actionType;
+  step.m_durationInMs = ToMilliseconds(std::chrono::steady_clock::now() - startTime);
+
+  std::vector<double> frameTimes;
+  {
+    std::lock_guard<std::mutex> lock(m_statMutex);
+    frameTimes.swap(m_frameTimesInMs);
+    step.m_tilesRequestedCount = m_tilesRequestedCount;
+    step.m_tilesReadCount = m_tilesReadCount;
+  }
+
+  allFrameTimes.insert(allFrameTimes.end(), frameTimes.begin(), frameTimes.end());
+  step.m_frameTime = GetFrameTimeStatistic(std::move(frameTimes));
+  report.m_steps.push_back(step);
+}
+
+double ScenarioManager::WaitForTiles(WaitForTilesAction::Duration const & timeout)
+{
+  auto const startTime = std::chrono::steady_clock::now();
+  std::unique_lock<std::mutex> lock(m_statMutex);
+  bool const isComplete = m_tilesCondition.wait_for(lock, timeout, [this]()
+  {
+    return m_framesCount >= m_minCompleteFrame && m_allTilesRead && !m_isAnimating;
+  });
+  if (!isComplete)
+    return -1.0;
+  return ToMilliseconds(std::chrono::steady_clock::now() - startTime);
+}
+
+void ScenarioManager::OnFrame(double frameTimeInSeconds, bool isActive, bool isAnimating)
+{
+  if (!m_isMeasuring)
+    return;
+
+  {
+    std::lock_guard<std::mutex> lock(m_statMutex);
+    ++m_framesCount;
+    m_isAnimating = isAnimating;
+    if (isActive)
+      m_frameTimesInMs.push_back(frameTimeInSeconds * 1000.0);
+  }
+  m_tilesCondition.notify_all();
+}
+
+void ScenarioManager::OnTilesRequested(size_t tilesCount)
+{
+  if (!m_isMeasuring)
+    return;
+
+  std::lock_guard<std::mutex> lock(m_statMutex);
+  m_tilesRequestedCount += static_cast<uint32_t>(tilesCount);
+  m_allTilesRead = tilesCount == 0;
+}
+
+void ScenarioManager::OnTilesRead(size_t tilesCount, bool allTilesRead)
+{
+  if (!m_isMeasuring)
+    return;
+
+  {
+    std::lock_guard<std::mutex> lock(m_statMutex);
+    m_tilesReadCount += static_cast<uint32_t>(tilesCount);
+    m_allTilesRead = allTilesRead;
+  }
+  m_tilesCondition.notify_all();
 }
 
 void ScenarioManager::InterruptImpl()
@@ -9,22 +9,31 @@
 #include "base/stl_add.hpp"
 #include "base/thread.hpp"
 
+#include <atomic>
 #include <chrono>
+#include <condition_variable>
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <mutex>
+#include <string>
 #include <vector>
 
 namespace df
 {
 
+// Replays scenarios of camera actions and measures them: frame times,
+// time until all tiles of the viewport are read and counts of tiles which
+// are requested from the backend and read by it. Every action is a step
+// of the report.
 class ScenarioManager
 {
 public:
   enum class ActionType
   {
     CenterViewport,
-    WaitForTime
+    WaitForTime,
+    WaitForTiles
   };
 
   class Action
@@ -37,16 +46,18 @@ public:
   class CenterViewportAction : public Action
   {
   public:
-    CenterViewportAction(m2::PointD const & pt, int zoomLevel)
-      : m_center(pt), m_zoomLevel(zoomLevel) {}
+    CenterViewportAction(m2::PointD const & pt, int zoomLevel, bool isAnim = true)
+      : m_center(pt), m_zoomLevel(zoomLevel), m_isAnim(isAnim) {}
 
     ActionType GetType() override { return ActionType::CenterViewport; }
 
     m2::PointD const & GetCenter() const { return m_center; }
     int GetZoomLevel() const { return m_zoomLevel; }
+    bool IsAnim() const { return m_isAnim; }
   private:
     m2::PointD const m_center;
     int const m_zoomLevel;
+    bool const m_isAnim;
   };
 
   class WaitForTimeAction : public Action
@@ -64,8 +75,59 @@ public:
     Duration m_duration;
   };
 
+  // Waits until animations are finished and all tiles of the viewport
+  // are read, but not longer than the timeout.
+  class WaitForTilesAction : public Action
+  {
+  public:
+    using Duration = std::chrono::steady_clock::duration;
+
+    WaitForTilesAction(Duration const & timeout)
+      : m_timeout(timeout) {}
+
+    ActionType GetType() override { return ActionType::WaitForTiles; }
+
+    Duration const & GetTimeout() const { return m_timeout; }
+  private:
+    Duration m_timeout;
+  };
+
+  struct FrameTimeStatistic
+  {
+    uint32_t m_framesCount = 0;
+    double m_avgTimeInMs = 0.0;
+    double m_medianTimeInMs = 0.0;
+    double m_p90TimeInMs = 0.0;
+    double m_p99TimeInMs = 0.0;
+    double m_maxTimeInMs = 0.0;
+  };
+
+  struct StepReport
+  {
+    ActionType m_actionType = ActionType::WaitForTime;
+    double m_durationInMs = 0.0;
+    // Time from the start of a WaitForTiles step until all tiles are read,
+    // it's negative for other steps and when the timeout is exceeded.
+    double m_tilesCompleteTimeInMs = -1.0;
+    uint32_t m_tilesRequestedCount = 0;
+    uint32_t m_tilesReadCount = 0;
+    FrameTimeStatistic m_frameTime;
+  };
+
+  struct ScenarioReport
+  {
+    std::string ToString() const;
+
+    std::string m_name;
+    bool m_isInterrupted = false;
+    std::vector<StepReport> m_steps;
+    // Frames of all steps.
+    FrameTimeStatistic m_frameTime;
+  };
+
   using Scenario = std::vector<std::unique_ptr<Action>>;
   using ScenarioCallback = std::function<void(std::string const & name)>;
+  using ScenarioFinishCallback = std::function<void(ScenarioReport const & report)>;
 
   struct ScenarioData
   {
@@ -76,15 +138,27 @@ public:
   ScenarioManager(FrontendRenderer * frontendRenderer);
   ~ScenarioManager();
 
-  bool RunScenario(ScenarioData && scenarioData,
-                   ScenarioCallback const & startHandler, ScenarioCallback const & finishHandler);
+  bool RunScenario(ScenarioData && scenarioData, ScenarioCallback const & startHandler,
+                   ScenarioFinishCallback const & finishHandler);
   void Interrupt();
   bool IsRunning();
 
+  // Measurement hooks, they are called by the frontend renderer on its thread.
+  // |isActive| is false for frames after idle waiting, their time isn't counted.
+  void OnFrame(double frameTimeInSeconds, bool isActive, bool isAnimating);
+  void OnTilesRequested(size_t tilesCount);
+  void OnTilesRead(size_t tilesCount, bool allTilesRead);
+
 private:
   void ThreadRoutine();
   void InterruptImpl();
 
+  void StartStep();
+  void FinishStep(ActionType actionType, std::chrono::steady_clock::time_point const & startTime,
+                  ScenarioReport & report, std::vector<double> & allFrameTimes);
+  // Returns time of waiting for tiles or a negative value if the timeout is exceeded.
+  double WaitForTiles(WaitForTilesAction::Duration const & timeout);
+
   FrontendRenderer * m_frontendRenderer;
 
   std::mutex m_mutex;
@@ -92,7 +166,21 @@ private:
   bool m_needInterrupt;
   bool m_isFinished;
   ScenarioCallback m_onStartHandler;
-  ScenarioCallback m_onFinishHandler;
+  ScenarioFinishCallback m_onFinishHandler;
+
+  // Statistic of the current step, it's guarded by |m_statMutex|.
+  std::atomic<bool> m_isMeasuring{false};
+  std::mutex m_statMutex;
+  std::condition_variable m_tilesCondition;
+  std::vector<double> m_frameTimesInMs;
+  uint32_t m_tilesRequestedCount = 0;
+  uint32_t m_tilesReadCount = 0;
+  uint64_t m_framesCount = 0;
+  bool m_allTilesRead = true;
+  bool m_isAnimating = false;
+  // Tiles aren't considered to be read until the frontend renders this frame,
+  // so the wait doesn't finish before the frontend processes the last action.
+  uint64_t m_minCompleteFrame = 0;
 #ifdef DEBUG
   std::thread::id m_threadId;
 #endif
@@ -0,0 +1,66 @@
+#include "drape_frontend/shaped_text_cache.hpp"
+
+#include "base/assert.hpp"
+
+namespace df
+{
+// static
+size_t constexpr ShapedTextCache::kMaxSize;
+
+// static
+ShapedTextCache & ShapedTextCache::Instance()
+{
+  static ShapedTextCache instance;
+  return instance;
+}
+
+ShapedTextCache::ShapedTextCache(size_t maxSize) : m_maxSize(maxSize)
+{
+  ASSERT_GREATER(m_maxSize, 0, ());
+}
+
+std::shared_ptr<ShapedTextCache::ShapedText const> ShapedTextCache::Get(
+    strings::UniString const & text, TShapeFn const & shape)
+{
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto const it = m_texts.find(text);
+    if (it != m_texts.end())
+      return it->second;
+  }
+
+  auto shaped = std::make_shared<ShapedText>();
+  shape(text, *shaped);
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  // Another worker may have shaped the text meanwhile.
+  auto const it = m_texts.find(text);
+  if (it != m_texts.end())
+    return it->second;
+
+  if (m_texts.size() >= m_maxSize)
+    m_texts.clear();
+  m_texts.emplace(text, shaped);
+  return shaped;
+}
+
+size_t ShapedTextCache::GetSize() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_texts.size();
+}
+
+void ShapedTextCache::Clear()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_texts.clear();
+}
+
+size_t ShapedTextCache::Hash::operator()(strings::UniString const & text) const
+{
+  size_t hash = 0;
+  for (auto const c : text)
+    hash = hash * 31 + c;
+  return hash;
+}
+}  // namespace df
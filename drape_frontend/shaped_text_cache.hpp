@@ -0,0 +1,66 @@
+#pragma once
+
+#include "base/buffer_vector.hpp"
+#include "base/macros.hpp"
+#include "base/string_utils.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace df
+{
+// A thread-safe cache of texts shaped for text layouts, i.e. reordered
+// from the logical order to the visual one (see bidi::log2vis()) and
+// split into lines. Labels repeat across tiles and zoom levels (e.g.
+// names of streets), so the backend workers share the results.
+//
+// Shaping doesn't depend on the font size and the style of a label, so
+// texts are the only keys. Glyph regions are not cached, layouts request
+// them from the texture manager because glyphs may be moved to other
+// textures.
+class ShapedTextCache
+{
+public:
+  struct ShapedText
+  {
+    // The text in the visual order.
+    strings::UniString m_visibleText;
+    // The visible text prepared for straight layouts with the ends of
+    // its lines.
+    strings::UniString m_splitText;
+    buffer_vector<size_t, 2> m_delimIndexes;
+  };
+
+  using TShapeFn = std::function<void(strings::UniString const & text, ShapedText & shaped)>;
+
+  static size_t constexpr kMaxSize = 4096;
+
+  static ShapedTextCache & Instance();
+
+  explicit ShapedTextCache(size_t maxSize = kMaxSize);
+
+  // Returns the shaped |text|. |shape| is called outside of the lock
+  // for texts which aren't cached yet. When the cache is full it's
+  // cleared.
+  std::shared_ptr<ShapedText const> Get(strings::UniString const & text, TShapeFn const & shape);
+
+  size_t GetSize() const;
+  void Clear();
+
+private:
+  struct Hash
+  {
+    size_t operator()(strings::UniString const & text) const;
+  };
+
+  size_t const m_maxSize;
+
+  mutable std::mutex m_mutex;
+  std::unordered_map<strings::UniString, std::shared_ptr<ShapedText const>, Hash> m_texts;
+
+  DISALLOW_COPY_AND_MOVE(ShapedTextCache);
+};
+}  // namespace df
@@ -365,9 +365,8 @@ bool InitStylist(FeatureType const & f, int8_t deviceLang, int const zoomLevel,
     return false;
 
   drule::KeysT keys;
-  pair<int, bool> const geomType = feature::GetDrawRule(types, zoomLevel, keys);
-
-  feature::FilterRulesByRuntimeSelector(f, zoomLevel, keys);
+  pair<int, bool> const geomType =
+      feature::GetDrawRuleFilteredByRuntimeSelector(f, types, zoomLevel, keys);
 
   if (keys.empty())
     return false;
@@ -416,9 +415,8 @@ bool InitStylist(FeatureType const & f, int8_t deviceLang, int const zoomLevel,
 double GetFeaturePriority(FeatureType const & f, int const zoomLevel)
 {
   drule::KeysT keys;
-  pair<int, bool> const geomType = feature::GetDrawRule(f, zoomLevel, keys);
-
-  feature::FilterRulesByRuntimeSelector(f, zoomLevel, keys);
+  pair<int, bool> const geomType =
+      feature::GetDrawRuleFilteredByRuntimeSelector(f, feature::TypesHolder(f), zoomLevel, keys);
 
   feature::EGeomType const mainGeomType = feature::EGeomType(geomType.first);
 
@@ -1,5 +1,6 @@
 #include "drape_frontend/text_layout.hpp"
 #include "drape_frontend/map_shape.hpp"
+#include "drape_frontend/shaped_text_cache.hpp"
 #include "drape_frontend/visual_params.hpp"
 
 #include "drape/bidi.hpp"
@@ -279,6 +280,16 @@ void CalculateOffsets(dp::Anchor anchor, float textRatio,
   pixelSize = m2::PointF(maxLength, summaryHeight);
 }
 
+void ShapeText(strings::UniString const & text, ShapedTextCache::ShapedText & shaped)
+{
+  shaped.m_visibleText = bidi::log2vis(text);
+  shaped.m_splitText = shaped.m_visibleText;
+  if (shaped.m_visibleText == text)
+    SplitText(shaped.m_splitText, shaped.m_delimIndexes);
+  else
+    shaped.m_delimIndexes.push_back(shaped.m_visibleText.size());
+}
+
 double GetTextMinPeriod(double pixelTextLength)
 {
   double const vs = df::VisualParams::Instance().GetVisualScale();
@@ -341,15 +352,10 @@ strings::UniString const & TextLayout::GetText() const
 StraightTextLayout::StraightTextLayout(strings::UniString const & text, float fontSize, bool isSdf,
                                        ref_ptr<dp::TextureManager> textures, dp::Anchor anchor)
 {
-  strings::UniString visibleText = bidi::log2vis(text);
-  buffer_vector<size_t, 2> delimIndexes;
-  if (visibleText == text)
-    SplitText(visibleText, delimIndexes);
-  else
-    delimIndexes.push_back(visibleText.size());
-
-  TBase::Init(visibleText, fontSize, isSdf, textures);
-  CalculateOffsets(anchor, m_textSizeRatio, m_metrics, delimIndexes, m_offsets, m_pixelSize);
+  auto const shaped = ShapedTextCache::Instance().Get(text, ShapeText);
+  TBase::Init(shaped->m_splitText, fontSize, isSdf, textures);
+  CalculateOffsets(anchor, m_textSizeRatio, m_metrics, shaped->m_delimIndexes, m_offsets,
+                   m_pixelSize);
 }
 
 void StraightTextLayout::Cache(glm::vec4 const & pivot, glm::vec2 const & pixelOffset,
@@ -397,7 +403,7 @@ PathTextLayout::PathTextLayout(m2::PointD const & tileCenter, strings::UniString
                                float fontSize, bool isSdf, ref_ptr<dp::TextureManager> textures)
   : m_tileCenter(tileCenter)
 {
-  Init(bidi::log2vis(text), fontSize, isSdf, textures);
+  Init(ShapedTextCache::Instance().Get(text, ShapeText)->m_visibleText, fontSize, isSdf, textures);
 }
 
 void PathTextLayout::CacheStaticGeometry(dp::TextureManager::ColorRegion const & colorRegion,
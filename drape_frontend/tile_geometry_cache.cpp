@@ -0,0 +1,298 @@
+#include "drape_frontend/tile_geometry_cache.hpp"
+
+#include "drape/index_storage.hpp"
+#include "drape/render_bucket.hpp"
+
+#include "platform/platform.hpp"
+
+#include "coding/file_name_utils.hpp"
+#include "coding/file_reader.hpp"
+#include "coding/file_writer.hpp"
+#include "coding/internal/file_data.hpp"
+#include "coding/reader.hpp"
+#include "coding/write_to_sink.hpp"
+
+#include "base/assert.hpp"
+#include "base/exception.hpp"
+#include "base/logging.hpp"
+#include "base/string_utils.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <tuple>
+#include <utility>
+
+namespace df
+{
+namespace
+{
+std::string const kSpillFileExtension = ".geom";
+
+template <typename TSink>
+void WriteData(TSink & sink, std::vector<uint8_t> const & data)
+{
+  WriteToSink(sink, static_cast<uint32_t>(data.size()));
+  sink.Write(data.data(), data.size());
+}
+
+template <typename TSource>
+void ReadData(TSource & source, std::vector<uint8_t> & data)
+{
+  data.resize(ReadPrimitiveFromSource<uint32_t>(source));
+  source.Read(data.data(), data.size());
+}
+}  // namespace
+
+TileGeometryCache::Key::Key(TileKey const & tileKey, MapStyle style, bool is3dBuildings,
+                            bool isTrafficEnabled)
+  : m_x(tileKey.m_x)
+  , m_y(tileKey.m_y)
+  , m_zoomLevel(tileKey.m_zoomLevel)
+  , m_style(style)
+  , m_is3dBuildings(is3dBuildings)
+  , m_isTrafficEnabled(isTrafficEnabled)
+{
+}
+
+bool TileGeometryCache::Key::operator<(Key const & other) const
+{
+  return std::tie(m_zoomLevel, m_x, m_y, m_style, m_is3dBuildings, m_isTrafficEnabled) <
+         std::tie(other.m_zoomLevel, other.m_x, other.m_y, other.m_style, other.m_is3dBuildings,
+                  other.m_isTrafficEnabled);
+}
+
+size_t TileGeometryCache::Bucket::GetDataSize() const
+{
+  size_t size = m_indices.size();
+  for (auto const & buffer : m_buffers)
+    size += buffer.second.size();
+  return size;
+}
+
+TileGeometryCache::TileGeometryCache(Params const & params) : m_params(params)
+{
+  if (m_params.m_spillDir.empty())
+    return;
+
+  // Files may be left by a previous run which was interrupted.
+  GetPlatform().MkDir(m_params.m_spillDir);
+  Platform::FilesList files;
+  Platform::GetFilesByExt(m_params.m_spillDir, kSpillFileExtension, files);
+  for (auto const & file : files)
+    my::DeleteFileX(my::JoinPath(m_params.m_spillDir, file));
+}
+
+TileGeometryCache::~TileGeometryCache() { Clear(); }
+
+// static
+bool TileGeometryCache::CopyBucket(dp::GLState const & state, ref_ptr<dp::RenderBucket> bucket,
+                                   Bucket & result)
+{
+  if (bucket->HasOverlayHandles())
+    return false;
+
+  result.m_state = state;
+  result.m_featuresMinZoom = bucket->GetMinZoom();
+  return bucket->GetBuffer()->GetCpuData(result.m_buffers, result.m_indices);
+}
+
+// static
+drape_ptr<dp::RenderBucket> TileGeometryCache::CreateRenderBucket(Bucket const & bucket)
+{
+  uint32_t vertexCount = 0;
+  if (!bucket.m_buffers.empty())
+  {
+    auto const & buffer = bucket.m_buffers.front();
+    vertexCount = static_cast<uint32_t>(buffer.second.size() / buffer.first.GetElementSize());
+  }
+  auto const indexCount =
+      static_cast<uint32_t>(bucket.m_indices.size() / dp::IndexStorage::SizeOfIndex());
+
+  auto buffer = make_unique_dp<dp::VertexArrayBuffer>(std::max(indexCount, 1u),
+                                                      std::max(vertexCount, 1u));
+  for (auto const & data : bucket.m_buffers)
+    buffer->UploadData(data.first, data.second.data(), vertexCount);
+  buffer->UploadIndexes(bucket.m_indices.data(), indexCount);
+  buffer->Preflush();
+
+  auto result = make_unique_dp<dp::RenderBucket>(std::move(buffer));
+  result->SetFeatureMinZoom(bucket.m_featuresMinZoom);
+  return result;
+}
+
+void TileGeometryCache::Put(Key const & key, TBuckets && buckets)
+{
+  auto it = m_entries.find(key);
+  if (it != m_entries.end())
+    EraseEntry(it);
+
+  m_lru.push_front(key);
+  Entry & entry = m_entries[key];
+  entry.m_buckets = std::move(buckets);
+  for (auto const & bucket : entry.m_buckets)
+    entry.m_dataSize += bucket.GetDataSize();
+  entry.m_lruIt = m_lru.begin();
+  m_memorySize += entry.m_dataSize;
+  m_memory.Set(m_memorySize);
+
+  CheckLimits();
+}
+
+TileGeometryCache::TBuckets const * TileGeometryCache::Get(Key const & key)
+{
+  auto it = m_entries.find(key);
+  if (it == m_entries.end())
+    return nullptr;
+
+  Entry & entry = it->second;
+  if (!entry.m_fileName.empty() && !Restore(entry))
+  {
+    EraseEntry(it);
+    return nullptr;
+  }
+
+  Touch(entry);
+  CheckLimits();
+  return &entry.m_buckets;
+}
+
+void TileGeometryCache::Erase(m2::RectD const & rect)
+{
+  for (auto it = m_entries.begin(); it != m_entries.end();)
+  {
+    Key const & key = it->first;
+    if (TileKey(key.m_x, key.m_y, key.m_zoomLevel).GetGlobalRect().IsIntersect(rect))
+      EraseEntry(it++);
+    else
+      ++it;
+  }
+}
+
+void TileGeometryCache::Clear()
+{
+  while (!m_entries.empty())
+    EraseEntry(m_entries.begin());
+  ASSERT(m_lru.empty(), ());
+  ASSERT_EQUAL(m_memorySize, 0, ());
+  ASSERT_EQUAL(m_diskSize, 0, ());
+}
+
+void TileGeometryCache::Touch(Entry & entry)
+{
+  m_lru.splice(m_lru.begin(), m_lru, entry.m_lruIt);
+}
+
+void TileGeometryCache::EraseEntry(TEntries::iterator it)
+{
+  Entry & entry = it->second;
+  if (entry.m_fileName.empty())
+  {
+    m_memorySize -= entry.m_dataSize;
+    m_memory.Set(m_memorySize);
+  }
+  else
+  {
+    my::DeleteFileX(entry.m_fileName);
+    m_diskSize -= entry.m_dataSize;
+  }
+
+  m_lru.erase(entry.m_lruIt);
+  m_entries.erase(it);
+}
+
+void TileGeometryCache::CheckLimits()
+{
+  // The most recently used tile is never spilled, since it may be being
+  // uploaded right now.
+  auto const first = m_lru.empty() ? m_lru.end() : std::next(m_lru.begin());
+  auto it = m_lru.end();
+  while (m_memorySize > m_params.m_memoryLimit && it != first)
+  {
+    auto entryIt = m_entries.find(*std::prev(it));
+    ASSERT(entryIt != m_entries.end(), ());
+    if (entryIt->second.m_fileName.empty() && !Spill(entryIt->second))
+      EraseEntry(entryIt);
+    else
+      --it;
+  }
+
+  it = m_lru.end();
+  while (m_diskSize > m_params.m_diskLimit && it != m_lru.begin())
+  {
+    auto entryIt = m_entries.find(*std::prev(it));
+    ASSERT(entryIt != m_entries.end(), ());
+    if (!entryIt->second.m_fileName.empty())
+      EraseEntry(entryIt);
+    else
+      --it;
+  }
+}
+
+bool TileGeometryCache::Spill(Entry & entry)
+{
+  ASSERT(entry.m_fileName.empty(), ());
+  if (m_params.m_spillDir.empty() || entry.m_dataSize > m_params.m_diskLimit)
+    return false;
+
+  std::string const fileName = my::JoinPath(
+      m_params.m_spillDir, strings::to_string(m_nextFileIndex++) + kSpillFileExtension);
+  try
+  {
+    FileWriter writer(fileName);
+    for (auto const & bucket : entry.m_buckets)
+    {
+      for (auto const & buffer : bucket.m_buffers)
+        WriteData(writer, buffer.second);
+      WriteData(writer, bucket.m_indices);
+    }
+  }
+  catch (RootException const & e)
+  {
+    LOG(LWARNING, ("Can't spill tile geometry to", fileName, e.Msg()));
+    my::DeleteFileX(fileName);
+    return false;
+  }
+
+  // States and bindings stay in memory, they can't be serialized.
+  for (auto & bucket : entry.m_buckets)
+  {
+    for (auto & buffer : bucket.m_buffers)
+      std::vector<uint8_t>().swap(buffer.second);
+    std::vector<uint8_t>().swap(bucket.m_indices);
+  }
+
+  entry.m_fileName = fileName;
+  m_memorySize -= entry.m_dataSize;
+  m_memory.Set(m_memorySize);
+  m_diskSize += entry.m_dataSize;
+  return true;
+}
+
+bool TileGeometryCache::Restore(Entry & entry)
+{
+  ASSERT(!entry.m_fileName.empty(), ());
+  try
+  {
+    FileReader reader(entry.m_fileName, true /* withExceptions */);
+    ReaderSource<FileReader> source(reader);
+    for (auto & bucket : entry.m_buckets)
+    {
+      for (auto & buffer : bucket.m_buffers)
+        ReadData(source, buffer.second);
+      ReadData(source, bucket.m_indices);
+    }
+  }
+  catch (RootException const & e)
+  {
+    LOG(LWARNING, ("Can't read spilled tile geometry from", entry.m_fileName, e.Msg()));
+    return false;
+  }
+
+  my::DeleteFileX(entry.m_fileName);
+  entry.m_fileName.clear();
+  m_diskSize -= entry.m_dataSize;
+  m_memorySize += entry.m_dataSize;
+  m_memory.Set(m_memorySize);
+  return true;
+}
+}  // namespace df
@@ -0,0 +1,141 @@
+#pragma once
+
+#include "drape_frontend/tile_key.hpp"
+
+#include "drape/glstate.hpp"
+#include "drape/pointers.hpp"
+#include "drape/vertex_array_buffer.hpp"
+
+#include "indexer/map_style.hpp"
+
+#include "geometry/rect2d.hpp"
+
+#include "base/macros.hpp"
+#include "base/memory_counters.hpp"
+
+#include <cstdint>
+#include <list>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace dp
+{
+class RenderBucket;
+}  // namespace dp
+
+namespace df
+{
+// Cache of finished geometry of tiles, i.e. CPU copies of vertex and
+// index buffers of render buckets, which are uploaded again instead of
+// reading and tessellating features. Buckets with overlay handles are
+// never cached, overlays are read as usual.
+//
+// Recently used tiles are kept in memory, the others are spilled to
+// disk until the disk limit is exceeded. States of buckets refer to
+// textures, so the cache must be cleared when GL resources are
+// released, and spilled files live only as long as the cache.
+//
+// Not thread safe, it's used on the backend renderer thread.
+class TileGeometryCache
+{
+public:
+  struct Params
+  {
+    // Limits of the size of cached buffers in bytes.
+    size_t m_memoryLimit = 32 * 1024 * 1024;
+    size_t m_diskLimit = 128 * 1024 * 1024;
+    // Spilled tiles are dropped when the directory is empty.
+    std::string m_spillDir;
+  };
+
+  struct Key
+  {
+    Key(TileKey const & tileKey, MapStyle style, bool is3dBuildings, bool isTrafficEnabled);
+
+    bool operator<(Key const & other) const;
+
+    // Generations of the tile key are not considered.
+    int m_x;
+    int m_y;
+    int m_zoomLevel;
+    MapStyle m_style;
+    bool m_is3dBuildings;
+    bool m_isTrafficEnabled;
+  };
+
+  struct Bucket
+  {
+    explicit Bucket(dp::GLState const & state) : m_state(state) {}
+
+    size_t GetDataSize() const;
+
+    dp::GLState m_state;
+    int m_featuresMinZoom = 0;
+    dp::VertexArrayBuffer::TBuffersData m_buffers;
+    std::vector<uint8_t> m_indices;
+  };
+
+  using TBuckets = std::vector<Bucket>;
+
+  explicit TileGeometryCache(Params const & params);
+  ~TileGeometryCache();
+
+  // Copies data of |bucket| before it's moved to GPU. Returns false when
+  // the bucket can't be cached.
+  static bool CopyBucket(dp::GLState const & state, ref_ptr<dp::RenderBucket> bucket,
+                         Bucket & result);
+  // Creates a render bucket ready to be flushed. Must be called on the
+  // thread with GL context.
+  static drape_ptr<dp::RenderBucket> CreateRenderBucket(Bucket const & bucket);
+
+  void Put(Key const & key, TBuckets && buckets);
+
+  // Returns nullptr when there is no geometry for |key|. Spilled geometry
+  // is read back to memory. The result is valid until the next call of
+  // a non-const method.
+  TBuckets const * Get(Key const & key);
+  // Doesn't read spilled geometry back and doesn't touch the entry.
+  bool Contains(Key const & key) const { return m_entries.find(key) != m_entries.end(); }
+
+  // Removes tiles which intersect |rect|.
+  void Erase(m2::RectD const & rect);
+  void Clear();
+
+  size_t GetMemorySize() const { return m_memorySize; }
+  size_t GetDiskSize() const { return m_diskSize; }
+
+private:
+  struct Entry
+  {
+    TBuckets m_buckets;
+    size_t m_dataSize = 0;
+    // Buffers of spilled entries are empty and stored in the file.
+    std::string m_fileName;
+    std::list<Key>::iterator m_lruIt;
+  };
+
+  using TEntries = std::map<Key, Entry>;
+
+  void Touch(Entry & entry);
+  void EraseEntry(TEntries::iterator it);
+  void CheckLimits();
+
+  bool Spill(Entry & entry);
+  bool Restore(Entry & entry);
+
+  Params const m_params;
+
+  TEntries m_entries;
+  // The most recently used tiles go first.
+  std::list<Key> m_lru;
+
+  size_t m_memorySize = 0;
+  // Reports |m_memorySize| to base::MemoryCounters.
+  base::MemoryCounter m_memory{"drape.tile_geometry_cache"};
+  size_t m_diskSize = 0;
+  uint64_t m_nextFileIndex = 0;
+
+  DISALLOW_COPY_AND_MOVE(TileGeometryCache);
+};
+}  // namespace df
@@ -24,6 +24,13 @@ TileInfo::TileInfo(drape_ptr<EngineContext> && engineContext)
   , m_isCanceled(false)
 {}
 
+TileInfo::~TileInfo()
+{
+  // The second stage of reading is cancelled, so the tile is finished here.
+  if (!m_deferredShapes.empty())
+    m_context->EndReadTile();
+}
+
 m2::RectD TileInfo::GetGlobalRect() const
 {
   return GetTileKey().GetGlobalRect();
@@ -73,13 +80,45 @@ void TileInfo::ReadFeatures(MapDataProvider const & model)
     RuleDrawer drawer(std::bind(&TileInfo::InitStylist, this, deviceLang, _1, _2),
                       std::bind(&TileInfo::IsCancelled, this),
                       model.m_isCountryLoadedByName, make_ref(m_context));
-    model.ReadFeatures(std::bind<void>(std::ref(drawer), _1), m_featureInfo);
+    model.ReadFeatures([&drawer](FeatureType const & ft)
+    {
+      drawer(ft);
+      // Features are loaded before they are passed to the drawer, so
+      // reading is interrupted here not to load the rest features of
+      // a cancelled tile.
+      if (drawer.WasCancelled())
+        MYTHROW(ReadCanceledException, ());
+    }, m_featureInfo);
+    m_deferredShapes = drawer.MoveDeferredShapes();
+  }
+
+  if (!m_deferredShapes.empty())
+  {
+    // Flat geometry of the tile is shown until 3d buildings are generated.
+    m_context->FlushTileGeometry();
+    ReleaseReadTile.release();
   }
 #if defined(DRAPE_MEASURER) && defined(TILES_STATISTIC)
   DrapeMeasurer::Instance().EndTileReading();
 #endif
 }
 
+void TileInfo::GenerateDeferredShapes()
+{
+  ASSERT(!m_deferredShapes.empty(), ());
+  TMapShapes shapes;
+  shapes.swap(m_deferredShapes);
+
+  MY_SCOPE_GUARD(ReleaseReadTile, std::bind(&EngineContext::EndReadTile, m_context.get()));
+
+  for (auto const & shape : shapes)
+  {
+    CheckCanceled();
+    shape->Prepare(m_context->GetTextureManager());
+  }
+  m_context->Flush(std::move(shapes));
+}
+
 void TileInfo::Cancel()
 {
   m_isCanceled = true;
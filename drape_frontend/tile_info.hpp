@@ -26,13 +26,21 @@ public:
   DECLARE_EXCEPTION(ReadCanceledException, RootException);
 
   TileInfo(drape_ptr<EngineContext> && engineContext);
+  ~TileInfo();
 
+  // The first stage of reading. Shapes of 3d buildings are deferred, so the tile
+  // isn't finished if they exist.
   void ReadFeatures(MapDataProvider const & model);
+  // The second stage of reading, it generates the deferred shapes on the workers
+  // dedicated to it and finishes the tile.
+  void GenerateDeferredShapes();
+  bool HasDeferredShapes() const { return !m_deferredShapes.empty(); }
   void Cancel();
   bool IsCancelled() const;
 
   m2::RectD GetGlobalRect() const;
   TileKey const & GetTileKey() const { return m_context->GetTileKey(); }
+  bool IsPrefetch() const { return m_context->IsPrefetch(); }
   bool operator <(TileInfo const & other) const { return GetTileKey() < other.GetTileKey(); }
 
 private:
@@ -46,6 +54,7 @@ private:
 private:
   drape_ptr<EngineContext> m_context;
   std::vector<FeatureID> m_featureInfo;
+  TMapShapes m_deferredShapes;
   std::atomic<bool> m_isCanceled;
   std::set<MwmSet::MwmId> m_mwms;
 
@@ -56,10 +56,21 @@ dp::BindingInfo const & GetTrafficStaticBindingInfo()
   static unique_ptr<dp::BindingInfo> s_info;
   if (s_info == nullptr)
   {
-    dp::BindingFiller<TrafficStaticVertex> filler(3);
+    dp::BindingFiller<TrafficStaticVertex> filler(2);
     filler.FillDecl<TrafficStaticVertex::TPosition>("a_position");
     filler.FillDecl<TrafficStaticVertex::TNormal>("a_normal");
-    filler.FillDecl<TrafficStaticVertex::TTexCoord>("a_colorTexCoord");
+    s_info.reset(new dp::BindingInfo(filler.m_info));
+  }
+  return *s_info;
+}
+
+dp::BindingInfo const & GetTrafficDynamicBindingInfo()
+{
+  static unique_ptr<dp::BindingInfo> s_info;
+  if (s_info == nullptr)
+  {
+    dp::BindingFiller<TrafficDynamicVertex> filler(1, TrafficHandle::GetDynamicStreamID());
+    filler.FillDecl<TrafficDynamicVertex::TTexCoord>("a_colorTexCoord");
     s_info.reset(new dp::BindingInfo(filler.m_info));
   }
   return *s_info;
@@ -70,41 +81,180 @@ dp::BindingInfo const & GetTrafficLineStaticBindingInfo()
   static unique_ptr<dp::BindingInfo> s_info;
   if (s_info == nullptr)
   {
-    dp::BindingFiller<TrafficLineStaticVertex> filler(2);
+    dp::BindingFiller<TrafficLineStaticVertex> filler(1);
     filler.FillDecl<TrafficLineStaticVertex::TPosition>("a_position");
-    filler.FillDecl<TrafficLineStaticVertex::TTexCoord>("a_colorTexCoord");
+    s_info.reset(new dp::BindingInfo(filler.m_info));
+  }
+  return *s_info;
+}
+
+dp::BindingInfo const & GetTrafficLineDynamicBindingInfo()
+{
+  static unique_ptr<dp::BindingInfo> s_info;
+  if (s_info == nullptr)
+  {
+    dp::BindingFiller<TrafficLineDynamicVertex> filler(1, TrafficHandle::GetDynamicStreamID());
+    filler.FillDecl<TrafficLineDynamicVertex::TTexCoord>("a_colorTexCoord");
     s_info.reset(new dp::BindingInfo(filler.m_info));
   }
   return *s_info;
 }
 
 void SubmitStaticVertex(glsl::vec3 const & pivot, glsl::vec2 const & normal, float side,
-                        float offsetFromStart, glsl::vec4 const & texCoord,
-                        vector<TrafficStaticVertex> & staticGeom)
+                        float offsetFromStart, vector<TrafficStaticVertex> & staticGeom)
 {
-  staticGeom.emplace_back(pivot, TrafficStaticVertex::TNormal(normal, side, offsetFromStart), texCoord);
+  staticGeom.emplace_back(pivot, TrafficStaticVertex::TNormal(normal, side, offsetFromStart));
 }
 
 void GenerateCapTriangles(glsl::vec3 const & pivot, vector<glsl::vec2> const & normals,
-                          dp::TextureManager::ColorRegion const & colorRegion,
                           vector<TrafficStaticVertex> & staticGeometry)
 {
   float const kEps = 1e-5;
-  glsl::vec4 const uv = glsl::vec4(glsl::ToVec2(colorRegion.GetTexRect().Center()), 0.0f, 0.0f);
   size_t const trianglesCount = normals.size() / 3;
   for (size_t j = 0; j < trianglesCount; j++)
   {
     SubmitStaticVertex(pivot, normals[3 * j],
-                       glsl::length(normals[3 * j]) < kEps ? 0.0f : 1.0f, 0.0f, uv, staticGeometry);
+                       glsl::length(normals[3 * j]) < kEps ? 0.0f : 1.0f, 0.0f, staticGeometry);
     SubmitStaticVertex(pivot, normals[3 * j + 1],
-                       glsl::length(normals[3 * j + 1]) < kEps ? 0.0f : 1.0f, 0.0f, uv, staticGeometry);
+                       glsl::length(normals[3 * j + 1]) < kEps ? 0.0f : 1.0f, 0.0f, staticGeometry);
     SubmitStaticVertex(pivot, normals[3 * j + 2],
-                       glsl::length(normals[3 * j + 2]) < kEps ? 0.0f : 1.0f, 0.0f, uv, staticGeometry);
+                       glsl::length(normals[3 * j + 2]) < kEps ? 0.0f : 1.0f, 0.0f, staticGeometry);
   }
 }
 
+// Returns true when the segment is generated for |speedGroup|.
+bool IsGenerated(traffic::SpeedGroup speedGroup)
+{
+  // We do not generate geometry for unknown segments.
+  return speedGroup != traffic::SpeedGroup::Unknown;
+}
+
+bool HasSameVisibleSegments(traffic::TrafficInfo::Coloring const & lhs,
+                            traffic::TrafficInfo::Coloring const & rhs)
+{
+  size_t lhsCount = 0;
+  for (auto const & p : lhs)
+  {
+    if (!IsGenerated(p.second))
+      continue;
+    ++lhsCount;
+    auto const it = rhs.find(p.first);
+    if (it == rhs.end() || !IsGenerated(it->second))
+      return false;
+  }
+
+  size_t const rhsCount = count_if(rhs.begin(), rhs.end(),
+                                   [](pair<traffic::TrafficInfo::RoadSegmentId,
+                                           traffic::SpeedGroup> const & p)
+  {
+    return IsGenerated(p.second);
+  });
+  return lhsCount == rhsCount;
+}
 } // namespace
 
+TrafficHandle::TrafficHandle(traffic::TrafficInfo::RoadSegmentId const & segmentId, bool isLine,
+                             uint32_t verticesCount, uint32_t bodyVerticesCount,
+                             traffic::SpeedGroup speedGroup, TrafficTexCoords const & texCoords)
+  : TBase(FeatureID(), dp::Anchor::Center, 0 /* priority */, false /* isBillboard */)
+  , m_segmentId(segmentId)
+  , m_isLine(isLine)
+  , m_bodyVerticesCount(bodyVerticesCount)
+  , m_speedGroup(speedGroup)
+  , m_needUpdate(false)
+{
+  ASSERT_LESS_OR_EQUAL(bodyVerticesCount, verticesCount, ());
+  size_t const componentsCount = m_isLine ? 2 : 4;
+  m_buffer.resize(verticesCount * componentsCount);
+  FillBuffer(texCoords);
+}
+
+void TrafficHandle::GetAttributeMutation(ref_ptr<dp::AttributeBufferMutator> mutator) const
+{
+  if (!m_needUpdate)
+    return;
+
+  TOffsetNode const & node = GetOffsetNode(GetDynamicStreamID());
+  ASSERT(node.first.GetElementSize() * node.second.m_count == m_buffer.size() * sizeof(float), ());
+
+  uint32_t const byteCount = static_cast<uint32_t>(m_buffer.size() * sizeof(float));
+  void * buffer = mutator->AllocateMutationBuffer(byteCount);
+  memcpy(buffer, m_buffer.data(), byteCount);
+
+  dp::MutateNode mutateNode;
+  mutateNode.m_region = node.second;
+  mutateNode.m_data = make_ref(buffer);
+  mutator->AddMutation(node.first, mutateNode);
+
+  m_needUpdate = false;
+}
+
+bool TrafficHandle::IndexesRequired() const
+{
+  return false;
+}
+
+m2::RectD TrafficHandle::GetPixelRect(ScreenBase const & /* screen */, bool /* perspective */) const
+{
+  return m2::RectD();
+}
+
+void TrafficHandle::GetPixelShape(ScreenBase const & /* screen */, bool /* perspective */,
+                                  Rects & /* rects */) const
+{
+}
+
+void TrafficHandle::SetSpeedGroup(traffic::SpeedGroup speedGroup, TrafficTexCoords const & texCoords)
+{
+  ASSERT(IsGenerated(speedGroup), ());
+  m_speedGroup = speedGroup;
+  FillBuffer(texCoords);
+  m_needUpdate = true;
+}
+
+// static
+uint32_t TrafficHandle::GetDynamicStreamID()
+{
+  return 0x7F;
+}
+
+void TrafficHandle::FillBuffer(TrafficTexCoords const & texCoords)
+{
+  size_t const index = static_cast<size_t>(m_speedGroup);
+  ASSERT_LESS(index, texCoords.size(), ());
+  glsl::vec2 const & uv = texCoords[index];
+  if (m_isLine)
+  {
+    for (size_t i = 0; i < m_buffer.size(); i += 2)
+    {
+      m_buffer[i] = uv.x;
+      m_buffer[i + 1] = uv.y;
+    }
+    return;
+  }
+
+  // Every piece of the body consists of 6 vertices, the 2nd and the 3rd
+  // ones are at the ends of the piece (see GenerateSegment()). Caps have
+  // no arrows.
+  float const vOffset = kCoordVOffsets[index];
+  float const minU = kMinCoordU[index];
+  for (size_t i = 0; 4 * i < m_buffer.size(); ++i)
+  {
+    glsl::vec4 texCoord(uv, 0.0f, 0.0f);
+    if (i < m_bodyVerticesCount)
+    {
+      size_t const vertex = i % 6;
+      bool const isEnd = (vertex == 2 || vertex == 3 || vertex == 5);
+      texCoord.z = vOffset;
+      texCoord.w = isEnd ? minU : 1.0f;
+    }
+    m_buffer[4 * i] = texCoord.x;
+    m_buffer[4 * i + 1] = texCoord.y;
+    m_buffer[4 * i + 2] = texCoord.z;
+    m_buffer[4 * i + 3] = texCoord.w;
+  }
+}
+
 bool TrafficGenerator::m_simplifiedColorScheme = true;
 
 void TrafficGenerator::Init()
@@ -116,7 +266,9 @@ void TrafficGenerator::Init()
                                   kBatchSize, kBatchSize);
 
   m_providerLines.InitStream(0 /* stream index */, GetTrafficLineStaticBindingInfo(), nullptr);
+  m_providerLines.InitStream(1 /* stream index */, GetTrafficLineDynamicBindingInfo(), nullptr);
   m_providerTriangles.InitStream(0 /* stream index */, GetTrafficStaticBindingInfo(), nullptr);
+  m_providerTriangles.InitStream(1 /* stream index */, GetTrafficDynamicBindingInfo(), nullptr);
 }
 
 void TrafficGenerator::ClearGLDependentResources()
@@ -128,8 +280,7 @@ void TrafficGenerator::ClearGLDependentResources()
 void TrafficGenerator::FlushSegmentsGeometry(TileKey const & tileKey, TrafficSegmentsGeometry const & geom,
                                              ref_ptr<dp::TextureManager> textures)
 {
-  FillColorsCache(textures);
-  ASSERT(m_colorsCacheValid, ());
+  TrafficTexCoords const texCoords = GetTexCoords(textures);
   auto const texture = m_colorsCache[static_cast<size_t>(traffic::SpeedGroup::G0)].GetTexture();
 
   auto state = CreateGLState(gpu::TRAFFIC_PROGRAM, RenderState::GeometryLayer);
@@ -160,8 +311,8 @@ void TrafficGenerator::FlushSegmentsGeometry(TileKey const & tileKey, TrafficSeg
         auto segmentColoringIt = coloring.find(sid);
         if (segmentColoringIt != coloring.end())
         {
-          // We do not generate geometry for unknown segments.
-          if (segmentColoringIt->second == traffic::SpeedGroup::Unknown)
+          traffic::SpeedGroup const speedGroup = segmentColoringIt->second;
+          if (!IsGenerated(speedGroup))
             continue;
 
           TrafficSegmentGeometry const & g = geomIt->second[i].second;
@@ -170,41 +321,46 @@ void TrafficGenerator::FlushSegmentsGeometry(TileKey const & tileKey, TrafficSeg
 
           float const depth = kDepths[static_cast<size_t>(g.m_roadClass)];
 
-          ASSERT(m_colorsCacheValid, ());
-          dp::TextureManager::ColorRegion const & colorRegion =
-              m_colorsCache[static_cast<size_t>(segmentColoringIt->second)];
-          float const vOffset = kCoordVOffsets[static_cast<size_t>(segmentColoringIt->second)];
-          float const minU = kMinCoordU[static_cast<size_t>(segmentColoringIt->second)];
-
           int width = 0;
           if (TrafficRenderer::CanBeRendereredAsLine(g.m_roadClass, tileKey.m_zoomLevel, width))
           {
             vector<TrafficLineStaticVertex> staticGeometry;
-            GenerateLineSegment(colorRegion, g.m_polyline, tileKey.GetGlobalRect().Center(), depth,
+            GenerateLineSegment(g.m_polyline, tileKey.GetGlobalRect().Center(), depth,
                                 staticGeometry);
             if (staticGeometry.empty())
               continue;
 
-            m_providerLines.Reset(static_cast<uint32_t>(staticGeometry.size()));
+            auto const verticesCount = static_cast<uint32_t>(staticGeometry.size());
+            drape_ptr<TrafficHandle> handle = make_unique_dp<TrafficHandle>(
+                sid, true /* isLine */, verticesCount, verticesCount, speedGroup, texCoords);
+
+            m_providerLines.Reset(verticesCount);
             m_providerLines.UpdateStream(0 /* stream index */, make_ref(staticGeometry.data()));
+            m_providerLines.UpdateStream(1 /* stream index */, make_ref(handle->GetBuffer()));
 
             dp::GLState curLineState = lineState;
             curLineState.SetLineWidth(width);
-            batcher->InsertLineStrip(curLineState, make_ref(&m_providerLines));
+            batcher->InsertLineStrip(curLineState, make_ref(&m_providerLines), move(handle));
           }
           else
           {
             vector<TrafficStaticVertex> staticGeometry;
+            uint32_t bodyVerticesCount = 0;
             bool const generateCaps =
                 (tileKey.m_zoomLevel > kGenerateCapsZoomLevel[static_cast<uint32_t>(g.m_roadClass)]);
-            GenerateSegment(colorRegion, g.m_polyline, tileKey.GetGlobalRect().Center(),
-                            generateCaps, depth, vOffset, minU, staticGeometry);
+            GenerateSegment(g.m_polyline, tileKey.GetGlobalRect().Center(), generateCaps, depth,
+                            staticGeometry, bodyVerticesCount);
             if (staticGeometry.empty())
               continue;
 
-            m_providerTriangles.Reset(static_cast<uint32_t>(staticGeometry.size()));
+            auto const verticesCount = static_cast<uint32_t>(staticGeometry.size());
+            drape_ptr<TrafficHandle> handle = make_unique_dp<TrafficHandle>(
+                sid, false /* isLine */, verticesCount, bodyVerticesCount, speedGroup, texCoords);
+
+            m_providerTriangles.Reset(verticesCount);
             m_providerTriangles.UpdateStream(0 /* stream index */, make_ref(staticGeometry.data()));
-            batcher->InsertTriangleList(state, make_ref(&m_providerTriangles));
+            m_providerTriangles.UpdateStream(1 /* stream index */, make_ref(handle->GetBuffer()));
+            batcher->InsertTriangleList(state, make_ref(&m_providerTriangles), move(handle));
           }
         }
       }
@@ -217,10 +373,35 @@ void TrafficGenerator::FlushSegmentsGeometry(TileKey const & tileKey, TrafficSeg
   GLFunctions::glFlush();
 }
 
-void TrafficGenerator::UpdateColoring(TrafficSegmentsColoring const & coloring)
+bool TrafficGenerator::UpdateColoring(TrafficSegmentsColoring const & coloring)
 {
+  bool canBeRecolored = true;
   for (auto const & p : coloring)
-    m_coloring[p.first] = p.second;
+  {
+    auto it = m_coloring.find(p.first);
+    if (it == m_coloring.end())
+    {
+      canBeRecolored = false;
+      m_coloring.insert(p);
+      continue;
+    }
+
+    if (canBeRecolored && !HasSameVisibleSegments(it->second, p.second))
+      canBeRecolored = false;
+    it->second = p.second;
+  }
+  return canBeRecolored;
+}
+
+TrafficTexCoords TrafficGenerator::GetTexCoords(ref_ptr<dp::TextureManager> textures)
+{
+  FillColorsCache(textures);
+  ASSERT(m_colorsCacheValid, ());
+
+  TrafficTexCoords texCoords;
+  for (size_t i = 0; i < texCoords.size(); ++i)
+    texCoords[i] = glsl::ToVec2(m_colorsCache[i].GetTexRect().Center());
+  return texCoords;
 }
 
 void TrafficGenerator::ClearCache()
@@ -250,10 +431,10 @@ void TrafficGenerator::FlushGeometry(TrafficBatcherKey const & key, dp::GLState
   m_flushRenderDataFn(move(renderData));
 }
 
-void TrafficGenerator::GenerateSegment(dp::TextureManager::ColorRegion const & colorRegion,
-                                       m2::PolylineD const & polyline, m2::PointD const & tileCenter,
-                                       bool generateCaps, float depth, float vOffset, float minU,
-                                       vector<TrafficStaticVertex> & staticGeometry)
+void TrafficGenerator::GenerateSegment(m2::PolylineD const & polyline, m2::PointD const & tileCenter,
+                                       bool generateCaps, float depth,
+                                       vector<TrafficStaticVertex> & staticGeometry,
+                                       uint32_t & bodyVerticesCount)
 {
   vector<m2::PointD> const & path = polyline.GetPoints();
   ASSERT_GREATER(path.size(), 1, ());
@@ -267,8 +448,6 @@ void TrafficGenerator::GenerateSegment(dp::TextureManager::ColorRegion const & c
   glsl::vec2 lastPoint, lastTangent, lastLeftNormal, lastRightNormal;
   bool firstFilled = false;
 
-  glsl::vec4 const uvStart = glsl::vec4(glsl::ToVec2(colorRegion.GetTexRect().Center()), vOffset, 1.0f);
-  glsl::vec4 const uvEnd = glsl::vec4(uvStart.x, uvStart.y, uvStart.z, minU);
   for (size_t i = 1; i < path.size(); ++i)
   {
     if (path[i].EqualDxDy(path[i - 1], 1.0E-5))
@@ -296,14 +475,16 @@ void TrafficGenerator::GenerateSegment(dp::TextureManager::ColorRegion const & c
 
     glsl::vec3 const startPivot = glsl::vec3(p1, depth);
     glsl::vec3 const endPivot = glsl::vec3(p2, depth);
-    SubmitStaticVertex(startPivot, rightNormal, -1.0f, 0.0f, uvStart, staticGeometry);
-    SubmitStaticVertex(startPivot, leftNormal, 1.0f, 0.0f, uvStart, staticGeometry);
-    SubmitStaticVertex(endPivot, rightNormal, -1.0f, maskSize, uvEnd, staticGeometry);
-    SubmitStaticVertex(endPivot, rightNormal, -1.0f, maskSize, uvEnd, staticGeometry);
-    SubmitStaticVertex(startPivot, leftNormal, 1.0f, 0.0f, uvStart, staticGeometry);
-    SubmitStaticVertex(endPivot, leftNormal, 1.0f, maskSize, uvEnd, staticGeometry);
+    SubmitStaticVertex(startPivot, rightNormal, -1.0f, 0.0f, staticGeometry);
+    SubmitStaticVertex(startPivot, leftNormal, 1.0f, 0.0f, staticGeometry);
+    SubmitStaticVertex(endPivot, rightNormal, -1.0f, maskSize, staticGeometry);
+    SubmitStaticVertex(endPivot, rightNormal, -1.0f, maskSize, staticGeometry);
+    SubmitStaticVertex(startPivot, leftNormal, 1.0f, 0.0f, staticGeometry);
+    SubmitStaticVertex(endPivot, leftNormal, 1.0f, maskSize, staticGeometry);
   }
 
+  bodyVerticesCount = static_cast<uint32_t>(staticGeometry.size());
+
   // Generate caps.
   if (generateCaps && firstFilled)
   {
@@ -312,17 +493,16 @@ void TrafficGenerator::GenerateSegment(dp::TextureManager::ColorRegion const & c
     normals.reserve(kAverageCapSize);
     GenerateCapNormals(dp::RoundCap, firstLeftNormal, firstRightNormal, -firstTangent,
                        1.0f, true /* isStart */, normals, kSegmentsCount);
-    GenerateCapTriangles(glsl::vec3(firstPoint, depth), normals, colorRegion, staticGeometry);
+    GenerateCapTriangles(glsl::vec3(firstPoint, depth), normals, staticGeometry);
 
     normals.clear();
     GenerateCapNormals(dp::RoundCap, lastLeftNormal, lastRightNormal, lastTangent,
                        1.0f, false /* isStart */, normals, kSegmentsCount);
-    GenerateCapTriangles(glsl::vec3(lastPoint, depth), normals, colorRegion, staticGeometry);
+    GenerateCapTriangles(glsl::vec3(lastPoint, depth), normals, staticGeometry);
   }
 }
 
-void TrafficGenerator::GenerateLineSegment(dp::TextureManager::ColorRegion const & colorRegion,
-                                           m2::PolylineD const & polyline, m2::PointD const & tileCenter,
+void TrafficGenerator::GenerateLineSegment(m2::PolylineD const & polyline, m2::PointD const & tileCenter,
                                            float depth, vector<TrafficLineStaticVertex> & staticGeometry)
 {
   vector<m2::PointD> const & path = polyline.GetPoints();
@@ -332,11 +512,10 @@ void TrafficGenerator::GenerateLineSegment(dp::TextureManager::ColorRegion const
   staticGeometry.reserve(staticGeometry.size() + kAverageSize);
 
   // Build geometry.
-  glsl::vec2 const uv = glsl::ToVec2(colorRegion.GetTexRect().Center());
   for (size_t i = 0; i < path.size(); ++i)
   {
     glsl::vec2 const p = glsl::ToVec2(MapShape::ConvertToLocal(path[i], tileCenter, kShapeCoordScalar));
-    staticGeometry.emplace_back(glsl::vec3(p, depth), uv);
+    staticGeometry.emplace_back(glsl::vec3(p, depth));
   }
 }
 
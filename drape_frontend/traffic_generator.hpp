@@ -7,6 +7,7 @@
 
 #include "drape/color.hpp"
 #include "drape/glsl_types.hpp"
+#include "drape/overlay_handle.hpp"
 #include "drape/render_bucket.hpp"
 #include "drape/texture_manager.hpp"
 
@@ -93,37 +94,93 @@ struct TrafficStaticVertex
 {
   using TPosition = glsl::vec3;
   using TNormal = glsl::vec4;
-  using TTexCoord = glsl::vec4;
 
   TrafficStaticVertex() = default;
-  TrafficStaticVertex(TPosition const & position, TNormal const & normal,
-                      TTexCoord const & colorTexCoord)
+  TrafficStaticVertex(TPosition const & position, TNormal const & normal)
     : m_position(position)
     , m_normal(normal)
-    , m_colorTexCoord(colorTexCoord)
   {}
 
   TPosition m_position;
   TNormal m_normal;
+};
+
+struct TrafficDynamicVertex
+{
+  using TTexCoord = glsl::vec4;
+
+  TrafficDynamicVertex() = default;
+  explicit TrafficDynamicVertex(TTexCoord const & colorTexCoord)
+    : m_colorTexCoord(colorTexCoord)
+  {}
+
   TTexCoord m_colorTexCoord;
 };
 
 struct TrafficLineStaticVertex
 {
   using TPosition = glsl::vec3;
-  using TTexCoord = glsl::vec2;
 
   TrafficLineStaticVertex() = default;
-  TrafficLineStaticVertex(TPosition const & position, TTexCoord const & colorTexCoord)
+  explicit TrafficLineStaticVertex(TPosition const & position)
     : m_position(position)
-    , m_colorTexCoord(colorTexCoord)
   {}
 
   TPosition m_position;
+};
+
+struct TrafficLineDynamicVertex
+{
+  using TTexCoord = glsl::vec2;
+
+  TrafficLineDynamicVertex() = default;
+  explicit TrafficLineDynamicVertex(TTexCoord const & colorTexCoord)
+    : m_colorTexCoord(colorTexCoord)
+  {}
+
   TTexCoord m_colorTexCoord;
 };
 
-using TrafficTexCoords = unordered_map<size_t, glsl::vec2>;
+// Centers of the color regions of the speed groups.
+using TrafficTexCoords = array<glsl::vec2, static_cast<size_t>(traffic::SpeedGroup::Count)>;
+
+// Keeps the colors of a traffic segment in the dynamic stream of its bucket.
+// The geometry of a segment doesn't depend on its speed group, so new
+// coloring is applied by rewriting of the colors only.
+class TrafficHandle : public dp::OverlayHandle
+{
+  using TBase = dp::OverlayHandle;
+
+public:
+  // |bodyVerticesCount| is the number of the vertices of the segment
+  // without caps.
+  TrafficHandle(traffic::TrafficInfo::RoadSegmentId const & segmentId, bool isLine,
+                uint32_t verticesCount, uint32_t bodyVerticesCount,
+                traffic::SpeedGroup speedGroup, TrafficTexCoords const & texCoords);
+
+  void GetAttributeMutation(ref_ptr<dp::AttributeBufferMutator> mutator) const override;
+  bool IndexesRequired() const override;
+  m2::RectD GetPixelRect(ScreenBase const & screen, bool perspective) const override;
+  void GetPixelShape(ScreenBase const & screen, bool perspective, Rects & rects) const override;
+
+  void SetSpeedGroup(traffic::SpeedGroup speedGroup, TrafficTexCoords const & texCoords);
+
+  traffic::TrafficInfo::RoadSegmentId const & GetSegmentId() const { return m_segmentId; }
+  traffic::SpeedGroup GetSpeedGroup() const { return m_speedGroup; }
+  void * GetBuffer() { return m_buffer.data(); }
+
+  static uint32_t GetDynamicStreamID();
+
+private:
+  void FillBuffer(TrafficTexCoords const & texCoords);
+
+  traffic::TrafficInfo::RoadSegmentId const m_segmentId;
+  bool const m_isLine;
+  uint32_t const m_bodyVerticesCount;
+  traffic::SpeedGroup m_speedGroup;
+  vector<float> m_buffer;
+  mutable bool m_needUpdate;
+};
 
 class TrafficGenerator final
 {
@@ -132,8 +189,8 @@ public:
 
   explicit TrafficGenerator(TFlushRenderDataFn flushFn)
     : m_flushRenderDataFn(flushFn)
-    , m_providerTriangles(1 /* stream count */, 0 /* vertices count*/)
-    , m_providerLines(1 /* stream count */, 0 /* vertices count*/)
+    , m_providerTriangles(2 /* stream count */, 0 /* vertices count*/)
+    , m_providerLines(2 /* stream count */, 0 /* vertices count*/)
   {}
 
   void Init();
@@ -141,7 +198,11 @@ public:
 
   void FlushSegmentsGeometry(TileKey const & tileKey, TrafficSegmentsGeometry const & geom,
                              ref_ptr<dp::TextureManager> textures);
-  void UpdateColoring(TrafficSegmentsColoring const & coloring);
+  // Returns true when the segments of the updated mwms keep their
+  // visibility, so the generated geometry may be recolored through
+  // TrafficHandle instead of the regeneration.
+  bool UpdateColoring(TrafficSegmentsColoring const & coloring);
+  TrafficTexCoords GetTexCoords(ref_ptr<dp::TextureManager> textures);
 
   void ClearCache();
   void ClearCache(MwmSet::MwmId const & mwmId);
@@ -180,12 +241,10 @@ private:
     }
   };
 
-  void GenerateSegment(dp::TextureManager::ColorRegion const & colorRegion,
-                       m2::PolylineD const & polyline, m2::PointD const & tileCenter,
-                       bool generateCaps, float depth, float vOffset, float minU,
-                       vector<TrafficStaticVertex> & staticGeometry);
-  void GenerateLineSegment(dp::TextureManager::ColorRegion const & colorRegion,
-                           m2::PolylineD const & polyline, m2::PointD const & tileCenter, float depth,
+  void GenerateSegment(m2::PolylineD const & polyline, m2::PointD const & tileCenter,
+                       bool generateCaps, float depth, vector<TrafficStaticVertex> & staticGeometry,
+                       uint32_t & bodyVerticesCount);
+  void GenerateLineSegment(m2::PolylineD const & polyline, m2::PointD const & tileCenter, float depth,
                            vector<TrafficLineStaticVertex> & staticGeometry);
   void FillColorsCache(ref_ptr<dp::TextureManager> textures);
 
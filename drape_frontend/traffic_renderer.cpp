@@ -108,6 +108,27 @@ void TrafficRenderer::AddRenderData(ref_ptr<dp::GpuProgramManager> mng, TrafficR
   rd.m_bucket->GetBuffer()->Build(program);
 }
 
+void TrafficRenderer::UpdateTraffic(TrafficSegmentsColoring const & coloring,
+                                    TrafficTexCoords const & texCoords)
+{
+  for (TrafficRenderData & renderData : m_renderData)
+  {
+    auto coloringIt = coloring.find(renderData.m_mwmId);
+    if (coloringIt == coloring.end())
+      continue;
+
+    auto const & segmentsColoring = coloringIt->second;
+    for (size_t i = 0; i < renderData.m_bucket->GetOverlayHandlesCount(); ++i)
+    {
+      ref_ptr<TrafficHandle> handle =
+          renderData.m_bucket->GetOverlayHandle(i).downcast<TrafficHandle>();
+      auto it = segmentsColoring.find(handle->GetSegmentId());
+      if (it != segmentsColoring.end() && it->second != handle->GetSpeedGroup())
+        handle->SetSpeedGroup(it->second, texCoords);
+    }
+  }
+}
+
 void TrafficRenderer::OnUpdateViewport(CoverageResult const & coverage, int currentZoomLevel,
                                        buffer_vector<TileKey, 8> const & tilesToDelete)
 {
@@ -26,6 +26,9 @@ public:
                      ref_ptr<dp::GpuProgramManager> mng,
                      dp::UniformValuesStorage const & commonUniforms);
 
+  // Recolors the generated segments of the mwms of |coloring|.
+  void UpdateTraffic(TrafficSegmentsColoring const & coloring, TrafficTexCoords const & texCoords);
+
   bool HasRenderData() const { return !m_renderData.empty(); }
 
   void ClearGLDependentResources();
@@ -9,6 +9,7 @@
 #include "base/macros.hpp"
 
 #include "std/algorithm.hpp"
+#include "std/future.hpp"
 #include "std/random.hpp"
 #include "std/sstream.hpp"
 
@@ -101,6 +102,11 @@ string DebugPrint(xml_document const & doc)
 
 namespace osm
 {
+// static
+size_t constexpr ChangesetWrapper::kMaxBatchSize;
+// static
+size_t constexpr ChangesetWrapper::kMaxParallelRequests;
+
 ChangesetWrapper::ChangesetWrapper(TKeySecret const & keySecret,
                                    ServerApi06::TKeyValueTags const & comments) noexcept
   : m_changesetComments(comments), m_api(OsmOAuth::ServerAuth(keySecret))
@@ -127,6 +133,20 @@ ChangesetWrapper::~ChangesetWrapper()
 void ChangesetWrapper::LoadXmlFromOSM(ms::LatLon const & ll, pugi::xml_document & doc,
                                       double radiusInMeters)
 {
+  if (radiusInMeters == 1.0)
+  {
+    auto const it = m_prefetched.find(make_pair(ll.lat, ll.lon));
+    if (it != m_prefetched.end())
+    {
+      string const xml = move(it->second);
+      m_prefetched.erase(it);
+      if (pugi::status_ok == doc.load(xml.c_str()).status)
+        return;
+      MYTHROW(OsmXmlParseException,
+              ("Can't parse OSM server response for GetXmlFeaturesAtLatLon request", xml));
+    }
+  }
+
   auto const response = m_api.GetXmlFeaturesAtLatLon(ll.lat, ll.lon, radiusInMeters);
   if (response.first != OsmOAuth::HTTP::OK)
     MYTHROW(HttpErrorException, ("HTTP error", response, "with GetXmlFeaturesAtLatLon", ll));
@@ -230,13 +250,75 @@ XMLFeature ChangesetWrapper::GetMatchingAreaFeatureFromOSM(vector<m2::PointD> co
   MYTHROW(OsmObjectWasDeletedException, ("OSM does not have any matching way for feature"));
 }
 
-void ChangesetWrapper::Create(XMLFeature node)
+void ChangesetWrapper::PrefetchNodes(vector<m2::PointD> const & points)
+{
+  vector<ms::LatLon> lls;
+  for (auto const & point : points)
+  {
+    ms::LatLon const ll = MercatorBounds::ToLatLon(point);
+    if (m_prefetched.count(make_pair(ll.lat, ll.lon)) == 0)
+      lls.push_back(ll);
+  }
+  sort(lls.begin(), lls.end(), [](ms::LatLon const & a, ms::LatLon const & b)
+  {
+    return make_pair(a.lat, a.lon) < make_pair(b.lat, b.lon);
+  });
+  lls.erase(unique(lls.begin(), lls.end(), [](ms::LatLon const & a, ms::LatLon const & b)
+  {
+    return a.lat == b.lat && a.lon == b.lon;
+  }), lls.end());
+
+  for (size_t first = 0; first < lls.size(); first += kMaxParallelRequests)
+  {
+    size_t const last = min(first + kMaxParallelRequests, lls.size());
+    vector<future<OsmOAuth::Response>> responses;
+    for (size_t i = first; i < last; ++i)
+    {
+      ms::LatLon const ll = lls[i];
+      responses.push_back(async(launch::async, [this, ll]()
+      {
+        return m_api.GetXmlFeaturesAtLatLon(ll.lat, ll.lon);
+      }));
+    }
+
+    for (size_t i = first; i < last; ++i)
+    {
+      try
+      {
+        auto response = responses[i - first].get();
+        if (response.first == OsmOAuth::HTTP::OK)
+          m_prefetched[make_pair(lls[i].lat, lls[i].lon)] = move(response.second);
+      }
+      catch (std::exception const & ex)
+      {
+        LOG(LWARNING, ("Can't prefetch OSM data at", lls[i], ex.what()));
+      }
+    }
+  }
+}
+
+void ChangesetWrapper::SetChangesetId(XMLFeature & node)
 {
   if (m_changesetId == kInvalidChangesetId)
     m_changesetId = m_api.CreateChangeSet(m_changesetComments);
 
   // Changeset id should be updated for every OSM server commit.
   node.SetAttribute("changeset", strings::to_string(m_changesetId));
+}
+
+void ChangesetWrapper::UploadElement(Action action, XMLFeature const & node)
+{
+  switch (action)
+  {
+  case Action::Create: Create(node); break;
+  case Action::Modify: Modify(node); break;
+  case Action::Delete: Delete(node); break;
+  }
+}
+
+void ChangesetWrapper::Create(XMLFeature node)
+{
+  SetChangesetId(node);
   // TODO(AlexZ): Think about storing/logging returned OSM ids.
   UNUSED_VALUE(m_api.CreateElement(node));
   m_created_types[GetTypeForFeature(node)]++;
@@ -244,26 +326,106 @@ void ChangesetWrapper::Create(XMLFeature node)
 
 void ChangesetWrapper::Modify(XMLFeature node)
 {
-  if (m_changesetId == kInvalidChangesetId)
-    m_changesetId = m_api.CreateChangeSet(m_changesetComments);
-
-  // Changeset id should be updated for every OSM server commit.
-  node.SetAttribute("changeset", strings::to_string(m_changesetId));
+  SetChangesetId(node);
   m_api.ModifyElement(node);
   m_modified_types[GetTypeForFeature(node)]++;
 }
 
 void ChangesetWrapper::Delete(XMLFeature node)
 {
-  if (m_changesetId == kInvalidChangesetId)
-    m_changesetId = m_api.CreateChangeSet(m_changesetComments);
-
-  // Changeset id should be updated for every OSM server commit.
-  node.SetAttribute("changeset", strings::to_string(m_changesetId));
+  SetChangesetId(node);
   m_api.DeleteElement(node);
   m_deleted_types[GetTypeForFeature(node)]++;
 }
 
+void ChangesetWrapper::AddToBatch(Action action, XMLFeature const & node)
+{
+  m_batch.emplace_back(action, node);
+}
+
+void ChangesetWrapper::AddCreateToBatch(XMLFeature node) { AddToBatch(Action::Create, node); }
+
+void ChangesetWrapper::AddModifyToBatch(XMLFeature node) { AddToBatch(Action::Modify, node); }
+
+void ChangesetWrapper::AddDeleteToBatch(XMLFeature node) { AddToBatch(Action::Delete, node); }
+
+string ChangesetWrapper::MakeOsmChange() const
+{
+  pugi::xml_document doc;
+  auto root = doc.append_child("osmChange");
+  root.append_attribute("version") = "0.6";
+  root.append_attribute("generator") = "MAPS.ME";
+
+  string const changeset = strings::to_string(m_changesetId);
+  int64_t placeholderId = 0;
+  for (auto const & item : m_batch)
+  {
+    // Consecutive elements with the same action share a block.
+    char const * name = item.first == Action::Create
+                            ? "create"
+                            : (item.first == Action::Modify ? "modify" : "delete");
+    auto block = root.last_child();
+    if (strcmp(block.name(), name) != 0)
+      block = root.append_child(name);
+
+    XMLFeature node = item.second;
+    node.SetAttribute("changeset", changeset);
+    // Created elements of a diff are referenced by negative placeholder ids.
+    if (item.first == Action::Create)
+      node.SetAttribute("id", strings::to_string(--placeholderId));
+    CHECK(node.AttachToParentNode(block), ());
+  }
+
+  ostringstream stream;
+  doc.save(stream, "  ");
+  return stream.str();
+}
+
+vector<string> ChangesetWrapper::FlushBatch()
+{
+  vector<string> errors(m_batch.size());
+  if (m_batch.empty())
+    return errors;
+
+  try
+  {
+    if (m_changesetId == kInvalidChangesetId)
+      m_changesetId = m_api.CreateChangeSet(m_changesetComments);
+
+    m_api.UploadDiff(m_changesetId, MakeOsmChange());
+    for (auto const & item : m_batch)
+    {
+      auto & typeCount = item.first == Action::Create
+                             ? m_created_types
+                             : (item.first == Action::Modify ? m_modified_types : m_deleted_types);
+      typeCount[GetTypeForFeature(item.second)]++;
+    }
+    m_batch.clear();
+    return errors;
+  }
+  catch (RootException const & ex)
+  {
+    LOG(LWARNING, ("Diff upload of", m_batch.size(), "elements has failed:", ex.Msg()));
+  }
+
+  // One wrong element fails the whole diff, so the elements are uploaded one by one.
+  for (size_t i = 0; i < m_batch.size(); ++i)
+  {
+    try
+    {
+      UploadElement(m_batch[i].first, m_batch[i].second);
+    }
+    catch (RootException const & ex)
+    {
+      errors[i] = ex.Msg();
+      if (errors[i].empty())
+        errors[i] = ex.what();
+    }
+  }
+  m_batch.clear();
+  return errors;
+}
+
 string ChangesetWrapper::TypeCountToString(TTypeCount const & typeCount)
 {
   if (typeCount.empty())
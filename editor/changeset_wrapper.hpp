@@ -8,7 +8,9 @@
 #include "geometry/point2d.hpp"
 #include "geometry/rect2d.hpp"
 
+#include "std/map.hpp"
 #include "std/set.hpp"
+#include "std/utility.hpp"
 #include "std/vector.hpp"
 
 class FeatureType;
@@ -53,9 +55,46 @@ public:
   /// Throws exceptions from above list.
   void Delete(editor::XMLFeature node);
 
+  /// The same as Create(), Modify() and Delete(), but elements are added to
+  /// the batch which is uploaded by one request of diff upload in FlushBatch().
+  void AddCreateToBatch(editor::XMLFeature node);
+  void AddModifyToBatch(editor::XMLFeature node);
+  void AddDeleteToBatch(editor::XMLFeature node);
+
+  size_t GetBatchSize() const { return m_batch.size(); }
+
+  /// Uploads the batch and clears it. The server rejects the whole diff when
+  /// some of its elements are wrong, in this case the elements are uploaded
+  /// one by one, so the wrong elements don't fail the others.
+  /// @returns errors of the elements of the batch, in the order of the batch,
+  /// empty strings for uploaded elements.
+  vector<string> FlushBatch();
+
+  /// Loads OSM data around |points| by several requests in parallel, so
+  /// GetMatchingNodeFeatureFromOSM() of the points doesn't wait for the server.
+  /// Data which failed to load is requested again by GetMatchingNodeFeatureFromOSM().
+  void PrefetchNodes(vector<m2::PointD> const & points);
+
   uint64_t GetChangesetId() const { return m_changesetId; }
 
+  static size_t constexpr kMaxBatchSize = 500;
+  static size_t constexpr kMaxParallelRequests = 4;
+
 private:
+  enum class Action
+  {
+    Create,
+    Modify,
+    Delete
+  };
+
+  using TLatLonKey = pair<double, double>;
+
+  void AddToBatch(Action action, editor::XMLFeature const & node);
+  void UploadElement(Action action, editor::XMLFeature const & node);
+  void SetChangesetId(editor::XMLFeature & node);
+  string MakeOsmChange() const;
+
   /// Unfortunately, pugi can't return xml_documents from methods.
   /// Throws exceptions from above list.
   void LoadXmlFromOSM(ms::LatLon const & ll, pugi::xml_document & doc, double radiusInMeters = 1.0);
@@ -66,6 +105,10 @@ private:
   static constexpr uint64_t kInvalidChangesetId = 0;
   uint64_t m_changesetId = kInvalidChangesetId;
 
+  vector<pair<Action, editor::XMLFeature>> m_batch;
+  /// Responses of PrefetchNodes() by lat lon of points.
+  map<TLatLonKey, string> m_prefetched;
+
   TTypeCount m_modified_types;
   TTypeCount m_created_types;
   TTypeCount m_deleted_types;
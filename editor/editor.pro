@@ -14,6 +14,7 @@ SOURCES += \
   editor_config.cpp \
   editor_notes.cpp \
   editor_storage.cpp \
+  edits_index.cpp \
   opening_hours_ui.cpp \
   osm_auth.cpp \
   osm_feature_matcher.cpp \
@@ -28,6 +29,7 @@ HEADERS += \
   editor_config.hpp \
   editor_notes.hpp \
   editor_storage.hpp \
+  edits_index.hpp \
   opening_hours_ui.hpp \
   osm_auth.hpp \
   osm_feature_matcher.hpp \
@@ -2,6 +2,7 @@
 
 #include "platform/platform.hpp"
 
+#include "coding/file_writer.hpp"
 #include "coding/internal/file_data.hpp"
 
 #include "base/logging.hpp"
@@ -13,8 +14,10 @@ using namespace pugi;
 namespace
 {
 char const * kEditorXMLFileName = "edits.xml";
+char const * kEditorIndexFileName = "edits.idx";
 
 string GetEditorFilePath() { return GetPlatform().WritablePathForFile(kEditorXMLFileName); }
+string GetEditorIndexFilePath() { return GetPlatform().WritablePathForFile(kEditorIndexFileName); }
 }  // namespace
 
 namespace editor
@@ -45,6 +48,39 @@ bool LocalStorage::Load(xml_document & doc)
 void LocalStorage::Reset()
 {
   my::DeleteFileX(GetEditorFilePath());
+  if (Platform::IsFileExistsByFullPath(GetEditorIndexFilePath()))
+    my::DeleteFileX(GetEditorIndexFilePath());
+}
+
+unique_ptr<EditsIndex> LocalStorage::SaveIndex(vector<uint8_t> const & index)
+{
+  auto const indexFilePath = GetEditorIndexFilePath();
+  auto const saved = my::WriteToTempAndRenameToFile(indexFilePath, [&index](string const & fileName) {
+    try
+    {
+      FileWriter writer(fileName);
+      writer.Write(index.data(), index.size());
+      return true;
+    }
+    catch (Writer::Exception const & e)
+    {
+      LOG(LWARNING, ("Can't write edits index", fileName, e.Msg()));
+    }
+    return false;
+  });
+
+  if (!saved)
+    return nullptr;
+
+  try
+  {
+    return make_unique<EditsIndex>(indexFilePath);
+  }
+  catch (RootException const & e)
+  {
+    LOG(LWARNING, ("Can't map edits index", indexFilePath, e.Msg()));
+  }
+  return nullptr;
 }
 
 // StorageMemory -----------------------------------------------------------------------------------
@@ -64,4 +100,9 @@ void InMemoryStorage::Reset()
 {
   m_doc.reset();
 }
+
+unique_ptr<EditsIndex> InMemoryStorage::SaveIndex(vector<uint8_t> const & index)
+{
+  return make_unique<EditsIndex>(vector<uint8_t>(index));
+}
 }  // namespace editor
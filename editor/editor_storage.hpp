@@ -1,5 +1,11 @@
 #pragma once
 
+#include "editor/edits_index.hpp"
+
+#include "std/cstdint.hpp"
+#include "std/unique_ptr.hpp"
+#include "std/vector.hpp"
+
 #include "3party/pugixml/src/pugixml.hpp"
 
 namespace editor
@@ -13,6 +19,9 @@ public:
   virtual bool Save(pugi::xml_document const & doc) = 0;
   virtual bool Load(pugi::xml_document & doc) = 0;
   virtual void Reset() = 0;
+
+  // Saves a serialized EditsIndex and returns the saved index, returns nullptr on errors.
+  virtual unique_ptr<EditsIndex> SaveIndex(vector<uint8_t> const & index) = 0;
 };
 
 // Class which saves/loads edits to/from local file.
@@ -23,6 +32,8 @@ public:
   bool Save(pugi::xml_document const & doc) override;
   bool Load(pugi::xml_document & doc) override;
   void Reset() override;
+  // The index is mapped to memory from a file next to the edits.
+  unique_ptr<EditsIndex> SaveIndex(vector<uint8_t> const & index) override;
 };
 
 // Class which saves/loads edits to/from xml_document class instance.
@@ -33,6 +44,7 @@ public:
   bool Save(pugi::xml_document const & doc) override;
   bool Load(pugi::xml_document & doc) override;
   void Reset() override;
+  unique_ptr<EditsIndex> SaveIndex(vector<uint8_t> const & index) override;
 
 private:
   pugi::xml_document m_doc;
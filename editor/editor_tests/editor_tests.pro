@@ -26,6 +26,7 @@ SOURCES += \
     config_loader_test.cpp \
     editor_config_test.cpp \
     editor_notes_test.cpp \
+    edits_index_test.cpp \
     opening_hours_ui_test.cpp \
     osm_feature_matcher_test.cpp \
     ui2oh_test.cpp \
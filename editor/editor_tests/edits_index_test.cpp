@@ -0,0 +1,99 @@
+#include "testing/testing.hpp"
+
+#include "editor/edits_index.hpp"
+
+#include "platform/platform_tests_support/scoped_file.hpp"
+
+#include "std/string.hpp"
+#include "std/vector.hpp"
+
+using namespace editor;
+
+namespace
+{
+vector<uint8_t> MakeTestIndex()
+{
+  EditsIndex::Builder builder;
+  builder.Add("Russia_Moscow", 170101, 10 /* index */, 1 /* status */);
+  builder.Add("Russia_Moscow", 170101, 3 /* index */, 2 /* status */);
+  builder.Add("Russia_Moscow", 170101, 4294000000 /* index */, 4 /* status */);
+  builder.Add("Belarus", 170202, 0 /* index */, 3 /* status */);
+
+  vector<uint8_t> buffer;
+  builder.Serialize(buffer);
+  return buffer;
+}
+
+bool IsCorrupted(vector<uint8_t> && buffer)
+{
+  try
+  {
+    EditsIndex const index(move(buffer));
+  }
+  catch (EditsIndexError const &)
+  {
+    return true;
+  }
+  return false;
+}
+
+void TestIndex(EditsIndex const & index)
+{
+  TEST_EQUAL(index.GetMwmsCount(), 2, ());
+
+  EditsIndex::Mwm mwm;
+  TEST(!index.GetMwm("Russia_Moscow", 170202, mwm), ());
+  TEST(!index.GetMwm("Germany", 170101, mwm), ());
+
+  TEST(index.GetMwm("Russia_Moscow", 170101, mwm), ());
+  TEST_EQUAL(mwm.GetCount(), 3, ());
+  EditsIndex::Status status = 0;
+  TEST(mwm.GetStatus(3, status), ());
+  TEST_EQUAL(status, 2, ());
+  TEST(mwm.GetStatus(10, status), ());
+  TEST_EQUAL(status, 1, ());
+  TEST(mwm.GetStatus(4294000000, status), ());
+  TEST_EQUAL(status, 4, ());
+  TEST(!mwm.GetStatus(0, status), ());
+  TEST(!mwm.GetStatus(5, status), ());
+
+  TEST(index.GetMwm("Belarus", 170202, mwm), ());
+  TEST_EQUAL(mwm.GetCount(), 1, ());
+  TEST(mwm.GetStatus(0, status), ());
+  TEST_EQUAL(status, 3, ());
+}
+}  // namespace
+
+UNIT_TEST(EditsIndex_Memory)
+{
+  EditsIndex const index(MakeTestIndex());
+  TestIndex(index);
+
+  vector<uint8_t> buffer;
+  EditsIndex::Builder().Serialize(buffer);
+  EditsIndex const empty(move(buffer));
+  TEST_EQUAL(empty.GetMwmsCount(), 0, ());
+}
+
+UNIT_TEST(EditsIndex_File)
+{
+  auto const buffer = MakeTestIndex();
+  platform::tests_support::ScopedFile sf("edits_index_test.idx",
+                                         string(buffer.begin(), buffer.end()));
+  EditsIndex const index(sf.GetFullPath());
+  TestIndex(index);
+}
+
+UNIT_TEST(EditsIndex_Corrupted)
+{
+  auto buffer = MakeTestIndex();
+  buffer.resize(buffer.size() - 4);
+  TEST(IsCorrupted(move(buffer)), ());
+
+  buffer = MakeTestIndex();
+  buffer[sizeof(uint32_t)] = EditsIndex::kLatestVersion + 1;
+  TEST(IsCorrupted(move(buffer)), ());
+
+  TEST(IsCorrupted(vector<uint8_t>(2)), ());
+  TEST(!IsCorrupted(MakeTestIndex()), ());
+}
@@ -0,0 +1,158 @@
+#include "editor/edits_index.hpp"
+
+#include "coding/endianness.hpp"
+#include "coding/read_write_utils.hpp"
+#include "coding/reader.hpp"
+#include "coding/varint.hpp"
+#include "coding/write_to_sink.hpp"
+#include "coding/writer.hpp"
+
+#include "base/assert.hpp"
+
+#include "std/algorithm.hpp"
+
+namespace
+{
+uint64_t constexpr kAlignment = 4;
+
+uint64_t Align(uint64_t offset) { return (offset + kAlignment - 1) / kAlignment * kAlignment; }
+
+template <typename Sink>
+void WritePadding(Sink & sink)
+{
+  while (sink.Pos() % kAlignment != 0)
+    WriteToSink(sink, static_cast<uint8_t>(0));
+}
+}  // namespace
+
+namespace editor
+{
+// static
+uint8_t constexpr EditsIndex::kLatestVersion;
+
+// EditsIndex::Mwm ---------------------------------------------------------------------------------
+bool EditsIndex::Mwm::GetStatus(uint32_t index, Status & status) const
+{
+  auto const end = m_indices + m_count;
+  auto const it = lower_bound(m_indices, end, index, [](uint32_t lhs, uint32_t rhs) {
+    return SwapIfBigEndian(lhs) < rhs;
+  });
+  if (it == end || SwapIfBigEndian(*it) != index)
+    return false;
+
+  status = m_statuses[it - m_indices];
+  return true;
+}
+
+// EditsIndex::Builder -----------------------------------------------------------------------------
+void EditsIndex::Builder::Add(string const & countryName, int64_t version, uint32_t index,
+                              Status status)
+{
+  m_mwms[make_pair(countryName, version)].emplace_back(index, status);
+}
+
+void EditsIndex::Builder::Serialize(vector<uint8_t> & buffer) const
+{
+  buffer.clear();
+
+  vector<uint8_t> header;
+  vector<uint8_t> data;
+  {
+    MemWriter<vector<uint8_t>> headerWriter(header);
+    MemWriter<vector<uint8_t>> dataWriter(data);
+
+    WriteToSink(headerWriter, kLatestVersion);
+    WriteVarUint(headerWriter, static_cast<uint32_t>(m_mwms.size()));
+    for (auto const & mwm : m_mwms)
+    {
+      auto features = mwm.second;
+      sort(features.begin(), features.end());
+      features.erase(unique(features.begin(), features.end(),
+                            [](pair<uint32_t, Status> const & lhs,
+                               pair<uint32_t, Status> const & rhs) {
+                              return lhs.first == rhs.first;
+                            }),
+                     features.end());
+
+      rw::Write(headerWriter, mwm.first.first);
+      WriteVarInt(headerWriter, mwm.first.second);
+      WriteVarUint(headerWriter, static_cast<uint32_t>(features.size()));
+      WriteVarUint(headerWriter, dataWriter.Pos());
+
+      for (auto const & feature : features)
+        WriteToSink(dataWriter, feature.first);
+      for (auto const & feature : features)
+        WriteToSink(dataWriter, feature.second);
+      WritePadding(dataWriter);
+    }
+  }
+
+  MemWriter<vector<uint8_t>> writer(buffer);
+  auto const dataOffset = static_cast<uint32_t>(Align(sizeof(uint32_t) + header.size()));
+  WriteToSink(writer, dataOffset);
+  writer.Write(header.data(), header.size());
+  WritePadding(writer);
+  ASSERT_EQUAL(writer.Pos(), dataOffset, ());
+  writer.Write(data.data(), data.size());
+}
+
+// EditsIndex --------------------------------------------------------------------------------------
+EditsIndex::EditsIndex(vector<uint8_t> && buffer) : m_buffer(move(buffer))
+{
+  Init(m_buffer.data(), m_buffer.size());
+}
+
+EditsIndex::EditsIndex(string const & filePath) : m_reader(make_unique<MmapReader>(filePath))
+{
+  m_reader->Advise(MmapReader::Advice::Random);
+  Init(m_reader->Data(), m_reader->Size());
+}
+
+bool EditsIndex::GetMwm(string const & countryName, int64_t version, Mwm & mwm) const
+{
+  auto const it = m_mwms.find(make_pair(countryName, version));
+  if (it == m_mwms.cend())
+    return false;
+
+  mwm = it->second;
+  return true;
+}
+
+void EditsIndex::Init(uint8_t const * data, uint64_t size)
+{
+  try
+  {
+    MemReaderWithExceptions reader(data, static_cast<size_t>(size));
+    ReaderSource<MemReaderWithExceptions> src(reader);
+
+    auto const dataOffset = ReadPrimitiveFromSource<uint32_t>(src);
+    if (dataOffset % kAlignment != 0 || dataOffset > size)
+      MYTHROW(EditsIndexError, ("Wrong data offset:", dataOffset));
+
+    auto const version = ReadPrimitiveFromSource<uint8_t>(src);
+    if (version != kLatestVersion)
+      MYTHROW(EditsIndexError, ("Unknown version:", static_cast<int>(version)));
+
+    auto const mwmsCount = ReadVarUint<uint32_t>(src);
+    for (uint32_t i = 0; i < mwmsCount; ++i)
+    {
+      string countryName;
+      rw::Read(src, countryName);
+      auto const mwmVersion = ReadVarInt<int64_t>(src);
+      auto const count = ReadVarUint<uint32_t>(src);
+      auto const offset = dataOffset + ReadVarUint<uint64_t>(src);
+
+      if (offset % kAlignment != 0 || offset + uint64_t(count) * (sizeof(uint32_t) + 1) > size)
+        MYTHROW(EditsIndexError, ("Features of", countryName, "are out of the index."));
+
+      auto const indices = reinterpret_cast<uint32_t const *>(data + offset);
+      auto const statuses = data + offset + count * sizeof(uint32_t);
+      m_mwms[make_pair(countryName, mwmVersion)] = Mwm(indices, statuses, count);
+    }
+  }
+  catch (Reader::Exception const & e)
+  {
+    MYTHROW(EditsIndexError, ("Index is truncated:", e.Msg()));
+  }
+}
+}  // namespace editor
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "coding/mmap_reader.hpp"
+
+#include "base/exception.hpp"
+
+#include "std/cstdint.hpp"
+#include "std/map.hpp"
+#include "std/string.hpp"
+#include "std/unique_ptr.hpp"
+#include "std/utility.hpp"
+#include "std/vector.hpp"
+
+namespace editor
+{
+DECLARE_EXCEPTION(EditsIndexError, RootException);
+
+// Compact binary index of map edits. For every mwm it keeps sorted indices of edited
+// features and their statuses, so a check of a feature is a binary search over plain
+// memory. An index saved to a file is mapped to memory instead of being read.
+//
+// Format: uint32 offset of the data, uint8 version, varuint number of mwms and for every mwm
+// its name, varint version, varuint number of features and varuint offset of its features from
+// the data. The data is aligned by 4 bytes and keeps for every mwm uint32 feature indices
+// followed by uint8 statuses, padded to 4 bytes.
+class EditsIndex
+{
+public:
+  using Status = uint8_t;
+
+  static uint8_t constexpr kLatestVersion = 0;
+
+  // Edited features of an mwm. Points to the memory of the index.
+  class Mwm
+  {
+  public:
+    Mwm() = default;
+    Mwm(uint32_t const * indices, Status const * statuses, uint32_t count)
+      : m_indices(indices), m_statuses(statuses), m_count(count)
+    {
+    }
+
+    // Returns false when feature |index| is not edited.
+    bool GetStatus(uint32_t index, Status & status) const;
+    uint32_t GetCount() const { return m_count; }
+
+  private:
+    uint32_t const * m_indices = nullptr;
+    Status const * m_statuses = nullptr;
+    uint32_t m_count = 0;
+  };
+
+  class Builder
+  {
+  public:
+    void Add(string const & countryName, int64_t version, uint32_t index, Status status);
+    void Serialize(vector<uint8_t> & buffer) const;
+
+  private:
+    map<pair<string, int64_t>, vector<pair<uint32_t, Status>>> m_mwms;
+  };
+
+  // Throws EditsIndexError when |buffer| is not a valid index.
+  explicit EditsIndex(vector<uint8_t> && buffer);
+  // Throws EditsIndexError when the file is not a valid index and
+  // Reader::Exception when it can't be mapped.
+  explicit EditsIndex(string const & filePath);
+
+  // Returns false when there are no edits of the mwm.
+  bool GetMwm(string const & countryName, int64_t version, Mwm & mwm) const;
+  size_t GetMwmsCount() const { return m_mwms.size(); }
+
+private:
+  void Init(uint8_t const * data, uint64_t size);
+
+  vector<uint8_t> m_buffer;
+  unique_ptr<MmapReader> m_reader;
+  map<pair<string, int64_t>, Mwm> m_mwms;
+};
+}  // namespace editor
@@ -104,6 +104,14 @@ void ServerApi06::DeleteElement(editor::XMLFeature const & element) const
     MYTHROW(ErrorDeletingElement, ("Could not delete an element:", response));
 }
 
+void ServerApi06::UploadDiff(uint64_t changesetId, string const & osmChange) const
+{
+  OsmOAuth::Response const response =
+      m_auth.Request("/changeset/" + strings::to_string(changesetId) + "/upload", "POST", osmChange);
+  if (response.first != OsmOAuth::HTTP::OK)
+    MYTHROW(UploadDiffHasFailed, ("UploadDiff request has failed:", response));
+}
+
 void ServerApi06::UpdateChangeSet(uint64_t changesetId, TKeyValueTags const & kvTags) const
 {
   OsmOAuth::Response const response = m_auth.Request("/changeset/" + strings::to_string(changesetId), "PUT", KeyValueTagsToXML(kvTags));
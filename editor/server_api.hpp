@@ -38,6 +38,7 @@ public:
   DECLARE_EXCEPTION(CreateElementHasFailed, ServerApi06Exception);
   DECLARE_EXCEPTION(ModifiedElementHasNoIdAttribute, ServerApi06Exception);
   DECLARE_EXCEPTION(ModifyElementHasFailed, ServerApi06Exception);
+  DECLARE_EXCEPTION(UploadDiffHasFailed, ServerApi06Exception);
   DECLARE_EXCEPTION(ErrorClosingChangeSet, ServerApi06Exception);
   DECLARE_EXCEPTION(ErrorAddingNote, ServerApi06Exception);
   DECLARE_EXCEPTION(DeletedElementHasNoIdAttribute, ServerApi06Exception);
@@ -71,6 +72,9 @@ public:
   /// @param element should already have all attributes set, including "id", "version", "changeset".
   /// @returns true if element was successfully deleted (or was already deleted).
   void DeleteElement(editor::XMLFeature const & element) const;
+  /// Uploads all changes of |osmChange| document by one request. The server applies
+  /// all of the changes or none of them.
+  void UploadDiff(uint64_t changesetId, string const & osmChange) const;
   void UpdateChangeSet(uint64_t changesetId, TKeyValueTags const & kvTags) const;
   void CloseChangeSet(uint64_t changesetId) const;
   /// @returns id of a created note.
@@ -0,0 +1,306 @@
+// Exports features of mwms to columnar text files for analytics.
+//
+// Every mwm is exported to a set of files <output>/<mwm>.<field>, one file per requested
+// field plus <mwm>.id with feature indices. The i-th line of every file of an mwm belongs
+// to the same feature. Mwms are exported in parallel, features of an mwm are read
+// sequentially from its features section, without an index and an mwm set.
+#include "indexer/classificator.hpp"
+#include "indexer/classificator_loader.hpp"
+#include "indexer/feature.hpp"
+#include "indexer/feature_algo.hpp"
+#include "indexer/features_vector.hpp"
+#include "indexer/map_style_reader.hpp"
+
+#include "platform/platform.hpp"
+
+#include "coding/file_name_utils.hpp"
+#include "coding/file_writer.hpp"
+#include "coding/multilang_utf8_string.hpp"
+
+#include "geometry/mercator.hpp"
+
+#include "base/exception.hpp"
+#include "base/logging.hpp"
+#include "base/string_utils.hpp"
+#include "base/timer.hpp"
+
+#include "defines.hpp"
+
+#include "std/algorithm.hpp"
+#include "std/atomic.hpp"
+#include "std/string.hpp"
+#include "std/thread.hpp"
+#include "std/unique_ptr.hpp"
+#include "std/vector.hpp"
+
+#include "3party/gflags/src/gflags/gflags.h"
+
+DEFINE_string(data_path, "", "Path to the resources (classificator, types).");
+DEFINE_string(mwm_path, "", "Path to the directory with mwm files.");
+DEFINE_string(mwm_prefix, "", "Only mwms which names start with the prefix are exported.");
+DEFINE_string(output, "", "Path to the directory for the exported files.");
+DEFINE_string(fields, "types,names,metadata,center",
+              "Comma-separated list of the exported fields: types, names, metadata, center.");
+DEFINE_int32(threads, 0, "Number of threads, the number of cores by default.");
+DEFINE_bool(named_only, false, "Exports features with names only.");
+
+namespace
+{
+enum class Field
+{
+  Types,
+  Names,
+  Metadata,
+  Center
+};
+
+char const * GetFieldName(Field field)
+{
+  switch (field)
+  {
+  case Field::Types: return "types";
+  case Field::Names: return "names";
+  case Field::Metadata: return "metadata";
+  case Field::Center: return "center";
+  }
+  return "";
+}
+
+bool ParseFields(string const & s, vector<Field> & fields)
+{
+  fields.clear();
+  for (strings::SimpleTokenizer it(s, ","); it; ++it)
+  {
+    string token = *it;
+    strings::Trim(token);
+    bool found = false;
+    for (auto const field : {Field::Types, Field::Names, Field::Metadata, Field::Center})
+    {
+      if (token == GetFieldName(field))
+      {
+        if (find(fields.begin(), fields.end(), field) == fields.end())
+          fields.push_back(field);
+        found = true;
+        break;
+      }
+    }
+    if (!found)
+    {
+      LOG(LWARNING, ("Unknown field", token));
+      return false;
+    }
+  }
+  return !fields.empty();
+}
+
+// Values are separated by tabs and features by newlines, so they're escaped in values.
+void AppendEscaped(string const & value, string & out)
+{
+  for (char const c : value)
+  {
+    switch (c)
+    {
+    case '\\': out += "\\\\"; break;
+    case '\t': out += "\\t"; break;
+    case '\n': out += "\\n"; break;
+    case '\r': out += "\\r"; break;
+    default: out += c;
+    }
+  }
+}
+
+void AppendField(FeatureType const & ft, Field field, string & out)
+{
+  switch (field)
+  {
+  case Field::Types:
+  {
+    bool first = true;
+    ft.ForEachType([&](uint32_t type)
+    {
+      if (!first)
+        out += '\t';
+      first = false;
+      AppendEscaped(classif().GetReadableObjectName(type), out);
+    });
+    break;
+  }
+  case Field::Names:
+  {
+    bool first = true;
+    ft.GetNames().ForEach([&](int8_t code, string const & name)
+    {
+      if (!first)
+        out += '\t';
+      first = false;
+      out += StringUtf8Multilang::GetLangByCode(code);
+      out += '=';
+      AppendEscaped(name, out);
+      return true;
+    });
+    break;
+  }
+  case Field::Metadata:
+  {
+    auto const & metadata = ft.GetMetadata();
+    bool first = true;
+    for (auto const type : metadata.GetPresentTypes())
+    {
+      if (!first)
+        out += '\t';
+      first = false;
+      out += DebugPrint(static_cast<feature::Metadata::EType>(type));
+      out += '=';
+      AppendEscaped(metadata.Get(type), out);
+    }
+    break;
+  }
+  case Field::Center:
+  {
+    auto const latLon = MercatorBounds::ToLatLon(feature::GetCenter(ft));
+    out += strings::to_string_with_digits_after_comma(latLon.lat, 6);
+    out += '\t';
+    out += strings::to_string_with_digits_after_comma(latLon.lon, 6);
+    break;
+  }
+  }
+}
+
+class MwmExporter
+{
+public:
+  MwmExporter(string const & mwmPath, string const & outputDir, vector<Field> const & fields)
+    : m_mwmPath(mwmPath), m_fields(fields)
+  {
+    string name = mwmPath;
+    my::GetNameFromFullPath(name);
+    my::GetNameWithoutExt(name);
+
+    string const base = my::JoinFoldersToPath(outputDir, name);
+    m_idWriter.reset(new FileWriter(base + ".id"));
+    for (auto const field : m_fields)
+      m_writers.emplace_back(new FileWriter(base + "." + GetFieldName(field)));
+    m_lines.resize(m_fields.size());
+  }
+
+  // Returns number of exported features.
+  size_t Export()
+  {
+    size_t count = 0;
+    FeaturesVectorTest const features(m_mwmPath);
+    features.GetVector().ForEach([&](FeatureType & ft, uint32_t index)
+    {
+      if (FLAGS_named_only && !ft.HasName())
+        return;
+
+      m_idLine += strings::to_string(index);
+      m_idLine += '\n';
+      for (size_t i = 0; i < m_fields.size(); ++i)
+      {
+        AppendField(ft, m_fields[i], m_lines[i]);
+        m_lines[i] += '\n';
+      }
+      ++count;
+
+      if (m_idLine.size() >= kFlushSize)
+        Flush();
+    });
+    Flush();
+    return count;
+  }
+
+private:
+  // Lines are collected in buffers and written by big blocks.
+  static size_t constexpr kFlushSize = 1 << 16;
+
+  void Flush()
+  {
+    m_idWriter->Write(m_idLine.data(), m_idLine.size());
+    m_idLine.clear();
+    for (size_t i = 0; i < m_fields.size(); ++i)
+    {
+      m_writers[i]->Write(m_lines[i].data(), m_lines[i].size());
+      m_lines[i].clear();
+    }
+  }
+
+  string const m_mwmPath;
+  vector<Field> const m_fields;
+  unique_ptr<FileWriter> m_idWriter;
+  vector<unique_ptr<FileWriter>> m_writers;
+  string m_idLine;
+  vector<string> m_lines;
+};
+}  // namespace
+
+int main(int argc, char ** argv)
+{
+  google::SetUsageMessage("Exports features of mwms to columnar text files.");
+  google::ParseCommandLineFlags(&argc, &argv, true);
+
+  if (FLAGS_mwm_path.empty() || FLAGS_output.empty())
+  {
+    LOG(LWARNING, ("Both --mwm_path and --output must be set."));
+    return 1;
+  }
+
+  vector<Field> fields;
+  if (!ParseFields(FLAGS_fields, fields))
+  {
+    LOG(LWARNING, ("Wrong --fields:", FLAGS_fields));
+    return 1;
+  }
+
+  Platform & platform = GetPlatform();
+  if (!FLAGS_data_path.empty())
+    platform.SetResourceDir(FLAGS_data_path);
+
+  GetStyleReader().SetCurrentStyle(MapStyleMerged);
+  classificator::Load();
+
+  Platform::FilesList files;
+  Platform::GetFilesByExt(FLAGS_mwm_path, DATA_FILE_EXTENSION, files);
+  vector<string> mwms;
+  for (auto const & file : files)
+  {
+    if (strings::StartsWith(file, FLAGS_mwm_prefix.c_str()))
+      mwms.push_back(my::JoinFoldersToPath(FLAGS_mwm_path, file));
+  }
+  sort(mwms.begin(), mwms.end());
+
+  size_t threadsCount = FLAGS_threads > 0 ? static_cast<size_t>(FLAGS_threads) : platform.CpuCores();
+  threadsCount = max(min(threadsCount, mwms.size()), static_cast<size_t>(1));
+
+  my::Timer timer;
+  atomic<size_t> next(0);
+  atomic<size_t> exported(0);
+  atomic<bool> failed(false);
+  vector<thread> threads;
+  for (size_t i = 0; i < threadsCount; ++i)
+  {
+    threads.emplace_back([&]()
+    {
+      for (size_t j = next++; j < mwms.size(); j = next++)
+      {
+        try
+        {
+          MwmExporter exporter(mwms[j], FLAGS_output, fields);
+          size_t const count = exporter.Export();
+          exported += count;
+          LOG(LINFO, ("Exported", count, "features of", mwms[j]));
+        }
+        catch (RootException const & e)
+        {
+          LOG(LWARNING, ("Can't export", mwms[j], e.Msg()));
+          failed = true;
+        }
+      }
+    });
+  }
+  for (auto & t : threads)
+    t.join();
+
+  LOG(LINFO, ("Exported", exported.load(), "features of", mwms.size(), "mwms in",
+              timer.ElapsedSeconds(), "seconds"));
+  return failed ? 1 : 0;
+}
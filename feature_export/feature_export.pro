@@ -0,0 +1,22 @@
+# Feature Export Tool
+
+ROOT_DIR = ..
+DEPENDENCIES = indexer platform editor geometry coding base gflags jansson protobuf succinct \
+               opening_hours pugixml icu
+
+include($$ROOT_DIR/common.pri)
+
+INCLUDEPATH *= $$ROOT_DIR/3party/gflags/src
+
+CONFIG += console warn_on
+CONFIG -= app_bundle
+TEMPLATE = app
+
+# needed for Platform::WorkingDir() and unicode combining
+QT *= core
+
+macx-* {
+  LIBS *= "-framework IOKit" "-framework SystemConfiguration"
+}
+
+SOURCES += feature_export.cpp
@@ -29,6 +29,8 @@
 #include "defines.hpp"
 
 #include <algorithm>
+#include <cmath>
+#include <set>
 #include <type_traits>
 #include <utility>
 #include <vector>
@@ -54,6 +56,32 @@ public:
     return m_srtmManager.GetHeight(MercatorBounds::ToLatLon(p));
   }
 
+  // Loads tiles which are covered by bounding boxes of roads of |mwmPath|.
+  void PrefetchTiles(std::string const & mwmPath, size_t threadsCount)
+  {
+    std::set<std::pair<int, int>> cells;
+    feature::ForEachFromDat(mwmPath, [&cells](FeatureType const & f, uint32_t /* id */)
+    {
+      if (!routing::IsRoad(feature::TypesHolder(f)))
+        return;
+
+      m2::RectD const rect = f.GetLimitRect(FeatureType::BEST_GEOMETRY);
+      ms::LatLon const min = MercatorBounds::ToLatLon(rect.LeftBottom());
+      ms::LatLon const max = MercatorBounds::ToLatLon(rect.RightTop());
+      for (int lat = static_cast<int>(std::floor(min.lat)); lat <= std::floor(max.lat); ++lat)
+      {
+        for (int lon = static_cast<int>(std::floor(min.lon)); lon <= std::floor(max.lon); ++lon)
+          cells.emplace(lat, lon);
+      }
+    });
+
+    // Centers of cells of one degree are in the same tiles as cells.
+    std::vector<ms::LatLon> coords;
+    for (auto const & cell : cells)
+      coords.emplace_back(cell.first + 0.5, cell.second + 0.5);
+    m_srtmManager.Prefetch(coords, threadsCount);
+  }
+
 private:
   generator::SrtmTileManager m_srtmManager;
 };
@@ -234,10 +262,13 @@ void BuildRoadAltitudes(std::string const & mwmPath, AltitudeGetter & altitudeGe
   }
 }
 
-void BuildRoadAltitudes(std::string const & mwmPath, std::string const & srtmDir)
+void BuildRoadAltitudes(std::string const & mwmPath, std::string const & srtmDir,
+                        size_t threadsCount)
 {
   LOG(LINFO, ("mwmPath =", mwmPath, "srtmDir =", srtmDir));
   SrtmGetter srtmGetter(srtmDir);
+  if (threadsCount > 1)
+    srtmGetter.PrefetchTiles(mwmPath, threadsCount);
   BuildRoadAltitudes(mwmPath, srtmGetter);
 }
 }  // namespace routing
@@ -4,6 +4,7 @@
 
 #include "indexer/feature_altitude.hpp"
 
+#include <cstddef>
 #include <string>
 
 namespace routing
@@ -25,5 +26,8 @@ public:
 /// feat. table offset  feature table         alt. info offset - feat. table offset
 /// alt. info offset    altitude info         end of section - alt. info offset
 void BuildRoadAltitudes(std::string const & mwmPath, AltitudeGetter & altitudeGetter);
-void BuildRoadAltitudes(std::string const & mwmPath, std::string const & srtmDir);
+/// \brief Adds altitude section with altitudes of SRTM tiles of |srtmDir|. When |threadsCount|
+/// is greater than one, tiles of all roads are loaded in advance on |threadsCount| threads.
+void BuildRoadAltitudes(std::string const & mwmPath, std::string const & srtmDir,
+                        size_t threadsCount = 1);
 }  // namespace routing
@@ -5,6 +5,7 @@
 
 #include "platform/platform.hpp"
 
+#include "storage/country_grid.hpp"
 #include "storage/country_polygon.hpp"
 
 #include "indexer/geometry_serialization.hpp"
@@ -15,8 +16,10 @@
 #include "geometry/distance.hpp"
 
 #include "coding/file_container.hpp"
+#include "coding/reader.hpp"
 #include "coding/read_write_utils.hpp"
 #include "coding/file_name_utils.hpp"
+#include "coding/writer.hpp"
 
 #include "base/logging.hpp"
 #include "base/string_utils.hpp"
@@ -24,6 +27,7 @@
 #include <fstream>
 #include <functional>
 #include <iomanip>
+#include <utility>
 #include <vector>
 
 
@@ -106,6 +110,8 @@ class PackedBordersGenerator
   FilesContainerW m_writer;
 
   std::vector<storage::CountryDef> m_polys;
+  // Polygons as they are read from the packed file, for the countries grid.
+  std::vector<std::vector<m2::RegionD>> m_regions;
 
 public:
   PackedBordersGenerator(std::string const & baseDir)
@@ -129,6 +135,7 @@ public:
 
     // write polygons as paths
     WriteVarUint(w, borders.size());
+    m_regions.emplace_back();
     for (m2::RegionD const & border : borders)
     {
       typedef std::vector<m2::PointD> VectorT;
@@ -143,7 +150,16 @@ public:
       SimplifyNearOptimal(20, in.begin(), in.end(), eps, dist,
                           AccumulateSkipSmallTrg<DistanceT, m2::PointD>(dist, out, eps));
 
-      serial::SaveOuterPath(out, cp, w);
+      std::vector<char> buffer;
+      MemWriter<std::vector<char>> bufferWriter(buffer);
+      serial::SaveOuterPath(out, cp, bufferWriter);
+      w.Write(buffer.data(), buffer.size());
+
+      MemReader bufferReader(buffer.data(), buffer.size());
+      ReaderSource<MemReader> src(bufferReader);
+      std::vector<m2::PointD> points;
+      serial::LoadOuterPath(src, cp, points);
+      m_regions.back().emplace_back(std::move(points));
     }
   }
 
@@ -154,6 +170,16 @@ public:
     FileWriter w = m_writer.GetWriter(PACKED_POLYGONS_INFO_TAG);
     rw::Write(w, m_polys);
   }
+
+  void WriteCountriesGrid()
+  {
+    LOG(LINFO, ("Building countries grid."));
+    storage::CountryGrid grid;
+    grid.Build(m_regions, storage::CountryGrid::kDefaultSize);
+
+    FileWriter w = m_writer.GetWriter(PACKED_POLYGONS_GRID_TAG);
+    grid.Serialize(w);
+  }
 };
 
 void GeneratePackedBorders(std::string const & baseDir)
@@ -161,6 +187,7 @@ void GeneratePackedBorders(std::string const & baseDir)
   PackedBordersGenerator generator(baseDir);
   ForEachCountry(baseDir, generator);
   generator.WritePolygonsInfo();
+  generator.WriteCountriesGrid();
 }
 
 void UnpackBorders(std::string const & baseDir, std::string const & targetDir)
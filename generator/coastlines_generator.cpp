@@ -10,6 +10,9 @@
 
 #include <condition_variable>
 #include <functional>
+#include <iterator>
+#include <list>
+#include <mutex>
 #include <thread>
 #include <utility>
 
@@ -210,20 +213,37 @@ class RegionInCellSplitter final
 public:
   using TCell = RectId;
   using TIndex = m4::Tree<m2::RegionI>;
-  using TProcessResultFunc = function<void(TCell const &, DoDifference &)>;
+  using TMakeFeatureFn = function<FeatureBuilder1(TCell const &, DoDifference &)>;
+  using TEmitFn = CoastlineFeaturesGenerator::TEmitFn;
 
   static int constexpr kStartLevel = 4;
   static int constexpr kHighLevel = 10;
   static int constexpr kMaxPoints = 20000;
 
 protected:
+  // Result of a cell. Slots go in the order of cells: a split cell is
+  // replaced by slots of its children, so features are emitted in the
+  // same order regardless of the number of threads.
+  struct Slot
+  {
+    Slot(TCell const & cell) : m_cell(cell) {}
+
+    TCell m_cell;
+    FeatureBuilder1 m_feature;
+    bool m_done = false;
+  };
+
+  using TSlots = list<Slot>;
+
   struct Context
   {
     mutex mutexTasks;
-    list<TCell> listTasks;
+    // Tasks refer to slots of their cells.
+    list<TSlots::iterator> listTasks;
+    TSlots slots;
     condition_variable listCondVar;
     size_t inWork = 0;
-    TProcessResultFunc processResultFunc;
+    TMakeFeatureFn makeFeatureFunc;
   };
 
   Context & m_ctx;
@@ -234,15 +254,21 @@ protected:
   {}
 
 public:
-  static bool Process(size_t numThreads, size_t baseScale, TIndex const & index,
-                      TProcessResultFunc funcResult)
+  // Features are made on |numThreads| threads and are passed to |emitFunc|
+  // on the calling thread as soon as features of all previous cells are
+  // passed, so only a window of features is kept in memory.
+  static void Process(size_t numThreads, size_t baseScale, TIndex const & index,
+                      TMakeFeatureFn const & makeFunc, TEmitFn const & emitFunc)
   {
     Context ctx;
 
     for (size_t i = 0; i < TCell::TotalCellsOnLevel(baseScale); ++i)
-      ctx.listTasks.push_back(TCell::FromBitsAndLevel(i, static_cast<int>(baseScale)));
+    {
+      ctx.slots.emplace_back(TCell::FromBitsAndLevel(i, static_cast<int>(baseScale)));
+      ctx.listTasks.push_back(prev(ctx.slots.end()));
+    }
 
-    ctx.processResultFunc = funcResult;
+    ctx.makeFeatureFunc = makeFunc;
 
     vector<RegionInCellSplitter> instances;
     vector<thread> threads;
@@ -252,14 +278,28 @@ public:
       threads.emplace_back(instances.back());
     }
 
+    {
+      unique_lock<mutex> lock(ctx.mutexTasks);
+      while (true)
+      {
+        ctx.listCondVar.wait(lock, [&ctx] { return ctx.slots.empty() || ctx.slots.front().m_done; });
+        if (ctx.slots.empty())
+          break;
+
+        FeatureBuilder1 fb = move(ctx.slots.front().m_feature);
+        ctx.slots.pop_front();
+
+        lock.unlock();
+        emitFunc(fb);
+        lock.lock();
+      }
+    }
+
     for (auto & thread : threads)
       thread.join();
-
-    // return true if listTask has no error cells
-    return ctx.listTasks.empty();
   }
 
-  bool ProcessCell(TCell const & cell)
+  bool ProcessCell(TCell const & cell, FeatureBuilder1 & fb)
   {
     // get rect cell
     double minX, minY, maxX, maxY;
@@ -279,7 +319,7 @@ public:
     if (cell.Level() < kHighLevel && doDiff.GetPointsCount() >= kMaxPoints)
       return false;
 
-    m_ctx.processResultFunc(cell, doDiff);
+    fb = m_ctx.makeFeatureFunc(cell, doDiff);
     return true;
   }
 
@@ -293,19 +333,29 @@ public:
       if (m_ctx.listTasks.empty())
         break;
 
-      TCell currentCell = m_ctx.listTasks.front();
+      auto const slot = m_ctx.listTasks.front();
       m_ctx.listTasks.pop_front();
       ++m_ctx.inWork;
+      TCell const currentCell = slot->m_cell;
       lock.unlock();
 
-      bool const done = ProcessCell(currentCell);
+      FeatureBuilder1 fb;
+      bool const done = ProcessCell(currentCell, fb);
 
       lock.lock();
-      // return to queue not ready cells
-      if (!done)
+      if (done)
       {
+        slot->m_feature = move(fb);
+        slot->m_done = true;
+      }
+      else
+      {
+        // Children replace the cell in the order of slots and go to the
+        // front of the queue, so the front slots are filled first.
+        auto it = m_ctx.listTasks.begin();
         for (int8_t i = 0; i < TCell::MAX_CHILDREN; ++i)
-          m_ctx.listTasks.push_back(currentCell.Child(i));
+          m_ctx.listTasks.insert(it, m_ctx.slots.emplace(slot, currentCell.Child(i)));
+        m_ctx.slots.erase(slot);
       }
       --m_ctx.inWork;
       m_ctx.listCondVar.notify_all();
@@ -313,15 +363,14 @@ public:
   }
 };
 
-void CoastlineFeaturesGenerator::GetFeatures(vector<FeatureBuilder1> & features)
+void CoastlineFeaturesGenerator::ForEachFeature(TEmitFn const & fn)
 {
   size_t const maxThreads = thread::hardware_concurrency();
   CHECK_GREATER(maxThreads, 0, ("Not supported platform"));
 
-  mutex featuresMutex;
   RegionInCellSplitter::Process(
       maxThreads, RegionInCellSplitter::kStartLevel, m_tree,
-      [&features, &featuresMutex, this](RegionInCellSplitter::TCell const & cell, DoDifference & cellData)
+      [this](RegionInCellSplitter::TCell const & cell, DoDifference & cellData)
       {
         FeatureBuilder1 fb;
         fb.SetCoastCell(cell.ToInt64(RegionInCellSplitter::kHighLevel + 1));
@@ -333,9 +382,12 @@ void CoastlineFeaturesGenerator::GetFeatures(vector<FeatureBuilder1> & features)
         // Should represent non-empty geometry
         CHECK_GREATER(fb.GetPolygonsCount(), 0, ());
         CHECK_GREATER_OR_EQUAL(fb.GetPointsCount(), 3, ());
+        return fb;
+      },
+      fn);
+}
 
-        // save result
-        lock_guard<mutex> lock(featuresMutex);
-        features.emplace_back(move(fb));
-      });
+void CoastlineFeaturesGenerator::GetFeatures(vector<FeatureBuilder1> & features)
+{
+  ForEachFeature([&features](FeatureBuilder1 & fb) { features.emplace_back(move(fb)); });
 }
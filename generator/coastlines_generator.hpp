@@ -7,6 +7,8 @@
 #include "geometry/tree4d.hpp"
 #include "geometry/region2d.hpp"
 
+#include <functional>
+
 
 class FeatureBuilder1;
 
@@ -20,6 +22,8 @@ class CoastlineFeaturesGenerator
   uint32_t m_coastType;
 
 public:
+  using TEmitFn = std::function<void(FeatureBuilder1 & fb)>;
+
   CoastlineFeaturesGenerator(uint32_t coastType);
 
   void AddRegionToTree(FeatureBuilder1 const & fb);
@@ -28,5 +32,8 @@ public:
   /// @return false if coasts are not merged and FLAG_fail_on_coasts is set
   bool Finish();
 
+  /// Makes features of cells of the world on all cores and passes them to |fn|
+  /// on the calling thread in the order of cells, which doesn't depend on threads.
+  void ForEachFeature(TEmitFn const & fn);
   void GetFeatures(vector<FeatureBuilder1> & vecFb);
 };
@@ -0,0 +1,96 @@
+#include "generator/countries_scheduler.hpp"
+
+#include "base/assert.hpp"
+
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+using namespace std;
+
+namespace generator
+{
+CountriesScheduler::CountriesScheduler(size_t threadsCount, uint64_t memoryLimit)
+  : m_threadsCount(max(threadsCount, static_cast<size_t>(1))), m_memoryLimit(memoryLimit)
+{
+}
+
+void CountriesScheduler::Run(vector<Country> countries, TProcessFn const & fn) const
+{
+  if (m_threadsCount == 1 || countries.size() <= 1)
+  {
+    for (auto const & country : countries)
+      fn(country.m_name);
+    return;
+  }
+
+  stable_sort(countries.begin(), countries.end(), [](Country const & lhs, Country const & rhs)
+  {
+    return lhs.m_memory > rhs.m_memory;
+  });
+
+  mutex mu;
+  condition_variable cv;
+  vector<bool> isStarted(countries.size(), false);
+  size_t startedCount = 0;
+  size_t runningCount = 0;
+  uint64_t usedMemory = 0;
+
+  // Returns index of the biggest country which can be started now.
+  auto const findCountry = [&]() -> size_t
+  {
+    for (size_t i = 0; i < countries.size(); ++i)
+    {
+      if (isStarted[i])
+        continue;
+      if (m_memoryLimit == 0 || runningCount == 0 ||
+          usedMemory + countries[i].m_memory <= m_memoryLimit)
+      {
+        return i;
+      }
+    }
+    return countries.size();
+  };
+
+  auto const worker = [&]()
+  {
+    unique_lock<mutex> lock(mu);
+    while (true)
+    {
+      size_t index = countries.size();
+      cv.wait(lock, [&]()
+      {
+        if (startedCount == countries.size())
+          return true;
+        index = findCountry();
+        return index != countries.size();
+      });
+      if (startedCount == countries.size())
+        return;
+
+      Country const & country = countries[index];
+      isStarted[index] = true;
+      ++startedCount;
+      ++runningCount;
+      usedMemory += country.m_memory;
+
+      lock.unlock();
+      fn(country.m_name);
+      lock.lock();
+
+      ASSERT_GREATER(runningCount, 0, ());
+      --runningCount;
+      usedMemory -= country.m_memory;
+      cv.notify_all();
+    }
+  };
+
+  vector<thread> threads;
+  size_t const threadsCount = min(m_threadsCount, countries.size());
+  for (size_t i = 0; i < threadsCount; ++i)
+    threads.emplace_back(worker);
+  for (auto & thread : threads)
+    thread.join();
+}
+}  // namespace generator
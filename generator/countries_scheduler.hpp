@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace generator
+{
+// Processes countries on a pool of threads. Countries which need more memory
+// are started first, which balances threads better, and a country is started
+// only while the sum of predicted memory of running countries fits the limit.
+class CountriesScheduler
+{
+public:
+  struct Country
+  {
+    Country() = default;
+    Country(std::string const & name, uint64_t memory) : m_name(name), m_memory(memory) {}
+
+    std::string m_name;
+    // Predicted memory which is needed to process the country, in bytes.
+    uint64_t m_memory = 0;
+  };
+
+  using TProcessFn = std::function<void(std::string const & country)>;
+
+  // Zero |memoryLimit| means no limit.
+  CountriesScheduler(size_t threadsCount, uint64_t memoryLimit);
+
+  // Calls |fn| for every country and returns when all of them are processed.
+  // With one thread countries are processed on the calling thread in the
+  // given order. A country which doesn't fit the limit alone is processed
+  // when nothing else is running.
+  void Run(std::vector<Country> countries, TProcessFn const & fn) const;
+
+private:
+  size_t const m_threadsCount;
+  uint64_t const m_memoryLimit;
+};
+}  // namespace generator
@@ -182,6 +182,7 @@ public:
 
   void SetCoastCell(int64_t iCell) { m_coastCell = iCell; }
   inline bool IsCoastCell() const { return (m_coastCell != -1); }
+  inline int64_t GetCoastCell() const { return m_coastCell; }
 
   bool AddName(std::string const & lang, std::string const & name);
   std::string GetName(int8_t lang = StringUtf8Multilang::kDefaultCode) const;
@@ -5,6 +5,11 @@
 #include "indexer/classificator.hpp"
 
 #include "coding/point_to_integer.hpp"
+#include "coding/xxhash.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
 
 MergedFeatureBuilder1::MergedFeatureBuilder1(FeatureBuilder1 const & fb)
   : FeatureBuilder1(fb), m_isRound(false)
@@ -115,13 +120,13 @@ double MergedFeatureBuilder1::GetPriority() const
 }
 
 
-FeatureMergeProcessor::key_t FeatureMergeProcessor::get_key(m2::PointD const & p)
+FeatureMergeProcessor::TKey FeatureMergeProcessor::GetKey(m2::PointD const & p) const
 {
   return PointToInt64(p, m_coordBits);
 }
 
-FeatureMergeProcessor::FeatureMergeProcessor(uint32_t coordBits)
-: m_coordBits(coordBits)
+FeatureMergeProcessor::FeatureMergeProcessor(uint32_t coordBits, size_t threadsCount)
+  : m_coordBits(coordBits), m_threadsCount(std::max(threadsCount, size_t{1}))
 {
 }
 
@@ -132,73 +137,42 @@ void FeatureMergeProcessor::operator() (FeatureBuilder1 const & fb)
 
 void FeatureMergeProcessor::operator() (MergedFeatureBuilder1 * p)
 {
-  key_t const k1 = get_key(p->FirstPoint());
-  key_t const k2 = get_key(p->LastPoint());
+  auto const feature = static_cast<uint32_t>(m_features.size());
+  m_features.emplace_back(p);
+  m_priorities.push_back(p->GetPriority());
+
+  TKey const k1 = GetKey(p->FirstPoint());
+  TKey const k2 = GetKey(p->LastPoint());
 
-  m_map[k1].push_back(p);
+  m_keyPoints.push_back({k1, feature});
   if (k1 != k2)
-    m_map[k2].push_back(p);
+    m_keyPoints.push_back({k2, feature});
   else
   {
     ///@ todo Do it only for small round features!
     p->SetRound();
 
-    p->ForEachMiddlePoints(std::bind(&FeatureMergeProcessor::Insert, this, std::placeholders::_1, p));
-  }
-}
-
-void FeatureMergeProcessor::Insert(m2::PointD const & pt, MergedFeatureBuilder1 * p)
-{
-  m_map[get_key(pt)].push_back(p);
-}
-
-void FeatureMergeProcessor::Remove(key_t key, MergedFeatureBuilder1 const * p)
-{
-  map_t::iterator i = m_map.find(key);
-  if (i != m_map.end())
-  {
-    vector_t & v = i->second;
-    v.erase(remove(v.begin(), v.end(), p), v.end());
-    if (v.empty()) m_map.erase(i);
+    p->ForEachMiddlePoints([this, feature](m2::PointD const & pt) { AddKeyPoint(pt, feature); });
   }
 }
 
-void FeatureMergeProcessor::Remove(MergedFeatureBuilder1 const * p)
+void FeatureMergeProcessor::AddKeyPoint(m2::PointD const & pt, uint32_t feature)
 {
-  key_t const k1 = get_key(p->FirstPoint());
-  key_t const k2 = get_key(p->LastPoint());
-
-  Remove(k1, p);
-  if (k1 != k2)
-    Remove(k2, p);
-  else
-  {
-    ASSERT ( p->IsRound(), () );
-
-    p->ForEachMiddlePoints(std::bind(&FeatureMergeProcessor::Remove1, this, std::placeholders::_1, p));
-  }
+  m_keyPoints.push_back({GetKey(pt), feature});
 }
 
-void FeatureMergeProcessor::DoMerge(FeatureEmitterIFace & emitter)
+void FeatureMergeProcessor::MergeType(uint32_t type, std::vector<uint32_t> const & features,
+                                      std::vector<bool> & merged,
+                                      std::vector<MergedFeatureBuilder1> & result) const
 {
-  while (!m_map.empty())
+  for (uint32_t const start : features)
   {
-    // Get any starting feature.
-    vector_t & vS = m_map.begin()->second;
-    CHECK(!vS.empty(), ());
-    MergedFeatureBuilder1 * p = vS.front();  // may be 'back' is better
-
-    // Remove next processing type. If it's a last type - remove from map.
-    uint32_t type;
-    bool isRemoved = false;
-    if (p->PopAnyType(type))
-    {
-      isRemoved = true;
-      Remove(p);
-    }
+    if (merged[start])
+      continue;
+    merged[start] = true;
 
-    // We will merge to the copy of p.
-    MergedFeatureBuilder1 curr(*p);
+    // We will merge to the copy of the feature.
+    MergedFeatureBuilder1 curr(*m_features[start]);
     curr.SetType(type);
 
     // Iterate through key points while merging.
@@ -206,71 +180,140 @@ void FeatureMergeProcessor::DoMerge(FeatureEmitterIFace & emitter)
     while (ind < curr.GetKeyPointsCount())  // GetKeyPointsCount() can be different on each iteration
     {
       pair<m2::PointD, bool> const pt = curr.GetKeyPoint(ind++);
-      map_t::const_iterator it = m_map.find(get_key(pt.first));
-
-      MergedFeatureBuilder1 * pp = 0;
-      if (it != m_map.end())
+      auto const it = m_ranges.find(GetKey(pt.first));
+      if (it == m_ranges.end())
+        continue;
+
+      // Find best feature to continue. Key points of a key are sorted by
+      // features, so the first of features with equal priorities is taken.
+      MergedFeatureBuilder1 const * pp = nullptr;
+      uint32_t best = 0;
+      double bestPr = -1.0;
+      for (uint32_t i = it->second.first; i < it->second.second; ++i)
       {
-        // Find best feature to continue.
-        double bestPr = -1.0;
-        for (size_t i = 0; i < it->second.size(); ++i)
-        {
-          MergedFeatureBuilder1 * pTest = it->second[i];
-          if (pTest->HasType(type))
-          {
-            double const pr = pTest->GetPriority();
-            // It's not necessery assert, because it's possible in source data
-//            ASSERT_GREATER ( pr, 0.0, () );
-            if (pr > bestPr)
-            {
-              pp = pTest;
-              bestPr = pr;
-            }
-          }
-        }
+        uint32_t const feature = m_keyPoints[i].m_feature;
+        if (merged[feature] || !m_features[feature]->HasType(type))
+          continue;
 
-        // Merge current feature with best feature.
-        if (pp)
+        // It's not necessery assert, because it's possible in source data
+        // ASSERT_GREATER ( pr, 0.0, () );
+        if (m_priorities[feature] > bestPr)
         {
-          bool const toBack = pt.second;
-          bool fromBegin = true;
-          if ((pt.first.SquareLength(pp->FirstPoint()) > pt.first.SquareLength(pp->LastPoint())) == toBack)
-            fromBegin = false;
+          pp = m_features[feature].get();
+          best = feature;
+          bestPr = m_priorities[feature];
+        }
+      }
 
-          curr.AppendFeature(*pp, fromBegin, toBack);
+      // Merge current feature with best feature.
+      if (pp)
+      {
+        bool const toBack = pt.second;
+        bool fromBegin = true;
+        if ((pt.first.SquareLength(pp->FirstPoint()) > pt.first.SquareLength(pp->LastPoint())) == toBack)
+          fromBegin = false;
 
-          if (pp->PopExactType(type))
-          {
-            Remove(pp);
-            delete pp;
-          }
+        curr.AppendFeature(*pp, fromBegin, toBack);
+        merged[best] = true;
 
-          // start from the beginning if we have a successful merge
-          ind = 0;
-        }
+        // start from the beginning if we have a successful merge
+        ind = 0;
       }
     }
 
-    if (m_last.NotEmpty() && m_last.EqualGeometry(curr))
-    {
-      // curr is equal with m_last by geometry - just add new type to m_last
-      if (!m_last.HasType(type))
-        m_last.AddType(type);
-    }
-    else
+    result.push_back(std::move(curr));
+  }
+
+  for (uint32_t const feature : features)
+    merged[feature] = false;
+}
+
+void FeatureMergeProcessor::DoMerge(FeatureEmitterIFace & emitter)
+{
+  std::sort(m_keyPoints.begin(), m_keyPoints.end(), [](KeyPoint const & lhs, KeyPoint const & rhs)
+  {
+    return lhs.m_key != rhs.m_key ? lhs.m_key < rhs.m_key : lhs.m_feature < rhs.m_feature;
+  });
+
+  m_ranges.clear();
+  m_ranges.reserve(m_keyPoints.size());
+  for (uint32_t first = 0, last = 0; first < m_keyPoints.size(); first = last)
+  {
+    TKey const key = m_keyPoints[first].m_key;
+    for (last = first + 1; last < m_keyPoints.size() && m_keyPoints[last].m_key == key; ++last)
+      ;
+    m_ranges.emplace(key, std::make_pair(first, last));
+  }
+
+  std::map<uint32_t, std::vector<uint32_t>> typeFeatures;
+  for (uint32_t i = 0; i < m_features.size(); ++i)
+  {
+    for (uint32_t const type : m_features[i]->GetTypes())
+      typeFeatures[type].push_back(i);
+  }
+
+  std::vector<std::pair<uint32_t, std::vector<uint32_t>>> const types(typeFeatures.begin(),
+                                                                       typeFeatures.end());
+  typeFeatures.clear();
+
+  std::vector<std::vector<MergedFeatureBuilder1>> results(types.size());
+  std::atomic<size_t> next(0);
+  auto const worker = [&]()
+  {
+    std::vector<bool> merged(m_features.size());
+    for (size_t i = next++; i < types.size(); i = next++)
+      MergeType(types[i].first, types[i].second, merged, results[i]);
+  };
+
+  size_t const threadsCount = std::min(m_threadsCount, std::max(types.size(), size_t{1}));
+  std::vector<std::thread> threads;
+  for (size_t i = 1; i < threadsCount; ++i)
+    threads.emplace_back(worker);
+  worker();
+  for (auto & thread : threads)
+    thread.join();
+
+  // Unite merged features with equal geometry, just add new types to the first of them.
+  std::vector<MergedFeatureBuilder1> features;
+  std::unordered_multimap<uint64_t, size_t> geometries;
+  for (auto & result : results)
+  {
+    for (auto & curr : result)
     {
-      // emit m_last and set curr as last processed feature (m_last)
-      if (m_last.NotEmpty())
-        emitter(m_last);
-      m_last = curr;
-    }
+      auto const & geometry = curr.GetOuterGeometry();
+      uint64_t const hash =
+          coding::XXHash64::Hash(geometry.data(), geometry.size() * sizeof(m2::PointD));
+      auto const range = geometries.equal_range(hash);
+      auto const it = std::find_if(range.first, range.second,
+                                   [&](std::pair<uint64_t const, size_t> const & e)
+      {
+        return features[e.second].EqualGeometry(curr);
+      });
 
-    // Delete if the feature was removed from map.
-    if (isRemoved) delete p;
+      if (it != range.second)
+      {
+        auto & same = features[it->second];
+        for (uint32_t const type : curr.GetTypes())
+        {
+          if (!same.HasType(type))
+            same.AddType(type);
+        }
+        continue;
+      }
+
+      geometries.emplace(hash, features.size());
+      features.push_back(std::move(curr));
+    }
+    result.clear();
   }
 
-  if (m_last.NotEmpty())
-    emitter(m_last);
+  for (auto const & fb : features)
+    emitter(fb);
+
+  m_features.clear();
+  m_priorities.clear();
+  m_keyPoints.clear();
+  m_ranges.clear();
 }
 
 uint32_t FeatureTypesProcessor::GetType(char const * arr[], size_t n)
@@ -2,8 +2,12 @@
 #include "generator/feature_emitter_iface.hpp"
 #include "generator/feature_builder.hpp"
 
+#include <cstdint>
 #include <map>
+#include <memory>
 #include <set>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 /// Feature builder class that used while feature type processing and merging.
@@ -53,30 +57,43 @@ public:
 };
 
 /// Feature merger.
+///
+/// Features are merged independently for each type, a feature with several
+/// types takes part in merging of each of them. Key points of features are
+/// kept in one array sorted by keys with a hash table of ranges of keys,
+/// so candidates to continue a feature are found by one lookup. Types are
+/// merged on several threads, and results with equal geometry are united.
 class FeatureMergeProcessor
 {
-  typedef int64_t key_t;
-  key_t get_key(m2::PointD const & p);
+  using TKey = int64_t;
 
-  MergedFeatureBuilder1 m_last;
+  struct KeyPoint
+  {
+    TKey m_key;
+    uint32_t m_feature;
+  };
 
-  typedef std::vector<MergedFeatureBuilder1 *> vector_t;
-  typedef std::map<key_t, vector_t> map_t;
-  map_t m_map;
+  TKey GetKey(m2::PointD const & p) const;
 
-  void Insert(m2::PointD const & pt, MergedFeatureBuilder1 * p);
+  void AddKeyPoint(m2::PointD const & pt, uint32_t feature);
 
-  void Remove(key_t key, MergedFeatureBuilder1 const * p);
-  inline void Remove1(m2::PointD const & pt, MergedFeatureBuilder1 const * p)
-  {
-    Remove(get_key(pt), p);
-  }
-  void Remove(MergedFeatureBuilder1 const * p);
+  // Merges features with |type|. |features| are indices of the features,
+  // |merged| is a flag for every feature which is reset on return.
+  void MergeType(uint32_t type, std::vector<uint32_t> const & features,
+                 std::vector<bool> & merged, std::vector<MergedFeatureBuilder1> & result) const;
+
+  std::vector<std::unique_ptr<MergedFeatureBuilder1>> m_features;
+  // Priorities don't change while merging, so they are calculated once.
+  std::vector<double> m_priorities;
+  std::vector<KeyPoint> m_keyPoints;
+  // Ranges of |m_keyPoints| by keys.
+  std::unordered_map<TKey, std::pair<uint32_t, uint32_t>> m_ranges;
 
   uint32_t m_coordBits;
+  size_t m_threadsCount;
 
 public:
-  FeatureMergeProcessor(uint32_t coordBits);
+  FeatureMergeProcessor(uint32_t coordBits, size_t threadsCount = 1);
 
   void operator() (FeatureBuilder1 const & fb);
   void operator() (MergedFeatureBuilder1 * p);
@@ -22,16 +22,21 @@
 #include "coding/internal/file_data.hpp"
 #include "coding/file_container.hpp"
 #include "coding/file_name_utils.hpp"
+#include "coding/file_sort.hpp"
+#include "coding/writer.hpp"
 
 #include "base/assert.hpp"
 #include "base/logging.hpp"
 #include "base/scope_guard.hpp"
 #include "base/string_utils.hpp"
 
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
 namespace
 {
-  typedef pair<uint64_t, uint64_t> CellAndOffsetT;
-
   class CalculateMidPoints
   {
     m2::PointD m_midLoc, m_midAll;
@@ -44,9 +49,8 @@ namespace
     {
     }
 
-    vector<CellAndOffsetT> m_vec;
-
-    void operator() (FeatureBuilder1 const & ft, uint64_t pos)
+    /// @return false if the feature is skipped, otherwise |order| is a key to sort features.
+    bool operator() (FeatureBuilder1 const & ft, uint64_t & order)
     {
       // reset state
       m_midLoc = m2::PointD(0, 0);
@@ -60,11 +64,11 @@ namespace
 
       /// May be invisible if it's small area object with [0-9] scales.
       /// @todo Probably, we need to keep that objects if 9 scale (as we do in 17 scale).
-      if (minScale != -1 || feature::RequireGeometryInIndex(ft.GetFeatureBase()))
-      {
-        uint64_t const order = (static_cast<uint64_t>(minScale) << 59) | (pointAsInt64 >> 5);
-        m_vec.push_back(make_pair(order, pos));
-      }
+      if (minScale == -1 && !feature::RequireGeometryInIndex(ft.GetFeatureBase()))
+        return false;
+
+      order = (static_cast<uint64_t>(minScale) << 59) | (pointAsInt64 >> 5);
+      return true;
     }
 
     bool operator() (m2::PointD const & p)
@@ -78,11 +82,6 @@ namespace
 
     m2::PointD GetCenter() const { return m_midAll / m_allCount; }
   };
-
-  bool SortMidPointsFunc(CellAndOffsetT const & c1, CellAndOffsetT const & c2)
-  {
-    return c1.first < c2.first;
-  }
 }
 
 namespace feature
@@ -203,13 +202,19 @@ namespace feature
     typedef vector<m2::PointD> points_t;
     typedef list<points_t> polygons_t;
 
+    // Geometry of a feature which is simplified and serialized for all scales.
+    // It doesn't touch the collector, so features may be processed on several
+    // threads, serialized outer geometry is appended to files by WriteFeature().
     class GeometryHolder
     {
     public:
+      // Serialized outer geometry with the index of the scale.
+      using TBlobs = vector<pair<int, vector<char>>>;
+
       FeatureBuilder2::SupportingData m_buffer;
+      TBlobs m_ptsBlobs, m_trgBlobs;
 
     private:
-      FeaturesCollector2 & m_rMain;
       FeatureBuilder2 & m_rFB;
 
       points_t m_current;
@@ -229,8 +234,9 @@ namespace feature
         points_t toSave(points.begin() + 1, points.end());
 
         m_buffer.m_ptsMask |= (1 << i);
-        m_buffer.m_ptsOffset.push_back(m_rMain.GetFileSize(*m_rMain.m_geoFile[i]));
-        serial::SaveOuterPath(toSave, cp, *m_rMain.m_geoFile[i]);
+        m_ptsBlobs.emplace_back(i, vector<char>());
+        MemWriter<vector<char>> w(m_ptsBlobs.back().second);
+        serial::SaveOuterPath(toSave, cp, w);
       }
 
       void WriteOuterTriangles(polygons_t const & polys, int i)
@@ -262,10 +268,11 @@ namespace feature
 
         //CHECK_LESS_OR_EQUAL(saver.GetBufferSize(), checkSaver.GetBufferSize(), ());
 
-        // saving to file
+        // saving to buffer
         m_buffer.m_trgMask |= (1 << i);
-        m_buffer.m_trgOffset.push_back(m_rMain.GetFileSize(*m_rMain.m_trgFile[i]));
-        saver.Save(*m_rMain.m_trgFile[i]);
+        m_trgBlobs.emplace_back(i, vector<char>());
+        MemWriter<vector<char>> w(m_trgBlobs.back().second);
+        saver.Save(w);
       }
 
       void FillInnerPointsMask(points_t const & points, uint32_t scaleIndex)
@@ -314,14 +321,13 @@ namespace feature
       };
 
     public:
-      GeometryHolder(FeaturesCollector2 & rMain,
-                     FeatureBuilder2 & fb,
-                     DataHeader const & header)
-        : m_rMain(rMain), m_rFB(fb), m_header(header),
-          m_ptsInner(true), m_trgInner(true)
+      GeometryHolder(FeatureBuilder2 & fb, DataHeader const & header)
+        : m_rFB(fb), m_header(header), m_ptsInner(true), m_trgInner(true)
       {
       }
 
+      FeatureBuilder2 & GetFeatureBuilder() { return m_rFB; }
+
       points_t const & GetSourcePoints()
       {
         return (!m_current.empty() ? m_current : m_rFB.GetOuterGeometry());
@@ -405,8 +411,8 @@ namespace feature
       }
     };
 
-    void SimplifyPoints(points_t const & in, points_t & out, int level,
-                        bool isCoast, m2::RectD const & rect)
+    static void SimplifyPoints(points_t const & in, points_t & out, int level,
+                               bool isCoast, m2::RectD const & rect)
     {
       if (isCoast)
       {
@@ -420,6 +426,21 @@ namespace feature
       }
     }
 
+    static void SimplifyPoints(points_t const & in, vector<int> const & levels,
+                               vector<points_t> & out, bool isCoast, m2::RectD const & rect)
+    {
+      if (isCoast)
+      {
+        BoundsDistance dist(rect);
+        feature::SimplifyPoints(dist, in, levels, out);
+      }
+      else
+      {
+        m2::DistanceToLineSquare<m2::PointD> dist;
+        feature::SimplifyPoints(dist, in, levels, out);
+      }
+    }
+
     static double CalcSquare(points_t const & poly)
     {
       ASSERT ( poly.front() == poly.back(), () );
@@ -446,31 +467,62 @@ namespace feature
 
     bool IsCountry() const { return m_header.GetType() == feature::DataHeader::country; }
 
-  public:
-    uint32_t operator()(FeatureBuilder2 & fb)
+    // Simplifies and tesselates geometry of the feature for all scales.
+    // It's safe to call ProcessGeometry() for different holders concurrently.
+    void ProcessGeometry(GeometryHolder & holder) const
     {
-      GeometryHolder holder(*this, fb, m_header);
+      FeatureBuilder2 & fb = holder.GetFeatureBuilder();
 
       bool const isLine = fb.IsLine();
       bool const isArea = fb.IsArea();
 
+      bool const isCoast = fb.IsCoastCell();
+      m2::RectD const rect = fb.GetLimitRect();
+
       int const scalesStart = static_cast<int>(m_header.GetScalesCount()) - 1;
+      auto const isDrawable = [&](int i)
+      {
+        return fb.IsDrawableInRange(i > 0 ? m_header.GetScale(i - 1) + 1 : 0,
+                                    PatchScaleBound(m_header.GetScale(i)));
+      };
+      // Do not change linear geometry for the upper scale.
+      auto const keepSourcePoints = [&](int i)
+      {
+        return isLine && i == scalesStart && IsCountry() && fb.IsRoad();
+      };
+
+      // Source points are simplified for all scales in one pass.
+      vector<int> levels;
+      vector<int> scaleIndices;
       for (int i = scalesStart; i >= 0; --i)
       {
-        int const level = m_header.GetScale(i);
-        if (fb.IsDrawableInRange(i > 0 ? m_header.GetScale(i-1) + 1 : 0, PatchScaleBound(level)))
+        if (isDrawable(i) && !keepSourcePoints(i))
         {
-          bool const isCoast = fb.IsCoastCell();
-          m2::RectD const rect = fb.GetLimitRect();
+          levels.push_back(m_header.GetScale(i));
+          scaleIndices.push_back(i);
+        }
+      }
+      vector<points_t> simplifiedPoints;
+      SimplifyPoints(holder.GetSourcePoints(), levels, simplifiedPoints, isCoast, rect);
 
+      for (int i = scalesStart; i >= 0; --i)
+      {
+        int const level = m_header.GetScale(i);
+        if (isDrawable(i))
+        {
           // Simplify and serialize geometry.
           points_t points;
 
-          // Do not change linear geometry for the upper scale.
-          if (isLine && i == scalesStart && IsCountry() && fb.IsRoad())
+          if (keepSourcePoints(i))
+          {
             points = holder.GetSourcePoints();
+          }
           else
-            SimplifyPoints(holder.GetSourcePoints(), points, level, isCoast, rect);
+          {
+            auto const it = find(scaleIndices.begin(), scaleIndices.end(), i);
+            CHECK(it != scaleIndices.end(), ());
+            points.swap(simplifiedPoints[distance(scaleIndices.begin(), it)]);
+          }
 
           if (isLine)
             holder.AddPoints(points, i);
@@ -520,6 +572,25 @@ namespace feature
           }
         }
       }
+    }
+
+    void WriteGeometry(GeometryHolder::TBlobs const & blobs, TmpFiles & files,
+                       vector<uint32_t> & offsets)
+    {
+      for (auto const & blob : blobs)
+      {
+        TmpFile & file = *files[blob.first];
+        offsets.push_back(GetFileSize(file));
+        file.Write(blob.second.data(), blob.second.size());
+      }
+    }
+
+    uint32_t WriteFeature(GeometryHolder & holder)
+    {
+      FeatureBuilder2 & fb = holder.GetFeatureBuilder();
+
+      WriteGeometry(holder.m_ptsBlobs, m_geoFile, holder.m_buffer.m_ptsOffset);
+      WriteGeometry(holder.m_trgBlobs, m_trgFile, holder.m_buffer.m_trgOffset);
 
       uint32_t featureId = kInvalidFeatureId;
       if (fb.PreSerialize(holder.m_buffer))
@@ -549,30 +620,103 @@ namespace feature
       };
       return featureId;
     }
-  };
 
-  /// Simplify geometry for the upper scale.
-  FeatureBuilder2 & GetFeatureBuilder2(FeatureBuilder1 & fb)
-  {
-    return static_cast<FeatureBuilder2 &>(fb);
-  }
+  public:
+    uint32_t operator()(FeatureBuilder2 & fb)
+    {
+      GeometryHolder holder(fb, m_header);
+      ProcessGeometry(holder);
+      return WriteFeature(holder);
+    }
+
+    // Processes geometry of |features| on |threadsCount| threads and writes
+    // features in the order of |features| as soon as they are ready, so the
+    // result is the same as when features are passed to operator() one by one.
+    void operator()(vector<FeatureBuilder1> & features, size_t threadsCount)
+    {
+      if (threadsCount <= 1)
+      {
+        for (auto & f : features)
+          (*this)(static_cast<FeatureBuilder2 &>(f));
+        return;
+      }
+
+      vector<unique_ptr<GeometryHolder>> holders(features.size());
+      std::mutex holdersMutex;
+      std::condition_variable holderReady;
+      std::atomic<size_t> next(0);
+
+      vector<std::thread> workers;
+      MY_SCOPE_GUARD(joinWorkers, [&]()
+      {
+        // Workers stop after current features when writing fails.
+        next = features.size();
+        for (auto & worker : workers)
+          worker.join();
+      });
+
+      for (size_t i = 0; i < threadsCount; ++i)
+      {
+        workers.emplace_back([&]()
+        {
+          for (size_t j = next++; j < features.size(); j = next++)
+          {
+            auto holder = make_unique<GeometryHolder>(static_cast<FeatureBuilder2 &>(features[j]),
+                                                      m_header);
+            ProcessGeometry(*holder);
+            {
+              std::lock_guard<std::mutex> lock(holdersMutex);
+              holders[j] = move(holder);
+            }
+            holderReady.notify_one();
+          }
+        });
+      }
+
+      for (size_t i = 0; i < features.size(); ++i)
+      {
+        unique_ptr<GeometryHolder> holder;
+        {
+          std::unique_lock<std::mutex> lock(holdersMutex);
+          holderReady.wait(lock, [&]() { return holders[i] != nullptr; });
+          holder = move(holders[i]);
+        }
+        WriteFeature(*holder);
+      }
+    }
+  };
 
   bool GenerateFinalFeatures(feature::GenerateInfo const & info, std::string const & name, int mapType)
   {
     std::string const srcFilePath = info.GetTmpFileName(name);
     std::string const datFilePath = info.GetTargetFileName(name);
 
-    // stores cellIds for middle points
+    // Sort features by their middle point. Features which don't fit in memory are
+    // sorted in a temporary file, so the dat file is read sequentially only once.
     CalculateMidPoints midPoints;
-    ForEachFromDatRawFormat(srcFilePath, midPoints);
+    RecordsFileSorter<uint64_t> sorter(static_cast<size_t>(info.m_featuresSortBufferBytes),
+                                       info.GetTmpFileName(name, FEATURES_SORT_FILE_EXTENSION));
+    {
+      FileReader reader(srcFilePath);
+      ReaderSource<FileReader> src(reader);
 
-    // sort features by their middle point
-    sort(midPoints.m_vec.begin(), midPoints.m_vec.end(), &SortMidPointsFunc);
+      FeatureBuilder1::TBuffer buffer;
+      while (src.Size() > 0)
+      {
+        buffer.resize(ReadVarUint<uint32_t>(src));
+        src.Read(buffer.data(), buffer.size());
+
+        FeatureBuilder1 fb;
+        fb.Deserialize(buffer);
+
+        uint64_t order;
+        if (midPoints(fb, order))
+          sorter.Add(order, buffer.data(), buffer.size());
+      }
+    }
 
     // store sorted features
     {
-      FileReader reader(srcFilePath);
-
       bool const isWorld = (mapType != DataHeader::country);
 
       // Fill mwm header.
@@ -604,17 +748,26 @@ namespace feature
       {
         FeaturesCollector2 collector(datFilePath, header, regionData, info.m_versionDate);
 
-        for (size_t i = 0; i < midPoints.m_vec.size(); ++i)
+        // Features are read by batches to process their geometry on several threads.
+        size_t const kBatchSize = 4096;
+        vector<FeatureBuilder1> features;
+        features.reserve(kBatchSize);
+        FeatureBuilder1::TBuffer buffer;
+        sorter.SortAndFinish([&](uint64_t /* order */, char const * data, size_t size)
         {
-          ReaderSource<FileReader> src(reader);
-          src.Skip(midPoints.m_vec[i].second);
-
-          FeatureBuilder1 f;
-          ReadFromSourceRowFormat(src, f);
+          buffer.assign(data, data + size);
+          features.emplace_back();
+          features.back().Deserialize(buffer);
 
-          // emit the feature
-          collector(GetFeatureBuilder2(f));
-        }
+          // emit features
+          if (features.size() == kBatchSize)
+          {
+            collector(features, info.m_geometryThreadsCount);
+            features.clear();
+          }
+        });
+        if (!features.empty())
+          collector(features, info.m_geometryThreadsCount);
 
         collector.Finish();
       }
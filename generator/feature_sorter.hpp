@@ -8,6 +8,7 @@
 #include "indexer/scales.hpp"
 
 #include <string>
+#include <vector>
 
 
 namespace feature
@@ -72,4 +73,35 @@ namespace feature
       CHECK ( are_points_equal(in.back(), out.back()), () );
     }
   }
+
+  /// Same as SimplifyPoints() for every level from |levels|, but in one pass by |in|.
+  template <class DistanceT, class PointsContainerT>
+  void SimplifyPoints(DistanceT dist, PointsContainerT const & in, std::vector<int> const & levels,
+                      std::vector<PointsContainerT> & out)
+  {
+    out.assign(levels.size(), PointsContainerT());
+    if (in.size() < 2)
+      return;
+
+    std::vector<double> epsilons;
+    std::vector<AccumulateSkipSmallTrg<DistanceT, m2::PointD>> accumulators;
+    for (size_t i = 0; i < levels.size(); ++i)
+    {
+      epsilons.push_back(my::sq(scales::GetEpsilonForSimplify(levels[i])));
+      accumulators.emplace_back(dist, out[i], epsilons.back());
+    }
+
+    SimplifyNearOptimalForEpsilons(20, in.begin(), in.end(), epsilons, dist,
+                                   [&accumulators](size_t i, m2::PointD const & p)
+                                   {
+                                     accumulators[i](p);
+                                   });
+
+    for (auto const & points : out)
+    {
+      CHECK_GREATER ( points.size(), 1, () );
+      CHECK ( are_points_equal(in.front(), points.front()), () );
+      CHECK ( are_points_equal(in.back(), points.back()), () );
+    }
+  }
 }
@@ -17,13 +17,15 @@ struct GenerateInfo
   {
     Memory,
     Index,
-    File
+    File,
+    Packed
   };
 
   enum class OsmSourceType
   {
     XML,
-    O5M
+    O5M,
+    PBF
   };
 
   // Directory for .mwm.tmp files.
@@ -48,6 +50,17 @@ struct GenerateInfo
 
   uint32_t m_versionDate = 0;
 
+  // Count of threads which decode osm data.
+  uint32_t m_threadsCount = 1;
+  // Count of threads which simplify and tesselate geometry of a country.
+  uint32_t m_geometryThreadsCount = 1;
+  // Count of threads which split features by country polygons.
+  uint32_t m_polygonizerThreadsCount = 1;
+  // Count of threads which merge linear features of the world by types.
+  uint32_t m_mergerThreadsCount = 1;
+  // Memory for sorting features of a country, the rest is sorted in a temporary file.
+  uint64_t m_featuresSortBufferBytes = 512 * 1024 * 1024;
+
   std::vector<std::string> m_bucketNames;
 
   bool m_createWorld = false;
@@ -67,6 +80,8 @@ struct GenerateInfo
       m_osmFileType = OsmSourceType::XML;
     else if (type == "o5m")
       m_osmFileType = OsmSourceType::O5M;
+    else if (type == "pbf")
+      m_osmFileType = OsmSourceType::PBF;
     else
       LOG(LCRITICAL, ("Unknown source type:", type));
   }
@@ -79,6 +94,8 @@ struct GenerateInfo
       m_nodeStorageType = NodeStorageType::Index;
     else if (type == "mem")
       m_nodeStorageType = NodeStorageType::Memory;
+    else if (type == "packed")
+      m_nodeStorageType = NodeStorageType::Packed;
     else
       LOG(LCRITICAL, ("Incorrect node_storage type:", type));
   }
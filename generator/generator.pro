@@ -23,18 +23,25 @@ SOURCES += \
     centers_table_builder.cpp \
     check_model.cpp \
     coastlines_generator.cpp \
+    countries_scheduler.cpp \
     dumper.cpp \
     feature_builder.cpp \
     feature_generator.cpp \
     feature_merger.cpp \
     feature_sorter.cpp \
+    hotels_table_builder.cpp \
+    house_numbers_index_builder.cpp \
+    latlon_bands_index.cpp \
+    localities_grid_builder.cpp \
     metalines_builder.cpp \
     opentable_dataset.cpp \
     opentable_scoring.cpp \
     osm2meta.cpp \
     osm2type.cpp \
+    osm_change.cpp \
     osm_element.cpp \
     osm_id.cpp \
+    osm_pbf_source.cpp \
     osm_source.cpp \
     region_meta.cpp \
     restriction_collector.cpp \
@@ -45,8 +52,11 @@ SOURCES += \
     routing_helpers.cpp \
     routing_index_generator.cpp \
     search_index_builder.cpp \
+    speed_cameras_generator.cpp \
+    speed_profiles_generator.cpp \
     sponsored_scoring.cpp \
     srtm_parser.cpp \
+    stages_profiler.cpp \
     statistics.cpp \
     tesselator.cpp \
     towns_dumper.cpp \
@@ -66,6 +76,7 @@ HEADERS += \
     centers_table_builder.hpp \
     check_model.hpp \
     coastlines_generator.hpp \
+    countries_scheduler.hpp \
     dumper.hpp \
     feature_builder.hpp \
     feature_emitter_iface.hpp \
@@ -74,15 +85,21 @@ HEADERS += \
     feature_sorter.hpp \
     gen_mwm_info.hpp \
     generate_info.hpp \
+    hotels_table_builder.hpp \
+    house_numbers_index_builder.hpp \
     intermediate_data.hpp\
     intermediate_elements.hpp\
+    latlon_bands_index.hpp \
+    localities_grid_builder.hpp \
     metalines_builder.hpp \
     opentable_dataset.hpp \
     osm2meta.hpp \
     osm2type.hpp \
+    osm_change.hpp \
     osm_element.hpp \
     osm_id.hpp \
     osm_o5m_source.hpp \
+    osm_pbf_source.hpp \
     osm_translator.hpp \
     osm_xml_source.hpp \
     polygonizer.hpp \
@@ -95,11 +112,14 @@ HEADERS += \
     routing_helpers.hpp \
     routing_index_generator.hpp \
     search_index_builder.hpp \
+    speed_cameras_generator.hpp \
+    speed_profiles_generator.hpp \
     sponsored_dataset.hpp \
     sponsored_dataset_inl.hpp \
     sponsored_object_storage.hpp \
     sponsored_scoring.hpp \
     srtm_parser.hpp \
+    stages_profiler.hpp \
     statistics.hpp \
     tag_admixer.hpp \
     tesselator.hpp \
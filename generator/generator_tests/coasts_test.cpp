@@ -1,5 +1,6 @@
 #include "testing/testing.hpp"
 
+#include "generator/coastlines_generator.hpp"
 #include "generator/feature_builder.hpp"
 #include "generator/feature_sorter.hpp"
 #include "generator/feature_generator.hpp"
@@ -11,6 +12,9 @@
 #include "geometry/cellid.hpp"
 
 #include "base/logging.hpp"
+#include "base/math.hpp"
+
+#include <cmath>
 
 using namespace std;
 
@@ -95,6 +99,37 @@ UNIT_TEST(CellID_CheckRectPoints)
   }
 }
 
+UNIT_TEST(CoastlineFeaturesGenerator_CellsOrder)
+{
+  CoastlineFeaturesGenerator generator(0 /* coastType */);
+
+  // An island with so many points that cells which contain it are split.
+  size_t const kPointsCount = 30000;
+  FeatureBuilder1 island;
+  for (size_t i = 0; i <= kPointsCount; ++i)
+  {
+    double const angle = 2 * math::pi * (i % kPointsCount) / kPointsCount;
+    island.AddPoint(m2::PointD(10 + 5 * cos(angle), 10 + 5 * sin(angle)));
+  }
+  island.SetArea();
+  generator(island);
+  TEST(generator.Finish(), ());
+
+  vector<FeatureBuilder1> features;
+  generator.GetFeatures(features);
+  TEST_GREATER(features.size(), RectId::TotalCellsOnLevel(4), ());
+
+  // Cells go in the preorder of the cells tree.
+  for (size_t i = 1; i < features.size(); ++i)
+    TEST_LESS(features[i - 1].GetCoastCell(), features[i].GetCoastCell(), (i));
+
+  vector<FeatureBuilder1> again;
+  generator.GetFeatures(again);
+  TEST_EQUAL(features.size(), again.size(), ());
+  for (size_t i = 0; i < features.size(); ++i)
+    TEST(features[i] == again[i], (i));
+}
+
 namespace
 {
   class ProcessCoastsBase
@@ -0,0 +1,81 @@
+#include "testing/testing.hpp"
+
+#include "generator/countries_scheduler.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace generator;
+using namespace std;
+
+namespace
+{
+vector<CountriesScheduler::Country> MakeCountries()
+{
+  vector<CountriesScheduler::Country> countries;
+  for (size_t i = 0; i < 20; ++i)
+    countries.emplace_back("Country" + to_string(i), 10 * (i % 7) + 5);
+  countries.emplace_back("Huge", 1000);
+  return countries;
+}
+}  // namespace
+
+UNIT_TEST(CountriesScheduler_OneThread)
+{
+  auto const countries = MakeCountries();
+  vector<string> processed;
+  CountriesScheduler(1 /* threadsCount */, 10 /* memoryLimit */)
+      .Run(countries, [&processed](string const & country) { processed.push_back(country); });
+
+  TEST_EQUAL(processed.size(), countries.size(), ());
+  for (size_t i = 0; i < countries.size(); ++i)
+    TEST_EQUAL(processed[i], countries[i].m_name, ());
+}
+
+UNIT_TEST(CountriesScheduler_MemoryLimit)
+{
+  uint64_t const kMemoryLimit = 100;
+  auto const countries = MakeCountries();
+  map<string, uint64_t> memory;
+  for (auto const & country : countries)
+    memory[country.m_name] = country.m_memory;
+
+  mutex mu;
+  multiset<string> processed;
+  vector<string> startOrder;
+  uint64_t usedMemory = 0;
+  size_t runningCount = 0;
+  bool isLimitExceeded = false;
+
+  CountriesScheduler(4 /* threadsCount */, kMemoryLimit).Run(countries, [&](string const & country)
+  {
+    {
+      lock_guard<mutex> lock(mu);
+      startOrder.push_back(country);
+      ++runningCount;
+      usedMemory += memory[country];
+      // A country which doesn't fit the limit alone runs alone.
+      if (usedMemory > kMemoryLimit && runningCount > 1)
+        isLimitExceeded = true;
+    }
+
+    this_thread::sleep_for(chrono::milliseconds(1));
+
+    lock_guard<mutex> lock(mu);
+    processed.insert(country);
+    --runningCount;
+    usedMemory -= memory[country];
+  });
+
+  TEST(!isLimitExceeded, ());
+  TEST_EQUAL(processed.size(), countries.size(), ());
+  for (auto const & country : countries)
+    TEST_EQUAL(processed.count(country.m_name), 1, (country.m_name));
+  TEST_EQUAL(startOrder.front(), "Huge", ());
+}
@@ -19,6 +19,8 @@ namespace
 
     size_t GetSize() const { return m_vec.size(); }
 
+    bool operator==(VectorEmitter const & rhs) const { return m_vec == rhs.m_vec; }
+
     void Check(uint32_t type, size_t count) const
     {
       size_t test = 0;
@@ -187,3 +189,47 @@ UNIT_TEST(FeatureMerger_Rounds)
 
   TEST_EQUAL(emitter.GetSize(), 1, ());
 }
+
+UNIT_TEST(FeatureMerger_Threads)
+{
+  classificator::Load();
+
+  // A grid of linear features, every feature has one of two types and
+  // some of them have a third type.
+  vector<FeatureBuilder1> vF;
+  for (int i = 0; i < 20; ++i)
+  {
+    for (int j = 0; j < 20; ++j)
+    {
+      vF.push_back(FeatureBuilder1());
+      vF.back().AddPoint(P(i, j));
+      vF.back().AddPoint(P(i + 1, j));
+      vF.back().SetLinear();
+      vF.back().AddType(j % 2);
+      if (i % 3 == 0)
+        vF.back().AddType(2);
+    }
+  }
+
+  auto const merge = [&vF](size_t threadsCount)
+  {
+    FeatureMergeProcessor processor(POINT_COORD_BITS, threadsCount);
+    for (auto const & fb : vF)
+      processor(fb);
+
+    VectorEmitter emitter;
+    processor.DoMerge(emitter);
+    return emitter;
+  };
+
+  VectorEmitter const single = merge(1 /* threadsCount */);
+  // Rows of each of two types are merged to one feature, type 2 is on
+  // every third segment of every row, so it's not merged.
+  TEST_EQUAL(single.GetSize(), 20 + 20 * 7, ());
+  single.Check(0, 10);
+  single.Check(1, 10);
+  single.Check(2, 20 * 7);
+
+  for (size_t threadsCount : {2, 4, 8})
+    TEST(merge(threadsCount) == single, (threadsCount));
+}
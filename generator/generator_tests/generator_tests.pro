@@ -32,12 +32,17 @@ SOURCES += \
     altitude_test.cpp \
     check_mwms.cpp \
     coasts_test.cpp \
+    countries_scheduler_test.cpp \
     feature_builder_test.cpp \
     feature_merger_test.cpp \
+    intermediate_data_test.cpp \
+    latlon_bands_index_test.cpp \
     metadata_parser_test.cpp \
     osm2meta_test.cpp \
+    osm_change_test.cpp \
     osm_id_test.cpp \
     osm_o5m_source_test.cpp \
+    osm_pbf_source_test.cpp \
     osm_type_test.cpp \
     road_access_test.cpp \
     restriction_collector_test.cpp \
@@ -45,6 +50,7 @@ SOURCES += \
     source_data.cpp \
     source_to_element_test.cpp \
     srtm_parser_test.cpp \
+    stages_profiler_test.cpp \
     tag_admixer_test.cpp \
     tesselator_test.cpp \
     triangles_tree_coding_test.cpp \
@@ -8,8 +8,15 @@
 
 #include "testing/testing.hpp"
 
+#include "generator/intermediate_data.hpp"
 #include "generator/intermediate_elements.hpp"
 
+#include "platform/platform_tests_support/scoped_file.hpp"
+
+#include <cstdint>
+#include <map>
+#include <utility>
+
 
 UNIT_TEST(Intermediate_Data_empty_way_element_save_load_test)
 {
@@ -99,3 +106,53 @@ UNIT_TEST(Intermediate_Data_relation_element_save_load_test)
   TEST_NOT_EQUAL(e2.tags["key1old"], "value1old", ());
   TEST_NOT_EQUAL(e2.tags["key2old"], "value2old", ());
 }
+
+UNIT_TEST(Intermediate_Data_packed_point_storage_test)
+{
+  std::string const kFileName = "intermediate_data_test_nodes";
+  platform::tests_support::ScopedFile const scopedFile(kFileName + ".packed");
+  std::string const fileName = my::JoinFoldersToPath(GetPlatform().WritableDir(), kFileName);
+
+  // Ids grow with gaps of different sizes, some points are added out of order.
+  std::map<uint64_t, std::pair<double, double>> points;
+  {
+    cache::PackedFilePointStorage<cache::EMode::Write> storage(fileName);
+    uint64_t id = 1;
+    for (uint32_t i = 0; i < 10000; ++i)
+    {
+      id += (i % 7 == 0) ? 1 : i % 100;
+      if (i % 1000 == 0)
+        id += 0x100000000;
+      double const lat = -80.0 + 0.0123456 * (i % 13000);
+      double const lon = 170.0 - 0.0345678 * (i % 9000);
+      storage.AddPoint(id, lat, lon);
+      points[id] = std::make_pair(lat, lon);
+    }
+    for (uint64_t unsortedId : {3, 50, 1000})
+    {
+      storage.AddPoint(unsortedId, 1.5, 2.5);
+      points[unsortedId] = std::make_pair(1.5, 2.5);
+    }
+  }
+
+  cache::PackedFilePointStorage<cache::EMode::Read> const storage(fileName);
+  for (auto const & point : points)
+  {
+    double lat = 0.0;
+    double lon = 0.0;
+    TEST(storage.GetPoint(point.first, lat, lon), (point.first));
+    TEST(my::AlmostEqualAbs(lat, point.second.first, 1e-7), (point.first, lat));
+    TEST(my::AlmostEqualAbs(lon, point.second.second, 1e-7), (point.first, lon));
+  }
+
+  // Missing points are logged as errors.
+  my::ScopedLogAbortLevelChanger const logAbortLevel;
+  double lat = 0.0;
+  double lon = 0.0;
+  TEST(!storage.GetPoint(0, lat, lon), ());
+  uint64_t missingId = points.begin()->first;
+  while (points.count(missingId) != 0)
+    ++missingId;
+  TEST(!storage.GetPoint(missingId, lat, lon), ());
+  TEST(!storage.GetPoint(points.rbegin()->first + 1, lat, lon), ());
+}
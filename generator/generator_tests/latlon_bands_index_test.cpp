@@ -0,0 +1,95 @@
+#include "testing/testing.hpp"
+
+#include "generator/latlon_bands_index.hpp"
+
+#include "geometry/distance_on_sphere.hpp"
+
+#include "base/math.hpp"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace generator;
+
+namespace
+{
+std::vector<uint32_t> FindInDistance(LatLonBandsIndex const & index, ms::LatLon const & ll)
+{
+  std::vector<uint32_t> result;
+  index.ForEachInDistance(ll, [&result](uint32_t value, double /* distance */) {
+    result.push_back(value);
+  });
+  std::sort(result.begin(), result.end());
+  return result;
+}
+
+std::vector<uint32_t> FindInDistanceSlow(LatLonBandsIndex::TPoints const & points,
+                                         ms::LatLon const & ll, double distance)
+{
+  std::vector<uint32_t> result;
+  for (auto const & point : points)
+  {
+    if (ms::DistanceOnEarth(ll, point.first) <= distance)
+      result.push_back(point.second);
+  }
+  std::sort(result.begin(), result.end());
+  return result;
+}
+}  // namespace
+
+UNIT_TEST(LatLonBandsIndex_Smoke)
+{
+  LatLonBandsIndex::TPoints const points = {{ms::LatLon(55.75, 37.62), 0},
+                                            {ms::LatLon(55.7505, 37.6205), 1},
+                                            {ms::LatLon(55.76, 37.62), 2},
+                                            {ms::LatLon(0.0, 179.9999), 3},
+                                            {ms::LatLon(0.0, -179.9999), 4},
+                                            {ms::LatLon(89.9999, 0.0), 5},
+                                            {ms::LatLon(89.9999, 180.0), 6}};
+  LatLonBandsIndex const index(points, 150.0 /* distanceMeters */);
+  TEST_EQUAL(index.Size(), points.size(), ());
+
+  TEST_EQUAL(FindInDistance(index, ms::LatLon(55.75, 37.62)), std::vector<uint32_t>({0, 1}), ());
+  TEST_EQUAL(FindInDistance(index, ms::LatLon(55.76, 37.62)), std::vector<uint32_t>({2}), ());
+  TEST_EQUAL(FindInDistance(index, ms::LatLon(10.0, 10.0)), std::vector<uint32_t>(), ());
+  // Across the antimeridian.
+  TEST_EQUAL(FindInDistance(index, ms::LatLon(0.0, 180.0)), std::vector<uint32_t>({3, 4}), ());
+  // Near a pole.
+  TEST_EQUAL(FindInDistance(index, ms::LatLon(90.0, 0.0)), std::vector<uint32_t>({5, 6}), ());
+
+  TEST_EQUAL(FindInDistance(LatLonBandsIndex(), ms::LatLon(0.0, 0.0)), std::vector<uint32_t>(), ());
+}
+
+UNIT_TEST(LatLonBandsIndex_Random)
+{
+  std::mt19937 rng(0);
+  std::uniform_real_distribution<double> lat(-90.0, 90.0);
+  std::uniform_real_distribution<double> lon(-180.0, 180.0);
+  std::uniform_real_distribution<double> shift(-0.05, 0.05);
+
+  // Points are grouped in clusters, so there are many points in the distance.
+  LatLonBandsIndex::TPoints points;
+  for (uint32_t i = 0; i < 200; ++i)
+  {
+    ms::LatLon const center(lat(rng), lon(rng));
+    for (uint32_t j = 0; j < 50; ++j)
+    {
+      ms::LatLon const ll(my::clamp(center.lat + shift(rng), -90.0, 90.0),
+                          my::clamp(center.lon + shift(rng), -180.0, 180.0));
+      points.emplace_back(ll, static_cast<uint32_t>(points.size()));
+    }
+  }
+
+  for (double const distance : {150.0, 3000.0})
+  {
+    LatLonBandsIndex const index(points, distance);
+    for (size_t i = 0; i < 2000; ++i)
+    {
+      auto const & center = points[rng() % points.size()].first;
+      ms::LatLon const ll(my::clamp(center.lat + shift(rng) / 10, -90.0, 90.0),
+                          my::clamp(center.lon + shift(rng) / 10, -180.0, 180.0));
+      TEST_EQUAL(FindInDistance(index, ll), FindInDistanceSlow(points, ll, distance), (ll, distance));
+    }
+  }
+}
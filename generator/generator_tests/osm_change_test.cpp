@@ -0,0 +1,79 @@
+#include "testing/testing.hpp"
+
+#include "generator/osm_change.hpp"
+#include "generator/osm_element.hpp"
+#include "generator/osm_source.hpp"
+
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace generator;
+using namespace std;
+
+namespace
+{
+char const kOsmChange[] = R"(<?xml version="1.0" encoding="UTF-8"?>
+<osmChange version="0.6" generator="osmosis">
+  <create>
+    <node id="10" version="1" lat="55.7" lon="37.6">
+      <tag k="amenity" v="cafe"/>
+    </node>
+    <way id="20" version="1">
+      <nd ref="10"/>
+      <nd ref="11"/>
+      <tag k="highway" v="residential"/>
+    </way>
+  </create>
+  <modify>
+    <node id="11" version="3" lat="55.8" lon="37.5"/>
+    <relation id="30" version="2">
+      <member type="way" ref="20" role="outer"/>
+      <tag k="type" v="multipolygon"/>
+    </relation>
+  </modify>
+  <delete>
+    <node id="12" version="5"/>
+  </delete>
+</osmChange>
+)";
+}  // namespace
+
+UNIT_TEST(OsmChange_Process)
+{
+  istringstream ss(kOsmChange);
+  SourceReader reader(ss);
+
+  vector<pair<OsmChangeAction, OsmElement>> elements;
+  ProcessOsmChange(reader, [&elements](OsmChangeAction action, OsmElement * e)
+  {
+    elements.emplace_back(action, *e);
+  });
+
+  TEST_EQUAL(elements.size(), 5, ());
+
+  TEST_EQUAL(elements[0].first, OsmChangeAction::Create, ());
+  TEST_EQUAL(elements[0].second.type, OsmElement::EntityType::Node, ());
+  TEST_EQUAL(elements[0].second.id, 10, ());
+  TEST(my::AlmostEqualAbs(elements[0].second.lat, 55.7, 1e-7), ());
+  TEST_EQUAL(elements[0].second.Tags(), vector<OsmElement::Tag>({{"amenity", "cafe"}}), ());
+
+  TEST_EQUAL(elements[1].first, OsmChangeAction::Create, ());
+  TEST_EQUAL(elements[1].second.type, OsmElement::EntityType::Way, ());
+  TEST_EQUAL(elements[1].second.Nodes(), vector<uint64_t>({10, 11}), ());
+
+  TEST_EQUAL(elements[2].first, OsmChangeAction::Modify, ());
+  TEST_EQUAL(elements[2].second.id, 11, ());
+
+  TEST_EQUAL(elements[3].first, OsmChangeAction::Modify, ());
+  TEST_EQUAL(elements[3].second.type, OsmElement::EntityType::Relation, ());
+  auto const & members = elements[3].second.Members();
+  TEST_EQUAL(members.size(), 1, ());
+  TEST_EQUAL(members[0].ref, 20, ());
+  TEST_EQUAL(members[0].role, "outer", ());
+
+  TEST_EQUAL(elements[4].first, OsmChangeAction::Delete, ());
+  TEST_EQUAL(elements[4].second.type, OsmElement::EntityType::Node, ());
+  TEST_EQUAL(elements[4].second.id, 12, ());
+}
@@ -0,0 +1,247 @@
+#include "testing/testing.hpp"
+
+#include "generator/osm_element.hpp"
+#include "generator/osm_pbf_source.hpp"
+#include "generator/osm_source.hpp"
+
+#include "coding/zlib.hpp"
+
+#include <cstdint>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+namespace
+{
+// Writer of protobuf messages which is enough to make PBF data for tests.
+class ProtoWriter
+{
+public:
+  void Varint(uint64_t value)
+  {
+    while (value >= 0x80)
+    {
+      m_data.push_back(static_cast<char>((value & 0x7F) | 0x80));
+      value >>= 7;
+    }
+    m_data.push_back(static_cast<char>(value));
+  }
+
+  void UInt(uint32_t field, uint64_t value)
+  {
+    Varint(field << 3);
+    Varint(value);
+  }
+
+  void SInt(uint32_t field, int64_t value) { UInt(field, ZigZag(value)); }
+
+  void Bytes(uint32_t field, string const & value)
+  {
+    Varint((field << 3) | 2);
+    Varint(value.size());
+    m_data += value;
+  }
+
+  void PackedUInts(uint32_t field, vector<uint64_t> const & values)
+  {
+    ProtoWriter packed;
+    for (auto const v : values)
+      packed.Varint(v);
+    Bytes(field, packed.m_data);
+  }
+
+  // Writes values as deltas of sint64.
+  void PackedDeltas(uint32_t field, vector<int64_t> const & values)
+  {
+    ProtoWriter packed;
+    int64_t prev = 0;
+    for (auto const v : values)
+    {
+      packed.Varint(ZigZag(v - prev));
+      prev = v;
+    }
+    Bytes(field, packed.m_data);
+  }
+
+  string const & GetData() const { return m_data; }
+
+private:
+  static uint64_t ZigZag(int64_t value)
+  {
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+  }
+
+  string m_data;
+};
+
+// Block with three nodes, a way and a relation with ids starting from |firstId|.
+string MakePrimitiveBlock(int64_t firstId)
+{
+  ProtoWriter strings;
+  for (auto const & s : {"", "amenity", "cafe", "highway", "residential", "type", "multipolygon",
+                         "outer"})
+  {
+    strings.Bytes(1, s);
+  }
+
+  ProtoWriter dense;
+  dense.PackedDeltas(1, {firstId, firstId + 1, firstId + 2});
+  dense.PackedDeltas(8, {557000000, 557100000, 557200000});
+  dense.PackedDeltas(9, {376000000, 376100000, 376200000});
+  dense.PackedUInts(10, {0, 1, 2, 0, 0});
+
+  ProtoWriter way;
+  way.UInt(1, firstId + 3);
+  way.PackedUInts(2, {3});
+  way.PackedUInts(3, {4});
+  way.PackedDeltas(8, {firstId, firstId + 1, firstId + 2});
+
+  ProtoWriter relation;
+  relation.UInt(1, firstId + 4);
+  relation.PackedUInts(2, {5});
+  relation.PackedUInts(3, {6});
+  relation.PackedUInts(8, {7});
+  relation.PackedDeltas(9, {firstId + 3});
+  relation.PackedUInts(10, {1});
+
+  ProtoWriter nodesGroup;
+  nodesGroup.Bytes(2, dense.GetData());
+  ProtoWriter waysGroup;
+  waysGroup.Bytes(3, way.GetData());
+  ProtoWriter relationsGroup;
+  relationsGroup.Bytes(4, relation.GetData());
+
+  ProtoWriter block;
+  block.Bytes(1, strings.GetData());
+  block.Bytes(2, nodesGroup.GetData());
+  block.Bytes(2, waysGroup.GetData());
+  block.Bytes(2, relationsGroup.GetData());
+  return block.GetData();
+}
+
+string MakeHeaderBlock()
+{
+  ProtoWriter header;
+  header.Bytes(4, "OsmSchema-V0.6");
+  header.Bytes(4, "DenseNodes");
+  return header.GetData();
+}
+
+void WriteBlob(string const & type, string const & message, bool compress, string & output)
+{
+  ProtoWriter blob;
+  if (compress)
+  {
+    string compressed;
+    coding::ZLib::Deflate const deflate(coding::ZLib::Deflate::Format::ZLib,
+                                        coding::ZLib::Deflate::Level::BestSpeed);
+    TEST(deflate(message, back_inserter(compressed)), ());
+    blob.UInt(2, message.size());
+    blob.Bytes(3, compressed);
+  }
+  else
+  {
+    blob.Bytes(1, message);
+  }
+
+  ProtoWriter header;
+  header.Bytes(1, type);
+  header.UInt(3, blob.GetData().size());
+
+  uint32_t const size = static_cast<uint32_t>(header.GetData().size());
+  output.push_back(static_cast<char>(size >> 24));
+  output.push_back(static_cast<char>(size >> 16));
+  output.push_back(static_cast<char>(size >> 8));
+  output.push_back(static_cast<char>(size));
+  output += header.GetData();
+  output += blob.GetData();
+}
+
+vector<OsmElement> ReadPBF(string const & data, uint32_t threadsCount)
+{
+  istringstream ss(data);
+  SourceReader reader(ss);
+
+  vector<OsmElement> elements;
+  ProcessOsmElementsFromPBF(reader, [&elements](OsmElement * e)
+  {
+    elements.push_back(*e);
+  }, threadsCount);
+  return elements;
+}
+}  // namespace
+
+UNIT_TEST(OSM_PBF_Source_DecodeBlob)
+{
+  string data;
+  WriteBlob("OSMData", MakePrimitiveBlock(100 /* firstId */), true /* compress */, data);
+
+  istringstream ss(data);
+  osm::PBFSource source([&ss](uint8_t * buffer, size_t size)
+  {
+    return ss.read(reinterpret_cast<char *>(buffer), size).gcount();
+  });
+
+  osm::PBFSource::Blob blob;
+  TEST(source.ReadBlob(blob), ());
+  TEST_EQUAL(blob.m_type, "OSMData", ());
+  TEST(!source.ReadBlob(blob), ());
+
+  vector<OsmElement> elements;
+  TEST(osm::PBFSource::DecodeBlob(blob, elements), ());
+  TEST_EQUAL(elements.size(), 5, (elements));
+
+  TEST_EQUAL(elements[0].type, OsmElement::EntityType::Node, ());
+  TEST_EQUAL(elements[0].id, 100, ());
+  TEST(my::AlmostEqualAbs(elements[0].lat, 55.7, 1e-7), ());
+  TEST(my::AlmostEqualAbs(elements[0].lon, 37.6, 1e-7), ());
+  TEST(elements[0].Tags().empty(), ());
+
+  TEST_EQUAL(elements[1].id, 101, ());
+  TEST(my::AlmostEqualAbs(elements[1].lat, 55.71, 1e-7), ());
+  TEST_EQUAL(elements[1].Tags(), vector<OsmElement::Tag>({{"amenity", "cafe"}}), ());
+
+  TEST_EQUAL(elements[3].type, OsmElement::EntityType::Way, ());
+  TEST_EQUAL(elements[3].id, 103, ());
+  TEST_EQUAL(elements[3].Nodes(), vector<uint64_t>({100, 101, 102}), ());
+  TEST_EQUAL(elements[3].Tags(), vector<OsmElement::Tag>({{"highway", "residential"}}), ());
+
+  TEST_EQUAL(elements[4].type, OsmElement::EntityType::Relation, ());
+  TEST_EQUAL(elements[4].id, 104, ());
+  auto const & members = elements[4].Members();
+  TEST_EQUAL(members.size(), 1, ());
+  TEST_EQUAL(members[0].ref, 103, ());
+  TEST_EQUAL(members[0].type, OsmElement::EntityType::Way, ());
+  TEST_EQUAL(members[0].role, "outer", ());
+  TEST_EQUAL(elements[4].Tags(), vector<OsmElement::Tag>({{"type", "multipolygon"}}), ());
+
+  // A broken blob isn't decoded.
+  blob.m_data.resize(blob.m_data.size() / 2);
+  elements.clear();
+  TEST(!osm::PBFSource::DecodeBlob(blob, elements), ());
+}
+
+UNIT_TEST(OSM_PBF_Source_SeveralThreads)
+{
+  size_t const kBlocksCount = 20;
+
+  string data;
+  WriteBlob("OSMHeader", MakeHeaderBlock(), false /* compress */, data);
+  for (size_t i = 0; i < kBlocksCount; ++i)
+  {
+    WriteBlob("OSMData", MakePrimitiveBlock(10 * i + 1 /* firstId */), i % 2 == 0 /* compress */,
+              data);
+  }
+
+  auto const elements = ReadPBF(data, 1 /* threadsCount */);
+  TEST_EQUAL(elements.size(), 5 * kBlocksCount, ());
+  for (size_t i = 0; i < elements.size(); ++i)
+    TEST_EQUAL(elements[i].id, 10 * (i / 5) + i % 5 + 1, ());
+
+  // Elements are processed in the order of the file.
+  TEST_EQUAL(ReadPBF(data, 2 /* threadsCount */), elements, ());
+  TEST_EQUAL(ReadPBF(data, 5 /* threadsCount */), elements, ());
+}
@@ -66,3 +66,25 @@ UNIT_TEST(Source_To_Element_check_equivalence)
     TEST_EQUAL(elementsXML[i], elementsO5M[i], ());
   }
 }
+
+UNIT_TEST(Source_To_Element_o5m_several_threads)
+{
+  std::string src(std::begin(relation_o5m_data), std::end(relation_o5m_data));
+
+  auto const process = [&src](uint32_t threadsCount)
+  {
+    std::istringstream ss(src);
+    SourceReader reader(ss);
+
+    std::vector<OsmElement> elements;
+    ProcessOsmElementsFromO5M(reader, [&elements](OsmElement * e)
+    {
+      elements.push_back(*e);
+    }, threadsCount);
+    return elements;
+  };
+
+  auto const elements = process(1 /* threadsCount */);
+  TEST_EQUAL(elements.size(), 11, (elements));
+  TEST_EQUAL(process(4 /* threadsCount */), elements, ());
+}
@@ -2,6 +2,11 @@
 
 #include "generator/srtm_parser.hpp"
 
+#include "platform/platform.hpp"
+#include "platform/platform_tests_support/scoped_file.hpp"
+
+#include <string>
+
 using namespace generator;
 
 namespace
@@ -25,4 +30,25 @@ UNIT_TEST(FilenameTests)
   name = GetBase({-34.622358, -58.383654});
   TEST_EQUAL(name, "S35W059", ());
 }
+
+UNIT_TEST(SrtmTileManager_UncompressedTile)
+{
+  size_t const kSide = 60 * 60 + 1;
+  std::string data(kSide * kSide * sizeof(feature::TAltitude), '\0');
+
+  // Heights are big-endian, rows go from North to South, so the south-west corner
+  // of the tile is the first point of the last row.
+  size_t const ix = (kSide - 1) * kSide;
+  data[2 * ix] = 0x01;
+  data[2 * ix + 1] = 0x2C;
+  platform::tests_support::ScopedFile const tile("N55E037.hgt", data);
+
+  SrtmTileManager manager(GetPlatform().WritableDir());
+  manager.Prefetch({{55.5, 37.5}, {55.1, 37.9}, {10.5, 10.5}}, 3 /* threadsCount */);
+
+  TEST_EQUAL(manager.GetHeight({55.0, 37.0}), 300, ());
+  TEST_EQUAL(manager.GetHeight({55.5, 37.5}), 0, ());
+  // There is no tile for this point.
+  TEST_EQUAL(manager.GetHeight({10.5, 10.5}), feature::kInvalidAltitude, ());
+}
 }  // namespace
@@ -0,0 +1,60 @@
+#include "testing/testing.hpp"
+
+#include "generator/stages_profiler.hpp"
+
+#include <cstdint>
+#include <string>
+
+#include "3party/jansson/myjansson.hpp"
+
+using namespace generator;
+using namespace std;
+
+UNIT_TEST(StagesProfiler_Disabled)
+{
+  StagesProfiler profiler(false /* enabled */);
+  {
+    StagesProfiler::Stage const stage(profiler, "Country", "geometry");
+  }
+
+  my::Json const json(profiler.SerializeReport("Country"));
+  TEST_EQUAL(json_array_size(my::GetJSONObligatoryField(json.get(), "stages")), 0, ());
+}
+
+UNIT_TEST(StagesProfiler_Report)
+{
+  StagesProfiler profiler(true /* enabled */);
+  {
+    StagesProfiler::Stage const stage(profiler, "Country", "geometry");
+  }
+  {
+    StagesProfiler::Stage const stage(profiler, "Country", "index");
+  }
+  {
+    StagesProfiler::Stage const stage(profiler, "Other", "index");
+  }
+
+  my::Json const json(profiler.SerializeReport("Country"));
+  string country;
+  FromJSONObject(json.get(), "country", country);
+  TEST_EQUAL(country, "Country", ());
+
+  auto * stages = my::GetJSONObligatoryField(json.get(), "stages");
+  TEST_EQUAL(json_array_size(stages), 2, ());
+
+  string name;
+  FromJSONObject(json_array_get(stages, 0), "name", name);
+  TEST_EQUAL(name, "geometry", ());
+  FromJSONObject(json_array_get(stages, 1), "name", name);
+  TEST_EQUAL(name, "index", ());
+
+  double wallTimeSec = -1.0;
+  uint64_t peakRssBytes = 0;
+  uint64_t featuresCount = 1;
+  FromJSONObject(json_array_get(stages, 1), "wall_time_sec", wallTimeSec);
+  FromJSONObject(json_array_get(stages, 1), "peak_rss_bytes", peakRssBytes);
+  FromJSONObject(json_array_get(stages, 1), "features_count", featuresCount);
+  TEST_GREATER_OR_EQUAL(wallTimeSec, 0.0, ());
+  TEST_GREATER(peakRssBytes, 0, ());
+  TEST_EQUAL(featuresCount, 0, ());
+}
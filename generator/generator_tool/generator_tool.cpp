@@ -3,17 +3,25 @@
 #include "generator/borders_loader.hpp"
 #include "generator/centers_table_builder.hpp"
 #include "generator/check_model.hpp"
+#include "generator/countries_scheduler.hpp"
 #include "generator/dumper.hpp"
 #include "generator/feature_generator.hpp"
 #include "generator/feature_sorter.hpp"
 #include "generator/generate_info.hpp"
+#include "generator/hotels_table_builder.hpp"
+#include "generator/house_numbers_index_builder.hpp"
+#include "generator/localities_grid_builder.hpp"
 #include "generator/metalines_builder.hpp"
+#include "generator/osm_change.hpp"
 #include "generator/osm_source.hpp"
 #include "generator/restriction_generator.hpp"
 #include "generator/road_access_generator.hpp"
 #include "generator/routing_generator.hpp"
 #include "generator/routing_index_generator.hpp"
 #include "generator/search_index_builder.hpp"
+#include "generator/speed_cameras_generator.hpp"
+#include "generator/speed_profiles_generator.hpp"
+#include "generator/stages_profiler.hpp"
 #include "generator/statistics.hpp"
 #include "generator/traffic_generator.hpp"
 #include "generator/transit_generator.hpp"
@@ -21,6 +29,7 @@
 
 #include "indexer/classificator.hpp"
 #include "indexer/classificator_loader.hpp"
+#include "indexer/compressed_features_data.hpp"
 #include "indexer/data_header.hpp"
 #include "indexer/drawing_rules.hpp"
 #include "indexer/features_offsets_table.hpp"
@@ -34,13 +43,21 @@
 #include "platform/platform.hpp"
 
 #include "coding/file_name_utils.hpp"
+#include "coding/section_hashes.hpp"
 
+#include "base/scope_guard.hpp"
+#include "base/stl_helpers.hpp"
 #include "base/timer.hpp"
 
 #include "std/unique_ptr.hpp"
 
+#include <algorithm>
 #include <cstdlib>
+#include <mutex>
+#include <set>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include "defines.hpp"
 
@@ -54,14 +71,20 @@ DEFINE_bool(emit_coasts, false,
 
 // Generator settings and paths.
 DEFINE_string(osm_file_name, "", "Input osm area file.");
-DEFINE_string(osm_file_type, "xml", "Input osm area file type [xml, o5m].");
+DEFINE_string(osm_file_type, "xml", "Input osm area file type [xml, o5m, pbf].");
+DEFINE_uint64(osm_threads_count, 1,
+              "Count of threads which decode o5m and pbf data, 0 means count of cores.");
+DEFINE_string(osm_change, "",
+              "osmChange file with changes since the previous generation. Only countries affected "
+              "by the changes are regenerated, they are found by the previous intermediate data.");
 DEFINE_string(data_path, "", "Working directory, 'path_to_exe/../../data' if empty.");
 DEFINE_string(user_resource_path, "", "User defined resource path for classificator.txt and etc.");
 DEFINE_string(intermediate_data_path, "", "Path to stored nodes, ways, relations.");
 DEFINE_string(output, "", "File name for process (without 'mwm' ext).");
 DEFINE_bool(preload_cache, false, "Preload all ways and relations cache.");
 DEFINE_string(node_storage, "map",
-              "Type of storage for intermediate points representation. Available: raw, map, mem.");
+              "Type of storage for intermediate points representation. Available: raw, map, mem, "
+              "packed.");
 DEFINE_uint64(planet_version, my::SecondsSinceEpoch(),
               "Version as seconds since epoch, by default - now.");
 
@@ -72,6 +95,27 @@ DEFINE_bool(generate_geometry, false,
             "3rd pass - split and simplify geometry and triangles for features.");
 DEFINE_bool(generate_index, false, "4rd pass - generate index.");
 DEFINE_bool(generate_search_index, false, "5th pass - generate search index.");
+DEFINE_uint64(geometry_threads_count, 1,
+              "Count of threads which simplify and tesselate geometry of a country, 0 means count "
+              "of cores.");
+DEFINE_uint64(search_index_threads_count, 1,
+              "Count of threads which collect and sort names of features of a country for the "
+              "search index and calculate ranks of features, 0 means count of cores.");
+DEFINE_uint64(features_sort_buffer_mb, 512,
+              "Memory for sorting features of a country by the geometry pass, features which "
+              "don't fit in it are sorted in a temporary file.");
+DEFINE_uint64(polygonizer_threads_count, 0,
+              "Count of threads which split features by country polygons, 0 means count of "
+              "cores.");
+DEFINE_uint64(merger_threads_count, 0,
+              "Count of threads which merge linear features of the world by types, 0 means count "
+              "of cores.");
+DEFINE_uint64(threads_count, 1,
+              "Count of countries which are processed in parallel by geometry, index and search "
+              "index passes, 0 means count of cores.");
+DEFINE_uint64(memory_limit_mb, 0,
+              "Limit of predicted memory of countries which are processed in parallel, "
+              "0 means no limit.");
 DEFINE_bool(generate_world, false, "Generate separate world file.");
 DEFINE_bool(split_by_polygons, false,
             "Use countries borders to split planet by regions and countries.");
@@ -83,12 +127,27 @@ DEFINE_bool(make_cross_section, false, "Make cross section in routing file for c
 DEFINE_bool(make_routing_index, false, "Make sections with the routing information.");
 DEFINE_bool(make_cross_mwm, false,
             "Make section for cross mwm routing (for dynamic indexed routing).");
+DEFINE_bool(make_routing_shortcuts, false,
+            "Make section with precomputed weights of car routing chains (for dynamic indexed "
+            "routing).");
+DEFINE_bool(make_routing_landmarks, false,
+            "Make section with landmark distances for car routing heuristic (for dynamic "
+            "indexed routing).");
 DEFINE_bool(disable_cross_mwm_progress, false,
             "Disable log of cross mwm section building progress.");
+DEFINE_uint64(cross_mwm_threads_count, 1,
+              "Count of threads which calculate leaps of cross mwm section, 0 means count of "
+              "cores.");
 DEFINE_string(srtm_path, "",
               "Path to srtm directory. If set, generates a section with altitude information "
               "about roads.");
+DEFINE_uint64(srtm_threads_count, 1,
+              "Count of threads which load srtm tiles of roads of a country in advance, 0 means "
+              "count of cores.");
 DEFINE_string(transit_path, "", "Path to directory with transit graphs in json.");
+DEFINE_string(speed_profiles_path, "",
+              "Path to text file with speed profiles of road segments by the time of the day. "
+              "If set, generates a section with speed profiles for time-dependent car routing.");
 
 // Sponsored-related.
 DEFINE_string(booking_data, "", "Path to booking data in .tsv format.");
@@ -107,6 +166,8 @@ DEFINE_string(dump_feature_names, "", "Print all feature names by 2-letter local
 
 // Service functions.
 DEFINE_bool(generate_classif, false, "Generate classificator.");
+DEFINE_bool(generate_classif_bin, false,
+            "Precompile classificator.txt and types.txt to classificator.bin in data path.");
 DEFINE_bool(generate_packed_borders, false, "Generate packed file with country polygons.");
 DEFINE_string(unpack_borders, "", "Convert packed_polygons to a directory of polygon files (specify folder).");
 DEFINE_bool(unpack_mwm, false, "Unpack each section of mwm into a separate file with name filePath.sectionName.");
@@ -115,6 +176,23 @@ DEFINE_string(delete_section, "", "Delete specified section (defines.hpp) from c
 DEFINE_bool(generate_addresses_file, false, "Generate .addr file (for '--output' option) with full addresses list.");
 DEFINE_bool(generate_traffic_keys, false,
             "Generate keys for the traffic map (road segment -> speed group).");
+DEFINE_uint64(compress_features_data_block_kb, 0,
+              "Compress features data of mwms by blocks of the specified size in kilobytes. "
+              "Such mwms can't be read by older versions of the app.");
+DEFINE_bool(write_section_hashes, false,
+            "Write hashes of sections of mwms which are verified after download. It's the last "
+            "stage of a country, since any change of a section invalidates its hash.");
+DEFINE_uint64(section_hashes_threads_count, 0,
+              "Count of threads which hash sections of a country, 0 means count of cores.");
+DEFINE_bool(stages_report, false,
+            "Write time and resources used by generation stages of every country to "
+            "<country>.stages.json files in the intermediate data path.");
+
+namespace
+{
+// Rough ratio of memory which is needed to process a country to the size of its features.
+uint64_t const kMemoryPerFeaturesByte = 4;
+}  // namespace
 
 int main(int argc, char ** argv)
 {
@@ -154,16 +232,48 @@ int main(int argc, char ** argv)
   genInfo.m_viatorDatafileName = FLAGS_viator_data;
 
   genInfo.m_versionDate = static_cast<uint32_t>(FLAGS_planet_version);
+  genInfo.m_threadsCount = FLAGS_osm_threads_count != 0
+                               ? static_cast<uint32_t>(FLAGS_osm_threads_count)
+                               : std::max(std::thread::hardware_concurrency(), 1u);
+  genInfo.m_geometryThreadsCount = FLAGS_geometry_threads_count != 0
+                                       ? static_cast<uint32_t>(FLAGS_geometry_threads_count)
+                                       : std::max(std::thread::hardware_concurrency(), 1u);
+  genInfo.m_polygonizerThreadsCount =
+      FLAGS_polygonizer_threads_count != 0
+          ? static_cast<uint32_t>(FLAGS_polygonizer_threads_count)
+          : std::max(std::thread::hardware_concurrency(), 1u);
+  genInfo.m_mergerThreadsCount = FLAGS_merger_threads_count != 0
+                                     ? static_cast<uint32_t>(FLAGS_merger_threads_count)
+                                     : std::max(std::thread::hardware_concurrency(), 1u);
+  genInfo.m_featuresSortBufferBytes = FLAGS_features_sort_buffer_mb * 1024 * 1024;
 
   if (!FLAGS_node_storage.empty())
     genInfo.SetNodeStorageType(FLAGS_node_storage);
   if (!FLAGS_osm_file_type.empty())
     genInfo.SetOsmFileType(FLAGS_osm_file_type);
 
+  generator::StagesProfiler profiler(FLAGS_stages_report);
+  MY_SCOPE_GUARD(writeStagesReports, [&]()
+  {
+    if (profiler.IsEnabled())
+      profiler.WriteReports(genInfo.m_intermediateDir);
+  });
+  char const * const kCommonStages = generator::StagesProfiler::kCommonReportName;
+
+  // Countries are found by the intermediate data before it's regenerated.
+  std::set<std::string> affectedCountries;
+  if (!FLAGS_osm_change.empty())
+  {
+    LOG(LINFO, ("Finding countries affected by", FLAGS_osm_change));
+    if (!generator::FindCountriesAffectedByOsmChange(genInfo, FLAGS_osm_change, affectedCountries))
+      return -1;
+  }
+
   // Generate intermediate files.
   if (FLAGS_preprocess)
   {
     LOG(LINFO, ("Generating intermediate data ...."));
+    generator::StagesProfiler::Stage const stage(profiler, kCommonStages, "preprocess");
     if (!GenerateIntermediateData(genInfo))
     {
       return -1;
@@ -178,16 +288,25 @@ int main(int argc, char ** argv)
       FLAGS_generate_index || FLAGS_generate_search_index || FLAGS_calc_statistics ||
       FLAGS_type_statistics || FLAGS_dump_types || FLAGS_dump_prefixes ||
       FLAGS_dump_feature_names != "" || FLAGS_check_mwm || FLAGS_srtm_path != "" ||
-      FLAGS_make_routing_index || FLAGS_make_cross_mwm || FLAGS_generate_traffic_keys ||
-      FLAGS_transit_path != "")
+      FLAGS_make_routing_index || FLAGS_make_cross_mwm || FLAGS_make_routing_shortcuts ||
+      FLAGS_make_routing_landmarks || FLAGS_generate_traffic_keys || FLAGS_transit_path != "" ||
+      FLAGS_generate_classif_bin)
   {
     classificator::Load();
     classif().SortClassificator();
   }
 
+  if (FLAGS_generate_classif_bin)
+  {
+    std::string const filePath = my::JoinFoldersToPath(path, CLASSIFICATOR_BIN_FILE);
+    LOG(LINFO, ("Writing precompiled classificator to", filePath));
+    classificator::SaveBinary(filePath);
+  }
+
   // Load mwm tree only if we need it
   std::unique_ptr<storage::CountryParentGetter> countryParentGetter;
-  if (FLAGS_make_routing_index || FLAGS_make_cross_mwm)
+  if (FLAGS_make_routing_index || FLAGS_make_cross_mwm || FLAGS_make_routing_shortcuts ||
+      FLAGS_make_routing_landmarks)
   {
     countryParentGetter =
         make_unique<storage::CountryParentGetter>();
@@ -205,8 +324,12 @@ int main(int argc, char ** argv)
     genInfo.m_fileName = FLAGS_output;
     genInfo.m_genAddresses = FLAGS_generate_addresses_file;
 
-    if (!GenerateFeatures(genInfo))
-      return -1;
+    {
+      generator::StagesProfiler::Stage const stage(
+          profiler, kCommonStages, FLAGS_generate_features ? "features" : "coasts");
+      if (!GenerateFeatures(genInfo))
+        return -1;
+    }
 
     if (FLAGS_generate_world)
     {
@@ -220,11 +343,37 @@ int main(int argc, char ** argv)
       genInfo.m_bucketNames.push_back(FLAGS_output);
   }
 
-  // Enumerate over all dat files that were created.
-  size_t const count = genInfo.m_bucketNames.size();
-  for (size_t i = 0; i < count; ++i)
+  // Mwms of other countries are left from the previous generation. World files
+  // are made of features of all countries, so they are always regenerated.
+  if (!FLAGS_osm_change.empty())
+  {
+    my::EraseIf(genInfo.m_bucketNames, [&affectedCountries](std::string const & country)
+    {
+      return country != WORLD_FILE_NAME && country != WORLD_COASTS_FILE_NAME &&
+             affectedCountries.count(country) == 0;
+    });
+    LOG(LINFO, ("Countries to regenerate:", genInfo.m_bucketNames));
+  }
+
+  size_t const searchIndexThreadsCount =
+      FLAGS_search_index_threads_count != 0
+          ? static_cast<size_t>(FLAGS_search_index_threads_count)
+          : std::max(std::thread::hardware_concurrency(), 1u);
+
+  size_t const srtmThreadsCount = FLAGS_srtm_threads_count != 0
+                                     ? static_cast<size_t>(FLAGS_srtm_threads_count)
+                                     : std::max(std::thread::hardware_concurrency(), 1u);
+
+  size_t const crossMwmThreadsCount = FLAGS_cross_mwm_threads_count != 0
+                                         ? static_cast<size_t>(FLAGS_cross_mwm_threads_count)
+                                         : std::max(std::thread::hardware_concurrency(), 1u);
+
+  // Geometry, index and search index passes of different countries don't
+  // depend on each other, so they are run in parallel.
+  std::mutex failedCountriesMutex;
+  std::set<std::string> failedCountries;
+  auto const finalizeCountry = [&](std::string const & country)
   {
-    std::string const & country = genInfo.m_bucketNames[i];
     std::string const datFile = my::JoinFoldersToPath(path, country + DATA_FILE_EXTENSION);
     std::string const osmToFeatureFilename =
         genInfo.GetTargetFileName(country) + OSM2FEATURE_FILE_EXTENSION;
@@ -238,14 +387,27 @@ int main(int argc, char ** argv)
         mapType = feature::DataHeader::worldcoasts;
 
       // On error move to the next bucket without index generation.
+      auto const markFailed = [&]()
+      {
+        std::lock_guard<std::mutex> lock(failedCountriesMutex);
+        failedCountries.insert(country);
+      };
+
+      generator::StagesProfiler::Stage const stage(profiler, country, "geometry", datFile);
 
       LOG(LINFO, ("Generating result features for", country));
       if (!feature::GenerateFinalFeatures(genInfo, country, mapType))
-        continue;
+      {
+        markFailed();
+        return;
+      }
 
       LOG(LINFO, ("Generating offsets table for", datFile));
       if (!feature::BuildOffsetsTable(datFile))
-        continue;
+      {
+        markFailed();
+        return;
+      }
 
       if (mapType == feature::DataHeader::country)
       {
@@ -261,6 +423,7 @@ int main(int argc, char ** argv)
     if (FLAGS_generate_index)
     {
       LOG(LINFO, ("Generating index for", datFile));
+      generator::StagesProfiler::Stage const stage(profiler, country, "index", datFile);
 
       if (!indexer::BuildIndexFromDataFile(datFile, FLAGS_intermediate_data_path + country))
         LOG(LCRITICAL, ("Error generating index."));
@@ -269,21 +432,71 @@ int main(int argc, char ** argv)
     if (FLAGS_generate_search_index)
     {
       LOG(LINFO, ("Generating search index for", datFile));
+      generator::StagesProfiler::Stage const stage(profiler, country, "search_index", datFile);
 
-      if (!indexer::BuildSearchIndexFromDataFile(datFile, true))
+      if (!indexer::BuildSearchIndexFromDataFile(datFile, true, searchIndexThreadsCount))
         LOG(LCRITICAL, ("Error generating search index."));
 
       LOG(LINFO, ("Generating rank table for", datFile));
-      if (!search::RankTableBuilder::CreateIfNotExists(datFile))
+      if (!search::RankTableBuilder::CreateIfNotExists(datFile, searchIndexThreadsCount))
         LOG(LCRITICAL, ("Error generating rank table."));
 
       LOG(LINFO, ("Generating centers table for", datFile));
       if (!indexer::BuildCentersTableFromDataFile(datFile, true /* forceRebuild */))
         LOG(LCRITICAL, ("Error generating centers table."));
+
+      LOG(LINFO, ("Generating localities grid for", datFile));
+      if (!indexer::BuildLocalitiesGridFromDataFile(datFile))
+        LOG(LCRITICAL, ("Error generating localities grid."));
+
+      LOG(LINFO, ("Generating hotels table for", datFile));
+      if (!indexer::BuildHotelsTableFromDataFile(datFile))
+        LOG(LCRITICAL, ("Error generating hotels table."));
+
+      LOG(LINFO, ("Generating house numbers index for", datFile));
+      if (!indexer::BuildHouseNumbersIndexFromDataFile(datFile))
+        LOG(LCRITICAL, ("Error generating house numbers index."));
+    }
+  };
+
+  if (FLAGS_generate_geometry || FLAGS_generate_index || FLAGS_generate_search_index)
+  {
+    // Memory of a country is predicted by the size of its features: the
+    // features file before the geometry pass, the mwm file after it.
+    std::vector<generator::CountriesScheduler::Country> countries;
+    for (auto const & country : genInfo.m_bucketNames)
+    {
+      uint64_t size = 0;
+      if (!pl.GetFileSizeByFullPath(genInfo.GetTmpFileName(country), size))
+        pl.GetFileSizeByFullPath(my::JoinFoldersToPath(path, country + DATA_FILE_EXTENSION), size);
+      countries.emplace_back(country, kMemoryPerFeaturesByte * size);
     }
 
+    uint64_t const threadsCount = FLAGS_threads_count != 0
+                                      ? FLAGS_threads_count
+                                      : std::max(std::thread::hardware_concurrency(), 1u);
+    generator::CountriesScheduler const scheduler(static_cast<size_t>(threadsCount),
+                                                  FLAGS_memory_limit_mb * 1024 * 1024);
+    scheduler.Run(countries, finalizeCountry);
+  }
+
+  // Enumerate over all dat files that were created.
+  size_t const count = genInfo.m_bucketNames.size();
+  for (size_t i = 0; i < count; ++i)
+  {
+    std::string const & country = genInfo.m_bucketNames[i];
+    std::string const datFile = my::JoinFoldersToPath(path, country + DATA_FILE_EXTENSION);
+    std::string const osmToFeatureFilename =
+        genInfo.GetTargetFileName(country) + OSM2FEATURE_FILE_EXTENSION;
+
+    if (failedCountries.count(country) != 0)
+      continue;
+
     if (!FLAGS_srtm_path.empty())
-      routing::BuildRoadAltitudes(datFile, FLAGS_srtm_path);
+    {
+      generator::StagesProfiler::Stage const stage(profiler, country, "altitude", datFile);
+      routing::BuildRoadAltitudes(datFile, FLAGS_srtm_path, srtmThreadsCount);
+    }
 
     if (!FLAGS_transit_path.empty())
       routing::transit::BuildTransit(datFile, FLAGS_transit_path);
@@ -303,9 +516,17 @@ int main(int argc, char ** argv)
       std::string const roadAccessFilename =
           genInfo.GetIntermediateFileName(ROAD_ACCESS_FILENAME, "" /* extension */);
 
+      generator::StagesProfiler::Stage const stage(profiler, country, "routing", datFile);
       routing::BuildRoadRestrictions(datFile, restrictionsFilename, osmToFeatureFilename);
       routing::BuildRoadAccessInfo(datFile, roadAccessFilename, osmToFeatureFilename);
       routing::BuildRoutingIndex(datFile, country, *countryParentGetter);
+      routing::BuildSpeedCamerasSection(datFile);
+    }
+
+    if (!FLAGS_speed_profiles_path.empty())
+    {
+      generator::StagesProfiler::Stage const stage(profiler, country, "speed_profiles", datFile);
+      routing::BuildSpeedProfilesSection(datFile, FLAGS_speed_profiles_path, osmToFeatureFilename);
     }
 
     if (FLAGS_make_cross_mwm)
@@ -318,16 +539,63 @@ int main(int argc, char ** argv)
         return -1;
       }
 
+      generator::StagesProfiler::Stage const stage(profiler, country, "cross_mwm", datFile);
       if (!routing::BuildCrossMwmSection(path, datFile, country, *countryParentGetter,
-                                         osmToFeatureFilename, FLAGS_disable_cross_mwm_progress))
+                                         osmToFeatureFilename, FLAGS_disable_cross_mwm_progress,
+                                         crossMwmThreadsCount))
         LOG(LCRITICAL, ("Error generating cross mwm section."));
     }
 
+    if (FLAGS_make_routing_shortcuts)
+    {
+      if (!countryParentGetter)
+      {
+        // All the mwms should use proper VehicleModels.
+        LOG(LCRITICAL, ("Countries file is needed. Please set countries file name (countries.txt or "
+                        "countries_obsolete.txt). File must be located in data directory."));
+        return -1;
+      }
+
+      if (!routing::BuildShortcutsSection(path, datFile, country, *countryParentGetter))
+        LOG(LCRITICAL, ("Error generating shortcuts section."));
+    }
+
+    if (FLAGS_make_routing_landmarks)
+    {
+      if (!countryParentGetter)
+      {
+        // All the mwms should use proper VehicleModels.
+        LOG(LCRITICAL, ("Countries file is needed. Please set countries file name (countries.txt or "
+                        "countries_obsolete.txt). File must be located in data directory."));
+        return -1;
+      }
+
+      if (!routing::BuildLandmarksSection(path, datFile, country, *countryParentGetter))
+        LOG(LCRITICAL, ("Error generating landmarks section."));
+    }
+
     if (FLAGS_generate_traffic_keys)
     {
+      generator::StagesProfiler::Stage const stage(profiler, country, "traffic_keys", datFile);
       if (!traffic::GenerateTrafficKeysFromDataFile(datFile))
         LOG(LCRITICAL, ("Error generating traffic keys."));
     }
+
+    if (FLAGS_compress_features_data_block_kb != 0)
+    {
+      generator::StagesProfiler::Stage const stage(profiler, country, "compress_data", datFile);
+      if (!feature::CompressFeaturesData(
+              datFile, static_cast<uint32_t>(FLAGS_compress_features_data_block_kb * 1024)))
+      {
+        LOG(LCRITICAL, ("Error compressing features data."));
+      }
+    }
+
+    if (FLAGS_write_section_hashes)
+    {
+      generator::StagesProfiler::Stage const stage(profiler, country, "section_hashes", datFile);
+      coding::SectionHashes::Write(datFile, static_cast<size_t>(FLAGS_section_hashes_threads_count));
+    }
   }
 
   std::string const datFile = my::JoinFoldersToPath(path, FLAGS_output + DATA_FILE_EXTENSION);
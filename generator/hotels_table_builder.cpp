@@ -0,0 +1,63 @@
+#include "generator/hotels_table_builder.hpp"
+
+#include "search/hotels_filter.hpp"
+#include "search/hotels_table.hpp"
+
+#include "indexer/data_header.hpp"
+#include "indexer/feature.hpp"
+#include "indexer/features_vector.hpp"
+#include "indexer/ftypes_matcher.hpp"
+
+#include "coding/file_container.hpp"
+#include "coding/file_writer.hpp"
+
+#include "base/exception.hpp"
+#include "base/logging.hpp"
+
+#include <cstdint>
+
+#include "defines.hpp"
+
+namespace indexer
+{
+bool BuildHotelsTableFromDataFile(std::string const & filename)
+{
+  try
+  {
+    uint32_t numHotels = 0;
+    search::HotelsTableBuilder builder;
+
+    {
+      FilesContainerR rcont(filename);
+      feature::DataHeader const header(rcont);
+      FeaturesVector const features(rcont, header, nullptr /* features offsets table */);
+
+      auto const & checker = ftypes::IsHotelChecker::Instance();
+      features.ForEach([&](FeatureType & ft, uint32_t featureId) {
+        if (!checker(ft))
+          return;
+
+        search::hotels_filter::Description description;
+        description.FromFeature(ft);
+        builder.Put(featureId, description);
+        ++numHotels;
+      });
+    }
+
+    {
+      FilesContainerW writeContainer(filename, FileWriter::OP_WRITE_EXISTING);
+      FileWriter writer = writeContainer.GetWriter(HOTELS_FILE_TAG);
+      builder.Freeze(writer);
+    }
+
+    LOG(LINFO, ("Hotels table of", filename, "contains", numHotels, "hotels."));
+  }
+  catch (RootException const & e)
+  {
+    LOG(LERROR, ("Failed to build hotels table:", e.Msg()));
+    return false;
+  }
+
+  return true;
+}
+}  // namespace indexer
@@ -0,0 +1,10 @@
+#pragma once
+
+#include <string>
+
+namespace indexer
+{
+// Builds the hotels table section for search::hotels_filter and writes
+// it to the mwm file.
+bool BuildHotelsTableFromDataFile(std::string const & filename);
+}  // namespace indexer
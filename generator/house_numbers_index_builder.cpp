@@ -0,0 +1,125 @@
+#include "generator/house_numbers_index_builder.hpp"
+
+#include "search/house_numbers_index.hpp"
+#include "search/house_numbers_matcher.hpp"
+#include "search/house_to_street_table.hpp"
+#include "search/reverse_geocoder.hpp"
+
+#include "indexer/feature.hpp"
+#include "indexer/features_vector.hpp"
+#include "indexer/index.hpp"
+
+#include "platform/local_country_file.hpp"
+
+#include "coding/file_container.hpp"
+#include "coding/file_writer.hpp"
+
+#include "base/exception.hpp"
+#include "base/logging.hpp"
+#include "base/string_utils.hpp"
+
+#include <cstdint>
+#include <vector>
+
+#include "defines.hpp"
+
+using namespace std;
+
+namespace indexer
+{
+bool BuildHouseNumbersIndexFromDataFile(string const & filename)
+{
+  try
+  {
+    uint32_t numHouses = 0;
+    uint32_t numMissing = 0;
+    search::HouseNumbersIndexBuilder builder;
+
+    {
+      Index index;
+      auto const res = index.RegisterMap(platform::LocalCountryFile::MakeTemporary(filename));
+      if (res.second != MwmSet::RegResult::Success)
+      {
+        LOG(LERROR, ("Can't register", filename));
+        return false;
+      }
+
+      auto handle = index.GetMwmHandleById(res.first);
+      auto & value = *handle.GetValue<MwmValue>();
+      if (!value.m_cont.IsExist(SEARCH_ADDRESS_FILE_TAG))
+        return true;
+
+      auto const table = search::HouseToStreetTable::Load(value);
+      search::ReverseGeocoder const rgc(index);
+      FeaturesVector const features(value.m_cont, value.GetHeader(), value.m_table.get());
+
+      vector<search::ReverseGeocoder::Street> streets;
+      vector<vector<search::house_numbers::Token>> parses;
+      features.ForEach([&](FeatureType & ft, uint32_t houseId) {
+        string const houseNumber = ft.GetHouseNumber();
+        if (houseNumber.empty())
+          return;
+
+        parses.clear();
+        search::house_numbers::ParseHouseNumber(strings::MakeUniString(houseNumber), parses);
+        vector<uint32_t> keys;
+        for (auto const & parse : parses)
+        {
+          uint32_t key;
+          if (search::GetHouseNumberKey(parse, key))
+            keys.push_back(key);
+        }
+        if (keys.empty())
+          return;
+
+        // The street is chosen in the same way as search::FeaturesLayerMatcher
+        // chooses it for the houses which aren't edited by user.
+        ft.SetID(FeatureID(res.first, houseId));
+        rgc.GetNearbyStreets(ft, streets);
+        for (size_t i = 0; i < streets.size(); ++i)
+        {
+          if (streets[i].m_distanceMeters > search::ReverseGeocoder::kLookupRadiusM)
+          {
+            streets.resize(i);
+            break;
+          }
+        }
+
+        uint32_t streetIndex;
+        size_t street = streets.size();
+        if (table->Get(houseId, streetIndex) && streetIndex < streets.size())
+          street = streetIndex;
+        else if (!streets.empty() &&
+                 streets[0].m_distanceMeters < search::ReverseGeocoder::kMaxApproxStreetDistanceM)
+          street = 0;
+
+        if (street == streets.size())
+        {
+          ++numMissing;
+          return;
+        }
+
+        for (auto const key : keys)
+          builder.Put(streets[street].m_id.m_index, key, houseId);
+        ++numHouses;
+      });
+    }
+
+    {
+      FilesContainerW writeContainer(filename, FileWriter::OP_WRITE_EXISTING);
+      FileWriter writer = writeContainer.GetWriter(HOUSE_NUMBERS_FILE_TAG);
+      builder.Freeze(writer);
+    }
+
+    LOG(LINFO, ("House numbers index of", filename, "contains", numHouses, "houses,", numMissing,
+                "houses without streets."));
+  }
+  catch (RootException const & e)
+  {
+    LOG(LERROR, ("Failed to build house numbers index:", e.Msg()));
+    return false;
+  }
+
+  return true;
+}
+}  // namespace indexer
@@ -0,0 +1,11 @@
+#pragma once
+
+#include <string>
+
+namespace indexer
+{
+// Builds the house numbers index section for search and writes it to
+// the mwm file. The search address section (house-to-street table)
+// should be already built. Does nothing for mwms without the section.
+bool BuildHouseNumbersIndexFromDataFile(std::string const & filename);
+}  // namespace indexer
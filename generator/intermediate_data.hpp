@@ -2,14 +2,18 @@
 
 #include "generator/intermediate_elements.hpp"
 
+#include "coding/buffered_file_writer.hpp"
+#include "coding/byte_stream.hpp"
 #include "coding/file_name_utils.hpp"
 #include "coding/file_reader.hpp"
 #include "coding/file_writer.hpp"
 #include "coding/mmap_reader.hpp"
+#include "coding/varint.hpp"
 
 #include "base/logging.hpp"
 
 #include <algorithm>
+#include <cstring>
 #include <deque>
 #include <exception>
 #include <fstream>
@@ -135,8 +139,8 @@ class OSMElementCache
 {
 public:
   using TKey = uint64_t;
-  using TStorage = typename conditional<TMode == EMode::Write, FileWriter, FileReader>::type;
-  using TOffsetFile = typename conditional<TMode == EMode::Write, FileWriter, FileReader>::type;
+  using TStorage = typename conditional<TMode == EMode::Write, BufferedFileWriter, FileReader>::type;
+  using TOffsetFile = typename conditional<TMode == EMode::Write, BufferedFileWriter, FileReader>::type;
 
 protected:
   using TBuffer = std::vector<uint8_t>;
@@ -252,12 +256,24 @@ class RawFilePointStorage : public PointStorage
   using TFileReader = MmapReader;
 #endif
 
-  typename conditional<TMode == EMode::Write, FileWriter, TFileReader>::type m_file;
+  typename conditional<TMode == EMode::Write, BufferedFileWriter, TFileReader>::type m_file;
 
   constexpr static double const kValueOrder = 1E+7;
+  // Max count of points which are written at once.
+  constexpr static size_t const kMaxBufferSize = 64 * 1024;
+  // Max count of missing ids which are written as zeros to keep a buffer continuous.
+  constexpr static uint64_t const kMaxGap = 64;
+
+  // Points with ids which follow each other are written with one call,
+  // since a seek in a file is much more expensive than writing of a gap.
+  std::vector<LatLon> m_buffer;
+  uint64_t m_bufferId = 0;
+  // All ids which are greater or equal were never written to the file.
+  uint64_t m_endId = 0;
 
 public:
   explicit RawFilePointStorage(std::string const & name) : m_file(name) {}
+  ~RawFilePointStorage() { FlushBuffer(); }
 
   template <EMode T = TMode>
   typename enable_if<T == EMode::Write, void>::type AddPoint(uint64_t id, double lat, double lng)
@@ -271,12 +287,40 @@ public:
     CHECK_EQUAL(static_cast<int64_t>(ll.lat), lat64, ("Latitude is out of 32bit boundary!"));
     CHECK_EQUAL(static_cast<int64_t>(ll.lon), lng64, ("Longtitude is out of 32bit boundary!"));
 
-    m_file.Seek(id * sizeof(ll));
-    m_file.Write(&ll, sizeof(ll));
+    // Zeros mean missing points, so a gap can be filled only with ids which
+    // were never written.
+    uint64_t const nextId = m_bufferId + m_buffer.size();
+    bool const canAppend = !m_buffer.empty() && id >= nextId && id - nextId <= kMaxGap &&
+                           (id == nextId || nextId >= m_endId);
+    if (!canAppend || m_buffer.size() >= kMaxBufferSize)
+    {
+      FlushBuffer();
+      m_bufferId = id;
+    }
+
+    m_buffer.resize(id - m_bufferId, LatLon{0, 0});
+    m_buffer.push_back(ll);
 
     IncProcessedPoint();
   }
 
+  template <EMode T = TMode>
+  typename enable_if<T == EMode::Write, void>::type FlushBuffer()
+  {
+    if (m_buffer.empty())
+      return;
+
+    m_file.Seek(m_bufferId * sizeof(LatLon));
+    m_file.Write(m_buffer.data(), m_buffer.size() * sizeof(LatLon));
+    m_endId = std::max(m_endId, m_bufferId + m_buffer.size());
+    m_buffer.clear();
+  }
+
+  template <EMode T = TMode>
+  typename enable_if<T == EMode::Read, void>::type FlushBuffer()
+  {
+  }
+
   template <EMode T = TMode>
   typename enable_if<T == EMode::Read, bool>::type GetPoint(uint64_t id, double & lat,
                                                             double & lng) const
@@ -367,7 +411,7 @@ public:
 template <EMode TMode>
 class MapFilePointStorage : public PointStorage
 {
-  typename conditional<TMode == EMode::Write, FileWriter, FileReader>::type m_file;
+  typename conditional<TMode == EMode::Write, BufferedFileWriter, FileReader>::type m_file;
   std::unordered_map<uint64_t, std::pair<int32_t, int32_t>> m_map;
 
   constexpr static double const kValueOrder = 1E+7;
@@ -426,4 +470,275 @@ public:
   }
 };
 
+/// Keeps points in blocks of points with increasing ids, ids and coordinates
+/// are delta coded inside of a block. Every sub-block of a block can be decoded
+/// independently, so a search of a point needs a binary search in the index
+/// of blocks, a binary search of a sub-block and decoding of one sub-block.
+/// The file is memory-mapped in the read mode.
+///
+/// File layout: blocks, index of blocks, points added out of order of ids, footer.
+/// Block layout: count of points (uint16), deltas of first ids of sub-blocks
+/// from the first id of the block (uint32 each), offsets of sub-blocks from
+/// the beginning of the block (uint16 each), points of sub-blocks.
+/// Every point except the first one in a sub-block starts with a delta of id,
+/// then deltas of coordinates follow.
+template <EMode TMode>
+class PackedFilePointStorage : public PointStorage
+{
+  struct BlockEntry
+  {
+    uint64_t m_firstId;
+    uint64_t m_offset;
+  };
+  static_assert(sizeof(BlockEntry) == 16, "Invalid structure size");
+
+  struct Footer
+  {
+    uint64_t m_blocksOffset;
+    uint64_t m_blocksCount;
+    uint64_t m_unsortedOffset;
+    uint64_t m_unsortedCount;
+  };
+  static_assert(sizeof(Footer) == 32, "Invalid structure size");
+
+  constexpr static double const kValueOrder = 1E+7;
+  constexpr static size_t const kBlockSize = 256;
+  constexpr static size_t const kSubBlockSize = 16;
+  constexpr static size_t const kMaxSubBlocksCount = kBlockSize / kSubBlockSize;
+
+  typename conditional<TMode == EMode::Write, BufferedFileWriter, MmapReader>::type m_file;
+
+  // Write mode.
+  std::vector<LatLonPos> m_block;
+  std::vector<uint8_t> m_buffer;
+  std::vector<BlockEntry> m_blocks;
+  std::vector<LatLonPos> m_unsorted;
+  uint64_t m_lastId = 0;
+  bool m_hasSortedPoints = false;
+
+  // Read mode.
+  uint8_t const * m_data = nullptr;
+  BlockEntry const * m_blocksBegin = nullptr;
+  BlockEntry const * m_blocksEnd = nullptr;
+  std::unordered_map<uint64_t, std::pair<int32_t, int32_t>> m_unsortedMap;
+
+public:
+  explicit PackedFilePointStorage(std::string const & name) : m_file(name + ".packed")
+  {
+    InitStorage<TMode>();
+  }
+
+  ~PackedFilePointStorage() { DoneStorage<TMode>(); }
+
+  template <EMode T>
+  typename enable_if<T == EMode::Write, void>::type InitStorage()
+  {
+    m_block.reserve(kBlockSize);
+  }
+
+  template <EMode T>
+  typename enable_if<T == EMode::Read, void>::type InitStorage()
+  {
+    uint64_t const size = m_file.Size();
+    CHECK_GREATER_OR_EQUAL(size, sizeof(Footer), ("Invalid file of points."));
+    Footer footer;
+    m_file.Read(size - sizeof(footer), &footer, sizeof(footer));
+
+    m_data = m_file.Data();
+    m_blocksBegin = reinterpret_cast<BlockEntry const *>(m_data + footer.m_blocksOffset);
+    m_blocksEnd = m_blocksBegin + footer.m_blocksCount;
+
+    for (uint64_t i = 0; i < footer.m_unsortedCount; ++i)
+    {
+      LatLonPos ll;
+      m_file.Read(footer.m_unsortedOffset + i * sizeof(ll), &ll, sizeof(ll));
+      m_unsortedMap[ll.pos] = std::make_pair(ll.lat, ll.lon);
+    }
+
+    LOG(LINFO, ("Blocks of points:", footer.m_blocksCount, "points out of order:",
+                footer.m_unsortedCount));
+  }
+
+  template <EMode T>
+  typename enable_if<T == EMode::Write, void>::type DoneStorage()
+  {
+    FlushBlock();
+
+    // Blocks are accessed directly in the mapped file.
+    uint64_t const padding = (sizeof(uint64_t) - m_file.Pos() % sizeof(uint64_t)) % sizeof(uint64_t);
+    uint64_t const zero = 0;
+    m_file.Write(&zero, static_cast<size_t>(padding));
+
+    Footer footer;
+    footer.m_blocksOffset = m_file.Pos();
+    footer.m_blocksCount = m_blocks.size();
+    m_file.Write(m_blocks.data(), m_blocks.size() * sizeof(BlockEntry));
+    footer.m_unsortedOffset = m_file.Pos();
+    footer.m_unsortedCount = m_unsorted.size();
+    m_file.Write(m_unsorted.data(), m_unsorted.size() * sizeof(LatLonPos));
+    m_file.Write(&footer, sizeof(footer));
+  }
+
+  template <EMode T>
+  typename enable_if<T == EMode::Read, void>::type DoneStorage() {}
+
+  template <EMode T = TMode>
+  typename enable_if<T == EMode::Write, void>::type AddPoint(uint64_t id, double lat, double lng)
+  {
+    int64_t const lat64 = lat * kValueOrder;
+    int64_t const lng64 = lng * kValueOrder;
+
+    LatLonPos ll;
+    ll.pos = id;
+    ll.lat = static_cast<int32_t>(lat64);
+    ll.lon = static_cast<int32_t>(lng64);
+    CHECK_EQUAL(static_cast<int64_t>(ll.lat), lat64, ("Latitude is out of 32bit boundary!"));
+    CHECK_EQUAL(static_cast<int64_t>(ll.lon), lng64, ("Longtitude is out of 32bit boundary!"));
+
+    IncProcessedPoint();
+
+    // Osm data is sorted by ids usually, other points are kept in memory.
+    if (m_hasSortedPoints && id <= m_lastId)
+    {
+      m_unsorted.push_back(ll);
+      return;
+    }
+
+    if (m_block.size() == kBlockSize ||
+        (!m_block.empty() && id - m_block.front().pos > std::numeric_limits<uint32_t>::max()))
+    {
+      FlushBlock();
+    }
+    m_block.push_back(ll);
+    m_lastId = id;
+    m_hasSortedPoints = true;
+  }
+
+  template <EMode T = TMode>
+  typename enable_if<T == EMode::Read, bool>::type GetPoint(uint64_t id, double & lat,
+                                                            double & lng) const
+  {
+    int32_t latI = 0;
+    int32_t lonI = 0;
+    auto const it = m_unsortedMap.find(id);
+    if (it != m_unsortedMap.end())
+    {
+      latI = it->second.first;
+      lonI = it->second.second;
+    }
+    else if (!FindPoint(id, latI, lonI))
+    {
+      LOG(LERROR, ("Node with id = ", id, " not found!"));
+      return false;
+    }
+
+    lat = static_cast<double>(latI) / kValueOrder;
+    lng = static_cast<double>(lonI) / kValueOrder;
+    return true;
+  }
+
+private:
+  template <EMode T = TMode>
+  typename enable_if<T == EMode::Write, void>::type FlushBlock()
+  {
+    if (m_block.empty())
+      return;
+
+    uint16_t const count = static_cast<uint16_t>(m_block.size());
+    size_t const subBlocksCount = (m_block.size() + kSubBlockSize - 1) / kSubBlockSize;
+    uint64_t const firstId = m_block.front().pos;
+
+    uint32_t idDeltas[kMaxSubBlocksCount];
+    uint16_t offsets[kMaxSubBlocksCount];
+    size_t const idDeltasSize = subBlocksCount * sizeof(uint32_t);
+    size_t const offsetsSize = subBlocksCount * sizeof(uint16_t);
+
+    // The header is filled when sub-blocks are written.
+    m_buffer.assign(sizeof(count) + idDeltasSize + offsetsSize, 0);
+    PushBackByteSink<std::vector<uint8_t>> sink(m_buffer);
+    for (size_t i = 0; i < subBlocksCount; ++i)
+    {
+      size_t const begin = i * kSubBlockSize;
+      size_t const end = std::min(begin + kSubBlockSize, m_block.size());
+
+      CHECK_LESS_OR_EQUAL(m_buffer.size(), std::numeric_limits<uint16_t>::max(), ());
+      idDeltas[i] = static_cast<uint32_t>(m_block[begin].pos - firstId);
+      offsets[i] = static_cast<uint16_t>(m_buffer.size());
+
+      int64_t prevLat = 0;
+      int64_t prevLon = 0;
+      for (size_t j = begin; j < end; ++j)
+      {
+        LatLonPos const & ll = m_block[j];
+        if (j != begin)
+          WriteVarUint(sink, ll.pos - m_block[j - 1].pos);
+        WriteVarInt(sink, ll.lat - prevLat);
+        WriteVarInt(sink, ll.lon - prevLon);
+        prevLat = ll.lat;
+        prevLon = ll.lon;
+      }
+    }
+
+    memcpy(m_buffer.data(), &count, sizeof(count));
+    memcpy(m_buffer.data() + sizeof(count), idDeltas, idDeltasSize);
+    memcpy(m_buffer.data() + sizeof(count) + idDeltasSize, offsets, offsetsSize);
+
+    m_blocks.push_back({firstId, m_file.Pos()});
+    m_file.Write(m_buffer.data(), m_buffer.size());
+    m_block.clear();
+  }
+
+  bool FindPoint(uint64_t id, int32_t & lat, int32_t & lon) const
+  {
+    auto it = std::upper_bound(m_blocksBegin, m_blocksEnd, id,
+                               [](uint64_t id, BlockEntry const & e) { return id < e.m_firstId; });
+    if (it == m_blocksBegin)
+      return false;
+    --it;
+
+    uint64_t const idDelta = id - it->m_firstId;
+    if (idDelta > std::numeric_limits<uint32_t>::max())
+      return false;
+
+    uint8_t const * block = m_data + it->m_offset;
+    uint16_t count;
+    memcpy(&count, block, sizeof(count));
+    size_t const subBlocksCount = (count + kSubBlockSize - 1) / kSubBlockSize;
+
+    uint32_t idDeltas[kMaxSubBlocksCount];
+    memcpy(idDeltas, block + sizeof(count), subBlocksCount * sizeof(uint32_t));
+    size_t const subBlock =
+        std::upper_bound(idDeltas, idDeltas + subBlocksCount, static_cast<uint32_t>(idDelta)) -
+        idDeltas - 1;
+
+    uint16_t offset;
+    memcpy(&offset, block + sizeof(count) + subBlocksCount * sizeof(uint32_t) +
+                        subBlock * sizeof(offset),
+           sizeof(offset));
+
+    ArrayByteSource src(block + offset);
+    size_t const restCount = count - subBlock * kSubBlockSize;
+    size_t const pointsCount = restCount < kSubBlockSize ? restCount : kSubBlockSize;
+    uint64_t currentId = it->m_firstId + idDeltas[subBlock];
+    int64_t currentLat = 0;
+    int64_t currentLon = 0;
+    for (size_t i = 0; i < pointsCount; ++i)
+    {
+      if (i != 0)
+        currentId += ReadVarUint<uint64_t>(src);
+      currentLat += ReadVarInt<int64_t>(src);
+      currentLon += ReadVarInt<int64_t>(src);
+      if (currentId >= id)
+      {
+        if (currentId != id)
+          return false;
+        lat = static_cast<int32_t>(currentLat);
+        lon = static_cast<int32_t>(currentLon);
+        return true;
+      }
+    }
+    return false;
+  }
+};
+
 }  // namespace cache
@@ -0,0 +1,116 @@
+#include "generator/latlon_bands_index.hpp"
+
+#include "geometry/distance_on_sphere.hpp"
+
+#include "base/assert.hpp"
+#include "base/math.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <tuple>
+
+namespace
+{
+// Bounds of bands and ranges are a bit wider than the distance, so points
+// on the boundary aren't lost due to rounding.
+double constexpr kMargin = 1.01;
+double constexpr kMinBandDegrees = 1e-6;
+}  // namespace
+
+namespace generator
+{
+// static
+size_t constexpr LatLonBandsIndex::kMaxRanges;
+
+LatLonBandsIndex::LatLonBandsIndex(TPoints const & points, double distanceMeters)
+  : m_distanceMeters(distanceMeters)
+{
+  CHECK_GREATER(distanceMeters, 0.0, ());
+
+  double const metersPerDegree = ms::EarthRadiusMeters() * math::pi / 180.0;
+  m_bandDegrees = std::max(kMargin * distanceMeters / metersPerDegree, kMinBandDegrees);
+
+  m_entries.reserve(points.size());
+  for (auto const & point : points)
+    m_entries.push_back({GetBand(point.first.lat), point.second, point.first.lat, point.first.lon});
+
+  std::sort(m_entries.begin(), m_entries.end(), [](Entry const & lhs, Entry const & rhs) {
+    return std::tie(lhs.m_band, lhs.m_lon, lhs.m_value) < std::tie(rhs.m_band, rhs.m_lon, rhs.m_value);
+  });
+}
+
+uint32_t LatLonBandsIndex::GetBand(double lat) const
+{
+  double const band = std::floor((my::clamp(lat, -90.0, 90.0) + 90.0) / m_bandDegrees);
+  return static_cast<uint32_t>(std::min(band, 180.0 / m_bandDegrees));
+}
+
+double LatLonBandsIndex::GetDistance(ms::LatLon const & ll, Entry const & entry) const
+{
+  return ms::DistanceOnEarth(ll.lat, ll.lon, entry.m_lat, entry.m_lon);
+}
+
+size_t LatLonBandsIndex::GetRanges(ms::LatLon const & ll,
+                                   std::pair<uint32_t, uint32_t> (&ranges)[kMaxRanges]) const
+{
+  if (m_entries.empty())
+    return 0;
+
+  // Points in the distance from |ll| are in a spherical cap. Longitudes of
+  // the cap differ from |ll.lon| by asin(sin(radius) / cos(lat)) at most,
+  // when the cap doesn't contain a pole.
+  double const radius = kMargin * m_distanceMeters / ms::EarthRadiusMeters();
+  double const sinRadius = std::sin(std::min(radius, math::pi / 2));
+  double const cosLat = std::cos(my::DegToRad(my::clamp(ll.lat, -90.0, 90.0)));
+  double lonDegrees = 360.0;
+  if (sinRadius < cosLat)
+    lonDegrees = kMargin * my::RadToDeg(std::asin(sinRadius / cosLat));
+
+  auto const lowerBound = [this](uint32_t band, double lon) {
+    return static_cast<uint32_t>(
+        std::lower_bound(m_entries.begin(), m_entries.end(), std::make_pair(band, lon),
+                         [](Entry const & e, std::pair<uint32_t, double> const & key) {
+                           return std::tie(e.m_band, e.m_lon) < std::tie(key.first, key.second);
+                         }) -
+        m_entries.begin());
+  };
+  auto const upperBound = [this](uint32_t band, double lon) {
+    return static_cast<uint32_t>(
+        std::upper_bound(m_entries.begin(), m_entries.end(), std::make_pair(band, lon),
+                         [](std::pair<uint32_t, double> const & key, Entry const & e) {
+                           return std::tie(key.first, key.second) < std::tie(e.m_band, e.m_lon);
+                         }) -
+        m_entries.begin());
+  };
+
+  size_t count = 0;
+  auto const addRange = [&](uint32_t band, double minLon, double maxLon) {
+    ASSERT_LESS(count, kMaxRanges, ());
+    uint32_t const first = lowerBound(band, minLon);
+    uint32_t const last = upperBound(band, maxLon);
+    if (first < last)
+      ranges[count++] = std::make_pair(first, last);
+  };
+
+  uint32_t const band = GetBand(ll.lat);
+  uint32_t const firstBand = band == 0 ? 0 : band - 1;
+  for (uint32_t b = firstBand; b <= band + 1; ++b)
+  {
+    if (lonDegrees >= 180.0)
+    {
+      addRange(b, -180.0, 180.0);
+      continue;
+    }
+
+    double const minLon = ll.lon - lonDegrees;
+    double const maxLon = ll.lon + lonDegrees;
+    addRange(b, std::max(minLon, -180.0), std::min(maxLon, 180.0));
+    // The range crosses the antimeridian.
+    if (minLon < -180.0)
+      addRange(b, minLon + 360.0, 180.0);
+    else if (maxLon > 180.0)
+      addRange(b, -180.0, maxLon - 360.0);
+  }
+  return count;
+}
+}  // namespace generator
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "geometry/latlon.hpp"
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace generator
+{
+// Packed index of points for queries of points within a distance.
+//
+// Points are kept in one sorted array: by bands of latitude, which are not
+// lower than the distance, and by longitude inside of a band. So a query
+// looks through ranges of longitudes of three bands only, and the index
+// takes 24 bytes per point. Const methods may be called concurrently.
+class LatLonBandsIndex
+{
+public:
+  using TPoints = std::vector<std::pair<ms::LatLon, uint32_t>>;
+
+  LatLonBandsIndex() = default;
+
+  // |distanceMeters| is the max distance of queries.
+  LatLonBandsIndex(TPoints const & points, double distanceMeters);
+
+  // Calls |fn| with values and distances of points which are not farther
+  // than the distance of the index from |ll|.
+  template <typename TFn>
+  void ForEachInDistance(ms::LatLon const & ll, TFn && fn) const
+  {
+    std::pair<uint32_t, uint32_t> ranges[kMaxRanges];
+    size_t const count = GetRanges(ll, ranges);
+    for (size_t i = 0; i < count; ++i)
+    {
+      for (uint32_t j = ranges[i].first; j < ranges[i].second; ++j)
+      {
+        auto const & entry = m_entries[j];
+        double const distance = GetDistance(ll, entry);
+        if (distance <= m_distanceMeters)
+          fn(entry.m_value, distance);
+      }
+    }
+  }
+
+  size_t Size() const { return m_entries.size(); }
+
+private:
+  static size_t constexpr kMaxRanges = 6;
+
+  struct Entry
+  {
+    uint32_t m_band;
+    uint32_t m_value;
+    double m_lat;
+    double m_lon;
+  };
+
+  uint32_t GetBand(double lat) const;
+  double GetDistance(ms::LatLon const & ll, Entry const & entry) const;
+  // Writes ranges of entries which may be in the distance from |ll| and
+  // returns count of the ranges.
+  size_t GetRanges(ms::LatLon const & ll, std::pair<uint32_t, uint32_t> (&ranges)[kMaxRanges]) const;
+
+  std::vector<Entry> m_entries;
+  double m_distanceMeters = 0.0;
+  double m_bandDegrees = 180.0;
+};
+}  // namespace generator
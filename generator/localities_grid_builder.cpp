@@ -0,0 +1,88 @@
+#include "generator/localities_grid_builder.hpp"
+
+#include "search/localities_grid.hpp"
+#include "search/locality_finder.hpp"
+
+#include "indexer/data_header.hpp"
+#include "indexer/feature.hpp"
+#include "indexer/features_vector.hpp"
+#include "indexer/ftypes_matcher.hpp"
+
+#include "coding/file_container.hpp"
+#include "coding/file_writer.hpp"
+
+#include "base/exception.hpp"
+#include "base/logging.hpp"
+#include "base/stl_add.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <memory>
+
+#include "defines.hpp"
+
+namespace indexer
+{
+namespace
+{
+// Must be in sync with the features LocalityFinder loads.
+bool IsLocality(FeatureType & ft)
+{
+  if (ft.GetFeatureType() != feature::GEOM_POINT)
+    return false;
+
+  switch (ftypes::IsLocalityChecker::Instance().GetType(ft))
+  {
+  case ftypes::CITY:
+  case ftypes::TOWN:
+  case ftypes::VILLAGE: break;
+  default: return false;
+  }
+
+  return ftypes::GetPopulation(ft) != 0;
+}
+}  // namespace
+
+bool BuildLocalitiesGridFromDataFile(std::string const & filename)
+{
+  try
+  {
+    uint32_t numLocalities = 0;
+    std::unique_ptr<search::LocalitiesGridBuilder> builder;
+
+    {
+      FilesContainerR rcont(filename);
+      feature::DataHeader const header(rcont);
+
+      double const radiusMeters = header.GetType() == feature::DataHeader::world
+                                      ? search::LocalityFinder::kMaxCityRadiusMeters
+                                      : search::LocalityFinder::kMaxVillageRadiusMeters;
+      builder = my::make_unique<search::LocalitiesGridBuilder>(
+          static_cast<uint32_t>(std::ceil(radiusMeters)));
+
+      FeaturesVector const features(rcont, header, nullptr /* features offsets table */);
+      features.ForEach([&](FeatureType & ft, uint32_t featureId) {
+        if (!IsLocality(ft))
+          return;
+        builder->Put(featureId, ft.GetCenter());
+        ++numLocalities;
+      });
+    }
+
+    {
+      FilesContainerW writeContainer(filename, FileWriter::OP_WRITE_EXISTING);
+      FileWriter writer = writeContainer.GetWriter(LOCALITIES_GRID_FILE_TAG);
+      builder->Freeze(writer);
+    }
+
+    LOG(LINFO, ("Localities grid of", filename, "contains", numLocalities, "localities."));
+  }
+  catch (RootException const & e)
+  {
+    LOG(LERROR, ("Failed to build localities grid:", e.Msg()));
+    return false;
+  }
+
+  return true;
+}
+}  // namespace indexer
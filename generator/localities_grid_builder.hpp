@@ -0,0 +1,11 @@
+#pragma once
+
+#include <string>
+
+namespace indexer
+{
+// Builds the localities grid section for LocalityFinder and writes it
+// to the mwm file. World grid lists cities and towns, grids of
+// countries list villages as well.
+bool BuildLocalitiesGridFromDataFile(std::string const & filename);
+}  // namespace indexer
@@ -1,5 +1,6 @@
 #include "generator/mwm_diff/diff.hpp"
 
+#include "coding/file_container.hpp"
 #include "coding/file_reader.hpp"
 #include "coding/file_writer.hpp"
 #include "coding/reader.hpp"
@@ -7,10 +8,16 @@
 #include "coding/writer.hpp"
 #include "coding/zlib.hpp"
 
+#include "base/checked_cast.hpp"
 #include "base/logging.hpp"
 
+#include <algorithm>
 #include <cstdint>
+#include <exception>
 #include <iterator>
+#include <memory>
+#include <string>
+#include <thread>
 #include <vector>
 
 #include "3party/bsdiff-courgette/bsdiff/bsdiff.h"
@@ -23,9 +30,134 @@ enum Version
 {
   // Format Version 0: bsdiff+gzip.
   VERSION_V0 = 0,
-  VERSION_LATEST = VERSION_V0
+  // Format Version 1: the new mwm is made of ranges of sections of its container and
+  // of gaps between them. Unchanged sections are copied from the old mwm, changed ones
+  // are patched by bsdiff+gzip independently, so they are applied in parallel.
+  // Every range has crc32 of its bytes in the new mwm.
+  VERSION_V1 = 1,
+  VERSION_LATEST = VERSION_V1
 };
 
+enum class RangeType : uint8_t
+{
+  // Bytes are copied from the old mwm.
+  Copy = 0,
+  // Deflated bytes are stored in the diff.
+  Raw = 1,
+  // A range of the old mwm is patched by deflated bsdiff patch.
+  Patch = 2
+};
+
+// Ranges which are larger than this are read and compared by parts.
+uint64_t constexpr kCopyBufferSize = 1 << 20;
+
+// Max number of threads which apply patches of sections.
+unsigned int constexpr kMaxApplyThreads = 4;
+
+struct Range
+{
+  uint64_t m_offset = 0;
+  uint64_t m_size = 0;
+  // Empty for gaps between sections.
+  std::string m_tag;
+};
+
+uint32_t UpdateCrc(uint32_t crc, void const * data, size_t size)
+{
+  auto const * p = static_cast<Bytef const *>(data);
+  while (size != 0)
+  {
+    auto const part = static_cast<uInt>(min(size, static_cast<size_t>(kCopyBufferSize)));
+    crc = static_cast<uint32_t>(crc32(crc, p, part));
+    p += part;
+    size -= part;
+  }
+  return crc;
+}
+
+void Deflate(vector<uint8_t> const & data, vector<uint8_t> & deflated)
+{
+  using Deflate = coding::ZLib::Deflate;
+  Deflate deflate(Deflate::Format::ZLib, Deflate::Level::BestCompression);
+  deflated.clear();
+  deflate(data.data(), data.size(), back_inserter(deflated));
+}
+
+bool Inflate(vector<uint8_t> const & deflated, vector<uint8_t> & data)
+{
+  using Inflate = coding::ZLib::Inflate;
+  Inflate inflate(Inflate::Format::ZLib);
+  data.clear();
+  return inflate(deflated.data(), deflated.size(), back_inserter(data));
+}
+
+void ReadBytes(FileReader const & reader, uint64_t offset, uint64_t size, vector<uint8_t> & bytes)
+{
+  bytes.resize(base::checked_cast<size_t>(size));
+  reader.Read(offset, bytes.data(), bytes.size());
+}
+
+bool AreEqualRanges(FileReader const & oldReader, uint64_t oldOffset, FileReader const & newReader,
+                    uint64_t newOffset, uint64_t size)
+{
+  vector<uint8_t> oldBytes;
+  vector<uint8_t> newBytes;
+  for (uint64_t pos = 0; pos < size; pos += kCopyBufferSize)
+  {
+    uint64_t const part = min(size - pos, kCopyBufferSize);
+    ReadBytes(oldReader, oldOffset + pos, part, oldBytes);
+    ReadBytes(newReader, newOffset + pos, part, newBytes);
+    if (oldBytes != newBytes)
+      return false;
+  }
+  return true;
+}
+
+// Splits the file of |cont| into ranges of its non-empty sections and gaps between them.
+// Returns false if sections overlap.
+bool GetRanges(FilesContainerR const & cont, vector<Range> & ranges)
+{
+  vector<Range> sections;
+  cont.ForEachTag([&](FilesContainerR::Tag const & tag) {
+    auto const offsetAndSize = cont.GetAbsoluteOffsetAndSize(tag);
+    if (offsetAndSize.second == 0)
+      return;
+    Range range;
+    range.m_offset = offsetAndSize.first;
+    range.m_size = offsetAndSize.second;
+    range.m_tag = tag;
+    sections.push_back(range);
+  });
+  sort(sections.begin(), sections.end(),
+       [](Range const & lhs, Range const & rhs) { return lhs.m_offset < rhs.m_offset; });
+
+  ranges.clear();
+  uint64_t pos = 0;
+  auto const addGap = [&](uint64_t end) {
+    if (end == pos)
+      return;
+    Range gap;
+    gap.m_offset = pos;
+    gap.m_size = end - pos;
+    ranges.push_back(gap);
+  };
+
+  for (auto const & section : sections)
+  {
+    if (section.m_offset < pos)
+      return false;
+    addGap(section.m_offset);
+    ranges.push_back(section);
+    pos = section.m_offset + section.m_size;
+  }
+
+  uint64_t const fileSize = cont.GetFileSize();
+  if (fileSize < pos)
+    return false;
+  addGap(fileSize);
+  return true;
+}
+
 bool MakeDiffVersion0(FileReader & oldReader, FileReader & newReader, FileWriter & diffFileWriter)
 {
   vector<uint8_t> diffBuf;
@@ -52,6 +184,82 @@ bool MakeDiffVersion0(FileReader & oldReader, FileReader & newReader, FileWriter
   return true;
 }
 
+bool MakeDiffVersion1(FilesContainerR const & oldCont, FileReader const & oldReader,
+                      FilesContainerR const & newCont, FileReader const & newReader,
+                      FileWriter & diffFileWriter)
+{
+  vector<Range> ranges;
+  if (!GetRanges(newCont, ranges))
+    return false;
+
+  WriteToSink(diffFileWriter, static_cast<uint32_t>(VERSION_V1));
+  WriteToSink(diffFileWriter, newReader.Size());
+  WriteToSink(diffFileWriter, base::checked_cast<uint32_t>(ranges.size()));
+
+  vector<uint8_t> newBytes;
+  vector<uint8_t> oldBytes;
+  vector<uint8_t> deflated;
+  for (auto const & range : ranges)
+  {
+    ReadBytes(newReader, range.m_offset, range.m_size, newBytes);
+    uint32_t const crc = UpdateCrc(0 /* crc */, newBytes.data(), newBytes.size());
+
+    bool const hasOldSection = !range.m_tag.empty() && oldCont.IsExist(range.m_tag);
+    pair<uint64_t, uint64_t> oldSection(0, 0);
+    if (hasOldSection)
+      oldSection = oldCont.GetAbsoluteOffsetAndSize(range.m_tag);
+
+    RangeType type = RangeType::Raw;
+    if (hasOldSection && oldSection.second == range.m_size &&
+        AreEqualRanges(oldReader, oldSection.first, newReader, range.m_offset, range.m_size))
+    {
+      type = RangeType::Copy;
+    }
+    else if (hasOldSection && oldSection.second != 0)
+    {
+      type = RangeType::Patch;
+    }
+
+    WriteToSink(diffFileWriter, static_cast<uint8_t>(type));
+    WriteToSink(diffFileWriter, range.m_size);
+    WriteToSink(diffFileWriter, crc);
+
+    switch (type)
+    {
+    case RangeType::Copy: WriteToSink(diffFileWriter, oldSection.first); break;
+    case RangeType::Raw:
+    {
+      Deflate(newBytes, deflated);
+      WriteToSink(diffFileWriter, static_cast<uint64_t>(deflated.size()));
+      diffFileWriter.Write(deflated.data(), deflated.size());
+      break;
+    }
+    case RangeType::Patch:
+    {
+      ReadBytes(oldReader, oldSection.first, oldSection.second, oldBytes);
+      MemReader oldMemReader(oldBytes.data(), oldBytes.size());
+      MemReader newMemReader(newBytes.data(), newBytes.size());
+      vector<uint8_t> patch;
+      MemWriter<vector<uint8_t>> patchWriter(patch);
+      auto const status = bsdiff::CreateBinaryPatch(oldMemReader, newMemReader, patchWriter);
+      if (status != bsdiff::BSDiffStatus::OK)
+      {
+        LOG(LERROR, ("Could not create patch of section", range.m_tag, "with bsdiff:", status));
+        return false;
+      }
+
+      Deflate(patch, deflated);
+      WriteToSink(diffFileWriter, oldSection.first);
+      WriteToSink(diffFileWriter, oldSection.second);
+      WriteToSink(diffFileWriter, static_cast<uint64_t>(deflated.size()));
+      diffFileWriter.Write(deflated.data(), deflated.size());
+      break;
+    }
+    }
+  }
+  return true;
+}
+
 bool ApplyDiffVersion0(FileReader & oldReader, FileWriter & newWriter,
                        ReaderSource<FileReader> & diffFileSource)
 {
@@ -76,6 +284,180 @@ bool ApplyDiffVersion0(FileReader & oldReader, FileWriter & newWriter,
 
   return true;
 }
+// A range of the new mwm which is being applied.
+struct RangeToApply
+{
+  // Applies the patch or inflates bytes of the range to |m_result| and verifies them.
+  void Apply()
+  {
+    vector<uint8_t> patch;
+    switch (m_type)
+    {
+    case RangeType::Copy: return;
+    case RangeType::Raw: m_ok = Inflate(m_deflated, m_result); break;
+    case RangeType::Patch:
+    {
+      if (!Inflate(m_deflated, patch))
+        return;
+      MemReader oldMemReader(m_oldBytes.data(), m_oldBytes.size());
+      MemReader patchMemReader(patch.data(), patch.size());
+      MemWriter<vector<uint8_t>> newMemWriter(m_result);
+      auto const status = bsdiff::ApplyBinaryPatch(oldMemReader, newMemWriter, patchMemReader);
+      if (status != bsdiff::BSDiffStatus::OK)
+        LOG(LERROR, ("Could not apply patch with bsdiff:", status));
+      m_ok = status == bsdiff::BSDiffStatus::OK;
+      break;
+    }
+    }
+
+    m_ok = m_ok && m_result.size() == m_size &&
+           UpdateCrc(0 /* crc */, m_result.data(), m_result.size()) == m_crc;
+    vector<uint8_t>().swap(m_deflated);
+    vector<uint8_t>().swap(m_oldBytes);
+  }
+
+  RangeType m_type = RangeType::Raw;
+  uint64_t m_size = 0;
+  uint32_t m_crc = 0;
+  uint64_t m_oldOffset = 0;
+  vector<uint8_t> m_oldBytes;
+  vector<uint8_t> m_deflated;
+  vector<uint8_t> m_result;
+  bool m_ok = false;
+};
+
+bool CopyRange(FileReader const & oldReader, RangeToApply const & range, FileWriter & newWriter)
+{
+  if (range.m_oldOffset + range.m_size > oldReader.Size())
+    return false;
+
+  uint32_t crc = 0;
+  vector<uint8_t> bytes;
+  for (uint64_t pos = 0; pos < range.m_size; pos += kCopyBufferSize)
+  {
+    ReadBytes(oldReader, range.m_oldOffset + pos, min(range.m_size - pos, kCopyBufferSize), bytes);
+    crc = UpdateCrc(crc, bytes.data(), bytes.size());
+    newWriter.Write(bytes.data(), bytes.size());
+  }
+  return crc == range.m_crc;
+}
+
+// Applies |ranges| in parallel and writes them to |newWriter| in order.
+bool ApplyRanges(FileReader const & oldReader, vector<RangeToApply> & ranges,
+                 FileWriter & newWriter)
+{
+  vector<thread> threads;
+  vector<exception_ptr> errors(ranges.size());
+  for (size_t i = 0; i < ranges.size(); ++i)
+  {
+    if (ranges[i].m_type == RangeType::Copy)
+      continue;
+    threads.emplace_back([&ranges, &errors, i]() {
+      try
+      {
+        ranges[i].Apply();
+      }
+      catch (...)
+      {
+        errors[i] = current_exception();
+      }
+    });
+  }
+  for (auto & thread : threads)
+    thread.join();
+  for (auto const & error : errors)
+  {
+    if (error)
+      rethrow_exception(error);
+  }
+
+  for (auto const & range : ranges)
+  {
+    if (range.m_type == RangeType::Copy)
+    {
+      if (!CopyRange(oldReader, range, newWriter))
+      {
+        LOG(LWARNING, ("Copied range of the old mwm is broken."));
+        return false;
+      }
+      continue;
+    }
+
+    if (!range.m_ok)
+    {
+      LOG(LWARNING, ("Applied range of mwm diff is broken."));
+      return false;
+    }
+    newWriter.Write(range.m_result.data(), range.m_result.size());
+  }
+  ranges.clear();
+  return true;
+}
+
+bool ApplyDiffVersion1(FileReader & oldReader, FileWriter & newWriter,
+                       ReaderSource<FileReader> & diffFileSource)
+{
+  auto const newSize = ReadPrimitiveFromSource<uint64_t>(diffFileSource);
+  auto const rangesCount = ReadPrimitiveFromSource<uint32_t>(diffFileSource);
+
+  unsigned int const threadsCount =
+      max(1U, min(thread::hardware_concurrency(), kMaxApplyThreads));
+
+  // Ranges are applied by batches, so only a few sections are kept in memory.
+  vector<RangeToApply> batch;
+  size_t heavyRanges = 0;
+  for (uint32_t i = 0; i < rangesCount; ++i)
+  {
+    batch.emplace_back();
+    RangeToApply & range = batch.back();
+    range.m_type = static_cast<RangeType>(ReadPrimitiveFromSource<uint8_t>(diffFileSource));
+    range.m_size = ReadPrimitiveFromSource<uint64_t>(diffFileSource);
+    range.m_crc = ReadPrimitiveFromSource<uint32_t>(diffFileSource);
+
+    switch (range.m_type)
+    {
+    case RangeType::Copy:
+      range.m_oldOffset = ReadPrimitiveFromSource<uint64_t>(diffFileSource);
+      break;
+    case RangeType::Patch:
+    {
+      range.m_oldOffset = ReadPrimitiveFromSource<uint64_t>(diffFileSource);
+      auto const oldSize = ReadPrimitiveFromSource<uint64_t>(diffFileSource);
+      ReadBytes(oldReader, range.m_oldOffset, oldSize, range.m_oldBytes);
+      break;
+    }
+    case RangeType::Raw: break;
+    default:
+      LOG(LERROR, ("Unknown type of range of mwm diff:", static_cast<int>(range.m_type)));
+      return false;
+    }
+
+    if (range.m_type != RangeType::Copy)
+    {
+      auto const deflatedSize = ReadPrimitiveFromSource<uint64_t>(diffFileSource);
+      range.m_deflated.resize(base::checked_cast<size_t>(deflatedSize));
+      diffFileSource.Read(range.m_deflated.data(), range.m_deflated.size());
+      ++heavyRanges;
+    }
+
+    if (heavyRanges == threadsCount)
+    {
+      if (!ApplyRanges(oldReader, batch, newWriter))
+        return false;
+      heavyRanges = 0;
+    }
+  }
+
+  if (!ApplyRanges(oldReader, batch, newWriter))
+    return false;
+
+  if (newWriter.Pos() != newSize)
+  {
+    LOG(LERROR, ("Wrong size of the new mwm:", newWriter.Pos(), "instead of", newSize));
+    return false;
+  }
+  return true;
+}
 }  // namespace
 
 namespace generator
@@ -93,6 +475,29 @@ bool MakeDiff(string const & oldMwmPath, string const & newMwmPath, string const
     switch (VERSION_LATEST)
     {
     case VERSION_V0: return MakeDiffVersion0(oldReader, newReader, diffFileWriter);
+    case VERSION_V1:
+    {
+      // Files which are not valid containers are diffed as a whole.
+      unique_ptr<FilesContainerR> oldCont;
+      unique_ptr<FilesContainerR> newCont;
+      try
+      {
+        oldCont.reset(new FilesContainerR(oldMwmPath));
+        newCont.reset(new FilesContainerR(newMwmPath));
+      }
+      catch (Reader::Exception const & e)
+      {
+        LOG(LINFO, ("Making mwm diff of whole files:", e.Msg()));
+        return MakeDiffVersion0(oldReader, newReader, diffFileWriter);
+      }
+
+      if (MakeDiffVersion1(*oldCont, oldReader, *newCont, newReader, diffFileWriter))
+        return true;
+      if (diffFileWriter.Pos() != 0)
+        return false;
+      LOG(LINFO, ("Sections of", newMwmPath, "overlap, making mwm diff of whole files."));
+      return MakeDiffVersion0(oldReader, newReader, diffFileWriter);
+    }
     default:
       LOG(LERROR,
           ("Making mwm diffs with diff format version", VERSION_LATEST, "is not implemented"));
@@ -126,6 +531,7 @@ bool ApplyDiff(string const & oldMwmPath, string const & newMwmPath, string cons
     switch (version)
     {
     case VERSION_V0: return ApplyDiffVersion0(oldReader, newWriter, diffFileSource);
+    case VERSION_V1: return ApplyDiffVersion1(oldReader, newWriter, diffFileSource);
     default: LOG(LERROR, ("Unknown version format of mwm diff:", version));
     }
   }
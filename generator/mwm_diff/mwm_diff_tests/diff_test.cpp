@@ -4,12 +4,19 @@
 
 #include "platform/platform.hpp"
 
+#include "coding/file_container.hpp"
 #include "coding/file_name_utils.hpp"
+#include "coding/file_reader.hpp"
 #include "coding/file_writer.hpp"
 #include "coding/internal/file_data.hpp"
+#include "coding/reader.hpp"
 
 #include "base/scope_guard.hpp"
 
+#include <string>
+#include <utility>
+#include <vector>
+
 using namespace std;
 
 namespace generator
@@ -41,5 +48,67 @@ UNIT_TEST(IncrementalUpdates_Smoke)
 
   TEST(my::IsEqualFiles(newMwmPath1, newMwmPath2), ());
 }
+
+UNIT_TEST(IncrementalUpdates_Sections)
+{
+  string const oldMwmPath = my::JoinFoldersToPath(GetPlatform().WritableDir(), "sections-old.mwm");
+  string const newMwmPath1 =
+      my::JoinFoldersToPath(GetPlatform().WritableDir(), "sections-new1.mwm");
+  string const newMwmPath2 =
+      my::JoinFoldersToPath(GetPlatform().WritableDir(), "sections-new2.mwm");
+  string const diffPath = my::JoinFoldersToPath(GetPlatform().WritableDir(), "sections.mwmdiff");
+
+  MY_SCOPE_GUARD(cleanup, [&] {
+    FileWriter::DeleteFileX(oldMwmPath);
+    FileWriter::DeleteFileX(newMwmPath1);
+    FileWriter::DeleteFileX(newMwmPath2);
+    FileWriter::DeleteFileX(diffPath);
+  });
+
+  auto const makeSection = [](size_t size, char c) {
+    vector<char> section(size);
+    for (size_t i = 0; i < size; ++i)
+      section[i] = static_cast<char>(c + i % 7);
+    return section;
+  };
+
+  vector<char> const unchanged = makeSection(100000, 'a');
+  vector<char> changed = makeSection(50000, 'b');
+
+  {
+    FilesContainerW cont(oldMwmPath);
+    cont.Write(unchanged, "aaaa");
+    cont.Write(changed, "bbbb");
+    cont.Write(makeSection(1000, 'c'), "cccc");
+  }
+
+  changed[100] = 'x';
+  changed.resize(60000, 'y');
+  {
+    FilesContainerW cont(newMwmPath1);
+    cont.Write(changed, "bbbb");
+    cont.Write(unchanged, "aaaa");
+    cont.Write(makeSection(2000, 'd'), "dddd");
+  }
+
+  TEST(MakeDiff(oldMwmPath, newMwmPath1, diffPath), ());
+  {
+    FileReader const reader(diffPath);
+    TEST_EQUAL(ReadPrimitiveFromPos<uint32_t>(reader, 0), 1, ("Section diff is expected."));
+  }
+
+  TEST(ApplyDiff(oldMwmPath, newMwmPath2, diffPath), ());
+  TEST(my::IsEqualFiles(newMwmPath1, newMwmPath2), ());
+
+  // The copied section doesn't match its hash after the old mwm was changed.
+  {
+    FileWriter writer(oldMwmPath, FileWriter::OP_WRITE_EXISTING);
+    FilesContainerR const cont(oldMwmPath);
+    writer.Seek(cont.GetAbsoluteOffsetAndSize("aaaa").first);
+    char const c = 'z';
+    writer.Write(&c, sizeof(c));
+  }
+  TEST(!ApplyDiff(oldMwmPath, newMwmPath2, diffPath), ());
+}
 }  // namespace mwm_diff
 }  // namespace generator
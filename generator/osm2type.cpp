@@ -9,13 +9,17 @@
 #include "geometry/mercator.hpp"
 
 #include "base/assert.hpp"
+#include "base/buffer_vector.hpp"
 #include "base/stl_add.hpp"
 #include "base/string_utils.hpp"
 
+#include <algorithm>
 #include <cstdint>
 #include <functional>
 #include <initializer_list>
+#include <limits>
 #include <set>
+#include <unordered_map>
 #include <vector>
 
 using namespace std;
@@ -90,26 +94,94 @@ namespace ftype
       return res;
     }
 
-    template <typename TResult, class ToDo>
-    TResult ForEachTagEx(OsmElement * p, set<int> & skipTags, ToDo && toDo)
+    // Names of classificator objects interned to integer ids and the tree of
+    // objects where children of a node are sorted by ids of their names.
+    // Keys and values of an element are looked up in the table once, and
+    // then they are matched to the tree by comparisons of integers.
+    class ClassifTagIds
     {
-      int id = 0;
-      return ForEachTag<TResult>(p, [&](string const & k, string const & v)
+    public:
+      static uint32_t constexpr kNoId = numeric_limits<uint32_t>::max();
+
+      struct Child
+      {
+        uint32_t m_nameId;
+        uint32_t m_node;
+        // Index of the object in its parent, it's a component of a type.
+        uint8_t m_index;
+      };
+
+      ClassifTagIds()
+      {
+        m_nodes.emplace_back();
+        Build(*classif().GetRoot(), GetRoot());
+      }
+
+      static uint32_t GetRoot() { return 0; }
+
+      uint32_t GetId(string const & name) const
+      {
+        auto const it = m_ids.find(name);
+        return it == m_ids.end() ? kNoId : it->second;
+      }
+
+      // Returns a child of |node| which name has |nameId|, or nullptr.
+      Child const * Find(uint32_t node, uint32_t nameId) const
       {
-        int currentId = id++;
-        if (skipTags.count(currentId) != 0)
-          return TResult();
-        if (string::npos != k.find("name"))
+        if (nameId == kNoId)
+          return nullptr;
+
+        auto const & range = m_nodes[node];
+        auto const first = m_children.begin() + range.first;
+        auto const last = m_children.begin() + range.second;
+        auto const it = lower_bound(first, last, nameId, [](Child const & child, uint32_t id)
         {
-          skipTags.insert(currentId);
-          return TResult();
+          return child.m_nameId < id;
+        });
+        return it != last && it->m_nameId == nameId ? &(*it) : nullptr;
+      }
+
+    private:
+      uint32_t Intern(string const & name)
+      {
+        return m_ids.emplace(name, static_cast<uint32_t>(m_ids.size())).first->second;
+      }
+
+      void Build(ClassifObject const & object, uint32_t node)
+      {
+        vector<ClassifObject const *> objects;
+        object.ForEachObject([&objects](ClassifObject const * o) { objects.push_back(o); });
+
+        auto const first = static_cast<uint32_t>(m_children.size());
+        for (size_t i = 0; i < objects.size(); ++i)
+        {
+          m_children.push_back({Intern(objects[i]->GetName()), static_cast<uint32_t>(m_nodes.size()),
+                                static_cast<uint8_t>(i)});
+          m_nodes.emplace_back();
         }
-        TResult res = toDo(k, v);
-        if (res)
-          skipTags.insert(currentId);
-        return res;
-      });
-    }
+        auto const last = static_cast<uint32_t>(m_children.size());
+        m_nodes[node] = make_pair(first, last);
+
+        // Objects are sorted by names, so the stable sort keeps the first
+        // of equal names first, as ClassifObject::BinaryFind() finds it.
+        stable_sort(m_children.begin() + first, m_children.begin() + last,
+                    [](Child const & lhs, Child const & rhs) { return lhs.m_nameId < rhs.m_nameId; });
+
+        for (uint32_t i = first; i < last; ++i)
+        {
+          Child const child = m_children[i];
+          Build(*objects[child.m_index], child.m_node);
+        }
+      }
+
+      unordered_map<string, uint32_t> m_ids;
+      // Ranges of children of nodes in |m_children|.
+      vector<pair<uint32_t, uint32_t>> m_nodes;
+      vector<Child> m_children;
+    };
+
+    // static
+    uint32_t constexpr ClassifTagIds::kNoId;
 
     class NamesExtractor
     {
@@ -268,71 +340,99 @@ namespace ftype
 
   void MatchTypes(OsmElement * p, FeatureParams & params)
   {
-    set<int> skipRows;
-    vector<ClassifObjectPtr> path;
-    ClassifObject const * current = nullptr;
+    static ClassifTagIds const ids;
 
-    auto matchTagToClassificator = [&path, &current](string const & k, string const & v) -> bool
+    struct TagIds
     {
-      // First try to match key.
-      ClassifObjectPtr elem = current->BinaryFind(k);
-      if (!elem)
-        return false;
+      uint32_t m_key;
+      // kNoId when the value must not be matched.
+      uint32_t m_value;
+      bool m_isMatched;
+    };
+
+    // Tags which may be matched to the classificator, names are never matched.
+    buffer_vector<TagIds, 32> tags;
+    for (auto const & e : p->m_tags)
+    {
+      if (IgnoreTag(e.key, e.value) || string::npos != e.key.find("name"))
+        continue;
+
+      uint32_t const key = ids.GetId(e.key);
+      uint32_t const value = NeedMatchValue(e.key, e.value) ? ids.GetId(e.value) : ClassifTagIds::kNoId;
+      if (key != ClassifTagIds::kNoId || value != ClassifTagIds::kNoId)
+        tags.push_back({key, value, false /* isMatched */});
+    }
+
+    buffer_vector<ClassifTagIds::Child const *, 8> path;
+    uint32_t current = ClassifTagIds::GetRoot();
+
+    auto const matchByKey = [&]() -> bool
+    {
+      for (auto & tag : tags)
+      {
+        if (tag.m_isMatched)
+          continue;
+
+        // First try to match key.
+        auto const * elem = ids.Find(current, tag.m_key);
+        if (!elem)
+          continue;
+
+        path.push_back(elem);
 
-      path.push_back(elem);
+        // Now try to match correspondent value.
+        if (auto const * velem = ids.Find(elem->m_node, tag.m_value))
+          path.push_back(velem);
 
-      // Now try to match correspondent value.
-      if (!NeedMatchValue(k, v))
+        tag.m_isMatched = true;
         return true;
+      }
+      return false;
+    };
 
-      if (ClassifObjectPtr velem = elem->BinaryFind(v))
-        path.push_back(velem);
+    auto const matchByValue = [&]() -> bool
+    {
+      for (auto & tag : tags)
+      {
+        if (tag.m_isMatched)
+          continue;
 
-      return true;
+        if (auto const * elem = ids.Find(current, tag.m_value))
+        {
+          path.push_back(elem);
+          tag.m_isMatched = true;
+          return true;
+        }
+      }
+      return false;
     };
 
     do
     {
-      current = classif().GetRoot();
+      current = ClassifTagIds::GetRoot();
       path.clear();
 
       // Find first root object by key.
-      if (!ForEachTagEx<bool>(p, skipRows, matchTagToClassificator))
+      if (!matchByKey())
         break;
       CHECK(!path.empty(), ());
 
       do
       {
         // Continue find path from last element.
-        current = path.back().get();
+        current = path.back()->m_node;
 
         // Next objects trying to find by value first.
         // Prevent merging different tags (e.g. shop=pet from shop=abandoned, was:shop=pet).
-       ClassifObjectPtr pObj =
-           path.size() == 1 ? ClassifObjectPtr()
-                            : ForEachTagEx<ClassifObjectPtr>(
-                                  p, skipRows, [&current](string const & k, string const & v) {
-                                    if (!NeedMatchValue(k, v))
-                                      return ClassifObjectPtr();
-                                    return current->BinaryFind(v);
-                                  });
-
-        if (pObj)
-        {
-          path.push_back(pObj);
-        }
-        else
-        {
-          // If no - try find object by key (in case of k = "area", v = "yes").
-          if (!ForEachTagEx<bool>(p, skipRows, matchTagToClassificator))
-            break;
-        }
+        // If no - try find object by key (in case of k = "area", v = "yes").
+        if ((path.size() == 1 || !matchByValue()) && !matchByKey())
+          break;
       } while (true);
 
       // Assign type.
       uint32_t t = ftype::GetEmptyValue();
-      for (auto const & e : path)
-        ftype::PushValue(t, e.GetIndex());
+      for (auto const * e : path)
+        ftype::PushValue(t, e->m_index);
 
       // Use features only with drawing rules.
       if (feature::IsDrawableAny(t))
@@ -0,0 +1,276 @@
+#include "generator/osm_change.hpp"
+
+#include "generator/borders_loader.hpp"
+#include "generator/intermediate_data.hpp"
+#include "generator/intermediate_elements.hpp"
+#include "generator/osm_source.hpp"
+#include "generator/osm_xml_source.hpp"
+
+#include "platform/platform.hpp"
+
+#include "geometry/mercator.hpp"
+
+#include "coding/parse_xml.hpp"
+
+#include "base/logging.hpp"
+
+#include "defines.hpp"
+
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+using namespace std;
+
+namespace generator
+{
+namespace
+{
+// Elements of osmChange are grouped by actions, so XMLSource is given
+// elements without the tags of actions.
+class OsmChangeSource
+{
+public:
+  using TEmitterFn = function<void(OsmChangeAction, OsmElement *)>;
+
+  explicit OsmChangeSource(TEmitterFn const & fn)
+    : m_emitterFn(fn), m_source([this](OsmElement * e) { m_emitterFn(m_action, e); })
+  {
+  }
+
+  void CharData(string const & data) { m_source.CharData(data); }
+
+  void AddAttr(string const & key, string const & value)
+  {
+    if (m_depth != 2)
+      m_source.AddAttr(key, value);
+  }
+
+  bool Push(string const & tagName)
+  {
+    if (++m_depth != 2)
+      return m_source.Push(tagName);
+
+    if (tagName == "create")
+    {
+      m_action = OsmChangeAction::Create;
+    }
+    else if (tagName == "delete")
+    {
+      m_action = OsmChangeAction::Delete;
+    }
+    else
+    {
+      if (tagName != "modify")
+        LOG(LWARNING, ("Unknown action", tagName, "in osmChange, processed as modify"));
+      m_action = OsmChangeAction::Modify;
+    }
+    return true;
+  }
+
+  void Pop(string const & tagName)
+  {
+    if (m_depth-- != 2)
+      m_source.Pop(tagName);
+  }
+
+private:
+  TEmitterFn m_emitterFn;
+  XMLSource m_source;
+  size_t m_depth = 0;
+  OsmChangeAction m_action = OsmChangeAction::Modify;
+};
+
+struct OsmChange
+{
+  // Positions of created and modified nodes.
+  unordered_map<uint64_t, m2::PointD> m_points;
+  // Nodes of created and modified ways.
+  unordered_map<uint64_t, vector<uint64_t>> m_ways;
+  // Elements which geometry is taken from the previous intermediate data.
+  unordered_set<uint64_t> m_oldNodes;
+  unordered_set<uint64_t> m_oldWays;
+  // Created elements which aren't in the previous intermediate data.
+  unordered_set<uint64_t> m_createdNodes;
+  unordered_set<uint64_t> m_createdWays;
+
+  void AddNodes(vector<uint64_t> const & nodes)
+  {
+    for (auto const id : nodes)
+      AddOldNode(id);
+  }
+
+  void AddOldNode(uint64_t id)
+  {
+    if (m_createdNodes.count(id) == 0)
+      m_oldNodes.insert(id);
+  }
+};
+
+void AddElement(OsmChangeAction action, OsmElement const & e, OsmChange & change)
+{
+  bool const isCreated = action == OsmChangeAction::Create;
+  switch (e.type)
+  {
+  case OsmElement::EntityType::Node:
+    if (isCreated)
+      change.m_createdNodes.insert(e.id);
+    else
+      change.m_oldNodes.insert(e.id);
+    // Deleted nodes may have no coordinates.
+    if (action != OsmChangeAction::Delete)
+      change.m_points[e.id] = MercatorBounds::FromLatLon(e.lat, e.lon);
+    break;
+  case OsmElement::EntityType::Way:
+    if (isCreated)
+      change.m_createdWays.insert(e.id);
+    else
+      change.m_oldWays.insert(e.id);
+    if (action != OsmChangeAction::Delete)
+      change.m_ways[e.id] = e.Nodes();
+    break;
+  case OsmElement::EntityType::Relation:
+    // Geometry of a relation is geometry of its members. Old members of modified
+    // relations aren't taken into account, they are removed from the relation only.
+    for (auto const & member : e.Members())
+    {
+      if (member.type == OsmElement::EntityType::Node)
+        change.m_oldNodes.insert(member.ref);
+      else if (member.type == OsmElement::EntityType::Way)
+        change.m_oldWays.insert(member.ref);
+    }
+    break;
+  default:
+    break;
+  }
+}
+
+template <class TNodesHolder>
+void CollectPoints(feature::GenerateInfo const & info, OsmChange & change,
+                   vector<m2::PointD> & points)
+{
+  // Members of relations may be created by the same change.
+  for (auto const id : change.m_createdNodes)
+    change.m_oldNodes.erase(id);
+  for (auto const id : change.m_createdWays)
+    change.m_oldWays.erase(id);
+
+  for (auto const & way : change.m_ways)
+    change.AddNodes(way.second);
+
+  {
+    cache::OSMElementCache<cache::EMode::Read> ways(info.GetIntermediateFileName(WAYS_FILE, ""),
+                                                   info.m_preloadCache);
+    ways.LoadOffsets();
+
+    for (auto const id : change.m_oldWays)
+    {
+      WayElement way(id);
+      if (ways.Read(id, way))
+        change.AddNodes(way.nodes);
+    }
+  }
+
+  TNodesHolder nodes(info.GetIntermediateFileName(NODES_FILE, ""));
+  for (auto const id : change.m_oldNodes)
+  {
+    double lat, lon;
+    if (nodes.GetPoint(id, lat, lon))
+      points.push_back(MercatorBounds::FromLatLon(lat, lon));
+  }
+
+  for (auto const & point : change.m_points)
+    points.push_back(point.second);
+}
+}  // namespace
+
+string DebugPrint(OsmChangeAction action)
+{
+  switch (action)
+  {
+  case OsmChangeAction::Create: return "create";
+  case OsmChangeAction::Modify: return "modify";
+  case OsmChangeAction::Delete: return "delete";
+  }
+  return string();
+}
+
+void ProcessOsmChange(SourceReader & stream, function<void(OsmChangeAction, OsmElement *)> processor)
+{
+  OsmChangeSource parser(processor);
+  ParseXMLSequence(stream, parser);
+}
+
+bool FindCountriesAffectedByOsmChange(feature::GenerateInfo const & info,
+                                      string const & osmChangeFileName, set<string> & countries)
+{
+  if (!Platform::IsFileExistsByFullPath(osmChangeFileName))
+  {
+    LOG(LERROR, ("Can't find osmChange file", osmChangeFileName));
+    return false;
+  }
+
+  OsmChange change;
+  {
+    SourceReader reader(osmChangeFileName);
+    ProcessOsmChange(reader, [&change](OsmChangeAction action, OsmElement * e)
+    {
+      AddElement(action, *e, change);
+    });
+  }
+
+  vector<m2::PointD> points;
+  try
+  {
+    switch (info.m_nodeStorageType)
+    {
+    case feature::GenerateInfo::NodeStorageType::File:
+      CollectPoints<cache::RawFilePointStorage<cache::EMode::Read>>(info, change, points);
+      break;
+    case feature::GenerateInfo::NodeStorageType::Index:
+      CollectPoints<cache::MapFilePointStorage<cache::EMode::Read>>(info, change, points);
+      break;
+    case feature::GenerateInfo::NodeStorageType::Memory:
+      CollectPoints<cache::RawMemPointStorage<cache::EMode::Read>>(info, change, points);
+      break;
+    case feature::GenerateInfo::NodeStorageType::Packed:
+      CollectPoints<cache::PackedFilePointStorage<cache::EMode::Read>>(info, change, points);
+      break;
+    }
+  }
+  catch (Reader::Exception const & ex)
+  {
+    LOG(LERROR, ("Error with intermediate data", ex.Msg()));
+    return false;
+  }
+
+  borders::CountriesContainerT borders;
+  if (!borders::LoadCountriesList(info.m_targetDir, borders))
+  {
+    LOG(LERROR, ("Can't load countries borders from", info.m_targetDir));
+    return false;
+  }
+
+  for (auto const & point : points)
+  {
+    m2::RectD const rect(point, point);
+    borders.ForEachInRect(rect, [&](borders::CountryPolygons const & country)
+    {
+      if (countries.count(country.m_name) != 0)
+        return;
+
+      bool contains = false;
+      country.m_regions.ForEachInRect(rect, [&](borders::Region const & region)
+      {
+        if (!contains)
+          contains = region.Contains(point);
+      });
+      if (contains)
+        countries.insert(country.m_name);
+    });
+  }
+
+  LOG(LINFO, ("Changed points:", points.size(), "affected countries:", countries.size()));
+  return true;
+}
+}  // namespace generator
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "generator/generate_info.hpp"
+#include "generator/osm_element.hpp"
+
+#include <functional>
+#include <set>
+#include <string>
+
+class SourceReader;
+
+namespace generator
+{
+// Actions of an osmChange file, see http://wiki.openstreetmap.org/wiki/OsmChange
+enum class OsmChangeAction
+{
+  Create,
+  Modify,
+  Delete
+};
+
+std::string DebugPrint(OsmChangeAction action);
+
+void ProcessOsmChange(SourceReader & stream,
+                      std::function<void(OsmChangeAction, OsmElement *)> processor);
+
+// Finds countries which mwms may be changed by the osmChange file. New geometry of
+// changed elements is taken from the change and the old one is taken from intermediate
+// data of the previous generation, so it must be called before the intermediate data
+// is regenerated. A country is found by points of changed nodes, ways and members of
+// relations. Returns false when the change can't be read.
+bool FindCountriesAffectedByOsmChange(feature::GenerateInfo const & info,
+                                      std::string const & osmChangeFileName,
+                                      std::set<std::string> & countries);
+}  // namespace generator
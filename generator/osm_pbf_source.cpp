@@ -0,0 +1,537 @@
+#include "generator/osm_pbf_source.hpp"
+
+#include "coding/zlib.hpp"
+
+#include "base/assert.hpp"
+#include "base/logging.hpp"
+
+#include <iterator>
+
+using namespace std;
+
+namespace osm
+{
+namespace
+{
+// Limits from the format specification.
+uint32_t const kMaxBlobHeaderSize = 64 * 1024;
+uint32_t const kMaxBlobSize = 32 * 1024 * 1024;
+
+enum WireType : uint32_t
+{
+  Varint = 0,
+  Fixed64 = 1,
+  LengthDelimited = 2,
+  Fixed32 = 5
+};
+
+// Minimal reader of protobuf messages. It doesn't throw, a malformed
+// message makes the reader invalid and stops iteration over fields.
+class ProtoReader
+{
+public:
+  ProtoReader() = default;
+  ProtoReader(uint8_t const * data, size_t size) : m_cur(data), m_end(data + size) {}
+
+  bool IsValid() const { return m_isValid; }
+
+  // Reads a key of the next field, returns false at the end of the message.
+  bool Next()
+  {
+    if (!m_isValid || m_cur == m_end)
+      return false;
+    uint64_t const key = ReadVarint();
+    m_field = static_cast<uint32_t>(key >> 3);
+    m_wireType = static_cast<uint32_t>(key & 0x7);
+    return m_isValid;
+  }
+
+  uint32_t GetField() const { return m_field; }
+
+  uint64_t GetUInt()
+  {
+    Expect(WireType::Varint);
+    return ReadVarint();
+  }
+
+  int64_t GetInt() { return static_cast<int64_t>(GetUInt()); }
+  int64_t GetSInt() { return DecodeZigZag(GetUInt()); }
+
+  ProtoReader GetMessage()
+  {
+    Expect(WireType::LengthDelimited);
+    return ReadLengthDelimited();
+  }
+
+  string GetString()
+  {
+    ProtoReader const r = GetMessage();
+    return string(r.m_cur, r.m_end);
+  }
+
+  pair<uint8_t const *, size_t> GetBytes()
+  {
+    ProtoReader const r = GetMessage();
+    return make_pair(r.m_cur, static_cast<size_t>(r.m_end - r.m_cur));
+  }
+
+  // Calls |toDo| for every value of a repeated varint field, which may be
+  // packed or not.
+  template <typename ToDo>
+  void ForEachUInt(ToDo && toDo)
+  {
+    if (m_wireType == WireType::Varint)
+    {
+      uint64_t const value = ReadVarint();
+      if (m_isValid)
+        toDo(value);
+      return;
+    }
+
+    ProtoReader packed = GetMessage();
+    while (packed.m_isValid && packed.m_cur != packed.m_end)
+    {
+      uint64_t const value = packed.ReadVarint();
+      if (packed.m_isValid)
+        toDo(value);
+    }
+    m_isValid = m_isValid && packed.m_isValid;
+  }
+
+  void Skip()
+  {
+    switch (m_wireType)
+    {
+    case WireType::Varint: ReadVarint(); break;
+    case WireType::Fixed64: Advance(8); break;
+    case WireType::LengthDelimited: ReadLengthDelimited(); break;
+    case WireType::Fixed32: Advance(4); break;
+    default: m_isValid = false;
+    }
+  }
+
+  static int64_t DecodeZigZag(uint64_t value)
+  {
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+  }
+
+private:
+  void Expect(uint32_t wireType)
+  {
+    if (m_wireType != wireType)
+      m_isValid = false;
+  }
+
+  uint64_t ReadVarint()
+  {
+    uint64_t result = 0;
+    for (uint32_t shift = 0; m_isValid && shift < 64; shift += 7)
+    {
+      if (m_cur == m_end)
+        break;
+      uint8_t const byte = *m_cur++;
+      result |= static_cast<uint64_t>(byte & 0x7F) << shift;
+      if ((byte & 0x80) == 0)
+        return result;
+    }
+    m_isValid = false;
+    return 0;
+  }
+
+  ProtoReader ReadLengthDelimited()
+  {
+    uint64_t const size = ReadVarint();
+    if (!m_isValid || size > static_cast<uint64_t>(m_end - m_cur))
+    {
+      m_isValid = false;
+      return ProtoReader();
+    }
+    ProtoReader result(m_cur, static_cast<size_t>(size));
+    m_cur += size;
+    return result;
+  }
+
+  void Advance(size_t size)
+  {
+    if (size > static_cast<size_t>(m_end - m_cur))
+      m_isValid = false;
+    else
+      m_cur += size;
+  }
+
+  uint8_t const * m_cur = nullptr;
+  uint8_t const * m_end = nullptr;
+  uint32_t m_field = 0;
+  uint32_t m_wireType = 0;
+  bool m_isValid = true;
+};
+
+// Common data of a PrimitiveBlock message.
+struct BlockContext
+{
+  double GetLat(int64_t lat) const { return 1e-9 * (m_latOffset + m_granularity * lat); }
+  double GetLon(int64_t lon) const { return 1e-9 * (m_lonOffset + m_granularity * lon); }
+
+  bool AddTag(OsmElement & e, uint64_t key, uint64_t value) const
+  {
+    if (key >= m_strings.size() || value >= m_strings.size())
+      return false;
+    e.AddTag(m_strings[key], m_strings[value]);
+    return true;
+  }
+
+  bool AddTags(OsmElement & e, vector<uint64_t> const & keys, vector<uint64_t> const & values) const
+  {
+    if (keys.size() != values.size())
+      return false;
+    for (size_t i = 0; i < keys.size(); ++i)
+    {
+      if (!AddTag(e, keys[i], values[i]))
+        return false;
+    }
+    return true;
+  }
+
+  vector<string> m_strings;
+  int64_t m_granularity = 100;
+  int64_t m_latOffset = 0;
+  int64_t m_lonOffset = 0;
+};
+
+bool ReadFully(PBFSource::TReaderFn const & reader, uint8_t * buffer, size_t size)
+{
+  while (size != 0)
+  {
+    size_t const readBytes = reader(buffer, size);
+    if (readBytes == 0)
+      return false;
+    buffer += readBytes;
+    size -= readBytes;
+  }
+  return true;
+}
+
+void ReadUInts(ProtoReader & reader, vector<uint64_t> & values)
+{
+  reader.ForEachUInt([&values](uint64_t v) { values.push_back(v); });
+}
+
+// Decodes a repeated delta coded sint64 field.
+void ReadDeltas(ProtoReader & reader, vector<int64_t> & values)
+{
+  int64_t current = values.empty() ? 0 : values.back();
+  reader.ForEachUInt([&values, &current](uint64_t v)
+  {
+    current += ProtoReader::DecodeZigZag(v);
+    values.push_back(current);
+  });
+}
+
+bool DecodeNode(ProtoReader reader, BlockContext const & context, vector<OsmElement> & elements)
+{
+  OsmElement e;
+  e.type = OsmElement::EntityType::Node;
+  vector<uint64_t> keys;
+  vector<uint64_t> values;
+  int64_t lat = 0;
+  int64_t lon = 0;
+  while (reader.Next())
+  {
+    switch (reader.GetField())
+    {
+    case 1: e.id = static_cast<uint64_t>(reader.GetSInt()); break;
+    case 2: ReadUInts(reader, keys); break;
+    case 3: ReadUInts(reader, values); break;
+    case 8: lat = reader.GetSInt(); break;
+    case 9: lon = reader.GetSInt(); break;
+    default: reader.Skip();
+    }
+  }
+  if (!reader.IsValid() || !context.AddTags(e, keys, values))
+    return false;
+
+  e.lat = context.GetLat(lat);
+  e.lon = context.GetLon(lon);
+  elements.push_back(move(e));
+  return true;
+}
+
+bool DecodeDenseNodes(ProtoReader reader, BlockContext const & context,
+                      vector<OsmElement> & elements)
+{
+  vector<int64_t> ids;
+  vector<int64_t> lats;
+  vector<int64_t> lons;
+  vector<uint64_t> keysValues;
+  while (reader.Next())
+  {
+    switch (reader.GetField())
+    {
+    case 1: ReadDeltas(reader, ids); break;
+    case 8: ReadDeltas(reader, lats); break;
+    case 9: ReadDeltas(reader, lons); break;
+    case 10: ReadUInts(reader, keysValues); break;
+    default: reader.Skip();
+    }
+  }
+  if (!reader.IsValid() || ids.size() != lats.size() || ids.size() != lons.size())
+    return false;
+
+  // Tags of all nodes are stored as key-value pairs, tags of every node end with zero.
+  size_t pos = 0;
+  elements.reserve(elements.size() + ids.size());
+  for (size_t i = 0; i < ids.size(); ++i)
+  {
+    OsmElement e;
+    e.type = OsmElement::EntityType::Node;
+    e.id = static_cast<uint64_t>(ids[i]);
+    e.lat = context.GetLat(lats[i]);
+    e.lon = context.GetLon(lons[i]);
+
+    while (pos < keysValues.size() && keysValues[pos] != 0)
+    {
+      if (pos + 1 == keysValues.size() || !context.AddTag(e, keysValues[pos], keysValues[pos + 1]))
+        return false;
+      pos += 2;
+    }
+    ++pos;
+
+    elements.push_back(move(e));
+  }
+  return true;
+}
+
+bool DecodeWay(ProtoReader reader, BlockContext const & context, vector<OsmElement> & elements)
+{
+  OsmElement e;
+  e.type = OsmElement::EntityType::Way;
+  vector<uint64_t> keys;
+  vector<uint64_t> values;
+  vector<int64_t> refs;
+  while (reader.Next())
+  {
+    switch (reader.GetField())
+    {
+    case 1: e.id = static_cast<uint64_t>(reader.GetInt()); break;
+    case 2: ReadUInts(reader, keys); break;
+    case 3: ReadUInts(reader, values); break;
+    case 8: ReadDeltas(reader, refs); break;
+    default: reader.Skip();
+    }
+  }
+  if (!reader.IsValid() || !context.AddTags(e, keys, values))
+    return false;
+
+  e.m_nds.reserve(refs.size());
+  for (auto const ref : refs)
+    e.AddNd(static_cast<uint64_t>(ref));
+  elements.push_back(move(e));
+  return true;
+}
+
+bool DecodeRelation(ProtoReader reader, BlockContext const & context,
+                    vector<OsmElement> & elements)
+{
+  OsmElement e;
+  e.type = OsmElement::EntityType::Relation;
+  vector<uint64_t> keys;
+  vector<uint64_t> values;
+  vector<uint64_t> roles;
+  vector<int64_t> ids;
+  vector<uint64_t> types;
+  while (reader.Next())
+  {
+    switch (reader.GetField())
+    {
+    case 1: e.id = static_cast<uint64_t>(reader.GetInt()); break;
+    case 2: ReadUInts(reader, keys); break;
+    case 3: ReadUInts(reader, values); break;
+    case 8: ReadUInts(reader, roles); break;
+    case 9: ReadDeltas(reader, ids); break;
+    case 10: ReadUInts(reader, types); break;
+    default: reader.Skip();
+    }
+  }
+  if (!reader.IsValid() || !context.AddTags(e, keys, values) || roles.size() != ids.size() ||
+      types.size() != ids.size())
+  {
+    return false;
+  }
+
+  for (size_t i = 0; i < ids.size(); ++i)
+  {
+    if (roles[i] >= context.m_strings.size())
+      return false;
+
+    OsmElement::EntityType type;
+    switch (types[i])
+    {
+    case 0: type = OsmElement::EntityType::Node; break;
+    case 1: type = OsmElement::EntityType::Way; break;
+    case 2: type = OsmElement::EntityType::Relation; break;
+    default: return false;
+    }
+    e.AddMember(static_cast<uint64_t>(ids[i]), type, context.m_strings[roles[i]]);
+  }
+  elements.push_back(move(e));
+  return true;
+}
+
+bool DecodePrimitiveBlock(ProtoReader reader, vector<OsmElement> & elements)
+{
+  // Groups are decoded when the string table and the granularity are known.
+  BlockContext context;
+  vector<ProtoReader> groups;
+  while (reader.Next())
+  {
+    switch (reader.GetField())
+    {
+    case 1:
+    {
+      ProtoReader table = reader.GetMessage();
+      while (table.Next())
+      {
+        if (table.GetField() == 1)
+          context.m_strings.push_back(table.GetString());
+        else
+          table.Skip();
+      }
+      if (!table.IsValid())
+        return false;
+      break;
+    }
+    case 2: groups.push_back(reader.GetMessage()); break;
+    case 17: context.m_granularity = reader.GetInt(); break;
+    case 19: context.m_latOffset = reader.GetInt(); break;
+    case 20: context.m_lonOffset = reader.GetInt(); break;
+    default: reader.Skip();
+    }
+  }
+  if (!reader.IsValid())
+    return false;
+
+  for (auto & group : groups)
+  {
+    while (group.Next())
+    {
+      bool isDecoded = true;
+      switch (group.GetField())
+      {
+      case 1: isDecoded = DecodeNode(group.GetMessage(), context, elements); break;
+      case 2: isDecoded = DecodeDenseNodes(group.GetMessage(), context, elements); break;
+      case 3: isDecoded = DecodeWay(group.GetMessage(), context, elements); break;
+      case 4: isDecoded = DecodeRelation(group.GetMessage(), context, elements); break;
+      default: group.Skip();
+      }
+      if (!isDecoded)
+        return false;
+    }
+    if (!group.IsValid())
+      return false;
+  }
+  return true;
+}
+
+bool CheckHeaderBlock(ProtoReader reader)
+{
+  while (reader.Next())
+  {
+    // Required features.
+    if (reader.GetField() != 4)
+    {
+      reader.Skip();
+      continue;
+    }
+
+    string const feature = reader.GetString();
+    if (feature != "OsmSchema-V0.6" && feature != "DenseNodes")
+    {
+      LOG(LERROR, ("Unsupported feature of PBF data:", feature));
+      return false;
+    }
+  }
+  return reader.IsValid();
+}
+}  // namespace
+
+bool PBFSource::ReadBlob(Blob & blob)
+{
+  uint8_t sizeBuffer[4];
+  if (!ReadFully(m_reader, sizeBuffer, sizeof(sizeBuffer)))
+    return false;
+
+  uint32_t const headerSize = (static_cast<uint32_t>(sizeBuffer[0]) << 24) |
+                              (static_cast<uint32_t>(sizeBuffer[1]) << 16) |
+                              (static_cast<uint32_t>(sizeBuffer[2]) << 8) |
+                              static_cast<uint32_t>(sizeBuffer[3]);
+  CHECK_LESS_OR_EQUAL(headerSize, kMaxBlobHeaderSize, ("Invalid size of PBF blob header."));
+  m_header.resize(headerSize);
+  CHECK(ReadFully(m_reader, m_header.data(), headerSize), ("Unexpected end of PBF input."));
+
+  blob.m_type.clear();
+  uint64_t dataSize = 0;
+  ProtoReader header(m_header.data(), m_header.size());
+  while (header.Next())
+  {
+    switch (header.GetField())
+    {
+    case 1: blob.m_type = header.GetString(); break;
+    case 3: dataSize = header.GetUInt(); break;
+    default: header.Skip();
+    }
+  }
+  CHECK(header.IsValid(), ("Malformed PBF blob header."));
+  CHECK_LESS_OR_EQUAL(dataSize, kMaxBlobSize, ("Invalid size of PBF blob."));
+
+  blob.m_data.resize(static_cast<size_t>(dataSize));
+  CHECK(ReadFully(m_reader, blob.m_data.data(), blob.m_data.size()),
+        ("Unexpected end of PBF input."));
+  return true;
+}
+
+// static
+bool PBFSource::DecodeBlob(Blob const & blob, vector<OsmElement> & elements)
+{
+  bool const isData = blob.m_type == "OSMData";
+  if (!isData && blob.m_type != "OSMHeader")
+    return true;
+
+  pair<uint8_t const *, size_t> raw(nullptr, 0);
+  pair<uint8_t const *, size_t> compressed(nullptr, 0);
+  uint64_t rawSize = 0;
+  ProtoReader reader(blob.m_data.data(), blob.m_data.size());
+  while (reader.Next())
+  {
+    switch (reader.GetField())
+    {
+    case 1: raw = reader.GetBytes(); break;
+    case 2: rawSize = reader.GetUInt(); break;
+    case 3: compressed = reader.GetBytes(); break;
+    case 4:
+    case 5:
+    case 6:
+    case 7:
+      LOG(LERROR, ("Only zlib compression of PBF data is supported."));
+      return false;
+    default: reader.Skip();
+    }
+  }
+  if (!reader.IsValid())
+    return false;
+
+  vector<uint8_t> buffer;
+  if (compressed.first != nullptr)
+  {
+    if (rawSize > kMaxBlobSize)
+      return false;
+    buffer.reserve(static_cast<size_t>(rawSize));
+    coding::ZLib::Inflate const inflate(coding::ZLib::Inflate::Format::ZLib);
+    if (!inflate(compressed.first, compressed.second, back_inserter(buffer)))
+      return false;
+    raw = make_pair(buffer.data(), buffer.size());
+  }
+
+  ProtoReader const message(raw.first, raw.second);
+  return isData ? DecodePrimitiveBlock(message, elements) : CheckHeaderBlock(message);
+}
+}  // namespace osm
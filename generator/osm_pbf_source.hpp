@@ -0,0 +1,43 @@
+// See PBF Format definition at http://wiki.openstreetmap.org/wiki/PBF_Format
+#pragma once
+
+#include "generator/osm_element.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace osm
+{
+// Reads OSM data in the PBF format. A file is a sequence of blobs which
+// don't depend on each other, so blobs are read sequentially by ReadBlob()
+// and can be decoded on several threads by DecodeBlob().
+class PBFSource
+{
+public:
+  using TReaderFn = std::function<size_t(uint8_t *, size_t)>;
+
+  struct Blob
+  {
+    // "OSMHeader" or "OSMData", blobs of other types must be skipped.
+    std::string m_type;
+    // Serialized Blob message, it's compressed usually.
+    std::vector<uint8_t> m_data;
+  };
+
+  explicit PBFSource(TReaderFn const & reader) : m_reader(reader) {}
+
+  // Returns false at the end of the input.
+  bool ReadBlob(Blob & blob);
+
+  // Appends nodes, ways and relations of |blob| to |elements| in the order
+  // of the file. Returns false when the blob is malformed.
+  static bool DecodeBlob(Blob const & blob, std::vector<OsmElement> & elements);
+
+private:
+  TReaderFn m_reader;
+  std::vector<uint8_t> m_header;
+};
+}  // namespace osm
@@ -4,6 +4,7 @@
 #include "generator/intermediate_elements.hpp"
 #include "generator/osm_element.hpp"
 #include "generator/osm_o5m_source.hpp"
+#include "generator/osm_pbf_source.hpp"
 #include "generator/osm_source.hpp"
 #include "generator/osm_translator.hpp"
 #include "generator/osm_xml_source.hpp"
@@ -30,6 +31,11 @@
 
 #include "defines.hpp"
 
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
 using namespace std;
 
 SourceReader::SourceReader()
@@ -64,7 +70,8 @@ class IntermediateData
 {
   using TReader = cache::OSMElementCache<TMode>;
 
-  using TFile = typename conditional<TMode == cache::EMode::Write, FileWriter, FileReader>::type;
+  using TFile =
+      typename conditional<TMode == cache::EMode::Write, BufferedFileWriter, FileReader>::type;
 
   using TKey = uint64_t;
   static_assert(is_integral<TKey>::value, "TKey is not integral type");
@@ -431,17 +438,14 @@ public:
       size_t totalPoints = 0;
       size_t totalPolygons = 0;
 
-      vector<FeatureBuilder1> vecFb;
-      m_coasts->GetFeatures(vecFb);
-
-      for (auto & fb : vecFb)
+      m_coasts->ForEachFeature([&](FeatureBuilder1 & fb)
       {
         (*m_coastsHolder)(fb);
 
         ++totalFeatures;
         totalPoints += fb.GetPointsCount();
         totalPolygons += fb.GetPolygonsCount();
-      }
+      });
       LOG(LINFO, ("Total features:", totalFeatures, "total polygons:", totalPolygons,
                   "total points:", totalPoints));
     }
@@ -592,6 +596,285 @@ void AddElementToCache(TCache & cache, TElement const & em)
   }
 }
 
+namespace
+{
+// Count of O5M elements which are handed over to processing at once.
+size_t const kO5MBatchSize = 4096;
+
+// Reads tasks sequentially on a separate thread, decodes them into batches
+// of elements on |workersCount| threads and hands batches over to the
+// calling thread in the order of the source. When there are no workers,
+// everything is done on the calling thread.
+template <typename TTask>
+class OsmElementsPipeline
+{
+public:
+  // Called on one thread only, returns false at the end of the source.
+  using TReadFn = function<bool(TTask & task)>;
+  // Called on several threads, returns false when the task is malformed.
+  using TDecodeFn = function<bool(TTask & task, vector<OsmElement> & elements)>;
+
+  OsmElementsPipeline(TReadFn const & read, TDecodeFn const & decode, size_t workersCount)
+    : m_read(read), m_decode(decode), m_workersCount(workersCount)
+    , m_maxSlotsCount(2 * workersCount + 2)
+  {
+  }
+
+  ~OsmElementsPipeline() { Stop(); }
+
+  template <typename ToDo>
+  void ForEachElement(ToDo && toDo)
+  {
+    vector<OsmElement> batch;
+    if (m_workersCount == 0)
+    {
+      TTask task;
+      while (m_read(task))
+      {
+        batch.clear();
+        if (!m_decode(task, batch))
+          LOG(LCRITICAL, ("Can't decode osm data."));
+        for (auto & e : batch)
+          toDo(&e);
+      }
+      return;
+    }
+
+    m_threads.emplace_back(&OsmElementsPipeline::ReaderRoutine, this);
+    for (size_t i = 0; i < m_workersCount; ++i)
+      m_threads.emplace_back(&OsmElementsPipeline::WorkerRoutine, this);
+
+    while (TakeBatch(batch))
+    {
+      for (auto & e : batch)
+        toDo(&e);
+    }
+    Stop();
+  }
+
+private:
+  struct Slot
+  {
+    TTask m_task;
+    vector<OsmElement> m_elements;
+    bool m_isReady = false;
+    bool m_isDecoded = false;
+  };
+
+  void ReaderRoutine()
+  {
+    while (true)
+    {
+      {
+        unique_lock<mutex> lock(m_mutex);
+        m_condition.wait(lock, [this] { return m_isStopped || m_slots.size() < m_maxSlotsCount; });
+        if (m_isStopped)
+          return;
+      }
+
+      TTask task;
+      bool const hasTask = m_read(task);
+
+      lock_guard<mutex> lock(m_mutex);
+      if (hasTask)
+      {
+        m_slots.emplace_back();
+        m_slots.back().m_task = move(task);
+      }
+      else
+      {
+        m_isReadFinished = true;
+      }
+      m_condition.notify_all();
+      if (!hasTask)
+        return;
+    }
+  }
+
+  void WorkerRoutine()
+  {
+    while (true)
+    {
+      Slot * slot = nullptr;
+      {
+        unique_lock<mutex> lock(m_mutex);
+        m_condition.wait(lock, [this]
+        {
+          return m_isStopped || m_isReadFinished || m_nextSlot < m_firstSlot + m_slots.size();
+        });
+        if (m_isStopped || m_nextSlot == m_firstSlot + m_slots.size())
+          return;
+        // Slots are removed from the front only when they are decoded,
+        // and adding of slots to the back keeps references valid.
+        slot = &m_slots[m_nextSlot - m_firstSlot];
+        ++m_nextSlot;
+      }
+
+      bool const isDecoded = m_decode(slot->m_task, slot->m_elements);
+      slot->m_task = TTask();
+
+      lock_guard<mutex> lock(m_mutex);
+      slot->m_isDecoded = isDecoded;
+      slot->m_isReady = true;
+      m_condition.notify_all();
+    }
+  }
+
+  bool TakeBatch(vector<OsmElement> & batch)
+  {
+    unique_lock<mutex> lock(m_mutex);
+    m_condition.wait(lock, [this]
+    {
+      return (!m_slots.empty() && m_slots.front().m_isReady) ||
+             (m_slots.empty() && m_isReadFinished);
+    });
+    if (m_slots.empty())
+      return false;
+
+    if (!m_slots.front().m_isDecoded)
+    {
+      lock.unlock();
+      LOG(LCRITICAL, ("Can't decode osm data."));
+      return false;
+    }
+
+    batch.swap(m_slots.front().m_elements);
+    m_slots.pop_front();
+    ++m_firstSlot;
+    m_condition.notify_all();
+    return true;
+  }
+
+  void Stop()
+  {
+    {
+      lock_guard<mutex> lock(m_mutex);
+      m_isStopped = true;
+    }
+    m_condition.notify_all();
+
+    for (auto & thread : m_threads)
+      thread.join();
+    m_threads.clear();
+  }
+
+  TReadFn m_read;
+  TDecodeFn m_decode;
+  size_t const m_workersCount;
+  size_t const m_maxSlotsCount;
+
+  mutex m_mutex;
+  condition_variable m_condition;
+  deque<Slot> m_slots;
+  // Source indices of the front slot and of the next slot to decode.
+  uint64_t m_firstSlot = 0;
+  uint64_t m_nextSlot = 0;
+  bool m_isReadFinished = false;
+  bool m_isStopped = false;
+  vector<thread> m_threads;
+};
+
+void TranslateO5MEntity(osm::O5MSource::Entity const & em, OsmElement & p)
+{
+  using TType = osm::O5MSource::EntityType;
+
+  auto translate = [](TType t) -> OsmElement::EntityType
+  {
+    switch (t)
+    {
+      case TType::Node: return OsmElement::EntityType::Node;
+      case TType::Way: return OsmElement::EntityType::Way;
+      case TType::Relation: return OsmElement::EntityType::Relation;
+      default: return OsmElement::EntityType::Unknown;
+    }
+  };
+
+  p.id = em.id;
+
+  switch (em.type)
+  {
+    case TType::Node:
+    {
+      p.type = OsmElement::EntityType::Node;
+      p.lat = em.lat;
+      p.lon = em.lon;
+      break;
+    }
+    case TType::Way:
+    {
+      p.type = OsmElement::EntityType::Way;
+      for (uint64_t nd : em.Nodes())
+        p.AddNd(nd);
+      break;
+    }
+    case TType::Relation:
+    {
+      p.type = OsmElement::EntityType::Relation;
+      for (auto const & member : em.Members())
+        p.AddMember(member.ref, translate(member.type), member.role);
+      break;
+    }
+    default: break;
+  }
+
+  for (auto const & tag : em.Tags())
+    p.AddTag(tag.key, tag.value);
+}
+
+// O5M data is delta coded and uses a table of recent strings, so it can't
+// be decoded in parallel. Instead elements are decoded on a separate
+// thread while the calling thread processes previous ones.
+template <typename ToDo>
+void ForEachO5MElementPipelined(SourceReader & stream, ToDo && toDo)
+{
+  using TBatch = vector<OsmElement>;
+
+  osm::O5MSource dataset([&stream](uint8_t * buffer, size_t size)
+  {
+    return stream.Read(reinterpret_cast<char *>(buffer), size);
+  });
+  auto it = dataset.begin();
+  auto const end = dataset.end();
+
+  OsmElementsPipeline<TBatch> pipeline([&](TBatch & batch)
+  {
+    batch.reserve(kO5MBatchSize);
+    for (; it != end && batch.size() < kO5MBatchSize; ++it)
+    {
+      batch.emplace_back();
+      TranslateO5MEntity(*it, batch.back());
+    }
+    return !batch.empty();
+  },
+  [](TBatch & batch, vector<OsmElement> & elements)
+  {
+    elements.swap(batch);
+    return true;
+  }, 1 /* workersCount */);
+  pipeline.ForEachElement(toDo);
+}
+
+template <typename ToDo>
+void ForEachPBFElement(SourceReader & stream, uint32_t threadsCount, ToDo && toDo)
+{
+  using TBlob = osm::PBFSource::Blob;
+
+  osm::PBFSource source([&stream](uint8_t * buffer, size_t size)
+  {
+    return stream.Read(reinterpret_cast<char *>(buffer), size);
+  });
+
+  // One thread reads blobs, others decode them.
+  size_t const workersCount = threadsCount > 1 ? threadsCount - 1 : 0;
+  OsmElementsPipeline<TBlob> pipeline([&source](TBlob & blob) { return source.ReadBlob(blob); },
+                                      [](TBlob & blob, vector<OsmElement> & elements)
+                                      {
+                                        return osm::PBFSource::DecodeBlob(blob, elements);
+                                      }, workersCount);
+  pipeline.ForEachElement(toDo);
+}
+}  // namespace
+
 template <typename TCache>
 void BuildIntermediateDataFromXML(SourceReader & stream, TCache & cache, TownsDumper & towns)
 {
@@ -610,8 +893,19 @@ void ProcessOsmElementsFromXML(SourceReader & stream, function<void(OsmElement *
 }
 
 template <typename TCache>
-void BuildIntermediateDataFromO5M(SourceReader & stream, TCache & cache, TownsDumper & towns)
+void BuildIntermediateDataFromO5M(SourceReader & stream, TCache & cache, TownsDumper & towns,
+                                  uint32_t threadsCount)
 {
+  if (threadsCount > 1)
+  {
+    ForEachO5MElementPipelined(stream, [&](OsmElement * e)
+    {
+      towns.CheckElement(*e);
+      AddElementToCache(cache, *e);
+    });
+    return;
+  }
+
   osm::O5MSource dataset([&stream](uint8_t * buffer, size_t size)
   {
     return stream.Read(reinterpret_cast<char *>(buffer), size);
@@ -624,64 +918,45 @@ void BuildIntermediateDataFromO5M(SourceReader & stream, TCache & cache, TownsDu
   }
 }
 
-void ProcessOsmElementsFromO5M(SourceReader & stream, function<void(OsmElement *)> processor)
+void ProcessOsmElementsFromO5M(SourceReader & stream, function<void(OsmElement *)> processor,
+                               uint32_t threadsCount)
 {
-  using TType = osm::O5MSource::EntityType;
+  if (threadsCount > 1)
+  {
+    ForEachO5MElementPipelined(stream, processor);
+    return;
+  }
 
   osm::O5MSource dataset([&stream](uint8_t * buffer, size_t size)
   {
     return stream.Read(reinterpret_cast<char *>(buffer), size);
   });
 
-  auto translate = [](TType t) -> OsmElement::EntityType
-  {
-    switch (t)
-    {
-      case TType::Node: return OsmElement::EntityType::Node;
-      case TType::Way: return OsmElement::EntityType::Way;
-      case TType::Relation: return OsmElement::EntityType::Relation;
-      default: return OsmElement::EntityType::Unknown;
-    }
-  };
-
   for (auto const & em : dataset)
   {
     OsmElement p;
-    p.id = em.id;
-
-    switch (em.type)
-    {
-      case TType::Node:
-      {
-        p.type = OsmElement::EntityType::Node;
-        p.lat = em.lat;
-        p.lon = em.lon;
-        break;
-      }
-      case TType::Way:
-      {
-        p.type = OsmElement::EntityType::Way;
-        for (uint64_t nd : em.Nodes())
-          p.AddNd(nd);
-        break;
-      }
-      case TType::Relation:
-      {
-        p.type = OsmElement::EntityType::Relation;
-        for (auto const & member : em.Members())
-          p.AddMember(member.ref, translate(member.type), member.role);
-        break;
-      }
-      default: break;
-    }
-
-    for (auto const & tag : em.Tags())
-      p.AddTag(tag.key, tag.value);
-
+    TranslateO5MEntity(em, p);
     processor(&p);
   }
 }
 
+template <typename TCache>
+void BuildIntermediateDataFromPBF(SourceReader & stream, TCache & cache, TownsDumper & towns,
+                                  uint32_t threadsCount)
+{
+  ForEachPBFElement(stream, threadsCount, [&](OsmElement * e)
+  {
+    towns.CheckElement(*e);
+    AddElementToCache(cache, *e);
+  });
+}
+
+void ProcessOsmElementsFromPBF(SourceReader & stream, function<void(OsmElement *)> processor,
+                               uint32_t threadsCount)
+{
+  ForEachPBFElement(stream, threadsCount, processor);
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 // Generate functions implementations.
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -726,7 +1001,10 @@ bool GenerateFeaturesImpl(feature::GenerateInfo & info, EmitterBase & emitter)
         ProcessOsmElementsFromXML(reader, fn);
         break;
       case feature::GenerateInfo::OsmSourceType::O5M:
-        ProcessOsmElementsFromO5M(reader, fn);
+        ProcessOsmElementsFromO5M(reader, fn, info.m_threadsCount);
+        break;
+      case feature::GenerateInfo::OsmSourceType::PBF:
+        ProcessOsmElementsFromPBF(reader, fn, info.m_threadsCount);
         break;
     }
 
@@ -766,7 +1044,10 @@ bool GenerateIntermediateDataImpl(feature::GenerateInfo & info)
         BuildIntermediateDataFromXML(reader, cache, towns);
         break;
       case feature::GenerateInfo::OsmSourceType::O5M:
-        BuildIntermediateDataFromO5M(reader, cache, towns);
+        BuildIntermediateDataFromO5M(reader, cache, towns, info.m_threadsCount);
+        break;
+      case feature::GenerateInfo::OsmSourceType::PBF:
+        BuildIntermediateDataFromPBF(reader, cache, towns, info.m_threadsCount);
         break;
     }
 
@@ -792,6 +1073,8 @@ bool GenerateFeatures(feature::GenerateInfo & info, EmitterFactory factory)
       return GenerateFeaturesImpl<cache::MapFilePointStorage<cache::EMode::Read>>(info, *emitter);
     case feature::GenerateInfo::NodeStorageType::Memory:
       return GenerateFeaturesImpl<cache::RawMemPointStorage<cache::EMode::Read>>(info, *emitter);
+    case feature::GenerateInfo::NodeStorageType::Packed:
+      return GenerateFeaturesImpl<cache::PackedFilePointStorage<cache::EMode::Read>>(info, *emitter);
   }
   return false;
 }
@@ -806,6 +1089,8 @@ bool GenerateIntermediateData(feature::GenerateInfo & info)
       return GenerateIntermediateDataImpl<cache::MapFilePointStorage<cache::EMode::Write>>(info);
     case feature::GenerateInfo::NodeStorageType::Memory:
       return GenerateIntermediateDataImpl<cache::RawMemPointStorage<cache::EMode::Write>>(info);
+    case feature::GenerateInfo::NodeStorageType::Packed:
+      return GenerateIntermediateDataImpl<cache::PackedFilePointStorage<cache::EMode::Write>>(info);
   }
   return false;
 }
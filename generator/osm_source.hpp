@@ -59,5 +59,10 @@ bool GenerateFeatures(feature::GenerateInfo & info,
                       EmitterFactory factory = MakeMainFeatureEmitter);
 bool GenerateIntermediateData(feature::GenerateInfo & info);
 
-void ProcessOsmElementsFromO5M(SourceReader & stream, std::function<void(OsmElement *)> processor);
+// When |threadsCount| is greater than one, elements are decoded on other threads,
+// |processor| is called on the calling thread in the order of the source anyway.
+void ProcessOsmElementsFromO5M(SourceReader & stream, std::function<void(OsmElement *)> processor,
+                               uint32_t threadsCount = 1);
+void ProcessOsmElementsFromPBF(SourceReader & stream, std::function<void(OsmElement *)> processor,
+                               uint32_t threadsCount = 1);
 void ProcessOsmElementsFromXML(SourceReader & stream, std::function<void(OsmElement *)> processor);
@@ -16,48 +16,62 @@
 #include "base/buffer_vector.hpp"
 #include "base/macros.hpp"
 
+#include <condition_variable>
+#include <deque>
+#include <mutex>
 #include <string>
-
-#ifndef PARALLEL_POLYGONIZER
-#define PARALLEL_POLYGONIZER 1
-#endif
-
-#if PARALLEL_POLYGONIZER
-#include <QtCore/QSemaphore>
-#include <QtCore/QThreadPool>
-#include <QtCore/QMutex>
-#include <QtCore/QMutexLocker>
-#endif
+#include <thread>
+#include <utility>
+#include <vector>
 
 namespace feature
 {
-  // Groups features according to country polygons
+  // Groups features according to country polygons.
+  //
+  // When there are several threads, features are collected to batches
+  // which are split by workers. A worker keeps features of a batch which
+  // belong to countries in its own buffer and emits the buffer to buckets
+  // under one lock, so workers don't wait for each other on every feature.
+  // Features of a batch go to a bucket in their original order.
   template <class FeatureOutT>
   class Polygonizer
   {
+    using TCountries = buffer_vector<borders::CountryPolygons const *, 32>;
+    using TBatch = std::vector<FeatureBuilder1>;
+    // Countries of features of a batch, features are referenced by
+    // indices in the batch.
+    using TEmitted = std::vector<std::pair<borders::CountryPolygons const *, size_t>>;
+
+    static size_t constexpr kBatchSize = 1024;
+
     feature::GenerateInfo const & m_info;
 
     vector<FeatureOutT*> m_Buckets;
     vector<std::string> m_Names;
     borders::CountriesContainerT m_countries;
 
-#if PARALLEL_POLYGONIZER
-    QThreadPool m_ThreadPool;
-    QSemaphore m_ThreadPoolSemaphore;
-    QMutex m_EmitFeatureMutex;
-#endif
+    std::vector<std::thread> m_workers;
+    size_t m_maxBatchesCount = 0;
+
+    std::mutex m_queueMutex;
+    // Notifies workers about new batches and the stop.
+    std::condition_variable m_batchesCondition;
+    // Notifies the producer about taken and processed batches.
+    std::condition_variable m_doneCondition;
+    std::deque<TBatch> m_batches;
+    size_t m_batchesInProgress = 0;
+    bool m_stopping = false;
+
+    // Guards buckets and names.
+    std::mutex m_emitMutex;
+
+    TBatch m_batch;
+    TEmitted m_emitted;
 
   public:
     Polygonizer(feature::GenerateInfo const & info)
       : m_info(info)
-#if PARALLEL_POLYGONIZER
-      , m_ThreadPoolSemaphore(m_ThreadPool.maxThreadCount() * 8)
-#endif
     {
-#if PARALLEL_POLYGONIZER
-      LOG(LINFO, ("Polygonizer thread pool threads:", m_ThreadPool.maxThreadCount()));
-#endif
-
       if (info.m_splitByPolygons)
       {
         CHECK(borders::LoadCountriesList(info.m_targetDir, m_countries),
@@ -69,10 +83,28 @@ namespace feature
         // create only one output file which contains all features
         m_countries.Add(borders::CountryPolygons(info.m_fileName), MercatorBounds::FullRect());
       }
+
+      size_t const threadsCount = info.m_polygonizerThreadsCount;
+      LOG(LINFO, ("Polygonizer threads:", threadsCount));
+      if (threadsCount > 1)
+      {
+        m_maxBatchesCount = 2 * threadsCount;
+        m_batch.reserve(kBatchSize);
+        for (size_t i = 0; i < threadsCount; ++i)
+          m_workers.emplace_back(&Polygonizer::WorkerRoutine, this);
+      }
     }
     ~Polygonizer()
     {
       Finish();
+      {
+        std::lock_guard<std::mutex> lock(m_queueMutex);
+        m_stopping = true;
+      }
+      m_batchesCondition.notify_all();
+      for (auto & worker : m_workers)
+        worker.join();
+
       for_each(m_Buckets.begin(), m_Buckets.end(), DeleteFunctor());
     }
 
@@ -100,11 +132,10 @@ namespace feature
 
     class InsertCountriesPtr
     {
-      typedef buffer_vector<borders::CountryPolygons const *, 32> vec_type;
-      vec_type & m_vec;
+      TCountries & m_vec;
 
     public:
-      InsertCountriesPtr(vec_type & vec) : m_vec(vec) {}
+      InsertCountriesPtr(TCountries & vec) : m_vec(vec) {}
       void operator() (borders::CountryPolygons const & c)
       {
         m_vec.push_back(&c);
@@ -113,47 +144,45 @@ namespace feature
 
     void operator()(FeatureBuilder1 & fb)
     {
-      buffer_vector<borders::CountryPolygons const *, 32> vec;
-      m_countries.ForEachInRect(fb.GetLimitRect(), InsertCountriesPtr(vec));
-
-      switch (vec.size())
+      if (m_workers.empty())
       {
-      case 0:
-        break;
-      case 1: EmitFeature(vec[0], fb); break;
-      default:
-        {
-#if PARALLEL_POLYGONIZER
-          m_ThreadPoolSemaphore.acquire();
-          m_ThreadPool.start(new PolygonizerTask(this, vec, fb));
-#else
-        PolygonizerTask task(this, vec, fb);
-        task.RunBase();
-#endif
-        }
+        m_emitted.clear();
+        FindCountries(fb, 0 /* index */, m_emitted);
+        for (auto const & e : m_emitted)
+          EmitFeature(e.first, fb);
+        return;
       }
+
+      m_batch.push_back(fb);
+      if (m_batch.size() >= kBatchSize)
+        PushBatch();
     }
 
+    // Names of countries of features which are passed between Start() and Finish().
     std::string m_currentNames;
 
     void Start()
     {
+      Finish();
       m_currentNames.clear();
     }
 
+    // Waits until all features passed before are emitted.
     void Finish()
     {
-#if PARALLEL_POLYGONIZER
-      m_ThreadPool.waitForDone();
-#endif
+      if (m_workers.empty())
+        return;
+
+      if (!m_batch.empty())
+        PushBatch();
+
+      std::unique_lock<std::mutex> lock(m_queueMutex);
+      m_doneCondition.wait(lock, [this]() { return m_batches.empty() && m_batchesInProgress == 0; });
     }
 
+    // Isn't synchronized, workers call it under |m_emitMutex|.
     void EmitFeature(borders::CountryPolygons const * country, FeatureBuilder1 const & fb)
     {
-#if PARALLEL_POLYGONIZER
-      QMutexLocker mutexLocker(&m_EmitFeatureMutex);
-      UNUSED_VALUE(mutexLocker);
-#endif
       if (country->m_index == -1)
       {
         m_Names.push_back(country->m_name);
@@ -175,46 +204,81 @@ namespace feature
     }
 
   private:
-    friend class PolygonizerTask;
-
-    class PolygonizerTask
-#if PARALLEL_POLYGONIZER
-      : public QRunnable
-#endif
+    // Appends countries which contain points of |fb| to |emitted|.
+    void FindCountries(FeatureBuilder1 const & fb, size_t index, TEmitted & emitted) const
     {
-    public:
-      PolygonizerTask(Polygonizer * pPolygonizer,
-                      buffer_vector<borders::CountryPolygons const *, 32> const & countries,
-                      FeatureBuilder1 const & fb)
-        : m_pPolygonizer(pPolygonizer), m_Countries(countries), m_fb(fb)
+      TCountries countries;
+      m_countries.ForEachInRect(fb.GetLimitRect(), InsertCountriesPtr(countries));
+
+      if (countries.size() == 1)
       {
+        emitted.emplace_back(countries[0], index);
+        return;
       }
 
-      void RunBase()
+      for (auto const * country : countries)
       {
-        for (size_t i = 0; i < m_Countries.size(); ++i)
-        {
-          PointChecker doCheck(m_Countries[i]->m_regions);
-          m_fb.ForEachGeometryPoint(doCheck);
+        PointChecker doCheck(country->m_regions);
+        fb.ForEachGeometryPoint(doCheck);
 
-          if (doCheck.m_belongs)
-            m_pPolygonizer->EmitFeature(m_Countries[i], m_fb);
-        }
+        if (doCheck.m_belongs)
+          emitted.emplace_back(country, index);
       }
+    }
 
-#if PARALLEL_POLYGONIZER
-      void run()
+    void PushBatch()
+    {
       {
-        RunBase();
+        std::unique_lock<std::mutex> lock(m_queueMutex);
+        m_doneCondition.wait(lock, [this]() { return m_batches.size() < m_maxBatchesCount; });
+        m_batches.push_back(std::move(m_batch));
+      }
+      m_batchesCondition.notify_one();
 
-        m_pPolygonizer->m_ThreadPoolSemaphore.release();
+      m_batch = TBatch();
+      m_batch.reserve(kBatchSize);
+    }
+
+    void WorkerRoutine()
+    {
+      TEmitted emitted;
+      while (true)
+      {
+        TBatch batch;
+        {
+          std::unique_lock<std::mutex> lock(m_queueMutex);
+          m_batchesCondition.wait(lock, [this]() { return m_stopping || !m_batches.empty(); });
+          if (m_batches.empty())
+            return;
+
+          batch = std::move(m_batches.front());
+          m_batches.pop_front();
+          ++m_batchesInProgress;
+        }
+        m_doneCondition.notify_all();
+
+        emitted.clear();
+        for (size_t i = 0; i < batch.size(); ++i)
+          FindCountries(batch[i], i, emitted);
+
+        {
+          std::lock_guard<std::mutex> lock(m_emitMutex);
+          for (auto const & e : emitted)
+            EmitFeature(e.first, batch[e.second]);
+        }
+
+        {
+          std::lock_guard<std::mutex> lock(m_queueMutex);
+          --m_batchesInProgress;
+        }
+        m_doneCondition.notify_all();
       }
-#endif
+    }
 
-    private:
-      Polygonizer * m_pPolygonizer;
-      buffer_vector<borders::CountryPolygons const *, 32> m_Countries;
-      FeatureBuilder1 m_fb;
-    };
+    DISALLOW_COPY_AND_MOVE(Polygonizer);
   };
+
+  // static
+  template <class FeatureOutT>
+  size_t constexpr Polygonizer<FeatureOutT>::kBatchSize;
 }
@@ -11,6 +11,12 @@
 #include "routing/index_graph.hpp"
 #include "routing/index_graph_loader.hpp"
 #include "routing/index_graph_serialization.hpp"
+#include "routing/landmark_index.hpp"
+#include "routing/landmark_serialization.hpp"
+#include "routing/road_grid.hpp"
+#include "routing/road_speeds_serialization.hpp"
+#include "routing/shortcut_index.hpp"
+#include "routing/shortcut_serialization.hpp"
 #include "routing/vehicle_mask.hpp"
 
 #include "routing_common/bicycle_model.hpp"
@@ -28,12 +34,16 @@
 
 #include "base/checked_cast.hpp"
 #include "base/logging.hpp"
+#include "base/stl_add.hpp"
 
 #include <algorithm>
+#include <atomic>
 #include <cstdint>
+#include <exception>
 #include <functional>
 #include <map>
 #include <memory>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 
@@ -72,6 +82,26 @@ public:
         f, [&](VehicleModelInterface const & model, FeatureType const & f) { return model.IsOneWay(f); });
   }
 
+  // Adds |f| to the tables of the vehicle types of |roadMask|.
+  void AddRoadSpeeds(FeatureType const & f, uint32_t featureId, VehicleMask roadMask,
+                     RoadSpeedsSerializer::RoadSpeedsByVehicleType & roadSpeeds) const
+  {
+    auto const addRoad = [&](VehicleModelInterface const & model, VehicleType vehicleType) {
+      if ((roadMask & GetVehicleMask(vehicleType)) == 0)
+        return;
+
+      RoadSpeeds::Road road;
+      road.m_speedKMpH = model.GetSpeed(f);
+      road.m_isOneWay = model.IsOneWay(f);
+      road.m_isTransitAllowed = model.IsTransitAllowed(f);
+      roadSpeeds[static_cast<size_t>(vehicleType)].Add(featureId, road);
+    };
+
+    addRoad(*m_pedestrianModel, VehicleType::Pedestrian);
+    addRoad(*m_bicycleModel, VehicleType::Bicycle);
+    addRoad(*m_carModel, VehicleType::Car);
+  }
+
 private:
   template <class Fn>
   VehicleMask CalcMask(FeatureType const & f, Fn && fn) const
@@ -119,6 +149,11 @@ public:
   }
 
   unordered_map<uint32_t, VehicleMask> const & GetMasks() const { return m_masks; }
+  RoadSpeedsSerializer::RoadSpeedsByVehicleType const & GetRoadSpeeds() const
+  {
+    return m_roadSpeeds;
+  }
+  RoadGridBuilder & GetRoadGridBuilder() { return m_roadGridBuilder; }
 
 private:
   void ProcessFeature(FeatureType const & f, uint32_t id)
@@ -128,18 +163,23 @@ private:
       return;
 
     m_masks[id] = mask;
+    m_maskBuilder.AddRoadSpeeds(f, id, mask, m_roadSpeeds);
     f.ParseGeometry(FeatureType::BEST_GEOMETRY);
 
     for (size_t i = 0; i < f.GetPointsCount(); ++i)
     {
       uint64_t const locationKey = PointToInt64(f.GetPoint(i), POINT_COORD_BITS);
       m_posToJoint[locationKey].AddPoint(RoadPoint(id, base::checked_cast<uint32_t>(i)));
+      if (i > 0)
+        m_roadGridBuilder.AddSegment(id, f.GetPoint(i - 1), f.GetPoint(i));
     }
   }
 
   VehicleMaskBuilder const m_maskBuilder;
   unordered_map<uint64_t, Joint> m_posToJoint;
   unordered_map<uint32_t, VehicleMask> m_masks;
+  RoadSpeedsSerializer::RoadSpeedsByVehicleType m_roadSpeeds;
+  RoadGridBuilder m_roadGridBuilder;
 };
 
 class DijkstraWrapper final
@@ -274,53 +314,114 @@ void CalcCrossMwmTransitions(string const & path, string const & mwmFile, string
   }
 }
 
+// Graph of the car routing section of the mwm. Geometry of the graph is loaded lazily,
+// so every thread needs its own graph.
+unique_ptr<IndexGraph> LoadCarIndexGraph(string const & path, string const & mwmFile,
+                                         string const & country,
+                                         shared_ptr<VehicleModelInterface> const & vehicleModel)
+{
+  auto graph = my::make_unique<IndexGraph>(
+      GeometryLoader::CreateFromFile(mwmFile, vehicleModel),
+      EdgeEstimator::Create(VehicleType::Car, vehicleModel->GetMaxSpeed(),
+                            nullptr /* trafficStash */));
+
+  MwmValue mwmValue(LocalCountryFile(path, platform::CountryFile(country), 0 /* version */));
+  DeserializeIndexGraph(mwmValue, kCarMask, *graph);
+  return graph;
+}
+
+// Waves from enters don't depend on each other, so they are propagated on |threadsCount|
+// threads. Enters are taken by threads one by one, since waves differ a lot in size.
 void FillWeights(string const & path, string const & mwmFile, string const & country,
                  CountryParentNameGetterFn const & countryParentNameGetterFn,
-                 bool disableCrossMwmProgress, CrossMwmConnector & connector)
+                 bool disableCrossMwmProgress, size_t threadsCount, CrossMwmConnector & connector)
 {
   my::Timer timer;
 
   shared_ptr<VehicleModelInterface> vehicleModel =
       CarModelFactory(countryParentNameGetterFn).GetVehicleModelForCountry(country);
-  IndexGraph graph(GeometryLoader::CreateFromFile(mwmFile, vehicleModel),
-                   EdgeEstimator::Create(VehicleType::Car, vehicleModel->GetMaxSpeed(),
-                                         nullptr /* trafficStash */));
-
-  MwmValue mwmValue(LocalCountryFile(path, platform::CountryFile(country), 0 /* version */));
-  DeserializeIndexGraph(mwmValue, kCarMask, graph);
 
-  map<Segment, map<Segment, RouteWeight>> weights;
   auto const numEnters = connector.GetEnters().size();
-  size_t foundCount = 0;
-  size_t notFoundCount = 0;
-  for (size_t i = 0; i < numEnters; ++i)
-  {
-    if (!disableCrossMwmProgress && (i % 10 == 0) && (i != 0))
-      LOG(LINFO, ("Building leaps:", i, "/", numEnters, "waves passed"));
+  threadsCount = max(min(threadsCount, numEnters), static_cast<size_t>(1));
 
-    Segment const & enter = connector.GetEnter(i);
+  // Weights from every enter to exits.
+  vector<map<Segment, RouteWeight>> enterWeights(numEnters);
+  atomic<size_t> nextEnter(0);
+  atomic<size_t> wavesPassed(0);
+  atomic<size_t> foundCount(0);
+  atomic<size_t> notFoundCount(0);
 
-    AStarAlgorithm<DijkstraWrapper> astar;
-    DijkstraWrapper wrapper(graph);
-    AStarAlgorithm<DijkstraWrapper>::Context context;
-    astar.PropagateWave(wrapper, enter,
-                        [](Segment const & /* vertex */) { return true; } /* visitVertex */,
-                        context);
-
-    for (Segment const & exit : connector.GetExits())
+  auto const propagateWaves = [&](IndexGraph & graph)
+  {
+    for (size_t i = nextEnter++; i < numEnters; i = nextEnter++)
     {
-      if (context.HasDistance(exit))
+      Segment const & enter = connector.GetEnter(i);
+
+      AStarAlgorithm<DijkstraWrapper> astar;
+      DijkstraWrapper wrapper(graph);
+      AStarAlgorithm<DijkstraWrapper>::Context context;
+      astar.PropagateWave(wrapper, enter,
+                          [](Segment const & /* vertex */) { return true; } /* visitVertex */,
+                          context);
+
+      for (Segment const & exit : connector.GetExits())
       {
-        weights[enter][exit] = context.GetDistance(exit);
-        ++foundCount;
+        if (context.HasDistance(exit))
+        {
+          enterWeights[i][exit] = context.GetDistance(exit);
+          ++foundCount;
+        }
+        else
+        {
+          ++notFoundCount;
+        }
       }
-      else
+
+      size_t const passed = ++wavesPassed;
+      if (!disableCrossMwmProgress && passed % 10 == 0)
+        LOG(LINFO, ("Building leaps:", passed, "/", numEnters, "waves passed"));
+    }
+  };
+
+  if (threadsCount == 1)
+  {
+    propagateWaves(*LoadCarIndexGraph(path, mwmFile, country, vehicleModel));
+  }
+  else
+  {
+    vector<exception_ptr> errors(threadsCount);
+    vector<thread> threads;
+    for (size_t i = 0; i < threadsCount; ++i)
+    {
+      threads.emplace_back([&, i]()
       {
-        ++notFoundCount;
-      }
+        try
+        {
+          propagateWaves(*LoadCarIndexGraph(path, mwmFile, country, vehicleModel));
+        }
+        catch (...)
+        {
+          errors[i] = current_exception();
+          // Other threads are stopped at the next enter.
+          nextEnter = numEnters;
+        }
+      });
+    }
+
+    for (auto & t : threads)
+      t.join();
+
+    for (auto const & error : errors)
+    {
+      if (error)
+        rethrow_exception(error);
     }
   }
 
+  map<Segment, map<Segment, RouteWeight>> weights;
+  for (size_t i = 0; i < numEnters; ++i)
+    weights[connector.GetEnter(i)].swap(enterWeights[i]);
+
   connector.FillWeights([&](Segment const & enter, Segment const & exit) {
     auto it0 = weights.find(enter);
     if (it0 == weights.end())
@@ -334,7 +435,7 @@ void FillWeights(string const & path, string const & mwmFile, string const & cou
   });
 
   LOG(LINFO, ("Leaps finished, elapsed:", timer.ElapsedSeconds(), "seconds, routes found:",
-              foundCount, ", not found:", notFoundCount));
+              foundCount.load(), ", not found:", notFoundCount.load(), ", threads:", threadsCount));
 }
 
 serial::CodingParams LoadCodingParams(string const & mwmFile)
@@ -359,14 +460,37 @@ bool BuildRoutingIndex(string const & filename, string const & country,
     processor.BuildGraph(graph);
 
     FilesContainerW cont(filename, FileWriter::OP_WRITE_EXISTING);
-    FileWriter writer = cont.GetWriter(ROUTING_FILE_TAG);
+    {
+      FileWriter writer = cont.GetWriter(ROUTING_FILE_TAG);
 
-    auto const startPos = writer.Pos();
-    IndexGraphSerializer::Serialize(graph, processor.GetMasks(), writer);
-    auto const sectionSize = writer.Pos() - startPos;
+      auto const startPos = writer.Pos();
+      IndexGraphSerializer::Serialize(graph, processor.GetMasks(), writer);
+      auto const sectionSize = writer.Pos() - startPos;
+
+      LOG(LINFO, ("Routing section created:", sectionSize, "bytes,", graph.GetNumRoads(), "roads,",
+                  graph.GetNumJoints(), "joints,", graph.GetNumPoints(), "points"));
+    }
+
+    // Speeds are written next to the graph, so that they're always built with the same models.
+    {
+      FileWriter writer = cont.GetWriter(ROAD_SPEEDS_FILE_TAG);
+
+      auto const startPos = writer.Pos();
+      RoadSpeedsSerializer::Serialize(writer, processor.GetRoadSpeeds());
+      auto const sectionSize = writer.Pos() - startPos;
+
+      LOG(LINFO, (ROAD_SPEEDS_FILE_TAG, "section created:", sectionSize, "bytes"));
+    }
+
+    {
+      FileWriter writer = cont.GetWriter(ROAD_GRID_FILE_TAG);
 
-    LOG(LINFO, ("Routing section created:", sectionSize, "bytes,", graph.GetNumRoads(), "roads,",
-                graph.GetNumJoints(), "joints,", graph.GetNumPoints(), "points"));
+      auto const startPos = writer.Pos();
+      processor.GetRoadGridBuilder().Serialize(writer);
+      auto const sectionSize = writer.Pos() - startPos;
+
+      LOG(LINFO, (ROAD_GRID_FILE_TAG, "section created:", sectionSize, "bytes"));
+    }
     return true;
   }
   catch (RootException const & e)
@@ -378,7 +502,8 @@ bool BuildRoutingIndex(string const & filename, string const & country,
 
 bool BuildCrossMwmSection(string const & path, string const & mwmFile, string const & country,
                           CountryParentNameGetterFn const & countryParentNameGetterFn,
-                          string const & osmToFeatureFile, bool disableCrossMwmProgress)
+                          string const & osmToFeatureFile, bool disableCrossMwmProgress,
+                          size_t threadsCount)
 {
   LOG(LINFO, ("Building cross mwm section for", country));
 
@@ -403,7 +528,7 @@ bool BuildCrossMwmSection(string const & path, string const & mwmFile, string co
   // We use leaps for cars only. To use leaps for other vehicle types add weights generation
   // here and change WorldGraph mode selection rule in IndexRouter::CalculateSubroute.
   FillWeights(path, mwmFile, country, countryParentNameGetterFn, disableCrossMwmProgress,
-              connectors[static_cast<size_t>(VehicleType::Car)]);
+              threadsCount, connectors[static_cast<size_t>(VehicleType::Car)]);
 
   serial::CodingParams const codingParams = LoadCodingParams(mwmFile);
   FilesContainerW cont(mwmFile, FileWriter::OP_WRITE_EXISTING);
@@ -415,4 +540,86 @@ bool BuildCrossMwmSection(string const & path, string const & mwmFile, string co
   LOG(LINFO, ("Cross mwm section generated, size:", sectionSize, "bytes"));
   return true;
 }
+
+bool BuildShortcutsSection(string const & path, string const & mwmFile, string const & country,
+                           CountryParentNameGetterFn const & countryParentNameGetterFn)
+{
+  LOG(LINFO, ("Building shortcuts section for", country));
+  my::Timer timer;
+
+  try
+  {
+    ShortcutIndex shortcuts;
+    {
+      shared_ptr<VehicleModelInterface> vehicleModel =
+          CarModelFactory(countryParentNameGetterFn).GetVehicleModelForCountry(country);
+      shared_ptr<EdgeEstimator> estimator = EdgeEstimator::Create(
+          VehicleType::Car, vehicleModel->GetMaxSpeed(), nullptr /* trafficStash */);
+      IndexGraph graph(GeometryLoader::CreateFromFile(mwmFile, vehicleModel), estimator);
+
+      MwmValue mwmValue(LocalCountryFile(path, platform::CountryFile(country), 0 /* version */));
+      DeserializeIndexGraph(mwmValue, kCarMask, graph);
+
+      BuildShortcutIndex(graph, *estimator, shortcuts);
+    }
+
+    FilesContainerW cont(mwmFile, FileWriter::OP_WRITE_EXISTING);
+    FileWriter writer = cont.GetWriter(SHORTCUTS_FILE_TAG);
+    auto const startPos = writer.Pos();
+    ShortcutSerializer::Serialize(shortcuts, writer);
+    auto const sectionSize = writer.Pos() - startPos;
+
+    LOG(LINFO, ("Shortcuts section generated in", timer.ElapsedSeconds(), "seconds, size:",
+                sectionSize, "bytes,", shortcuts.GetNumFeatures(), "features"));
+    return true;
+  }
+  catch (RootException const & e)
+  {
+    LOG(LERROR, ("An exception happened while creating", SHORTCUTS_FILE_TAG, "section:", e.what()));
+    return false;
+  }
+}
+
+bool BuildLandmarksSection(string const & path, string const & mwmFile, string const & country,
+                           CountryParentNameGetterFn const & countryParentNameGetterFn)
+{
+  // Every landmark takes 4 bytes per joint.
+  size_t constexpr kNumLandmarks = 8;
+
+  LOG(LINFO, ("Building landmarks section for", country));
+  my::Timer timer;
+
+  try
+  {
+    LandmarkIndex landmarks;
+    {
+      shared_ptr<VehicleModelInterface> vehicleModel =
+          CarModelFactory(countryParentNameGetterFn).GetVehicleModelForCountry(country);
+      shared_ptr<EdgeEstimator> estimator = EdgeEstimator::Create(
+          VehicleType::Car, vehicleModel->GetMaxSpeed(), nullptr /* trafficStash */);
+      IndexGraph graph(GeometryLoader::CreateFromFile(mwmFile, vehicleModel), estimator);
+
+      // Joint ids depend on the vehicle mask. The mask should be the same as the router's one.
+      MwmValue mwmValue(LocalCountryFile(path, platform::CountryFile(country), 0 /* version */));
+      DeserializeIndexGraph(mwmValue, kCarMask, graph);
+
+      BuildLandmarkIndex(graph, kNumLandmarks, landmarks);
+    }
+
+    FilesContainerW cont(mwmFile, FileWriter::OP_WRITE_EXISTING);
+    FileWriter writer = cont.GetWriter(LANDMARKS_FILE_TAG);
+    auto const startPos = writer.Pos();
+    LandmarkSerializer::Serialize(landmarks, writer);
+    auto const sectionSize = writer.Pos() - startPos;
+
+    LOG(LINFO, ("Landmarks section generated in", timer.ElapsedSeconds(), "seconds, size:",
+                sectionSize, "bytes,", landmarks.GetNumLandmarks(), "landmarks"));
+    return true;
+  }
+  catch (RootException const & e)
+  {
+    LOG(LERROR, ("An exception happened while creating", LANDMARKS_FILE_TAG, "section:", e.what()));
+    return false;
+  }
+}
 }  // namespace routing
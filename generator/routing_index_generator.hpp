@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <functional>
 #include <string>
@@ -8,10 +9,24 @@ namespace routing
 {
 using CountryParentNameGetterFn = std::function<std::string(std::string const &)>;
 
+// Builds the routing section, the section with speeds of the roads for every vehicle type and
+// the grid of the roads to find roads near a point.
 bool BuildRoutingIndex(std::string const & filename, std::string const & country,
                        CountryParentNameGetterFn const & countryParentNameGetterFn);
+// Leaps of car routing are calculated on |threadsCount| threads.
 bool BuildCrossMwmSection(std::string const & path, std::string const & mwmFile,
                           std::string const & country,
                           CountryParentNameGetterFn const & countryParentNameGetterFn,
-                          std::string const & osmToFeatureFile, bool disableCrossMwmProgress);
+                          std::string const & osmToFeatureFile, bool disableCrossMwmProgress,
+                          size_t threadsCount = 1);
+// Builds the section with precomputed weights of chains of car routing index graph.
+// The routing section should be built before.
+bool BuildShortcutsSection(std::string const & path, std::string const & mwmFile,
+                           std::string const & country,
+                           CountryParentNameGetterFn const & countryParentNameGetterFn);
+// Builds the section with distances between landmarks and joints of car routing index graph.
+// The routing section should be built before.
+bool BuildLandmarksSection(std::string const & path, std::string const & mwmFile,
+                           std::string const & country,
+                           CountryParentNameGetterFn const & countryParentNameGetterFn);
 }  // namespace routing
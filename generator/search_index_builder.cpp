@@ -4,6 +4,7 @@
 #include "search/reverse_geocoder.hpp"
 #include "search/search_index_values.hpp"
 #include "search/search_trie.hpp"
+#include "search/types_index.hpp"
 #include "search/types_skipper.hpp"
 
 #include "indexer/categories_holder.hpp"
@@ -36,9 +37,11 @@
 #include "base/timer.hpp"
 
 #include <algorithm>
+#include <exception>
 #include <fstream>
 #include <initializer_list>
 #include <limits>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 
@@ -309,7 +312,7 @@ public:
 
 template <typename TKey, typename TValue>
 void AddFeatureNameIndexPairs(FeaturesVectorTest const & features,
-                              CategoriesHolder & categoriesHolder,
+                              CategoriesHolder const & categoriesHolder,
                               vector<pair<TKey, TValue>> & keyValuePairs)
 {
   feature::DataHeader const & header = features.GetHeader();
@@ -324,6 +327,111 @@ void AddFeatureNameIndexPairs(FeaturesVectorTest const & features,
       synonyms.get(), keyValuePairs, categoriesHolder, header.GetScaleRange(), valueBuilder));
 }
 
+// Features are split into |threadsCount| ranges of indices, pairs of every range are
+// collected by its own features vector and sorted on its own thread. Then sorted ranges
+// are merged by pairs on several threads, so the result is the same as sorting of all pairs.
+template <typename TKey, typename TValue>
+void GetSortedFeatureNameIndexPairs(FilesContainerR const & container,
+                                    FeaturesVectorTest const & features,
+                                    CategoriesHolder const & categoriesHolder, size_t threadsCount,
+                                    vector<pair<TKey, TValue>> & keyValuePairs)
+{
+  // Count of features is unknown without the offsets table, so
+  // features can't be read by ranges.
+  size_t const featuresCount = features.GetVector().GetNumFeatures();
+  threadsCount = min(threadsCount, featuresCount);
+  if (threadsCount <= 1)
+  {
+    AddFeatureNameIndexPairs(features, categoriesHolder, keyValuePairs);
+    sort(keyValuePairs.begin(), keyValuePairs.end());
+    return;
+  }
+
+  feature::DataHeader const & header = features.GetHeader();
+
+  ValueBuilder<TValue> valueBuilder;
+
+  unique_ptr<SynonymsHolder> synonyms;
+  if (header.GetType() == feature::DataHeader::world)
+    synonyms.reset(new SynonymsHolder(GetPlatform().WritablePathForFile(SYNONYMS_FILE)));
+
+  vector<vector<pair<TKey, TValue>>> shards(threadsCount);
+  vector<exception_ptr> errors(threadsCount);
+  {
+    vector<thread> threads;
+    for (size_t i = 0; i < threadsCount; ++i)
+    {
+      uint32_t const begin = static_cast<uint32_t>(featuresCount * i / threadsCount);
+      uint32_t const end = static_cast<uint32_t>(featuresCount * (i + 1) / threadsCount);
+      threads.emplace_back([&, i, begin, end]()
+      {
+        try
+        {
+          // Readers of a container can't be shared between threads.
+          FeaturesVectorTest shardFeatures(container.GetFileName());
+          FeatureInserter<TKey, TValue> inserter(synonyms.get(), shards[i], categoriesHolder,
+                                                 header.GetScaleRange(), valueBuilder);
+          for (uint32_t index = begin; index < end; ++index)
+          {
+            FeatureType ft;
+            shardFeatures.GetVector().GetByIndex(index, ft);
+            ft.SetID(FeatureID(MwmSet::MwmId(), index));
+            inserter(ft, index);
+          }
+          sort(shards[i].begin(), shards[i].end());
+        }
+        catch (...)
+        {
+          errors[i] = current_exception();
+        }
+      });
+    }
+
+    for (auto & t : threads)
+      t.join();
+  }
+
+  for (auto const & e : errors)
+  {
+    if (e)
+      rethrow_exception(e);
+  }
+
+  size_t pairsCount = 0;
+  for (auto const & shard : shards)
+    pairsCount += shard.size();
+
+  keyValuePairs.reserve(keyValuePairs.size() + pairsCount);
+  vector<size_t> bounds = {keyValuePairs.size()};
+  for (auto & shard : shards)
+  {
+    move(shard.begin(), shard.end(), back_inserter(keyValuePairs));
+    vector<pair<TKey, TValue>>().swap(shard);
+    bounds.push_back(keyValuePairs.size());
+  }
+
+  while (bounds.size() > 2)
+  {
+    vector<size_t> nextBounds = {bounds.front()};
+    vector<thread> threads;
+    for (size_t i = 0; i + 2 < bounds.size(); i += 2)
+    {
+      auto const first = keyValuePairs.begin() + bounds[i];
+      auto const middle = keyValuePairs.begin() + bounds[i + 1];
+      auto const last = keyValuePairs.begin() + bounds[i + 2];
+      threads.emplace_back([first, middle, last]() { inplace_merge(first, middle, last); });
+      nextBounds.push_back(bounds[i + 2]);
+    }
+    // The last range has no pair.
+    if ((bounds.size() - 1) % 2 == 1)
+      nextBounds.push_back(bounds.back());
+
+    for (auto & t : threads)
+      t.join();
+    bounds.swap(nextBounds);
+  }
+}
+
 void BuildAddressTable(FilesContainerR & container, Writer & writer)
 {
   ReaderSource<ModelReaderPtr> src = container.GetReader(SEARCH_TOKENS_FILE_TAG);
@@ -389,7 +497,7 @@ void BuildAddressTable(FilesContainerR & container, Writer & writer)
 
 namespace indexer
 {
-bool BuildSearchIndexFromDataFile(string const & filename, bool forceRebuild)
+bool BuildSearchIndexFromDataFile(string const & filename, bool forceRebuild, size_t threadsCount)
 {
   Platform & platform = GetPlatform();
 
@@ -409,12 +517,18 @@ bool BuildSearchIndexFromDataFile(string const & filename, bool forceRebuild)
         mwmName + "." SEARCH_ADDRESS_FILE_TAG EXTENSION_TMP);
   MY_SCOPE_GUARD(addrFileGuard, bind(&FileWriter::DeleteFileX, addrFilePath));
 
+  string const typesFilePath = platform.WritablePathForFile(
+        mwmName + "." TYPES_INDEX_FILE_TAG EXTENSION_TMP);
+  MY_SCOPE_GUARD(typesFileGuard, bind(&FileWriter::DeleteFileX, typesFilePath));
+
   try
   {
     {
       FileWriter writer(indexFilePath);
-      BuildSearchIndex(readContainer, writer);
+      FileWriter typesWriter(typesFilePath);
+      BuildSearchIndex(readContainer, writer, threadsCount, &typesWriter);
       LOG(LINFO, ("Search index size =", writer.Size()));
+      LOG(LINFO, ("Types index size =", typesWriter.Size()));
     }
     if (filename != WORLD_FILE_NAME && filename != WORLD_COASTS_FILE_NAME)
     {
@@ -448,6 +562,11 @@ bool BuildSearchIndexFromDataFile(string const & filename, bool forceRebuild)
         FilesContainerW writeContainer(readContainer.GetFileName(), FileWriter::OP_WRITE_EXISTING);
         writeContainer.Write(addrFilePath, SEARCH_ADDRESS_FILE_TAG);
       }
+
+      {
+        FilesContainerW writeContainer(readContainer.GetFileName(), FileWriter::OP_WRITE_EXISTING);
+        writeContainer.Write(typesFilePath, TYPES_INDEX_FILE_TAG);
+      }
     }
   }
   catch (Reader::Exception const & e)
@@ -464,7 +583,8 @@ bool BuildSearchIndexFromDataFile(string const & filename, bool forceRebuild)
   return true;
 }
 
-void BuildSearchIndex(FilesContainerR & container, Writer & indexWriter)
+void BuildSearchIndex(FilesContainerR & container, Writer & indexWriter, size_t threadsCount,
+                      Writer * typesIndexWriter)
 {
   using TKey = strings::UniString;
   using TValue = FeatureIndexValue;
@@ -481,11 +601,25 @@ void BuildSearchIndex(FilesContainerR & container, Writer & indexWriter)
   SingleValueSerializer<TValue> serializer(codingParams);
 
   vector<pair<TKey, TValue>> searchIndexKeyValuePairs;
-  AddFeatureNameIndexPairs(features, categoriesHolder, searchIndexKeyValuePairs);
-
-  sort(searchIndexKeyValuePairs.begin(), searchIndexKeyValuePairs.end());
+  GetSortedFeatureNameIndexPairs(container, features, categoriesHolder, threadsCount,
+                                 searchIndexKeyValuePairs);
   LOG(LINFO, ("End sorting strings:", timer.ElapsedSeconds()));
 
+  if (typesIndexWriter)
+  {
+    search::TypesIndexBuilder builder;
+    uint32_t type;
+    for (auto const & kv : searchIndexKeyValuePairs)
+    {
+      auto const & key = kv.first;
+      if (key.empty() || key[0] != search::kCategoriesLang)
+        continue;
+      if (search::FeatureTypeFromString(strings::UniString(key.begin() + 1, key.end()), type))
+        builder.Put(type, kv.second.m_featureId);
+    }
+    builder.Freeze(*typesIndexWriter);
+  }
+
   trie::Build<Writer, TKey, ValueList<TValue>, SingleValueSerializer<TValue>>(
       indexWriter, serializer, searchIndexKeyValuePairs);
 
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <string>
 
 class FilesContainerR;
@@ -11,7 +12,12 @@ namespace indexer
 // An attempt to rewrite the search index of an old mwm may result in a future crash
 // when using search because this function does not update mwm's version. This results
 // in version mismatch when trying to read the index.
-bool BuildSearchIndexFromDataFile(std::string const & filename, bool forceRebuild = false);
+// Names of features are collected and sorted on |threadsCount| threads.
+bool BuildSearchIndexFromDataFile(std::string const & filename, bool forceRebuild = false,
+                                  size_t threadsCount = 1);
 
-void BuildSearchIndex(FilesContainerR & container, Writer & indexWriter);
+// When |typesIndexWriter| is not null, posting lists of the category types of features are
+// written to it too (see search::TypesIndex).
+void BuildSearchIndex(FilesContainerR & container, Writer & indexWriter, size_t threadsCount = 1,
+                      Writer * typesIndexWriter = nullptr);
 }  // namespace indexer
@@ -0,0 +1,56 @@
+#include "generator/speed_cameras_generator.hpp"
+
+#include "routing/speed_camera.hpp"
+
+#include "indexer/data_header.hpp"
+#include "indexer/feature.hpp"
+#include "indexer/features_vector.hpp"
+#include "indexer/ftypes_matcher.hpp"
+
+#include "coding/file_container.hpp"
+#include "coding/file_writer.hpp"
+
+#include "base/exception.hpp"
+#include "base/logging.hpp"
+
+#include "defines.hpp"
+
+#include <vector>
+
+namespace routing
+{
+bool BuildSpeedCamerasSection(std::string const & dataFilePath)
+{
+  try
+  {
+    std::vector<SpeedCamera> cameras;
+    {
+      FilesContainerR rcont(dataFilePath);
+      feature::DataHeader const header(rcont);
+      FeaturesVector const features(rcont, header, nullptr /* features offsets table */);
+
+      auto const & checker = ftypes::IsSpeedCamChecker::Instance();
+      features.ForEach([&](FeatureType & ft, uint32_t /* featureId */) {
+        if (ft.GetFeatureType() != feature::GEOM_POINT || !checker(ft))
+          return;
+        cameras.emplace_back(ft.GetCenter(), ReadCameraRestriction(ft));
+      });
+    }
+
+    FilesContainerW cont(dataFilePath, FileWriter::OP_WRITE_EXISTING);
+    FileWriter writer = cont.GetWriter(SPEED_CAMERAS_FILE_TAG);
+    auto const startPos = writer.Pos();
+    SpeedCamerasSerializer::Serialize(writer, cameras);
+
+    LOG(LINFO, (SPEED_CAMERAS_FILE_TAG, "section created:", writer.Pos() - startPos, "bytes,",
+                cameras.size(), "cameras"));
+  }
+  catch (RootException const & e)
+  {
+    LOG(LERROR, ("Failed to build speed cameras section:", e.Msg()));
+    return false;
+  }
+
+  return true;
+}
+}  // namespace routing
@@ -0,0 +1,12 @@
+#pragma once
+
+#include <string>
+
+namespace routing
+{
+/// \brief Builds the section with positions and max speeds of all speed cameras of the mwm,
+/// see routing::SpeedCamerasSerializer.
+/// \param dataFilePath path to the mwm which will be added with the section.
+/// \returns false if the section can't be built.
+bool BuildSpeedCamerasSection(std::string const & dataFilePath);
+}  // namespace routing
@@ -0,0 +1,149 @@
+#include "generator/speed_profiles_generator.hpp"
+
+#include "generator/osm_id.hpp"
+#include "generator/routing_helpers.hpp"
+
+#include "routing/segment.hpp"
+#include "routing/speed_profiles.hpp"
+#include "routing/speed_profiles_serialization.hpp"
+
+#include "coding/file_container.hpp"
+#include "coding/file_writer.hpp"
+
+#include "base/logging.hpp"
+#include "base/string_utils.hpp"
+
+#include "defines.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace routing;
+using namespace std;
+
+namespace
+{
+char constexpr kDelim[] = " \t\r\n";
+
+// Parses the line in the format described in speed_profiles_generator.hpp.
+bool ParseProfileLine(string const & line, uint64_t & osmWayId, uint32_t & segmentIdx,
+                      bool & forward, SpeedProfiles::Profile & profile)
+{
+  strings::SimpleTokenizer iter(line, kDelim);
+
+  if (!iter || !strings::to_uint64(*iter, osmWayId))
+    return false;
+  ++iter;
+
+  if (!iter || !strings::to_uint(*iter, segmentIdx))
+    return false;
+  ++iter;
+
+  unsigned int isForward = 0;
+  if (!iter || !strings::to_uint(*iter, isForward) || isForward > 1)
+    return false;
+  forward = isForward == 1;
+  ++iter;
+
+  for (auto & factor : profile)
+  {
+    unsigned int percents = 0;
+    if (!iter || !strings::to_uint(*iter, percents))
+      return false;
+    factor = SpeedProfiles::QuantizeFactor(static_cast<double>(percents) / SpeedProfiles::kMaxFactor);
+    ++iter;
+  }
+  return !iter;
+}
+}  // namespace
+
+namespace routing
+{
+bool BuildSpeedProfilesSection(string const & dataFilePath, string const & speedProfilesPath,
+                               string const & osmIdsToFeatureIdsPath)
+{
+  LOG(LINFO, ("Building speed profiles section for", dataFilePath));
+
+  map<osm::Id, uint32_t> osmIdToFeatureId;
+  if (!ParseOsmIdToFeatureIdMapping(osmIdsToFeatureIdsPath, osmIdToFeatureId))
+  {
+    LOG(LWARNING, ("An error happened while parsing feature id to osm ids mapping from file:",
+                   osmIdsToFeatureIdsPath));
+    return false;
+  }
+
+  ifstream stream(speedProfilesPath);
+  if (!stream)
+  {
+    LOG(LWARNING, ("Could not open", speedProfilesPath));
+    return false;
+  }
+
+  vector<pair<Segment, SpeedProfiles::Profile>> segmentProfiles;
+  string line;
+  size_t lineNo = 0;
+  while (getline(stream, line))
+  {
+    ++lineNo;
+    uint64_t osmWayId = 0;
+    uint32_t segmentIdx = 0;
+    bool forward = false;
+    SpeedProfiles::Profile profile;
+    if (!ParseProfileLine(line, osmWayId, segmentIdx, forward, profile))
+    {
+      LOG(LWARNING, ("Error parsing speed profile in", speedProfilesPath, "line:", lineNo));
+      continue;
+    }
+
+    auto const it = osmIdToFeatureId.find(osm::Id::Way(osmWayId));
+    // The profiles are collected for the whole planet, most of the ways are in other mwms.
+    if (it == osmIdToFeatureId.cend())
+      continue;
+
+    segmentProfiles.emplace_back(Segment(kFakeNumMwmId, it->second, segmentIdx, forward), profile);
+  }
+
+  if (segmentProfiles.empty())
+  {
+    LOG(LINFO, ("No speed profiles for", dataFilePath));
+    return false;
+  }
+
+  // All the segments are of the same mwm so they are sorted in the order of SpeedProfiles keys.
+  sort(segmentProfiles.begin(), segmentProfiles.end(),
+       [](pair<Segment, SpeedProfiles::Profile> const & lhs,
+          pair<Segment, SpeedProfiles::Profile> const & rhs) { return lhs.first < rhs.first; });
+
+  SpeedProfiles speedProfiles;
+  map<SpeedProfiles::Profile, uint32_t> profileIds;
+  Segment const * prevSegment = nullptr;
+  for (auto const & segmentProfile : segmentProfiles)
+  {
+    Segment const & segment = segmentProfile.first;
+    if (prevSegment && *prevSegment == segment)
+    {
+      LOG(LWARNING, ("Several speed profiles for", segment, "the first one is used."));
+      continue;
+    }
+    prevSegment = &segment;
+
+    auto const emplaced = profileIds.emplace(segmentProfile.second, 0);
+    if (emplaced.second)
+      emplaced.first->second = speedProfiles.AddProfile(segmentProfile.second);
+    speedProfiles.SetSegmentProfile(segment, emplaced.first->second);
+  }
+
+  LOG(LINFO, ("Speed profiles section contains", speedProfiles.GetNumSegments(), "segments and",
+              speedProfiles.GetNumProfiles(), "distinct profiles."));
+
+  FilesContainerW cont(dataFilePath, FileWriter::OP_WRITE_EXISTING);
+  FileWriter writer = cont.GetWriter(SPEED_PROFILES_FILE_TAG);
+  SpeedProfilesSerializer::Serialize(writer, speedProfiles);
+  return true;
+}
+}  // namespace routing
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <string>
+
+namespace routing
+{
+/// \brief Builds the section with historical speed profiles of car road segments.
+/// \param dataFilePath path to the mwm which will be added with the section.
+/// \param speedProfilesPath text file with a line for every road segment with a profile
+/// in the following format:
+/// <osm way id> <segment idx> <1 if forward, 0 otherwise> <factor 0> ... <factor 95>
+/// where factors are the percents of the free flow speed for the 15 minute buckets of a day.
+/// \param osmIdsToFeatureIdsPath a binary file with mapping form osm ids to feature ids.
+/// \returns false if no valid profiles are found.
+bool BuildSpeedProfilesSection(std::string const & dataFilePath,
+                               std::string const & speedProfilesPath,
+                               std::string const & osmIdsToFeatureIdsPath);
+}  // namespace routing
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "generator/latlon_bands_index.hpp"
+
 #include "platform/platform.hpp"
 
 #include "geometry/distance_on_sphere.hpp"
@@ -7,17 +9,14 @@
 
 #include "base/logging.hpp"
 
+#include <algorithm>
 #include <fstream>
 #include <functional>
 #include <map>
 #include <string>
+#include <utility>
 #include <vector>
 
-#include "boost/geometry.hpp"
-#include "boost/geometry/geometries/box.hpp"
-#include "boost/geometry/geometries/point.hpp"
-#include "boost/geometry/index/rtree.hpp"
-
 namespace generator
 {
 template <typename Object>
@@ -77,7 +76,8 @@ public:
   void LoadData(std::istream & src, std::string const & addressReferencePath)
   {
     m_objects.clear();
-    m_rtree.clear();
+    m_ids.clear();
+    m_index = LatLonBandsIndex();
 
     for (std::string line; std::getline(src, line);)
     {
@@ -103,13 +103,16 @@ public:
       platform.SetWritableDirForTests(backupPath);
     }
 
+    LatLonBandsIndex::TPoints points;
+    points.reserve(m_objects.size());
     for (auto const & item : m_objects)
     {
-      auto const & object = item.second;
-      Box b(Point(object.m_latLon.lat, object.m_latLon.lon),
-            Point(object.m_latLon.lat, object.m_latLon.lon));
-      m_rtree.insert(make_pair(b, object.m_id));
+      points.emplace_back(item.second.m_latLon, static_cast<uint32_t>(m_ids.size()));
+      m_ids.push_back(item.first);
     }
+
+    if (m_distanceLimitMeters != 0.0)
+      m_index = LatLonBandsIndex(points, m_distanceLimitMeters);
   }
 
   Object const & GetObjectById(ObjectId id) const
@@ -126,36 +129,41 @@ public:
     return it->second;
   }
 
+  /// @return ids of at most |m_maxSelectedElements| objects in |m_distanceLimitMeters|
+  /// from |latLon|, nearest objects go first. It's safe to call it concurrently.
   std::vector<ObjectId> GetNearestObjects(ms::LatLon const & latLon) const
   {
-    namespace bgi = boost::geometry::index;
-
-    std::vector<ObjectId> indexes;
-    for_each(bgi::qbegin(m_rtree, bgi::nearest(Point(latLon.lat, latLon.lon),
-                                               static_cast<unsigned>(m_maxSelectedElements))),
-             bgi::qend(m_rtree), [this, &latLon, &indexes](Value const & v) {
-               auto const & object = GetObjectById(v.second);
-               double const dist = ms::DistanceOnEarth(latLon, object.m_latLon);
-               if (m_distanceLimitMeters != 0.0 && dist > m_distanceLimitMeters)
-                 return;
+    std::vector<std::pair<double, uint32_t>> nearest;
+    if (m_distanceLimitMeters != 0.0)
+    {
+      m_index.ForEachInDistance(latLon, [&nearest](uint32_t i, double distance) {
+        nearest.emplace_back(distance, i);
+      });
+    }
+    else
+    {
+      for (size_t i = 0; i < m_ids.size(); ++i)
+      {
+        nearest.emplace_back(ms::DistanceOnEarth(latLon, GetObjectById(m_ids[i]).m_latLon),
+                             static_cast<uint32_t>(i));
+      }
+    }
 
-               indexes.emplace_back(v.second);
-             });
+    size_t const count = std::min(nearest.size(), m_maxSelectedElements);
+    std::partial_sort(nearest.begin(), nearest.begin() + count, nearest.end());
 
-    return indexes;
+    std::vector<ObjectId> ids;
+    ids.reserve(count);
+    for (size_t i = 0; i < count; ++i)
+      ids.push_back(m_ids[nearest[i].second]);
+    return ids;
   }
 
 private:
-  // TODO(mgsergio): Get rid of Box since boost::rtree supports point as value type.
-  // TODO(mgsergio): Use mercator instead of latlon or boost::geometry::cs::spherical_equatorial
-  // instead of boost::geometry::cs::cartesian.
-  using Point = boost::geometry::model::point<float, 2, boost::geometry::cs::cartesian>;
-  using Box = boost::geometry::model::box<Point>;
-  using Value = std::pair<Box, ObjectId>;
-
-  // Create the rtree using default constructor.
-  boost::geometry::index::rtree<Value, boost::geometry::index::quadratic<16>> m_rtree;
   ObjectsContainer m_objects;
+  // Ids of objects by values of |m_index|.
+  std::vector<ObjectId> m_ids;
+  LatLonBandsIndex m_index;
 
   double const m_distanceLimitMeters;
   size_t const m_maxSelectedElements;
@@ -1,6 +1,10 @@
 #pragma once
 
+#include "base/string_utils.hpp"
+
 #include <string>
+#include <utility>
+#include <vector>
 
 class FeatureBuilder1;
 
@@ -8,7 +12,13 @@ namespace generator
 {
 namespace impl
 {
+// Normalized words of a name with their weights, sorted by words.
+using WeightedBagOfWords = std::vector<std::pair<strings::UniString, double>>;
+
+WeightedBagOfWords MakeWeightedBagOfWords(std::string const & name);
+
 double GetLinearNormDistanceScore(double distance, double maxDistance);
+double GetNameSimilarityScore(WeightedBagOfWords const & lhs, WeightedBagOfWords const & rhs);
 double GetNameSimilarityScore(std::string const & booking_name, std::string const & osm_name);
 }  // namespace impl
 
@@ -30,5 +40,11 @@ struct MatchStats
 /// Matches a given sponsored object against a given OSM object.
 template <typename SponsoredObject>
 MatchStats<SponsoredObject> Match(SponsoredObject const & o, FeatureBuilder1 const & fb);
+
+/// Same as above, |fbName| is MakeWeightedBagOfWords() of the default name of |fb|, so
+/// the name is normalized once for all candidates.
+template <typename SponsoredObject>
+MatchStats<SponsoredObject> Match(SponsoredObject const & o, FeatureBuilder1 const & fb,
+                                  impl::WeightedBagOfWords const & fbName);
 }  // namespace booking_scoring
 }  // namespace generator
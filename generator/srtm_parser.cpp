@@ -1,12 +1,21 @@
 #include "generator/srtm_parser.hpp"
 
+#include "platform/platform.hpp"
+
 #include "coding/endianness.hpp"
+#include "coding/mmap_reader.hpp"
+#include "coding/writer.hpp"
 #include "coding/zip_reader.hpp"
 
 #include "base/logging.hpp"
+#include "base/stl_add.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <iomanip>
 #include <sstream>
+#include <thread>
+#include <unordered_set>
 
 namespace generator
 {
@@ -14,25 +23,6 @@ namespace
 {
 size_t constexpr kArcSecondsInDegree = 60 * 60;
 size_t constexpr kSrtmTileSize = (kArcSecondsInDegree + 1) * (kArcSecondsInDegree + 1) * 2;
-
-struct UnzipMemDelegate : public ZipFileReader::Delegate
-{
-  UnzipMemDelegate(std::string & buffer) : m_buffer(buffer), m_completed(false) {}
-
-  // ZipFileReader::Delegate overrides:
-  void OnBlockUnzipped(size_t size, char const * data) override { m_buffer.append(data, size); }
-
-  void OnStarted() override
-  {
-    m_buffer.clear();
-    m_completed = false;
-  }
-
-  void OnCompleted() override { m_completed = true; }
-
-  std::string & m_buffer;
-  bool m_completed;
-};
 }  // namespace
 
 // SrtmTile ----------------------------------------------------------------------------------------
@@ -41,37 +31,52 @@ SrtmTile::SrtmTile()
   Invalidate();
 }
 
-SrtmTile::SrtmTile(SrtmTile && rhs) : m_data(move(rhs.m_data)), m_valid(rhs.m_valid)
+SrtmTile::SrtmTile(SrtmTile && rhs)
+  : m_data(move(rhs.m_data)), m_mmap(move(rhs.m_mmap)), m_valid(rhs.m_valid)
 {
   rhs.Invalidate();
 }
 
+SrtmTile::~SrtmTile() {}
+
 void SrtmTile::Init(std::string const & dir, ms::LatLon const & coord)
 {
   Invalidate();
 
   std::string const base = GetBase(coord);
+
+  std::string const hgt = dir + base + ".hgt";
+  if (Platform::IsFileExistsByFullPath(hgt))
+  {
+    m_mmap = my::make_unique<MmapReader>(hgt);
+    if (m_mmap->Size() != kSrtmTileSize)
+    {
+      LOG(LWARNING, ("Bad SRTM file size:", hgt, m_mmap->Size()));
+      Invalidate();
+      return;
+    }
+
+    m_valid = true;
+    return;
+  }
+
   std::string const cont = dir + base + ".SRTMGL1.hgt.zip";
   std::string file = base + ".hgt";
 
-  UnzipMemDelegate delegate(m_data);
+  // The size of the tile is known, so the buffer is not reallocated while unzipping.
+  m_data.clear();
+  m_data.reserve(kSrtmTileSize);
+  MemWriter<std::string> writer(m_data);
   try
   {
-    ZipFileReader::UnzipFile(cont, file, delegate);
+    ZipFileReader::UnzipFile(cont, file, writer);
   }
   catch (ZipFileReader::LocateZipException const & e)
   {
     // Sometimes packed file has different name. See N39E051 measure.
     file = base + ".SRTMGL1.hgt";
 
-    ZipFileReader::UnzipFile(cont, file, delegate);
-  }
-
-  if (!delegate.m_completed)
-  {
-    LOG(LWARNING, ("Can't decompress SRTM file:", cont));
-    Invalidate();
-    return;
+    ZipFileReader::UnzipFile(cont, file, writer);
   }
 
   if (m_data.size() != kSrtmTileSize)
@@ -84,7 +89,7 @@ void SrtmTile::Init(std::string const & dir, ms::LatLon const & coord)
   m_valid = true;
 }
 
-feature::TAltitude SrtmTile::GetHeight(ms::LatLon const & coord)
+feature::TAltitude SrtmTile::GetHeight(ms::LatLon const & coord) const
 {
   if (!IsValid())
     return feature::kInvalidAltitude;
@@ -136,10 +141,24 @@ std::string SrtmTile::GetBase(ms::LatLon coord)
   return ss.str();
 }
 
+feature::TAltitude const * SrtmTile::Data() const
+{
+  if (m_mmap)
+    return reinterpret_cast<feature::TAltitude const *>(m_mmap->Data());
+  return reinterpret_cast<feature::TAltitude const *>(m_data.data());
+}
+
+size_t SrtmTile::Size() const
+{
+  size_t const bytes = m_mmap ? static_cast<size_t>(m_mmap->Size()) : m_data.size();
+  return bytes / sizeof(feature::TAltitude);
+}
+
 void SrtmTile::Invalidate()
 {
   m_data.clear();
   m_data.shrink_to_fit();
+  m_mmap.reset();
   m_valid = false;
 }
 
@@ -147,25 +166,64 @@ void SrtmTile::Invalidate()
 SrtmTileManager::SrtmTileManager(std::string const & dir) : m_dir(dir) {}
 feature::TAltitude SrtmTileManager::GetHeight(ms::LatLon const & coord)
 {
-  std::string const base = SrtmTile::GetBase(coord);
-  auto it = m_tiles.find(base);
-  if (it == m_tiles.end())
+  return GetTile(coord).GetHeight(coord);
+}
+
+void SrtmTileManager::Prefetch(std::vector<ms::LatLon> const & coords, size_t threadsCount)
+{
+  std::vector<ms::LatLon> tiles;
   {
-    SrtmTile tile;
-    try
+    std::unordered_set<std::string> bases;
+    for (auto const & coord : coords)
     {
-      tile.Init(m_dir, coord);
-    }
-    catch (RootException const & e)
-    {
-      LOG(LINFO, ("Can't init SRTM tile:", base, "reason:", e.Msg()));
+      if (bases.insert(SrtmTile::GetBase(coord)).second)
+        tiles.push_back(coord);
     }
+  }
 
-    // It's OK to store even invalid tiles and return invalid height
-    // for them later.
-    it = m_tiles.emplace(base, std::move(tile)).first;
+  std::atomic<size_t> next(0);
+  auto const load = [&]()
+  {
+    for (size_t i = next++; i < tiles.size(); i = next++)
+      GetTile(tiles[i]);
+  };
+
+  threadsCount = std::min(threadsCount, tiles.size());
+  std::vector<std::thread> threads;
+  for (size_t i = 1; i < threadsCount; ++i)
+    threads.emplace_back(load);
+  load();
+  for (auto & thread : threads)
+    thread.join();
+
+  LOG(LINFO, ("Prefetched SRTM tiles:", tiles.size()));
+}
+
+SrtmTile const & SrtmTileManager::GetTile(ms::LatLon const & coord)
+{
+  std::string const base = SrtmTile::GetBase(coord);
+  {
+    std::lock_guard<std::mutex> lock(m_tilesMutex);
+    auto const it = m_tiles.find(base);
+    if (it != m_tiles.end())
+      return it->second;
+  }
+
+  // Tiles are loaded without the lock, so different tiles are loaded in parallel.
+  // When a tile is loaded by several threads at once, one of copies is stored.
+  SrtmTile tile;
+  try
+  {
+    tile.Init(m_dir, coord);
+  }
+  catch (RootException const & e)
+  {
+    LOG(LINFO, ("Can't init SRTM tile:", base, "reason:", e.Msg()));
   }
 
-  return it->second.GetHeight(coord);
+  // It's OK to store even invalid tiles and return invalid height
+  // for them later.
+  std::lock_guard<std::mutex> lock(m_tilesMutex);
+  return m_tiles.emplace(base, std::move(tile)).first->second;
 }
 }  // namespace generator
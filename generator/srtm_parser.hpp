@@ -6,9 +6,15 @@
 
 #include "base/macros.hpp"
 
+#include <cstddef>
 #include <cstdint>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
+#include <vector>
+
+class MmapReader;
 
 namespace generator
 {
@@ -17,25 +23,25 @@ class SrtmTile
 public:
   SrtmTile();
   SrtmTile(SrtmTile && rhs);
+  ~SrtmTile();
 
+  // Uncompressed |dir|/<base>.hgt is mapped to memory, otherwise the tile is
+  // unpacked from |dir|/<base>.SRTMGL1.hgt.zip.
   void Init(std::string const & dir, ms::LatLon const & coord);
 
   inline bool IsValid() const { return m_valid; }
   // Returns height in meters at |coord| or kInvalidAltitude.
-  feature::TAltitude GetHeight(ms::LatLon const & coord);
+  feature::TAltitude GetHeight(ms::LatLon const & coord) const;
 
   static std::string GetBase(ms::LatLon coord);
 
 private:
-  inline feature::TAltitude const * Data() const
-  {
-    return reinterpret_cast<feature::TAltitude const *>(m_data.data());
-  };
-
-  inline size_t Size() const { return m_data.size() / sizeof(feature::TAltitude); }
+  feature::TAltitude const * Data() const;
+  size_t Size() const;
   void Invalidate();
 
   std::string m_data;
+  std::unique_ptr<MmapReader> m_mmap;
   bool m_valid;
 
   DISALLOW_COPY(SrtmTile);
@@ -46,10 +52,21 @@ class SrtmTileManager
 public:
   SrtmTileManager(std::string const & dir);
 
+  // It's safe to call GetHeight() and Prefetch() from several threads.
   feature::TAltitude GetHeight(ms::LatLon const & coord);
 
+  // Loads tiles which contain |coords| on |threadsCount| threads, so GetHeight()
+  // doesn't wait for reading and unpacking of these tiles later.
+  void Prefetch(std::vector<ms::LatLon> const & coords, size_t threadsCount);
+
 private:
+  SrtmTile const & GetTile(ms::LatLon const & coord);
+
   std::string m_dir;
+
+  std::mutex m_tilesMutex;
+  // Elements of unordered_map aren't moved by rehashing, so references
+  // to tiles are valid while the manager exists.
   std::unordered_map<std::string, SrtmTile> m_tiles;
 
   DISALLOW_COPY(SrtmTileManager);
@@ -0,0 +1,216 @@
+#include "generator/stages_profiler.hpp"
+
+#include "indexer/features_offsets_table.hpp"
+
+#include "coding/file_container.hpp"
+#include "coding/file_name_utils.hpp"
+#include "coding/file_writer.hpp"
+
+#include "base/logging.hpp"
+
+#include "std/target_os.hpp"
+
+#include <fstream>
+#include <memory>
+#include <sstream>
+
+#include <sys/resource.h>
+
+#include "defines.hpp"
+
+#include "3party/jansson/myjansson.hpp"
+
+using namespace std;
+
+namespace generator
+{
+namespace
+{
+double GetCpuTimeSec()
+{
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0)
+    return 0.0;
+
+  auto const toSec = [](timeval const & t) { return t.tv_sec + t.tv_usec / 1e6; };
+  return toSec(usage.ru_utime) + toSec(usage.ru_stime);
+}
+
+#if defined(OMIM_OS_LINUX)
+// Returns a value of the line which starts with |key| in files like /proc/self/status.
+uint64_t ReadProcValue(string const & fileName, string const & key)
+{
+  ifstream file(fileName);
+  string line;
+  while (getline(file, line))
+  {
+    if (line.compare(0, key.size(), key) != 0)
+      continue;
+
+    uint64_t value = 0;
+    istringstream(line.substr(key.size())) >> value;
+    return value;
+  }
+  return 0;
+}
+#endif
+
+void ResetPeakRss()
+{
+#if defined(OMIM_OS_LINUX)
+  // See "clear_refs" in man proc(5).
+  ofstream("/proc/self/clear_refs") << "5";
+#endif
+}
+
+uint64_t GetPeakRssBytes()
+{
+#if defined(OMIM_OS_LINUX)
+  uint64_t const peakKb = ReadProcValue("/proc/self/status", "VmHWM:");
+  if (peakKb != 0)
+    return peakKb * 1024;
+#endif
+
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0)
+    return 0;
+#if defined(OMIM_OS_MAC)
+  // ru_maxrss is in bytes on Mac.
+  return static_cast<uint64_t>(usage.ru_maxrss);
+#else
+  return static_cast<uint64_t>(usage.ru_maxrss) * 1024;
+#endif
+}
+
+void GetIOBytes(uint64_t & readBytes, uint64_t & writtenBytes)
+{
+  readBytes = 0;
+  writtenBytes = 0;
+#if defined(OMIM_OS_LINUX)
+  readBytes = ReadProcValue("/proc/self/io", "read_bytes:");
+  writtenBytes = ReadProcValue("/proc/self/io", "write_bytes:");
+#endif
+}
+}  // namespace
+
+// static
+char const * const StagesProfiler::kCommonReportName = "common";
+
+StagesProfiler::Stage::Stage(StagesProfiler & profiler, string const & country,
+                             string const & name, string const & mwmPath)
+  : m_profiler(profiler), m_country(country), m_mwmPath(mwmPath)
+{
+  if (!m_profiler.IsEnabled())
+    return;
+
+  m_report.m_name = name;
+  m_report.m_cpuTimeSec = GetCpuTimeSec();
+  GetIOBytes(m_report.m_readBytes, m_report.m_writtenBytes);
+  ResetPeakRss();
+  m_timer.Reset();
+}
+
+StagesProfiler::Stage::~Stage()
+{
+  if (!m_profiler.IsEnabled())
+    return;
+
+  m_report.m_wallTimeSec = m_timer.ElapsedSeconds();
+  m_report.m_cpuTimeSec = GetCpuTimeSec() - m_report.m_cpuTimeSec;
+  m_report.m_peakRssBytes = GetPeakRssBytes();
+
+  uint64_t readBytes;
+  uint64_t writtenBytes;
+  GetIOBytes(readBytes, writtenBytes);
+  m_report.m_readBytes = readBytes - m_report.m_readBytes;
+  m_report.m_writtenBytes = writtenBytes - m_report.m_writtenBytes;
+
+  if (!m_mwmPath.empty())
+    m_report.m_featuresCount = GetFeaturesCount(m_mwmPath);
+
+  LOG(LINFO, ("Stage", m_report.m_name, "of", m_country, "is finished in",
+              m_report.m_wallTimeSec, "seconds"));
+  m_profiler.AddStage(m_country, m_report);
+}
+
+void StagesProfiler::AddStage(string const & country, StageReport const & report)
+{
+  lock_guard<mutex> lock(m_mutex);
+  m_reports[country].push_back(report);
+}
+
+bool StagesProfiler::WriteReports(string const & dir) const
+{
+  lock_guard<mutex> lock(m_mutex);
+
+  bool result = true;
+  for (auto const & report : m_reports)
+  {
+    string const fileName =
+        my::JoinFoldersToPath(dir, report.first + STAGES_REPORT_FILE_EXTENSION);
+    try
+    {
+      string const data = SerializeStages(report.first, report.second);
+      FileWriter writer(fileName);
+      writer.Write(data.data(), data.size());
+    }
+    catch (FileWriter::Exception const & e)
+    {
+      LOG(LERROR, ("Can't write stages report", fileName, e.Msg()));
+      result = false;
+    }
+  }
+  return result;
+}
+
+string StagesProfiler::SerializeReport(string const & country) const
+{
+  lock_guard<mutex> lock(m_mutex);
+
+  auto const it = m_reports.find(country);
+  if (it == m_reports.cend())
+    return SerializeStages(country, {});
+  return SerializeStages(country, it->second);
+}
+
+// static
+string StagesProfiler::SerializeStages(string const & country, vector<StageReport> const & stages)
+{
+  auto stagesNode = my::NewJSONArray();
+  for (auto const & stage : stages)
+  {
+    auto node = my::NewJSONObject();
+    ToJSONObject(*node, "name", stage.m_name);
+    ToJSONObject(*node, "wall_time_sec", stage.m_wallTimeSec);
+    ToJSONObject(*node, "cpu_time_sec", stage.m_cpuTimeSec);
+    ToJSONObject(*node, "peak_rss_bytes", stage.m_peakRssBytes);
+    ToJSONObject(*node, "read_bytes", stage.m_readBytes);
+    ToJSONObject(*node, "written_bytes", stage.m_writtenBytes);
+    ToJSONObject(*node, "features_count", stage.m_featuresCount);
+    json_array_append_new(stagesNode.get(), node.release());
+  }
+
+  auto const root = my::NewJSONObject();
+  ToJSONObject(*root, "country", country);
+  json_object_set_new(root.get(), "stages", stagesNode.release());
+
+  unique_ptr<char, JSONFreeDeleter> buffer(json_dumps(root.get(), JSON_INDENT(2)));
+  return buffer.get();
+}
+
+uint64_t GetFeaturesCount(string const & mwmPath)
+{
+  try
+  {
+    FilesContainerR const cont(mwmPath);
+    if (!cont.IsExist(FEATURE_OFFSETS_FILE_TAG))
+      return 0;
+    return feature::FeaturesOffsetsTable::Load(cont)->size();
+  }
+  catch (Reader::Exception const & e)
+  {
+    LOG(LWARNING, ("Can't count features of", mwmPath, e.Msg()));
+    return 0;
+  }
+}
+}  // namespace generator
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "base/timer.hpp"
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace generator
+{
+// Resources used by a generation stage.
+struct StageReport
+{
+  std::string m_name;
+  double m_wallTimeSec = 0.0;
+  double m_cpuTimeSec = 0.0;
+  uint64_t m_peakRssBytes = 0;
+  // Bytes which are read from and written to the storage.
+  uint64_t m_readBytes = 0;
+  uint64_t m_writtenBytes = 0;
+  // Features in the mwm after the stage, zero if the mwm has no offsets table yet.
+  uint64_t m_featuresCount = 0;
+};
+
+// Collects reports of generator stages for every country. CPU time, peak RSS and
+// IO counters are taken for the whole process, so they are exact only when
+// countries are processed one by one. Peak RSS is reset at the beginning of a
+// stage on Linux, on other platforms it's the peak of the process so far.
+class StagesProfiler
+{
+public:
+  // Name of the report of stages which aren't bound to a country.
+  static char const * const kCommonReportName;
+
+  // Measures resources from the construction to the destruction.
+  class Stage
+  {
+  public:
+    // Features count is taken from |mwmPath| when it's not empty.
+    Stage(StagesProfiler & profiler, std::string const & country, std::string const & name,
+          std::string const & mwmPath = std::string());
+    ~Stage();
+
+  private:
+    StagesProfiler & m_profiler;
+    std::string m_country;
+    std::string m_mwmPath;
+    StageReport m_report;
+    my::Timer m_timer;
+  };
+
+  explicit StagesProfiler(bool enabled) : m_enabled(enabled) {}
+
+  bool IsEnabled() const { return m_enabled; }
+
+  void AddStage(std::string const & country, StageReport const & report);
+
+  // Writes |<country><STAGES_REPORT_FILE_EXTENSION>| files to |dir|.
+  bool WriteReports(std::string const & dir) const;
+
+  std::string SerializeReport(std::string const & country) const;
+
+private:
+  static std::string SerializeStages(std::string const & country,
+                                     std::vector<StageReport> const & stages);
+
+  bool const m_enabled;
+  mutable std::mutex m_mutex;
+  std::map<std::string, std::vector<StageReport>> m_reports;
+};
+
+uint64_t GetFeaturesCount(std::string const & mwmPath);
+}  // namespace generator
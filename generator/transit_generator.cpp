@@ -1,16 +1,183 @@
 #include "generator/transit_generator.hpp"
 
+#include "routing/transit_section.hpp"
+
+#include "platform/platform.hpp"
+
+#include "coding/file_container.hpp"
+#include "coding/file_name_utils.hpp"
+#include "coding/file_reader.hpp"
+#include "coding/file_writer.hpp"
+
+#include "geometry/point2d.hpp"
+
 #include "base/logging.hpp"
-#include "base/macros.hpp"
+
+#include "defines.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "3party/jansson/myjansson.hpp"
+
+using namespace std;
+
+// Transit json of a country is an object of arrays, points are mercator:
+// {
+//   "stops": [{"id": 1, "feature_id": 2, "point": {"x": 37.5, "y": 67.5}, "line_ids": [3]}],
+//   "gates": [{"feature_id": 4, "stop_ids": [1], "point": {"x": 37.6, "y": 67.6},
+//              "weight": 30, "entrance": true, "exit": true}],
+//   "edges": [{"stop1_id": 1, "stop2_id": 5, "line_id": 3, "shape_id": 6, "weight": 120,
+//              "transfer": false}],
+//   "lines": [{"id": 3, "title": "1", "stop_ids": [1, 5]}],
+//   "shapes": [{"id": 6, "polyline": [{"x": 37.5, "y": 67.5}, {"x": 37.7, "y": 67.7}]}]
+// }
+// "feature_id" of stops, "line_id" and "shape_id" of edges are optional.
+namespace
+{
+using namespace routing::transit;
+
+json_t * GetArray(json_t * root, string const & field)
+{
+  json_t * arr = my::GetJSONOptionalField(root, field);
+  if (arr && !json_is_array(arr))
+    MYTHROW(my::Json::Exception, ("The field", field, "must contain a json array."));
+  return arr;
+}
+
+template <typename Fn>
+void ForEachItem(json_t * root, string const & field, Fn && fn)
+{
+  json_t * arr = GetArray(root, field);
+  if (!arr)
+    return;
+  for (size_t i = 0; i < json_array_size(arr); ++i)
+    fn(json_array_get(arr, i));
+}
+
+m2::PointD GetPoint(json_t * point)
+{
+  double x = 0.0;
+  double y = 0.0;
+  FromJSONObject(point, "x", x);
+  FromJSONObject(point, "y", y);
+  return {x, y};
+}
+
+m2::PointD GetPoint(json_t * root, string const & field)
+{
+  return GetPoint(my::GetJSONObligatoryField(root, field));
+}
+
+uint32_t GetOptionalId(json_t * root, string const & field)
+{
+  json_t * id = my::GetJSONOptionalField(root, field);
+  if (!id || my::JSONIsNull(id))
+    return kInvalidId;
+  uint32_t result = kInvalidId;
+  FromJSON(id, result);
+  return result;
+}
+
+void ParseTransit(json_t * root, TransitSectionBuilder & builder)
+{
+  ForEachItem(root, "stops", [&builder](json_t * stop) {
+    uint32_t id = 0;
+    vector<uint32_t> lineIds;
+    FromJSONObject(stop, "id", id);
+    FromJSONObjectOptionalField(stop, "line_ids", lineIds);
+    builder.AddStop(id, GetOptionalId(stop, "feature_id"), GetPoint(stop, "point"), lineIds);
+  });
+
+  ForEachItem(root, "gates", [&builder](json_t * gate) {
+    uint32_t featureId = 0;
+    vector<uint32_t> stopIds;
+    double weight = 0.0;
+    bool entrance = false;
+    bool exit = false;
+    FromJSONObject(gate, "feature_id", featureId);
+    FromJSONObject(gate, "stop_ids", stopIds);
+    FromJSONObject(gate, "weight", weight);
+    FromJSONObject(gate, "entrance", entrance);
+    FromJSONObject(gate, "exit", exit);
+    m2::PointD const point = GetPoint(gate, "point");
+    // A gate record is kept for every stop of the gate, so gates are looked up by stops.
+    for (auto const stopId : stopIds)
+      builder.AddGate(featureId, stopId, static_cast<float>(weight), entrance, exit, point);
+  });
+
+  ForEachItem(root, "edges", [&builder](json_t * edge) {
+    uint32_t stop1Id = 0;
+    uint32_t stop2Id = 0;
+    double weight = 0.0;
+    bool transfer = false;
+    FromJSONObject(edge, "stop1_id", stop1Id);
+    FromJSONObject(edge, "stop2_id", stop2Id);
+    FromJSONObject(edge, "weight", weight);
+    FromJSONObjectOptionalField(edge, "transfer", transfer);
+    builder.AddEdge(stop1Id, stop2Id, GetOptionalId(edge, "line_id"),
+                    GetOptionalId(edge, "shape_id"), static_cast<float>(weight), transfer);
+  });
+
+  ForEachItem(root, "lines", [&builder](json_t * line) {
+    uint32_t id = 0;
+    string title;
+    vector<uint32_t> stopIds;
+    FromJSONObject(line, "id", id);
+    FromJSONObjectOptionalField(line, "title", title);
+    FromJSONObject(line, "stop_ids", stopIds);
+    builder.AddLine(id, title, stopIds);
+  });
+
+  ForEachItem(root, "shapes", [&builder](json_t * shape) {
+    uint32_t id = 0;
+    vector<m2::PointD> polyline;
+    FromJSONObject(shape, "id", id);
+    ForEachItem(shape, "polyline", [&polyline](json_t * point) {
+      polyline.push_back(GetPoint(point));
+    });
+    builder.AddShape(id, polyline);
+  });
+}
+}  // namespace
 
 namespace routing
 {
 namespace transit
 {
-void BuildTransit(std::string const & mwmPath, std::string const & transitDir)
+void BuildTransit(string const & mwmPath, string const & transitDir)
 {
   LOG(LINFO, ("mwm path:", mwmPath, ", directory with transit:", transitDir));
-  NOTIMPLEMENTED();
+
+  string country = mwmPath;
+  my::GetNameFromFullPath(country);
+  my::GetNameWithoutExt(country);
+  string const jsonPath = my::JoinFoldersToPath(transitDir, country + TRANSIT_FILE_EXTENSION);
+  if (!GetPlatform().IsFileExistsByFullPath(jsonPath))
+  {
+    LOG(LINFO, ("No transit for", country));
+    return;
+  }
+
+  try
+  {
+    string content;
+    FileReader(jsonPath).ReadAsString(content);
+    my::Json root(content);
+
+    TransitSectionBuilder builder;
+    ParseTransit(root.get(), builder);
+
+    FilesContainerW cont(mwmPath, FileWriter::OP_WRITE_EXISTING);
+    FileWriter writer = cont.GetWriter(TRANSIT_FILE_TAG);
+    builder.Write(writer);
+  }
+  catch (RootException const & e)
+  {
+    LOG(LERROR, ("An exception happened while creating", TRANSIT_FILE_TAG, "section by", jsonPath,
+                 ":", e.what()));
+  }
 }
 }  // namespace transit
 }  // namespace routing
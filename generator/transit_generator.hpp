@@ -1,9 +1,13 @@
+#pragma once
+
 #include <string>
 
 namespace routing
 {
 namespace transit
 {
-void BuildTransit(std::string const & mwmPath, std::string const & srtmDir);
+// Builds the transit section of the mwm |mwmPath| by |transitDir|/<country>.transit.json.
+// Does nothing when there is no such a file. See the format in transit_generator.cpp.
+void BuildTransit(std::string const & mwmPath, std::string const & transitDir);
 }  // namespace transit
 }  // namespace routing
@@ -241,7 +241,8 @@ class WorldMapGenerator
 public:
   explicit WorldMapGenerator(feature::GenerateInfo const & info)
       : m_worldBucket(info),
-        m_merger(POINT_COORD_BITS - (scales::GetUpperScale() - scales::GetUpperWorldScale()) / 2),
+        m_merger(POINT_COORD_BITS - (scales::GetUpperScale() - scales::GetUpperWorldScale()) / 2,
+                 info.m_mergerThreadsCount),
         m_boundaryChecker(info)
   {
     // Do not strip last types for given tags,
@@ -22,6 +22,7 @@ SOURCES += \
   robust_orientation.cpp \
   screenbase.cpp \
   segment2d.cpp \
+  segments_batch.cpp \
   spline.cpp \
   triangle2d.cpp \
 
@@ -40,6 +41,7 @@ HEADERS += \
   latlon.hpp \
   nearby_points_sweeper.hpp \
   mercator.hpp \
+  packed_rtree.hpp \
   packer.hpp \
   point2d.hpp \
   pointu_to_uint64.hpp \
@@ -50,9 +52,11 @@ HEADERS += \
   region2d.hpp \
   region2d/binary_operators.hpp \
   region2d/boost_concept.hpp \
+  region2d/slab_index.hpp \
   robust_orientation.hpp \
   screenbase.hpp \
   segment2d.hpp \
+  segments_batch.hpp \
   simplification.hpp \
   spline.hpp \
   transformations.hpp \
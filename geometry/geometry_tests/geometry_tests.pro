@@ -33,6 +33,7 @@ SOURCES += \
   latlon_test.cpp \
   nearby_points_sweeper_test.cpp \
   mercator_test.cpp \
+  packed_rtree_test.cpp \
   packer_test.cpp \
   point_test.cpp \
   pointu_to_uint64_test.cpp \
@@ -42,6 +43,7 @@ SOURCES += \
   region_test.cpp \
   robust_test.cpp \
   screen_test.cpp \
+  segments_batch_test.cpp \
   segments_intersect_test.cpp \
   simplification_test.cpp \
   spline_test.cpp \
@@ -0,0 +1,144 @@
+#include "testing/testing.hpp"
+
+#include "geometry/packed_rtree.hpp"
+#include "geometry/rect2d.hpp"
+#include "geometry/tree4d.hpp"
+
+#include "base/logging.hpp"
+#include "base/timer.hpp"
+
+#include "std/algorithm.hpp"
+#include "std/random.hpp"
+#include "std/tuple.hpp"
+#include "std/vector.hpp"
+
+namespace
+{
+using R = m2::RectD;
+
+struct Traits
+{
+  m2::RectD LimitRect(m2::RectD const & r) const { return r; }
+};
+
+using TTree = m4::Tree<R, Traits>;
+using TPackedTree = m4::PackedRTree<R, Traits>;
+
+vector<R> MakeRandomRects(size_t count, mt19937 & rng)
+{
+  uniform_real_distribution<double> coord(0.0, 1000.0);
+  uniform_real_distribution<double> size(0.0, 10.0);
+  vector<R> rects;
+  rects.reserve(count);
+  for (size_t i = 0; i < count; ++i)
+  {
+    double const x = coord(rng);
+    double const y = coord(rng);
+    rects.emplace_back(x, y, x + size(rng), y + size(rng));
+  }
+  return rects;
+}
+
+template <typename Tree>
+vector<R> GetRectsInRect(Tree const & tree, R const & rect)
+{
+  vector<R> result;
+  tree.ForEachInRect(rect, [&result](R const & r) { result.push_back(r); });
+  sort(result.begin(), result.end(), [](R const & lhs, R const & rhs) {
+    return make_tuple(lhs.minX(), lhs.minY(), lhs.maxX(), lhs.maxY()) <
+           make_tuple(rhs.minX(), rhs.minY(), rhs.maxX(), rhs.maxY());
+  });
+  return result;
+}
+
+// Returns time of the queries in seconds.
+template <typename Tree>
+double RunQueries(Tree const & tree, vector<R> const & queries, size_t & found)
+{
+  my::Timer timer;
+  for (auto const & q : queries)
+    tree.ForEachInRect(q, [&found](R const &) { ++found; });
+  return timer.ElapsedSeconds();
+}
+}  // namespace
+
+UNIT_TEST(PackedRTree_Smoke)
+{
+  TPackedTree tree;
+  TEST(tree.IsEmpty(), ());
+  tree.ForEachInRect(R(0, 0, 10, 10), [](R const &) { TEST(false, ()); });
+
+  tree.Build(vector<R>{R(0, 0, 1, 1), R(1, 1, 2, 2), R(2, 2, 3, 3)});
+  TEST_EQUAL(tree.GetSize(), 3, ());
+
+  vector<R> test;
+  tree.ForEach(MakeBackInsertFunctor(test));
+  TEST_EQUAL(test.size(), 3, ());
+
+  test = GetRectsInRect(tree, R(1.5, 1.5, 1.5, 1.5));
+  TEST_EQUAL(test, vector<R>{R(1, 1, 2, 2)}, ());
+
+  // Touching rects don't intersect like in m4::Tree.
+  test = GetRectsInRect(tree, R(3, 3, 4, 4));
+  TEST(test.empty(), ());
+
+  tree.Clear();
+  TEST(tree.IsEmpty(), ());
+}
+
+UNIT_TEST(PackedRTree_SameAsTree4D)
+{
+  mt19937 rng(0);
+  for (size_t const count : {1, 15, 16, 17, 255, 256, 257, 5000})
+  {
+    auto const rects = MakeRandomRects(count, rng);
+
+    TTree tree;
+    for (auto const & r : rects)
+      tree.Add(r);
+    TPackedTree packedTree;
+    packedTree.Build(vector<R>(rects));
+    TEST_EQUAL(packedTree.GetSize(), count, ());
+
+    auto const queries = MakeRandomRects(100, rng);
+    for (auto const & query : queries)
+    {
+      R const inflated(query.minX(), query.minY(), query.maxX() + 50, query.maxY() + 50);
+      TEST_EQUAL(GetRectsInRect(tree, inflated), GetRectsInRect(packedTree, inflated),
+                 (count, inflated));
+    }
+    TEST_EQUAL(GetRectsInRect(tree, R(-1, -1, 2000, 2000)).size(), count, ());
+    TEST_EQUAL(GetRectsInRect(packedTree, R(-1, -1, 2000, 2000)).size(), count, ());
+  }
+}
+
+UNIT_TEST(PackedRTree_Benchmark)
+{
+  size_t const kRectsCount = 100000;
+  size_t const kQueriesCount = 10000;
+
+  mt19937 rng(0);
+  auto const rects = MakeRandomRects(kRectsCount, rng);
+  auto const queries = MakeRandomRects(kQueriesCount, rng);
+
+  my::Timer timer;
+  TTree tree;
+  for (auto const & r : rects)
+    tree.Add(r);
+  double const treeBuildTime = timer.ElapsedSeconds();
+
+  timer.Reset();
+  TPackedTree packedTree;
+  packedTree.Build(vector<R>(rects));
+  double const packedTreeBuildTime = timer.ElapsedSeconds();
+
+  size_t treeFound = 0;
+  double const treeQueryTime = RunQueries(tree, queries, treeFound);
+  size_t packedTreeFound = 0;
+  double const packedTreeQueryTime = RunQueries(packedTree, queries, packedTreeFound);
+  TEST_EQUAL(treeFound, packedTreeFound, ());
+
+  LOG(LINFO, ("m4::Tree build:", treeBuildTime, "s, queries:", treeQueryTime, "s"));
+  LOG(LINFO, ("m4::PackedRTree build:", packedTreeBuildTime, "s, queries:", packedTreeQueryTime,
+              "s"));
+}
@@ -4,6 +4,10 @@
 
 #include "geometry/region2d.hpp"
 
+#include "std/cmath.hpp"
+#include "std/random.hpp"
+#include "std/vector.hpp"
+
 
 namespace {
 
@@ -261,3 +265,58 @@ UNIT_TEST(Region_border_intersecion_Test)
 
   TEST(!region.FindIntersection(P(5.0, 5.0), P(2.0, 2.0), intersection), ("This case has no intersection"));
 }
+
+namespace
+{
+// Star-shaped polygon with a lot of vertices, so Contains() uses an index.
+template <class TRegion, class TEqualF>
+void TestContainsLargeRegion(TEqualF equalF)
+{
+  using P = typename TRegion::ValueT;
+
+  mt19937 rng(0);
+  uniform_int_distribution<int> radius(500, 1000);
+  uniform_int_distribution<int> coord(-1100, 1100);
+
+  size_t const count = 1000;
+  vector<P> points;
+  for (size_t i = 0; i < count; ++i)
+  {
+    double const angle = 2 * math::pi * i / count;
+    int const r = radius(rng);
+    points.emplace_back(2000 + static_cast<int>(r * cos(angle)),
+                        2000 + static_cast<int>(r * sin(angle)));
+  }
+
+  TRegion region(points.begin(), points.end());
+  auto const check = [&](TRegion const & region, P const & pt)
+  {
+    TEST_EQUAL(region.Contains(pt), region.Contains(pt, equalF), (pt));
+  };
+
+  for (size_t i = 0; i < count; ++i)
+  {
+    TEST(region.Contains(points[i]), (points[i]));
+    check(region, (points[i] + points[(i + 1) % count]) / 2);
+  }
+
+  for (size_t i = 0; i < 10000; ++i)
+    check(region, P(2000 + coord(rng), 2000 + coord(rng)));
+
+  // A copy shares the index, a changed region rebuilds it.
+  TRegion copy = region;
+  check(copy, P(2000, 2000));
+  copy.AddPoint(P(4000, 4000));
+  TEST(copy.Contains(P(4000, 4000)), ());
+  TEST(!region.Contains(P(4000, 4000)), ());
+  for (size_t i = 0; i < 1000; ++i)
+    check(copy, P(2000 + 2 * coord(rng), 2000 + 2 * coord(rng)));
+}
+}  // namespace
+
+UNIT_TEST(Region_Contains_LargeRegion)
+{
+  TestContainsLargeRegion<m2::RegionI>(m2::detail::DefEqualInt());
+  TestContainsLargeRegion<m2::RegionU>(m2::detail::DefEqualInt());
+  TestContainsLargeRegion<m2::RegionD>(m2::detail::DefEqualFloat());
+}
@@ -0,0 +1,123 @@
+#include "testing/testing.hpp"
+
+#include "geometry/distance.hpp"
+#include "geometry/point2d.hpp"
+#include "geometry/segments_batch.hpp"
+
+#include "base/math.hpp"
+
+#include "std/limits.hpp"
+#include "std/random.hpp"
+#include "std/vector.hpp"
+
+using namespace m2;
+
+namespace
+{
+double constexpr kEps = 1e-9;
+
+void TestEqualToSections(SegmentsBatch const & batch, PointD const & p)
+{
+  vector<double> distances;
+  batch.GetDistancesSquare(p, distances);
+  vector<PointD> projections;
+  batch.GetProjections(p, projections);
+  TEST_EQUAL(distances.size(), batch.Size(), ());
+  TEST_EQUAL(projections.size(), batch.Size(), ());
+
+  size_t expectedIndex = batch.Size();
+  double expectedDist = numeric_limits<double>::max();
+  for (size_t i = 0; i < batch.Size(); ++i)
+  {
+    DistanceToLineSquare<PointD> distance;
+    distance.SetBounds(batch.GetP0(i), batch.GetP1(i));
+    ProjectionToSection<PointD> projection;
+    projection.SetBounds(batch.GetP0(i), batch.GetP1(i));
+
+    double const d = distance(p);
+    TEST(my::AlmostEqualAbs(distances[i], d, kEps), (i, distances[i], d));
+    TEST(projections[i].EqualDxDy(projection(p), kEps), (i, projections[i], projection(p)));
+
+    if (distances[i] < expectedDist)
+    {
+      expectedDist = distances[i];
+      expectedIndex = i;
+    }
+  }
+
+  PointD proj;
+  double dist;
+  TEST_EQUAL(batch.FindNearest(p, proj, dist), expectedIndex, ());
+  if (expectedIndex == batch.Size())
+    return;
+  TEST_EQUAL(dist, expectedDist, ());
+  TEST_EQUAL(proj, projections[expectedIndex], ());
+}
+
+UNIT_TEST(SegmentsBatch_Smoke)
+{
+  SegmentsBatch batch;
+  TEST(batch.IsEmpty(), ());
+
+  PointD proj;
+  double dist;
+  TEST_EQUAL(batch.FindNearest(PointD(0, 0), proj, dist), 0, ());
+
+  batch.Add(PointD(0, 0), PointD(10, 0));
+  batch.Add(PointD(10, 0), PointD(10, 10));
+  TEST_EQUAL(batch.Size(), 2, ());
+
+  TEST_EQUAL(batch.FindNearest(PointD(5, 1), proj, dist), 0, ());
+  TEST_EQUAL(proj, PointD(5, 0), ());
+  TEST(my::AlmostEqualAbs(dist, 1.0, kEps), (dist));
+
+  TEST_EQUAL(batch.FindNearest(PointD(12, 7), proj, dist), 1, ());
+  TEST_EQUAL(proj, PointD(10, 7), ());
+  TEST(my::AlmostEqualAbs(dist, 4.0, kEps), (dist));
+
+  // Projections to ends of segments.
+  TEST_EQUAL(batch.FindNearest(PointD(-3, -4), proj, dist), 0, ());
+  TEST_EQUAL(proj, PointD(0, 0), ());
+  TEST(my::AlmostEqualAbs(dist, 25.0, kEps), (dist));
+
+  batch.Clear();
+  TEST(batch.IsEmpty(), ());
+}
+
+UNIT_TEST(SegmentsBatch_Polyline)
+{
+  TEST(SegmentsBatch(vector<PointD>{}).IsEmpty(), ());
+  TEST(SegmentsBatch(vector<PointD>{PointD(1, 1)}).IsEmpty(), ());
+
+  vector<PointD> const points = {PointD(0, 0), PointD(1, 1), PointD(1, 1), PointD(3, 0)};
+  SegmentsBatch const batch(points);
+  TEST_EQUAL(batch.Size(), points.size() - 1, ());
+  for (size_t i = 0; i < batch.Size(); ++i)
+  {
+    TEST_EQUAL(batch.GetP0(i), points[i], ());
+    TEST_EQUAL(batch.GetP1(i), points[i + 1], ());
+  }
+
+  // The degenerate segment is a point.
+  TestEqualToSections(batch, PointD(1, 2));
+  TestEqualToSections(batch, PointD(2, 2));
+  TestEqualToSections(batch, PointD(-1, 0));
+}
+
+UNIT_TEST(SegmentsBatch_Random)
+{
+  mt19937 rng(0);
+  uniform_real_distribution<double> coord(-100.0, 100.0);
+
+  // More segments than a block of the kernels.
+  SegmentsBatch batch;
+  for (size_t i = 0; i < 1000; ++i)
+  {
+    PointD const p0(coord(rng), coord(rng));
+    batch.Add(p0, p0 + PointD(coord(rng), coord(rng)) / 10.0);
+  }
+
+  for (size_t i = 0; i < 100; ++i)
+    TestEqualToSections(batch, PointD(coord(rng), coord(rng)));
+}
+}  // namespace
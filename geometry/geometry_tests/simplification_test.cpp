@@ -12,6 +12,7 @@
 #include "base/stl_add.hpp"
 
 #include "std/limits.hpp"
+#include "std/random.hpp"
 #include "std/vector.hpp"
 
 namespace
@@ -166,6 +167,85 @@ UNIT_TEST(Simpfication_DP_DegenerateTrg)
   CheckDPStrict(arr2, ARRAY_SIZE(arr2), 1.0, 4);
 }
 
+namespace
+{
+vector<double> const kEpsilons = {0.00001, 0.0001, 0.001, 0.01, 0.1};
+
+// Collects simplifications for every epsilon.
+struct EpsilonsOutput
+{
+  explicit EpsilonsOutput(vector<vector<P>> & results) : m_results(results) {}
+
+  void operator()(size_t epsilonIndex, P const & p) { m_results[epsilonIndex].push_back(p); }
+
+  vector<vector<P>> & m_results;
+};
+
+template <typename SimplifyFn>
+void TestForEpsilons(P const * points, size_t count, SimplifyFn simplifyFn,
+                     vector<vector<P>> const & results)
+{
+  TEST_EQUAL(results.size(), kEpsilons.size(), ());
+  for (size_t e = 0; e < kEpsilons.size(); ++e)
+  {
+    vector<P> expected;
+    simplifyFn(points, points + count, kEpsilons[e], DistanceF(), MakeBackInsertFunctor(expected));
+    TEST_EQUAL(results[e], expected, (kEpsilons[e]));
+  }
+}
+}  // namespace
+
+UNIT_TEST(Simplification_DP_ForEpsilons)
+{
+  P const * points = LargePolylineTestData::m_Data;
+  size_t const count = LargePolylineTestData::m_Size;
+
+  vector<vector<P>> results(kEpsilons.size());
+  SimplifyDPForEpsilons(points, points + count, kEpsilons, DistanceF(), EpsilonsOutput(results));
+  TestForEpsilons(points, count, &SimplifyDP<DistanceF, P const *, PointOutput>, results);
+}
+
+UNIT_TEST(Simplification_Opt_ForEpsilons)
+{
+  P const * points = LargePolylineTestData::m_Data;
+  size_t const count = LargePolylineTestData::m_Size;
+
+  vector<vector<P>> results(kEpsilons.size());
+  SimplifyNearOptimalForEpsilons(20, points, points + count, kEpsilons, DistanceF(),
+                                 EpsilonsOutput(results));
+  TestForEpsilons(points, count, &SimplifyNearOptimal20, results);
+
+  // Lines are kept as is.
+  for (auto & result : results)
+    result.clear();
+  SimplifyNearOptimalForEpsilons(20, points, points + 2, kEpsilons, DistanceF(),
+                                 EpsilonsOutput(results));
+  TestForEpsilons(points, 2, &SimplifyNearOptimal20, results);
+}
+
+UNIT_TEST(Simplification_DP_Parallel)
+{
+  // Random walk which is long enough to be split between threads.
+  mt19937 rng(0);
+  uniform_real_distribution<double> step(-1.0, 1.0);
+  vector<P> points = {P(0.0, 0.0)};
+  for (size_t i = 0; i < 100000; ++i)
+    points.push_back(points.back() + P(step(rng), step(rng)));
+
+  for (double epsilon : {0.01, 1.0, 100.0})
+  {
+    vector<P> expected;
+    SimplifyDP(points.begin(), points.end(), epsilon, DistanceF(), MakeBackInsertFunctor(expected));
+    for (size_t threadsCount : {1, 2, 4})
+    {
+      vector<P> result;
+      SimplifyDPParallel(threadsCount, points.begin(), points.end(), epsilon, DistanceF(),
+                         MakeBackInsertFunctor(result));
+      TEST_EQUAL(result, expected, (epsilon, threadsCount));
+    }
+  }
+}
+
 #include "geometry/geometry_tests/large_polygon.hpp"
 
 m2::PointD const * LargePolylineTestData::m_Data = LargePolygon::kLargePolygon;
@@ -0,0 +1,260 @@
+#pragma once
+
+#include "geometry/rect2d.hpp"
+#include "geometry/tree4d.hpp"
+
+#include "base/assert.hpp"
+
+#include "std/algorithm.hpp"
+#include "std/cmath.hpp"
+#include "std/cstdint.hpp"
+#include "std/utility.hpp"
+#include "std/vector.hpp"
+
+namespace m4
+{
+// Static R-tree which is bulk loaded by Sort-Tile-Recursive algorithm. Values and nodes are kept
+// in two contiguous arrays: leaves go first, the root is the last node. A node covers
+// a contiguous range of values or child nodes. Queries are answered by a traversal with
+// an explicit stack.
+//
+// The tree can't be modified after it's built. It has the same query interface as m4::Tree,
+// and the same rect intersection semantics, so static data sets may switch to it.
+template <class T, typename Traits = TraitsDef<T>, size_t kNodeCapacity = 16>
+class PackedRTree
+{
+  static_assert(kNodeCapacity >= 2, "");
+
+public:
+  using elem_t = T;
+
+  PackedRTree(Traits const & traits = Traits()) : m_traits(traits) {}
+
+  explicit PackedRTree(vector<T> && values, Traits const & traits = Traits()) : m_traits(traits)
+  {
+    Build(move(values));
+  }
+
+  // Replaces the content of the tree by |values|.
+  void Build(vector<T> && values)
+  {
+    vector<pair<T, m2::RectD>> items;
+    items.reserve(values.size());
+    for (auto & value : values)
+    {
+      m2::RectD const rect = m_traits.LimitRect(value);
+      items.emplace_back(move(value), rect);
+    }
+    Build(move(items));
+  }
+
+  // Replaces the content of the tree by values with their rects.
+  void Build(vector<pair<T, m2::RectD>> && items)
+  {
+    Clear();
+    if (items.empty())
+      return;
+
+    m_values.reserve(items.size());
+    for (auto & item : items)
+      m_values.emplace_back(move(item.first), item.second);
+
+    // Leaves.
+    vector<Node> level;
+    SortTileRecursive(m_values, level);
+    m_leavesCount = level.size();
+
+    // Internal levels. Children of a level are sorted before its nodes are made, so every node
+    // covers a contiguous range of the previous level.
+    uint32_t levelOffset = 0;
+    while (level.size() > 1)
+    {
+      vector<Node> upper;
+      SortTileRecursive(level, upper);
+      for (auto & node : upper)
+        node.m_first += levelOffset;
+
+      levelOffset += static_cast<uint32_t>(level.size());
+      m_nodes.insert(m_nodes.end(), level.begin(), level.end());
+      level.swap(upper);
+    }
+    m_nodes.insert(m_nodes.end(), level.begin(), level.end());
+  }
+
+  template <class ToDo>
+  void ForEach(ToDo && toDo) const
+  {
+    for (auto const & v : m_values)
+      toDo(v.m_val);
+  }
+
+  template <class ToDo>
+  void ForEachEx(ToDo && toDo) const
+  {
+    for (auto const & v : m_values)
+      toDo(v.GetRect(), v.m_val);
+  }
+
+  template <class ToDo>
+  bool FindNode(ToDo && toDo) const
+  {
+    for (auto const & v : m_values)
+    {
+      if (toDo(v.m_val))
+        return true;
+    }
+    return false;
+  }
+
+  template <class ToDo>
+  void ForEachInRect(m2::RectD const & rect, ToDo && toDo) const
+  {
+    ForEachValueInRect(rect, [&toDo](Value const & v) { toDo(v.m_val); });
+  }
+
+  template <class ToDo>
+  void ForEachInRectEx(m2::RectD const & rect, ToDo && toDo) const
+  {
+    ForEachValueInRect(rect, [&toDo](Value const & v) { toDo(v.GetRect(), v.m_val); });
+  }
+
+  bool IsEmpty() const { return m_values.empty(); }
+  size_t GetSize() const { return m_values.size(); }
+
+  void Clear()
+  {
+    m_values.clear();
+    m_nodes.clear();
+    m_leavesCount = 0;
+  }
+
+private:
+  struct Box
+  {
+    Box() = default;
+    explicit Box(m2::RectD const & r)
+    {
+      m_pts[0] = r.minX();
+      m_pts[1] = r.minY();
+      m_pts[2] = r.maxX();
+      m_pts[3] = r.maxY();
+    }
+
+    // Same as IsIntersect() of m4::Tree: touching rects don't intersect.
+    bool IsIntersect(m2::RectD const & r) const
+    {
+      return !((m_pts[2] <= r.minX()) || (m_pts[0] >= r.maxX()) || (m_pts[3] <= r.minY()) ||
+               (m_pts[1] >= r.maxY()));
+    }
+
+    void Add(Box const & b)
+    {
+      m_pts[0] = min(m_pts[0], b.m_pts[0]);
+      m_pts[1] = min(m_pts[1], b.m_pts[1]);
+      m_pts[2] = max(m_pts[2], b.m_pts[2]);
+      m_pts[3] = max(m_pts[3], b.m_pts[3]);
+    }
+
+    double CenterX() const { return (m_pts[0] + m_pts[2]) / 2; }
+    double CenterY() const { return (m_pts[1] + m_pts[3]) / 2; }
+
+    m2::RectD GetRect() const { return m2::RectD(m_pts[0], m_pts[1], m_pts[2], m_pts[3]); }
+
+    double m_pts[4];
+  };
+
+  struct Value
+  {
+    Value(T && t, m2::RectD const & r) : m_box(r), m_val(move(t)) {}
+
+    Box const & GetBox() const { return m_box; }
+    m2::RectD GetRect() const { return m_box.GetRect(); }
+
+    Box m_box;
+    T m_val;
+  };
+
+  struct Node
+  {
+    Box const & GetBox() const { return m_box; }
+
+    Box m_box;
+    // Range of values for leaves or range of nodes for internal nodes.
+    uint32_t m_first = 0;
+    uint32_t m_count = 0;
+  };
+
+  // Sorts |items| by Sort-Tile-Recursive and packs them to |nodes| by kNodeCapacity items.
+  template <typename Item>
+  static void SortTileRecursive(vector<Item> & items, vector<Node> & nodes)
+  {
+    size_t const count = items.size();
+    size_t const nodesCount = (count + kNodeCapacity - 1) / kNodeCapacity;
+    auto const slicesCount = static_cast<size_t>(ceil(sqrt(static_cast<double>(nodesCount))));
+    size_t const sliceSize = slicesCount * kNodeCapacity;
+
+    sort(items.begin(), items.end(), [](Item const & lhs, Item const & rhs) {
+      return lhs.GetBox().CenterX() < rhs.GetBox().CenterX();
+    });
+    for (size_t i = 0; i < count; i += sliceSize)
+    {
+      sort(items.begin() + i, items.begin() + min(i + sliceSize, count),
+           [](Item const & lhs, Item const & rhs) {
+             return lhs.GetBox().CenterY() < rhs.GetBox().CenterY();
+           });
+    }
+
+    nodes.clear();
+    nodes.reserve(nodesCount);
+    for (size_t i = 0; i < count; i += kNodeCapacity)
+    {
+      Node node;
+      node.m_first = static_cast<uint32_t>(i);
+      node.m_count = static_cast<uint32_t>(min(kNodeCapacity, count - i));
+      node.m_box = items[i].GetBox();
+      for (size_t j = i + 1; j < i + node.m_count; ++j)
+        node.m_box.Add(items[j].GetBox());
+      nodes.push_back(node);
+    }
+  }
+
+  template <class ToDo>
+  void ForEachValueInRect(m2::RectD const & rect, ToDo && toDo) const
+  {
+    if (m_nodes.empty())
+      return;
+
+    // Depth of the tree is logarithmic, so the stack is short.
+    vector<uint32_t> stack;
+    stack.push_back(static_cast<uint32_t>(m_nodes.size() - 1));
+    while (!stack.empty())
+    {
+      Node const & node = m_nodes[stack.back()];
+      bool const isLeaf = stack.back() < m_leavesCount;
+      stack.pop_back();
+
+      if (!node.m_box.IsIntersect(rect))
+        continue;
+
+      if (isLeaf)
+      {
+        for (uint32_t i = node.m_first; i < node.m_first + node.m_count; ++i)
+        {
+          Value const & v = m_values[i];
+          if (v.m_box.IsIntersect(rect))
+            toDo(v);
+        }
+        continue;
+      }
+
+      for (uint32_t i = node.m_first; i < node.m_first + node.m_count; ++i)
+        stack.push_back(i);
+    }
+  }
+
+  Traits m_traits;
+  vector<Value> m_values;
+  vector<Node> m_nodes;
+  size_t m_leavesCount = 0;
+};
+}  // namespace m4
@@ -3,11 +3,13 @@
 #include "geometry/point2d.hpp"
 #include "geometry/rect2d.hpp"
 #include "geometry/distance.hpp"
+#include "geometry/region2d/slab_index.hpp"
 
 #include "base/math.hpp"
 
 #include "std/vector.hpp"
 #include "std/algorithm.hpp"
+#include "std/shared_ptr.hpp"
 #include "std/type_traits.hpp"
 
 
@@ -90,6 +92,10 @@ namespace m2
   private:
     typedef vector<PointT> ContainerT;
     typedef detail::TraitsType<is_floating_point<CoordT>::value> TraitsT;
+    typedef detail::RegionSlabIndex<PointT> IndexT;
+
+    // Contains() for regions with more points uses an index, which is built by the first query.
+    static size_t constexpr kMinPointsForIndex = 64;
 
   public:
     /// @name Needed for boost region concept.
@@ -136,6 +142,7 @@ namespace m2
     {
       m_points.push_back(pt);
       m_rect.Add(pt);
+      m_index.Reset();
     }
 
     template <class TFunctor>
@@ -152,6 +159,8 @@ namespace m2
     {
       m_points.swap(rhs.m_points);
       std::swap(m_rect, rhs.m_rect);
+      m_index.Reset();
+      rhs.m_index.Reset();
     }
 
     ContainerT const & Data() const { return m_points; }
@@ -199,9 +208,6 @@ namespace m2
 
       size_t const numPoints = m_points.size();
 
-      typedef typename TraitsT::BigType BigCoordT;
-      typedef Point<BigCoordT> BigPointT;
-
       BigPointT prev = BigPointT(m_points[numPoints - 1]) - BigPointT(pt);
       for (size_t i = 0; i < numPoints; ++i)
       {
@@ -209,47 +215,47 @@ namespace m2
           return true;
 
         BigPointT const curr = BigPointT(m_points[i]) - BigPointT(pt);
-
-        bool const rCheck = ((curr.y > 0) != (prev.y > 0));
-        bool const lCheck = ((curr.y < 0) != (prev.y < 0));
-
-        if (rCheck || lCheck)
-        {
-          ASSERT_NOT_EQUAL ( curr.y, prev.y, () );
-
-          BigCoordT const delta = prev.y - curr.y;
-          BigCoordT const cp = CrossProduct(curr, prev);
-
-          // Squared precision is needed here because of comparison between cross product of two
-          // vectors and zero. It's impossible to compare them relatively, so they're compared
-          // absolutely, and, as cross product is proportional to product of lengths of both
-          // operands precision must be squared too.
-          if (!equalF.EqualZeroSquarePrecision(cp))
-          {
-            bool const PrevGreaterCurr = delta > 0.0;
-
-            if (rCheck && ((cp > 0) == PrevGreaterCurr)) ++rCross;
-            if (lCheck && ((cp > 0) != PrevGreaterCurr)) ++lCross;
-          }
-        }
-
+        CountCrossings(prev, curr, equalF, rCross, lCross);
         prev = curr;
       }
 
-      /* q on the edge if left and right cross are not the same parity. */
-      if ((rCross & 1) != (lCross & 1))
-        return true;  // on the edge
-
-      /* q inside if an odd number of crossings. */
-      if (rCross & 1)
-        return true;  // inside
-      else
-        return false; // outside
+      return IsInside(rCross, lCross);
     }
 
+    /// Same as Contains(pt, equalF) with default precision. Only edges which may cross
+    /// the horizontal line through |pt| are checked for large regions.
     bool Contains(PointT const & pt) const
     {
-      return Contains(pt, typename TraitsT::EqualType());
+      typename TraitsT::EqualType equalF;
+      shared_ptr<IndexT const> const index = GetIndex();
+      if (!index)
+        return Contains(pt, equalF);
+
+      if (!m_rect.IsPointInside(pt))
+        return false;
+
+      int rCross = 0;
+      int lCross = 0;
+      bool atPoint = false;
+
+      size_t const numPoints = m_points.size();
+      index->ForEachEdge(static_cast<double>(pt.y), [&](size_t i)
+      {
+        if (atPoint)
+          return;
+
+        if (equalF.EqualPoints(m_points[i], pt))
+        {
+          atPoint = true;
+          return;
+        }
+
+        BigPointT const prev = BigPointT(m_points[i == 0 ? numPoints - 1 : i - 1]) - BigPointT(pt);
+        BigPointT const curr = BigPointT(m_points[i]) - BigPointT(pt);
+        CountCrossings(prev, curr, equalF, rCross, lCross);
+      });
+
+      return atPoint || IsInside(rCross, lCross);
     }
 
     /// Finds point of intersection with the section.
@@ -303,15 +309,79 @@ namespace m2
     }
 
   private:
+    typedef typename TraitsT::BigType BigCoordT;
+    typedef Point<BigCoordT> BigPointT;
+
+    template <class TEqualF>
+    static void CountCrossings(BigPointT const & prev, BigPointT const & curr, TEqualF equalF,
+                               int & rCross, int & lCross)
+    {
+      bool const rCheck = ((curr.y > 0) != (prev.y > 0));
+      bool const lCheck = ((curr.y < 0) != (prev.y < 0));
+
+      if (rCheck || lCheck)
+      {
+        ASSERT_NOT_EQUAL ( curr.y, prev.y, () );
+
+        BigCoordT const delta = prev.y - curr.y;
+        BigCoordT const cp = CrossProduct(curr, prev);
+
+        // Squared precision is needed here because of comparison between cross product of two
+        // vectors and zero. It's impossible to compare them relatively, so they're compared
+        // absolutely, and, as cross product is proportional to product of lengths of both
+        // operands precision must be squared too.
+        if (!equalF.EqualZeroSquarePrecision(cp))
+        {
+          bool const PrevGreaterCurr = delta > 0.0;
+
+          if (rCheck && ((cp > 0) == PrevGreaterCurr)) ++rCross;
+          if (lCheck && ((cp > 0) != PrevGreaterCurr)) ++lCross;
+        }
+      }
+    }
+
+    static bool IsInside(int rCross, int lCross)
+    {
+      /* q on the edge if left and right cross are not the same parity. */
+      if ((rCross & 1) != (lCross & 1))
+        return true;  // on the edge
+
+      /* q inside if an odd number of crossings. */
+      if (rCross & 1)
+        return true;  // inside
+      else
+        return false; // outside
+    }
+
+    shared_ptr<IndexT const> GetIndex() const
+    {
+      if (m_points.size() < kMinPointsForIndex)
+        return shared_ptr<IndexT const>();
+
+      // Points may be changed without a reset of the index only by a move from the region.
+      shared_ptr<IndexT const> index = m_index.Get();
+      if (!index || index->GetPointsCount() != m_points.size())
+      {
+        // Vertices are compared with precision, so edges are extended by it.
+        double const margin =
+            is_floating_point<CoordT>::value ? 2 * detail::DefEqualFloat::kPrecision : 0.0;
+        index = make_shared<IndexT const>(m_points, margin);
+        m_index.Set(index);
+      }
+      return index;
+    }
+
     void CalcLimitRect()
     {
       m_rect.MakeEmpty();
       for (size_t i = 0; i < m_points.size(); ++i)
         m_rect.Add(m_points[i]);
+      m_index.Reset();
     }
 
     ContainerT m_points;
     m2::Rect<CoordT> m_rect;
+    detail::LazyIndexHolder<IndexT> m_index;
 
     template <class T> friend string DebugPrint(Region<T> const &);
   };
@@ -327,6 +397,7 @@ namespace m2
   {
     ar >> region.m_rect;
     ar >> region.m_points;
+    region.m_index.Reset();
     return ar;
   }
 
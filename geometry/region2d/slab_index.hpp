@@ -0,0 +1,140 @@
+#pragma once
+
+#include "base/assert.hpp"
+
+#include "std/algorithm.hpp"
+#include "std/cmath.hpp"
+#include "std/cstdint.hpp"
+#include "std/shared_ptr.hpp"
+#include "std/vector.hpp"
+
+namespace m2
+{
+namespace detail
+{
+// Horizontal slabs of a polygon. Every slab keeps edges whose y-ranges (extended by |margin|)
+// intersect the slab, so a horizontal line y = const crosses only edges of its slab.
+// Edge i goes from point i - 1 (the last point for i == 0) to point i.
+template <class PointT>
+class RegionSlabIndex
+{
+public:
+  RegionSlabIndex(vector<PointT> const & points, double margin) : m_pointsCount(points.size())
+  {
+    ASSERT(!points.empty(), ());
+
+    m_minY = m_maxY = static_cast<double>(points[0].y);
+    for (auto const & p : points)
+    {
+      m_minY = min(m_minY, static_cast<double>(p.y));
+      m_maxY = max(m_maxY, static_cast<double>(p.y));
+    }
+
+    // Long edges go to many slabs, so the number of slabs is decreased until memory is linear.
+    size_t slabsCount = max(m_pointsCount / kPointsPerSlab, static_cast<size_t>(1));
+    while (!Build(points, margin, slabsCount))
+      slabsCount /= 2;
+  }
+
+  size_t GetPointsCount() const { return m_pointsCount; }
+
+  // Calls |toDo| for every edge which may be crossed by the line through |y|.
+  template <class ToDo>
+  void ForEachEdge(double y, ToDo && toDo) const
+  {
+    size_t const slab = GetSlab(y);
+    for (uint32_t i = m_offsets[slab]; i < m_offsets[slab + 1]; ++i)
+      toDo(m_edges[i]);
+  }
+
+private:
+  static size_t constexpr kPointsPerSlab = 8;
+  static size_t constexpr kMaxEdgesPerPoint = 8;
+
+  // Returns false when edges need more memory than it's allowed.
+  bool Build(vector<PointT> const & points, double margin, size_t slabsCount)
+  {
+    m_scale = m_maxY > m_minY ? slabsCount / (m_maxY - m_minY) : 0.0;
+    m_offsets.assign(slabsCount + 1, 0);
+
+    size_t total = 0;
+    ForEachSlabRange(points, margin, [&](size_t /* edge */, size_t from, size_t to)
+    {
+      total += to - from + 1;
+      for (size_t slab = from; slab <= to; ++slab)
+        ++m_offsets[slab + 1];
+    });
+
+    if (slabsCount > 1 && total > kMaxEdgesPerPoint * m_pointsCount)
+      return false;
+
+    for (size_t slab = 0; slab < slabsCount; ++slab)
+      m_offsets[slab + 1] += m_offsets[slab];
+
+    m_edges.resize(total);
+    vector<uint32_t> pos(m_offsets.begin(), m_offsets.end() - 1);
+    ForEachSlabRange(points, margin, [&](size_t edge, size_t from, size_t to)
+    {
+      for (size_t slab = from; slab <= to; ++slab)
+        m_edges[pos[slab]++] = static_cast<uint32_t>(edge);
+    });
+    return true;
+  }
+
+  template <class ToDo>
+  void ForEachSlabRange(vector<PointT> const & points, double margin, ToDo && toDo) const
+  {
+    double prevY = static_cast<double>(points.back().y);
+    for (size_t i = 0; i < points.size(); ++i)
+    {
+      double const currY = static_cast<double>(points[i].y);
+      toDo(i, GetSlab(min(prevY, currY) - margin), GetSlab(max(prevY, currY) + margin));
+      prevY = currY;
+    }
+  }
+
+  // Slab of |y| is monotonic by |y|, so an edge which contains |y| in its y-range always
+  // belongs to the slab of |y|.
+  size_t GetSlab(double y) const
+  {
+    size_t const lastSlab = m_offsets.size() - 2;
+    double const slab = floor((y - m_minY) * m_scale);
+    if (slab <= 0)
+      return 0;
+    if (slab >= lastSlab)
+      return lastSlab;
+    return static_cast<size_t>(slab);
+  }
+
+  size_t m_pointsCount;
+  double m_minY;
+  double m_maxY;
+  double m_scale = 0.0;
+  vector<uint32_t> m_offsets;
+  vector<uint32_t> m_edges;
+};
+
+// Keeps a lazily built index of a region. Copies share the index, and it may be set
+// from const methods of concurrent readers.
+template <class IndexT>
+class LazyIndexHolder
+{
+public:
+  LazyIndexHolder() = default;
+  LazyIndexHolder(LazyIndexHolder const & rhs) : m_index(rhs.Get()) {}
+
+  LazyIndexHolder & operator=(LazyIndexHolder const & rhs)
+  {
+    Set(rhs.Get());
+    return *this;
+  }
+
+  shared_ptr<IndexT const> Get() const { return std::atomic_load(&m_index); }
+  void Set(shared_ptr<IndexT const> index) const { std::atomic_store(&m_index, move(index)); }
+  void Reset() { Set(shared_ptr<IndexT const>()); }
+
+private:
+  mutable shared_ptr<IndexT const> m_index;
+};
+}  // namespace detail
+}  // namespace m2
@@ -0,0 +1,127 @@
+#include "geometry/segments_batch.hpp"
+
+#include "base/math.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace std;
+
+namespace
+{
+// Segments are processed by blocks which fit to stack buffers.
+size_t constexpr kBlockSize = 64;
+}  // namespace
+
+namespace m2
+{
+SegmentsBatch::SegmentsBatch(vector<PointD> const & points)
+{
+  if (points.size() < 2)
+    return;
+
+  for (size_t i = 0; i + 1 < points.size(); ++i)
+    Add(points[i], points[i + 1]);
+}
+
+void SegmentsBatch::Add(PointD const & p0, PointD const & p1)
+{
+  // The same as CalculatedSection::SetBounds().
+  PointD d = p1 - p0;
+  double const length = sqrt(DotProduct(d, d));
+  if (my::AlmostEqualULPs(length, 0.0))
+    d = PointD::Zero();
+  else
+    d = d / length;
+
+  m_x0.push_back(p0.x);
+  m_y0.push_back(p0.y);
+  m_x1.push_back(p1.x);
+  m_y1.push_back(p1.y);
+  m_dx.push_back(d.x);
+  m_dy.push_back(d.y);
+  m_length.push_back(length);
+}
+
+void SegmentsBatch::Clear()
+{
+  m_x0.clear();
+  m_y0.clear();
+  m_x1.clear();
+  m_y1.clear();
+  m_dx.clear();
+  m_dy.clear();
+  m_length.clear();
+}
+
+template <typename ToDo>
+void SegmentsBatch::ForEachProjection(PointD const & p, ToDo && toDo) const
+{
+  // Results are computed to local buffers, so the compiler knows they don't alias segments.
+  double projX[kBlockSize];
+  double projY[kBlockSize];
+  double distSquare[kBlockSize];
+
+  double const x = p.x;
+  double const y = p.y;
+
+  size_t const n = Size();
+  for (size_t first = 0; first < n; first += kBlockSize)
+  {
+    size_t const count = min(kBlockSize, n - first);
+    double const * x0 = m_x0.data() + first;
+    double const * y0 = m_y0.data() + first;
+    double const * dx = m_dx.data() + first;
+    double const * dy = m_dy.data() + first;
+    double const * length = m_length.data() + first;
+
+    // The same as ProjectionToSection::operator(), but the parameter of the projection is
+    // clamped to the segment instead of branching, so the loop is vectorized. For points beyond
+    // ends results differ from the ends by rounding errors only.
+    for (size_t i = 0; i < count; ++i)
+    {
+      double const t = dx[i] * (x - x0[i]) + dy[i] * (y - y0[i]);
+      double const positive = t > 0 ? t : 0;
+      double const clamped = positive < length[i] ? positive : length[i];
+      double const px = dx[i] * clamped + x0[i];
+      double const py = dy[i] * clamped + y0[i];
+      projX[i] = px;
+      projY[i] = py;
+      distSquare[i] = (x - px) * (x - px) + (y - py) * (y - py);
+    }
+
+    for (size_t i = 0; i < count; ++i)
+      toDo(first + i, projX[i], projY[i], distSquare[i]);
+  }
+}
+void SegmentsBatch::GetDistancesSquare(PointD const & p, vector<double> & distances) const
+{
+  distances.resize(Size());
+  ForEachProjection(p, [&distances](size_t i, double /* projX */, double /* projY */,
+                                    double distSquare) { distances[i] = distSquare; });
+}
+
+void SegmentsBatch::GetProjections(PointD const & p, vector<PointD> & projections) const
+{
+  projections.resize(Size());
+  ForEachProjection(p, [&projections](size_t i, double projX, double projY,
+                                      double /* distSquare */) {
+    projections[i] = PointD(projX, projY);
+  });
+}
+
+size_t SegmentsBatch::FindNearest(PointD const & p, PointD & proj, double & distSquare) const
+{
+  size_t best = Size();
+  ForEachProjection(p, [&](size_t i, double projX, double projY, double dist) {
+    if (best == Size() || dist < distSquare)
+    {
+      best = i;
+      proj = PointD(projX, projY);
+      distSquare = dist;
+    }
+  });
+  return best;
+}
+
+}  // namespace m2
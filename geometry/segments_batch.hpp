@@ -0,0 +1,62 @@
+#pragma once
+
+#include "geometry/point2d.hpp"
+
+#include <cstddef>
+#include <vector>
+
+namespace m2
+{
+// Segments in structure-of-arrays layout. Distances and projections from a point to all
+// segments are computed by branchless loops over contiguous arrays, which compilers
+// vectorize. Results are the same as of DistanceToLineSquare and ProjectionToSection
+// for every segment up to rounding errors.
+class SegmentsBatch
+{
+public:
+  SegmentsBatch() = default;
+  // Makes segments of the polyline |points|.
+  explicit SegmentsBatch(std::vector<PointD> const & points);
+
+  void Add(PointD const & p0, PointD const & p1);
+  void Clear();
+
+  size_t Size() const { return m_x0.size(); }
+  bool IsEmpty() const { return m_x0.empty(); }
+  // Returns the number of bytes allocated for the segments.
+  size_t GetMemorySize() const
+  {
+    return (m_x0.capacity() + m_y0.capacity() + m_x1.capacity() + m_y1.capacity() +
+            m_dx.capacity() + m_dy.capacity() + m_length.capacity()) *
+           sizeof(double);
+  }
+
+  PointD GetP0(size_t i) const { return PointD(m_x0[i], m_y0[i]); }
+  PointD GetP1(size_t i) const { return PointD(m_x1[i], m_y1[i]); }
+
+  // Fills |distances| by squared distances from |p| to segments.
+  void GetDistancesSquare(PointD const & p, std::vector<double> & distances) const;
+
+  // Fills |projections| by nearest to |p| points of segments.
+  void GetProjections(PointD const & p, std::vector<PointD> & projections) const;
+
+  // Returns index of the nearest to |p| segment, and its nearest point and squared distance.
+  // The first one of equally near segments is returned. Returns Size() when there are
+  // no segments.
+  size_t FindNearest(PointD const & p, PointD & proj, double & distSquare) const;
+
+private:
+  // Calls |toDo| with index, projection of |p| and squared distance for every segment.
+  template <typename ToDo>
+  void ForEachProjection(PointD const & p, ToDo && toDo) const;
+
+  std::vector<double> m_x0;
+  std::vector<double> m_y0;
+  std::vector<double> m_x1;
+  std::vector<double> m_y1;
+  // Normalized directions of segments, zero for degenerate ones.
+  std::vector<double> m_dx;
+  std::vector<double> m_dy;
+  std::vector<double> m_length;
+};
+}  // namespace m2
@@ -5,6 +5,9 @@
 
 #include "std/iterator.hpp"
 #include "std/algorithm.hpp"
+#include "std/atomic.hpp"
+#include "std/limits.hpp"
+#include "std/thread.hpp"
 #include "std/utility.hpp"
 #include "std/vector.hpp"
 
@@ -12,6 +15,8 @@
 //
 // SimplifyXXX() should be used to simplify polyline for a given epsilon.
 // (!) They do not include the last point to the simplification, the calling side should do it.
+// SimplifyXXXForEpsilons() produce simplifications for several epsilons in one pass
+// and call out(epsilonIndex, point) for every point of every simplification.
 
 namespace impl
 {
@@ -53,6 +58,46 @@ void SimplifyDP(IterT first, IterT last, double epsilon, DistanceF & dist, OutT
     impl::SimplifyDP(maxDist.second, last, epsilon, dist, out);
   }
 }
+
+// Douglas-Peucker splits of a range don't depend on epsilon, so every point gets a weight:
+// the point is in the simplification for epsilon iff its weight >= epsilon.
+// Points which can't be in simplifications for |minEpsilon| get the lowest weight.
+template <typename DistanceF, typename IterT>
+void CalcDPWeights(IterT beg, IterT end, double minEpsilon, DistanceF & dist,
+                   vector<double> & weights)
+{
+  size_t const n = static_cast<size_t>(distance(beg, end));
+  weights.assign(n, numeric_limits<double>::lowest());
+  if (n == 0)
+    return;
+  weights.front() = weights.back() = numeric_limits<double>::max();
+
+  // Ranges [first, last] with weights of their splits. The explicit stack is used because
+  // a depth of the recursion may be linear.
+  struct Range
+  {
+    size_t m_first;
+    size_t m_last;
+    double m_weight;
+  };
+  vector<Range> stack = {{0, n - 1, numeric_limits<double>::max()}};
+  while (!stack.empty())
+  {
+    Range const range = stack.back();
+    stack.pop_back();
+
+    pair<double, IterT> const maxDist =
+        impl::MaxDistance(beg + range.m_first, beg + range.m_last, dist);
+    if (maxDist.second == beg + range.m_last || maxDist.first < minEpsilon)
+      continue;
+
+    size_t const split = static_cast<size_t>(distance(beg, maxDist.second));
+    double const weight = min(range.m_weight, maxDist.first);
+    weights[split] = weight;
+    stack.push_back({range.m_first, split, weight});
+    stack.push_back({split, range.m_last, weight});
+  }
+}
 //@}
 
 struct SimplifyOptimalRes
@@ -80,6 +125,118 @@ void SimplifyDP(IterT beg, IterT end, double epsilon, DistanceF dist, OutT out)
   }
 }
 
+// The same as SimplifyDP(), but independent parts of a long polyline are simplified
+// by |threadsCount| threads. Top splits are done by the calling thread until there are
+// enough parts, so the result is exactly the same as of SimplifyDP().
+// |dist| is copied to every thread.
+template <typename DistanceF, typename IterT, typename OutT>
+void SimplifyDPParallel(size_t threadsCount, IterT beg, IterT end, double epsilon,
+                        DistanceF dist, OutT out)
+{
+  // Threads aren't worth it for shorter polylines.
+  size_t const kMinPointsPerThread = 10000;
+
+  size_t const n = static_cast<size_t>(distance(beg, end));
+  if (threadsCount <= 1 || n < 2 * kMinPointsPerThread)
+  {
+    SimplifyDP(beg, end, epsilon, dist, out);
+    return;
+  }
+
+  // Ranges [first, last] in order of the polyline. A done range is a leaf of the simplification.
+  struct Part
+  {
+    IterT m_first;
+    IterT m_last;
+    bool m_done;
+    vector<typename iterator_traits<IterT>::value_type> m_result;
+  };
+
+  size_t const maxPartSize = max(n / (4 * threadsCount), kMinPointsPerThread);
+  vector<Part> parts = {{beg, end - 1, false, {}}};
+  bool split = true;
+  while (split)
+  {
+    split = false;
+    vector<Part> next;
+    for (auto & part : parts)
+    {
+      if (part.m_done || static_cast<size_t>(distance(part.m_first, part.m_last)) <= maxPartSize)
+      {
+        next.push_back(move(part));
+        continue;
+      }
+
+      pair<double, IterT> const maxDist = impl::MaxDistance(part.m_first, part.m_last, dist);
+      if (maxDist.second == part.m_last || maxDist.first < epsilon)
+      {
+        next.push_back({part.m_first, part.m_last, true, {}});
+        continue;
+      }
+
+      next.push_back({part.m_first, maxDist.second, false, {}});
+      next.push_back({maxDist.second, part.m_last, false, {}});
+      split = true;
+    }
+    parts.swap(next);
+  }
+
+  atomic<size_t> nextPart(0);
+  auto const simplifyParts = [&parts, &nextPart, epsilon, dist]()
+  {
+    DistanceF threadDist = dist;
+    for (size_t i = nextPart++; i < parts.size(); i = nextPart++)
+    {
+      Part & part = parts[i];
+      if (part.m_done)
+        continue;
+      auto pushBack = MakeBackInsertFunctor(part.m_result);
+      impl::SimplifyDP(part.m_first, part.m_last, epsilon, threadDist, pushBack);
+    }
+  };
+
+  vector<thread> threads;
+  for (size_t i = 1; i < threadsCount; ++i)
+    threads.emplace_back(simplifyParts);
+  simplifyParts();
+  for (auto & t : threads)
+    t.join();
+
+  out(*beg);
+  for (auto const & part : parts)
+  {
+    if (part.m_done)
+    {
+      out(*part.m_last);
+      continue;
+    }
+    for (auto const & p : part.m_result)
+      out(p);
+  }
+}
+
+// Douglas-Peucker simplifications for every epsilon from |epsilons|. Every simplification
+// is the same as of SimplifyDP() for its epsilon.
+template <typename DistanceF, typename IterT, typename OutT>
+void SimplifyDPForEpsilons(IterT beg, IterT end, vector<double> const & epsilons, DistanceF dist,
+                           OutT out)
+{
+  if (beg == end || epsilons.empty())
+    return;
+
+  vector<double> weights;
+  impl::CalcDPWeights(beg, end, *min_element(epsilons.begin(), epsilons.end()), dist, weights);
+
+  for (size_t e = 0; e < epsilons.size(); ++e)
+  {
+    for (size_t i = 0; i < weights.size(); ++i)
+    {
+      if (weights[i] >= epsilons[e])
+        out(e, *(beg + i));
+    }
+  }
+}
+
 // Dynamic programming near-optimal simplification.
 // Uses O(n) additional memory.
 // Worst case O(n^3) performance, average O(n*k^2), where k is kMaxFalseLookAhead - parameter,
@@ -124,6 +281,82 @@ void SimplifyNearOptimal(int kMaxFalseLookAhead, IterT beg, IterT end,
     out(*(beg + i));
 }
 
+// SimplifyNearOptimal() for every epsilon from |epsilons|. Every simplification is the same
+// as of SimplifyNearOptimal() for its epsilon, but a distance for a pair of points is
+// calculated once for all epsilons.
+template <typename DistanceF, typename IterT, typename OutT>
+void SimplifyNearOptimalForEpsilons(int kMaxFalseLookAhead, IterT beg, IterT end,
+                                    vector<double> const & epsilons, DistanceF dist, OutT out)
+{
+  int32_t const n = static_cast<int32_t>(end - beg);
+  size_t const count = epsilons.size();
+  if (count == 0)
+    return;
+  if (n <= 2)
+  {
+    for (size_t e = 0; e < count; ++e)
+    {
+      for (IterT it = beg; it != end; ++it)
+        out(e, *it);
+    }
+    return;
+  }
+
+  // F[i * count + e] is the same as F[i] of SimplifyNearOptimal() for epsilons[e].
+  vector<impl::SimplifyOptimalRes> F(n * count);
+  for (size_t e = 0; e < count; ++e)
+    F[(n - 1) * count + e] = impl::SimplifyOptimalRes(n, 1);
+
+  vector<int32_t> falseCount(count);
+  for (int32_t i = n - 2; i >= 0; --i)
+  {
+    impl::SimplifyOptimalRes * const Fi = &F[i * count];
+    fill(falseCount.begin(), falseCount.end(), 0);
+    for (int32_t j = i + 1; j < n; ++j)
+    {
+      impl::SimplifyOptimalRes const * const Fj = &F[j * count];
+      bool active = false;
+      bool needDistance = false;
+      for (size_t e = 0; e < count; ++e)
+      {
+        if (falseCount[e] >= kMaxFalseLookAhead)
+          continue;
+        active = true;
+        if (Fj[e].m_PointCount + 1 < Fi[e].m_PointCount)
+          needDistance = true;
+      }
+      if (!active)
+        break;
+      if (!needDistance)
+        continue;
+
+      double const maxDistance = impl::MaxDistance(beg + i, beg + j, dist).first;
+      for (size_t e = 0; e < count; ++e)
+      {
+        uint32_t const newPointCount = Fj[e].m_PointCount + 1;
+        if (falseCount[e] >= kMaxFalseLookAhead || newPointCount >= Fi[e].m_PointCount)
+          continue;
+
+        if (maxDistance < epsilons[e])
+        {
+          Fi[e].m_NextPoint = j;
+          Fi[e].m_PointCount = newPointCount;
+        }
+        else
+        {
+          ++falseCount[e];
+        }
+      }
+    }
+  }
+
+  for (size_t e = 0; e < count; ++e)
+  {
+    for (int32_t i = 0; i < n; i = F[i * count + e].m_NextPoint)
+      out(e, *(beg + i));
+  }
+}
+
 
 // Additional points filter to use in simplification.
 // SimplifyDP can produce points that define degenerate triangle.
@@ -29,6 +29,9 @@ void LoadAndMap(size_t dataSize, ReaderSource<FilesContainerR::TReader> & src, T
 
 namespace feature
 {
+// static
+uint32_t constexpr AltitudeLoader::kInvalidFeatureId;
+
 AltitudeLoader::AltitudeLoader(Index const & index, MwmSet::MwmId const & mwmId)
   : m_handle(index.GetMwmHandleById(mwmId))
 {
@@ -68,22 +71,31 @@ bool AltitudeLoader::HasAltitudes() const
 }
 
 TAltitudes const & AltitudeLoader::GetAltitudes(uint32_t featureId, size_t pointCount)
+{
+  if (featureId == m_cachedFeatureId && m_cache.size() == pointCount)
+    return m_cache;
+
+  GetAltitudes(featureId, pointCount, m_cache);
+  m_cachedFeatureId = featureId;
+  return m_cache;
+}
+
+void AltitudeLoader::GetAltitudes(uint32_t featureId, size_t pointCount,
+                                  TAltitudes & altitudes) const
 {
   if (!HasAltitudes())
   {
     // The version of mwm is less than version::Format::v8 or there's no altitude section in mwm.
-    return m_cache.insert(make_pair(featureId, TAltitudes(pointCount, kDefaultAltitudeMeters))).first->second;
+    altitudes.assign(pointCount, kDefaultAltitudeMeters);
+    return;
   }
 
-  auto const it = m_cache.find(featureId);
-  if (it != m_cache.end())
-    return it->second;
-
   if (!m_altitudeAvailability[featureId])
   {
     LOG(LDEBUG, ("Feature Id", featureId, "of", m_countryFileName,
                  "does not contain any altitude information."));
-    return m_cache.insert(make_pair(featureId, TAltitudes(pointCount, m_header.m_minAltitude))).first->second;
+    altitudes.assign(pointCount, m_header.m_minAltitude);
+    return;
   }
 
   uint64_t const r = m_altitudeAvailability.rank(featureId);
@@ -94,30 +106,31 @@ TAltitudes const & AltitudeLoader::GetAltitudes(uint32_t featureId, size_t point
   uint64_t const altitudeInfoOffsetInSection = m_header.m_altitudesOffset + offset;
   CHECK_LESS(altitudeInfoOffsetInSection, m_reader->Size(), ("Feature Id", featureId, "of", m_countryFileName));
 
+  // |altitudes| is moved to the decoder and back to reuse its memory.
+  Altitudes decoded;
+  decoded.m_altitudes.swap(altitudes);
   try
   {
-    Altitudes altitudes;
     ReaderSource<FilesContainerR::TReader> src(*m_reader);
     src.Skip(altitudeInfoOffsetInSection);
-    bool const isDeserialized = altitudes.Deserialize(m_header.m_minAltitude, pointCount,
-                                                      m_countryFileName, featureId,  src);
+    bool const isDeserialized = decoded.Deserialize(m_header.m_minAltitude, pointCount,
+                                                    m_countryFileName, featureId, src);
+    decoded.m_altitudes.swap(altitudes);
 
     bool const allValid = isDeserialized
-        && none_of(altitudes.m_altitudes.begin(), altitudes.m_altitudes.end(),
+        && none_of(altitudes.begin(), altitudes.end(),
                    [](TAltitude a) { return a == kInvalidAltitude; });
     if (!allValid)
     {
-      LOG(LERROR, ("Only a part point of a feature has a valid altitdue. Altitudes: ", altitudes.m_altitudes,
+      LOG(LERROR, ("Only a part point of a feature has a valid altitdue. Altitudes: ", altitudes,
                    ". Feature Id", featureId, "of", m_countryFileName));
-      return m_cache.insert(make_pair(featureId, TAltitudes(pointCount, m_header.m_minAltitude))).first->second;
+      altitudes.assign(pointCount, m_header.m_minAltitude);
     }
-
-    return m_cache.insert(make_pair(featureId, move(altitudes.m_altitudes))).first->second;
   }
   catch (Reader::OpenException const & e)
   {
     LOG(LERROR, ("Feature Id", featureId, "of", m_countryFileName, ". Error while getting altitude data:", e.Msg()));
-    return m_cache.insert(make_pair(featureId, TAltitudes(pointCount, m_header.m_minAltitude))).first->second;
+    altitudes.assign(pointCount, m_header.m_minAltitude);
   }
 }
 }  // namespace feature
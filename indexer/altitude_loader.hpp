@@ -5,6 +5,8 @@
 
 #include "coding/memory_region.hpp"
 
+#include "std/cstdint.hpp"
+#include "std/limits.hpp"
 #include "std/string.hpp"
 #include "std/unique_ptr.hpp"
 #include "std/vector.hpp"
@@ -20,11 +22,17 @@ public:
 
   /// \returns altitude of feature with |featureId|. All items of the returned vector are valid
   /// or the returned vector is empty.
+  /// \note The returned reference is valid till the next call of GetAltitudes() for another
+  /// feature. Only altitudes of the last requested feature are cached.
   TAltitudes const & GetAltitudes(uint32_t featureId, size_t pointCount);
 
+  /// \brief Decodes altitudes of feature with |featureId| to |altitudes|. Memory of |altitudes|
+  /// is reused so it's worth passing the same vector for sequential features.
+  void GetAltitudes(uint32_t featureId, size_t pointCount, TAltitudes & altitudes) const;
+
   bool HasAltitudes() const;
 
-  void ClearCache() { m_cache.clear(); }
+  void ClearCache() { m_cachedFeatureId = kInvalidFeatureId; }
 
 private:
   unique_ptr<CopiedMemoryRegion> m_altitudeAvailabilityRegion;
@@ -33,8 +41,11 @@ private:
   succinct::rs_bit_vector m_altitudeAvailability;
   succinct::elias_fano m_featureTable;
 
+  static uint32_t constexpr kInvalidFeatureId = numeric_limits<uint32_t>::max();
+
   unique_ptr<FilesContainerR::TReader> m_reader;
-  map<uint32_t, TAltitudes> m_cache;
+  TAltitudes m_cache;
+  uint32_t m_cachedFeatureId = kInvalidFeatureId;
   AltitudeHeader m_header;
   string m_countryFileName;
   MwmSet::MwmHandle m_handle;
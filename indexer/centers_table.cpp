@@ -6,6 +6,7 @@
 #include "coding/endianness.hpp"
 #include "coding/file_container.hpp"
 #include "coding/memory_region.hpp"
+#include "coding/mmap_reader.hpp"
 #include "coding/point_to_integer.hpp"
 #include "coding/reader.hpp"
 #include "coding/succinct_mapper.hpp"
@@ -17,6 +18,8 @@
 #include "base/checked_cast.hpp"
 #include "base/logging.hpp"
 
+#include "std/algorithm.hpp"
+#include "std/limits.hpp"
 #include "std/unordered_map.hpp"
 
 #include "3party/succinct/elias_fano.hpp"
@@ -26,6 +29,15 @@ namespace search
 {
 namespace
 {
+template <typename TCont>
+void Map(uint8_t const * data, TCont & cont)
+{
+  TCont c;
+  coding::MapVisitor visitor(data);
+  c.map(visitor);
+  c.swap(cont);
+}
+
 template <typename TCont>
 void EndiannessAwareMap(bool endiannesMismatch, CopiedMemoryRegion & region, TCont & cont)
 {
@@ -149,36 +161,78 @@ public:
 
     auto & entry = m_cache[base];
     if (entry.empty())
-    {
-      entry.resize(kBlockSize);
-
-      auto const start = m_offsets.select(base);
-      auto const end = base + 1 < m_offsets.num_ones()
-                           ? m_offsets.select(base + 1)
-                           : m_header.m_endOffset - m_header.m_deltasOffset;
+      ReadBlock(base, entry);
 
-      vector<uint8_t> data(end - start);
-
-      m_reader.Read(m_header.m_deltasOffset + start, data.data(), data.size());
+    center = PointU2PointD(entry[offset], m_codingParams.GetCoordBits());
+    return true;
+  }
 
-      MemReader mreader(data.data(), data.size());
-      NonOwningReaderSource msource(mreader);
+  void GetBatch(vector<uint32_t> const & ids, vector<m2::PointD> & centers,
+                vector<bool> & found) override
+  {
+    ASSERT(is_sorted(ids.begin(), ids.end()), ());
 
-      uint64_t delta = ReadVarUint<uint64_t>(msource);
-      entry[0] = DecodeDelta(delta, m_codingParams.GetBasePoint());
+    centers.assign(ids.size(), m2::PointD());
+    found.assign(ids.size(), false);
 
-      for (size_t i = 1; i < kBlockSize && msource.Size() > 0; ++i)
+    vector<m2::PointU> block;
+    uint32_t blockBase = numeric_limits<uint32_t>::max();
+    for (size_t i = 0; i < ids.size(); ++i)
+    {
+      uint32_t const id = ids[i];
+      if (id >= m_ids.size() || !m_ids[id])
+        continue;
+      uint32_t const rank = static_cast<uint32_t>(m_ids.rank(id));
+      uint32_t const base = rank / kBlockSize;
+
+      vector<m2::PointU> const * entry = nullptr;
+      auto const it = m_cache.find(base);
+      if (it != m_cache.end())
       {
-        delta = ReadVarUint<uint64_t>(msource);
-        entry[i] = DecodeDelta(delta, entry[i - 1]);
+        entry = &it->second;
+      }
+      else
+      {
+        if (base != blockBase)
+        {
+          ReadBlock(base, block);
+          blockBase = base;
+        }
+        entry = &block;
       }
-    }
 
-    center = PointU2PointD(entry[offset], m_codingParams.GetCoordBits());
-    return true;
+      centers[i] = PointU2PointD((*entry)[rank % kBlockSize], m_codingParams.GetCoordBits());
+      found[i] = true;
+    }
   }
 
 private:
+  void ReadBlock(uint32_t base, vector<m2::PointU> & entry)
+  {
+    entry.resize(kBlockSize);
+
+    auto const start = m_offsets.select(base);
+    auto const end = base + 1 < m_offsets.num_ones()
+                         ? m_offsets.select(base + 1)
+                         : m_header.m_endOffset - m_header.m_deltasOffset;
+
+    vector<uint8_t> data(end - start);
+
+    m_reader.Read(m_header.m_deltasOffset + start, data.data(), data.size());
+
+    MemReader mreader(data.data(), data.size());
+    NonOwningReaderSource msource(mreader);
+
+    uint64_t delta = ReadVarUint<uint64_t>(msource);
+    entry[0] = DecodeDelta(delta, m_codingParams.GetBasePoint());
+
+    for (size_t i = 1; i < kBlockSize && msource.Size() > 0; ++i)
+    {
+      delta = ReadVarUint<uint64_t>(msource);
+      entry[i] = DecodeDelta(delta, entry[i - 1]);
+    }
+  }
+
   // CentersTable overrides:
   bool Init() override
   {
@@ -191,6 +245,16 @@ private:
     bool const isDataBigEndian = m_header.m_base.m_endianness == 1;
     bool const endiannesMismatch = isHostBigEndian != isDataBigEndian;
 
+    // Structures of a mapped section are used in place, so they share
+    // physical pages with other processes which map the mwm.
+    uint8_t const * mapped = MmapReader::GetMappedData(m_reader);
+    if (mapped && !endiannesMismatch)
+    {
+      Map(mapped + sizeof(m_header), m_ids);
+      Map(mapped + m_header.m_positionsOffset, m_offsets);
+      return true;
+    }
+
     {
       uint32_t const idsSize = m_header.m_positionsOffset - sizeof(m_header);
       vector<uint8_t> data(idsSize);
@@ -247,6 +311,15 @@ bool CentersTable::Header::IsValid() const
 }
 
 // CentersTable ------------------------------------------------------------------------------------
+void CentersTable::GetBatch(vector<uint32_t> const & ids, vector<m2::PointD> & centers,
+                            vector<bool> & found)
+{
+  centers.assign(ids.size(), m2::PointD());
+  found.assign(ids.size(), false);
+  for (size_t i = 0; i < ids.size(); ++i)
+    found[i] = Get(ids[i], centers[i]);
+}
+
 unique_ptr<CentersTable> CentersTable::Load(Reader & reader,
                                             serial::CodingParams const & codingParams)
 {
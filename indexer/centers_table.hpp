@@ -50,6 +50,13 @@ public:
   // false if table does not have entry for the feature.
   WARN_UNUSED_RESULT virtual bool Get(uint32_t id, m2::PointD & center) = 0;
 
+  // Gets centers of the features identified by sorted |ids|.  Every
+  // block of centers is decoded once for all ids in it and isn't
+  // kept after the call.  |found[i]| is false if table does not have
+  // entry for |ids[i]|.
+  virtual void GetBatch(vector<uint32_t> const & ids, vector<m2::PointD> & centers,
+                        vector<bool> & found);
+
   // Loads CentersTable instance. Note that |reader| must be alive
   // until the destruction of loaded table. Returns nullptr if
   // CentersTable can't be loaded.
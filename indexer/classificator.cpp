@@ -1,7 +1,14 @@
 #include "indexer/classificator.hpp"
+#include "indexer/drawing_rules.hpp"
 #include "indexer/map_style_reader.hpp"
 #include "indexer/tree_structure.hpp"
 
+#include "coding/read_write_utils.hpp"
+#include "coding/reader.hpp"
+#include "coding/varint.hpp"
+#include "coding/write_to_sink.hpp"
+#include "coding/writer.hpp"
+
 #include "base/logging.hpp"
 #include "base/macros.hpp"
 #include "base/string_utils.hpp"
@@ -95,6 +102,22 @@ void ClassifObject::Swap(ClassifObject & r)
   swap(m_visibility, r.m_visibility);
 }
 
+void ClassifObject::Write(Writer & writer) const
+{
+  rw::Write(writer, m_name);
+  WriteVarUint(writer, static_cast<uint32_t>(m_objs.size()));
+  for (auto const & obj : m_objs)
+    obj.Write(writer);
+}
+
+void ClassifObject::Read(NonOwningReaderSource & src)
+{
+  rw::Read(src, m_name);
+  m_objs.resize(ReadVarUint<uint32_t>(src));
+  for (auto & obj : m_objs)
+    obj.Read(src);
+}
+
 ClassifObject const * ClassifObject::GetObject(size_t i) const
 {
   if (i < m_objs.size())
@@ -371,9 +394,37 @@ void Classificator::ReadClassificator(istream & s)
   m_coastType = GetTypeByPath({ "natural", "coastline" });
 }
 
+void Classificator::WriteBinary(Writer & writer) const
+{
+  m_root.Write(writer);
+
+  auto const & types = m_mapping.GetTypes();
+  WriteVarUint(writer, static_cast<uint32_t>(types.size()));
+  for (auto const type : types)
+    WriteToSink(writer, type);
+}
+
+void Classificator::ReadBinary(NonOwningReaderSource & src)
+{
+  Clear();
+
+  // The tree is written sorted, so it isn't sorted again.
+  m_root.Read(src);
+
+  vector<uint32_t> types(ReadVarUint<uint32_t>(src));
+  for (auto & type : types)
+    type = ReadPrimitiveFromSource<uint32_t>(src);
+  m_mapping.Load(types);
+
+  m_coastType = GetTypeByPath({ "natural", "coastline" });
+}
+
 void Classificator::SortClassificator()
 {
   GetMutableRoot()->Sort();
+  // Types may be changed by the sort.
+  if (!m_rulesTable.IsEmpty())
+    BuildRulesTable(drule::rules());
 }
 
 template <class IterT> uint32_t Classificator::GetTypeByPathImpl(IterT beg, IterT end) const
@@ -431,6 +482,7 @@ void Classificator::Clear()
 {
   ClassifObject("world").Swap(m_root);
   m_mapping.Clear();
+  m_rulesTable.Clear();
 }
 
 string Classificator::GetReadableObjectName(uint32_t type) const
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "indexer/drawing_rule_def.hpp"
+#include "indexer/drules_table.hpp"
 #include "indexer/feature_decl.hpp"
 #include "indexer/map_style.hpp"
 #include "indexer/scales.hpp"
@@ -14,6 +15,8 @@
 #include "std/vector.hpp"
 
 class ClassifObject;
+class NonOwningReaderSource;
+class Writer;
 
 namespace ftype
 {
@@ -75,6 +78,13 @@ public:
   void Sort();
   void Swap(ClassifObject & r);
 
+  /// @name Binary serialization of names of the subtree, drawing rules
+  /// aren't written.
+  //@{
+  void Write(Writer & writer) const;
+  void Read(NonOwningReaderSource & src);
+  //@}
+
   string const & GetName() const { return m_name; }
   ClassifObject const * GetObject(size_t i) const;
 
@@ -96,6 +106,13 @@ public:
       toDo(&m_objs[i]);
   }
 
+  template <class ToDo>
+  void ForEachObject(ToDo toDo) const
+  {
+    for (size_t i = 0; i < m_objs.size(); ++i)
+      toDo(&m_objs[i]);
+  }
+
   template <class ToDo>
   void ForEachObjectInTree(ToDo & toDo, uint32_t const start) const
   {
@@ -159,6 +176,8 @@ class Classificator : private noncopyable
 
   IndexAndTypeMapping m_mapping;
 
+  drule::RulesTable m_rulesTable;
+
   uint32_t m_coastType;
 
   static ClassifObject * AddV(ClassifObject * parent, string const & key, string const & value);
@@ -174,6 +193,11 @@ public:
   void ReadTypesMapping(istream & s);
 
   void SortClassificator();
+
+  /// The tree and the types mapping in the binary form, which is read
+  /// without parsing of the text and the search of every type by path.
+  void WriteBinary(Writer & writer) const;
+  void ReadBinary(NonOwningReaderSource & src);
   //@}
 
   void Clear();
@@ -198,6 +222,11 @@ public:
   uint32_t GetTypeForIndex(uint32_t i) const { return m_mapping.GetType(i); }
   bool IsTypeValid(uint32_t t) const { return m_mapping.HasIndex(t); }
 
+  /// Builds the table of drawing rules of the types, should be called
+  /// after the drawing rules are set to the classificator objects.
+  void BuildRulesTable(drule::RulesHolder const & rules) { m_rulesTable.Build(*this, rules); }
+  drule::RulesTable const & GetRulesTable() const { return m_rulesTable; }
+
   inline uint32_t GetCoastType() const { return m_coastType; }
 
   /// @name used in osm2type.cpp, not for public use.
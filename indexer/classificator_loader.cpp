@@ -5,37 +5,92 @@
 
 #include "platform/platform.hpp"
 
-#include "coding/reader_streambuf.hpp"
+#include "coding/file_writer.hpp"
+#include "coding/reader.hpp"
+#include "coding/write_to_sink.hpp"
+#include "coding/xxhash.hpp"
 
 #include "base/logging.hpp"
 
-#include "std/iostream.hpp"
+#include "defines.hpp"
+
+#include "std/sstream.hpp"
 
 
 namespace
 {
-void ReadCommon(unique_ptr<Reader> classificator,
-                unique_ptr<Reader> types)
+// Format of the binary classificator: version, hash of the text files
+// and the data of Classificator::WriteBinary().
+uint8_t constexpr kBinaryVersion = 0;
+
+struct TextFiles
+{
+  TextFiles()
+  {
+    Platform & p = GetPlatform();
+    p.GetReader(CLASSIFICATOR_FILE)->ReadAsString(m_classificator);
+    p.GetReader(TYPES_FILE)->ReadAsString(m_types);
+  }
+
+  uint64_t GetHash() const
+  {
+    coding::XXHash64 hash;
+    hash.Update(m_classificator.data(), m_classificator.size());
+    hash.Update(m_types.data(), m_types.size());
+    return hash.Digest();
+  }
+
+  string m_classificator;
+  string m_types;
+};
+
+void ReadText(TextFiles const & files)
 {
   Classificator & c = classif();
   c.Clear();
 
   {
     //LOG(LINFO, ("Reading classificator"));
-    ReaderStreamBuf buffer(move(classificator));
-
-    istream s(&buffer);
+    istringstream s(files.m_classificator);
     c.ReadClassificator(s);
   }
 
   {
     //LOG(LINFO, ("Reading types mapping"));
-    ReaderStreamBuf buffer(move(types));
-
-    istream s(&buffer);
+    istringstream s(files.m_types);
     c.ReadTypesMapping(s);
   }
 }
+
+// Returns the data of the binary classificator after the header, or an
+// empty string when there's no binary classificator or it's made from
+// other text files.
+string ReadBinaryData(TextFiles const & files)
+{
+  string buffer;
+  try
+  {
+    GetPlatform().GetReader(CLASSIFICATOR_BIN_FILE)->ReadAsString(buffer);
+  }
+  catch (RootException const &)
+  {
+    return {};
+  }
+
+  MemReader reader(buffer.data(), buffer.size());
+  NonOwningReaderSource src(reader);
+  if (src.Size() < sizeof(kBinaryVersion) + sizeof(uint64_t))
+    return {};
+
+  auto const version = ReadPrimitiveFromSource<uint8_t>(src);
+  auto const hash = ReadPrimitiveFromSource<uint64_t>(src);
+  if (version != kBinaryVersion || hash != files.GetHash())
+  {
+    LOG(LWARNING, (CLASSIFICATOR_BIN_FILE, "is outdated, text files are used"));
+    return {};
+  }
+  return buffer.substr(static_cast<size_t>(src.Pos()));
+}
 }  // namespace
 
 namespace classificator
@@ -44,7 +99,9 @@ void Load()
 {
   LOG(LDEBUG, ("Reading of classificator started"));
 
-  Platform & p = GetPlatform();
+  // The files are the same for all styles, so they are read once.
+  TextFiles const files;
+  string const binary = ReadBinaryData(files);
 
   MapStyle const originMapStyle = GetStyleReader().GetCurrentStyle();
 
@@ -55,8 +112,16 @@ void Load()
     if (mapStyle != MapStyleMerged || originMapStyle == MapStyleMerged)
     {
       GetStyleReader().SetCurrentStyle(mapStyle);
-      ReadCommon(p.GetReader("classificator.txt"),
-                 p.GetReader("types.txt"));
+      if (binary.empty())
+      {
+        ReadText(files);
+      }
+      else
+      {
+        MemReader reader(binary.data(), binary.size());
+        NonOwningReaderSource src(reader);
+        classif().ReadBinary(src);
+      }
 
       drule::LoadRules();
     }
@@ -66,4 +131,12 @@ void Load()
 
   LOG(LDEBUG, ("Reading of classificator finished"));
 }
+
+void SaveBinary(string const & filePath)
+{
+  FileWriter writer(filePath);
+  WriteToSink(writer, kBinaryVersion);
+  WriteToSink(writer, TextFiles().GetHash());
+  classif().WriteBinary(writer);
+}
 }  // namespace classificator
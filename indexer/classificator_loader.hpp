@@ -5,5 +5,12 @@
 
 namespace classificator
 {
+  /// Loads the classificator and the drawing rules of all styles. The
+  /// precompiled classificator (see SaveBinary()) is used when it's made
+  /// from the current text files, otherwise the text files are parsed.
   void Load();
+
+  /// Writes the loaded classificator of the current style to |filePath|
+  /// in the binary form, with the hash of the text files it's made from.
+  void SaveBinary(string const & filePath);
 }
@@ -0,0 +1,185 @@
+#include "indexer/compressed_features_data.hpp"
+
+#include "coding/byte_stream.hpp"
+#include "coding/file_container.hpp"
+#include "coding/file_writer.hpp"
+#include "coding/var_record_reader.hpp"
+#include "coding/varint.hpp"
+#include "coding/write_to_sink.hpp"
+#include "coding/writer.hpp"
+#include "coding/zlib.hpp"
+
+#include "base/assert.hpp"
+#include "base/checked_cast.hpp"
+#include "base/logging.hpp"
+#include "base/scope_guard.hpp"
+
+#include <functional>
+#include <iterator>
+
+#include "defines.hpp"
+
+using namespace std;
+
+namespace feature
+{
+namespace
+{
+uint32_t constexpr kHeaderSize = 2 * sizeof(uint32_t);
+}  // namespace
+
+// static
+uint32_t constexpr CompressedFeaturesData::kLatestVersion;
+// static
+uint32_t constexpr CompressedFeaturesData::kDefaultBlockSize;
+
+// static
+void CompressedFeaturesData::Build(ModelReaderPtr const & data, uint32_t blockSize,
+                                   Writer & writer)
+{
+  CHECK_GREATER(blockSize, 0, ());
+
+  vector<uint32_t> offsets = {0};
+  vector<uint32_t> compressedOffsets = {0};
+  vector<char> compressed;
+  vector<char> block;
+
+  coding::ZLib::Deflate const deflate(coding::ZLib::Deflate::Format::ZLib,
+                                      coding::ZLib::Deflate::Level::BestCompression);
+  auto const flushBlock = [&]()
+  {
+    if (block.empty())
+      return;
+    CHECK(deflate(block.data(), block.size(), back_inserter(compressed)), ());
+    offsets.push_back(offsets.back() + base::checked_cast<uint32_t>(block.size()));
+    compressedOffsets.push_back(base::checked_cast<uint32_t>(compressed.size()));
+    block.clear();
+  };
+
+  VarRecordReader<ModelReaderPtr, &VarRecordSizeReaderVarint> const reader(data, 256);
+  reader.ForEachRecord([&](uint32_t pos, char const * record, uint32_t size)
+  {
+    // Records are never split, so a block may be larger than |blockSize|.
+    if (!block.empty() && block.size() + size > blockSize)
+      flushBlock();
+
+    ASSERT_EQUAL(pos, offsets.back() + block.size(), ());
+    PushBackByteSink<vector<char>> sink(block);
+    WriteVarUint(sink, size);
+    block.insert(block.end(), record, record + size);
+  });
+  flushBlock();
+
+  WriteToSink(writer, kLatestVersion);
+  WriteToSink(writer, base::checked_cast<uint32_t>(offsets.size() - 1));
+  for (auto const offset : offsets)
+    WriteToSink(writer, offset);
+  for (auto const offset : compressedOffsets)
+    WriteToSink(writer, offset);
+  writer.Write(compressed.data(), compressed.size());
+}
+
+CompressedFeaturesData::CompressedFeaturesData(ModelReaderPtr const & reader) : m_reader(reader)
+{
+  if (m_reader.Size() < kHeaderSize)
+    MYTHROW(Reader::SizeException, ("Too small compressed features data:", m_reader.Size()));
+
+  uint32_t const version = ReadPrimitiveFromPos<uint32_t>(m_reader, 0);
+  if (version != kLatestVersion)
+    MYTHROW(Reader::ReadException, ("Unknown version of compressed features data:", version));
+
+  m_blocksCount = ReadPrimitiveFromPos<uint32_t>(m_reader, sizeof(uint32_t));
+  uint64_t const tablesSize = 2 * (static_cast<uint64_t>(m_blocksCount) + 1) * sizeof(uint32_t);
+  if (m_reader.Size() < kHeaderSize + tablesSize)
+    MYTHROW(Reader::SizeException, ("Broken tables of compressed features data:", m_blocksCount));
+}
+
+uint32_t CompressedFeaturesData::GetBlockByOffset(uint32_t offset) const
+{
+  ASSERT_GREATER(m_blocksCount, 0, ());
+  ASSERT_LESS(offset, GetBlockOffset(m_blocksCount), ());
+
+  // Looks for the last block which starts not after |offset|.
+  uint32_t lo = 0;
+  uint32_t hi = m_blocksCount;
+  while (hi - lo > 1)
+  {
+    uint32_t const mid = lo + (hi - lo) / 2;
+    if (GetBlockOffset(mid) <= offset)
+      lo = mid;
+    else
+      hi = mid;
+  }
+  return lo;
+}
+
+uint32_t CompressedFeaturesData::GetBlockOffset(uint32_t block) const
+{
+  ASSERT_LESS_OR_EQUAL(block, m_blocksCount, ());
+  return ReadPrimitiveFromPos<uint32_t>(m_reader, kHeaderSize + block * sizeof(uint32_t));
+}
+
+void CompressedFeaturesData::ReadBlock(uint32_t block, vector<char> & data) const
+{
+  ASSERT_LESS(block, m_blocksCount, ());
+
+  uint64_t const blocksBegin = kHeaderSize + 2 * (static_cast<uint64_t>(m_blocksCount) + 1) *
+                                                 sizeof(uint32_t);
+  uint32_t const begin = GetCompressedOffset(block);
+  uint32_t const end = GetCompressedOffset(block + 1);
+  if (begin > end || blocksBegin + end > m_reader.Size())
+    MYTHROW(Reader::ReadException, ("Broken offsets of compressed block", block));
+
+  vector<char> compressed(end - begin);
+  m_reader.Read(blocksBegin + begin, compressed.data(), compressed.size());
+
+  data.clear();
+  uint32_t const size = GetBlockOffset(block + 1) - GetBlockOffset(block);
+  data.reserve(size);
+  coding::ZLib::Inflate const inflate(coding::ZLib::Inflate::Format::ZLib);
+  if (!inflate(compressed.data(), compressed.size(), back_inserter(data)) || data.size() != size)
+    MYTHROW(Reader::ReadException, ("Can't decompress block", block));
+}
+
+uint32_t CompressedFeaturesData::GetCompressedOffset(uint32_t block) const
+{
+  ASSERT_LESS_OR_EQUAL(block, m_blocksCount, ());
+  return ReadPrimitiveFromPos<uint32_t>(
+      m_reader, kHeaderSize + (m_blocksCount + 1 + block) * sizeof(uint32_t));
+}
+
+bool CompressFeaturesData(string const & filePath, uint32_t blockSize)
+{
+  string const tmpPath = filePath + "." COMPRESSED_DATA_FILE_TAG;
+  MY_SCOPE_GUARD(tmpDeleter, bind(FileWriter::DeleteFileX, tmpPath));
+
+  try
+  {
+    {
+      FilesContainerR const cont(filePath);
+      if (!cont.IsExist(DATA_FILE_TAG))
+      {
+        LOG(LWARNING, ("No features data in", filePath));
+        return false;
+      }
+
+      FileWriter writer(tmpPath);
+      CompressedFeaturesData::Build(cont.GetReader(DATA_FILE_TAG), blockSize, writer);
+    }
+
+    {
+      FilesContainerW cont(filePath, FileWriter::OP_WRITE_EXISTING);
+      cont.Write(tmpPath, COMPRESSED_DATA_FILE_TAG);
+    }
+
+    // DeleteSection() reads sections from the file on disk, so the new one must be finished.
+    FilesContainerW(filePath, FileWriter::OP_WRITE_EXISTING).DeleteSection(DATA_FILE_TAG);
+  }
+  catch (RootException const & e)
+  {
+    LOG(LERROR, ("Can't compress features data of", filePath, e.Msg()));
+    return false;
+  }
+  return true;
+}
+}  // namespace feature
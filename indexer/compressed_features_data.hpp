@@ -0,0 +1,56 @@
+#pragma once
+
+#include "coding/reader.hpp"
+#include "coding/writer.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace feature
+{
+// Features data section (DATA_FILE_TAG) which is divided into blocks compressed by zlib.
+// Every block holds whole records of the original section, so offsets of features in
+// FeaturesOffsetsTable are offsets in the uncompressed data, as before.
+//
+// Layout of COMPRESSED_DATA_FILE_TAG section:
+//   uint32_t version
+//   uint32_t blocksCount
+//   (blocksCount + 1) x uint32_t offsets of blocks in the uncompressed data
+//   (blocksCount + 1) x uint32_t offsets of compressed blocks from the end of the tables
+//   compressed blocks
+class CompressedFeaturesData
+{
+public:
+  static uint32_t constexpr kLatestVersion = 0;
+  static uint32_t constexpr kDefaultBlockSize = 8 * 1024;
+
+  // Compresses records of the original section |data| by blocks of about |blockSize|
+  // uncompressed bytes and writes the section to |writer|.
+  static void Build(ModelReaderPtr const & data, uint32_t blockSize, Writer & writer);
+
+  // Throws Reader::Exception for a broken section.
+  explicit CompressedFeaturesData(ModelReaderPtr const & reader);
+
+  uint32_t GetBlocksCount() const { return m_blocksCount; }
+
+  // Returns the block which contains the record at |offset| of the uncompressed data.
+  uint32_t GetBlockByOffset(uint32_t offset) const;
+
+  // Returns the offset of |block| in the uncompressed data.
+  uint32_t GetBlockOffset(uint32_t block) const;
+
+  // Decompresses |block| to |data|. Throws Reader::Exception for a broken block.
+  void ReadBlock(uint32_t block, std::vector<char> & data) const;
+
+private:
+  uint32_t GetCompressedOffset(uint32_t block) const;
+
+  ModelReaderPtr m_reader;
+  uint32_t m_blocksCount = 0;
+};
+
+// Replaces DATA_FILE_TAG section of the mwm at |filePath| by COMPRESSED_DATA_FILE_TAG one.
+// Such mwms can't be read by versions without CompressedFeaturesData.
+bool CompressFeaturesData(std::string const & filePath, uint32_t blockSize);
+}  // namespace feature
@@ -524,6 +524,7 @@ void RulesHolder::LoadFromBinaryProto(string const & s)
   CHECK ( doSet.m_cont.ParseFromString(s), ("Error in proto loading!") );
 
   classif().GetMutableRoot()->ForEachObject(ref(doSet));
+  classif().BuildRulesTable(*this);
 
   InitBackgroundColors(doSet.m_cont);
   InitColors(doSet.m_cont);
@@ -64,6 +64,8 @@ namespace drule
 
     // Set runtime feature style selector
     void SetSelector(unique_ptr<ISelector> && selector);
+
+    inline bool HasSelector() const { return m_selector != nullptr; }
   };
 
   class RulesHolder
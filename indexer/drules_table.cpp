@@ -0,0 +1,131 @@
+#include "indexer/drules_table.hpp"
+
+#include "indexer/classificator.hpp"
+#include "indexer/drawing_rules.hpp"
+
+#include "base/assert.hpp"
+
+namespace drule
+{
+// static
+int constexpr RulesTable::kNumScales;
+// static
+int constexpr RulesTable::kNumGeomTypes;
+// static
+uint32_t constexpr RulesTable::kEmptyRow;
+
+void RulesTable::Build(Classificator const & c, RulesHolder const & rules)
+{
+  Clear();
+
+  m_offsets.push_back(0);
+  uint32_t numRows = 0;
+  auto addObject = [&](ClassifObject const * p, uint32_t type)
+  {
+    if (!p->IsDrawableAny())
+    {
+      m_rows[type] = kEmptyRow;
+      return;
+    }
+
+    m_rows[type] = numRows++;
+
+    uint32_t drawableScales = 0;
+    size_t const firstScales = m_scalesOfRules.size();
+    m_scalesOfRules.resize(firstScales + kNumGeomTypes * count_of_rules, 0);
+    for (int scale = 0; scale < kNumScales; ++scale)
+    {
+      if (p->IsDrawable(scale))
+        drawableScales |= 1U << scale;
+
+      for (int geomType = 0; geomType < kNumGeomTypes; ++geomType)
+      {
+        KeysT keys;
+        p->GetSuitable(scale, feature::EGeomType(geomType), keys);
+
+        bool hasSelectors = false;
+        for (auto const & key : keys)
+        {
+          auto const * rule = rules.Find(key);
+          if (rule != nullptr && rule->HasSelector())
+            hasSelectors = true;
+          m_keys.push_back(key);
+          m_scalesOfRules[firstScales + geomType * count_of_rules + key.m_type] |= 1U << scale;
+        }
+        m_offsets.push_back(static_cast<uint32_t>(m_keys.size()));
+        m_selectors.push_back(hasSelectors);
+      }
+    }
+    m_drawableScales.push_back(drawableScales);
+  };
+  c.ForEachTree(addObject);
+
+  ASSERT_EQUAL(m_offsets.size(), GetBucket(numRows, 0 /* scale */, 0 /* geomType */) + 1, ());
+}
+
+void RulesTable::Clear()
+{
+  m_rows.clear();
+  m_offsets.clear();
+  m_keys.clear();
+  m_selectors.clear();
+  m_drawableScales.clear();
+  m_scalesOfRules.clear();
+}
+
+bool RulesTable::GetSuitable(uint32_t type, int scale, feature::EGeomType geomType, KeysT & keys,
+                             bool & hasSelectors) const
+{
+  if (scale < 0 || scale >= kNumScales || geomType < 0 || geomType >= kNumGeomTypes)
+    return false;
+
+  auto const it = m_rows.find(type);
+  if (it == m_rows.end())
+    return false;
+  if (it->second == kEmptyRow)
+    return true;
+
+  auto const bucket = GetBucket(it->second, scale, geomType);
+  ASSERT_LESS(bucket + 1, m_offsets.size(), ());
+  for (auto i = m_offsets[bucket]; i < m_offsets[bucket + 1]; ++i)
+    keys.push_back(m_keys[i]);
+  if (m_selectors[bucket])
+    hasSelectors = true;
+  return true;
+}
+
+bool RulesTable::GetDrawableScales(uint32_t type, uint32_t & scales) const
+{
+  auto const it = m_rows.find(type);
+  if (it == m_rows.end())
+    return false;
+
+  scales = it->second == kEmptyRow ? 0 : m_drawableScales[it->second];
+  return true;
+}
+
+bool RulesTable::GetScalesOfRules(uint32_t type, feature::EGeomType geomType, uint32_t ruleTypes,
+                                  uint32_t & scales) const
+{
+  if (geomType < 0 || geomType >= kNumGeomTypes)
+    return false;
+
+  auto const it = m_rows.find(type);
+  if (it == m_rows.end())
+    return false;
+
+  scales = 0;
+  if (it->second == kEmptyRow)
+    return true;
+
+  size_t const first =
+      (static_cast<size_t>(it->second) * kNumGeomTypes + geomType) * count_of_rules;
+  ASSERT_LESS_OR_EQUAL(first + count_of_rules, m_scalesOfRules.size(), ());
+  for (int t = 0; t < count_of_rules; ++t)
+  {
+    if (ruleTypes & (1U << t))
+      scales |= m_scalesOfRules[first + t];
+  }
+  return true;
+}
+}  // namespace drule
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "indexer/drawing_rule_def.hpp"
+#include "indexer/feature_decl.hpp"
+#include "indexer/scales.hpp"
+
+#include "std/cstdint.hpp"
+#include "std/unordered_map.hpp"
+#include "std/vector.hpp"
+
+class Classificator;
+
+namespace drule
+{
+class RulesHolder;
+
+// A flattened table of the drawing rules of the classificator types
+// by scales and geometry types. It's built once when the drawing rules
+// are loaded (see RulesHolder::LoadFromBinaryProto()), so the rules of
+// a feature type are found without the walk over the classificator
+// tree and the filtering of ClassifObject::GetSuitable(). The table
+// also knows which rules have runtime selectors, so the selectors are
+// tested only for the types which need them. Masks of the scales where
+// the types are drawable are kept too, so the checks of the visibility
+// of features are bit operations.
+class RulesTable
+{
+public:
+  void Build(Classificator const & c, RulesHolder const & rules);
+  void Clear();
+
+  inline bool IsEmpty() const { return m_rows.empty(); }
+
+  // Appends to |keys| the rules of |type| which are suitable for
+  // |scale| and |geomType|, the same rules as
+  // ClassifObject::GetSuitable() appends. Raises |hasSelectors| when
+  // some of the appended rules have runtime selectors. Returns false
+  // when there's no |type| in the table.
+  bool GetSuitable(uint32_t type, int scale, feature::EGeomType geomType, KeysT & keys,
+                   bool & hasSelectors) const;
+
+  // Writes to |scales| the mask of the scales where |type| is drawable,
+  // bit i is set when ClassifObject::IsDrawable(i) is true. Returns false
+  // when there's no |type| in the table.
+  bool GetDrawableScales(uint32_t type, uint32_t & scales) const;
+
+  // Writes to |scales| the mask of the scales where |type| has suitable
+  // rules of the types of |ruleTypes|, bit t of |ruleTypes| stands for
+  // rule_type_t t. Returns false when there's no |type| in the table.
+  bool GetScalesOfRules(uint32_t type, feature::EGeomType geomType, uint32_t ruleTypes,
+                        uint32_t & scales) const;
+
+private:
+  static int constexpr kNumScales = scales::UPPER_STYLE_SCALE + 1;
+  static int constexpr kNumGeomTypes = 3;
+  static uint32_t constexpr kEmptyRow = 0xFFFFFFFF;
+
+  static_assert(kNumScales <= 32, "Masks of scales don't fit uint32_t.");
+
+  static size_t GetBucket(uint32_t row, int scale, int geomType)
+  {
+    return (static_cast<size_t>(row) * kNumScales + scale) * kNumGeomTypes + geomType;
+  }
+
+  // Type -> row of the table, types without drawing rules are mapped
+  // to kEmptyRow.
+  unordered_map<uint32_t, uint32_t> m_rows;
+  // Keys of the bucket i = GetBucket(row, scale, geomType) are in
+  // [m_offsets[i], m_offsets[i + 1]).
+  vector<uint32_t> m_offsets;
+  vector<Key> m_keys;
+  // True when some of the rules of the bucket have runtime selectors.
+  vector<bool> m_selectors;
+  // Masks of the drawable scales by rows.
+  vector<uint32_t> m_drawableScales;
+  // Masks of the scales of the rules of the rule type t for the row r
+  // and the geometry type g are at (r * kNumGeomTypes + g) * count_of_rules + t.
+  vector<uint32_t> m_scalesOfRules;
+};
+}  // namespace drule
@@ -30,12 +30,13 @@ void FeatureBase::Deserialize(feature::LoaderBase * pLoader, TBuffer buffer)
   m_pLoader->Init(buffer);
 
   m_limitRect = m2::RectD::GetEmptyRect();
-  m_typesParsed = m_commonParsed = false;
+  m_typesParsed = m_commonParsed = m_namesParsed = false;
   m_header = m_pLoader->GetHeader();
 }
 
 void FeatureType::ApplyPatch(editor::XMLFeature const & xml)
 {
+  ParseNames();
   xml.ForEachName([this](string const & lang, string const & name)
                   {
                     m_params.name.AddString(lang, name);
@@ -85,6 +86,7 @@ void FeatureType::ReplaceBy(osm::EditableMapObject const & emo)
   }
 
   m_params.name = emo.GetName();
+  m_namesParsed = true;
   string const & house = emo.GetHouseNumber();
   if (house.empty())
     m_params.house.Clear();
@@ -193,6 +195,7 @@ bool FeatureType::FromXML(editor::XMLFeature const & xml)
   {
     m_params.name.AddString(lang, name);
   });
+  m_namesParsed = true;
 
   string const house = xml.GetHouse();
   if (!house.empty())
@@ -259,6 +262,26 @@ void FeatureBase::ParseCommon() const
   }
 }
 
+void FeatureBase::ParseNames() const
+{
+  if (!m_namesParsed)
+  {
+    ParseCommon();
+
+    m_pLoader->ParseNames();
+    m_namesParsed = true;
+  }
+}
+
+bool FeatureBase::GetUnparsedNames(char const *& data, size_t & size) const
+{
+  if (m_namesParsed)
+    return false;
+
+  ParseCommon();
+  return m_pLoader->GetNamesBuffer(data, size);
+}
+
 feature::EGeomType FeatureBase::GetFeatureType() const
 {
   switch (Header() & HEADER_GEOTYPE_MASK)
@@ -271,7 +294,7 @@ feature::EGeomType FeatureBase::GetFeatureType() const
 
 string FeatureBase::DebugString() const
 {
-  ParseCommon();
+  ParseNames();
 
   Classificator const & c = classif();
 
@@ -303,6 +326,7 @@ void FeatureType::ParseEverything() const
 {
   // Also calls ParseCommon() and ParseTypes().
   ParseHeader2();
+  ParseNames();
   ParseGeometry(FeatureType::BEST_GEOMETRY);
   ParseTriangles(FeatureType::BEST_GEOMETRY);
   ParseMetadata();
@@ -369,12 +393,14 @@ void FeatureType::ParseMetadata() const
 
 StringUtf8Multilang const & FeatureType::GetNames() const
 {
+  ParseNames();
   return m_params.name;
 }
 
 void FeatureType::SetNames(StringUtf8Multilang const & newNames)
 {
   m_params.name.Clear();
+  m_namesParsed = true;
   // Validate passed string to clean up empty names (if any).
   newNames.ForEach([this](int8_t langCode, string const & name) -> bool
   {
@@ -575,8 +601,17 @@ bool FeatureType::GetName(int8_t lang, string & name) const
   if (!HasName())
     return false;
 
-  ParseCommon();
-  return m_params.name.GetString(lang, name);
+  bool found = false;
+  ForEachNameRef([&](int8_t l, char const * s, size_t size)
+  {
+    if (l != lang)
+      return true;
+
+    name.assign(s, size);
+    found = true;
+    return false;
+  });
+  return found;
 }
 
 uint8_t FeatureType::GetRank() const
@@ -47,6 +47,7 @@ public:
   //@{
   void ParseTypes() const;
   void ParseCommon() const;
+  void ParseNames() const;
   //@}
 
   feature::EGeomType GetFeatureType() const;
@@ -95,11 +96,33 @@ public:
     if (!HasName())
       return false;
 
-    ParseCommon();
+    ParseNames();
     m_params.name.ForEach(forward<T>(fn));
     return true;
   }
 
+  /// Calls |fn(int8_t lang, char const * name, size_t size)| for every name without copying
+  /// of names. When names aren't parsed yet they are taken right from the record of the
+  /// feature, so they are valid while the feature can be parsed.
+  template <class T>
+  inline bool ForEachNameRef(T && fn) const
+  {
+    if (!HasName())
+      return false;
+
+    char const * data = nullptr;
+    size_t size = 0;
+    if (GetUnparsedNames(data, size))
+    {
+      StringUtf8Multilang::ForEachRef(data, size, fn);
+      return true;
+    }
+
+    ParseNames();
+    m_params.name.ForEachRef(fn);
+    return true;
+  }
+
   inline m2::RectD GetLimitRect() const
   {
     ASSERT ( m_limitRect.IsValid(), () );
@@ -135,6 +158,9 @@ protected:
   inline uint8_t Header() const { return m_header; }
 
 protected:
+  /// @return false if names are parsed already or aren't stored in the record.
+  bool GetUnparsedNames(char const *& data, size_t & size) const;
+
   feature::LoaderBase * m_pLoader;
 
   uint8_t m_header = 0;
@@ -149,6 +175,7 @@ protected:
 
   mutable bool m_typesParsed = false;
   mutable bool m_commonParsed = false;
+  mutable bool m_namesParsed = false;
 
   friend class feature::LoaderCurrent;
   friend class old_101::feature::LoaderImpl;
@@ -6,6 +6,10 @@
 
 #include "geometry/covering_utils.hpp"
 
+#include "std/algorithm.hpp"
+#include "std/array.hpp"
+#include "std/list.hpp"
+#include "std/mutex.hpp"
 #include "std/vector.hpp"
 
 
@@ -189,17 +193,111 @@ void AppendLowerLevels(RectId id, int cellDepth, IntervalsT & intervals)
   }
 }
 
+void AppendLowerLevelsSorted(vector<RectId> & ids, int cellDepth, IntervalsT & res)
+{
+  ASSERT(res.empty(), ());
+
+  // Cells numbers are in preorder, so a subtree is an interval of numbers, a cell goes before
+  // its subtree, and subtrees of cells which are not nested go in order of cells.
+  sort(ids.begin(), ids.end(), [cellDepth](RectId const & lhs, RectId const & rhs)
+  {
+    return lhs.ToInt64(cellDepth) < rhs.ToInt64(cellDepth);
+  });
+
+  auto const add = [&res](int64_t first, int64_t second)
+  {
+    ASSERT(res.empty() || res.back().first <= first, ());
+    if (!res.empty() && res.back().second >= first)
+      res.back().second = max(res.back().second, second);
+    else
+      res.emplace_back(first, second);
+  };
+
+  // An added ancestor for every level. Ancestors of an added ancestor are added too, so
+  // walking up from a cell stops at the first ancestor which is added already.
+  array<RectId, RectId::DEPTH_LEVELS> added;
+  array<bool, RectId::DEPTH_LEVELS> isAdded;
+  isAdded.fill(false);
+  array<int64_t, RectId::DEPTH_LEVELS> ancestors;
+  for (RectId const & id : ids)
+  {
+    int64_t const idInt64 = id.ToInt64(cellDepth);
+    // The cell is in a subtree of a previous cell.
+    if (!res.empty() && idInt64 < res.back().second)
+      continue;
+
+    size_t count = 0;
+    for (RectId ancestor = id; ancestor.Level() > 0;)
+    {
+      ancestor = ancestor.Parent();
+      int const level = ancestor.Level();
+      if (isAdded[level] && added[level] == ancestor)
+        break;
+      added[level] = ancestor;
+      isAdded[level] = true;
+      ancestors[count++] = ancestor.ToInt64(cellDepth);
+    }
+
+    // A new ancestor of the cell isn't an ancestor of previous cells, so it goes after them.
+    while (count > 0)
+    {
+      --count;
+      add(ancestors[count], ancestors[count] + 1);
+    }
+    add(idInt64, idInt64 + static_cast<int64_t>(id.SubTreeSize(cellDepth)));
+  }
+}
+
 void CoverViewportAndAppendLowerLevels(m2::RectD const & r, int cellDepth, IntervalsT & res)
 {
   vector<RectId> ids;
   ids.reserve(SPLIT_RECT_CELLS_COUNT);
   CoverRect<MercatorBounds, RectId>(r, SPLIT_RECT_CELLS_COUNT, cellDepth, ids);
 
-  IntervalsT intervals;
-  for (size_t i = 0; i < ids.size(); ++i)
-    AppendLowerLevels(ids[i], cellDepth, intervals);
+  AppendLowerLevelsSorted(ids, cellDepth, res);
+}
+
+void CoverViewportAndAppendLowerLevelsCached(m2::RectD const & r, int cellDepth, IntervalsT & res)
+{
+  // Rendering and search cover the same rects many times, e.g. for every mwm or tile
+  // read, so recently used coverings are kept.
+  size_t const kCacheSize = 32;
+
+  struct Entry
+  {
+    m2::RectD m_rect;
+    int m_cellDepth;
+    IntervalsT m_intervals;
+  };
+
+  static mutex cacheMutex;
+  static list<Entry> cache;
+
+  auto const sameRect = [&r](m2::RectD const & rect)
+  {
+    return rect.minX() == r.minX() && rect.minY() == r.minY() && rect.maxX() == r.maxX() &&
+           rect.maxY() == r.maxY();
+  };
+
+  {
+    lock_guard<mutex> lock(cacheMutex);
+    for (auto it = cache.begin(); it != cache.end(); ++it)
+    {
+      if (it->m_cellDepth == cellDepth && sameRect(it->m_rect))
+      {
+        cache.splice(cache.begin(), cache, it);
+        res = cache.front().m_intervals;
+        return;
+      }
+    }
+  }
+
+  CoverViewportAndAppendLowerLevels(r, cellDepth, res);
 
-  SortAndMergeIntervals(intervals, res);
+  lock_guard<mutex> lock(cacheMutex);
+  cache.push_front({r, cellDepth, res});
+  if (cache.size() > kCacheSize)
+    cache.pop_back();
 }
 
 RectId GetRectIdAsIs(m2::RectD const & r)
@@ -232,7 +330,7 @@ IntervalsT const & CoveringGetter::Get(int scale)
     switch (m_mode)
     {
     case ViewportWithLowLevels:
-      CoverViewportAndAppendLowerLevels(m_rect, cellDepth, m_res[ind]);
+      CoverViewportAndAppendLowerLevelsCached(m_rect, cellDepth, m_res[ind]);
       break;
 
     case LowLevelsOnly:
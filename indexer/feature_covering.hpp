@@ -21,10 +21,21 @@ namespace covering
 
   void AppendLowerLevels(RectId id, int cellDepth, IntervalsT & intervals);
 
+  // Appends intervals of subtrees of |ids| and their ancestors to |intervals|, which must
+  // be empty. Result is the same as of AppendLowerLevels() for every id followed by
+  // SortAndMergeIntervals(), but intervals are produced already sorted and merged.
+  // |ids| are sorted.
+  void AppendLowerLevelsSorted(vector<RectId> & ids, int cellDepth, IntervalsT & intervals);
+
   // Cover viewport with RectIds and append their RectIds as well.
   void CoverViewportAndAppendLowerLevels(m2::RectD const & rect, int cellDepth,
                                          IntervalsT & intervals);
 
+  // Same as CoverViewportAndAppendLowerLevels(), but recently used coverings are cached.
+  // *NOTE* This function is thread-safe.
+  void CoverViewportAndAppendLowerLevelsCached(m2::RectD const & rect, int cellDepth,
+                                               IntervalsT & intervals);
+
   // Given a vector of intervals [a, b), sort them and merge overlapping intervals.
   IntervalsT SortAndMergeIntervals(IntervalsT const & intervals);
 
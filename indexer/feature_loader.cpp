@@ -43,7 +43,15 @@ void LoaderCurrent::ParseCommon()
   ArrayByteSource source(DataPtr() + m_CommonOffset);
 
   uint8_t const h = Header();
-  m_pF->m_params.Read(source, h);
+
+  // Names are the biggest common field and they are often not needed, so they are
+  // skipped here and are parsed by ParseNames() on demand.
+  if (h & HEADER_HAS_NAME)
+  {
+    m_NamesOffset = CalcOffset(source);
+    source.Advance(ReadVarUint<uint32_t>(source) + 1);
+  }
+  m_pF->m_params.Read(source, h & ~HEADER_HAS_NAME);
 
   if (m_pF->GetFeatureType() == GEOM_POINT)
   {
@@ -54,6 +62,18 @@ void LoaderCurrent::ParseCommon()
   m_Header2Offset = CalcOffset(source);
 }
 
+void LoaderCurrent::ParseNames()
+{
+  if (m_NamesOffset == 0)
+  {
+    m_pF->m_params.name.Clear();
+    return;
+  }
+
+  ArrayByteSource source(DataPtr() + m_NamesOffset);
+  m_pF->m_params.name.Read(source);
+}
+
 namespace
 {
   class BitSource
@@ -24,6 +24,7 @@ namespace feature
     virtual uint8_t GetHeader() override;
     void ParseTypes() override;
     void ParseCommon() override;
+    void ParseNames() override;
     void ParseHeader2() override;
     uint32_t ParseGeometry(int scale) override;
     uint32_t ParseTriangles(int scale) override;
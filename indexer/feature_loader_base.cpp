@@ -80,6 +80,7 @@ void LoaderBase::Init(TBuffer data)
   m_pF = 0;
 
   m_CommonOffset = m_Header2Offset = 0;
+  m_NamesOffset = 0;
 
   ResetGeometry();
 }
@@ -92,6 +93,17 @@ void LoaderBase::ResetGeometry()
   m_trgOffsets.clear();
 }
 
+bool LoaderBase::GetNamesBuffer(char const *& data, size_t & size) const
+{
+  if (m_NamesOffset == 0)
+    return false;
+
+  ArrayByteSource source(DataPtr() + m_NamesOffset);
+  size = ReadVarUint<uint32_t>(source) + 1;
+  data = source.PtrC();
+  return true;
+}
+
 uint32_t LoaderBase::CalcOffset(ArrayByteSource const & source) const
 {
   return static_cast<uint32_t>(source.PtrC() - DataPtr());
@@ -75,6 +75,7 @@ namespace feature
 
     virtual void ParseTypes() = 0;
     virtual void ParseCommon() = 0;
+    virtual void ParseNames() = 0;
     virtual void ParseHeader2() = 0;
     virtual uint32_t ParseGeometry(int scale) = 0;
     virtual uint32_t ParseTriangles(int scale) = 0;
@@ -82,6 +83,10 @@ namespace feature
 
     inline uint32_t GetTypesSize() const { return m_CommonOffset - m_TypesOffset; }
 
+    /// Serialized names of the feature in the buffer, ParseCommon() must be called before.
+    /// @return false if the feature has no names.
+    bool GetNamesBuffer(char const *& data, size_t & size) const;
+
   protected:
     inline char const * DataPtr() const { return m_Data; }
 
@@ -106,6 +111,8 @@ namespace feature
 
     static uint32_t const m_TypesOffset = 1;
     uint32_t m_CommonOffset, m_Header2Offset;
+    /// Offset of names which are skipped by ParseCommon(), zero if there are no names.
+    uint32_t m_NamesOffset;
 
     uint32_t m_ptsSimpMask;
 
@@ -70,7 +70,7 @@ namespace
 
   public:
     DrawRuleGetter(int scale, EGeomType ft, drule::KeysT & keys)
-      : m_scale(scale), m_ft(ft), m_keys(keys)
+      : m_scale(min(scale, scales::GetUpperStyleScale())), m_ft(ft), m_keys(keys)
     {
     }
 
@@ -82,9 +82,21 @@ namespace
     bool operator() (ClassifObject const * p, bool & res)
     {
       res = true;
-      p->GetSuitable(min(m_scale, scales::GetUpperStyleScale()), m_ft, m_keys);
+      p->GetSuitable(m_scale, m_ft, m_keys);
       return false;
     }
+
+    // Appends the rules of |type|. Returns true when some of the rules
+    // may have runtime selectors.
+    bool Process(Classificator const & c, uint32_t type)
+    {
+      bool hasSelectors = false;
+      if (c.GetRulesTable().GetSuitable(type, m_scale, m_ft, m_keys, hasSelectors))
+        return hasSelectors;
+
+      (void)c.ProcessObjects(type, *this);
+      return true;
+    }
   };
 }
 
@@ -96,7 +108,28 @@ pair<int, bool> GetDrawRule(TypesHolder const & types, int level,
 
   DrawRuleGetter doRules(level, types.GetGeoType(), keys);
   for (uint32_t t : types)
-    (void)c.ProcessObjects(t, doRules);
+    (void)doRules.Process(c, t);
+
+  return make_pair(types.GetGeoType(), types.Has(c.GetCoastType()));
+}
+
+pair<int, bool> GetDrawRuleFilteredByRuntimeSelector(FeatureType const & f,
+                                                     TypesHolder const & types, int level,
+                                                     drule::KeysT & keys)
+{
+  ASSERT ( keys.empty(), () );
+  Classificator const & c = classif();
+
+  DrawRuleGetter doRules(level, types.GetGeoType(), keys);
+  bool hasSelectors = false;
+  for (uint32_t t : types)
+  {
+    if (doRules.Process(c, t))
+      hasSelectors = true;
+  }
+
+  if (hasSelectors)
+    FilterRulesByRuntimeSelector(f, level, keys);
 
   return make_pair(types.GetGeoType(), types.Has(c.GetCoastType()));
 }
@@ -111,7 +144,7 @@ void GetDrawRule(vector<uint32_t> const & types, int level, int geoType,
   DrawRuleGetter doRules(level, EGeomType(geoType), keys);
 
   for (uint32_t t : types)
-    (void)c.ProcessObjects(t, doRules);
+    (void)doRules.Process(c, t);
 }
 
 void FilterRulesByRuntimeSelector(FeatureType const & f, int zoomLevel, drule::KeysT & keys)
@@ -257,6 +290,62 @@ namespace
   }
 }
 
+namespace
+{
+  int constexpr kNumScales = scales::UPPER_STYLE_SCALE + 1;
+
+  // Mask of the scales where |type| is drawable, it's taken from the
+  // table of rules when the table is built.
+  uint32_t GetDrawableScales(Classificator const & c, uint32_t type)
+  {
+    uint32_t scales = 0;
+    if (c.GetRulesTable().GetDrawableScales(type, scales))
+      return scales;
+
+    ClassifObject const * p = c.GetObject(type);
+    ASSERT(p, ());
+    if (p == c.GetRoot())
+      return 0;
+
+    for (int scale = 0; scale < kNumScales; ++scale)
+    {
+      if (p->IsDrawable(scale))
+        scales |= 1U << scale;
+    }
+    return scales;
+  }
+
+  uint32_t GetDrawableScales(TypesHolder const & types)
+  {
+    Classificator const & c = classif();
+
+    uint32_t scales = 0;
+    for (uint32_t t : types)
+      scales |= GetDrawableScales(c, t);
+    return scales;
+  }
+
+  bool HasScale(uint32_t scales, int scale)
+  {
+    return 0 <= scale && scale < kNumScales && (scales & (1U << scale)) != 0;
+  }
+
+  /// @return [-1, -1] when there are no scales in |scales|.
+  pair<int, int> GetScalesRange(uint32_t scales)
+  {
+    if (scales == 0)
+      return make_pair(-1, -1);
+
+    int low = 0;
+    while (!HasScale(scales, low))
+      ++low;
+    int high = kNumScales - 1;
+    while (!HasScale(scales, high))
+      --high;
+    return make_pair(low, high);
+  }
+}
+
 bool RequireGeometryInIndex(FeatureBase const & f)
 {
   TypesHolder const types(f);
@@ -312,6 +401,9 @@ bool IsDrawableForIndexClassifOnly(FeatureBase const & f, int level)
 
   TypesHolder const types(f);
 
+  if (!c.GetRulesTable().IsEmpty())
+    return HasScale(GetDrawableScales(types), level);
+
   IsDrawableChecker doCheck(level);
   for (uint32_t t : types)
     if (c.ProcessObjects(t, doCheck))
@@ -351,9 +443,10 @@ bool RemoveNoDrawableTypes(vector<uint32_t> & types, EGeomType geomType, bool em
 int GetMinDrawableScale(FeatureBase const & f)
 {
   int const upBound = scales::GetUpperStyleScale();
+  uint32_t const scales = GetDrawableScales(TypesHolder(f));
 
   for (int level = 0; level <= upBound; ++level)
-    if (IsDrawableForIndex(f, level))
+    if (HasScale(scales, level) && IsDrawableForIndexGeometryOnly(f, level))
       return level;
 
   return -1;
@@ -362,9 +455,10 @@ int GetMinDrawableScale(FeatureBase const & f)
 int GetMinDrawableScaleClassifOnly(FeatureBase const & f)
 {
   int const upBound = scales::GetUpperStyleScale();
+  uint32_t const scales = GetDrawableScales(TypesHolder(f));
 
   for (int level = 0; level <= upBound; ++level)
-    if (IsDrawableForIndexClassifOnly(f, level))
+    if (HasScale(scales, level))
       return level;
 
   return -1;
@@ -411,6 +505,12 @@ namespace
 
 pair<int, int> GetDrawableScaleRange(uint32_t type)
 {
+  Classificator const & c = classif();
+
+  uint32_t scales = 0;
+  if (c.GetRulesTable().GetDrawableScales(type, scales))
+    return GetScalesRange(scales);
+
   DoGetScalesRange doGet;
   (void)classif().ProcessObjects(type, doGet);
   return doGet.GetScale();
@@ -439,10 +539,38 @@ namespace
 
     return false;
   }
+
+  // Writes to |scales| the mask of the scales where |types| have the
+  // rules, returns false when some of the types aren't in the table.
+  bool GetScalesOfRules(TypesHolder const & types, int rules, uint32_t & scales)
+  {
+    uint32_t ruleTypes = 0;
+    if (rules & RULE_CAPTION)
+      ruleTypes |= 1U << drule::caption;
+    if (rules & RULE_PATH_TEXT)
+      ruleTypes |= 1U << drule::pathtext;
+    if (rules & RULE_SYMBOL)
+      ruleTypes |= 1U << drule::symbol;
+
+    auto const & table = classif().GetRulesTable();
+    scales = 0;
+    for (uint32_t t : types)
+    {
+      uint32_t typeScales = 0;
+      if (!table.GetScalesOfRules(t, types.GetGeoType(), ruleTypes, typeScales))
+        return false;
+      scales |= typeScales;
+    }
+    return true;
+  }
 }
 
 pair<int, int> GetDrawableScaleRangeForRules(TypesHolder const & types, int rules)
 {
+  uint32_t scales = 0;
+  if (GetScalesOfRules(types, rules, scales))
+    return GetScalesRange(scales);
+
   int const upBound = scales::GetUpperStyleScale();
   int lowL = -1;
   for (int level = 0; level <= upBound; ++level)
@@ -66,6 +66,11 @@ namespace feature
   void GetDrawRule(vector<uint32_t> const & types, int level, int geoType,
                    drule::KeysT & keys);
   void FilterRulesByRuntimeSelector(FeatureType const & f, int zoomLevel, drule::KeysT & keys);
+  /// The same as GetDrawRule() followed by FilterRulesByRuntimeSelector(), but
+  /// runtime selectors are tested only when the rules of |types| have them.
+  pair<int, bool> GetDrawRuleFilteredByRuntimeSelector(FeatureType const & f,
+                                                       TypesHolder const & types, int level,
+                                                       drule::KeysT & keys);
 
   /// Used to check whether user types belong to particular classificator set.
   class TypeSetChecker
@@ -0,0 +1,126 @@
+#include "indexer/features_cache.hpp"
+
+#include "base/assert.hpp"
+
+#include <algorithm>
+#include <functional>
+
+using namespace std;
+
+namespace
+{
+// The fixed part of a feature, a node of the list and an entry of the index.
+// Names and metadata which are allocated by features aren't counted.
+size_t constexpr kBytesPerFeature = sizeof(FeatureType) + sizeof(FeatureID) + 5 * sizeof(void *);
+}  // namespace
+
+FeaturesCache::FeaturesCache(size_t maxFeaturesCount, size_t shardsCount)
+  : m_maxShardSize(max(maxFeaturesCount / max(shardsCount, size_t(1)), size_t(1)))
+  , m_shards(max(shardsCount, size_t(1)))
+{
+}
+
+bool FeaturesCache::Get(FeatureID const & id, FeatureType & ft)
+{
+  Shard & shard = GetShard(id);
+  lock_guard<mutex> lock(shard.m_mutex);
+
+  auto const it = shard.m_index.find(id);
+  if (it == shard.m_index.end())
+    return false;
+
+  if (!id.m_mwmId.IsAlive())
+  {
+    shard.m_features.erase(it->second);
+    shard.m_index.erase(it);
+    shard.UpdateMemory();
+    return false;
+  }
+
+  shard.m_features.splice(shard.m_features.begin(), shard.m_features, it->second);
+  ft = *it->second;
+  return true;
+}
+
+void FeaturesCache::Put(FeatureType const & ft)
+{
+  FeatureID const & id = ft.GetID();
+  ASSERT(id.IsValid(), ());
+
+  Shard & shard = GetShard(id);
+  lock_guard<mutex> lock(shard.m_mutex);
+
+  auto const it = shard.m_index.find(id);
+  if (it != shard.m_index.end())
+  {
+    *it->second = ft;
+    shard.m_features.splice(shard.m_features.begin(), shard.m_features, it->second);
+    return;
+  }
+
+  if (shard.m_features.size() >= m_maxShardSize)
+  {
+    shard.m_index.erase(shard.m_features.back().GetID());
+    shard.m_features.pop_back();
+  }
+
+  shard.m_features.push_front(ft);
+  shard.m_index.emplace(id, shard.m_features.begin());
+  shard.UpdateMemory();
+}
+
+void FeaturesCache::RemoveDeregistered()
+{
+  for (auto & shard : m_shards)
+  {
+    lock_guard<mutex> lock(shard.m_mutex);
+    for (auto it = shard.m_features.begin(); it != shard.m_features.end();)
+    {
+      if (it->GetID().m_mwmId.IsAlive())
+      {
+        ++it;
+        continue;
+      }
+
+      shard.m_index.erase(it->GetID());
+      it = shard.m_features.erase(it);
+    }
+    shard.UpdateMemory();
+  }
+}
+
+void FeaturesCache::Clear()
+{
+  for (auto & shard : m_shards)
+  {
+    lock_guard<mutex> lock(shard.m_mutex);
+    shard.m_index.clear();
+    shard.m_features.clear();
+    shard.UpdateMemory();
+  }
+}
+
+size_t FeaturesCache::GetSize() const
+{
+  size_t size = 0;
+  for (auto const & shard : m_shards)
+  {
+    lock_guard<mutex> lock(shard.m_mutex);
+    size += shard.m_features.size();
+  }
+  return size;
+}
+
+size_t FeaturesCache::FeatureIDHash::operator()(FeatureID const & id) const
+{
+  size_t const mwmHash = hash<MwmInfo const *>()(id.m_mwmId.GetInfo().get());
+  return mwmHash ^ (hash<uint32_t>()(id.m_index) + 0x9e3779b9 + (mwmHash << 6) + (mwmHash >> 2));
+}
+
+void FeaturesCache::Shard::UpdateMemory() { m_memory.Set(m_features.size() * kBytesPerFeature); }
+
+FeaturesCache::Shard & FeaturesCache::GetShard(FeatureID const & id)
+{
+  // Neighbouring features of an mwm are spread among all shards.
+  return m_shards[FeatureIDHash()(id) % m_shards.size()];
+}
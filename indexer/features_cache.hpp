@@ -0,0 +1,62 @@
+#pragma once
+
+#include "indexer/feature.hpp"
+#include "indexer/feature_decl.hpp"
+#include "indexer/mwm_set.hpp"
+
+#include "base/memory_counters.hpp"
+
+#include <cstddef>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+/// Thread-safe LRU cache of features which are parsed completely by
+/// FeatureType::ParseEverything(), so they don't need loaders of their mwms anymore.
+/// Features are distributed among shards by ids, every shard has its own lock,
+/// so threads which read different features seldom wait for each other.
+/// Features of mwms which aren't alive are never returned.
+class FeaturesCache
+{
+public:
+  FeaturesCache(size_t maxFeaturesCount, size_t shardsCount = 16);
+
+  /// \returns false if there is no feature with |id| in the cache.
+  bool Get(FeatureID const & id, FeatureType & ft);
+
+  /// |ft| must be parsed completely and must have a valid id.
+  void Put(FeatureType const & ft);
+
+  /// Removes features of mwms which aren't alive.
+  void RemoveDeregistered();
+
+  void Clear();
+
+  size_t GetSize() const;
+
+private:
+  struct FeatureIDHash
+  {
+    size_t operator()(FeatureID const & id) const;
+  };
+
+  struct Shard
+  {
+    using TList = std::list<FeatureType>;
+
+    mutable std::mutex m_mutex;
+    // The most recently used features are at the front.
+    TList m_features;
+    std::unordered_map<FeatureID, TList::iterator, FeatureIDHash> m_index;
+    base::MemoryCounter m_memory{"indexer.features_cache"};
+
+    /// Reports the memory of features to base::MemoryCounters, it's called under |m_mutex|.
+    void UpdateMemory();
+  };
+
+  Shard & GetShard(FeatureID const & id);
+
+  size_t const m_maxShardSize;
+  std::vector<Shard> m_shards;
+};
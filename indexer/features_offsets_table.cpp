@@ -12,6 +12,7 @@
 #include "base/logging.hpp"
 #include "base/scope_guard.hpp"
 
+#include "std/algorithm.hpp"
 #include "std/string.hpp"
 
 
@@ -148,6 +149,33 @@ namespace feature
     return static_cast<uint32_t>(m_table.select(index));
   }
 
+  void FeaturesOffsetsTable::GetFeatureOffsets(vector<uint32_t> const & indices,
+                                               vector<uint32_t> & offsets) const
+  {
+    ASSERT(is_sorted(indices.begin(), indices.end()), ());
+    offsets.resize(indices.size());
+
+    size_t i = 0;
+    while (i < indices.size())
+    {
+      ASSERT_LESS(indices[i], size(), ("Index out of bounds", indices[i], size()));
+      succinct::elias_fano::select_enumerator it(m_table, indices[i]);
+      uint32_t index = indices[i];
+      uint32_t offset = static_cast<uint32_t>(it.next());
+      offsets[i++] = offset;
+
+      for (; i < indices.size() && indices[i] <= index + 1; ++i)
+      {
+        if (indices[i] != index)
+        {
+          offset = static_cast<uint32_t>(it.next());
+          index = indices[i];
+        }
+        offsets[i] = offset;
+      }
+    }
+  }
+
   size_t FeaturesOffsetsTable::GetFeatureIndexbyOffset(uint32_t offset) const
   {
     ASSERT_GREATER(size(), 0, ("We must not ask empty table"));
@@ -155,17 +183,13 @@ namespace feature
                                                      m_table.select(size() - 1)));
     ASSERT_GREATER_OR_EQUAL(offset, m_table.select(0), ("Offset out of bounds", offset,
                                                         m_table.select(size() - 1)));
-    //Binary search in elias_fano list
-    size_t leftBound = 0, rightBound = size();
-    while (leftBound + 1 < rightBound) {
-      size_t middle = leftBound + (rightBound - leftBound) / 2;
-      if (m_table.select(middle) <= offset)
-        leftBound = middle;
-      else
-        rightBound = middle;
-    }
-    ASSERT_EQUAL(offset, m_table.select(leftBound), ("Can't find offset", offset, "in the table"));
-    return leftBound;
+    // The rank is the index of the first offset which is not less than |offset|, it's
+    // found by one pass over the upper bits instead of a binary search over all offsets.
+    // The last offset is equal to the universe of the table and is out of the rank's range.
+    size_t const index = offset < m_table.size() ? static_cast<size_t>(m_table.rank(offset))
+                                                 : size() - 1;
+    ASSERT_EQUAL(offset, m_table.select(index), ("Can't find offset", offset, "in the table"));
+    return index;
   }
 
   bool BuildOffsetsTable(string const & filePath)
@@ -82,6 +82,11 @@ namespace feature
     /// \return offset a feature
     uint32_t GetFeatureOffset(size_t index) const;
 
+    /// \param indices sorted indices of features
+    /// \param offsets offsets of features, runs of consecutive indices
+    ///        are decoded by one pass over the table
+    void GetFeatureOffsets(vector<uint32_t> const & indices, vector<uint32_t> & offsets) const;
+
     /// \param offset offset of a feature
     /// \return index of a feature
     size_t GetFeatureIndexbyOffset(uint32_t offset) const;
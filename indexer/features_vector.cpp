@@ -5,13 +5,85 @@
 #include "platform/constants.hpp"
 #include "platform/mwm_version.hpp"
 
+#include "std/algorithm.hpp"
+#include "std/iterator.hpp"
+
+#include "defines.hpp"
+
+// static
+size_t constexpr FeaturesVector::kCachedBlocksCount;
+
+FeaturesVector::FeaturesVector(FilesContainerR const & cont, feature::DataHeader const & header,
+                               feature::FeaturesOffsetsTable const * table)
+  : m_LoadInfo(cont, header), m_table(table)
+{
+  if (cont.IsExist(COMPRESSED_DATA_FILE_TAG))
+  {
+    m_compressed = make_unique<feature::CompressedFeaturesData>(
+        cont.GetReader(COMPRESSED_DATA_FILE_TAG));
+  }
+  else
+  {
+    m_RecordReader = make_unique<TRecordReader>(m_LoadInfo.GetDataReader(), 256);
+  }
+}
+
+FeaturesVector::~FeaturesVector() {}
 
 void FeaturesVector::GetByIndex(uint32_t index, FeatureType & ft) const
 {
-  uint32_t offset = 0, size = 0;
   auto const ftOffset = m_table ? m_table->GetFeatureOffset(index) : index;
-  m_RecordReader.ReadRecord(ftOffset, m_buffer, offset, size);
-  ft.Deserialize(m_LoadInfo.GetLoader(), &m_buffer[offset]);
+  if (m_RecordReader)
+  {
+    uint32_t offset = 0, size = 0;
+    m_RecordReader->ReadRecord(ftOffset, m_buffer, offset, size);
+    ft.Deserialize(m_LoadInfo.GetLoader(), &m_buffer[offset]);
+    return;
+  }
+
+  uint32_t blockOffset = 0;
+  vector<char> const & block = GetBlock(static_cast<uint32_t>(ftOffset), blockOffset);
+  ArrayByteSource src(block.data() + (ftOffset - blockOffset));
+  uint32_t const size = ReadVarUint<uint32_t>(src);
+  ASSERT_LESS_OR_EQUAL(src.PtrC() + size, block.data() + block.size(), ());
+
+  // The block may be evicted from the cache while the feature is used.
+  m_buffer.assign(src.PtrC(), src.PtrC() + size);
+  ft.Deserialize(m_LoadInfo.GetLoader(), m_buffer.data());
+}
+
+vector<char> const & FeaturesVector::GetBlock(uint32_t offset, uint32_t & blockOffset) const
+{
+  uint32_t const block = m_compressed->GetBlockByOffset(offset);
+  blockOffset = m_compressed->GetBlockOffset(block);
+
+  auto const it = find_if(m_blocks.begin(), m_blocks.end(),
+                          [block](pair<uint32_t, vector<char>> const & p)
+                          {
+                            return p.first == block;
+                          });
+  if (it != m_blocks.end())
+  {
+    m_blocks.splice(m_blocks.begin(), m_blocks, it);
+    return m_blocks.front().second;
+  }
+
+  if (m_blocks.size() >= kCachedBlocksCount)
+    m_blocks.splice(m_blocks.begin(), m_blocks, prev(m_blocks.end()));
+  else
+    m_blocks.emplace_front();
+
+  try
+  {
+    m_compressed->ReadBlock(block, m_blocks.front().second);
+  }
+  catch (Reader::Exception const &)
+  {
+    m_blocks.pop_front();
+    throw;
+  }
+  m_blocks.front().first = block;
+  return m_blocks.front().second;
 }
 
 size_t FeaturesVector::GetNumFeatures() const
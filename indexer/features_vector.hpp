@@ -1,9 +1,16 @@
 #pragma once
 #include "feature.hpp"
 #include "feature_loader_base.hpp"
+#include "compressed_features_data.hpp"
 
 #include "coding/var_record_reader.hpp"
+#include "coding/varint.hpp"
 
+#include "std/algorithm.hpp"
+#include "std/exception.hpp"
+#include "std/list.hpp"
+#include "std/thread.hpp"
+#include "std/unique_ptr.hpp"
 
 namespace feature { class FeaturesOffsetsTable; }
 
@@ -15,10 +22,8 @@ class FeaturesVector
 
 public:
   FeaturesVector(FilesContainerR const & cont, feature::DataHeader const & header,
-                 feature::FeaturesOffsetsTable const * table)
-    : m_LoadInfo(cont, header), m_RecordReader(m_LoadInfo.GetDataReader(), 256), m_table(table)
-  {
-  }
+                 feature::FeaturesOffsetsTable const * table);
+  ~FeaturesVector();
 
   void GetByIndex(uint32_t index, FeatureType & ft) const;
 
@@ -27,7 +32,7 @@ public:
   template <class ToDo> void ForEach(ToDo && toDo) const
   {
     uint32_t index = 0;
-    m_RecordReader.ForEachRecord([&] (uint32_t pos, char const * data, uint32_t /*size*/)
+    ForEachRecord([&] (uint32_t pos, char const * data)
     {
       FeatureType ft;
       ft.Deserialize(m_LoadInfo.GetLoader(), data);
@@ -53,8 +58,49 @@ public:
 private:
   friend class FeaturesVectorTest;
 
+  using TRecordReader = VarRecordReader<FilesContainerR::TReader, &VarRecordSizeReaderVarint>;
+
+  // Number of decompressed blocks which are kept by the vector.
+  static size_t constexpr kCachedBlocksCount = 4;
+
+  template <class ToDo> void ForEachRecord(ToDo && toDo) const
+  {
+    if (m_RecordReader)
+    {
+      m_RecordReader->ForEachRecord([&] (uint32_t pos, char const * data, uint32_t /*size*/)
+      {
+        toDo(pos, data);
+      });
+      return;
+    }
+
+    vector<char> block;
+    for (uint32_t i = 0; i < m_compressed->GetBlocksCount(); ++i)
+    {
+      uint32_t const blockOffset = m_compressed->GetBlockOffset(i);
+      m_compressed->ReadBlock(i, block);
+
+      ArrayByteSource src(block.data());
+      while (src.PtrC() < block.data() + block.size())
+      {
+        uint32_t const pos = blockOffset + static_cast<uint32_t>(src.PtrC() - block.data());
+        uint32_t const size = ReadVarUint<uint32_t>(src);
+        toDo(pos, src.PtrC());
+        src.Advance(size);
+      }
+    }
+  }
+
+  // Returns the decompressed block which contains the record at |offset| and the
+  // offset of the block in the uncompressed data.
+  vector<char> const & GetBlock(uint32_t offset, uint32_t & blockOffset) const;
+
   feature::SharedLoadInfo m_LoadInfo;
-  VarRecordReader<FilesContainerR::TReader, &VarRecordSizeReaderVarint> m_RecordReader;
+  // Exactly one of the readers is set, depending on the sections of the mwm.
+  unique_ptr<TRecordReader> m_RecordReader;
+  unique_ptr<feature::CompressedFeaturesData> m_compressed;
+  // The most recently used blocks of |m_compressed| are at the front.
+  mutable list<pair<uint32_t, vector<char>>> m_blocks;
   mutable vector<char> m_buffer;
   feature::FeaturesOffsetsTable const * m_table;
 };
@@ -77,3 +123,58 @@ public:
   feature::DataHeader const & GetHeader() const { return m_header; }
   FeaturesVector const & GetVector() const { return m_vector; }
 };
+
+/// Calls |toDo(ft, index)| for all features of the mwm at |filePath| from |threadsCount|
+/// threads, so |toDo| must be thread-safe. Features are split into consecutive ranges of
+/// indices and every range is read by its own FeaturesVectorTest, since readers of a container
+/// can't be shared between threads. Without the offsets table features are read one by one
+/// on the calling thread. The first exception of the threads is rethrown.
+template <class ToDo>
+void ForEachFeatureParallel(string const & filePath, size_t threadsCount, ToDo && toDo)
+{
+  FeaturesVectorTest const features(filePath);
+  size_t const featuresCount = features.GetVector().GetNumFeatures();
+  threadsCount = min(threadsCount, featuresCount);
+  if (threadsCount <= 1)
+  {
+    features.GetVector().ForEach(toDo);
+    return;
+  }
+
+  vector<std::exception_ptr> errors(threadsCount);
+  {
+    vector<thread> threads;
+    for (size_t i = 0; i < threadsCount; ++i)
+    {
+      uint32_t const begin = static_cast<uint32_t>(featuresCount * i / threadsCount);
+      uint32_t const end = static_cast<uint32_t>(featuresCount * (i + 1) / threadsCount);
+      threads.emplace_back([&, i, begin, end]()
+      {
+        try
+        {
+          FeaturesVectorTest const rangeFeatures(filePath);
+          for (uint32_t index = begin; index < end; ++index)
+          {
+            FeatureType ft;
+            rangeFeatures.GetVector().GetByIndex(index, ft);
+            ft.SetID(FeatureID(MwmSet::MwmId(), index));
+            toDo(ft, index);
+          }
+        }
+        catch (...)
+        {
+          errors[i] = std::current_exception();
+        }
+      });
+    }
+
+    for (auto & t : threads)
+      t.join();
+  }
+
+  for (auto const & e : errors)
+  {
+    if (e)
+      std::rethrow_exception(e);
+  }
+}
@@ -1,6 +1,7 @@
 #include "indexer/geometry_coding.hpp"
 
 #include "base/assert.hpp"
+#include "base/buffer_vector.hpp"
 #include "base/stl_add.hpp"
 
 #include "std/complex.hpp"
@@ -18,6 +19,25 @@ namespace
     return m2::PointU(static_cast<uvalue_t>(my::clamp(point.x, 0.0, static_cast<double>(maxPoint.x))),
                       static_cast<uvalue_t>(my::clamp(point.y, 0.0, static_cast<double>(maxPoint.y))));
   }
+
+  typedef buffer_vector<m2::PointU, 32> DiffsT;
+
+  void DecodeDiffs(geo_coding::InDeltasT const & deltas, DiffsT & diffs)
+  {
+    diffs.resize(deltas.size());
+    if (!deltas.empty())
+      DecodeDeltas(&deltas[0], deltas.size(), 0 /* lowBits */, &diffs[0]);
+  }
+}
+
+void DecodeDeltas(uint64_t const * deltas, size_t count, uint8_t lowBits, m2::PointU * diffs)
+{
+  for (size_t i = 0; i < count; ++i)
+  {
+    uint32_t x, y;
+    bits::BitwiseSplit(deltas[i] >> lowBits, x, y);
+    diffs[i] = m2::PointU(bits::ZigZagDecode(x), bits::ZigZagDecode(y));
+  }
 }
 
 m2::PointU PredictPointInPolyline(m2::PointU const & maxPoint,
@@ -110,12 +130,15 @@ void DecodePolylinePrev1(InDeltasT const & deltas,
                          m2::PointU const & /*maxPoint*/,
                          OutPointsT & points)
 {
-  size_t const count = deltas.size();
+  DiffsT diffs;
+  DecodeDiffs(deltas, diffs);
+
+  size_t const count = diffs.size();
   if (count > 0)
   {
-    points.push_back(DecodeDelta(deltas[0], basePoint));
+    points.push_back(basePoint + diffs[0]);
     for (size_t i = 1; i < count; ++i)
-      points.push_back(DecodeDelta(deltas[i], points.back()));
+      points.push_back(points.back() + diffs[i]);
   }
 }
 
@@ -145,18 +168,20 @@ void DecodePolylinePrev2(InDeltasT const & deltas,
                          m2::PointU const & maxPoint,
                          OutPointsT & points)
 {
-  size_t const count = deltas.size();
+  DiffsT diffs;
+  DecodeDiffs(deltas, diffs);
+
+  size_t const count = diffs.size();
   if (count > 0)
   {
-    points.push_back(DecodeDelta(deltas[0], basePoint));
+    points.push_back(basePoint + diffs[0]);
     if (count > 1)
     {
-      points.push_back(DecodeDelta(deltas[1], points.back()));
+      points.push_back(points.back() + diffs[1]);
       for (size_t i = 2; i < count; ++i)
       {
         size_t const n = points.size();
-        points.push_back(DecodeDelta(deltas[i],
-                                     PredictPointInPolyline(maxPoint, points[n-1], points[n-2])));
+        points.push_back(PredictPointInPolyline(maxPoint, points[n-1], points[n-2]) + diffs[i]);
       }
     }
   }
@@ -202,24 +227,26 @@ void DecodePolylinePrev3(InDeltasT const & deltas,
   ASSERT_LESS_OR_EQUAL(basePoint.x, maxPoint.x, (basePoint, maxPoint));
   ASSERT_LESS_OR_EQUAL(basePoint.y, maxPoint.y, (basePoint, maxPoint));
 
-  size_t const count = deltas.size();
+  DiffsT diffs;
+  DecodeDiffs(deltas, diffs);
+
+  size_t const count = diffs.size();
   if (count> 0)
   {
-    points.push_back(DecodeDelta(deltas[0], basePoint));
+    points.push_back(basePoint + diffs[0]);
     if (count > 1)
     {
       m2::PointU const pt0 = points.back();
-      points.push_back(DecodeDelta(deltas[1], pt0));
+      points.push_back(pt0 + diffs[1]);
       if (count > 2)
       {
-        points.push_back(DecodeDelta(deltas[2],
-                                     PredictPointInPolyline(maxPoint, points.back(), pt0)));
+        points.push_back(PredictPointInPolyline(maxPoint, points.back(), pt0) + diffs[2]);
         for (size_t i = 3; i < count; ++i)
         {
           size_t const n = points.size();
           m2::PointU const prediction =
               PredictPointInPolyline(maxPoint, points[n-1], points[n-2], points[n-3]);
-          points.push_back(DecodeDelta(deltas[i], prediction));
+          points.push_back(prediction + diffs[i]);
         }
       }
     }
@@ -254,21 +281,24 @@ void DecodeTriangleStrip(InDeltasT const & deltas,
                          m2::PointU const & maxPoint,
                          OutPointsT & points)
 {
-  size_t const count = deltas.size();
+  DiffsT diffs;
+  DecodeDiffs(deltas, diffs);
+
+  size_t const count = diffs.size();
   if (count > 0)
   {
     ASSERT_GREATER(count, 2, ());
 
-    points.push_back(DecodeDelta(deltas[0], basePoint));
-    points.push_back(DecodeDelta(deltas[1], points.back()));
-    points.push_back(DecodeDelta(deltas[2], points.back()));
+    points.push_back(basePoint + diffs[0]);
+    points.push_back(points.back() + diffs[1]);
+    points.push_back(points.back() + diffs[2]);
 
     for (size_t i = 3; i < count; ++i)
     {
       size_t const n = points.size();
       m2::PointU const prediction =
           PredictPointInTriangle(maxPoint, points[n-1], points[n-2], points[n-3]);
-      points.push_back(DecodeDelta(deltas[i], prediction));
+      points.push_back(prediction + diffs[i]);
     }
   }
 }
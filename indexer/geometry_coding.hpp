@@ -22,6 +22,11 @@ inline m2::PointU DecodeDelta(uint64_t delta, m2::PointU const & prediction)
   bits::BitwiseSplit(delta, x, y);
   return m2::PointU(prediction.x + bits::ZigZagDecode(x), prediction.y + bits::ZigZagDecode(y));
 }
+
+/// Batch version of DecodeDelta() which doesn't depend on predictions:
+/// DecodeDelta(deltas[i] >> lowBits, p) == p + diffs[i] for every i < count.
+/// Iterations are independent, so compilers vectorize the loop.
+void DecodeDeltas(uint64_t const * deltas, size_t count, uint8_t lowBits, m2::PointU * diffs);
 //@}
 
 
@@ -210,9 +210,14 @@ namespace serial
     size_t const count = deltas.size();
     ASSERT_GREATER ( count, 2, () );
 
-    points.push_back(DecodeDelta(deltas[0], basePoint));
-    points.push_back(DecodeDelta(deltas[1], points.back()));
-    points.push_back(DecodeDelta(deltas[2] >> 2, points.back()));
+    // Two low bits of all deltas but first two are bits of the tree of triangles.
+    pts::upoints_t diffs(count);
+    DecodeDeltas(&deltas[0], 2, 0 /* lowBits */, &diffs[0]);
+    DecodeDeltas(&deltas[2], count - 2, 2 /* lowBits */, &diffs[2]);
+
+    points.push_back(basePoint + diffs[0]);
+    points.push_back(points.back() + diffs[1]);
+    points.push_back(points.back() + diffs[2]);
 
     stack<size_t> st;
 
@@ -256,11 +261,10 @@ namespace serial
       // push points
       points.push_back(points[trg[0]]);
       points.push_back(points[trg[1]]);
-      points.push_back(DecodeDelta(deltas[i] >> 2,
-                                   PredictPointInTriangle(maxPoint,
-                                                          points[trg[0]],
-                                                          points[trg[1]],
-                                                          points[trg[2]])));
+      points.push_back(PredictPointInTriangle(maxPoint,
+                                              points[trg[0]],
+                                              points[trg[1]],
+                                              points[trg[2]]) + diffs[i]);
 
       // next step
       treeBits = deltas[i] & 3;
@@ -105,13 +105,13 @@ namespace serial
                  TPoints & points, size_t reserveF = 1)
   {
     uint32_t const count = ReadVarUint<uint32_t>(src);
-    vector<char> buffer(count);
-    char * p = &buffer[0];
+    buffer_vector<char, 256> buffer(count);
+    char * p = buffer.data();
     src.Read(p, count);
 
     DeltasT deltas;
     deltas.reserve(count / 2);
-    ReadVarUint64Array(p, p + count, MakeBackInsertFunctor(deltas));
+    ReadVarUint64Buffer(p, p + count, deltas);
 
     Decode(fn, deltas, params, points, reserveF);
   }
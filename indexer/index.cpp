@@ -1,14 +1,23 @@
 #include "indexer/index.hpp"
 
+#include "platform/constants.hpp"
 #include "platform/local_country_file_utils.hpp"
+#include "platform/platform.hpp"
 
 #include "indexer/rank_table.hpp"
 
 #include "coding/file_name_utils.hpp"
+#include "coding/file_reader.hpp"
+#include "coding/file_writer.hpp"
 #include "coding/internal/file_data.hpp"
+#include "coding/read_write_utils.hpp"
+#include "coding/varint.hpp"
+#include "coding/write_to_sink.hpp"
 
 #include "base/logging.hpp"
 
+#include "std/cstring.hpp"
+
 using platform::CountryFile;
 using platform::LocalCountryFile;
 
@@ -16,12 +25,50 @@ using platform::LocalCountryFile;
 // MwmValue implementation
 //////////////////////////////////////////////////////////////////////////////////
 
-MwmValue::MwmValue(LocalCountryFile const & localFile)
-  : m_cont(platform::GetCountryReader(localFile, MapOptions::Map)), m_file(localFile)
+namespace
+{
+unique_ptr<MmapReader> CreateMappedReader(LocalCountryFile const & localFile)
+{
+  // See LocalCountryFile comment for explanation.
+  if (localFile.GetDirectory().empty())
+    return nullptr;
+
+  string const path = localFile.GetPath(MapOptions::Map);
+  if (!Platform::IsFileExistsByFullPath(path))
+    return nullptr;
+
+  auto reader = make_unique<MmapReader>(path);
+  // Features and their geometry are read randomly, so read-ahead only wastes memory.
+  reader->Advise(MmapReader::Advice::Random);
+  return reader;
+}
+
+ModelReaderPtr CreateReader(LocalCountryFile const & localFile, unique_ptr<MmapReader> && mapped)
+{
+  if (mapped)
+    return ModelReaderPtr(move(mapped));
+  return platform::GetCountryReader(localFile, MapOptions::Map);
+}
+}  // namespace
+
+MwmValue::MwmValue(LocalCountryFile const & localFile, bool mapped)
+  : MwmValue(localFile, mapped ? CreateMappedReader(localFile) : nullptr)
+{
+}
+
+MwmValue::MwmValue(LocalCountryFile const & localFile, unique_ptr<MmapReader> && mapped)
+  : m_mappedReader(mapped.get()), m_cont(CreateReader(localFile, move(mapped))), m_file(localFile)
 {
   m_factory.Load(m_cont);
 }
 
+uint64_t MwmValue::GetMemoryUsage() const
+{
+  if (m_mappedReader)
+    return m_mappedReader->GetResidentBytes();
+  return static_cast<uint64_t>(1) << (READER_CHUNK_LOG_SIZE + READER_CHUNK_LOG_COUNT);
+}
+
 void MwmValue::SetTable(MwmInfoEx & info)
 {
   auto const version = GetHeader().GetFormat();
@@ -39,12 +86,123 @@ void MwmValue::SetTable(MwmInfoEx & info)
   }
 }
 
+void MwmValue::PrefetchFeatures(vector<uint32_t> const & indices) const
+{
+  ASSERT(is_sorted(indices.begin(), indices.end()), ());
+  // Ends of records aren't known without the offsets table. Compressed features data
+  // is read by blocks, so it's not prefetched.
+  if (!m_mappedReader || !m_table || indices.empty() || !m_cont.IsExist(DATA_FILE_TAG))
+    return;
+
+  // Records which are closer than |kMaxGap| are prefetched by one range.
+  uint64_t const kMaxGap = 16 * 1024;
+
+  // Offsets of records and of the next ones, which are their ends, are decoded at once.
+  vector<uint32_t> bounds;
+  bounds.reserve(2 * indices.size());
+  for (auto const index : indices)
+  {
+    bounds.push_back(index);
+    if (index + 1 < m_table->size())
+      bounds.push_back(index + 1);
+  }
+  my::SortUnique(bounds);
+  vector<uint32_t> offsets;
+  m_table->GetFeatureOffsets(bounds, offsets);
+
+  auto const section = m_cont.GetAbsoluteOffsetAndSize(DATA_FILE_TAG);
+  auto const getOffset = [&](uint32_t index) -> uint64_t
+  {
+    auto const it = lower_bound(bounds.begin(), bounds.end(), index);
+    ASSERT(it != bounds.end() && *it == index, ());
+    return offsets[distance(bounds.begin(), it)];
+  };
+  auto const getEnd = [&](uint32_t index) -> uint64_t
+  {
+    if (index + 1 < m_table->size())
+      return getOffset(index + 1);
+    return section.second;
+  };
+  auto const prefetch = [&](uint64_t begin, uint64_t end)
+  {
+    m_mappedReader->Advise(MmapReader::Advice::WillNeed, section.first + begin, end - begin);
+  };
+
+  uint64_t begin = getOffset(indices.front());
+  uint64_t end = getEnd(indices.front());
+  for (size_t i = 1; i < indices.size(); ++i)
+  {
+    uint64_t const offset = getOffset(indices[i]);
+    if (offset > end + kMaxGap)
+    {
+      prefetch(begin, end);
+      begin = offset;
+    }
+    end = max(end, getEnd(indices[i]));
+  }
+  prefetch(begin, end);
+}
+
 //////////////////////////////////////////////////////////////////////////////////
 // Index implementation
 //////////////////////////////////////////////////////////////////////////////////
 
+namespace
+{
+uint8_t constexpr kInfoSnapshotVersion = 0;
+
+// Coordinates are saved as is, so infos from snapshots are the same as read from mwms.
+template <typename TSink>
+void WriteDouble(TSink & sink, double d)
+{
+  static_assert(sizeof(double) == sizeof(uint64_t), "");
+  uint64_t bits;
+  memcpy(&bits, &d, sizeof(d));
+  WriteToSink(sink, bits);
+}
+
+template <typename TSource>
+double ReadDouble(TSource & src)
+{
+  uint64_t const bits = ReadPrimitiveFromSource<uint64_t>(src);
+  double d;
+  memcpy(&d, &bits, sizeof(d));
+  return d;
+}
+}  // namespace
+
 unique_ptr<MwmInfo> Index::CreateInfo(platform::LocalCountryFile const & localFile) const
 {
+  uint64_t fileSize = 0;
+  uint64_t fileTime = 0;
+  // See LocalCountryFile comment for explanation.
+  string const path = localFile.GetPath(MapOptions::Map);
+  if (!localFile.GetDirectory().empty() && Platform::GetFileSizeByFullPath(path, fileSize) &&
+      Platform::GetFileModificationTimeByFullPath(path, fileTime))
+  {
+    lock_guard<mutex> lock(m_infoSnapshotMutex);
+    auto const it = m_infoSnapshot.find(path);
+    if (it != m_infoSnapshot.end() && it->second.m_fileSize == fileSize &&
+        it->second.m_fileTime == fileTime)
+    {
+      InfoSnapshotEntry const & entry = it->second;
+      auto info = make_unique<MwmInfoEx>();
+      info->m_limitRect = entry.m_limitRect;
+      info->m_minScale = entry.m_minScale;
+      info->m_maxScale = entry.m_maxScale;
+      info->m_version = entry.m_version;
+      info->m_data = entry.m_data;
+      info->m_fileSize = fileSize;
+      info->m_fileTime = fileTime;
+      return unique_ptr<MwmInfo>(move(info));
+    }
+  }
+  else
+  {
+    fileSize = 0;
+    fileTime = 0;
+  }
+
   MwmValue value(localFile);
 
   feature::DataHeader const & h = value.GetHeader();
@@ -61,6 +219,8 @@ unique_ptr<MwmInfo> Index::CreateInfo(platform::LocalCountryFile const & localFi
   // Copying to drop the const qualifier.
   feature::RegionData regionData(value.GetRegionData());
   info->m_data = regionData;
+  info->m_fileSize = fileSize;
+  info->m_fileTime = fileTime;
 
   return unique_ptr<MwmInfo>(move(info));
 }
@@ -69,7 +229,7 @@ unique_ptr<MwmSet::MwmValueBase> Index::CreateValue(MwmInfo & info) const
 {
   // Create a section with rank table if it does not exist.
   platform::LocalCountryFile const & localFile = info.GetLocalFile();
-  unique_ptr<MwmValue> p(new MwmValue(localFile));
+  unique_ptr<MwmValue> p(new MwmValue(localFile, m_mapMwms));
   p->SetTable(dynamic_cast<MwmInfoEx &>(info));
   ASSERT(p->GetHeader().IsMWMSuitable(), ());
   return unique_ptr<MwmSet::MwmValueBase>(move(p));
@@ -80,14 +240,147 @@ pair<MwmSet::MwmId, MwmSet::RegResult> Index::RegisterMap(LocalCountryFile const
   return Register(localFile);
 }
 
+vector<pair<MwmSet::MwmId, MwmSet::RegResult>> Index::RegisterMaps(
+    vector<LocalCountryFile> const & localFiles, size_t threadsCount)
+{
+  return Register(localFiles, threadsCount);
+}
+
 bool Index::DeregisterMap(CountryFile const & countryFile) { return Deregister(countryFile); }
 
+bool Index::LoadInfoSnapshot(string const & path)
+{
+  if (!Platform::IsFileExistsByFullPath(path))
+    return false;
+
+  map<string, InfoSnapshotEntry> snapshot;
+  try
+  {
+    FileReader reader(path);
+    ReaderSource<FileReader> src(reader);
+
+    auto const version = ReadPrimitiveFromSource<uint8_t>(src);
+    if (version != kInfoSnapshotVersion)
+    {
+      LOG(LWARNING, ("Unknown version of mwms snapshot:", version));
+      return false;
+    }
+
+    uint32_t const count = ReadVarUint<uint32_t>(src);
+    for (uint32_t i = 0; i < count; ++i)
+    {
+      string filePath;
+      rw::Read(src, filePath);
+
+      InfoSnapshotEntry entry;
+      entry.m_fileSize = ReadVarUint<uint64_t>(src);
+      entry.m_fileTime = ReadVarUint<uint64_t>(src);
+      double const minX = ReadDouble(src);
+      double const minY = ReadDouble(src);
+      double const maxX = ReadDouble(src);
+      double const maxY = ReadDouble(src);
+      if (minX > maxX || minY > maxY)
+        MYTHROW(Reader::ReadException, ("Broken limit rect of", filePath));
+      entry.m_limitRect = m2::RectD(minX, minY, maxX, maxY);
+      entry.m_minScale = ReadPrimitiveFromSource<uint8_t>(src);
+      entry.m_maxScale = ReadPrimitiveFromSource<uint8_t>(src);
+      entry.m_version.SetFormat(static_cast<version::Format>(ReadPrimitiveFromSource<uint8_t>(src)));
+      entry.m_version.SetSecondsSinceEpoch(ReadVarUint<uint64_t>(src));
+      entry.m_data.Deserialize(src);
+      snapshot[filePath] = move(entry);
+    }
+  }
+  catch (RootException const & e)
+  {
+    LOG(LWARNING, ("Can't load mwms snapshot", path, e.Msg()));
+    return false;
+  }
+
+  lock_guard<mutex> lock(m_infoSnapshotMutex);
+  m_infoSnapshot.swap(snapshot);
+  return true;
+}
+
+bool Index::SaveInfoSnapshot(string const & path) const
+{
+  vector<shared_ptr<MwmInfo>> infos;
+  GetMwmsInfo(infos);
+
+  string const tmpPath = path + ".tmp";
+  try
+  {
+    FileWriter writer(tmpPath);
+    WriteToSink(writer, kInfoSnapshotVersion);
+
+    vector<MwmInfoEx const *> saved;
+    for (auto const & info : infos)
+    {
+      auto const & infoEx = static_cast<MwmInfoEx const &>(*info);
+      if (info->IsRegistered() && infoEx.m_fileTime != 0)
+        saved.push_back(&infoEx);
+    }
+
+    WriteVarUint(writer, static_cast<uint32_t>(saved.size()));
+    for (auto const info : saved)
+    {
+      rw::Write(writer, info->GetLocalFile().GetPath(MapOptions::Map));
+      WriteVarUint(writer, info->m_fileSize);
+      WriteVarUint(writer, info->m_fileTime);
+      WriteDouble(writer, info->m_limitRect.minX());
+      WriteDouble(writer, info->m_limitRect.minY());
+      WriteDouble(writer, info->m_limitRect.maxX());
+      WriteDouble(writer, info->m_limitRect.maxY());
+      WriteToSink(writer, info->m_minScale);
+      WriteToSink(writer, info->m_maxScale);
+      WriteToSink(writer, static_cast<uint8_t>(info->m_version.GetFormat()));
+      WriteVarUint(writer, info->m_version.GetSecondsSinceEpoch());
+      info->m_data.Serialize(writer);
+    }
+  }
+  catch (RootException const & e)
+  {
+    LOG(LWARNING, ("Can't save mwms snapshot", path, e.Msg()));
+    my::DeleteFileX(tmpPath);
+    return false;
+  }
+
+  return my::RenameFileX(tmpPath, path);
+}
+
+void Index::EnableFeaturesCache(size_t maxFeaturesCount)
+{
+  if (m_featuresCacheCleaner)
+    RemoveObserver(*m_featuresCacheCleaner);
+
+  m_featuresCacheShedding.reset();
+  m_featuresCache = make_unique<FeaturesCache>(maxFeaturesCount);
+  m_featuresCacheCleaner = make_unique<FeaturesCacheCleaner>(*m_featuresCache);
+  AddObserver(*m_featuresCacheCleaner);
+  m_featuresCacheShedding = make_unique<base::SheddableCache>(
+      "indexer.features_cache", base::CacheRegistry::Priority::Low,
+      [this]() { m_featuresCache->Clear(); });
+}
+
+void Index::LogMemoryUsage() const
+{
+  map<MwmId, uint64_t> usage;
+  GetCacheMemoryUsage(usage);
+
+  uint64_t total = 0;
+  for (auto const & mwm : usage)
+  {
+    LOG(LINFO, ("Mwm", mwm.first, "holds", mwm.second, "bytes"));
+    total += mwm.second;
+  }
+  LOG(LINFO, ("Cached mwms:", usage.size(), "total bytes:", total));
+}
+
 //////////////////////////////////////////////////////////////////////////////////
 // Index::FeaturesLoaderGuard implementation
 //////////////////////////////////////////////////////////////////////////////////
 
 Index::FeaturesLoaderGuard::FeaturesLoaderGuard(Index const & index, MwmId const & id)
-  : m_handle(index.GetMwmHandleById(id))
+  : m_handle(index.GetMwmHandleById(id)), m_cache(index.m_featuresCache.get())
 {
   if (!m_handle.IsAlive())
     return;
@@ -136,6 +429,29 @@ bool Index::FeaturesLoaderGuard::GetOriginalFeatureByIndex(uint32_t index, Featu
   return true;
 }
 
+bool Index::FeaturesLoaderGuard::GetParsedFeatureByIndex(uint32_t index, FeatureType & ft) const
+{
+  if (!m_handle.IsAlive())
+    return false;
+
+  // Features of Editor are parsed already.
+  MwmId const & id = m_handle.GetId();
+  if (m_editor.GetEditedFeature(id, index, ft))
+    return true;
+
+  FeatureID const fid(id, index);
+  if (m_cache != nullptr && m_cache->Get(fid, ft))
+    return true;
+
+  if (!GetOriginalFeatureByIndex(index, ft))
+    return false;
+
+  ft.ParseEverything();
+  if (m_cache != nullptr)
+    m_cache->Put(ft);
+  return true;
+}
+
 size_t Index::FeaturesLoaderGuard::GetNumFeatures() const
 {
   if (!m_handle.IsAlive())
@@ -2,6 +2,7 @@
 #include "indexer/cell_id.hpp"
 #include "indexer/data_factory.hpp"
 #include "indexer/feature_covering.hpp"
+#include "indexer/features_cache.hpp"
 #include "indexer/features_offsets_table.hpp"
 #include "indexer/features_vector.hpp"
 #include "indexer/mwm_set.hpp"
@@ -10,13 +11,20 @@
 #include "indexer/unique_index.hpp"
 
 #include "coding/file_container.hpp"
+#include "coding/mmap_reader.hpp"
 
 #include "defines.hpp"
 
+#include "base/cache_registry.hpp"
 #include "base/macros.hpp"
+#include "base/stl_add.hpp"
+#include "base/stl_helpers.hpp"
 
 #include "std/algorithm.hpp"
 #include "std/limits.hpp"
+#include "std/map.hpp"
+#include "std/mutex.hpp"
+#include "std/string.hpp"
 #include "std/utility.hpp"
 #include "std/vector.hpp"
 #include "std/weak_ptr.hpp"
@@ -36,10 +44,21 @@ private:
   // only in the MwmSet critical section, protected by a lock.  So,
   // there's an implicit synchronization on this field.
   weak_ptr<feature::FeaturesOffsetsTable> m_table;
+
+  // Size and modification time of the file when the info was read. Zero time means
+  // that the file isn't a regular one, and the info isn't saved to snapshots.
+  uint64_t m_fileSize = 0;
+  uint64_t m_fileTime = 0;
 };
 
 class MwmValue : public MwmSet::MwmValueBase
 {
+  // Not null when the mwm is mapped to memory, it's owned by |m_cont|,
+  // so it must be declared before |m_cont|.
+  MmapReader const * m_mappedReader;
+
+  MwmValue(platform::LocalCountryFile const & localFile, unique_ptr<MmapReader> && mapped);
+
 public:
   FilesContainerR const m_cont;
   IndexFactory m_factory;
@@ -47,9 +66,22 @@ public:
 
   shared_ptr<feature::FeaturesOffsetsTable> m_table;
 
-  explicit MwmValue(platform::LocalCountryFile const & localFile);
+  /// When |mapped| is true, all sections are read from the mwm mapped to memory.
+  /// Mwms which aren't regular files (e.g. in the apk) are read by file readers anyway.
+  explicit MwmValue(platform::LocalCountryFile const & localFile, bool mapped = false);
   void SetTable(MwmInfoEx & info);
 
+  inline bool IsMapped() const { return m_mappedReader != nullptr; }
+
+  /// MwmSet::MwmValueBase overrides:
+  /// Returns resident bytes of a mapped mwm and the capacity of
+  /// the reader's cache of pages otherwise.
+  uint64_t GetMemoryUsage() const override;
+
+  /// Hints the system to read records of features with sorted |indices|.
+  /// Close records are prefetched by one range. It's a no-op when the mwm isn't mapped.
+  void PrefetchFeatures(vector<uint32_t> const & indices) const;
+
   inline feature::DataHeader const & GetHeader() const { return m_factory.GetHeader(); }
   inline feature::RegionData const & GetRegionData() const { return m_factory.GetRegionData(); }
   inline version::MwmVersion const & GetMwmVersion() const { return m_factory.GetMwmVersion(); }
@@ -73,6 +105,10 @@ public:
   /// Registers a new map.
   pair<MwmId, RegResult> RegisterMap(platform::LocalCountryFile const & localFile);
 
+  /// Registers new maps reading their headers on |threadsCount| threads.
+  vector<pair<MwmId, RegResult>> RegisterMaps(
+      vector<platform::LocalCountryFile> const & localFiles, size_t threadsCount);
+
   /// Deregisters a map from internal records.
   ///
   /// \param countryFile A countryFile denoting a map to be deregistered.
@@ -80,14 +116,85 @@ public:
   ///         now, returns false.
   bool DeregisterMap(platform::CountryFile const & countryFile);
 
+  /// Enables the cache of completely parsed features which is used by
+  /// FeaturesLoaderGuard::GetParsedFeatureByIndex(). It's not synchronized,
+  /// so it must be called before features are read.
+  void EnableFeaturesCache(size_t maxFeaturesCount);
+
+  /// Opens mwms mapped to memory, see MwmValue. Together with
+  /// MwmSet::SetCacheBytesBudget() it bounds memory of mwms by bytes
+  /// instead of a count. Mwms are mapped read-only and shared, and search ranks
+  /// and centers of mapped mwms are used in place, so processes which serve the same
+  /// mwms share physical pages of them. It's not synchronized, so it must be called
+  /// before mwms are used.
+  void SetMwmsMapping(bool enable) { m_mapMwms = enable; }
+
+  /// Logs memory which is held by every mwm in the cache of mwms.
+  void LogMemoryUsage() const;
+
+  /// Snapshot of infos of registered mwms: paths, sizes and modification times of files
+  /// and fields of their headers. Mwms whose files are not changed since the snapshot
+  /// was saved are registered without opening them. The snapshot must be loaded before
+  /// maps are registered.
+  //@{
+  bool LoadInfoSnapshot(string const & path);
+  bool SaveInfoSnapshot(string const & path) const;
+  //@}
+
 private:
+  /// Drops features of deregistered mwms from the features cache.
+  class FeaturesCacheCleaner : public MwmSet::Observer
+  {
+  public:
+    explicit FeaturesCacheCleaner(FeaturesCache & cache) : m_cache(cache) {}
+
+    /// MwmSet::Observer overrides:
+    //@{
+    void OnMapUpdated(platform::LocalCountryFile const & /* newFile */,
+                      platform::LocalCountryFile const & /* oldFile */) override
+    {
+      m_cache.RemoveDeregistered();
+    }
+    void OnMapDeregistered(platform::LocalCountryFile const & /* localFile */) override
+    {
+      m_cache.RemoveDeregistered();
+    }
+    //@}
+
+  private:
+    FeaturesCache & m_cache;
+  };
+
+  struct InfoSnapshotEntry
+  {
+    uint64_t m_fileSize = 0;
+    uint64_t m_fileTime = 0;
+    m2::RectD m_limitRect;
+    uint8_t m_minScale = 0;
+    uint8_t m_maxScale = 0;
+    version::MwmVersion m_version;
+    feature::RegionData m_data;
+  };
+
+  unique_ptr<FeaturesCache> m_featuresCache;
+  unique_ptr<FeaturesCacheCleaner> m_featuresCacheCleaner;
+  unique_ptr<base::SheddableCache> m_featuresCacheShedding;
+  bool m_mapMwms = false;
+
+  // Maps paths of mwm files to their infos from the loaded snapshot.
+  map<string, InfoSnapshotEntry> m_infoSnapshot;
+  mutable mutex m_infoSnapshotMutex;
+
 
   template <typename F> class ReadMWMFunctor
   {
     F & m_f;
+    bool const m_batched;
     osm::Editor & m_editor = osm::Editor::Instance();
   public:
-    ReadMWMFunctor(F & f) : m_f(f) {}
+    /// When |batched| is true, features of an mwm are collected, sorted by their
+    /// offsets and prefetched before they are read.
+    ReadMWMFunctor(F & f, bool batched = false) : m_f(f), m_batched(batched) {}
 
     /// Used by Editor to inject new features.
     void operator()(FeatureType & feature)
@@ -117,36 +224,53 @@ private:
         ScaleIndex<ModelReaderPtr> index(pValue->m_cont.GetReader(INDEX_FILE_TAG),
                                          pValue->m_factory);
 
-        // iterate through intervals
-        CheckUniqueIndexes checkUnique(header.GetFormat() >= version::Format::v5);
         MwmId const & mwmID = handle.GetId();
+        auto const readFeature = [&](uint32_t index)
+        {
+          FeatureType feature;
+          switch (m_editor.GetFeatureStatus(mwmID, index))
+          {
+          case osm::Editor::FeatureStatus::Deleted:
+          case osm::Editor::FeatureStatus::Obsolete:
+            return;
+          case osm::Editor::FeatureStatus::Modified:
+            VERIFY(m_editor.GetEditedFeature(mwmID, index, feature), ());
+            m_f(feature);
+            return;
+          case osm::Editor::FeatureStatus::Created:
+            CHECK(false, ("Created features index should be generated."));
+          case osm::Editor::FeatureStatus::Untouched: break;
+          }
 
+          fv.GetByIndex(index, feature);
+          feature.SetID(FeatureID(mwmID, index));
+          m_f(feature);
+        };
+
+        if (m_batched)
+        {
+          // Records of features are stored in order of their indices,
+          // so the sorted indices are read sequentially.
+          vector<uint32_t> indices;
+          for (auto const & i : interval)
+            index.ForEachInIntervalAndScale(MakeBackInsertFunctor(indices), i.first, i.second, scale);
+          my::SortUnique(indices);
+
+          pValue->PrefetchFeatures(indices);
+          for (auto const i : indices)
+            readFeature(i);
+          return;
+        }
+
+        // iterate through intervals
+        CheckUniqueIndexes checkUnique(header.GetFormat() >= version::Format::v5);
         for (auto const & i : interval)
         {
           index.ForEachInIntervalAndScale(
               [&](uint32_t index)
               {
-                if (!checkUnique(index))
-                  return;
-
-                FeatureType feature;
-                switch (m_editor.GetFeatureStatus(mwmID, index))
-                {
-                case osm::Editor::FeatureStatus::Deleted:
-                case osm::Editor::FeatureStatus::Obsolete:
-                  return;
-                case osm::Editor::FeatureStatus::Modified:
-                  VERIFY(m_editor.GetEditedFeature(mwmID, index, feature), ());
-                  m_f(feature);
-                  return;
-                case osm::Editor::FeatureStatus::Created:
-                  CHECK(false, ("Created features index should be generated."));
-                case osm::Editor::FeatureStatus::Untouched: break;
-                }
-
-                fv.GetByIndex(index, feature);
-                feature.SetID(FeatureID(mwmID, index));
-                m_f(feature);
+                if (checkUnique(index))
+                  readFeature(index);
               },
               i.first, i.second, scale);
         }
@@ -214,6 +338,16 @@ public:
     ForEachInIntervals(implFunctor, covering::ViewportWithLowLevels, rect, scale);
   }
 
+  /// The same as ForEachInRect(), but features of every mwm are read in order of
+  /// their records and ranges of the records are prefetched when the mwm is mapped
+  /// (see SetMwmsMapping()). Editor's features are passed in the same way.
+  template <typename F>
+  void ForEachInRectBatched(F && f, m2::RectD const & rect, int scale) const
+  {
+    ReadMWMFunctor<F> implFunctor(f, true /* batched */);
+    ForEachInIntervals(implFunctor, covering::ViewportWithLowLevels, rect, scale);
+  }
+
   template <typename F>
   void ForEachFeatureIDInRect(F && f, m2::RectD const & rect, int scale) const
   {
@@ -288,11 +422,18 @@ public:
     /// Editor core only method, to get 'untouched', original version of feature.
     WARN_UNUSED_RESULT bool GetOriginalFeatureByIndex(uint32_t index, FeatureType & ft) const;
 
+    /// The same as GetFeatureByIndex() but the feature is parsed completely at the best
+    /// geometry. Original features are taken from the features cache of Index when it's
+    /// enabled. Edited features are always taken from Editor, so changes of Editor
+    /// don't make the cache stale.
+    WARN_UNUSED_RESULT bool GetParsedFeatureByIndex(uint32_t index, FeatureType & ft) const;
+
     size_t GetNumFeatures() const;
 
   private:
     MwmHandle m_handle;
     unique_ptr<FeaturesVector> m_vector;
+    FeaturesCache * m_cache;
     osm::Editor & m_editor = osm::Editor::Instance();
   };
 
@@ -18,6 +18,7 @@ SOURCES += \
     classificator.cpp \
     classificator_loader.cpp \
     coding_params.cpp \
+    compressed_features_data.cpp \
     cuisines.cpp \
     data_factory.cpp \
     data_header.cpp \
@@ -25,6 +26,7 @@ SOURCES += \
     drawing_rules.cpp \
     drules_selector.cpp \
     drules_selector_parser.cpp \
+    drules_table.cpp \
     editable_map_object.cpp \
     edits_migration.cpp \
     feature.cpp \
@@ -38,6 +40,7 @@ SOURCES += \
     feature_meta.cpp \
     feature_utils.cpp \
     feature_visibility.cpp \
+    features_cache.cpp \
     features_offsets_table.cpp \
     features_vector.cpp \
     ftypes_matcher.cpp \
@@ -72,6 +75,7 @@ HEADERS += \
     classificator.hpp \
     classificator_loader.hpp \
     coding_params.hpp \
+    compressed_features_data.hpp \
     cuisines.hpp \
     data_factory.hpp \
     data_header.hpp \
@@ -80,6 +84,7 @@ HEADERS += \
     drules_include.hpp \
     drules_selector.hpp \
     drules_selector_parser.hpp \
+    drules_table.hpp \
     editable_map_object.hpp \
     edits_migration.hpp \
     feature.hpp \
@@ -95,6 +100,7 @@ HEADERS += \
     feature_processor.hpp \
     feature_utils.hpp \
     feature_visibility.hpp \
+    features_cache.hpp \
     features_offsets_table.hpp \
     features_vector.hpp \
     ftraits.hpp \
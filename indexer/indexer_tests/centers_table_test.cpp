@@ -9,12 +9,17 @@
 #include "platform/platform.hpp"
 
 #include "coding/file_name_utils.hpp"
+#include "coding/file_writer.hpp"
+#include "coding/internal/file_data.hpp"
+#include "coding/mmap_reader.hpp"
 #include "coding/reader.hpp"
 #include "coding/writer.hpp"
 
 #include "geometry/mercator.hpp"
 #include "geometry/point2d.hpp"
 
+#include "base/scope_guard.hpp"
+
 #include "std/cstdint.hpp"
 #include "std/string.hpp"
 #include "std/utility.hpp"
@@ -117,4 +122,90 @@ UNIT_CLASS_TEST(CentersTableTest, Subset)
     }
   }
 }
+
+UNIT_CLASS_TEST(CentersTableTest, Batch)
+{
+  serial::CodingParams codingParams;
+
+  // Features are spread among several blocks.
+  vector<pair<uint32_t, m2::PointD>> features;
+  for (uint32_t i = 0; i < 300; ++i)
+    features.emplace_back(2 * i, m2::PointD(i % 17, i % 23));
+
+  TBuffer buffer;
+  {
+    CentersTableBuilder builder;
+
+    builder.SetCodingParams(codingParams);
+    for (auto const & feature : features)
+      builder.Put(feature.first, feature.second);
+
+    MemWriter<TBuffer> writer(buffer);
+    builder.Freeze(writer);
+  }
+
+  MemReader reader(buffer.data(), buffer.size());
+  auto table = CentersTable::Load(reader, codingParams);
+  TEST(table.get(), ());
+
+  vector<uint32_t> ids;
+  for (uint32_t id = 0; id < 700; id += 3)
+    ids.push_back(id);
+
+  vector<m2::PointD> centers;
+  vector<bool> found;
+  table->GetBatch(ids, centers, found);
+  TEST_EQUAL(centers.size(), ids.size(), ());
+  TEST_EQUAL(found.size(), ids.size(), ());
+
+  for (size_t i = 0; i < ids.size(); ++i)
+  {
+    uint32_t const id = ids[i];
+    bool const expected = id % 2 == 0 && id / 2 < features.size();
+    TEST_EQUAL(found[i], expected, (id));
+    if (expected)
+    {
+      TEST_LESS_OR_EQUAL(
+          MercatorBounds::DistanceOnEarth(centers[i], features[id / 2].second), 1, (id));
+    }
+  }
+}
+
+UNIT_CLASS_TEST(CentersTableTest, Mapped)
+{
+  serial::CodingParams codingParams;
+
+  vector<pair<uint32_t, m2::PointD>> features;
+  for (uint32_t i = 0; i < 100; ++i)
+    features.emplace_back(3 * i, m2::PointD(i % 13, i % 7));
+
+  string const path = my::JoinFoldersToPath(GetPlatform().WritableDir(), "mapped_centers.bin");
+  MY_SCOPE_GUARD(deleteFile, [&path]() { my::DeleteFileX(path); });
+  {
+    CentersTableBuilder builder;
+
+    builder.SetCodingParams(codingParams);
+    for (auto const & feature : features)
+      builder.Put(feature.first, feature.second);
+
+    FileWriter writer(path);
+    builder.Freeze(writer);
+  }
+
+  // The table is used in place of the mapped file.
+  MmapReader reader(path);
+  TEST(MmapReader::GetMappedData(reader), ());
+  auto table = CentersTable::Load(reader, codingParams);
+  TEST(table.get(), ());
+
+  for (auto const & feature : features)
+  {
+    m2::PointD actual;
+    TEST(table->Get(feature.first, actual), (feature.first));
+    TEST_LESS_OR_EQUAL(MercatorBounds::DistanceOnEarth(actual, feature.second), 1, ());
+  }
+
+  m2::PointD actual;
+  TEST(!table->Get(1, actual), ());
+}
 }  // namespace
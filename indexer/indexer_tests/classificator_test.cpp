@@ -0,0 +1,54 @@
+#include "testing/testing.hpp"
+
+#include "indexer/classificator.hpp"
+#include "indexer/classificator_loader.hpp"
+
+#include "coding/reader.hpp"
+#include "coding/writer.hpp"
+
+#include <cstdint>
+#include <vector>
+
+using namespace std;
+
+namespace
+{
+UNIT_TEST(Classificator_BinarySerialization)
+{
+  classificator::Load();
+  Classificator const & c = classif();
+
+  vector<uint8_t> buffer;
+  {
+    MemWriter<vector<uint8_t>> writer(buffer);
+    c.WriteBinary(writer);
+  }
+
+  Classificator deserialized;
+  {
+    MemReader reader(buffer.data(), buffer.size());
+    NonOwningReaderSource src(reader);
+    deserialized.ReadBinary(src);
+    TEST_EQUAL(src.Size(), 0, ());
+  }
+
+  TEST_EQUAL(deserialized.GetCoastType(), c.GetCoastType(), ());
+
+  uint32_t count = 0;
+  auto const check = [&](ClassifObject const *, uint32_t type) {
+    TEST_EQUAL(deserialized.GetFullObjectName(type), c.GetFullObjectName(type), ());
+    TEST_EQUAL(deserialized.IsTypeValid(type), c.IsTypeValid(type), ());
+    if (c.IsTypeValid(type))
+    {
+      TEST_EQUAL(deserialized.GetIndexForType(type), c.GetIndexForType(type), ());
+      ++count;
+    }
+  };
+  c.ForEachTree(check);
+  TEST_GREATER(count, 0, ());
+
+  TEST_EQUAL(deserialized.GetTypeByPath({"highway", "primary"}),
+             c.GetTypeByPath({"highway", "primary"}), ());
+  TEST_EQUAL(deserialized.GetTypeByPathSafe({"highway", "nonexistent"}), 0, ());
+}
+}  // namespace
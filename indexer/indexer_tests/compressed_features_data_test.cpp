@@ -0,0 +1,74 @@
+#include "testing/testing.hpp"
+
+#include "indexer/compressed_features_data.hpp"
+
+#include "coding/byte_stream.hpp"
+#include "coding/file_container.hpp"
+#include "coding/file_writer.hpp"
+#include "coding/varint.hpp"
+
+#include "base/scope_guard.hpp"
+
+#include "defines.hpp"
+
+#include "std/bind.hpp"
+#include "std/string.hpp"
+#include "std/vector.hpp"
+
+namespace feature
+{
+namespace
+{
+uint32_t constexpr kBlockSize = 1024;
+
+// Reads the record at |offset| of the uncompressed data.
+string ReadRecord(CompressedFeaturesData const & data, uint32_t offset)
+{
+  uint32_t const block = data.GetBlockByOffset(offset);
+  vector<char> buffer;
+  data.ReadBlock(block, buffer);
+
+  ArrayByteSource src(buffer.data() + (offset - data.GetBlockOffset(block)));
+  uint32_t const size = ReadVarUint<uint32_t>(src);
+  return string(src.PtrC(), size);
+}
+}  // namespace
+
+UNIT_TEST(CompressedFeaturesData_Smoke)
+{
+  string const testFile = "compressed_features_data_test.mwm";
+  MY_SCOPE_GUARD(deleter, bind(FileWriter::DeleteFileX, testFile));
+
+  vector<string> records;
+  vector<uint32_t> offsets;
+  {
+    vector<char> dat;
+    PushBackByteSink<vector<char>> sink(dat);
+    for (size_t i = 0; i < 1000; ++i)
+    {
+      // One of records is larger than a block.
+      size_t const size = i == 500 ? 3 * kBlockSize : i * 37 % 300 + 1;
+      records.emplace_back(size, static_cast<char>('a' + i % 26));
+      offsets.push_back(static_cast<uint32_t>(dat.size()));
+      WriteVarUint(sink, static_cast<uint32_t>(size));
+      dat.insert(dat.end(), records.back().begin(), records.back().end());
+    }
+
+    FilesContainerW cont(testFile);
+    cont.Write(dat, DATA_FILE_TAG);
+  }
+
+  TEST(CompressFeaturesData(testFile, kBlockSize), ());
+
+  FilesContainerR const cont(testFile);
+  TEST(!cont.IsExist(DATA_FILE_TAG), ());
+  TEST(cont.IsExist(COMPRESSED_DATA_FILE_TAG), ());
+
+  CompressedFeaturesData const data(cont.GetReader(COMPRESSED_DATA_FILE_TAG));
+  TEST_GREATER(data.GetBlocksCount(), 1, ());
+  TEST_EQUAL(data.GetBlockOffset(0), 0, ());
+
+  for (size_t i = 0; i < records.size(); ++i)
+    TEST_EQUAL(ReadRecord(data, offsets[i]), records[i], (i));
+}
+}  // namespace feature
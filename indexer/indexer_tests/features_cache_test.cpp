@@ -0,0 +1,94 @@
+#include "testing/testing.hpp"
+
+#include "test_mwm_set.hpp"
+
+#include "indexer/feature.hpp"
+#include "indexer/feature_decl.hpp"
+#include "indexer/features_cache.hpp"
+
+#include "coding/multilang_utf8_string.hpp"
+
+#include "std/string.hpp"
+
+using platform::CountryFile;
+using platform::LocalCountryFile;
+using tests::TestMwmSet;
+
+namespace
+{
+FeatureType MakeFeature(MwmSet::MwmId const & mwmId, uint32_t index, string const & name)
+{
+  StringUtf8Multilang names;
+  names.AddString(StringUtf8Multilang::kDefaultCode, name);
+
+  FeatureType ft;
+  ft.SetID(FeatureID(mwmId, index));
+  ft.SetNames(names);
+  return ft;
+}
+
+string GetName(FeatureType const & ft)
+{
+  string name;
+  ft.GetNames().GetString(StringUtf8Multilang::kDefaultCode, name);
+  return name;
+}
+}  // namespace
+
+UNIT_TEST(FeaturesCache_Smoke)
+{
+  TestMwmSet mwmSet;
+  auto const mwmId = mwmSet.Register(LocalCountryFile::MakeForTesting("0")).first;
+
+  FeaturesCache cache(2 /* maxFeaturesCount */, 1 /* shardsCount */);
+  FeatureType ft;
+  TEST(!cache.Get(FeatureID(mwmId, 0), ft), ());
+
+  cache.Put(MakeFeature(mwmId, 0, "zero"));
+  cache.Put(MakeFeature(mwmId, 1, "one"));
+  TEST_EQUAL(cache.GetSize(), 2, ());
+
+  TEST(cache.Get(FeatureID(mwmId, 0), ft), ());
+  TEST_EQUAL(ft.GetID(), FeatureID(mwmId, 0), ());
+  TEST_EQUAL(GetName(ft), "zero", ());
+
+  // The least recently used feature is removed.
+  cache.Put(MakeFeature(mwmId, 2, "two"));
+  TEST_EQUAL(cache.GetSize(), 2, ());
+  TEST(!cache.Get(FeatureID(mwmId, 1), ft), ());
+  TEST(cache.Get(FeatureID(mwmId, 0), ft), ());
+  TEST(cache.Get(FeatureID(mwmId, 2), ft), ());
+  TEST_EQUAL(GetName(ft), "two", ());
+
+  cache.Put(MakeFeature(mwmId, 2, "two again"));
+  TEST(cache.Get(FeatureID(mwmId, 2), ft), ());
+  TEST_EQUAL(GetName(ft), "two again", ());
+
+  cache.Clear();
+  TEST_EQUAL(cache.GetSize(), 0, ());
+}
+
+UNIT_TEST(FeaturesCache_Deregistered)
+{
+  TestMwmSet mwmSet;
+  auto const mwmId0 = mwmSet.Register(LocalCountryFile::MakeForTesting("0")).first;
+  auto const mwmId1 = mwmSet.Register(LocalCountryFile::MakeForTesting("1")).first;
+
+  FeaturesCache cache(100 /* maxFeaturesCount */);
+  for (uint32_t i = 0; i < 10; ++i)
+  {
+    cache.Put(MakeFeature(mwmId0, i, "zero"));
+    cache.Put(MakeFeature(mwmId1, i, "one"));
+  }
+  TEST_EQUAL(cache.GetSize(), 20, ());
+
+  TEST(mwmSet.Deregister(CountryFile("1")), ());
+
+  FeatureType ft;
+  TEST(!cache.Get(FeatureID(mwmId1, 0), ft), ());
+  TEST(cache.Get(FeatureID(mwmId0, 0), ft), ());
+  TEST_EQUAL(GetName(ft), "zero", ());
+
+  cache.RemoveDeregistered();
+  TEST_EQUAL(cache.GetSize(), 10, ());
+}
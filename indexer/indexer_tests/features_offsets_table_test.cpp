@@ -15,6 +15,7 @@
 
 #include "std/bind.hpp"
 #include "std/string.hpp"
+#include "std/vector.hpp"
 
 
 using namespace platform;
@@ -62,6 +63,10 @@ namespace feature
     TEST_EQUAL(static_cast<size_t>(5), table->GetFeatureIndexbyOffset(510), ());
     TEST_EQUAL(static_cast<size_t>(6), table->GetFeatureIndexbyOffset(513), ());
     TEST_EQUAL(static_cast<size_t>(7), table->GetFeatureIndexbyOffset(1024), ());
+
+    vector<uint32_t> offsets;
+    table->GetFeatureOffsets({0, 1, 1, 2, 4, 6, 7}, offsets);
+    TEST_EQUAL(offsets, vector<uint32_t>({1, 4, 4, 17, 129, 513, 1024}), ());
   }
 
   UNIT_TEST(FeaturesOffsetsTable_CreateIfNotExistsAndLoad)
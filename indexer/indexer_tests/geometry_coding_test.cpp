@@ -40,6 +40,32 @@ UNIT_TEST(EncodeDelta)
   }
 }
 
+UNIT_TEST(DecodeDeltas)
+{
+  PU const pred(1000, 1000);
+  vector<uint64_t> deltas;
+  vector<PU> points;
+  for (int x = -100; x <= 100; x += 7)
+  {
+    for (int y = -100; y <= 100; y += 3)
+    {
+      points.push_back(PU(1000 + x, 1000 + y));
+      deltas.push_back(EncodeDelta(points.back(), pred));
+    }
+  }
+
+  vector<PU> diffs(deltas.size());
+  DecodeDeltas(deltas.data(), deltas.size(), 0 /* lowBits */, diffs.data());
+  for (size_t i = 0; i < deltas.size(); ++i)
+    TEST_EQUAL(pred + diffs[i], points[i], (i));
+
+  for (auto & delta : deltas)
+    delta = (delta << 2) | 3;
+  DecodeDeltas(deltas.data(), deltas.size(), 2 /* lowBits */, diffs.data());
+  for (size_t i = 0; i < deltas.size(); ++i)
+    TEST_EQUAL(pred + diffs[i], points[i], (i));
+}
+
 UNIT_TEST(PredictPointsInPolyline2)
 {
   // Ci = Ci-1 + (Ci-1 + Ci-2) / 2
@@ -5,6 +5,7 @@
 #include "indexer/mwm_set.hpp"
 
 #include "coding/file_name_utils.hpp"
+#include "coding/file_writer.hpp"
 #include "coding/internal/file_data.hpp"
 
 #include "platform/country_file.hpp"
@@ -167,3 +168,40 @@ UNIT_CLASS_TEST(IndexTest, StatusNotifications)
     TEST(CheckExpectations(), ());
   }
 }
+
+UNIT_CLASS_TEST(IndexTest, InfoSnapshot)
+{
+  string const snapshotPath =
+      my::JoinFoldersToPath(GetPlatform().WritableDir(), "index_test_" MWMS_SNAPSHOT_FILENAME);
+  MY_SCOPE_GUARD(snapshotDeleter, bind(&FileWriter::DeleteFileX, snapshotPath));
+
+  TEST(!m_index.LoadInfoSnapshot(snapshotPath), ());
+
+  LocalCountryFile const file = LocalCountryFile::MakeForTesting("minsk-pass");
+  auto const results = m_index.RegisterMaps({file}, 2 /* threadsCount */);
+  TEST_EQUAL(results.size(), 1, ());
+  TEST_EQUAL(results[0].second, MwmSet::RegResult::Success, ());
+  ExpectRegistered(file);
+  TEST(CheckExpectations(), ());
+
+  TEST(m_index.SaveInfoSnapshot(snapshotPath), ());
+
+  Index index;
+  TEST(index.LoadInfoSnapshot(snapshotPath), ());
+  auto const result = index.RegisterMap(file);
+  TEST_EQUAL(result.second, MwmSet::RegResult::Success, ());
+
+  auto const & expected = *results[0].first.GetInfo();
+  auto const & actual = *result.first.GetInfo();
+  TEST_EQUAL(actual.m_limitRect, expected.m_limitRect, ());
+  TEST_EQUAL(actual.m_minScale, expected.m_minScale, ());
+  TEST_EQUAL(actual.m_maxScale, expected.m_maxScale, ());
+  TEST_EQUAL(actual.m_version.GetFormat(), expected.m_version.GetFormat(), ());
+  TEST_EQUAL(actual.m_version.GetSecondsSinceEpoch(),
+             expected.m_version.GetSecondsSinceEpoch(), ());
+  TEST(actual.GetRegionData().Equals(expected.GetRegionData()), ());
+
+  // Features are read from the mwm registered by the snapshot.
+  NoopFunctor fn;
+  index.ForEachInScale(fn, 15);
+}
@@ -33,11 +33,14 @@ SOURCES += \
     cell_id_test.cpp \
     centers_table_test.cpp \
     checker_test.cpp \
+    classificator_test.cpp \
+    compressed_features_data_test.cpp \
     drules_selector_parser_test.cpp \
     editable_map_object_test.cpp \
     feature_metadata_test.cpp \
     feature_names_test.cpp \
     feature_xml_test.cpp \
+    features_cache_test.cpp \
     features_offsets_table_test.cpp \
     features_vector_test.cpp \
     geometry_coding_test.cpp \
@@ -5,6 +5,7 @@
 #include "coding/writer.hpp"
 #include "base/macros.hpp"
 #include "base/stl_add.hpp"
+#include "std/algorithm.hpp"
 #include "std/utility.hpp"
 #include "std/vector.hpp"
 
@@ -276,3 +277,43 @@ UNIT_TEST(IntervalIndex_Simple5)
   }
 }
 
+
+UNIT_TEST(IntervalIndex_Large)
+{
+  // The index is large enough for the lower levels of nodes not to be cached.
+  vector<CellIdFeaturePairForTest> data;
+  uint64_t cell = 0;
+  for (uint32_t i = 0; i < 100000; ++i)
+  {
+    cell = (cell * 6364136223846793005ULL + 1442695040888963407ULL);
+    data.push_back(CellIdFeaturePairForTest(cell >> 24, i));
+  }
+  sort(data.begin(), data.end(),
+       [](CellIdFeaturePairForTest const & lhs, CellIdFeaturePairForTest const & rhs)
+       {
+         return lhs.GetCell() < rhs.GetCell();
+       });
+
+  vector<char> serialIndex;
+  MemWriter<vector<char> > writer(serialIndex);
+  BuildIntervalIndex(data.begin(), data.end(), writer, 40);
+  MemReader reader(&serialIndex[0], serialIndex.size());
+  IntervalIndex<MemReader> index(reader);
+
+  for (uint64_t beg = 0; beg < 0xFFFFFFFFFFULL; beg += 0x0FFFFFFFFFULL)
+  {
+    uint64_t const end = beg + 0x00FFFFFFFFULL;
+    vector<uint32_t> expected;
+    for (auto const & p : data)
+    {
+      if (p.GetCell() >= beg && p.GetCell() < end)
+        expected.push_back(p.GetFeature());
+    }
+    sort(expected.begin(), expected.end());
+
+    vector<uint32_t> values;
+    index.ForEach(MakeBackInsertFunctor(values), beg, end);
+    sort(values.begin(), values.end());
+    TEST_EQUAL(values, expected, (beg, end));
+  }
+}
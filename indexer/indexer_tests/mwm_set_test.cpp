@@ -4,8 +4,11 @@
 
 #include "indexer/mwm_set.hpp"
 
+#include "coding/reader.hpp"
+
 #include "base/macros.hpp"
 
+#include "std/cctype.hpp"
 #include "std/initializer_list.hpp"
 #include "std/unordered_map.hpp"
 
@@ -33,6 +36,52 @@ void TestFilesPresence(TMwmsInfo const & mwmsInfo, initializer_list<string> cons
   for (string const & countryFileName : expectedNames)
     TEST_EQUAL(1, mwmsInfo.count(countryFileName), (countryFileName));
 }
+
+class SizedValue : public MwmSet::MwmValueBase
+{
+public:
+  explicit SizedValue(uint64_t bytes) : m_bytes(bytes) {}
+
+  uint64_t GetMemoryUsage() const override { return m_bytes; }
+
+private:
+  uint64_t m_bytes;
+};
+
+// Values of mwm "n" hold n * 100 bytes.
+class SizedMwmSet : public TestMwmSet
+{
+protected:
+  unique_ptr<MwmValueBase> CreateValue(MwmInfo & info) const override
+  {
+    return make_unique<SizedValue>(info.m_maxScale * 100);
+  }
+};
+
+// Mwms with names which don't start with a digit can't be read.
+class BrokenMwmSet : public TestMwmSet
+{
+protected:
+  unique_ptr<MwmInfo> CreateInfo(platform::LocalCountryFile const & localFile) const override
+  {
+    if (!isdigit(localFile.GetCountryName()[0]))
+      MYTHROW(Reader::OpenException, (localFile.GetCountryName()));
+    return TestMwmSet::CreateInfo(localFile);
+  }
+};
+
+void UseMwm(MwmSet & mwmSet, string const & name)
+{
+  TEST(mwmSet.GetMwmHandleByCountryFile(CountryFile(name)).IsAlive(), (name));
+}
+
+uint64_t GetCachedBytes(MwmSet const & mwmSet, string const & name)
+{
+  map<MwmSet::MwmId, uint64_t> usage;
+  mwmSet.GetCacheMemoryUsage(usage);
+  auto const it = usage.find(mwmSet.GetMwmIdByCountryFile(CountryFile(name)));
+  return it == usage.end() ? 0 : it->second;
+}
 }  // namespace
 
 UNIT_TEST(MwmSetSmokeTest)
@@ -157,3 +206,63 @@ UNIT_TEST(MwmSetLockAndIdTest)
   TEST(!handle.GetId().IsAlive(), ());
   TEST(!handle.GetId().GetInfo().get(), ());
 }
+
+UNIT_TEST(MwmSetCacheBytesBudgetTest)
+{
+  SizedMwmSet mwmSet;
+  for (string const name : {"1", "2", "3"})
+    UNUSED_VALUE(mwmSet.Register(LocalCountryFile::MakeForTesting(name)));
+
+  mwmSet.SetCacheBytesBudget(500);
+  UseMwm(mwmSet, "1");
+  UseMwm(mwmSet, "2");
+  TEST_EQUAL(GetCachedBytes(mwmSet, "1"), 100, ());
+  TEST_EQUAL(GetCachedBytes(mwmSet, "2"), 200, ());
+
+  // The least recently used value is dropped.
+  UseMwm(mwmSet, "3");
+  TEST_EQUAL(GetCachedBytes(mwmSet, "1"), 0, ());
+  TEST_EQUAL(GetCachedBytes(mwmSet, "2"), 200, ());
+  TEST_EQUAL(GetCachedBytes(mwmSet, "3"), 300, ());
+
+  // The most recently used value is kept even when it's out of the budget.
+  mwmSet.SetCacheBytesBudget(250);
+  TEST_EQUAL(GetCachedBytes(mwmSet, "2"), 0, ());
+  TEST_EQUAL(GetCachedBytes(mwmSet, "3"), 300, ());
+
+  mwmSet.SetCacheBytesBudget(0);
+  UseMwm(mwmSet, "1");
+  UseMwm(mwmSet, "2");
+  TEST_EQUAL(GetCachedBytes(mwmSet, "1"), 100, ());
+  TEST_EQUAL(GetCachedBytes(mwmSet, "2"), 200, ());
+  TEST_EQUAL(GetCachedBytes(mwmSet, "3"), 300, ());
+}
+
+UNIT_TEST(MwmSetParallelRegistrationTest)
+{
+  BrokenMwmSet mwmSet;
+  vector<LocalCountryFile> files;
+  for (char c = '0'; c <= '9'; ++c)
+    files.push_back(LocalCountryFile::MakeForTesting(string(1, c)));
+  files.push_back(LocalCountryFile::MakeForTesting("5"));
+  files.push_back(LocalCountryFile::MakeForTesting("broken"));
+
+  auto const results = mwmSet.Register(files, 4 /* threadsCount */);
+  TEST_EQUAL(results.size(), files.size(), ());
+  for (size_t i = 0; i < 10; ++i)
+  {
+    TEST_EQUAL(results[i].second, MwmSet::RegResult::Success, (i));
+    TEST(results[i].first.IsAlive(), (i));
+    TEST_EQUAL(results[i].first.GetInfo()->m_maxScale, i, ());
+  }
+
+  TEST_EQUAL(results[10].second, MwmSet::RegResult::VersionAlreadyExists, ());
+  TEST_EQUAL(results[10].first, results[5].first, ());
+
+  TEST_EQUAL(results[11].second, MwmSet::RegResult::BadFile, ());
+  TEST(!results[11].first.IsAlive(), ());
+
+  TMwmsInfo mwmsInfo;
+  GetMwmsInfo(mwmSet, mwmsInfo);
+  TestFilesPresence(mwmsInfo, {"0", "1", "2", "3", "4", "5", "6", "7", "8", "9"});
+}
@@ -104,6 +104,23 @@ UNIT_TEST(RankTableBuilder_EndToEnd)
   TestTable(ranks, mapPath);
 }
 
+UNIT_TEST(RankTableBuilder_Parallel)
+{
+  classificator::Load();
+
+  string const mapPath = my::JoinFoldersToPath(GetPlatform().WritableDir(), "minsk-pass.mwm");
+
+  vector<uint8_t> expected;
+  {
+    FilesContainerR rcont(mapPath);
+    search::RankTableBuilder::CalcSearchRanks(rcont, expected);
+  }
+
+  vector<uint8_t> ranks;
+  search::RankTableBuilder::CalcSearchRanks(mapPath, 4 /* threadsCount */, ranks);
+  TEST_EQUAL(ranks, expected, ());
+}
+
 UNIT_TEST(RankTableBuilder_WrongEndianness)
 {
   char const kTestFile[] = "test.mwm";
@@ -89,6 +89,19 @@ UNIT_TEST(NormalizeAndSimplifyStringWithOurTambourines)
     TEST_EQUAL(arr[i + 1], ToUtf8(NormalizeAndSimplifyString(arr[i])), (i));
 }
 
+UNIT_TEST(NormalizeAndSimplifyString_ASCII)
+{
+  // ASCII strings go by the fast path, which should be the same as the general one.
+  string const arr[] = {"", "Main Street", "HELLO, World!", "#1", "# 12", "a#b", "Route 66 #", "Z@[`{"};
+  for (auto const & s : arr)
+  {
+    // A leading non-ASCII char forces the general path.
+    UniString const general = NormalizeAndSimplifyString("\xc3\xa9" + s);
+    TEST(!general.empty(), (s));
+    TEST_EQUAL(NormalizeAndSimplifyString(s), UniString(general.begin() + 1, general.end()), (s));
+  }
+}
+
 UNIT_TEST(Contains)
 {
   constexpr char const * kTestStr = "ØøÆæŒœ Ўвага!";
@@ -189,3 +202,17 @@ UNIT_TEST(NormalizeAndSimplifyString_Numero)
   TEST_EQUAL(NormalizeAndSimplifyStringUtf8("Area # "), "area   ", ());
   TEST_EQUAL(NormalizeAndSimplifyStringUtf8("Area #One"), "area #one", ());
 }
+
+UNIT_TEST(FeatureTypeFromString)
+{
+  uint32_t type = 0;
+  TEST(FeatureTypeFromString(FeatureTypeToString(0), type), ());
+  TEST_EQUAL(type, 0, ());
+  TEST(FeatureTypeFromString(FeatureTypeToString(1234), type), ());
+  TEST_EQUAL(type, 1234, ());
+
+  TEST(!FeatureTypeFromString(MakeUniString("!type:"), type), ());
+  TEST(!FeatureTypeFromString(MakeUniString("!type:12a"), type), ());
+  TEST(!FeatureTypeFromString(MakeUniString("!type:99999999999"), type), ());
+  TEST(!FeatureTypeFromString(MakeUniString("cafe"), type), ());
+}
@@ -1,6 +1,11 @@
 #include "testing/testing.hpp"
+#include "indexer/cell_coverer.hpp"
 #include "indexer/feature_covering.hpp"
 
+#include "geometry/mercator.hpp"
+
+#include "std/random.hpp"
+
 UNIT_TEST(SortAndMergeIntervals_1Interval)
 {
   vector<pair<int64_t, int64_t> > v;
@@ -60,3 +65,39 @@ UNIT_TEST(SortAndMergeIntervals_ContainAndTouchBorder)
 
 
 
+
+UNIT_TEST(AppendLowerLevelsSorted_EqualToSortAndMerge)
+{
+  mt19937 rng(0);
+  uniform_real_distribution<double> coord(-180.0, 180.0);
+  uniform_real_distribution<double> size(0.0, 50.0);
+
+  for (size_t i = 0; i < 200; ++i)
+  {
+    m2::PointD const p(coord(rng), coord(rng));
+    m2::RectD const rect(p, p + m2::PointD(size(rng), size(rng)) / (1 + i % 7 * 100));
+
+    for (int cellDepth : {static_cast<int>(RectId::DEPTH_LEVELS), RectId::DEPTH_LEVELS - 5})
+    {
+      vector<RectId> ids;
+      CoverRect<MercatorBounds, RectId>(rect, SPLIT_RECT_CELLS_COUNT, cellDepth, ids);
+
+      covering::IntervalsT intervals;
+      for (auto const & id : ids)
+        covering::AppendLowerLevels(id, cellDepth, intervals);
+      covering::IntervalsT const expected = covering::SortAndMergeIntervals(intervals);
+
+      covering::IntervalsT actual;
+      covering::AppendLowerLevelsSorted(ids, cellDepth, actual);
+      TEST_EQUAL(actual, expected, (rect, cellDepth));
+
+      // Twice to get the covering from the cache.
+      for (size_t j = 0; j < 2; ++j)
+      {
+        covering::IntervalsT cached;
+        covering::CoverViewportAndAppendLowerLevelsCached(rect, cellDepth, cached);
+        TEST_EQUAL(cached, expected, (rect, cellDepth));
+      }
+    }
+  }
+}
@@ -86,3 +86,29 @@ UNIT_TEST(VisibleScales_Highway)
 
   doGet.Print();
 }
+
+UNIT_TEST(VisibleScales_RulesTable)
+{
+  classificator::Load();
+  Classificator const & c = classif();
+  TEST(!c.GetRulesTable().IsEmpty(), ());
+
+  // Scales of the table are the same as the scales of the tree.
+  size_t count = 0;
+  auto const check = [&](ClassifObject const * p, uint32_t type)
+  {
+    TEST_EQUAL(feature::GetDrawableScaleRange(type), p->GetDrawScaleRange(),
+               (c.GetFullObjectName(type)));
+
+    uint32_t scales = 0;
+    TEST(c.GetRulesTable().GetDrawableScales(type, scales), (c.GetFullObjectName(type)));
+    for (int scale = 0; scale <= scales::GetUpperStyleScale(); ++scale)
+    {
+      TEST_EQUAL((scales & (1U << scale)) != 0, p->IsDrawable(scale),
+                 (c.GetFullObjectName(type), scale));
+    }
+    ++count;
+  };
+  c.ForEachTree(check);
+  TEST_GREATER(count, 0, ());
+}
@@ -9,6 +9,9 @@
 #include "base/assert.hpp"
 #include "base/buffer_vector.hpp"
 
+#include "std/limits.hpp"
+#include "std/vector.hpp"
+
 
 class IntervalIndexBase : public IntervalIndexIFace
 {
@@ -45,8 +48,11 @@ public:
     src.Read(&m_Header, sizeof(Header));
     CHECK_EQUAL(m_Header.m_Version, static_cast<uint8_t>(kVersion), ());
     if (m_Header.m_Levels != 0)
+    {
       for (int i = 0; i <= m_Header.m_Levels + 1; ++i)
         m_LevelOffsets.push_back(ReadPrimitiveFromSource<uint32_t>(src));
+      CacheTopLevels();
+    }
   }
 
   uint64_t KeyEnd() const
@@ -77,6 +83,39 @@ public:
   }
 
 private:
+  // Upper bound of bytes of the top levels which are cached by CacheTopLevels().
+  static uint32_t constexpr kMaxCachedBytes = 16 * 1024;
+
+  // Reads the top levels of nodes, which are stored contiguously at the end of the index,
+  // at once, so traversals read only leaves and the lower levels of nodes.
+  void CacheTopLevels()
+  {
+    int level = m_Header.m_Levels;
+    uint32_t const end = m_LevelOffsets[m_Header.m_Levels + 1];
+    while (level > 1 && end - m_LevelOffsets[level - 1] <= kMaxCachedBytes)
+      --level;
+    if (end - m_LevelOffsets[level] > kMaxCachedBytes)
+      return;
+
+    m_CachedBegin = m_LevelOffsets[level];
+    m_CachedNodes.resize(end - m_CachedBegin);
+    if (!m_CachedNodes.empty())
+      m_Reader.Read(m_CachedBegin, m_CachedNodes.data(), m_CachedNodes.size());
+  }
+
+  template <class TBuffer>
+  uint8_t const * ReadNode(uint32_t offset, uint32_t size, TBuffer & data) const
+  {
+    if (offset >= m_CachedBegin)
+    {
+      ASSERT_LESS_OR_EQUAL(offset - m_CachedBegin + size, m_CachedNodes.size(), ());
+      return m_CachedNodes.data() + (offset - m_CachedBegin);
+    }
+
+    data.resize_no_init(size);
+    m_Reader.Read(offset, &data[0], size);
+    return &data[0];
+  }
 
   template <typename F>
   void ForEachLeaf(F const & f, uint64_t const beg, uint64_t const end,
@@ -123,11 +162,9 @@ private:
     uint32_t const end0 = static_cast<uint32_t>(end >> skipBits);
     ASSERT_LESS(end0, (1U << m_Header.m_BitsPerLevel), (beg, end, skipBits));
 
-    buffer_vector<uint8_t, 576> data;
-    data.resize_no_init(size);
-
-    m_Reader.Read(offset, &data[0], size);
-    ArrayByteSource src(&data[0]);
+    buffer_vector<uint8_t, 576> buffer;
+    uint8_t const * data = ReadNode(offset, size, buffer);
+    ArrayByteSource src(data);
 
     uint32_t const offsetAndFlag = ReadVarUint<uint32_t>(src);
     uint32_t childOffset = offsetAndFlag >> 1;
@@ -151,12 +188,12 @@ private:
         }
       }
       ASSERT(end0 != (1 << m_Header.m_BitsPerLevel) - 1 ||
-             static_cast<uint8_t const *>(src.Ptr()) - &data[0] == size,
-             (beg, end, beg0, end0, offset, size, src.Ptr(), &data[0]));
+             static_cast<uint8_t const *>(src.Ptr()) - data == size,
+             (beg, end, beg0, end0, offset, size, src.Ptr(), data));
     }
     else
     {
-      void const * pEnd = &data[0] + size;
+      void const * pEnd = data + size;
       while (src.Ptr() < pEnd)
       {
         uint8_t const i = src.ReadByte();
@@ -177,4 +214,11 @@ private:
   ReaderT m_Reader;
   Header m_Header;
   buffer_vector<uint32_t, 7> m_LevelOffsets;
+  // Nodes from |m_CachedBegin| to the end of the index.
+  uint32_t m_CachedBegin = numeric_limits<uint32_t>::max();
+  vector<uint8_t> m_CachedNodes;
 };
+
+// static
+template <class ReaderT>
+uint32_t constexpr IntervalIndex<ReaderT>::kMaxCachedBytes;
@@ -10,7 +10,9 @@
 
 #include "std/algorithm.hpp"
 #include "std/exception.hpp"
+#include "std/iterator.hpp"
 #include "std/sstream.hpp"
+#include "std/thread.hpp"
 
 #include "defines.hpp"
 
@@ -85,64 +87,121 @@ MwmSet::MwmId MwmSet::GetMwmIdByCountryFileImpl(CountryFile const & countryFile)
   return MwmId(it->second.back());
 }
 
+template <typename TCreateInfo>
+pair<MwmSet::MwmId, MwmSet::RegResult> MwmSet::RegisterOrUpdateImpl(
+    LocalCountryFile const & localFile, TCreateInfo && createInfo, EventList & events)
+{
+  CountryFile const & countryFile = localFile.GetCountryFile();
+  MwmId const id = GetMwmIdByCountryFileImpl(countryFile);
+  if (!id.IsAlive())
+    return RegisterImpl(localFile, createInfo(), events);
+
+  shared_ptr<MwmInfo> info = id.GetInfo();
+
+  // Deregister old mwm for the country.
+  if (info->GetVersion() < localFile.GetVersion())
+  {
+    EventList subEvents;
+    DeregisterImpl(id, subEvents);
+    auto const result = RegisterImpl(localFile, createInfo(), subEvents);
+
+    // In the case of success all sub-events are
+    // replaced with a single UPDATE event. Otherwise,
+    // sub-events are reported as is.
+    if (result.second == MwmSet::RegResult::Success)
+      events.Add(Event(Event::TYPE_UPDATED, localFile, info->GetLocalFile()));
+    else
+      events.Append(subEvents);
+    return result;
+  }
+
+  string const name = countryFile.GetName();
+  // Update the status of the mwm with the same version.
+  if (info->GetVersion() == localFile.GetVersion())
+  {
+    LOG(LINFO, ("Updating already registered mwm:", name));
+    SetStatus(*info, MwmInfo::STATUS_REGISTERED, events);
+    info->m_file = localFile;
+    return make_pair(id, RegResult::VersionAlreadyExists);
+  }
+
+  LOG(LWARNING, ("Trying to add too old (", localFile.GetVersion(), ") mwm (", name,
+                 "), current version:", info->GetVersion()));
+  return make_pair(MwmId(), RegResult::VersionTooOld);
+}
+
 pair<MwmSet::MwmId, MwmSet::RegResult> MwmSet::Register(LocalCountryFile const & localFile)
 {
   pair<MwmSet::MwmId, MwmSet::RegResult> result;
   auto registerFile = [&](EventList & events)
   {
-    CountryFile const & countryFile = localFile.GetCountryFile();
-    MwmId const id = GetMwmIdByCountryFileImpl(countryFile);
-    if (!id.IsAlive())
-    {
-      result = RegisterImpl(localFile, events);
-      return;
-    }
+    // This function can throw an exception for a bad mwm file.
+    auto createInfo = [&]() { return shared_ptr<MwmInfo>(CreateInfo(localFile)); };
+    result = RegisterOrUpdateImpl(localFile, createInfo, events);
+  };
 
-    shared_ptr<MwmInfo> info = id.GetInfo();
+  WithEventLog(registerFile);
+  return result;
+}
 
-    // Deregister old mwm for the country.
-    if (info->GetVersion() < localFile.GetVersion())
+vector<pair<MwmSet::MwmId, MwmSet::RegResult>> MwmSet::Register(
+    vector<LocalCountryFile> const & localFiles, size_t threadsCount)
+{
+  // Infos are read without |m_lock|, so other threads may use the set meanwhile.
+  vector<shared_ptr<MwmInfo>> infos(localFiles.size());
+  vector<uint8_t> badFiles(localFiles.size(), 0);
+  atomic<size_t> nextFile(0);
+  auto readInfos = [&]()
+  {
+    for (size_t i = nextFile++; i < localFiles.size(); i = nextFile++)
     {
-      EventList subEvents;
-      DeregisterImpl(id, subEvents);
-      result = RegisterImpl(localFile, subEvents);
-
-      // In the case of success all sub-events are
-      // replaced with a single UPDATE event. Otherwise,
-      // sub-events are reported as is.
-      if (result.second == MwmSet::RegResult::Success)
-        events.Add(Event(Event::TYPE_UPDATED, localFile, info->GetLocalFile()));
-      else
-        events.Append(subEvents);
-      return;
+      try
+      {
+        infos[i] = CreateInfo(localFiles[i]);
+      }
+      catch (RootException const & ex)
+      {
+        LOG(LWARNING, ("IO error while adding", localFiles[i].GetCountryName(), "map.", ex.Msg()));
+        badFiles[i] = 1;
+      }
     }
+  };
+
+  threadsCount = min(max(threadsCount, static_cast<size_t>(1)), localFiles.size());
+  vector<thread> threads;
+  for (size_t i = 1; i < threadsCount; ++i)
+    threads.emplace_back(readInfos);
+  readInfos();
+  for (auto & worker : threads)
+    worker.join();
 
-    string const name = countryFile.GetName();
-    // Update the status of the mwm with the same version.
-    if (info->GetVersion() == localFile.GetVersion())
+  vector<pair<MwmId, RegResult>> results(localFiles.size());
+  WithEventLog([&](EventList & events)
+  {
+    for (size_t i = 0; i < localFiles.size(); ++i)
     {
-      LOG(LINFO, ("Updating already registered mwm:", name));
-      SetStatus(*info, MwmInfo::STATUS_REGISTERED, events);
-      info->m_file = localFile;
-      result = make_pair(id, RegResult::VersionAlreadyExists);
-      return;
+      if (badFiles[i])
+      {
+        results[i] = make_pair(MwmId(), RegResult::BadFile);
+        continue;
+      }
+      results[i] = RegisterOrUpdateImpl(localFiles[i], [&]() { return infos[i]; }, events);
     }
-
-    LOG(LWARNING, ("Trying to add too old (", localFile.GetVersion(), ") mwm (", name,
-                   "), current version:", info->GetVersion()));
-    result = make_pair(MwmId(), RegResult::VersionTooOld);
-    return;
-  };
-
-  WithEventLog(registerFile);
-  return result;
+  });
+  return results;
 }
 
 pair<MwmSet::MwmId, MwmSet::RegResult> MwmSet::RegisterImpl(LocalCountryFile const & localFile,
                                                             EventList & events)
 {
   // This function can throw an exception for a bad mwm file.
-  shared_ptr<MwmInfo> info(CreateInfo(localFile));
+  return RegisterImpl(localFile, shared_ptr<MwmInfo>(CreateInfo(localFile)), events);
+}
+
+pair<MwmSet::MwmId, MwmSet::RegResult> MwmSet::RegisterImpl(LocalCountryFile const & localFile,
+                                                            shared_ptr<MwmInfo> info,
+                                                            EventList & events)
+{
   if (!info)
     return make_pair(MwmId(), RegResult::UnsupportedFileFormat);
 
@@ -166,9 +225,9 @@ bool MwmSet::DeregisterImpl(MwmId const & id, EventList & events)
     infos.erase(remove(infos.begin(), infos.end(), info), infos.end());
     for (auto it = m_cache.begin(); it != m_cache.end(); ++it)
     {
-      if (it->first == id)
+      if (it->m_id == id)
       {
-        m_cache.erase(it);
+        ClearCacheImpl(it, next(it));
         break;
       }
     }
@@ -282,10 +341,10 @@ unique_ptr<MwmSet::MwmValueBase> MwmSet::LockValueImpl(MwmId const & id, EventLi
   // Search in cache.
   for (auto it = m_cache.begin(); it != m_cache.end(); ++it)
   {
-    if (it->first == id)
+    if (it->m_id == id)
     {
-      unique_ptr<MwmValueBase> result = move(it->second);
-      m_cache.erase(it);
+      unique_ptr<MwmValueBase> result = move(it->m_value);
+      ClearCacheImpl(it, next(it));
       return result;
     }
   }
@@ -336,12 +395,11 @@ void MwmSet::UnlockValueImpl(MwmId const & id, unique_ptr<MwmValueBase> p, Event
     /// @todo Probably, it's better to store only "unique by id" free caches here.
     /// But it's no obvious if we have many threads working with the single mwm.
 
-    m_cache.push_back(make_pair(id, move(p)));
-    if (m_cache.size() > m_cacheSize)
-    {
-      ASSERT_EQUAL(m_cache.size(), m_cacheSize + 1, ());
-      m_cache.pop_front();
-    }
+    uint64_t const bytes = p->GetMemoryUsage();
+    m_cache.emplace_back(id, move(p), bytes);
+    m_cacheBytes += bytes;
+    ShrinkCacheImpl();
+    m_cacheMemory.Set(m_cacheBytes);
   }
 }
 
@@ -358,6 +416,20 @@ void MwmSet::ClearCache()
   ClearCacheImpl(m_cache.begin(), m_cache.end());
 }
 
+void MwmSet::SetCacheBytesBudget(uint64_t bytes)
+{
+  lock_guard<mutex> lock(m_lock);
+  m_cacheBytesBudget = bytes;
+  ShrinkCacheImpl();
+}
+
+void MwmSet::GetCacheMemoryUsage(map<MwmId, uint64_t> & usage) const
+{
+  lock_guard<mutex> lock(m_lock);
+  for (auto const & entry : m_cache)
+    usage[entry.m_id] += entry.m_value->GetMemoryUsage();
+}
+
 MwmSet::MwmId MwmSet::GetMwmIdByCountryFile(CountryFile const & countryFile) const
 {
   lock_guard<mutex> lock(m_lock);
@@ -394,14 +466,38 @@ MwmSet::MwmHandle MwmSet::GetMwmHandleByIdImpl(MwmId const & id, EventList & eve
 
 void MwmSet::ClearCacheImpl(CacheType::iterator beg, CacheType::iterator end)
 {
+  for (auto it = beg; it != end; ++it)
+  {
+    ASSERT_GREATER_OR_EQUAL(m_cacheBytes, it->m_bytes, ());
+    m_cacheBytes -= it->m_bytes;
+  }
   m_cache.erase(beg, end);
+  m_cacheMemory.Set(m_cacheBytes);
+}
+
+void MwmSet::ShrinkCacheImpl()
+{
+  size_t count = m_cache.size() > m_cacheSize ? m_cache.size() - m_cacheSize : 0;
+  uint64_t bytes = m_cacheBytes;
+  for (size_t i = 0; i < count; ++i)
+    bytes -= m_cache[i].m_bytes;
+
+  // The most recently used value is kept even when it's out of the budget,
+  // otherwise a large mwm would be reopened on every access.
+  while (m_cacheBytesBudget != 0 && bytes > m_cacheBytesBudget && count + 1 < m_cache.size())
+  {
+    bytes -= m_cache[count].m_bytes;
+    ++count;
+  }
+
+  ClearCacheImpl(m_cache.begin(), m_cache.begin() + count);
 }
 
 void MwmSet::ClearCache(MwmId const & id)
 {
-  auto sameId = [&id](pair<MwmSet::MwmId, unique_ptr<MwmSet::MwmValueBase>> const & p)
+  auto sameId = [&id](CacheEntry const & entry)
   {
-    return (p.first == id);
+    return (entry.m_id == id);
   };
   ClearCacheImpl(RemoveIfKeepValid(m_cache.begin(), m_cache.end(), sameId), m_cache.end());
 }
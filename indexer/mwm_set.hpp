@@ -6,7 +6,9 @@
 
 #include "geometry/rect2d.hpp"
 
+#include "base/cache_registry.hpp"
 #include "base/macros.hpp"
+#include "base/memory_counters.hpp"
 
 #include "indexer/feature_meta.hpp"
 
@@ -125,6 +127,10 @@ public:
   {
   public:
     virtual ~MwmValueBase() = default;
+
+    /// Returns bytes of memory which are held by the value, it's used
+    /// by the bytes budget of the cache of values.
+    virtual uint64_t GetMemoryUsage() const { return 0; }
   };
 
   // Mwm handle, which is used to refer to mwm and prevent it from
@@ -256,9 +262,18 @@ public:
   /// to just-registered file).
 protected:
   pair<MwmId, RegResult> RegisterImpl(platform::LocalCountryFile const & localFile, EventList & events);
+  pair<MwmId, RegResult> RegisterImpl(platform::LocalCountryFile const & localFile,
+                                      shared_ptr<MwmInfo> info, EventList & events);
 
 public:
   pair<MwmId, RegResult> Register(platform::LocalCountryFile const & localFile);
+
+  /// Registers maps reading their infos on |threadsCount| threads, which is the longest
+  /// part of the registration. Results are in the order of |localFiles|. Unlike the
+  /// registration of a single map it doesn't throw: maps which can't be read are
+  /// reported as RegResult::BadFile.
+  vector<pair<MwmId, RegResult>> Register(vector<platform::LocalCountryFile> const & localFiles,
+                                          size_t threadsCount);
   //@}
 
   /// @name Remove mwm.
@@ -294,6 +309,14 @@ public:
 
   void ClearCache();
 
+  /// Sets the limit of memory which is held by cached values (see MwmValueBase::GetMemoryUsage()).
+  /// The least recently used values are dropped first, but the most recent one is always kept.
+  /// Zero means that only the count of cached values is limited.
+  void SetCacheBytesBudget(uint64_t bytes);
+
+  /// Collects memory usage of values in the cache by mwms.
+  void GetCacheMemoryUsage(map<MwmId, uint64_t> & usage) const;
+
   MwmId GetMwmIdByCountryFile(platform::CountryFile const & countryFile) const;
 
   MwmHandle GetMwmHandleByCountryFile(platform::CountryFile const & countryFile);
@@ -313,7 +336,20 @@ protected:
   virtual unique_ptr<MwmValueBase> CreateValue(MwmInfo & info) const = 0;
 
 private:
-  typedef deque<pair<MwmId, unique_ptr<MwmValueBase>>> CacheType;
+  struct CacheEntry
+  {
+    CacheEntry(MwmId const & id, unique_ptr<MwmValueBase> && value, uint64_t bytes)
+      : m_id(id), m_value(move(value)), m_bytes(bytes)
+    {
+    }
+
+    MwmId m_id;
+    unique_ptr<MwmValueBase> m_value;
+    // Memory usage of the value when it was put to the cache.
+    uint64_t m_bytes;
+  };
+
+  typedef deque<CacheEntry> CacheType;
 
   // This is the only valid way to take |m_lock| and use *Impl()
   // functions. The reason is that event processing requires
@@ -333,6 +369,13 @@ private:
     ProcessEventList(events);
   }
 
+  // Registers |localFile| or updates the already registered mwm of the country.
+  // |createInfo| is called only when a new info is needed.
+  /// @precondition This function is always called under mutex m_lock.
+  template <typename TCreateInfo>
+  pair<MwmId, RegResult> RegisterOrUpdateImpl(platform::LocalCountryFile const & localFile,
+                                              TCreateInfo && createInfo, EventList & events);
+
   // Sets |status| in |info|, adds corresponding event to |event|.
   void SetStatus(MwmInfo & info, MwmInfo::Status status, EventList & events);
 
@@ -351,8 +394,16 @@ private:
   /// @precondition This function is always called under mutex m_lock.
   void ClearCacheImpl(CacheType::iterator beg, CacheType::iterator end);
 
+  /// Drops the least recently used values which are out of the limits.
+  /// @precondition This function is always called under mutex m_lock.
+  void ShrinkCacheImpl();
+
   CacheType m_cache;
   size_t const m_cacheSize;
+  uint64_t m_cacheBytesBudget = 0;
+  uint64_t m_cacheBytes = 0;
+  /// Reports |m_cacheBytes| to base::MemoryCounters.
+  base::MemoryCounter m_cacheMemory{"indexer.mwm_values"};
 
 protected:
   /// @precondition This function is always called under mutex m_lock.
@@ -368,6 +419,10 @@ protected:
 
 private:
   base::ObserverListSafe<Observer> m_observers;
+
+  // Values are reopened on demand, so the cache is dropped under memory pressure.
+  base::SheddableCache m_cacheShedding{"indexer.mwm_values", base::CacheRegistry::Priority::Normal,
+                                       [this]() { ClearCache(); }};
 };
 
 string DebugPrint(MwmSet::RegResult result);
@@ -32,6 +32,7 @@ namespace old_101 { namespace feature
     uint8_t GetHeader() override;
     void ParseTypes() override;
     void ParseCommon() override;
+    void ParseNames() override {}  /// names are parsed by ParseCommon() in this version
     void ParseHeader2() override;
     uint32_t ParseGeometry(int scale) override;
     uint32_t ParseTriangles(int scale) override;
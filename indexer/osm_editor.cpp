@@ -172,6 +172,7 @@ void Editor::LoadMapEdits()
 
   // TODO(mgsergio): synchronize access to m_features.
   m_features.clear();
+  m_editsIndexMwms.clear();
   for (xml_node mwm : doc.child(kXmlRootNode).children(kXmlMwmNode))
   {
     string const mapName = mwm.attribute("name").as_string("");
@@ -272,6 +273,8 @@ void Editor::LoadMapEdits()
   // Save edits with new indexes and mwm version to avoid another migration on next startup.
   if (needRewriteEdits)
     Save();
+  else
+    UpdateEditsIndex();
   LOG(LINFO, ("Loaded", modified, "modified,",
               created, "created,", deleted, "deleted and", obsolete, "obsolete features."));
 }
@@ -285,6 +288,7 @@ bool Editor::Save() const
   if (m_features.empty())
   {
     m_storage->Reset();
+    UpdateEditsIndex();
     return true;
   }
 
@@ -330,7 +334,9 @@ bool Editor::Save() const
     }
   }
 
-  return m_storage->Save(doc);
+  bool const saved = m_storage->Save(doc);
+  UpdateEditsIndex();
+  return saved;
 }
 
 void Editor::ClearAllLocalEdits()
@@ -362,14 +368,18 @@ void Editor::OnMapDeregistered(platform::LocalCountryFile const & localFile)
 Editor::FeatureStatus Editor::GetFeatureStatus(MwmSet::MwmId const & mwmId, uint32_t index) const
 {
   // Most popular case optimization.
-  if (m_features.empty())
+  if (m_editsIndexMwms.empty())
     return FeatureStatus::Untouched;
 
-  auto const * featureInfo = GetFeatureTypeInfo(mwmId, index);
-  if (featureInfo == nullptr)
+  auto const it = m_editsIndexMwms.find(mwmId);
+  if (it == m_editsIndexMwms.cend())
     return FeatureStatus::Untouched;
 
-  return featureInfo->m_status;
+  editor::EditsIndex::Status status;
+  if (!it->second.GetStatus(index, status))
+    return FeatureStatus::Untouched;
+
+  return static_cast<FeatureStatus>(status);
 }
 
 Editor::FeatureStatus Editor::GetFeatureStatus(FeatureID const & fid) const
@@ -393,6 +403,7 @@ void Editor::DeleteFeature(FeatureID const & fid)
     if (f != mwm->second.end() && f->second.m_status == FeatureStatus::Created)
     {
       mwm->second.erase(f);
+      UpdateEditsIndex();
       return;
     }
   }
@@ -729,6 +740,69 @@ void Editor::UploadChanges(string const & key, string const & secret, TChangeset
 
     int uploadedFeaturesCount = 0, errorsCount = 0;
     ChangesetWrapper changeset({key, secret}, tags);
+
+    // OSM data around points is requested in parallel before matching of the features.
+    vector<m2::PointD> points;
+    for (auto & id : features)
+    {
+      for (auto & index : id.second)
+      {
+        FeatureTypeInfo & fti = index.second;
+        if (NeedsUpload(fti.m_uploadStatus) && fti.m_status != FeatureStatus::Obsolete &&
+            fti.m_feature.GetFeatureType() == feature::GEOM_POINT)
+        {
+          points.push_back(fti.m_feature.GetCenter());
+        }
+      }
+    }
+    changeset.PrefetchNodes(points);
+
+    auto const finishUpload = [this](FeatureTypeInfo & fti, string const & ourDebugFeatureString)
+    {
+      // TODO(AlexZ): Use timestamp from the server.
+      fti.m_uploadAttemptTimestamp = time(nullptr);
+
+      if (fti.m_uploadStatus != kUploaded)
+      {
+        ms::LatLon const ll = MercatorBounds::ToLatLon(feature::GetCenter(fti.m_feature));
+        alohalytics::LogEvent("Editor_DataSync_error", {{"type", fti.m_uploadStatus},
+                              {"details", fti.m_uploadError}, {"our", ourDebugFeatureString},
+                              {"mwm", fti.m_feature.GetID().GetMwmName()},
+                              {"mwm_version", strings::to_string(fti.m_feature.GetID().GetMwmVersion())}},
+                              alohalytics::Location::FromLatLon(ll.lat, ll.lon));
+      }
+      // Call Save every time we modify each feature's information.
+      SaveUploadedInformation(fti);
+    };
+
+    // Changes of features are uploaded by batches, features of a batch get
+    // their statuses when the batch is uploaded.
+    vector<pair<FeatureTypeInfo *, string>> batched;
+    auto const flushBatch = [&]()
+    {
+      auto const errors = changeset.FlushBatch();
+      CHECK_EQUAL(errors.size(), batched.size(), ());
+      for (size_t i = 0; i < batched.size(); ++i)
+      {
+        FeatureTypeInfo & fti = *batched[i].first;
+        if (errors[i].empty())
+        {
+          fti.m_uploadStatus = kUploaded;
+          fti.m_uploadError.clear();
+          ++uploadedFeaturesCount;
+        }
+        else
+        {
+          fti.m_uploadStatus = kNeedsRetry;
+          fti.m_uploadError = errors[i];
+          ++errorsCount;
+          LOG(LWARNING, (errors[i]));
+        }
+        finishUpload(fti, batched[i].second);
+      }
+      batched.clear();
+    };
+
     for (auto & id : features)
     {
       for (auto & index : id.second)
@@ -739,6 +813,7 @@ void Editor::UploadChanges(string const & key, string const & secret, TChangeset
           continue;
 
         string ourDebugFeatureString;
+        size_t const batchSize = changeset.GetBatchSize();
 
         try
         {
@@ -772,18 +847,18 @@ void Editor::UploadChanges(string const & key, string const & secret, TChangeset
                 else
                 {
                   LOG(LDEBUG, ("Create case: uploading patched feature", osmFeature));
-                  changeset.Modify(osmFeature);
+                  changeset.AddModifyToBatch(osmFeature);
                 }
               }
               catch (ChangesetWrapper::OsmObjectWasDeletedException const &)
               {
                 // Object was never created by anyone else - it's safe to create it.
-                changeset.Create(feature);
+                changeset.AddCreateToBatch(feature);
               }
               catch (ChangesetWrapper::EmptyFeatureException const &)
               {
                 // There is another node nearby, but it should be safe to create a new one.
-                changeset.Create(feature);
+                changeset.AddCreateToBatch(feature);
               }
               catch (...)
               {
@@ -825,7 +900,7 @@ void Editor::UploadChanges(string const & key, string const & secret, TChangeset
               else
               {
                 LOG(LDEBUG, ("Uploading patched feature", osmFeature));
-                changeset.Modify(osmFeature);
+                changeset.AddModifyToBatch(osmFeature);
               }
             }
             break;
@@ -839,10 +914,17 @@ void Editor::UploadChanges(string const & key, string const & secret, TChangeset
               RemoveFeatureFromStorageIfExists(fti.m_feature.GetID());
               continue;
             }
-            changeset.Delete(GetMatchingFeatureFromOSM(
+            changeset.AddDeleteToBatch(GetMatchingFeatureFromOSM(
                 changeset, *originalFeaturePtr));
             break;
           }
+          if (changeset.GetBatchSize() != batchSize)
+          {
+            batched.emplace_back(&fti, ourDebugFeatureString);
+            if (batched.size() >= ChangesetWrapper::kMaxBatchSize)
+              flushBatch();
+            continue;
+          }
           fti.m_uploadStatus = kUploaded;
           fti.m_uploadError.clear();
           ++uploadedFeaturesCount;
@@ -875,22 +957,10 @@ void Editor::UploadChanges(string const & key, string const & secret, TChangeset
           ++errorsCount;
           LOG(LWARNING, (ex.what()));
         }
-        // TODO(AlexZ): Use timestamp from the server.
-        fti.m_uploadAttemptTimestamp = time(nullptr);
-
-        if (fti.m_uploadStatus != kUploaded)
-        {
-          ms::LatLon const ll = MercatorBounds::ToLatLon(feature::GetCenter(fti.m_feature));
-          alohalytics::LogEvent("Editor_DataSync_error", {{"type", fti.m_uploadStatus},
-                                {"details", fti.m_uploadError}, {"our", ourDebugFeatureString},
-                                {"mwm", fti.m_feature.GetID().GetMwmName()},
-                                {"mwm_version", strings::to_string(fti.m_feature.GetID().GetMwmVersion())}},
-                                alohalytics::Location::FromLatLon(ll.lat, ll.lon));
-        }
-        // Call Save every time we modify each feature's information.
-        SaveUploadedInformation(fti);
+        finishUpload(fti, ourDebugFeatureString);
       }
     }
+    flushBatch();
 
     alohalytics::LogEvent("Editor_DataSync_finished", {{"errors", strings::to_string(errorsCount)},
                           {"uploaded", strings::to_string(uploadedFeaturesCount)},
@@ -967,11 +1037,13 @@ void Editor::RemoveFeatureFromStorageIfExists(MwmSet::MwmId const & mwmId, uint3
     return;
 
   auto matchedIndex = matchedMwm->second.find(index);
-  if (matchedIndex != matchedMwm->second.end())
-    matchedMwm->second.erase(matchedIndex);
+  if (matchedIndex == matchedMwm->second.end())
+    return;
 
+  matchedMwm->second.erase(matchedIndex);
   if (matchedMwm->second.empty())
     m_features.erase(matchedMwm);
+  UpdateEditsIndex();
 }
 
 void Editor::RemoveFeatureFromStorageIfExists(FeatureID const & fid)
@@ -1127,6 +1199,45 @@ void Editor::UploadNotes(string const & key, string const & secret)
   m_notes->Upload(OsmOAuth::ServerAuth({key, secret}));
 }
 
+void Editor::UpdateEditsIndex() const
+{
+  map<MwmSet::MwmId, editor::EditsIndex::Mwm> mwms;
+  if (m_features.empty())
+  {
+    m_editsIndexMwms.swap(mwms);
+    m_editsIndex.reset();
+    return;
+  }
+
+  editor::EditsIndex::Builder builder;
+  for (auto const & mwm : m_features)
+  {
+    auto const & info = mwm.first.GetInfo();
+    for (auto const & index : mwm.second)
+    {
+      builder.Add(info->GetCountryName(), info->GetVersion(), index.first,
+                  static_cast<editor::EditsIndex::Status>(index.second.m_status));
+    }
+  }
+
+  vector<uint8_t> buffer;
+  builder.Serialize(buffer);
+  auto editsIndex = m_storage->SaveIndex(buffer);
+  if (!editsIndex)
+    editsIndex = make_unique<editor::EditsIndex>(move(buffer));
+
+  for (auto const & mwm : m_features)
+  {
+    auto const & info = mwm.first.GetInfo();
+    editor::EditsIndex::Mwm indexMwm;
+    VERIFY(editsIndex->GetMwm(info->GetCountryName(), info->GetVersion(), indexMwm), ());
+    mwms.emplace(mwm.first, indexMwm);
+  }
+
+  m_editsIndexMwms.swap(mwms);
+  m_editsIndex = move(editsIndex);
+}
+
 void Editor::MarkFeatureWithStatus(FeatureID const & fid, FeatureStatus status)
 {
   auto & fti = m_features[fid.m_mwmId][fid.m_index];
@@ -12,6 +12,7 @@
 #include "editor/editor_config.hpp"
 #include "editor/editor_notes.hpp"
 #include "editor/editor_storage.hpp"
+#include "editor/edits_index.hpp"
 #include "editor/xml_feature.hpp"
 
 #include "base/timer.hpp"
@@ -236,6 +237,9 @@ private:
 
   void MarkFeatureWithStatus(FeatureID const & fid, FeatureStatus status);
 
+  // Rebuilds the index of statuses by m_features.
+  void UpdateEditsIndex() const;
+
   // These methods are just checked wrappers around Delegate.
   MwmSet::MwmId GetMwmIdByMapName(string const & name);
   unique_ptr<FeatureType> GetOriginalFeature(FeatureID const & fid) const;
@@ -245,6 +249,9 @@ private:
   // TODO(AlexZ): Synchronize multithread access.
   /// Deleted, edited and created features.
   map<MwmSet::MwmId, map<uint32_t, FeatureTypeInfo>> m_features;
+  /// Statuses of m_features, GetFeatureStatus() is a binary search in it.
+  mutable unique_ptr<editor::EditsIndex> m_editsIndex;
+  mutable map<MwmSet::MwmId, editor::EditsIndex::Mwm> m_editsIndexMwms;
 
   unique_ptr<Delegate> m_delegate;
 
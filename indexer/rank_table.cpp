@@ -4,6 +4,7 @@
 #include "indexer/feature_algo.hpp"
 #include "indexer/feature_impl.hpp"
 #include "indexer/feature_utils.hpp"
+#include "indexer/features_offsets_table.hpp"
 #include "indexer/features_vector.hpp"
 #include "indexer/ftypes_matcher.hpp"
 
@@ -14,6 +15,7 @@
 #include "coding/file_container.hpp"
 #include "coding/file_writer.hpp"
 #include "coding/memory_region.hpp"
+#include "coding/mmap_reader.hpp"
 #include "coding/reader.hpp"
 #include "coding/simple_dense_coding.hpp"
 #include "coding/succinct_mapper.hpp"
@@ -68,6 +70,19 @@ unique_ptr<CopiedMemoryRegion> GetMemoryRegionForTag(FilesContainerR const & rco
   return make_unique<CopiedMemoryRegion>(move(buffer));
 }
 
+// Returns null when the section isn't mapped by MmapReader.
+unique_ptr<MmapMemoryRegion> GetMmapRegionForTag(FilesContainerR const & rcont,
+                                                 FilesContainerBase::Tag const & tag)
+{
+  if (!rcont.IsExist(tag))
+    return unique_ptr<MmapMemoryRegion>();
+
+  FilesContainerR::TReader reader = rcont.GetReader(tag);
+  if (!MmapReader::GetMappedData(*reader.GetPtr()))
+    return unique_ptr<MmapMemoryRegion>();
+  return make_unique<MmapMemoryRegion>(reader);
+}
+
 unique_ptr<MappedMemoryRegion> GetMemoryRegionForTag(FilesMappingContainer const & mcont,
                                                      FilesContainerBase::Tag const & tag)
 {
@@ -114,8 +129,8 @@ public:
       ReverseFreeze(m_coding, writer, "SimpleDenseCoding");
   }
 
-  // Loads RankTableV0 from a raw memory region.
-  static unique_ptr<RankTableV0> Load(unique_ptr<MappedMemoryRegion> && region)
+  // Loads RankTableV0 from a raw immutable memory region.
+  static unique_ptr<RankTableV0> Load(unique_ptr<MemoryRegion> && region)
   {
     if (!region.get())
       return unique_ptr<RankTableV0>();
@@ -222,8 +237,9 @@ uint8_t CalcSearchRank(FeatureType const & ft)
 
 // Creates rank table if it does not exists in |rcont| or has wrong
 // endianness. Otherwise (table exists and has correct format) returns
-// null.
-unique_ptr<RankTable> CreateRankTableIfNotExists(FilesContainerR & rcont)
+// null. Ranks are calculated on |threadsCount| threads when it's
+// greater than one, |rcont| must be opened from a file in this case.
+unique_ptr<RankTable> CreateRankTableIfNotExists(FilesContainerR & rcont, size_t threadsCount)
 {
   unique_ptr<RankTable> table;
 
@@ -257,7 +273,10 @@ unique_ptr<RankTable> CreateRankTableIfNotExists(FilesContainerR & rcont)
   if (!table)
   {
     vector<uint8_t> ranks;
-    RankTableBuilder::CalcSearchRanks(rcont, ranks);
+    if (threadsCount > 1)
+      RankTableBuilder::CalcSearchRanks(rcont.GetFileName(), threadsCount, ranks);
+    else
+      RankTableBuilder::CalcSearchRanks(rcont, ranks);
     table = make_unique<RankTableV0>(ranks);
   }
 
@@ -268,6 +287,13 @@ unique_ptr<RankTable> CreateRankTableIfNotExists(FilesContainerR & rcont)
 // static
 unique_ptr<RankTable> RankTable::Load(FilesContainerR const & rcont)
 {
+  // Ranks of a mapped mwm are used in place, a copy is made only on
+  // endianness mismatch.
+  if (auto region = GetMmapRegionForTag(rcont, RANKS_FILE_TAG))
+  {
+    if (auto table = LoadRankTable(move(region)))
+      return table;
+  }
   return LoadRankTable(GetMemoryRegionForTag(rcont, RANKS_FILE_TAG));
 }
 
@@ -289,6 +315,29 @@ void RankTableBuilder::CalcSearchRanks(FilesContainerR & rcont, vector<uint8_t>
                          });
 }
 
+// static
+void RankTableBuilder::CalcSearchRanks(string const & mapPath, size_t threadsCount,
+                                       vector<uint8_t> & ranks)
+{
+  {
+    FilesContainerR rcont(mapPath);
+    // Without the offsets table features can't be split by ranges of indices.
+    if (!rcont.IsExist(FEATURE_OFFSETS_FILE_TAG))
+    {
+      CalcSearchRanks(rcont, ranks);
+      return;
+    }
+    ranks.assign(feature::FeaturesOffsetsTable::Load(rcont)->size(), 0);
+  }
+
+  // Every rank is written to its own place, so the threads don't need to be synchronized.
+  ForEachFeatureParallel(mapPath, threadsCount,
+                         [&ranks](FeatureType const & ft, uint32_t index)
+                         {
+                           ranks[index] = CalcSearchRank(ft);
+                         });
+}
+
 // static
 bool RankTableBuilder::CreateIfNotExists(platform::LocalCountryFile const & localFile) noexcept
 {
@@ -305,7 +354,7 @@ bool RankTableBuilder::CreateIfNotExists(platform::LocalCountryFile const & loca
       mapPath = reader.GetName();
 
       FilesContainerR rcont(reader);
-      table = CreateRankTableIfNotExists(rcont);
+      table = CreateRankTableIfNotExists(rcont, 1 /* threadsCount */);
     }
 
     if (table)
@@ -321,14 +370,14 @@ bool RankTableBuilder::CreateIfNotExists(platform::LocalCountryFile const & loca
 }
 
 // static
-bool RankTableBuilder::CreateIfNotExists(string const & mapPath) noexcept
+bool RankTableBuilder::CreateIfNotExists(string const & mapPath, size_t threadsCount) noexcept
 {
   try
   {
     unique_ptr<RankTable> table;
     {
       FilesContainerR rcont(mapPath);
-      table = CreateRankTableIfNotExists(rcont);
+      table = CreateRankTableIfNotExists(rcont, threadsCount);
     }
 
     if (table)
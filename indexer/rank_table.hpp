@@ -65,7 +65,8 @@ public:
 
   // Copies whole section corresponding to a rank table and
   // deserializes it. Returns nullptr if there're no ranks section or
-  // rank table's header is damaged.
+  // rank table's header is damaged. When |rcont| is read by
+  // MmapReader, the section is used in place instead of the copy.
   //
   // *NOTE* Return value can outlive |rcont|. Also note that there is
   // undefined behaviour if ranks section exists but internally
@@ -91,6 +92,11 @@ public:
   // Calculates search ranks for all features in an mwm.
   static void CalcSearchRanks(FilesContainerR & rcont, vector<uint8_t> & ranks);
 
+  // Calculates search ranks for all features in the mwm at |mapPath|
+  // on |threadsCount| threads.
+  static void CalcSearchRanks(string const & mapPath, size_t threadsCount,
+                              vector<uint8_t> & ranks);
+
   // Following methods create rank table for an mwm.
   // * When rank table already exists and has proper endianness, does nothing.
   // * When rank table already exists but has improper endianness, re-creates it by
@@ -101,7 +107,7 @@ public:
   // Return true if rank table was successfully generated and written
   // or already exists and has correct format.
   static bool CreateIfNotExists(platform::LocalCountryFile const & localFile) noexcept;
-  static bool CreateIfNotExists(string const & mapPath) noexcept;
+  static bool CreateIfNotExists(string const & mapPath, size_t threadsCount = 1) noexcept;
 
   // Force creation of a rank table from array of ranks. Existing rank
   // table is removed (if any). Note that |wcont| must be instantiated
@@ -5,6 +5,8 @@
 #include "base/macros.hpp"
 #include "base/mem_trie.hpp"
 
+#include <limits>
+
 using namespace std;
 using namespace strings;
 
@@ -40,6 +42,22 @@ void RemoveNumeroSigns(UniString & s)
 
 UniString NormalizeAndSimplifyString(string const & s)
 {
+  // Fast path for ASCII strings: special chars, normalization and accents below
+  // don't change them, so they are only lowercased while they're decoded.
+  if (IsASCIIString(s))
+  {
+    UniString uniString;
+    uniString.resize_no_init(s.size());
+    UniChar * const data = uniString.data();
+    for (size_t i = 0; i < s.size(); ++i)
+    {
+      UniChar const c = static_cast<uint8_t>(s[i]);
+      data[i] = c + (static_cast<UniChar>(c - 'A' < 26) << 5);
+    }
+    RemoveNumeroSigns(uniString);
+    return uniString;
+  }
+
   UniString uniString = MakeUniString(s);
   for (size_t i = 0; i < uniString.size(); ++i)
   {
@@ -130,6 +148,25 @@ UniString FeatureTypeToString(uint32_t type)
   return UniString(s.begin(), s.end());
 }
 
+bool FeatureTypeFromString(UniString const & s, uint32_t & type)
+{
+  static UniString const kPrefix = MakeUniString("!type:");
+  if (s.size() <= kPrefix.size() || !StartsWith(s, kPrefix))
+    return false;
+
+  uint64_t value = 0;
+  for (size_t i = kPrefix.size(); i < s.size(); ++i)
+  {
+    if (s[i] < '0' || s[i] > '9')
+      return false;
+    value = value * 10 + (s[i] - '0');
+    if (value > numeric_limits<uint32_t>::max())
+      return false;
+  }
+  type = static_cast<uint32_t>(value);
+  return true;
+}
+
 namespace
 {
 char const * kStreetTokensSeparator = "\t -,.";
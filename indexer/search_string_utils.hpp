@@ -39,6 +39,9 @@ void NormalizeAndTokenizeString(std::string const & s, Tokens & tokens)
 
 strings::UniString FeatureTypeToString(uint32_t type);
 
+// Parses a string made by FeatureTypeToString(). Returns false if |s| is not such a string.
+bool FeatureTypeFromString(strings::UniString const & s, uint32_t & type);
+
 template <class Tokens, class Delims>
 bool TokenizeStringAndCheckIfLastTokenIsPrefix(strings::UniString const & s,
                                                Tokens & tokens,
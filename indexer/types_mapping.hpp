@@ -18,6 +18,9 @@ class IndexAndTypeMapping
 public:
   void Clear();
   void Load(istream & s);
+  void Load(vector<uint32_t> const & types);
+
+  vector<uint32_t> const & GetTypes() const { return m_types; }
 
   uint32_t GetType(uint32_t ind) const
   {
@@ -162,3 +162,23 @@ UNIT_TEST(LocalAdsStatistics_Process_Complex)
   expectedResult2.push_back(local_ads::Event(events2.back()));
   TEST_EQUAL(statistics.ReadEventsForTesting("Minsk_123456.dat"), expectedResult2, ());
 }
+
+UNIT_TEST(LocalAdsStatistics_Flush_On_Teardown)
+{
+  local_ads::Statistics statistics;
+  StatisticsGuard guard(statistics);
+  statistics.Startup();
+
+  std::list<local_ads::Event> events;
+  events.emplace_back(ET::ShowPoint, 123456, "Moscow", 111, 15, TS(minutes(5)), 20.0, 14.0, 20);
+  events.emplace_back(ET::OpenInfo, 123456, "Moscow", 111, 17, TS(minutes(25)), 40.0, 14.0, 20);
+  auto const expectedResult = events;
+
+  statistics.RegisterEvents(std::move(events));
+  statistics.RegisterEvent(local_ads::Event(ET::ShowPoint, 123456, "Minsk", 222, 13,
+                                            TS(minutes(10)), 30.0, 14.0, 20));
+  statistics.Teardown();
+
+  TEST_EQUAL(statistics.ReadEventsForTesting("Moscow_123456.dat"), expectedResult, ());
+  TEST_EQUAL(statistics.ReadEventsForTesting("Minsk_123456.dat").size(), 1, ());
+}
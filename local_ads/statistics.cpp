@@ -31,6 +31,10 @@ uint64_t constexpr kMaxFilesSizeInBytes = 10 * 1024 * 1024;
 float const kEventsDisposingRate = 0.2f;
 
 auto constexpr kSendingTimeout = std::chrono::hours(1);
+// Registered events are written to files by batches: once in the period or when there are
+// too many of them.
+auto constexpr kFlushPeriod = std::chrono::seconds(10);
+size_t constexpr kMaxBufferedEvents = 1000;
 int64_t constexpr kEventMaxLifetimeInSeconds = 24 * 183 * 3600;  // About half of year.
 auto constexpr kDeletionPeriod = std::chrono::hours(24);
 
@@ -191,20 +195,23 @@ bool Statistics::RequestEvents(std::list<Event> & events, bool & needToSend)
 {
   std::unique_lock<std::mutex> lock(m_mutex);
 
-  bool const isTimeout = !m_condition.wait_for(lock, kSendingTimeout, [this]
+  m_condition.wait_for(lock, kFlushPeriod, [this]
   {
-    return !m_isRunning || !m_events.empty();
+    return !m_isRunning || m_events.size() >= kMaxBufferedEvents;
   });
 
+  // Buffered events are written on teardown too.
+  events = std::move(m_events);
+  m_events.clear();
+
   if (!m_isRunning)
+  {
+    needToSend = false;
     return false;
+  }
 
-  using namespace std::chrono;
-  needToSend = m_isFirstSending || isTimeout ||
+  needToSend = m_isFirstSending ||
     (std::chrono::steady_clock::now() > (m_lastSending + kSendingTimeout));
-
-  events = std::move(m_events);
-  m_events.clear();
   return true;
 }
 
@@ -214,7 +221,9 @@ void Statistics::RegisterEvent(Event && event)
   if (!m_isRunning)
     return;
   m_events.push_back(std::move(event));
-  m_condition.notify_one();
+  // The thread is woken only when the buffer is full, otherwise it flushes events by timeout.
+  if (m_events.size() >= kMaxBufferedEvents)
+    m_condition.notify_one();
 }
 
 void Statistics::RegisterEvents(std::list<Event> && events)
@@ -223,16 +232,20 @@ void Statistics::RegisterEvents(std::list<Event> && events)
   if (!m_isRunning)
     return;
   m_events.splice(m_events.end(), std::move(events));
-  m_condition.notify_one();
+  if (m_events.size() >= kMaxBufferedEvents)
+    m_condition.notify_one();
 }
 
 void Statistics::ThreadRoutine()
 {
   std::list<Event> events;
   bool needToSend = false;
-  while (RequestEvents(events, needToSend))
+  bool isRunning = true;
+  while (isRunning)
   {
-    ProcessEvents(events);
+    isRunning = RequestEvents(events, needToSend);
+    if (!events.empty())
+      ProcessEvents(events);
     events.clear();
 
     // Send statistics to server.
@@ -394,7 +407,7 @@ void Statistics::SendToServer()
 
   for (auto it = m_metadataCache.begin(); it != m_metadataCache.end();)
   {
-    std::string const url = MakeRemoteURL(m_userId, it->first.first, it->first.second);
+    std::string const url = MakeRemoteURL(userId, it->first.first, it->first.second);
     if (url.empty())
       return;
 
@@ -419,7 +432,14 @@ void Statistics::SendToServer()
 #endif
     request.SetBodyData(std::string(bytes.begin(), bytes.end()), contentType, "POST",
                         contentEncoding);
-    if (request.RunHttpRequest() && request.ErrorCode() == 200)
+    if (!request.RunHttpRequest())
+    {
+      // There is no connection, the rest of files are sent next time.
+      LOG(LWARNING, ("Sending statistics failed:", "URL:", url, it->first.first, it->first.second));
+      break;
+    }
+
+    if (request.ErrorCode() == 200)
     {
       FileWriter::DeleteFileX(it->second.m_fileName);
       it = m_metadataCache.erase(it);
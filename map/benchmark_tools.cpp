@@ -7,16 +7,23 @@
 #include "platform/http_client.hpp"
 #include "platform/platform.hpp"
 
+#include "coding/file_reader.hpp"
+#include "coding/file_writer.hpp"
+
 #include "3party/jansson/myjansson.hpp"
 
 #include <algorithm>
 #include <atomic>
+#include <cstring>
 #include <set>
 #include <string>
 #include <vector>
 
 namespace
 {
+char const kScenariosFile[] = "graphics_benchmark.json";
+char const kReportFile[] = "graphics_benchmark_report.json";
+char const kScenariosUrl[] = "http://osmz.ru/mwm/graphics_benchmark.json";
 
 struct BenchmarkHandle
 {
@@ -24,16 +31,87 @@ struct BenchmarkHandle
   size_t m_currentScenario = 0;
   std::vector<storage::TCountryId> m_regionsToDownload;
   size_t m_regionsToDownloadCounter = 0;
+  std::vector<df::ScenarioManager::ScenarioReport> m_reports;
 
 #ifdef DRAPE_MEASURER
   std::vector<std::pair<string, df::DrapeMeasurer::DrapeStatistic>> m_drapeStatistic;
 #endif
 };
 
+my::JSONPtr ToJSON(df::ScenarioManager::FrameTimeStatistic const & statistic)
+{
+  auto node = my::NewJSONObject();
+  ToJSONObject(*node, "framesCount", statistic.m_framesCount);
+  ToJSONObject(*node, "avgTimeInMs", statistic.m_avgTimeInMs);
+  ToJSONObject(*node, "medianTimeInMs", statistic.m_medianTimeInMs);
+  ToJSONObject(*node, "p90TimeInMs", statistic.m_p90TimeInMs);
+  ToJSONObject(*node, "p99TimeInMs", statistic.m_p99TimeInMs);
+  ToJSONObject(*node, "maxTimeInMs", statistic.m_maxTimeInMs);
+  return node;
+}
+
+std::string ToString(df::ScenarioManager::ActionType type)
+{
+  switch (type)
+  {
+  case df::ScenarioManager::ActionType::CenterViewport: return "centerViewport";
+  case df::ScenarioManager::ActionType::WaitForTime: return "waitForTime";
+  case df::ScenarioManager::ActionType::WaitForTiles: return "waitForTiles";
+  }
+  ASSERT(false, ());
+  return {};
+}
+
+// Writes reports of all scenarios to the writable directory, so they can be
+// collected after a run in CI.
+void WriteReports(std::vector<df::ScenarioManager::ScenarioReport> const & reports)
+{
+  auto root = my::NewJSONObject();
+  auto scenarios = my::NewJSONArray();
+  for (auto const & report : reports)
+  {
+    auto scenario = my::NewJSONObject();
+    ToJSONObject(*scenario, "name", report.m_name);
+    ToJSONObject(*scenario, "interrupted", report.m_isInterrupted);
+    json_object_set_new(scenario.get(), "frameTime", ToJSON(report.m_frameTime).release());
+
+    auto steps = my::NewJSONArray();
+    for (auto const & step : report.m_steps)
+    {
+      auto stepNode = my::NewJSONObject();
+      ToJSONObject(*stepNode, "actionType", ToString(step.m_actionType));
+      ToJSONObject(*stepNode, "durationInMs", step.m_durationInMs);
+      if (step.m_actionType == df::ScenarioManager::ActionType::WaitForTiles)
+        ToJSONObject(*stepNode, "tilesCompleteTimeInMs", step.m_tilesCompleteTimeInMs);
+      ToJSONObject(*stepNode, "tilesRequested", step.m_tilesRequestedCount);
+      ToJSONObject(*stepNode, "tilesRead", step.m_tilesReadCount);
+      json_object_set_new(stepNode.get(), "frameTime", ToJSON(step.m_frameTime).release());
+      json_array_append_new(steps.get(), stepNode.release());
+    }
+    json_object_set_new(scenario.get(), "steps", steps.release());
+    json_array_append_new(scenarios.get(), scenario.release());
+  }
+  json_object_set_new(root.get(), "scenarios", scenarios.release());
+
+  std::unique_ptr<char, JSONFreeDeleter> buffer(json_dumps(root.get(), JSON_INDENT(2)));
+  std::string const path = GetPlatform().WritablePathForFile(kReportFile);
+  try
+  {
+    FileWriter writer(path);
+    writer.Write(buffer.get(), strlen(buffer.get()));
+    LOG(LINFO, ("Graphics benchmark report is written to", path));
+  }
+  catch (FileWriter::Exception const & e)
+  {
+    LOG(LERROR, ("Can't write graphics benchmark report", path, e.Msg()));
+  }
+}
+
 void RunScenario(Framework * framework, std::shared_ptr<BenchmarkHandle> handle)
 {
   if (handle->m_currentScenario >= handle->m_scenariosToRun.size())
   {
+    WriteReports(handle->m_reports);
 #ifdef DRAPE_MEASURER
     for (auto const & it : handle->m_drapeStatistic)
     {
@@ -48,26 +126,28 @@ void RunScenario(Framework * framework, std::shared_ptr<BenchmarkHandle> handle)
 
   auto & scenarioData = handle->m_scenariosToRun[handle->m_currentScenario];
 
-  framework->GetDrapeEngine()->RunScenario(std::move(scenarioData),
-                                           [handle](std::string const & name)
+  auto const onStart = [handle](std::string const & name)
   {
 #ifdef DRAPE_MEASURER
     df::DrapeMeasurer::Instance().StartBenchmark();
 #endif
-  },
-                                           [framework, handle](std::string const & name)
+  };
+  auto const onFinish = [framework, handle](df::ScenarioManager::ScenarioReport const & report)
   {
 #ifdef DRAPE_MEASURER
     df::DrapeMeasurer::Instance().StopBenchmark();
     auto const drapeStatistic = df::DrapeMeasurer::Instance().GetDrapeStatistic();
-    handle->m_drapeStatistic.push_back(make_pair(name, drapeStatistic));
+    handle->m_drapeStatistic.push_back(make_pair(report.m_name, drapeStatistic));
 #endif
-    GetPlatform().RunOnGuiThread([framework, handle]()
+    LOG(LINFO, (report.ToString()));
+    GetPlatform().RunOnGuiThread([framework, handle, report]()
     {
+      handle->m_reports.push_back(report);
       handle->m_currentScenario++;
       RunScenario(framework, handle);
     });
-  });
+  };
+  framework->GetDrapeEngine()->RunScenario(std::move(scenarioData), onStart, onFinish);
 }
 } //  namespace
 
@@ -78,16 +158,34 @@ void RunGraphicsBenchmark(Framework * framework)
 #ifdef SCENARIO_ENABLE
   using namespace df;
 
-  // Request scenarios from the server.
-  platform::HttpClient request("http://osmz.ru/mwm/graphics_benchmark.json");
-  if (!request.RunHttpRequest())
-    return;
+  // Scenarios are read from the writable directory, so they can be scripted
+  // for a run in CI, or requested from the server.
+  std::string result;
+  std::string const scenariosPath = GetPlatform().WritablePathForFile(kScenariosFile);
+  if (Platform::IsFileExistsByFullPath(scenariosPath))
+  {
+    try
+    {
+      FileReader(scenariosPath).ReadAsString(result);
+    }
+    catch (FileReader::Exception const & e)
+    {
+      LOG(LERROR, ("Can't read graphics benchmark scenarios", scenariosPath, e.Msg()));
+      return;
+    }
+  }
+  else
+  {
+    platform::HttpClient request(kScenariosUrl);
+    if (!request.RunHttpRequest())
+      return;
+    result = request.ServerResponse();
+  }
 
   std::shared_ptr<BenchmarkHandle> handle = std::make_shared<BenchmarkHandle>();
 
   // Parse scenarios.
   std::vector<m2::PointD> points;
-  string const & result = request.ServerResponse();
   try
   {
     my::Json root(result.c_str());
@@ -132,10 +230,22 @@ void RunGraphicsBenchmark(Framework * framework)
             FromJSONObject(centerNode, "y", y);
             json_int_t zoomLevel = -1;
             FromJSONObject(stepElem, "zoomLevel", zoomLevel);
+            // Rapid pans are scripted without animation.
+            bool isAnim = true;
+            if (json_object_get(stepElem, "animated") != nullptr)
+              FromJSONObject(stepElem, "animated", isAnim);
             m2::PointD const pt(x, y);
             points.push_back(pt);
             scenario.push_back(std::unique_ptr<ScenarioManager::Action>(
-                                 new ScenarioManager::CenterViewportAction(pt, static_cast<int>(zoomLevel))));
+                new ScenarioManager::CenterViewportAction(pt, static_cast<int>(zoomLevel), isAnim)));
+          }
+          else if (actionType == "waitForTiles")
+          {
+            json_int_t timeoutInSeconds = 30;
+            if (json_object_get(stepElem, "timeout") != nullptr)
+              FromJSONObject(stepElem, "timeout", timeoutInSeconds);
+            scenario.push_back(std::unique_ptr<ScenarioManager::Action>(
+                new ScenarioManager::WaitForTilesAction(seconds(timeoutInSeconds))));
           }
         }
       }
@@ -4,5 +4,15 @@ class Framework;
 
 namespace benchmark
 {
+// Runs scenarios of graphics_benchmark.json from the writable directory or
+// from the server, when there is no such file. A scenario is
+//   {"name": "...", "steps": [step, ...]}
+// where steps are
+//   {"actionType": "centerViewport", "center": {"x": x, "y": y}, "zoomLevel": z,
+//    "animated": true}
+//   {"actionType": "waitForTime", "time": seconds}
+//   {"actionType": "waitForTiles", "timeout": seconds}
+// Reports of scenarios are written to graphics_benchmark_report.json in the
+// writable directory. Works with SCENARIO_ENABLE only.
 void RunGraphicsBenchmark(Framework * framework);
 } //  namespace benchmark
@@ -5,12 +5,18 @@
 
 #include "base/scope_guard.hpp"
 
+#include "geometry/distance.hpp"
 #include "geometry/mercator.hpp"
+#include "geometry/simplification.hpp"
 
 #include "coding/file_reader.hpp"
+#include "coding/file_writer.hpp"
 #include "coding/parse_xml.hpp"  // LoadFromKML
 #include "coding/internal/file_data.hpp"
 #include "coding/hex.hpp"
+#include "coding/read_write_utils.hpp"
+#include "coding/varint.hpp"
+#include "coding/write_to_sink.hpp"
 
 #include "drape/drape_global.hpp"
 #include "drape/color.hpp"
@@ -19,10 +25,13 @@
 
 #include "platform/platform.hpp"
 
+#include "defines.hpp"
+
 #include "base/stl_add.hpp"
 #include "base/string_utils.hpp"
 
 #include <algorithm>
+#include <cstring>
 #include <fstream>
 #include <iterator>
 #include <map>
@@ -196,6 +205,31 @@ namespace
     return ss.str();
   }
 
+  // Tracks with more points are simplified by Douglas-Peucker with the epsilon in mercator,
+  // it's about a meter. Shorter tracks are kept as is.
+  size_t constexpr kMaxTrackPointsWithoutSimplification = 10000;
+  double constexpr kTrackSimplificationEpsilon = 1e-5;
+
+  void SimplifyTrack(m2::PolylineD const & points, m2::PolylineD & result)
+  {
+    if (points.GetSize() <= kMaxTrackPointsWithoutSimplification)
+    {
+      result = points;
+      return;
+    }
+
+    auto const & v = points.GetPoints();
+    std::vector<m2::PointD> simplified;
+    simplified.reserve(v.size() / 4);
+    simplified.push_back(v.front());
+    SimplifyDP(v.cbegin(), v.cend(), kTrackSimplificationEpsilon * kTrackSimplificationEpsilon,
+               m2::DistanceToLineSquare<m2::PointD>(),
+               MakeBackInsertFunctor(simplified));
+    // SimplifyDP() doesn't include the last point.
+    simplified.push_back(v.back());
+    result = m2::PolylineD(std::move(simplified));
+  }
+
   enum GeometryType
   {
     GEOMETRY_TYPE_UNKNOWN,
@@ -214,7 +248,7 @@ namespace
       return style::GetSupportedStyle(result, m_name, style::GetDefaultStyle());
     }
 
-    BookmarkCategory & m_category;
+    BookmarkCategoryData & m_data;
 
     std::vector<std::string> m_tags;
     GeometryType m_geometryType;
@@ -353,17 +387,12 @@ namespace
     }
 
   public:
-    KMLParser(BookmarkCategory & cat)
-      : m_category(cat)
+    KMLParser(BookmarkCategoryData & data)
+      : m_data(data)
     {
       Reset();
     }
 
-    ~KMLParser()
-    {
-      m_category.NotifyChanges();
-    }
-
     bool Push(std::string const & name)
     {
       m_tags.push_back(name);
@@ -403,17 +432,20 @@ namespace
         {
           if (GEOMETRY_TYPE_POINT == m_geometryType)
           {
-            Bookmark * bm = static_cast<Bookmark *>(m_category.CreateUserMark(m_org));
-            bm->SetData(BookmarkData(m_name, m_type, m_description, m_scale, m_timeStamp));
+            m_data.m_bookmarks.emplace_back(
+                m_org, BookmarkData(m_name, m_type, m_description, m_scale, m_timeStamp));
           }
           else if (GEOMETRY_TYPE_LINE == m_geometryType)
           {
-            Track::Params params;
-            params.m_colors.push_back({ kDefaultTrackWidth, m_trackColor });
-            params.m_name = m_name;
+            BookmarkCategoryData::TrackData track;
+            track.m_params.m_colors.push_back({ kDefaultTrackWidth, m_trackColor });
+            track.m_params.m_name = m_name;
+            // Tracks are simplified as soon as they are read, so the points of a whole
+            // file are never kept.
+            SimplifyTrack(m_points, track.m_polyline);
 
             /// @todo Add description, style, timestamp
-            m_category.AddTrack(make_unique<Track>(m_points, params));
+            m_data.m_tracks.push_back(std::move(track));
           }
         }
         Reset();
@@ -447,9 +479,14 @@ namespace
         if (prevTag == kDocument)
         {
           if (currTag == "name")
-            m_category.SetName(value);
+          {
+            m_data.m_name = value;
+          }
           else if (currTag == "visibility")
-            m_category.SetIsVisible(value == "0" ? false : true);
+          {
+            m_data.m_hasVisibility = true;
+            m_data.m_isVisible = value == "0" ? false : true;
+          }
         }
         else if (prevTag == kPlacemark)
         {
@@ -561,10 +598,40 @@ std::string BookmarkCategory::GetDefaultType()
   return style::GetDefaultStyle();
 }
 
+void BookmarkCategory::AddData(BookmarkCategoryData && data)
+{
+  if (!data.m_name.empty())
+    SetName(data.m_name);
+  if (data.m_hasVisibility)
+    SetIsVisible(data.m_isVisible);
+
+  for (auto const & bookmark : data.m_bookmarks)
+  {
+    Bookmark * bm = static_cast<Bookmark *>(CreateUserMark(bookmark.first));
+    bm->SetData(bookmark.second);
+  }
+
+  m_tracks.reserve(m_tracks.size() + data.m_tracks.size());
+  for (auto const & track : data.m_tracks)
+    AddTrack(make_unique<Track>(track.m_polyline, track.m_params));
+
+  NotifyChanges();
+}
+
 bool BookmarkCategory::LoadFromKML(ReaderPtr<Reader> const & reader)
+{
+  BookmarkCategoryData data;
+  if (!ReadKML(reader, data))
+    return false;
+  AddData(std::move(data));
+  return true;
+}
+
+// static
+bool BookmarkCategory::ReadKML(ReaderPtr<Reader> const & reader, BookmarkCategoryData & data)
 {
   ReaderSource<ReaderPtr<Reader> > src(reader);
-  KMLParser parser(*this);
+  KMLParser parser(data);
   if (ParseXML(src, parser, true))
     return true;
   else
@@ -574,23 +641,253 @@ bool BookmarkCategory::LoadFromKML(ReaderPtr<Reader> const & reader)
   }
 }
 
+namespace
+{
+uint8_t constexpr kCacheVersion = 0;
+
+// Doubles are stored bitwise, so coordinates are the same after loading.
+template <typename TSink>
+void WriteDouble(TSink & sink, double d)
+{
+  uint64_t bits;
+  static_assert(sizeof(bits) == sizeof(d), "");
+  memcpy(&bits, &d, sizeof(d));
+  WriteToSink(sink, bits);
+}
+
+template <typename TSource>
+double ReadDouble(TSource & src)
+{
+  uint64_t const bits = ReadPrimitiveFromSource<uint64_t>(src);
+  double d;
+  memcpy(&d, &bits, sizeof(d));
+  return d;
+}
+
+template <typename TSink>
+void WritePoint(TSink & sink, m2::PointD const & pt)
+{
+  WriteDouble(sink, pt.x);
+  WriteDouble(sink, pt.y);
+}
+
+template <typename TSource>
+m2::PointD ReadPoint(TSource & src)
+{
+  double const x = ReadDouble(src);
+  double const y = ReadDouble(src);
+  return m2::PointD(x, y);
+}
+
+bool GetKMLFileInfo(std::string const & file, uint64_t & size, uint64_t & time)
+{
+  return Platform::GetFileSizeByFullPath(file, size) &&
+         Platform::GetFileModificationTimeByFullPath(file, time);
+}
+}  // namespace
+
+// static
+std::string BookmarkCategory::GetCacheFileName(std::string const & file)
+{
+  return file + BOOKMARKS_CACHE_FILE_EXTENSION;
+}
+
+bool BookmarkCategory::LoadFromCache(ReaderPtr<Reader> const & reader, uint64_t kmlSize,
+                                     uint64_t kmlTime)
+{
+  BookmarkCategoryData data;
+  if (!ReadCache(reader, kmlSize, kmlTime, data))
+    return false;
+  AddData(std::move(data));
+  return true;
+}
+
+// static
+bool BookmarkCategory::ReadCache(ReaderPtr<Reader> const & reader, uint64_t kmlSize,
+                                 uint64_t kmlTime, BookmarkCategoryData & data)
+{
+  ReaderSource<ReaderPtr<Reader>> src(reader);
+  if (ReadPrimitiveFromSource<uint8_t>(src) != kCacheVersion ||
+      ReadVarUint<uint64_t>(src) != kmlSize || ReadVarUint<uint64_t>(src) != kmlTime)
+  {
+    return false;
+  }
+
+  rw::Read(src, data.m_name);
+  data.m_hasVisibility = true;
+  data.m_isVisible = ReadPrimitiveFromSource<uint8_t>(src) != 0;
+
+  uint64_t const bookmarksCount = ReadVarUint<uint64_t>(src);
+  data.m_bookmarks.reserve(static_cast<size_t>(bookmarksCount));
+  for (uint64_t i = 0; i < bookmarksCount; ++i)
+  {
+    m2::PointD const org = ReadPoint(src);
+    std::string bmName, type, description;
+    rw::Read(src, bmName);
+    rw::Read(src, type);
+    rw::Read(src, description);
+    double const scale = ReadDouble(src);
+    time_t const timeStamp = static_cast<time_t>(ReadVarInt<int64_t>(src));
+
+    data.m_bookmarks.emplace_back(org, BookmarkData(bmName, type, description, scale, timeStamp));
+  }
+
+  uint64_t const tracksCount = ReadVarUint<uint64_t>(src);
+  data.m_tracks.resize(static_cast<size_t>(tracksCount));
+  for (auto & track : data.m_tracks)
+  {
+    Track::Params & params = track.m_params;
+    rw::Read(src, params.m_name);
+    uint64_t const colorsCount = ReadVarUint<uint64_t>(src);
+    for (uint64_t j = 0; j < colorsCount; ++j)
+    {
+      Track::TrackOutline outline;
+      outline.m_lineWidth = static_cast<float>(ReadDouble(src));
+      uint8_t const r = ReadPrimitiveFromSource<uint8_t>(src);
+      uint8_t const g = ReadPrimitiveFromSource<uint8_t>(src);
+      uint8_t const b = ReadPrimitiveFromSource<uint8_t>(src);
+      uint8_t const a = ReadPrimitiveFromSource<uint8_t>(src);
+      outline.m_color = dp::Color(r, g, b, a);
+      params.m_colors.push_back(outline);
+    }
+
+    uint64_t const pointsCount = ReadVarUint<uint64_t>(src);
+    for (uint64_t j = 0; j < pointsCount; ++j)
+      track.m_polyline.Add(ReadPoint(src));
+  }
+
+  return true;
+}
+
+bool BookmarkCategory::SaveToCacheFile() const
+{
+  uint64_t kmlSize, kmlTime;
+  if (m_file.empty() || !GetKMLFileInfo(m_file, kmlSize, kmlTime))
+    return false;
+
+  std::string const cacheFile = GetCacheFileName(m_file);
+  std::string const cacheFileTmp = cacheFile + ".tmp";
+  try
+  {
+    {
+      FileWriter w(cacheFileTmp);
+      WriteToSink(w, kCacheVersion);
+      WriteVarUint(w, kmlSize);
+      WriteVarUint(w, kmlTime);
+
+      rw::Write(w, GetName());
+      WriteToSink(w, static_cast<uint8_t>(IsVisible() ? 1 : 0));
+
+      // Bookmarks are stored in reverse order like in KML, see SaveToKML().
+      size_t const bookmarksCount = GetUserMarkCount();
+      WriteVarUint(w, static_cast<uint64_t>(bookmarksCount));
+      for (size_t i = bookmarksCount; i > 0; --i)
+      {
+        Bookmark const * bm = static_cast<Bookmark const *>(GetUserMark(i - 1));
+        BookmarkData const & data = bm->GetData();
+        WritePoint(w, bm->GetPivot());
+        rw::Write(w, data.GetName());
+        rw::Write(w, data.GetType());
+        rw::Write(w, data.GetDescription());
+        WriteDouble(w, data.GetScale());
+        WriteVarInt(w, static_cast<int64_t>(data.GetTimeStamp()));
+      }
+
+      WriteVarUint(w, static_cast<uint64_t>(m_tracks.size()));
+      for (auto const & track : m_tracks)
+      {
+        rw::Write(w, track->GetName());
+        size_t const layersCount = track->GetLayerCount();
+        WriteVarUint(w, static_cast<uint64_t>(layersCount));
+        for (size_t j = 0; j < layersCount; ++j)
+        {
+          WriteDouble(w, track->GetWidth(j));
+          dp::Color const & color = track->GetColor(j);
+          WriteToSink(w, color.GetRed());
+          WriteToSink(w, color.GetGreen());
+          WriteToSink(w, color.GetBlue());
+          WriteToSink(w, color.GetAlfa());
+        }
+
+        auto const & points = track->GetPolyline().GetPoints();
+        WriteVarUint(w, static_cast<uint64_t>(points.size()));
+        for (auto const & pt : points)
+          WritePoint(w, pt);
+      }
+    }
+
+    if (my::RenameFileX(cacheFileTmp, cacheFile))
+      return true;
+  }
+  catch (RootException const & e)
+  {
+    LOG(LWARNING, ("Can't save bookmarks cache", cacheFile, e.Msg()));
+  }
+
+  my::DeleteFileX(cacheFileTmp);
+  return false;
+}
+
 BookmarkCategory * BookmarkCategory::CreateFromKMLFile(std::string const & file, Framework & framework)
 {
-  std::auto_ptr<BookmarkCategory> cat(new BookmarkCategory("", framework));
+  BookmarkCategoryData data;
+  bool fromCache = false;
+  if (!ReadFromKMLFile(file, data, fromCache))
+    return nullptr;
+  return CreateFromData(file, std::move(data), fromCache, framework).release();
+}
+
+// static
+bool BookmarkCategory::ReadFromKMLFile(std::string const & file, BookmarkCategoryData & data,
+                                       bool & fromCache)
+{
+  uint64_t kmlSize, kmlTime;
+  if (GetKMLFileInfo(file, kmlSize, kmlTime))
+  {
+    std::string const cacheFile = GetCacheFileName(file);
+    if (Platform::IsFileExistsByFullPath(cacheFile))
+    {
+      try
+      {
+        if (ReadCache(make_unique<FileReader>(cacheFile), kmlSize, kmlTime, data))
+        {
+          fromCache = true;
+          return true;
+        }
+      }
+      catch (RootException const & e)
+      {
+        LOG(LWARNING, ("Error while loading bookmarks cache", cacheFile, e.Msg()));
+      }
+      data = BookmarkCategoryData();
+    }
+  }
+
+  fromCache = false;
   try
   {
-    if (cat->LoadFromKML(make_unique<FileReader>(file)))
-      cat->m_file = file;
-    else
-      cat.reset();
+    return ReadKML(make_unique<FileReader>(file), data);
   }
   catch (std::exception const & e)
   {
     LOG(LWARNING, ("Error while loading bookmarks from", file, e.what()));
-    cat.reset();
   }
+  return false;
+}
 
-  return cat.release();
+// static
+std::unique_ptr<BookmarkCategory> BookmarkCategory::CreateFromData(std::string const & file,
+                                                                   BookmarkCategoryData && data,
+                                                                   bool fromCache,
+                                                                   Framework & framework)
+{
+  std::unique_ptr<BookmarkCategory> cat(new BookmarkCategory("", framework));
+  cat->AddData(std::move(data));
+  cat->m_file = file;
+  // Only own bookmarks are cached, e.g. files which are imported are copied there.
+  if (!fromCache && strings::StartsWith(file, GetPlatform().SettingsDir().c_str()))
+    cat->SaveToCacheFile();
+  return cat;
 }
 
 namespace
@@ -872,8 +1169,13 @@ bool BookmarkCategory::SaveToKMLFile()
       VERIFY(my::RenameFileX(fileTmp, m_file), (fileTmp, m_file));
       // delete old file
       if (!oldFile.empty())
+      {
         VERIFY(my::DeleteFileX(oldFile), (oldFile, m_file));
+        if (Platform::IsFileExistsByFullPath(GetCacheFileName(oldFile)))
+          my::DeleteFileX(GetCacheFileName(oldFile));
+      }
 
+      SaveToCacheFile();
       return true;
     }
   }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "map/track.hpp"
 #include "map/user_mark.hpp"
 #include "map/user_mark_container.hpp"
 
@@ -15,6 +16,7 @@
 #include <iostream>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace anim
@@ -22,8 +24,6 @@ namespace anim
   class Task;
 }
 
-class Track;
-
 class BookmarkData
 {
 public:
@@ -108,6 +108,26 @@ private:
   BookmarkData m_data;
 };
 
+/// Bookmarks and tracks of a category as they are read from a file. Reading of the data
+/// doesn't create user marks, so categories may be read on any thread and then added to
+/// BookmarkCategory on the thread of the framework.
+struct BookmarkCategoryData
+{
+  struct TrackData
+  {
+    m2::PolylineD m_polyline;
+    Track::Params m_params;
+  };
+
+  /// Empty if the file has no name of the category.
+  std::string m_name;
+  bool m_hasVisibility = false;
+  bool m_isVisible = true;
+  /// In the order of the file.
+  std::vector<std::pair<m2::PointD, BookmarkData>> m_bookmarks;
+  std::vector<TrackData> m_tracks;
+};
+
 class BookmarkCategory : public UserMarkContainer
 {
   typedef UserMarkContainer TBase;
@@ -140,18 +160,40 @@ public:
   std::string const & GetName() const { return m_name; }
   std::string const & GetFileName() const { return m_file; }
 
+  /// Creates bookmarks and tracks of |data| and notifies the drape engine once.
+  void AddData(BookmarkCategoryData && data);
+
   /// @name Theese fuctions are public for unit tests only.
   /// You don't need to call them from client code.
   //@{
   bool LoadFromKML(ReaderPtr<Reader> const & reader);
+  /// Tracks with many points are simplified while they are read.
+  static bool ReadKML(ReaderPtr<Reader> const & reader, BookmarkCategoryData & data);
   void SaveToKML(std::ostream & s);
 
   /// Uses the same file name from which was loaded, or
   /// creates unique file name on first save and uses it every time.
   bool SaveToKMLFile();
 
+  /// Binary cache of the category is kept next to its KML file, it's valid while
+  /// size and modification time of the KML file are the same.
+  bool LoadFromCache(ReaderPtr<Reader> const & reader, uint64_t kmlSize, uint64_t kmlTime);
+  static bool ReadCache(ReaderPtr<Reader> const & reader, uint64_t kmlSize, uint64_t kmlTime,
+                        BookmarkCategoryData & data);
+  bool SaveToCacheFile() const;
+  static std::string GetCacheFileName(std::string const & file);
+
+  /// Loads the category from its cache if it's valid, otherwise from KML.
   /// @return 0 in the case of error
   static BookmarkCategory * CreateFromKMLFile(std::string const & file, Framework & framework);
+  /// The same as CreateFromKMLFile() in two steps: ReadFromKMLFile() may be called on any
+  /// thread, CreateFromData() is called on the thread of the framework.
+  /// @return false in the case of error
+  static bool ReadFromKMLFile(std::string const & file, BookmarkCategoryData & data,
+                              bool & fromCache);
+  static std::unique_ptr<BookmarkCategory> CreateFromData(std::string const & file,
+                                                          BookmarkCategoryData && data,
+                                                          bool fromCache, Framework & framework);
 
   /// Get valid file name from input (remove illegal symbols).
   static std::string RemoveInvalidSymbols(std::string const & name);
@@ -13,10 +13,15 @@
 
 #include "base/macros.hpp"
 #include "base/stl_add.hpp"
+#include "base/thread.hpp"
 
 #include "std/target_os.hpp"
 
 #include <algorithm>
+#include <atomic>
+#include <functional>
+#include <thread>
+#include <vector>
 
 BookmarkManager::BookmarkManager(Framework & f)
   : m_framework(f)
@@ -41,6 +46,31 @@ namespace
 {
 char const * BOOKMARK_CATEGORY = "LastBookmarkCategory";
 char const * BOOKMARK_TYPE = "LastBookmarkType";
+
+// Bookmark files are read by a few threads, the rest of loading is done on the calling thread.
+size_t constexpr kMaxLoadingThreads = 4;
+
+// Calls |fn| for the files one by one while there are files nobody has taken yet.
+class ReadFilesRoutine final : public threads::IRoutine
+{
+public:
+  ReadFilesRoutine(size_t size, std::atomic<size_t> & next, std::function<void(size_t)> const & fn)
+    : m_size(size), m_next(next), m_fn(fn)
+  {
+  }
+
+  // threads::IRoutine overrides:
+  void Do() override
+  {
+    for (size_t i = m_next++; i < m_size; i = m_next++)
+      m_fn(i);
+  }
+
+private:
+  size_t const m_size;
+  std::atomic<size_t> & m_next;
+  std::function<void(size_t)> const & m_fn;
+};
 }
 
 void BookmarkManager::SaveState() const
@@ -68,8 +98,54 @@ void BookmarkManager::LoadBookmarks()
 
   Platform::FilesList files;
   Platform::GetFilesByExt(dir, BOOKMARKS_FILE_EXTENSION, files);
+  if (files.empty())
+  {
+    LoadState();
+    return;
+  }
+
+  // Files are parsed in parallel, but user marks aren't thread safe, so categories are
+  // created here in the order of files.
+  struct FileData
+  {
+    BookmarkCategoryData m_data;
+    bool m_isRead = false;
+    bool m_fromCache = false;
+  };
+
+  std::vector<FileData> filesData(files.size());
+  std::function<void(size_t)> const readFile = [&](size_t i)
+  {
+    FileData & fileData = filesData[i];
+    fileData.m_isRead = BookmarkCategory::ReadFromKMLFile(dir + files[i], fileData.m_data,
+                                                          fileData.m_fromCache);
+  };
+
+  size_t const hardwareThreads = std::max(std::thread::hardware_concurrency(), 1U);
+  size_t const threadsCount =
+      std::min(files.size(), std::min(kMaxLoadingThreads, hardwareThreads));
+  if (threadsCount <= 1)
+  {
+    for (size_t i = 0; i < files.size(); ++i)
+      readFile(i);
+  }
+  else
+  {
+    std::atomic<size_t> next(0);
+    threads::SimpleThreadPool pool(threadsCount);
+    for (size_t i = 0; i < threadsCount; ++i)
+      pool.Add(my::make_unique<ReadFilesRoutine>(files.size(), next, readFile));
+    pool.Join();
+  }
+
   for (size_t i = 0; i < files.size(); ++i)
-    LoadBookmark(dir + files[i]);
+  {
+    FileData & fileData = filesData[i];
+    if (!fileData.m_isRead)
+      continue;
+    m_categories.emplace_back(BookmarkCategory::CreateFromData(
+        dir + files[i], std::move(fileData.m_data), fileData.m_fromCache, m_framework));
+  }
 
   LoadState();
 }
@@ -171,6 +247,9 @@ void BookmarkManager::DeleteBmCategory(CategoryIter it)
   BookmarkCategory & cat = *it->get();
   cat.DeleteLater();
   FileWriter::DeleteFileX(cat.GetFileName());
+  string const cacheFile = BookmarkCategory::GetCacheFileName(cat.GetFileName());
+  if (Platform::IsFileExistsByFullPath(cacheFile))
+    FileWriter::DeleteFileX(cacheFile);
   m_categories.erase(it);
 }
 
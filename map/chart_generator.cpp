@@ -127,15 +127,18 @@ bool NormalizeChartData(vector<double> const & distanceDataM,
     return true;
   }
 
+  // Distances of the result points grow so the route segment of the next point is found
+  // starting from the segment of the previous one.
+  size_t nextPointIdx = 1;
   auto const calculateAltitude = [&](double distFormStartM) {
     if (distFormStartM <= distanceDataM.front())
       return static_cast<double>(altitudeDataM.front());
     if (distFormStartM >= distanceDataM.back())
       return static_cast<double>(altitudeDataM.back());
 
-    auto const lowerIt = lower_bound(distanceDataM.cbegin(), distanceDataM.cend(), distFormStartM);
-    size_t const nextPointIdx = distance(distanceDataM.cbegin(), lowerIt);
-    ASSERT_LESS(0, nextPointIdx, ("distFormStartM is greater than 0 but nextPointIdx == 0."));
+    while (distanceDataM[nextPointIdx] < distFormStartM)
+      ++nextPointIdx;
+    ASSERT_LESS(nextPointIdx, distanceDataM.size(), ());
     size_t const prevPointIdx = nextPointIdx - 1;
 
     if (my::AlmostEqualAbs(distanceDataM[prevPointIdx], distanceDataM[nextPointIdx], kEpsilon))
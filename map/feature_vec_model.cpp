@@ -69,6 +69,27 @@ pair<MwmSet::MwmId, MwmSet::RegResult> FeaturesFetcher::RegisterMap(
   }
 }
 
+vector<pair<MwmSet::MwmId, MwmSet::RegResult>> FeaturesFetcher::RegisterMaps(
+    vector<LocalCountryFile> const & localFiles, size_t threadsCount)
+{
+  auto const results = m_multiIndex.RegisterMaps(localFiles, threadsCount);
+  for (size_t i = 0; i < results.size(); ++i)
+  {
+    auto const & result = results[i];
+    if (result.second != MwmSet::RegResult::Success)
+    {
+      LOG(LWARNING, ("Can't add map", localFiles[i].GetCountryName(), "(", result.second, ").",
+                     "Probably it's already added or has newer data version."));
+      continue;
+    }
+
+    MwmSet::MwmId const & id = result.first;
+    ASSERT(id.IsAlive(), ());
+    m_rect.Add(id.GetInfo()->m_limitRect);
+  }
+  return results;
+}
+
 bool FeaturesFetcher::DeregisterMap(CountryFile const & countryFile)
 {
   return m_multiIndex.Deregister(countryFile);
@@ -50,6 +50,10 @@ class FeaturesFetcher : public MwmSet::Observer
     pair<MwmSet::MwmId, MwmSet::RegResult> RegisterMap(
         platform::LocalCountryFile const & localFile);
 
+    /// Registers new maps reading their headers on |threadsCount| threads.
+    vector<pair<MwmSet::MwmId, MwmSet::RegResult>> RegisterMaps(
+        vector<platform::LocalCountryFile> const & localFiles, size_t threadsCount);
+
     /// Deregisters a map denoted by file from internal records.
     bool DeregisterMap(platform::CountryFile const & countryFile);
 
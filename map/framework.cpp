@@ -88,6 +88,7 @@
 
 #include "base/logging.hpp"
 #include "base/math.hpp"
+#include "base/memory_counters.hpp"
 #include "base/scope_guard.hpp"
 #include "base/stl_add.hpp"
 #include "base/timer.hpp"
@@ -95,6 +96,7 @@
 #include "std/algorithm.hpp"
 #include "std/bind.hpp"
 #include "std/target_os.hpp"
+#include "std/thread.hpp"
 #include "std/utility.hpp"
 
 #include "api/internal/c/api-client-internals.h"
@@ -139,6 +141,10 @@ char const kICUDataFile[] = "icudt57l.dat";
 double const kDistEqualQueryMeters = 100.0;
 double const kLargeFontsScaleFactor = 1.6;
 size_t constexpr kMaxTrafficCacheSizeBytes = 64 /* Mb */ * 1024 * 1024;
+// Search results of successive queries share most of their features.
+size_t constexpr kMaxCachedFeaturesCount = 2048;
+// Successive address queries in a city share most of their streets.
+size_t constexpr kMaxStreetVicinityCacheSizeBytes = 8 /* Mb */ * 1024 * 1024;
 
 // Must correspond SearchMarkType.
 vector<string> kSearchMarks =
@@ -356,6 +362,7 @@ void Framework::Migrate(bool keepDownloaded)
     OnDestroyGLContext();
   }
   m_selectedFeature = FeatureID();
+  ClearPlacePageExtrasCache();
   m_searchEngine.reset();
   m_infoGetter.reset();
   m_taxiEngine.reset();
@@ -407,6 +414,7 @@ Framework::Framework(FrameworkParams const & params)
   , m_lastReportedCountry(kInvalidCountryId)
   , m_enabledDiffs(params.m_enableDiffs)
 {
+  m_startupTrace.Mark("Members");
   m_startBackgroundTime = my::Timer::LocalTime();
 
   // Restore map style before classificator loading
@@ -439,27 +447,41 @@ Framework::Framework(FrameworkParams const & params)
 
   m_model.InitClassificator();
   m_model.SetOnMapDeregisteredCallback(bind(&Framework::OnMapDeregistered, this, _1));
+  m_model.GetIndex().EnableFeaturesCache(kMaxCachedFeaturesCount);
   LOG(LDEBUG, ("Classificator initialized"));
+  m_startupTrace.Mark("Classificator");
 
   m_displayedCategories = make_unique<search::DisplayedCategories>(GetDefaultCategories());
 
   // To avoid possible races - init country info getter in constructor.
   InitCountryInfoGetter();
   LOG(LDEBUG, ("Country info getter initialized"));
+  m_startupTrace.Mark("CountryInfoGetter");
 
-  InitUGC();
-  LOG(LDEBUG, ("UGC initialized"));
+  m_isDeferredInitPending = params.m_deferNonCriticalInit;
+  m_enableLocalAds = params.m_enableLocalAds;
+  if (!m_isDeferredInitPending)
+  {
+    InitUGC();
+    LOG(LDEBUG, ("UGC initialized"));
+    m_startupTrace.Mark("UGC");
+  }
 
   InitSearchEngine();
   LOG(LDEBUG, ("Search engine initialized"));
+  m_startupTrace.Mark("SearchEngine");
 
   InitCityFinder();
   InitTaxiEngine();
+  m_startupTrace.Mark("TaxiEngine");
 
   // All members which re-initialize in Migrate() method should be initialized before RegisterAllMaps().
   // Migrate() can be called from RegisterAllMaps().
   RegisterAllMaps();
   LOG(LDEBUG, ("Maps initialized"));
+  m_startupTrace.Mark("Maps");
+  if (!m_isDeferredInitPending)
+    m_storage.CleanupMapsDirectoryAsync();
 
   // Init storage with needed callback.
   m_storage.Init(
@@ -467,12 +489,14 @@ Framework::Framework(FrameworkParams const & params)
                  bind(&Framework::OnCountryFileDelete, this, _1, _2));
   m_storage.SetDownloadingPolicy(&m_storageDownloadingPolicy);
   LOG(LDEBUG, ("Storage initialized"));
+  m_startupTrace.Mark("Storage");
 
   // Local ads manager should be initialized after storage initialization.
-  if (params.m_enableLocalAds)
+  if (m_enableLocalAds && !m_isDeferredInitPending)
   {
     m_localAdsManager.SetBookmarkManager(&m_bmManager);
     m_localAdsManager.Startup();
+    m_startupTrace.Mark("LocalAds");
   }
 
   m_routingManager.SetRouterImpl(RouterType::Vehicle);
@@ -480,18 +504,26 @@ Framework::Framework(FrameworkParams const & params)
   UpdateMinBuildingsTapZoom();
 
   LOG(LDEBUG, ("Routing engine initialized"));
+  m_startupTrace.Mark("Routing");
 
   LOG(LINFO, ("System languages:", languages::GetPreferred()));
 
   osm::Editor & editor = osm::Editor::Instance();
 
   editor.SetDelegate(make_unique<search::EditorDelegate>(m_model.GetIndex()));
-  editor.SetInvalidateFn([this](){ InvalidateRect(GetCurrentViewport()); });
+  editor.SetInvalidateFn([this]()
+  {
+    ClearPlacePageExtrasCache();
+    if (m_searchEngine)
+      m_searchEngine->ClearCaches();
+    InvalidateRect(GetCurrentViewport());
+  });
   editor.LoadMapEdits();
 
   m_model.GetIndex().AddObserver(editor);
 
   LOG(LINFO, ("Editor initialized"));
+  m_startupTrace.Mark("Editor");
 
   m_trafficManager.SetCurrentDataVersion(m_storage.GetCurrentDataVersion());
 
@@ -499,6 +531,10 @@ Framework::Framework(FrameworkParams const & params)
 
   InitTransliteration();
   LOG(LDEBUG, ("Transliterators initialized"));
+  m_startupTrace.Mark("Transliteration");
+
+  LOG(LINFO, ("Framework initialized in", m_startupTrace.GetTotalSeconds(), "seconds",
+              m_startupTrace.GetStages()));
 }
 
 Framework::~Framework()
@@ -591,6 +627,11 @@ void Framework::OnCountryFileDownloaded(storage::TCountryId const & countryId, s
   m_searchEngine->ClearCaches();
 }
 
+map<string, uint64_t> Framework::GetMemoryUsage() const
+{
+  return base::MemoryCounters::Instance().GetSnapshot();
+}
+
 bool Framework::OnCountryFileDelete(storage::TCountryId const & countryId, storage::TLocalFilePtr const localFile)
 {
   // Soft reset to signal that mwm file may be out of date in routing caches.
@@ -684,9 +725,21 @@ void Framework::RegisterAllMaps()
 
   vector<shared_ptr<LocalCountryFile>> maps;
   m_storage.GetLocalMaps(maps);
+  vector<LocalCountryFile> localFiles;
+  localFiles.reserve(maps.size());
   for (auto const & localFile : maps)
+    localFiles.push_back(*localFile);
+
+  // Headers of maps which are not changed since the previous start are taken from the snapshot.
+  string const snapshotPath = GetPlatform().WritablePathForFile(MWMS_SNAPSHOT_FILENAME);
+  m_model.GetIndex().LoadInfoSnapshot(snapshotPath);
+  auto const results =
+      m_model.RegisterMaps(localFiles, max(thread::hardware_concurrency(), 1u) /* threadsCount */);
+  m_model.GetIndex().SaveInfoSnapshot(snapshotPath);
+
+  for (size_t i = 0; i < results.size(); ++i)
   {
-    auto p = RegisterMap(*localFile);
+    auto const & p = results[i];
     if (p.second != MwmSet::RegResult::Success)
       continue;
 
@@ -695,7 +748,7 @@ void Framework::RegisterAllMaps()
     minFormat = min(minFormat, static_cast<int>(id.GetInfo()->m_version.GetFormat()));
     if (needStatisticsUpdate)
     {
-      listRegisteredMaps << localFile->GetCountryName() << ":" << id.GetInfo()->GetVersion() << ";";
+      listRegisteredMaps << localFiles[i].GetCountryName() << ":" << id.GetInfo()->GetVersion() << ";";
     }
   }
 
@@ -865,9 +918,17 @@ void Framework::FillInfoFromFeatureType(FeatureType const & ft, place_page::Info
   info.SetLocalizedWifiString(m_stringsBundle.GetString("wifi"));
   info.SetLocalizedRatingString(m_stringsBundle.GetString("place_page_booking_rating"));
 
-  if (ftypes::IsAddressObjectChecker::Instance()(ft))
-    info.SetAddress(GetAddressInfoAtPoint(feature::GetCenter(ft)).FormatHouseAndStreet());
+  PlacePageExtras extras;
+  auto const it = m_placePageExtras.find(ft.GetID());
+  if (it != m_placePageExtras.end())
+    extras = it->second;
+  else if (m_updateMapSelectionFn)
+    RequestPlacePageExtras(ft.GetID(), ftypes::IsAddressObjectChecker::Instance()(ft),
+                           feature::GetCenter(ft));
+  else
+    extras = GetPlacePageExtras(ft);
 
+  info.SetAddress(extras.m_address);
   info.SetFromFeatureType(ft);
 
   if (ftypes::IsBookingChecker::Instance()(ft))
@@ -931,9 +992,77 @@ void Framework::FillInfoFromFeatureType(FeatureType const & ft, place_page::Info
     info.SetLocalAdsStatus(place_page::LocalAdsStatus::NotAvailable);
   }
 
-  auto const latlon = MercatorBounds::ToLatLon(feature::GetCenter(ft));
+  info.SetReachableByTaxiProviders(extras.m_taxiProviders);
+}
+
+Framework::PlacePageExtras Framework::GetPlacePageExtras(FeatureType const & ft) const
+{
+  PlacePageExtras extras;
+  auto const center = feature::GetCenter(ft);
+  if (ftypes::IsAddressObjectChecker::Instance()(ft))
+    extras.m_address = GetAddressInfoAtPoint(center).FormatHouseAndStreet();
+  extras.m_taxiProviders = GetTaxiProviders(center);
+  return extras;
+}
+
+vector<taxi::Provider::Type> Framework::GetTaxiProviders(m2::PointD const & pt) const
+{
   ASSERT(m_taxiEngine, ());
-  info.SetReachableByTaxiProviders(m_taxiEngine->GetProvidersAtPos(latlon));
+  return m_taxiEngine->GetProvidersAtPos(MercatorBounds::ToLatLon(pt));
+}
+
+void Framework::RequestPlacePageExtras(FeatureID const & fid, bool isAddressObject,
+                                       m2::PointD const & center) const
+{
+  if (!m_requestedPlacePageExtras.insert(fid).second)
+    return;
+
+  // Reverse geocoding reads features only, so it's done in background. Taxi engine uses
+  // the city finder which is not thread-safe, so taxi providers are got on the GUI thread.
+  auto self = const_cast<Framework *>(this);
+  GetPlatform().RunAsync([self, fid, isAddressObject, center]()
+  {
+    PlacePageExtras extras;
+    if (isAddressObject)
+      extras.m_address = self->GetAddressInfoAtPoint(center).FormatHouseAndStreet();
+
+    GetPlatform().RunOnGuiThread([self, fid, center, extras]() mutable
+    {
+      if (self->m_requestedPlacePageExtras.erase(fid) == 0)
+        return;
+      extras.m_taxiProviders = self->GetTaxiProviders(center);
+      self->OnPlacePageExtrasReady(fid, extras);
+    });
+  });
+}
+
+void Framework::OnPlacePageExtrasReady(FeatureID const & fid, PlacePageExtras const & extras)
+{
+  if (m_placePageExtras.emplace(fid, extras).second)
+  {
+    m_placePageExtrasOrder.push_back(fid);
+    if (m_placePageExtrasOrder.size() > kPlacePageExtrasCacheSize)
+    {
+      m_placePageExtras.erase(m_placePageExtrasOrder.front());
+      m_placePageExtrasOrder.pop_front();
+    }
+  }
+
+  if (!m_selectedInfo || m_selectedInfo->GetID() != fid || m_selectedFeature != fid)
+    return;
+
+  m_selectedInfo->UpdateAddress(extras.m_address);
+  m_selectedInfo->SetReachableByTaxiProviders(extras.m_taxiProviders);
+  if (m_updateMapSelectionFn)
+    m_updateMapSelectionFn(*m_selectedInfo);
+}
+
+void Framework::ClearPlacePageExtrasCache()
+{
+  m_placePageExtras.clear();
+  m_placePageExtrasOrder.clear();
+  // Results of requests in progress may be obsolete.
+  m_requestedPlacePageExtras.clear();
 }
 
 void Framework::FillApiMarkInfo(ApiMarkPoint const & api, place_page::Info & info) const
@@ -1379,6 +1508,21 @@ bool Framework::SearchInViewport(search::ViewportSearchParams const & params)
 
 bool Framework::SearchInDownloader(DownloaderSearchParams const & params)
 {
+  // Countries and regions are found by names at once, the features
+  // of World are matched to the countries by the search engine later.
+  auto const & storage = GetStorage();
+  if (!m_downloaderSearchIndex.IsUpToDate(storage))
+    m_downloaderSearchIndex.Build(storage);
+
+  DownloaderSearchResults namesResults;
+  m_downloaderSearchIndex.Search(params.m_query, namesResults.m_results);
+  namesResults.m_query = params.m_query;
+  if (!namesResults.m_results.empty() && params.m_onResults)
+  {
+    auto const onResults = params.m_onResults;
+    RunUITask([onResults, namesResults]() { onResults(namesResults); });
+  }
+
   search::SearchParams p;
   p.m_query = params.m_query;
   p.m_inputLocale = params.m_inputLocale;
@@ -1387,7 +1531,7 @@ bool Framework::SearchInDownloader(DownloaderSearchParams const & params)
   p.m_suggestsEnabled = false;
   p.m_onResults = search::DownloaderSearchCallback(
       static_cast<search::DownloaderSearchCallback::Delegate &>(*this), m_model.GetIndex(),
-      GetCountryInfoGetter(), GetStorage(), params);
+      GetCountryInfoGetter(), storage, params, namesResults.m_results);
   return Search(p);
 }
 
@@ -1418,8 +1562,13 @@ void Framework::CancelAllSearches()
 void Framework::MemoryWarning()
 {
   LOG(LINFO, ("MemoryWarning"));
-  ClearAllCaches();
-  SharedBufferManager::instance().clearReserved();
+  OnMemoryPressure(base::CacheRegistry::Pressure::Critical);
+}
+
+void Framework::OnMemoryPressure(base::CacheRegistry::Pressure pressure)
+{
+  LOG(LINFO, (pressure, "memory pressure, memory of caches:", GetMemoryUsage()));
+  base::CacheRegistry::Instance().Shed(pressure);
 }
 
 void Framework::EnterBackground()
@@ -1484,7 +1633,41 @@ void Framework::InitUGC()
 {
   ASSERT(!m_ugcApi.get(), ("InitUGC() must be called only once."));
 
-  m_ugcApi = make_unique<ugc::Api>(m_model.GetIndex(), "FILENAME_PLACEHOLDER");
+  m_ugcApi = make_unique<ugc::Api>(
+      m_model.GetIndex(), my::JoinFoldersToPath(GetPlatform().WritableDir(), "ugc_updates.bin"));
+}
+
+ugc::Api & Framework::GetUGCApi()
+{
+  // UGC may be requested before the deferred initialization.
+  if (!m_ugcApi)
+    InitUGC();
+  return *m_ugcApi;
+}
+
+void Framework::RunDeferredInit()
+{
+  if (!m_isDeferredInitPending)
+    return;
+  m_isDeferredInitPending = false;
+  m_startupTrace.Resume();
+
+  m_storage.CleanupMapsDirectoryAsync();
+
+  if (!m_ugcApi)
+  {
+    InitUGC();
+    m_startupTrace.Mark("UGC");
+  }
+
+  if (m_enableLocalAds)
+  {
+    m_localAdsManager.SetBookmarkManager(&m_bmManager);
+    m_localAdsManager.Startup();
+    m_startupTrace.Mark("LocalAds");
+  }
+
+  LOG(LINFO, ("Deferred initialization is finished", m_startupTrace.GetStages()));
 }
 
 void Framework::InitSearchEngine()
@@ -1496,6 +1679,7 @@ void Framework::InitSearchEngine()
     search::Engine::Params params;
     params.m_locale = languages::GetCurrentOrig();
     params.m_numThreads = 1;
+    params.m_streetVicinityCacheSize = kMaxStreetVicinityCacheSizeBytes;
     m_searchEngine.reset(new search::Engine(const_cast<Index &>(m_model.GetIndex()),
                                             GetDefaultCategories(), *m_infoGetter,
                                             make_unique<search::ProcessorFactory>(), params));
@@ -1992,6 +2176,10 @@ void Framework::CreateDrapeEngine(ref_ptr<dp::OGLContextFactory> contextFactory,
   m_localAdsManager.SetDrapeEngine(make_ref(m_drapeEngine));
 
   benchmark::RunGraphicsBenchmark(this);
+
+  // The first frame is being rendered, the rest of subsystems may be initialized.
+  if (m_isDeferredInitPending)
+    GetPlatform().RunOnGuiThread([this]() { RunDeferredInit(); });
 }
 
 void Framework::OnRecoverGLContext(int width, int height)
@@ -2335,11 +2523,21 @@ void Framework::SetMapSelectionListeners(TActivateMapSelectionFn const & activat
   m_deactivateMapSelectionFn = deactivator;
 }
 
+void Framework::SetMapSelectionUpdateListener(TUpdateMapSelectionFn const & updater)
+{
+  m_updateMapSelectionFn = updater;
+}
+
 void Framework::ActivateMapSelection(bool needAnimation, df::SelectionShape::ESelectedObject selectionType,
                                      place_page::Info const & info)
 {
   ASSERT_NOT_EQUAL(selectionType, df::SelectionShape::OBJECT_EMPTY, ("Empty selections are impossible."));
   m_selectedFeature = info.GetID();
+  if (m_updateMapSelectionFn && info.IsFeature())
+    m_selectedInfo.reset(new place_page::Info(info));
+  else
+    m_selectedInfo.reset();
+
   if (m_drapeEngine != nullptr)
     m_drapeEngine->SelectObject(selectionType, info.GetMercator(), info.GetID(), needAnimation);
 
@@ -2356,6 +2554,7 @@ void Framework::DeactivateMapSelection(bool notifyUI)
 {
   bool const somethingWasAlreadySelected = (m_lastTapEvent != nullptr);
   m_lastTapEvent.reset();
+  m_selectedInfo.reset();
 
   if (notifyUI && m_deactivateMapSelectionFn)
     m_deactivateMapSelectionFn(!somethingWasAlreadySelected);
@@ -3379,6 +3578,12 @@ void Framework::RegisterCountryFilesOnRoute(shared_ptr<routing::NumMwmIds> ptr)
       [&ptr](platform::CountryFile const & file) { ptr->RegisterFile(file); });
 }
 
+// RoutingManager::Delegate
+void Framework::OnRouteChanged(vector<m2::PointD> const & points, vector<double> const & timesSec)
+{
+  m_trafficManager.SetRoute(points, timesSec);
+}
+
 void Framework::InitCityFinder()
 {
   ASSERT(!m_cityFinder, ());
@@ -10,6 +10,7 @@
 #include "map/place_page_info.hpp"
 #include "map/routing_manager.hpp"
 #include "map/routing_mark.hpp"
+#include "map/startup_trace.hpp"
 #include "map/track.hpp"
 #include "map/traffic_manager.hpp"
 
@@ -32,6 +33,7 @@
 #include "search/city_finder.hpp"
 #include "search/displayed_categories.hpp"
 #include "search/downloader_search_callback.hpp"
+#include "search/downloader_search_index.hpp"
 #include "search/engine.hpp"
 #include "search/everywhere_search_callback.hpp"
 #include "search/mode.hpp"
@@ -60,13 +62,16 @@
 #include "geometry/rect2d.hpp"
 #include "geometry/screenbase.hpp"
 
+#include "base/cache_registry.hpp"
 #include "base/deferred_task.hpp"
 #include "base/macros.hpp"
 #include "base/strings_bundle.hpp"
 #include "base/thread_checker.hpp"
 
+#include "std/deque.hpp"
 #include "std/function.hpp"
 #include "std/list.hpp"
+#include "std/map.hpp"
 #include "std/set.hpp"
 #include "std/shared_ptr.hpp"
 #include "std/string.hpp"
@@ -112,6 +117,9 @@ struct FrameworkParams
 {
   bool m_enableLocalAds = true;
   bool m_enableDiffs = true;
+  // When it's true, subsystems which aren't needed to show the map (UGC, local ads)
+  // are initialized after the drape engine is created.
+  bool m_deferNonCriticalInit = false;
 
   FrameworkParams() = default;
   FrameworkParams(bool enableLocalAds, bool enableDiffs)
@@ -149,6 +157,9 @@ class Framework : public search::ViewportSearchCallback::Delegate,
 protected:
   using TDrapeFunction = function<void (df::DrapeEngine *)>;
 
+  // It's the first member to measure initialization of other ones.
+  StartupTrace m_startupTrace;
+
   StringsBundle m_stringsBundle;
 
   model::FeaturesFetcher m_model;
@@ -215,6 +226,9 @@ protected:
   void OnMapDeregistered(platform::LocalCountryFile const & localFile);
 
   void ClearAllCaches();
+  /// Bytes of caches of subsystems by names of counters, e.g. "indexer.features_cache".
+  /// May be called from any thread.
+  map<string, uint64_t> GetMemoryUsage() const;
 
   void StopLocationFollow();
 
@@ -293,7 +307,7 @@ public:
 
   Index const & GetIndex() const { return m_model.GetIndex(); }
 
-  ugc::Api & GetUGCApi() { return *m_ugcApi; }
+  ugc::Api & GetUGCApi();
 
   search::Engine & GetSearchEngine() { return *m_searchEngine; }
   search::Engine const & GetSearchEngine() const { return *m_searchEngine; }
@@ -380,6 +394,11 @@ public:
   using TDeactivateMapSelectionFn = function<void (bool /*switchFullScreenMode*/)>;
   void SetMapSelectionListeners(TActivateMapSelectionFn const & activator,
                                 TDeactivateMapSelectionFn const & deactivator);
+  /// Called to notify UI that info of the selected object is completed. When the listener is set,
+  /// place page info is filled without data which is slow to get (the address, taxi providers),
+  /// the data is got in background and the listener is called with the full info.
+  using TUpdateMapSelectionFn = function<void (place_page::Info const &)>;
+  void SetMapSelectionUpdateListener(TUpdateMapSelectionFn const & updater);
 
   void ResetLastTapEvent();
 
@@ -436,6 +455,7 @@ private:
 
   TActivateMapSelectionFn m_activateMapSelectionFn;
   TDeactivateMapSelectionFn m_deactivateMapSelectionFn;
+  TUpdateMapSelectionFn m_updateMapSelectionFn;
 
   /// Here we store last selected feature to get its polygons in case of adding organization.
   mutable FeatureID m_selectedFeature;
@@ -507,6 +527,8 @@ public:
 
   void PrepareToShutdown();
 
+  StartupTrace const & GetStartupTrace() const { return m_startupTrace; }
+
   void SetDisplacementMode(DisplacementModeManager::Slot slot, bool show);
 
 private:
@@ -522,6 +544,11 @@ private:
   void InitUGC();
   void InitSearchEngine();
 
+  // Initializes subsystems which are deferred by FrameworkParams::m_deferNonCriticalInit.
+  void RunDeferredInit();
+  bool m_isDeferredInitPending = false;
+  bool m_enableLocalAds = true;
+
   DisplacementModeManager m_displacementModeManager;
 
   bool m_connectToGpsTrack; // need to connect to tracker when Drape is being constructed
@@ -538,6 +565,11 @@ private:
   // because it must be used from the UI thread only.
   SearchIntent m_searchIntents[static_cast<size_t>(search::Mode::Count)];
 
+  // Index of names of the countries tree, it's rebuilt lazily when
+  // the locale or the data version of storage changes. Must be used
+  // from the UI thread only.
+  search::DownloaderSearchIndex m_downloaderSearchIndex;
+
   bool Search(search::SearchParams const & params);
   void Search(SearchIntent & intent) const;
 
@@ -675,6 +707,28 @@ private:
   /// @param customTitle, if not empty, overrides any other calculated name.
   void FillPointInfo(m2::PointD const & mercator, string const & customTitle, place_page::Info & info) const;
   void FillInfoFromFeatureType(FeatureType const & ft, place_page::Info & info) const;
+
+  // Place page data which is slow to get. It's cached for a few recently shown features.
+  struct PlacePageExtras
+  {
+    string m_address;
+    vector<taxi::Provider::Type> m_taxiProviders;
+  };
+  static size_t constexpr kPlacePageExtrasCacheSize = 32;
+
+  PlacePageExtras GetPlacePageExtras(FeatureType const & ft) const;
+  vector<taxi::Provider::Type> GetTaxiProviders(m2::PointD const & pt) const;
+  // Gets extras of |fid| in background, caches them and updates the selected object.
+  void RequestPlacePageExtras(FeatureID const & fid, bool isAddressObject,
+                              m2::PointD const & center) const;
+  void OnPlacePageExtrasReady(FeatureID const & fid, PlacePageExtras const & extras);
+  void ClearPlacePageExtrasCache();
+
+  // These fields are used on the GUI thread only.
+  mutable map<FeatureID, PlacePageExtras> m_placePageExtras;
+  mutable deque<FeatureID> m_placePageExtrasOrder;
+  mutable set<FeatureID> m_requestedPlacePageExtras;
+  unique_ptr<place_page::Info> m_selectedInfo;
   void FillApiMarkInfo(ApiMarkPoint const & api, place_page::Info & info) const;
   void FillSearchResultInfo(SearchMarkPoint const & smp, place_page::Info & info) const;
   void FillMyPositionInfo(place_page::Info & info, df::TapInfo const & tapInfo) const;
@@ -710,6 +764,8 @@ public:
   WARN_UNUSED_RESULT bool GetFeatureByID(FeatureID const & fid, FeatureType & ft) const;
 
   void MemoryWarning();
+  /// Sheds caches of subsystems by tiers of |pressure|, see base::CacheRegistry.
+  void OnMemoryPressure(base::CacheRegistry::Pressure pressure);
   void EnterBackground();
   void EnterForeground();
 
@@ -784,6 +840,7 @@ protected:
   /// RoutingManager::Delegate
   void OnRouteFollow(routing::RouterType type) override;
   void RegisterCountryFilesOnRoute(shared_ptr<routing::NumMwmIds> ptr) const override;
+  void OnRouteChanged(vector<m2::PointD> const & points, vector<double> const & timesSec) override;
 
 public:
   /// @name Editor interface.
@@ -1,9 +1,12 @@
 #include "map/gps_track_storage.hpp"
 
+#include "coding/byte_stream.hpp"
 #include "coding/endianness.hpp"
 #include "coding/internal/file_data.hpp"
+#include "coding/varint.hpp"
 
 #include "std/algorithm.hpp"
+#include "std/cmath.hpp"
 #include "std/cstring.hpp"
 
 #include "base/assert.hpp"
@@ -13,7 +16,10 @@ namespace
 {
 
 // Current file format version
-uint32_t constexpr kCurrentVersion = 1;
+uint32_t constexpr kCurrentVersion = 2;
+
+// Version with fixed-size records of plain values, it's migrated on opening.
+uint32_t constexpr kPlainVersion = 1;
 
 // Header size in bytes, header consists of uint32_t 'version' only
 uint32_t constexpr kHeaderSize = sizeof(uint32_t);
@@ -21,12 +27,31 @@ uint32_t constexpr kHeaderSize = sizeof(uint32_t);
 // Number of items for batch processing
 size_t constexpr kItemBlockSize = 1000;
 
-// TODO
-// Now GpsInfo written as plain values, but values can be compressed.
-
-// Size of point in bytes to write in file of read from file
+// Size of point in bytes of kPlainVersion files
 size_t constexpr kPointSize = 8 * sizeof(double) + sizeof(uint8_t);
 
+// Values are stored with fixed precision: 1 ms for timestamp, 1e-7 degree (about 1 cm)
+// for coordinates and 0.01 for other values.
+// Order of fields: timestamp, latitude, longitude, altitude, speed, bearing,
+// horizontal accuracy, vertical accuracy.
+size_t constexpr kFieldsCount = 8;
+double const kFieldScales[kFieldsCount] = {1e3, 1e7, 1e7, 1e2, 1e2, 1e2, 1e2, 1e2};
+
+using TFields = array<int64_t, kFieldsCount>;
+
+// Values which are too big for the fixed precision are stored as raw doubles.
+double constexpr kMaxQuantized = static_cast<double>(1LL << 52);
+
+// Record: uint8_t payload size, payload. Payload: uint8_t flags, [uint8_t source,]
+// [uint8_t mask of raw fields,] fields. Fields are varints or raw doubles. Varints of
+// the first record of a block are absolute values, varints of other records are deltas
+// to the previous record, the previous value of a raw field is zero.
+uint8_t constexpr kBlockStartFlag = 1;
+uint8_t constexpr kSourceFlag = 2;
+uint8_t constexpr kRawFieldsFlag = 4;
+size_t constexpr kMaxPayloadSize = 3 * sizeof(uint8_t) + kFieldsCount * 10;
+static_assert(kMaxPayloadSize <= 255, "");
+
 // Writes value in memory in LittleEndian
 template <typename T>
 void MemWrite(void * ptr, T value)
@@ -44,21 +69,6 @@ T MemRead(void const * ptr)
   return SwapIfBigEndian(value);
 }
 
-void Pack(char * p, location::GpsInfo const & info)
-{  
-  MemWrite<double>(p + 0 * sizeof(double), info.m_timestamp);
-  MemWrite<double>(p + 1 * sizeof(double), info.m_latitude);
-  MemWrite<double>(p + 2 * sizeof(double), info.m_longitude);
-  MemWrite<double>(p + 3 * sizeof(double), info.m_altitude);
-  MemWrite<double>(p + 4 * sizeof(double), info.m_speed);
-  MemWrite<double>(p + 5 * sizeof(double), info.m_bearing);
-  MemWrite<double>(p + 6 * sizeof(double), info.m_horizontalAccuracy);
-  MemWrite<double>(p + 7 * sizeof(double), info.m_verticalAccuracy);
-  ASSERT_LESS_OR_EQUAL(static_cast<int>(info.m_source), 255, ());
-  uint8_t const source = static_cast<uint8_t>(info.m_source);
-  MemWrite<uint8_t>(p + 8 * sizeof(double), source);
-}
-
 void Unpack(char const * p, location::GpsInfo & info)
 {
   info.m_timestamp = MemRead<double>(p + 0 * sizeof(double));
@@ -73,15 +83,115 @@ void Unpack(char const * p, location::GpsInfo & info)
   info.m_source = static_cast<location::TLocationSource>(source);
 }
 
-inline size_t GetItemOffset(size_t itemIndex)
+void GetValues(location::GpsInfo const & info, double (&values)[kFieldsCount])
+{
+  values[0] = info.m_timestamp;
+  values[1] = info.m_latitude;
+  values[2] = info.m_longitude;
+  values[3] = info.m_altitude;
+  values[4] = info.m_speed;
+  values[5] = info.m_bearing;
+  values[6] = info.m_horizontalAccuracy;
+  values[7] = info.m_verticalAccuracy;
+}
+
+void SetValues(double const (&values)[kFieldsCount], location::GpsInfo & info)
+{
+  info.m_timestamp = values[0];
+  info.m_latitude = values[1];
+  info.m_longitude = values[2];
+  info.m_altitude = values[3];
+  info.m_speed = values[4];
+  info.m_bearing = values[5];
+  info.m_horizontalAccuracy = values[6];
+  info.m_verticalAccuracy = values[7];
+}
+
+// @return false if |value| must be stored as is.
+bool Quantize(double value, double scale, int64_t & quantized)
 {
-  return kHeaderSize + itemIndex * kPointSize;
+  double const scaled = value * scale;
+  if (!(fabs(scaled) < kMaxQuantized))
+    return false;
+  quantized = llround(scaled);
+  return true;
 }
 
-inline size_t GetItemCount(size_t fileSize)
+double Dequantize(int64_t quantized, double scale)
 {
-  ASSERT_GREATER_OR_EQUAL(fileSize, kHeaderSize, ());
-  return (fileSize - kHeaderSize) / kPointSize;
+  // Division gives exact values for values which are exact in the fixed precision.
+  return quantized / scale;
+}
+
+class Decoder
+{
+public:
+  Decoder() { m_fields.fill(0); }
+
+  TFields const & GetFields() const { return m_fields; }
+
+  // Decodes the record at |p| and moves |p| to the next record.
+  // @return false if the record is broken or incomplete.
+  bool Decode(char const *& p, char const * end, location::GpsInfo & info)
+  {
+    if (p == end)
+      return false;
+    size_t const size = static_cast<uint8_t>(*p);
+    if (size == 0 || size > kMaxPayloadSize || static_cast<size_t>(end - p) < size + 1)
+      return false;
+
+    // |end| is followed by padding, so varints can't be read out of the buffer.
+    ArrayByteSource src(p + 1);
+    uint8_t const flags = src.ReadByte();
+    bool const blockStart = (flags & kBlockStartFlag) != 0;
+    if (!blockStart && !m_hasPrevious)
+      return false;
+
+    if (flags & kSourceFlag)
+      m_source = src.ReadByte();
+    uint8_t const rawMask = (flags & kRawFieldsFlag) ? src.ReadByte() : 0;
+
+    double values[kFieldsCount];
+    for (size_t i = 0; i < kFieldsCount; ++i)
+    {
+      if (rawMask & (1 << i))
+      {
+        uint64_t bits;
+        src.Read(&bits, sizeof(bits));
+        bits = SwapIfBigEndian(bits);
+        memcpy(&values[i], &bits, sizeof(bits));
+        m_fields[i] = 0;
+        continue;
+      }
+
+      int64_t const value = ReadVarInt<int64_t>(src);
+      m_fields[i] = blockStart ? value : m_fields[i] + value;
+      values[i] = Dequantize(m_fields[i], kFieldScales[i]);
+    }
+    if (src.PtrC() != p + 1 + size)
+      return false;
+
+    SetValues(values, info);
+    info.m_source = static_cast<location::TLocationSource>(m_source);
+    m_hasPrevious = true;
+    p += size + 1;
+    return true;
+  }
+
+private:
+  TFields m_fields;
+  uint8_t m_source = 0;
+  bool m_hasPrevious = false;
+};
+
+// Reads [offset, fileSize) of the file to |buffer| followed by padding.
+void ReadTail(fstream & f, uint64_t offset, uint64_t fileSize, vector<char> & buffer)
+{
+  ASSERT_LESS_OR_EQUAL(offset, fileSize, ());
+  buffer.assign(static_cast<size_t>(fileSize - offset) + kMaxPayloadSize + 1, 0);
+  f.seekg(offset, ios::beg);
+  if (f.good())
+    f.read(buffer.data(), static_cast<std::streamsize>(fileSize - offset));
 }
 
 inline bool WriteVersion(fstream & f, uint32_t version)
@@ -118,28 +228,61 @@ GpsTrackStorage::GpsTrackStorage(string const & filePath, size_t maxItemCount)
     if (!ReadVersion(m_stream, version))
       MYTHROW(OpenException, ("Read version error.", m_filePath));
 
+    // Seek to end to get file size
+    m_stream.seekp(0, ios::end);
+    if (!m_stream.good())
+      MYTHROW(OpenException, ("Seek to the end error.", m_filePath));
+    m_fileSize = static_cast<uint64_t>(m_stream.tellp());
+
     if (version == kCurrentVersion)
     {
-      // Seek to end to get file size
-      m_stream.seekp(0, ios::end);
-      if (!m_stream.good())
-        MYTHROW(OpenException, ("Seek to the end error.", m_filePath));
-
-      size_t const fileSize = m_stream.tellp();
-
-      m_itemCount = GetItemCount(fileSize);
+      if (!Scan())
+      {
+        LOG(LWARNING, ("Broken end of file", m_filePath, "items:", m_itemCount));
+        try
+        {
+          TruncFile();
+        }
+        catch (RootException const & e)
+        {
+          MYTHROW(OpenException, ("Truncation error.", m_filePath, e.Msg()));
+        }
+      }
 
       // Set write position after last item position
-      size_t const offset = GetItemOffset(m_itemCount);
-      m_stream.seekp(offset, ios::beg);
+      m_stream.seekp(m_fileSize, ios::beg);
+      if (!m_stream.good())
+        MYTHROW(OpenException, ("Seek to the offset error:", m_fileSize, m_filePath));
+    }
+    else if (version == kPlainVersion)
+    {
+      // Last items of the old file are kept.
+      size_t const itemCount = (m_fileSize - kHeaderSize) / kPointSize;
+      size_t const first = itemCount > m_maxItemCount ? itemCount - m_maxItemCount : 0;
+      vector<TItem> items(itemCount - first);
+      vector<char> buff(kPointSize);
+      m_stream.seekg(kHeaderSize + first * kPointSize, ios::beg);
+      for (size_t i = 0; i < items.size() && m_stream.good(); ++i)
+      {
+        m_stream.read(buff.data(), kPointSize);
+        Unpack(buff.data(), items[i]);
+      }
       if (!m_stream.good())
-        MYTHROW(OpenException, ("Seek to the offset error:", offset, m_filePath));
+        items.clear();
+
+      try
+      {
+        Rewrite(items);
+      }
+      catch (RootException const & e)
+      {
+        MYTHROW(OpenException, ("Migration error.", m_filePath, e.Msg()));
+      }
     }
     else
     {
       m_stream.close();
       // TODO: migration for file m_filePath from version 'version' to version 'kCurrentVersion'
-      // TODO: For now we support only one version, but in future migration may be needed.
     }
   }
 
@@ -155,6 +298,8 @@ GpsTrackStorage::GpsTrackStorage(string const & filePath, size_t maxItemCount)
       MYTHROW(OpenException, ("Write version error.", m_filePath));
 
     m_itemCount = 0;
+    m_fileSize = kHeaderSize;
+    ResetEncoder();
   }
 }
 
@@ -170,20 +315,24 @@ void GpsTrackStorage::Append(vector<TItem> const & items)
   if (needTrunc)
     TruncFile();
 
-  // Write position must be after last item position
-  ASSERT_EQUAL(m_stream.tellp(), GetItemOffset(m_itemCount), ());
+  // Write position must be after last item position, reading may move it.
+  m_stream.seekp(m_fileSize, ios::beg);
+  if (!m_stream.good())
+    MYTHROW(WriteException, ("File:", m_filePath));
 
-  vector<char> buff(min(kItemBlockSize, items.size()) * kPointSize);
+  string buff;
   for (size_t i = 0; i < items.size();)
   {
     size_t const n = min(items.size() - i, kItemBlockSize);
 
+    buff.clear();
     for (size_t j = 0; j < n; ++j)
-      Pack(&buff[0] + j * kPointSize, items[i + j]);
+      Encode(items[i + j], buff);
 
-    m_stream.write(&buff[0], n * kPointSize);
+    m_stream.write(buff.data(), buff.size());
     if (!m_stream.good())
       MYTHROW(WriteException, ("File:", m_filePath));
+    m_fileSize += buff.size();
 
     i += n;
   }
@@ -191,8 +340,6 @@ void GpsTrackStorage::Append(vector<TItem> const & items)
   m_stream.flush();
   if (!m_stream.good())
     MYTHROW(WriteException, ("File:", m_filePath));
-
-  m_itemCount += items.size();
 }
 
 void GpsTrackStorage::Clear()
@@ -211,43 +358,56 @@ void GpsTrackStorage::Clear()
   if (!WriteVersion(m_stream, kCurrentVersion))
     MYTHROW(WriteException, ("File:", m_filePath));
 
+  m_fileSize = kHeaderSize;
+  ResetEncoder();
+
   // Write position is set to the first item in the file
-  ASSERT_EQUAL(m_stream.tellp(), GetItemOffset(0), ());
+  ASSERT_EQUAL(static_cast<uint64_t>(m_stream.tellp()), m_fileSize, ());
 }
 
 void GpsTrackStorage::ForEach(std::function<bool(TItem const & item)> const & fn)
 {
   ASSERT(m_stream.is_open(), ());
 
-  size_t i = GetFirstItemIndex();
+  if (m_itemCount == 0)
+    return;
+
+  size_t const first = GetFirstItemIndex();
+  size_t const block = first / kItemBlockSize;
+  ASSERT_LESS(block, m_blockOffsets.size(), ());
 
-  // Set read position to the first item
-  m_stream.seekg(GetItemOffset(i), ios::beg);
+  vector<char> buff;
+  ReadTail(m_stream, m_blockOffsets[block], m_fileSize, buff);
   if (!m_stream.good())
     MYTHROW(ReadException, ("File:", m_filePath));
 
-  vector<char> buff(min(kItemBlockSize, m_itemCount) * kPointSize);
-  for (; i < m_itemCount;)
+  char const * p = buff.data();
+  char const * const end = p + (m_fileSize - m_blockOffsets[block]);
+  Decoder decoder;
+  TItem item;
+  for (size_t i = block * kItemBlockSize; i < m_itemCount; ++i)
   {
-    size_t const n = min(m_itemCount - i, kItemBlockSize);
-
-    m_stream.read(&buff[0], n * kPointSize);
-    if (!m_stream.good())
-      MYTHROW(ReadException, ("File:", m_filePath));
-
-    for (size_t j = 0; j < n; ++j)
-    {      
-      TItem item;
-      Unpack(&buff[0] + j * kPointSize, item);
-      if (!fn(item))
-        return;
-    }
-
-    i += n;
+    if (!decoder.Decode(p, end, item))
+      MYTHROW(ReadException, ("Broken item", i, "File:", m_filePath));
+    if (i >= first && !fn(item))
+      return;
   }
 }
 
 void GpsTrackStorage::TruncFile()
+{
+  vector<TItem> items;
+  items.reserve(min(m_itemCount, m_maxItemCount));
+  ForEach([&items](TItem const & item)
+  {
+    items.push_back(item);
+    return true;
+  });
+
+  Rewrite(items);
+}
+
+void GpsTrackStorage::Rewrite(vector<TItem> const & items)
 {
   string const tmpFilePath = m_filePath + ".tmp";
 
@@ -260,34 +420,26 @@ void GpsTrackStorage::TruncFile()
   if (!WriteVersion(tmp, kCurrentVersion))
     MYTHROW(WriteException, ("File:", tmpFilePath));
 
-  size_t i = GetFirstItemIndex();
-
-  // Set read position to the first item
-  m_stream.seekg(GetItemOffset(i), ios::beg);
-  if (!m_stream.good())
-    MYTHROW(ReadException, ("File:", m_filePath));
-
-  size_t newItemCount = 0;
+  m_itemCount = 0;
+  m_fileSize = kHeaderSize;
+  ResetEncoder();
 
-  // Copy items
-  vector<char> buff(min(kItemBlockSize, m_itemCount) * kPointSize);
-  for (; i < m_itemCount;)
+  string buff;
+  for (size_t i = 0; i < items.size();)
   {
-    size_t const n = min(m_itemCount - i, kItemBlockSize);
+    size_t const n = min(items.size() - i, kItemBlockSize);
 
-    m_stream.read(&buff[0], n * kPointSize);
-    if (!m_stream.good())
-      MYTHROW(ReadException, ("File:", m_filePath));
+    buff.clear();
+    for (size_t j = 0; j < n; ++j)
+      Encode(items[i + j], buff);
 
-    tmp.write(&buff[0], n * kPointSize);
+    tmp.write(buff.data(), buff.size());
     if (!tmp.good())
       MYTHROW(WriteException, ("File:", tmpFilePath));
+    m_fileSize += buff.size();
 
     i += n;
-    newItemCount += n;
   }
-  buff.clear();
-  buff.shrink_to_fit();
 
   tmp.close();
   m_stream.close();
@@ -305,10 +457,109 @@ void GpsTrackStorage::TruncFile()
   if (!m_stream)
     MYTHROW(WriteException, ("File:", m_filePath));
 
-  m_itemCount = newItemCount;
-
   // Write position must be after last item position (end of file)
-  ASSERT_EQUAL(m_stream.tellp(), GetItemOffset(m_itemCount), ());
+  ASSERT_EQUAL(static_cast<uint64_t>(m_stream.tellp()), m_fileSize, ());
+}
+
+void GpsTrackStorage::ResetEncoder()
+{
+  m_blockOffsets.clear();
+  m_lastFields.fill(0);
+  m_lastSource = 0;
+}
+
+void GpsTrackStorage::Encode(TItem const & item, string & buffer)
+{
+  bool const blockStart = (m_itemCount % kItemBlockSize == 0);
+  if (blockStart)
+    m_blockOffsets.push_back(m_fileSize + buffer.size());
+
+  ASSERT_LESS_OR_EQUAL(static_cast<int>(item.m_source), 255, ());
+  uint8_t const source = static_cast<uint8_t>(item.m_source);
+
+  double values[kFieldsCount];
+  GetValues(item, values);
+  TFields fields;
+  uint8_t rawMask = 0;
+  for (size_t i = 0; i < kFieldsCount; ++i)
+  {
+    if (!Quantize(values[i], kFieldScales[i], fields[i]))
+    {
+      rawMask |= (1 << i);
+      fields[i] = 0;
+    }
+  }
+
+  size_t const sizePos = buffer.size();
+  buffer.push_back(0);
+  PushBackByteSink<string> sink(buffer);
+
+  uint8_t flags = blockStart ? kBlockStartFlag : 0;
+  if (blockStart || source != m_lastSource)
+    flags |= kSourceFlag;
+  if (rawMask != 0)
+    flags |= kRawFieldsFlag;
+  buffer.push_back(static_cast<char>(flags));
+  if (flags & kSourceFlag)
+    buffer.push_back(static_cast<char>(source));
+  if (rawMask != 0)
+    buffer.push_back(static_cast<char>(rawMask));
+
+  for (size_t i = 0; i < kFieldsCount; ++i)
+  {
+    if (rawMask & (1 << i))
+    {
+      uint64_t bits;
+      memcpy(&bits, &values[i], sizeof(bits));
+      bits = SwapIfBigEndian(bits);
+      sink.Write(&bits, sizeof(bits));
+    }
+    else
+    {
+      WriteVarInt(sink, blockStart ? fields[i] : fields[i] - m_lastFields[i]);
+    }
+  }
+
+  size_t const payloadSize = buffer.size() - sizePos - 1;
+  ASSERT_LESS_OR_EQUAL(payloadSize, kMaxPayloadSize, ());
+  buffer[sizePos] = static_cast<char>(payloadSize);
+
+  m_lastFields = fields;
+  m_lastSource = source;
+  ++m_itemCount;
+}
+
+bool GpsTrackStorage::Scan()
+{
+  m_itemCount = 0;
+  ResetEncoder();
+
+  vector<char> buff;
+  ReadTail(m_stream, kHeaderSize, m_fileSize, buff);
+  if (!m_stream.good())
+    MYTHROW(OpenException, ("Read error.", m_filePath));
+
+  char const * const begin = buff.data();
+  char const * const end = begin + (m_fileSize - kHeaderSize);
+  char const * p = begin;
+  Decoder decoder;
+  TItem item;
+  while (p != end)
+  {
+    uint64_t const offset = kHeaderSize + (p - begin);
+    if (!decoder.Decode(p, end, item))
+    {
+      m_fileSize = offset;
+      return false;
+    }
+
+    if (m_itemCount % kItemBlockSize == 0)
+      m_blockOffsets.push_back(offset);
+    m_lastFields = decoder.GetFields();
+    m_lastSource = static_cast<uint8_t>(item.m_source);
+    ++m_itemCount;
+  }
+  return true;
 }
 
 size_t GpsTrackStorage::GetFirstItemIndex() const
@@ -5,10 +5,13 @@
 #include "base/exception.hpp"
 #include "base/macros.hpp"
 
+#include "std/array.hpp"
+#include "std/cstdint.hpp"
 #include "std/fstream.hpp"
 #include "std/function.hpp"
 #include "std/limits.hpp"
 #include "std/string.hpp"
+#include "std/vector.hpp"
 
 class GpsTrackStorage final
 {
@@ -45,10 +48,28 @@ private:
   void TruncFile();
   size_t GetFirstItemIndex() const;
 
+  // Replaces the file by a new one with |items|.
+  void Rewrite(vector<TItem> const & items);
+  void ResetEncoder();
+  // Appends the record of |item| to |buffer| which is written at the end of file.
+  void Encode(TItem const & item, string & buffer);
+  // Reads the file from the beginning, initializes the state for appending.
+  // @return false if the end of file is broken.
+  bool Scan();
+
   string const m_filePath;
   size_t const m_maxItemCount;
   fstream m_stream;
   size_t m_itemCount; // current number of items in file, read note
+  uint64_t m_fileSize = 0;
+
+  // Items are stored by blocks, the first item of a block is stored as is,
+  // other items are stored as deltas to previous items. So reading may start
+  // from the beginning of any block.
+  vector<uint64_t> m_blockOffsets;
+  // Quantized fields and the source of the last item.
+  array<int64_t, 8> m_lastFields;
+  uint8_t m_lastSource = 0;
 
   // NOTE
   // New items append to the end of file, when file become too big, it is truncated.
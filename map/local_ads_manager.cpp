@@ -87,13 +87,12 @@ std::string MakeCampaignDownloadingURL(MwmSet::MwmId const & mwmId)
   return ss.str();
 }
 
-using CampaignData = std::map<FeatureID, LocalAdsMarkData>;
+using CampaignData = LocalAdsManager::CampaignData;
 
-CampaignData ParseCampaign(std::vector<uint8_t> const & rawData, MwmSet::MwmId const & mwmId,
-                           LocalAdsManager::Timestamp timestamp)
+CampaignData ParseCampaign(std::vector<local_ads::Campaign> const & campaigns,
+                           MwmSet::MwmId const & mwmId, LocalAdsManager::Timestamp timestamp)
 {
   CampaignData data;
-  auto campaigns = local_ads::Deserialize(rawData);
   for (local_ads::Campaign const & campaign : campaigns)
   {
     std::string const iconName = campaign.GetIconName();
@@ -461,23 +460,22 @@ void LocalAdsManager::ThreadRoutine()
         if (!DownloadCampaign(mwm.first, info.m_data))
           continue;
 
-        // Parse data and recreate marks.
-        ClearLocalAdsForMwm(mwm.first);
+        // Parse data and apply the difference with the previous campaign of the mwm.
         if (!info.m_data.empty())
-        {
-          auto campaignData = ParseCampaign(std::move(info.m_data), mwm.first, info.m_created);
-          if (!campaignData.empty())
-          {
-            UpdateFeaturesCache(ReadCampaignFeatures(m_readFeaturesFn, campaignData));
-            CreateLocalAdsMarks(m_bmManager, campaignData);
-          }
-        }
+          info.m_campaigns = local_ads::Deserialize(info.m_data);
+        auto campaignData = ParseCampaign(info.m_campaigns, mwm.first, info.m_created);
+        ReadCampaignFeatures(m_readFeaturesFn, campaignData);
+        UpdateFeaturesCacheForMwm(mwm.first, campaignData);
+
+        // Marks are recreated, since their icons and texts may be changed.
+        DeleteLocalAdsMarks(m_bmManager, mwm.first);
+        CreateLocalAdsMarks(m_bmManager, campaignData);
 
         // Update run-time data.
         {
           std::lock_guard<std::mutex> lock(m_mutex);
           m_campaigns[countryName] = true;
-          m_info[countryName] = info;
+          m_info[countryName] = std::move(info);
         }
       }
       else if (mwm.second == RequestType::Delete)
@@ -537,7 +535,9 @@ void LocalAdsManager::ReadCampaignFile(std::string const & campaignFile)
       std::string countryName;
       CampaignInfo info;
       DeserializeCampaign(src, countryName, info.m_created, info.m_data);
-      m_info[countryName] = info;
+      if (!info.m_data.empty())
+        info.m_campaigns = local_ads::Deserialize(info.m_data);
+      m_info[countryName] = std::move(info);
       m_campaigns[countryName] = false;
     }
   }
@@ -575,27 +575,66 @@ void LocalAdsManager::Invalidate()
     std::lock_guard<std::mutex> lock(m_mutex);
     for (auto const & info : m_info)
     {
-      auto data = ParseCampaign(info.second.m_data, m_getMwmIdByNameFn(info.first),
+      auto data = ParseCampaign(info.second.m_campaigns, m_getMwmIdByNameFn(info.first),
                                 info.second.m_created);
       campaignData.insert(data.begin(), data.end());
     }
   }
-  UpdateFeaturesCache(ReadCampaignFeatures(m_readFeaturesFn, campaignData));
+  ReadCampaignFeatures(m_readFeaturesFn, campaignData);
+  UpdateFeaturesCache(campaignData);
   CreateLocalAdsMarks(m_bmManager, campaignData);
 }
 
-void LocalAdsManager::UpdateFeaturesCache(std::set<FeatureID> && ids)
+void LocalAdsManager::UpdateFeaturesCache(CampaignData const & campaignData)
 {
   std::set<FeatureID> featuresCache;
   {
     std::lock_guard<std::mutex> lock(m_featuresCacheMutex);
-    if (!ids.empty())
-      m_featuresCache.insert(ids.begin(), ids.end());
-    featuresCache = m_featuresCache;
+    for (auto const & data : campaignData)
+      m_featuresCache[data.first] = data.second.m_position;
+    for (auto const & feature : m_featuresCache)
+      featuresCache.insert(featuresCache.end(), feature.first);
   }
   m_drapeEngine.SafeCall(&df::DrapeEngine::SetCustomFeatures, std::move(featuresCache));
 }
 
+void LocalAdsManager::UpdateFeaturesCacheForMwm(MwmSet::MwmId const & mwmId,
+                                                CampaignData const & campaignData)
+{
+  std::set<FeatureID> features;
+  std::vector<m2::PointD> changedPositions;
+  {
+    std::lock_guard<std::mutex> lock(m_featuresCacheMutex);
+    auto it = m_featuresCache.lower_bound(FeatureID(mwmId, 0));
+    while (it != m_featuresCache.end() && it->first.m_mwmId == mwmId)
+    {
+      if (campaignData.find(it->first) == campaignData.cend())
+      {
+        changedPositions.push_back(it->second);
+        it = m_featuresCache.erase(it);
+      }
+      else
+      {
+        ++it;
+      }
+    }
+
+    for (auto const & data : campaignData)
+    {
+      ASSERT_EQUAL(data.first.m_mwmId, mwmId, ());
+      if (m_featuresCache.insert(std::make_pair(data.first, data.second.m_position)).second)
+        changedPositions.push_back(data.second.m_position);
+      features.insert(features.end(), data.first);
+    }
+  }
+
+  if (changedPositions.empty())
+    return;
+
+  m_drapeEngine.SafeCall(&df::DrapeEngine::SetCustomFeaturesForMwm, mwmId, std::move(features),
+                         std::move(changedPositions));
+}
+
 void LocalAdsManager::ClearLocalAdsForMwm(MwmSet::MwmId const & mwmId)
 {
   // Clear feature cache.
@@ -603,7 +642,7 @@ void LocalAdsManager::ClearLocalAdsForMwm(MwmSet::MwmId const & mwmId)
     std::lock_guard<std::mutex> lock(m_featuresCacheMutex);
     for (auto it = m_featuresCache.begin(); it != m_featuresCache.end();)
     {
-      if (it->m_mwmId == mwmId)
+      if (it->first.m_mwmId == mwmId)
         it = m_featuresCache.erase(it);
       else
         ++it;
@@ -1,5 +1,8 @@
 #pragma once
 
+#include "map/local_ads_mark.hpp"
+
+#include "local_ads/campaign.hpp"
 #include "local_ads/statistics.hpp"
 
 #include "drape_frontend/drape_engine_safe_ptr.hpp"
@@ -40,6 +43,7 @@ public:
   using ReadFeaturesFn = std::function<void(ReadFeatureTypeFn const &,
                                             std::set<FeatureID> const & features)>;
   using Timestamp = local_ads::Timestamp;
+  using CampaignData = std::map<FeatureID, LocalAdsMarkData>;
 
   LocalAdsManager(GetMwmsByRectFn && getMwmsByRectFn, GetMwmIdByNameFn && getMwmIdByName,
                   ReadFeaturesFn && readFeaturesFn);
@@ -80,7 +84,10 @@ private:
   void ReadCampaignFile(std::string const & campaignFile);
   void WriteCampaignFile(std::string const & campaignFile);
 
-  void UpdateFeaturesCache(std::set<FeatureID> && ids);
+  void UpdateFeaturesCache(CampaignData const & campaignData);
+  // Replaces features of the mwm in the cache and in graphics engine by the campaign features.
+  // Only tiles with added or removed features are reread.
+  void UpdateFeaturesCacheForMwm(MwmSet::MwmId const & mwmId, CampaignData const & campaignData);
   void ClearLocalAdsForMwm(MwmSet::MwmId const &mwmId);
 
   void FillSupportedTypes();
@@ -102,10 +109,13 @@ private:
   {
     Timestamp m_created;
     std::vector<uint8_t> m_data;
+    // Deserialized |m_data|, it's kept to not deserialize campaigns on every invalidation.
+    std::vector<local_ads::Campaign> m_campaigns;
   };
   std::map<std::string, CampaignInfo> m_info;
 
-  std::set<FeatureID> m_featuresCache;
+  // Positions of the features are kept to invalidate their tiles only.
+  std::map<FeatureID, m2::PointD> m_featuresCache;
   mutable std::mutex m_featuresCacheMutex;
 
   ftypes::HashSetMatcher<uint32_t> m_supportedTypes;
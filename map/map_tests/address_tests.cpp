@@ -44,3 +44,35 @@ UNIT_TEST(ReverseGeocoder_Smoke)
   TestAddress(coder, {53.89724, 27.54983}, "проспектнезависимости", "11");
   TestAddress(coder, {53.89745, 27.55835}, "улицакарламаркса", "18А");
 }
+
+UNIT_TEST(ReverseGeocoder_Batch)
+{
+  classificator::Load();
+
+  LocalCountryFile file = LocalCountryFile::MakeForTesting("minsk-pass");
+
+  Index index;
+  TEST_EQUAL(index.RegisterMap(file).second, MwmSet::RegResult::Success, ());
+
+  ReverseGeocoder coder(index);
+
+  vector<m2::PointD> points = {
+      MercatorBounds::FromLatLon(53.89815, 27.54265), MercatorBounds::FromLatLon(53.89953, 27.54189),
+      MercatorBounds::FromLatLon(53.89666, 27.54904), MercatorBounds::FromLatLon(53.89724, 27.54983),
+      MercatorBounds::FromLatLon(53.89745, 27.55835), MercatorBounds::FromLatLon(53.89816, 27.54266)};
+
+  for (size_t numThreads : {1, 3})
+  {
+    vector<ReverseGeocoder::Address> addrs;
+    coder.GetNearbyAddresses(points, addrs, numThreads);
+    TEST_EQUAL(addrs.size(), points.size(), ());
+
+    for (size_t i = 0; i < points.size(); ++i)
+    {
+      ReverseGeocoder::Address addr;
+      coder.GetNearbyAddress(points[i], addr);
+      TEST_EQUAL(addr.GetStreetName(), addrs[i].GetStreetName(), (i, numThreads));
+      TEST_EQUAL(addr.GetHouseNumber(), addrs[i].GetHouseNumber(), (i, numThreads));
+    }
+  }
+}
@@ -11,9 +11,11 @@
 #include "platform/platform.hpp"
 #include "platform/preferred_languages.hpp"
 
+#include "coding/file_writer.hpp"
 #include "coding/internal/file_data.hpp"
 
 #include "std/fstream.hpp"
+#include "std/sstream.hpp"
 #include "std/unique_ptr.hpp"
 
 namespace
@@ -210,6 +212,7 @@ UNIT_TEST(Bookmarks_ExportKML)
   cat2.reset(BookmarkCategory::CreateFromKMLFile(catFileName, framework));
   CheckBookmarks(*cat2);
   TEST(my::DeleteFileX(catFileName), ());
+  TEST(my::DeleteFileX(BookmarkCategory::GetCacheFileName(catFileName)), ());
 }
 
 namespace
@@ -621,6 +624,45 @@ UNIT_TEST(Bookmarks_SpecialXMLNames)
   TEST_EQUAL(bm1->GetName(), "![X1]{X2}(X3)", ());
 
   TEST(my::DeleteFileX(cat1.GetFileName()), ());
+  TEST(my::DeleteFileX(BookmarkCategory::GetCacheFileName(cat1.GetFileName())), ());
+}
+
+UNIT_TEST(Bookmarks_Cache)
+{
+  Framework framework(kFrameworkParams);
+  df::VisualParams::Init(1.0, 1024);
+
+  BookmarkCategory cat("Default", framework);
+  TEST(cat.LoadFromKML(make_unique<MemReader>(kmlString, strlen(kmlString))), ());
+  TEST(cat.SaveToKMLFile(), ());
+  string const file = cat.GetFileName();
+  string const cacheFile = BookmarkCategory::GetCacheFileName(file);
+  TEST(Platform::IsFileExistsByFullPath(cacheFile), ());
+
+  unique_ptr<BookmarkCategory> cat2(BookmarkCategory::CreateFromKMLFile(file, framework));
+  TEST(cat2.get(), ());
+  CheckBookmarks(*cat2);
+  TEST_EQUAL(cat2->GetName(), "MapName", ());
+  TEST_EQUAL(cat2->IsVisible(), false, ());
+  for (size_t i = 0; i < cat.GetUserMarkCount(); ++i)
+  {
+    Bookmark const * bm1 = static_cast<Bookmark const *>(cat.GetUserMark(i));
+    Bookmark const * bm2 = static_cast<Bookmark const *>(cat2->GetUserMark(i));
+    TEST_EQUAL(bm1->GetPivot(), bm2->GetPivot(), (i));
+    TEST_EQUAL(bm1->GetScale(), bm2->GetScale(), (i));
+  }
+
+  // The cache is not used when the KML file is changed.
+  {
+    FileWriter writer(file);
+    writer.Write(kmlString3, strlen(kmlString3));
+  }
+  cat2.reset(BookmarkCategory::CreateFromKMLFile(file, framework));
+  TEST(cat2.get(), ());
+  TEST_EQUAL(cat2->GetUserMarkCount(), 1, ());
+
+  TEST(my::DeleteFileX(file), ());
+  TEST(my::DeleteFileX(cacheFile), ());
 }
 
 UNIT_TEST(TrackParsingTest_1)
@@ -662,3 +704,34 @@ UNIT_TEST(TrackParsingTest_2)
   TEST_GREATER(track->GetLayerCount(), 0, ());
   TEST_EQUAL(track->GetColor(0), dp::Color(57, 255, 32, 255), ());
 }
+
+UNIT_TEST(TrackParsingTest_Simplification)
+{
+  Framework framework(kFrameworkParams);
+
+  // A straight track with a spike in the middle.
+  size_t const kPointsCount = 20001;
+  ostringstream kml;
+  kml << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+         "<kml xmlns=\"http://earth.google.com/kml/2.2\"><Document><Placemark><name>Long</name>"
+         "<LineString><coordinates>";
+  for (size_t i = 0; i < kPointsCount; ++i)
+    kml << (i == kPointsCount / 2 ? 0.1 : 0.0) << ',' << i * 1e-4 << ' ';
+  kml << "</coordinates></LineString></Placemark></Document></kml>";
+  string const kmlString = kml.str();
+
+  BookmarkCategoryData data;
+  TEST(BookmarkCategory::ReadKML(make_unique<MemReader>(kmlString.data(), kmlString.size()), data),
+       ());
+  TEST_EQUAL(data.m_tracks.size(), 1, ());
+
+  auto const & points = data.m_tracks[0].m_polyline.GetPoints();
+  TEST_LESS(points.size(), 10, ());
+  TEST(points.front().EqualDxDy(MercatorBounds::FromLatLon(0.0, 0.0), 1e-9), (points.front()));
+  TEST(points.back().EqualDxDy(MercatorBounds::FromLatLon((kPointsCount - 1) * 1e-4, 0.0), 1e-9),
+       (points.back()));
+  auto const spike = MercatorBounds::FromLatLon(kPointsCount / 2 * 1e-4, 0.1);
+  TEST(find_if(points.begin(), points.end(), [&spike](m2::PointD const & p) {
+         return p.EqualDxDy(spike, 1e-9);
+       }) != points.end(), (points));
+}
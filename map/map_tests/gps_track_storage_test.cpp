@@ -6,10 +6,12 @@
 
 #include "coding/file_name_utils.hpp"
 #include "coding/file_writer.hpp"
+#include "coding/internal/file_data.hpp"
 
 #include "geometry/latlon.hpp"
 
 #include "base/logging.hpp"
+#include "base/math.hpp"
 #include "base/scope_guard.hpp"
 
 #include "std/chrono.hpp"
@@ -184,3 +186,56 @@ UNIT_TEST(GpsTrackStorage_WriteReadWithTrunc)
     TEST_EQUAL(i, 0, ());
   }
 }
+
+UNIT_TEST(GpsTrackStorage_CompactAndBrokenTail)
+{
+  string const filePath = GetGpsTrackFilePath();
+  MY_SCOPE_GUARD(gpsTestFileDeleter, bind(FileWriter::DeleteFileX, filePath));
+  FileWriter::DeleteFileX(filePath);
+
+  size_t const fileMaxItemCount = 10000;
+  double const timestamp = 1500000000.0;
+
+  vector<location::GpsInfo> points;
+  for (size_t i = 0; i < 2500; ++i)
+  {
+    double const d = static_cast<double>(i);
+    points.emplace_back(Make(timestamp + d, ms::LatLon(53.9 + d * 1e-5, 27.56 - d * 1e-5), 10.0));
+  }
+
+  {
+    GpsTrackStorage stg(filePath, fileMaxItemCount);
+    stg.Append(points);
+  }
+
+  // Close points are stored by deltas.
+  uint64_t fileSize = 0;
+  TEST(my::GetFileSize(filePath, fileSize), ());
+  TEST_LESS(fileSize, points.size() * 16, ());
+
+  // A partially written item is dropped.
+  {
+    FileWriter writer(filePath, FileWriter::OP_APPEND);
+    uint8_t const tail[] = {50, 0, 1};
+    writer.Write(tail, sizeof(tail));
+  }
+
+  {
+    GpsTrackStorage stg(filePath, fileMaxItemCount);
+    stg.Append(points);
+
+    size_t i = 0;
+    stg.ForEach([&](location::GpsInfo const & point)->bool
+    {
+      auto const & expected = points[i % points.size()];
+      TEST(my::AlmostEqualAbs(point.m_latitude, expected.m_latitude, 1e-7), (i));
+      TEST(my::AlmostEqualAbs(point.m_longitude, expected.m_longitude, 1e-7), (i));
+      TEST_EQUAL(point.m_timestamp, expected.m_timestamp, (i));
+      TEST_EQUAL(point.m_speed, expected.m_speed, (i));
+      TEST_EQUAL(point.m_source, expected.m_source, (i));
+      ++i;
+      return true;
+    });
+    TEST_EQUAL(i, 2 * points.size(), ());
+  }
+}
@@ -44,6 +44,7 @@ SOURCES += \
   gps_track_test.cpp \
   kmz_unarchive_test.cpp \
   mwm_url_tests.cpp \
+  startup_trace_test.cpp \
   transliteration_test.cpp \
 
 !linux* {
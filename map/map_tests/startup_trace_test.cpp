@@ -0,0 +1,27 @@
+#include "testing/testing.hpp"
+
+#include "map/startup_trace.hpp"
+
+#include "base/math.hpp"
+
+UNIT_TEST(StartupTrace_Smoke)
+{
+  StartupTrace trace;
+  TEST(trace.GetStages().empty(), ());
+  TEST_EQUAL(trace.GetTotalSeconds(), 0.0, ());
+
+  trace.Mark("first");
+  trace.Mark("second");
+
+  auto const & stages = trace.GetStages();
+  TEST_EQUAL(stages.size(), 2, ());
+  TEST_EQUAL(stages[0].m_name, "first", ());
+  TEST_EQUAL(stages[1].m_name, "second", ());
+  TEST_GREATER_OR_EQUAL(stages[0].m_seconds, 0.0, ());
+  TEST(my::AlmostEqualAbs(trace.GetTotalSeconds(), stages[0].m_seconds + stages[1].m_seconds, 1e-9),
+       ());
+
+  trace.Resume();
+  trace.Mark("third");
+  TEST_EQUAL(trace.GetStages().size(), 3, ());
+}
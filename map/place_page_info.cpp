@@ -29,6 +29,19 @@ bool Info::ShouldShowAddPlace() const
 void Info::SetFromFeatureType(FeatureType const & ft)
 {
   MapObject::SetFromFeatureType(ft);
+  UpdateTitles();
+}
+
+void Info::UpdateAddress(std::string const & address)
+{
+  m_address = address;
+  m_uiSecondaryTitle.clear();
+  m_uiAddress.clear();
+  UpdateTitles();
+}
+
+void Info::UpdateTitles()
+{
   std::string primaryName;
   std::string secondaryName;
   GetPrefferedNames(primaryName, secondaryName);
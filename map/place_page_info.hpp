@@ -106,6 +106,8 @@ public:
   void SetCustomName(std::string const & name);
   void SetCustomNameWithCoordinates(m2::PointD const & mercator, std::string const & name);
   void SetAddress(std::string const & address) { m_address = address; }
+  /// Sets the address of the feature which is already set and updates titles.
+  void UpdateAddress(std::string const & address);
   void SetIsMyPosition() { m_isMyPosition = true; }
   void SetCanEditOrAdd(bool canEditOrAdd) { m_canEditOrAdd = canEditOrAdd; }
   void SetLocalizedWifiString(std::string const & str) { m_localizedWifiString = str; }
@@ -195,6 +197,7 @@ public:
   std::vector<std::string> GetRawTypes() const { return m_types.ToObjectNames(); }
 
 private:
+  void UpdateTitles();
   std::string FormatSubtitle(bool withType) const;
   void GetPrefferedNames(std::string & primaryName, std::string & secondaryName) const;
   /// @returns empty string or GetStars() count of ★ symbol.
@@ -54,6 +54,8 @@ double const kRouteScaleMultiplier = 1.5;
 
 string const kRoutePointsFile = "route_points.dat";
 
+string const kTrackingSpoolFile = "tracking_spool.dat";
+
 uint32_t constexpr kInvalidTransactionId = 0;
 
 void FillTurnsDistancesForRendering(vector<RouteSegment> const & segments,
@@ -243,6 +245,8 @@ RoutingManager::RoutingManager(Callbacks && callbacks, Delegate & delegate)
 #endif
   });
 
+  m_trackingReporter.SetSpoolPath(GetPlatform().SettingsPathForFile(kTrackingSpoolFile));
+
   m_routingSession.SetReadyCallbacks(
       [this](Route const & route, IRouter::ResultCode code) { OnBuildRouteReady(route, code); },
       [this](Route const & route, IRouter::ResultCode code) { OnRebuildRouteReady(route, code); });
@@ -407,6 +411,7 @@ void RoutingManager::RemoveRoute(bool deactivateFollowing)
     // Remove all subroutes.
     m_drapeEngine.SafeCall(&df::DrapeEngine::RemoveSubroute,
                            dp::DrapeID(), true /* deactivateFollowing */);
+    m_delegate.OnRouteChanged({} /* points */, {} /* timesSec */);
   }
   else
   {
@@ -435,6 +440,8 @@ void RoutingManager::InsertRoute(Route const & route)
 
   vector<RouteSegment> segments;
   vector<m2::PointD> points;
+  vector<m2::PointD> routePoints;
+  vector<double> routeTimesSec;
   double distance = 0.0;
   auto const subroutesCount = route.GetSubrouteCount();
   for (size_t subrouteIndex = route.GetCurrentSubrouteIdx(); subrouteIndex < subroutesCount; ++subrouteIndex)
@@ -455,6 +462,15 @@ void RoutingManager::InsertRoute(Route const & route)
     }
     distance = segments.back().GetDistFromBeginningMerc();
 
+    if (m_currentRouterType == RouterType::Vehicle || m_currentRouterType == RouterType::Taxi)
+    {
+      for (auto const & s : segments)
+      {
+        routePoints.push_back(s.GetJunction().GetPoint());
+        routeTimesSec.push_back(s.GetTimeFromBeginningSec());
+      }
+    }
+
     auto subroute = make_unique_dp<df::Subroute>();
     subroute->m_polyline = m2::PolylineD(points);
     subroute->m_baseDistance = currentBaseDistance;
@@ -499,6 +515,8 @@ void RoutingManager::InsertRoute(Route const & route)
     lock_guard<mutex> lock(m_drapeSubroutesMutex);
     m_drapeSubroutes.push_back(subrouteId);
   }
+
+  m_delegate.OnRouteChanged(routePoints, routeTimesSec);
 }
 
 void RoutingManager::FollowRoute()
@@ -57,6 +57,10 @@ public:
   public:
     virtual void OnRouteFollow(routing::RouterType type) = 0;
     virtual void RegisterCountryFilesOnRoute(std::shared_ptr<routing::NumMwmIds> ptr) const = 0;
+    /// Called when the shown route is changed. |points| and |timesSec| are points of a car route
+    /// and ETAs to reach them. They're empty when the route is removed or it isn't a car route.
+    virtual void OnRouteChanged(std::vector<m2::PointD> const & points,
+                                std::vector<double> const & timesSec) = 0;
 
     virtual ~Delegate() = default;
   };
@@ -0,0 +1,27 @@
+#include "map/startup_trace.hpp"
+
+#include "base/logging.hpp"
+
+#include "std/sstream.hpp"
+
+void StartupTrace::Mark(string const & name)
+{
+  m_stages.emplace_back(name, m_timer.ElapsedSeconds());
+  m_timer.Reset();
+  LOG(LDEBUG, ("Startup stage", m_stages.back()));
+}
+
+double StartupTrace::GetTotalSeconds() const
+{
+  double total = 0.0;
+  for (auto const & stage : m_stages)
+    total += stage.m_seconds;
+  return total;
+}
+
+string DebugPrint(StartupTrace::Stage const & stage)
+{
+  ostringstream out;
+  out << stage.m_name << ": " << static_cast<int>(stage.m_seconds * 1000.0) << " ms";
+  return out.str();
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "base/timer.hpp"
+
+#include "std/string.hpp"
+#include "std/vector.hpp"
+
+// Durations of stages of the framework startup. A stage lasts from the previous mark
+// (or the trace creation) till its own mark.
+class StartupTrace
+{
+public:
+  struct Stage
+  {
+    Stage(string const & name, double seconds) : m_name(name), m_seconds(seconds) {}
+
+    string m_name;
+    double m_seconds;
+  };
+
+  // Finishes the stage |name|, the next stage starts.
+  void Mark(string const & name);
+  // Starts the next stage now, the time since the last mark isn't traced.
+  void Resume() { m_timer.Reset(); }
+
+  vector<Stage> const & GetStages() const { return m_stages; }
+  double GetTotalSeconds() const;
+
+private:
+  my::Timer m_timer;
+  vector<Stage> m_stages;
+};
+
+string DebugPrint(StartupTrace::Stage const & stage);
@@ -50,6 +50,38 @@ UNIT_TEST(Classificator_CheckConsistency)
   });
 }
 
+UNIT_TEST(Classificator_RulesTableConsistency)
+{
+  UnitTestInitPlatform();
+  styles::RunForEveryMapStyle([](MapStyle)
+  {
+    Classificator const & c = classif();
+    drule::RulesTable const & table = c.GetRulesTable();
+    TEST(!table.IsEmpty(), ());
+
+    auto doCheck = [&](ClassifObject const * p, uint32_t type)
+    {
+      for (int scale = 0; scale <= scales::GetUpperStyleScale(); ++scale)
+      {
+        for (auto const geomType : {feature::GEOM_POINT, feature::GEOM_LINE, feature::GEOM_AREA})
+        {
+          drule::KeysT expected;
+          p->GetSuitable(scale, geomType, expected);
+
+          drule::KeysT keys;
+          bool hasSelectors = false;
+          TEST(table.GetSuitable(type, scale, geomType, keys, hasSelectors),
+               (c.GetFullObjectName(type)));
+          TEST_EQUAL(keys.size(), expected.size(), (c.GetFullObjectName(type), scale, geomType));
+          TEST(equal(keys.begin(), keys.end(), expected.begin()),
+               (c.GetFullObjectName(type), scale, geomType));
+        }
+      }
+    };
+    c.ForEachTree(doCheck);
+  });
+}
+
 using namespace feature;
 
 namespace
@@ -21,6 +21,15 @@ auto constexpr kOutdatedDataTimeout = minutes(5) + kUpdateInterval;
 auto constexpr kNetworkErrorTimeout = minutes(20);
 
 auto constexpr kMaxRetriesCount = 5;
+
+// Route points are sampled with the distance to find mwms of the route.
+double constexpr kRouteSampleDistanceM = 2000.0;
+// Traffic is prefetched for mwms which will be reached in the time.
+auto constexpr kPrefetchHorizon = minutes(30);
+// Bandwidth budget of prefetching: number of mwms and a part of the cache which
+// may be taken by prefetched data.
+size_t constexpr kMaxPrefetchMwms = 4;
+size_t constexpr kPrefetchCacheDivider = 2;
 } // namespace
 
 
@@ -121,13 +130,16 @@ void TrafficManager::SetEnabled(bool enabled)
 void TrafficManager::Clear()
 {
   m_currentCacheSizeBytes = 0;
+  m_cacheMemory.Set(0);
   m_mwmCache.clear();
   m_lastDrapeMwmsByRect.clear();
   m_lastRoutingMwmsByRect.clear();
   m_activeDrapeMwms.clear();
   m_activeRoutingMwms.clear();
+  m_prefetchMwms.clear();
   m_requestedMwms.clear();
   m_trafficETags.clear();
+  m_trafficColorings.clear();
 }
 
 void TrafficManager::SetDrapeEngine(ref_ptr<df::DrapeEngine> engine)
@@ -212,7 +224,106 @@ void TrafficManager::UpdateMyPosition(MyPosition const & myPosition)
   // Request traffic.
   UpdateActiveMwms(rect, m_lastRoutingMwmsByRect, m_activeRoutingMwms);
 
-  // @TODO Do all routing stuff.
+  if (myPosition.m_knownPosition)
+    UpdatePrefetchMwms(myPosition.m_position);
+}
+
+void TrafficManager::SetRoute(vector<m2::PointD> const & points, vector<double> const & timesSec)
+{
+  ASSERT_EQUAL(points.size(), timesSec.size(), ());
+  m_routeSamples.clear();
+  m_passedRouteSamples = 0;
+
+  for (size_t i = 0; i < points.size(); ++i)
+  {
+    if (i + 1 != points.size() && !m_routeSamples.empty() &&
+        MercatorBounds::DistanceOnEarth(m_routeSamples.back().m_point, points[i]) <
+            kRouteSampleDistanceM)
+    {
+      continue;
+    }
+    m_routeSamples.emplace_back(points[i], timesSec[i]);
+  }
+
+  for (auto & sample : m_routeSamples)
+  {
+    m2::RectD const rect = MercatorBounds::RectByCenterXYAndSizeInMeters(sample.m_point, 1.0);
+    for (auto const & mwm : m_getMwmsByRectFn(rect))
+    {
+      if (mwm.IsAlive())
+        sample.m_mwms.push_back(mwm);
+    }
+  }
+
+  if (m_routeSamples.empty())
+  {
+    lock_guard<mutex> lock(m_mutex);
+    m_prefetchMwms.clear();
+    return;
+  }
+
+  if (!IsEnabled() || IsInvalidState() || m_isPaused)
+    return;
+
+  m2::PointD const position = m_currentPosition.second && m_currentPosition.first.m_knownPosition
+                                  ? m_currentPosition.first.m_position
+                                  : m_routeSamples.front().m_point;
+  UpdatePrefetchMwms(position);
+}
+
+void TrafficManager::UpdatePrefetchMwms(m2::PointD const & position)
+{
+  if (m_routeSamples.empty())
+    return;
+
+  // The route is passed forward, so the closest sample is looked for ahead of passed ones only.
+  size_t closest = m_passedRouteSamples;
+  double minDistance = MercatorBounds::DistanceOnEarth(position, m_routeSamples[closest].m_point);
+  for (size_t i = closest + 1; i < m_routeSamples.size(); ++i)
+  {
+    double const distance = MercatorBounds::DistanceOnEarth(position, m_routeSamples[i].m_point);
+    if (distance < minDistance)
+    {
+      minDistance = distance;
+      closest = i;
+    }
+  }
+  m_passedRouteSamples = closest;
+
+  double const startTimeSec = m_routeSamples[closest].m_timeSec;
+  double const horizonSec = duration_cast<seconds>(kPrefetchHorizon).count();
+
+  lock_guard<mutex> lock(m_mutex);
+
+  vector<MwmSet::MwmId> mwms;
+  size_t prefetchedBytes = 0;
+  for (size_t i = closest; i < m_routeSamples.size() && mwms.size() < kMaxPrefetchMwms; ++i)
+  {
+    auto const & sample = m_routeSamples[i];
+    if (sample.m_timeSec - startTimeSec > horizonSec)
+      break;
+
+    for (auto const & mwm : sample.m_mwms)
+    {
+      if (mwms.size() >= kMaxPrefetchMwms || find(mwms.begin(), mwms.end(), mwm) != mwms.end())
+        continue;
+
+      auto const it = m_mwmCache.find(mwm);
+      if (it != m_mwmCache.end())
+      {
+        if (prefetchedBytes + it->second.m_dataSize > m_maxCacheSizeBytes / kPrefetchCacheDivider)
+          continue;
+        prefetchedBytes += it->second.m_dataSize;
+      }
+      mwms.push_back(mwm);
+    }
+  }
+
+  if (mwms == m_prefetchMwms)
+    return;
+
+  m_prefetchMwms.swap(mwms);
+  RequestTrafficData();
 }
 
 void TrafficManager::UpdateViewport(ScreenBase const & screen)
@@ -242,12 +353,34 @@ void TrafficManager::ThreadRoutine()
       traffic::TrafficInfo info(mwm, m_currentDataVersion);
 
       string tag;
+      shared_ptr<traffic::TrafficInfo::Coloring const> coloring;
       {
         lock_guard<mutex> lock(m_mutex);
         tag = m_trafficETags[mwm];
+        auto const it = m_trafficColorings.find(mwm);
+        if (it != m_trafficColorings.end())
+          coloring = it->second;
+      }
+
+      if (coloring && !tag.empty())
+        info.SetBaseColoring(*coloring);
+
+      bool const received = info.ReceiveTrafficData(tag);
+      if (received && !info.GetColoring().empty())
+        coloring = make_shared<traffic::TrafficInfo::Coloring const>(info.GetColoring());
+      else if (!received || tag.empty())
+        coloring.reset();
+
+      {
+        lock_guard<mutex> lock(m_mutex);
+        m_trafficETags[mwm] = tag;
+        if (coloring)
+          m_trafficColorings[mwm] = coloring;
+        else
+          m_trafficColorings.erase(mwm);
       }
 
-      if (info.ReceiveTrafficData(tag))
+      if (received)
       {
         OnTrafficDataResponse(move(info));
       }
@@ -256,11 +389,6 @@ void TrafficManager::ThreadRoutine()
         LOG(LWARNING, ("Traffic request failed. Mwm =", mwm));
         OnTrafficRequestFailed(move(info));
       }
-
-      {
-        lock_guard<mutex> lock(m_mutex);
-        m_trafficETags[mwm] = tag;
-      }
     }
     mwms.clear();
   }
@@ -319,8 +447,8 @@ void TrafficManager::RequestTrafficData(MwmSet::MwmId const & mwmId, bool force)
 
 void TrafficManager::RequestTrafficData()
 {
-  if ((m_activeDrapeMwms.empty() && m_activeRoutingMwms.empty()) || !IsEnabled() ||
-      IsInvalidState() || m_isPaused)
+  if ((m_activeDrapeMwms.empty() && m_activeRoutingMwms.empty() && m_prefetchMwms.empty()) ||
+      !IsEnabled() || IsInvalidState() || m_isPaused)
   {
     return;
   }
@@ -329,6 +457,16 @@ void TrafficManager::RequestTrafficData()
     ASSERT(mwmId.IsAlive(), ());
     RequestTrafficData(mwmId, false /* force */);
   });
+
+  // Mwms along the route are requested after the active ones, the nearest first.
+  for (auto const & mwmId : m_prefetchMwms)
+  {
+    if (mwmId.IsAlive() && m_activeDrapeMwms.count(mwmId) == 0 &&
+        m_activeRoutingMwms.count(mwmId) == 0)
+    {
+      RequestTrafficData(mwmId, false /* force */);
+    }
+  }
   UpdateState();
 }
 
@@ -384,6 +522,7 @@ void TrafficManager::OnTrafficDataResponse(traffic::TrafficInfo && info)
       m_currentCacheSizeBytes += (dataSize - it->second.m_dataSize);
       it->second.m_dataSize = dataSize;
       ShrinkCacheToAllowableSize();
+      m_cacheMemory.Set(m_currentCacheSizeBytes);
     }
 
     UpdateState();
@@ -410,6 +549,8 @@ void TrafficManager::ShrinkCacheToAllowableSize()
   // Calculating number of different active mwms.
   set<MwmSet::MwmId> activeMwms;
   UniteActiveMwms(activeMwms);
+  // Prefetched data is kept as well.
+  activeMwms.insert(m_prefetchMwms.cbegin(), m_prefetchMwms.cend());
   size_t const numActiveMwms = activeMwms.size();
 
   if (m_currentCacheSizeBytes > m_maxCacheSizeBytes && m_mwmCache.size() > numActiveMwms)
@@ -437,6 +578,7 @@ void TrafficManager::ClearCache(MwmSet::MwmId const & mwmId)
   {
     ASSERT_GREATER_OR_EQUAL(m_currentCacheSizeBytes, it->second.m_dataSize, ());
     m_currentCacheSizeBytes -= it->second.m_dataSize;
+    m_cacheMemory.Set(m_currentCacheSizeBytes);
 
     m_drapeEngine.SafeCall(&df::DrapeEngine::ClearTrafficCache, mwmId);
 
@@ -447,6 +589,7 @@ void TrafficManager::ClearCache(MwmSet::MwmId const & mwmId)
   }
   m_mwmCache.erase(it);
   m_trafficETags.erase(mwmId);
+  m_trafficColorings.erase(mwmId);
 }
 
 bool TrafficManager::IsEnabled() const
@@ -544,6 +687,24 @@ void TrafficManager::OnEnterBackground()
   Pause();
 }
 
+void TrafficManager::ShrinkCache()
+{
+  lock_guard<mutex> lock(m_mutex);
+
+  set<MwmSet::MwmId> activeMwms;
+  UniteActiveMwms(activeMwms);
+  activeMwms.insert(m_prefetchMwms.cbegin(), m_prefetchMwms.cend());
+
+  vector<MwmSet::MwmId> inactiveMwms;
+  for (auto const & mwmInfo : m_mwmCache)
+  {
+    if (activeMwms.count(mwmInfo.first) == 0)
+      inactiveMwms.push_back(mwmInfo.first);
+  }
+  for (auto const & mwmId : inactiveMwms)
+    ClearCache(mwmId);
+}
+
 void TrafficManager::Pause()
 {
   m_isPaused = true;
@@ -14,6 +14,8 @@
 #include "indexer/index.hpp"
 #include "indexer/mwm_set.hpp"
 
+#include "base/cache_registry.hpp"
+#include "base/memory_counters.hpp"
 #include "base/thread.hpp"
 
 #include "std/algorithm.hpp"
@@ -71,6 +73,13 @@ public:
   void UpdateViewport(ScreenBase const & screen);
   void UpdateMyPosition(MyPosition const & myPosition);
 
+  /// \brief Sets the active route to prefetch traffic for mwms along it.
+  /// \param points are points of the route.
+  /// \param timesSec are ETAs in seconds to reach |points| from the route beginning.
+  /// \note Traffic is requested in the ETA order for mwms which will be reached soon.
+  /// Empty |points| clears the route.
+  void SetRoute(vector<m2::PointD> const & points, vector<double> const & timesSec);
+
   void Invalidate();
 
   void OnDestroyGLContext();
@@ -80,6 +89,9 @@ public:
   void OnEnterForeground();
   void OnEnterBackground();
 
+  /// Drops traffic of mwms which are neither shown nor used by the route.
+  void ShrinkCache();
+
   void SetSimplifiedColorScheme(bool simplified);
 
 private:
@@ -101,6 +113,15 @@ private:
     traffic::TrafficInfo::Availability m_lastAvailability;
   };
 
+  struct RouteSample
+  {
+    RouteSample(m2::PointD const & point, double timeSec) : m_point(point), m_timeSec(timeSec) {}
+
+    m2::PointD m_point;
+    double m_timeSec;
+    vector<MwmSet::MwmId> m_mwms;
+  };
+
   void ThreadRoutine();
   bool WaitForRequest(vector<MwmSet::MwmId> & mwms);
 
@@ -115,6 +136,10 @@ private:
   void UpdateActiveMwms(m2::RectD const & rect, vector<MwmSet::MwmId> & lastMwmsByRect,
                         set<MwmSet::MwmId> & activeMwms);
 
+  /// \brief Updates |m_prefetchMwms| by mwms of the route ahead of |position|.
+  /// \note |m_mutex| is locked inside the method. So the method should be called without |m_mutex|.
+  void UpdatePrefetchMwms(m2::PointD const & position);
+
   // This is a group of methods that haven't their own synchronization inside.
   void RequestTrafficData();
   void RequestTrafficData(MwmSet::MwmId const & mwmId, bool force);
@@ -157,6 +182,8 @@ private:
 
   size_t m_maxCacheSizeBytes;
   size_t m_currentCacheSizeBytes = 0;
+  // Reports |m_currentCacheSizeBytes| to base::MemoryCounters.
+  base::MemoryCounter m_cacheMemory{"traffic.cache"};
 
   map<MwmSet::MwmId, CacheEntry> m_mwmCache;
 
@@ -168,16 +195,27 @@ private:
   vector<MwmSet::MwmId> m_lastRoutingMwmsByRect;
   set<MwmSet::MwmId> m_activeRoutingMwms;
 
+  // Samples of the active route. They're used on the GUI thread only.
+  vector<RouteSample> m_routeSamples;
+  size_t m_passedRouteSamples = 0;
+  // Mwms of the active route which will be reached soon in the ETA order.
+  vector<MwmSet::MwmId> m_prefetchMwms;
+
   // The ETag or entity tag is part of HTTP, the protocol for the World Wide Web.
   // It is one of several mechanisms that HTTP provides for web cache validation,
   // which allows a client to make conditional requests.
   map<MwmSet::MwmId, string> m_trafficETags;
+  // Colorings which correspond to m_trafficETags, the server may send only changes against them.
+  map<MwmSet::MwmId, shared_ptr<traffic::TrafficInfo::Coloring const>> m_trafficColorings;
 
   atomic<bool> m_isPaused;
 
   vector<MwmSet::MwmId> m_requestedMwms;
   mutex m_mutex;
   threads::SimpleThread m_thread;
+
+  base::SheddableCache m_cacheShedding{"traffic.cache", base::CacheRegistry::Priority::Low,
+                                       [this]() { ShrinkCache(); }};
 };
 
 extern string DebugPrint(TrafficManager::TrafficState state);
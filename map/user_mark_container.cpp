@@ -9,6 +9,7 @@
 #include "base/stl_add.hpp"
 
 #include "std/algorithm.hpp"
+#include "std/vector.hpp"
 
 namespace
 {
@@ -73,8 +74,19 @@ UserMark const * UserMarkContainer::FindMarkInRect(m2::AnyRectD const & rect, do
   UserMark * mark = nullptr;
   if (IsVisible())
   {
+    if (!m_isIndexValid)
+      BuildIndex();
+
+    vector<size_t> candidates;
+    m_index.ForEachInRect(rect.GetGlobalRect(), [&candidates](size_t index)
+    {
+      candidates.push_back(index);
+    });
+    // The first one of marks with the same distance is chosen.
+    sort(candidates.begin(), candidates.end());
+
     FindMarkFunctor f(&mark, d, rect);
-    for (size_t i = 0; i < m_userMarks.size(); ++i)
+    for (size_t const i : candidates)
     {
       if (m_userMarks[i]->IsAvailableForSearch() && rect.IsPointInside(m_userMarks[i]->GetPivot()))
          f(m_userMarks[i].get());
@@ -83,6 +95,17 @@ UserMark const * UserMarkContainer::FindMarkInRect(m2::AnyRectD const & rect, do
   return mark;
 }
 
+void UserMarkContainer::BuildIndex() const
+{
+  m_index.Clear();
+  for (size_t i = 0; i < m_userMarks.size(); ++i)
+  {
+    m2::PointD const & org = m_userMarks[i]->GetPivot();
+    m_index.Add(i, m2::RectD(org, org));
+  }
+  m_isIndexValid = true;
+}
+
 namespace
 {
 
@@ -178,6 +201,7 @@ UserMark * UserMarkContainer::CreateUserMark(m2::PointD const & ptOrg)
 {
   // Push front an user mark.
   SetDirty();
+  InvalidateIndex();
   m_userMarks.push_front(unique_ptr<UserMark>(AllocateUserMark(ptOrg)));
   m_createdMarks.m_marksID.push_back(m_userMarks.front()->GetId());
   return m_userMarks.front().get();
@@ -202,6 +226,7 @@ UserMarkType UserMarkContainer::GetType() const
 UserMark * UserMarkContainer::GetUserMarkForEdit(size_t index)
 {
   SetDirty();
+  InvalidateIndex();
   ASSERT_LESS(index, m_userMarks.size(), ());
   return m_userMarks[index].get();
 }
@@ -209,6 +234,7 @@ UserMark * UserMarkContainer::GetUserMarkForEdit(size_t index)
 void UserMarkContainer::Clear(size_t skipCount/* = 0*/)
 {
   SetDirty();
+  InvalidateIndex();
   if (skipCount < m_userMarks.size())
     m_userMarks.erase(m_userMarks.begin(), m_userMarks.end() - skipCount);
 }
@@ -249,6 +275,7 @@ bool UserMarkContainer::IsDirty() const
 void UserMarkContainer::DeleteUserMark(size_t index)
 {
   SetDirty();
+  InvalidateIndex();
   ASSERT_LESS(index, m_userMarks.size(), ());
   if (index < m_userMarks.size())
   {
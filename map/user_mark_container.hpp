@@ -7,6 +7,7 @@
 #include "geometry/point2d.hpp"
 #include "geometry/rect2d.hpp"
 #include "geometry/any_rect2d.hpp"
+#include "geometry/tree4d.hpp"
 
 #include "std/deque.hpp"
 #include "std/bitset.hpp"
@@ -95,6 +96,8 @@ public:
 
 protected:
   void SetDirty();
+  // Marks the spatial index as outdated, it's rebuilt by the next search.
+  void InvalidateIndex() { m_isIndexValid = false; }
 
   virtual UserMark * AllocateUserMark(m2::PointD const & ptOrg) = 0;
 
@@ -108,6 +111,11 @@ private:
   df::MarkIDCollection m_createdMarks;
   df::MarkIDCollection m_removedMarks;
   bool m_isDirty = false;
+
+  // Indices of marks in |m_userMarks| by their positions, it's used for hit testing.
+  void BuildIndex() const;
+  mutable m4::Tree<size_t> m_index;
+  mutable bool m_isIndexValid = false;
 };
 
 class SearchUserMarkContainer : public UserMarkContainer
@@ -10,23 +10,30 @@
 
 #include "base/string_utils.hpp"
 
+#include "std/algorithm.hpp"
+#include "std/condition_variable.hpp"
+#include "std/deque.hpp"
 #include "std/exception.hpp"
 #include "std/fstream.hpp"
 #include "std/iomanip.hpp"
 #include "std/iostream.hpp"
+#include "std/mutex.hpp"
 #include "std/string.hpp"
+#include "std/thread.hpp"
+#include "std/vector.hpp"
 
 #include "3party/gflags/src/gflags/gflags.h"
 
 #pragma mark Define options
 //----------------------------------------------------------------------------------------
 DEFINE_bool(c, false, "Read places from stdin");
-DEFINE_string(place, "", "Define place in format \"lat;lon;zoom\"");
+DEFINE_string(place, "", "Define place in format \"lat;lon;zoom[;width;height]\"");
 DEFINE_string(outpath, "./", "Path for output files");
 DEFINE_string(datapath, "", "Path to data directory");
 DEFINE_string(mwmpath, "", "Path to mwm files");
 DEFINE_int32(width, 480, "Resulting image width");
 DEFINE_int32(height, 640, "Resulting image height");
+DEFINE_int32(threads, 1, "Count of threads which render places, the map is loaded once for all of them");
 //----------------------------------------------------------------------------------------
 
 namespace
@@ -40,22 +47,35 @@ struct Place
   int height;
 };
 
-Place ParsePlace(string const & src)
+// Size of the image is optional, flags define it by default.
+bool ParsePlace(string const & src, Place & p)
 {
-  Place p;
+  p.width = FLAGS_width;
+  p.height = FLAGS_height;
   try
   {
     strings::SimpleTokenizer token(src, ";");
     p.lat = stod(*token);
     p.lon = stod(*(++token));
     p.zoom = static_cast<int>(stoi(*(++token)));
+    if (++token)
+    {
+      p.width = stoi(*token);
+      p.height = stoi(*(++token));
+    }
   }
   catch (exception & e)
   {
     cerr << "Error in [" << src << "]: " << e.what() << endl;
-    exit(1);
+    return false;
+  }
+
+  if (p.width <= 0 || p.height <= 0)
+  {
+    cerr << "Error in [" << src << "]: invalid size of the image" << endl;
+    return false;
   }
-  return p;
+  return true;
 }
 
 string FilenameSeq(string const & path)
@@ -66,28 +86,12 @@ string FilenameSeq(string const & path)
   return filename.str();
 }
 
-unique_ptr<software_renderer::CPUDrawer> cpuDrawer;
-
-bool IsFrameRendererInitialized()
-{
-  return cpuDrawer != nullptr;
-}
-
-void InitFrameRenderer(float visualScale)
+unique_ptr<software_renderer::CPUDrawer> CreateFrameRenderer(float visualScale)
 {
   using namespace software_renderer;
 
-  if (cpuDrawer == nullptr)
-  {
-    string resPostfix = df::VisualParams::GetResourcePostfix(visualScale);
-    cpuDrawer = make_unique_dp<CPUDrawer>(CPUDrawer::Params(resPostfix, visualScale));
-  }
-}
-
-void ReleaseFrameRenderer()
-{
-  if (IsFrameRendererInitialized())
-    cpuDrawer.reset();
+  string resPostfix = df::VisualParams::GetResourcePostfix(visualScale);
+  return make_unique<CPUDrawer>(CPUDrawer::Params(resPostfix, visualScale));
 }
 
 /// @param center - map center in Mercator
@@ -101,51 +105,50 @@ void ReleaseFrameRenderer()
 ///                   It must be equal render buffer height. For retina it's equal 2.0 * displayHeight
 /// @param symbols - configuration for symbols on the frame
 /// @param image [out] - result image
-void DrawFrame(Framework & framework,
+void DrawFrame(Framework & framework, software_renderer::CPUDrawer & drawer,
                m2::PointD const & center, int zoomModifier,
                uint32_t pxWidth, uint32_t pxHeight,
                software_renderer::FrameSymbols const & symbols,
                software_renderer::FrameImage & image)
 {
-  ASSERT(IsFrameRendererInitialized(), ());
-
   int resultZoom = -1;
-  ScreenBase screen = cpuDrawer->CalculateScreen(center, zoomModifier, pxWidth, pxHeight, symbols, resultZoom);
+  ScreenBase screen = drawer.CalculateScreen(center, zoomModifier, pxWidth, pxHeight, symbols, resultZoom);
   ASSERT_GREATER(resultZoom, 0, ());
 
   uint32_t const bgColor = drule::rules().GetBgColor(resultZoom);
-  cpuDrawer->BeginFrame(pxWidth, pxHeight, dp::Extract(bgColor, 255 - (bgColor >> 24)));
+  drawer.BeginFrame(pxWidth, pxHeight, dp::Extract(bgColor, 255 - (bgColor >> 24)));
 
   m2::RectD renderRect = m2::RectD(0, 0, pxWidth, pxHeight);
   m2::RectD selectRect;
   m2::RectD clipRect;
-  double const inflationSize = 24 * cpuDrawer->GetVisualScale();
+  double const inflationSize = 24 * drawer.GetVisualScale();
   screen.PtoG(m2::Inflate(renderRect, inflationSize, inflationSize), clipRect);
   screen.PtoG(renderRect, selectRect);
 
   uint32_t const tileSize = static_cast<uint32_t>(df::CalculateTileSize(pxWidth, pxHeight));
-  int const drawScale = df::GetDrawTileScale(screen, tileSize, cpuDrawer->GetVisualScale());
-  software_renderer::FeatureProcessor doDraw(make_ref(cpuDrawer), clipRect, screen, drawScale);
+  int const drawScale = df::GetDrawTileScale(screen, tileSize, drawer.GetVisualScale());
+  software_renderer::FeatureProcessor doDraw(make_ref(&drawer), clipRect, screen, drawScale);
 
   int const upperScale = scales::GetUpperScale();
 
   framework.GetIndex().ForEachInRect(doDraw, selectRect, min(upperScale, drawScale));
 
-  cpuDrawer->Flush();
-  //cpuDrawer->DrawMyPosition(screen.GtoP(center));
+  drawer.Flush();
+  //drawer.DrawMyPosition(screen.GtoP(center));
 
   if (symbols.m_showSearchResult)
   {
     if (!screen.PixelRect().IsPointInside(screen.GtoP(symbols.m_searchResult)))
-      cpuDrawer->DrawSearchArrow(ang::AngleTo(center, symbols.m_searchResult));
+      drawer.DrawSearchArrow(ang::AngleTo(center, symbols.m_searchResult));
     else
-      cpuDrawer->DrawSearchResult(screen.GtoP(symbols.m_searchResult));
+      drawer.DrawSearchResult(screen.GtoP(symbols.m_searchResult));
   }
 
-  cpuDrawer->EndFrame(image);
+  drawer.EndFrame(image);
 }
 
-void RenderPlace(Framework & framework, Place const & place, string const & filename)
+void RenderPlace(Framework & framework, software_renderer::CPUDrawer & drawer,
+                 Place const & place, string const & filename)
 {
   software_renderer::FrameImage frame;
   software_renderer::FrameSymbols sym;
@@ -155,13 +158,110 @@ void RenderPlace(Framework & framework, Place const & place, string const & file
   // It is almost UpperComfortScale but there is some magic involved.
   int constexpr kMagicBaseScale = 17;
 
-  DrawFrame(framework, MercatorBounds::FromLatLon(place.lat, place.lon),
+  DrawFrame(framework, drawer, MercatorBounds::FromLatLon(place.lat, place.lon),
             place.zoom - kMagicBaseScale, place.width, place.height, sym, frame);
 
-  ofstream file(filename.c_str());
+  ofstream file(filename.c_str(), ios::binary);
   file.write(reinterpret_cast<char const *>(frame.m_data.data()), frame.m_data.size());
   file.close();
 }
+
+// Renders places on several threads. Every thread has its own renderer,
+// the index and styles are shared, so features of different places are
+// read in parallel. Places are rendered in any order, but names of files
+// follow the order of places.
+class PlacesRenderer
+{
+public:
+  PlacesRenderer(Framework & framework, float visualScale, size_t threadsCount)
+    : m_framework(framework)
+  {
+    // Renderers are created on the main thread, since they read resources.
+    for (size_t i = 0; i < threadsCount; ++i)
+      m_drawers.push_back(CreateFrameRenderer(visualScale));
+    for (size_t i = 0; i < threadsCount; ++i)
+      m_threads.emplace_back(&PlacesRenderer::Routine, this, ref(*m_drawers[i]));
+  }
+
+  ~PlacesRenderer() { Finish(); }
+
+  // Waits until all places are rendered.
+  bool Finish()
+  {
+    {
+      lock_guard<mutex> lock(m_mutex);
+      m_isFinished = true;
+    }
+    m_queueCondition.notify_all();
+    for (auto & t : m_threads)
+      t.join();
+    m_threads.clear();
+    return !m_hasErrors;
+  }
+
+  void Push(string const & placeStr, Place const & place, string const & filename)
+  {
+    unique_lock<mutex> lock(m_mutex);
+    // Places are read while the previous ones are rendered, but not much ahead.
+    m_spaceCondition.wait(lock, [this] { return m_queue.size() < 2 * m_threads.size(); });
+    m_queue.push_back({placeStr, place, filename});
+    lock.unlock();
+    m_queueCondition.notify_one();
+  }
+
+private:
+  struct Task
+  {
+    string m_placeStr;
+    Place m_place;
+    string m_filename;
+  };
+
+  void Routine(software_renderer::CPUDrawer & drawer)
+  {
+    while (true)
+    {
+      Task task;
+      {
+        unique_lock<mutex> lock(m_mutex);
+        m_queueCondition.wait(lock, [this] { return !m_queue.empty() || m_isFinished; });
+        if (m_queue.empty())
+          return;
+        task = move(m_queue.front());
+        m_queue.pop_front();
+      }
+      m_spaceCondition.notify_one();
+
+      try
+      {
+        RenderPlace(m_framework, drawer, task.m_place, task.m_filename);
+      }
+      catch (exception & e)
+      {
+        lock_guard<mutex> lock(m_outputMutex);
+        cerr << "Error in [" << task.m_placeStr << "]: " << e.what() << endl;
+        m_hasErrors = true;
+        continue;
+      }
+
+      lock_guard<mutex> lock(m_outputMutex);
+      cout << "Rendering " << task.m_placeStr << " into " << task.m_filename << " is finished."
+           << endl;
+    }
+  }
+
+  Framework & m_framework;
+  vector<unique_ptr<software_renderer::CPUDrawer>> m_drawers;
+  vector<thread> m_threads;
+
+  deque<Task> m_queue;
+  bool m_isFinished = false;
+  mutex m_mutex;
+  condition_variable m_queueCondition;
+  condition_variable m_spaceCondition;
+  mutex m_outputMutex;
+  bool m_hasErrors = false;
+};
 }  // namespace
 
 int main(int argc, char * argv[])
@@ -186,20 +286,23 @@ int main(int argc, char * argv[])
   {
     Framework f(FrameworkParams(false /* m_enableLocalAds */, false /* m_enableDiffs */));
 
-    auto processPlace = [&](string const & place)
-    {
-      Place p = ParsePlace(place);
-      p.width = FLAGS_width;
-      p.height = FLAGS_height;
-      string const & filename = FilenameSeq(FLAGS_outpath);
-      RenderPlace(f, p, filename);
-      cout << "Rendering " << place << " into " << filename << " is finished." << endl;
-    };
-
     // This magic constant was determined in several attempts.
     // It is a scale level, basically, dpi factor. 1 means 90 or 96, it seems,
     // and with 1.1 the map looks subjectively better.
-    InitFrameRenderer(1.1 /* visualScale */);
+    size_t const threadsCount = static_cast<size_t>(max(FLAGS_threads, 1));
+    PlacesRenderer renderer(f, 1.1 /* visualScale */, threadsCount);
+
+    bool hasErrors = false;
+    auto processPlace = [&](string const & place)
+    {
+      Place p;
+      if (!ParsePlace(place, p))
+      {
+        hasErrors = true;
+        return;
+      }
+      renderer.Push(place, p, FilenameSeq(FLAGS_outpath));
+    };
 
     if (!FLAGS_place.empty())
       processPlace(FLAGS_place);
@@ -207,15 +310,18 @@ int main(int argc, char * argv[])
     if (FLAGS_c)
     {
       for (string line; getline(cin, line);)
-        processPlace(line);
+      {
+        if (!line.empty())
+          processPlace(line);
+      }
     }
 
-    ReleaseFrameRenderer();
-    return 0;
+    if (!renderer.Finish())
+      hasErrors = true;
+    return hasErrors ? 1 : 0;
   }
   catch (exception & e)
   {
-    ReleaseFrameRenderer();
     cerr << e.what() << endl;
   }
   return 1;
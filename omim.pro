@@ -111,6 +111,10 @@ SUBDIRS = 3party base coding geometry editor ugc indexer routing routing_common
     feature_list.depends = $$SUBDIRS
     SUBDIRS *= feature_list
 
+    feature_export.subdir = feature_export
+    feature_export.depends = $$SUBDIRS
+    SUBDIRS *= feature_export
+
     search_quality_tool.subdir = search/search_quality/search_quality_tool
     search_quality_tool.depends = $$SUBDIRS
 
@@ -164,6 +168,10 @@ SUBDIRS = 3party base coding geometry editor ugc indexer routing routing_common
 #    downloader_tests.depends = 3party base coding platform platform_tests_support
 #    SUBDIRS *= downloader_tests
 
+    benchmarks.subdir = benchmarks
+    benchmarks.depends = 3party base coding geometry editor platform indexer
+    SUBDIRS *= benchmarks
+
     search_tests.subdir = search/search_tests
     search_tests.depends = 3party base coding geometry platform indexer search
     SUBDIRS *= search_tests
@@ -212,6 +220,10 @@ SUBDIRS = 3party base coding geometry editor ugc indexer routing routing_common
     routing_consistency_tests.depends = $$MapDepLibs routing generator
     SUBDIRS *= routing_consistency_tests
 
+    routing_replay_benchmark.subdir = routing/routing_replay_benchmark
+    routing_replay_benchmark.depends = $$MapDepLibs routing
+    SUBDIRS *= routing_replay_benchmark
+
     srtm_coverage_checker.subdir = generator/srtm_coverage_checker
     srtm_coverage_checker.depends = $$MapDepLibs routing
     SUBDIRS *= srtm_coverage_checker
@@ -0,0 +1,156 @@
+#include "openlr/cached_road_graph.hpp"
+
+#include "indexer/feature.hpp"
+#include "indexer/index.hpp"
+
+#include "coding/point_to_integer.hpp"
+
+#include "base/assert.hpp"
+#include "base/bits.hpp"
+#include "base/logging.hpp"
+
+#include <algorithm>
+
+using namespace routing;
+using namespace std;
+
+namespace openlr
+{
+// RoadGeometryCache::MwmRoads ---------------------------------------------------------------------
+void RoadGeometryCache::MwmRoads::AddRoad(uint32_t featureIndex, IRoadGraph::RoadInfo const & info)
+{
+  Road road;
+  road.m_featureIndex = featureIndex;
+  road.m_firstJunction = static_cast<uint32_t>(m_junctions.size());
+  road.m_junctionsCount = static_cast<uint32_t>(info.m_junctions.size());
+  road.m_speedKMPH = info.m_speedKMPH;
+  road.m_bidirectional = info.m_bidirectional;
+
+  auto const roadIndex = static_cast<uint32_t>(m_roads.size());
+  m_roads.push_back(road);
+  for (auto const & junction : info.m_junctions)
+  {
+    m_junctions.push_back(junction);
+    m_points.emplace_back(GetPointKey(junction.GetPoint()), roadIndex);
+  }
+}
+
+void RoadGeometryCache::MwmRoads::Build()
+{
+  sort(m_points.begin(), m_points.end());
+  // A road passing a point several times is reported once, edges loaders process all
+  // occurrences of the point in the road.
+  m_points.erase(unique(m_points.begin(), m_points.end()), m_points.end());
+  m_points.shrink_to_fit();
+  m_junctions.shrink_to_fit();
+  m_roads.shrink_to_fit();
+}
+
+// static
+uint64_t RoadGeometryCache::MwmRoads::GetPointKey(m2::PointD const & pt)
+{
+  m2::PointU const p = PointD2PointU(pt, POINT_COORD_BITS);
+  return bits::BitwiseMerge(p.x, p.y);
+}
+
+IRoadGraph::RoadInfo RoadGeometryCache::MwmRoads::GetRoadInfo(uint32_t roadIndex) const
+{
+  ASSERT_LESS(roadIndex, m_roads.size(), ());
+  Road const & road = m_roads[roadIndex];
+
+  IRoadGraph::RoadInfo info;
+  info.m_speedKMPH = road.m_speedKMPH;
+  info.m_bidirectional = road.m_bidirectional;
+  auto const begin = m_junctions.cbegin() + road.m_firstJunction;
+  info.m_junctions.assign(begin, begin + road.m_junctionsCount);
+  return info;
+}
+
+// RoadGeometryCache -------------------------------------------------------------------------------
+RoadGeometryCache::MwmRoads const & RoadGeometryCache::GetMwmRoads(string const & mwmName,
+                                                                   LoadMwmRoadsFn const & loadFn)
+{
+  Entry * entry = nullptr;
+  {
+    lock_guard<mutex> lock(m_mutex);
+    auto & e = m_mwms[mwmName];
+    if (!e)
+      e.reset(new Entry());
+    entry = e.get();
+  }
+
+  // Other threads wait until the mwm is loaded, entries are never removed.
+  call_once(entry->m_loaded, [&]()
+  {
+    loadFn(entry->m_roads);
+    entry->m_roads.Build();
+  });
+  return entry->m_roads;
+}
+
+// CachedRoadGraph ---------------------------------------------------------------------------------
+CachedRoadGraph::CachedRoadGraph(Index const & index, IRoadGraph::Mode mode,
+                                 shared_ptr<VehicleModelFactoryInterface> vehicleModelFactory,
+                                 RoadGeometryCache & cache)
+  : FeaturesRoadGraph(index, mode, vehicleModelFactory), m_index(index), m_cache(cache)
+{
+  m_index.GetMwmsInfo(m_mwms);
+}
+
+void CachedRoadGraph::ForEachFeatureClosestToCross(m2::PointD const & cross,
+                                                   ICrossEdgesLoader & edgesLoader) const
+{
+  for (auto const & info : m_mwms)
+  {
+    if (info->GetType() != MwmInfo::COUNTRY || !info->m_limitRect.IsPointInside(cross))
+      continue;
+
+    MwmSet::MwmId const mwmId(info);
+    GetMwmRoads(mwmId).ForEachRoadAt(cross, [&](uint32_t featureIndex,
+                                                IRoadGraph::RoadInfo const & roadInfo)
+    {
+      edgesLoader(FeatureID(mwmId, featureIndex), roadInfo);
+    });
+  }
+}
+
+RoadGeometryCache::MwmRoads const & CachedRoadGraph::GetMwmRoads(MwmSet::MwmId const & mwmId) const
+{
+  auto const it = m_mwmRoads.find(mwmId);
+  if (it != m_mwmRoads.cend())
+    return *it->second;
+
+  auto const & roads = m_cache.GetMwmRoads(mwmId.GetInfo()->GetCountryName(),
+                                           [this, &mwmId](RoadGeometryCache::MwmRoads & roads)
+  {
+    LoadMwmRoads(mwmId, roads);
+  });
+  m_mwmRoads[mwmId] = &roads;
+  return roads;
+}
+
+void CachedRoadGraph::LoadMwmRoads(MwmSet::MwmId const & mwmId,
+                                   RoadGeometryCache::MwmRoads & roads) const
+{
+  Index::FeaturesLoaderGuard guard(m_index, mwmId);
+  size_t const numFeatures = guard.GetNumFeatures();
+  for (size_t i = 0; i < numFeatures; ++i)
+  {
+    FeatureType ft;
+    if (!guard.GetOriginalFeatureByIndex(static_cast<uint32_t>(i), ft))
+      continue;
+    if (ft.GetFeatureType() != feature::GEOM_LINE || !IsRoad(ft))
+      continue;
+
+    double const speedKMPH = GetSpeedKMPHFromFt(ft);
+    if (speedKMPH <= 0.0)
+      continue;
+
+    IRoadGraph::RoadInfo info;
+    ExtractRoadInfo(ft.GetID(), ft, speedKMPH, info);
+    roads.AddRoad(static_cast<uint32_t>(i), info);
+  }
+
+  LOG(LINFO, ("Loaded", roads.GetRoadsCount(), "roads of", mwmId));
+}
+}  // namespace openlr
@@ -0,0 +1,112 @@
+#pragma once
+
+#include "routing/features_road_graph.hpp"
+#include "routing/road_graph.hpp"
+
+#include "routing_common/vehicle_model.hpp"
+
+#include "indexer/mwm_set.hpp"
+
+#include "geometry/point2d.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+class Index;
+
+namespace openlr
+{
+// Road geometry of mwms shared by road graphs of all decoding threads. Roads of an mwm are
+// loaded once, and roads passing through a point are found by a binary search over sorted
+// road points.
+//
+// *NOTE* This class is thread-safe.
+class RoadGeometryCache
+{
+public:
+  class MwmRoads
+  {
+  public:
+    // Calls |fn| for every road with a point at |pt|.
+    template <typename Fn>
+    void ForEachRoadAt(m2::PointD const & pt, Fn && fn) const
+    {
+      auto const key = GetPointKey(pt);
+      auto it = std::lower_bound(m_points.cbegin(), m_points.cend(), std::make_pair(key, 0u));
+      for (; it != m_points.cend() && it->first == key; ++it)
+        fn(m_roads[it->second].m_featureIndex, GetRoadInfo(it->second));
+    }
+
+    void AddRoad(uint32_t featureIndex, routing::IRoadGraph::RoadInfo const & info);
+    // Prepares the index of road points, must be called after all roads are added.
+    void Build();
+
+    size_t GetRoadsCount() const { return m_roads.size(); }
+
+  private:
+    struct Road
+    {
+      uint32_t m_featureIndex = 0;
+      uint32_t m_firstJunction = 0;
+      uint32_t m_junctionsCount = 0;
+      double m_speedKMPH = 0.0;
+      bool m_bidirectional = false;
+    };
+
+    static uint64_t GetPointKey(m2::PointD const & pt);
+
+    routing::IRoadGraph::RoadInfo GetRoadInfo(uint32_t roadIndex) const;
+
+    std::vector<Road> m_roads;
+    std::vector<routing::Junction> m_junctions;
+    // Sorted pairs of keys of road points and indices of roads.
+    std::vector<std::pair<uint64_t, uint32_t>> m_points;
+  };
+
+  using LoadMwmRoadsFn = std::function<void(MwmRoads & roads)>;
+
+  // Returns roads of the mwm, they're loaded by |loadFn| on the first call for the mwm.
+  MwmRoads const & GetMwmRoads(std::string const & mwmName, LoadMwmRoadsFn const & loadFn);
+
+private:
+  struct Entry
+  {
+    std::once_flag m_loaded;
+    MwmRoads m_roads;
+  };
+
+  std::mutex m_mutex;
+  std::map<std::string, std::unique_ptr<Entry>> m_mwms;
+};
+
+// Road graph which finds edges around junctions by roads preloaded to RoadGeometryCache
+// instead of reading and parsing features around every junction.
+class CachedRoadGraph : public routing::FeaturesRoadGraph
+{
+public:
+  CachedRoadGraph(Index const & index, IRoadGraph::Mode mode,
+                  std::shared_ptr<routing::VehicleModelFactoryInterface> vehicleModelFactory,
+                  RoadGeometryCache & cache);
+
+  // IRoadGraph overrides:
+  void ForEachFeatureClosestToCross(m2::PointD const & cross,
+                                    ICrossEdgesLoader & edgesLoader) const override;
+
+private:
+  RoadGeometryCache::MwmRoads const & GetMwmRoads(MwmSet::MwmId const & mwmId) const;
+  void LoadMwmRoads(MwmSet::MwmId const & mwmId, RoadGeometryCache::MwmRoads & roads) const;
+
+  Index const & m_index;
+  RoadGeometryCache & m_cache;
+
+  mutable std::vector<std::shared_ptr<MwmInfo>> m_mwms;
+  mutable std::map<MwmSet::MwmId, RoadGeometryCache::MwmRoads const *> m_mwmRoads;
+};
+}  // namespace openlr
@@ -8,6 +8,7 @@ ROOT_DIR = ..
 include($$ROOT_DIR/common.pri)
 
 SOURCES += \
+  cached_road_graph.cpp \
   decoded_path.cpp \
   openlr_model.cpp \
   openlr_model_xml.cpp \
@@ -17,6 +18,7 @@ SOURCES += \
   router.cpp \
 
 HEADERS += \
+  cached_road_graph.hpp \
   decoded_path.hpp \
   openlr_model.hpp \
   openlr_model_xml.hpp \
@@ -1,5 +1,6 @@
 #include "openlr/openlr_simple_decoder.hpp"
 
+#include "openlr/cached_road_graph.hpp"
 #include "openlr/decoded_path.hpp"
 #include "openlr/openlr_model.hpp"
 #include "openlr/road_info_getter.hpp"
@@ -14,12 +15,18 @@
 #include "indexer/classificator.hpp"
 #include "indexer/index.hpp"
 
+#include "coding/point_to_integer.hpp"
+
+#include "geometry/mercator.hpp"
 #include "geometry/polyline2d.hpp"
 
+#include "base/bits.hpp"
 #include "base/logging.hpp"
-#include "base/math.hpp"
 
+#include "std/algorithm.hpp"
+#include "std/atomic.hpp"
 #include "std/fstream.hpp"
+#include "std/numeric.hpp"
 #include "std/thread.hpp"
 
 using namespace routing;
@@ -49,6 +56,18 @@ struct alignas(kCacheLineSize) Stats
   uint32_t m_tightOffsets = 0;
   uint32_t m_total = 0;
 };
+
+// Returns a key of the segment start in Z-order, so close segments have close keys.
+uint64_t GetLocalityKey(LinearSegment const & segment)
+{
+  auto const & points = segment.m_locationReference.m_points;
+  if (points.empty())
+    return 0;
+
+  m2::PointU const pt =
+      PointD2PointU(MercatorBounds::FromLatLon(points.front().m_latLon), POINT_COORD_BITS);
+  return bits::BitwiseMerge(pt.x, pt.y);
+}
 }  // namespace
 
 // OpenLRSimpleDecoder::SegmentsFilter -------------------------------------------------------------
@@ -88,29 +107,55 @@ void OpenLRSimpleDecoder::Decode(std::vector<LinearSegment> const & segments,
 {
   double const kOffsetToleranceM = 10;
 
-  // This code computes the most optimal (in the sense of cache lines
-  // occupancy) batch size.
-  size_t constexpr a = my::LCM(sizeof(LinearSegment), kCacheLineSize) / sizeof(LinearSegment);
-  size_t constexpr b =
-      my::LCM(sizeof(IRoadGraph::TEdgeVector), kCacheLineSize) / sizeof(IRoadGraph::TEdgeVector);
-  size_t constexpr kBatchSize = my::LCM(a, b);
+  // Number of spatially close segments a thread takes at once.
+  size_t constexpr kBatchSize = 64;
   size_t constexpr kProgressFrequency = 100;
 
-  auto worker = [&segments, &paths, kBatchSize, kProgressFrequency, kOffsetToleranceM, numThreads,
-                 this](size_t threadNum, Index const & index, Stats & stats) {
-    FeaturesRoadGraph roadGraph(index, IRoadGraph::Mode::ObeyOnewayTag,
-                                make_unique<CarModelFactory>(m_countryParentNameGetterFn));
-    RoadInfoGetter roadInfoGetter(index);
-    Router router(roadGraph, roadInfoGetter);
+  size_t const numSegments = segments.size();
+
+  // Segments are decoded in the order of their locality keys, and threads take batches of
+  // segments dynamically. So every thread mostly reads features of its own area and road graph
+  // caches of the threads don't duplicate each other.
+  vector<uint64_t> keys(numSegments);
+  for (size_t i = 0; i < numSegments; ++i)
+    keys[i] = GetLocalityKey(segments[i]);
+  vector<size_t> order(numSegments);
+  iota(order.begin(), order.end(), 0);
+  sort(order.begin(), order.end(), [&keys](size_t lhs, size_t rhs)
+  {
+    return keys[lhs] < keys[rhs];
+  });
 
-    size_t const numSegments = segments.size();
+  atomic<size_t> nextBatch(0);
+  RoadInfoGetter::SharedCache roadInfoCache;
+  RoadGeometryCache roadGeometryCache;
+
+  auto worker = [&segments, &paths, &order, &nextBatch, &roadInfoCache, &roadGeometryCache,
+                 numSegments, kBatchSize, kProgressFrequency, kOffsetToleranceM,
+                 this](size_t threadNum, Index const & index, Stats & stats) {
+    auto carModelFactory = make_shared<CarModelFactory>(m_countryParentNameGetterFn);
+    unique_ptr<FeaturesRoadGraph> roadGraph;
+    if (m_preloadRoads)
+    {
+      roadGraph.reset(new CachedRoadGraph(index, IRoadGraph::Mode::ObeyOnewayTag, carModelFactory,
+                                          roadGeometryCache));
+    }
+    else
+    {
+      roadGraph.reset(
+          new FeaturesRoadGraph(index, IRoadGraph::Mode::ObeyOnewayTag, carModelFactory));
+    }
+    RoadInfoGetter roadInfoGetter(index, roadInfoCache);
+    Router router(*roadGraph, roadInfoGetter);
 
     vector<WayPoint> points;
 
-    for (size_t i = threadNum * kBatchSize; i < numSegments; i += numThreads * kBatchSize)
+    for (size_t i = nextBatch.fetch_add(kBatchSize); i < numSegments;
+         i = nextBatch.fetch_add(kBatchSize))
     {
-      for (size_t j = i; j < numSegments && j < i + kBatchSize; ++j)
+      for (size_t k = i; k < numSegments && k < i + kBatchSize; ++k)
       {
+        size_t const j = order[k];
         auto const & segment = segments[j];
         auto const & ref = segment.m_locationReference;
 
@@ -41,11 +41,17 @@ public:
                       CountryParentNameGetterFn const & countryParentNameGetterFn);
 
   // Maps partner segments to mwm paths. |segments| should be sorted by partner id.
+  // Threads decode spatially close segments together and share the cache of road infos.
   void Decode(std::vector<LinearSegment> const & segments, uint32_t const numThreads,
               std::vector<DecodedPath> & paths);
 
+  // When it's set, roads of mwms are loaded into memory once and shared by all threads, so
+  // junctions are expanded without reading features. It pays off on big batches of segments.
+  void SetPreloadRoads(bool preloadRoads) { m_preloadRoads = preloadRoads; }
+
 private:
   std::vector<Index> const & m_indexes;
   CountryParentNameGetterFn m_countryParentNameGetterFn;
+  bool m_preloadRoads = false;
 };
 }  // namespace openlr
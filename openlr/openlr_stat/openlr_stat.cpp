@@ -43,6 +43,8 @@ DEFINE_string(resources_path, "", "Path to a folder with resources.");
 DEFINE_int32(limit, -1, "Max number of segments to handle. -1 for all.");
 DEFINE_bool(multipoints_only, false, "Only segments with multiple points to handle.");
 DEFINE_int32(num_threads, 1, "Number of threads.");
+DEFINE_bool(preload_roads, false,
+            "Load roads of mwms into memory once. It's faster for big numbers of segments.");
 DEFINE_string(ids_path, "", "Path to a file with segment ids to process.");
 DEFINE_string(countries_filename, "",
               "Name of countries file which describes mwm tree. Used to get country specific "
@@ -227,6 +229,7 @@ int main(int argc, char * argv[])
 
   OpenLRSimpleDecoder decoder(indexes, storage::CountryParentGetter(FLAGS_countries_filename,
                                                                     GetPlatform().ResourcesDir()));
+  decoder.SetPreloadRoads(FLAGS_preload_roads);
 
   pugi::xml_document document;
   auto const load_result = document.load_file(FLAGS_input.data());
@@ -0,0 +1,66 @@
+#include "testing/testing.hpp"
+
+#include "openlr/cached_road_graph.hpp"
+
+#include "routing/road_graph.hpp"
+
+#include <cstdint>
+#include <set>
+#include <utility>
+
+using namespace openlr;
+using namespace routing;
+
+namespace
+{
+UNIT_TEST(RoadGeometryCache_MwmRoads)
+{
+  RoadGeometryCache::MwmRoads roads;
+  roads.AddRoad(10 /* featureIndex */,
+                IRoadGraph::RoadInfo(true /* bidirectional */, 60.0 /* speedKMPH */,
+                                     {MakeJunctionForTesting({0.0, 0.0}),
+                                      MakeJunctionForTesting({1.0, 0.0}),
+                                      MakeJunctionForTesting({2.0, 0.0})}));
+  roads.AddRoad(20 /* featureIndex */,
+                IRoadGraph::RoadInfo(false /* bidirectional */, 30.0 /* speedKMPH */,
+                                     {MakeJunctionForTesting({1.0, 1.0}),
+                                      MakeJunctionForTesting({1.0, 0.0}),
+                                      MakeJunctionForTesting({1.0, -1.0}),
+                                      MakeJunctionForTesting({1.0, 1.0})}));
+  roads.Build();
+  TEST_EQUAL(roads.GetRoadsCount(), 2, ());
+
+  std::set<uint32_t> found;
+  roads.ForEachRoadAt({1.0, 0.0}, [&](uint32_t featureIndex, IRoadGraph::RoadInfo const & info)
+  {
+    TEST(found.insert(featureIndex).second, (featureIndex));
+    if (featureIndex == 10)
+    {
+      TEST(info.m_bidirectional, ());
+      TEST_EQUAL(info.m_speedKMPH, 60.0, ());
+      TEST_EQUAL(info.m_junctions.size(), 3, ());
+    }
+    else
+    {
+      TEST(!info.m_bidirectional, ());
+      TEST_EQUAL(info.m_junctions.size(), 4, ());
+      TEST_EQUAL(info.m_junctions[2].GetPoint(), m2::PointD(1.0, -1.0), ());
+    }
+  });
+  TEST_EQUAL(found, std::set<uint32_t>({10, 20}), ());
+
+  // The loop road is reported once for its repeated point.
+  size_t count = 0;
+  roads.ForEachRoadAt({1.0, 1.0}, [&](uint32_t featureIndex, IRoadGraph::RoadInfo const &)
+  {
+    TEST_EQUAL(featureIndex, 20, ());
+    ++count;
+  });
+  TEST_EQUAL(count, 1, ());
+
+  roads.ForEachRoadAt({0.5, 0.0}, [](uint32_t featureIndex, IRoadGraph::RoadInfo const &)
+  {
+    TEST(false, ("A road without a point", featureIndex));
+  });
+}
+}  // namespace
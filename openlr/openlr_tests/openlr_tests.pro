@@ -41,4 +41,5 @@ HEADERS += \
 
 SOURCES += \
     $$ROOT_DIR/testing/testingmain.cpp \
+    cached_road_graph_test.cpp \
     decoded_path_test.cpp \
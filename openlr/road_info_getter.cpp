@@ -10,14 +10,63 @@
 
 namespace openlr
 {
+// RoadInfoGetter::SharedCache --------------------------------------------------------------------
+bool RoadInfoGetter::SharedCache::Find(string const & mwmName, uint32_t featureIndex,
+                                       RoadInfo & info) const
+{
+  lock_guard<mutex> lock(m_mutex);
+  auto const mwmIt = m_cache.find(mwmName);
+  if (mwmIt == m_cache.cend())
+    return false;
+
+  auto const it = mwmIt->second.find(featureIndex);
+  if (it == mwmIt->second.cend())
+    return false;
+
+  info = it->second;
+  return true;
+}
+
+void RoadInfoGetter::SharedCache::Insert(string const & mwmName, uint32_t featureIndex,
+                                         RoadInfo const & info)
+{
+  lock_guard<mutex> lock(m_mutex);
+  m_cache[mwmName].emplace(featureIndex, info);
+}
+
+// RoadInfoGetter ----------------------------------------------------------------------------------
 RoadInfoGetter::RoadInfoGetter(Index const & index) : m_index(index), m_c(classif()) {}
 
+RoadInfoGetter::RoadInfoGetter(Index const & index, SharedCache & sharedCache)
+  : m_index(index), m_c(classif()), m_sharedCache(&sharedCache)
+{
+}
+
 RoadInfoGetter::RoadInfo RoadInfoGetter::Get(FeatureID const & fid)
 {
+  if (m_sharedCache)
+  {
+    string const & mwmName = fid.m_mwmId.GetInfo()->GetCountryName();
+    RoadInfo info;
+    if (m_sharedCache->Find(mwmName, fid.m_index, info))
+      return info;
+
+    // Two threads may load the same feature simultaneously, the second insertion is ignored.
+    info = Load(fid);
+    m_sharedCache->Insert(mwmName, fid.m_index, info);
+    return info;
+  }
+
   auto it = m_cache.find(fid);
   if (it != end(m_cache))
     return it->second;
 
+  it = m_cache.emplace(fid, Load(fid)).first;
+  return it->second;
+}
+
+RoadInfoGetter::RoadInfo RoadInfoGetter::Load(FeatureID const & fid) const
+{
   Index::FeaturesLoaderGuard g(m_index, fid.m_mwmId);
   FeatureType ft;
   CHECK(g.GetOriginalFeatureByIndex(fid.m_index, ft), ());
@@ -25,9 +74,7 @@ RoadInfoGetter::RoadInfo RoadInfoGetter::Get(FeatureID const & fid)
   RoadInfo info;
   info.m_frc = GetFunctionalRoadClass(ft);
   info.m_fow = GetFormOfWay(ft);
-  it = m_cache.emplace(fid, info).first;
-
-  return it->second;
+  return info;
 }
 
 FunctionalRoadClass RoadInfoGetter::GetFunctionalRoadClass(feature::TypesHolder const & types) const
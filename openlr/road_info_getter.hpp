@@ -6,6 +6,8 @@
 #include "indexer/feature_data.hpp"
 
 #include "std/map.hpp"
+#include "std/mutex.hpp"
+#include "std/string.hpp"
 
 class Classificator;
 class Index;
@@ -28,13 +30,29 @@ public:
     FormOfWay m_fow = FormOfWay::NotAValue;
   };
 
+  // Thread-safe cache of road infos which is shared by getters of different threads.
+  // Every thread has its own index, so features are identified by mwm names.
+  class SharedCache
+  {
+  public:
+    bool Find(string const & mwmName, uint32_t featureIndex, RoadInfo & info) const;
+    void Insert(string const & mwmName, uint32_t featureIndex, RoadInfo const & info);
+
+  private:
+    mutable mutex m_mutex;
+    map<string, map<uint32_t, RoadInfo>> m_cache;
+  };
+
   RoadInfoGetter(Index const & index);
+  // Road infos are cached in |sharedCache| instead of the own cache of the getter.
+  RoadInfoGetter(Index const & index, SharedCache & sharedCache);
 
   RoadInfo Get(FeatureID const & fid);
 
  private:
   FunctionalRoadClass GetFunctionalRoadClass(feature::TypesHolder const & types) const;
   FormOfWay GetFormOfWay(feature::TypesHolder const & types) const;
+  RoadInfo Load(FeatureID const & fid) const;
 
   Index const & m_index;
   Classificator const & m_c;
@@ -47,5 +65,6 @@ public:
   LivingStreetChecker const m_livingStreetChecker;
 
   map<FeatureID, RoadInfo> m_cache;
+  SharedCache * m_sharedCache = nullptr;
 };
 }  // namespace openlr
@@ -1,6 +1,6 @@
 #include "partners_api/booking_api.hpp"
+#include "partners_api/http_engine.hpp"
 
-#include "platform/http_client.hpp"
 #include "platform/platform.hpp"
 
 #include "coding/url_encode.hpp"
@@ -32,16 +32,25 @@ string const kPhotoSmallUrl = "http://aff.bstatic.com/images/hotel/max300/";
 string const kSearchBaseUrl = "https://www.booking.com/search.html";
 string g_BookingUrlForTesting = "";
 
-bool RunSimpleHttpRequest(bool const needAuth, string const & url, string & result)
+// Descriptions of hotels are changed rarely, so they are cached.
+double constexpr kExtendedInfoCacheSec = 10 * 60;
+
+bool RunSimpleHttpRequest(bool const needAuth, string const & url, string & result,
+                          double cacheSec = 0.0)
 {
-  HttpClient request(url);
+  partners_api::HttpRequest request(url);
 
   if (needAuth)
-    request.SetUserAndPassword(BOOKING_KEY, BOOKING_SECRET);
+  {
+    request.m_user = BOOKING_KEY;
+    request.m_password = BOOKING_SECRET;
+  }
+  request.m_cacheSec = cacheSec;
 
-  if (request.RunHttpRequest() && !request.WasRedirected() && request.ErrorCode() == 200)
+  auto const response = partners_api::HttpEngine::Instance().Get(request);
+  if (response)
   {
-    result = request.ServerResponse();
+    result = response.m_data;
     return true;
   }
   return false;
@@ -266,7 +275,7 @@ bool RawApi::GetExtendedInfo(string const & hotelId, string const & lang, string
 {
   ostringstream os;
   os << kExtendedHotelInfoBaseUrl << "?hotel_id=" << hotelId << "&lang=" << lang;
-  return RunSimpleHttpRequest(false, os.str(), result);
+  return RunSimpleHttpRequest(false, os.str(), result, kExtendedInfoCacheSec);
 }
 
 string Api::GetBookHotelUrl(string const & baseUrl) const
@@ -310,7 +319,7 @@ string Api::GetSearchUrl(string const & city, string const & name) const
 
 void Api::GetMinPrice(string const & hotelId, string const & currency, GetMinPriceCallback const & fn)
 {
-  GetPlatform().RunOnNetworkThread([hotelId, currency, fn]()
+  partners_api::HttpEngine::Instance().RunAsync([hotelId, currency, fn]()
   {
     string minPrice;
     string priceCurrency;
@@ -337,7 +346,7 @@ void Api::GetMinPrice(string const & hotelId, string const & currency, GetMinPri
 
 void Api::GetHotelInfo(string const & hotelId, string const & lang, GetHotelInfoCallback const & fn)
 {
-  GetPlatform().RunOnNetworkThread([hotelId, lang, fn]()
+  partners_api::HttpEngine::Instance().RunAsync([hotelId, lang, fn]()
   {
     HotelInfo info;
     info.m_hotelId = hotelId;
@@ -1,6 +1,5 @@
 #include "partners_api/cian_api.hpp"
-
-#include "platform/platform.hpp"
+#include "partners_api/http_engine.hpp"
 
 #include "geometry/mercator.hpp"
 #include "geometry/rect2d.hpp"
@@ -29,6 +28,8 @@ void AddParameterToUrl(std::string & url, std::string const & parameters)
   
 // Length of the rect side in meters.
 double const kSearchRadius = 500.0;
+// Offers are changed rarely, so they are cached.
+double const kCacheSec = 5 * 60;
 std::string const kUtmComplement = "utm_source=maps.me&utm_medium=cpc&utm_campaign=map";
 
 std::unordered_set<std::string> const kSupportedCities
@@ -123,7 +124,9 @@ http::Result RawApi::GetRentNearby(m2::RectD const & rect,
   url << std::setprecision(6) << baseUrl << "/get-offers-in-bbox/?bbox=" << rect.minX() << ',' << rect.maxY() << '~'
       << rect.maxX() << ',' << rect.minY();
 
-  return http::RunSimpleRequest(url.str());
+  HttpRequest request(url.str());
+  request.m_cacheSec = kCacheSec;
+  return HttpEngine::Instance().Get(request);
 }
 
 Api::Api(std::string const & baseUrl /* = kBaseUrl */) : m_baseUrl(baseUrl) {}
@@ -138,7 +141,7 @@ uint64_t Api::GetRentNearby(ms::LatLon const & latlon, RentNearbyCallback const
   auto const mercatorRect = MercatorBounds::MetresToXY(latlon.lat, latlon.lon, kSearchRadius);
   auto const rect = MercatorBounds::ToLatLonRect(mercatorRect);
 
-  GetPlatform().RunOnNetworkThread([reqId, rect, onSuccess, onError, baseUrl]() {
+  HttpEngine::Instance().RunAsync([reqId, rect, onSuccess, onError, baseUrl]() {
     std::vector<RentPlace> result;
 
     auto const rawResult = RawApi::GetRentNearby(rect, baseUrl);
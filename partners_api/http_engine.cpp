@@ -0,0 +1,173 @@
+#include "partners_api/http_engine.hpp"
+
+#include "platform/http_client.hpp"
+
+#include "base/assert.hpp"
+
+#include <algorithm>
+
+namespace partners_api
+{
+// static
+size_t constexpr HttpEngine::kDefaultThreadsCount;
+// static
+size_t constexpr HttpEngine::kMaxCacheSize;
+
+HttpEngine::HttpEngine(size_t threadsCount, Fetcher const & fetcher) : m_fetcher(fetcher)
+{
+  CHECK_GREATER(threadsCount, 0, ());
+  CHECK(m_fetcher, ());
+
+  for (size_t i = 0; i < threadsCount; ++i)
+    m_workers.emplace_back(&HttpEngine::WorkerRoutine, this);
+}
+
+HttpEngine::~HttpEngine()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_tasksMutex);
+    m_stopping = true;
+  }
+  m_tasksCondition.notify_all();
+  for (auto & worker : m_workers)
+    worker.join();
+}
+
+// static
+HttpEngine & HttpEngine::Instance()
+{
+  static HttpEngine engine;
+  return engine;
+}
+
+http::Result HttpEngine::Get(HttpRequest const & request)
+{
+  auto const key = GetKey(request);
+
+  std::promise<http::Result> promise;
+  std::shared_future<http::Result> inFlight;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto const cached = m_cache.find(key);
+    if (cached != m_cache.end())
+    {
+      if (cached->second.m_expiry > Clock::now())
+        return cached->second.m_result;
+      m_cache.erase(cached);
+    }
+
+    auto const it = m_inFlight.find(key);
+    if (it != m_inFlight.end())
+      inFlight = it->second;
+    else
+      m_inFlight.emplace(key, promise.get_future().share());
+  }
+
+  if (inFlight.valid())
+    return inFlight.get();
+
+  auto const result = m_fetcher(request);
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_inFlight.erase(key);
+    if (result && request.m_cacheSec > 0)
+      AddToCache(key, result, request.m_cacheSec);
+  }
+
+  promise.set_value(result);
+  return result;
+}
+
+void HttpEngine::RunAsync(Task && task)
+{
+  {
+    std::lock_guard<std::mutex> lock(m_tasksMutex);
+    m_tasks.push_back(std::move(task));
+  }
+  m_tasksCondition.notify_one();
+}
+
+void HttpEngine::ClearCache()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_cache.clear();
+}
+
+// static
+http::Result HttpEngine::Fetch(HttpRequest const & request)
+{
+  platform::HttpClient client(request.m_url);
+  for (auto const & header : request.m_headers)
+    client.SetRawHeader(header.first, header.second);
+  if (!request.m_user.empty())
+    client.SetUserAndPassword(request.m_user, request.m_password);
+  client.SetTimeout(request.m_timeoutSec);
+
+  bool const result =
+      client.RunHttpRequest() && !client.WasRedirected() && client.ErrorCode() == 200;
+  return {result, client.ErrorCode(), client.ServerResponse()};
+}
+
+// static
+std::string HttpEngine::GetKey(HttpRequest const & request)
+{
+  // Fields are separated by a character which isn't valid in urls and headers.
+  std::string key = request.m_url;
+  for (auto const & header : request.m_headers)
+    key += '\n' + header.first + ':' + header.second;
+  key += '\n' + request.m_user + ':' + request.m_password;
+  return key;
+}
+
+void HttpEngine::AddToCache(std::string const & key, http::Result const & result,
+                            double cacheSec)
+{
+  auto const now = Clock::now();
+  if (m_cache.size() >= kMaxCacheSize)
+  {
+    for (auto it = m_cache.begin(); it != m_cache.end();)
+    {
+      if (it->second.m_expiry <= now)
+        it = m_cache.erase(it);
+      else
+        ++it;
+    }
+  }
+
+  if (m_cache.size() >= kMaxCacheSize)
+  {
+    auto const oldest = std::min_element(
+        m_cache.begin(), m_cache.end(),
+        [](std::pair<std::string const, CacheEntry> const & lhs,
+           std::pair<std::string const, CacheEntry> const & rhs) {
+          return lhs.second.m_expiry < rhs.second.m_expiry;
+        });
+    m_cache.erase(oldest);
+  }
+
+  auto const expiry =
+      now + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(cacheSec));
+  m_cache.erase(key);
+  m_cache.emplace(key, CacheEntry(result, expiry));
+}
+
+void HttpEngine::WorkerRoutine()
+{
+  while (true)
+  {
+    Task task;
+    {
+      std::unique_lock<std::mutex> lock(m_tasksMutex);
+      m_tasksCondition.wait(lock, [this]() { return m_stopping || !m_tasks.empty(); });
+      if (m_stopping)
+        return;
+
+      task = std::move(m_tasks.front());
+      m_tasks.pop_front();
+    }
+    task();
+  }
+}
+}  // namespace partners_api
@@ -0,0 +1,106 @@
+#pragma once
+
+#include "partners_api/utils.hpp"
+
+#include "base/macros.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace partners_api
+{
+struct HttpRequest
+{
+  explicit HttpRequest(std::string const & url) : m_url(url) {}
+
+  std::string m_url;
+  std::vector<std::pair<std::string, std::string>> m_headers;
+  // HTTP Basic Auth, used when |m_user| isn't empty.
+  std::string m_user;
+  std::string m_password;
+  double m_timeoutSec = 30.0;
+  // Successful results are reused during the time, zero means the
+  // results aren't cached.
+  double m_cacheSec = 0.0;
+};
+
+// Shared engine of GET requests to partners.
+//
+// Requests run by Get() on the calling threads or on the threads of the
+// engine by RunAsync(), so requests of different partners don't wait
+// for each other. Equal requests which are in flight at the same time
+// are sent once, the others wait for the result. Connections are reused
+// by platform::HttpClient of the platforms.
+class HttpEngine
+{
+public:
+  using Fetcher = std::function<http::Result(HttpRequest const & request)>;
+  using Task = std::function<void()>;
+
+  static size_t constexpr kDefaultThreadsCount = 4;
+  static size_t constexpr kMaxCacheSize = 64;
+
+  explicit HttpEngine(size_t threadsCount = kDefaultThreadsCount, Fetcher const & fetcher = &Fetch);
+  ~HttpEngine();
+
+  static HttpEngine & Instance();
+
+  // Runs |request| on the calling thread or waits for the result of the
+  // equal request which is in flight. May be called concurrently.
+  http::Result Get(HttpRequest const & request);
+
+  // Runs |task| on one of the threads of the engine. Tasks which are
+  // pending when the engine is destroyed are skipped.
+  void RunAsync(Task && task);
+
+  void ClearCache();
+
+  // Runs |request| by platform::HttpClient.
+  static http::Result Fetch(HttpRequest const & request);
+
+private:
+  using Clock = std::chrono::steady_clock;
+
+  struct CacheEntry
+  {
+    CacheEntry(http::Result const & result, Clock::time_point expiry)
+      : m_result(result), m_expiry(expiry)
+    {
+    }
+
+    http::Result m_result;
+    Clock::time_point m_expiry;
+  };
+
+  static std::string GetKey(HttpRequest const & request);
+
+  // Should be called under |m_mutex|.
+  void AddToCache(std::string const & key, http::Result const & result, double cacheSec);
+
+  void WorkerRoutine();
+
+  Fetcher m_fetcher;
+
+  std::mutex m_mutex;
+  std::map<std::string, std::shared_future<http::Result>> m_inFlight;
+  std::map<std::string, CacheEntry> m_cache;
+
+  std::mutex m_tasksMutex;
+  std::condition_variable m_tasksCondition;
+  std::deque<Task> m_tasks;
+  bool m_stopping = false;
+  std::vector<std::thread> m_workers;
+
+  DISALLOW_COPY_AND_MOVE(HttpEngine);
+};
+}  // namespace partners_api
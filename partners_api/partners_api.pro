@@ -15,6 +15,7 @@ SOURCES += \
     cian_api.cpp \
     facebook_ads.cpp \
     google_ads.cpp \
+    http_engine.cpp \
     locals_api.cpp \
     mopub_ads.cpp \
     opentable_api.cpp \
@@ -34,6 +35,7 @@ HEADERS += \
     cian_api.hpp \
     facebook_ads.hpp \
     google_ads.hpp \
+    http_engine.hpp \
     locals_api.hpp \
     mopub_ads.hpp \
     opentable_api.hpp \
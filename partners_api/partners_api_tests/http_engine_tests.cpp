@@ -0,0 +1,120 @@
+#include "testing/testing.hpp"
+
+#include "partners_api/http_engine.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace partners_api;
+using namespace std;
+
+namespace
+{
+// Fetcher which counts requests and may hold them until it's released.
+class TestFetcher
+{
+public:
+  http::Result operator()(HttpRequest const & request)
+  {
+    ++m_count;
+    unique_lock<mutex> lock(m_mutex);
+    ++m_started;
+    m_cv.notify_all();
+    m_cv.wait(lock, [this]() { return m_released; });
+    if (request.m_url == "fail")
+      return {false, 404, {}};
+    return {true, 200, request.m_url + to_string(m_count)};
+  }
+
+  void WaitStarted(int started)
+  {
+    unique_lock<mutex> lock(m_mutex);
+    m_cv.wait(lock, [&]() { return m_started >= started; });
+  }
+
+  void Release(bool released)
+  {
+    lock_guard<mutex> lock(m_mutex);
+    m_released = released;
+    m_cv.notify_all();
+  }
+
+  atomic<int> m_count{0};
+
+private:
+  mutex m_mutex;
+  condition_variable m_cv;
+  int m_started = 0;
+  bool m_released = true;
+};
+
+UNIT_TEST(HttpEngine_Coalescing)
+{
+  TestFetcher fetcher;
+  fetcher.Release(false);
+  HttpEngine engine(2 /* threadsCount */, [&fetcher](HttpRequest const & r) { return fetcher(r); });
+
+  mutex resultsMutex;
+  condition_variable resultsCv;
+  vector<string> results;
+  auto const get = [&]() {
+    auto const result = engine.Get(HttpRequest("url"));
+    TEST(result, ());
+    lock_guard<mutex> lock(resultsMutex);
+    results.push_back(result.m_data);
+    resultsCv.notify_all();
+  };
+
+  engine.RunAsync(get);
+  fetcher.WaitStarted(1);
+  // The second request waits for the result of the first one.
+  engine.RunAsync(get);
+  this_thread::sleep_for(chrono::milliseconds(100));
+
+  fetcher.Release(true);
+  {
+    unique_lock<mutex> lock(resultsMutex);
+    resultsCv.wait(lock, [&]() { return results.size() == 2; });
+  }
+  TEST_EQUAL(results[0], results[1], ());
+  TEST_EQUAL(fetcher.m_count, 1, ());
+
+  // The request isn't in flight anymore and isn't cached.
+  TEST(engine.Get(HttpRequest("url")), ());
+  TEST_EQUAL(fetcher.m_count, 2, ());
+}
+
+UNIT_TEST(HttpEngine_Cache)
+{
+  TestFetcher fetcher;
+  HttpEngine engine(1 /* threadsCount */, [&fetcher](HttpRequest const & r) { return fetcher(r); });
+
+  HttpRequest request("url");
+  request.m_cacheSec = 60;
+  auto const first = engine.Get(request);
+  auto const second = engine.Get(request);
+  TEST_EQUAL(fetcher.m_count, 1, ());
+  TEST_EQUAL(first.m_data, second.m_data, ());
+
+  // Other headers make other requests.
+  request.m_headers = {{"Accept", "application/json"}};
+  engine.Get(request);
+  TEST_EQUAL(fetcher.m_count, 2, ());
+
+  // Errors aren't cached.
+  HttpRequest fail("fail");
+  fail.m_cacheSec = 60;
+  TEST(!engine.Get(fail), ());
+  TEST(!engine.Get(fail), ());
+  TEST_EQUAL(fetcher.m_count, 4, ());
+
+  engine.ClearCache();
+  engine.Get(HttpRequest("url"));
+  TEST_EQUAL(fetcher.m_count, 5, ());
+}
+}  // namespace
@@ -31,6 +31,7 @@ SOURCES += \
     cian_tests.cpp \
     facebook_tests.cpp \
     google_tests.cpp \
+    http_engine_tests.cpp \
     mopub_tests.cpp \
     rb_tests.cpp \
     taxi_engine_tests.cpp \
@@ -14,6 +14,10 @@ class LatLon;
 
 namespace taxi
 {
+/// Requests to all providers run in parallel and every request is limited by the timeout,
+/// so the products of all providers are got by the timeout at last.
+double constexpr kRequestTimeoutSec = 10.0;
+
 /// @products - vector of available products for requested route, cannot be empty.
 /// @requestId - identificator which was provided to GetAvailableProducts to identify request.
 using ProductsCallback = std::function<void(std::vector<Product> const & products)>;
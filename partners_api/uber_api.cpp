@@ -1,8 +1,7 @@
 #include "partners_api/uber_api.hpp"
+#include "partners_api/http_engine.hpp"
 #include "partners_api/utils.hpp"
 
-#include "platform/platform.hpp"
-
 #include "geometry/latlon.hpp"
 
 #include "base/logging.hpp"
@@ -21,10 +20,13 @@ namespace
 {
 bool RunSimpleHttpRequest(std::string const & url, std::string & result)
 {
-  platform::HttpClient request(url);
-  if (request.RunHttpRequest() && !request.WasRedirected() && request.ErrorCode() == 200)
+  partners_api::HttpRequest request(url);
+  request.m_timeoutSec = taxi::kRequestTimeoutSec;
+
+  auto const response = partners_api::HttpEngine::Instance().Get(request);
+  if (response)
   {
-    result = request.ServerResponse();
+    result = response.m_data;
     return true;
   }
   return false;
@@ -252,7 +254,9 @@ void Api::GetAvailableProducts(ms::LatLon const & from, ms::LatLon const & to,
 
   maker->Reset(reqId);
 
-  GetPlatform().RunOnNetworkThread([maker, from, reqId, baseUrl, successFn, errorFn]()
+  auto & engine = partners_api::HttpEngine::Instance();
+  // Times and prices are requested in parallel.
+  engine.RunAsync([maker, from, reqId, baseUrl, successFn, errorFn]()
   {
     string result;
     if (!RawApi::GetEstimatedTime(from, result, baseUrl))
@@ -262,7 +266,7 @@ void Api::GetAvailableProducts(ms::LatLon const & from, ms::LatLon const & to,
     maker->MakeProducts(reqId, successFn, errorFn);
   });
 
-  GetPlatform().RunOnNetworkThread([maker, from, to, reqId, baseUrl, successFn, errorFn]()
+  engine.RunAsync([maker, from, to, reqId, baseUrl, successFn, errorFn]()
   {
     string result;
     if (!RawApi::GetEstimatedPrice(from, to, result, baseUrl))
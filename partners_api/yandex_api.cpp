@@ -1,7 +1,5 @@
 #include "partners_api/yandex_api.hpp"
-
-#include "platform/http_client.hpp"
-#include "platform/platform.hpp"
+#include "partners_api/http_engine.hpp"
 
 #include "geometry/latlon.hpp"
 
@@ -22,12 +20,14 @@ namespace
 {
 bool RunSimpleHttpRequest(std::string const & url, std::string & result)
 {
-  platform::HttpClient request(url);
-  request.SetRawHeader("Accept", "application/json");
-  request.SetRawHeader("YaTaxi-Api-Key", YANDEX_API_KEY);
-  if (request.RunHttpRequest() && !request.WasRedirected() && request.ErrorCode() == 200)
+  partners_api::HttpRequest request(url);
+  request.m_headers = {{"Accept", "application/json"}, {"YaTaxi-Api-Key", YANDEX_API_KEY}};
+  request.m_timeoutSec = taxi::kRequestTimeoutSec;
+
+  auto const response = partners_api::HttpEngine::Instance().Get(request);
+  if (response)
   {
-    result = request.ServerResponse();
+    result = response.m_data;
     return true;
   }
 
@@ -85,7 +85,7 @@ void Api::GetAvailableProducts(ms::LatLon const & from, ms::LatLon const & to,
 
   auto const baseUrl = m_baseUrl;
 
-  GetPlatform().RunOnNetworkThread([from, to, baseUrl, successFn, errorFn]()
+  partners_api::HttpEngine::Instance().RunAsync([from, to, baseUrl, successFn, errorFn]()
   {
     std::string result;
     if (!RawApi::GetTaxiInfo(from, to, result, baseUrl))
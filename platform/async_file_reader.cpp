@@ -0,0 +1,188 @@
+#include "platform/async_file_reader.hpp"
+
+#include "coding/internal/file_data.hpp"
+
+#include "base/assert.hpp"
+#include "base/exception.hpp"
+#include "base/logging.hpp"
+
+#include "std/algorithm.hpp"
+#include "std/atomic.hpp"
+#include "std/unique_ptr.hpp"
+
+namespace platform
+{
+struct AsyncFileReader::Batch
+{
+  Batch(string const & filePath, vector<Request> const & requests, TOnRead const & onRead)
+    : m_filePath(filePath), m_requests(requests), m_onRead(onRead), m_next(0)
+  {
+  }
+
+  // Takes the next request which is not read yet.
+  bool Take(size_t & index)
+  {
+    index = m_next++;
+    return index < m_requests.size();
+  }
+
+  void Finish(size_t index, bool success)
+  {
+    if (m_onRead)
+      m_onRead(index, success);
+
+    lock_guard<mutex> lock(m_mutex);
+    ++m_finished;
+    if (!success)
+      m_failed = true;
+    if (m_finished == m_requests.size())
+      m_cv.notify_all();
+  }
+
+  bool IsTaken() const { return m_next >= m_requests.size(); }
+
+  string const m_filePath;
+  vector<Request> const m_requests;
+  TOnRead const m_onRead;
+  atomic<size_t> m_next;
+
+  mutable mutex m_mutex;
+  mutable condition_variable m_cv;
+  size_t m_finished = 0;
+  bool m_failed = false;
+};
+
+// AsyncFileReader::Handle -------------------------------------------------------------------------
+bool AsyncFileReader::Handle::Wait() const
+{
+  if (!m_batch)
+    return true;
+
+  unique_lock<mutex> lock(m_batch->m_mutex);
+  m_batch->m_cv.wait(lock, [this]() { return m_batch->m_finished == m_batch->m_requests.size(); });
+  return !m_batch->m_failed;
+}
+
+bool AsyncFileReader::Handle::IsFinished() const
+{
+  if (!m_batch)
+    return true;
+
+  lock_guard<mutex> lock(m_batch->m_mutex);
+  return m_batch->m_finished == m_batch->m_requests.size();
+}
+
+// AsyncFileReader ---------------------------------------------------------------------------------
+AsyncFileReader::AsyncFileReader(size_t threadsCount)
+{
+  threadsCount = max(threadsCount, static_cast<size_t>(1));
+  for (size_t i = 0; i < threadsCount; ++i)
+    m_workers.emplace_back(&AsyncFileReader::Worker, this);
+}
+
+AsyncFileReader::~AsyncFileReader()
+{
+  {
+    lock_guard<mutex> lock(m_mutex);
+    m_shutdown = true;
+  }
+  m_cv.notify_all();
+
+  for (auto & worker : m_workers)
+    worker.join();
+
+  for (auto const & batch : m_batches)
+    CancelBatch(*batch);
+}
+
+AsyncFileReader::Handle AsyncFileReader::Read(string const & filePath,
+                                              vector<Request> const & requests,
+                                              TOnRead const & onRead)
+{
+  auto batch = make_shared<Batch>(filePath, requests, onRead);
+  if (requests.empty())
+    return Handle(batch);
+
+  {
+    lock_guard<mutex> lock(m_mutex);
+    if (m_shutdown)
+    {
+      CancelBatch(*batch);
+      return Handle(batch);
+    }
+    m_batches.push_back(batch);
+  }
+  // All workers may join the batch.
+  m_cv.notify_all();
+  return Handle(batch);
+}
+
+void AsyncFileReader::Worker()
+{
+  while (true)
+  {
+    shared_ptr<Batch> batch;
+    {
+      unique_lock<mutex> lock(m_mutex);
+      m_cv.wait(lock, [this]() { return m_shutdown || !m_batches.empty(); });
+      if (m_shutdown)
+        return;
+
+      batch = m_batches.front();
+      if (batch->IsTaken())
+      {
+        m_batches.pop_front();
+        continue;
+      }
+    }
+
+    ProcessBatch(*batch);
+
+    lock_guard<mutex> lock(m_mutex);
+    if (!m_batches.empty() && m_batches.front() == batch)
+      m_batches.pop_front();
+  }
+}
+
+// static
+void AsyncFileReader::ProcessBatch(Batch & batch)
+{
+  unique_ptr<my::FileData> file;
+  try
+  {
+    file.reset(new my::FileData(batch.m_filePath, my::FileData::OP_READ));
+  }
+  catch (RootException const & e)
+  {
+    LOG(LWARNING, ("Can't open", batch.m_filePath, e.Msg()));
+    CancelBatch(batch);
+    return;
+  }
+
+  size_t index;
+  while (batch.Take(index))
+  {
+    Request const & request = batch.m_requests[index];
+    bool success = true;
+    try
+    {
+      file->Read(request.m_offset, request.m_buffer, request.m_size);
+    }
+    catch (RootException const & e)
+    {
+      LOG(LWARNING, ("Can't read", request.m_size, "bytes at", request.m_offset, "of",
+                     batch.m_filePath, e.Msg()));
+      success = false;
+    }
+    batch.Finish(index, success);
+  }
+}
+
+// static
+void AsyncFileReader::CancelBatch(Batch & batch)
+{
+  size_t index;
+  while (batch.Take(index))
+    batch.Finish(index, false /* success */);
+}
+}  // namespace platform
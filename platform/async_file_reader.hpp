@@ -0,0 +1,93 @@
+#pragma once
+
+#include "base/macros.hpp"
+
+#include "std/condition_variable.hpp"
+#include "std/cstdint.hpp"
+#include "std/deque.hpp"
+#include "std/function.hpp"
+#include "std/mutex.hpp"
+#include "std/shared_ptr.hpp"
+#include "std/string.hpp"
+#include "std/thread.hpp"
+#include "std/vector.hpp"
+
+namespace platform
+{
+// Reads ranges of regular files in background, so batch consumers may issue many
+// reads at once and decode data which is already read while the rest is being read.
+// Offsets are absolute, e.g. ranges of mwm sections are given by
+// FilesContainerR::GetAbsoluteOffsetAndSize(). Files inside of archives (e.g. the apk)
+// can't be read.
+//
+// Requests of a batch are read in parallel by a pool of threads, every thread reads
+// the file by its own handle.
+//
+// *NOTE* This class is thread-safe.
+class AsyncFileReader
+{
+  struct Batch;
+
+public:
+  struct Request
+  {
+    Request() = default;
+    Request(uint64_t offset, size_t size, void * buffer)
+      : m_offset(offset), m_size(size), m_buffer(buffer)
+    {
+    }
+
+    uint64_t m_offset = 0;
+    size_t m_size = 0;
+    // At least |m_size| bytes which must be alive until the request is finished.
+    void * m_buffer = nullptr;
+  };
+
+  // Called on a worker thread when the request |index| of a batch is finished.
+  using TOnRead = function<void(size_t index, bool success)>;
+
+  class Handle
+  {
+  public:
+    Handle() = default;
+
+    // Waits until all requests of the batch are finished, returns false if any of them
+    // is failed. Returns true for an empty handle.
+    bool Wait() const;
+    bool IsFinished() const;
+
+  private:
+    friend class AsyncFileReader;
+
+    explicit Handle(shared_ptr<Batch> const & batch) : m_batch(batch) {}
+
+    shared_ptr<Batch> m_batch;
+  };
+
+  explicit AsyncFileReader(size_t threadsCount);
+
+  // Requests which are not started yet are finished as failed.
+  ~AsyncFileReader();
+
+  // Enqueues reading of |requests| from the file |filePath|. |onRead| may be empty.
+  Handle Read(string const & filePath, vector<Request> const & requests,
+              TOnRead const & onRead = TOnRead());
+
+private:
+  void Worker();
+
+  // Reads requests of |batch| until all of them are taken by workers.
+  static void ProcessBatch(Batch & batch);
+  static void CancelBatch(Batch & batch);
+
+  mutex m_mutex;
+  condition_variable m_cv;
+  // Batches which have requests not taken by workers yet.
+  deque<shared_ptr<Batch>> m_batches;
+  bool m_shutdown = false;
+
+  vector<thread> m_workers;
+
+  DISALLOW_COPY_AND_MOVE(AsyncFileReader);
+};
+}  // namespace platform
@@ -2,15 +2,40 @@
 
 #include "coding/file_writer.hpp"
 #include "coding/file_reader.hpp"
+#include "coding/internal/file_data.hpp"
+#include "coding/reader.hpp"
 #include "coding/varint.hpp"
+#include "coding/write_to_sink.hpp"
+#include "coding/zlib.hpp"
 
 #include "base/logging.hpp"
 
 #include "std/algorithm.hpp"
+#include "std/unique_ptr.hpp"
 
 
 namespace downloader
 {
+namespace
+{
+// A request for several chunks should take about this time on a fast server.
+double constexpr kTargetRequestSeconds = 5.0;
+size_t constexpr kMaxChunksPerRequest = 8;
+
+// A server which is this times slower than the fastest one is dropped
+// after kMinMeasurements finished requests.
+double constexpr kSlowServerFactor = 4.0;
+size_t constexpr kMinMeasurements = 2;
+
+// Resume files of older versions start with the file size, so a negative number marks
+// resume files with crcs of chunks.
+int64_t constexpr kResumeWithCrcsTag = -1;
+
+uint32_t UpdateCrc(uint32_t crc, void const * data, size_t size)
+{
+  return static_cast<uint32_t>(crc32(crc, static_cast<Bytef const *>(data), static_cast<uInt>(size)));
+}
+}  // namespace
 
 ChunksDownloadStrategy::ChunksDownloadStrategy(vector<string> const & urls)
 {
@@ -26,7 +51,8 @@ ChunksDownloadStrategy::GetChunk(RangeT const & range)
 
   if (i != m_chunks.end() && i->m_pos == range.first)
   {
-    ASSERT_EQUAL ( (i+1)->m_pos, range.second + 1, () );
+    // A range may consist of several consecutive chunks.
+    ASSERT(binary_search(i + 1, m_chunks.end(), range.second + 1, LessChunks()), (range));
     return pair<ChunkT *, int>(&(*i), distance(m_chunks.begin(), i));
   }
   else
@@ -39,9 +65,13 @@ ChunksDownloadStrategy::GetChunk(RangeT const & range)
 void ChunksDownloadStrategy::InitChunks(int64_t fileSize, int64_t chunkSize, ChunkStatusT status)
 {
   m_chunks.reserve(fileSize / chunkSize + 2);
+  m_chunks.clear();
   for (int64_t i = 0; i < fileSize; i += chunkSize)
     m_chunks.push_back(ChunkT(i, status));
   m_chunks.push_back(ChunkT(fileSize, CHUNK_AUX));
+
+  m_crcs.assign(m_chunks.size(), 0);
+  m_crcKnown.assign(m_chunks.size(), false);
 }
 
 void ChunksDownloadStrategy::AddChunk(RangeT const & range, ChunkStatusT status)
@@ -59,6 +89,9 @@ void ChunksDownloadStrategy::AddChunk(RangeT const & range, ChunkStatusT status)
   }
 
   m_chunks.push_back(ChunkT(range.second + 1, CHUNK_AUX));
+
+  m_crcs.resize(m_chunks.size(), 0);
+  m_crcKnown.resize(m_chunks.size(), false);
 }
 
 void ChunksDownloadStrategy::SaveChunks(int64_t fileSize, string const & fName)
@@ -67,10 +100,18 @@ void ChunksDownloadStrategy::SaveChunks(int64_t fileSize, string const & fName)
   {
     try
     {
+      ASSERT_EQUAL(m_crcs.size(), m_chunks.size(), ());
       FileWriter w(fName);
+      WriteVarInt(w, kResumeWithCrcsTag);
       WriteVarInt(w, fileSize);
+      WriteVarUint(w, static_cast<uint64_t>(m_chunks.size()));
 
       w.Write(&m_chunks[0], sizeof(ChunkT) * m_chunks.size());
+      for (size_t i = 0; i < m_crcs.size(); ++i)
+      {
+        WriteToSink(w, m_crcs[i]);
+        WriteToSink(w, static_cast<uint8_t>(m_crcKnown[i] ? 1 : 0));
+      }
       return;
     }
     catch (FileWriter::Exception const & e)
@@ -83,8 +124,8 @@ void ChunksDownloadStrategy::SaveChunks(int64_t fileSize, string const & fName)
   (void)FileWriter::DeleteFileX(fName);
 }
 
-int64_t ChunksDownloadStrategy::LoadOrInitChunks( string const & fName,
-                                                  int64_t fileSize, int64_t chunkSize)
+int64_t ChunksDownloadStrategy::LoadOrInitChunks(string const & fName, int64_t fileSize,
+                                                 int64_t chunkSize, string const & dataFileName)
 {
   ASSERT ( fileSize > 0, () );
   ASSERT ( chunkSize > 0, () );
@@ -94,29 +135,61 @@ int64_t ChunksDownloadStrategy::LoadOrInitChunks( string const & fName,
     FileReader r(fName);
     ReaderSource<FileReader> src(r);
 
-    int64_t const readedSize = ReadVarInt<int64_t>(src);
+    int const stSize = sizeof(ChunkT);
+    int64_t readedSize = ReadVarInt<int64_t>(src);
+    bool const withCrcs = (readedSize == kResumeWithCrcsTag);
+    if (withCrcs)
+      readedSize = ReadVarInt<int64_t>(src);
+
     if (readedSize == fileSize)
     {
       // Load chunks.
-      uint64_t const size = src.Size();
-      int const stSize = sizeof(ChunkT);
-      size_t const count = size / stSize;
-      ASSERT_EQUAL(size, stSize * count, ());
-
-      m_chunks.resize(count);
-      src.Read(&m_chunks[0], stSize * count);
-
-      // Reset status "downloading" to "free".
-      int64_t downloadedSize = 0;
-      for (size_t i = 0; i < count-1; ++i)
+      size_t count = 0;
+      if (withCrcs)
       {
-        if (m_chunks[i].m_status != CHUNK_COMPLETE)
-          m_chunks[i].m_status = CHUNK_FREE;
-        else
-          downloadedSize += (m_chunks[i+1].m_pos - m_chunks[i].m_pos);
+        count = static_cast<size_t>(ReadVarUint<uint64_t>(src));
+      }
+      else
+      {
+        uint64_t const size = src.Size();
+        count = size / stSize;
+        ASSERT_EQUAL(size, stSize * count, ());
       }
 
-      return downloadedSize;
+      if (count > 1 && count * stSize <= src.Size())
+      {
+        m_chunks.resize(count);
+        src.Read(&m_chunks[0], stSize * count);
+
+        m_crcs.assign(count, 0);
+        m_crcKnown.assign(count, false);
+        if (withCrcs)
+        {
+          for (size_t i = 0; i < count; ++i)
+          {
+            m_crcs[i] = ReadPrimitiveFromSource<uint32_t>(src);
+            m_crcKnown[i] = ReadPrimitiveFromSource<uint8_t>(src) != 0;
+          }
+        }
+
+        // Reset status "downloading" to "free".
+        for (size_t i = 0; i < count - 1; ++i)
+        {
+          if (m_chunks[i].m_status != CHUNK_COMPLETE)
+            m_chunks[i].m_status = CHUNK_FREE;
+        }
+
+        if (!dataFileName.empty())
+          VerifyChunks(dataFileName);
+
+        int64_t downloadedSize = 0;
+        for (size_t i = 0; i < count - 1; ++i)
+        {
+          if (m_chunks[i].m_status == CHUNK_COMPLETE)
+            downloadedSize += (m_chunks[i + 1].m_pos - m_chunks[i].m_pos);
+        }
+        return downloadedSize;
+      }
     }
   }
   catch (RootException const & e)
@@ -129,6 +202,76 @@ int64_t ChunksDownloadStrategy::LoadOrInitChunks( string const & fName,
   return 0;
 }
 
+void ChunksDownloadStrategy::VerifyChunks(string const & dataFileName)
+{
+  unique_ptr<my::FileData> file;
+  try
+  {
+    file.reset(new my::FileData(dataFileName, my::FileData::OP_READ));
+  }
+  catch (RootException const & e)
+  {
+    // Downloaded data will be checked by the caller.
+    LOG(LDEBUG, (e.Msg()));
+    return;
+  }
+
+  size_t brokenCount = 0;
+  vector<char> buffer;
+  for (size_t i = 0; i + 1 < m_chunks.size(); ++i)
+  {
+    if (m_chunks[i].m_status != CHUNK_COMPLETE)
+      continue;
+
+    buffer.resize(static_cast<size_t>(m_chunks[i + 1].m_pos - m_chunks[i].m_pos));
+    try
+    {
+      file->Read(m_chunks[i].m_pos, buffer.data(), buffer.size());
+    }
+    catch (RootException const & e)
+    {
+      LOG(LDEBUG, (e.Msg()));
+      m_chunks[i].m_status = CHUNK_FREE;
+      ++brokenCount;
+      continue;
+    }
+
+    uint32_t const crc = UpdateCrc(0 /* crc */, buffer.data(), buffer.size());
+    if (!m_crcKnown[i])
+    {
+      // Data of chunks from old resume files is trusted.
+      m_crcs[i] = crc;
+      m_crcKnown[i] = true;
+    }
+    else if (m_crcs[i] != crc)
+    {
+      m_chunks[i].m_status = CHUNK_FREE;
+      ++brokenCount;
+    }
+  }
+
+  if (brokenCount != 0)
+    LOG(LWARNING, (brokenCount, "broken chunks of", dataFileName, "are downloaded again."));
+}
+
+void ChunksDownloadStrategy::ChunkDataArrived(int64_t pos, void const * data, size_t size)
+{
+  char const * p = static_cast<char const *>(data);
+  // Data of a range may belong to several consecutive chunks.
+  auto it = upper_bound(m_chunks.begin(), m_chunks.end(), pos, LessChunks());
+  while (size != 0 && it != m_chunks.begin() && it != m_chunks.end())
+  {
+    size_t const index = distance(m_chunks.begin(), it) - 1;
+    size_t const part = static_cast<size_t>(min(static_cast<int64_t>(size), it->m_pos - pos));
+    m_crcs[index] = UpdateCrc(m_crcs[index], p, part);
+
+    p += part;
+    pos += part;
+    size -= part;
+    ++it;
+  }
+}
+
 string ChunksDownloadStrategy::ChunkFinished(bool success, RangeT const & range)
 {
   pair<ChunkT *, int> res = GetChunk(range);
@@ -141,19 +284,25 @@ string ChunksDownloadStrategy::ChunkFinished(bool success, RangeT const & range)
       if (m_servers[s].m_chunkIndex == res.second)
       {
         url = m_servers[s].m_url;
+        ChunkStatusT const status = success ? CHUNK_COMPLETE : CHUNK_FREE;
+        for (size_t i = 0; i < m_servers[s].m_chunksCount; ++i)
+        {
+          res.first[i].m_status = status;
+          m_crcKnown[res.second + i] = success;
+        }
+
         if (success)
         {
-          // mark server as free and chunk as ready
+          // mark server as free and chunks as ready
           m_servers[s].m_chunkIndex = SERVER_READY;
-          res.first->m_status = CHUNK_COMPLETE;
+          UpdateServerSpeed(s, range.second - range.first + 1);
         }
         else
         {
           LOG(LINFO, ("Thread for url", m_servers[s].m_url,
                       "failed to download chunk number", m_servers[s].m_chunkIndex));
-          // remove failed server and mark chunk as free
+          // remove failed server and mark chunks as free
           m_servers.erase(m_servers.begin() + s);
-          res.first->m_status = CHUNK_FREE;
         }
         break;
       }
@@ -169,14 +318,14 @@ ChunksDownloadStrategy::NextChunk(string & outUrl, RangeT & range)
   if (m_servers.empty())
     return EDownloadFailed;
 
-  // Find first free server.
+  // Find the fastest free server.
   ServerT * server = 0;
   for (size_t i = 0; i < m_servers.size(); ++i)
   {
-    if (m_servers[i].m_chunkIndex == SERVER_READY)
+    if (m_servers[i].m_chunkIndex == SERVER_READY &&
+        (server == 0 || server->m_speed < m_servers[i].m_speed))
     {
       server = &m_servers[i];
-      break;
     }
   }
   if (server == 0)
@@ -190,14 +339,26 @@ ChunksDownloadStrategy::NextChunk(string & outUrl, RangeT & range)
     switch (m_chunks[i].m_status)
     {
     case CHUNK_FREE:
+    {
+      // Take the following free chunks too if the server is fast enough.
+      size_t const maxCount = GetChunksPerRequest(*server, m_chunks[i + 1].m_pos - m_chunks[i].m_pos);
+      size_t end = i;
+      while (end < m_chunks.size() - 1 && end - i < maxCount && m_chunks[end].m_status == CHUNK_FREE)
+      {
+        m_crcs[end] = 0;
+        m_crcKnown[end] = false;
+        m_chunks[end++].m_status = CHUNK_DOWNLOADING;
+      }
+
       server->m_chunkIndex = static_cast<int>(i);
+      server->m_chunksCount = end - i;
+      server->m_requestStart = Now();
       outUrl = server->m_url;
 
       range.first = m_chunks[i].m_pos;
-      range.second = m_chunks[i+1].m_pos - 1;
-
-      m_chunks[i].m_status = CHUNK_DOWNLOADING;
+      range.second = m_chunks[end].m_pos - 1;
       return ENextChunk;
+    }
 
     case CHUNK_DOWNLOADING:
       allChunksDownloaded = false;
@@ -208,4 +369,46 @@ ChunksDownloadStrategy::NextChunk(string & outUrl, RangeT & range)
   return (allChunksDownloaded ? EDownloadSucceeded : ENoFreeServers);
 }
 
+size_t ChunksDownloadStrategy::GetChunksPerRequest(ServerT const & server, int64_t chunkSize) const
+{
+  if (server.m_measurements == 0 || chunkSize <= 0)
+    return 1;
+
+  double const count = server.m_speed * kTargetRequestSeconds / chunkSize;
+  if (count <= 1.0)
+    return 1;
+  return min(static_cast<size_t>(count), kMaxChunksPerRequest);
+}
+
+bool ChunksDownloadStrategy::UpdateServerSpeed(size_t serverIndex, int64_t bytes)
+{
+  ServerT & server = m_servers[serverIndex];
+  // Too short requests can't be measured.
+  double const seconds = Now() - server.m_requestStart;
+  if (seconds <= 0.0)
+    return false;
+
+  double const speed = bytes / seconds;
+  server.m_speed = server.m_measurements == 0 ? speed : (server.m_speed + speed) / 2;
+  ++server.m_measurements;
+
+  if (m_servers.size() < 2 || server.m_measurements < kMinMeasurements)
+    return false;
+
+  double bestSpeed = 0.0;
+  for (auto const & s : m_servers)
+  {
+    if (s.m_measurements >= kMinMeasurements)
+      bestSpeed = max(bestSpeed, s.m_speed);
+  }
+
+  if (server.m_speed * kSlowServerFactor >= bestSpeed)
+    return false;
+
+  LOG(LINFO, ("Server", server.m_url, "is too slow:", server.m_speed, "bytes/s, the fastest one:",
+              bestSpeed, "bytes/s. It's not used anymore."));
+  m_servers.erase(m_servers.begin() + serverIndex);
+  return true;
+}
+
 } // namespace downloader
@@ -1,5 +1,8 @@
 #pragma once
 
+#include "base/timer.hpp"
+
+#include "std/function.hpp"
 #include "std/string.hpp"
 #include "std/vector.hpp"
 #include "std/utility.hpp"
@@ -33,18 +36,34 @@ private:
 #pragma pack(pop)
 
   vector<ChunkT> m_chunks;
+  /// Crc32 of data of every chunk, it's computed while data arrives and is stored
+  /// in the resume file, so complete chunks are verified on resume.
+  vector<uint32_t> m_crcs;
+  /// False for chunks whose crc is unknown, e.g. from resume files of older versions.
+  vector<bool> m_crcKnown;
 
   static const int SERVER_READY = -1;
   struct ServerT
   {
     string m_url;
+    /// Index of the first chunk of the current request.
     int m_chunkIndex;
+    /// Number of consecutive chunks of the current request.
+    size_t m_chunksCount = 0;
+    /// Start time of the current request.
+    double m_requestStart = 0.0;
+    /// Average throughput in bytes per second, it's measured by finished requests.
+    double m_speed = 0.0;
+    size_t m_measurements = 0;
 
     ServerT(string const & url, int ind) : m_url(url), m_chunkIndex(ind) {}
   };
 
   vector<ServerT> m_servers;
 
+  my::Timer m_timer;
+  function<double()> m_timeFn;
+
   struct LessChunks
   {
     bool operator() (ChunkT const & r1, ChunkT const & r2) const { return r1.m_pos < r2.m_pos; }
@@ -57,6 +76,19 @@ private:
   /// @return Chunk pointer and it's index for given file offsets range.
   pair<ChunkT *, int> GetChunk(RangeT const & range);
 
+  double Now() const { return m_timeFn ? m_timeFn() : m_timer.ElapsedSeconds(); }
+
+  /// @return Number of chunks which |server| can download in one request in reasonable time.
+  size_t GetChunksPerRequest(ServerT const & server, int64_t chunkSize) const;
+
+  /// Measures throughput of |server| by its finished request and drops it if it's much
+  /// slower than other servers.
+  /// @return true if the server is dropped.
+  bool UpdateServerSpeed(size_t serverIndex, int64_t bytes);
+
+  /// Marks complete chunks with data which doesn't match crcs as free.
+  void VerifyChunks(string const & dataFileName);
+
 public:
   ChunksDownloadStrategy(vector<string> const & urls);
 
@@ -67,8 +99,15 @@ public:
   void AddChunk(RangeT const & range, ChunkStatusT status);
 
   void SaveChunks(int64_t fileSize, string const & fName);
+  /// Complete chunks are verified by data in |dataFileName| if it's not empty, broken
+  /// chunks are downloaded again.
   /// @return Already downloaded size.
-  int64_t LoadOrInitChunks(string const & fName, int64_t fileSize, int64_t chunkSize);
+  int64_t LoadOrInitChunks(string const & fName, int64_t fileSize, int64_t chunkSize,
+                           string const & dataFileName = string());
+
+  /// Should be called for data of chunks in progress, data of every chunk must arrive
+  /// sequentially.
+  void ChunkDataArrived(int64_t pos, void const * data, size_t size);
 
   /// Should be called for every completed chunk (no matter successful or not).
   /// @returns url of the chunk
@@ -76,6 +115,9 @@ public:
 
   size_t ActiveServersCount() const { return m_servers.size(); }
 
+  /// Used in unit tests only! Sets the source of time in seconds.
+  void SetTimeFnForTesting(function<double()> const & fn) { m_timeFn = fn; }
+
   enum ResultT
   {
     ENextChunk,
@@ -83,7 +125,9 @@ public:
     EDownloadFailed,
     EDownloadSucceeded
   };
-  /// Should be called until returns ENextChunk
+  /// Should be called until returns ENextChunk.
+  /// Fast servers get several consecutive chunks in one range, so there are less
+  /// requests and connections per file.
   ResultT NextChunk(string & outUrl, RangeT & range);
 };
 
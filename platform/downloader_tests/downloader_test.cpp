@@ -330,6 +330,136 @@ UNIT_TEST(ChunksDownloadStrategyFAIL)
   TEST_EQUAL(strategy.NextChunk(s2, r2), ChunksDownloadStrategy::EDownloadFailed, ());
 }
 
+UNIT_TEST(ChunksDownloadStrategyAdaptive)
+{
+  string const S1 = "UrlOfServer1";
+  string const S2 = "UrlOfServer2";
+
+  typedef pair<int64_t, int64_t> RangeT;
+
+  vector<string> servers;
+  servers.push_back(S1);
+  servers.push_back(S2);
+
+  int64_t const FILE_SIZE = 1000;
+  int64_t const CHUNK_SIZE = 100;
+  ChunksDownloadStrategy strategy(servers);
+  strategy.InitChunks(FILE_SIZE, CHUNK_SIZE);
+
+  double now = 0.0;
+  strategy.SetTimeFnForTesting([&now]() { return now; });
+
+  // Speed of servers is unknown, so they get one chunk each.
+  string s1, s2;
+  RangeT r1, r2;
+  TEST_EQUAL(strategy.NextChunk(s1, r1), ChunksDownloadStrategy::ENextChunk, ());
+  TEST_EQUAL(strategy.NextChunk(s2, r2), ChunksDownloadStrategy::ENextChunk, ());
+  TEST_EQUAL(s1, S1, ());
+  TEST_EQUAL(r1, RangeT(0, 99), ());
+  TEST_EQUAL(s2, S2, ());
+  TEST_EQUAL(r2, RangeT(100, 199), ());
+
+  // 100 bytes per second, so the first server gets 5 chunks at once.
+  now = 1.0;
+  strategy.ChunkFinished(true, r1);
+  TEST_EQUAL(strategy.NextChunk(s1, r1), ChunksDownloadStrategy::ENextChunk, ());
+  TEST_EQUAL(s1, S1, ());
+  TEST_EQUAL(r1, RangeT(200, 699), ());
+
+  // 10 bytes per second.
+  now = 10.0;
+  strategy.ChunkFinished(true, r2);
+  TEST_EQUAL(strategy.NextChunk(s2, r2), ChunksDownloadStrategy::ENextChunk, ());
+  TEST_EQUAL(s2, S2, ());
+  TEST_EQUAL(r2, RangeT(700, 799), ());
+
+  now = 11.0;
+  strategy.ChunkFinished(true, r1);
+  TEST_EQUAL(strategy.ActiveServersCount(), 2, ());
+
+  // The second server is much slower than the first one, so it's dropped.
+  now = 30.0;
+  strategy.ChunkFinished(true, r2);
+  TEST_EQUAL(strategy.ActiveServersCount(), 1, ());
+
+  TEST_EQUAL(strategy.NextChunk(s1, r1), ChunksDownloadStrategy::ENextChunk, ());
+  TEST_EQUAL(s1, S1, ());
+  TEST_EQUAL(r1, RangeT(800, 999), ());
+
+  string sEmpty;
+  RangeT rEmpty;
+  TEST_EQUAL(strategy.NextChunk(sEmpty, rEmpty), ChunksDownloadStrategy::ENoFreeServers, ());
+  now = 32.0;
+  strategy.ChunkFinished(true, r1);
+  TEST_EQUAL(strategy.NextChunk(sEmpty, rEmpty), ChunksDownloadStrategy::EDownloadSucceeded, ());
+}
+
+UNIT_TEST(ChunksDownloadStrategyResumeCrcs)
+{
+  string const DATA_FILENAME = "chunks_crcs_test" DOWNLOADING_FILE_EXTENSION;
+  string const RESUME_FILENAME = "chunks_crcs_test" RESUME_FILE_EXTENSION;
+
+  typedef pair<int64_t, int64_t> RangeT;
+  int64_t const FILE_SIZE = 1000;
+  int64_t const CHUNK_SIZE = 100;
+
+  string data(FILE_SIZE, 0);
+  for (size_t i = 0; i < data.size(); ++i)
+    data[i] = static_cast<char>(i % 101);
+  {
+    FileWriter f(DATA_FILENAME);
+    f.Write(data.data(), data.size());
+  }
+
+  {
+    ChunksDownloadStrategy strategy(vector<string>(1, "UrlOfServer1"));
+    strategy.InitChunks(FILE_SIZE, CHUNK_SIZE);
+    // Speed of the server is not measured, so it gets one chunk per request.
+    strategy.SetTimeFnForTesting([]() { return 0.0; });
+    // Download the first half of the file, data arrives by small parts.
+    for (size_t i = 0; i < 5; ++i)
+    {
+      string url;
+      RangeT range;
+      TEST_EQUAL(strategy.NextChunk(url, range), ChunksDownloadStrategy::ENextChunk, ());
+      for (int64_t pos = range.first; pos <= range.second; pos += 30)
+      {
+        size_t const size = static_cast<size_t>(min(int64_t(30), range.second + 1 - pos));
+        strategy.ChunkDataArrived(pos, data.data() + pos, size);
+      }
+      strategy.ChunkFinished(true, range);
+    }
+    strategy.SaveChunks(FILE_SIZE, RESUME_FILENAME);
+  }
+
+  {
+    ChunksDownloadStrategy strategy(vector<string>(1, "UrlOfServer1"));
+    TEST_EQUAL(strategy.LoadOrInitChunks(RESUME_FILENAME, FILE_SIZE, CHUNK_SIZE, DATA_FILENAME),
+               500, ());
+  }
+
+  // Corrupt the second chunk.
+  {
+    FileWriter f(DATA_FILENAME, FileWriter::OP_WRITE_EXISTING);
+    f.Seek(150);
+    char const b = 'x';
+    f.Write(&b, 1);
+  }
+
+  {
+    ChunksDownloadStrategy strategy(vector<string>(1, "UrlOfServer1"));
+    TEST_EQUAL(strategy.LoadOrInitChunks(RESUME_FILENAME, FILE_SIZE, CHUNK_SIZE, DATA_FILENAME),
+               400, ());
+    string url;
+    RangeT range;
+    TEST_EQUAL(strategy.NextChunk(url, range), ChunksDownloadStrategy::ENextChunk, ());
+    TEST_EQUAL(range, RangeT(100, 199), ());
+  }
+
+  TEST(my::DeleteFileX(DATA_FILENAME), ());
+  TEST(my::DeleteFileX(RESUME_FILENAME), ());
+}
+
 namespace
 {
   string ReadFileAsString(string const & file)
@@ -1,6 +1,7 @@
 #include "platform/chunks_download_strategy.hpp"
 #include "platform/http_request.hpp"
 #include "platform/http_thread_callback.hpp"
+#include "platform/network_scheduler.hpp"
 #include "platform/platform.hpp"
 
 #include "defines.hpp"
@@ -16,6 +17,7 @@
 #include "base/string_utils.hpp"
 
 #include "std/list.hpp"
+#include "std/map.hpp"
 #include "std/unique_ptr.hpp"
 
 #include "3party/Alohalytics/src/alohalytics.h"
@@ -151,6 +153,11 @@ class FileHttpRequest : public HttpRequest, public IHttpThreadCallback
   typedef list<ThreadHandleT> ThreadsContainerT;
   ThreadsContainerT m_threads;
 
+  /// Bytes received for chunks in progress by begins of chunks. Data of a chunk
+  /// is verified while it arrives, kBrokenChunk marks a chunk with unexpected data.
+  static int64_t constexpr kBrokenChunk = -1;
+  map<int64_t, int64_t> m_chunksBytes;
+
   string m_filePath;
   unique_ptr<FileWriter> m_writer;
 
@@ -161,9 +168,14 @@ class FileHttpRequest : public HttpRequest, public IHttpThreadCallback
   {
     string url;
     pair<int64_t, int64_t> range;
-    ChunksDownloadStrategy::ResultT result;
-    while ((result = m_strategy.NextChunk(url, range)) == ChunksDownloadStrategy::ENextChunk)
+    ChunksDownloadStrategy::ResultT result = ChunksDownloadStrategy::ENextChunk;
+    // Map files are bulk downloads, the rest of chunks are started when foreground
+    // requests are finished and any of running chunks is finished.
+    auto const & scheduler = platform::NetworkScheduler::Instance();
+    while (scheduler.CanStartBulkRequest(m_threads.size()) &&
+           (result = m_strategy.NextChunk(url, range)) == ChunksDownloadStrategy::ENextChunk)
     {
+      m_chunksBytes[range.first] = 0;
       HttpThread * p = CreateNativeHttpThread(url, *this, range.first, range.second, m_progress.second);
       ASSERT ( p, () );
       m_threads.push_back(make_pair(p, range.first));
@@ -203,10 +215,29 @@ class FileHttpRequest : public HttpRequest, public IHttpThreadCallback
     ASSERT_EQUAL(id, threads::GetCurrentThreadID(), ("OnWrite called from different threads"));
 #endif
 
+    auto it = m_chunksBytes.upper_bound(offset);
+    if (it == m_chunksBytes.begin())
+    {
+      LOG(LERROR, ("No chunk is downloaded for offset", offset));
+      return false;
+    }
+    --it;
+
+    // Data of a chunk must arrive sequentially, otherwise the response is broken
+    // and the chunk is downloaded again.
+    if (it->second == kBrokenChunk || it->first + it->second != offset)
+    {
+      LOG(LWARNING, (m_filePath, "Unexpected data at", offset, "for chunk", it->first));
+      it->second = kBrokenChunk;
+      return false;
+    }
+
     try
     {
       m_writer->Seek(offset);
       m_writer->Write(buffer, size);
+      it->second += size;
+      m_strategy.ChunkDataArrived(offset, buffer, size);
       return true;
     }
     catch (Writer::Exception const & e)
@@ -239,7 +270,23 @@ class FileHttpRequest : public HttpRequest, public IHttpThreadCallback
     ASSERT_EQUAL(id, threads::GetCurrentThreadID(), ("OnFinish called from different threads"));
 #endif
 
-    bool const isChunkOk = (httpCode == 200);
+    // A chunk is good only if all its bytes were received, some servers and proxies
+    // report success for truncated responses. So a broken file is never assembled
+    // and there is no need to verify the whole file after downloading.
+    int64_t received = 0;
+    auto const it = m_chunksBytes.find(begRange);
+    if (it != m_chunksBytes.end())
+    {
+      received = it->second;
+      m_chunksBytes.erase(it);
+    }
+    bool isChunkOk = (httpCode == 200);
+    if (isChunkOk && endRange >= begRange && received != endRange - begRange + 1)
+    {
+      LOG(LWARNING, (m_filePath, "Chunk", begRange, endRange, "is incomplete:", received, "bytes"));
+      isChunkOk = false;
+    }
+
     string const urlError = m_strategy.ChunkFinished(isChunkOk, make_pair(begRange, endRange));
 
     // remove completed chunk from the list, beg is the key
@@ -329,7 +376,8 @@ public:
 
     // Load resume downloading information.
     m_progress.first = m_strategy.LoadOrInitChunks(m_filePath + RESUME_FILE_EXTENSION,
-                                                   fileSize, chunkSize);
+                                                   fileSize, chunkSize,
+                                                   m_filePath + DOWNLOADING_FILE_EXTENSION);
     m_progress.second = fileSize;
 
     FileWriter::Op openMode = FileWriter::OP_WRITE_TRUNCATE;
@@ -48,7 +48,13 @@ HttpThread::HttpThread(string const & url,
     request.setRawHeader("User-Agent", uid.c_str());
   }
 
-  /// Use single instance for whole app
+#if QT_VERSION >= QT_VERSION_CHECK(5, 8, 0)
+  // Chunks which are requested from the same server are multiplexed
+  // over one connection if the server supports HTTP/2.
+  request.setAttribute(QNetworkRequest::HTTP2AllowedAttribute, true);
+#endif
+
+  /// Use single instance for whole app, so connections are kept alive between chunks.
   static QNetworkAccessManager netManager;
 
   if (pb.empty())
@@ -125,6 +125,14 @@ LocalCountryFile LocalCountryFile::MakeTemporary(string const & fullPath)
   return LocalCountryFile(my::GetDirectory(fullPath), CountryFile(name), 0 /* version */);
 }
 
+// static
+LocalCountryFile LocalCountryFile::MakeForResource(CountryFile const & countryFile, int64_t version)
+{
+  LocalCountryFile localFile(string(), countryFile, version);
+  localFile.m_files = MapOptions::Map;
+  return localFile;
+}
+
 
 string DebugPrint(LocalCountryFile const & file)
 {
@@ -84,11 +84,13 @@ public:
   /// @param fullPath Full path to the mwm file.
   static LocalCountryFile MakeTemporary(string const & fullPath);
 
+  // Creates LocalCountryFile for a map which is stored in resources,
+  // see the note for m_directory.
+  static LocalCountryFile MakeForResource(CountryFile const & countryFile, int64_t version);
+
 private:
   friend string DebugPrint(LocalCountryFile const &);
   friend void UnitTest_LocalCountryFile_DirectoryLookup();
-  friend void FindAllLocalMapsAndCleanup(int64_t latestVersion,
-                                         string const & dataDir, vector<LocalCountryFile> & localFiles);
 
   /// @note! If directory is empty, the file is stored in resources.
   /// In this case, the only valid params are m_countryFile and m_version.
@@ -6,8 +6,15 @@
 #include "platform/settings.hpp"
 
 #include "coding/file_name_utils.hpp"
+#include "coding/file_reader.hpp"
+#include "coding/file_writer.hpp"
 #include "coding/internal/file_data.hpp"
+#include "coding/read_write_utils.hpp"
 #include "coding/reader.hpp"
+#include "coding/varint.hpp"
+#include "coding/write_to_sink.hpp"
+#include "coding/writer.hpp"
+#include "coding/xxhash.hpp"
 
 #include "base/assert.hpp"
 #include "base/string_utils.hpp"
@@ -15,6 +22,7 @@
 
 #include "std/algorithm.hpp"
 #include "std/cctype.hpp"
+#include "std/ctime.hpp"
 #include "std/regex.hpp"
 #include "std/sstream.hpp"
 #include "std/unique_ptr.hpp"
@@ -167,6 +175,160 @@ void FindAllDiffsInDirectory(string const & dir, vector<LocalCountryFile> & diff
     diffs.push_back(localDiff);
   }
 }
+
+// Maps of a directory which are kept in the manifest.
+struct ManifestDir
+{
+  // Name of a version subdirectory, empty for the maps directory.
+  string m_name;
+  // Zero when the modification time is unknown.
+  uint64_t m_mtime = 0;
+  vector<string> m_countries;
+};
+
+uint8_t constexpr kManifestVersion = 0;
+
+uint64_t GetModificationTime(string const & path)
+{
+  uint64_t time = 0;
+  if (!Platform::GetFileModificationTimeByFullPath(path, time))
+    return 0;
+  return time;
+}
+
+// Lists maps of |directory| and, when |subdirs| isn't null, its version subdirectories.
+void ListDirectory(string const & directory, vector<string> & countries, vector<string> * subdirs)
+{
+  Platform::TFilesWithType fwts;
+  Platform::GetFilesByType(directory, Platform::FILE_TYPE_REGULAR | Platform::FILE_TYPE_DIRECTORY,
+                           fwts);
+  for (auto const & fwt : fwts)
+  {
+    string name = fwt.first;
+    if (fwt.second == Platform::FILE_TYPE_DIRECTORY)
+    {
+      int64_t version;
+      if (subdirs && ParseVersion(name, version))
+        subdirs->push_back(name);
+      continue;
+    }
+
+    if (fwt.second != Platform::FILE_TYPE_REGULAR || !strings::EndsWith(name, DATA_FILE_EXTENSION))
+      continue;
+
+    my::GetNameWithoutExt(name);
+    countries.push_back(name);
+  }
+}
+
+// The manifest is the version, hash of the data and the data, so a
+// partially written file is never used.
+bool LoadManifest(string const & path, vector<ManifestDir> & dirs)
+{
+  dirs.clear();
+  try
+  {
+    string data;
+    FileReader(path).ReadAsString(data);
+    if (data.size() < sizeof(uint8_t) + sizeof(uint64_t))
+      return false;
+
+    MemReader reader(data.data(), data.size());
+    ReaderSource<MemReader> src(reader);
+    if (ReadPrimitiveFromSource<uint8_t>(src) != kManifestVersion)
+      return false;
+    auto const hash = ReadPrimitiveFromSource<uint64_t>(src);
+    size_t const offset = sizeof(uint8_t) + sizeof(uint64_t);
+    if (hash != coding::XXHash64::Hash(data.data() + offset, data.size() - offset))
+      return false;
+
+    dirs.resize(ReadVarUint<uint32_t>(src));
+    for (auto & dir : dirs)
+    {
+      rw::Read(src, dir.m_name);
+      dir.m_mtime = ReadVarUint<uint64_t>(src);
+      rw::Read(src, dir.m_countries);
+    }
+    return true;
+  }
+  catch (RootException const & ex)
+  {
+    LOG(LDEBUG, ("Can't load manifest of local maps", path, ex.Msg()));
+  }
+  dirs.clear();
+  return false;
+}
+
+void SaveManifest(string const & path, vector<ManifestDir> const & dirs)
+{
+  vector<uint8_t> data;
+  {
+    MemWriter<vector<uint8_t>> writer(data);
+    WriteVarUint(writer, static_cast<uint32_t>(dirs.size()));
+    for (auto const & dir : dirs)
+    {
+      rw::Write(writer, dir.m_name);
+      WriteVarUint(writer, dir.m_mtime);
+      rw::Write(writer, dir.m_countries);
+    }
+  }
+
+  try
+  {
+    // The file is rewritten in place, it doesn't change the modification
+    // time of the maps directory.
+    FileWriter writer(path);
+    WriteToSink(writer, kManifestVersion);
+    WriteToSink(writer, coding::XXHash64::Hash(data.data(), data.size()));
+    writer.Write(data.data(), data.size());
+  }
+  catch (RootException const & ex)
+  {
+    LOG(LWARNING, ("Can't save manifest of local maps", path, ex.Msg()));
+  }
+}
+
+// World and WorldCoasts can be stored in app bundle or in resources
+// directory, thus it's better to get them via Platform.
+void AddWorldFiles(vector<LocalCountryFile> & localFiles)
+{
+  for (string const & file : { WORLD_FILE_NAME,
+    (migrate::NeedMigrate() ? WORLD_COASTS_OBSOLETE_FILE_NAME : WORLD_COASTS_FILE_NAME) })
+  {
+    auto i = localFiles.begin();
+    for (; i != localFiles.end(); ++i)
+    {
+      if (i->GetCountryFile().GetName() == file)
+        break;
+    }
+
+    try
+    {
+      Platform & platform = GetPlatform();
+      ModelReaderPtr reader(
+          platform.GetReader(file + DATA_FILE_EXTENSION, GetSpecialFilesSearchScope()));
+
+      // Assume that empty path means the resource file.
+      LocalCountryFile const worldFile =
+          LocalCountryFile::MakeForResource(CountryFile(file), version::ReadVersionDate(reader));
+      if (i != localFiles.end())
+      {
+        // Always use resource World files instead of local on disk.
+        *i = worldFile;
+      }
+      else
+        localFiles.push_back(worldFile);
+    }
+    catch (RootException const & ex)
+    {
+      if (i == localFiles.end())
+      {
+        // This warning is possible on android devices without pre-downloaded Worlds/fonts files.
+        LOG(LWARNING, ("Can't find any:", file, "Reason:", ex.Msg()));
+      }
+    }
+  }
+}
 }  // namespace
 
 void DeleteDownloaderFilesForCountry(int64_t version, CountryFile const & countryFile)
@@ -286,56 +448,103 @@ void FindAllLocalMapsAndCleanup(int64_t latestVersion, string const & dataDir,
 
     string const fullPath = my::JoinFoldersToPath(dir, subdir);
     FindAllLocalMapsInDirectoryAndCleanup(fullPath, version, latestVersion, localFiles);
+    // The cleanup may run in background, and a map may be being downloaded
+    // to an empty directory of the latest version.
+    if (version == latestVersion)
+      continue;
     Platform::EError err = Platform::RmDir(fullPath);
     if (err != Platform::ERR_OK && err != Platform::ERR_DIRECTORY_NOT_EMPTY)
       LOG(LWARNING, ("Can't remove directory:", fullPath, err));
   }
 
-  // World and WorldCoasts can be stored in app bundle or in resources
-  // directory, thus it's better to get them via Platform.
-  for (string const & file : { WORLD_FILE_NAME,
-    (migrate::NeedMigrate() ? WORLD_COASTS_OBSOLETE_FILE_NAME : WORLD_COASTS_FILE_NAME) })
+  AddWorldFiles(localFiles);
+}
+
+void FindAllLocalMaps(int64_t latestVersion, string const & dataDir,
+                      vector<LocalCountryFile> & localFiles)
+{
+  string const dir = GetDataDirFullPath(dataDir);
+  string const manifestPath = my::JoinFoldersToPath(dir, LOCAL_MAPS_MANIFEST_FILE);
+
+  vector<ManifestDir> cached;
+  if (!LoadManifest(manifestPath, cached) && !Platform::IsFileExistsByFullPath(manifestPath))
   {
-    auto i = localFiles.begin();
-    for (; i != localFiles.end(); ++i)
-    {
-      if (i->GetCountryFile().GetName() == file)
-        break;
-    }
+    // The manifest is created before modification times are taken, so
+    // its creation doesn't invalidate the maps directory for the next call.
+    SaveManifest(manifestPath, cached);
+  }
 
-    try
+  // A directory which is modified in the same second after it was listed
+  // has the same modification time, so times of the current second are
+  // not trusted.
+  auto const now = static_cast<uint64_t>(time(nullptr));
+  bool changed = false;
+  auto const loadDir = [&](string const & name, string const & path, vector<string> * subdirs)
+  {
+    ManifestDir result;
+    result.m_name = name;
+    result.m_mtime = GetModificationTime(path);
+    auto const it = find_if(cached.cbegin(), cached.cend(),
+                            [&name](ManifestDir const & d) { return d.m_name == name; });
+    if (it != cached.cend() && it->m_mtime != 0 && it->m_mtime == result.m_mtime)
     {
-      Platform & platform = GetPlatform();
-      ModelReaderPtr reader(
-          platform.GetReader(file + DATA_FILE_EXTENSION, GetSpecialFilesSearchScope()));
-
-      // Assume that empty path means the resource file.
-      LocalCountryFile worldFile{string(), CountryFile(file),
-                                 version::ReadVersionDate(reader)};
-      worldFile.m_files = MapOptions::Map;
-      if (i != localFiles.end())
+      result.m_countries = it->m_countries;
+      if (subdirs)
       {
-        // Always use resource World files instead of local on disk.
-        *i = worldFile;
+        for (auto const & d : cached)
+        {
+          if (!d.m_name.empty())
+            subdirs->push_back(d.m_name);
+        }
       }
-      else
-        localFiles.push_back(worldFile);
     }
-    catch (RootException const & ex)
+    else
     {
-      if (i == localFiles.end())
-      {
-        // This warning is possible on android devices without pre-downloaded Worlds/fonts files.
-        LOG(LWARNING, ("Can't find any:", file, "Reason:", ex.Msg()));
-      }
+      ListDirectory(path, result.m_countries, subdirs);
+      changed = true;
+    }
+
+    if (result.m_mtime >= now)
+      result.m_mtime = 0;
+    return result;
+  };
+
+  vector<string> subdirs;
+  vector<ManifestDir> dirs = {loadDir(string(), dir, &subdirs)};
+  for (auto const & subdir : subdirs)
+    dirs.push_back(loadDir(subdir, my::JoinFoldersToPath(dir, subdir), nullptr));
+
+  if (changed)
+    SaveManifest(manifestPath, dirs);
+
+  for (auto const & d : dirs)
+  {
+    int64_t version = 0;
+    if (!d.m_name.empty() && (!ParseVersion(d.m_name, version) || version > latestVersion))
+      continue;
+
+    string const directory = d.m_name.empty() ? dir : my::JoinFoldersToPath(dir, d.m_name);
+    for (auto const & name : d.m_countries)
+    {
+      // See FindAllLocalMapsInDirectoryAndCleanup().
+      if (name == "Japan" || name == "Brazil")
+        continue;
+      localFiles.emplace_back(directory, CountryFile(name), version);
     }
   }
+
+  AddWorldFiles(localFiles);
 }
 
 void CleanupMapsDirectory(int64_t latestVersion)
+{
+  CleanupMapsDirectory(latestVersion, string());
+}
+
+void CleanupMapsDirectory(int64_t latestVersion, string const & dataDir)
 {
   vector<LocalCountryFile> localFiles;
-  FindAllLocalMapsAndCleanup(latestVersion, localFiles);
+  FindAllLocalMapsAndCleanup(latestVersion, dataDir, localFiles);
 }
 
 bool ParseVersion(string const & s, int64_t & version)
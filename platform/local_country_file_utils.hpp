@@ -55,6 +55,14 @@ void FindAllLocalMapsAndCleanup(int64_t latestVersion, vector<LocalCountryFile>
 void FindAllLocalMapsAndCleanup(int64_t latestVersion, string const & dataDir,
                                 vector<LocalCountryFile> & localFiles);
 
+// Finds the same maps as FindAllLocalMapsAndCleanup() but doesn't clean
+// up anything, so maps which are deleted by the cleanup (e.g. old Japan
+// and Brazil maps) are skipped. Lists of maps of directories are kept in
+// LOCAL_MAPS_MANIFEST_FILE of the maps directory, and only directories
+// which modification times are changed since the last call are listed.
+void FindAllLocalMaps(int64_t latestVersion, string const & dataDir,
+                      vector<LocalCountryFile> & localFiles);
+
 void FindAllDiffs(string const & dataDir, vector<LocalCountryFile> & diffs);
 
 // This method removes:
@@ -64,6 +72,7 @@ void FindAllDiffs(string const & dataDir, vector<LocalCountryFile> & diffs);
 // * old (split) Japan and Brazil maps
 // * indexes for absent countries
 void CleanupMapsDirectory(int64_t latestVersion);
+void CleanupMapsDirectory(int64_t latestVersion, string const & dataDir);
 
 // Tries to parse a version from a string of size not longer than 18
 // symbols and representing an unsigned decimal number. Leading zeroes
@@ -0,0 +1,48 @@
+#include "platform/network_scheduler.hpp"
+
+#include "base/assert.hpp"
+
+#include "std/algorithm.hpp"
+#include "std/limits.hpp"
+
+namespace platform
+{
+// NetworkScheduler::ForegroundRequest -------------------------------------------------------------
+NetworkScheduler::ForegroundRequest::ForegroundRequest()
+{
+  ++NetworkScheduler::Instance().m_foregroundRequests;
+}
+
+NetworkScheduler::ForegroundRequest::~ForegroundRequest()
+{
+  auto & scheduler = NetworkScheduler::Instance();
+  ASSERT_GREATER(scheduler.m_foregroundRequests, 0, ());
+  --scheduler.m_foregroundRequests;
+}
+
+// NetworkScheduler --------------------------------------------------------------------------------
+// static
+NetworkScheduler & NetworkScheduler::Instance()
+{
+  static NetworkScheduler scheduler;
+  return scheduler;
+}
+
+NetworkScheduler::NetworkScheduler()
+  : m_foregroundRequests(0), m_maxBulkRequests(numeric_limits<size_t>::max())
+{
+}
+
+bool NetworkScheduler::CanStartBulkRequest(size_t runningRequests) const
+{
+  // A download always keeps one request, so it's never stalled.
+  if (runningRequests == 0)
+    return true;
+  return m_foregroundRequests == 0 && runningRequests < m_maxBulkRequests;
+}
+
+void NetworkScheduler::SetMaxBulkRequests(size_t maxRequests)
+{
+  m_maxBulkRequests = max(maxRequests, static_cast<size_t>(1));
+}
+}  // namespace platform
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "base/macros.hpp"
+
+#include "std/atomic.hpp"
+#include "std/cstdint.hpp"
+
+namespace platform
+{
+// Shares the network between latency-sensitive foreground requests (traffic, online
+// routing) and bulk downloads (map files). Bulk downloads consist of many requests
+// (e.g. chunks of a file), every download may keep one request running and starts
+// others only while there are no foreground requests. So a foreground request needs to
+// wait for at most one request of every download.
+//
+// *NOTE* This class is thread-safe.
+class NetworkScheduler
+{
+public:
+  // Marks a foreground request as running while it's alive.
+  class ForegroundRequest
+  {
+  public:
+    ForegroundRequest();
+    ~ForegroundRequest();
+
+  private:
+    DISALLOW_COPY_AND_MOVE(ForegroundRequest);
+  };
+
+  static NetworkScheduler & Instance();
+
+  // Returns true when a bulk download with |runningRequests| requests in progress
+  // may start one more request.
+  bool CanStartBulkRequest(size_t runningRequests) const;
+
+  // Limits requests of every bulk download when there are no foreground requests.
+  void SetMaxBulkRequests(size_t maxRequests);
+  size_t GetMaxBulkRequests() const { return m_maxBulkRequests; }
+
+  size_t GetForegroundRequestsCount() const { return m_foregroundRequests; }
+
+private:
+  NetworkScheduler();
+
+  atomic<size_t> m_foregroundRequests;
+  atomic<size_t> m_maxBulkRequests;
+
+  DISALLOW_COPY_AND_MOVE(NetworkScheduler);
+};
+}  // namespace platform
@@ -1,4 +1,6 @@
 #include "platform/platform.hpp"
+
+#include "platform/async_file_reader.hpp"
 #include "platform/local_country_file.hpp"
 
 #include "coding/base64.hpp"
@@ -235,6 +237,13 @@ unsigned Platform::CpuCores() const
   return cores > 0 ? cores : 1;
 }
 
+platform::AsyncFileReader & Platform::GetAsyncFileReader()
+{
+  // Reads are mostly waiting for I/O, so there are more threads than cores.
+  static platform::AsyncFileReader reader(2 * CpuCores() /* threadsCount */);
+  return reader;
+}
+
 string DebugPrint(Platform::EError err)
 {
   switch (err)
@@ -25,6 +25,7 @@ DECLARE_EXCEPTION(FileSystemException, RootException);
 
 namespace platform
 {
+class AsyncFileReader;
 class LocalCountryFile;
 }
 
@@ -185,6 +186,9 @@ public:
   /// @return false if file is not exist
   /// @note Try do not use in client production code
   static bool GetFileSizeByFullPath(string const & filePath, uint64_t & size);
+  /// @return false if file is not exist
+  /// @note |time| is in seconds since epoch
+  static bool GetFileModificationTimeByFullPath(string const & filePath, uint64_t & time);
   //@}
 
   /// Used to check available free storage space for downloading.
@@ -214,6 +218,9 @@ public:
   };
   using TFunctor = function<void()>;
   void RunAsync(TFunctor const & fn, Priority p = EPriorityDefault);
+
+  /// Process-wide reader of file ranges in background, see platform::AsyncFileReader.
+  platform::AsyncFileReader & GetAsyncFileReader();
   //@}
 
   // Please note, that number of active cores can vary at runtime.
@@ -73,6 +73,7 @@ linux*|win* {
 # common sources for all platforms
 
 HEADERS += \
+    async_file_reader.hpp \
     chunks_download_strategy.hpp \
     constants.hpp \
     country_defines.hpp \
@@ -91,6 +92,7 @@ HEADERS += \
     mwm_traits.hpp \
     mwm_version.hpp \
     network_policy.hpp \
+    network_scheduler.hpp \
     platform.hpp \
     preferred_languages.hpp \
     safe_callback.hpp \
@@ -100,6 +102,7 @@ HEADERS += \
     string_storage_base.hpp \
 
 SOURCES += \
+    async_file_reader.cpp \
     chunks_download_strategy.cpp \
     country_defines.cpp \
     country_file.cpp \
@@ -113,6 +116,7 @@ SOURCES += \
     measurement_utils.cpp \
     mwm_traits.cpp \
     mwm_version.cpp \
+    network_scheduler.cpp \
     platform.cpp \
     preferred_languages.cpp \
     servers_list.cpp \
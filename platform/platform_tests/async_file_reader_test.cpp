@@ -0,0 +1,72 @@
+#include "testing/testing.hpp"
+
+#include "platform/async_file_reader.hpp"
+#include "platform/platform.hpp"
+
+#include "coding/file_name_utils.hpp"
+#include "coding/file_writer.hpp"
+
+#include "base/scope_guard.hpp"
+
+#include "std/atomic.hpp"
+#include "std/bind.hpp"
+#include "std/string.hpp"
+#include "std/vector.hpp"
+
+using namespace platform;
+
+namespace
+{
+string const kTestFileName = "async_file_reader_test.tmp";
+}  // namespace
+
+UNIT_TEST(AsyncFileReader_Smoke)
+{
+  string const path = my::JoinFoldersToPath(GetPlatform().WritableDir(), kTestFileName);
+  MY_SCOPE_GUARD(deleter, bind(&FileWriter::DeleteFileX, path));
+
+  vector<char> data(1 << 20);
+  for (size_t i = 0; i < data.size(); ++i)
+    data[i] = static_cast<char>(i % 251);
+  {
+    FileWriter writer(path);
+    writer.Write(data.data(), data.size());
+  }
+
+  size_t const kRequestsCount = 200;
+  vector<vector<char>> buffers(kRequestsCount);
+  vector<AsyncFileReader::Request> requests;
+  for (size_t i = 0; i < kRequestsCount; ++i)
+  {
+    uint64_t const offset = (i * 7919) % (data.size() - 1000);
+    buffers[i].resize(1 + i * 5);
+    requests.emplace_back(offset, buffers[i].size(), buffers[i].data());
+  }
+
+  AsyncFileReader reader(4 /* threadsCount */);
+  atomic<size_t> readCount(0);
+  auto handle = reader.Read(path, requests, [&](size_t index, bool success)
+  {
+    TEST(success, (index));
+    ++readCount;
+  });
+  TEST(handle.Wait(), ());
+  TEST(handle.IsFinished(), ());
+  TEST_EQUAL(readCount, kRequestsCount, ());
+
+  for (size_t i = 0; i < kRequestsCount; ++i)
+  {
+    auto const begin = data.begin() + requests[i].m_offset;
+    TEST(equal(buffers[i].begin(), buffers[i].end(), begin), (i));
+  }
+
+  // Reads beyond the end of the file are failed.
+  char buffer[10];
+  vector<AsyncFileReader::Request> const wrong = {
+      AsyncFileReader::Request(0, sizeof(buffer), buffer),
+      AsyncFileReader::Request(data.size(), sizeof(buffer), buffer)};
+  TEST(!reader.Read(path, wrong).Wait(), ());
+
+  TEST(!reader.Read(path + ".absent", requests).Wait(), ());
+  TEST(reader.Read(path, {}).Wait(), ());
+}
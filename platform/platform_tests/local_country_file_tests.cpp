@@ -308,6 +308,53 @@ UNIT_TEST(LocalCountryFile_AllLocalFilesLookup)
   TEST_EQUAL(1, localFilesSet.count(expectedItalyFile), (localFiles));
 }
 
+// Checks that FindAllLocalMaps() finds maps without cleanup and finds
+// maps which are added after the manifest was saved.
+UNIT_TEST(LocalCountryFile_FindAllLocalMapsByManifest)
+{
+  string const manifestPath =
+      my::JoinFoldersToPath(GetPlatform().WritableDir(), LOCAL_MAPS_MANIFEST_FILE);
+  my::DeleteFileX(manifestPath);
+  MY_SCOPE_GUARD(deleteManifest, bind(&FileWriter::DeleteFileX, manifestPath));
+
+  CountryFile const italyFile("Italy");
+  CountryFile const spainFile("Spain");
+
+  ScopedDir oldDir("10100");
+  ScopedDir testDir("10101");
+  ScopedFile oldDownloaderFile(
+      my::JoinFoldersToPath(oldDir.GetRelativePath(), "Russia_Central.mwm.downloading"),
+      "Central Russia map");
+  ScopedFile italyMapFile(testDir, italyFile, MapOptions::Map, "Italy-map");
+
+  LocalCountryFile const expectedItalyFile(testDir.GetFullPath(), italyFile, 10101);
+  LocalCountryFile const expectedSpainFile(testDir.GetFullPath(), spainFile, 10101);
+
+  vector<LocalCountryFile> localFiles;
+  FindAllLocalMaps(10101 /* latestVersion */, string() /* dataDir */, localFiles);
+  TEST(Contains(localFiles, expectedItalyFile), (localFiles));
+  TEST(!Contains(localFiles, expectedSpainFile), (localFiles));
+  TEST(oldDownloaderFile.Exists(), (oldDownloaderFile));
+  TEST(Platform::IsFileExistsByFullPath(manifestPath), ());
+
+  ScopedFile spainMapFile(testDir, spainFile, MapOptions::Map, "Spain-map");
+
+  localFiles.clear();
+  FindAllLocalMaps(10101 /* latestVersion */, string() /* dataDir */, localFiles);
+  TEST(Contains(localFiles, expectedItalyFile), (localFiles));
+  TEST(Contains(localFiles, expectedSpainFile), (localFiles));
+
+  localFiles.clear();
+  FindAllLocalMaps(10100 /* latestVersion */, string() /* dataDir */, localFiles);
+  TEST(!Contains(localFiles, expectedItalyFile), (localFiles));
+
+  CleanupMapsDirectory(10101 /* latestVersion */, string() /* dataDir */);
+  TEST(!oldDownloaderFile.Exists(), (oldDownloaderFile));
+  oldDownloaderFile.Reset();
+  TEST(!oldDir.Exists(), (oldDir));
+  oldDir.Reset();
+}
+
 UNIT_TEST(LocalCountryFile_PreparePlaceForCountryFiles)
 {
   Platform & platform = GetPlatform();
@@ -0,0 +1,32 @@
+#include "testing/testing.hpp"
+
+#include "platform/network_scheduler.hpp"
+
+using namespace platform;
+
+UNIT_TEST(NetworkScheduler_BulkRequests)
+{
+  auto & scheduler = NetworkScheduler::Instance();
+  size_t const maxRequests = scheduler.GetMaxBulkRequests();
+
+  scheduler.SetMaxBulkRequests(3);
+  TEST(scheduler.CanStartBulkRequest(0), ());
+  TEST(scheduler.CanStartBulkRequest(2), ());
+  TEST(!scheduler.CanStartBulkRequest(3), ());
+
+  {
+    NetworkScheduler::ForegroundRequest const foreground;
+    TEST_EQUAL(scheduler.GetForegroundRequestsCount(), 1, ());
+    // A download keeps one request while foreground requests are in progress.
+    TEST(scheduler.CanStartBulkRequest(0), ());
+    TEST(!scheduler.CanStartBulkRequest(1), ());
+  }
+
+  TEST_EQUAL(scheduler.GetForegroundRequestsCount(), 0, ());
+  TEST(scheduler.CanStartBulkRequest(1), ());
+
+  scheduler.SetMaxBulkRequests(0);
+  TEST_EQUAL(scheduler.GetMaxBulkRequests(), 1, ());
+
+  scheduler.SetMaxBulkRequests(maxRequests);
+}
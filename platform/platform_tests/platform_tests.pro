@@ -25,6 +25,7 @@ win32*|linux* {
 SOURCES += \
     ../../testing/testingmain.cpp \
     apk_test.cpp \
+    async_file_reader_test.cpp \
     country_file_tests.cpp \
     get_text_by_id_tests.cpp \
     jansson_test.cpp \
@@ -33,4 +34,6 @@ SOURCES += \
     location_test.cpp \
     measurement_tests.cpp \
     mwm_version_test.cpp \
+    network_scheduler_test.cpp \
     platform_test.cpp \
+    string_storage_test.cpp \
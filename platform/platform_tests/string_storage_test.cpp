@@ -0,0 +1,90 @@
+#include "testing/testing.hpp"
+
+#include "platform/platform.hpp"
+#include "platform/string_storage_base.hpp"
+
+#include "coding/file_name_utils.hpp"
+#include "coding/file_writer.hpp"
+#include "coding/internal/file_data.hpp"
+
+#include "base/scope_guard.hpp"
+#include "base/string_utils.hpp"
+
+#include "std/string.hpp"
+
+using namespace platform;
+
+namespace
+{
+string const kTestFileName = "string_storage_test.ini";
+
+string GetValue(StringStorageBase const & storage, string const & key)
+{
+  string value;
+  if (!storage.GetValue(key, value))
+    return "<none>";
+  return value;
+}
+}  // namespace
+
+UNIT_TEST(StringStorage_Journal)
+{
+  string const path = my::JoinFoldersToPath(GetPlatform().WritableDir(), kTestFileName);
+  string const journalPath = StringStorageBase(path).GetJournalPath();
+  MY_SCOPE_GUARD(deleter, [&]()
+  {
+    FileWriter::DeleteFileX(path);
+    FileWriter::DeleteFileX(journalPath);
+  });
+
+  {
+    FileWriter writer(path);
+    string const text = "Units=0\nLastPosition=1.5,2.5\n\nbroken\n";
+    writer.Write(text.data(), text.size());
+  }
+  FileWriter::DeleteFileX(journalPath);
+
+  {
+    // The text storage is migrated.
+    StringStorageBase storage(path);
+    TEST_EQUAL(GetValue(storage, "Units"), "0", ());
+    TEST_EQUAL(GetValue(storage, "LastPosition"), "1.5,2.5", ());
+    TEST_EQUAL(GetValue(storage, "broken"), "<none>", ());
+
+    storage.SetValue("Units", "1");
+    storage.SetValue("Binary", string("a\0=\nb", 5));
+    storage.DeleteKeyAndValue("LastPosition");
+  }
+  FileWriter::DeleteFileX(path);
+
+  uint64_t size = 0;
+  {
+    StringStorageBase storage(path);
+    TEST_EQUAL(GetValue(storage, "Units"), "1", ());
+    TEST_EQUAL(GetValue(storage, "Binary"), string("a\0=\nb", 5), ());
+    TEST_EQUAL(GetValue(storage, "LastPosition"), "<none>", ());
+
+    // Obsolete records are dropped from the journal.
+    for (size_t i = 0; i < 5000; ++i)
+      storage.SetValue("Counter", strings::to_string(i));
+    TEST(my::GetFileSize(journalPath, size), ());
+    TEST_LESS(size, 1024 * 40, ());
+  }
+
+  {
+    // A partially written tail is ignored.
+    my::FileData file(journalPath, my::FileData::OP_APPEND);
+    char const tail[] = {0, 5, 0};
+    file.Write(tail, sizeof(tail));
+  }
+  {
+    StringStorageBase storage(path);
+    TEST_EQUAL(GetValue(storage, "Counter"), "4999", ());
+    TEST_EQUAL(GetValue(storage, "Units"), "1", ());
+
+    storage.Clear();
+    TEST_EQUAL(GetValue(storage, "Units"), "<none>", ());
+  }
+
+  TEST_EQUAL(GetValue(StringStorageBase(path), "Counter"), "<none>", ());
+}
@@ -1,13 +1,17 @@
 #include "string_storage_base.hpp"
 
 #include "coding/reader_streambuf.hpp"
+#include "coding/endianness.hpp"
 #include "coding/file_reader.hpp"
 #include "coding/file_writer.hpp"
+#include "coding/internal/file_data.hpp"
+#include "coding/mmap_reader.hpp"
 
 #include "base/logging.hpp"
 #include "base/exception.hpp"
 #include "base/stl_add.hpp"
 
+#include <cstring>
 #include <istream>
 
 using namespace std;
@@ -15,15 +19,136 @@ using namespace std;
 namespace
 {
 constexpr char kDelimChar = '=';
+
+char const kJournalExtension[] = ".bin";
+char const kJournalMagic[] = {'M', 'W', 'S', 'J'};
+uint8_t constexpr kJournalVersion = 0;
+size_t constexpr kJournalHeaderSize = sizeof(kJournalMagic) + sizeof(kJournalVersion);
+
+enum RecordType : uint8_t
+{
+  RECORD_SET = 0,
+  RECORD_DELETE = 1
+};
+
+// The journal is compacted when it has at least so many records and most of them
+// are obsolete.
+size_t constexpr kMinRecordsToCompact = 1024;
+
+void AppendUint32(uint32_t value, string & buffer)
+{
+  value = SwapIfBigEndian(value);
+  buffer.append(reinterpret_cast<char const *>(&value), sizeof(value));
+}
+
+// Record: type, key size, [value size,] key, [value]. Sizes are little-endian uint32.
+void AppendRecord(string const & key, string const * value, string & buffer)
+{
+  buffer.push_back(static_cast<char>(value ? RECORD_SET : RECORD_DELETE));
+  AppendUint32(static_cast<uint32_t>(key.size()), buffer);
+  if (value)
+    AppendUint32(static_cast<uint32_t>(value->size()), buffer);
+  buffer += key;
+  if (value)
+    buffer += *value;
+}
+
+bool ReadUint32(uint8_t const *& p, uint8_t const * end, uint32_t & value)
+{
+  if (static_cast<size_t>(end - p) < sizeof(value))
+    return false;
+  memcpy(&value, p, sizeof(value));
+  value = SwapIfBigEndian(value);
+  p += sizeof(value);
+  return true;
+}
 }  // namespace
 
 namespace platform
 {
-StringStorageBase::StringStorageBase(string const & path) : m_path(path)
+StringStorageBase::StringStorageBase(string const & path)
+  : m_path(path), m_journalPath(path + kJournalExtension)
+{
+  LOG(LINFO, ("Settings path:", m_path));
+  if (LoadJournal())
+    return;
+
+  LoadText();
+  Save();
+}
+
+bool StringStorageBase::LoadJournal()
+{
+  uint64_t size = 0;
+  if (!my::GetFileSize(m_journalPath, size))
+    return false;
+
+  bool complete = true;
+  try
+  {
+    MmapReader const reader(m_journalPath);
+    uint8_t const * p = reader.Data();
+    uint8_t const * const end = p + reader.Size();
+    if (reader.Size() < kJournalHeaderSize ||
+        memcmp(p, kJournalMagic, sizeof(kJournalMagic)) != 0 ||
+        p[sizeof(kJournalMagic)] != kJournalVersion)
+    {
+      LOG(LWARNING, ("Unknown format of", m_journalPath));
+      return false;
+    }
+    p += kJournalHeaderSize;
+
+    Container values;
+    size_t records = 0;
+    while (p != end)
+    {
+      uint8_t const type = *p++;
+      uint32_t keySize = 0;
+      uint32_t valueSize = 0;
+      if ((type != RECORD_SET && type != RECORD_DELETE) || !ReadUint32(p, end, keySize) ||
+          (type == RECORD_SET && !ReadUint32(p, end, valueSize)) ||
+          static_cast<uint64_t>(end - p) < static_cast<uint64_t>(keySize) + valueSize)
+      {
+        // The last change may be written partially.
+        complete = false;
+        break;
+      }
+
+      string key(reinterpret_cast<char const *>(p), keySize);
+      p += keySize;
+      if (type == RECORD_SET)
+      {
+        values[move(key)].assign(reinterpret_cast<char const *>(p), valueSize);
+        p += valueSize;
+      }
+      else
+      {
+        values.erase(key);
+      }
+      ++records;
+    }
+
+    m_values.swap(values);
+    m_journalRecords = records;
+  }
+  catch (RootException const & ex)
+  {
+    LOG(LWARNING, ("Loading settings:", ex.Msg()));
+    return false;
+  }
+
+  if (!complete)
+  {
+    LOG(LWARNING, ("Broken tail of", m_journalPath));
+    Save();
+  }
+  return true;
+}
+
+void StringStorageBase::LoadText()
 {
   try
   {
-    LOG(LINFO, ("Settings path:", m_path));
     ReaderStreamBuf buffer(make_unique<FileReader>(m_path));
     istream stream(&buffer);
 
@@ -51,17 +176,24 @@ StringStorageBase::StringStorageBase(string const & path) : m_path(path)
 
 void StringStorageBase::Save() const
 {
+  string buffer(kJournalMagic, sizeof(kJournalMagic));
+  buffer.push_back(static_cast<char>(kJournalVersion));
+  for (auto const & value : m_values)
+    AppendRecord(value.first, &value.second, buffer);
+
+  string const tmpPath = m_journalPath + ".tmp";
   try
   {
-    FileWriter file(m_path);
-    for (auto const & value : m_values)
     {
-      string line(value.first);
-      line += kDelimChar;
-      line += value.second;
-      line += '\n';
-      file.Write(line.data(), line.size());
+      FileWriter file(tmpPath);
+      file.Write(buffer.data(), buffer.size());
+    }
+    if (!my::RenameFileX(tmpPath, m_journalPath))
+    {
+      LOG(LWARNING, ("Can't rename", tmpPath, "to", m_journalPath));
+      return;
     }
+    m_journalRecords = m_values.size();
   }
   catch (RootException const & ex)
   {
@@ -93,8 +225,7 @@ void StringStorageBase::SetValue(string const & key, string && value)
 {
   lock_guard<mutex> guard(m_mutex);
 
-  m_values[key] = move(value);
-  Save();
+  Append(key, &(m_values[key] = move(value)));
 }
 
 void StringStorageBase::DeleteKeyAndValue(string const & key)
@@ -105,7 +236,30 @@ void StringStorageBase::DeleteKeyAndValue(string const & key)
   if (found != m_values.end())
   {
     m_values.erase(found);
+    Append(key, nullptr);
+  }
+}
+
+void StringStorageBase::Append(string const & key, string const * value)
+{
+  if (m_journalRecords >= kMinRecordsToCompact && m_journalRecords > 2 * m_values.size())
+  {
     Save();
+    return;
+  }
+
+  string buffer;
+  AppendRecord(key, value, buffer);
+  try
+  {
+    FileWriter file(m_journalPath, FileWriter::OP_APPEND);
+    file.Write(buffer.data(), buffer.size());
+    ++m_journalRecords;
+  }
+  catch (RootException const & ex)
+  {
+    // Ignore all settings saving exceptions.
+    LOG(LWARNING, ("Saving settings:", ex.Msg()));
   }
 }
 }  // namespace platform
@@ -1,25 +1,44 @@
 #pragma once
 
+#include <cstddef>
 #include <map>
 #include <mutex>
 #include <string>
 
 namespace platform
 {
+// Key-value storage of strings. Values are kept in a binary journal next to |path|:
+// every change is appended to the journal, and the journal is rewritten by live values
+// only when it has too many obsolete records. The journal is read by mmap at startup.
+// A text storage "key=value" at |path| is migrated to the journal on the first load.
 class StringStorageBase
 {
 public:
   StringStorageBase(std::string const & path);
+
+  // Rewrites the journal by current values.
   void Save() const;
   void Clear();
   bool GetValue(std::string const & key, std::string & outValue) const;
   void SetValue(std::string const & key, std::string && value);
   void DeleteKeyAndValue(std::string const & key);
-  
+
+  std::string const & GetJournalPath() const { return m_journalPath; }
+
 private:
   using Container = std::map<std::string, std::string>;
+
+  bool LoadJournal();
+  void LoadText();
+
+  // Appends a record to the journal, compacts it when it's needed.
+  void Append(std::string const & key, std::string const * value);
+
   Container m_values;
   mutable std::mutex m_mutex;
   std::string const m_path;
+  std::string const m_journalPath;
+  // Number of records in the journal.
+  mutable size_t m_journalRecords = 0;
 };
 }  // namespace platform
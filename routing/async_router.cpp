@@ -180,6 +180,14 @@ void AsyncRouter::ClearState()
   ResetDelegate();
 }
 
+void AsyncRouter::ShrinkCaches()
+{
+  lock_guard<mutex> l(m_guard);
+
+  m_shrinkCaches = true;
+  m_threadCondVar.notify_one();
+}
+
 void AsyncRouter::LogCode(IRouter::ResultCode code, double const elapsedSec)
 {
   switch (code)
@@ -242,7 +250,9 @@ void AsyncRouter::ThreadFunc()
   {
     {
       unique_lock<mutex> ul(m_guard);
-      m_threadCondVar.wait(ul, [this](){ return m_threadExit || m_hasRequest || m_clearState; });
+      m_threadCondVar.wait(ul, [this]() {
+        return m_threadExit || m_hasRequest || m_clearState || m_shrinkCaches;
+      });
 
       if (m_clearState && m_router)
       {
@@ -250,6 +260,12 @@ void AsyncRouter::ThreadFunc()
         m_clearState = false;
       }
 
+      if (m_shrinkCaches && m_router)
+      {
+        m_router->ShrinkCaches();
+        m_shrinkCaches = false;
+      }
+
       if (m_threadExit)
         break;
 
@@ -6,6 +6,7 @@
 #include "routing/router.hpp"
 #include "routing/router_delegate.hpp"
 
+#include "base/cache_registry.hpp"
 #include "base/thread.hpp"
 
 #include "std/condition_variable.hpp"
@@ -55,6 +56,10 @@ public:
   /// Interrupt routing and clear buffers
   void ClearState();
 
+  /// Drops caches of the router which are kept between requests, the current
+  /// route calculation isn't interrupted, caches are dropped after it.
+  void ShrinkCaches();
+
 private:
   /// Worker thread function
   void ThreadFunc();
@@ -112,6 +117,7 @@ private:
 
   /// Current request parameters
   bool m_clearState = false;
+  bool m_shrinkCaches = false;
   Checkpoints m_checkpoints;
   m2::PointD m_startDirection = m2::PointD::Zero();
   bool m_adjustToPrevRoute = false;
@@ -121,6 +127,9 @@ private:
 
   TRoutingStatisticsCallback const m_routingStatisticsCallback;
   RouterDelegate::TPointCheckCallback const m_pointCheckCallback;
+
+  base::SheddableCache m_cachesShedding{"routing", base::CacheRegistry::Priority::Normal,
+                                        [this]() { ShrinkCaches(); }};
 };
 
 }  // namespace routing
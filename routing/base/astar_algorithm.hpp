@@ -1,14 +1,20 @@
 #pragma once
 
 #include "routing/base/astar_weight.hpp"
+#include "routing/base/stamped_hash_map.hpp"
 
 #include "base/assert.hpp"
 #include "base/cancellable.hpp"
+#include "base/thread.hpp"
 
 #include <algorithm>
+#include <exception>
 #include <iostream>
 #include <map>
+#include <mutex>
 #include <queue>
+#include <set>
+#include <utility>
 #include <vector>
 
 namespace routing
@@ -29,6 +35,60 @@ struct RoutingResult
   }
 };
 
+// AStarBidirectionalContext keeps the states of both waves of
+// AStarAlgorithm::FindPathBidirectional(). A caller may keep a context (one per thread) and pass
+// it to many searches one by one: the context is reset in O(1) at the beginning of each search and
+// the memory allocated by the previous searches is reused.
+template <typename TVertexType, typename TWeightType>
+class AStarBidirectionalContext final
+{
+public:
+  struct VertexState
+  {
+    TWeightType distance = GetAStarWeightZero<TWeightType>();
+    TVertexType parent = TVertexType();
+    bool hasParent = false;
+  };
+
+  struct QueueState
+  {
+    QueueState(TVertexType const & vertex, TWeightType const & distance)
+      : vertex(vertex), distance(distance)
+    {
+    }
+
+    inline bool operator>(QueueState const & rhs) const { return distance > rhs.distance; }
+
+    TVertexType vertex;
+    TWeightType distance;
+  };
+
+  struct Wave
+  {
+    void Clear()
+    {
+      queue.clear();
+      vertices.Clear();
+    }
+
+    // Binary heap with the minimal distance on the top.
+    std::vector<QueueState> queue;
+    StampedHashMap<TVertexType, VertexState> vertices;
+  };
+
+  void Clear()
+  {
+    m_forward.Clear();
+    m_backward.Clear();
+  }
+
+  Wave & GetWave(bool forward) { return forward ? m_forward : m_backward; }
+
+private:
+  Wave m_forward;
+  Wave m_backward;
+};
+
 template <typename TGraph>
 class AStarAlgorithm
 {
@@ -63,6 +123,7 @@ public:
   }
 
   using TOnVisitedVertexCallback = std::function<void(TVertexType const &, TVertexType const &)>;
+  using BidirectionalContext = AStarBidirectionalContext<TVertexType, TWeightType>;
 
   class Context final
   {
@@ -126,6 +187,54 @@ public:
                                my::Cancellable const & cancellable = my::Cancellable(),
                                TOnVisitedVertexCallback onVisitedVertexCallback = nullptr) const;
 
+  // The same as above but the search states are kept in |context| which is cleared at the
+  // beginning. Please see a comment to AStarBidirectionalContext for details.
+  Result FindPathBidirectional(BidirectionalContext & context, TGraphType & graph,
+                               TVertexType const & startVertex, TVertexType const & finalVertex,
+                               RoutingResult<TVertexType, TWeightType> & result,
+                               my::Cancellable const & cancellable = my::Cancellable(),
+                               TOnVisitedVertexCallback onVisitedVertexCallback = nullptr) const;
+
+  struct AlternativesParams
+  {
+    size_t m_maxAlternatives = 2;
+    // An alternative path may be longer than the best one by |m_maxStretch| * the best path length.
+    double m_maxStretch = 0.25;
+    // A part of an alternative path which may be shared with the best path and the other
+    // alternatives. The part is measured by weight.
+    double m_maxSharing = 0.8;
+    // The minimal plateau length of an alternative path in parts of the best path length.
+    double m_minPlateau = 0.1;
+  };
+
+  // The same as FindPathBidirectional() with a context but up to |params.m_maxAlternatives|
+  // alternative paths are found as well. |alternatives| are sorted by distance.
+  // The waves are propagated till the sum of the top distances exceeds the best path length
+  // by |params.m_maxStretch| of it and the alternatives are taken from the explored search spaces
+  // without additional searches. An alternative goes through a plateau: a chain of edges
+  // which are in both the forward and the backward shortest path trees. So the alternative is
+  // the shortest path between any two vertices of the plateau.
+  Result FindPathWithAlternatives(BidirectionalContext & context, TGraphType & graph,
+                                  TVertexType const & startVertex, TVertexType const & finalVertex,
+                                  AlternativesParams const & params,
+                                  RoutingResult<TVertexType, TWeightType> & result,
+                                  std::vector<RoutingResult<TVertexType, TWeightType>> & alternatives,
+                                  my::Cancellable const & cancellable = my::Cancellable(),
+                                  TOnVisitedVertexCallback onVisitedVertexCallback = nullptr) const;
+
+  // The same as FindPathBidirectional() but the forward wave is propagated in a separate thread
+  // on |forwardGraph| and the backward wave is propagated in the calling thread on
+  // |backwardGraph|. The waves are synchronized only on the meeting and termination checks.
+  // |forwardGraph| and |backwardGraph| should be two instances of the same graph which do not
+  // share mutable state, e.g. two instances with their own geometry caches.
+  // |onVisitedVertexCallback| is called from both threads but never simultaneously.
+  Result FindPathBidirectionalParallel(TGraphType & forwardGraph, TGraphType & backwardGraph,
+                                       TVertexType const & startVertex,
+                                       TVertexType const & finalVertex,
+                                       RoutingResult<TVertexType, TWeightType> & result,
+                                       my::Cancellable const & cancellable = my::Cancellable(),
+                                       TOnVisitedVertexCallback onVisitedVertexCallback = nullptr) const;
+
   // Adjust route to the previous one.
   // adjustLimit - distance limit for wave propagation, measured in same units as graph edges length.
   typename AStarAlgorithm<TGraph>::Result AdjustRoute(
@@ -179,29 +288,89 @@ private:
   // purpose is to make the code that changes directions more readable.
   struct BidirectionalStepContext
   {
+    using QueueState = typename BidirectionalContext::QueueState;
+
     BidirectionalStepContext(bool forward, TVertexType const & startVertex,
-                             TVertexType const & finalVertex, TGraphType & graph)
+                             TVertexType const & finalVertex, TGraphType & graph,
+                             typename BidirectionalContext::Wave & wave)
         : forward(forward), startVertex(startVertex), finalVertex(finalVertex), graph(graph)
-        , m_piRT(graph.HeuristicCostEstimate(finalVertex, startVertex))
+        , m_piRT(graph.HeuristicCostEstimate(startVertex, finalVertex))
         , m_piFS(graph.HeuristicCostEstimate(startVertex, finalVertex))
+        , wave(wave)
     {
       bestVertex = forward ? startVertex : finalVertex;
       pS = ConsistentHeuristic(bestVertex);
     }
 
+    bool IsQueueEmpty() const { return wave.queue.empty(); }
+
+    QueueState PopQueue()
+    {
+      ASSERT(!wave.queue.empty(), ());
+      std::pop_heap(wave.queue.begin(), wave.queue.end(), std::greater<QueueState>());
+      QueueState const state = wave.queue.back();
+      wave.queue.pop_back();
+      return state;
+    }
+
+    void PushQueue(TVertexType const & vertex, TWeightType const & distance)
+    {
+      wave.queue.emplace_back(vertex, distance);
+      std::push_heap(wave.queue.begin(), wave.queue.end(), std::greater<QueueState>());
+    }
+
     TWeightType TopDistance() const
     {
-      ASSERT(!queue.empty(), ());
-      return bestDistance.at(queue.top().vertex);
+      ASSERT(!wave.queue.empty(), ());
+      auto const * state = wave.vertices.Find(wave.queue.front().vertex);
+      CHECK(state, ());
+      return state->distance;
+    }
+
+    // Returns nullptr if |v| has not been reached by the wave yet.
+    TWeightType const * FindDistance(TVertexType const & v) const
+    {
+      auto const * state = wave.vertices.Find(v);
+      return state ? &state->distance : nullptr;
+    }
+
+    void SetDistance(TVertexType const & v, TWeightType const & distance)
+    {
+      wave.vertices[v].distance = distance;
+    }
+
+    void SetDistanceAndParent(TVertexType const & v, TWeightType const & distance,
+                              TVertexType const & parent)
+    {
+      auto & state = wave.vertices[v];
+      state.distance = distance;
+      state.parent = parent;
+      state.hasParent = true;
+    }
+
+    // Appends the path from the wave source to |v| in reversed order.
+    void ReconstructReversedPath(TVertexType const & v, std::vector<TVertexType> & path) const
+    {
+      TVertexType cur = v;
+      while (true)
+      {
+        path.push_back(cur);
+        auto const * state = wave.vertices.Find(cur);
+        if (state == nullptr || !state->hasParent)
+          break;
+        cur = state->parent;
+      }
     }
 
     // p_f(v) = 0.5*(π_f(v) - π_r(v)) + 0.5*π_r(t)
     // p_r(v) = 0.5*(π_r(v) - π_f(v)) + 0.5*π_f(s)
     // p_r(v) + p_f(v) = const. Note: this condition is called consistence.
+    // π_f(v) estimates the distance from v to t and π_r(v) estimates the distance from s to v,
+    // so the heuristic may be asymmetric (e.g. the landmark one of IndexGraph).
     TWeightType ConsistentHeuristic(TVertexType const & v) const
     {
       auto const piF = graph.HeuristicCostEstimate(v, finalVertex);
-      auto const piR = graph.HeuristicCostEstimate(v, startVertex);
+      auto const piR = graph.HeuristicCostEstimate(startVertex, v);
       if (forward)
       {
         /// @todo careful: with this "return" here and below in the Backward case
@@ -230,21 +399,53 @@ private:
     TGraph & graph;
     TWeightType const m_piRT;
     TWeightType const m_piFS;
+    typename BidirectionalContext::Wave & wave;
 
-    std::priority_queue<State, std::vector<State>, std::greater<State>> queue;
-    std::map<TVertexType, TWeightType> bestDistance;
-    std::map<TVertexType, TVertexType> parent;
     TVertexType bestVertex;
 
     TWeightType pS;
   };
 
+  // The state shared by the waves of FindPathBidirectionalParallel(). All the fields and both
+  // vertex tables of the waves are guarded by |m_mutex|.
+  struct ParallelSearchState
+  {
+    std::mutex m_mutex;
+    bool m_stop = false;
+    bool m_cancelled = false;
+    bool m_foundAnyPath = false;
+    TWeightType m_bestPathReducedLength = kZeroDistance;
+    TWeightType m_bestPathRealLength = kZeroDistance;
+    // Reduced distances of the last vertices settled by the forward and the backward waves.
+    // Distances of settled vertices do not decrease so they are lower bounds for the queues.
+    TWeightType m_settledDistance[2] = {kZeroDistance, kZeroDistance};
+    std::exception_ptr m_exception;
+  };
+
+  // The waves are propagated till the sum of the top distances exceeds the best path length
+  // by |stopSlack| of it.
+  Result FindPathBidirectionalImpl(BidirectionalContext & context, TGraphType & graph,
+                                   TVertexType const & startVertex, TVertexType const & finalVertex,
+                                   double stopSlack, RoutingResult<TVertexType, TWeightType> & result,
+                                   my::Cancellable const & cancellable,
+                                   TOnVisitedVertexCallback onVisitedVertexCallback) const;
+
+  // Fills |alternatives| with paths through the plateaus of the waves kept in |context|.
+  void FindAlternatives(BidirectionalContext & context, TGraphType & graph,
+                        TVertexType const & startVertex, TVertexType const & finalVertex,
+                        AlternativesParams const & params,
+                        RoutingResult<TVertexType, TWeightType> const & result,
+                        std::vector<RoutingResult<TVertexType, TWeightType>> & alternatives) const;
+
+  void PropagateParallelWave(BidirectionalStepContext & cur, BidirectionalStepContext & nxt,
+                             ParallelSearchState & state, my::Cancellable const & cancellable,
+                             TOnVisitedVertexCallback const & onVisitedVertexCallback) const;
+
   static void ReconstructPath(TVertexType const & v,
                               std::map<TVertexType, TVertexType> const & parent,
                               std::vector<TVertexType> & path);
-  static void ReconstructPathBidirectional(TVertexType const & v, TVertexType const & w,
-                                           std::map<TVertexType, TVertexType> const & parentV,
-                                           std::map<TVertexType, TVertexType> const & parentW,
+  static void ReconstructPathBidirectional(BidirectionalStepContext const & cur,
+                                           BidirectionalStepContext const & nxt,
                                            std::vector<TVertexType> & path);
 };
 
@@ -373,8 +574,9 @@ typename AStarAlgorithm<TGraph>::Result AStarAlgorithm<TGraph>::FindPath(
   if (resultCode == Result::OK)
   {
     context.ReconstructPath(finalVertex, result.path);
+    // The reduced length of a path is its real length minus the potential of its start.
     result.distance =
-        context.GetDistance(finalVertex) - graph.HeuristicCostEstimate(startVertex, finalVertex);
+        context.GetDistance(finalVertex) + graph.HeuristicCostEstimate(startVertex, finalVertex);
   }
 
   return resultCode;
@@ -387,22 +589,69 @@ typename AStarAlgorithm<TGraph>::Result AStarAlgorithm<TGraph>::FindPathBidirect
     RoutingResult<TVertexType, TWeightType> & result,
     my::Cancellable const & cancellable,
     TOnVisitedVertexCallback onVisitedVertexCallback) const
+{
+  BidirectionalContext context;
+  return FindPathBidirectional(context, graph, startVertex, finalVertex, result, cancellable,
+                               onVisitedVertexCallback);
+}
+
+template <typename TGraph>
+typename AStarAlgorithm<TGraph>::Result AStarAlgorithm<TGraph>::FindPathBidirectional(
+    BidirectionalContext & context, TGraphType & graph,
+    TVertexType const & startVertex, TVertexType const & finalVertex,
+    RoutingResult<TVertexType, TWeightType> & result,
+    my::Cancellable const & cancellable,
+    TOnVisitedVertexCallback onVisitedVertexCallback) const
+{
+  return FindPathBidirectionalImpl(context, graph, startVertex, finalVertex, 0.0 /* stopSlack */,
+                                   result, cancellable, onVisitedVertexCallback);
+}
+
+template <typename TGraph>
+typename AStarAlgorithm<TGraph>::Result AStarAlgorithm<TGraph>::FindPathWithAlternatives(
+    BidirectionalContext & context, TGraphType & graph, TVertexType const & startVertex,
+    TVertexType const & finalVertex, AlternativesParams const & params,
+    RoutingResult<TVertexType, TWeightType> & result,
+    std::vector<RoutingResult<TVertexType, TWeightType>> & alternatives,
+    my::Cancellable const & cancellable, TOnVisitedVertexCallback onVisitedVertexCallback) const
+{
+  alternatives.clear();
+  auto const resultCode =
+      FindPathBidirectionalImpl(context, graph, startVertex, finalVertex, params.m_maxStretch,
+                                result, cancellable, onVisitedVertexCallback);
+  if (resultCode != Result::OK || params.m_maxAlternatives == 0)
+    return resultCode;
+
+  FindAlternatives(context, graph, startVertex, finalVertex, params, result, alternatives);
+  return Result::OK;
+}
+
+template <typename TGraph>
+typename AStarAlgorithm<TGraph>::Result AStarAlgorithm<TGraph>::FindPathBidirectionalImpl(
+    BidirectionalContext & context, TGraphType & graph,
+    TVertexType const & startVertex, TVertexType const & finalVertex, double stopSlack,
+    RoutingResult<TVertexType, TWeightType> & result,
+    my::Cancellable const & cancellable,
+    TOnVisitedVertexCallback onVisitedVertexCallback) const
 {
   if (nullptr == onVisitedVertexCallback)
     onVisitedVertexCallback = [](TVertexType const &, TVertexType const &){};
 
-  BidirectionalStepContext forward(true /* forward */, startVertex, finalVertex, graph);
-  BidirectionalStepContext backward(false /* forward */, startVertex, finalVertex, graph);
+  context.Clear();
+  BidirectionalStepContext forward(true /* forward */, startVertex, finalVertex, graph,
+                                   context.GetWave(true /* forward */));
+  BidirectionalStepContext backward(false /* forward */, startVertex, finalVertex, graph,
+                                    context.GetWave(false /* forward */));
 
   bool foundAnyPath = false;
   auto bestPathReducedLength = kZeroDistance;
   auto bestPathRealLength = kZeroDistance;
 
-  forward.bestDistance[startVertex] = kZeroDistance;
-  forward.queue.push(State(startVertex, kZeroDistance));
+  forward.SetDistance(startVertex, kZeroDistance);
+  forward.PushQueue(startVertex, kZeroDistance);
 
-  backward.bestDistance[finalVertex] = kZeroDistance;
-  backward.queue.push(State(finalVertex, kZeroDistance));
+  backward.SetDistance(finalVertex, kZeroDistance);
+  backward.PushQueue(finalVertex, kZeroDistance);
 
   // To use the search code both for backward and forward directions
   // we keep the pointers to everything related to the search in the
@@ -419,7 +668,7 @@ typename AStarAlgorithm<TGraph>::Result AStarAlgorithm<TGraph>::FindPathBidirect
   uint32_t steps = 0;
   PeriodicPollCancellable periodicCancellable(cancellable);
 
-  while (!cur->queue.empty() && !nxt->queue.empty())
+  while (!cur->IsQueueEmpty() && !nxt->IsQueueEmpty())
   {
     ++steps;
 
@@ -445,10 +694,9 @@ typename AStarAlgorithm<TGraph>::Result AStarAlgorithm<TGraph>::FindPathBidirect
       // several top states in a priority queue may have equal reduced path lengths and
       // different real path lengths.
 
-      if (curTop + nxtTop >= bestPathReducedLength - kEpsilon)
+      if (curTop + nxtTop >= bestPathReducedLength + stopSlack * bestPathRealLength - kEpsilon)
       {
-        ReconstructPathBidirectional(cur->bestVertex, nxt->bestVertex, cur->parent, nxt->parent,
-                                     result.path);
+        ReconstructPathBidirectional(*cur, *nxt, result.path);
         result.distance = bestPathRealLength;
         CHECK(!result.path.empty(), ());
         if (!cur->forward)
@@ -457,10 +705,11 @@ typename AStarAlgorithm<TGraph>::Result AStarAlgorithm<TGraph>::FindPathBidirect
       }
     }
 
-    State const stateV = cur->queue.top();
-    cur->queue.pop();
+    auto const stateV = cur->PopQueue();
 
-    if (stateV.distance > cur->bestDistance[stateV.vertex])
+    auto const * const distV = cur->FindDistance(stateV.vertex);
+    CHECK(distV, ());
+    if (stateV.distance > *distV)
       continue;
 
     onVisitedVertexCallback(stateV.vertex, cur->forward ? cur->finalVertex : cur->startVertex);
@@ -468,26 +717,26 @@ typename AStarAlgorithm<TGraph>::Result AStarAlgorithm<TGraph>::FindPathBidirect
     cur->GetAdjacencyList(stateV.vertex, adj);
     for (auto const & edge : adj)
     {
-      State stateW(edge.GetTarget(), kZeroDistance);
-      if (stateV.vertex == stateW.vertex)
+      TVertexType const & vertexW = edge.GetTarget();
+      if (stateV.vertex == vertexW)
         continue;
 
       auto const len = edge.GetWeight();
       auto const pV = cur->ConsistentHeuristic(stateV.vertex);
-      auto const pW = cur->ConsistentHeuristic(stateW.vertex);
+      auto const pW = cur->ConsistentHeuristic(vertexW);
       auto const reducedLen = len + pW - pV;
 
       CHECK(reducedLen >= -kEpsilon, ("Invariant violated:", reducedLen, "<", -kEpsilon));
       auto const newReducedDist = stateV.distance + std::max(reducedLen, kZeroDistance);
 
-      auto const itCur = cur->bestDistance.find(stateW.vertex);
-      if (itCur != cur->bestDistance.end() && newReducedDist >= itCur->second - kEpsilon)
+      auto const * const curDistW = cur->FindDistance(vertexW);
+      if (curDistW != nullptr && newReducedDist >= *curDistW - kEpsilon)
         continue;
 
-      auto const itNxt = nxt->bestDistance.find(stateW.vertex);
-      if (itNxt != nxt->bestDistance.end())
+      auto const * const nxtDistW = nxt->FindDistance(vertexW);
+      if (nxtDistW != nullptr)
       {
-        auto const distW = itNxt->second;
+        auto const distW = *nxtDistW;
         // Reduced length that the path we've just found has in the original graph:
         // find the reduced length of the path's parts in the reduced forward and backward graphs.
         auto const curPathReducedLength = newReducedDist + distW;
@@ -498,24 +747,322 @@ typename AStarAlgorithm<TGraph>::Result AStarAlgorithm<TGraph>::FindPathBidirect
 
           bestPathRealLength = stateV.distance + len + distW;
           bestPathRealLength += cur->pS - pV;
-          bestPathRealLength += nxt->pS - nxt->ConsistentHeuristic(stateW.vertex);
+          bestPathRealLength += nxt->pS - nxt->ConsistentHeuristic(vertexW);
 
           foundAnyPath = true;
           cur->bestVertex = stateV.vertex;
-          nxt->bestVertex = stateW.vertex;
+          nxt->bestVertex = vertexW;
         }
       }
 
-      stateW.distance = newReducedDist;
-      cur->bestDistance[stateW.vertex] = newReducedDist;
-      cur->parent[stateW.vertex] = stateV.vertex;
-      cur->queue.push(stateW);
+      cur->SetDistanceAndParent(vertexW, newReducedDist, stateV.vertex);
+      cur->PushQueue(vertexW, newReducedDist);
     }
   }
 
+  // A queue may be exhausted when the waves are propagated further than the best path.
+  if (foundAnyPath)
+  {
+    ReconstructPathBidirectional(*cur, *nxt, result.path);
+    result.distance = bestPathRealLength;
+    CHECK(!result.path.empty(), ());
+    if (!cur->forward)
+      reverse(result.path.begin(), result.path.end());
+    return Result::OK;
+  }
+
   return Result::NoPath;
 }
 
+template <typename TGraph>
+void AStarAlgorithm<TGraph>::FindAlternatives(
+    BidirectionalContext & context, TGraphType & graph, TVertexType const & startVertex,
+    TVertexType const & finalVertex, AlternativesParams const & params,
+    RoutingResult<TVertexType, TWeightType> const & result,
+    std::vector<RoutingResult<TVertexType, TWeightType>> & alternatives) const
+{
+  using VertexState = typename BidirectionalContext::VertexState;
+
+  BidirectionalStepContext const forward(true /* forward */, startVertex, finalVertex, graph,
+                                         context.GetWave(true /* forward */));
+  BidirectionalStepContext const backward(false /* forward */, startVertex, finalVertex, graph,
+                                          context.GetWave(false /* forward */));
+  auto const & forwardVertices = forward.wave.vertices;
+  auto const & backwardVertices = backward.wave.vertices;
+
+  // Returns the real distance from the start to |v| for the forward wave and from |v| to
+  // the finish for the backward one.
+  auto const getRealDistance = [](BidirectionalStepContext const & step, TVertexType const & v) {
+    auto const * distance = step.FindDistance(v);
+    CHECK(distance, ());
+    return *distance + step.pS - step.ConsistentHeuristic(v);
+  };
+
+  // Returns true if the edge from |from| to |to| is in the both shortest path trees.
+  auto const isPlateauEdge = [&](TVertexType const & from, TVertexType const & to) {
+    auto const * forwardState = forwardVertices.Find(to);
+    auto const * backwardState = backwardVertices.Find(from);
+    return forwardState != nullptr && forwardState->hasParent && forwardState->parent == from &&
+           backwardState != nullptr && backwardState->hasParent && backwardState->parent == to;
+  };
+
+  // Every plateau gives a candidate which is represented by the last vertex of the plateau.
+  std::vector<std::pair<TWeightType, TVertexType>> candidates;
+  TWeightType const maxDistance = result.distance + params.m_maxStretch * result.distance;
+  TWeightType const minPlateau = params.m_minPlateau * result.distance;
+  forwardVertices.ForEach([&](TVertexType const & v, VertexState const & forwardState) {
+    auto const * backwardState = backwardVertices.Find(v);
+    if (backwardState == nullptr || !forwardState.hasParent ||
+        !isPlateauEdge(forwardState.parent, v))
+    {
+      return;
+    }
+
+    if (backwardState->hasParent && isPlateauEdge(v, backwardState->parent))
+      return;
+
+    auto const distance = getRealDistance(forward, v) + getRealDistance(backward, v);
+    if (distance > maxDistance)
+      return;
+
+    TVertexType first = forwardState.parent;
+    while (true)
+    {
+      auto const * state = forwardVertices.Find(first);
+      CHECK(state, ());
+      if (!state->hasParent || !isPlateauEdge(state->parent, first))
+        break;
+      first = state->parent;
+    }
+
+    if (getRealDistance(forward, v) - getRealDistance(forward, first) < minPlateau)
+      return;
+
+    candidates.emplace_back(distance, v);
+  });
+
+  std::sort(candidates.begin(), candidates.end(),
+            [](std::pair<TWeightType, TVertexType> const & lhs,
+               std::pair<TWeightType, TVertexType> const & rhs) { return lhs.first < rhs.first; });
+
+  std::set<std::pair<TVertexType, TVertexType>> usedEdges;
+  auto const addEdges = [&usedEdges](std::vector<TVertexType> const & path) {
+    for (size_t i = 1; i < path.size(); ++i)
+      usedEdges.emplace(path[i - 1], path[i]);
+  };
+  addEdges(result.path);
+
+  std::vector<TVertexType> path;
+  std::vector<TVertexType> sortedPath;
+  for (auto const & candidate : candidates)
+  {
+    if (alternatives.size() >= params.m_maxAlternatives)
+      break;
+
+    TVertexType const & v = candidate.second;
+    path.clear();
+    forward.ReconstructReversedPath(v, path);
+    std::reverse(path.begin(), path.end());
+    size_t const forwardSize = path.size();
+    auto const * backwardState = backwardVertices.Find(v);
+    CHECK(backwardState, ());
+    if (backwardState->hasParent)
+      backward.ReconstructReversedPath(backwardState->parent, path);
+
+    // The parts of the path from the trees may intersect.
+    sortedPath = path;
+    std::sort(sortedPath.begin(), sortedPath.end());
+    if (std::adjacent_find(sortedPath.begin(), sortedPath.end()) != sortedPath.end())
+      continue;
+
+    auto sharedDistance = kZeroDistance;
+    for (size_t i = 1; i < path.size(); ++i)
+    {
+      if (usedEdges.count(std::make_pair(path[i - 1], path[i])) == 0)
+        continue;
+
+      if (i < forwardSize)
+        sharedDistance += getRealDistance(forward, path[i]) - getRealDistance(forward, path[i - 1]);
+      else
+        sharedDistance += getRealDistance(backward, path[i - 1]) - getRealDistance(backward, path[i]);
+    }
+
+    if (sharedDistance > params.m_maxSharing * candidate.first)
+      continue;
+
+    addEdges(path);
+    alternatives.emplace_back();
+    alternatives.back().path = path;
+    alternatives.back().distance = candidate.first;
+  }
+}
+
+template <typename TGraph>
+typename AStarAlgorithm<TGraph>::Result AStarAlgorithm<TGraph>::FindPathBidirectionalParallel(
+    TGraphType & forwardGraph, TGraphType & backwardGraph, TVertexType const & startVertex,
+    TVertexType const & finalVertex, RoutingResult<TVertexType, TWeightType> & result,
+    my::Cancellable const & cancellable, TOnVisitedVertexCallback onVisitedVertexCallback) const
+{
+  if (nullptr == onVisitedVertexCallback)
+    onVisitedVertexCallback = [](TVertexType const &, TVertexType const &){};
+
+  BidirectionalContext context;
+  BidirectionalStepContext forward(true /* forward */, startVertex, finalVertex, forwardGraph,
+                                   context.GetWave(true /* forward */));
+  BidirectionalStepContext backward(false /* forward */, startVertex, finalVertex, backwardGraph,
+                                    context.GetWave(false /* forward */));
+
+  forward.SetDistance(startVertex, kZeroDistance);
+  forward.PushQueue(startVertex, kZeroDistance);
+
+  backward.SetDistance(finalVertex, kZeroDistance);
+  backward.PushQueue(finalVertex, kZeroDistance);
+
+  ParallelSearchState state;
+  auto const propagate = [&](BidirectionalStepContext & cur, BidirectionalStepContext & nxt) {
+    try
+    {
+      PropagateParallelWave(cur, nxt, state, cancellable, onVisitedVertexCallback);
+    }
+    catch (...)
+    {
+      std::lock_guard<std::mutex> guard(state.m_mutex);
+      if (!state.m_exception)
+        state.m_exception = std::current_exception();
+      state.m_stop = true;
+    }
+  };
+
+  threads::SimpleThread forwardThread([&]() { propagate(forward, backward); });
+  propagate(backward, forward);
+  forwardThread.join();
+
+  if (state.m_exception)
+    std::rethrow_exception(state.m_exception);
+
+  if (state.m_cancelled)
+    return Result::Cancelled;
+
+  if (!state.m_foundAnyPath)
+    return Result::NoPath;
+
+  ReconstructPathBidirectional(forward, backward, result.path);
+  result.distance = state.m_bestPathRealLength;
+  CHECK(!result.path.empty(), ());
+  return Result::OK;
+}
+
+template <typename TGraph>
+void AStarAlgorithm<TGraph>::PropagateParallelWave(
+    BidirectionalStepContext & cur, BidirectionalStepContext & nxt, ParallelSearchState & state,
+    my::Cancellable const & cancellable,
+    TOnVisitedVertexCallback const & onVisitedVertexCallback) const
+{
+  size_t const curIdx = cur.forward ? 0 : 1;
+  size_t const nxtIdx = 1 - curIdx;
+  // p_f(v) + p_r(v) is the same for all the vertices. See BidirectionalStepContext.
+  TWeightType const heuristicSum = 0.5 * (cur.m_piRT + cur.m_piFS);
+
+  PeriodicPollCancellable periodicCancellable(cancellable);
+  std::vector<TEdgeType> adj;
+  std::vector<TWeightType> potentials;
+
+  while (true)
+  {
+    bool const cancelled = periodicCancellable.IsCancelled();
+
+    typename BidirectionalStepContext::QueueState stateV(TVertexType(), kZeroDistance);
+    {
+      std::lock_guard<std::mutex> guard(state.m_mutex);
+      if (state.m_stop)
+        return;
+
+      if (cancelled)
+      {
+        state.m_cancelled = true;
+        state.m_stop = true;
+        return;
+      }
+
+      // If one of the queues is exhausted all the vertices reachable from its source are settled,
+      // so the best path found so far (if any) is the shortest one.
+      if (cur.IsQueueEmpty())
+      {
+        state.m_stop = true;
+        return;
+      }
+
+      // The settled distance of the other wave is not greater than its queue top distance,
+      // so the check is not weaker than the one in FindPathBidirectional().
+      if (state.m_foundAnyPath &&
+          cur.TopDistance() + state.m_settledDistance[nxtIdx] >=
+              state.m_bestPathReducedLength - kEpsilon)
+      {
+        state.m_stop = true;
+        return;
+      }
+
+      stateV = cur.PopQueue();
+      auto const * const distV = cur.FindDistance(stateV.vertex);
+      CHECK(distV, ());
+      if (stateV.distance > *distV)
+        continue;
+
+      state.m_settledDistance[curIdx] = stateV.distance;
+      onVisitedVertexCallback(stateV.vertex, cur.forward ? cur.finalVertex : cur.startVertex);
+    }
+
+    // Getting edges and heuristics is the most expensive part of a step. It's done without
+    // the lock on the graph of the wave.
+    cur.GetAdjacencyList(stateV.vertex, adj);
+    auto const pV = cur.ConsistentHeuristic(stateV.vertex);
+    potentials.clear();
+    for (auto const & edge : adj)
+      potentials.push_back(cur.ConsistentHeuristic(edge.GetTarget()));
+
+    std::lock_guard<std::mutex> guard(state.m_mutex);
+    for (size_t i = 0; i < adj.size(); ++i)
+    {
+      TVertexType const & vertexW = adj[i].GetTarget();
+      if (stateV.vertex == vertexW)
+        continue;
+
+      auto const len = adj[i].GetWeight();
+      auto const pW = potentials[i];
+      auto const reducedLen = len + pW - pV;
+
+      CHECK(reducedLen >= -kEpsilon, ("Invariant violated:", reducedLen, "<", -kEpsilon));
+      auto const newReducedDist = stateV.distance + std::max(reducedLen, kZeroDistance);
+
+      auto const * const curDistW = cur.FindDistance(vertexW);
+      if (curDistW != nullptr && newReducedDist >= *curDistW - kEpsilon)
+        continue;
+
+      auto const * const nxtDistW = nxt.FindDistance(vertexW);
+      if (nxtDistW != nullptr)
+      {
+        auto const distW = *nxtDistW;
+        auto const curPathReducedLength = newReducedDist + distW;
+        if (!state.m_foundAnyPath || state.m_bestPathReducedLength > curPathReducedLength)
+        {
+          state.m_bestPathReducedLength = curPathReducedLength;
+          state.m_bestPathRealLength = stateV.distance + len + distW;
+          state.m_bestPathRealLength += cur.pS - pV;
+          // The heuristic of the other wave is calculated without the graph of the other wave.
+          state.m_bestPathRealLength += nxt.pS - (heuristicSum - pW);
+
+          state.m_foundAnyPath = true;
+          cur.bestVertex = stateV.vertex;
+          nxt.bestVertex = vertexW;
+        }
+      }
+
+      cur.SetDistanceAndParent(vertexW, newReducedDist, stateV.vertex);
+      cur.PushQueue(vertexW, newReducedDist);
+    }
+  }
+}
+
 template <typename TGraph>
 typename AStarAlgorithm<TGraph>::Result AStarAlgorithm<TGraph>::AdjustRoute(
     TGraphType & graph, TVertexType const & startVertex, std::vector<TEdgeType> const & prevRoute,
@@ -625,19 +1172,14 @@ void AStarAlgorithm<TGraph>::ReconstructPath(TVertexType const & v,
 
 // static
 template <typename TGraph>
-void AStarAlgorithm<TGraph>::ReconstructPathBidirectional(
-    TVertexType const & v, TVertexType const & w,
-    std::map<TVertexType, TVertexType> const & parentV,
-    std::map<TVertexType, TVertexType> const & parentW, std::vector<TVertexType> & path)
+void AStarAlgorithm<TGraph>::ReconstructPathBidirectional(BidirectionalStepContext const & cur,
+                                                          BidirectionalStepContext const & nxt,
+                                                          std::vector<TVertexType> & path)
 {
-  std::vector<TVertexType> pathV;
-  ReconstructPath(v, parentV, pathV);
-  std::vector<TVertexType> pathW;
-  ReconstructPath(w, parentW, pathW);
   path.clear();
-  path.reserve(pathV.size() + pathW.size());
-  path.insert(path.end(), pathV.begin(), pathV.end());
-  path.insert(path.end(), pathW.rbegin(), pathW.rend());
+  cur.ReconstructReversedPath(cur.bestVertex, path);
+  reverse(path.begin(), path.end());
+  nxt.ReconstructReversedPath(nxt.bestVertex, path);
 }
 
 template <typename TGraph>
@@ -0,0 +1,78 @@
+#pragma once
+
+#include "base/assert.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace routing
+{
+// EytzingerMap is a static sorted map which keeps the pairs in the Eytzinger (breadth-first)
+// order of the implicit binary search tree. The first levels of the tree which are visited by
+// every search are packed together, so a search touches much fewer cache lines than
+// std::lower_bound() over a sorted vector or std::map. The map is built once and can't be changed.
+template <typename Key, typename Value>
+class EytzingerMap final
+{
+public:
+  // |pairs| should be sorted by keys and keys should be unique.
+  void Build(std::vector<std::pair<Key, Value>> const & pairs)
+  {
+    ASSERT(std::is_sorted(pairs.cbegin(), pairs.cend(),
+                          [](std::pair<Key, Value> const & lhs, std::pair<Key, Value> const & rhs) {
+                            return lhs.first < rhs.first;
+                          }),
+           ());
+
+    // The tree is 1-based: children of the node i are 2i and 2i + 1.
+    m_keys.assign(pairs.size() + 1, Key());
+    m_values.assign(pairs.size() + 1, Value());
+    size_t pos = 0;
+    Fill(pairs, 1 /* node */, pos);
+    ASSERT_EQUAL(pos, pairs.size(), ());
+  }
+
+  void Clear()
+  {
+    m_keys.clear();
+    m_values.clear();
+  }
+
+  bool IsEmpty() const { return GetSize() == 0; }
+  size_t GetSize() const { return m_keys.empty() ? 0 : m_keys.size() - 1; }
+
+  // Returns nullptr if there is no |key| in the map.
+  Value const * Find(Key const & key) const
+  {
+    size_t const size = m_keys.size();
+    size_t node = 1;
+    while (node < size)
+    {
+      if (m_keys[node] == key)
+        return &m_values[node];
+      node = 2 * node + (m_keys[node] < key ? 1 : 0);
+    }
+    return nullptr;
+  }
+
+private:
+  // In-order traversal of the tree visits the nodes in the ascending order of keys.
+  void Fill(std::vector<std::pair<Key, Value>> const & pairs, size_t node, size_t & pos)
+  {
+    if (node >= m_keys.size())
+      return;
+
+    Fill(pairs, 2 * node, pos);
+    m_keys[node] = pairs[pos].first;
+    m_values[node] = pairs[pos].second;
+    ++pos;
+    Fill(pairs, 2 * node + 1, pos);
+  }
+
+  // Keys are kept apart from values to make the search denser.
+  std::vector<Key> m_keys;
+  std::vector<Value> m_values;
+};
+}  // namespace routing
@@ -8,6 +8,13 @@ namespace routing
 using namespace std;
 using Iter = routing::FollowedPolyline::Iter;
 
+namespace
+{
+size_t constexpr kSegmentsInBlock = 32;
+// Block rects are inflated to not miss projections on their borders because of rounding errors.
+double constexpr kBlockRectEps = 1e-9;
+}  // namespace
+
 Iter FollowedPolyline::Begin() const
 {
   ASSERT(IsValid(), ());
@@ -77,6 +84,7 @@ void FollowedPolyline::Swap(FollowedPolyline & rhs)
   m_poly.Swap(rhs.m_poly);
   m_segDistance.swap(rhs.m_segDistance);
   m_segProj.swap(rhs.m_segProj);
+  m_blockRects.swap(rhs.m_blockRects);
   swap(m_current, rhs.m_current);
   swap(m_nextCheckpointIndex, rhs.m_nextCheckpointIndex);
 }
@@ -89,6 +97,7 @@ void FollowedPolyline::Update()
 
   m_segDistance.resize(n);
   m_segProj.resize(n);
+  m_blockRects.assign((n + kSegmentsInBlock - 1) / kSegmentsInBlock, m2::RectD());
 
   double dist = 0.0;
   for (size_t i = 0; i < n; ++i)
@@ -100,8 +109,15 @@ void FollowedPolyline::Update()
 
     m_segDistance[i] = dist;
     m_segProj[i].SetBounds(p1, p2);
+
+    m2::RectD & blockRect = m_blockRects[i / kSegmentsInBlock];
+    blockRect.Add(p1);
+    blockRect.Add(p2);
   }
 
+  for (auto & blockRect : m_blockRects)
+    blockRect.Inflate(kBlockRectEps, kBlockRectEps);
+
   m_current = Iter(m_poly.Front(), 0);
 }
 
@@ -118,19 +134,28 @@ Iter FollowedPolyline::GetClosestProjectionInInterval(m2::RectD const & posRect,
 
   m2::PointD const currPos = posRect.Center();
 
-  for (size_t i = startIdx; i < endIdx; ++i)
+  // A projection inside |posRect| lies on a segment, so blocks which don't intersect
+  // |posRect| are skipped entirely.
+  for (size_t block = startIdx / kSegmentsInBlock; block * kSegmentsInBlock < endIdx; ++block)
   {
-    m2::PointD const pt = m_segProj[i](currPos);
-
-    if (!posRect.IsPointInside(pt))
+    if (!m_blockRects[block].IsIntersect(posRect))
       continue;
 
-    Iter it(pt, i);
-    double const dp = distFn(it);
-    if (dp < minDist)
+    size_t const blockEnd = min(endIdx, (block + 1) * kSegmentsInBlock);
+    for (size_t i = max(startIdx, block * kSegmentsInBlock); i < blockEnd; ++i)
     {
-      res = it;
-      minDist = dp;
+      m2::PointD const pt = m_segProj[i](currPos);
+
+      if (!posRect.IsPointInside(pt))
+        continue;
+
+      Iter it(pt, i);
+      double const dp = distFn(it);
+      if (dp < minDist)
+      {
+        res = it;
+        minDist = dp;
+      }
     }
   }
 
@@ -4,6 +4,7 @@
 
 #include "geometry/point2d.hpp"
 #include "geometry/polyline2d.hpp"
+#include "geometry/rect2d.hpp"
 
 #include <vector>
 
@@ -101,6 +102,9 @@ private:
   std::vector<m2::ProjectionToSection<m2::PointD>> m_segProj;
   /// Accumulated cache of segments length in meters.
   std::vector<double> m_segDistance;
+  /// Bounding rects of blocks of consecutive segments. Only segments of blocks intersecting
+  /// a position rect are projected, so a search along a long route is cheap.
+  std::vector<m2::RectD> m_blockRects;
 };
 
 }  // namespace routing
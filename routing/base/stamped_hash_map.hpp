@@ -0,0 +1,130 @@
+#pragma once
+
+#include "base/assert.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace routing
+{
+// StampedHashMap is an open addressing hash map with linear probing. Every slot keeps the stamp
+// of the Clear() generation it was filled in, so Clear() takes O(1) and keeps the allocated
+// memory. It makes the map suitable for search states which are reused by many queries.
+// Erasing of single keys is not supported.
+template <typename Key, typename Value, typename Hash = std::hash<Key>>
+class StampedHashMap final
+{
+public:
+  void Clear()
+  {
+    m_size = 0;
+    ++m_stamp;
+    if (m_stamp != 0)
+      return;
+
+    // Stamps overflowed. All the slots should be marked as empty explicitly.
+    for (auto & slot : m_slots)
+      slot.m_stamp = 0;
+    m_stamp = 1;
+  }
+
+  size_t GetSize() const { return m_size; }
+  bool IsEmpty() const { return m_size == 0; }
+
+  Value const * Find(Key const & key) const
+  {
+    if (m_slots.empty())
+      return nullptr;
+
+    Slot const & slot = m_slots[FindSlot(key)];
+    return IsFilled(slot) ? &slot.m_value : nullptr;
+  }
+
+  Value * Find(Key const & key)
+  {
+    return const_cast<Value *>(static_cast<StampedHashMap const *>(this)->Find(key));
+  }
+
+  // Returns the value of |key|. Inserts default-constructed value if there is no |key| in the map.
+  Value & operator[](Key const & key)
+  {
+    if ((m_size + 1) * kMaxLoadFactorInv > m_slots.size())
+      Grow();
+
+    Slot & slot = m_slots[FindSlot(key)];
+    if (!IsFilled(slot))
+    {
+      slot.m_key = key;
+      slot.m_value = Value();
+      slot.m_stamp = m_stamp;
+      ++m_size;
+    }
+    return slot.m_value;
+  }
+
+  // Calls |fn| for every key and its value. It takes time proportional to the capacity of the map.
+  template <typename Fn>
+  void ForEach(Fn && fn) const
+  {
+    for (auto const & slot : m_slots)
+    {
+      if (IsFilled(slot))
+        fn(slot.m_key, slot.m_value);
+    }
+  }
+
+private:
+  static size_t constexpr kInitialCapacity = 1024;
+  // The map is grown when more than half of the slots are filled.
+  static size_t constexpr kMaxLoadFactorInv = 2;
+
+  struct Slot
+  {
+    Key m_key = Key();
+    Value m_value = Value();
+    uint32_t m_stamp = 0;
+  };
+
+  bool IsFilled(Slot const & slot) const { return slot.m_stamp == m_stamp; }
+
+  // Returns the slot of |key| or the empty slot |key| should be placed to.
+  size_t FindSlot(Key const & key) const
+  {
+    ASSERT(!m_slots.empty(), ());
+    size_t const mask = m_slots.size() - 1;
+    // Fibonacci hashing spreads close hash values (like sequential ids) over the table.
+    uint64_t const hash = static_cast<uint64_t>(m_hash(key)) * 0x9E3779B97F4A7C15ULL;
+    size_t idx = static_cast<size_t>(hash >> 32) & mask;
+    while (IsFilled(m_slots[idx]) && !(m_slots[idx].m_key == key))
+      idx = (idx + 1) & mask;
+    return idx;
+  }
+
+  void Grow()
+  {
+    std::vector<Slot> slots(m_slots.empty() ? kInitialCapacity : m_slots.size() * 2);
+    std::swap(slots, m_slots);
+    uint32_t const prevStamp = m_stamp;
+    m_stamp = 1;
+
+    for (auto & slot : slots)
+    {
+      if (slot.m_stamp != prevStamp)
+        continue;
+
+      Slot & newSlot = m_slots[FindSlot(slot.m_key)];
+      newSlot.m_key = std::move(slot.m_key);
+      newSlot.m_value = std::move(slot.m_value);
+      newSlot.m_stamp = m_stamp;
+    }
+  }
+
+  std::vector<Slot> m_slots;
+  uint32_t m_stamp = 1;
+  size_t m_size = 0;
+  Hash m_hash;
+};
+}  // namespace routing
@@ -19,6 +19,7 @@
 
 #include "geometry/point2d.hpp"
 
+#include <algorithm>
 #include <cstdlib>
 #include <numeric>
 #include <utility>
@@ -159,6 +160,7 @@ bool BicycleDirectionsEngine::Generate(RoadGraphBase const & graph, vector<Junct
 {
   m_adjacentEdges.clear();
   m_pathSegments.clear();
+  m_featureAttrs.clear();
   turns.clear();
   streetNames.clear();
   routeGeometry.clear();
@@ -207,23 +209,54 @@ Index::FeaturesLoaderGuard & BicycleDirectionsEngine::GetLoader(MwmSet::MwmId co
   return *m_loader;
 }
 
-void BicycleDirectionsEngine::LoadPathAttributes(FeatureID const & featureId, LoadedPathSegment & pathSegment)
+void BicycleDirectionsEngine::LoadFeatureAttrs(vector<FeatureID> & featureIds)
 {
-  if (!featureId.IsValid())
-    return;
+  sort(featureIds.begin(), featureIds.end());
+  featureIds.erase(unique(featureIds.begin(), featureIds.end()), featureIds.end());
 
-  FeatureType ft;
-  if(!GetLoader(featureId.m_mwmId).GetFeatureByIndex(featureId.m_index, ft))
-    return;
+  m_featureAttrs.clear();
+  m_featureAttrs.reserve(featureIds.size());
+  for (auto const & featureId : featureIds)
+  {
+    if (!featureId.IsValid())
+      continue;
+
+    FeatureType ft;
+    if (!GetLoader(featureId.m_mwmId).GetFeatureByIndex(featureId.m_index, ft))
+      continue;
+
+    FeatureAttrs attrs;
+    attrs.m_highwayClass = ftypes::GetHighwayClass(ft);
+    ASSERT_NOT_EQUAL(attrs.m_highwayClass, ftypes::HighwayClass::Error, ());
+    ASSERT_NOT_EQUAL(attrs.m_highwayClass, ftypes::HighwayClass::Undefined, ());
+    attrs.m_isLink = ftypes::IsLinkChecker::Instance()(ft);
+    attrs.m_onRoundabout = ftypes::IsRoundAboutChecker::Instance()(ft);
+    ft.GetName(FeatureType::DEFAULT_LANG, attrs.m_name);
+    m_featureAttrs.emplace_back(featureId, move(attrs));
+  }
+}
 
-  auto const highwayClass = ftypes::GetHighwayClass(ft);
-  ASSERT_NOT_EQUAL(highwayClass, ftypes::HighwayClass::Error, ());
-  ASSERT_NOT_EQUAL(highwayClass, ftypes::HighwayClass::Undefined, ());
+BicycleDirectionsEngine::FeatureAttrs const * BicycleDirectionsEngine::GetFeatureAttrs(
+    FeatureID const & featureId) const
+{
+  auto const it = lower_bound(
+      m_featureAttrs.cbegin(), m_featureAttrs.cend(), featureId,
+      [](pair<FeatureID, FeatureAttrs> const & p, FeatureID const & id) { return p.first < id; });
+  if (it == m_featureAttrs.cend() || it->first != featureId)
+    return nullptr;
+  return &it->second;
+}
+
+void BicycleDirectionsEngine::LoadPathAttributes(FeatureID const & featureId, LoadedPathSegment & pathSegment)
+{
+  FeatureAttrs const * attrs = GetFeatureAttrs(featureId);
+  if (attrs == nullptr)
+    return;
 
-  pathSegment.m_highwayClass = highwayClass;
-  pathSegment.m_isLink = ftypes::IsLinkChecker::Instance()(ft);
-  ft.GetName(FeatureType::DEFAULT_LANG, pathSegment.m_name);
-  pathSegment.m_onRoundabout = ftypes::IsRoundAboutChecker::Instance()(ft);
+  pathSegment.m_highwayClass = attrs->m_highwayClass;
+  pathSegment.m_isLink = attrs->m_isLink;
+  pathSegment.m_name = attrs->m_name;
+  pathSegment.m_onRoundabout = attrs->m_onRoundabout;
 }
 
 void BicycleDirectionsEngine::GetUniNodeIdAndAdjacentEdges(IRoadGraph::TEdgeVector const & outgoingEdges,
@@ -245,14 +278,11 @@ void BicycleDirectionsEngine::GetUniNodeIdAndAdjacentEdges(IRoadGraph::TEdgeVect
     if (edge.IsFake())
       continue;
 
-    auto const & outFeatureId = edge.GetFeatureId();
-    FeatureType ft;
-    if (!GetLoader(outFeatureId.m_mwmId).GetFeatureByIndex(outFeatureId.m_index, ft))
+    FeatureAttrs const * attrs = GetFeatureAttrs(edge.GetFeatureId());
+    if (attrs == nullptr)
       continue;
 
-    auto const highwayClass = ftypes::GetHighwayClass(ft);
-    ASSERT_NOT_EQUAL(highwayClass, ftypes::HighwayClass::Error, ());
-    ASSERT_NOT_EQUAL(highwayClass, ftypes::HighwayClass::Undefined, ());
+    auto const highwayClass = attrs->m_highwayClass;
 
     double angle = 0;
 
@@ -294,7 +324,13 @@ void BicycleDirectionsEngine::FillPathSegmentsAndAdjacentEdgesMap(
   size_t const pathSize = path.size();
   CHECK_GREATER(pathSize, 1, ());
   CHECK_EQUAL(routeEdges.size() + 1, pathSize, ());
-  // Filling |m_adjacentEdges|.
+
+  // Joints of the path and their adjacent edges are gathered first. Then the features of all
+  // the joints are read in one go, so every feature is read once even if it's adjacent to many
+  // joints.
+  vector<PathJoint> joints;
+  vector<FeatureID> featureIds;
+
   auto constexpr kInvalidSegId = numeric_limits<uint32_t>::max();
   // |startSegId| is a value to keep start segment id of a new instance of LoadedPathSegment.
   uint32_t startSegId = kInvalidSegId;
@@ -335,31 +371,58 @@ void BicycleDirectionsEngine::FillPathSegmentsAndAdjacentEdgesMap(
 
     prevJunctions.push_back(currJunction);
 
-    AdjacentEdges adjacentEdges(ingoingEdges.size());
+    featureIds.push_back(inFeatureId);
+    for (auto const & edge : outgoingEdges)
+    {
+      if (!edge.IsFake())
+        featureIds.push_back(edge.GetFeatureId());
+    }
+
+    joints.emplace_back();
+    PathJoint & joint = joints.back();
+    joint.m_inEdgeIdx = i - 1;
+    joint.m_startSegId = startSegId;
+    joint.m_junctions = move(prevJunctions);
+    joint.m_segments = move(prevSegments);
+    joint.m_outgoingEdges = move(outgoingEdges);
+    joint.m_ingoingEdgesCount = ingoingEdges.size();
+
+    prevJunctions.clear();
+    prevSegments.clear();
+    startSegId = kInvalidSegId;
+  }
+
+  if (cancellable.IsCancelled())
+    return;
+
+  LoadFeatureAttrs(featureIds);
+
+  // Filling |m_adjacentEdges| and |m_pathSegments|.
+  for (auto & joint : joints)
+  {
+    Edge const & inEdge = routeEdges[joint.m_inEdgeIdx];
+
+    AdjacentEdges adjacentEdges(joint.m_ingoingEdgesCount);
     UniNodeId uniNodeId(UniNodeId::Type::Mwm);
-    GetUniNodeIdAndAdjacentEdges(outgoingEdges, inEdge, startSegId, inSegId, uniNodeId,
-                                 adjacentEdges.m_outgoingTurns);
+    GetUniNodeIdAndAdjacentEdges(joint.m_outgoingEdges, inEdge, joint.m_startSegId,
+                                 inEdge.GetSegId(), uniNodeId, adjacentEdges.m_outgoingTurns);
 
-    size_t const prevJunctionSize = prevJunctions.size();
+    size_t const prevJunctionSize = joint.m_junctions.size();
     LoadedPathSegment pathSegment(UniNodeId::Type::Mwm);
     LoadPathAttributes(uniNodeId.GetFeature(), pathSegment);
     pathSegment.m_nodeId = uniNodeId;
-    pathSegment.m_path = move(prevJunctions);
+    pathSegment.m_path = move(joint.m_junctions);
     // @TODO(bykoianko) |pathSegment.m_weight| should be filled here.
 
-    // |prevSegments| contains segments which corresponds to road edges between joints. In case of a fake edge
-    // a fake segment is created.
-    CHECK_EQUAL(prevSegments.size() + 1, prevJunctionSize, ());
-    pathSegment.m_segments = move(prevSegments);
+    // |m_segments| contains segments which corresponds to road edges between joints. In case of
+    // a fake edge a fake segment is created.
+    CHECK_EQUAL(joint.m_segments.size() + 1, prevJunctionSize, ());
+    pathSegment.m_segments = move(joint.m_segments);
 
     auto const it = m_adjacentEdges.insert(make_pair(uniNodeId, move(adjacentEdges)));
     ASSERT(it.second, ());
     UNUSED_VALUE(it);
     m_pathSegments.push_back(move(pathSegment));
-
-    prevJunctions.clear();
-    prevSegments.clear();
-    startSegId = kInvalidSegId;
   }
 }
 }  // namespace routing
@@ -5,10 +5,15 @@
 #include "routing/num_mwm_id.hpp"
 #include "routing/turn_candidate.hpp"
 
+#include "indexer/ftypes_matcher.hpp"
 #include "indexer/index.hpp"
 
+#include <cstdint>
 #include <map>
 #include <memory>
+#include <string>
+#include <utility>
+#include <vector>
 
 namespace routing
 {
@@ -34,7 +39,32 @@ public:
                 vector<Segment> & segments) override;
 
 private:
+  // Attributes of a road which are used for turn generation.
+  struct FeatureAttrs
+  {
+    ftypes::HighwayClass m_highwayClass = ftypes::HighwayClass::Undefined;
+    bool m_isLink = false;
+    bool m_onRoundabout = false;
+    std::string m_name;
+  };
+
+  // The end of a LoadedPathSegment of the path with its adjacent edges.
+  struct PathJoint
+  {
+    size_t m_inEdgeIdx = 0;
+    uint32_t m_startSegId = 0;
+    std::vector<Junction> m_junctions;
+    std::vector<Segment> m_segments;
+    IRoadGraph::TEdgeVector m_outgoingEdges;
+    size_t m_ingoingEdgesCount = 0;
+  };
+
   Index::FeaturesLoaderGuard & GetLoader(MwmSet::MwmId const & id);
+  /// \brief Loads attributes of |featureIds| to |m_featureAttrs|. Features are read in order
+  /// of mwms and feature ids, every feature is read once.
+  void LoadFeatureAttrs(std::vector<FeatureID> & featureIds);
+  /// \returns nullptr if the feature of |featureId| can't be read.
+  FeatureAttrs const * GetFeatureAttrs(FeatureID const & featureId) const;
   void LoadPathAttributes(FeatureID const & featureId, LoadedPathSegment & pathSegment);
   void GetUniNodeIdAndAdjacentEdges(IRoadGraph::TEdgeVector const & outgoingEdges,
                                     Edge const & inEdge,
@@ -58,5 +88,7 @@ private:
   Index const & m_index;
   std::shared_ptr<NumMwmIds> m_numMwmIds;
   std::unique_ptr<Index::FeaturesLoaderGuard> m_loader;
+  // Sorted by feature ids.
+  std::vector<std::pair<FeatureID, FeatureAttrs>> m_featureAttrs;
 };
 }  // namespace routing
@@ -0,0 +1,81 @@
+#include "routing/cross_mwm_connector_cache.hpp"
+
+#include "base/assert.hpp"
+
+using namespace std;
+
+namespace routing
+{
+// static
+size_t constexpr CrossMwmConnectorCache::kDefaultMaxSize;
+
+// static
+CrossMwmConnectorCache & CrossMwmConnectorCache::Instance()
+{
+  static CrossMwmConnectorCache cache;
+  return cache;
+}
+
+CrossMwmConnectorCache::CrossMwmConnectorCache(size_t maxSize) : m_maxSize(maxSize)
+{
+  CHECK_GREATER(m_maxSize, 0, ());
+}
+
+shared_ptr<CrossMwmConnector const> CrossMwmConnectorCache::Get(Key const & key)
+{
+  lock_guard<mutex> lock(m_mutex);
+  auto const it = m_index.find(key);
+  if (it == m_index.cend())
+  {
+    ++m_stats.m_misses;
+    return nullptr;
+  }
+
+  ++m_stats.m_hits;
+  m_entries.splice(m_entries.begin(), m_entries, it->second);
+  return it->second->second;
+}
+
+void CrossMwmConnectorCache::Put(Key const & key, shared_ptr<CrossMwmConnector const> connector)
+{
+  CHECK(connector, ());
+
+  lock_guard<mutex> lock(m_mutex);
+  auto const it = m_index.find(key);
+  if (it != m_index.cend())
+  {
+    it->second->second = move(connector);
+    m_entries.splice(m_entries.begin(), m_entries, it->second);
+    return;
+  }
+
+  if (m_entries.size() == m_maxSize)
+  {
+    m_index.erase(m_entries.back().first);
+    m_entries.pop_back();
+  }
+
+  m_entries.emplace_front(key, move(connector));
+  m_index.emplace(key, m_entries.begin());
+}
+
+void CrossMwmConnectorCache::Clear()
+{
+  lock_guard<mutex> lock(m_mutex);
+  m_index.clear();
+  m_entries.clear();
+  m_stats = Stats();
+}
+
+size_t CrossMwmConnectorCache::GetSize() const
+{
+  lock_guard<mutex> lock(m_mutex);
+  return m_entries.size();
+}
+
+CrossMwmConnectorCache::Stats CrossMwmConnectorCache::GetStats() const
+{
+  lock_guard<mutex> lock(m_mutex);
+  return m_stats;
+}
+}  // namespace routing
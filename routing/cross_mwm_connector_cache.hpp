@@ -0,0 +1,83 @@
+#pragma once
+
+#include "routing/cross_mwm_connector.hpp"
+#include "routing/num_mwm_id.hpp"
+#include "routing/vehicle_mask.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <utility>
+
+namespace routing
+{
+// CrossMwmConnectorCache keeps the deserialized connectors of the recently used mwms.
+// The cache is process-wide and is shared between routers, so the connectors survive
+// WorldGraph::ClearIndexGraphs() and router re-creation. When the cache is full the least
+// recently used connector is dropped.
+// Cached connectors are never changed, so they may be read from many threads. A connector with
+// loaded weights is put to the cache instead of the connector with transitions only.
+class CrossMwmConnectorCache final
+{
+public:
+  // Segments of a connector keep NumMwmId, so a connector may be reused only by the routers with
+  // the same mwm numeration. The country name and the version of the mwm are a part of the key
+  // to distinguish numerations and to skip connectors of updated mwms.
+  struct Key
+  {
+    Key(std::string const & countryName, NumMwmId mwmId, int64_t version, VehicleType vehicleType)
+      : m_countryName(countryName), m_mwmId(mwmId), m_version(version), m_vehicleType(vehicleType)
+    {
+    }
+
+    bool operator<(Key const & rhs) const
+    {
+      return std::tie(m_mwmId, m_version, m_vehicleType, m_countryName) <
+             std::tie(rhs.m_mwmId, rhs.m_version, rhs.m_vehicleType, rhs.m_countryName);
+    }
+
+    std::string m_countryName;
+    NumMwmId m_mwmId;
+    int64_t m_version;
+    VehicleType m_vehicleType;
+  };
+
+  struct Stats
+  {
+    uint64_t m_hits = 0;
+    uint64_t m_misses = 0;
+  };
+
+  static size_t constexpr kDefaultMaxSize = 32;
+
+  static CrossMwmConnectorCache & Instance();
+
+  explicit CrossMwmConnectorCache(size_t maxSize = kDefaultMaxSize);
+
+  // Returns nullptr if there's no connector for |key|.
+  std::shared_ptr<CrossMwmConnector const> Get(Key const & key);
+  // Replaces the connector of |key| if it's already in the cache.
+  void Put(Key const & key, std::shared_ptr<CrossMwmConnector const> connector);
+  void Clear();
+
+  size_t GetSize() const;
+  Stats GetStats() const;
+
+private:
+  using Entry = std::pair<Key, std::shared_ptr<CrossMwmConnector const>>;
+  using Entries = std::list<Entry>;
+
+  size_t const m_maxSize;
+
+  mutable std::mutex m_mutex;
+  // The most recently used entry is the first one.
+  Entries m_entries;
+  std::map<Key, Entries::iterator> m_index;
+  Stats m_stats;
+};
+}  // namespace routing
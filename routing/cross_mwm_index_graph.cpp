@@ -24,7 +24,7 @@ void CrossMwmIndexGraph::GetTwinsByOsmId(Segment const & s, bool isOutgoing,
     auto const it = m_connectors.find(neighbor);
     CHECK(it != m_connectors.cend(), ("Connector for", m_numMwmIds->GetFile(neighbor), "was not deserialized."));
 
-    CrossMwmConnector const & connector = it->second;
+    CrossMwmConnector const & connector = *it->second;
     // Note. Last parameter in the method below (isEnter) should be set to |isOutgoing|.
     // If |isOutgoing| == true |s| should be an exit transition segment and the method below searches enters
     // and the last parameter (|isEnter|) should be set to true.
@@ -47,14 +47,27 @@ void CrossMwmIndexGraph::GetEdgeList(Segment const & s, bool isOutgoing,
 }
 
 CrossMwmConnector const & CrossMwmIndexGraph::GetCrossMwmConnectorWithTransitions(NumMwmId numMwmId)
+{
+  return *GetConnector(numMwmId);
+}
+
+shared_ptr<CrossMwmConnector const> CrossMwmIndexGraph::GetConnector(NumMwmId numMwmId)
 {
   auto const it = m_connectors.find(numMwmId);
   if (it != m_connectors.cend())
     return it->second;
 
-  return Deserialize(
-      numMwmId,
-      CrossMwmConnectorSerializer::DeserializeTransitions<ReaderSourceFile>);
+  MwmSet::MwmHandle const handle = GetMwmHandle(numMwmId);
+  auto connector = m_cache.Get(GetCacheKey(numMwmId, handle));
+  if (connector)
+  {
+    m_connectors.emplace(numMwmId, connector);
+    return connector;
+  }
+
+  Deserialize(numMwmId, handle,
+              CrossMwmConnectorSerializer::DeserializeTransitions<ReaderSourceFile>);
+  return m_connectors[numMwmId];
 }
 
 CrossMwmConnector const & CrossMwmIndexGraph::GetCrossMwmConnectorWithWeights(NumMwmId numMwmId)
@@ -63,9 +76,23 @@ CrossMwmConnector const & CrossMwmIndexGraph::GetCrossMwmConnectorWithWeights(Nu
   if (c.WeightsWereLoaded())
     return c;
 
-  return Deserialize(
-      numMwmId,
-      CrossMwmConnectorSerializer::DeserializeWeights<ReaderSourceFile>);
+  return Deserialize(numMwmId, GetMwmHandle(numMwmId),
+                     CrossMwmConnectorSerializer::DeserializeWeights<ReaderSourceFile>);
+}
+
+CrossMwmConnectorCache::Key CrossMwmIndexGraph::GetCacheKey(NumMwmId numMwmId,
+                                                            MwmSet::MwmHandle const & handle) const
+{
+  return CrossMwmConnectorCache::Key(m_numMwmIds->GetFile(numMwmId).GetName(), numMwmId,
+                                     handle.GetInfo()->GetVersion(), m_vehicleType);
+}
+
+MwmSet::MwmHandle CrossMwmIndexGraph::GetMwmHandle(NumMwmId numMwmId)
+{
+  MwmSet::MwmHandle handle = m_index.GetMwmHandleByCountryFile(m_numMwmIds->GetFile(numMwmId));
+  if (!handle.IsAlive())
+    MYTHROW(RoutingException, ("Mwm", m_numMwmIds->GetFile(numMwmId), "cannot be loaded."));
+  return handle;
 }
 
 TransitionPoints CrossMwmIndexGraph::GetTransitionPoints(Segment const & s, bool isOutgoing)
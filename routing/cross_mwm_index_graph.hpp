@@ -1,6 +1,7 @@
 #pragma once
 
 #include "routing/cross_mwm_connector.hpp"
+#include "routing/cross_mwm_connector_cache.hpp"
 #include "routing/num_mwm_id.hpp"
 #include "routing/segment.hpp"
 #include "routing/routing_exceptions.hpp"
@@ -25,8 +26,9 @@ class CrossMwmIndexGraph final
 public:
   using ReaderSourceFile = ReaderSource<FilesContainerR::TReader>;
 
-  CrossMwmIndexGraph(Index & index, std::shared_ptr<NumMwmIds> numMwmIds, VehicleType vehicleType)
-    : m_index(index), m_numMwmIds(numMwmIds), m_vehicleType(vehicleType)
+  CrossMwmIndexGraph(Index & index, std::shared_ptr<NumMwmIds> numMwmIds, VehicleType vehicleType,
+                     CrossMwmConnectorCache & cache = CrossMwmConnectorCache::Instance())
+    : m_index(index), m_numMwmIds(numMwmIds), m_vehicleType(vehicleType), m_cache(cache)
   {
   }
 
@@ -38,6 +40,7 @@ public:
   void GetTwinsByOsmId(Segment const & s, bool isOutgoing, std::vector<NumMwmId> const & neighbors,
                        std::vector<Segment> & twins);
   void GetEdgeList(Segment const & s, bool isOutgoing, std::vector<SegmentEdge> & edges);
+  // The connectors stay in |m_cache|.
   void Clear() { m_connectors.clear(); }
   TransitionPoints GetTransitionPoints(Segment const & s, bool isOutgoing);
   bool InCache(NumMwmId numMwmId) const { return m_connectors.count(numMwmId) != 0; }
@@ -46,43 +49,51 @@ public:
   template <typename Fn>
   void ForEachTransition(NumMwmId numMwmId, bool isEnter, Fn && fn)
   {
-    auto const & connectors = GetCrossMwmConnectorWithTransitions(numMwmId);
-    for (Segment const & t : (isEnter ? connectors.GetEnters() : connectors.GetExits()))
+    // |fn| may cause weights loading which replaces the connector in |m_connectors|.
+    std::shared_ptr<CrossMwmConnector const> const connector = GetConnector(numMwmId);
+    for (Segment const & t : (isEnter ? connector->GetEnters() : connector->GetExits()))
       fn(t);
   }
 
 private:
+  // Returns the connector with loaded transitions.
+  std::shared_ptr<CrossMwmConnector const> GetConnector(NumMwmId numMwmId);
   CrossMwmConnector const & GetCrossMwmConnectorWithWeights(NumMwmId numMwmId);
+  CrossMwmConnectorCache::Key GetCacheKey(NumMwmId numMwmId, MwmSet::MwmHandle const & handle) const;
+  MwmSet::MwmHandle GetMwmHandle(NumMwmId numMwmId);
 
   /// \brief Deserializes connectors for an mwm with |numMwmId|.
   /// \param fn is a function implementing deserialization.
   /// \note Each CrossMwmConnector contained in |m_connectors| may be deserizalize in two stages.
   /// The first one is transition deserialization and the second is weight deserialization.
   /// Transition deserialization is much faster and used more often.
+  /// \note Connectors are shared with |m_cache| and must not be changed. So the second stage
+  /// is applied to a copy of the connector which replaces the original one.
   template <typename Fn>
-  CrossMwmConnector const & Deserialize(NumMwmId numMwmId, Fn && fn)
+  CrossMwmConnector const & Deserialize(NumMwmId numMwmId, MwmSet::MwmHandle const & handle,
+                                        Fn && fn)
   {
-    MwmSet::MwmHandle handle = m_index.GetMwmHandleByCountryFile(m_numMwmIds->GetFile(numMwmId));
-    if (!handle.IsAlive())
-      MYTHROW(RoutingException, ("Mwm", m_numMwmIds->GetFile(numMwmId), "cannot be loaded."));
-
-    MwmValue * value = handle.GetValue<MwmValue>();
+    MwmValue const * value = handle.GetValue<MwmValue>();
     CHECK(value != nullptr, ("Country file:", m_numMwmIds->GetFile(numMwmId)));
 
     FilesContainerR::TReader const reader =
         FilesContainerR::TReader(value->m_cont.GetReader(CROSS_MWM_FILE_TAG));
     ReaderSourceFile src(reader);
-    auto it = m_connectors.find(numMwmId);
-    if (it == m_connectors.end())
-      it = m_connectors.emplace(numMwmId, CrossMwmConnector(numMwmId)).first;
-
-    fn(m_vehicleType, it->second, src);
-    return it->second;
+    auto const it = m_connectors.find(numMwmId);
+    auto connector = it == m_connectors.end()
+                         ? std::make_shared<CrossMwmConnector>(numMwmId)
+                         : std::make_shared<CrossMwmConnector>(*it->second);
+
+    fn(m_vehicleType, *connector, src);
+    m_cache.Put(GetCacheKey(numMwmId, handle), connector);
+    m_connectors[numMwmId] = connector;
+    return *connector;
   }
 
   Index & m_index;
   std::shared_ptr<NumMwmIds> m_numMwmIds;
   VehicleType m_vehicleType;
+  CrossMwmConnectorCache & m_cache;
 
   /// \note |m_connectors| contains cache with transition segments and leap edges.
   /// Each mwm in |m_connectors| may be in two conditions:
@@ -91,6 +102,6 @@ private:
   /// * with loaded transition segments and with loaded weights
   ///   (after a call to CrossMwmConnectorSerializer::DeserializeTransitions()
   ///   and CrossMwmConnectorSerializer::DeserializeWeights())
-  std::map<NumMwmId, CrossMwmConnector> m_connectors;
+  std::map<NumMwmId, std::shared_ptr<CrossMwmConnector const>> m_connectors;
 };
 }  // namespace routing
@@ -88,6 +88,8 @@ double EdgeEstimator::CalcHeuristic(m2::PointD const & from, m2::PointD const &
   return TimeBetweenSec(from, to, m_maxSpeedMPS);
 }
 
+double EdgeEstimator::CalcHeuristic(double distanceM) const { return distanceM / m_maxSpeedMPS; }
+
 double EdgeEstimator::CalcLeapWeight(m2::PointD const & from, m2::PointD const & to) const
 {
   // Let us assume for the time being that
@@ -181,7 +183,10 @@ double CarEstimator::GetUTurnPenalty() const
   return 2 * 60;  // seconds
 }
 
-bool CarEstimator::LeapIsAllowed(NumMwmId mwmId) const { return !m_trafficStash->Has(mwmId); }
+bool CarEstimator::LeapIsAllowed(NumMwmId mwmId) const
+{
+  return !m_trafficStash || !m_trafficStash->Has(mwmId);
+}
 
 // EdgeEstimator -----------------------------------------------------------------------------------
 // static
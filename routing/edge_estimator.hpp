@@ -25,6 +25,8 @@ public:
   virtual ~EdgeEstimator() = default;
 
   double CalcHeuristic(m2::PointD const & from, m2::PointD const & to) const;
+  // Returns the lower bound of time in seconds it takes to pass |distanceM| meters along roads.
+  double CalcHeuristic(double distanceM) const;
   // Returns time in seconds it takes to go from point |from| to point |to| along a leap (fake)
   // edge |from|-|to|.
   // Note 1. The result of the method should be used if it's necessary to add a leap (fake) edge
@@ -1,6 +1,8 @@
 #include "routing/features_road_graph.hpp"
+#include "routing/index_graph_loader.hpp"
 #include "routing/nearest_edge_finder.hpp"
 #include "routing/route.hpp"
+#include "routing/vehicle_mask.hpp"
 
 #include "routing_common/vehicle_model.hpp"
 
@@ -9,10 +11,15 @@
 #include "indexer/index.hpp"
 #include "indexer/scales.hpp"
 
+#include "coding/file_container.hpp"
+
 #include "geometry/distance_on_sphere.hpp"
 
 #include "base/logging.hpp"
 #include "base/macros.hpp"
+#include "base/stl_helpers.hpp"
+
+#include "defines.hpp"
 
 namespace routing
 {
@@ -25,6 +32,9 @@ double constexpr kMwmRoadCrossingRadiusMeters = 2.0;
 
 double constexpr kMwmCrossingNodeEqualityRadiusMeters = 100.0;
 
+// Crosses of an mwm are dropped by ClearState() when there are more of them.
+size_t constexpr kMaxCachedCrossesPerMwm = 1 << 20;
+
 }  // namespace
 
 FeaturesRoadGraph::Value::Value(Index const & index, MwmSet::MwmHandle handle)
@@ -34,6 +44,20 @@ FeaturesRoadGraph::Value::Value(Index const & index, MwmSet::MwmHandle handle)
     return;
 
   m_altitudeLoader = make_unique<feature::AltitudeLoader>(index, m_mwmHandle.GetId());
+
+  FilesContainerR const & cont = m_mwmHandle.GetValue<MwmValue>()->m_cont;
+  if (!cont.IsExist(ROAD_GRID_FILE_TAG))
+    return;
+
+  try
+  {
+    FilesContainerR::TReader const reader = cont.GetReader(ROAD_GRID_FILE_TAG);
+    m_roadGrid = make_unique<RoadGrid>(reader.GetPtr()->CreateSubReader(0 /* pos */, reader.Size()));
+  }
+  catch (Reader::OpenException const & e)
+  {
+    LOG(LERROR, ("Error while reading", ROAD_GRID_FILE_TAG, "section.", e.Msg()));
+  }
 }
 
 FeaturesRoadGraph::CrossCountryVehicleModel::CrossCountryVehicleModel(
@@ -102,6 +126,62 @@ void FeaturesRoadGraph::RoadInfoCache::Clear()
 {
   m_cache.clear();
 }
+
+vector<uint32_t> const * FeaturesRoadGraph::CrossCache::Find(m2::PointD const & cross) const
+{
+  auto const it = m_crosses.find(cross);
+  return it == m_crosses.end() ? nullptr : &it->second;
+}
+
+void FeaturesRoadGraph::CrossCache::Add(m2::PointD const & cross, vector<uint32_t> && featureIds)
+{
+  my::SortUnique(featureIds);
+  m_crosses[cross] = move(featureIds);
+}
+
+void FeaturesRoadGraph::CrossCache::AddRoad(uint32_t featureId, RoadInfo const & roadInfo)
+{
+  if (!m_joints || !m_joints->IsRoad(featureId) || !m_roads.insert(featureId).second)
+    return;
+
+  RoadJointIds const & road = m_joints->GetRoad(featureId);
+  for (size_t i = 0; i < roadInfo.m_junctions.size(); ++i)
+  {
+    m2::PointD const & point = roadInfo.m_junctions[i].GetPoint();
+    if (m_crosses.count(point) != 0)
+      continue;
+
+    vector<uint32_t> featureIds;
+    Joint::Id const jointId = road.GetJointId(static_cast<uint32_t>(i));
+    if (jointId == Joint::kInvalidId)
+    {
+      featureIds.push_back(featureId);
+    }
+    else
+    {
+      m_joints->ForEachPoint(jointId, [&featureIds](RoadPoint const & rp) {
+        featureIds.push_back(rp.GetFeatureId());
+      });
+    }
+    Add(point, move(featureIds));
+  }
+}
+
+bool FeaturesRoadGraph::CrossCache::IsRoadKnown(uint32_t featureId, bool & isRoad) const
+{
+  auto const it = m_isRoad.find(featureId);
+  if (it == m_isRoad.end())
+    return false;
+  isRoad = it->second;
+  return true;
+}
+
+void FeaturesRoadGraph::CrossCache::ClearCrosses()
+{
+  m_crosses.clear();
+  m_roads.clear();
+  m_isRoad.clear();
+}
 FeaturesRoadGraph::FeaturesRoadGraph(Index const & index, IRoadGraph::Mode mode,
                                      shared_ptr<VehicleModelFactoryInterface> vehicleModelFactory)
   : m_index(index), m_mode(mode), m_vehicleModel(vehicleModelFactory)
@@ -113,8 +193,9 @@ int FeaturesRoadGraph::GetStreetReadScale() { return scales::GetUpperScale(); }
 class CrossFeaturesLoader
 {
 public:
-  CrossFeaturesLoader(FeaturesRoadGraph const & graph, IRoadGraph::ICrossEdgesLoader & edgesLoader)
-    : m_graph(graph), m_edgesLoader(edgesLoader)
+  CrossFeaturesLoader(FeaturesRoadGraph const & graph, FeaturesRoadGraph::CrossCache & cache,
+                      IRoadGraph::ICrossEdgesLoader & edgesLoader)
+    : m_graph(graph), m_cache(cache), m_edgesLoader(edgesLoader)
   {}
 
   void operator()(FeatureType & ft)
@@ -127,15 +208,23 @@ public:
       return;
 
     FeatureID const featureId = ft.GetID();
+    m_cache.SetIsRoad(featureId.m_index, true);
 
     IRoadGraph::RoadInfo const & roadInfo = m_graph.GetCachedRoadInfo(featureId, ft, speedKMPH);
+    m_cache.AddRoad(featureId.m_index, roadInfo);
+    m_featureIds.push_back(featureId.m_index);
 
     m_edgesLoader(featureId, roadInfo);
   }
 
+  vector<uint32_t> & GetFeatureIds() { return m_featureIds; }
+
 private:
   FeaturesRoadGraph const & m_graph;
+  FeaturesRoadGraph::CrossCache & m_cache;
   IRoadGraph::ICrossEdgesLoader & m_edgesLoader;
+  // Roads found by the query.
+  vector<uint32_t> m_featureIds;
 };
 
 IRoadGraph::RoadInfo FeaturesRoadGraph::GetRoadInfo(FeatureID const & featureId) const
@@ -157,12 +246,75 @@ double FeaturesRoadGraph::GetMaxSpeedKMPH() const
   return m_vehicleModel.GetMaxSpeed();
 }
 
+template <typename Fn>
+void FeaturesRoadGraph::ForEachMwmInRect(m2::RectD const & rect, Fn && fn) const
+{
+  int const scale = GetStreetReadScale();
+
+  vector<shared_ptr<MwmInfo>> mwms;
+  m_index.GetMwmsInfo(mwms);
+  for (auto const & info : mwms)
+  {
+    if (info->GetType() != MwmInfo::COUNTRY || info->m_minScale > scale ||
+        scale > info->m_maxScale || !rect.IsIntersect(info->m_limitRect))
+    {
+      continue;
+    }
+
+    MwmSet::MwmId const mwmId(info);
+    Value const & value = LockMwm(mwmId);
+    if (value.IsAlive())
+      fn(mwmId, value);
+  }
+}
+
+template <typename Fn>
+void FeaturesRoadGraph::ForEachRoadInMwm(m2::RectD const & rect, MwmSet::MwmId const & mwmId,
+                                         Value const & value, Fn && fn) const
+{
+  if (!value.m_roadGrid)
+  {
+    m_index.ForEachInRectForMWM(fn, rect, GetStreetReadScale(), mwmId);
+    return;
+  }
+
+  Index::FeaturesLoaderGuard loader(m_index, mwmId);
+  value.m_roadGrid->ForEachRoadInRect(rect, [&](uint32_t featureId) {
+    FeatureType ft;
+    if (loader.GetFeatureByIndex(featureId, ft))
+      fn(ft);
+  });
+}
+
+template <typename Fn>
+void FeaturesRoadGraph::ForEachRoadInRect(m2::RectD const & rect, Fn && fn) const
+{
+  ForEachMwmInRect(rect, [&](MwmSet::MwmId const & mwmId, Value const & value) {
+    ForEachRoadInMwm(rect, mwmId, value, fn);
+  });
+}
+
 void FeaturesRoadGraph::ForEachFeatureClosestToCross(m2::PointD const & cross,
                                                      ICrossEdgesLoader & edgesLoader) const
 {
-  CrossFeaturesLoader featuresLoader(*this, edgesLoader);
   m2::RectD const rect = MercatorBounds::RectByCenterXYAndSizeInMeters(cross, kMwmRoadCrossingRadiusMeters);
-  m_index.ForEachInRect(featuresLoader, rect, GetStreetReadScale());
+  ForEachMwmInRect(rect, [&](MwmSet::MwmId const & mwmId, Value const & value) {
+    CrossCache & cache = GetCrossCache(mwmId, value);
+    if (auto const * featureIds = cache.Find(cross))
+    {
+      for (auto const featureId : *featureIds)
+      {
+        FeatureID const id(mwmId, featureId);
+        if (RoadInfo const * roadInfo = GetCrossRoadInfo(cache, id))
+          edgesLoader(id, *roadInfo);
+      }
+      return;
+    }
+
+    CrossFeaturesLoader featuresLoader(*this, cache, edgesLoader);
+    ForEachRoadInMwm(rect, mwmId, value, featuresLoader);
+    cache.Add(cross, move(featuresLoader.GetFeatureIds()));
+  });
 }
 
 void FeaturesRoadGraph::FindClosestEdges(m2::PointD const & point, uint32_t count,
@@ -186,9 +338,8 @@ void FeaturesRoadGraph::FindClosestEdges(m2::PointD const & point, uint32_t coun
     finder.AddInformationSource(featureId, roadInfo);
   };
 
-  m_index.ForEachInRect(
-      f, MercatorBounds::RectByCenterXYAndSizeInMeters(point, kMwmCrossingNodeEqualityRadiusMeters),
-      GetStreetReadScale());
+  ForEachRoadInRect(
+      MercatorBounds::RectByCenterXYAndSizeInMeters(point, kMwmCrossingNodeEqualityRadiusMeters), f);
 
   finder.MakeResult(vicinities, count);
 }
@@ -240,6 +391,19 @@ void FeaturesRoadGraph::ClearState()
   m_cache.Clear();
   m_vehicleModel.Clear();
   m_mwmLocks.clear();
+
+  // Crosses are kept for the next routes if the mwm is still registered.
+  for (auto it = m_crossCaches.begin(); it != m_crossCaches.end();)
+  {
+    if (!it->first.IsAlive())
+    {
+      it = m_crossCaches.erase(it);
+      continue;
+    }
+    if (it->second.GetCrossesCount() > kMaxCachedCrossesPerMwm)
+      it->second.ClearCrosses();
+    ++it;
+  }
 }
 
 bool FeaturesRoadGraph::IsRoad(FeatureType const & ft) const { return m_vehicleModel.IsRoad(ft); }
@@ -270,7 +434,7 @@ void FeaturesRoadGraph::ExtractRoadInfo(FeatureID const & featureId, FeatureType
   feature::TAltitudes altitudes;
   if (value.m_altitudeLoader)
   {
-    altitudes = value.m_altitudeLoader->GetAltitudes(featureId.m_index, ft.GetPointsCount());
+    value.m_altitudeLoader->GetAltitudes(featureId.m_index, ft.GetPointsCount(), altitudes);
   }
   else
   {
@@ -324,6 +488,53 @@ IRoadGraph::RoadInfo const & FeaturesRoadGraph::GetCachedRoadInfo(FeatureID cons
   return ri;
 }
 
+FeaturesRoadGraph::CrossCache & FeaturesRoadGraph::GetCrossCache(MwmSet::MwmId const & mwmId,
+                                                                 Value const & value) const
+{
+  auto const it = m_crossCaches.find(mwmId);
+  if (it != m_crossCaches.end())
+    return it->second;
+
+  unique_ptr<IndexGraph> joints;
+  MwmValue const & mwmValue = *value.m_mwmHandle.GetValue<MwmValue>();
+  if (mwmValue.m_cont.IsExist(ROUTING_FILE_TAG))
+  {
+    try
+    {
+      joints = make_unique<IndexGraph>();
+      DeserializeIndexGraphJoints(mwmValue, kAllVehiclesMask, *joints);
+    }
+    catch (RootException const & e)
+    {
+      LOG(LERROR, ("Error while reading", ROUTING_FILE_TAG, "section.", e.Msg()));
+      joints.reset();
+    }
+  }
+  return m_crossCaches.emplace(mwmId, CrossCache(move(joints))).first->second;
+}
+
+IRoadGraph::RoadInfo const * FeaturesRoadGraph::GetCrossRoadInfo(CrossCache & cache,
+                                                                 FeatureID const & featureId) const
+{
+  bool isRoad = false;
+  if (cache.IsRoadKnown(featureId.m_index, isRoad))
+    return isRoad ? &GetCachedRoadInfo(featureId) : nullptr;
+
+  // Roads of joints are checked by the vehicle model once.
+  FeatureType ft;
+  Index::FeaturesLoaderGuard loader(m_index, featureId.m_mwmId);
+  double speedKMPH = 0.0;
+  if (loader.GetFeatureByIndex(featureId.m_index, ft) && IsRoad(ft))
+    speedKMPH = GetSpeedKMPHFromFt(ft);
+  cache.SetIsRoad(featureId.m_index, speedKMPH > 0.0);
+  if (speedKMPH <= 0.0)
+    return nullptr;
+
+  RoadInfo const & roadInfo = GetCachedRoadInfo(featureId, ft, speedKMPH);
+  cache.AddRoad(featureId.m_index, roadInfo);
+  return &roadInfo;
+}
+
 FeaturesRoadGraph::Value const & FeaturesRoadGraph::LockMwm(MwmSet::MwmId const & mwmId) const
 {
   ASSERT(mwmId.IsAlive(), ());
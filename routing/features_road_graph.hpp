@@ -1,6 +1,8 @@
 #pragma once
 
+#include "routing/index_graph.hpp"
 #include "routing/road_graph.hpp"
+#include "routing/road_grid.hpp"
 
 #include "routing_common/vehicle_model.hpp"
 
@@ -15,6 +17,8 @@
 
 #include "std/map.hpp"
 #include "std/unique_ptr.hpp"
+#include "std/unordered_map.hpp"
+#include "std/unordered_set.hpp"
 #include "std/vector.hpp"
 
 class Index;
@@ -61,6 +65,40 @@ private:
     map<MwmSet::MwmId, TMwmFeatureCache> m_cache;
   };
 
+  // Roads of an mwm which have points at crosses, so a cross is expanded without queries of
+  // the index after the first time. When a road of the routing section is loaded, all its points
+  // are filled by the joints of the section: the roads of a joint, or the road itself for a point
+  // which isn't a joint. Other crosses are filled by results of queries. Roads which aren't in
+  // the routing section and have points at joints may be missed. The cache doesn't lock the mwm
+  // and survives ClearState().
+  class CrossCache
+  {
+  public:
+    // |joints| is nullptr if the mwm has no routing section, then crosses are filled by
+    // queries only.
+    explicit CrossCache(unique_ptr<IndexGraph> joints) : m_joints(move(joints)) {}
+
+    // Returns nullptr if roads of |cross| aren't known.
+    vector<uint32_t> const * Find(m2::PointD const & cross) const;
+    void Add(m2::PointD const & cross, vector<uint32_t> && featureIds);
+    // Fills crosses of points of the road |featureId| by the joints.
+    void AddRoad(uint32_t featureId, RoadInfo const & roadInfo);
+
+    // Returns false if it's not known yet whether |featureId| is a road of the vehicle model.
+    bool IsRoadKnown(uint32_t featureId, bool & isRoad) const;
+    void SetIsRoad(uint32_t featureId, bool isRoad) { m_isRoad[featureId] = isRoad; }
+
+    size_t GetCrossesCount() const { return m_crosses.size(); }
+    void ClearCrosses();
+
+  private:
+    unique_ptr<IndexGraph> m_joints;
+    map<m2::PointD, vector<uint32_t>> m_crosses;
+    // Roads which crosses are filled by the joints.
+    unordered_set<uint32_t> m_roads;
+    unordered_map<uint32_t, bool> m_isRoad;
+  };
+
 public:
   FeaturesRoadGraph(Index const & index, IRoadGraph::Mode mode,
                     shared_ptr<VehicleModelFactoryInterface> vehicleModelFactory);
@@ -82,6 +120,11 @@ public:
 
   bool IsRoad(FeatureType const & ft) const;
 
+protected:
+  double GetSpeedKMPHFromFt(FeatureType const & ft) const;
+  void ExtractRoadInfo(FeatureID const & featureId, FeatureType const & ft, double speedKMPH,
+                       RoadInfo & ri) const;
+
 private:
   friend class CrossFeaturesLoader;
 
@@ -94,10 +137,27 @@ private:
 
     MwmSet::MwmHandle m_mwmHandle;
     unique_ptr<feature::AltitudeLoader> m_altitudeLoader;
+    // Nullptr if the mwm has no road grid section.
+    unique_ptr<RoadGrid> m_roadGrid;
   };
 
+  // Calls |fn| for the features of every mwm which may be roads with segments in |rect|. Roads of
+  // mwms with road grids are found by the grids, the features of other mwms are read
+  // from the index.
+  template <typename Fn>
+  void ForEachRoadInRect(m2::RectD const & rect, Fn && fn) const;
+  // Calls |fn| with ids and locks of alive country mwms which may have roads in |rect|.
+  template <typename Fn>
+  void ForEachMwmInRect(m2::RectD const & rect, Fn && fn) const;
+  template <typename Fn>
+  void ForEachRoadInMwm(m2::RectD const & rect, MwmSet::MwmId const & mwmId, Value const & value,
+                        Fn && fn) const;
+
+  CrossCache & GetCrossCache(MwmSet::MwmId const & mwmId, Value const & value) const;
+  // Returns nullptr if |featureId| isn't a road of the vehicle model.
+  RoadInfo const * GetCrossRoadInfo(CrossCache & cache, FeatureID const & featureId) const;
+
   bool IsOneWay(FeatureType const & ft) const;
-  double GetSpeedKMPHFromFt(FeatureType const & ft) const;
 
   // Searches a feature RoadInfo in the cache, and if does not find then
   // loads feature from the index and takes speed for the feature from the vehicle model.
@@ -106,8 +166,6 @@ private:
   // This version is used to prevent redundant feature loading when feature speed is known.
   RoadInfo const & GetCachedRoadInfo(FeatureID const & featureId, FeatureType const & ft,
                                      double speedKMPH) const;
-  void ExtractRoadInfo(FeatureID const & featureId, FeatureType const & ft, double speedKMPH,
-                       RoadInfo & ri) const;
 
   Value const & LockMwm(MwmSet::MwmId const & mwmId) const;
 
@@ -116,6 +174,7 @@ private:
   mutable RoadInfoCache m_cache;
   mutable CrossCountryVehicleModel m_vehicleModel;
   mutable map<MwmSet::MwmId, Value> m_mwmLocks;
+  mutable map<MwmSet::MwmId, CrossCache> m_crossCaches;
 };
 
 }  // namespace routing
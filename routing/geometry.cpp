@@ -7,6 +7,7 @@
 #include "geometry/mercator.hpp"
 
 #include "base/assert.hpp"
+#include "base/checked_cast.hpp"
 
 #include <string>
 
@@ -20,22 +21,28 @@ class GeometryLoaderImpl final : public GeometryLoader
 {
 public:
   GeometryLoaderImpl(Index const & index, MwmSet::MwmHandle const & handle,
-                     shared_ptr<VehicleModelInterface> vehicleModel, bool loadAltitudes);
+                     shared_ptr<VehicleModelInterface> vehicleModel,
+                     shared_ptr<RoadSpeeds const> roadSpeeds, bool loadAltitudes);
 
   // GeometryLoader overrides:
   void Load(uint32_t featureId, RoadGeometry & road) override;
 
 private:
   shared_ptr<VehicleModelInterface> m_vehicleModel;
+  shared_ptr<RoadSpeeds const> m_roadSpeeds;
   Index::FeaturesLoaderGuard m_guard;
   string const m_country;
   feature::AltitudeLoader m_altitudeLoader;
+  // Buffer for decoding of altitudes which is reused for all features.
+  feature::TAltitudes m_altitudes;
   bool const m_loadAltitudes;
 };
 
 GeometryLoaderImpl::GeometryLoaderImpl(Index const & index, MwmSet::MwmHandle const & handle,
-                                       shared_ptr<VehicleModelInterface> vehicleModel, bool loadAltitudes)
+                                       shared_ptr<VehicleModelInterface> vehicleModel,
+                                       shared_ptr<RoadSpeeds const> roadSpeeds, bool loadAltitudes)
   : m_vehicleModel(move(vehicleModel))
+  , m_roadSpeeds(move(roadSpeeds))
   , m_guard(index, handle.GetId())
   , m_country(handle.GetInfo()->GetCountryName())
   , m_altitudeLoader(index, handle.GetId())
@@ -56,10 +63,15 @@ void GeometryLoaderImpl::Load(uint32_t featureId, RoadGeometry & road)
 
   feature::TAltitudes const * altitudes = nullptr;
   if (m_loadAltitudes)
-    altitudes = &(m_altitudeLoader.GetAltitudes(featureId, feature.GetPointsCount()));
+  {
+    m_altitudeLoader.GetAltitudes(featureId, feature.GetPointsCount(), m_altitudes);
+    altitudes = &m_altitudes;
+  }
 
-  road.Load(*m_vehicleModel, feature, altitudes);
-  m_altitudeLoader.ClearCache();
+  if (m_roadSpeeds)
+    road.Load(*m_roadSpeeds, featureId, feature, altitudes);
+  else
+    road.Load(*m_vehicleModel, feature, altitudes);
 }
 
 // FileGeometryLoader ------------------------------------------------------------------------------
@@ -96,6 +108,9 @@ void FileGeometryLoader::Load(uint32_t featureId, RoadGeometry & road)
 namespace routing
 {
 // RoadGeometry ------------------------------------------------------------------------------------
+// static
+size_t constexpr RoadGeometry::kStaticJunctions;
+
 RoadGeometry::RoadGeometry(bool oneWay, double speed, Points const & points)
   : m_speed(speed), m_isOneWay(oneWay), m_valid(true)
 {
@@ -109,13 +124,30 @@ RoadGeometry::RoadGeometry(bool oneWay, double speed, Points const & points)
 void RoadGeometry::Load(VehicleModelInterface const & vehicleModel, FeatureType const & feature,
                         feature::TAltitudes const * altitudes)
 {
-  CHECK(altitudes == nullptr || altitudes->size() == feature.GetPointsCount(), ());
-
   m_valid = vehicleModel.IsRoad(feature);
   m_isOneWay = vehicleModel.IsOneWay(feature);
   m_speed = vehicleModel.GetSpeed(feature);
   m_isTransitAllowed = vehicleModel.IsTransitAllowed(feature);
 
+  LoadJunctions(feature, altitudes);
+}
+
+void RoadGeometry::Load(RoadSpeeds const & roadSpeeds, uint32_t featureId,
+                        FeatureType const & feature, feature::TAltitudes const * altitudes)
+{
+  RoadSpeeds::Road road;
+  m_valid = roadSpeeds.Get(featureId, road);
+  m_isOneWay = road.m_isOneWay;
+  m_speed = road.m_speedKMpH;
+  m_isTransitAllowed = road.m_isTransitAllowed;
+
+  LoadJunctions(feature, altitudes);
+}
+
+void RoadGeometry::LoadJunctions(FeatureType const & feature, feature::TAltitudes const * altitudes)
+{
+  CHECK(altitudes == nullptr || altitudes->size() == feature.GetPointsCount(), ());
+
   m_junctions.clear();
   m_junctions.reserve(feature.GetPointsCount());
   for (size_t i = 0; i < feature.GetPointsCount(); ++i)
@@ -144,23 +176,47 @@ Geometry::Geometry(unique_ptr<GeometryLoader> loader) : m_loader(move(loader))
 
 RoadGeometry const & Geometry::GetRoad(uint32_t featureId)
 {
-  auto const & it = m_roads.find(featureId);
-  if (it != m_roads.cend())
-    return it->second;
+  uint32_t & slot = GetSlot(featureId);
+  if (slot != 0)
+    return m_roads[slot - 1];
 
-  RoadGeometry & road = m_roads[featureId];
+  m_roads.emplace_back();
+  slot = base::checked_cast<uint32_t>(m_roads.size());
+  RoadGeometry & road = m_roads.back();
   m_loader->Load(featureId, road);
+
+  m_memorySize += sizeof(RoadGeometry);
+  // Junctions which don't fit into the static buffer are kept on the heap.
+  if (road.GetPointsCount() > RoadGeometry::kStaticJunctions)
+    m_memorySize += road.GetPointsCount() * sizeof(Junction);
   return road;
 }
 
+uint32_t & Geometry::GetSlot(uint32_t featureId)
+{
+  size_t const pageIdx = featureId >> kPageBits;
+  if (pageIdx >= m_pages.size())
+    m_pages.resize(pageIdx + 1);
+
+  unique_ptr<uint32_t[]> & page = m_pages[pageIdx];
+  if (!page)
+  {
+    page.reset(new uint32_t[kPageSize]());
+    m_memorySize += kPageSize * sizeof(uint32_t);
+  }
+
+  return page[featureId & (kPageSize - 1)];
+}
+
 // static
 unique_ptr<GeometryLoader> GeometryLoader::Create(Index const & index,
                                                   MwmSet::MwmHandle const & handle,
                                                   shared_ptr<VehicleModelInterface> vehicleModel,
+                                                  shared_ptr<RoadSpeeds const> roadSpeeds,
                                                   bool loadAltitudes)
 {
   CHECK(handle.IsAlive(), ());
-  return make_unique<GeometryLoaderImpl>(index, handle, vehicleModel, loadAltitudes);
+  return make_unique<GeometryLoaderImpl>(index, handle, vehicleModel, roadSpeeds, loadAltitudes);
 }
 
 // static
@@ -2,6 +2,7 @@
 
 #include "routing/road_point.hpp"
 #include "routing/road_graph.hpp"
+#include "routing/road_speeds.hpp"
 
 #include "routing_common/vehicle_model.hpp"
 
@@ -13,9 +14,10 @@
 #include "base/buffer_vector.hpp"
 
 #include <cstdint>
+#include <deque>
 #include <memory>
 #include <string>
-#include <unordered_map>
+#include <vector>
 
 namespace routing
 {
@@ -23,12 +25,17 @@ class RoadGeometry final
 {
 public:
   using Points = buffer_vector<m2::PointD, 32>;
+  // Number of junctions which are kept without heap allocations.
+  static size_t constexpr kStaticJunctions = 32;
 
   RoadGeometry() = default;
   RoadGeometry(bool oneWay, double speed, Points const & points);
 
   void Load(VehicleModelInterface const & vehicleModel, FeatureType const & feature,
             feature::TAltitudes const * altitudes);
+  // Takes the speed and the flags of the road from |roadSpeeds| instead of the vehicle model.
+  void Load(RoadSpeeds const & roadSpeeds, uint32_t featureId, FeatureType const & feature,
+            feature::TAltitudes const * altitudes);
 
   bool IsOneWay() const { return m_isOneWay; }
   // Kilometers per hour.
@@ -58,7 +65,9 @@ public:
   }
 
 private:
-  buffer_vector<Junction, 32> m_junctions;
+  void LoadJunctions(FeatureType const & feature, feature::TAltitudes const * altitudes);
+
+  buffer_vector<Junction, kStaticJunctions> m_junctions;
   double m_speed = 0.0;
   bool m_isOneWay = false;
   bool m_valid = false;
@@ -73,9 +82,12 @@ public:
   virtual void Load(uint32_t featureId, RoadGeometry & road) = 0;
 
   // handle should be alive: it is caller responsibility to check it.
+  // |roadSpeeds| is the table of the mwm for the vehicle type of |vehicleModel|. If it's nullptr,
+  // the speeds and the flags of the roads are calculated with |vehicleModel|.
   static std::unique_ptr<GeometryLoader> Create(Index const & index,
                                                 MwmSet::MwmHandle const & handle,
                                                 std::shared_ptr<VehicleModelInterface> vehicleModel,
+                                                std::shared_ptr<RoadSpeeds const> roadSpeeds,
                                                 bool loadAltitudes);
 
   /// This is for stand-alone work.
@@ -97,9 +109,24 @@ public:
     return GetRoad(rp.GetFeatureId()).GetPoint(rp.GetPointId());
   }
 
+  // Returns the approximate number of bytes used by the loaded roads.
+  size_t GetMemorySize() const { return m_memorySize; }
+
 private:
-  // Feature id to RoadGeometry map.
-  std::unordered_map<uint32_t, RoadGeometry> m_roads;
+  // Feature ids are split into pages of kPageSize ids. A page is allocated when a road of the page
+  // is requested for the first time. Features of a region have close ids, so a route touches
+  // a small number of pages.
+  static uint32_t constexpr kPageBits = 10;
+  static uint32_t constexpr kPageSize = 1 << kPageBits;
+
+  // Returns the index of |featureId| road in |m_roads| plus one or zero if the road is not loaded.
+  uint32_t & GetSlot(uint32_t featureId);
+
+  // Loaded roads. std::deque does not invalidate references on push_back so the references
+  // returned by GetRoad() stay valid while Geometry is alive.
+  std::deque<RoadGeometry> m_roads;
+  std::vector<std::unique_ptr<uint32_t[]>> m_pages;
   std::unique_ptr<GeometryLoader> m_loader;
+  size_t m_memorySize = 0;
 };
 }  // namespace routing
@@ -2,9 +2,12 @@
 
 #include "routing/restrictions_serialization.hpp"
 
+#include "geometry/mercator.hpp"
+
 #include "base/assert.hpp"
 #include "base/checked_cast.hpp"
 #include "base/exception.hpp"
+#include "base/logging.hpp"
 
 #include <algorithm>
 #include <limits>
@@ -21,17 +24,14 @@ bool IsUTurn(Segment const & u, Segment const & v)
          u.IsForward() != v.IsForward();
 }
 
-bool IsRestricted(RestrictionVec const & restrictions, Segment const & u, Segment const & v,
+bool IsRestricted(RestrictionIndex const & restrictions, Segment const & u, Segment const & v,
                   bool isOutgoing)
 {
   uint32_t const featureIdFrom = isOutgoing ? u.GetFeatureId() : v.GetFeatureId();
   uint32_t const featureIdTo = isOutgoing ? v.GetFeatureId() : u.GetFeatureId();
 
-  if (!binary_search(restrictions.cbegin(), restrictions.cend(),
-                     Restriction(Restriction::Type::No, {featureIdFrom, featureIdTo})))
-  {
+  if (!restrictions.IsProhibited(featureIdFrom, featureIdTo))
     return false;
-  }
 
   if (featureIdFrom != featureIdTo)
     return true;
@@ -53,6 +53,32 @@ bool IsRestricted(RestrictionVec const & restrictions, Segment const & u, Segmen
   // is lost.
   return IsUTurn(u, v);
 }
+
+// Returns the segment of the same feature which follows |segment| in its direction.
+Segment GetNextInFeature(Segment const & segment)
+{
+  uint32_t const segmentIdx =
+      segment.IsForward() ? segment.GetSegmentIdx() + 1 : segment.GetSegmentIdx() - 1;
+  return Segment(segment.GetMwmId(), segment.GetFeatureId(), segmentIdx, segment.IsForward());
+}
+
+// Returns the segment of the same feature which precedes |segment| in its direction.
+Segment GetPrevInFeature(Segment const & segment)
+{
+  uint32_t const segmentIdx =
+      segment.IsForward() ? segment.GetSegmentIdx() - 1 : segment.GetSegmentIdx() + 1;
+  return Segment(segment.GetMwmId(), segment.GetFeatureId(), segmentIdx, segment.IsForward());
+}
+
+// Returns the length in meters of the part of |road| between |fromPointId| and |toPointId|.
+double CalcLength(RoadGeometry const & road, uint32_t fromPointId, uint32_t toPointId)
+{
+  ASSERT_LESS_OR_EQUAL(fromPointId, toPointId, ());
+  double length = 0.0;
+  for (uint32_t i = fromPointId; i < toPointId; ++i)
+    length += MercatorBounds::DistanceOnEarth(road.GetPoint(i), road.GetPoint(i + 1));
+  return length;
+}
 }  // namespace
 
 namespace routing
@@ -80,6 +106,61 @@ void IndexGraph::GetEdgeList(Segment const & segment, bool isOutgoing, vector<Se
   }
 }
 
+void IndexGraph::GetShortcutEdgeList(Segment const & segment, bool isOutgoing,
+                                     IsPinnedFn const & isPinned, vector<SegmentEdge> & edges)
+{
+  if (!isOutgoing)
+  {
+    GetIngoingShortcutEdgeList(segment, isPinned, edges);
+    return;
+  }
+
+  size_t const begin = edges.size();
+  GetEdgeList(segment, true /* isOutgoing */, edges);
+
+  size_t end = begin;
+  for (size_t i = begin; i < edges.size(); ++i)
+  {
+    if (ProlongOutgoingEdge(isPinned, edges[i]))
+      edges[end++] = edges[i];
+  }
+  edges.erase(edges.begin() + end, edges.end());
+}
+
+void IndexGraph::UnpackShortcut(Segment const & from, Segment const & to, vector<Segment> & path)
+{
+  if (from.GetMwmId() != to.GetMwmId() || IsAdjacent(from, to))
+    return;
+
+  RoadGeometry const & road = m_geometry.GetRoad(to.GetFeatureId());
+  size_t const begin = path.size();
+  Segment current = to;
+  do
+  {
+    CHECK(!IsChainBegin(current, road), ("Segments", from, "and", to, "are not connected."));
+    current = GetPrevInFeature(current);
+    path.push_back(current);
+  } while (!IsAdjacent(from, current));
+
+  reverse(path.begin() + begin, path.end());
+}
+
+void IndexGraph::UnpackShortcuts(vector<Segment> & path)
+{
+  if (!HasShortcuts() || path.empty())
+    return;
+
+  vector<Segment> result;
+  result.reserve(path.size());
+  result.push_back(path.front());
+  for (size_t i = 1; i < path.size(); ++i)
+  {
+    UnpackShortcut(path[i - 1], path[i], result);
+    result.push_back(path[i]);
+  }
+  path.swap(result);
+}
+
 void IndexGraph::Build(uint32_t numJoints) { m_jointIndex.Build(m_roadIndex, numJoints); }
 
 void IndexGraph::Import(vector<Joint> const & joints)
@@ -92,27 +173,98 @@ void IndexGraph::Import(vector<Joint> const & joints)
 void IndexGraph::SetRestrictions(RestrictionVec && restrictions)
 {
   ASSERT(is_sorted(restrictions.cbegin(), restrictions.cend()), ());
-  m_restrictions = move(restrictions);
+  m_restrictions.Build(restrictions);
 }
 
 void IndexGraph::SetRoadAccess(RoadAccess && roadAccess) { m_roadAccess = move(roadAccess); }
 
+void IndexGraph::SetShortcuts(ShortcutIndex && shortcuts) { m_shortcuts = move(shortcuts); }
+
+void IndexGraph::SetLandmarks(LandmarkIndex && landmarks)
+{
+  if (!landmarks.IsEmpty() && landmarks.GetNumJoints() != GetNumJoints())
+  {
+    LOG(LWARNING, ("Landmarks are built for", landmarks.GetNumJoints(), "joints, graph has",
+                   GetNumJoints(), "joints."));
+    return;
+  }
+  m_landmarks = move(landmarks);
+}
+
+void IndexGraph::SetSpeedProfiles(SpeedProfiles && speedProfiles)
+{
+  m_speedProfiles = move(speedProfiles);
+}
+
+void IndexGraph::EnableTimeDependency(Segment const & start, uint32_t departureTimeOfDaySec)
+{
+  m_timeDependent = true;
+  m_departureTimeOfDaySec = departureTimeOfDaySec % SpeedProfiles::kSecondsInDay;
+  m_passTimes.Clear();
+  m_passTimes[start] = 0.0;
+}
+
+void IndexGraph::DisableTimeDependency()
+{
+  m_timeDependent = false;
+  m_passTimes.Clear();
+}
+
+void IndexGraph::EnableShortcuts(vector<Segment> const & stops)
+{
+  m_shortcutsEnabled = true;
+  m_shortcutPins = MakeShortcutPins(stops);
+}
+
+void IndexGraph::DisableShortcuts()
+{
+  m_shortcutsEnabled = false;
+  m_shortcutPins.clear();
+}
+
 void IndexGraph::GetOutgoingEdgesList(Segment const & segment, vector<SegmentEdge> & edges)
 {
   edges.clear();
+  if (m_timeDependent)
+  {
+    GetEdgeList(segment, true /* isOutgoing */, edges);
+    ApplyTimeDependency(segment, edges);
+    return;
+  }
+
+  if (m_shortcutsEnabled && HasShortcuts())
+  {
+    GetShortcutEdgeList(segment, true /* isOutgoing */,
+                        [this](Segment const & s) { return m_shortcutPins.count(s) != 0; },
+                        edges);
+    return;
+  }
   GetEdgeList(segment, true /* isOutgoing */, edges);
 }
 
 void IndexGraph::GetIngoingEdgesList(Segment const & segment, vector<SegmentEdge> & edges)
 {
+  CHECK(!m_timeDependent, ("Time-dependent weights are known for outgoing edges only."));
   edges.clear();
+  if (m_shortcutsEnabled && HasShortcuts())
+  {
+    GetShortcutEdgeList(segment, false /* isOutgoing */,
+                        [this](Segment const & s) { return m_shortcutPins.count(s) != 0; },
+                        edges);
+    return;
+  }
   GetEdgeList(segment, false /* isOutgoing */, edges);
 }
 
 RouteWeight IndexGraph::HeuristicCostEstimate(Segment const & from, Segment const & to)
 {
-  return RouteWeight(
-      m_estimator->CalcHeuristic(GetPoint(from, true /* front */), GetPoint(to, true /* front */)));
+  double const heuristic =
+      m_estimator->CalcHeuristic(GetPoint(from, true /* front */), GetPoint(to, true /* front */));
+  if (!HasLandmarks())
+    return RouteWeight(heuristic);
+
+  return RouteWeight(max(heuristic, CalcLandmarkHeuristic(from.GetRoadPoint(true /* front */),
+                                                          to.GetRoadPoint(true /* front */))));
 }
 
 RouteWeight IndexGraph::CalcSegmentWeight(Segment const & segment)
@@ -175,4 +327,240 @@ RouteWeight IndexGraph::GetPenalties(Segment const & u, Segment const & v) const
 
   return RouteWeight(0.0);
 }
+
+bool IndexGraph::IsChainEnd(Segment const & segment, RoadGeometry const & road) const
+{
+  RoadPoint const rp = segment.GetRoadPoint(true /* front */);
+  return road.IsEndPointId(rp.GetPointId()) || m_roadIndex.GetJointId(rp) != Joint::kInvalidId;
+}
+
+bool IndexGraph::IsChainBegin(Segment const & segment, RoadGeometry const & road) const
+{
+  RoadPoint const rp = segment.GetRoadPoint(false /* front */);
+  return road.IsEndPointId(rp.GetPointId()) || m_roadIndex.GetJointId(rp) != Joint::kInvalidId;
+}
+
+bool IndexGraph::IsAdjacent(Segment const & from, Segment const & to) const
+{
+  RoadPoint const front = from.GetRoadPoint(true /* front */);
+  RoadPoint const back = to.GetRoadPoint(false /* front */);
+  if (front == back)
+    return true;
+
+  Joint::Id const jointId = m_roadIndex.GetJointId(front);
+  return jointId != Joint::kInvalidId && jointId == m_roadIndex.GetJointId(back);
+}
+
+bool IndexGraph::ProlongOutgoingEdge(IsPinnedFn const & isPinned, SegmentEdge & edge)
+{
+  Segment const first = edge.GetTarget();
+  RoadGeometry const & road = m_geometry.GetRoad(first.GetFeatureId());
+
+  Segment last = first;
+  while (!isPinned(last) && !IsChainEnd(last, road))
+  {
+    last = GetNextInFeature(last);
+    if (m_roadAccess.GetSegmentType(last) != RoadAccess::Type::Yes)
+      return false;
+  }
+
+  if (last == first)
+    return true;
+
+  edge = SegmentEdge(last, edge.GetWeight() +
+                               RouteWeight(CalcChainWeight(first, last.GetPointId(true), road)));
+  return true;
+}
+
+void IndexGraph::GetIngoingShortcutEdgeList(Segment const & segment, IsPinnedFn const & isPinned,
+                                            vector<SegmentEdge> & edges)
+{
+  RoadGeometry const & road = m_geometry.GetRoad(segment.GetFeatureId());
+  if (!road.IsValid())
+  {
+    GetEdgeList(segment, false /* isOutgoing */, edges);
+    return;
+  }
+
+  uint32_t const toPointId = segment.GetPointId(true /* front */);
+
+  // Going back to the first segment of the chain which ends with |segment|.
+  Segment first = segment;
+  while (!IsChainBegin(first, road))
+  {
+    Segment const prev = GetPrevInFeature(first);
+    if (m_roadAccess.GetSegmentType(prev) != RoadAccess::Type::Yes)
+      return;
+
+    if (isPinned(prev))
+    {
+      double weight = m_estimator->CalcSegmentWeight(first, road);
+      if (first != segment)
+        weight += CalcChainWeight(first, toPointId, road);
+      edges.emplace_back(prev, RouteWeight(weight));
+      return;
+    }
+
+    first = prev;
+  }
+
+  size_t const begin = edges.size();
+  GetEdgeList(first, false /* isOutgoing */, edges);
+  if (first == segment)
+    return;
+
+  RouteWeight const chainWeight(CalcChainWeight(first, toPointId, road));
+  for (size_t i = begin; i < edges.size(); ++i)
+    edges[i] = SegmentEdge(edges[i].GetTarget(), edges[i].GetWeight() + chainWeight);
+}
+
+double IndexGraph::CalcChainWeight(Segment const & segment, uint32_t toPointId,
+                                   RoadGeometry const & road) const
+{
+  uint32_t const fromPointId = segment.GetPointId(true /* front */);
+  ASSERT_NOT_EQUAL(fromPointId, toPointId, ());
+
+  double chainWeight = 0.0;
+  if (m_estimator->LeapIsAllowed(segment.GetMwmId()) &&
+      m_shortcuts.GetWeight(segment.GetFeatureId(), segment.GetPointId(false /* front */),
+                            toPointId, chainWeight))
+  {
+    // The precomputed weight may be calculated with another version of the vehicle model.
+    // The heuristic is the lower bound which keeps the edge admissible for A*.
+    return max(chainWeight - m_estimator->CalcSegmentWeight(segment, road),
+               m_estimator->CalcHeuristic(road.GetPoint(fromPointId), road.GetPoint(toPointId)));
+  }
+
+  double weight = 0.0;
+  for (Segment s = GetNextInFeature(segment);; s = GetNextInFeature(s))
+  {
+    weight += m_estimator->CalcSegmentWeight(s, road);
+    if (s.GetPointId(true /* front */) == toPointId)
+      break;
+  }
+  return weight;
+}
+void IndexGraph::ApplyTimeDependency(Segment const & from, vector<SegmentEdge> & edges)
+{
+  double const * fromTime = m_passTimes.Find(from);
+  double const timeSec = fromTime ? *fromTime : 0.0;
+  auto const timeOfDaySec = static_cast<uint32_t>(m_departureTimeOfDaySec + timeSec) %
+                            SpeedProfiles::kSecondsInDay;
+
+  for (auto & edge : edges)
+  {
+    Segment const & to = edge.GetTarget();
+    double weight = edge.GetWeight().GetWeight();
+    if (HasSpeedProfiles())
+    {
+      // Only the time of passing |to| depends on the speed, penalties are kept as they are.
+      double const segmentWeight = CalcSegmentWeight(to).GetWeight();
+      weight += segmentWeight / m_speedProfiles.GetSpeedFactor(to, timeOfDaySec) - segmentWeight;
+      edge = SegmentEdge(to, RouteWeight(weight));
+    }
+
+    double const passTime = timeSec + weight;
+    double * toTime = m_passTimes.Find(to);
+    if (!toTime)
+      m_passTimes[to] = passTime;
+    else if (passTime < *toTime)
+      *toTime = passTime;
+  }
+}
+
+void IndexGraph::GetLandmarkDistances(RoadPoint const & rp, LandmarkDistances & distances)
+{
+  size_t const numLandmarks = m_landmarks.GetNumLandmarks();
+  distances.m_forward.fill(numeric_limits<double>::infinity());
+  distances.m_backward.fill(numeric_limits<double>::infinity());
+
+  if (!m_roadIndex.IsRoad(rp.GetFeatureId()))
+    return;
+
+  RoadJointIds const & joints = m_roadIndex.GetRoad(rp.GetFeatureId());
+  Joint::Id const jointId = joints.GetJointId(rp.GetPointId());
+  if (jointId != Joint::kInvalidId)
+  {
+    for (size_t i = 0; i < numLandmarks; ++i)
+    {
+      distances.m_forward[i] = m_landmarks.GetDistance(i, jointId, true /* forward */);
+      distances.m_backward[i] = m_landmarks.GetDistance(i, jointId, false /* forward */);
+    }
+    return;
+  }
+
+  RoadGeometry const & road = m_geometry.GetRoad(rp.GetFeatureId());
+  bool const bidirectional = !road.IsOneWay();
+
+  auto const prev = joints.FindNeighbor(rp.GetPointId(), false /* forward */);
+  if (prev.first != Joint::kInvalidId)
+  {
+    double const length = CalcLength(road, prev.second, rp.GetPointId());
+    for (size_t i = 0; i < numLandmarks; ++i)
+    {
+      distances.m_forward[i] = m_landmarks.GetDistance(i, prev.first, true /* forward */) + length;
+      if (bidirectional)
+      {
+        distances.m_backward[i] =
+            length + m_landmarks.GetDistance(i, prev.first, false /* forward */);
+      }
+    }
+  }
+
+  auto const next = joints.FindNeighbor(rp.GetPointId(), true /* forward */);
+  if (next.first != Joint::kInvalidId)
+  {
+    double const length = CalcLength(road, rp.GetPointId(), next.second);
+    for (size_t i = 0; i < numLandmarks; ++i)
+    {
+      distances.m_backward[i] =
+          min(distances.m_backward[i],
+              length + m_landmarks.GetDistance(i, next.first, false /* forward */));
+      if (bidirectional)
+      {
+        distances.m_forward[i] =
+            min(distances.m_forward[i],
+                m_landmarks.GetDistance(i, next.first, true /* forward */) + length);
+      }
+    }
+  }
+}
+
+double IndexGraph::CalcLandmarkHeuristic(RoadPoint const & from, RoadPoint const & to)
+{
+  // It's returned if there's no way from |from| to |to|. The value is finite to keep
+  // the arithmetic of potentials of the bidirectional A* valid.
+  double constexpr kNoWayHeuristicSec = 1e7;
+  double constexpr kInf = numeric_limits<double>::infinity();
+
+  LandmarkDistances fromDistances;
+  LandmarkDistances toDistances;
+  GetLandmarkDistances(from, fromDistances);
+  GetLandmarkDistances(to, toDistances);
+
+  double distance = 0.0;
+  for (size_t i = 0; i < m_landmarks.GetNumLandmarks(); ++i)
+  {
+    // d(from, to) >= d(L, to) - d(L, from).
+    double const fromForward = fromDistances.m_forward[i];
+    double const toForward = toDistances.m_forward[i];
+    if (fromForward != kInf)
+    {
+      if (toForward == kInf)
+        return kNoWayHeuristicSec;
+      distance = max(distance, toForward - fromForward);
+    }
+
+    // d(from, to) >= d(from, L) - d(to, L).
+    double const fromBackward = fromDistances.m_backward[i];
+    double const toBackward = toDistances.m_backward[i];
+    if (toBackward != kInf)
+    {
+      if (fromBackward == kInf)
+        return kNoWayHeuristicSec;
+      distance = max(distance, fromBackward - toBackward);
+    }
+  }
+  return m_estimator->CalcHeuristic(distance);
+}
 }  // namespace routing
@@ -4,15 +4,24 @@
 #include "routing/geometry.hpp"
 #include "routing/joint.hpp"
 #include "routing/joint_index.hpp"
+#include "routing/landmark_index.hpp"
+#include "routing/restriction_index.hpp"
 #include "routing/restrictions_serialization.hpp"
 #include "routing/road_access.hpp"
 #include "routing/road_index.hpp"
 #include "routing/road_point.hpp"
 #include "routing/segment.hpp"
+#include "routing/shortcut_index.hpp"
+#include "routing/speed_profiles.hpp"
+
+#include "routing/base/stamped_hash_map.hpp"
 
 #include "geometry/point2d.hpp"
 
+#include "std/array.hpp"
 #include "std/cstdint.hpp"
+#include "std/function.hpp"
+#include "std/set.hpp"
 #include "std/shared_ptr.hpp"
 #include "std/unique_ptr.hpp"
 #include "std/utility.hpp"
@@ -28,12 +37,28 @@ public:
   using TEdgeType = SegmentEdge;
   using TWeightType = RouteWeight;
 
+  // Returns true if shortcut edges should not pass over |segment|.
+  using IsPinnedFn = function<bool(Segment const & segment)>;
+
   IndexGraph() = default;
   explicit IndexGraph(unique_ptr<GeometryLoader> loader, shared_ptr<EdgeEstimator> estimator);
 
   // Put outgoing (or ingoing) egdes for segment to the 'edges' vector.
   void GetEdgeList(Segment const & segment, bool isOutgoing, vector<SegmentEdge> & edges);
 
+  // Puts outgoing (or ingoing) shortcut edges for segment to the 'edges' vector.
+  // Segments of a chain (see ShortcutIndex) are skipped, so the edges lead to segments which end
+  // at joints or feature ends, or to pinned segments. Shortcut edges never pass over
+  // pinned segments.
+  void GetShortcutEdgeList(Segment const & segment, bool isOutgoing, IsPinnedFn const & isPinned,
+                           vector<SegmentEdge> & edges);
+
+  // Appends to |path| the segments which were skipped by the edge |from| -> |to|.
+  // Does nothing if |from| and |to| are connected with an ordinary edge.
+  void UnpackShortcut(Segment const & from, Segment const & to, vector<Segment> & path);
+  // Restores in |path| all the segments which were skipped by shortcut edges.
+  void UnpackShortcuts(vector<Segment> & path);
+
   Joint::Id GetJointId(RoadPoint const & rp) const { return m_roadIndex.GetJointId(rp); }
 
   Geometry & GetGeometry() { return m_geometry; }
@@ -48,16 +73,49 @@ public:
   uint32_t GetNumRoads() const { return m_roadIndex.GetSize(); }
   uint32_t GetNumJoints() const { return m_jointIndex.GetNumJoints(); }
   uint32_t GetNumPoints() const { return m_jointIndex.GetNumPoints(); }
+  // Returns the approximate number of bytes used by the roads, joints and landmarks.
+  // The memory of the geometry (see Geometry::GetMemorySize()) is not included.
+  size_t GetIndexMemorySize() const
+  {
+    return m_roadIndex.GetMemorySize() + m_jointIndex.GetMemorySize() +
+           m_landmarks.GetMemorySize();
+  }
 
   void Build(uint32_t numJoints);
   void Import(vector<Joint> const & joints);
 
   void SetRestrictions(RestrictionVec && restrictions);
   void SetRoadAccess(RoadAccess && roadAccess);
+  void SetShortcuts(ShortcutIndex && shortcuts);
+  // Landmarks are ignored if they are built for another set of joints.
+  void SetLandmarks(LandmarkIndex && landmarks);
+  void SetSpeedProfiles(SpeedProfiles && speedProfiles);
+
+  bool HasLandmarks() const { return !m_landmarks.IsEmpty(); }
+
+  bool HasSpeedProfiles() const { return !m_speedProfiles.IsEmpty(); }
+
+  // While time dependency is enabled the weights of outgoing edges depend on the time their
+  // targets are entered at. The time is |departureTimeOfDaySec| plus the weight of the best path
+  // from |start| to the source of the edge found so far, and the speed at the time is taken from
+  // the speed profiles. The path weights are known for the one-directional search from |start|
+  // (AStarAlgorithm::FindPath()) only, so ingoing edges are not available in the mode.
+  // Shortcut edges are not used while time dependency is enabled.
+  void EnableTimeDependency(Segment const & start, uint32_t departureTimeOfDaySec);
+  void DisableTimeDependency();
+
+  bool HasShortcuts() const { return !m_shortcuts.IsEmpty(); }
+  // While shortcuts are enabled the interface for AStarAlgorithm returns shortcut edges.
+  // |stops| are the segments a route is looked for between.
+  void EnableShortcuts(vector<Segment> const & stops);
+  void DisableShortcuts();
 
   // Interface for AStarAlgorithm:
   void GetOutgoingEdgesList(Segment const & segment, vector<SegmentEdge> & edges);
   void GetIngoingEdgesList(Segment const & segment, vector<SegmentEdge> & edges);
+  // Returns the straight line estimation. If there are landmarks the landmark estimation is
+  // used too. It's asymmetric and admissible for the routes inside the graph only, the routes
+  // which leave the mwm may be shorter.
   RouteWeight HeuristicCostEstimate(Segment const & from, Segment const & to);
 
   void PushFromSerializer(Joint::Id jointId, RoadPoint const & rp)
@@ -78,12 +136,40 @@ public:
   }
 
 private:
+  // Distances in meters from the landmarks to a road point and from the road point to the
+  // landmarks. Infinity means there's no way.
+  struct LandmarkDistances
+  {
+    array<double, LandmarkIndex::kMaxLandmarks> m_forward;
+    array<double, LandmarkIndex::kMaxLandmarks> m_backward;
+  };
+
   RouteWeight CalcSegmentWeight(Segment const & segment);
   void GetNeighboringEdges(Segment const & from, RoadPoint const & rp, bool isOutgoing,
                            vector<SegmentEdge> & edges);
   void GetNeighboringEdge(Segment const & from, Segment const & to, bool isOutgoing,
                           vector<SegmentEdge> & edges);
   RouteWeight GetPenalties(Segment const & u, Segment const & v) const;
+  // Returns true if the front point of |segment| is a joint or an end of the feature.
+  bool IsChainEnd(Segment const & segment, RoadGeometry const & road) const;
+  // Returns true if the back point of |segment| is a joint or an end of the feature.
+  bool IsChainBegin(Segment const & segment, RoadGeometry const & road) const;
+  bool IsAdjacent(Segment const & from, Segment const & to) const;
+  // Prolongs |edge| along the chain of its target. Returns false if the chain is blocked.
+  bool ProlongOutgoingEdge(IsPinnedFn const & isPinned, SegmentEdge & edge);
+  void GetIngoingShortcutEdgeList(Segment const & segment, IsPinnedFn const & isPinned,
+                                  vector<SegmentEdge> & edges);
+  // Returns the weight of passing the segments which follow |segment| along its feature
+  // up to |toPointId|.
+  double CalcChainWeight(Segment const & segment, uint32_t toPointId,
+                         RoadGeometry const & road) const;
+  // Distances of a point inside a chain are extended from the distances of the chain ends
+  // along the feature. It keeps the estimation consistent along every edge.
+  void GetLandmarkDistances(RoadPoint const & rp, LandmarkDistances & distances);
+  double CalcLandmarkHeuristic(RoadPoint const & from, RoadPoint const & to);
+  // Changes the weights of the outgoing |edges| of |from| according to the times their targets
+  // are entered at and keeps the best times of passing the targets.
+  void ApplyTimeDependency(Segment const & from, vector<SegmentEdge> & edges);
   m2::PointD const & GetPoint(Segment const & segment, bool front)
   {
     return GetGeometry().GetRoad(segment.GetFeatureId()).GetPoint(segment.GetPointId(front));
@@ -93,7 +179,17 @@ private:
   shared_ptr<EdgeEstimator> m_estimator;
   RoadIndex m_roadIndex;
   JointIndex m_jointIndex;
-  RestrictionVec m_restrictions;
+  RestrictionIndex m_restrictions;
   RoadAccess m_roadAccess;
+  ShortcutIndex m_shortcuts;
+  LandmarkIndex m_landmarks;
+  SpeedProfiles m_speedProfiles;
+  bool m_shortcutsEnabled = false;
+  set<Segment> m_shortcutPins;
+  bool m_timeDependent = false;
+  uint32_t m_departureTimeOfDaySec = 0;
+  // Times in seconds since the departure the segments are passed at along the best paths of
+  // the time-dependent search found so far.
+  StampedHashMap<Segment, double> m_passTimes;
 };
 }  // namespace routing
@@ -1,20 +1,62 @@
 #include "routing/index_graph_loader.hpp"
 
 #include "routing/index_graph_serialization.hpp"
+#include "routing/landmark_serialization.hpp"
 #include "routing/restriction_loader.hpp"
 #include "routing/road_access_serialization.hpp"
+#include "routing/road_speeds_serialization.hpp"
 #include "routing/routing_exceptions.hpp"
+#include "routing/shortcut_serialization.hpp"
+#include "routing/speed_profiles_serialization.hpp"
+
+#include "platform/country_file.hpp"
+#include "platform/platform.hpp"
 
 #include "coding/file_container.hpp"
+#include "coding/reader.hpp"
 
 #include "base/assert.hpp"
+#include "base/memory_counters.hpp"
 #include "base/timer.hpp"
 
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
 namespace
 {
 using namespace routing;
 using namespace std;
 
+// Memory of the loaded graphs is checked every kMemoryCheckPeriod requests of graphs because
+// the geometry grows while the graphs are used.
+uint64_t constexpr kMemoryCheckPeriod = 1024;
+
+// Returns nullptr if the mwm has no table of road speeds. Then road speeds are calculated
+// with the vehicle model.
+shared_ptr<RoadSpeeds const> ReadRoadSpeedsFromMwm(MwmValue const & mwmValue,
+                                                   VehicleType vehicleType)
+{
+  if (!mwmValue.m_cont.IsExist(ROAD_SPEEDS_FILE_TAG))
+    return nullptr;
+
+  try
+  {
+    auto const reader = mwmValue.m_cont.GetReader(ROAD_SPEEDS_FILE_TAG);
+    ReaderSource<FilesContainerR::TReader> src(reader);
+
+    auto roadSpeeds = make_shared<RoadSpeeds>();
+    RoadSpeedsSerializer::Deserialize(src, vehicleType, *roadSpeeds);
+    return roadSpeeds;
+  }
+  catch (Reader::OpenException const & e)
+  {
+    LOG(LERROR, ("Error while reading", ROAD_SPEEDS_FILE_TAG, "section.", e.Msg()));
+    return nullptr;
+  }
+}
+
 class IndexGraphLoaderImpl final : public IndexGraphLoader
 {
 public:
@@ -25,23 +67,51 @@ public:
   // IndexGraphLoader overrides:
   virtual IndexGraph & GetIndexGraph(NumMwmId numMwmId) override;
   virtual void Clear() override;
+  virtual double GetLoadingTimeSec() const override { return m_loadingTimeSec; }
+  virtual size_t GetMemorySize() const override;
+  virtual size_t GetPeakMemorySize() const override { return m_peakMemorySize; }
+  virtual void SetMaxMemorySize(size_t maxMemorySize) override { m_maxMemorySize = maxMemorySize; }
 
 private:
+  struct GraphEntry
+  {
+    size_t GetMemorySize() const
+    {
+      return m_indexMemorySize + m_graph->GetGeometry().GetMemorySize();
+    }
+
+    unique_ptr<IndexGraph> m_graph;
+    // Memory of the index doesn't change after loading.
+    size_t m_indexMemorySize = 0;
+    uint64_t m_lastAccess = 0;
+  };
+
   IndexGraph & Load(NumMwmId mwmId);
+  // Updates the peak memory and unloads the least recently used graphs if the memory
+  // exceeds the limit.
+  void CheckMemory();
 
+  VehicleType m_vehicleType;
   VehicleMask m_vehicleMask;
   bool m_loadAltitudes;
   Index & m_index;
   shared_ptr<NumMwmIds> m_numMwmIds;
   shared_ptr<VehicleModelFactoryInterface> m_vehicleModelFactory;
   shared_ptr<EdgeEstimator> m_estimator;
-  unordered_map<NumMwmId, unique_ptr<IndexGraph>> m_graphs;
+  unordered_map<NumMwmId, GraphEntry> m_graphs;
+  double m_loadingTimeSec = 0.0;
+  uint64_t m_accessCount = 0;
+  size_t m_maxMemorySize = 0;
+  size_t m_peakMemorySize = 0;
+  // Memory of graphs as of the last check.
+  base::MemoryCounter m_memory{"routing.index_graphs"};
 };
 
 IndexGraphLoaderImpl::IndexGraphLoaderImpl(VehicleType vehicleType, bool loadAltitudes, shared_ptr<NumMwmIds> numMwmIds,
                                            shared_ptr<VehicleModelFactoryInterface> vehicleModelFactory,
                                            shared_ptr<EdgeEstimator> estimator, Index & index)
-  : m_vehicleMask(GetVehicleMask(vehicleType))
+  : m_vehicleType(vehicleType)
+  , m_vehicleMask(GetVehicleMask(vehicleType))
   , m_loadAltitudes(loadAltitudes)
   , m_index(index)
   , m_numMwmIds(numMwmIds)
@@ -55,15 +125,63 @@ IndexGraphLoaderImpl::IndexGraphLoaderImpl(VehicleType vehicleType, bool loadAlt
 
 IndexGraph & IndexGraphLoaderImpl::GetIndexGraph(NumMwmId numMwmId)
 {
+  ++m_accessCount;
   auto it = m_graphs.find(numMwmId);
-  if (it != m_graphs.end())
-    return *it->second;
+  if (it == m_graphs.end())
+  {
+    IndexGraph & graph = Load(numMwmId);
+    CheckMemory();
+    return graph;
+  }
+
+  it->second.m_lastAccess = m_accessCount;
+  IndexGraph & graph = *it->second.m_graph;
+  // The requested graph is the most recently used one, so it's not unloaded.
+  if (m_accessCount % kMemoryCheckPeriod == 0)
+    CheckMemory();
+  return graph;
+}
+
+size_t IndexGraphLoaderImpl::GetMemorySize() const
+{
+  size_t size = 0;
+  for (auto const & kv : m_graphs)
+    size += kv.second.GetMemorySize();
+  return size;
+}
 
-  return Load(numMwmId);
+void IndexGraphLoaderImpl::CheckMemory()
+{
+  vector<IndexGraphUsage> usages;
+  usages.reserve(m_graphs.size());
+  size_t memorySize = 0;
+  for (auto const & kv : m_graphs)
+  {
+    IndexGraphUsage usage;
+    usage.m_mwmId = kv.first;
+    usage.m_lastAccess = kv.second.m_lastAccess;
+    usage.m_memorySize = kv.second.GetMemorySize();
+    memorySize += usage.m_memorySize;
+    usages.push_back(usage);
+  }
+  m_peakMemorySize = max(m_peakMemorySize, memorySize);
+  m_memory.Set(memorySize);
+
+  if (m_maxMemorySize == 0 || memorySize <= m_maxMemorySize)
+    return;
+
+  auto const unloaded = ChooseGraphsToUnload(move(usages), m_maxMemorySize, kMinResidentGraphs);
+  for (auto const numMwmId : unloaded)
+    m_graphs.erase(numMwmId);
+  m_memory.Set(GetMemorySize());
+
+  LOG(LINFO, ("Unloaded", unloaded.size(), "index graphs, memory of graphs:", memorySize, "->",
+              GetMemorySize(), "bytes, limit:", m_maxMemorySize));
 }
 
 IndexGraph & IndexGraphLoaderImpl::Load(NumMwmId numMwmId)
 {
+  my::Timer loadingTimer;
   platform::CountryFile const & file = m_numMwmIds->GetFile(numMwmId);
   MwmSet::MwmHandle handle = m_index.GetMwmHandleByCountryFile(file);
   if (!handle.IsAlive())
@@ -72,21 +190,30 @@ IndexGraph & IndexGraphLoaderImpl::Load(NumMwmId numMwmId)
   shared_ptr<VehicleModelInterface> vehicleModel =
       m_vehicleModelFactory->GetVehicleModelForCountry(file.GetName());
 
+  my::Timer timer;
+  MwmValue const & mwmValue = *handle.GetValue<MwmValue>();
   auto graphPtr = make_unique<IndexGraph>(
-      GeometryLoader::Create(m_index, handle, vehicleModel, m_loadAltitudes),
+      GeometryLoader::Create(m_index, handle, vehicleModel,
+                             ReadRoadSpeedsFromMwm(mwmValue, m_vehicleType), m_loadAltitudes),
       m_estimator);
   IndexGraph & graph = *graphPtr;
 
-  my::Timer timer;
-  MwmValue const & mwmValue = *handle.GetValue<MwmValue>();
   DeserializeIndexGraph(mwmValue, m_vehicleMask, graph);
-  m_graphs[numMwmId] = move(graphPtr);
+  GraphEntry & entry = m_graphs[numMwmId];
+  entry.m_indexMemorySize = graph.GetIndexMemorySize();
+  entry.m_lastAccess = m_accessCount;
+  entry.m_graph = move(graphPtr);
   LOG(LINFO, (ROUTING_FILE_TAG, "section for", file.GetName(), "loaded in", timer.ElapsedSeconds(),
               "seconds"));
+  m_loadingTimeSec += loadingTimer.ElapsedSeconds();
   return graph;
 }
 
-void IndexGraphLoaderImpl::Clear() { m_graphs.clear(); }
+void IndexGraphLoaderImpl::Clear()
+{
+  m_graphs.clear();
+  m_memory.Set(0);
+}
 
 bool ReadRoadAccessFromMwm(MwmValue const & mwmValue, RoadAccess & roadAccess)
 {
@@ -107,6 +234,89 @@ bool ReadRoadAccessFromMwm(MwmValue const & mwmValue, RoadAccess & roadAccess)
   }
   return true;
 }
+
+// Index graph is decoded bit by bit. It's many times faster to decode it from memory than through
+// the cache of FileReader. So the section is mapped when the mwm is a regular file and it's read
+// in one go otherwise (e.g. the mwm is packed into the application bundle).
+template <typename Fn>
+void ReadRoutingSection(MwmValue const & mwmValue, Fn && fn)
+{
+  string const path = mwmValue.m_file.GetPath(MapOptions::Map);
+  if (Platform::IsFileExistsByFullPath(path))
+  {
+    FilesMappingContainer container(path);
+    FilesMappingContainer::Handle const handle = container.Map(ROUTING_FILE_TAG);
+    MemReader reader(handle.GetData<uint8_t>(), handle.GetSize());
+    fn(reader);
+    return;
+  }
+
+  FilesContainerR::TReader reader(mwmValue.m_cont.GetReader(ROUTING_FILE_TAG));
+  vector<uint8_t> buffer(reader.Size());
+  reader.Read(0 /* pos */, buffer.data(), buffer.size());
+  MemReader memReader(buffer.data(), buffer.size());
+  fn(memReader);
+}
+
+bool ReadShortcutsFromMwm(MwmValue const & mwmValue, ShortcutIndex & shortcuts)
+{
+  if (!mwmValue.m_cont.IsExist(SHORTCUTS_FILE_TAG))
+    return false;
+
+  try
+  {
+    auto const reader = mwmValue.m_cont.GetReader(SHORTCUTS_FILE_TAG);
+    ReaderSource<FilesContainerR::TReader> src(reader);
+
+    ShortcutSerializer::Deserialize(src, shortcuts);
+  }
+  catch (Reader::OpenException const & e)
+  {
+    LOG(LERROR, ("Error while reading", SHORTCUTS_FILE_TAG, "section.", e.Msg()));
+    return false;
+  }
+  return true;
+}
+
+bool ReadLandmarksFromMwm(MwmValue const & mwmValue, LandmarkIndex & landmarks)
+{
+  if (!mwmValue.m_cont.IsExist(LANDMARKS_FILE_TAG))
+    return false;
+
+  try
+  {
+    auto const reader = mwmValue.m_cont.GetReader(LANDMARKS_FILE_TAG);
+    ReaderSource<FilesContainerR::TReader> src(reader);
+
+    LandmarkSerializer::Deserialize(src, landmarks);
+  }
+  catch (Reader::OpenException const & e)
+  {
+    LOG(LERROR, ("Error while reading", LANDMARKS_FILE_TAG, "section.", e.Msg()));
+    return false;
+  }
+  return true;
+}
+
+bool ReadSpeedProfilesFromMwm(MwmValue const & mwmValue, SpeedProfiles & speedProfiles)
+{
+  if (!mwmValue.m_cont.IsExist(SPEED_PROFILES_FILE_TAG))
+    return false;
+
+  try
+  {
+    auto const reader = mwmValue.m_cont.GetReader(SPEED_PROFILES_FILE_TAG);
+    ReaderSource<FilesContainerR::TReader> src(reader);
+
+    SpeedProfilesSerializer::Deserialize(src, speedProfiles);
+  }
+  catch (Reader::OpenException const & e)
+  {
+    LOG(LERROR, ("Error while reading", SPEED_PROFILES_FILE_TAG, "section.", e.Msg()));
+    return false;
+  }
+  return true;
+}
 }  // namespace
 
 namespace routing
@@ -121,11 +331,37 @@ unique_ptr<IndexGraphLoader> IndexGraphLoader::Create(
                                            estimator, index);
 }
 
+vector<NumMwmId> ChooseGraphsToUnload(vector<IndexGraphUsage> usages, size_t maxMemorySize,
+                                      size_t minResidentGraphs)
+{
+  // The most recently used graphs go first.
+  sort(usages.begin(), usages.end(), [](IndexGraphUsage const & lhs, IndexGraphUsage const & rhs) {
+    return lhs.m_lastAccess > rhs.m_lastAccess;
+  });
+
+  vector<NumMwmId> unloaded;
+  size_t memorySize = 0;
+  for (size_t i = 0; i < usages.size(); ++i)
+  {
+    memorySize += usages[i].m_memorySize;
+    if (i >= minResidentGraphs && memorySize > maxMemorySize)
+      unloaded.push_back(usages[i].m_mwmId);
+  }
+  return unloaded;
+}
+
+void DeserializeIndexGraphJoints(MwmValue const & mwmValue, VehicleMask vehicleMask,
+                                 IndexGraph & graph)
+{
+  ReadRoutingSection(mwmValue, [&](MemReader const & reader) {
+    ReaderSource<MemReader> src(reader);
+    IndexGraphSerializer::Deserialize(graph, src, vehicleMask);
+  });
+}
+
 void DeserializeIndexGraph(MwmValue const & mwmValue, VehicleMask vehicleMask, IndexGraph & graph)
 {
-  FilesContainerR::TReader reader(mwmValue.m_cont.GetReader(ROUTING_FILE_TAG));
-  ReaderSource<FilesContainerR::TReader> src(reader);
-  IndexGraphSerializer::Deserialize(graph, src, vehicleMask);
+  DeserializeIndexGraphJoints(mwmValue, vehicleMask, graph);
   RestrictionLoader restrictionLoader(mwmValue, graph);
   if (restrictionLoader.HasRestrictions())
     graph.SetRestrictions(restrictionLoader.StealRestrictions());
@@ -133,5 +369,20 @@ void DeserializeIndexGraph(MwmValue const & mwmValue, VehicleMask vehicleMask, I
   RoadAccess roadAccess;
   if (ReadRoadAccessFromMwm(mwmValue, roadAccess))
     graph.SetRoadAccess(move(roadAccess));
+
+  // Chain weights are precomputed for cars only.
+  ShortcutIndex shortcuts;
+  if (vehicleMask == kCarMask && ReadShortcutsFromMwm(mwmValue, shortcuts))
+    graph.SetShortcuts(move(shortcuts));
+
+  // Landmark distances are calculated for the car graph only.
+  LandmarkIndex landmarks;
+  if (vehicleMask == kCarMask && ReadLandmarksFromMwm(mwmValue, landmarks))
+    graph.SetLandmarks(move(landmarks));
+
+  // Historical speeds are collected for cars only.
+  SpeedProfiles speedProfiles;
+  if (vehicleMask == kCarMask && ReadSpeedProfilesFromMwm(mwmValue, speedProfiles))
+    graph.SetSpeedProfiles(move(speedProfiles));
 }
 }  // namespace routing
@@ -9,7 +9,10 @@
 
 #include "indexer/index.hpp"
 
+#include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <vector>
 
 namespace routing
 {
@@ -20,6 +23,17 @@ public:
 
   virtual IndexGraph & GetIndexGraph(NumMwmId mwmId) = 0;
   virtual void Clear() = 0;
+  // Returns the total time spent on loading of graphs. Clear() doesn't reset it.
+  virtual double GetLoadingTimeSec() const = 0;
+  // Returns the approximate number of bytes used by the loaded graphs and their geometry.
+  virtual size_t GetMemorySize() const = 0;
+  // Returns the maximum of GetMemorySize() since the loader was created.
+  virtual size_t GetPeakMemorySize() const = 0;
+  // When the memory of the loaded graphs exceeds |maxMemorySize| the least recently used graphs
+  // are unloaded. They are loaded again when they are requested. Zero means no limit.
+  // Graphs are unloaded only inside GetIndexGraph() and the kMinResidentGraphs most recently
+  // used graphs are never unloaded, so the references to them stay valid.
+  virtual void SetMaxMemorySize(size_t maxMemorySize) = 0;
 
   static std::unique_ptr<IndexGraphLoader> Create(
       VehicleType vehicleType, bool loadAltitudes, std::shared_ptr<NumMwmIds> numMwmIds,
@@ -28,4 +42,24 @@ public:
 };
 
 void DeserializeIndexGraph(MwmValue const & mwmValue, VehicleMask vehicleMask, IndexGraph & graph);
+// Reads the roads and joints of the routing section only, restrictions, road access and other
+// sections of the graph aren't read.
+void DeserializeIndexGraphJoints(MwmValue const & mwmValue, VehicleMask vehicleMask,
+                                 IndexGraph & graph);
+
+size_t constexpr kMinResidentGraphs = 4;
+
+struct IndexGraphUsage
+{
+  NumMwmId m_mwmId = kFakeNumMwmId;
+  // The number of the last access to the graph, greater numbers are more recent.
+  uint64_t m_lastAccess = 0;
+  size_t m_memorySize = 0;
+};
+
+// Returns the mwms of the graphs which should be unloaded to fit |maxMemorySize|. The least
+// recently used graphs are unloaded first, |minResidentGraphs| most recently used graphs are
+// kept anyway. Graphs far behind the search wave aren't used lately, so they go first.
+std::vector<NumMwmId> ChooseGraphsToUnload(std::vector<IndexGraphUsage> usages,
+                                           size_t maxMemorySize, size_t minResidentGraphs);
 }  // namespace routing
@@ -288,6 +288,32 @@ bool IndexGraphStarter::IsLeap(NumMwmId mwmId) const
   return m_graph.GetEstimator().LeapIsAllowed(mwmId);
 }
 
+void IndexGraphStarter::EnableShortcuts() const
+{
+  vector<Segment> stops;
+  stops.reserve(m_fake.m_realToFake.size());
+  for (auto const & kv : m_fake.m_realToFake)
+    stops.push_back(kv.first);
+
+  m_graph.EnableShortcuts(stops);
+}
+
+void IndexGraphStarter::DisableShortcuts() const { m_graph.DisableShortcuts(); }
+
+void IndexGraphStarter::UnpackShortcuts(vector<Segment> & route) const
+{
+  // Shortcut edges are not used in LeapsOnly mode. In LeapsIfPossible mode segments of leap mwms
+  // are connected with leaps which should be processed by IndexRouter::ProcessLeaps().
+  switch (m_graph.GetMode())
+  {
+  case WorldGraph::Mode::LeapsOnly: return;
+  case WorldGraph::Mode::LeapsIfPossible:
+    m_graph.UnpackShortcuts(route, [this](NumMwmId mwmId) { return IsLeap(mwmId); });
+    return;
+  case WorldGraph::Mode::NoLeaps: m_graph.UnpackShortcuts(route); return;
+  }
+}
+
 void IndexGraphStarter::AddEnding(FakeEnding const & thisEnding, FakeEnding const & otherEnding,
                                   bool isStart, bool strictForward, uint32_t & fakeNumerationStart)
 {
@@ -107,6 +107,13 @@ public:
 
   bool IsLeap(NumMwmId mwmId) const;
 
+  // Makes the world graph return shortcut edges which do not pass over the real segments
+  // the fake endings are attached to.
+  void EnableShortcuts() const;
+  void DisableShortcuts() const;
+  // Restores in |route| the segments which were skipped by shortcut edges.
+  void UnpackShortcuts(std::vector<Segment> & route) const;
+
 private:
   class FakeVertex final
   {
@@ -13,6 +13,7 @@
 #include "routing/road_graph_router.hpp"
 #include "routing/route.hpp"
 #include "routing/routing_helpers.hpp"
+#include "routing/subroute_cache.hpp"
 #include "routing/turns_generator.hpp"
 #include "routing/vehicle_mask.hpp"
 
@@ -30,8 +31,11 @@
 
 #include "base/exception.hpp"
 #include "base/stl_helpers.hpp"
+#include "base/thread.hpp"
+#include "base/timer.hpp"
 
 #include <algorithm>
+#include <atomic>
 #include <map>
 #include <utility>
 
@@ -50,6 +54,11 @@ double constexpr kAdjustRangeM = 5000.0;
 double constexpr kMinDistanceToFinishM = 10000;
 // Limit of adjust in seconds.
 double constexpr kAdjustLimitSec = 5 * 60;
+// Total number of segments of the cached subroutes.
+size_t constexpr kSubrouteCacheCapacity = 1 << 20;
+// Bicycle and pedestrian routes don't use leaps, so the search wave passes through every mwm
+// between the checkpoints. Graphs far behind the wave are unloaded to keep memory bounded.
+size_t constexpr kMaxNoLeapsGraphsMemory = 100 * 1024 * 1024;
 
 double CalcMaxSpeed(NumMwmIds const & numMwmIds, VehicleModelFactoryInterface const & vehicleModelFactory)
 {
@@ -120,11 +129,29 @@ IRouter::ResultCode FindPath(
     typename Graph::TVertexType const & start, typename Graph::TVertexType const & finish,
     RouterDelegate const & delegate, Graph & graph,
     typename AStarAlgorithm<Graph>::TOnVisitedVertexCallback const & onVisitedVertexCallback,
+    typename AStarAlgorithm<Graph>::BidirectionalContext & context,
     RoutingResult<typename Graph::TVertexType, typename Graph::TWeightType> & routingResult)
 {
   AStarAlgorithm<Graph> algorithm;
-  return ConvertResult<Graph>(algorithm.FindPathBidirectional(graph, start, finish, routingResult,
-                                                              delegate, onVisitedVertexCallback));
+  return ConvertResult<Graph>(algorithm.FindPathBidirectional(
+      context, graph, start, finish, routingResult, delegate, onVisitedVertexCallback));
+}
+
+template <typename Graph>
+IRouter::ResultCode FindPathWithAlternatives(
+    typename Graph::TVertexType const & start, typename Graph::TVertexType const & finish,
+    RouterDelegate const & delegate, Graph & graph,
+    typename AStarAlgorithm<Graph>::TOnVisitedVertexCallback const & onVisitedVertexCallback,
+    typename AStarAlgorithm<Graph>::BidirectionalContext & context, size_t maxAlternatives,
+    RoutingResult<typename Graph::TVertexType, typename Graph::TWeightType> & routingResult,
+    vector<RoutingResult<typename Graph::TVertexType, typename Graph::TWeightType>> & alternatives)
+{
+  AStarAlgorithm<Graph> algorithm;
+  typename AStarAlgorithm<Graph>::AlternativesParams params;
+  params.m_maxAlternatives = maxAlternatives;
+  return ConvertResult<Graph>(algorithm.FindPathWithAlternatives(
+      context, graph, start, finish, params, routingResult, alternatives, delegate,
+      onVisitedVertexCallback));
 }
 
 bool IsDeadEnd(Segment const & segment, bool isOutgoing, WorldGraph & worldGraph)
@@ -221,10 +248,139 @@ bool GetLastRealOrPart(IndexGraphStarter const & starter, vector<Segment> const
   }
   return false;
 }
+
+// Restricts the graph of |starter| to the real segments of a cached subroute and the fake
+// segments of |starter|. The cached subroute was calculated for other projections of
+// the checkpoints to the same segments, so the search along it is very cheap and the best route
+// between the new projections nearly always follows it.
+class CorridorGraph final
+{
+public:
+  // AStarAlgorithm types aliases:
+  using TVertexType = IndexGraphStarter::TVertexType;
+  using TEdgeType = IndexGraphStarter::TEdgeType;
+  using TWeightType = IndexGraphStarter::TWeightType;
+
+  // |corridor| should be sorted.
+  CorridorGraph(IndexGraphStarter const & starter, vector<Segment> const & corridor)
+    : m_starter(starter), m_corridor(corridor)
+  {
+  }
+
+  void GetOutgoingEdgesList(TVertexType const & segment, vector<TEdgeType> & edges) const
+  {
+    m_starter.GetOutgoingEdgesList(segment, edges);
+    FilterEdges(edges);
+  }
+
+  void GetIngoingEdgesList(TVertexType const & segment, vector<TEdgeType> & edges) const
+  {
+    m_starter.GetIngoingEdgesList(segment, edges);
+    FilterEdges(edges);
+  }
+
+  RouteWeight HeuristicCostEstimate(TVertexType const & from, TVertexType const & to) const
+  {
+    return m_starter.HeuristicCostEstimate(from, to);
+  }
+
+private:
+  void FilterEdges(vector<TEdgeType> & edges) const
+  {
+    my::EraseIf(edges, [this](TEdgeType const & edge) {
+      Segment real = edge.GetTarget();
+      // Pure fake segments connect the checkpoints to the corridor.
+      if (!m_starter.ConvertToReal(real))
+        return false;
+      return !binary_search(m_corridor.cbegin(), m_corridor.cend(), real);
+    });
+  }
+
+  IndexGraphStarter const & m_starter;
+  vector<Segment> const & m_corridor;
+};
+
+// Fills |row| with travel times from |source| to |targets|. One-to-many wave is propagated
+// from |source| until all the |targets| are settled.
+void CalculateMatrixRow(WorldGraph & graph, Segment const & source,
+                        vector<Segment> const & targets, RouterDelegate const & delegate,
+                        double * row)
+{
+  set<Segment> unsettled(targets.cbegin(), targets.cend());
+  uint32_t visitCount = 0;
+  auto const visitVertex = [&](Segment const & vertex) {
+    if (++visitCount % kVisitPeriod == 0 && delegate.IsCancelled())
+      return false;
+
+    unsettled.erase(vertex);
+    return !unsettled.empty();
+  };
+
+  AStarAlgorithm<WorldGraph> algorithm;
+  AStarAlgorithm<WorldGraph>::Context context;
+  algorithm.PropagateWave(graph, source, visitVertex, context);
+
+  for (size_t i = 0; i < targets.size(); ++i)
+  {
+    row[i] = context.HasDistance(targets[i]) ? context.GetDistance(targets[i]).GetWeight()
+                                             : IndexRouter::kNoRouteTime;
+  }
+}
+
+// Calculates the matrix rows one by one while there are rows nobody has taken yet.
+// Each routine has its own world graph because graphs cache roads and aren't thread-safe.
+class MatrixRowsRoutine final : public threads::IRoutine
+{
+public:
+  MatrixRowsRoutine(WorldGraph && graph, vector<Segment> const & sources,
+                    vector<Segment> const & targets, RouterDelegate const & delegate,
+                    atomic<size_t> & nextRow, atomic<bool> & failed, vector<double> & matrix)
+    : m_graph(move(graph))
+    , m_sources(sources)
+    , m_targets(targets)
+    , m_delegate(delegate)
+    , m_nextRow(nextRow)
+    , m_failed(failed)
+    , m_matrix(matrix)
+  {
+  }
+
+  // threads::IRoutine overrides:
+  void Do() override
+  {
+    try
+    {
+      for (size_t row = m_nextRow++; row < m_sources.size(); row = m_nextRow++)
+      {
+        if (m_failed || m_delegate.IsCancelled())
+          return;
+
+        CalculateMatrixRow(m_graph, m_sources[row], m_targets, m_delegate,
+                           m_matrix.data() + row * m_targets.size());
+      }
+    }
+    catch (RootException const & e)
+    {
+      LOG(LERROR, ("Can't calculate route matrix row:", e.what()));
+      m_failed = true;
+    }
+  }
+
+private:
+  WorldGraph m_graph;
+  vector<Segment> const & m_sources;
+  vector<Segment> const & m_targets;
+  RouterDelegate const & m_delegate;
+  atomic<size_t> & m_nextRow;
+  atomic<bool> & m_failed;
+  vector<double> & m_matrix;
+};
 }  // namespace
 
 namespace routing
 {
+double constexpr IndexRouter::kNoRouteTime;
+
 // IndexRouter::BestEdgeComparator ----------------------------------------------------------------
 IndexRouter::BestEdgeComparator::BestEdgeComparator(m2::PointD const & point, m2::PointD const & direction)
   : m_point(point), m_direction(direction)
@@ -293,6 +449,7 @@ IndexRouter::IndexRouter(VehicleType vehicleType, bool loadAltitudes,
   , m_estimator(EdgeEstimator::Create(
         m_vehicleType, CalcMaxSpeed(*m_numMwmIds, *m_vehicleModelFactory), m_trafficStash))
   , m_directionsEngine(CreateDirectionsEngine(m_vehicleType, m_numMwmIds, m_index))
+  , m_subrouteCache(kSubrouteCacheCapacity)
 {
   CHECK(!m_name.empty(), ());
   CHECK(m_numMwmIds, ());
@@ -352,7 +509,8 @@ IRouter::ResultCode IndexRouter::CalculateRoute(Checkpoints const & checkpoints,
           MercatorBounds::ToLatLon(finalPoint)));
       }
     }
-    return DoCalculateRoute(checkpoints, startDirection, delegate, route);
+    return DoCalculateRoute(checkpoints, startDirection, delegate, 0 /* maxAlternatives */, route,
+                            nullptr /* alternatives */);
   }
   catch (RootException const & e)
   {
@@ -362,11 +520,147 @@ IRouter::ResultCode IndexRouter::CalculateRoute(Checkpoints const & checkpoints,
   }
 }
 
+IRouter::ResultCode IndexRouter::CalculateRouteWithAlternatives(
+    Checkpoints const & checkpoints, m2::PointD const & startDirection, size_t maxAlternatives,
+    RouterDelegate const & delegate, Route & route, vector<unique_ptr<Route>> & alternatives)
+{
+  alternatives.clear();
+
+  vector<string> outdatedMwms;
+  GetOutdatedMwms(m_vehicleType, m_index, outdatedMwms);
+  if (!outdatedMwms.empty())
+  {
+    for (string const & mwm : outdatedMwms)
+      route.AddAbsentCountry(mwm);
+
+    return IRouter::FileTooOld;
+  }
+
+  try
+  {
+    return DoCalculateRoute(checkpoints, startDirection, delegate, maxAlternatives, route,
+                            &alternatives);
+  }
+  catch (RootException const & e)
+  {
+    LOG(LERROR, ("Can't find path from", MercatorBounds::ToLatLon(checkpoints.GetStart()), "to",
+                 MercatorBounds::ToLatLon(checkpoints.GetFinish()), ":\n ", e.what()));
+    alternatives.clear();
+    return IRouter::InternalError;
+  }
+}
+
+IRouter::ResultCode IndexRouter::CalculateRouteMatrix(vector<m2::PointD> const & sources,
+                                                      vector<m2::PointD> const & targets,
+                                                      RouterDelegate const & delegate,
+                                                      size_t threadsNum, vector<double> & matrix)
+{
+  matrix.clear();
+
+  vector<string> outdatedMwms;
+  GetOutdatedMwms(m_vehicleType, m_index, outdatedMwms);
+  if (!outdatedMwms.empty())
+    return IRouter::FileTooOld;
+
+  try
+  {
+    return DoCalculateRouteMatrix(sources, targets, delegate, threadsNum, matrix);
+  }
+  catch (RootException const & e)
+  {
+    LOG(LERROR, ("Can't calculate route matrix of", sources.size(), "x", targets.size(),
+                 "points:\n ", e.what()));
+    matrix.clear();
+    return IRouter::InternalError;
+  }
+}
+
+IRouter::ResultCode IndexRouter::DoCalculateRouteMatrix(vector<m2::PointD> const & sources,
+                                                        vector<m2::PointD> const & targets,
+                                                        RouterDelegate const & delegate,
+                                                        size_t threadsNum,
+                                                        vector<double> & matrix)
+{
+  for (auto const * points : {&sources, &targets})
+  {
+    for (auto const & point : *points)
+    {
+      string const countryName = m_countryFileFn(point);
+      if (countryName.empty())
+      {
+        LOG(LWARNING, ("For point", MercatorBounds::ToLatLon(point),
+                       "CountryInfoGetter returns an empty CountryFile()."));
+        return IRouter::InternalError;
+      }
+
+      if (!m_index.IsLoaded(platform::CountryFile(countryName)))
+        return IRouter::NeedMoreMaps;
+    }
+  }
+
+  TrafficStash::Guard guard(m_trafficStash);
+  WorldGraph graph = MakeWorldGraph();
+  graph.SetMode(WorldGraph::Mode::NoLeaps);
+
+  // Snapping uses |m_roadGraph| which isn't thread-safe so it's done before the rows calculation.
+  vector<Segment> sourceSegments;
+  if (!FindBestSegments(sources, true /* isOutgoing */, graph, sourceSegments))
+    return IRouter::StartPointNotFound;
+
+  vector<Segment> targetSegments;
+  if (!FindBestSegments(targets, false /* isOutgoing */, graph, targetSegments))
+    return IRouter::EndPointNotFound;
+
+  matrix.assign(sources.size() * targets.size(), kNoRouteTime);
+  if (targets.empty())
+    return IRouter::NoError;
+
+  threadsNum = min(threadsNum, sources.size());
+  if (threadsNum <= 1)
+  {
+    for (size_t row = 0; row < sourceSegments.size(); ++row)
+    {
+      CalculateMatrixRow(graph, sourceSegments[row], targetSegments, delegate,
+                         matrix.data() + row * targetSegments.size());
+      if (delegate.IsCancelled())
+        return IRouter::Cancelled;
+    }
+    return IRouter::NoError;
+  }
+
+  atomic<size_t> nextRow(0);
+  atomic<bool> failed(false);
+  threads::SimpleThreadPool pool(threadsNum);
+  for (size_t i = 0; i < threadsNum; ++i)
+  {
+    WorldGraph rowsGraph = i == 0 ? move(graph) : MakeWorldGraph();
+    rowsGraph.SetMode(WorldGraph::Mode::NoLeaps);
+    pool.Add(my::make_unique<MatrixRowsRoutine>(move(rowsGraph), sourceSegments, targetSegments,
+                                                delegate, nextRow, failed, matrix));
+  }
+  pool.Join();
+
+  if (failed)
+    return IRouter::InternalError;
+
+  if (delegate.IsCancelled())
+    return IRouter::Cancelled;
+
+  return IRouter::NoError;
+}
+
 IRouter::ResultCode IndexRouter::DoCalculateRoute(Checkpoints const & checkpoints,
                                                   m2::PointD const & startDirection,
-                                                  RouterDelegate const & delegate, Route & route)
+                                                  RouterDelegate const & delegate,
+                                                  size_t maxAlternatives, Route & route,
+                                                  vector<unique_ptr<Route>> * alternatives)
 {
+  CHECK(maxAlternatives == 0 || alternatives, ());
+  if (checkpoints.GetNumSubroutes() != 1)
+    maxAlternatives = 0;
+
   m_lastRoute.reset();
+  m_lastStats = Stats();
 
   for (auto const & checkpoint : checkpoints.GetPoints())
   {
@@ -392,6 +686,7 @@ IRouter::ResultCode IndexRouter::DoCalculateRoute(Checkpoints const & checkpoint
 
   vector<Segment> segments;
 
+  my::Timer snappingTimer;
   Segment startSegment;
   bool startSegmentIsAlmostCodirectionalDirection = false;
   if (!FindBestSegment(checkpoints.GetPointFrom(), startDirection, true /* isOutgoing */, graph,
@@ -399,8 +694,10 @@ IRouter::ResultCode IndexRouter::DoCalculateRoute(Checkpoints const & checkpoint
   {
     return IRouter::StartPointNotFound;
   }
+  m_lastStats.m_snappingSec += snappingTimer.ElapsedSeconds();
 
   size_t subrouteSegmentsBegin = 0;
+  vector<vector<Segment>> alternativeSubroutes;
   vector<Route::SubrouteAttrs> subroutes;
   PushPassedSubroutes(checkpoints, subroutes);
   unique_ptr<IndexGraphStarter> starter;
@@ -412,6 +709,7 @@ IRouter::ResultCode IndexRouter::DoCalculateRoute(Checkpoints const & checkpoint
     auto const & startCheckpoint = checkpoints.GetPoint(i);
     auto const & finishCheckpoint = checkpoints.GetPoint(i + 1);
 
+    snappingTimer.Reset();
     Segment finishSegment;
     bool dummy = false;
     if (!FindBestSegment(finishCheckpoint, m2::PointD::Zero() /* direction */,
@@ -420,6 +718,7 @@ IRouter::ResultCode IndexRouter::DoCalculateRoute(Checkpoints const & checkpoint
     {
       return isLastSubroute ? IRouter::EndPointNotFound : IRouter::IntermediatePointNotFound;
     }
+    m_lastStats.m_snappingSec += snappingTimer.ElapsedSeconds();
 
     bool isStartSegmentStrictForward = m_vehicleType == VehicleType::Car ? true : false;
     if (isFirstSubroute)
@@ -432,8 +731,24 @@ IRouter::ResultCode IndexRouter::DoCalculateRoute(Checkpoints const & checkpoint
 
     vector<Segment> subroute;
     Junction startJunction;
-    auto const result = CalculateSubroute(checkpoints, i, startSegment, delegate, subrouteStarter,
-                                          subroute, startJunction);
+    my::Timer searchTimer;
+    SubrouteCache::Key const cacheKey(startSegment, finishSegment, isStartSegmentStrictForward);
+    // Alternatives are taken from the search spaces, so they can't be found for cached subroutes.
+    auto result = maxAlternatives == 0
+                      ? FindCachedSubroute(cacheKey, delegate, subrouteStarter, subroute)
+                      : IRouter::RouteNotFound;
+    if (result == IRouter::NoError)
+    {
+      ++m_lastStats.m_cachedSubroutes;
+    }
+    else if (result != IRouter::Cancelled)
+    {
+      result = CalculateSubroute(checkpoints, i, startSegment, delegate, subrouteStarter,
+                                 maxAlternatives, subroute, &alternativeSubroutes, startJunction);
+      if (result == IRouter::NoError)
+        PutSubrouteToCache(cacheKey, subrouteStarter, subroute);
+    }
+    m_lastStats.m_searchSec += searchTimer.ElapsedSeconds();
 
     if (result != IRouter::NoError)
       return result;
@@ -460,6 +775,8 @@ IRouter::ResultCode IndexRouter::DoCalculateRoute(Checkpoints const & checkpoint
   IndexGraphStarter::CheckValidRoute(segments);
 
   auto redressResult = RedressRoute(segments, delegate, *starter, route);
+  m_lastStats.m_graphLoadingSec = graph.GetIndexGraphsLoadingTimeSec();
+  m_lastStats.m_peakGraphsMemory = graph.GetIndexGraphsPeakMemorySize();
   if (redressResult != IRouter::NoError)
     return redressResult;
 
@@ -468,6 +785,31 @@ IRouter::ResultCode IndexRouter::DoCalculateRoute(Checkpoints const & checkpoint
   for (Segment const & segment : segments)
     m_lastRoute->AddStep(segment, starter->GetPoint(segment, true /* front */));
 
+  // There's only one subroute if there are alternatives.
+  for (auto const & alternativeSubroute : alternativeSubroutes)
+  {
+    IndexGraphStarter::CheckValidRoute(alternativeSubroute);
+
+    auto alternative = make_unique<Route>(route.GetRouterId());
+    vector<Route::SubrouteAttrs> alternativeAttrs;
+    alternativeAttrs.emplace_back(starter->GetStartJunction(), starter->GetFinishJunction(),
+                                  0 /* beginSegmentIdx */, alternativeSubroute.size());
+    alternative->SetCurrentSubrouteIdx(0);
+    alternative->SetSubroteAttrs(move(alternativeAttrs));
+
+    auto const alternativeResult =
+        RedressRoute(alternativeSubroute, delegate, *starter, *alternative);
+    if (alternativeResult == IRouter::Cancelled)
+      return alternativeResult;
+
+    if (alternativeResult != IRouter::NoError)
+    {
+      LOG(LWARNING, ("Can't redress an alternative route:", alternativeResult));
+      continue;
+    }
+    alternatives->push_back(move(alternative));
+  }
+
   m_lastFakeEdges = make_unique<FakeEdgesContainer>(move(*starter));
 
   return IRouter::NoError;
@@ -477,10 +819,15 @@ IRouter::ResultCode IndexRouter::CalculateSubroute(Checkpoints const & checkpoin
                                                    size_t subrouteIdx, Segment const & startSegment,
                                                    RouterDelegate const & delegate,
                                                    IndexGraphStarter & starter,
+                                                   size_t maxAlternatives,
                                                    vector<Segment> & subroute,
+                                                   vector<vector<Segment>> * alternatives,
                                                    Junction & startJunction)
 {
+  CHECK(maxAlternatives == 0 || alternatives, ());
   subroute.clear();
+  if (alternatives)
+    alternatives->clear();
 
   // We use leaps for cars only. Other vehicle types do not have weights in their cross-mwm sections.
   switch (m_vehicleType)
@@ -527,25 +874,107 @@ IRouter::ResultCode IndexRouter::CalculateSubroute(Checkpoints const & checkpoin
   };
 
   RoutingResult<Segment, RouteWeight> routingResult;
-  IRouter::ResultCode const result = FindPath(starter.GetStartSegment(), starter.GetFinishSegment(),
-                                              delegate, starter, onVisitJunction, routingResult);
+  vector<RoutingResult<Segment, RouteWeight>> alternativeResults;
+  starter.EnableShortcuts();
+  IRouter::ResultCode const result =
+      maxAlternatives == 0
+          ? FindPath(starter.GetStartSegment(), starter.GetFinishSegment(), delegate, starter,
+                     onVisitJunction, m_searchContext, routingResult)
+          : FindPathWithAlternatives(starter.GetStartSegment(), starter.GetFinishSegment(),
+                                     delegate, starter, onVisitJunction, m_searchContext,
+                                     maxAlternatives, routingResult, alternativeResults);
+  starter.DisableShortcuts();
+  m_lastStats.m_settledVertices += visitCount;
   if (result != IRouter::NoError)
     return result;
 
+  starter.UnpackShortcuts(routingResult.path);
+
+  // ProcessLeaps() changes the mode of the graph.
+  WorldGraph::Mode const mode = starter.GetGraph().GetMode();
   IRouter::ResultCode const leapsResult =
-      ProcessLeaps(routingResult.path, delegate, starter.GetGraph().GetMode(), starter, subroute);
+      ProcessLeaps(routingResult.path, delegate, mode, starter, subroute);
   if (leapsResult != IRouter::NoError)
     return leapsResult;
 
   CHECK_GREATER_OR_EQUAL(subroute.size(), routingResult.path.size(), ());
+
+  for (auto & alternativeResult : alternativeResults)
+  {
+    starter.UnpackShortcuts(alternativeResult.path);
+    vector<Segment> alternative;
+    IRouter::ResultCode const alternativeLeapsResult =
+        ProcessLeaps(alternativeResult.path, delegate, mode, starter, alternative);
+    if (alternativeLeapsResult == IRouter::Cancelled)
+      return alternativeLeapsResult;
+
+    if (alternativeLeapsResult != IRouter::NoError)
+    {
+      LOG(LWARNING, ("Can't process leaps of an alternative route:", alternativeLeapsResult));
+      continue;
+    }
+    alternatives->push_back(move(alternative));
+  }
+
+  return IRouter::NoError;
+}
+
+IRouter::ResultCode IndexRouter::FindCachedSubroute(SubrouteCache::Key const & key,
+                                                    RouterDelegate const & delegate,
+                                                    IndexGraphStarter & starter,
+                                                    vector<Segment> & subroute)
+{
+  auto const entry = m_subrouteCache.Find(
+      key, [this](NumMwmId numMwmId) { return GetMwmState(numMwmId); });
+  if (!entry)
+    return IRouter::RouteNotFound;
+
+  // The cached segments are real ones, leaps are already replaced with them.
+  starter.GetGraph().SetMode(WorldGraph::Mode::NoLeaps);
+  CorridorGraph corridor(starter, entry->m_segments);
+  RoutingResult<Segment, RouteWeight> routingResult;
+  auto const result = FindPath(starter.GetStartSegment(), starter.GetFinishSegment(), delegate,
+                               corridor, nullptr /* onVisitedVertexCallback */, m_searchContext,
+                               routingResult);
+  if (result != IRouter::NoError)
+  {
+    LOG(LDEBUG, ("Can't find a route along the cached subroute:", result));
+    return result;
+  }
+
+  subroute = move(routingResult.path);
   return IRouter::NoError;
 }
 
+void IndexRouter::PutSubrouteToCache(SubrouteCache::Key const & key,
+                                     IndexGraphStarter const & starter,
+                                     vector<Segment> const & subroute)
+{
+  vector<Segment> realSegments;
+  realSegments.reserve(subroute.size());
+  for (auto segment : subroute)
+  {
+    if (starter.ConvertToReal(segment))
+      realSegments.push_back(segment);
+  }
+  m_subrouteCache.Put(key, realSegments,
+                       [this](NumMwmId numMwmId) { return GetMwmState(numMwmId); });
+}
+
+SubrouteCache::MwmState IndexRouter::GetMwmState(NumMwmId numMwmId) const
+{
+  SubrouteCache::MwmState state;
+  state.m_mwmId = m_index.GetMwmIdByCountryFile(m_numMwmIds->GetFile(numMwmId));
+  state.m_trafficVersion = m_trafficStash ? m_trafficStash->GetVersion(numMwmId) : 0;
+  return state;
+}
+
 IRouter::ResultCode IndexRouter::AdjustRoute(Checkpoints const & checkpoints,
                                              m2::PointD const & startDirection,
                                              RouterDelegate const & delegate, Route & route)
 {
   my::Timer timer;
+  m_lastStats = Stats();
   TrafficStash::Guard guard(m_trafficStash);
   WorldGraph graph = MakeWorldGraph();
   graph.SetMode(WorldGraph::Mode::NoLeaps);
@@ -652,6 +1081,8 @@ WorldGraph IndexRouter::MakeWorldGraph()
       IndexGraphLoader::Create(m_vehicleType, m_loadAltitudes, m_numMwmIds, m_vehicleModelFactory,
                                m_estimator, m_index),
       m_estimator);
+  if (m_vehicleType != VehicleType::Car)
+    graph.SetIndexGraphsMaxMemorySize(kMaxNoLeapsGraphsMemory);
   return graph;
 }
 
@@ -698,6 +1129,26 @@ bool IndexRouter::FindBestSegment(m2::PointD const & point, m2::PointD const & d
   return true;
 }
 
+bool IndexRouter::FindBestSegments(vector<m2::PointD> const & points, bool isOutgoing,
+                                   WorldGraph & worldGraph, vector<Segment> & segments) const
+{
+  segments.clear();
+  segments.reserve(points.size());
+  for (auto const & point : points)
+  {
+    Segment segment;
+    bool dummy = false;
+    if (!FindBestSegment(point, m2::PointD::Zero() /* direction */, isOutgoing, worldGraph,
+                         segment, dummy))
+    {
+      LOG(LWARNING, ("Can't find a segment for", MercatorBounds::ToLatLon(point)));
+      return false;
+    }
+    segments.push_back(segment);
+  }
+  return true;
+}
+
 IRouter::ResultCode IndexRouter::ProcessLeaps(vector<Segment> const & input,
                                               RouterDelegate const & delegate,
                                               WorldGraph::Mode prevMode,
@@ -736,18 +1187,31 @@ IRouter::ResultCode IndexRouter::ProcessLeaps(vector<Segment> const & input,
 
     IRouter::ResultCode result = IRouter::InternalError;
     RoutingResult<Segment, RouteWeight> routingResult;
+    auto const onVisitVertex = [this](Segment const & /* from */, Segment const & /* to */) {
+      ++m_lastStats.m_settledVertices;
+    };
     // In case of leaps from the start to its mwm transition and from finish mwm transition
     // route calculation should be made on the world graph (WorldGraph::Mode::NoLeaps).
     if (starter.GetMwms().count(current.GetMwmId()) && prevMode == WorldGraph::Mode::LeapsOnly)
     {
       // World graph route.
-      result = FindPath(current, next, delegate, worldGraph, {} /* onVisitedVertexCallback */, routingResult);
+      worldGraph.EnableShortcuts({current, next});
+      result = FindPath(current, next, delegate, worldGraph, onVisitVertex, m_searchContext,
+                        routingResult);
+      worldGraph.DisableShortcuts();
+      if (result == IRouter::NoError)
+        worldGraph.UnpackShortcuts(routingResult.path);
     }
     else
     {
       // Single mwm route.
       IndexGraph & indexGraph = worldGraph.GetIndexGraph(current.GetMwmId());
-      result = FindPath(current, next, delegate, indexGraph, {} /* onVisitedVertexCallback */, routingResult);
+      indexGraph.EnableShortcuts({current, next});
+      result = FindPath(current, next, delegate, indexGraph, onVisitVertex, m_searchContext,
+                        routingResult);
+      indexGraph.DisableShortcuts();
+      if (result == IRouter::NoError)
+        indexGraph.UnpackShortcuts(routingResult.path);
     }
     if (result != IRouter::NoError)
       return result;
@@ -765,9 +1229,10 @@ IRouter::ResultCode IndexRouter::ProcessLeaps(vector<Segment> const & input,
 
 IRouter::ResultCode IndexRouter::RedressRoute(vector<Segment> const & segments,
                                               RouterDelegate const & delegate,
-                                              IndexGraphStarter & starter, Route & route) const
+                                              IndexGraphStarter & starter, Route & route)
 {
   CHECK(!segments.empty(), ());
+  my::Timer timer;
   vector<Junction> junctions;
   size_t const numPoints = IndexGraphStarter::GetRouteNumPoints(segments);
   junctions.reserve(numPoints);
@@ -789,9 +1254,13 @@ IRouter::ResultCode IndexRouter::RedressRoute(vector<Segment> const & segments,
     times.emplace_back(static_cast<uint32_t>(i + 1), time);
   }
   
+  m_lastStats.m_redressSec += timer.ElapsedSeconds();
+
+  timer.Reset();
   CHECK(m_directionsEngine, ());
   ReconstructRoute(*m_directionsEngine, roadGraph, m_trafficStash, delegate, junctions, move(times),
                    route);
+  m_lastStats.m_reconstructionSec += timer.ElapsedSeconds();
 
   if (!route.IsValid())
   {
@@ -10,8 +10,11 @@
 #include "routing/router.hpp"
 #include "routing/routing_mapping.hpp"
 #include "routing/segmented_route.hpp"
+#include "routing/subroute_cache.hpp"
 #include "routing/world_graph.hpp"
 
+#include "routing/base/astar_algorithm.hpp"
+
 #include "routing_common/vehicle_model.hpp"
 
 #include "indexer/index.hpp"
@@ -21,7 +24,9 @@
 
 #include "std/unique_ptr.hpp"
 
+#include <cstdint>
 #include <functional>
+#include <memory>
 #include <set>
 #include <string>
 #include <vector>
@@ -34,6 +39,26 @@ class IndexGraphStarter;
 class IndexRouter : public IRouter
 {
 public:
+  // Phases of the last CalculateRoute() call. Index graphs are loaded lazily, mostly while
+  // searching, so |m_graphLoadingSec| is a part of |m_snappingSec| and |m_searchSec|.
+  struct Stats
+  {
+    // Search of the best segments of the checkpoints.
+    double m_snappingSec = 0.0;
+    double m_graphLoadingSec = 0.0;
+    // Maximal memory of the loaded index graphs and their geometry in bytes.
+    size_t m_peakGraphsMemory = 0;
+    // A* searches including the searches of ProcessLeaps().
+    double m_searchSec = 0.0;
+    uint64_t m_settledVertices = 0;
+    // Subroutes which were found along the cached ones, see SubrouteCache.
+    uint32_t m_cachedSubroutes = 0;
+    // Calculation of route junctions and times.
+    double m_redressSec = 0.0;
+    // ReconstructRoute(): turn generation, street names and route geometry.
+    double m_reconstructionSec = 0.0;
+  };
+
   class BestEdgeComparator final
   {
   public:
@@ -65,18 +90,67 @@ public:
 
   // IRouter overrides:
   std::string GetName() const override { return m_name; }
+  void ShrinkCaches() override { ClearSubrouteCache(); }
   ResultCode CalculateRoute(Checkpoints const & checkpoints, m2::PointD const & startDirection,
                             bool adjustToPrevRoute, RouterDelegate const & delegate,
                             Route & route) override;
 
+  /// \brief Calculates travel times in seconds from each of |sources| to each of |targets|.
+  /// Neither route geometry nor turns are built so it's much cheaper than calling
+  /// CalculateRoute() for every pair of points. |matrix| is filled row by row:
+  /// matrix[i * targets.size() + j] is the travel time from sources[i] to targets[j]
+  /// or kNoRouteTime if there's no route between them.
+  /// \param threadsNum is the number of threads rows of the matrix are calculated by.
+  ResultCode CalculateRouteMatrix(std::vector<m2::PointD> const & sources,
+                                  std::vector<m2::PointD> const & targets,
+                                  RouterDelegate const & delegate, size_t threadsNum,
+                                  std::vector<double> & matrix);
+
+  /// \brief Calculates the route as CalculateRoute() does and up to |maxAlternatives|
+  /// alternative routes which are taken from the search spaces of the route, so they are
+  /// much cheaper than additional searches. Alternatives are calculated for routes without
+  /// intermediate points only. Otherwise |alternatives| is left empty.
+  ResultCode CalculateRouteWithAlternatives(Checkpoints const & checkpoints,
+                                            m2::PointD const & startDirection,
+                                            size_t maxAlternatives, RouterDelegate const & delegate,
+                                            Route & route,
+                                            std::vector<std::unique_ptr<Route>> & alternatives);
+
+  static double constexpr kNoRouteTime = -1.0;
+
+  Stats const & GetLastStats() const { return m_lastStats; }
+
+  // ClearState() keeps the cached subroutes, they are valid for all the following requests.
+  void ClearSubrouteCache() { m_subrouteCache.Clear(); }
 private:
+  // |alternatives| may be nullptr if |maxAlternatives| is zero.
   IRouter::ResultCode DoCalculateRoute(Checkpoints const & checkpoints,
                                        m2::PointD const & startDirection,
-                                       RouterDelegate const & delegate, Route & route);
+                                       RouterDelegate const & delegate, size_t maxAlternatives,
+                                       Route & route,
+                                       std::vector<std::unique_ptr<Route>> * alternatives);
+  // |alternatives| may be nullptr if |maxAlternatives| is zero.
   IRouter::ResultCode CalculateSubroute(Checkpoints const & checkpoints, size_t subrouteIdx,
                                         Segment const & startSegment,
                                         RouterDelegate const & delegate, IndexGraphStarter & graph,
-                                        std::vector<Segment> & subroute, Junction & startJunction);
+                                        size_t maxAlternatives, std::vector<Segment> & subroute,
+                                        std::vector<std::vector<Segment>> * alternatives,
+                                        Junction & startJunction);
+
+  // Looks for the subroute of |starter| along the cached subroute for |key|.
+  // Returns RouteNotFound if there's no valid cached subroute.
+  IRouter::ResultCode FindCachedSubroute(SubrouteCache::Key const & key,
+                                         RouterDelegate const & delegate,
+                                         IndexGraphStarter & starter,
+                                         std::vector<Segment> & subroute);
+  void PutSubrouteToCache(SubrouteCache::Key const & key, IndexGraphStarter const & starter,
+                          std::vector<Segment> const & subroute);
+  SubrouteCache::MwmState GetMwmState(NumMwmId numMwmId) const;
+
+  IRouter::ResultCode DoCalculateRouteMatrix(std::vector<m2::PointD> const & sources,
+                                             std::vector<m2::PointD> const & targets,
+                                             RouterDelegate const & delegate, size_t threadsNum,
+                                             std::vector<double> & matrix);
 
   IRouter::ResultCode AdjustRoute(Checkpoints const & checkpoints,
                                   m2::PointD const & startDirection,
@@ -102,7 +176,12 @@ private:
                                    IndexGraphStarter & starter, std::vector<Segment> & output);
   IRouter::ResultCode RedressRoute(std::vector<Segment> const & segments,
                                    RouterDelegate const & delegate, IndexGraphStarter & starter,
-                                   Route & route) const;
+                                   Route & route);
+
+  /// \brief Fills |segments| with the best segments of |points|.
+  /// \returns false if there's a point without a segment nearby.
+  bool FindBestSegments(std::vector<m2::PointD> const & points, bool isOutgoing,
+                        WorldGraph & worldGraph, std::vector<Segment> & segments) const;
 
   bool AreMwmsNear(std::set<NumMwmId> const & mwmIds) const;
 
@@ -124,5 +203,9 @@ private:
   std::unique_ptr<IDirectionsEngine> m_directionsEngine;
   std::unique_ptr<SegmentedRoute> m_lastRoute;
   std::unique_ptr<FakeEdgesContainer> m_lastFakeEdges;
+  // Search states are reused by all the searches of the router to avoid reallocations.
+  AStarBidirectionalContext<Segment, RouteWeight> m_searchContext;
+  SubrouteCache m_subrouteCache;
+  Stats m_lastStats;
 };
 }  // namespace routing
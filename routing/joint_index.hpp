@@ -36,6 +36,11 @@ public:
 
   void Build(RoadIndex const & roadIndex, uint32_t numJoints);
 
+  size_t GetMemorySize() const
+  {
+    return m_offsets.capacity() * sizeof(uint32_t) + m_points.capacity() * sizeof(RoadPoint);
+  }
+
 private:
   // Begin index for jointId entries.
   uint32_t Begin(Joint::Id jointId) const
@@ -0,0 +1,256 @@
+#include "routing/landmark_index.hpp"
+
+#include "routing/index_graph.hpp"
+
+#include "geometry/mercator.hpp"
+
+#include "base/assert.hpp"
+#include "base/checked_cast.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <queue>
+#include <utility>
+
+using namespace std;
+
+namespace
+{
+using namespace routing;
+
+// Directed graph which vertices are joints and edges are the parts of features between
+// consecutive joints of the features.
+class JointGraph final
+{
+public:
+  struct Edge final
+  {
+    Edge(Joint::Id target, double length) : m_target(target), m_length(length) {}
+
+    Joint::Id m_target;
+    // Meters.
+    double m_length;
+  };
+
+  explicit JointGraph(IndexGraph & graph)
+    : m_outgoing(graph.GetNumJoints()), m_ingoing(graph.GetNumJoints())
+  {
+    graph.ForEachRoad([&](uint32_t featureId, RoadJointIds const & joints) {
+      RoadGeometry const & road = graph.GetGeometry().GetRoad(featureId);
+      if (!road.IsValid())
+        return;
+
+      Joint::Id prevJointId = Joint::kInvalidId;
+      uint32_t prevPointId = 0;
+      joints.ForEachJoint([&](uint32_t pointId, Joint::Id jointId) {
+        if (prevJointId != Joint::kInvalidId)
+        {
+          double length = 0.0;
+          for (uint32_t i = prevPointId; i < pointId; ++i)
+            length += MercatorBounds::DistanceOnEarth(road.GetPoint(i), road.GetPoint(i + 1));
+
+          AddEdge(prevJointId, jointId, length);
+          if (!road.IsOneWay())
+            AddEdge(jointId, prevJointId, length);
+        }
+        prevJointId = jointId;
+        prevPointId = pointId;
+      });
+    });
+  }
+
+  Joint::Id GetNumJoints() const { return base::asserted_cast<Joint::Id>(m_outgoing.size()); }
+
+  vector<Edge> const & GetEdges(Joint::Id jointId, bool forward) const
+  {
+    return forward ? m_outgoing[jointId] : m_ingoing[jointId];
+  }
+
+private:
+  void AddEdge(Joint::Id from, Joint::Id to, double length)
+  {
+    m_outgoing[from].emplace_back(to, length);
+    m_ingoing[to].emplace_back(from, length);
+  }
+
+  vector<vector<Edge>> m_outgoing;
+  vector<vector<Edge>> m_ingoing;
+};
+
+// Fills |distances| with the shortest distances from |source| to all the joints if |forward| is
+// true and from all the joints to |source| otherwise. Unreachable joints get |infinity|.
+template <typename Weight, typename CalcWeight>
+void CalcDistances(JointGraph const & graph, Joint::Id source, bool forward, Weight infinity,
+                   CalcWeight && calcWeight, vector<Weight> & distances)
+{
+  using State = pair<Weight, Joint::Id>;
+
+  distances.assign(graph.GetNumJoints(), infinity);
+  priority_queue<State, vector<State>, greater<State>> queue;
+  distances[source] = 0;
+  queue.emplace(0, source);
+
+  while (!queue.empty())
+  {
+    State const state = queue.top();
+    queue.pop();
+    if (state.first > distances[state.second])
+      continue;
+
+    for (auto const & edge : graph.GetEdges(state.second, forward))
+    {
+      Weight const distance = state.first + calcWeight(edge);
+      if (distance < distances[edge.m_target])
+      {
+        distances[edge.m_target] = distance;
+        queue.emplace(distance, edge.m_target);
+      }
+    }
+  }
+}
+
+void CalcMeterDistances(JointGraph const & graph, Joint::Id source, bool forward,
+                        vector<double> & distances)
+{
+  CalcDistances(graph, source, forward, numeric_limits<double>::infinity(),
+                [](JointGraph::Edge const & edge) { return edge.m_length; }, distances);
+}
+
+// Distances are calculated in units of |precision| meters. Lengths of the edges are rounded down,
+// so a unit distance multiplied by |precision| never exceeds the real one.
+void CalcUnitDistances(JointGraph const & graph, Joint::Id source, bool forward,
+                       uint32_t precision, vector<uint32_t> & distances)
+{
+  CalcDistances(graph, source, forward, numeric_limits<uint32_t>::max(),
+                [precision](JointGraph::Edge const & edge) {
+                  return static_cast<uint32_t>(floor(edge.m_length / precision));
+                },
+                distances);
+}
+
+void SetLandmarkDistances(JointGraph const & graph, size_t landmarkIdx, Joint::Id landmark,
+                          LandmarkIndex & index)
+{
+  double maxDistance = 0.0;
+  vector<double> meters;
+  for (bool const forward : {true, false})
+  {
+    CalcMeterDistances(graph, landmark, forward, meters);
+    for (double const distance : meters)
+    {
+      if (distance != numeric_limits<double>::infinity())
+        maxDistance = max(maxDistance, distance);
+    }
+  }
+
+  uint32_t precision = 1;
+  while (maxDistance / precision >= LandmarkIndex::kUnreachable)
+    precision *= 2;
+  index.SetPrecision(landmarkIdx, precision);
+
+  vector<uint32_t> forwardUnits;
+  vector<uint32_t> backwardUnits;
+  CalcUnitDistances(graph, landmark, true /* forward */, precision, forwardUnits);
+  CalcUnitDistances(graph, landmark, false /* forward */, precision, backwardUnits);
+
+  auto const toStored = [](uint32_t units) {
+    if (units == numeric_limits<uint32_t>::max())
+      return LandmarkIndex::kUnreachable;
+    CHECK_LESS(units, LandmarkIndex::kUnreachable, ());
+    return static_cast<uint16_t>(units);
+  };
+
+  for (Joint::Id jointId = 0; jointId < graph.GetNumJoints(); ++jointId)
+  {
+    index.SetDistances(landmarkIdx, jointId, toStored(forwardUnits[jointId]),
+                       toStored(backwardUnits[jointId]));
+  }
+}
+}  // namespace
+
+namespace routing
+{
+// static
+size_t constexpr LandmarkIndex::kMaxLandmarks;
+// static
+uint16_t constexpr LandmarkIndex::kUnreachable;
+
+void LandmarkIndex::Init(Joint::Id numJoints, vector<Joint::Id> const & landmarks)
+{
+  CHECK_LESS_OR_EQUAL(landmarks.size(), kMaxLandmarks, ());
+  m_numJoints = numJoints;
+  m_landmarks = landmarks;
+  m_precisions.assign(landmarks.size(), 1);
+  m_distances.assign(static_cast<size_t>(numJoints) * landmarks.size() * 2, kUnreachable);
+}
+
+void LandmarkIndex::SetPrecision(size_t landmarkIdx, uint32_t precision)
+{
+  CHECK_LESS(landmarkIdx, m_precisions.size(), ());
+  CHECK_GREATER(precision, 0, ());
+  m_precisions[landmarkIdx] = precision;
+}
+
+void LandmarkIndex::SetDistances(size_t landmarkIdx, Joint::Id jointId, uint16_t forward,
+                                 uint16_t backward)
+{
+  CHECK_LESS(landmarkIdx, m_landmarks.size(), ());
+  CHECK_LESS(jointId, m_numJoints, ());
+  m_distances[GetIndex(landmarkIdx, jointId, true /* forward */)] = forward;
+  m_distances[GetIndex(landmarkIdx, jointId, false /* forward */)] = backward;
+}
+
+void BuildLandmarkIndex(IndexGraph & graph, size_t numLandmarks, LandmarkIndex & index)
+{
+  CHECK_LESS_OR_EQUAL(numLandmarks, LandmarkIndex::kMaxLandmarks, ());
+
+  JointGraph const jointGraph(graph);
+  Joint::Id const numJoints = jointGraph.GetNumJoints();
+  if (numJoints == 0 || numLandmarks == 0)
+  {
+    index = LandmarkIndex();
+    return;
+  }
+
+  // Farthest landmarks selection: every next landmark is the joint which is the farthest one
+  // from the already chosen landmarks. The first one is the farthest from an arbitrary joint.
+  vector<double> scores;
+  CalcMeterDistances(jointGraph, 0 /* source */, true /* forward */, scores);
+
+  vector<Joint::Id> landmarks;
+  vector<double> distances;
+  while (landmarks.size() < numLandmarks)
+  {
+    Joint::Id best = Joint::kInvalidId;
+    double bestScore = 0.0;
+    for (Joint::Id jointId = 0; jointId < numJoints; ++jointId)
+    {
+      double const score = scores[jointId];
+      if (score != numeric_limits<double>::infinity() && score > bestScore)
+      {
+        best = jointId;
+        bestScore = score;
+      }
+    }
+
+    if (best == Joint::kInvalidId)
+      break;
+
+    CalcMeterDistances(jointGraph, best, true /* forward */, distances);
+    for (Joint::Id jointId = 0; jointId < numJoints; ++jointId)
+    {
+      if (landmarks.empty())
+        scores[jointId] = distances[jointId];
+      else if (distances[jointId] < scores[jointId])
+        scores[jointId] = distances[jointId];
+    }
+    scores[best] = 0.0;
+    landmarks.push_back(best);
+  }
+
+  index.Init(numJoints, landmarks);
+  for (size_t i = 0; i < landmarks.size(); ++i)
+    SetLandmarkDistances(jointGraph, i, landmarks[i], index);
+}
+}  // namespace routing
@@ -0,0 +1,78 @@
+#pragma once
+
+#include "routing/joint.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace routing
+{
+class IndexGraph;
+
+// LandmarkIndex keeps road distances between a few landmark joints and every joint of an mwm
+// graph. They are used by the ALT (A*, landmarks, triangle inequality) heuristic:
+// for any landmark L the distance from v to t is not less than d(L, t) - d(L, v) and
+// d(v, L) - d(t, L). Please see IndexGraph::HeuristicCostEstimate() for details.
+//
+// Distances are measured in meters along the roads, so they don't depend on speeds and
+// traffic and are a lower bound for any real route after division by the max speed.
+// Distances of a landmark are stored in units of its precision. Every unit distance is the
+// shortest path in the graph those edges have rounded down unit lengths, therefore the stored
+// distances are consistent: d(L, j2) <= d(L, j1) + length(j1, j2) for any road from j1 to j2.
+class LandmarkIndex final
+{
+  friend class LandmarkSerializer;
+
+public:
+  static size_t constexpr kMaxLandmarks = 16;
+  static uint16_t constexpr kUnreachable = std::numeric_limits<uint16_t>::max();
+
+  void Init(Joint::Id numJoints, std::vector<Joint::Id> const & landmarks);
+  void SetPrecision(size_t landmarkIdx, uint32_t precision);
+  // |forward| is the distance from the landmark to |jointId| and |backward| is the distance from
+  // |jointId| to the landmark in units of the landmark precision.
+  void SetDistances(size_t landmarkIdx, Joint::Id jointId, uint16_t forward, uint16_t backward);
+
+  bool IsEmpty() const { return m_landmarks.empty(); }
+  size_t GetNumLandmarks() const { return m_landmarks.size(); }
+  Joint::Id GetNumJoints() const { return m_numJoints; }
+  Joint::Id GetLandmark(size_t landmarkIdx) const { return m_landmarks[landmarkIdx]; }
+  size_t GetMemorySize() const { return m_distances.capacity() * sizeof(uint16_t); }
+
+  // Returns the distance in meters from the landmark to |jointId| if |forward| is true and from
+  // |jointId| to the landmark otherwise. Returns infinity if there's no such way.
+  double GetDistance(size_t landmarkIdx, Joint::Id jointId, bool forward) const
+  {
+    uint16_t const distance = m_distances[GetIndex(landmarkIdx, jointId, forward)];
+    if (distance == kUnreachable)
+      return std::numeric_limits<double>::infinity();
+    return static_cast<double>(distance) * m_precisions[landmarkIdx];
+  }
+
+  bool operator==(LandmarkIndex const & rhs) const
+  {
+    return m_numJoints == rhs.m_numJoints && m_landmarks == rhs.m_landmarks &&
+           m_precisions == rhs.m_precisions && m_distances == rhs.m_distances;
+  }
+
+private:
+  // Distances of one joint are placed together because the heuristic reads all of them at once.
+  size_t GetIndex(size_t landmarkIdx, Joint::Id jointId, bool forward) const
+  {
+    return (static_cast<size_t>(jointId) * m_landmarks.size() + landmarkIdx) * 2 +
+           (forward ? 0 : 1);
+  }
+
+  Joint::Id m_numJoints = 0;
+  std::vector<Joint::Id> m_landmarks;
+  // Meters in a unit of distance for every landmark.
+  std::vector<uint32_t> m_precisions;
+  std::vector<uint16_t> m_distances;
+};
+
+// Chooses |numLandmarks| joints of |graph| far from each other and fills |index| with the
+// distances between the landmarks and all the joints.
+void BuildLandmarkIndex(IndexGraph & graph, size_t numLandmarks, LandmarkIndex & index);
+}  // namespace routing
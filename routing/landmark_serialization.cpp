@@ -0,0 +1,7 @@
+#include "routing/landmark_serialization.hpp"
+
+namespace routing
+{
+// static
+uint32_t const LandmarkSerializer::kLatestVersion = 0;
+}  // namespace routing
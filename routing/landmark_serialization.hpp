@@ -0,0 +1,75 @@
+#pragma once
+
+#include "routing/landmark_index.hpp"
+
+#include "coding/endianness.hpp"
+#include "coding/reader.hpp"
+#include "coding/write_to_sink.hpp"
+
+#include "base/assert.hpp"
+#include "base/checked_cast.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace routing
+{
+// Section format:
+// header: uint32_t version, uint32_t number of joints, uint32_t number of landmarks
+// for every landmark: uint32_t joint id and uint32_t precision in meters
+// distances: uint16_t values, for every joint for every landmark the distance from the landmark
+// to the joint and the distance from the joint to the landmark.
+class LandmarkSerializer final
+{
+public:
+  LandmarkSerializer() = delete;
+
+  template <class Sink>
+  static void Serialize(LandmarkIndex const & index, Sink & sink)
+  {
+    WriteToSink(sink, kLatestVersion);
+    WriteToSink(sink, index.m_numJoints);
+    WriteToSink(sink, base::checked_cast<uint32_t>(index.m_landmarks.size()));
+    for (size_t i = 0; i < index.m_landmarks.size(); ++i)
+    {
+      WriteToSink(sink, index.m_landmarks[i]);
+      WriteToSink(sink, index.m_precisions[i]);
+    }
+
+    for (uint16_t const distance : index.m_distances)
+      WriteToSink(sink, distance);
+  }
+
+  template <class Source>
+  static void Deserialize(Source & src, LandmarkIndex & index)
+  {
+    uint32_t const version = ReadPrimitiveFromSource<uint32_t>(src);
+    CHECK_EQUAL(version, kLatestVersion, ());
+
+    auto const numJoints = ReadPrimitiveFromSource<Joint::Id>(src);
+    auto const numLandmarks = ReadPrimitiveFromSource<uint32_t>(src);
+    CHECK_LESS_OR_EQUAL(numLandmarks, LandmarkIndex::kMaxLandmarks, ());
+
+    std::vector<Joint::Id> landmarks(numLandmarks);
+    std::vector<uint32_t> precisions(numLandmarks);
+    for (uint32_t i = 0; i < numLandmarks; ++i)
+    {
+      landmarks[i] = ReadPrimitiveFromSource<Joint::Id>(src);
+      precisions[i] = ReadPrimitiveFromSource<uint32_t>(src);
+    }
+
+    index.Init(numJoints, landmarks);
+    for (uint32_t i = 0; i < numLandmarks; ++i)
+      index.SetPrecision(i, precisions[i]);
+
+    // The table is large so it's read in one go.
+    auto & distances = index.m_distances;
+    src.Read(distances.data(), distances.size() * sizeof(uint16_t));
+    for (uint16_t & distance : distances)
+      distance = SwapIfBigEndian(distance);
+  }
+
+private:
+  static uint32_t const kLatestVersion;
+};
+}  // namespace routing
@@ -1,6 +1,7 @@
 #include "routing/online_cross_fetcher.hpp"
 
 #include "platform/http_request.hpp"
+#include "platform/network_scheduler.hpp"
 
 #include "base/logging.hpp"
 #include "base/string_utils.hpp"
@@ -75,6 +76,8 @@ void OnlineCrossFetcher::Do()
 
     string const url = GenerateOnlineRequest(m_serverURL, MercatorBounds::ToLatLon(pointFrom),
                                              MercatorBounds::ToLatLon(pointTo));
+    // A route is being built, so map downloads are slowed down until the response.
+    platform::NetworkScheduler::ForegroundRequest const foreground;
     platform::HttpClient request(url);
     LOG(LINFO, ("Check mwms by URL: ", url));
 
@@ -0,0 +1,32 @@
+#include "routing/restriction_index.hpp"
+
+#include <algorithm>
+#include <utility>
+
+using namespace std;
+
+namespace routing
+{
+void RestrictionIndex::Build(RestrictionVec const & restrictions)
+{
+  m_hasRestrictions.clear();
+  vector<pair<uint64_t, Restriction::Type>> transitions;
+  for (Restriction const & restriction : restrictions)
+  {
+    if (restriction.m_type != Restriction::Type::No || restriction.m_featureIds.size() != 2)
+      continue;
+
+    uint32_t const featureIdFrom = restriction.m_featureIds[0];
+    if (featureIdFrom >= m_hasRestrictions.size())
+      m_hasRestrictions.resize(featureIdFrom + 1, false);
+    m_hasRestrictions[featureIdFrom] = true;
+    transitions.emplace_back(GetKey(featureIdFrom, restriction.m_featureIds[1]),
+                             restriction.m_type);
+  }
+
+  // Conversion of restrictions of Type::Only may produce duplicates.
+  sort(transitions.begin(), transitions.end());
+  transitions.erase(unique(transitions.begin(), transitions.end()), transitions.end());
+  m_transitions.Build(transitions);
+}
+}  // namespace routing
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "routing/restrictions_serialization.hpp"
+
+#include "routing/base/eytzinger_map.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace routing
+{
+// Static lookup of the prohibited transitions between features. It's built once from the sorted
+// restrictions of an mwm and is queried on every edge expansion. Features which aren't the first
+// feature of a restriction are rejected by one bit check.
+class RestrictionIndex final
+{
+public:
+  // Restrictions of Type::No with two features are taken into account only, restrictions of
+  // Type::Only should be converted (see ConvertRestrictionsOnlyToNoAndSort()).
+  void Build(RestrictionVec const & restrictions);
+
+  bool IsEmpty() const { return m_transitions.IsEmpty(); }
+
+  // Returns true if there's a restriction of Type::No from |featureIdFrom| to |featureIdTo|.
+  bool IsProhibited(uint32_t featureIdFrom, uint32_t featureIdTo) const
+  {
+    if (featureIdFrom >= m_hasRestrictions.size() || !m_hasRestrictions[featureIdFrom])
+      return false;
+    return m_transitions.Find(GetKey(featureIdFrom, featureIdTo)) != nullptr;
+  }
+
+private:
+  static uint64_t GetKey(uint32_t featureIdFrom, uint32_t featureIdTo)
+  {
+    return (static_cast<uint64_t>(featureIdFrom) << 32) | featureIdTo;
+  }
+
+  // The bit of a feature is set if there are restrictions from the feature.
+  std::vector<bool> m_hasRestrictions;
+  EytzingerMap<uint64_t, Restriction::Type> m_transitions;
+};
+}  // namespace routing
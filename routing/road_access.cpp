@@ -3,13 +3,22 @@
 #include "base/assert.hpp"
 
 #include <algorithm>
+#include <limits>
 #include <sstream>
+#include <utility>
 
 using namespace std;
 
 namespace
 {
 string const kNames[] = {"No", "Private", "Destination", "Yes", "Count"};
+
+uint64_t GetKey(uint32_t featureId, uint32_t segmentIdx, bool isForward)
+{
+  ASSERT_LESS(segmentIdx, numeric_limits<uint32_t>::max() >> 1, ());
+  return (static_cast<uint64_t>(featureId) << 32) | (static_cast<uint64_t>(segmentIdx) << 1) |
+         (isForward ? 1 : 0);
+}
 }  // namespace
 
 namespace routing
@@ -17,23 +26,20 @@ namespace routing
 // RoadAccess --------------------------------------------------------------------------------------
 RoadAccess::Type RoadAccess::GetSegmentType(Segment const & segment) const
 {
-  // todo(@m) This may or may not be too slow. Consider profiling this and using
-  // a Bloom filter or anything else that is faster than std::map.
+  uint32_t const featureId = segment.GetFeatureId();
+  if (featureId >= m_featureHasTypes.size() || !m_featureHasTypes[featureId])
+    return RoadAccess::Type::Yes;
 
+  if (auto const * type =
+          m_index.Find(GetKey(featureId, 0 /* wildcard segment idx */, true /* wildcard isForward */)))
   {
-    Segment key(kFakeNumMwmId, segment.GetFeatureId(), 0 /* wildcard segment idx */,
-                true /* wildcard isForward */);
-    auto const it = m_segmentTypes.find(key);
-    if (it != m_segmentTypes.end())
-      return it->second;
+    return *type;
   }
 
+  if (auto const * type =
+          m_index.Find(GetKey(featureId, segment.GetSegmentIdx() + 1, segment.IsForward())))
   {
-    Segment key(kFakeNumMwmId, segment.GetFeatureId(), segment.GetSegmentIdx() + 1,
-                segment.IsForward());
-    auto const it = m_segmentTypes.find(key);
-    if (it != m_segmentTypes.end())
-      return it->second;
+    return *type;
   }
 
   return RoadAccess::Type::Yes;
@@ -44,6 +50,30 @@ bool RoadAccess::operator==(RoadAccess const & rhs) const
   return m_segmentTypes == rhs.m_segmentTypes;
 }
 
+void RoadAccess::BuildIndex()
+{
+  m_featureHasTypes.clear();
+  vector<pair<uint64_t, Type>> pairs;
+  pairs.reserve(m_segmentTypes.size());
+  for (auto const & kv : m_segmentTypes)
+  {
+    Segment const & segment = kv.first;
+    // GetSegmentType() looks for the keys of kFakeNumMwmId only.
+    if (segment.GetMwmId() != kFakeNumMwmId)
+      continue;
+
+    uint32_t const featureId = segment.GetFeatureId();
+    if (featureId >= m_featureHasTypes.size())
+      m_featureHasTypes.resize(featureId + 1, false);
+    m_featureHasTypes[featureId] = true;
+    pairs.emplace_back(GetKey(featureId, segment.GetSegmentIdx(), segment.IsForward()), kv.second);
+  }
+
+  // Segments of the same mwm are ordered by (feature, segment idx, forward), so the keys are
+  // sorted too.
+  m_index.Build(pairs);
+}
+
 // Functions ---------------------------------------------------------------------------------------
 string ToString(RoadAccess::Type type)
 {
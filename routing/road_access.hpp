@@ -3,6 +3,8 @@
 #include "routing/segment.hpp"
 #include "routing/vehicle_mask.hpp"
 
+#include "routing/base/eytzinger_map.hpp"
+
 #include "base/assert.hpp"
 
 #include <cstdint>
@@ -42,12 +44,14 @@ public:
 
   std::map<Segment, RoadAccess::Type> const & GetSegmentTypes() const { return m_segmentTypes; }
 
+  // Features without access types are rejected by one bit check, so most of the calls are cheap.
   Type GetSegmentType(Segment const & segment) const;
 
   template <typename V>
   void SetSegmentTypes(V && v)
   {
     m_segmentTypes = std::forward<V>(v);
+    BuildIndex();
   }
 
   void Clear();
@@ -57,6 +61,9 @@ public:
   bool operator==(RoadAccess const & rhs) const;
 
 private:
+  // Builds the lookup structures of GetSegmentType() from |m_segmentTypes|.
+  void BuildIndex();
+
   // todo(@m) Segment's NumMwmId is not used here. Decouple it from
   // segment and use only (fid, idx, forward) in the map.
   //
@@ -64,6 +71,11 @@ private:
   // entire feature has the corresponding access type.
   // Otherwise, the information is about the segment with number (segmentIdx-1).
   std::map<Segment, RoadAccess::Type> m_segmentTypes;
+
+  // The bit of a feature is set if there are keys of the feature in |m_segmentTypes|.
+  std::vector<bool> m_featureHasTypes;
+  // |m_segmentTypes| keyed by (feature id, segment idx, is forward) packed into uint64_t.
+  EytzingerMap<uint64_t, Type> m_index;
 };
 
 std::string ToString(RoadAccess::Type type);
@@ -7,6 +7,7 @@
 #include "indexer/feature_altitude.hpp"
 #include "indexer/feature_data.hpp"
 
+#include "std/functional.hpp"
 #include "std/initializer_list.hpp"
 #include "std/map.hpp"
 #include "std/vector.hpp"
@@ -339,3 +340,17 @@ inline void JunctionsToAltitudes(vector<Junction> const & junctions, feature::TA
     altitudes[i] = junctions[i].GetAltitude();
 }
 }  // namespace routing
+
+namespace std
+{
+template <>
+struct hash<routing::Junction>
+{
+  // Junctions are compared by points only.
+  size_t operator()(routing::Junction const & junction) const
+  {
+    m2::PointD const & point = junction.GetPoint();
+    return hash<double>()(point.x) ^ (hash<double>()(point.y) << 1);
+  }
+};
+}  // namespace std
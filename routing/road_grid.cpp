@@ -0,0 +1,136 @@
+#include "routing/road_grid.hpp"
+
+#include <cmath>
+#include <limits>
+#include <utility>
+
+using namespace std;
+
+namespace routing
+{
+// RoadGrid ----------------------------------------------------------------------------------------
+// static
+double constexpr RoadGrid::kCellSize;
+uint64_t constexpr RoadGrid::kHeaderSize;
+uint32_t const RoadGrid::kLatestVersion = 0;
+
+RoadGrid::RoadGrid(unique_ptr<Reader> reader) : m_reader(move(reader))
+{
+  CHECK(m_reader, ());
+
+  NonOwningReaderSource src(*m_reader);
+  uint32_t const version = ReadPrimitiveFromSource<uint32_t>(src);
+  CHECK_EQUAL(version, kLatestVersion, ());
+
+  m_minX = ReadPrimitiveFromSource<int32_t>(src);
+  m_minY = ReadPrimitiveFromSource<int32_t>(src);
+  m_numCols = ReadPrimitiveFromSource<uint32_t>(src);
+  m_numCells = ReadPrimitiveFromSource<uint32_t>(src);
+  if (m_numCells == 0)
+    return;
+
+  CHECK_GREATER(m_numCols, 0, ());
+  m_maxX = m_minX + static_cast<int32_t>(m_numCols) - 1;
+  m_maxY = m_minY + static_cast<int32_t>(ReadKey(m_numCells - 1) / m_numCols);
+}
+
+// static
+int32_t RoadGrid::GetCellCoord(double coord)
+{
+  return static_cast<int32_t>(floor(coord / kCellSize));
+}
+
+uint32_t RoadGrid::LowerBound(uint32_t key) const
+{
+  uint32_t begin = 0;
+  uint32_t end = m_numCells;
+  while (begin < end)
+  {
+    uint32_t const middle = begin + (end - begin) / 2;
+    if (ReadKey(middle) < key)
+      begin = middle + 1;
+    else
+      end = middle;
+  }
+  return begin;
+}
+
+uint32_t RoadGrid::ReadKey(uint32_t cellIdx) const
+{
+  return ReadPrimitiveFromPos<uint32_t>(*m_reader, GetKeysPos() + cellIdx * sizeof(uint32_t));
+}
+
+void RoadGrid::ReadFeatureIds(uint32_t cellIdx, vector<uint32_t> & featureIds) const
+{
+  uint64_t const offsetPos = GetOffsetsPos() + cellIdx * sizeof(uint32_t);
+  uint32_t const begin = ReadPrimitiveFromPos<uint32_t>(*m_reader, offsetPos);
+  uint32_t const end = ReadPrimitiveFromPos<uint32_t>(*m_reader, offsetPos + sizeof(uint32_t));
+  CHECK_LESS_OR_EQUAL(begin, end, (cellIdx));
+
+  vector<uint8_t> buffer(end - begin);
+  m_reader->Read(GetFeatureIdsPos() + begin, buffer.data(), buffer.size());
+
+  MemReader memReader(buffer.data(), buffer.size());
+  ReaderSource<MemReader> src(memReader);
+  uint32_t featureId = 0;
+  while (src.Size() > 0)
+  {
+    featureId += ReadVarUint<uint32_t>(src);
+    featureIds.push_back(featureId);
+  }
+}
+
+// RoadGridBuilder ---------------------------------------------------------------------------------
+void RoadGridBuilder::AddSegment(uint32_t featureId, m2::PointD const & p0, m2::PointD const & p1)
+{
+  m2::PointD a = p0;
+  m2::PointD b = p1;
+  if (a.x > b.x)
+    swap(a, b);
+
+  // Cells are added column by column: the cells of a column are the ones which cross the part
+  // of the segment between the column borders.
+  int32_t const minX = RoadGrid::GetCellCoord(a.x);
+  int32_t const maxX = RoadGrid::GetCellCoord(b.x);
+  for (int32_t x = minX; x <= maxX; ++x)
+  {
+    double y0 = a.y;
+    double y1 = b.y;
+    if (b.x > a.x)
+    {
+      double const left = max(a.x, x * RoadGrid::kCellSize);
+      double const right = min(b.x, (x + 1) * RoadGrid::kCellSize);
+      double const slope = (b.y - a.y) / (b.x - a.x);
+      y0 = a.y + (left - a.x) * slope;
+      y1 = a.y + (right - a.x) * slope;
+    }
+
+    int32_t const minY = RoadGrid::GetCellCoord(min(y0, y1));
+    int32_t const maxY = RoadGrid::GetCellCoord(max(y0, y1));
+    for (int32_t y = minY; y <= maxY; ++y)
+      m_cells.emplace_back(y, x, featureId);
+  }
+}
+
+void RoadGridBuilder::CalcBounds(int32_t & minX, int32_t & minY, uint32_t & numCols) const
+{
+  if (m_cells.empty())
+  {
+    minX = 0;
+    minY = 0;
+    numCols = 0;
+    return;
+  }
+
+  minX = numeric_limits<int32_t>::max();
+  int32_t maxX = numeric_limits<int32_t>::min();
+  minY = numeric_limits<int32_t>::max();
+  for (auto const & cell : m_cells)
+  {
+    minY = min(minY, get<0>(cell));
+    minX = min(minX, get<1>(cell));
+    maxX = max(maxX, get<1>(cell));
+  }
+  numCols = base::checked_cast<uint32_t>(maxX - minX + 1);
+}
+}  // namespace routing
@@ -0,0 +1,177 @@
+#pragma once
+
+#include "coding/reader.hpp"
+#include "coding/varint.hpp"
+#include "coding/writer.hpp"
+#include "coding/write_to_sink.hpp"
+
+#include "geometry/point2d.hpp"
+#include "geometry/rect2d.hpp"
+
+#include "base/assert.hpp"
+#include "base/checked_cast.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <tuple>
+#include <vector>
+
+namespace routing
+{
+// Grid of mercator cells with the roads whose segments cross the cells. It's used to find roads
+// near a point without decoding all the features around the point.
+//
+// Section format:
+// header: uint32_t version, int32_t min cell x, int32_t min cell y, uint32_t number of columns,
+// uint32_t number of not empty cells
+// keys of not empty cells: uint32_t row * number of columns + column, in ascending order
+// offsets: uint32_t offset of the feature ids of every cell and the size of all the ids
+// feature ids: for every cell varuint deltas of its feature ids in ascending order
+class RoadGrid final
+{
+public:
+  // Mercator units, about 200 meters at the equator.
+  static double constexpr kCellSize = 0.002;
+
+  explicit RoadGrid(std::unique_ptr<Reader> reader);
+
+  // Calls |fn| once for every road which may have a segment in |rect|.
+  template <typename Fn>
+  void ForEachRoadInRect(m2::RectD const & rect, Fn && fn) const
+  {
+    std::vector<uint32_t> featureIds;
+    ForEachCellInRect(rect, [&](uint32_t cellIdx) { ReadFeatureIds(cellIdx, featureIds); });
+
+    std::sort(featureIds.begin(), featureIds.end());
+    featureIds.erase(std::unique(featureIds.begin(), featureIds.end()), featureIds.end());
+    for (uint32_t const featureId : featureIds)
+      fn(featureId);
+  }
+
+  static int32_t GetCellCoord(double coord);
+
+  static uint32_t const kLatestVersion;
+
+private:
+  uint64_t GetKeysPos() const { return kHeaderSize; }
+  uint64_t GetOffsetsPos() const { return GetKeysPos() + m_numCells * sizeof(uint32_t); }
+  uint64_t GetFeatureIdsPos() const
+  {
+    return GetOffsetsPos() + (m_numCells + 1) * sizeof(uint32_t);
+  }
+
+  template <typename Fn>
+  void ForEachCellInRect(m2::RectD const & rect, Fn && fn) const
+  {
+    if (m_numCells == 0)
+      return;
+
+    int32_t const minX = std::max(GetCellCoord(rect.minX()), m_minX);
+    int32_t const maxX = std::min(GetCellCoord(rect.maxX()), m_maxX);
+    int32_t const minY = std::max(GetCellCoord(rect.minY()), m_minY);
+    int32_t const maxY = std::min(GetCellCoord(rect.maxY()), m_maxY);
+    if (minX > maxX || minY > maxY)
+      return;
+
+    for (int32_t y = minY; y <= maxY; ++y)
+    {
+      uint32_t const rowKey = static_cast<uint32_t>(y - m_minY) * m_numCols;
+      uint32_t const lastKey = rowKey + static_cast<uint32_t>(maxX - m_minX);
+      for (uint32_t i = LowerBound(rowKey + static_cast<uint32_t>(minX - m_minX));
+           i < m_numCells && ReadKey(i) <= lastKey; ++i)
+      {
+        fn(i);
+      }
+    }
+  }
+
+  // Returns the index of the first cell which key is not less than |key|.
+  uint32_t LowerBound(uint32_t key) const;
+  uint32_t ReadKey(uint32_t cellIdx) const;
+  void ReadFeatureIds(uint32_t cellIdx, std::vector<uint32_t> & featureIds) const;
+
+  static uint64_t constexpr kHeaderSize = 5 * sizeof(uint32_t);
+
+  std::unique_ptr<Reader> m_reader;
+  int32_t m_minX = 0;
+  int32_t m_minY = 0;
+  int32_t m_maxX = 0;
+  int32_t m_maxY = 0;
+  uint32_t m_numCols = 0;
+  uint32_t m_numCells = 0;
+};
+
+class RoadGridBuilder final
+{
+public:
+  void AddSegment(uint32_t featureId, m2::PointD const & p0, m2::PointD const & p1);
+
+  template <class Sink>
+  void Serialize(Sink & sink)
+  {
+    std::sort(m_cells.begin(), m_cells.end());
+    m_cells.erase(std::unique(m_cells.begin(), m_cells.end()), m_cells.end());
+
+    int32_t minX = 0;
+    int32_t minY = 0;
+    uint32_t numCols = 0;
+    CalcBounds(minX, minY, numCols);
+
+    auto const getKey = [&](Cell const & cell) {
+      return base::checked_cast<uint32_t>(static_cast<uint64_t>(std::get<0>(cell) - minY) *
+                                              numCols +
+                                          static_cast<uint64_t>(std::get<1>(cell) - minX));
+    };
+
+    std::vector<uint32_t> keys;
+    for (auto const & cell : m_cells)
+    {
+      if (keys.empty() || keys.back() != getKey(cell))
+        keys.push_back(getKey(cell));
+    }
+
+    WriteToSink(sink, RoadGrid::kLatestVersion);
+    WriteToSink(sink, minX);
+    WriteToSink(sink, minY);
+    WriteToSink(sink, numCols);
+    WriteToSink(sink, base::checked_cast<uint32_t>(keys.size()));
+    for (uint32_t const key : keys)
+      WriteToSink(sink, key);
+
+    // Feature ids are written to a buffer first to know the offsets.
+    std::vector<uint8_t> buffer;
+    std::vector<uint32_t> offsets;
+    {
+      MemWriter<std::vector<uint8_t>> writer(buffer);
+      uint32_t prevFeatureId = 0;
+      for (size_t i = 0; i < m_cells.size(); ++i)
+      {
+        bool const isNewCell = i == 0 || getKey(m_cells[i - 1]) != getKey(m_cells[i]);
+        if (isNewCell)
+        {
+          offsets.push_back(base::checked_cast<uint32_t>(writer.Pos()));
+          prevFeatureId = 0;
+        }
+
+        uint32_t const featureId = std::get<2>(m_cells[i]);
+        WriteVarUint(writer, featureId - prevFeatureId);
+        prevFeatureId = featureId;
+      }
+      offsets.push_back(base::checked_cast<uint32_t>(writer.Pos()));
+    }
+
+    for (uint32_t const offset : offsets)
+      WriteToSink(sink, offset);
+    sink.Write(buffer.data(), buffer.size());
+  }
+
+private:
+  // Row, column and feature id.
+  using Cell = std::tuple<int32_t, int32_t, uint32_t>;
+
+  void CalcBounds(int32_t & minX, int32_t & minY, uint32_t & numCols) const;
+
+  std::vector<Cell> m_cells;
+};
+}  // namespace routing
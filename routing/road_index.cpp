@@ -26,4 +26,14 @@ pair<Joint::Id, uint32_t> RoadIndex::FindNeighbor(RoadPoint const & rp, bool for
 
   return it->second.FindNeighbor(rp.GetPointId(), forward);
 }
+
+size_t RoadIndex::GetMemorySize() const
+{
+  // Every node of the map keeps the pair and the pointer to the next node.
+  size_t size = m_roads.bucket_count() * sizeof(void *) +
+                m_roads.size() * (sizeof(decltype(m_roads)::value_type) + sizeof(void *));
+  for (auto const & road : m_roads)
+    size += road.second.GetMemorySize();
+  return size;
+}
 }  // namespace routing
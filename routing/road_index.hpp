@@ -106,6 +106,8 @@ public:
     return result;
   }
 
+  size_t GetMemorySize() const { return m_jointIds.capacity() * sizeof(Joint::Id); }
+
 private:
   // Joint ids indexed by point id.
   // If some point id doesn't match any joint id, this vector contains Joint::kInvalidId.
@@ -144,6 +146,8 @@ public:
   pair<Joint::Id, uint32_t> FindNeighbor(RoadPoint const & rp, bool forward) const;
 
   uint32_t GetSize() const { return base::asserted_cast<uint32_t>(m_roads.size()); }
+  // Returns the approximate number of bytes used by the index.
+  size_t GetMemorySize() const;
 
   Joint::Id GetJointId(RoadPoint const & rp) const
   {
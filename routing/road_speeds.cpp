@@ -0,0 +1,58 @@
+#include "routing/road_speeds.hpp"
+
+#include "base/assert.hpp"
+#include "base/checked_cast.hpp"
+
+#include <algorithm>
+#include <limits>
+
+using namespace std;
+
+namespace routing
+{
+// static
+uint16_t constexpr RoadSpeeds::kOneWayBit;
+uint16_t constexpr RoadSpeeds::kTransitAllowedBit;
+uint16_t constexpr RoadSpeeds::kFlagsBits;
+
+void RoadSpeeds::Add(uint32_t featureId, Road const & road)
+{
+  CHECK(m_featureIds.empty() || m_featureIds.back() < featureId, (featureId));
+
+  uint16_t attrs = GetSpeedIdx(road.m_speedKMpH) << kFlagsBits;
+  if (road.m_isOneWay)
+    attrs |= kOneWayBit;
+  if (road.m_isTransitAllowed)
+    attrs |= kTransitAllowedBit;
+
+  m_featureIds.push_back(featureId);
+  m_attrs.push_back(attrs);
+}
+
+bool RoadSpeeds::Get(uint32_t featureId, Road & road) const
+{
+  auto const it = lower_bound(m_featureIds.cbegin(), m_featureIds.cend(), featureId);
+  if (it == m_featureIds.cend() || *it != featureId)
+    return false;
+
+  uint16_t const attrs = m_attrs[distance(m_featureIds.cbegin(), it)];
+  size_t const speedIdx = attrs >> kFlagsBits;
+  CHECK_LESS(speedIdx, m_speeds.size(), (featureId));
+
+  road.m_speedKMpH = m_speeds[speedIdx];
+  road.m_isOneWay = (attrs & kOneWayBit) != 0;
+  road.m_isTransitAllowed = (attrs & kTransitAllowedBit) != 0;
+  return true;
+}
+
+uint16_t RoadSpeeds::GetSpeedIdx(double speedKMpH)
+{
+  auto const it = find(m_speeds.cbegin(), m_speeds.cend(), speedKMpH);
+  if (it != m_speeds.cend())
+    return static_cast<uint16_t>(distance(m_speeds.cbegin(), it));
+
+  CHECK_LESS(m_speeds.size(), numeric_limits<uint16_t>::max() >> kFlagsBits, ("Too many speeds."));
+  m_speeds.push_back(speedKMpH);
+  return base::checked_cast<uint16_t>(m_speeds.size() - 1);
+}
+}  // namespace routing
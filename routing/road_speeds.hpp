@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace routing
+{
+// Speeds and flags of the roads of one vehicle type, which are calculated by the generator with
+// the vehicle model of the country. Loading of a road with the table doesn't check feature types.
+class RoadSpeeds final
+{
+public:
+  struct Road
+  {
+    double m_speedKMpH = 0.0;
+    bool m_isOneWay = false;
+    bool m_isTransitAllowed = false;
+  };
+
+  // Roads should be added in ascending order of feature ids.
+  void Add(uint32_t featureId, Road const & road);
+
+  // Returns false if |featureId| is not a road for the vehicle type.
+  bool Get(uint32_t featureId, Road & road) const;
+
+  size_t GetNumRoads() const { return m_featureIds.size(); }
+  size_t GetNumSpeeds() const { return m_speeds.size(); }
+
+private:
+  friend class RoadSpeedsSerializer;
+
+  static uint16_t constexpr kOneWayBit = 1;
+  static uint16_t constexpr kTransitAllowedBit = 2;
+  static uint16_t constexpr kFlagsBits = 2;
+
+  uint16_t GetSpeedIdx(double speedKMpH);
+
+  std::vector<uint32_t> m_featureIds;
+  // Flags and the index of the speed in |m_speeds| for every road of |m_featureIds|.
+  std::vector<uint16_t> m_attrs;
+  // A few distinct speeds of the vehicle model.
+  std::vector<double> m_speeds;
+};
+}  // namespace routing
@@ -0,0 +1,7 @@
+#include "routing/road_speeds_serialization.hpp"
+
+namespace routing
+{
+// static
+uint32_t const RoadSpeedsSerializer::kLatestVersion = 0;
+}  // namespace routing
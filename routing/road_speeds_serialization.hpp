@@ -0,0 +1,132 @@
+#pragma once
+
+#include "routing/road_speeds.hpp"
+#include "routing/vehicle_mask.hpp"
+
+#include "coding/reader.hpp"
+#include "coding/varint.hpp"
+#include "coding/write_to_sink.hpp"
+
+#include "base/assert.hpp"
+#include "base/checked_cast.hpp"
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace routing
+{
+// Section format:
+// header: uint32_t version, uint32_t size of the table for every vehicle type
+// for every vehicle type:
+//   varuint number of speeds, uint64_t bits of every speed in km/h
+//   varuint number of roads, for every road varuint delta of feature id and varuint flags
+//   combined with the speed index
+class RoadSpeedsSerializer final
+{
+public:
+  using RoadSpeedsByVehicleType = std::array<RoadSpeeds, static_cast<size_t>(VehicleType::Count)>;
+
+  RoadSpeedsSerializer() = delete;
+
+  template <class Sink>
+  static void Serialize(Sink & sink, RoadSpeedsByVehicleType const & speedsByType)
+  {
+    WriteToSink(sink, kLatestVersion);
+
+    auto const sizesPos = sink.Pos();
+    std::array<uint32_t, static_cast<size_t>(VehicleType::Count)> sizes;
+    for (size_t i = 0; i < sizes.size(); ++i)
+    {
+      sizes[i] = 0;
+      WriteToSink(sink, sizes[i]);
+    }
+
+    for (size_t i = 0; i < sizes.size(); ++i)
+    {
+      auto const pos = sink.Pos();
+      SerializeOneVehicleType(sink, speedsByType[i]);
+      sizes[i] = base::checked_cast<uint32_t>(sink.Pos() - pos);
+    }
+
+    auto const endPos = sink.Pos();
+    sink.Seek(sizesPos);
+    for (size_t i = 0; i < sizes.size(); ++i)
+      WriteToSink(sink, sizes[i]);
+    sink.Seek(endPos);
+  }
+
+  template <class Source>
+  static void Deserialize(Source & src, VehicleType vehicleType, RoadSpeeds & speeds)
+  {
+    uint32_t const version = ReadPrimitiveFromSource<uint32_t>(src);
+    CHECK_EQUAL(version, kLatestVersion, ());
+
+    std::array<uint32_t, static_cast<size_t>(VehicleType::Count)> sizes;
+    for (size_t i = 0; i < sizes.size(); ++i)
+      sizes[i] = ReadPrimitiveFromSource<uint32_t>(src);
+
+    for (size_t i = 0; i < sizes.size(); ++i)
+    {
+      if (vehicleType != static_cast<VehicleType>(i))
+      {
+        src.Skip(sizes[i]);
+        continue;
+      }
+
+      DeserializeOneVehicleType(src, speeds);
+    }
+  }
+
+private:
+  static_assert(sizeof(double) == sizeof(uint64_t), "");
+
+  template <class Sink>
+  static void SerializeOneVehicleType(Sink & sink, RoadSpeeds const & speeds)
+  {
+    WriteVarUint(sink, base::checked_cast<uint32_t>(speeds.m_speeds.size()));
+    for (double const speed : speeds.m_speeds)
+    {
+      uint64_t bits;
+      std::memcpy(&bits, &speed, sizeof(bits));
+      WriteToSink(sink, bits);
+    }
+
+    WriteVarUint(sink, base::checked_cast<uint32_t>(speeds.m_featureIds.size()));
+    uint32_t prevFeatureId = 0;
+    for (size_t i = 0; i < speeds.m_featureIds.size(); ++i)
+    {
+      uint32_t const featureId = speeds.m_featureIds[i];
+      WriteVarUint(sink, featureId - prevFeatureId);
+      WriteVarUint(sink, static_cast<uint32_t>(speeds.m_attrs[i]));
+      prevFeatureId = featureId;
+    }
+  }
+
+  template <class Source>
+  static void DeserializeOneVehicleType(Source & src, RoadSpeeds & speeds)
+  {
+    auto const numSpeeds = ReadVarUint<uint32_t>(src);
+    speeds.m_speeds.resize(numSpeeds);
+    for (double & speed : speeds.m_speeds)
+    {
+      uint64_t const bits = ReadPrimitiveFromSource<uint64_t>(src);
+      std::memcpy(&speed, &bits, sizeof(speed));
+    }
+
+    auto const numRoads = ReadVarUint<uint32_t>(src);
+    speeds.m_featureIds.resize(numRoads);
+    speeds.m_attrs.resize(numRoads);
+    uint32_t featureId = 0;
+    for (uint32_t i = 0; i < numRoads; ++i)
+    {
+      featureId += ReadVarUint<uint32_t>(src);
+      speeds.m_featureIds[i] = featureId;
+      speeds.m_attrs[i] = base::checked_cast<uint16_t>(ReadVarUint<uint32_t>(src));
+    }
+  }
+
+  static uint32_t const kLatestVersion;
+};
+}  // namespace routing
@@ -341,6 +341,7 @@ void Route::SetSubrouteUid(size_t segmentIdx, SubrouteUid subrouteUid)
 void Route::GetAltitudes(feature::TAltitudes & altitudes) const
 {
   altitudes.clear();
+  altitudes.reserve(m_routeSegments.size() + 1);
 
   CHECK(!m_subrouteAttrs.empty(), ());
   altitudes.push_back(m_subrouteAttrs.front().GetStart().GetAltitude());
@@ -68,6 +68,9 @@ public:
   /// Clear all temporary buffers.
   virtual void ClearState() {}
 
+  /// Drops caches which are kept between requests, e.g. under memory pressure.
+  virtual void ShrinkCaches() {}
+
   /// Override this function with routing implementation.
   /// It will be called in separate thread and only one function will processed in same time.
   /// @warning please support Cancellable interface calls. You must stop processing when it is true.
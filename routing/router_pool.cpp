@@ -0,0 +1,142 @@
+#include "routing/router_pool.hpp"
+
+#include "base/assert.hpp"
+#include "base/exception.hpp"
+#include "base/logging.hpp"
+
+#include "std/utility.hpp"
+
+namespace routing
+{
+RouterPool::RouterPool(size_t workersCount, RouterFactory const & routerFactory)
+{
+  ASSERT_GREATER(workersCount, 0, ());
+  ASSERT(routerFactory, ());
+
+  m_routers.reserve(workersCount);
+  for (size_t i = 0; i < workersCount; ++i)
+  {
+    m_routers.push_back(routerFactory());
+    CHECK(m_routers.back(), ());
+  }
+
+  m_threads.reserve(workersCount);
+  for (auto & router : m_routers)
+    m_threads.emplace_back(&RouterPool::ThreadFunc, this, ref(*router));
+}
+
+RouterPool::~RouterPool()
+{
+  deque<Request> queue;
+  {
+    lock_guard<mutex> guard(m_guard);
+    m_exit = true;
+    queue.swap(m_queue);
+    for (auto & delegate : m_delegates)
+      delegate.second->Cancel();
+  }
+  m_cv.notify_all();
+
+  for (auto & thread : m_threads)
+    thread.join();
+
+  for (auto & request : queue)
+  {
+    Route route(m_routers.front()->GetName());
+    request.m_readyCallback(route, IRouter::Cancelled);
+  }
+}
+
+RouterPool::RequestId RouterPool::CalculateRoute(
+    Checkpoints const & checkpoints, m2::PointD const & startDirection,
+    ReadyCallback const & readyCallback, RouterDelegate::TProgressCallback const & progressCallback,
+    uint32_t timeoutSec)
+{
+  ASSERT(readyCallback, ());
+
+  Request request;
+  request.m_checkpoints = checkpoints;
+  request.m_startDirection = startDirection;
+  request.m_readyCallback = readyCallback;
+  request.m_delegate = make_shared<RouterDelegate>();
+  request.m_delegate->SetProgressCallback(progressCallback);
+  request.m_delegate->SetTimeout(timeoutSec);
+
+  RequestId id;
+  {
+    lock_guard<mutex> guard(m_guard);
+    id = m_nextId++;
+    request.m_id = id;
+    m_delegates.emplace(id, request.m_delegate);
+    m_queue.push_back(move(request));
+  }
+  m_cv.notify_one();
+  return id;
+}
+
+void RouterPool::Cancel(RequestId id)
+{
+  lock_guard<mutex> guard(m_guard);
+  auto const it = m_delegates.find(id);
+  if (it != m_delegates.end())
+    it->second->Cancel();
+}
+
+size_t RouterPool::GetQueueSize() const
+{
+  lock_guard<mutex> guard(m_guard);
+  return m_queue.size();
+}
+
+void RouterPool::ThreadFunc(IRouter & router)
+{
+  while (true)
+  {
+    Request request;
+    {
+      unique_lock<mutex> lock(m_guard);
+      m_cv.wait(lock, [this]() { return m_exit || !m_queue.empty(); });
+      if (m_exit)
+        return;
+      request = move(m_queue.front());
+      m_queue.pop_front();
+    }
+
+    Calculate(router, request);
+
+    lock_guard<mutex> guard(m_guard);
+    m_delegates.erase(request.m_id);
+  }
+}
+
+void RouterPool::Calculate(IRouter & router, Request & request)
+{
+  Route route(router.GetName());
+
+  // Cancelled and expired requests aren't calculated.
+  if (request.m_delegate->IsCancelled())
+  {
+    request.m_readyCallback(route, IRouter::Cancelled);
+    return;
+  }
+
+  IRouter::ResultCode code = IRouter::InternalError;
+  try
+  {
+    code = router.CalculateRoute(request.m_checkpoints, request.m_startDirection,
+                                 false /* adjust */, *request.m_delegate, route);
+  }
+  catch (RootException const & e)
+  {
+    code = IRouter::InternalError;
+    LOG(LERROR, ("Exception happened while calculating route:", e.Msg()));
+  }
+
+  // Routers may return partial results when they are cancelled.
+  if (code != IRouter::NoError && request.m_delegate->IsCancelled())
+    code = IRouter::Cancelled;
+
+  router.ClearState();
+  request.m_readyCallback(route, code);
+}
+}  // namespace routing
@@ -0,0 +1,85 @@
+#pragma once
+
+#include "routing/checkpoints.hpp"
+#include "routing/route.hpp"
+#include "routing/router.hpp"
+#include "routing/router_delegate.hpp"
+
+#include "geometry/point2d.hpp"
+
+#include "base/macros.hpp"
+#include "base/thread.hpp"
+
+#include "std/condition_variable.hpp"
+#include "std/cstdint.hpp"
+#include "std/deque.hpp"
+#include "std/function.hpp"
+#include "std/map.hpp"
+#include "std/mutex.hpp"
+#include "std/shared_ptr.hpp"
+#include "std/unique_ptr.hpp"
+#include "std/vector.hpp"
+
+namespace routing
+{
+/// Calculates routes concurrently, e.g. for a routing server. Unlike AsyncRouter, new
+/// requests don't cancel previous ones, they are queued and calculated by a fixed number
+/// of workers. Every worker owns a router created by the factory, so routers don't need
+/// to be thread-safe, but they may share read-only data, e.g. Index, NumMwmIds and
+/// cross-mwm data, when it's safe to read concurrently.
+///
+/// Every request has its own RouterDelegate. A timeout of a request counts from
+/// its submission, so requests whose deadlines pass in the queue are cancelled
+/// without calculation.
+class RouterPool final
+{
+public:
+  using RequestId = uint64_t;
+  using RouterFactory = function<unique_ptr<IRouter>()>;
+  /// Called on a worker thread, takes ownership of the passed route.
+  using ReadyCallback = function<void(Route &, IRouter::ResultCode)>;
+
+  RouterPool(size_t workersCount, RouterFactory const & routerFactory);
+  /// Cancels all requests. Ready callbacks of not started requests are called
+  /// with IRouter::Cancelled.
+  ~RouterPool();
+
+  /// @param timeoutSec timeout to cancel routing. 0 is infinity.
+  RequestId CalculateRoute(Checkpoints const & checkpoints, m2::PointD const & startDirection,
+                           ReadyCallback const & readyCallback,
+                           RouterDelegate::TProgressCallback const & progressCallback,
+                           uint32_t timeoutSec);
+
+  /// Cancels a queued or a running request. Its ready callback is called with
+  /// IRouter::Cancelled, unless the route is already calculated.
+  void Cancel(RequestId id);
+
+  size_t GetQueueSize() const;
+
+private:
+  struct Request
+  {
+    RequestId m_id = 0;
+    Checkpoints m_checkpoints;
+    m2::PointD m_startDirection = m2::PointD::Zero();
+    ReadyCallback m_readyCallback;
+    shared_ptr<RouterDelegate> m_delegate;
+  };
+
+  void ThreadFunc(IRouter & router);
+  void Calculate(IRouter & router, Request & request);
+
+  mutable mutex m_guard;
+  condition_variable m_cv;
+  deque<Request> m_queue;
+  /// Delegates of queued and running requests.
+  map<RequestId, shared_ptr<RouterDelegate>> m_delegates;
+  RequestId m_nextId = 0;
+  bool m_exit = false;
+
+  vector<unique_ptr<IRouter>> m_routers;
+  vector<threads::SimpleThread> m_threads;
+
+  DISALLOW_COPY_AND_MOVE(RouterPool);
+};
+}  // namespace routing
@@ -19,6 +19,7 @@ SOURCES += \
     checkpoint_predictor.cpp \
     checkpoints.cpp \
     cross_mwm_connector.cpp \
+    cross_mwm_connector_cache.cpp \
     cross_mwm_connector_serialization.cpp \
     cross_mwm_graph.cpp \
     cross_mwm_index_graph.cpp \
@@ -38,6 +39,8 @@ SOURCES += \
     index_router.cpp \
     joint.cpp \
     joint_index.cpp \
+    landmark_index.cpp \
+    landmark_serialization.cpp \
     nearest_edge_finder.cpp \
     online_absent_fetcher.cpp \
     online_cross_fetcher.cpp \
@@ -46,23 +49,35 @@ SOURCES += \
     pedestrian_directions.cpp \
     road_access.cpp \
     road_access_serialization.cpp \
+    restriction_index.cpp \
     restriction_loader.cpp \
     restrictions_serialization.cpp \
     road_graph.cpp \
     road_graph_router.cpp \
+    road_grid.cpp \
     road_index.cpp \
+    road_speeds.cpp \
+    road_speeds_serialization.cpp \
     route.cpp \
     route_weight.cpp \
     router.cpp \
     router_delegate.cpp \
+    router_pool.cpp \
     routing_algorithm.cpp \
     routing_helpers.cpp \
     routing_mapping.cpp \
     routing_session.cpp \
     routing_settings.cpp \
     segmented_route.cpp \
+    shortcut_index.cpp \
+    shortcut_serialization.cpp \
     speed_camera.cpp \
+    speed_profiles.cpp \
+    speed_profiles_serialization.cpp \
+    subroute_cache.cpp \
     traffic_stash.cpp \
+    transit_graph_loader.cpp \
+    transit_section.cpp \
     turns.cpp \
     turns_generator.cpp \
     turns_notification_manager.cpp \
@@ -75,12 +90,15 @@ HEADERS += \
     async_router.hpp \
     base/astar_algorithm.hpp \
     base/astar_weight.hpp \
+    base/eytzinger_map.hpp \
     base/followed_polyline.hpp \
+    base/stamped_hash_map.hpp \
     bicycle_directions.hpp \
     checkpoint_predictor.hpp \
     checkpoints.hpp \
     coding.hpp \
     cross_mwm_connector.hpp \
+    cross_mwm_connector_cache.hpp \
     cross_mwm_connector_serialization.hpp \
     cross_mwm_graph.hpp \
     cross_mwm_index_graph.hpp \
@@ -101,6 +119,8 @@ HEADERS += \
     index_router.hpp \
     joint.hpp \
     joint_index.hpp \
+    landmark_index.hpp \
+    landmark_serialization.hpp \
     loaded_path_segment.hpp \
     nearest_edge_finder.hpp \
     num_mwm_id.hpp \
@@ -110,19 +130,24 @@ HEADERS += \
     osrm_data_facade.hpp \
     osrm_engine.hpp \
     pedestrian_directions.hpp \
+    restriction_index.hpp \
     restriction_loader.hpp \
     restrictions_serialization.hpp \
     road_access.hpp \
     road_access_serialization.hpp \
     road_graph.hpp \
     road_graph_router.hpp \
+    road_grid.hpp \
     road_index.hpp \
     road_point.hpp \
+    road_speeds.hpp \
+    road_speeds_serialization.hpp \
     route.hpp \
     route_point.hpp \
     route_weight.hpp \
     router.hpp \
     router_delegate.hpp \
+    router_pool.hpp \
     routing_algorithm.hpp \
     routing_exceptions.hpp \
     routing_helpers.hpp \
@@ -132,8 +157,15 @@ HEADERS += \
     routing_settings.hpp \
     segment.hpp \
     segmented_route.hpp \
+    shortcut_index.hpp \
+    shortcut_serialization.hpp \
     speed_camera.hpp \
+    speed_profiles.hpp \
+    speed_profiles_serialization.hpp \
+    subroute_cache.hpp \
     traffic_stash.hpp \
+    transit_graph_loader.hpp \
+    transit_section.hpp \
     transition_points.hpp \
     turn_candidate.hpp \
     turns.hpp \
@@ -186,7 +186,7 @@ IRoutingAlgorithm::Result AStarBidirectionalRoutingAlgorithm::CalculateRoute(
   progress.Initialize(startPos.GetPoint(), finalPos.GetPoint());
   RoadGraph roadGraph(graph);
   TAlgorithmImpl::Result const res = TAlgorithmImpl().FindPathBidirectional(
-      roadGraph, startPos, finalPos, path, cancellable, onVisitJunctionFn);
+      m_context, roadGraph, startPos, finalPos, path, cancellable, onVisitJunctionFn);
   return Convert(res);
 }
 
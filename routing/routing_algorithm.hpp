@@ -50,6 +50,10 @@ public:
   Result CalculateRoute(IRoadGraph const & graph, Junction const & startPos,
                         Junction const & finalPos, RouterDelegate const & delegate,
                         RoutingResult<IRoadGraph::Vertex, IRoadGraph::Weight> & path) override;
+
+private:
+  // Search states are reused by all the searches of the algorithm to avoid reallocations.
+  AStarBidirectionalContext<IRoadGraph::Vertex, IRoadGraph::Weight> m_context;
 };
 
 }  // namespace routing
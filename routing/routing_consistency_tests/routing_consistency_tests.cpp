@@ -10,9 +10,12 @@
 #include "geometry/point2d.hpp"
 
 #include "base/logging.hpp"
+#include "base/timer.hpp"
 
-#include "std/string.hpp"
 #include "std/fstream.hpp"
+#include "std/iomanip.hpp"
+#include "std/mutex.hpp"
+#include "std/string.hpp"
 
 #include "3party/gflags/src/gflags/gflags.h"
 
@@ -31,6 +34,8 @@ DEFINE_string(data_path, "../../data/", "Working directory, 'path_to_exe/../../d
 DEFINE_string(user_resource_path, "", "User defined resource path for classificator.txt and etc.");
 DEFINE_bool(verbose, false, "Output processed lines to log.");
 DEFINE_uint64(confidence, 5, "Maximum test count for each single mwm file.");
+DEFINE_uint64(threads, 1, "Count of routers which calculate routes concurrently by one index.");
+DEFINE_string(timings_file, "", "CSV file for results and timings of routes.");
 
 // Information about successful user routing.
 struct UserRoutingRecord
@@ -74,24 +79,39 @@ bool ParseUserString(string const & incomeString, UserRoutingRecord & result)
   return true;
 }
 
+// Result of a route of a record.
+struct RouteResult
+{
+  string m_country;
+  IRouter::ResultCode m_code = IRouter::NoError;
+  bool m_ok = false;
+  double m_seconds = 0.0;
+};
+
 class RouteTester
 {
 public:
-  RouteTester() : m_components(integration::GetVehicleComponents<VehicleType::Car>())
+  RouteTester(vector<LocalCountryFile> const & localFiles, size_t threadsCount)
+    : m_pool(localFiles, VehicleType::Car, threadsCount)
   {
   }
 
-  bool BuildRoute(UserRoutingRecord const & record)
+  bool BuildRoute(integration::IRouterComponents const & components,
+                  UserRoutingRecord const & record, RouteResult & result)
   {
-    m_components.GetRouter().ClearState();
-    auto const result = integration::CalculateRoute(m_components, record.start, m2::PointD::Zero(), record.stop);
-    if (result.second != IRouter::NoError)
+    components.GetRouter().ClearState();
+    my::Timer timer;
+    auto const route = integration::CalculateRoute(components, record.start, m2::PointD::Zero(),
+                                                   record.stop);
+    result.m_seconds = timer.ElapsedSeconds();
+    result.m_code = route.second;
+    if (route.second != IRouter::NoError)
     {
-      LOG(LINFO, ("Can't build the route. Code:", result.second));
+      LOG(LINFO, ("Can't build the route. Code:", route.second));
       return false;
     }
     auto const delta = record.distance * kRouteLengthAccuracy;
-    auto const routeLength = result.first->GetTotalDistanceMeters();
+    auto const routeLength = route.first->GetTotalDistanceMeters();
     if (abs(routeLength - record.distance) < delta)
       return true;
 
@@ -99,34 +119,63 @@ public:
     return false;
   }
 
-  bool CheckRecord(UserRoutingRecord const & record)
+  // Checks the record and, if it should be tested, adds it to the records to test.
+  void AddRecord(UserRoutingRecord const & record)
   {
+    auto const & infoGetter = m_pool.GetComponents(0).GetCountryInfoGetter();
     CountryInfo startCountry, finishCountry;
-    m_components.GetCountryInfoGetter().GetRegionInfo(record.start, startCountry);
-    m_components.GetCountryInfoGetter().GetRegionInfo(record.stop, finishCountry);
+    infoGetter.GetRegionInfo(record.start, startCountry);
+    infoGetter.GetRegionInfo(record.stop, finishCountry);
     if (startCountry.m_name != finishCountry.m_name || startCountry.m_name.empty())
-      return false;
+      return;
 
     if (record.distance < kMinimumRouteDistanceM)
-      return false;
+      return;
 
     if (m_checkedCountries[startCountry.m_name] > FLAGS_confidence)
-      return false;
+      return;
 
-    return true;
+    m_checkedCountries[startCountry.m_name] += 1;
+    m_records.push_back(record);
+    m_results.emplace_back();
+    m_results.back().m_country = startCountry.m_name;
   }
 
-  bool BuildRouteByRecord(UserRoutingRecord const & record)
+  size_t GetRecordsCount() const { return m_records.size(); }
+
+  // Builds routes of all added records by all routers of the pool.
+  void BuildRoutes()
   {
-    CountryInfo startCountry;
-    m_components.GetCountryInfoGetter().GetRegionInfo(record.start, startCountry);
-    m_checkedCountries[startCountry.m_name] += 1;
-    if (!BuildRoute(record))
+    LOG(LINFO, ("Building", m_records.size(), "routes by", m_pool.GetRoutersCount(), "routers."));
+    my::Timer timer;
+    m_pool.RunConcurrently(m_records.size(),
+                           [this](integration::IRouterComponents const & components, size_t i) {
+                             RouteResult & result = m_results[i];
+                             result.m_ok = BuildRoute(components, m_records[i], result);
+                             if (!result.m_ok)
+                             {
+                               lock_guard<mutex> lock(m_errorsMutex);
+                               m_errors[result.m_country] += 1;
+                             }
+                           });
+    LOG(LINFO, ("Routes are built in", timer.ElapsedSeconds(), "seconds."));
+  }
+
+  void WriteTimings(string const & fileName) const
+  {
+    ofstream stream(fileName);
+    stream << "country,start_lat,start_lon,finish_lat,finish_lon,result,ok,seconds\n";
+    stream << setprecision(7) << fixed;
+    for (size_t i = 0; i < m_records.size(); ++i)
     {
-      m_errors[startCountry.m_name] += 1;
-      return false;
+      auto const & record = m_records[i];
+      auto const & result = m_results[i];
+      auto const start = MercatorBounds::ToLatLon(record.start);
+      auto const finish = MercatorBounds::ToLatLon(record.stop);
+      stream << result.m_country << ',' << start.lat << ',' << start.lon << ',' << finish.lat
+             << ',' << finish.lon << ',' << static_cast<int>(result.m_code) << ','
+             << result.m_ok << ',' << result.m_seconds << '\n';
     }
-    return true;
   }
 
   void PrintStatistics()
@@ -144,9 +193,13 @@ public:
   }
 
 private:
-  integration::IRouterComponents & m_components;
+  integration::VehicleRouterPool m_pool;
+
+  vector<UserRoutingRecord> m_records;
+  vector<RouteResult> m_results;
 
   map<string, size_t> m_checkedCountries;
+  mutex m_errorsMutex;
   map<string, size_t> m_errors;
 };
 
@@ -162,13 +215,14 @@ void ReadInput(istream & stream, RouteTester & tester)
     UserRoutingRecord record;
     if (!ParseUserString(line, record))
       continue;
-    if (tester.CheckRecord(record))
-    {
-      if (FLAGS_verbose)
-        LOG(LINFO, ("Checked", line));
-      tester.BuildRouteByRecord(record);
-    }
+    if (FLAGS_verbose)
+      LOG(LINFO, ("Parsed", line));
+    tester.AddRecord(record);
   }
+
+  tester.BuildRoutes();
+  if (!FLAGS_timings_file.empty())
+    tester.WriteTimings(FLAGS_timings_file);
   tester.PrintStatistics();
 }
 
@@ -183,7 +237,12 @@ int main(int argc, char ** argv)
   if (FLAGS_input_file.empty())
     return 1;
 
-  RouteTester tester;
+  if (FLAGS_threads == 0)
+    return 1;
+
+  vector<LocalCountryFile> localFiles;
+  integration::GetAllLocalFiles(localFiles);
+  RouteTester tester(localFiles, static_cast<size_t>(FLAGS_threads));
   ifstream stream(FLAGS_input_file);
   ReadInput(stream, tester);
 
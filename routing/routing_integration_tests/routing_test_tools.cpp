@@ -26,8 +26,12 @@
 
 #include "geometry/distance_on_sphere.hpp"
 
+#include "std/atomic.hpp"
+#include "std/exception.hpp"
 #include "std/functional.hpp"
 #include "std/limits.hpp"
+#include "std/mutex.hpp"
+#include "std/thread.hpp"
 
 #include "private.h"
 
@@ -131,6 +135,51 @@ namespace integration
     return unique_ptr<IRouter>(move(router));
   }
 
+  VehicleRouterPool::VehicleRouterPool(vector<LocalCountryFile> const & localFiles,
+                                       VehicleType vehicleType, size_t routersCount)
+  {
+    CHECK_GREATER(routersCount, 0, ());
+    auto const featuresFetcher = CreateFeaturesFetcher(localFiles);
+    CHECK(featuresFetcher, ());
+    for (size_t i = 0; i < routersCount; ++i)
+    {
+      m_components.push_back(
+          make_unique<VehicleRouterComponents>(featuresFetcher, localFiles, vehicleType));
+    }
+  }
+
+  void VehicleRouterPool::RunConcurrently(size_t casesCount, TTask const & task)
+  {
+    atomic<size_t> next(0);
+    exception_ptr error;
+    mutex errorMutex;
+
+    auto const worker = [&](IRouterComponents const & components) {
+      try
+      {
+        for (size_t i = next++; i < casesCount; i = next++)
+          task(components, i);
+      }
+      catch (...)
+      {
+        lock_guard<mutex> lock(errorMutex);
+        if (!error)
+          error = current_exception();
+        next = casesCount;
+      }
+    };
+
+    vector<thread> threads;
+    for (size_t i = 1; i < m_components.size(); ++i)
+      threads.emplace_back(worker, cref(*m_components[i]));
+    worker(*m_components[0]);
+    for (auto & t : threads)
+      t.join();
+
+    if (error)
+      rethrow_exception(error);
+  }
+
   void GetAllLocalFiles(vector<LocalCountryFile> & localFiles)
   {
     // Setting stored paths from testingmain.cpp
@@ -8,6 +8,7 @@
 
 #include "platform/local_country_file.hpp"
 
+#include "std/function.hpp"
 #include "std/set.hpp"
 #include "std/shared_ptr.hpp"
 #include "std/string.hpp"
@@ -64,6 +65,12 @@ public:
   {
   }
 
+  // Components which share the index of |featuresFetcher|.
+  IRouterComponents(shared_ptr<model::FeaturesFetcher> const & featuresFetcher)
+    : m_featuresFetcher(featuresFetcher), m_infoGetter(CreateCountryInfoGetter())
+  {
+  }
+
   virtual ~IRouterComponents() = default;
 
   virtual IRouter & GetRouter() const = 0;
@@ -85,13 +92,44 @@ public:
   {
   }
 
+  VehicleRouterComponents(shared_ptr<model::FeaturesFetcher> const & featuresFetcher,
+                          vector<LocalCountryFile> const & localFiles, VehicleType vehicleType)
+    : IRouterComponents(featuresFetcher)
+    , m_indexRouter(CreateVehicleRouter(m_featuresFetcher->GetIndex(), *m_infoGetter, m_trafficCache,
+                                        localFiles, vehicleType))
+  {
+  }
+
   IRouter & GetRouter() const override { return *m_indexRouter; }
+  IndexRouter & GetIndexRouter() const { return *m_indexRouter; }
 
 private:
   traffic::TrafficCache m_trafficCache;
   unique_ptr<IndexRouter> m_indexRouter;
 };
 
+// Routers which share one index of maps of |localFiles|. The index is only
+// read by routers, so routes are calculated concurrently by a router per thread.
+class VehicleRouterPool
+{
+public:
+  // Calculates a route of a case by |components|.
+  using TTask = function<void(IRouterComponents const & components, size_t caseIndex)>;
+
+  VehicleRouterPool(vector<LocalCountryFile> const & localFiles, VehicleType vehicleType,
+                    size_t routersCount);
+
+  size_t GetRoutersCount() const { return m_components.size(); }
+  IRouterComponents const & GetComponents(size_t i) const { return *m_components[i]; }
+
+  // Calls |task| for cases [0, casesCount) by all routers of the pool,
+  // returns when all of the cases are done. Cases are taken in order.
+  void RunConcurrently(size_t casesCount, TTask const & task);
+
+private:
+  vector<unique_ptr<VehicleRouterComponents>> m_components;
+};
+
 void GetAllLocalFiles(vector<LocalCountryFile> & localFiles);
 void TestOnlineCrosses(ms::LatLon const & startPoint, ms::LatLon const & finalPoint,
                        vector<string> const & expected, IRouterComponents & routerComponents);
@@ -0,0 +1,251 @@
+// Replays a set of routes through IndexRouter and writes timings of the routing phases.
+//
+// Every line of the input file describes a route:
+// <start lat> <start lon> <finish lat> <finish lon> <vehicle type: Car, Pedestrian or Bicycle>
+// Empty lines and lines which start with '#' are skipped.
+//
+// Every row of the output csv file describes a route of the input file in the same order.
+// The rows of two data versions or two builds may be compared line by line.
+
+#include "testing/testing.hpp"
+#include "routing/routing_integration_tests/routing_test_tools.hpp"
+
+#include "routing/index_router.hpp"
+#include "routing/route.hpp"
+#include "routing/vehicle_mask.hpp"
+
+#include "geometry/mercator.hpp"
+
+#include "base/logging.hpp"
+#include "base/string_utils.hpp"
+#include "base/timer.hpp"
+
+#include "std/target_os.hpp"
+
+#include <array>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <sys/resource.h>
+
+#include "3party/gflags/src/gflags/gflags.h"
+
+using namespace routing;
+using namespace std;
+
+// Testing stub to make routing test tools linkable.
+static CommandLineOptions g_options;
+CommandLineOptions const & GetTestingOptions() { return g_options; }
+
+DEFINE_string(input_file, "", "File with routes to replay.");
+DEFINE_string(csv_file, "", "Output file with timings of every route. Stdout if empty.");
+DEFINE_string(data_path, "../../data/", "Working directory, 'path_to_exe/../../data' if empty.");
+DEFINE_string(user_resource_path, "", "User defined resource path for classificator.txt and etc.");
+DEFINE_uint64(repeat, 1, "Number of times every route is calculated. The best time is reported.");
+
+namespace
+{
+struct RouteRecord
+{
+  m2::PointD m_start;
+  m2::PointD m_finish;
+  VehicleType m_vehicleType = VehicleType::Car;
+};
+
+struct RouteResult
+{
+  IRouter::ResultCode m_code = IRouter::NoError;
+  double m_totalSec = 0.0;
+  double m_distanceM = 0.0;
+  IndexRouter::Stats m_stats;
+};
+
+bool ParseVehicleType(string const & s, VehicleType & vehicleType)
+{
+  for (size_t i = 0; i < static_cast<size_t>(VehicleType::Count); ++i)
+  {
+    auto const type = static_cast<VehicleType>(i);
+    if (s == ToString(type))
+    {
+      vehicleType = type;
+      return true;
+    }
+  }
+  return false;
+}
+
+bool ParseRecord(string const & line, RouteRecord & record)
+{
+  istringstream stream(line);
+  double startLat, startLon, finishLat, finishLon;
+  string vehicleType;
+  if (!(stream >> startLat >> startLon >> finishLat >> finishLon >> vehicleType))
+    return false;
+
+  if (!ParseVehicleType(vehicleType, record.m_vehicleType))
+    return false;
+
+  record.m_start = MercatorBounds::FromLatLon(startLat, startLon);
+  record.m_finish = MercatorBounds::FromLatLon(finishLat, finishLon);
+  return true;
+}
+
+bool ReadRecords(string const & fileName, vector<RouteRecord> & records)
+{
+  ifstream stream(fileName);
+  if (!stream)
+  {
+    LOG(LERROR, ("Can't open", fileName));
+    return false;
+  }
+
+  string line;
+  size_t lineNumber = 0;
+  while (getline(stream, line))
+  {
+    ++lineNumber;
+    strings::Trim(line);
+    if (line.empty() || line[0] == '#')
+      continue;
+
+    RouteRecord record;
+    if (!ParseRecord(line, record))
+    {
+      LOG(LERROR, ("Malformed line", lineNumber, ":", line));
+      return false;
+    }
+    records.push_back(record);
+  }
+  return true;
+}
+
+// Returns peak resident set size of the process in kilobytes.
+uint64_t GetPeakRssKb()
+{
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0)
+    return 0;
+#if defined(OMIM_OS_MAC)
+  // ru_maxrss is in bytes on Mac.
+  return static_cast<uint64_t>(usage.ru_maxrss) / 1024;
+#else
+  return static_cast<uint64_t>(usage.ru_maxrss);
+#endif
+}
+
+IndexRouter & GetRouter(VehicleType vehicleType)
+{
+  static array<shared_ptr<integration::VehicleRouterComponents>,
+               static_cast<size_t>(VehicleType::Count)>
+      components;
+  auto & vehicleComponents = components[static_cast<size_t>(vehicleType)];
+  if (!vehicleComponents)
+  {
+    my::Timer timer;
+    vehicleComponents = integration::CreateAllMapsComponents(vehicleType);
+    LOG(LINFO, ("Router for", vehicleType, "created in", timer.ElapsedSeconds(), "seconds"));
+  }
+  return vehicleComponents->GetIndexRouter();
+}
+
+RouteResult CalculateRoute(RouteRecord const & record)
+{
+  IndexRouter & router = GetRouter(record.m_vehicleType);
+  RouteResult best;
+  for (uint64_t i = 0; i < FLAGS_repeat; ++i)
+  {
+    RouterDelegate delegate;
+    Route route(router.GetName());
+    router.ClearState();
+    // Repeats should measure the search, not the cache.
+    router.ClearSubrouteCache();
+
+    my::Timer timer;
+    RouteResult result;
+    result.m_code = router.CalculateRoute(Checkpoints(record.m_start, record.m_finish),
+                                          m2::PointD::Zero() /* startDirection */,
+                                          false /* adjustToPrevRoute */, delegate, route);
+    result.m_totalSec = timer.ElapsedSeconds();
+    result.m_stats = router.GetLastStats();
+    if (result.m_code == IRouter::NoError)
+      result.m_distanceM = route.GetTotalDistanceMeters();
+
+    if (i == 0 || result.m_totalSec < best.m_totalSec)
+      best = result;
+  }
+  return best;
+}
+
+void WriteHeader(ostream & output)
+{
+  output << "route,vehicle,result,distance_m,total_s,snapping_s,graph_loading_s,search_s,"
+            "settled_vertices,redress_s,reconstruction_s,peak_graphs_memory_b,peak_rss_kb\n";
+}
+
+void WriteResult(size_t routeIdx, RouteRecord const & record, RouteResult const & result,
+                 ostream & output)
+{
+  auto const & stats = result.m_stats;
+  output << routeIdx << ',' << ToString(record.m_vehicleType) << ','
+         << static_cast<int>(result.m_code) << ',' << result.m_distanceM << ','
+         << result.m_totalSec << ',' << stats.m_snappingSec << ',' << stats.m_graphLoadingSec << ','
+         << stats.m_searchSec << ',' << stats.m_settledVertices << ',' << stats.m_redressSec << ','
+         << stats.m_reconstructionSec << ',' << stats.m_peakGraphsMemory << ',' << GetPeakRssKb()
+         << '\n';
+}
+}  // namespace
+
+int main(int argc, char ** argv)
+{
+  google::SetUsageMessage("Replays routes through IndexRouter and reports timings of the routing "
+                          "phases.");
+  google::ParseCommandLineFlags(&argc, &argv, true);
+
+  g_options.m_dataPath = FLAGS_data_path.c_str();
+  g_options.m_resourcePath = FLAGS_user_resource_path.c_str();
+  if (FLAGS_input_file.empty() || FLAGS_repeat == 0)
+  {
+    google::ShowUsageWithFlagsRestrict(argv[0], "routing_replay_benchmark");
+    return 1;
+  }
+
+  vector<RouteRecord> records;
+  if (!ReadRecords(FLAGS_input_file, records))
+    return 1;
+
+  ofstream csv;
+  if (!FLAGS_csv_file.empty())
+  {
+    csv.open(FLAGS_csv_file);
+    if (!csv)
+    {
+      LOG(LERROR, ("Can't open", FLAGS_csv_file));
+      return 1;
+    }
+  }
+  ostream & output = FLAGS_csv_file.empty() ? cout : csv;
+  output << fixed << setprecision(6);
+  WriteHeader(output);
+
+  size_t routesFound = 0;
+  double totalSec = 0.0;
+  for (size_t i = 0; i < records.size(); ++i)
+  {
+    RouteResult const result = CalculateRoute(records[i]);
+    WriteResult(i, records[i], result, output);
+    totalSec += result.m_totalSec;
+    if (result.m_code == IRouter::NoError)
+      ++routesFound;
+  }
+
+  LOG(LINFO, ("Routes:", records.size(), "found:", routesFound, "total time:", totalSec,
+              "seconds, routes per second:", totalSec > 0.0 ? records.size() / totalSec : 0.0,
+              "peak RSS:", GetPeakRssKb(), "KB"));
+  return 0;
+}
@@ -0,0 +1,29 @@
+# This subproject implements a benchmark which replays a set of routes.
+# It's launched on the whole world dataset.
+
+TARGET = routing_replay_benchmark
+CONFIG += console warn_on
+CONFIG -= app_bundle
+TEMPLATE = app
+
+ROOT_DIR = ../..
+DEPENDENCIES = map routing traffic routing_common search storage indexer platform editor geometry coding base osrm \
+               jansson protobuf succinct stats_client gflags pugixml icu agg
+
+include($$ROOT_DIR/common.pri)
+
+QT *= core
+
+macx-* {
+  QT *= gui widgets # needed for QApplication with event loop, to test async events (downloader, etc.)
+  LIBS *= "-framework IOKit" "-framework QuartzCore" "-framework Cocoa" "-framework SystemConfiguration"
+}
+win32*|linux* {
+  QT *= network
+}
+
+INCLUDEPATH *= $$ROOT_DIR/3party/gflags/src
+
+SOURCES += \
+  ../routing_integration_tests/routing_test_tools.cpp \
+  routing_replay_benchmark.cpp \
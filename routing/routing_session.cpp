@@ -202,6 +202,8 @@ void RoutingSession::ResetImpl()
   m_lastWarnedSpeedCameraIndex = 0;
   m_lastCheckedSpeedCameraIndex = 0;
   m_lastFoundCamera = SpeedCameraRestriction();
+  m_routeCamerasSearched = false;
+  m_routeCameras.clear();
   m_speedWarningSignal = false;
   m_isFollowing = false;
   m_lastCompletionPercent = 0;
@@ -463,6 +465,8 @@ void RoutingSession::AssignRoute(Route & route, IRouter::ResultCode e)
   m_lastWarnedSpeedCameraIndex = 0;
   m_lastCheckedSpeedCameraIndex = 0;
   m_lastFoundCamera = SpeedCameraRestriction();
+  m_routeCamerasSearched = false;
+  m_routeCameras.clear();
 }
 
 void RoutingSession::SetRouter(unique_ptr<IRouter> && router,
@@ -598,6 +602,31 @@ double RoutingSession::GetDistanceToCurrentCamM(SpeedCameraRestriction & camera,
 
   auto const & m_poly = m_route->GetFollowedPolyline();
   auto const & currentIter = m_poly.GetCurrentIter();
+
+  // Cameras of the whole route are found once by speed camera sections of mwms.
+  if (!m_routeCamerasSearched)
+  {
+    m_routeCamerasSearched = true;
+    m_hasRouteCameras =
+        FindSpeedCamerasOnRoute(m_poly.GetPolyline().GetPoints(), index, m_routeCameras);
+  }
+
+  if (m_hasRouteCameras)
+  {
+    auto const it = upper_bound(m_routeCameras.cbegin(), m_routeCameras.cend(), currentIter.m_ind,
+                                [](size_t index, SpeedCameraRestriction const & camera) {
+                                  return index < camera.m_index;
+                                });
+    if (it == m_routeCameras.cend() ||
+        it->m_index >= currentIter.m_ind + kSpeedCameraLookAheadCount)
+    {
+      return kInvalidSpeedCameraDistance;
+    }
+
+    camera = *it;
+    return m_poly.GetDistanceM(currentIter, m_poly.GetIterToIndex(camera.m_index));
+  }
+
   if (currentIter.m_ind < m_lastFoundCamera.m_index &&
       m_lastFoundCamera.m_index < m_poly.GetPolyline().GetSize())
   {
@@ -658,7 +687,6 @@ bool RoutingSession::GetRouteAltitudesAndDistancesM(vector<double> & routeSegDis
     return false;
 
   routeSegDistanceM = m_route->GetSegDistanceMeters();
-  feature::TAltitudes altitudes;
   m_route->GetAltitudes(routeAltitudesM);
   return true;
 }
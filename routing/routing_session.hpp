@@ -3,6 +3,7 @@
 #include "routing/async_router.hpp"
 #include "routing/route.hpp"
 #include "routing/router.hpp"
+#include "routing/speed_camera.hpp"
 #include "routing/turns.hpp"
 #include "routing/turns_notification_manager.hpp"
 
@@ -31,15 +32,6 @@ class RouteMatchingInfo;
 
 namespace routing
 {
-struct SpeedCameraRestriction
-{
-  size_t m_index;  // Index of a polyline point where camera is located.
-  uint8_t m_maxSpeedKmH;  // Maximum speed allowed by the camera.
-
-  SpeedCameraRestriction(size_t index, uint8_t maxSpeed) : m_index(index), m_maxSpeedKmH(maxSpeed) {}
-  SpeedCameraRestriction() : m_index(0), m_maxSpeedKmH(numeric_limits<uint8_t>::max()) {}
-};
-
 class RoutingSession : public traffic::TrafficObserver, public traffic::TrafficCache
 {
   friend void UnitTest_TestFollowRoutePercentTest();
@@ -212,6 +204,11 @@ private:
   SpeedCameraRestriction m_lastFoundCamera;
   // Index of a last point on a route checked for a speed camera.
   size_t m_lastCheckedSpeedCameraIndex;
+  // Cameras of the route are searched once after the route is set. When some mwm of
+  // the route has no speed camera section, cameras are checked point by point instead.
+  bool m_routeCamerasSearched = false;
+  bool m_hasRouteCameras = false;
+  vector<SpeedCameraRestriction> m_routeCameras;
 
   // TODO (ldragunov) Rewrite UI interop to message queue and avoid mutable.
   /// This field is mutable because it's modified in a constant getter. Note that the notification
@@ -261,4 +261,46 @@ UNIT_CLASS_TEST(ApplyingTrafficTest, XXGraph_ChangingTraffic)
     TestRouteGeometry(starter, AStarAlgorithm<IndexGraphStarter>::Result::OK, noTrafficGeom);
   }
 }
+
+// Speed groups looked up in the stash after the coloring is replaced.
+UNIT_CLASS_TEST(ApplyingTrafficTest, TrafficStash_SpeedGroups)
+{
+  TrafficInfo::Coloring const coloring = {
+      {{3 /* feature id */, 0 /* segment id */, TrafficInfo::RoadSegmentId::kForwardDirection},
+       SpeedGroup::G0},
+      {{3 /* feature id */, 0 /* segment id */, TrafficInfo::RoadSegmentId::kReverseDirection},
+       SpeedGroup::G2},
+      {{3 /* feature id */, 1 /* segment id */, TrafficInfo::RoadSegmentId::kForwardDirection},
+       SpeedGroup::G4},
+      {{70000 /* feature id */, 300 /* segment id */,
+        TrafficInfo::RoadSegmentId::kReverseDirection},
+       SpeedGroup::TempBlock}};
+  SetTrafficColoring(make_shared<TrafficInfo::Coloring>(coloring));
+
+  auto const & stash = *GetTrafficStash();
+  TEST(stash.Has(kTestNumMwmId), ());
+  TEST_EQUAL(stash.GetSpeedGroup(Segment(kTestNumMwmId, 3, 0, true /* forward */)), SpeedGroup::G0,
+             ());
+  TEST_EQUAL(stash.GetSpeedGroup(Segment(kTestNumMwmId, 3, 0, false /* forward */)),
+             SpeedGroup::G2, ());
+  TEST_EQUAL(stash.GetSpeedGroup(Segment(kTestNumMwmId, 3, 1, true /* forward */)), SpeedGroup::G4,
+             ());
+  TEST_EQUAL(stash.GetSpeedGroup(Segment(kTestNumMwmId, 70000, 300, false /* forward */)),
+             SpeedGroup::TempBlock, ());
+  TEST_EQUAL(stash.GetSpeedGroup(Segment(kTestNumMwmId, 3, 1, false /* forward */)),
+             SpeedGroup::Unknown, ());
+  TEST_EQUAL(stash.GetSpeedGroup(Segment(kTestNumMwmId, 4, 0, true /* forward */)),
+             SpeedGroup::Unknown, ());
+  TEST_EQUAL(stash.GetSpeedGroup(Segment(kTestNumMwmId + 1, 3, 0, true /* forward */)),
+             SpeedGroup::Unknown, ());
+
+  TrafficInfo::Coloring const newColoring = {
+      {{3 /* feature id */, 1 /* segment id */, TrafficInfo::RoadSegmentId::kForwardDirection},
+       SpeedGroup::G1}};
+  SetTrafficColoring(make_shared<TrafficInfo::Coloring>(newColoring));
+  TEST_EQUAL(stash.GetSpeedGroup(Segment(kTestNumMwmId, 3, 0, true /* forward */)),
+             SpeedGroup::Unknown, ());
+  TEST_EQUAL(stash.GetSpeedGroup(Segment(kTestNumMwmId, 3, 1, true /* forward */)), SpeedGroup::G1,
+             ());
+}
 }  // namespace
@@ -73,6 +73,13 @@ void TestAStar(UndirectedGraph & graph, vector<unsigned> const & expectedRoute,
   TEST_EQUAL(TAlgorithm::Result::OK, algo.FindPathBidirectional(graph, 0u, 4u, actualRoute), ());
   TEST_EQUAL(expectedRoute, actualRoute.path, ());
   TEST_ALMOST_EQUAL_ULPS(expectedDistance, actualRoute.distance, ());
+
+  actualRoute.path.clear();
+  UndirectedGraph backwardGraph = graph;
+  TEST_EQUAL(TAlgorithm::Result::OK,
+             algo.FindPathBidirectionalParallel(graph, backwardGraph, 0u, 4u, actualRoute), ());
+  TEST_EQUAL(expectedRoute, actualRoute.path, ());
+  TEST_ALMOST_EQUAL_ULPS(expectedDistance, actualRoute.distance, ());
 }
 
 UNIT_TEST(AStarAlgorithm_Sample)
@@ -91,6 +98,141 @@ UNIT_TEST(AStarAlgorithm_Sample)
   TestAStar(graph, expectedRoute, 23);
 }
 
+UNIT_TEST(AStarAlgorithm_ReusedContext)
+{
+  UndirectedGraph graph;
+
+  // The number of vertices is greater than the initial capacity of the context tables.
+  unsigned constexpr kNumVertices = 3000;
+  for (unsigned i = 0; i + 1 < kNumVertices; ++i)
+    graph.AddEdge(i /* from */, i + 1 /* to */, 1 /* weight */);
+  graph.AddEdge(0 /* from */, kNumVertices - 1 /* to */, 10 /* weight */);
+
+  TAlgorithm algo;
+  TAlgorithm::BidirectionalContext context;
+  RoutingResult<unsigned /* VertexType */, double /* WeightType */> actualRoute;
+
+  TEST_EQUAL(TAlgorithm::Result::OK,
+             algo.FindPathBidirectional(context, graph, 0u, 100u, actualRoute), ());
+  TEST_EQUAL(actualRoute.path.size(), 101, ());
+  TEST_ALMOST_EQUAL_ULPS(actualRoute.distance, 100.0, ());
+
+  TEST_EQUAL(TAlgorithm::Result::OK,
+             algo.FindPathBidirectional(context, graph, 5u, kNumVertices - 2, actualRoute), ());
+  vector<unsigned> const expectedRoute = {5, 4, 3, 2, 1, 0, kNumVertices - 1, kNumVertices - 2};
+  TEST_EQUAL(actualRoute.path, expectedRoute, ());
+  TEST_ALMOST_EQUAL_ULPS(actualRoute.distance, 16.0, ());
+}
+
+UNIT_TEST(AStarAlgorithm_Parallel)
+{
+  // Grid kSize x kSize with different weights of rows and columns.
+  unsigned constexpr kSize = 30;
+  UndirectedGraph graph;
+  for (unsigned i = 0; i < kSize; ++i)
+  {
+    for (unsigned j = 0; j < kSize; ++j)
+    {
+      unsigned const v = i * kSize + j;
+      if (j + 1 < kSize)
+        graph.AddEdge(v, v + 1, 1 + (i * 7 + j * 3) % 5 /* weight */);
+      if (i + 1 < kSize)
+        graph.AddEdge(v, v + kSize, 1 + (i * 5 + j * 11) % 7 /* weight */);
+    }
+  }
+  UndirectedGraph backwardGraph = graph;
+
+  TAlgorithm algo;
+  for (unsigned start = 0; start < kSize * kSize; start += 97)
+  {
+    for (unsigned finish = 0; finish < kSize * kSize; finish += 89)
+    {
+      if (start == finish)
+        continue;
+
+      RoutingResult<unsigned /* VertexType */, double /* WeightType */> expected;
+      TEST_EQUAL(TAlgorithm::Result::OK, algo.FindPath(graph, start, finish, expected), ());
+
+      RoutingResult<unsigned /* VertexType */, double /* WeightType */> actual;
+      TEST_EQUAL(TAlgorithm::Result::OK,
+                 algo.FindPathBidirectionalParallel(graph, backwardGraph, start, finish, actual),
+                 ());
+      TEST_ALMOST_EQUAL_ULPS(expected.distance, actual.distance, (start, finish));
+      TEST_EQUAL(actual.path.front(), start, ());
+      TEST_EQUAL(actual.path.back(), finish, ());
+    }
+  }
+
+  RoutingResult<unsigned /* VertexType */, double /* WeightType */> noPath;
+  TEST_EQUAL(TAlgorithm::Result::NoPath,
+             algo.FindPathBidirectionalParallel(graph, backwardGraph, 0u, kSize * kSize, noPath),
+             ());
+}
+
+// Adds a chain of |numEdges| edges with |weight| from |from| to |to|. Ids of the inner vertices
+// of the chain start from |firstId|. Returns all the vertices of the chain.
+vector<unsigned> AddChain(UndirectedGraph & graph, unsigned from, unsigned to, unsigned firstId,
+                          unsigned numEdges, unsigned weight)
+{
+  vector<unsigned> chain = {from};
+  for (unsigned i = 0; i + 1 < numEdges; ++i)
+    chain.push_back(firstId + i);
+  chain.push_back(to);
+
+  for (size_t i = 0; i + 1 < chain.size(); ++i)
+    graph.AddEdge(chain[i], chain[i + 1], weight);
+  return chain;
+}
+
+UNIT_TEST(AStarAlgorithm_Alternatives)
+{
+  UndirectedGraph graph;
+  vector<unsigned> const best =
+      AddChain(graph, 0 /* from */, 1 /* to */, 100 /* firstId */, 100 /* numEdges */, 2 /* weight */);
+  // The bypass of the part of the best path. It's the shortest alternative but it mostly
+  // coincides with the best path.
+  vector<unsigned> const bypass = AddChain(graph, best[40], best[55], 1000 /* firstId */,
+                                           16 /* numEdges */, 2 /* weight */);
+  vector<unsigned> const alternative =
+      AddChain(graph, 0 /* from */, 1 /* to */, 2000 /* firstId */, 52 /* numEdges */, 4 /* weight */);
+  // Too long alternative.
+  AddChain(graph, 0 /* from */, 1 /* to */, 3000 /* firstId */, 100 /* numEdges */, 5 /* weight */);
+
+  TAlgorithm algo;
+  TAlgorithm::BidirectionalContext context;
+  TAlgorithm::AlternativesParams params;
+  RoutingResult<unsigned /* VertexType */, double /* WeightType */> result;
+  vector<RoutingResult<unsigned /* VertexType */, double /* WeightType */>> alternatives;
+
+  TEST_EQUAL(TAlgorithm::Result::OK,
+             algo.FindPathWithAlternatives(context, graph, 0u, 1u, params, result, alternatives),
+             ());
+  TEST_EQUAL(result.path, best, ());
+  TEST_ALMOST_EQUAL_ULPS(result.distance, 200.0, ());
+  TEST_EQUAL(alternatives.size(), 1, ());
+  TEST_EQUAL(alternatives[0].path, alternative, ());
+  TEST_ALMOST_EQUAL_ULPS(alternatives[0].distance, 208.0, ());
+
+  // The bypass is found if more sharing is allowed.
+  params.m_maxSharing = 0.9;
+  TEST_EQUAL(TAlgorithm::Result::OK,
+             algo.FindPathWithAlternatives(context, graph, 0u, 1u, params, result, alternatives),
+             ());
+  TEST_EQUAL(alternatives.size(), 2, ());
+  vector<unsigned> expectedBypass(best.begin(), best.begin() + 40);
+  expectedBypass.insert(expectedBypass.end(), bypass.begin(), bypass.end());
+  expectedBypass.insert(expectedBypass.end(), best.begin() + 56, best.end());
+  TEST_EQUAL(alternatives[0].path, expectedBypass, ());
+  TEST_ALMOST_EQUAL_ULPS(alternatives[0].distance, 202.0, ());
+  TEST_EQUAL(alternatives[1].path, alternative, ());
+
+  // The best path is the same as the one of FindPathBidirectional().
+  RoutingResult<unsigned /* VertexType */, double /* WeightType */> expected;
+  TEST_EQUAL(TAlgorithm::Result::OK,
+             algo.FindPathBidirectional(context, graph, 0u, 1u, expected), ());
+  TEST_EQUAL(result.path, expected.path, ());
+}
+
 UNIT_TEST(AdjustRoute)
 {
   UndirectedGraph graph;
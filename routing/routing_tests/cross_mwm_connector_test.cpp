@@ -1,5 +1,6 @@
 #include "testing/testing.hpp"
 
+#include "routing/cross_mwm_connector_cache.hpp"
 #include "routing/cross_mwm_connector_serialization.hpp"
 
 #include "coding/writer.hpp"
@@ -322,4 +323,44 @@ UNIT_TEST(WeightsSerialization)
     TestEdges(connector, enter, true /* isOutgoing */, expectedEdges);
   }
 }
+
+UNIT_TEST(CrossMwmConnectorCache_Lru)
+{
+  CrossMwmConnectorCache cache(2 /* maxSize */);
+  CrossMwmConnectorCache::Key const key0("Country0", 0 /* mwmId */, 170101 /* version */,
+                                         VehicleType::Car);
+  CrossMwmConnectorCache::Key const key1("Country1", 1 /* mwmId */, 170101 /* version */,
+                                         VehicleType::Car);
+  CrossMwmConnectorCache::Key const key2("Country2", 2 /* mwmId */, 170101 /* version */,
+                                         VehicleType::Car);
+  // The same mwm of another version.
+  CrossMwmConnectorCache::Key const key0Updated("Country0", 0 /* mwmId */, 170202 /* version */,
+                                                VehicleType::Car);
+
+  TEST(!cache.Get(key0), ());
+  auto const connector0 = make_shared<CrossMwmConnector>(0 /* mwmId */);
+  cache.Put(key0, connector0);
+  cache.Put(key1, make_shared<CrossMwmConnector>(1 /* mwmId */));
+  TEST_EQUAL(cache.Get(key0), connector0, ());
+  TEST(!cache.Get(key0Updated), ());
+
+  // |key1| is the least recently used one.
+  cache.Put(key2, make_shared<CrossMwmConnector>(2 /* mwmId */));
+  TEST_EQUAL(cache.GetSize(), 2, ());
+  TEST(!cache.Get(key1), ());
+  TEST(cache.Get(key2), ());
+
+  auto const replaced = make_shared<CrossMwmConnector>(0 /* mwmId */);
+  cache.Put(key0, replaced);
+  TEST_EQUAL(cache.Get(key0), replaced, ());
+  TEST_EQUAL(cache.GetSize(), 2, ());
+
+  auto const stats = cache.GetStats();
+  TEST_EQUAL(stats.m_hits, 3, ());
+  TEST_EQUAL(stats.m_misses, 3, ());
+
+  cache.Clear();
+  TEST_EQUAL(cache.GetSize(), 0, ());
+  TEST_EQUAL(cache.GetStats().m_hits, 0, ());
+}
 }  // namespace routing_test
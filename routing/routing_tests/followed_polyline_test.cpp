@@ -4,6 +4,8 @@
 
 #include "geometry/polyline2d.hpp"
 
+#include <vector>
+
 namespace routing_test
 {
 using namespace routing;
@@ -142,4 +144,31 @@ UNIT_TEST(FollowedPolylineGetDistanceFromBeginM)
       MercatorBounds::DistanceOnEarth(kTestDirectedPolyline1.Front(), point);
   TEST_ALMOST_EQUAL_ULPS(distance, masterDistance, ());
 }
+UNIT_TEST(FollowedPolylineLongRouteJumpTest)
+{
+  // A zigzag route with many segments, so the projection is searched by blocks of segments.
+  std::vector<m2::PointD> points;
+  for (size_t i = 0; i <= 1000; ++i)
+    points.emplace_back(0.001 * i, i % 2 == 0 ? 0.0 : 0.001);
+  FollowedPolyline polyline(points.begin(), points.end());
+
+  // Jump far ahead, e.g. after a tunnel.
+  m2::PointD const jumpPos(0.7005, 0.0005);
+  polyline.UpdateProjection(MercatorBounds::RectByCenterXYAndSizeInMeters(jumpPos, 20));
+  TEST_EQUAL(polyline.GetCurrentIter().m_ind, 700, ());
+  TEST_LESS_OR_EQUAL(MercatorBounds::DistanceOnEarth(polyline.GetCurrentIter().m_pt, jumpPos),
+                     1.0, ());
+
+  // A position far from the route isn't matched.
+  auto const iter = polyline.UpdateProjection(
+      MercatorBounds::RectByCenterXYAndSizeInMeters({0.5, 0.1}, 20));
+  TEST(!iter.IsValid(), ());
+  TEST_EQUAL(polyline.GetCurrentIter().m_ind, 700, ());
+
+  // Route points at the block borders are matched.
+  polyline.UpdateProjection(MercatorBounds::RectByCenterXYAndSizeInMeters(points[960], 2));
+  TEST_EQUAL(polyline.GetCurrentIter().m_ind, 959, ());
+  TEST(m2::AlmostEqualAbs(polyline.GetCurrentIter().m_pt, points[960], 1e-9),
+       (polyline.GetCurrentIter().m_pt));
+}
 }  // namespace routing_test
@@ -0,0 +1,61 @@
+#include "testing/testing.hpp"
+
+#include "routing/index_graph_loader.hpp"
+#include "routing/num_mwm_id.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+using namespace routing;
+using namespace std;
+
+namespace
+{
+IndexGraphUsage MakeUsage(NumMwmId mwmId, uint64_t lastAccess, size_t memorySize)
+{
+  IndexGraphUsage usage;
+  usage.m_mwmId = mwmId;
+  usage.m_lastAccess = lastAccess;
+  usage.m_memorySize = memorySize;
+  return usage;
+}
+
+vector<NumMwmId> Choose(vector<IndexGraphUsage> const & usages, size_t maxMemorySize,
+                        size_t minResidentGraphs)
+{
+  auto result = ChooseGraphsToUnload(usages, maxMemorySize, minResidentGraphs);
+  sort(result.begin(), result.end());
+  return result;
+}
+
+UNIT_TEST(ChooseGraphsToUnload_FitsLimit)
+{
+  vector<IndexGraphUsage> const usages = {MakeUsage(0, 1, 10), MakeUsage(1, 2, 10),
+                                          MakeUsage(2, 3, 10)};
+  TEST(Choose(usages, 30, 1).empty(), ());
+  TEST(Choose(usages, 100, 0).empty(), ());
+}
+
+UNIT_TEST(ChooseGraphsToUnload_LeastRecentlyUsed)
+{
+  vector<IndexGraphUsage> const usages = {MakeUsage(0, 5, 10), MakeUsage(1, 1, 10),
+                                          MakeUsage(2, 7, 10), MakeUsage(3, 3, 10)};
+  // Graphs 2 and 0 are the most recent ones and fit the limit.
+  TEST_EQUAL(Choose(usages, 20, 1), vector<NumMwmId>({1, 3}), ());
+  TEST_EQUAL(Choose(usages, 25, 1), vector<NumMwmId>({1, 3}), ());
+  TEST_EQUAL(Choose(usages, 30, 1), vector<NumMwmId>({1}), ());
+}
+
+UNIT_TEST(ChooseGraphsToUnload_MinResidentGraphs)
+{
+  vector<IndexGraphUsage> const usages = {MakeUsage(0, 5, 100), MakeUsage(1, 1, 10),
+                                          MakeUsage(2, 7, 100), MakeUsage(3, 3, 10)};
+  // The most recent graphs are kept even if they exceed the limit.
+  TEST_EQUAL(Choose(usages, 50, 2), vector<NumMwmId>({1, 3}), ());
+  TEST_EQUAL(Choose(usages, 50, 3), vector<NumMwmId>({1}), ());
+  TEST(Choose(usages, 50, 4).empty(), ());
+  TEST_EQUAL(Choose(usages, 50, 0), vector<NumMwmId>({0, 1, 2, 3}), ());
+}
+}  // namespace
@@ -6,6 +6,11 @@
 #include "routing/index_graph_serialization.hpp"
 #include "routing/index_graph_starter.hpp"
 #include "routing/index_router.hpp"
+#include "routing/landmark_index.hpp"
+#include "routing/landmark_serialization.hpp"
+#include "routing/shortcut_index.hpp"
+#include "routing/shortcut_serialization.hpp"
+#include "routing/speed_profiles.hpp"
 #include "routing/vehicle_mask.hpp"
 
 #include "routing/routing_tests/index_graph_tools.hpp"
@@ -232,6 +237,280 @@ UNIT_TEST(FindPathCross)
   }
 }
 
+// Routes built with shortcut edges should be the same as the routes built without them.
+//
+//                 R1
+//                 |
+//    R0  *--*--*--*--*--*--*
+//                 |
+//                 *
+//                 |
+UNIT_TEST(FindPathShortcuts)
+{
+  unique_ptr<TestGeometryLoader> loader = make_unique<TestGeometryLoader>();
+  loader->AddRoad(0 /* featureId */, false, 1.0 /* speed */,
+                  RoadGeometry::Points({{-3.0, 0.0}, {-2.0, 0.0}, {-1.0, 0.0}, {0.0, 0.0},
+                                        {1.0, 0.0}, {2.0, 0.0}, {3.0, 0.0}}));
+  loader->AddRoad(1 /* featureId */, false, 1.0 /* speed */,
+                  RoadGeometry::Points({{0.0, -2.0}, {0.0, -1.0}, {0.0, 0.0}, {0.0, 1.0}}));
+
+  traffic::TrafficCache const trafficCache;
+  shared_ptr<EdgeEstimator> estimator = CreateEstimatorForCar(trafficCache);
+  unique_ptr<WorldGraph> worldGraph =
+      BuildWorldGraph(move(loader), estimator, {MakeJoint({{0, 3}, {1, 2}})});
+
+  IndexGraph & indexGraph = worldGraph->GetIndexGraph(kTestNumMwmId);
+  ShortcutIndex shortcuts;
+  BuildShortcutIndex(indexGraph, *estimator, shortcuts);
+  TEST_EQUAL(shortcuts.GetNumFeatures(), 2, ());
+
+  double weight = 0.0;
+  TEST(shortcuts.GetWeight(0 /* featureId */, 3 /* fromPointId */, 6 /* toPointId */, weight), ());
+  TEST(!shortcuts.GetWeight(0 /* featureId */, 3 /* fromPointId */, 5 /* toPointId */, weight), ());
+  TEST(!shortcuts.GetWeight(1 /* featureId */, 2 /* fromPointId */, 3 /* toPointId */, weight), ());
+
+  vector<uint8_t> buffer;
+  {
+    MemWriter<vector<uint8_t>> writer(buffer);
+    ShortcutSerializer::Serialize(shortcuts, writer);
+  }
+  {
+    ShortcutIndex deserialized;
+    MemReader reader(buffer.data(), buffer.size());
+    ReaderSource<MemReader> source(reader);
+    ShortcutSerializer::Deserialize(source, deserialized);
+    TEST_EQUAL(deserialized.GetNumFeatures(), shortcuts.GetNumFeatures(), ());
+  }
+
+  indexGraph.SetShortcuts(move(shortcuts));
+
+  vector<IndexGraphStarter::FakeEnding> endPoints;
+  for (uint32_t i = 0; i < 6; ++i)
+  {
+    endPoints.push_back(IndexGraphStarter::MakeFakeEnding(
+        Segment(kTestNumMwmId, 0, i, true /*forward*/), m2::PointD(-2.5 + i, 0.0), *worldGraph));
+  }
+  for (uint32_t i = 0; i < 3; ++i)
+  {
+    endPoints.push_back(IndexGraphStarter::MakeFakeEnding(
+        Segment(kTestNumMwmId, 1, i, true /*forward*/), m2::PointD(0.0, -1.5 + i), *worldGraph));
+  }
+
+  for (auto const & start : endPoints)
+  {
+    for (auto const & finish : endPoints)
+    {
+      IndexGraphStarter starter(start, finish, 0 /* fakeNumerationStart */,
+                                false /* strictForward */, *worldGraph);
+      vector<Segment> expectedRoute;
+      double expectedTimeSec = 0.0;
+      TEST_EQUAL(CalculateRoute(starter, expectedRoute, expectedTimeSec),
+                 AStarAlgorithm<IndexGraphStarter>::Result::OK, ());
+
+      vector<Segment> route;
+      double timeSec = 0.0;
+      starter.EnableShortcuts();
+      TEST_EQUAL(CalculateRoute(starter, route, timeSec),
+                 AStarAlgorithm<IndexGraphStarter>::Result::OK, ());
+      starter.DisableShortcuts();
+      starter.UnpackShortcuts(route);
+
+      TEST_EQUAL(route, expectedRoute, ());
+      TEST(my::AlmostEqualAbs(timeSec, expectedTimeSec, 1e-7), (timeSec, expectedTimeSec));
+    }
+  }
+}
+
+// Routes built with the landmark heuristic should have the same weights as the routes built
+// with the straight line one. R0 is one way (left to right), the other roads are two way.
+//
+// Roads   R3  R4  R5
+//
+//    R0   * > * > *
+//         |   |   |
+//    R1   * - * - *
+//         |   |   |
+//    R2   * - * - *
+//
+UNIT_TEST(FindPathLandmarks)
+{
+  uint32_t constexpr kCitySize = 3;
+  unique_ptr<TestGeometryLoader> loader = make_unique<TestGeometryLoader>();
+  for (uint32_t i = 0; i < kCitySize; ++i)
+  {
+    RoadGeometry::Points street;
+    RoadGeometry::Points avenue;
+    for (uint32_t j = 0; j < kCitySize; ++j)
+    {
+      street.emplace_back(static_cast<double>(j), static_cast<double>(i));
+      avenue.emplace_back(static_cast<double>(i), static_cast<double>(j));
+    }
+    loader->AddRoad(i, i == 0 /* oneWay */, 1.0 /* speed */, street);
+    loader->AddRoad(i + kCitySize, false /* oneWay */, 1.0 /* speed */, avenue);
+  }
+
+  vector<Joint> joints;
+  for (uint32_t i = 0; i < kCitySize; ++i)
+  {
+    for (uint32_t j = 0; j < kCitySize; ++j)
+      joints.emplace_back(MakeJoint({{i, j}, {j + kCitySize, i}}));
+  }
+
+  traffic::TrafficCache const trafficCache;
+  IndexGraph graph(move(loader), CreateEstimatorForCar(trafficCache));
+  graph.Import(joints);
+
+  LandmarkIndex landmarks;
+  BuildLandmarkIndex(graph, 4 /* numLandmarks */, landmarks);
+  TEST_EQUAL(landmarks.GetNumLandmarks(), 4, ());
+  TEST_EQUAL(landmarks.GetNumJoints(), graph.GetNumJoints(), ());
+
+  vector<uint8_t> buffer;
+  {
+    MemWriter<vector<uint8_t>> writer(buffer);
+    LandmarkSerializer::Serialize(landmarks, writer);
+  }
+  {
+    LandmarkIndex deserialized;
+    MemReader reader(buffer.data(), buffer.size());
+    ReaderSource<MemReader> source(reader);
+    LandmarkSerializer::Deserialize(source, deserialized);
+    TEST(deserialized == landmarks, ());
+  }
+
+  vector<Segment> segments;
+  for (uint32_t featureId = 0; featureId < 2 * kCitySize; ++featureId)
+  {
+    for (uint32_t segmentIdx = 0; segmentIdx < kCitySize - 1; ++segmentIdx)
+    {
+      segments.emplace_back(kTestNumMwmId, featureId, segmentIdx, true /* forward */);
+      if (featureId != 0)
+        segments.emplace_back(kTestNumMwmId, featureId, segmentIdx, false /* forward */);
+    }
+  }
+
+  using Algorithm = AStarAlgorithm<IndexGraph>;
+  Algorithm algorithm;
+  vector<double> expectedWeights;
+  for (auto const & start : segments)
+  {
+    for (auto const & finish : segments)
+    {
+      RoutingResult<Segment, RouteWeight> result;
+      TEST_EQUAL(algorithm.FindPath(graph, start, finish, result), Algorithm::Result::OK, ());
+      expectedWeights.push_back(result.distance.GetWeight());
+    }
+  }
+
+  graph.SetLandmarks(move(landmarks));
+  TEST(graph.HasLandmarks(), ());
+
+  size_t i = 0;
+  for (auto const & start : segments)
+  {
+    for (auto const & finish : segments)
+    {
+      double const expectedWeight = expectedWeights[i++];
+      double const heuristic = graph.HeuristicCostEstimate(start, finish).GetWeight();
+      TEST_LESS_OR_EQUAL(heuristic, expectedWeight + 1e-7, (start, finish));
+
+      RoutingResult<Segment, RouteWeight> result;
+      TEST_EQUAL(algorithm.FindPath(graph, start, finish, result), Algorithm::Result::OK, ());
+      TEST(my::AlmostEqualAbs(result.distance.GetWeight(), expectedWeight, 1e-7),
+           (start, finish, result.distance, expectedWeight));
+
+      if (start == finish)
+        continue;
+
+      result.Clear();
+      TEST_EQUAL(algorithm.FindPathBidirectional(graph, start, finish, result),
+                 Algorithm::Result::OK, ());
+      TEST(my::AlmostEqualAbs(result.distance.GetWeight(), expectedWeight, 1e-7),
+           (start, finish, result.distance, expectedWeight));
+    }
+  }
+}
+
+// R0 is congested from 7:00 up to 10:00, the detour R1 is free.
+//
+//              R1 * - - * - - * - - *
+//                 |                 |
+// R2 * - - - - - J0 - - * - - * - - J1 - - - - - * R3
+//                         R0
+//
+// x: -0.001       0               0.003        0.004
+//
+UNIT_TEST(FindPathTimeDependent)
+{
+  unique_ptr<TestGeometryLoader> loader = make_unique<TestGeometryLoader>();
+  loader->AddRoad(0 /* featureId */, true /* oneWay */, 1.0 /* speed */,
+                  RoadGeometry::Points({{0.0, 0.0}, {0.001, 0.0}, {0.002, 0.0}, {0.003, 0.0}}));
+  loader->AddRoad(1 /* featureId */, true /* oneWay */, 1.0 /* speed */,
+                  RoadGeometry::Points({{0.0, 0.0},
+                                        {0.0, 0.001},
+                                        {0.001, 0.001},
+                                        {0.002, 0.001},
+                                        {0.003, 0.001},
+                                        {0.003, 0.0}}));
+  loader->AddRoad(2 /* featureId */, true /* oneWay */, 1.0 /* speed */,
+                  RoadGeometry::Points({{-0.001, 0.0}, {0.0, 0.0}}));
+  loader->AddRoad(3 /* featureId */, true /* oneWay */, 1.0 /* speed */,
+                  RoadGeometry::Points({{0.003, 0.0}, {0.004, 0.0}}));
+
+  traffic::TrafficCache const trafficCache;
+  IndexGraph graph(move(loader), CreateEstimatorForCar(trafficCache));
+  graph.Import({MakeJoint({{2, 1}, {0, 0}, {1, 0}}), MakeJoint({{0, 3}, {1, 5}, {3, 0}})});
+
+  SpeedProfiles::Profile profile;
+  profile.fill(SpeedProfiles::kMaxFactor);
+  for (size_t i = 7 * 4; i < 10 * 4; ++i)
+    profile[i] = 20;
+
+  SpeedProfiles speedProfiles;
+  uint32_t const profileIdx = speedProfiles.AddProfile(profile);
+  for (uint32_t segmentIdx = 0; segmentIdx < 3; ++segmentIdx)
+    speedProfiles.SetSegmentProfile(Segment(kTestNumMwmId, 0, segmentIdx, true), profileIdx);
+  graph.SetSpeedProfiles(move(speedProfiles));
+  TEST(graph.HasSpeedProfiles(), ());
+
+  Segment const start(kTestNumMwmId, 2, 0, true /* forward */);
+  Segment const finish(kTestNumMwmId, 3, 0, true /* forward */);
+
+  using Algorithm = AStarAlgorithm<IndexGraph>;
+  Algorithm algorithm;
+  auto const findPath = [&](RoutingResult<Segment, RouteWeight> & result) {
+    TEST_EQUAL(algorithm.FindPath(graph, start, finish, result), Algorithm::Result::OK, ());
+    return result.path.size() == 5 && result.path[1].GetFeatureId() == 0;
+  };
+
+  RoutingResult<Segment, RouteWeight> staticResult;
+  TEST(findPath(staticResult), ("The free flow route goes along R0."));
+
+  uint32_t constexpr kHour = 60 * 60;
+
+  // The rush hour.
+  graph.EnableTimeDependency(start, 8 * kHour);
+  RoutingResult<Segment, RouteWeight> rushHourResult;
+  TEST(!findPath(rushHourResult), ("The route should take the detour R1."));
+  TEST_EQUAL(rushHourResult.path.size(), 7, ());
+  TEST_EQUAL(rushHourResult.path[1].GetFeatureId(), 1, ());
+  TEST_GREATER(rushHourResult.distance, staticResult.distance, ());
+
+  // Midday, R0 is free.
+  graph.EnableTimeDependency(start, 12 * kHour);
+  RoutingResult<Segment, RouteWeight> middayResult;
+  TEST(findPath(middayResult), ());
+  TEST(my::AlmostEqualAbs(middayResult.distance.GetWeight(), staticResult.distance.GetWeight(),
+                          1e-7),
+       (middayResult.distance, staticResult.distance));
+
+  // The speeds do not depend on the time when the time dependency is disabled.
+  graph.DisableTimeDependency();
+  RoutingResult<Segment, RouteWeight> result;
+  TEST(findPath(result), ());
+  TEST_EQUAL(result.path, staticResult.path, ());
+}
+
 // Roads   R4  R5  R6  R7
 //
 //    R0   0 - * - * - *
@@ -46,6 +46,14 @@ IndexGraph & TestIndexGraphLoader::GetIndexGraph(NumMwmId mwmId)
 
 void TestIndexGraphLoader::Clear() { m_graphs.clear(); }
 
+size_t TestIndexGraphLoader::GetMemorySize() const
+{
+  size_t size = 0;
+  for (auto const & kv : m_graphs)
+    size += kv.second->GetIndexMemorySize() + kv.second->GetGeometry().GetMemorySize();
+  return size;
+}
+
 void TestIndexGraphLoader::AddGraph(NumMwmId mwmId, unique_ptr<IndexGraph> graph)
 {
   auto it = m_graphs.find(mwmId);
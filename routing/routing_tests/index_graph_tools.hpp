@@ -81,6 +81,11 @@ public:
   // IndexGraphLoader overrides:
   IndexGraph & GetIndexGraph(NumMwmId mwmId) override;
   virtual void Clear() override;
+  virtual double GetLoadingTimeSec() const override { return 0.0; }
+  virtual size_t GetMemorySize() const override;
+  virtual size_t GetPeakMemorySize() const override { return GetMemorySize(); }
+  // Test graphs are never unloaded.
+  virtual void SetMaxMemorySize(size_t /* maxMemorySize */) override {}
 
   void AddGraph(NumMwmId mwmId, unique_ptr<IndexGraph> graph);
 
@@ -3,6 +3,7 @@
 #include "routing/routing_tests/index_graph_tools.hpp"
 
 #include "routing/geometry.hpp"
+#include "routing/restriction_index.hpp"
 #include "routing/restriction_loader.hpp"
 
 #include "geometry/point2d.hpp"
@@ -896,4 +897,32 @@ UNIT_CLASS_TEST(RestrictionTest, FGraph_RestrictionF0F2Only)
                                                  m2::PointD(1, 1), *m_graph),
       move(restrictions), *this);
 }
+
+UNIT_TEST(RestrictionIndex_IsProhibited)
+{
+  RestrictionVec const restrictions = {
+      {Restriction::Type::No, {1 /* feature from */, 2 /* feature to */}},
+      {Restriction::Type::No, {1, 2}},
+      {Restriction::Type::No, {1, 7}},
+      {Restriction::Type::No, {5, 5}},
+      {Restriction::Type::No, {9, 3, 4}},
+      {Restriction::Type::Only, {3, 4}}};
+
+  RestrictionIndex index;
+  TEST(index.IsEmpty(), ());
+  TEST(!index.IsProhibited(1, 2), ());
+
+  index.Build(restrictions);
+  TEST(!index.IsEmpty(), ());
+  TEST(index.IsProhibited(1, 2), ());
+  TEST(index.IsProhibited(1, 7), ());
+  TEST(index.IsProhibited(5, 5), ());
+  TEST(!index.IsProhibited(2, 1), ());
+  TEST(!index.IsProhibited(1, 3), ());
+  TEST(!index.IsProhibited(0, 2), ());
+  TEST(!index.IsProhibited(100, 2), ());
+  // Restrictions of three features and of Type::Only are ignored.
+  TEST(!index.IsProhibited(9, 3), ());
+  TEST(!index.IsProhibited(3, 4), ());
+}
 }  // namespace routing_test
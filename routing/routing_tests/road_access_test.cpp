@@ -72,6 +72,31 @@ UNIT_TEST(RoadAccess_Serialization)
   }
 }
 
+UNIT_TEST(RoadAccess_GetSegmentType)
+{
+  RoadAccess roadAccess;
+  TEST_EQUAL(roadAccess.GetSegmentType(Segment(kFakeNumMwmId, 1, 0, true)), RoadAccess::Type::Yes,
+             ());
+
+  // Segment idx 0 is the wildcard of the entire feature, others are segment idx + 1.
+  map<Segment, RoadAccess::Type> const m = {
+      {Segment(kFakeNumMwmId, 1, 0, true), RoadAccess::Type::No},
+      {Segment(kFakeNumMwmId, 2, 3, false), RoadAccess::Type::Private},
+      {Segment(kFakeNumMwmId, 2, 4, true), RoadAccess::Type::Destination},
+  };
+  roadAccess.SetSegmentTypes(m);
+
+  TEST_EQUAL(roadAccess.GetSegmentType(Segment(0, 1, 0, true)), RoadAccess::Type::No, ());
+  TEST_EQUAL(roadAccess.GetSegmentType(Segment(0, 1, 5, false)), RoadAccess::Type::No, ());
+  TEST_EQUAL(roadAccess.GetSegmentType(Segment(0, 2, 2, false)), RoadAccess::Type::Private, ());
+  TEST_EQUAL(roadAccess.GetSegmentType(Segment(0, 2, 2, true)), RoadAccess::Type::Yes, ());
+  TEST_EQUAL(roadAccess.GetSegmentType(Segment(0, 2, 3, true)), RoadAccess::Type::Destination,
+             ());
+  TEST_EQUAL(roadAccess.GetSegmentType(Segment(0, 2, 0, true)), RoadAccess::Type::Yes, ());
+  TEST_EQUAL(roadAccess.GetSegmentType(Segment(0, 0, 0, true)), RoadAccess::Type::Yes, ());
+  TEST_EQUAL(roadAccess.GetSegmentType(Segment(0, 3, 0, true)), RoadAccess::Type::Yes, ());
+}
+
 UNIT_TEST(RoadAccess_WayBlocked)
 {
   // Add edges to the graph in the following format: (from, to, weight).
@@ -0,0 +1,90 @@
+#include "testing/testing.hpp"
+
+#include "routing/road_grid.hpp"
+
+#include "coding/reader.hpp"
+#include "coding/writer.hpp"
+
+#include "geometry/point2d.hpp"
+#include "geometry/rect2d.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+using namespace routing;
+using namespace std;
+
+namespace
+{
+double constexpr kCell = RoadGrid::kCellSize;
+
+vector<uint32_t> GetRoads(RoadGrid const & grid, m2::RectD const & rect)
+{
+  vector<uint32_t> roads;
+  grid.ForEachRoadInRect(rect, [&](uint32_t featureId) { roads.push_back(featureId); });
+  return roads;
+}
+
+m2::RectD CellRect(int32_t x, int32_t y)
+{
+  // The rect is inside the cell to avoid ambiguity on the borders of cells.
+  return m2::RectD((x + 0.25) * kCell, (y + 0.25) * kCell, (x + 0.75) * kCell, (y + 0.75) * kCell);
+}
+
+UNIT_TEST(RoadGrid_Smoke)
+{
+  RoadGridBuilder builder;
+  // Horizontal segment crossing cells (0, 0), (1, 0) and (2, 0).
+  builder.AddSegment(7, m2::PointD(0.5 * kCell, 0.5 * kCell), m2::PointD(2.5 * kCell, 0.5 * kCell));
+  // Diagonal segment from cell (0, 0) to cell (2, 2), it crosses (0, 0), (0, 1), (1, 1), (1, 2)
+  // and (2, 2).
+  builder.AddSegment(3, m2::PointD(0.5 * kCell, 0.6 * kCell), m2::PointD(2.5 * kCell, 2.6 * kCell));
+  // Vertical segment in column 5 with negative coordinates.
+  builder.AddSegment(10, m2::PointD(5.5 * kCell, -3.5 * kCell), m2::PointD(5.5 * kCell, -1.5 * kCell));
+  // The same feature is added with another segment of the same cell.
+  builder.AddSegment(7, m2::PointD(2.2 * kCell, 0.2 * kCell), m2::PointD(2.8 * kCell, 0.8 * kCell));
+
+  vector<uint8_t> buffer;
+  {
+    MemWriter<decltype(buffer)> writer(buffer);
+    builder.Serialize(writer);
+  }
+
+  RoadGrid const grid(make_unique<MemReader>(buffer.data(), buffer.size()));
+
+  TEST_EQUAL(GetRoads(grid, CellRect(0, 0)), vector<uint32_t>({3, 7}), ());
+  TEST_EQUAL(GetRoads(grid, CellRect(1, 0)), vector<uint32_t>({7}), ());
+  TEST_EQUAL(GetRoads(grid, CellRect(2, 0)), vector<uint32_t>({7}), ());
+  TEST_EQUAL(GetRoads(grid, CellRect(1, 1)), vector<uint32_t>({3}), ());
+  TEST_EQUAL(GetRoads(grid, CellRect(2, 2)), vector<uint32_t>({3}), ());
+  TEST_EQUAL(GetRoads(grid, CellRect(0, 2)), vector<uint32_t>(), ());
+  TEST_EQUAL(GetRoads(grid, CellRect(2, 1)), vector<uint32_t>(), ());
+
+  TEST_EQUAL(GetRoads(grid, CellRect(5, -4)), vector<uint32_t>({10}), ());
+  TEST_EQUAL(GetRoads(grid, CellRect(5, -2)), vector<uint32_t>({10}), ());
+  TEST_EQUAL(GetRoads(grid, CellRect(5, -1)), vector<uint32_t>(), ());
+
+  // Every road is reported once.
+  TEST_EQUAL(GetRoads(grid, m2::RectD(-kCell, -10 * kCell, 10 * kCell, 10 * kCell)),
+             vector<uint32_t>({3, 7, 10}), ());
+
+  // Rects outside the grid.
+  TEST_EQUAL(GetRoads(grid, CellRect(-5, 0)), vector<uint32_t>(), ());
+  TEST_EQUAL(GetRoads(grid, CellRect(0, 100)), vector<uint32_t>(), ());
+  TEST_EQUAL(GetRoads(grid, CellRect(100, -100)), vector<uint32_t>(), ());
+}
+
+UNIT_TEST(RoadGrid_Empty)
+{
+  RoadGridBuilder builder;
+  vector<uint8_t> buffer;
+  {
+    MemWriter<decltype(buffer)> writer(buffer);
+    builder.Serialize(writer);
+  }
+
+  RoadGrid const grid(make_unique<MemReader>(buffer.data(), buffer.size()));
+  TEST_EQUAL(GetRoads(grid, m2::RectD(-1.0, -1.0, 1.0, 1.0)), vector<uint32_t>(), ());
+}
+}  // namespace
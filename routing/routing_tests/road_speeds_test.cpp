@@ -0,0 +1,103 @@
+#include "testing/testing.hpp"
+
+#include "routing/road_speeds.hpp"
+#include "routing/road_speeds_serialization.hpp"
+
+#include "coding/reader.hpp"
+#include "coding/writer.hpp"
+
+#include <cstdint>
+#include <vector>
+
+using namespace routing;
+using namespace std;
+
+namespace
+{
+RoadSpeeds::Road MakeRoad(double speedKMpH, bool isOneWay, bool isTransitAllowed)
+{
+  RoadSpeeds::Road road;
+  road.m_speedKMpH = speedKMpH;
+  road.m_isOneWay = isOneWay;
+  road.m_isTransitAllowed = isTransitAllowed;
+  return road;
+}
+
+void TestRoad(RoadSpeeds const & speeds, uint32_t featureId, RoadSpeeds::Road const & expected)
+{
+  RoadSpeeds::Road road;
+  TEST(speeds.Get(featureId, road), (featureId));
+  TEST_EQUAL(road.m_speedKMpH, expected.m_speedKMpH, (featureId));
+  TEST_EQUAL(road.m_isOneWay, expected.m_isOneWay, (featureId));
+  TEST_EQUAL(road.m_isTransitAllowed, expected.m_isTransitAllowed, (featureId));
+}
+
+UNIT_TEST(RoadSpeeds_Get)
+{
+  RoadSpeeds speeds;
+  speeds.Add(3, MakeRoad(90.0, true /* isOneWay */, true /* isTransitAllowed */));
+  speeds.Add(7, MakeRoad(4.5, false /* isOneWay */, false /* isTransitAllowed */));
+  speeds.Add(100, MakeRoad(90.0, false /* isOneWay */, true /* isTransitAllowed */));
+
+  TEST_EQUAL(speeds.GetNumRoads(), 3, ());
+  TEST_EQUAL(speeds.GetNumSpeeds(), 2, ());
+
+  TestRoad(speeds, 3, MakeRoad(90.0, true, true));
+  TestRoad(speeds, 7, MakeRoad(4.5, false, false));
+  TestRoad(speeds, 100, MakeRoad(90.0, false, true));
+
+  RoadSpeeds::Road road;
+  TEST(!speeds.Get(0, road), ());
+  TEST(!speeds.Get(5, road), ());
+  TEST(!speeds.Get(101, road), ());
+}
+
+UNIT_TEST(RoadSpeeds_Serialization)
+{
+  RoadSpeedsSerializer::RoadSpeedsByVehicleType speedsByType;
+  RoadSpeeds & car = speedsByType[static_cast<size_t>(VehicleType::Car)];
+  car.Add(1, MakeRoad(60.0, true /* isOneWay */, true /* isTransitAllowed */));
+  car.Add(1000000, MakeRoad(110.5, false /* isOneWay */, true /* isTransitAllowed */));
+
+  RoadSpeeds & pedestrian = speedsByType[static_cast<size_t>(VehicleType::Pedestrian)];
+  pedestrian.Add(2, MakeRoad(5.0, false /* isOneWay */, false /* isTransitAllowed */));
+
+  vector<uint8_t> buf;
+  {
+    MemWriter<decltype(buf)> writer(buf);
+    RoadSpeedsSerializer::Serialize(writer, speedsByType);
+  }
+
+  {
+    RoadSpeeds deserialized;
+    MemReader memReader(buf.data(), buf.size());
+    ReaderSource<MemReader> src(memReader);
+    RoadSpeedsSerializer::Deserialize(src, VehicleType::Car, deserialized);
+    TEST_EQUAL(src.Size(), 0, ());
+
+    TEST_EQUAL(deserialized.GetNumRoads(), 2, ());
+    TestRoad(deserialized, 1, MakeRoad(60.0, true, true));
+    TestRoad(deserialized, 1000000, MakeRoad(110.5, false, true));
+  }
+
+  {
+    RoadSpeeds deserialized;
+    MemReader memReader(buf.data(), buf.size());
+    ReaderSource<MemReader> src(memReader);
+    RoadSpeedsSerializer::Deserialize(src, VehicleType::Bicycle, deserialized);
+    TEST_EQUAL(src.Size(), 0, ());
+    TEST_EQUAL(deserialized.GetNumRoads(), 0, ());
+  }
+
+  {
+    RoadSpeeds deserialized;
+    MemReader memReader(buf.data(), buf.size());
+    ReaderSource<MemReader> src(memReader);
+    RoadSpeedsSerializer::Deserialize(src, VehicleType::Pedestrian, deserialized);
+    TEST_EQUAL(src.Size(), 0, ());
+
+    TEST_EQUAL(deserialized.GetNumRoads(), 1, ());
+    TestRoad(deserialized, 2, MakeRoad(5.0, false, false));
+  }
+}
+}  // namespace
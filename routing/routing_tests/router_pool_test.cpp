@@ -0,0 +1,173 @@
+#include "testing/testing.hpp"
+
+#include "routing/router.hpp"
+#include "routing/router_pool.hpp"
+
+#include "geometry/point2d.hpp"
+
+#include "base/timer.hpp"
+
+#include "std/atomic.hpp"
+#include "std/chrono.hpp"
+#include "std/condition_variable.hpp"
+#include "std/map.hpp"
+#include "std/mutex.hpp"
+#include "std/string.hpp"
+#include "std/thread.hpp"
+
+using namespace routing;
+
+using ResultCode = routing::IRouter::ResultCode;
+
+namespace
+{
+class DummyRouter : public IRouter
+{
+public:
+  DummyRouter(atomic<uint32_t> & routersCount, ResultCode code, bool waitCancellation)
+    : m_code(code), m_waitCancellation(waitCancellation)
+  {
+    ++routersCount;
+  }
+
+  // IRouter overrides:
+  string GetName() const override { return "Dummy"; }
+  ResultCode CalculateRoute(Checkpoints const & checkpoints, m2::PointD const & startDirection,
+                            bool adjustToPrevRoute, RouterDelegate const & delegate,
+                            Route & route) override
+  {
+    while (m_waitCancellation && !delegate.IsCancelled())
+      this_thread::sleep_for(milliseconds(1));
+
+    route = Route("dummy", checkpoints.GetPoints().cbegin(), checkpoints.GetPoints().cend());
+    return m_code;
+  }
+
+private:
+  ResultCode const m_code;
+  bool const m_waitCancellation;
+};
+
+struct ResultCollector
+{
+  void Add(RouterPool::RequestId id, ResultCode code)
+  {
+    lock_guard<mutex> guard(m_mutex);
+    TEST(m_codes.emplace(id, code).second, ("The result callback is called twice for", id));
+    m_cv.notify_all();
+  }
+
+  void Wait(size_t count)
+  {
+    unique_lock<mutex> lock(m_mutex);
+    m_cv.wait(lock, [this, count]() { return m_codes.size() >= count; });
+  }
+
+  ResultCode Get(RouterPool::RequestId id)
+  {
+    lock_guard<mutex> guard(m_mutex);
+    auto const it = m_codes.find(id);
+    TEST(it != m_codes.end(), (id));
+    return it->second;
+  }
+
+  mutex m_mutex;
+  condition_variable m_cv;
+  map<RouterPool::RequestId, ResultCode> m_codes;
+};
+
+RouterPool::RequestId Submit(RouterPool & pool, ResultCollector & results, uint32_t timeoutSec)
+{
+  auto const id = make_shared<RouterPool::RequestId>();
+  // The id is known only after submission, so it's passed to the callback through
+  // a shared value which is set before the request can be finished.
+  auto const ready = make_shared<atomic<bool>>(false);
+  *id = pool.CalculateRoute(
+      Checkpoints(m2::PointD(0, 0), m2::PointD(1, 1)), m2::PointD::Zero(),
+      [&results, id, ready](Route &, ResultCode code) {
+        while (!*ready)
+          this_thread::yield();
+        results.Add(*id, code);
+      },
+      nullptr /* progressCallback */, timeoutSec);
+  *ready = true;
+  return *id;
+}
+}  // namespace
+
+UNIT_TEST(RouterPool_CalculatesAllRequests)
+{
+  atomic<uint32_t> routersCount(0);
+  ResultCollector results;
+  size_t const kRequestsCount = 20;
+  vector<RouterPool::RequestId> ids;
+  {
+    RouterPool pool(4 /* workersCount */, [&routersCount]() {
+      return make_unique<DummyRouter>(routersCount, IRouter::NoError, false /* waitCancellation */);
+    });
+    TEST_EQUAL(routersCount, 4, ());
+
+    for (size_t i = 0; i < kRequestsCount; ++i)
+      ids.push_back(Submit(pool, results, 0 /* timeoutSec */));
+    results.Wait(kRequestsCount);
+  }
+
+  TEST_EQUAL(results.m_codes.size(), kRequestsCount, ());
+  for (auto const id : ids)
+    TEST_EQUAL(results.Get(id), IRouter::NoError, (id));
+}
+
+UNIT_TEST(RouterPool_Cancel)
+{
+  atomic<uint32_t> routersCount(0);
+  ResultCollector results;
+  RouterPool pool(1 /* workersCount */, [&routersCount]() {
+    return make_unique<DummyRouter>(routersCount, IRouter::RouteNotFound, true /* waitCancellation */);
+  });
+
+  auto const running = Submit(pool, results, 0 /* timeoutSec */);
+  auto const queued = Submit(pool, results, 0 /* timeoutSec */);
+
+  pool.Cancel(queued);
+  pool.Cancel(running);
+  results.Wait(2);
+
+  TEST_EQUAL(results.Get(running), IRouter::Cancelled, ());
+  TEST_EQUAL(results.Get(queued), IRouter::Cancelled, ());
+  TEST_EQUAL(pool.GetQueueSize(), 0, ());
+}
+
+UNIT_TEST(RouterPool_TimeoutInQueue)
+{
+  atomic<uint32_t> routersCount(0);
+  ResultCollector results;
+  RouterPool pool(1 /* workersCount */, [&routersCount]() {
+    return make_unique<DummyRouter>(routersCount, IRouter::RouteNotFound, true /* waitCancellation */);
+  });
+
+  // The first request blocks the worker until its timeout, so the second one expires in the queue.
+  auto const first = Submit(pool, results, 1 /* timeoutSec */);
+  auto const second = Submit(pool, results, 1 /* timeoutSec */);
+  results.Wait(2);
+
+  TEST_EQUAL(results.Get(first), IRouter::Cancelled, ());
+  TEST_EQUAL(results.Get(second), IRouter::Cancelled, ());
+}
+
+UNIT_TEST(RouterPool_DestructorCancelsRequests)
+{
+  atomic<uint32_t> routersCount(0);
+  ResultCollector results;
+  size_t const kRequestsCount = 5;
+  {
+    RouterPool pool(1 /* workersCount */, [&routersCount]() {
+      return make_unique<DummyRouter>(routersCount, IRouter::RouteNotFound, true /* waitCancellation */);
+    });
+    for (size_t i = 0; i < kRequestsCount; ++i)
+      Submit(pool, results, 0 /* timeoutSec */);
+  }
+
+  TEST_EQUAL(results.m_codes.size(), kRequestsCount, ());
+  for (auto const & result : results.m_codes)
+    TEST_EQUAL(result.second, IRouter::Cancelled, ());
+}
@@ -32,6 +32,7 @@ SOURCES += \
   cross_routing_tests.cpp \
   cumulative_restriction_test.cpp \
   followed_polyline_test.cpp \
+  index_graph_loader_test.cpp \
   index_graph_test.cpp \
   index_graph_tools.cpp \
   nearest_edge_finder_tests.cpp \
@@ -41,10 +42,17 @@ SOURCES += \
   road_access_test.cpp \
   road_graph_builder.cpp \
   road_graph_nearest_edges_test.cpp \
+  road_grid_test.cpp \
+  road_speeds_test.cpp \
   route_tests.cpp \
+  router_pool_test.cpp \
   routing_helpers_tests.cpp \
   routing_mapping_test.cpp \
   routing_session_test.cpp \
+  speed_cameras_test.cpp \
+  speed_profiles_test.cpp \
+  subroute_cache_test.cpp \
+  transit_section_test.cpp \
   turns_generator_test.cpp \
   turns_sound_test.cpp \
   turns_tts_text_tests.cpp \
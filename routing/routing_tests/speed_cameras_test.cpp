@@ -0,0 +1,75 @@
+#include "testing/testing.hpp"
+
+#include "routing/speed_camera.hpp"
+
+#include "coding/reader.hpp"
+#include "coding/writer.hpp"
+
+#include "geometry/mercator.hpp"
+#include "geometry/point2d.hpp"
+
+#include <cstdint>
+#include <vector>
+
+using namespace routing;
+using namespace std;
+
+namespace
+{
+UNIT_TEST(SpeedCameras_Serialization)
+{
+  vector<SpeedCamera> const cameras = {
+      {m2::PointD(37.6, 67.7), 60},
+      {m2::PointD(-12.5, 48.1), 0},
+      {m2::PointD(37.6, 12.3), 90},
+      {m2::PointD(MercatorBounds::maxX, MercatorBounds::minY), 250}};
+
+  vector<uint8_t> buffer;
+  {
+    MemWriter<vector<uint8_t>> writer(buffer);
+    SpeedCamerasSerializer::Serialize(writer, cameras);
+  }
+
+  vector<SpeedCamera> deserialized;
+  {
+    MemReader reader(buffer.data(), buffer.size());
+    ReaderSource<MemReader> src(reader);
+    SpeedCamerasSerializer::Deserialize(src, deserialized);
+    TEST_EQUAL(src.Size(), 0, ());
+  }
+
+  // Cameras are sorted by x.
+  TEST_EQUAL(deserialized.size(), cameras.size(), ());
+  for (size_t i = 1; i < deserialized.size(); ++i)
+    TEST_LESS_OR_EQUAL(deserialized[i - 1].m_point.x, deserialized[i].m_point.x, ());
+
+  for (auto const & camera : cameras)
+  {
+    bool found = false;
+    for (auto const & d : deserialized)
+    {
+      if (d.m_point.EqualDxDy(camera.m_point, 1e-6))
+      {
+        TEST_EQUAL(d.m_maxSpeedKmH, camera.m_maxSpeedKmH, ());
+        found = true;
+      }
+    }
+    TEST(found, (camera.m_point));
+  }
+}
+
+UNIT_TEST(SpeedCameras_Empty)
+{
+  vector<uint8_t> buffer;
+  {
+    MemWriter<vector<uint8_t>> writer(buffer);
+    SpeedCamerasSerializer::Serialize(writer, {});
+  }
+
+  MemReader reader(buffer.data(), buffer.size());
+  ReaderSource<MemReader> src(reader);
+  vector<SpeedCamera> cameras = {{m2::PointD(1.0, 1.0), 10}};
+  SpeedCamerasSerializer::Deserialize(src, cameras);
+  TEST(cameras.empty(), ());
+}
+}  // namespace
@@ -0,0 +1,127 @@
+#include "testing/testing.hpp"
+
+#include "routing/segment.hpp"
+#include "routing/speed_profiles.hpp"
+#include "routing/speed_profiles_serialization.hpp"
+
+#include "coding/reader.hpp"
+#include "coding/writer.hpp"
+
+#include "base/math.hpp"
+
+#include <cstdint>
+#include <vector>
+
+using namespace routing;
+using namespace std;
+
+namespace
+{
+double constexpr kEpsilon = 1e-6;
+uint32_t constexpr kBucket = SpeedProfiles::kBucketDurationSec;
+
+SpeedProfiles::Profile MakeProfile(uint8_t factor)
+{
+  SpeedProfiles::Profile profile;
+  profile.fill(factor);
+  return profile;
+}
+
+// Congestion from 7:00 up to 10:00.
+SpeedProfiles::Profile MakeRushHourProfile()
+{
+  SpeedProfiles::Profile profile = MakeProfile(SpeedProfiles::kMaxFactor);
+  for (size_t i = 7 * 4; i < 10 * 4; ++i)
+    profile[i] = 20;
+  return profile;
+}
+
+Segment MakeSegment(uint32_t featureId, uint32_t segmentIdx, bool forward)
+{
+  return Segment(kFakeNumMwmId, featureId, segmentIdx, forward);
+}
+
+void TestFactor(SpeedProfiles const & profiles, Segment const & segment, uint32_t timeOfDaySec,
+                double expected)
+{
+  TEST(my::AlmostEqualAbs(profiles.GetSpeedFactor(segment, timeOfDaySec), expected, kEpsilon),
+       (segment, timeOfDaySec, profiles.GetSpeedFactor(segment, timeOfDaySec), expected));
+}
+
+UNIT_TEST(SpeedProfiles_QuantizeFactor)
+{
+  TEST_EQUAL(SpeedProfiles::QuantizeFactor(1.0), 100, ());
+  TEST_EQUAL(SpeedProfiles::QuantizeFactor(0.504), 50, ());
+  TEST_EQUAL(SpeedProfiles::QuantizeFactor(2.0), 100, ());
+  TEST_EQUAL(SpeedProfiles::QuantizeFactor(0.0), 1, ());
+}
+
+UNIT_TEST(SpeedProfiles_GetSpeedFactor)
+{
+  SpeedProfiles profiles;
+  uint32_t const rushHour = profiles.AddProfile(MakeRushHourProfile());
+  uint32_t const slow = profiles.AddProfile(MakeProfile(50));
+  profiles.SetSegmentProfile(MakeSegment(1, 0, true), rushHour);
+  profiles.SetSegmentProfile(MakeSegment(1, 3, false), slow);
+  profiles.SetSegmentProfile(MakeSegment(1, 3, true), rushHour);
+  profiles.SetSegmentProfile(MakeSegment(20, 0, false), rushHour);
+
+  TEST_EQUAL(profiles.GetNumProfiles(), 2, ());
+  TEST_EQUAL(profiles.GetNumSegments(), 4, ());
+
+  Segment const segment = MakeSegment(1, 0, true);
+  TestFactor(profiles, segment, 3 * 3600, 1.0);
+  // Middles of buckets.
+  TestFactor(profiles, segment, 8 * 3600 + kBucket / 2, 0.2);
+  TestFactor(profiles, segment, 7 * 3600 + kBucket / 2, 0.2);
+  // Between the middles of the last free flow bucket and the first congested one.
+  TestFactor(profiles, segment, 7 * 3600, 0.6);
+  TestFactor(profiles, segment, 7 * 3600 - kBucket / 4, 0.8);
+  // Times after midnight are wrapped.
+  TestFactor(profiles, segment, SpeedProfiles::kSecondsInDay + 8 * 3600, 0.2);
+
+  TestFactor(profiles, MakeSegment(1, 3, false), 8 * 3600, 0.5);
+  TestFactor(profiles, MakeSegment(1, 3, true), 8 * 3600, 0.2);
+  TestFactor(profiles, MakeSegment(20, 0, false), 8 * 3600, 0.2);
+
+  // No profiles.
+  TestFactor(profiles, MakeSegment(1, 0, false), 8 * 3600, 1.0);
+  TestFactor(profiles, MakeSegment(1, 1, true), 8 * 3600, 1.0);
+  TestFactor(profiles, MakeSegment(21, 0, false), 8 * 3600, 1.0);
+}
+
+UNIT_TEST(SpeedProfiles_Serialization)
+{
+  SpeedProfiles profiles;
+  uint32_t const rushHour = profiles.AddProfile(MakeRushHourProfile());
+  uint32_t const slow = profiles.AddProfile(MakeProfile(50));
+  profiles.SetSegmentProfile(MakeSegment(0, 0, false), slow);
+  profiles.SetSegmentProfile(MakeSegment(5, 2, true), rushHour);
+  profiles.SetSegmentProfile(MakeSegment(1000000, 10, true), slow);
+
+  vector<uint8_t> buffer;
+  {
+    MemWriter<decltype(buffer)> writer(buffer);
+    SpeedProfilesSerializer::Serialize(writer, profiles);
+  }
+
+  SpeedProfiles deserialized;
+  {
+    MemReader reader(buffer.data(), buffer.size());
+    ReaderSource<MemReader> src(reader);
+    SpeedProfilesSerializer::Deserialize(src, deserialized);
+  }
+
+  TEST_EQUAL(deserialized.GetNumProfiles(), 2, ());
+  TEST_EQUAL(deserialized.GetNumSegments(), 3, ());
+  for (uint32_t time : {0U, 7 * 3600U, 8 * 3600U, 9 * 3600U + 123U, 23 * 3600U})
+  {
+    for (auto const & segment : {MakeSegment(0, 0, false), MakeSegment(5, 2, true),
+                                 MakeSegment(1000000, 10, true), MakeSegment(5, 2, false)})
+    {
+      TEST_EQUAL(deserialized.GetSpeedFactor(segment, time), profiles.GetSpeedFactor(segment, time),
+                 (segment, time));
+    }
+  }
+}
+}  // namespace
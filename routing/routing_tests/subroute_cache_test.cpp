@@ -0,0 +1,150 @@
+#include "testing/testing.hpp"
+
+#include "routing/subroute_cache.hpp"
+
+#include "routing/num_mwm_id.hpp"
+#include "routing/segment.hpp"
+
+#include "indexer/mwm_set.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <vector>
+
+using namespace routing;
+using namespace std;
+
+namespace
+{
+NumMwmId constexpr kMwm0 = 0;
+NumMwmId constexpr kMwm1 = 1;
+
+class TestMwms
+{
+public:
+  TestMwms()
+  {
+    Update(kMwm0);
+    Update(kMwm1);
+  }
+
+  // Emulates an update of the mwm data.
+  void Update(NumMwmId numMwmId)
+  {
+    m_states[numMwmId].m_mwmId = MwmSet::MwmId(make_shared<MwmInfo>());
+  }
+
+  void SetTrafficVersion(NumMwmId numMwmId, uint64_t version)
+  {
+    m_states[numMwmId].m_trafficVersion = version;
+  }
+
+  SubrouteCache::GetMwmStateFn GetFn() const
+  {
+    return [this](NumMwmId numMwmId) { return m_states.at(numMwmId); };
+  }
+
+private:
+  map<NumMwmId, SubrouteCache::MwmState> m_states;
+};
+
+Segment MakeSegment(NumMwmId mwmId, uint32_t featureId, uint32_t segmentIdx)
+{
+  return Segment(mwmId, featureId, segmentIdx, true /* forward */);
+}
+
+UNIT_TEST(SubrouteCache_FindPut)
+{
+  TestMwms mwms;
+  SubrouteCache cache(100 /* capacity */);
+
+  SubrouteCache::Key const key(MakeSegment(kMwm0, 1, 0), MakeSegment(kMwm1, 5, 2),
+                               true /* strictForward */);
+  TEST(!cache.Find(key, mwms.GetFn()), ());
+
+  Segment const fake(kFakeNumMwmId, 0, 0, false);
+  cache.Put(key,
+            {fake, MakeSegment(kMwm0, 1, 0), MakeSegment(kMwm0, 1, 1), MakeSegment(kMwm1, 5, 0),
+             MakeSegment(kMwm1, 5, 1), MakeSegment(kMwm1, 5, 2), fake},
+            mwms.GetFn());
+
+  auto const entry = cache.Find(key, mwms.GetFn());
+  TEST(entry, ());
+  TEST_EQUAL(entry->m_segments.size(), 5, ());
+  TEST(is_sorted(entry->m_segments.cbegin(), entry->m_segments.cend()), ());
+  TEST_EQUAL(entry->m_numMwmIds, vector<NumMwmId>({kMwm0, kMwm1}), ());
+
+  // Keys differ by every field.
+  TEST(!cache.Find(SubrouteCache::Key(key.m_start, key.m_finish, false /* strictForward */),
+                   mwms.GetFn()),
+       ());
+  TEST(!cache.Find(SubrouteCache::Key(key.m_finish, key.m_start, true /* strictForward */),
+                   mwms.GetFn()),
+       ());
+  TEST_EQUAL(cache.GetAccessCount(), 4, ());
+  TEST_EQUAL(cache.GetMissCount(), 3, ());
+}
+
+UNIT_TEST(SubrouteCache_Invalidation)
+{
+  TestMwms mwms;
+  SubrouteCache cache(100 /* capacity */);
+
+  SubrouteCache::Key const key0(MakeSegment(kMwm0, 1, 0), MakeSegment(kMwm0, 3, 0),
+                                true /* strictForward */);
+  SubrouteCache::Key const key1(MakeSegment(kMwm1, 1, 0), MakeSegment(kMwm1, 3, 0),
+                                true /* strictForward */);
+  auto const put = [&]() {
+    cache.Put(key0, {key0.m_start, MakeSegment(kMwm0, 2, 0), key0.m_finish}, mwms.GetFn());
+    cache.Put(key1, {key1.m_start, MakeSegment(kMwm1, 2, 0), key1.m_finish}, mwms.GetFn());
+  };
+
+  put();
+  TEST_EQUAL(cache.GetSize(), 2, ());
+
+  // Traffic of mwm 0 is changed, the subroute in mwm 1 is still valid.
+  mwms.SetTrafficVersion(kMwm0, 7);
+  TEST(!cache.Find(key0, mwms.GetFn()), ());
+  TEST(cache.Find(key1, mwms.GetFn()), ());
+  TEST_EQUAL(cache.GetSize(), 1, ());
+
+  put();
+  TEST(cache.Find(key0, mwms.GetFn()), ());
+
+  // Mwm 1 is updated.
+  mwms.Update(kMwm1);
+  TEST(cache.Find(key0, mwms.GetFn()), ());
+  TEST(!cache.Find(key1, mwms.GetFn()), ());
+
+  cache.Clear();
+  TEST_EQUAL(cache.GetSize(), 0, ());
+  TEST(!cache.Find(key0, mwms.GetFn()), ());
+}
+
+UNIT_TEST(SubrouteCache_Capacity)
+{
+  TestMwms mwms;
+  SubrouteCache cache(10 /* capacity */);
+
+  vector<Segment> segments;
+  for (uint32_t i = 0; i < 4; ++i)
+    segments.push_back(MakeSegment(kMwm0, 1, i));
+
+  // The capacity is measured in segments, so only two subroutes of 4 segments fit.
+  for (uint32_t featureId = 0; featureId < 3; ++featureId)
+  {
+    cache.Put(SubrouteCache::Key(MakeSegment(kMwm0, featureId, 0), MakeSegment(kMwm0, 1, 3),
+                                 true /* strictForward */),
+              segments, mwms.GetFn());
+  }
+  TEST_EQUAL(cache.GetSize(), 2, ());
+  TEST(!cache.Find(SubrouteCache::Key(MakeSegment(kMwm0, 0, 0), MakeSegment(kMwm0, 1, 3), true),
+                   mwms.GetFn()),
+       ());
+  TEST(cache.Find(SubrouteCache::Key(MakeSegment(kMwm0, 2, 0), MakeSegment(kMwm0, 1, 3), true),
+                  mwms.GetFn()),
+       ());
+}
+}  // namespace
@@ -0,0 +1,140 @@
+#include "testing/testing.hpp"
+
+#include "routing/transit_section.hpp"
+
+#include "platform/platform.hpp"
+
+#include "coding/file_name_utils.hpp"
+#include "coding/file_reader.hpp"
+#include "coding/file_writer.hpp"
+#include "coding/internal/file_data.hpp"
+#include "coding/mmap_reader.hpp"
+#include "coding/reader.hpp"
+#include "coding/writer.hpp"
+
+#include "base/scope_guard.hpp"
+#include "base/stl_add.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace routing;
+using namespace routing::transit;
+using namespace std;
+
+namespace
+{
+void BuildSection(string const & path)
+{
+  TransitSectionBuilder builder;
+  // Records are added unsorted, the builder sorts them.
+  builder.AddStop(3 /* id */, kInvalidId, {3.0, 3.0}, {20} /* lineIds */);
+  builder.AddStop(1 /* id */, 100 /* featureId */, {1.0, 1.0}, {10, 20} /* lineIds */);
+  builder.AddStop(2 /* id */, kInvalidId, {2.0, 2.0}, {10} /* lineIds */);
+
+  builder.AddGate(200 /* featureId */, 2 /* stopId */, 30.0 /* weight */, true /* entrance */,
+                  false /* exit */, {2.5, 2.5});
+  builder.AddGate(201 /* featureId */, 1 /* stopId */, 40.0 /* weight */, true /* entrance */,
+                  true /* exit */, {1.5, 1.5});
+
+  builder.AddEdge(2, 3, 20 /* lineId */, kInvalidId, 60.0 /* weight */, false /* transfer */);
+  builder.AddEdge(1, 2, 10 /* lineId */, 5 /* shapeId */, 120.0 /* weight */, false);
+  builder.AddEdge(1, 3, 20 /* lineId */, kInvalidId, 180.0 /* weight */, false);
+  builder.AddEdge(3, 2, kInvalidId, kInvalidId, 90.0 /* weight */, true /* transfer */);
+
+  builder.AddLine(20 /* id */, "Line 20", {1, 3, 2} /* stopIds */);
+  builder.AddLine(10 /* id */, "Line 10", {1, 2} /* stopIds */);
+
+  builder.AddShape(5 /* id */, {{1.0, 1.0}, {1.5, 1.2}, {2.0, 2.0}});
+
+  FileWriter writer(path);
+  builder.Write(writer);
+}
+
+void TestSection(TransitSection const & section)
+{
+  TEST_EQUAL(section.GetStopsCount(), 3, ());
+  TEST_EQUAL(section.GetGatesCount(), 2, ());
+  TEST_EQUAL(section.GetEdgesCount(), 4, ());
+  TEST_EQUAL(section.GetLinesCount(), 2, ());
+  TEST_EQUAL(section.GetShapesCount(), 1, ());
+
+  vector<uint32_t> stopIds;
+  section.ForEachStop([&stopIds](Stop const & stop) { stopIds.push_back(stop.m_id); });
+  TEST_EQUAL(stopIds, vector<uint32_t>({1, 2, 3}), ());
+
+  Stop const * stop = section.GetStop(1);
+  TEST(stop, ());
+  TEST_EQUAL(stop->m_featureId, 100, ());
+  TEST_EQUAL(stop->GetPoint(), m2::PointD(1.0, 1.0), ());
+  TEST_EQUAL(section.GetLineIds(*stop), vector<uint32_t>({10, 20}), ());
+  TEST(!section.GetStop(4), ());
+
+  vector<pair<uint32_t, uint32_t>> edges;
+  section.ForEachOutgoingEdge(1, [&edges](Edge const & edge) {
+    edges.emplace_back(edge.m_stop1Id, edge.m_stop2Id);
+  });
+  TEST_EQUAL(edges, (vector<pair<uint32_t, uint32_t>>{{1, 2}, {1, 3}}), ());
+
+  edges.clear();
+  section.ForEachIngoingEdge(2, [&edges](Edge const & edge) {
+    edges.emplace_back(edge.m_stop1Id, edge.m_stop2Id);
+  });
+  TEST_EQUAL(edges, (vector<pair<uint32_t, uint32_t>>{{1, 2}, {3, 2}}), ());
+
+  edges.clear();
+  section.ForEachIngoingEdge(1, [&edges](Edge const & edge) {
+    edges.emplace_back(edge.m_stop1Id, edge.m_stop2Id);
+  });
+  TEST(edges.empty(), ());
+
+  vector<uint32_t> gates;
+  section.ForEachGateOfStop(2, [&gates](Gate const & gate) { gates.push_back(gate.m_featureId); });
+  TEST_EQUAL(gates, vector<uint32_t>({200}), ());
+
+  Line const * line = section.GetLine(20);
+  TEST(line, ());
+  TEST_EQUAL(section.GetTitle(*line), "Line 20", ());
+  TEST_EQUAL(section.GetStopIds(*line), vector<uint32_t>({1, 3, 2}), ());
+
+  Shape const * shape = section.GetShape(5);
+  TEST(shape, ());
+  TEST_EQUAL(section.GetPoints(*shape),
+             vector<m2::PointD>({{1.0, 1.0}, {1.5, 1.2}, {2.0, 2.0}}), ());
+  TEST(!section.GetShape(6), ());
+}
+
+UNIT_TEST(TransitSection_Smoke)
+{
+  string const path = my::JoinFoldersToPath(GetPlatform().WritableDir(), "transit_section.bin");
+  MY_SCOPE_GUARD(deleteFile, [&path]() { my::DeleteFileX(path); });
+  BuildSection(path);
+
+  {
+    // The section is used in place of the mapped file.
+    auto const section = TransitSection::Load(my::make_unique<MmapReader>(path));
+    TEST(section->IsMapped(), ());
+    TestSection(*section);
+  }
+
+  {
+    auto const section = TransitSection::Load(my::make_unique<FileReader>(path));
+    TEST(!section->IsMapped(), ());
+    TestSection(*section);
+  }
+}
+
+UNIT_TEST(TransitSection_AbsentStop)
+{
+  TransitSectionBuilder builder;
+  builder.AddStop(1 /* id */, kInvalidId, {1.0, 1.0}, {} /* lineIds */);
+  builder.AddEdge(1, 2, kInvalidId, kInvalidId, 60.0 /* weight */, true /* transfer */);
+
+  vector<uint8_t> buffer;
+  MemWriter<decltype(buffer)> writer(buffer);
+  TEST_ANY_THROW(builder.Write(writer), ());
+}
+}  // namespace
@@ -5,6 +5,7 @@
 #include "routing/route_weight.hpp"
 
 #include <cstdint>
+#include <functional>
 #include <sstream>
 #include <string>
 
@@ -121,3 +122,18 @@ inline std::string DebugPrint(SegmentEdge const & edge)
   return out.str();
 }
 }  // namespace routing
+
+namespace std
+{
+template <>
+struct hash<routing::Segment>
+{
+  size_t operator()(routing::Segment const & segment) const
+  {
+    uint64_t const featureAndIdx = (static_cast<uint64_t>(segment.GetFeatureId()) << 32) |
+                                   (static_cast<uint64_t>(segment.GetSegmentIdx()) << 1) |
+                                   (segment.IsForward() ? 1 : 0);
+    return hash<uint64_t>()(featureAndIdx ^ (static_cast<uint64_t>(segment.GetMwmId()) << 48));
+  }
+};
+}  // namespace std
@@ -0,0 +1,108 @@
+#include "routing/shortcut_index.hpp"
+
+#include "routing/edge_estimator.hpp"
+#include "routing/index_graph.hpp"
+
+#include "base/assert.hpp"
+
+#include <algorithm>
+
+using namespace std;
+
+namespace routing
+{
+// ShortcutIndex -----------------------------------------------------------------------------------
+void ShortcutIndex::SetChains(uint32_t featureId, vector<Chain> && chains)
+{
+  ASSERT(is_sorted(chains.cbegin(), chains.cend(),
+                   [](Chain const & lhs, Chain const & rhs) {
+                     return lhs.m_endPointId <= rhs.m_beginPointId;
+                   }),
+         ());
+
+  if (chains.empty())
+    m_chains.erase(featureId);
+  else
+    m_chains[featureId] = move(chains);
+}
+
+bool ShortcutIndex::GetWeight(uint32_t featureId, uint32_t fromPointId, uint32_t toPointId,
+                              double & weight) const
+{
+  auto const it = m_chains.find(featureId);
+  if (it == m_chains.cend())
+    return false;
+
+  bool const forward = fromPointId < toPointId;
+  uint32_t const beginPointId = forward ? fromPointId : toPointId;
+  uint32_t const endPointId = forward ? toPointId : fromPointId;
+
+  vector<Chain> const & chains = it->second;
+  auto const chainIt = lower_bound(chains.cbegin(), chains.cend(), beginPointId,
+                                   [](Chain const & chain, uint32_t pointId) {
+                                     return chain.m_beginPointId < pointId;
+                                   });
+  if (chainIt == chains.cend() || chainIt->m_beginPointId != beginPointId ||
+      chainIt->m_endPointId != endPointId)
+  {
+    return false;
+  }
+
+  weight = forward ? chainIt->m_forwardWeight : chainIt->m_backwardWeight;
+  return true;
+}
+
+// Functions ---------------------------------------------------------------------------------------
+void BuildShortcutIndex(IndexGraph & graph, EdgeEstimator const & estimator, ShortcutIndex & index)
+{
+  graph.ForEachRoad([&](uint32_t featureId, RoadJointIds const & joints) {
+    RoadGeometry const & road = graph.GetGeometry().GetRoad(featureId);
+    if (!road.IsValid())
+      return;
+
+    vector<ShortcutIndex::Chain> chains;
+    uint32_t const pointsCount = road.GetPointsCount();
+    uint32_t beginPointId = 0;
+    for (uint32_t pointId = 1; pointId < pointsCount; ++pointId)
+    {
+      if (!road.IsEndPointId(pointId) && joints.GetJointId(pointId) == Joint::kInvalidId)
+        continue;
+
+      // There is nothing to shortcut in a chain of one segment.
+      if (pointId - beginPointId >= 2)
+      {
+        double forwardWeight = 0.0;
+        double backwardWeight = 0.0;
+        for (uint32_t segmentIdx = beginPointId; segmentIdx < pointId; ++segmentIdx)
+        {
+          forwardWeight += estimator.CalcSegmentWeight(
+              Segment(kFakeNumMwmId, featureId, segmentIdx, true /* forward */), road);
+          backwardWeight += estimator.CalcSegmentWeight(
+              Segment(kFakeNumMwmId, featureId, segmentIdx, false /* forward */), road);
+        }
+        chains.emplace_back(beginPointId, pointId, forwardWeight, backwardWeight);
+      }
+
+      beginPointId = pointId;
+    }
+
+    index.SetChains(featureId, move(chains));
+  });
+}
+
+set<Segment> MakeShortcutPins(vector<Segment> const & stops)
+{
+  set<Segment> pins;
+  for (Segment const & stop : stops)
+  {
+    pins.insert(stop);
+    pins.emplace(stop.GetMwmId(), stop.GetFeatureId(), stop.GetSegmentIdx() + 1, stop.IsForward());
+    if (stop.GetSegmentIdx() > 0)
+    {
+      pins.emplace(stop.GetMwmId(), stop.GetFeatureId(), stop.GetSegmentIdx() - 1,
+                   stop.IsForward());
+    }
+  }
+  return pins;
+}
+}  // namespace routing
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "routing/segment.hpp"
+
+#include <cstdint>
+#include <set>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace routing
+{
+class EdgeEstimator;
+class IndexGraph;
+
+// ShortcutIndex keeps precomputed weights of chains. A chain is a sequence of segments of one
+// feature between two consecutive joints (or feature ends) of the feature. Inner points of a chain
+// are not connected with other features so every inner segment of a chain has exactly one
+// outgoing and one ingoing edge, and the whole chain may be passed with one shortcut edge.
+// Please see IndexGraph::GetShortcutEdgeList() for details.
+class ShortcutIndex final
+{
+public:
+  struct Chain final
+  {
+    Chain() = default;
+    Chain(uint32_t beginPointId, uint32_t endPointId, double forwardWeight, double backwardWeight)
+      : m_beginPointId(beginPointId)
+      , m_endPointId(endPointId)
+      , m_forwardWeight(forwardWeight)
+      , m_backwardWeight(backwardWeight)
+    {
+    }
+
+    bool operator==(Chain const & rhs) const
+    {
+      return m_beginPointId == rhs.m_beginPointId && m_endPointId == rhs.m_endPointId &&
+             m_forwardWeight == rhs.m_forwardWeight && m_backwardWeight == rhs.m_backwardWeight;
+    }
+
+    uint32_t m_beginPointId = 0;
+    uint32_t m_endPointId = 0;
+    // Time in seconds it takes to pass the chain from |m_beginPointId| to |m_endPointId|.
+    double m_forwardWeight = 0.0;
+    // Time in seconds it takes to pass the chain from |m_endPointId| to |m_beginPointId|.
+    double m_backwardWeight = 0.0;
+  };
+
+  // |chains| should be sorted by point ids and should not overlap.
+  void SetChains(uint32_t featureId, std::vector<Chain> && chains);
+
+  bool IsEmpty() const { return m_chains.empty(); }
+  size_t GetNumFeatures() const { return m_chains.size(); }
+
+  // Returns true and fills |weight| if there is a chain of |featureId| between |fromPointId| and
+  // |toPointId|. |weight| is the time of passing the chain from |fromPointId| to |toPointId|.
+  bool GetWeight(uint32_t featureId, uint32_t fromPointId, uint32_t toPointId,
+                 double & weight) const;
+
+  template <typename Fn>
+  void ForEachFeature(Fn && fn) const
+  {
+    for (auto const & kv : m_chains)
+      fn(kv.first, kv.second);
+  }
+
+  bool operator==(ShortcutIndex const & rhs) const { return m_chains == rhs.m_chains; }
+
+private:
+  // Feature id to sorted chains of the feature.
+  std::unordered_map<uint32_t, std::vector<Chain>> m_chains;
+};
+
+// Fills |index| with the weights of all the chains of |graph| which consist of two or more
+// segments. Weights are calculated with |estimator|.
+void BuildShortcutIndex(IndexGraph & graph, EdgeEstimator const & estimator,
+                        ShortcutIndex & index);
+
+// Returns the set of segments which shortcut edges should not pass over while looking
+// for a route between |stops|. A segment next to (or previous to) a stop is kept too, because
+// fake edges of IndexGraphStarter are attached to a real segment from its neighbors.
+std::set<Segment> MakeShortcutPins(std::vector<Segment> const & stops);
+}  // namespace routing
@@ -0,0 +1,8 @@
+#include "routing/shortcut_serialization.hpp"
+
+namespace routing
+{
+// static
+uint32_t const ShortcutSerializer::kLatestVersion = 0;
+double constexpr ShortcutSerializer::kWeightPrecision;
+}  // namespace routing
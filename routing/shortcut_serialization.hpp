@@ -0,0 +1,115 @@
+#pragma once
+
+#include "routing/shortcut_index.hpp"
+
+#include "coding/reader.hpp"
+#include "coding/varint.hpp"
+#include "coding/write_to_sink.hpp"
+
+#include "base/assert.hpp"
+#include "base/checked_cast.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace routing
+{
+// Section format:
+// header: uint32_t version
+// varuint: number of features
+// for every feature (sorted by feature id):
+//   varuint: feature id delta
+//   varuint: number of chains
+//   for every chain: varuints with begin point id delta, chain length in points and
+//   forward and backward weights in kWeightPrecision fractions of a second.
+class ShortcutSerializer final
+{
+public:
+  ShortcutSerializer() = delete;
+
+  template <class Sink>
+  static void Serialize(ShortcutIndex const & index, Sink & sink)
+  {
+    WriteToSink(sink, kLatestVersion);
+
+    std::vector<std::pair<uint32_t, std::vector<ShortcutIndex::Chain> const *>> features;
+    features.reserve(index.GetNumFeatures());
+    index.ForEachFeature([&](uint32_t featureId, std::vector<ShortcutIndex::Chain> const & chains) {
+      features.emplace_back(featureId, &chains);
+    });
+    std::sort(features.begin(), features.end());
+
+    WriteVarUint(sink, static_cast<uint64_t>(features.size()));
+    uint32_t prevFeatureId = 0;
+    for (auto const & feature : features)
+    {
+      WriteVarUint(sink, feature.first - prevFeatureId);
+      prevFeatureId = feature.first;
+
+      std::vector<ShortcutIndex::Chain> const & chains = *feature.second;
+      WriteVarUint(sink, static_cast<uint64_t>(chains.size()));
+      uint32_t prevPointId = 0;
+      for (auto const & chain : chains)
+      {
+        CHECK_GREATER_OR_EQUAL(chain.m_beginPointId, prevPointId, ());
+        CHECK_GREATER(chain.m_endPointId, chain.m_beginPointId, ());
+        WriteVarUint(sink, chain.m_beginPointId - prevPointId);
+        WriteVarUint(sink, chain.m_endPointId - chain.m_beginPointId);
+        WriteVarUint(sink, EncodeWeight(chain.m_forwardWeight));
+        WriteVarUint(sink, EncodeWeight(chain.m_backwardWeight));
+        prevPointId = chain.m_endPointId;
+      }
+    }
+  }
+
+  template <class Source>
+  static void Deserialize(Source & src, ShortcutIndex & index)
+  {
+    uint32_t const version = ReadPrimitiveFromSource<uint32_t>(src);
+    CHECK_EQUAL(version, kLatestVersion, ());
+
+    auto const numFeatures = ReadVarUint<uint64_t>(src);
+    uint32_t featureId = 0;
+    for (uint64_t i = 0; i < numFeatures; ++i)
+    {
+      featureId += ReadVarUint<uint32_t>(src);
+
+      auto const numChains = ReadVarUint<uint64_t>(src);
+      std::vector<ShortcutIndex::Chain> chains;
+      chains.reserve(base::checked_cast<size_t>(numChains));
+      uint32_t pointId = 0;
+      for (uint64_t j = 0; j < numChains; ++j)
+      {
+        uint32_t const beginPointId = pointId + ReadVarUint<uint32_t>(src);
+        uint32_t const endPointId = beginPointId + ReadVarUint<uint32_t>(src);
+        double const forwardWeight = DecodeWeight(ReadVarUint<uint32_t>(src));
+        double const backwardWeight = DecodeWeight(ReadVarUint<uint32_t>(src));
+        chains.emplace_back(beginPointId, endPointId, forwardWeight, backwardWeight);
+        pointId = endPointId;
+      }
+
+      index.SetChains(featureId, std::move(chains));
+    }
+  }
+
+private:
+  // Weights are rounded up so that a stored weight is never less than the real one and
+  // the A* heuristic stays admissible.
+  static uint32_t EncodeWeight(double weight)
+  {
+    CHECK_GREATER_OR_EQUAL(weight, 0.0, ());
+    return base::checked_cast<uint32_t>(static_cast<uint64_t>(std::ceil(weight * kWeightPrecision)));
+  }
+
+  static double DecodeWeight(uint32_t weight)
+  {
+    return static_cast<double>(weight) / kWeightPrecision;
+  }
+
+  static uint32_t const kLatestVersion;
+  static double constexpr kWeightPrecision = 10.0;
+};
+}  // namespace routing
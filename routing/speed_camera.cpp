@@ -13,6 +13,9 @@
 #include "base/math.hpp"
 
 #include "std/limits.hpp"
+#include "std/utility.hpp"
+
+#include "defines.hpp"
 
 namespace
 {
@@ -24,6 +27,9 @@ namespace routing
 {
 uint8_t const kNoSpeedCamera = numeric_limits<uint8_t>::max();
 
+// static
+uint32_t const SpeedCamerasSerializer::kLatestVersion = 0;
+
 uint8_t ReadCameraRestriction(FeatureType & ft)
 {
   using feature::Metadata;
@@ -61,4 +67,70 @@ uint8_t CheckCameraInPoint(m2::PointD const & point, Index const & index)
                       scales::GetUpperScale());
   return speedLimit;
 }
+
+bool FindSpeedCamerasOnRoute(vector<m2::PointD> const & points, Index const & index,
+                             vector<SpeedCameraRestriction> & cameras)
+{
+  cameras.clear();
+  if (points.empty())
+    return true;
+
+  m2::RectD rect;
+  for (auto const & point : points)
+    rect.Add(point);
+  rect.Inflate(kCoordinateEqualityDelta, kCoordinateEqualityDelta);
+
+  // Points of the route by x to match cameras to them by a binary search.
+  vector<pair<double, size_t>> xs;
+  xs.reserve(points.size());
+  for (size_t i = 0; i < points.size(); ++i)
+    xs.emplace_back(points[i].x, i);
+  sort(xs.begin(), xs.end());
+
+  vector<shared_ptr<MwmInfo>> infos;
+  index.GetMwmsInfo(infos);
+  vector<SpeedCamera> mwmCameras;
+  for (auto const & info : infos)
+  {
+    if (info->GetType() != MwmInfo::COUNTRY || !info->m_limitRect.IsIntersect(rect))
+      continue;
+
+    auto const handle = index.GetMwmHandleById(MwmSet::MwmId(info));
+    if (!handle.IsAlive())
+      continue;
+
+    auto const * value = handle.GetValue<MwmValue>();
+    if (!value->m_cont.IsExist(SPEED_CAMERAS_FILE_TAG))
+      return false;
+
+    auto reader = value->m_cont.GetReader(SPEED_CAMERAS_FILE_TAG);
+    ReaderSource<FilesContainerR::TReader> src(reader);
+    SpeedCamerasSerializer::Deserialize(src, mwmCameras);
+
+    for (auto const & camera : mwmCameras)
+    {
+      if (!rect.IsPointInside(camera.m_point))
+        continue;
+
+      auto it = lower_bound(xs.begin(), xs.end(),
+                            make_pair(camera.m_point.x - kCoordinateEqualityDelta, size_t{0}));
+      for (; it != xs.end() && it->first <= camera.m_point.x + kCoordinateEqualityDelta; ++it)
+      {
+        if (my::AlmostEqualAbs(points[it->second].y, camera.m_point.y, kCoordinateEqualityDelta))
+          cameras.emplace_back(it->second, camera.m_maxSpeedKmH);
+      }
+    }
+  }
+
+  sort(cameras.begin(), cameras.end(),
+       [](SpeedCameraRestriction const & lhs, SpeedCameraRestriction const & rhs) {
+         return lhs.m_index < rhs.m_index;
+       });
+  cameras.erase(unique(cameras.begin(), cameras.end(),
+                       [](SpeedCameraRestriction const & lhs, SpeedCameraRestriction const & rhs) {
+                         return lhs.m_index == rhs.m_index;
+                       }),
+                cameras.end());
+  return true;
+}
 }  // namespace routing
@@ -1,14 +1,114 @@
 #pragma once
 
+#include "coding/point_to_integer.hpp"
+#include "coding/reader.hpp"
+#include "coding/varint.hpp"
+#include "coding/write_to_sink.hpp"
+
 #include "geometry/point2d.hpp"
 
+#include "base/assert.hpp"
+#include "base/checked_cast.hpp"
+
+#include "std/algorithm.hpp"
 #include "std/cstdint.hpp"
+#include "std/limits.hpp"
+#include "std/vector.hpp"
 
+class FeatureType;
 class Index;
 
 namespace routing
 {
 extern uint8_t const kNoSpeedCamera;
 
+struct SpeedCameraRestriction
+{
+  size_t m_index;  // Index of a polyline point where camera is located.
+  uint8_t m_maxSpeedKmH;  // Maximum speed allowed by the camera.
+
+  SpeedCameraRestriction(size_t index, uint8_t maxSpeed) : m_index(index), m_maxSpeedKmH(maxSpeed) {}
+  SpeedCameraRestriction() : m_index(0), m_maxSpeedKmH(numeric_limits<uint8_t>::max()) {}
+};
+
+// A speed camera of an mwm, |m_maxSpeedKmH| is zero when the speed is unknown.
+struct SpeedCamera
+{
+  SpeedCamera() = default;
+  SpeedCamera(m2::PointD const & point, uint8_t maxSpeedKmH)
+    : m_point(point), m_maxSpeedKmH(maxSpeedKmH)
+  {
+  }
+
+  m2::PointD m_point;
+  uint8_t m_maxSpeedKmH = 0;
+};
+
+// Section with all speed cameras of an mwm, it's read at once when a route is built,
+// so cameras aren't searched among features during the guidance.
+//
+// Section format:
+// uint32_t version, varuint number of cameras,
+// cameras in ascending order of x: varuint delta of x, varuint zigzag delta of y
+// (coordinates of POINT_COORD_BITS bits), uint8_t max speed.
+class SpeedCamerasSerializer final
+{
+public:
+  static uint32_t const kLatestVersion;
+
+  template <class Sink>
+  static void Serialize(Sink & sink, vector<SpeedCamera> const & cameras)
+  {
+    vector<pair<m2::PointU, uint8_t>> points;
+    points.reserve(cameras.size());
+    for (auto const & camera : cameras)
+      points.emplace_back(PointD2PointU(camera.m_point, POINT_COORD_BITS), camera.m_maxSpeedKmH);
+    sort(points.begin(), points.end(), [](pair<m2::PointU, uint8_t> const & lhs,
+                                          pair<m2::PointU, uint8_t> const & rhs) {
+      return lhs.first.x < rhs.first.x;
+    });
+
+    WriteToSink(sink, kLatestVersion);
+    WriteVarUint(sink, static_cast<uint64_t>(points.size()));
+    m2::PointU prev(0, 0);
+    for (auto const & point : points)
+    {
+      WriteVarUint(sink, point.first.x - prev.x);
+      WriteVarInt(sink, static_cast<int64_t>(point.first.y) - static_cast<int64_t>(prev.y));
+      WriteToSink(sink, point.second);
+      prev = point.first;
+    }
+  }
+
+  template <class Source>
+  static void Deserialize(Source & src, vector<SpeedCamera> & cameras)
+  {
+    uint32_t const version = ReadPrimitiveFromSource<uint32_t>(src);
+    CHECK_EQUAL(version, kLatestVersion, ());
+
+    cameras.resize(base::checked_cast<size_t>(ReadVarUint<uint64_t>(src)));
+    m2::PointU prev(0, 0);
+    for (auto & camera : cameras)
+    {
+      m2::PointU point;
+      point.x = prev.x + ReadVarUint<uint32_t>(src);
+      point.y = static_cast<uint32_t>(static_cast<int64_t>(prev.y) + ReadVarInt<int64_t>(src));
+      camera.m_point = PointU2PointD(point, POINT_COORD_BITS);
+      camera.m_maxSpeedKmH = ReadPrimitiveFromSource<uint8_t>(src);
+      prev = point;
+    }
+  }
+};
+
+// Returns the max speed of a speed camera feature, zero when it's unknown.
+uint8_t ReadCameraRestriction(FeatureType & ft);
+
 uint8_t CheckCameraInPoint(m2::PointD const & point, Index const & index);
+
+// Finds cameras at |points| of a route by speed camera sections of mwms around the points,
+// |cameras| are in ascending order of indices of the points. Returns false when some of
+// the mwms has no speed camera section, cameras should be checked by CheckCameraInPoint()
+// then.
+bool FindSpeedCamerasOnRoute(vector<m2::PointD> const & points, Index const & index,
+                             vector<SpeedCameraRestriction> & cameras);
 }  // namespace routing
@@ -0,0 +1,73 @@
+#include "routing/speed_profiles.hpp"
+
+#include "base/assert.hpp"
+#include "base/checked_cast.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace std;
+
+namespace routing
+{
+// static
+uint32_t constexpr SpeedProfiles::kSecondsInDay;
+uint32_t constexpr SpeedProfiles::kBucketDurationSec;
+size_t constexpr SpeedProfiles::kBucketsCount;
+uint8_t constexpr SpeedProfiles::kMaxFactor;
+
+// static
+uint8_t SpeedProfiles::QuantizeFactor(double factor)
+{
+  // Zero factor is not allowed: there's no infinite time to pass a segment.
+  double const value = round(factor * kMaxFactor);
+  return static_cast<uint8_t>(max(1.0, min(value, static_cast<double>(kMaxFactor))));
+}
+
+uint32_t SpeedProfiles::AddProfile(Profile const & profile)
+{
+  for (auto const factor : profile)
+  {
+    CHECK_GREATER(factor, 0, ());
+    CHECK_LESS_OR_EQUAL(factor, kMaxFactor, ());
+  }
+
+  m_profiles.push_back(profile);
+  return base::checked_cast<uint32_t>(m_profiles.size() - 1);
+}
+
+void SpeedProfiles::SetSegmentProfile(Segment const & segment, uint32_t profileIdx)
+{
+  CHECK_LESS(profileIdx, m_profiles.size(), ());
+  uint64_t const key = GetKey(segment);
+  CHECK(m_keys.empty() || m_keys.back() < key, (segment));
+
+  m_keys.push_back(key);
+  m_profileIds.push_back(profileIdx);
+}
+
+double SpeedProfiles::GetSpeedFactor(Segment const & segment, uint32_t timeOfDaySec) const
+{
+  auto const it = lower_bound(m_keys.cbegin(), m_keys.cend(), GetKey(segment));
+  if (it == m_keys.cend() || *it != GetKey(segment))
+    return 1.0;
+
+  Profile const & profile = m_profiles[m_profileIds[distance(m_keys.cbegin(), it)]];
+
+  // Factors of buckets are the factors at the middles of buckets.
+  uint32_t const time =
+      (timeOfDaySec % kSecondsInDay + kSecondsInDay - kBucketDurationSec / 2) % kSecondsInDay;
+  size_t const prev = time / kBucketDurationSec;
+  size_t const next = (prev + 1) % kBucketsCount;
+  double const part = static_cast<double>(time % kBucketDurationSec) / kBucketDurationSec;
+  return (profile[prev] + (profile[next] - profile[prev]) * part) / kMaxFactor;
+}
+
+// static
+uint64_t SpeedProfiles::GetKey(Segment const & segment)
+{
+  return (static_cast<uint64_t>(segment.GetFeatureId()) << 32) |
+         (static_cast<uint64_t>(segment.GetSegmentIdx()) << 1) |
+         (segment.IsForward() ? 1 : 0);
+}
+}  // namespace routing
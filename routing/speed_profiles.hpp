@@ -0,0 +1,55 @@
+#pragma once
+
+#include "routing/segment.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace routing
+{
+// Historical speeds of road segments by the time of the day. A profile keeps factors of the free
+// flow speed for the 15 minute buckets of a day. Segments refer to profiles by index and equal
+// profiles are stored once, so the memory is bounded by the number of distinct profiles.
+class SpeedProfiles final
+{
+public:
+  static uint32_t constexpr kSecondsInDay = 24 * 60 * 60;
+  static uint32_t constexpr kBucketDurationSec = 15 * 60;
+  static size_t constexpr kBucketsCount = kSecondsInDay / kBucketDurationSec;
+  // A bucket keeps the factor in percents of the free flow speed. Factors are not greater than
+  // one so time-dependent weights are not less than static ones and heuristics stay admissible.
+  static uint8_t constexpr kMaxFactor = 100;
+
+  using Profile = std::array<uint8_t, kBucketsCount>;
+
+  // Returns the quantized value of |factor| for a profile bucket.
+  static uint8_t QuantizeFactor(double factor);
+
+  // Returns the index of the added |profile|. Equal profiles should be added once.
+  uint32_t AddProfile(Profile const & profile);
+
+  // Segments should be added in ascending order of (feature id, segment idx, is forward).
+  void SetSegmentProfile(Segment const & segment, uint32_t profileIdx);
+
+  // Returns the factor of the free flow speed of |segment| at |timeOfDaySec| seconds after
+  // midnight. Factors are linearly interpolated between the middles of buckets.
+  // Returns 1.0 if there's no profile for |segment|.
+  double GetSpeedFactor(Segment const & segment, uint32_t timeOfDaySec) const;
+
+  bool IsEmpty() const { return m_keys.empty(); }
+  size_t GetNumProfiles() const { return m_profiles.size(); }
+  size_t GetNumSegments() const { return m_keys.size(); }
+
+private:
+  friend class SpeedProfilesSerializer;
+
+  static uint64_t GetKey(Segment const & segment);
+
+  std::vector<Profile> m_profiles;
+  // Keys of the segments with profiles in ascending order and the indices of their profiles.
+  std::vector<uint64_t> m_keys;
+  std::vector<uint32_t> m_profileIds;
+};
+}  // namespace routing
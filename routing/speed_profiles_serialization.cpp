@@ -0,0 +1,7 @@
+#include "routing/speed_profiles_serialization.hpp"
+
+namespace routing
+{
+// static
+uint32_t const SpeedProfilesSerializer::kLatestVersion = 0;
+}  // namespace routing
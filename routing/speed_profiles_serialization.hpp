@@ -0,0 +1,73 @@
+#pragma once
+
+#include "routing/speed_profiles.hpp"
+
+#include "coding/reader.hpp"
+#include "coding/varint.hpp"
+#include "coding/write_to_sink.hpp"
+
+#include "base/assert.hpp"
+#include "base/checked_cast.hpp"
+
+#include <cstdint>
+
+namespace routing
+{
+// Section format:
+// header: uint32_t version
+// varuint number of profiles, SpeedProfiles::kBucketsCount bytes of every profile
+// varuint number of segments, for every segment varuint delta of its key and varuint index of
+// its profile
+class SpeedProfilesSerializer final
+{
+public:
+  SpeedProfilesSerializer() = delete;
+
+  template <class Sink>
+  static void Serialize(Sink & sink, SpeedProfiles const & speedProfiles)
+  {
+    WriteToSink(sink, kLatestVersion);
+
+    WriteVarUint(sink, base::checked_cast<uint32_t>(speedProfiles.m_profiles.size()));
+    for (auto const & profile : speedProfiles.m_profiles)
+      sink.Write(profile.data(), profile.size());
+
+    WriteVarUint(sink, base::checked_cast<uint32_t>(speedProfiles.m_keys.size()));
+    uint64_t prevKey = 0;
+    for (size_t i = 0; i < speedProfiles.m_keys.size(); ++i)
+    {
+      uint64_t const key = speedProfiles.m_keys[i];
+      WriteVarUint(sink, key - prevKey);
+      WriteVarUint(sink, speedProfiles.m_profileIds[i]);
+      prevKey = key;
+    }
+  }
+
+  template <class Source>
+  static void Deserialize(Source & src, SpeedProfiles & speedProfiles)
+  {
+    uint32_t const version = ReadPrimitiveFromSource<uint32_t>(src);
+    CHECK_EQUAL(version, kLatestVersion, ());
+
+    auto const numProfiles = ReadVarUint<uint32_t>(src);
+    speedProfiles.m_profiles.resize(numProfiles);
+    for (auto & profile : speedProfiles.m_profiles)
+      src.Read(profile.data(), profile.size());
+
+    auto const numSegments = ReadVarUint<uint32_t>(src);
+    speedProfiles.m_keys.resize(numSegments);
+    speedProfiles.m_profileIds.resize(numSegments);
+    uint64_t key = 0;
+    for (uint32_t i = 0; i < numSegments; ++i)
+    {
+      key += ReadVarUint<uint64_t>(src);
+      speedProfiles.m_keys[i] = key;
+      speedProfiles.m_profileIds[i] = ReadVarUint<uint32_t>(src);
+      CHECK_LESS(speedProfiles.m_profileIds[i], numProfiles, ());
+    }
+  }
+
+private:
+  static uint32_t const kLatestVersion;
+};
+}  // namespace routing
@@ -0,0 +1,63 @@
+#include "routing/subroute_cache.hpp"
+
+#include "base/stl_helpers.hpp"
+
+#include <algorithm>
+
+using namespace std;
+
+namespace routing
+{
+SubrouteCache::SubrouteCache(size_t capacity)
+  // One shard keeps the whole capacity for long subroutes, the router is used by one thread.
+  : m_cache(capacity, 1 /* shardsCount */)
+{
+}
+
+shared_ptr<SubrouteCache::Entry const> SubrouteCache::Find(Key const & key,
+                                                           GetMwmStateFn const & getMwmState)
+{
+  shared_ptr<Entry const> entry;
+  if (!m_cache.Find(key, entry))
+    return nullptr;
+
+  for (size_t i = 0; i < entry->m_numMwmIds.size(); ++i)
+  {
+    if (!(getMwmState(entry->m_numMwmIds[i]) == entry->m_mwmStates[i]))
+    {
+      m_cache.Erase(key);
+      return nullptr;
+    }
+  }
+  return entry;
+}
+
+void SubrouteCache::Put(Key const & key, vector<Segment> const & segments,
+                        GetMwmStateFn const & getMwmState)
+{
+  auto entry = make_shared<Entry>();
+  for (auto const & segment : segments)
+  {
+    if (segment.GetMwmId() == kFakeNumMwmId)
+      continue;
+    entry->m_segments.push_back(segment);
+    entry->m_numMwmIds.push_back(segment.GetMwmId());
+  }
+  my::SortUnique(entry->m_segments);
+  my::SortUnique(entry->m_numMwmIds);
+
+  entry->m_mwmStates.reserve(entry->m_numMwmIds.size());
+  for (auto const numMwmId : entry->m_numMwmIds)
+    entry->m_mwmStates.push_back(getMwmState(numMwmId));
+
+  m_cache.Put(key, entry);
+}
+
+size_t SubrouteCache::KeyHash::operator()(Key const & key) const
+{
+  hash<Segment> const segmentHash;
+  size_t const start = segmentHash(key.m_start);
+  size_t const finish = segmentHash(key.m_finish);
+  return (start * 31 + finish) * 2 + (key.m_strictForward ? 1 : 0);
+}
+}  // namespace routing
@@ -0,0 +1,100 @@
+#pragma once
+
+#include "routing/num_mwm_id.hpp"
+#include "routing/segment.hpp"
+
+#include "indexer/mwm_set.hpp"
+
+#include "base/concurrent_lru_cache.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace routing
+{
+// Real segments of recently calculated subroutes. Subroutes are found by the segments their
+// checkpoints are snapped to, so repeated requests and requests with nearby checkpoints get
+// the subroute without a search over the whole graph. An entry is valid while the data and
+// the traffic of all the mwms the subroute passes are the same as when it was calculated.
+// Every router keeps its own cache, so the vehicle type is not a part of the key.
+class SubrouteCache final
+{
+public:
+  struct Key
+  {
+    Key(Segment const & start, Segment const & finish, bool strictForward)
+      : m_start(start), m_finish(finish), m_strictForward(strictForward)
+    {
+    }
+
+    bool operator==(Key const & rhs) const
+    {
+      return m_start == rhs.m_start && m_finish == rhs.m_finish &&
+             m_strictForward == rhs.m_strictForward;
+    }
+
+    Segment m_start;
+    Segment m_finish;
+    bool m_strictForward;
+  };
+
+  struct MwmState
+  {
+    bool operator==(MwmState const & rhs) const
+    {
+      return m_mwmId == rhs.m_mwmId && m_trafficVersion == rhs.m_trafficVersion;
+    }
+
+    // Changes when the mwm is updated or reregistered.
+    MwmSet::MwmId m_mwmId;
+    // See TrafficStash::GetVersion().
+    uint64_t m_trafficVersion = 0;
+  };
+
+  using GetMwmStateFn = std::function<MwmState(NumMwmId numMwmId)>;
+
+  struct Entry
+  {
+    // Sorted real segments of the subroute.
+    std::vector<Segment> m_segments;
+    std::vector<NumMwmId> m_numMwmIds;
+    // States of |m_numMwmIds| when the subroute was calculated.
+    std::vector<MwmState> m_mwmStates;
+  };
+
+  // |capacity| is the total number of segments of the cached subroutes.
+  explicit SubrouteCache(size_t capacity);
+
+  // Returns nullptr if there's no subroute for |key| or the state of one of its mwms
+  // has changed. Outdated subroutes are erased.
+  std::shared_ptr<Entry const> Find(Key const & key, GetMwmStateFn const & getMwmState);
+  // Caches |segments| of a subroute for |key|. Parts of real segments should be converted to
+  // the real ones (see IndexGraphStarter::ConvertToReal()), fake segments are skipped.
+  void Put(Key const & key, std::vector<Segment> const & segments,
+           GetMwmStateFn const & getMwmState);
+  void Clear() { m_cache.Clear(); }
+
+  size_t GetSize() const { return m_cache.GetSize(); }
+  uint64_t GetAccessCount() const { return m_cache.GetAccessCount(); }
+  uint64_t GetMissCount() const { return m_cache.GetMissCount(); }
+
+private:
+  struct KeyHash
+  {
+    size_t operator()(Key const & key) const;
+  };
+
+  struct EntryWeigher
+  {
+    size_t operator()(Key const & /* key */, std::shared_ptr<Entry const> const & entry) const
+    {
+      return entry->m_segments.size();
+    }
+  };
+
+  my::ConcurrentLRUCache<Key, std::shared_ptr<Entry const>, KeyHash, EntryWeigher> m_cache;
+};
+}  // namespace routing
@@ -1,11 +1,32 @@
 #include "routing/traffic_stash.hpp"
 
-#include "base/checked_cast.hpp"
+#include "base/logging.hpp"
 
 #include <map>
 
 namespace routing
 {
+// TrafficStash::MwmTraffic ------------------------------------------------------------------------
+bool TrafficStash::MwmTraffic::Assign(std::shared_ptr<traffic::TrafficInfo::Coloring> coloring)
+{
+  CHECK(coloring, ());
+  if (coloring == m_coloring)
+    return false;
+
+  m_coloring = std::move(coloring);
+  m_speedGroups = traffic::DenseColoring(*m_coloring);
+  return true;
+}
+
+traffic::SpeedGroup TrafficStash::MwmTraffic::GetSpeedGroup(Segment const & segment) const
+{
+  return m_speedGroups.GetSpeedGroup(
+      segment.GetFeatureId(), segment.GetSegmentIdx(),
+      segment.IsForward() ? traffic::TrafficInfo::RoadSegmentId::kForwardDirection
+                          : traffic::TrafficInfo::RoadSegmentId::kReverseDirection);
+}
+
+// TrafficStash ------------------------------------------------------------------------------------
 TrafficStash::TrafficStash(traffic::TrafficCache const & source, shared_ptr<NumMwmIds> numMwmIds)
   : m_source(source), m_numMwmIds(std::move(numMwmIds))
 {
@@ -15,41 +36,70 @@ TrafficStash::TrafficStash(traffic::TrafficCache const & source, shared_ptr<NumM
 traffic::SpeedGroup TrafficStash::GetSpeedGroup(Segment const & segment) const
 {
   auto itMwm = m_mwmToTraffic.find(segment.GetMwmId());
-  if (itMwm == m_mwmToTraffic.cend())
-    return traffic::SpeedGroup::Unknown;
-
-  auto const & coloring = itMwm->second;
-  auto const itSeg = coloring->find(traffic::TrafficInfo::RoadSegmentId(
-      segment.GetFeatureId(), base::asserted_cast<uint16_t>(segment.GetSegmentIdx()),
-      segment.IsForward() ? traffic::TrafficInfo::RoadSegmentId::kForwardDirection
-                          : traffic::TrafficInfo::RoadSegmentId::kReverseDirection));
-
-  if (itSeg == coloring->cend())
+  if (itMwm == m_mwmToTraffic.cend() || !itMwm->second.IsActive())
     return traffic::SpeedGroup::Unknown;
 
-  return itSeg->second;
+  return itMwm->second.GetSpeedGroup(segment);
 }
 
 void TrafficStash::SetColoring(NumMwmId numMwmId,
                                std::shared_ptr<traffic::TrafficInfo::Coloring> coloring)
 {
-  m_mwmToTraffic[numMwmId] = coloring;
+  MwmTraffic & traffic = m_mwmToTraffic[numMwmId];
+  if (traffic.Assign(std::move(coloring)))
+    traffic.SetVersion(++m_lastVersion);
+  traffic.SetActive(true);
 }
 
 bool TrafficStash::Has(NumMwmId numMwmId) const
 {
-  return m_mwmToTraffic.find(numMwmId) != m_mwmToTraffic.cend();
+  auto const it = m_mwmToTraffic.find(numMwmId);
+  return it != m_mwmToTraffic.cend() && it->second.IsActive();
+}
+
+uint64_t TrafficStash::GetVersion(NumMwmId numMwmId) const
+{
+  auto const it = m_mwmToTraffic.find(numMwmId);
+  if (it == m_mwmToTraffic.cend() || !it->second.IsActive())
+    return 0;
+  return it->second.GetVersion();
 }
 
 void TrafficStash::CopyTraffic()
 {
   std::map<MwmSet::MwmId, std::shared_ptr<traffic::TrafficInfo::Coloring>> copy;
   m_source.CopyTraffic(copy);
+
+  size_t updated = 0;
   for (auto const & kv : copy)
   {
     auto const numMwmId = m_numMwmIds->GetId(kv.first.GetInfo()->GetLocalFile().GetCountryFile());
     CHECK(kv.second, ());
-    SetColoring(numMwmId, kv.second);
+    MwmTraffic & traffic = m_mwmToTraffic[numMwmId];
+    if (traffic.Assign(kv.second))
+    {
+      traffic.SetVersion(++m_lastVersion);
+      ++updated;
+    }
+    traffic.SetActive(true);
   }
+
+  // Mwms which have no traffic anymore are dropped to release memory.
+  for (auto it = m_mwmToTraffic.begin(); it != m_mwmToTraffic.end();)
+  {
+    if (it->second.IsActive())
+      ++it;
+    else
+      it = m_mwmToTraffic.erase(it);
+  }
+
+  if (updated != 0)
+    LOG(LDEBUG, ("Traffic is updated for", updated, "of", copy.size(), "mwms"));
+}
+
+void TrafficStash::Clear()
+{
+  for (auto & kv : m_mwmToTraffic)
+    kv.second.SetActive(false);
 }
 }  // namespace routing
@@ -3,6 +3,7 @@
 #include "routing/num_mwm_id.hpp"
 #include "routing/segment.hpp"
 
+#include "traffic/dense_coloring.hpp"
 #include "traffic/traffic_cache.hpp"
 #include "traffic/traffic_info.hpp"
 
@@ -10,8 +11,10 @@
 
 #include "base/assert.hpp"
 
+#include <cstdint>
 #include <memory>
 #include <unordered_map>
+#include <vector>
 
 namespace routing
 {
@@ -42,14 +45,44 @@ public:
   traffic::SpeedGroup GetSpeedGroup(Segment const & segment) const;
   void SetColoring(NumMwmId numMwmId, std::shared_ptr<traffic::TrafficInfo::Coloring> coloring);
   bool Has(NumMwmId numMwmId) const;
+  // Returns the version of the traffic of |numMwmId|, it changes every time the speed groups of
+  // the mwm are changed. Zero means there's no traffic for the mwm.
+  uint64_t GetVersion(NumMwmId numMwmId) const;
 
 private:
+  // Speed groups of an mwm in a dense array, it's much more cache friendly than Coloring.
+  // The array is rebuilt only when the traffic cache gets a new coloring for the mwm,
+  // so unchanged mwms cost nothing at the next route calculation.
+  class MwmTraffic final
+  {
+  public:
+    // Rebuilds the speed groups if |coloring| differs from the current one.
+    // \returns true if the speed groups have been rebuilt.
+    bool Assign(std::shared_ptr<traffic::TrafficInfo::Coloring> coloring);
+    traffic::SpeedGroup GetSpeedGroup(Segment const & segment) const;
+
+    bool IsActive() const { return m_active; }
+    void SetActive(bool active) { m_active = active; }
+
+    uint64_t GetVersion() const { return m_version; }
+    void SetVersion(uint64_t version) { m_version = version; }
+
+  private:
+    std::shared_ptr<traffic::TrafficInfo::Coloring> m_coloring;
+    traffic::DenseColoring m_speedGroups;
+    // Inactive mwms keep their speed groups between route calculations but aren't visible
+    // to the estimator.
+    bool m_active = false;
+    uint64_t m_version = 0;
+  };
+
   void CopyTraffic();
 
-  void Clear() { m_mwmToTraffic.clear(); }
+  void Clear();
 
   traffic::TrafficCache const & m_source;
   shared_ptr<NumMwmIds> m_numMwmIds;
-  std::unordered_map<NumMwmId, std::shared_ptr<traffic::TrafficInfo::Coloring>> m_mwmToTraffic;
+  std::unordered_map<NumMwmId, MwmTraffic> m_mwmToTraffic;
+  uint64_t m_lastVersion = 0;
 };
 }  // namespace routing
@@ -0,0 +1,75 @@
+#include "routing/transit_graph_loader.hpp"
+
+#include "routing/routing_exceptions.hpp"
+
+#include "platform/country_file.hpp"
+
+#include "coding/file_container.hpp"
+
+#include "base/logging.hpp"
+#include "base/timer.hpp"
+
+#include "defines.hpp"
+
+#include <utility>
+
+using namespace std;
+
+namespace routing
+{
+TransitGraphLoader::TransitGraphLoader(shared_ptr<NumMwmIds> numMwmIds, Index & index)
+  : m_numMwmIds(move(numMwmIds)), m_index(index)
+{
+  CHECK(m_numMwmIds, ());
+}
+
+transit::TransitSection const * TransitGraphLoader::GetTransitSection(NumMwmId numMwmId)
+{
+  auto it = m_sections.find(numMwmId);
+  if (it == m_sections.end())
+    it = m_sections.emplace(numMwmId, Load(numMwmId)).first;
+  return it->second.m_section.get();
+}
+
+uint64_t TransitGraphLoader::GetCopiedMemorySize() const
+{
+  uint64_t size = 0;
+  for (auto const & kv : m_sections)
+  {
+    auto const & section = kv.second.m_section;
+    if (section && !section->IsMapped())
+      size += section->GetSize();
+  }
+  return size;
+}
+
+TransitGraphLoader::SectionEntry TransitGraphLoader::Load(NumMwmId numMwmId)
+{
+  platform::CountryFile const & file = m_numMwmIds->GetFile(numMwmId);
+  MwmSet::MwmHandle handle = m_index.GetMwmHandleByCountryFile(file);
+  if (!handle.IsAlive())
+    MYTHROW(RoutingException, ("Can't get mwm handle for", file));
+
+  SectionEntry entry;
+  MwmValue const & mwmValue = *handle.GetValue<MwmValue>();
+  if (mwmValue.m_cont.IsExist(TRANSIT_FILE_TAG))
+  {
+    try
+    {
+      my::Timer timer;
+      entry.m_section = transit::TransitSection::Load(mwmValue.m_cont.GetReader(TRANSIT_FILE_TAG));
+      LOG(LINFO, (TRANSIT_FILE_TAG, "section for", file.GetName(), "loaded in",
+                  timer.ElapsedSeconds(), "seconds, mapped:", entry.m_section->IsMapped()));
+    }
+    catch (RootException const & e)
+    {
+      LOG(LERROR, ("Error while reading", TRANSIT_FILE_TAG, "section of", file.GetName(), ":",
+                   e.Msg()));
+    }
+  }
+  // The section may use the memory of the mwm mapping.
+  if (entry.m_section)
+    entry.m_handle = move(handle);
+  return entry;
+}
+}  // namespace routing
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "routing/num_mwm_id.hpp"
+#include "routing/transit_section.hpp"
+
+#include "indexer/index.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+
+namespace routing
+{
+// Loads transit sections of mwms on the first request, so mwms which aren't used by a route
+// cost nothing. A loaded section keeps the handle of its mwm, the memory of a mapped mwm
+// is used in place.
+class TransitGraphLoader final
+{
+public:
+  TransitGraphLoader(std::shared_ptr<NumMwmIds> numMwmIds, Index & index);
+
+  // Returns nullptr if the mwm has no transit section or the section is corrupted.
+  transit::TransitSection const * GetTransitSection(NumMwmId numMwmId);
+  // Returns the number of bytes of the loaded sections which aren't mapped.
+  uint64_t GetCopiedMemorySize() const;
+  void Clear() { m_sections.clear(); }
+
+private:
+  struct SectionEntry
+  {
+    // Alive only when there is a section.
+    MwmSet::MwmHandle m_handle;
+    // nullptr for mwms without transit.
+    std::unique_ptr<transit::TransitSection> m_section;
+  };
+
+  SectionEntry Load(NumMwmId numMwmId);
+
+  std::shared_ptr<NumMwmIds> m_numMwmIds;
+  Index & m_index;
+  std::unordered_map<NumMwmId, SectionEntry> m_sections;
+};
+}  // namespace routing
@@ -0,0 +1,331 @@
+#include "routing/transit_section.hpp"
+
+#include "coding/endianness.hpp"
+#include "coding/mmap_reader.hpp"
+
+#include "base/logging.hpp"
+#include "base/stl_add.hpp"
+
+#include <cstring>
+
+using namespace std;
+
+namespace routing
+{
+namespace transit
+{
+namespace
+{
+static_assert(sizeof(Stop) == 32, "");
+static_assert(sizeof(Gate) == 32, "");
+static_assert(sizeof(Edge) == 24, "");
+static_assert(sizeof(Line) == 24, "");
+static_assert(sizeof(Shape) == 16, "");
+static_assert(sizeof(Point) == 16, "");
+
+uint64_t constexpr kAlignment = 8;
+
+uint64_t Align(uint64_t offset) { return (offset + kAlignment - 1) / kAlignment * kAlignment; }
+
+// Offsets of the arrays of the section, every array starts at an aligned offset.
+struct Layout
+{
+  template <typename Header>
+  explicit Layout(Header const & header)
+  {
+    uint64_t offset = sizeof(Header);
+    auto const next = [&offset](uint64_t count, uint64_t size) {
+      offset = Align(offset);
+      uint64_t const result = offset;
+      offset += count * size;
+      return result;
+    };
+    m_stops = next(header.m_stopsCount, sizeof(Stop));
+    m_gates = next(header.m_gatesCount, sizeof(Gate));
+    m_edges = next(header.m_edgesCount, sizeof(Edge));
+    m_ingoingEdges = next(header.m_edgesCount, sizeof(uint32_t));
+    m_lines = next(header.m_linesCount, sizeof(Line));
+    m_shapes = next(header.m_shapesCount, sizeof(Shape));
+    m_ids = next(header.m_idsCount, sizeof(uint32_t));
+    m_points = next(header.m_pointsCount, sizeof(Point));
+    m_chars = next(header.m_charsCount, sizeof(char));
+    m_size = offset;
+  }
+
+  uint64_t m_stops;
+  uint64_t m_gates;
+  uint64_t m_edges;
+  uint64_t m_ingoingEdges;
+  uint64_t m_lines;
+  uint64_t m_shapes;
+  uint64_t m_ids;
+  uint64_t m_points;
+  uint64_t m_chars;
+  uint64_t m_size;
+};
+
+// Writes zero padding up to |offset| from |start| and then |v|.
+template <typename T>
+void WriteArray(Writer & writer, uint64_t start, uint64_t offset, vector<T> const & v)
+{
+  ASSERT_LESS_OR_EQUAL(writer.Pos() - start, offset, ());
+  uint8_t const zeros[kAlignment] = {};
+  writer.Write(zeros, static_cast<size_t>(start + offset - writer.Pos()));
+  if (!v.empty())
+    writer.Write(v.data(), v.size() * sizeof(T));
+}
+
+template <typename T>
+void SortByIdAndCheckUnique(vector<T> & v, char const * name)
+{
+  sort(v.begin(), v.end(), [](T const & lhs, T const & rhs) { return lhs.m_id < rhs.m_id; });
+  for (size_t i = 1; i < v.size(); ++i)
+  {
+    if (v[i - 1].m_id == v[i].m_id)
+      MYTHROW(TransitSectionException, ("Duplicate id of", name, v[i].m_id));
+  }
+}
+
+bool IsRangeValid(uint64_t offset, uint64_t count, uint64_t size)
+{
+  return offset <= size && count <= size - offset;
+}
+
+uint32_t CheckedSize(size_t size)
+{
+  if (size > numeric_limits<uint32_t>::max())
+    MYTHROW(TransitSectionException, ("Too much transit data:", size));
+  return static_cast<uint32_t>(size);
+}
+}  // namespace
+
+void TransitSectionBuilder::AddStop(uint32_t id, uint32_t featureId, m2::PointD const & point,
+                                    vector<uint32_t> const & lineIds)
+{
+  Stop stop = {};
+  stop.m_id = id;
+  stop.m_featureId = featureId;
+  stop.m_lineIdsOffset = CheckedSize(m_ids.size());
+  stop.m_lineIdsCount = CheckedSize(lineIds.size());
+  stop.m_x = point.x;
+  stop.m_y = point.y;
+  m_ids.insert(m_ids.end(), lineIds.begin(), lineIds.end());
+  m_stops.push_back(stop);
+}
+
+void TransitSectionBuilder::AddGate(uint32_t featureId, uint32_t stopId, float weight,
+                                    bool entrance, bool exit, m2::PointD const & point)
+{
+  Gate gate = {};
+  gate.m_featureId = featureId;
+  gate.m_stopId = stopId;
+  gate.m_weight = weight;
+  gate.m_entrance = entrance ? 1 : 0;
+  gate.m_exit = exit ? 1 : 0;
+  gate.m_x = point.x;
+  gate.m_y = point.y;
+  m_gates.push_back(gate);
+}
+
+void TransitSectionBuilder::AddEdge(uint32_t stop1Id, uint32_t stop2Id, uint32_t lineId,
+                                    uint32_t shapeId, float weight, bool transfer)
+{
+  Edge edge = {};
+  edge.m_stop1Id = stop1Id;
+  edge.m_stop2Id = stop2Id;
+  edge.m_lineId = lineId;
+  edge.m_shapeId = shapeId;
+  edge.m_weight = weight;
+  edge.m_transfer = transfer ? 1 : 0;
+  m_edges.push_back(edge);
+}
+
+void TransitSectionBuilder::AddLine(uint32_t id, string const & title,
+                                    vector<uint32_t> const & stopIds)
+{
+  Line line = {};
+  line.m_id = id;
+  line.m_stopIdsOffset = CheckedSize(m_ids.size());
+  line.m_stopIdsCount = CheckedSize(stopIds.size());
+  line.m_titleOffset = CheckedSize(m_chars.size());
+  line.m_titleSize = CheckedSize(title.size());
+  m_ids.insert(m_ids.end(), stopIds.begin(), stopIds.end());
+  m_chars += title;
+  m_lines.push_back(line);
+}
+
+void TransitSectionBuilder::AddShape(uint32_t id, vector<m2::PointD> const & points)
+{
+  Shape shape = {};
+  shape.m_id = id;
+  shape.m_pointsOffset = CheckedSize(m_points.size());
+  shape.m_pointsCount = CheckedSize(points.size());
+  for (auto const & p : points)
+    m_points.push_back({p.x, p.y});
+  m_shapes.push_back(shape);
+}
+
+void TransitSectionBuilder::Write(Writer & writer)
+{
+  if (IsBigEndian())
+    MYTHROW(TransitSectionException, ("Transit section is written on little endian hosts only."));
+
+  SortByIdAndCheckUnique(m_stops, "stop");
+  SortByIdAndCheckUnique(m_lines, "line");
+  SortByIdAndCheckUnique(m_shapes, "shape");
+
+  auto const checkStop = [this](uint32_t id) {
+    auto const it =
+        lower_bound(m_stops.begin(), m_stops.end(), id,
+                    [](Stop const & stop, uint32_t stopId) { return stop.m_id < stopId; });
+    if (it == m_stops.end() || it->m_id != id)
+      MYTHROW(TransitSectionException, ("Absent stop:", id));
+  };
+  for (auto const & edge : m_edges)
+  {
+    checkStop(edge.m_stop1Id);
+    checkStop(edge.m_stop2Id);
+  }
+  for (auto const & gate : m_gates)
+    checkStop(gate.m_stopId);
+
+  // Stable sorts keep the order of edges and gates of a stop from the source.
+  stable_sort(m_edges.begin(), m_edges.end(),
+              [](Edge const & lhs, Edge const & rhs) { return lhs.m_stop1Id < rhs.m_stop1Id; });
+  stable_sort(m_gates.begin(), m_gates.end(),
+              [](Gate const & lhs, Gate const & rhs) { return lhs.m_stopId < rhs.m_stopId; });
+
+  vector<uint32_t> ingoingEdges(m_edges.size());
+  for (size_t i = 0; i < ingoingEdges.size(); ++i)
+    ingoingEdges[i] = static_cast<uint32_t>(i);
+  stable_sort(ingoingEdges.begin(), ingoingEdges.end(), [this](uint32_t lhs, uint32_t rhs) {
+    return m_edges[lhs].m_stop2Id < m_edges[rhs].m_stop2Id;
+  });
+
+  TransitSection::Header header = {};
+  header.m_version = TransitSection::kVersion;
+  header.m_stopsCount = CheckedSize(m_stops.size());
+  header.m_gatesCount = CheckedSize(m_gates.size());
+  header.m_edgesCount = CheckedSize(m_edges.size());
+  header.m_linesCount = CheckedSize(m_lines.size());
+  header.m_shapesCount = CheckedSize(m_shapes.size());
+  header.m_idsCount = CheckedSize(m_ids.size());
+  header.m_pointsCount = CheckedSize(m_points.size());
+  header.m_charsCount = CheckedSize(m_chars.size());
+
+  Layout const layout(header);
+  uint64_t const start = writer.Pos();
+  writer.Write(&header, sizeof(header));
+  WriteArray(writer, start, layout.m_stops, m_stops);
+  WriteArray(writer, start, layout.m_gates, m_gates);
+  WriteArray(writer, start, layout.m_edges, m_edges);
+  WriteArray(writer, start, layout.m_ingoingEdges, ingoingEdges);
+  WriteArray(writer, start, layout.m_lines, m_lines);
+  WriteArray(writer, start, layout.m_shapes, m_shapes);
+  WriteArray(writer, start, layout.m_ids, m_ids);
+  WriteArray(writer, start, layout.m_points, m_points);
+  WriteArray(writer, start, layout.m_chars, vector<char>(m_chars.begin(), m_chars.end()));
+  ASSERT_EQUAL(writer.Pos() - start, layout.m_size, ());
+}
+
+// static
+uint16_t constexpr TransitSection::kVersion;
+
+// static
+unique_ptr<TransitSection> TransitSection::Load(ModelReaderPtr const & reader)
+{
+  if (IsBigEndian())
+    MYTHROW(TransitSectionException, ("Transit section is used on little endian hosts only."));
+
+  unique_ptr<TransitSection> section(new TransitSection());
+  if (MmapReader::GetMappedData(*reader.GetPtr()))
+  {
+    section->m_region = my::make_unique<MmapMemoryRegion>(reader);
+    section->m_isMapped = true;
+  }
+  else
+  {
+    vector<uint8_t> data(static_cast<size_t>(reader.Size()));
+    reader.Read(0, data.data(), data.size());
+    section->m_region = my::make_unique<CopiedMemoryRegion>(move(data));
+  }
+
+  if (!section->Map())
+    MYTHROW(TransitSectionException, ("Transit section is corrupted:", reader.GetName()));
+  return section;
+}
+
+vector<m2::PointD> TransitSection::GetPoints(Shape const & shape) const
+{
+  vector<m2::PointD> points;
+  points.reserve(shape.m_pointsCount);
+  for (uint32_t i = 0; i < shape.m_pointsCount; ++i)
+  {
+    Point const & p = m_points[shape.m_pointsOffset + i];
+    points.emplace_back(p.m_x, p.m_y);
+  }
+  return points;
+}
+
+bool TransitSection::Map()
+{
+  uint64_t const size = m_region->Size();
+  uint8_t const * data = m_region->ImmutableData();
+  if (size < sizeof(m_header))
+    return false;
+  memcpy(&m_header, data, sizeof(m_header));
+  if (m_header.m_version != kVersion)
+  {
+    LOG(LWARNING, ("Unknown version of transit section:", m_header.m_version));
+    return false;
+  }
+
+  Layout const layout(m_header);
+  if (layout.m_size > size)
+    return false;
+  // Arrays are used in place, so the section has to be aligned.
+  if (reinterpret_cast<uintptr_t>(data) % kAlignment != 0)
+    return false;
+
+  m_stops = reinterpret_cast<Stop const *>(data + layout.m_stops);
+  m_gates = reinterpret_cast<Gate const *>(data + layout.m_gates);
+  m_edges = reinterpret_cast<Edge const *>(data + layout.m_edges);
+  m_ingoingEdges = reinterpret_cast<uint32_t const *>(data + layout.m_ingoingEdges);
+  m_lines = reinterpret_cast<Line const *>(data + layout.m_lines);
+  m_shapes = reinterpret_cast<Shape const *>(data + layout.m_shapes);
+  m_ids = reinterpret_cast<uint32_t const *>(data + layout.m_ids);
+  m_points = reinterpret_cast<Point const *>(data + layout.m_points);
+  m_chars = reinterpret_cast<char const *>(data + layout.m_chars);
+
+  // Ranges of records are checked once, so accessors don't check them.
+  for (uint32_t i = 0; i < m_header.m_stopsCount; ++i)
+  {
+    if (!IsRangeValid(m_stops[i].m_lineIdsOffset, m_stops[i].m_lineIdsCount, m_header.m_idsCount))
+      return false;
+  }
+  for (uint32_t i = 0; i < m_header.m_linesCount; ++i)
+  {
+    Line const & line = m_lines[i];
+    if (!IsRangeValid(line.m_stopIdsOffset, line.m_stopIdsCount, m_header.m_idsCount) ||
+        !IsRangeValid(line.m_titleOffset, line.m_titleSize, m_header.m_charsCount))
+    {
+      return false;
+    }
+  }
+  for (uint32_t i = 0; i < m_header.m_shapesCount; ++i)
+  {
+    if (!IsRangeValid(m_shapes[i].m_pointsOffset, m_shapes[i].m_pointsCount,
+                      m_header.m_pointsCount))
+    {
+      return false;
+    }
+  }
+  for (uint32_t i = 0; i < m_header.m_edgesCount; ++i)
+  {
+    if (m_ingoingEdges[i] >= m_header.m_edgesCount)
+      return false;
+  }
+  return true;
+}
+}  // namespace transit
+}  // namespace routing
@@ -0,0 +1,275 @@
+#pragma once
+
+#include "coding/memory_region.hpp"
+#include "coding/writer.hpp"
+
+#include "geometry/point2d.hpp"
+
+#include "base/assert.hpp"
+#include "base/exception.hpp"
+#include "base/macros.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace routing
+{
+namespace transit
+{
+// Transit section (TRANSIT_FILE_TAG) of an mwm is a header and packed arrays of fixed size
+// little endian records, so it's used in place of a mapped mwm and nothing is decoded on
+// loading. Stops, lines and shapes are sorted by ids, edges are sorted by the first stops,
+// gates are sorted by stops and the ingoing edges are an index of edges sorted by the second
+// stops, so all lookups are binary searches. Variable size data (ids of stops of lines, ids of
+// lines of stops, points of shapes and titles) is kept in the common pools which are
+// referenced by offsets and counts.
+uint32_t constexpr kInvalidId = std::numeric_limits<uint32_t>::max();
+
+struct Stop
+{
+  uint32_t m_id;
+  // Id of a feature of the stop in the mwm or kInvalidId.
+  uint32_t m_featureId;
+  // Range of ids of lines of the stop in the pool of ids.
+  uint32_t m_lineIdsOffset;
+  uint32_t m_lineIdsCount;
+  // Mercator point.
+  double m_x;
+  double m_y;
+
+  m2::PointD GetPoint() const { return {m_x, m_y}; }
+};
+
+// Connection of a feature of the pedestrian graph with a stop.
+struct Gate
+{
+  uint32_t m_featureId;
+  uint32_t m_stopId;
+  // Time in seconds from the gate to the stop.
+  float m_weight;
+  uint8_t m_entrance;
+  uint8_t m_exit;
+  uint16_t m_reserved;
+  double m_x;
+  double m_y;
+
+  m2::PointD GetPoint() const { return {m_x, m_y}; }
+};
+
+struct Edge
+{
+  uint32_t m_stop1Id;
+  uint32_t m_stop2Id;
+  // kInvalidId for transfers.
+  uint32_t m_lineId;
+  uint32_t m_shapeId;
+  // Time in seconds.
+  float m_weight;
+  uint32_t m_transfer;
+};
+
+struct Line
+{
+  uint32_t m_id;
+  // Range of ids of stops of the line in the pool of ids.
+  uint32_t m_stopIdsOffset;
+  uint32_t m_stopIdsCount;
+  // Range of the title in the pool of chars.
+  uint32_t m_titleOffset;
+  uint32_t m_titleSize;
+  uint32_t m_reserved;
+};
+
+struct Shape
+{
+  uint32_t m_id;
+  // Range of points of the shape in the pool of points.
+  uint32_t m_pointsOffset;
+  uint32_t m_pointsCount;
+  uint32_t m_reserved;
+};
+
+struct Point
+{
+  double m_x;
+  double m_y;
+};
+
+DECLARE_EXCEPTION(TransitSectionException, RootException);
+
+// Collects transit data of an mwm and writes the transit section.
+class TransitSectionBuilder
+{
+public:
+  void AddStop(uint32_t id, uint32_t featureId, m2::PointD const & point,
+               std::vector<uint32_t> const & lineIds);
+  void AddGate(uint32_t featureId, uint32_t stopId, float weight, bool entrance, bool exit,
+               m2::PointD const & point);
+  void AddEdge(uint32_t stop1Id, uint32_t stop2Id, uint32_t lineId, uint32_t shapeId,
+               float weight, bool transfer);
+  void AddLine(uint32_t id, std::string const & title, std::vector<uint32_t> const & stopIds);
+  void AddShape(uint32_t id, std::vector<m2::PointD> const & points);
+
+  // Sorts the records and writes the section.
+  // @throws TransitSectionException if ids of stops, lines or shapes aren't unique or
+  // edges and gates refer absent stops.
+  void Write(Writer & writer);
+
+private:
+  std::vector<Stop> m_stops;
+  std::vector<Gate> m_gates;
+  std::vector<Edge> m_edges;
+  std::vector<Line> m_lines;
+  std::vector<Shape> m_shapes;
+  std::vector<uint32_t> m_ids;
+  std::vector<Point> m_points;
+  std::string m_chars;
+};
+
+// Transit data of an mwm over the memory of the section.
+class TransitSection
+{
+public:
+  static uint16_t constexpr kVersion = 0;
+
+  // Uses the section in place when |reader| is mapped, otherwise the section is copied.
+  // @throws TransitSectionException if the section is corrupted.
+  static std::unique_ptr<TransitSection> Load(ModelReaderPtr const & reader);
+
+  uint32_t GetStopsCount() const { return m_header.m_stopsCount; }
+  uint32_t GetEdgesCount() const { return m_header.m_edgesCount; }
+  uint32_t GetLinesCount() const { return m_header.m_linesCount; }
+  uint32_t GetShapesCount() const { return m_header.m_shapesCount; }
+  uint32_t GetGatesCount() const { return m_header.m_gatesCount; }
+
+  // Returns nullptr if there is no such a stop/line/shape.
+  Stop const * GetStop(uint32_t id) const { return FindById(m_stops, m_header.m_stopsCount, id); }
+  Line const * GetLine(uint32_t id) const { return FindById(m_lines, m_header.m_linesCount, id); }
+  Shape const * GetShape(uint32_t id) const
+  {
+    return FindById(m_shapes, m_header.m_shapesCount, id);
+  }
+
+  template <typename Fn>
+  void ForEachStop(Fn && fn) const
+  {
+    std::for_each(m_stops, m_stops + m_header.m_stopsCount, std::forward<Fn>(fn));
+  }
+
+  template <typename Fn>
+  void ForEachOutgoingEdge(uint32_t stopId, Fn && fn) const
+  {
+    auto const range = std::equal_range(m_edges, m_edges + m_header.m_edgesCount, stopId,
+                                        LessByStop1());
+    std::for_each(range.first, range.second, std::forward<Fn>(fn));
+  }
+
+  template <typename Fn>
+  void ForEachIngoingEdge(uint32_t stopId, Fn && fn) const
+  {
+    // The index keeps numbers of edges which are sorted by the second stops.
+    auto const end = m_ingoingEdges + m_header.m_edgesCount;
+    auto const lower = std::partition_point(
+        m_ingoingEdges, end, [this, stopId](uint32_t i) { return m_edges[i].m_stop2Id < stopId; });
+    for (auto it = lower; it != end; ++it)
+    {
+      if (m_edges[*it].m_stop2Id != stopId)
+        break;
+      fn(m_edges[*it]);
+    }
+  }
+
+  template <typename Fn>
+  void ForEachGateOfStop(uint32_t stopId, Fn && fn) const
+  {
+    auto const range = std::equal_range(m_gates, m_gates + m_header.m_gatesCount, stopId,
+                                        LessByStopId());
+    std::for_each(range.first, range.second, std::forward<Fn>(fn));
+  }
+
+  std::vector<uint32_t> GetLineIds(Stop const & stop) const
+  {
+    return {m_ids + stop.m_lineIdsOffset, m_ids + stop.m_lineIdsOffset + stop.m_lineIdsCount};
+  }
+  std::vector<uint32_t> GetStopIds(Line const & line) const
+  {
+    return {m_ids + line.m_stopIdsOffset, m_ids + line.m_stopIdsOffset + line.m_stopIdsCount};
+  }
+  std::string GetTitle(Line const & line) const
+  {
+    return {m_chars + line.m_titleOffset, line.m_titleSize};
+  }
+  std::vector<m2::PointD> GetPoints(Shape const & shape) const;
+
+  // Size of the section, the memory isn't copied when the section is mapped.
+  uint64_t GetSize() const { return m_region->Size(); }
+  bool IsMapped() const { return m_isMapped; }
+
+private:
+  friend class TransitSectionBuilder;
+
+  struct Header
+  {
+    uint16_t m_version;
+    uint16_t m_reserved;
+    uint32_t m_stopsCount;
+    uint32_t m_gatesCount;
+    uint32_t m_edgesCount;
+    uint32_t m_linesCount;
+    uint32_t m_shapesCount;
+    uint32_t m_idsCount;
+    uint32_t m_pointsCount;
+    uint32_t m_charsCount;
+    uint32_t m_reserved2;
+  };
+
+  struct LessByStop1
+  {
+    bool operator()(Edge const & lhs, uint32_t rhs) const { return lhs.m_stop1Id < rhs; }
+    bool operator()(uint32_t lhs, Edge const & rhs) const { return lhs < rhs.m_stop1Id; }
+  };
+
+  struct LessByStopId
+  {
+    bool operator()(Gate const & lhs, uint32_t rhs) const { return lhs.m_stopId < rhs; }
+    bool operator()(uint32_t lhs, Gate const & rhs) const { return lhs < rhs.m_stopId; }
+  };
+
+  TransitSection() = default;
+
+  template <typename T>
+  static T const * FindById(T const * begin, uint32_t count, uint32_t id)
+  {
+    auto const it = std::lower_bound(begin, begin + count, id,
+                                     [](T const & t, uint32_t id) { return t.m_id < id; });
+    if (it == begin + count || it->m_id != id)
+      return nullptr;
+    return it;
+  }
+
+  // Sets pointers to the arrays of the region. Returns false if the region is corrupted.
+  bool Map();
+
+  std::unique_ptr<MemoryRegion> m_region;
+  bool m_isMapped = false;
+
+  Header m_header = {};
+  Stop const * m_stops = nullptr;
+  Gate const * m_gates = nullptr;
+  Edge const * m_edges = nullptr;
+  uint32_t const * m_ingoingEdges = nullptr;
+  Line const * m_lines = nullptr;
+  Shape const * m_shapes = nullptr;
+  uint32_t const * m_ids = nullptr;
+  Point const * m_points = nullptr;
+  char const * m_chars = nullptr;
+
+  DISALLOW_COPY_AND_MOVE(TransitSection);
+};
+}  // namespace transit
+}  // namespace routing
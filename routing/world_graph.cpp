@@ -26,12 +26,58 @@ void WorldGraph::GetEdgeList(Segment const & segment, bool isOutgoing, bool isLe
   }
 
   IndexGraph & indexGraph = GetIndexGraph(segment.GetMwmId());
-  indexGraph.GetEdgeList(segment, isOutgoing, edges);
+  if (m_shortcutsEnabled && indexGraph.HasShortcuts())
+  {
+    indexGraph.GetShortcutEdgeList(segment, isOutgoing,
+                                   [this](Segment const & s) { return IsShortcutPinned(s); },
+                                   edges);
+  }
+  else
+  {
+    indexGraph.GetEdgeList(segment, isOutgoing, edges);
+  }
 
   if (m_crossMwmGraph && m_crossMwmGraph->IsTransition(segment, isOutgoing))
     GetTwins(segment, isOutgoing, edges);
 }
 
+void WorldGraph::EnableShortcuts(vector<Segment> const & stops)
+{
+  m_shortcutsEnabled = true;
+  m_shortcutPins = MakeShortcutPins(stops);
+}
+
+void WorldGraph::DisableShortcuts()
+{
+  m_shortcutsEnabled = false;
+  m_shortcutPins.clear();
+}
+
+void WorldGraph::UnpackShortcuts(vector<Segment> & path,
+                                 function<bool(NumMwmId)> const & isLeapMwm)
+{
+  if (path.empty())
+    return;
+
+  vector<Segment> result;
+  result.reserve(path.size());
+  result.push_back(path.front());
+  for (size_t i = 1; i < path.size(); ++i)
+  {
+    Segment const & from = path[i - 1];
+    Segment const & to = path[i];
+    NumMwmId const mwmId = to.GetMwmId();
+    if (mwmId != kFakeNumMwmId && from.GetMwmId() == mwmId && !(isLeapMwm && isLeapMwm(mwmId)))
+    {
+      IndexGraph & indexGraph = GetIndexGraph(mwmId);
+      if (indexGraph.HasShortcuts())
+        indexGraph.UnpackShortcut(from, to, result);
+    }
+    result.push_back(to);
+  }
+  path.swap(result);
+}
+
 Junction const & WorldGraph::GetJunction(Segment const & segment, bool front)
 {
   return GetRoadGeometry(segment.GetMwmId(), segment.GetFeatureId())
@@ -79,6 +125,16 @@ void WorldGraph::GetTwins(Segment const & segment, bool isOutgoing, vector<Segme
   }
 }
 
+bool WorldGraph::IsShortcutPinned(Segment const & s)
+{
+  if (m_shortcutPins.count(s) != 0)
+    return true;
+
+  return m_crossMwmGraph &&
+         (m_crossMwmGraph->IsTransition(s, true /* isOutgoing */) ||
+          m_crossMwmGraph->IsTransition(s, false /* isOutgoing */));
+}
+
 string DebugPrint(WorldGraph::Mode mode)
 {
   switch (mode)
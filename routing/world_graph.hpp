@@ -6,8 +6,11 @@
 #include "routing/index_graph.hpp"
 #include "routing/index_graph_loader.hpp"
 #include "routing/segment.hpp"
+#include "routing/transit_graph_loader.hpp"
 
+#include <functional>
 #include <memory>
+#include <set>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -50,11 +53,45 @@ public:
   m2::PointD const & GetPoint(Segment const & segment, bool front);
   RoadGeometry const & GetRoadGeometry(NumMwmId mwmId, uint32_t featureId);
 
-  // Clear memory used by loaded index graphs.
-  void ClearIndexGraphs() { m_loader->Clear(); }
+  // Clear memory used by loaded index graphs and transit sections.
+  void ClearIndexGraphs()
+  {
+    m_loader->Clear();
+    if (m_transitLoader)
+      m_transitLoader->Clear();
+  }
+  double GetIndexGraphsLoadingTimeSec() const { return m_loader->GetLoadingTimeSec(); }
+  size_t GetIndexGraphsMemorySize() const { return m_loader->GetMemorySize(); }
+  size_t GetIndexGraphsPeakMemorySize() const { return m_loader->GetPeakMemorySize(); }
+  // See IndexGraphLoader::SetMaxMemorySize().
+  void SetIndexGraphsMaxMemorySize(size_t maxMemorySize)
+  {
+    m_loader->SetMaxMemorySize(maxMemorySize);
+  }
+  // Transit sections are loaded lazily by |transitLoader|, a graph without the loader has no
+  // transit.
+  void SetTransitLoader(std::unique_ptr<TransitGraphLoader> transitLoader)
+  {
+    m_transitLoader = std::move(transitLoader);
+  }
+  // Returns nullptr if there is no transit in the mwm.
+  transit::TransitSection const * GetTransitSection(NumMwmId numMwmId)
+  {
+    return m_transitLoader ? m_transitLoader->GetTransitSection(numMwmId) : nullptr;
+  }
   void SetMode(Mode mode) { m_mode = mode; }
   Mode GetMode() const { return m_mode; }
 
+  // While shortcuts are enabled GetEdgeList() returns shortcut edges of index graphs which have
+  // precomputed shortcuts (see IndexGraph::GetShortcutEdgeList()). Shortcut edges never pass over
+  // |stops|, their neighbors and transition segments.
+  void EnableShortcuts(std::vector<Segment> const & stops);
+  void DisableShortcuts();
+  // Restores in |path| the segments which were skipped by shortcut edges. Segments of mwms
+  // for which |isLeapMwm| returns true are left as is.
+  void UnpackShortcuts(std::vector<Segment> & path,
+                       std::function<bool(NumMwmId)> const & isLeapMwm = nullptr);
+
   // Interface for AStarAlgorithm:
   void GetOutgoingEdgesList(Segment const & segment, vector<SegmentEdge> & edges);
   void GetIngoingEdgesList(Segment const & segment, vector<SegmentEdge> & edges);
@@ -73,12 +110,16 @@ public:
 
 private:
   void GetTwins(Segment const & s, bool isOutgoing, std::vector<SegmentEdge> & edges);
+  bool IsShortcutPinned(Segment const & s);
 
   std::unique_ptr<CrossMwmGraph> m_crossMwmGraph;
   std::unique_ptr<IndexGraphLoader> m_loader;
+  std::unique_ptr<TransitGraphLoader> m_transitLoader;
   std::shared_ptr<EdgeEstimator> m_estimator;
   std::vector<Segment> m_twins;
   Mode m_mode = Mode::NoLeaps;
+  bool m_shortcutsEnabled = false;
+  std::set<Segment> m_shortcutPins;
 };
 
 std::string DebugPrint(WorldGraph::Mode mode);
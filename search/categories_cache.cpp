@@ -3,6 +3,7 @@
 #include "search/mwm_context.hpp"
 #include "search/query_params.hpp"
 #include "search/retrieval.hpp"
+#include "search/types_index.hpp"
 
 #include "indexer/classificator.hpp"
 #include "indexer/ftypes_matcher.hpp"
@@ -21,14 +22,10 @@ CBV CategoriesCache::Get(MwmContext const & context)
   if (!context.m_handle.IsAlive() || !context.m_value.HasSearchIndex())
     return CBV();
 
-  auto id = context.m_handle.GetId();
-  auto const it = m_cache.find(id);
-  if (it != m_cache.cend())
-    return it->second;
-
-  auto cbv = Load(context);
-  m_cache[id] = cbv;
-  return cbv;
+  return m_cache.FindOrLoad(context.m_handle.GetId(), [this, &context]
+                           {
+                             return Load(context);
+                           });
 }
 
 CBV CategoriesCache::Load(MwmContext const & context)
@@ -36,6 +33,17 @@ CBV CategoriesCache::Load(MwmContext const & context)
   ASSERT(context.m_handle.IsAlive(), ());
   ASSERT(context.m_value.HasSearchIndex(), ());
 
+  Retrieval retrieval(context, m_cancellable);
+
+  // Posting lists of types are used when the mwm has them, the search
+  // index is traversed otherwise.
+  if (auto const index = TypesIndex::Load(context.m_value.m_cont))
+  {
+    vector<uint32_t> types;
+    m_categories.ForEach([&types](uint32_t const type) { types.push_back(type); });
+    return CBV(retrieval.RetrieveCategoryFeatures(*index, types));
+  }
+
   auto const & c = classif();
 
   SearchTrieRequest<strings::LevenshteinDFA> request;
@@ -44,7 +52,6 @@ CBV CategoriesCache::Load(MwmContext const & context)
     request.m_categories.emplace_back(FeatureTypeToString(c.GetIndexForType(type)));
   });
 
-  Retrieval retrieval(context, m_cancellable);
   return CBV(retrieval.RetrieveAddressFeatures(request));
 }
 
@@ -6,8 +6,10 @@
 #include "indexer/mwm_set.hpp"
 
 #include "base/cancellable.hpp"
+#include "base/concurrent_lru_cache.hpp"
 
-#include "std/map.hpp"
+#include "std/cstdint.hpp"
+#include "std/functional.hpp"
 
 namespace search
 {
@@ -18,7 +20,7 @@ class CategoriesCache
 public:
   template <typename TypesSource>
   CategoriesCache(TypesSource const & source, my::Cancellable const & cancellable)
-    : m_cancellable(cancellable)
+    : m_cancellable(cancellable), m_cache(kMaxNumMwms)
   {
     source.ForEachType([this](uint32_t type) { m_categories.Add(type); });
   }
@@ -27,14 +29,25 @@ public:
 
   CBV Get(MwmContext const & context);
 
-  inline void Clear() { m_cache.clear(); }
+  inline void Clear() { m_cache.Clear(); }
 
 private:
+  // Features are cached for the most recently used mwms.
+  static size_t constexpr kMaxNumMwms = 1024;
+
+  struct MwmIdHasher
+  {
+    size_t operator()(MwmSet::MwmId const & id) const
+    {
+      return hash<MwmInfo const *>()(id.GetInfo().get());
+    }
+  };
+
   CBV Load(MwmContext const & context);
 
   CategoriesSet m_categories;
   my::Cancellable const & m_cancellable;
-  map<MwmSet::MwmId, CBV> m_cache;
+  my::ConcurrentLRUCache<MwmSet::MwmId, CBV, MwmIdHasher> m_cache;
 };
 
 class StreetsCache : public CategoriesCache
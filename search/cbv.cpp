@@ -66,6 +66,8 @@ uint64_t CBV::PopCount() const
   return m_p->PopCount();
 }
 
+uint64_t CBV::GetMemorySize() const { return m_p.Get() ? m_p->GetMemorySize() : 0; }
+
 CBV CBV::Union(CBV const & rhs) const
 {
   if (IsFull() || rhs.IsEmpty())
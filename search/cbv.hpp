@@ -33,6 +33,8 @@ public:
 
   bool HasBit(uint64_t id) const;
   uint64_t PopCount() const;
+  // Bytes of the underlying bit vector, it's shared by copies of the CBV.
+  uint64_t GetMemorySize() const;
 
   template <class TFn>
   void ForEach(TFn && fn) const
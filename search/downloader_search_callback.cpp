@@ -35,22 +35,25 @@ bool GetGroupCountryIdFromFeature(storage::Storage const & storage, FeatureType
 
 namespace search
 {
-DownloaderSearchCallback::DownloaderSearchCallback(Delegate & delegate, Index const & index,
-                                                   storage::CountryInfoGetter const & infoGetter,
-                                                   storage::Storage const & storage,
-                                                   storage::DownloaderSearchParams params)
+DownloaderSearchCallback::DownloaderSearchCallback(
+    Delegate & delegate, Index const & index, storage::CountryInfoGetter const & infoGetter,
+    storage::Storage const & storage, storage::DownloaderSearchParams params,
+    vector<storage::DownloaderSearchResult> namesResults)
   : m_delegate(delegate)
   , m_index(index)
   , m_infoGetter(infoGetter)
   , m_storage(storage)
   , m_params(move(params))
+  , m_namesResults(move(namesResults))
 {
 }
 
 void DownloaderSearchCallback::operator()(search::Results const & results)
 {
   storage::DownloaderSearchResults downloaderSearchResults;
-  std::set<storage::DownloaderSearchResult> uniqueResults;
+  std::set<storage::DownloaderSearchResult> uniqueResults(m_namesResults.begin(),
+                                                          m_namesResults.end());
+  downloaderSearchResults.m_results = m_namesResults;
 
   for (auto const & result : results)
   {
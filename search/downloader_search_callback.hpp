@@ -2,6 +2,8 @@
 
 #include "storage/downloader_search_params.hpp"
 
+#include "std/vector.hpp"
+
 class Index;
 
 namespace storage
@@ -28,10 +30,13 @@ public:
     virtual void RunUITask(function<void()> fn) = 0;
   };
 
+  // |namesResults| are the nodes found by names (see
+  // DownloaderSearchIndex), they go before the results of the engine.
   DownloaderSearchCallback(Delegate & delegate, Index const & index,
                            storage::CountryInfoGetter const & infoGetter,
                            storage::Storage const & storage,
-                           storage::DownloaderSearchParams params);
+                           storage::DownloaderSearchParams params,
+                           vector<storage::DownloaderSearchResult> namesResults = {});
 
   void operator()(search::Results const & results);
 
@@ -41,5 +46,6 @@ private:
   storage::CountryInfoGetter const & m_infoGetter;
   storage::Storage const & m_storage;
   storage::DownloaderSearchParams m_params;
+  vector<storage::DownloaderSearchResult> m_namesResults;
 };
 }  // namespace search
@@ -0,0 +1,149 @@
+#include "search/downloader_search_index.hpp"
+
+#include "storage/storage.hpp"
+
+#include "indexer/search_delimiters.hpp"
+#include "indexer/search_string_utils.hpp"
+
+#include "base/assert.hpp"
+#include "base/stl_add.hpp"
+
+#include "std/algorithm.hpp"
+#include "std/iterator.hpp"
+#include "std/unordered_set.hpp"
+
+namespace search
+{
+// static
+size_t constexpr DownloaderSearchIndex::kMaxResults;
+
+void DownloaderSearchIndex::Build(storage::Storage const & storage)
+{
+  Clear();
+
+  auto const rootId = storage.GetRootId();
+  unordered_set<storage::TCountryId> visited;
+  storage.ForEachInSubtree(rootId, [&](storage::TCountryId const & countryId, bool /* groupNode */)
+  {
+    // Disputed territories may occur in the tree several times.
+    if (countryId == rootId || !visited.insert(countryId).second)
+      return;
+
+    auto const node = static_cast<uint32_t>(m_nodes.size());
+    m_nodes.push_back(countryId);
+
+    auto const localName = storage.GetNodeLocalName(countryId);
+    if (!localName.empty())
+      AddName(node, localName);
+    if (localName != countryId)
+      AddName(node, countryId);
+  });
+
+  sort(m_tokens.begin(), m_tokens.end());
+  m_tokens.erase(unique(m_tokens.begin(), m_tokens.end()), m_tokens.end());
+
+  m_locale = storage.GetLocale();
+  m_dataVersion = storage.GetCurrentDataVersion();
+}
+
+void DownloaderSearchIndex::Clear()
+{
+  m_nodes.clear();
+  m_names.clear();
+  m_tokens.clear();
+  m_locale.clear();
+  m_dataVersion = numeric_limits<int64_t>::min();
+}
+
+bool DownloaderSearchIndex::IsUpToDate(storage::Storage const & storage) const
+{
+  return !IsEmpty() && m_locale == storage.GetLocale() &&
+         m_dataVersion == storage.GetCurrentDataVersion();
+}
+
+void DownloaderSearchIndex::Search(string const & query,
+                                   vector<storage::DownloaderSearchResult> & results,
+                                   size_t maxResults) const
+{
+  vector<strings::UniString> tokens;
+  Delimiters delims;
+  auto const uniQuery = NormalizeAndSimplifyString(query);
+  SplitUniString(uniQuery, MakeBackInsertFunctor(tokens), delims);
+  if (tokens.empty() || maxResults == 0)
+    return;
+
+  bool const lastIsPrefix = !delims(uniQuery.back());
+
+  vector<uint32_t> ids;
+  vector<uint32_t> tokenIds;
+  vector<uint32_t> intersection;
+  for (size_t i = 0; i < tokens.size(); ++i)
+  {
+    tokenIds.clear();
+    GetNames(tokens[i], lastIsPrefix && i + 1 == tokens.size(), tokenIds);
+    if (i == 0)
+    {
+      ids.swap(tokenIds);
+    }
+    else
+    {
+      intersection.clear();
+      set_intersection(ids.begin(), ids.end(), tokenIds.begin(), tokenIds.end(),
+                       back_inserter(intersection));
+      ids.swap(intersection);
+    }
+    if (ids.empty())
+      return;
+  }
+
+  // Names are added in the order of the tree, so the stable partition
+  // keeps the tree order inside the groups.
+  stable_partition(ids.begin(), ids.end(), [&](uint32_t id)
+  {
+    return m_names[id].m_numTokens <= tokens.size();
+  });
+
+  vector<bool> found(m_nodes.size(), false);
+  size_t numFound = 0;
+  for (auto const id : ids)
+  {
+    auto const & name = m_names[id];
+    if (found[name.m_node])
+      continue;
+    found[name.m_node] = true;
+    results.emplace_back(m_nodes[name.m_node], name.m_name);
+    if (++numFound == maxResults)
+      break;
+  }
+}
+
+void DownloaderSearchIndex::AddName(uint32_t node, string const & name)
+{
+  vector<strings::UniString> tokens;
+  NormalizeAndTokenizeString(name, tokens);
+  if (tokens.empty())
+    return;
+
+  auto const id = static_cast<uint32_t>(m_names.size());
+  m_names.emplace_back(node, name, static_cast<uint32_t>(tokens.size()));
+  for (auto & token : tokens)
+    m_tokens.emplace_back(move(token), id);
+}
+
+void DownloaderSearchIndex::GetNames(strings::UniString const & token, bool isPrefix,
+                                     vector<uint32_t> & ids) const
+{
+  auto it = lower_bound(m_tokens.begin(), m_tokens.end(), token,
+                        [](pair<strings::UniString, uint32_t> const & lhs,
+                           strings::UniString const & rhs) { return lhs.first < rhs; });
+  for (; it != m_tokens.end(); ++it)
+  {
+    if (isPrefix ? !strings::StartsWith(it->first, token) : it->first != token)
+      break;
+    ids.push_back(it->second);
+  }
+
+  sort(ids.begin(), ids.end());
+  ids.erase(unique(ids.begin(), ids.end()), ids.end());
+}
+}  // namespace search
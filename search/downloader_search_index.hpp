@@ -0,0 +1,84 @@
+#pragma once
+
+#include "storage/downloader_search_params.hpp"
+#include "storage/index.hpp"
+
+#include "base/string_utils.hpp"
+
+#include "std/cstdint.hpp"
+#include "std/limits.hpp"
+#include "std/string.hpp"
+#include "std/utility.hpp"
+#include "std/vector.hpp"
+
+namespace storage
+{
+class Storage;
+}  // namespace storage
+
+namespace search
+{
+// An in-memory prefix index over the names of the nodes of the
+// countries tree (see countries.txt). Every node is indexed by its
+// local name (see storage::Storage::GetNodeLocalName()) and by its id,
+// so the countries and the regions are found by names without the
+// search engine and mwms.
+//
+// A node matches a query when every query token is a token of one of
+// the node names. The last query token may be a prefix of a name
+// token unless the query ends with a delimiter.
+//
+// *NOTE* the class is NOT thread safe.
+class DownloaderSearchIndex
+{
+public:
+  static size_t constexpr kMaxResults = 100;
+
+  // Rebuilds the index for the current locale and data version of |storage|.
+  void Build(storage::Storage const & storage);
+
+  void Clear();
+
+  // Returns true when the index was built for the current locale and
+  // data version of |storage|.
+  bool IsUpToDate(storage::Storage const & storage) const;
+
+  inline bool IsEmpty() const { return m_nodes.empty(); }
+  inline size_t GetNumNodes() const { return m_nodes.size(); }
+
+  // Appends to |results| at most |maxResults| nodes matching |query|,
+  // one result per node. The nodes a name of which consists of the
+  // query tokens only go first, the rest nodes go in the order of
+  // the countries tree.
+  void Search(string const & query, vector<storage::DownloaderSearchResult> & results,
+              size_t maxResults = kMaxResults) const;
+
+private:
+  struct Name
+  {
+    Name(uint32_t node, string const & name, uint32_t numTokens)
+      : m_node(node), m_name(name), m_numTokens(numTokens)
+    {
+    }
+
+    uint32_t m_node;
+    string m_name;
+    uint32_t m_numTokens;
+  };
+
+  void AddName(uint32_t node, string const & name);
+
+  // Appends to |ids| the sorted ids of the names having |token| (or a
+  // token starting with |token| when |isPrefix| is true).
+  void GetNames(strings::UniString const & token, bool isPrefix, vector<uint32_t> & ids) const;
+
+  vector<storage::TCountryId> m_nodes;
+  vector<Name> m_names;
+  // Pairs (token, name id) sorted by tokens, so the names having a
+  // token or a prefix are found by binary search.
+  vector<pair<strings::UniString, uint32_t>> m_tokens;
+
+  string m_locale;
+  int64_t m_dataVersion = numeric_limits<int64_t>::min();
+};
+}  // namespace search
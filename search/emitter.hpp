@@ -5,26 +5,63 @@
 
 #include "base/logging.hpp"
 
+#include "std/algorithm.hpp"
+
 namespace search
 {
 class Emitter
 {
 public:
-  inline void Init(SearchParams::TOnResults onResults)
+  inline void Init(SearchParams::TOnResults onResults,
+                   SearchParams::TOnResultsDelta onResultsDelta = SearchParams::TOnResultsDelta())
   {
     m_onResults = onResults;
+    m_onResultsDelta = onResultsDelta;
     m_results.Clear();
+    m_firstChanged = 0;
+  }
+
+  inline bool AddResult(Result && res)
+  {
+    bool const isSuggest = res.IsSuggest();
+    if (!m_results.AddResult(move(res)))
+      return false;
+
+    // Suggests are inserted before the first feature result, all other
+    // results are appended.
+    size_t position = m_results.GetCount() - 1;
+    if (isSuggest)
+    {
+      position = 0;
+      while (position < m_results.GetCount() &&
+             m_results[position].GetResultType() != Result::RESULT_FEATURE)
+      {
+        ++position;
+      }
+      ASSERT_GREATER(position, 0, ());
+      --position;
+    }
+    m_firstChanged = min(m_firstChanged, position);
+    return true;
   }
 
-  inline bool AddResult(Result && res) { return m_results.AddResult(move(res)); }
-  inline void AddResultNoChecks(Result && res) { m_results.AddResultNoChecks(move(res)); }
+  inline void AddResultNoChecks(Result && res)
+  {
+    m_firstChanged = min(m_firstChanged, m_results.GetCount());
+    m_results.AddResultNoChecks(move(res));
+  }
 
+  // Sends results to the client. The delta callback is not called
+  // when there are no changes since the last call.
   inline void Emit()
   {
+    if (m_onResultsDelta && m_firstChanged != m_results.GetCount())
+      m_onResultsDelta(m_results, m_firstChanged);
     if (m_onResults)
       m_onResults(m_results);
-    else
+    else if (!m_onResultsDelta)
       LOG(LERROR, ("OnResults is not set."));
+    m_firstChanged = m_results.GetCount();
   }
 
   inline Results const & GetResults() const { return m_results; }
@@ -32,14 +69,22 @@ public:
   inline void Finish(bool cancelled)
   {
     m_results.SetEndMarker(cancelled);
+    if (m_onResultsDelta)
+      m_onResultsDelta(m_results, m_firstChanged);
     if (m_onResults)
       m_onResults(m_results);
-    else
+    else if (!m_onResultsDelta)
       LOG(LERROR, ("OnResults is not set."));
+    m_firstChanged = m_results.GetCount();
   }
 
 private:
   SearchParams::TOnResults m_onResults;
+  SearchParams::TOnResultsDelta m_onResultsDelta;
   Results m_results;
+
+  // Results in the range [0, m_firstChanged) weren't changed since
+  // the last Emit() or Finish() call.
+  size_t m_firstChanged = 0;
 };
 }  // namespace search
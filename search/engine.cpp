@@ -8,6 +8,7 @@
 
 #include "indexer/categories_holder.hpp"
 #include "indexer/classificator.hpp"
+#include "indexer/index.hpp"
 #include "indexer/scales.hpp"
 #include "indexer/search_string_utils.hpp"
 
@@ -82,10 +83,21 @@ void ProcessorHandle::Detach()
 }
 
 // Engine::Params ----------------------------------------------------------------------------------
-Engine::Params::Params() : m_locale("en"), m_numThreads(1) {}
+Engine::Params::Params()
+  : m_locale("en")
+  , m_numThreads(1)
+  , m_numRetrievalThreads(0)
+  , m_resultsCacheSize(0)
+  , m_streetVicinityCacheSize(0)
+{
+}
 
 Engine::Params::Params(string const & locale, size_t numThreads)
-  : m_locale(locale), m_numThreads(numThreads)
+  : m_locale(locale)
+  , m_numThreads(numThreads)
+  , m_numRetrievalThreads(0)
+  , m_resultsCacheSize(0)
+  , m_streetVicinityCacheSize(0)
 {
 }
 
@@ -93,17 +105,39 @@ Engine::Params::Params(string const & locale, size_t numThreads)
 Engine::Engine(Index & index, CategoriesHolder const & categories,
                storage::CountryInfoGetter const & infoGetter, unique_ptr<ProcessorFactory> factory,
                Params const & params)
-  : m_shutdown(false)
+  : m_index(index), m_shutdown(false)
 {
+  if (params.m_resultsCacheSize != 0)
+  {
+    m_resultsCache = make_unique<ResultsCache>(params.m_resultsCacheSize);
+    m_index.AddObserver(*m_resultsCache);
+  }
+
+  if (params.m_streetVicinityCacheSize != 0)
+  {
+    m_streetVicinityCache = make_unique<StreetVicinityCache>(params.m_streetVicinityCacheSize);
+    m_index.AddObserver(*m_streetVicinityCache);
+  }
+
   InitSuggestions doInit;
   categories.ForEachName(bind<void>(ref(doInit), _1));
   doInit.GetSuggests(m_suggests);
 
+  size_t numRetrievalThreads = params.m_numRetrievalThreads;
+  if (numRetrievalThreads == 0 && params.m_numThreads > 1)
+    numRetrievalThreads = thread::hardware_concurrency() / params.m_numThreads;
+  numRetrievalThreads = max(numRetrievalThreads, static_cast<size_t>(1));
+  LOG(LINFO, ("Search threads:", params.m_numThreads, "retrieval threads per query:",
+              numRetrievalThreads));
+
   m_contexts.resize(params.m_numThreads);
   for (size_t i = 0; i < params.m_numThreads; ++i)
   {
     auto processor = factory->Build(index, categories, m_suggests, infoGetter);
     processor->SetPreferredLocale(params.m_locale);
+    processor->SetNumRetrievalThreads(numRetrievalThreads);
+    processor->SetStreetVicinityCache(m_streetVicinityCache.get());
+    processor->SetTablesCache(&m_tablesCache);
     m_contexts[i].m_processor = move(processor);
   }
 
@@ -122,6 +156,11 @@ Engine::~Engine()
 
   for (auto & thread : m_threads)
     thread.join();
+
+  if (m_resultsCache)
+    m_index.RemoveObserver(*m_resultsCache);
+  if (m_streetVicinityCache)
+    m_index.RemoveObserver(*m_streetVicinityCache);
 }
 
 weak_ptr<ProcessorHandle> Engine::Search(SearchParams const & params, m2::RectD const & viewport)
@@ -136,6 +175,7 @@ weak_ptr<ProcessorHandle> Engine::Search(SearchParams const & params, m2::RectD
 
 void Engine::SetSupportOldFormat(bool support)
 {
+  ClearResultsCache();
   PostMessage(Message::TYPE_BROADCAST, [this, support](Processor & processor)
               {
                 processor.SupportOldFormat(support);
@@ -152,12 +192,21 @@ void Engine::SetLocale(string const & locale)
 
 void Engine::ClearCaches()
 {
+  ClearResultsCache();
+  if (m_streetVicinityCache)
+    m_streetVicinityCache->Clear();
   PostMessage(Message::TYPE_BROADCAST, [this](Processor & processor)
               {
                 processor.ClearCaches();
               });
 }
 
+void Engine::ClearResultsCache()
+{
+  if (m_resultsCache)
+    m_resultsCache->Clear();
+}
+
 void Engine::MainLoop(Context & context)
 {
   while (true)
@@ -226,6 +275,43 @@ void Engine::PostMessage(TArgs &&... args)
 
 void Engine::DoSearch(SearchParams const & params, m2::RectD const & viewport,
                       shared_ptr<ProcessorHandle> handle, Processor & processor)
+{
+  ResultsCache::Key key;
+  if (m_resultsCache &&
+      ResultsCache::MakeKey(params, viewport, processor.GetPreferredLocaleCode(), key))
+  {
+    Results results;
+    if (m_resultsCache->Get(key, results))
+    {
+      if (params.m_onStarted)
+        params.m_onStarted();
+      if (params.m_onResultsDelta)
+        params.m_onResultsDelta(results, 0 /* firstChanged */);
+      if (params.m_onResults)
+        params.m_onResults(results);
+      return;
+    }
+
+    // Only complete results are cached. Results of a query which was
+    // running while the cache was cleared are dropped.
+    uint64_t const generation = m_resultsCache->GetGeneration();
+    SearchParams cachingParams = params;
+    auto const onResults = params.m_onResults;
+    cachingParams.m_onResults = [this, key, generation, onResults](Results const & results) {
+      if (results.IsEndedNormal())
+        m_resultsCache->Put(key, results, generation);
+      if (onResults)
+        onResults(results);
+    };
+    DoSearchImpl(cachingParams, viewport, handle, processor);
+    return;
+  }
+
+  DoSearchImpl(params, viewport, handle, processor);
+}
+
+void Engine::DoSearchImpl(SearchParams const & params, m2::RectD const & viewport,
+                          shared_ptr<ProcessorHandle> handle, Processor & processor)
 {
   bool const viewportSearch = params.m_mode == Mode::Viewport;
 
@@ -1,8 +1,11 @@
 #pragma once
 
+#include "search/mwm_tables_cache.hpp"
 #include "search/processor_factory.hpp"
 #include "search/result.hpp"
+#include "search/results_cache.hpp"
 #include "search/search_params.hpp"
+#include "search/street_vicinity_cache.hpp"
 #include "search/suggest.hpp"
 
 #include "indexer/categories_holder.hpp"
@@ -11,6 +14,7 @@
 
 #include "coding/reader.hpp"
 
+#include "base/cache_registry.hpp"
 #include "base/macros.hpp"
 #include "base/mutex.hpp"
 #include "base/thread.hpp"
@@ -89,6 +93,22 @@ public:
     // to process queries. Use this field wisely as large values may
     // negatively affect performance due to false sharing.
     size_t m_numThreads;
+
+    // Number of threads each query processor uses to retrieve
+    // features from mwms during world-wide search. When it's zero,
+    // the hardware threads are shared by the query processors and
+    // parallel retrieval is on only when there are several query
+    // processors, as on servers; the application uses a single one.
+    size_t m_numRetrievalThreads;
+
+    // Maximum number of queries which final results are kept in the
+    // results cache. Repeated everywhere search queries are answered
+    // from the cache. Zero disables the cache.
+    size_t m_resultsCacheSize;
+
+    // Maximum number of bytes used by the street vicinities shared by
+    // the query processors across queries. Zero disables the cache.
+    size_t m_streetVicinityCacheSize;
   };
 
   // Doesn't take ownership of index and categories.
@@ -106,9 +126,13 @@ public:
   // Sets default locale on all query processors.
   void SetLocale(string const & locale);
 
-  // Posts request to clear caches to the queue.
+  // Posts request to clear caches to the queue. The results cache and
+  // the street vicinity cache are cleared immediately.
   void ClearCaches();
 
+  // Clears the results cache. Must be called when features are edited.
+  void ClearResultsCache();
+
 private:
   struct Message
   {
@@ -154,11 +178,19 @@ private:
   template <typename... TArgs>
   void PostMessage(TArgs &&... args);
 
+  // Answers from the results cache when possible.
   void DoSearch(SearchParams const & params, m2::RectD const & viewport,
                 shared_ptr<ProcessorHandle> handle, Processor & processor);
+  void DoSearchImpl(SearchParams const & params, m2::RectD const & viewport,
+                    shared_ptr<ProcessorHandle> handle, Processor & processor);
 
   vector<Suggest> m_suggests;
 
+  Index & m_index;
+  unique_ptr<ResultsCache> m_resultsCache;
+  unique_ptr<StreetVicinityCache> m_streetVicinityCache;
+  MwmTablesCache m_tablesCache;
+
   bool m_shutdown;
   mutex m_mu;
   condition_variable m_cv;
@@ -166,5 +198,10 @@ private:
   queue<Message> m_messages;
   vector<Context> m_contexts;
   vector<threads::SimpleThread> m_threads;
+
+  // Caches are rebuilt by the following queries, so they are dropped first
+  // under memory pressure.
+  base::SheddableCache m_cachesShedding{"search", base::CacheRegistry::Priority::Low,
+                                        [this]() { ClearCaches(); }};
 };
 }  // namespace search
@@ -9,10 +9,6 @@
 
 namespace search
 {
-/// Max distance from house to street where we do search matching
-/// even if there is no exact street written for this house.
-int constexpr kMaxApproxStreetDistanceM = 100;
-
 FeaturesLayerMatcher::FeaturesLayerMatcher(Index const & index, my::Cancellable const & cancellable)
   : m_context(nullptr)
   , m_postcodes(nullptr)
@@ -39,6 +35,11 @@ void FeaturesLayerMatcher::SetPostcodes(CBV const * postcodes)
   m_postcodes = postcodes;
 }
 
+void FeaturesLayerMatcher::SetStreetVicinityCache(StreetVicinityCache * cache)
+{
+  m_loader.SetCache(cache);
+}
+
 void FeaturesLayerMatcher::OnQueryFinished()
 {
   m_nearbyStreetsCache.ClearIfNeeded();
@@ -132,7 +133,7 @@ uint32_t FeaturesLayerMatcher::GetMatchingStreetImpl(uint32_t houseId, FeatureTy
 
   // If there is no saved street for feature, assume that it's a nearest street if it's too close.
   if (result == kInvalidId && !streets.empty() &&
-      streets[0].m_distanceMeters < kMaxApproxStreetDistanceM)
+      streets[0].m_distanceMeters < ReverseGeocoder::kMaxApproxStreetDistanceM)
   {
     result = streets[0].m_id.m_index;
   }
@@ -3,6 +3,7 @@
 #include "search/cancel_exception.hpp"
 #include "search/cbv.hpp"
 #include "search/features_layer.hpp"
+#include "search/house_numbers_index.hpp"
 #include "search/house_numbers_matcher.hpp"
 #include "search/model.hpp"
 #include "search/mwm_context.hpp"
@@ -64,6 +65,7 @@ public:
   FeaturesLayerMatcher(Index const & index, my::Cancellable const & cancellable);
   void SetContext(MwmContext * context);
   void SetPostcodes(CBV const * postcodes);
+  void SetStreetVicinityCache(StreetVicinityCache * cache);
 
   template <typename TFn>
   void Match(FeaturesLayer const & child, FeaturesLayer const & parent, TFn && fn)
@@ -282,6 +284,17 @@ private:
     vector<house_numbers::Token> queryParse;
     ParseQuery(child.m_subQuery, child.m_lastTokenIsPrefix, queryParse);
 
+    // When the query starts with a number, only the houses with the
+    // same key can match it, and they are taken from the house numbers
+    // index instead of loading of all the houses in street vicinities.
+    // Houses edited by user aren't in the index, so they are checked
+    // as usual.
+    HouseNumbersIndex const * houseNumbers = nullptr;
+    uint32_t queryKey = 0;
+    if (child.m_hasDelayedFeatures && GetHouseNumberKey(queryParse, queryKey))
+      houseNumbers = m_context->GetHouseNumbersIndex();
+    vector<uint32_t> indexedHouses;
+
     uint32_t numFilterInvocations = 0;
     auto houseNumberFilter = [&](uint32_t id, FeatureType & feature, bool & loaded) -> bool {
       ++numFilterInvocations;
@@ -327,8 +340,23 @@ private:
 
       auto const & calculator = *street.m_calculator;
 
+      if (houseNumbers)
+      {
+        indexedHouses.clear();
+        houseNumbers->ForEachHouse(streetId, queryKey,
+                                   [&](uint32_t houseId) { indexedHouses.push_back(houseId); });
+        my::SortUnique(indexedHouses);
+      }
+
       for (uint32_t houseId : street.m_features)
       {
+        if (houseNumbers && !binary_search(indexedHouses.begin(), indexedHouses.end(), houseId) &&
+            !binary_search(buildings.begin(), buildings.end(), houseId) &&
+            !m_context->IsEdited(houseId))
+        {
+          continue;
+        }
+
         FeatureType feature;
         bool loaded = false;
         if (!cachingHouseNumberFilter(houseId, feature, loaded))
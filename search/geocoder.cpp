@@ -39,15 +39,20 @@
 #include "base/scope_guard.hpp"
 #include "base/stl_add.hpp"
 #include "base/stl_helpers.hpp"
+#include "base/thread.hpp"
 
 #include "std/algorithm.hpp"
+#include "std/atomic.hpp"
 #include "std/bind.hpp"
+#include "std/function.hpp"
 #include "std/iterator.hpp"
 #include "std/random.hpp"
 #include "std/sstream.hpp"
 #include "std/transform_iterator.hpp"
 #include "std/unique_ptr.hpp"
 
+#include <exception>
+
 #include "defines.hpp"
 
 #if defined(DEBUG)
@@ -74,6 +79,11 @@ size_t const kMaxNumLocalities = LocalityScorer::kDefaultReadLimit;
 size_t constexpr kPivotRectsCacheSize = 10;
 size_t constexpr kLocalityRectsCacheSize = 10;
 
+// Number of mwms per retrieval thread in a batch of mwms which are
+// prefetched together. Mwms differ a lot in size so every thread
+// gets more than one of them to keep all the threads busy.
+size_t constexpr kMwmsPerRetrievalThread = 2;
+
 UniString const kUniSpace(MakeUniString(" "));
 
 struct ScopedMarkTokens
@@ -108,7 +118,7 @@ struct ScopedMarkTokens
 class LazyRankTable : public RankTable
 {
 public:
-  LazyRankTable(MwmValue const & value) : m_value(value) {}
+  LazyRankTable(MwmContext const & context) : m_context(context) {}
 
   uint8_t Get(uint64_t i) const override
   {
@@ -128,10 +138,10 @@ public:
     return m_table->GetVersion();
   }
 
-  void Serialize(Writer & writer, bool preserveHostEndiannes) override
+  void Serialize(Writer & /* writer */, bool /* preserveHostEndiannes */) override
   {
-    EnsureTableLoaded();
-    m_table->Serialize(writer, preserveHostEndiannes);
+    // The table may be shared with other threads, so it's read-only.
+    NOTIMPLEMENTED();
   }
 
 private:
@@ -139,20 +149,28 @@ private:
   {
     if (m_table)
       return;
-    m_table = search::RankTable::Load(m_value.m_cont);
-    if (!m_table)
-      m_table = make_unique<search::DummyRankTable>();
+
+    if (auto * cache = m_context.GetTablesCache())
+    {
+      m_table = cache->GetRankTable(m_context.GetId(), m_context.m_value);
+      return;
+    }
+
+    unique_ptr<RankTable> table = search::RankTable::Load(m_context.m_value.m_cont);
+    if (!table)
+      table = make_unique<search::DummyRankTable>();
+    m_table = move(table);
   }
 
-  MwmValue const & m_value;
-  mutable unique_ptr<search::RankTable> m_table;
+  MwmContext const & m_context;
+  mutable shared_ptr<search::RankTable const> m_table;
 };
 
 class LocalityScorerDelegate : public LocalityScorer::Delegate
 {
 public:
   LocalityScorerDelegate(MwmContext const & context, Geocoder::Params const & params)
-    : m_context(context), m_params(params), m_ranks(m_context.m_value)
+    : m_context(context), m_params(params), m_ranks(m_context)
   {
   }
 
@@ -338,6 +356,29 @@ CBV DecimateCianResults(CBV const & cbv)
   });
   return CBV(coding::CompressedBitVectorBuilder::FromBitPositions(move(setBits)));
 }
+
+// Calls |fn| for the items of a batch one by one while there are
+// items nobody has taken yet.
+class BatchRoutine final : public threads::IRoutine
+{
+public:
+  BatchRoutine(size_t size, atomic<size_t> & next, function<void(size_t)> const & fn)
+    : m_size(size), m_next(next), m_fn(fn)
+  {
+  }
+
+  // threads::IRoutine overrides:
+  void Do() override
+  {
+    for (size_t i = m_next++; i < m_size; i = m_next++)
+      m_fn(i);
+  }
+
+private:
+  size_t const m_size;
+  atomic<size_t> & m_next;
+  function<void(size_t)> const & m_fn;
+};
 }  // namespace
 
 // Geocoder::Geocoder ------------------------------------------------------------------------------
@@ -369,8 +410,11 @@ void Geocoder::SetParams(Params const & params)
 
   m_tokenRequests.clear();
   m_prefixTokenRequest.Clear();
+  m_tokenKeys.clear();
   for (size_t i = 0; i < m_params.GetNumTokens(); ++i)
   {
+    m_tokenKeys.emplace_back(m_params, i);
+
     if (!m_params.IsPrefixToken(i))
     {
       m_tokenRequests.emplace_back();
@@ -397,6 +441,18 @@ void Geocoder::SetParams(Params const & params)
   LOG(LDEBUG, (static_cast<QueryParams const &>(m_params)));
 }
 
+void Geocoder::SetNumRetrievalThreads(size_t numThreads)
+{
+  m_numRetrievalThreads = max(numThreads, static_cast<size_t>(1));
+}
+
+void Geocoder::SetStreetVicinityCache(StreetVicinityCache * cache)
+{
+  m_streetVicinityCache = cache;
+  for (auto & matcher : m_matchersCache)
+    matcher.second->SetStreetVicinityCache(cache);
+}
+
 void Geocoder::GoEverywhere()
 {
 // TODO (@y): remove following code as soon as Geocoder::Go() will
@@ -438,6 +494,9 @@ void Geocoder::GoImpl(vector<shared_ptr<MwmInfo>> & infos, bool inViewport)
 {
   // base::PProf pprof("/tmp/geocoder.prof");
 
+  MY_SCOPE_GUARD(clearPrefetched, [this]() { m_prefetchedFeatures.clear(); });
+  m_tokenFeaturesCache.StartQuery();
+
   try
   {
     // Tries to find world and fill localities table.
@@ -453,7 +512,7 @@ void Geocoder::GoImpl(vector<shared_ptr<MwmInfo>> & infos, bool inViewport)
         // All MwmIds are unique during the application lifetime, so
         // it's ok to save MwmId.
         m_worldId = handle.GetId();
-        m_context = make_unique<MwmContext>(move(handle));
+        m_context = make_unique<MwmContext>(move(handle), m_tablesCache);
 
         if (value.HasSearchIndex())
         {
@@ -500,6 +559,7 @@ void Geocoder::GoImpl(vector<shared_ptr<MwmInfo>> & infos, bool inViewport)
         it = m_matchersCache.insert(make_pair(m_context->GetId(), my::make_unique<FeaturesLayerMatcher>(
                                                                       m_index, m_cancellable)))
                  .first;
+        it->second->SetStreetVicinityCache(m_streetVicinityCache);
       }
       m_matcher = it->second.get();
       m_matcher->SetContext(m_context.get());
@@ -534,8 +594,12 @@ void Geocoder::GoImpl(vector<shared_ptr<MwmInfo>> & infos, bool inViewport)
         m_preRanker.UpdateResults(false /* lastUpdate */);
     };
 
-    // Iterates through all alive mwms and performs geocoding.
-    ForEachCountry(infos, processCountry);
+    // Iterates through all alive mwms and performs geocoding. Viewport
+    // search touches a few mwms only, so retrieval is not worth to be
+    // parallelized there. Geocoding itself is always sequential
+    // because matchers, caches and PreRanker aren't thread-safe.
+    bool const prefetch = !inViewport && m_numRetrievalThreads > 1;
+    ForEachCountry(infos, prefetch, processCountry);
 
     m_preRanker.UpdateResults(true /* lastUpdate */);
   }
@@ -554,26 +618,90 @@ void Geocoder::ClearCaches()
   m_hotelsCache.Clear();
   m_hotelsFilter.ClearCaches();
   m_postcodes.Clear();
+  m_tokenFeaturesCache.Clear();
 }
 
 void Geocoder::InitBaseContext(BaseContext & ctx)
 {
-  Retrieval retrieval(*m_context, m_cancellable);
-
   ctx.m_usedTokens.assign(m_params.GetNumTokens(), false);
   ctx.m_numTokens = m_params.GetNumTokens();
-  ctx.m_features.resize(ctx.m_numTokens);
-  for (size_t i = 0; i < ctx.m_features.size(); ++i)
+
+  auto const it = m_prefetchedFeatures.find(m_context->GetId());
+  if (it != m_prefetchedFeatures.end())
   {
-    if (m_params.IsPrefixToken(i))
-      ctx.m_features[i] = retrieval.RetrieveAddressFeatures(m_prefixTokenRequest);
-    else
-      ctx.m_features[i] = retrieval.RetrieveAddressFeatures(m_tokenRequests[i]);
+    ctx.m_features = move(it->second);
+    m_prefetchedFeatures.erase(it);
+  }
+  else
+  {
+    RetrieveTokenFeatures(*m_context, ctx.m_features);
+  }
+  ASSERT_EQUAL(ctx.m_features.size(), ctx.m_numTokens, ());
+
+  ctx.m_hotelsFilter = m_hotelsFilter.MakeScopedFilter(*m_context, m_params.m_hotelsFilter);
+}
+
+void Geocoder::RetrieveTokenFeatures(MwmContext const & context, vector<CBV> & features)
+{
+  // Retrieval is created lazily as all tokens may be cached.
+  unique_ptr<Retrieval> retrieval;
+
+  features.clear();
+  features.resize(m_params.GetNumTokens());
+  for (size_t i = 0; i < features.size(); ++i)
+  {
+    ASSERT_LESS(i, m_tokenKeys.size(), ());
+    if (!m_tokenFeaturesCache.Get(context.GetId(), m_tokenKeys[i], features[i]))
+    {
+      if (!retrieval)
+        retrieval = my::make_unique<Retrieval>(context, m_cancellable);
+
+      if (m_params.IsPrefixToken(i))
+        features[i] = retrieval->RetrieveAddressFeatures(m_prefixTokenRequest);
+      else
+        features[i] = retrieval->RetrieveAddressFeatures(m_tokenRequests[i]);
+      m_tokenFeaturesCache.Put(context.GetId(), m_tokenKeys[i], features[i]);
+    }
 
     if (m_params.m_cianMode)
-      ctx.m_features[i] = DecimateCianResults(ctx.m_features[i]);
+      features[i] = DecimateCianResults(features[i]);
   }
-  ctx.m_hotelsFilter = m_hotelsFilter.MakeScopedFilter(*m_context, m_params.m_hotelsFilter);
+}
+
+void Geocoder::PrefetchTokenFeatures(vector<unique_ptr<MwmContext>> const & contexts)
+{
+  // Each context is used by a single thread only, and the token
+  // requests aren't changed during geocoding, so no locks are needed.
+  vector<vector<CBV>> features(contexts.size());
+  vector<std::exception_ptr> errors(contexts.size());
+  function<void(size_t)> const retrieve = [&](size_t i) {
+    try
+    {
+      RetrieveTokenFeatures(*contexts[i], features[i]);
+    }
+    catch (...)
+    {
+      errors[i] = std::current_exception();
+    }
+  };
+
+  size_t const numThreads = min(m_numRetrievalThreads, contexts.size());
+  atomic<size_t> next(0);
+  threads::SimpleThreadPool pool(numThreads);
+  for (size_t i = 0; i < numThreads; ++i)
+    pool.Add(my::make_unique<BatchRoutine>(contexts.size(), next, retrieve));
+  pool.Join();
+
+  // CancelException and reading errors are rethrown in the geocoding
+  // thread as if retrieval was sequential.
+  for (auto const & error : errors)
+  {
+    if (error)
+      std::rethrow_exception(error);
+  }
+
+  for (size_t i = 0; i < contexts.size(); ++i)
+    m_prefetchedFeatures[contexts[i]->GetId()] = move(features[i]);
 }
 
 void Geocoder::InitLayer(Model::Type type, TokenRange const & tokenRange, FeaturesLayer & layer)
@@ -598,6 +726,8 @@ void Geocoder::FillLocalityCandidates(BaseContext const & ctx, CBV const & filte
 
 void Geocoder::FillLocalitiesTable(BaseContext const & ctx)
 {
+  QueryTrace::Scope scope(m_params.m_trace, QueryTrace::STAGE_LOCALITIES);
+
   vector<Locality> preLocalities;
 
   CBV filter;
@@ -680,6 +810,8 @@ void Geocoder::FillLocalitiesTable(BaseContext const & ctx)
 
 void Geocoder::FillVillageLocalities(BaseContext const & ctx)
 {
+  QueryTrace::Scope scope(m_params.m_trace, QueryTrace::STAGE_LOCALITIES);
+
   vector<Locality> preLocalities;
   FillLocalityCandidates(ctx, ctx.m_villages /* filter */, kMaxNumVillages, preLocalities);
 
@@ -715,8 +847,22 @@ void Geocoder::FillVillageLocalities(BaseContext const & ctx)
 }
 
 template <typename TFn>
-void Geocoder::ForEachCountry(vector<shared_ptr<MwmInfo>> const & infos, TFn && fn)
+void Geocoder::ForEachCountry(vector<shared_ptr<MwmInfo>> const & infos, bool prefetch, TFn && fn)
 {
+  size_t const batchSize = prefetch ? m_numRetrievalThreads * kMwmsPerRetrievalThread : 1;
+
+  vector<size_t> indices;
+  vector<unique_ptr<MwmContext>> contexts;
+  auto processBatch = [&]()
+  {
+    if (prefetch && !contexts.empty())
+      PrefetchTokenFeatures(contexts);
+    for (size_t j = 0; j < contexts.size(); ++j)
+      fn(indices[j], move(contexts[j]));
+    indices.clear();
+    contexts.clear();
+  };
+
   for (size_t i = 0; i < infos.size(); ++i)
   {
     auto const & info = infos[i];
@@ -731,12 +877,19 @@ void Geocoder::ForEachCountry(vector<shared_ptr<MwmInfo>> const & infos, TFn &&
     auto & value = *handle.GetValue<MwmValue>();
     if (!value.HasSearchIndex() || !value.HasGeometryIndex())
       continue;
-    fn(i, make_unique<MwmContext>(move(handle)));
+
+    indices.push_back(i);
+    contexts.push_back(make_unique<MwmContext>(move(handle), m_tablesCache));
+    if (contexts.size() == batchSize)
+      processBatch();
   }
+  processBatch();
 }
 
 void Geocoder::MatchRegions(BaseContext & ctx, Region::Type type)
 {
+  QueryTrace::Scope scope(m_params.m_trace, QueryTrace::STAGE_LOCALITIES);
+
   switch (type)
   {
   case Region::TYPE_STATE:
@@ -810,6 +963,8 @@ void Geocoder::MatchRegions(BaseContext & ctx, Region::Type type)
 
 void Geocoder::MatchCities(BaseContext & ctx)
 {
+  QueryTrace::Scope scope(m_params.m_trace, QueryTrace::STAGE_LOCALITIES);
+
   ASSERT(!ctx.m_city, ());
 
   // Localities are ordered my (m_startToken, m_endToken) pairs.
@@ -926,6 +1081,8 @@ void Geocoder::WithPostcodes(BaseContext & ctx, TFn && fn)
 
 void Geocoder::GreedilyMatchStreets(BaseContext & ctx)
 {
+  QueryTrace::Scope scope(m_params.m_trace, QueryTrace::STAGE_STREETS);
+
   vector<StreetsMatcher::Prediction> predictions;
   StreetsMatcher::Go(ctx, *m_filter, m_params, predictions);
 
@@ -958,6 +1115,8 @@ void Geocoder::CreateStreetsLayerAndMatchLowerLayers(BaseContext & ctx,
 
 void Geocoder::MatchPOIsAndBuildings(BaseContext & ctx, size_t curToken)
 {
+  QueryTrace::Scope scope(m_params.m_trace, QueryTrace::STAGE_POIS_AND_BUILDINGS);
+
   BailIfCancelled();
 
   auto & layers = ctx.m_layers;
@@ -1185,6 +1344,8 @@ bool Geocoder::IsLayerSequenceSane(vector<FeaturesLayer> const & layers) const
 
 void Geocoder::FindPaths(BaseContext const & ctx)
 {
+  QueryTrace::Scope scope(m_params.m_trace, QueryTrace::STAGE_PATH_FINDER);
+
   auto const & layers = ctx.m_layers;
 
   if (layers.empty())
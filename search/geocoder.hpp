@@ -16,8 +16,10 @@
 #include "search/nested_rects_cache.hpp"
 #include "search/pre_ranking_info.hpp"
 #include "search/query_params.hpp"
+#include "search/query_trace.hpp"
 #include "search/ranking_utils.hpp"
 #include "search/streets_matcher.hpp"
+#include "search/token_features_cache.hpp"
 #include "search/token_range.hpp"
 
 #include "indexer/index.hpp"
@@ -37,6 +39,7 @@
 #include "base/string_utils.hpp"
 
 #include "std/limits.hpp"
+#include "std/map.hpp"
 #include "std/set.hpp"
 #include "std/string.hpp"
 #include "std/unique_ptr.hpp"
@@ -58,6 +61,8 @@ class PreRanker;
 class FeaturesFilter;
 class FeaturesLayerMatcher;
 class SearchModel;
+class MwmTablesCache;
+class StreetVicinityCache;
 class TokenSlice;
 
 // This class is used to retrieve all features corresponding to a
@@ -84,6 +89,9 @@ public:
     m2::RectD m_pivot;
     shared_ptr<hotels_filter::Rule> m_hotelsFilter;
     bool m_cianMode = false;
+
+    // Query trace, nullptr when tracing is disabled.
+    QueryTrace * m_trace = nullptr;
   };
 
   Geocoder(Index const & index, storage::CountryInfoGetter const & infoGetter,
@@ -95,6 +103,19 @@ public:
   // Sets search query params.
   void SetParams(Params const & params);
 
+  // Sets the number of threads used to retrieve features of the
+  // query tokens from mwms during GoEverywhere(). Retrieval is
+  // sequential when |numThreads| is less than two.
+  void SetNumRetrievalThreads(size_t numThreads);
+
+  // Sets the cache of street vicinities shared by geocoders. |cache|
+  // may be nullptr and must outlive the geocoder.
+  void SetStreetVicinityCache(StreetVicinityCache * cache);
+
+  // Sets the cache of mwm tables shared by geocoders. |cache| may be
+  // nullptr and must outlive the geocoder.
+  inline void SetTablesCache(MwmTablesCache * cache) { m_tablesCache = cache; }
+
   // Starts geocoding, retrieved features will be appended to
   // |results|.
   void GoEverywhere();
@@ -133,6 +154,14 @@ private:
   // for each token and saves it to m_addressFeatures.
   void InitBaseContext(BaseContext & ctx);
 
+  // Retrieves features corresponding to each token from |context|.
+  // May be called from several threads at once.
+  void RetrieveTokenFeatures(MwmContext const & context, vector<CBV> & features);
+
+  // Retrieves features corresponding to each token from all
+  // |contexts| in parallel and saves them to m_prefetchedFeatures.
+  void PrefetchTokenFeatures(vector<unique_ptr<MwmContext>> const & contexts);
+
   void InitLayer(Model::Type type, TokenRange const & tokenRange, FeaturesLayer & layer);
 
   void FillLocalityCandidates(BaseContext const & ctx,
@@ -143,8 +172,11 @@ private:
 
   void FillVillageLocalities(BaseContext const & ctx);
 
+  // When |prefetch| is true, mwms are processed in batches and
+  // features of the tokens are retrieved for the whole batch in
+  // parallel before |fn| is called.
   template <typename TFn>
-  void ForEachCountry(vector<shared_ptr<MwmInfo>> const & infos, TFn && fn);
+  void ForEachCountry(vector<shared_ptr<MwmInfo>> const & infos, bool prefetch, TFn && fn);
 
   // Throws CancelException if cancelled.
   inline void BailIfCancelled() { ::search::BailIfCancelled(m_cancellable); }
@@ -229,6 +261,12 @@ private:
   // Geocoder params.
   Params m_params;
 
+  size_t m_numRetrievalThreads = 1;
+
+  StreetVicinityCache * m_streetVicinityCache = nullptr;
+
+  MwmTablesCache * m_tablesCache = nullptr;
+
   // This field is used to map features to a limited number of search
   // classes.
   Model m_model;
@@ -241,6 +279,14 @@ private:
   // Context of the currently processed mwm.
   unique_ptr<MwmContext> m_context;
 
+  // Features corresponding to each token for the mwms of the
+  // current batch which are not processed yet.
+  map<MwmSet::MwmId, vector<CBV>> m_prefetchedFeatures;
+
+  // Keys of m_tokenFeaturesCache for each token.
+  vector<TokenFeaturesCache::TokenKey> m_tokenKeys;
+  TokenFeaturesCache m_tokenFeaturesCache;
+
   // m_cities stores both big cities that are visible at World.mwm
   // and small villages and hamlets that are not.
   LocalitiesCache<City> m_cities;
@@ -6,6 +6,8 @@
 
 #include "geometry/mercator.hpp"
 
+#include "std/vector.hpp"
+
 namespace search
 {
 namespace
@@ -20,6 +22,12 @@ GeometryCache::GeometryCache(size_t maxNumEntries, my::Cancellable const & cance
   CHECK_GREATER(m_maxNumEntries, 0, ());
 }
 
+void GeometryCache::Clear()
+{
+  m_entries.clear();
+  UpdateMemory();
+}
+
 void GeometryCache::InitEntry(MwmContext const & context, m2::RectD const & rect, int scale,
                               Entry & entry)
 {
@@ -28,9 +36,27 @@ void GeometryCache::InitEntry(MwmContext const & context, m2::RectD const & rect
   entry.m_rect = rect;
   entry.m_cbv = retrieval.RetrieveGeometryFeatures(rect, scale);
   entry.m_scale = scale;
+  entry.m_numUpdates = 0;
+}
+
+void GeometryCache::UpdateMemory()
+{
+  // Entries of an mwm may share bit vectors, so the sum is an upper bound.
+  uint64_t bytes = 0;
+  for (auto const & p : m_entries)
+  {
+    for (auto const & entry : p.second)
+      bytes += sizeof(Entry) + entry.m_cbv.GetMemorySize();
+  }
+  m_memory.Set(bytes);
 }
 
 // PivotRectsCache ---------------------------------------------------------------------------------
+// static
+double constexpr PivotRectsCache::kMinOverlapRatio;
+// static
+size_t constexpr PivotRectsCache::kMaxNumUpdates;
+
 PivotRectsCache::PivotRectsCache(size_t maxNumEntries, my::Cancellable const & cancellable,
                                  double maxRadiusMeters)
   : GeometryCache(maxNumEntries, cancellable), m_maxRadiusMeters(maxRadiusMeters)
@@ -45,18 +71,71 @@ CBV PivotRectsCache::Get(MwmContext const & context, m2::RectD const & rect, int
         return scale == entry.m_scale &&
                (entry.m_rect.IsRectInside(rect) || IsEqualMercator(rect, entry.m_rect, kCellEps));
       });
+  if (!p.second)
+    return p.first.m_cbv;
+
+  m2::RectD normRect =
+      MercatorBounds::RectByCenterXYAndSizeInMeters(rect.Center(), m_maxRadiusMeters);
+  if (!normRect.IsRectInside(rect))
+    normRect = rect;
+
   auto & entry = p.first;
-  if (p.second)
+  auto const * overlapping = FindOverlappingEntry(context.GetId(), normRect, scale);
+  if (!overlapping)
   {
-    m2::RectD normRect =
-        MercatorBounds::RectByCenterXYAndSizeInMeters(rect.Center(), m_maxRadiusMeters);
-    if (!normRect.IsRectInside(rect))
-      normRect = rect;
     InitEntry(context, normRect, scale, entry);
+    UpdateMemory();
+    return entry.m_cbv;
   }
+
+  vector<m2::RectD> strips;
+  SubtractRect(normRect, overlapping->m_rect, strips);
+
+  Retrieval retrieval(context, m_cancellable);
+  CBV cbv = overlapping->m_cbv;
+  for (auto const & strip : strips)
+    cbv = cbv.Union(CBV(retrieval.RetrieveGeometryFeatures(strip, scale)));
+
+  entry.m_rect = normRect;
+  entry.m_cbv = move(cbv);
+  entry.m_scale = scale;
+  entry.m_numUpdates = overlapping->m_numUpdates + 1;
+  UpdateMemory();
   return entry.m_cbv;
 }
 
+GeometryCache::Entry const * PivotRectsCache::FindOverlappingEntry(MwmSet::MwmId const & id,
+                                                                   m2::RectD const & rect,
+                                                                   int scale) const
+{
+  auto const it = m_entries.find(id);
+  if (it == m_entries.end())
+    return nullptr;
+
+  double const area = rect.SizeX() * rect.SizeY();
+  Entry const * best = nullptr;
+  double bestArea = kMinOverlapRatio * area;
+  // The first entry is the one being created.
+  for (size_t i = 1; i < it->second.size(); ++i)
+  {
+    auto const & entry = it->second[i];
+    if (entry.m_scale != scale || entry.m_numUpdates >= kMaxNumUpdates)
+      continue;
+
+    m2::RectD overlap = entry.m_rect;
+    if (!overlap.Intersect(rect))
+      continue;
+
+    double const overlapArea = overlap.SizeX() * overlap.SizeY();
+    if (overlapArea >= bestArea && overlapArea > 0.0)
+    {
+      best = &entry;
+      bestArea = overlapArea;
+    }
+  }
+  return best;
+}
+
 // LocalityRectsCache ------------------------------------------------------------------------------
 LocalityRectsCache::LocalityRectsCache(size_t maxNumEntries, my::Cancellable const & cancellable)
   : GeometryCache(maxNumEntries, cancellable)
@@ -72,7 +151,10 @@ CBV LocalityRectsCache::Get(MwmContext const & context, m2::RectD const & rect,
                              });
   auto & entry = p.first;
   if (p.second)
+  {
     InitEntry(context, rect, scale, entry);
+    UpdateMemory();
+  }
   return entry.m_cbv;
 }
 
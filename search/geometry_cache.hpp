@@ -7,6 +7,7 @@
 #include "geometry/rect2d.hpp"
 
 #include "base/assert.hpp"
+#include "base/memory_counters.hpp"
 
 #include "std/algorithm.hpp"
 #include "std/cstdint.hpp"
@@ -37,14 +38,19 @@ public:
   // this method.
   virtual CBV Get(MwmContext const & context, m2::RectD const & rect, int scale) = 0;
 
-  inline void Clear() { m_entries.clear(); }
+  void Clear();
 
 protected:
   struct Entry
   {
     m2::RectD m_rect;
+    // Contains all features in |m_rect| and may contain some features
+    // out of it.
     CBV m_cbv;
     int m_scale = 0;
+    // Number of times |m_cbv| was extended by features of new strips
+    // instead of retrieval of the whole rect.
+    size_t m_numUpdates = 0;
   };
 
   // |maxNumEntries| denotes the maximum number of rectangles that
@@ -74,14 +80,31 @@ protected:
 
   void InitEntry(MwmContext const & context, m2::RectD const & rect, int scale, Entry & entry);
 
+  // Reports bytes of cached features, it's called after changes of entries.
+  void UpdateMemory();
+
   map<MwmSet::MwmId, deque<Entry>> m_entries;
   size_t const m_maxNumEntries;
   my::Cancellable const & m_cancellable;
+  base::MemoryCounter m_memory{"search.geometry_cache"};
 };
 
+// When a pivot rect is moved a bit, as the viewport is during panning,
+// features of the new rect are taken from a cached overlapping rect
+// and only the strips of the new rect out of the cached one are
+// retrieved.
 class PivotRectsCache : public GeometryCache
 {
 public:
+  // Incremental updates are used when at least this part of the area
+  // of a new rect is covered by a cached one.
+  static double constexpr kMinOverlapRatio = 0.5;
+
+  // Cached features out of the rects grow with every incremental
+  // update, so after this number of updates a rect is retrieved
+  // from scratch.
+  static size_t constexpr kMaxNumUpdates = 8;
+
   PivotRectsCache(size_t maxNumEntries, my::Cancellable const & cancellable,
                   double maxRadiusMeters);
 
@@ -89,6 +112,11 @@ public:
   CBV Get(MwmContext const & context, m2::RectD const & rect, int scale) override;
 
 private:
+  // Returns the cached entry which covers the largest part of |rect|,
+  // or nullptr if there's no entry covering enough of it.
+  Entry const * FindOverlappingEntry(MwmSet::MwmId const & id, m2::RectD const & rect,
+                                     int scale) const;
+
   double const m_maxRadiusMeters;
 };
 
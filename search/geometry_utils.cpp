@@ -39,4 +39,25 @@ int GetQueryIndexScale(m2::RectD const & viewport)
   return scales::GetScaleLevel(viewport) + 7;
 }
 
+void SubtractRect(m2::RectD const & rect, m2::RectD const & sub, vector<m2::RectD> & parts)
+{
+  m2::RectD inner = sub;
+  if (!inner.Intersect(rect))
+  {
+    parts.push_back(rect);
+    return;
+  }
+
+  // Left and right strips take the whole height of |rect|, bottom
+  // and top strips are between them.
+  if (rect.minX() < inner.minX())
+    parts.emplace_back(rect.minX(), rect.minY(), inner.minX(), rect.maxY());
+  if (inner.maxX() < rect.maxX())
+    parts.emplace_back(inner.maxX(), rect.minY(), rect.maxX(), rect.maxY());
+  if (rect.minY() < inner.minY())
+    parts.emplace_back(inner.minX(), rect.minY(), inner.maxX(), inner.minY());
+  if (inner.maxY() < rect.maxY())
+    parts.emplace_back(inner.minX(), inner.maxY(), inner.maxX(), rect.maxY());
+}
+
 } // namespace search
@@ -3,6 +3,7 @@
 #include "geometry/point2d.hpp"
 #include "geometry/rect2d.hpp"
 
+#include "std/vector.hpp"
 
 namespace search
 {
@@ -15,5 +16,8 @@ bool IsEqualMercator(m2::RectD const & r1, m2::RectD const & r2, double epsMeter
 bool GetInflatedViewport(m2::RectD & viewport);
 // Get scale level to make geometry index query for current viewport.
 int GetQueryIndexScale(m2::RectD const & viewport);
+// Appends to |parts| at most four non-overlapping rects which cover
+// the part of |rect| which is out of |sub|.
+void SubtractRect(m2::RectD const & rect, m2::RectD const & sub, vector<m2::RectD> & parts);
 
 }
@@ -1,11 +1,16 @@
 #include "search/hotels_filter.hpp"
 
+#include "search/hotels_table.hpp"
+
 #include "indexer/feature.hpp"
 #include "indexer/feature_meta.hpp"
 #include "indexer/ftypes_matcher.hpp"
 
+#include "coding/compressed_bit_vector.hpp"
+
 #include "base/assert.hpp"
 #include "base/checked_cast.hpp"
+#include "base/logging.hpp"
 
 #include "std/algorithm.hpp"
 
@@ -19,11 +24,15 @@ typename Rating::Value const Rating::kDefault = 0;
 // static
 typename PriceRate::Value const PriceRate::kDefault = 0;
 
+// static
+typename Stars::Value const Stars::kDefault = 0;
+
 // Description -------------------------------------------------------------------------------------
 void Description::FromFeature(FeatureType & ft)
 {
   m_rating = Rating::kDefault;
   m_priceRate = PriceRate::kDefault;
+  m_stars = Stars::kDefault;
 
   auto const & metadata = ft.GetMetadata();
 
@@ -43,6 +52,14 @@ void Description::FromFeature(FeatureType & ft)
       m_priceRate = pr;
   }
 
+  if (metadata.Has(feature::Metadata::FMD_STARS))
+  {
+    string const stars = metadata.Get(feature::Metadata::FMD_STARS);
+    int st;
+    if (strings::to_int(stars, st))
+      m_stars = st;
+  }
+
   m_types = ftypes::IsHotelChecker::Instance().GetHotelTypesMask(ft);
 }
 
@@ -66,25 +83,25 @@ string DebugPrint(Rule const & rule) { return rule.ToString(); }
 // HotelsFilter::ScopedFilter ----------------------------------------------------------------------
 HotelsFilter::ScopedFilter::ScopedFilter(MwmSet::MwmId const & mwmId,
                                          Descriptions const & descriptions, shared_ptr<Rule> rule)
-  : m_mwmId(mwmId), m_descriptions(descriptions), m_rule(rule)
+  : m_mwmId(mwmId)
 {
-  CHECK(m_rule.get(), ());
+  CHECK(rule.get(), ());
+
+  vector<bool> matches;
+  rule->Matches(descriptions.m_descriptions, matches);
+
+  vector<uint64_t> ids;
+  for (size_t i = 0; i < matches.size(); ++i)
+  {
+    if (matches[i])
+      ids.push_back(descriptions.m_featureIds[i]);
+  }
+  m_matching = CBV(coding::CompressedBitVectorBuilder::FromBitPositions(move(ids)));
 }
 
 bool HotelsFilter::ScopedFilter::Matches(FeatureID const & fid) const
 {
-  if (fid.m_mwmId != m_mwmId)
-    return false;
-
-  auto it =
-      lower_bound(m_descriptions.begin(), m_descriptions.end(),
-                  make_pair(fid.m_index, Description{}),
-                  [](pair<uint32_t, Description> const & lhs,
-                     pair<uint32_t, Description> const & rhs) { return lhs.first < rhs.first; });
-  if (it == m_descriptions.end() || it->first != fid.m_index)
-    return false;
-
-  return m_rule->Matches(it->second);
+  return fid.m_mwmId == m_mwmId && m_matching.HasBit(fid.m_index);
 }
 
 // HotelsFilter ------------------------------------------------------------------------------------
@@ -111,16 +128,38 @@ HotelsFilter::Descriptions const & HotelsFilter::GetDescriptions(MwmContext cons
     return it->second;
 
   auto const hotels = m_hotels.Get(context);
+  auto const table = HotelsTable::Load(context.m_value.m_cont);
   auto & descriptions = m_descriptions[mwmId];
-  hotels.ForEach([&descriptions, &context](uint64_t bit) {
+  size_t fromTable = 0;
+  hotels.ForEach([&](uint64_t bit) {
     auto const id = base::asserted_cast<uint32_t>(bit);
-    FeatureType ft;
 
+    // Features edited by user aren't in sync with the table.
+    if (table && !context.IsEdited(id))
+    {
+      auto const i = table->Find(id);
+      if (i != table->GetSize())
+      {
+        descriptions.m_featureIds.push_back(id);
+        descriptions.m_descriptions.push_back(table->GetDescription(i));
+        ++fromTable;
+        return;
+      }
+    }
+
+    FeatureType ft;
     Description description;
     if (context.GetFeature(id, ft))
       description.FromFeature(ft);
-    descriptions.emplace_back(id, description);
+    descriptions.m_featureIds.push_back(id);
+    descriptions.m_descriptions.push_back(description);
   });
+
+  if (table)
+  {
+    LOG(LDEBUG, ("Descriptions of", fromTable, "of", descriptions.m_featureIds.size(),
+                 "hotels of", context.GetName(), "are taken from the hotels table."));
+  }
   return descriptions;
 }
 }  // namespace hotels_filter
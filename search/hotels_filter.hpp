@@ -59,12 +59,32 @@ struct PriceRate
   static char const * Name() { return "PriceRate"; }
 };
 
+struct Stars
+{
+  using Value = int;
+
+  static Value const kDefault;
+
+  static bool Lt(Value lhs, Value rhs) { return lhs < rhs; }
+  static bool Gt(Value lhs, Value rhs) { return lhs > rhs; }
+  static bool Eq(Value lhs, Value rhs) { return lhs == rhs; }
+
+  template <typename Description>
+  static Value Select(Description const & d)
+  {
+    return d.m_stars;
+  }
+
+  static char const * Name() { return "Stars"; }
+};
+
 struct Description
 {
   void FromFeature(FeatureType & ft);
 
   Rating::Value m_rating = Rating::kDefault;
   PriceRate::Value m_priceRate = PriceRate::kDefault;
+  Stars::Value m_stars = Stars::kDefault;
   unsigned m_types = 0;
 };
 
@@ -75,12 +95,25 @@ struct Rule
   static bool IsIdentical(shared_ptr<Rule> const & lhs, shared_ptr<Rule> const & rhs);
 
   virtual bool Matches(Description const & d) const = 0;
+  // Sets |matches[i]| iff |ds[i]| matches the rule. A whole mwm is
+  // checked by a single virtual call per node of the rule tree.
+  virtual void Matches(vector<Description> const & ds, vector<bool> & matches) const = 0;
   virtual bool IdenticalTo(Rule const & rhs) const = 0;
   virtual string ToString() const = 0;
 };
 
 string DebugPrint(Rule const & rule);
 
+// Implements the bulk Rule::Matches() of a leaf rule via the single
+// description one. The calls are qualified, so they are not virtual.
+template <typename LeafRule>
+void MatchEach(LeafRule const & rule, vector<Description> const & ds, vector<bool> & matches)
+{
+  matches.resize(ds.size());
+  for (size_t i = 0; i < ds.size(); ++i)
+    matches[i] = rule.LeafRule::Matches(ds[i]);
+}
+
 template <typename Field>
 struct EqRule final : public Rule
 {
@@ -94,6 +127,11 @@ struct EqRule final : public Rule
     return Field::Eq(Field::Select(d), m_value);
   }
 
+  void Matches(vector<Description> const & ds, vector<bool> & matches) const override
+  {
+    MatchEach(*this, ds, matches);
+  }
+
   bool IdenticalTo(Rule const & rhs) const override
   {
     auto const * r = dynamic_cast<EqRule const *>(&rhs);
@@ -123,6 +161,11 @@ struct LtRule final : public Rule
     return Field::Lt(Field::Select(d), m_value);
   }
 
+  void Matches(vector<Description> const & ds, vector<bool> & matches) const override
+  {
+    MatchEach(*this, ds, matches);
+  }
+
   bool IdenticalTo(Rule const & rhs) const override
   {
     auto const * r = dynamic_cast<LtRule const *>(&rhs);
@@ -153,6 +196,11 @@ struct LeRule final : public Rule
     return Field::Lt(value, m_value) || Field::Eq(value, m_value);
   }
 
+  void Matches(vector<Description> const & ds, vector<bool> & matches) const override
+  {
+    MatchEach(*this, ds, matches);
+  }
+
   bool IdenticalTo(Rule const & rhs) const override
   {
     auto const * r = dynamic_cast<LeRule const *>(&rhs);
@@ -182,6 +230,11 @@ struct GtRule final : public Rule
     return Field::Gt(Field::Select(d), m_value);
   }
 
+  void Matches(vector<Description> const & ds, vector<bool> & matches) const override
+  {
+    MatchEach(*this, ds, matches);
+  }
+
   bool IdenticalTo(Rule const & rhs) const override
   {
     auto const * r = dynamic_cast<GtRule const *>(&rhs);
@@ -212,6 +265,11 @@ struct GeRule final : public Rule
     return Field::Gt(value, m_value) || Field::Eq(value, m_value);
   }
 
+  void Matches(vector<Description> const & ds, vector<bool> & matches) const override
+  {
+    MatchEach(*this, ds, matches);
+  }
+
   bool IdenticalTo(Rule const & rhs) const override
   {
     auto const * r = dynamic_cast<GeRule const *>(&rhs);
@@ -243,6 +301,20 @@ struct AndRule final : public Rule
     return matches;
   }
 
+  void Matches(vector<Description> const & ds, vector<bool> & matches) const override
+  {
+    matches.assign(ds.size(), true);
+    vector<bool> operand;
+    for (auto const & rule : {m_lhs, m_rhs})
+    {
+      if (!rule)
+        continue;
+      rule->Matches(ds, operand);
+      for (size_t i = 0; i < ds.size(); ++i)
+        matches[i] = matches[i] && operand[i];
+    }
+  }
+
   bool IdenticalTo(Rule const & rhs) const override
   {
     auto const * r = dynamic_cast<AndRule const *>(&rhs);
@@ -279,6 +351,20 @@ struct OrRule final : public Rule
     return matches;
   }
 
+  void Matches(vector<Description> const & ds, vector<bool> & matches) const override
+  {
+    matches.assign(ds.size(), false);
+    vector<bool> operand;
+    for (auto const & rule : {m_lhs, m_rhs})
+    {
+      if (!rule)
+        continue;
+      rule->Matches(ds, operand);
+      for (size_t i = 0; i < ds.size(); ++i)
+        matches[i] = matches[i] || operand[i];
+    }
+  }
+
   bool IdenticalTo(Rule const & rhs) const override
   {
     auto const * r = dynamic_cast<OrRule const *>(&rhs);
@@ -307,6 +393,11 @@ struct OneOfRule final : public Rule
   // Rule overrides:
   bool Matches(Description const & d) const override { return (d.m_types & m_types) != 0; }
 
+  void Matches(vector<Description> const & ds, vector<bool> & matches) const override
+  {
+    MatchEach(*this, ds, matches);
+  }
+
   bool IdenticalTo(Rule const & rhs) const override
   {
     auto const * r = dynamic_cast<OneOfRule const *>(&rhs);
@@ -384,20 +475,30 @@ inline shared_ptr<Rule> OneOf(unsigned types) { return make_shared<OneOfRule>(ty
 class HotelsFilter
 {
 public:
-  using Descriptions = vector<pair<uint32_t, Description>>;
+  // Descriptions of hotels of an mwm in columns: |m_descriptions[i]|
+  // is the description of the feature |m_featureIds[i]|. Feature ids
+  // are sorted.
+  struct Descriptions
+  {
+    vector<uint32_t> m_featureIds;
+    vector<Description> m_descriptions;
+  };
 
   class ScopedFilter
   {
   public:
+    // Evaluates |rule| for all the |descriptions| at once.
     ScopedFilter(MwmSet::MwmId const & mwmId, Descriptions const & descriptions,
                  shared_ptr<Rule> rule);
 
     bool Matches(FeatureID const & fid) const;
 
+    // Returns features of the mwm which match the rule.
+    CBV const & GetMatchingFeatures() const { return m_matching; }
+
   private:
     MwmSet::MwmId const m_mwmId;
-    Descriptions const & m_descriptions;
-    shared_ptr<Rule> const m_rule;
+    CBV m_matching;
   };
 
   HotelsFilter(HotelsCache & hotels);
@@ -0,0 +1,169 @@
+#include "search/hotels_table.hpp"
+
+#include "coding/file_container.hpp"
+#include "coding/reader.hpp"
+#include "coding/varint.hpp"
+#include "coding/write_to_sink.hpp"
+#include "coding/writer.hpp"
+
+#include "base/logging.hpp"
+
+#include "std/algorithm.hpp"
+#include "std/cmath.hpp"
+#include "std/limits.hpp"
+
+#include "defines.hpp"
+
+namespace search
+{
+namespace
+{
+double constexpr kRatingScale = 100.0;
+
+template <typename T, typename V>
+T Clamp(V value)
+{
+  if (value < static_cast<V>(numeric_limits<T>::min()))
+    return numeric_limits<T>::min();
+  if (value > static_cast<V>(numeric_limits<T>::max()))
+    return numeric_limits<T>::max();
+  return static_cast<T>(value);
+}
+
+template <typename T, typename Source>
+void ReadColumn(Source & source, size_t size, vector<T> & column)
+{
+  column.resize(size);
+  for (auto & value : column)
+    value = ReadPrimitiveFromSource<T>(source);
+}
+
+template <typename T>
+void WriteColumn(Writer & writer, vector<T> const & column)
+{
+  for (auto const value : column)
+    WriteToSink(writer, value);
+}
+}  // namespace
+
+// HotelsTable -------------------------------------------------------------------------------------
+// static
+uint8_t constexpr HotelsTable::kLatestVersion;
+
+// static
+unique_ptr<HotelsTable> HotelsTable::Load(FilesContainerR const & cont)
+{
+  if (!cont.IsExist(HOTELS_FILE_TAG))
+    return unique_ptr<HotelsTable>();
+
+  try
+  {
+    auto reader = cont.GetReader(HOTELS_FILE_TAG);
+    return Load(*reader.GetPtr());
+  }
+  catch (Reader::Exception const & e)
+  {
+    LOG(LERROR, ("Can't read hotels table:", e.Msg()));
+  }
+  return unique_ptr<HotelsTable>();
+}
+
+// static
+unique_ptr<HotelsTable> HotelsTable::Load(Reader & reader)
+{
+  NonOwningReaderSource source(reader);
+
+  auto const version = ReadPrimitiveFromSource<uint8_t>(source);
+  if (version != kLatestVersion)
+  {
+    LOG(LWARNING, ("Unsupported version of hotels table:", version));
+    return unique_ptr<HotelsTable>();
+  }
+
+  auto table = make_unique<HotelsTable>();
+  auto const numHotels = ReadVarUint<uint64_t>(source);
+  // Every hotel takes several bytes, so a broken size is rejected before allocations.
+  if (numHotels > source.Size())
+    return unique_ptr<HotelsTable>();
+
+  auto const size = static_cast<size_t>(numHotels);
+  table->m_featureIds.reserve(size);
+  uint32_t id = 0;
+  for (size_t i = 0; i < size; ++i)
+  {
+    id += ReadVarUint<uint32_t>(source);
+    table->m_featureIds.push_back(id);
+  }
+
+  ReadColumn(source, size, table->m_ratings);
+  ReadColumn(source, size, table->m_priceRates);
+  ReadColumn(source, size, table->m_stars);
+  ReadColumn(source, size, table->m_types);
+  return table;
+}
+
+size_t HotelsTable::Find(uint32_t featureId) const
+{
+  auto const it = lower_bound(m_featureIds.begin(), m_featureIds.end(), featureId);
+  if (it == m_featureIds.end() || *it != featureId)
+    return GetSize();
+  return static_cast<size_t>(distance(m_featureIds.begin(), it));
+}
+
+hotels_filter::Description HotelsTable::GetDescription(size_t i) const
+{
+  ASSERT_LESS(i, GetSize(), ());
+  hotels_filter::Description description;
+  description.m_rating = static_cast<hotels_filter::Rating::Value>(m_ratings[i] / kRatingScale);
+  description.m_priceRate = m_priceRates[i];
+  description.m_stars = m_stars[i];
+  description.m_types = m_types[i];
+  return description;
+}
+
+// HotelsTableBuilder ------------------------------------------------------------------------------
+void HotelsTableBuilder::Put(uint32_t featureId, hotels_filter::Description const & description)
+{
+  m_hotels.emplace_back(featureId, description);
+}
+
+void HotelsTableBuilder::Freeze(Writer & writer) const
+{
+  auto hotels = m_hotels;
+  sort(hotels.begin(), hotels.end(),
+       [](pair<uint32_t, hotels_filter::Description> const & lhs,
+          pair<uint32_t, hotels_filter::Description> const & rhs) { return lhs.first < rhs.first; });
+
+  HotelsTable table;
+  uint32_t prevId = 0;
+  bool first = true;
+  for (auto const & hotel : hotels)
+  {
+    CHECK(first || hotel.first != prevId, ("Duplicate hotel", hotel.first));
+    first = false;
+    prevId = hotel.first;
+
+    auto const & description = hotel.second;
+    table.m_featureIds.push_back(hotel.first);
+    table.m_ratings.push_back(Clamp<uint16_t>(round(description.m_rating * kRatingScale)));
+    table.m_priceRates.push_back(Clamp<uint8_t>(description.m_priceRate));
+    table.m_stars.push_back(Clamp<uint8_t>(description.m_stars));
+    table.m_types.push_back(description.m_types);
+  }
+
+  WriteToSink(writer, HotelsTable::kLatestVersion);
+  WriteVarUint(writer, static_cast<uint64_t>(table.GetSize()));
+
+  prevId = 0;
+  for (auto const id : table.m_featureIds)
+  {
+    WriteVarUint(writer, id - prevId);
+    prevId = id;
+  }
+
+  WriteColumn(writer, table.m_ratings);
+  WriteColumn(writer, table.m_priceRates);
+  WriteColumn(writer, table.m_stars);
+  WriteColumn(writer, table.m_types);
+}
+}  // namespace search
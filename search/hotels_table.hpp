@@ -0,0 +1,73 @@
+#pragma once
+
+#include "search/hotels_filter.hpp"
+
+#include "std/cstdint.hpp"
+#include "std/unique_ptr.hpp"
+#include "std/utility.hpp"
+#include "std/vector.hpp"
+
+class FilesContainerR;
+class Reader;
+class Writer;
+
+namespace search
+{
+// A wrapper class around serialized as an mwm-section table of hotel
+// attributes. Attributes which are checked by hotels_filter::Rule are
+// kept in columns by hotels, so hotels of an mwm are filtered without
+// loading and parsing of features.
+//
+// The section is serialized in the following format (integers are
+// stored little-endian, "varuint" means WriteVarUint):
+//
+// Field name         Field type
+// version            uint8_t
+// numHotels          varuint
+// featureIds         numHotels times, varuint, sorted and delta-coded
+// ratings            numHotels times, uint16_t, hundredths of rating
+// priceRates         numHotels times, uint8_t
+// stars              numHotels times, uint8_t
+// types              numHotels times, uint32_t, mask of IsHotelChecker types
+//
+// *NOTE* There should always be backward-compatibility. When adding
+// new versions, never change data format of old versions.
+class HotelsTable
+{
+public:
+  static uint8_t constexpr kLatestVersion = 0;
+
+  // Loads the table from the section of |cont|. Returns nullptr when
+  // there's no section or it can't be read.
+  static unique_ptr<HotelsTable> Load(FilesContainerR const & cont);
+  static unique_ptr<HotelsTable> Load(Reader & reader);
+
+  inline size_t GetSize() const { return m_featureIds.size(); }
+
+  // Returns the position of |featureId| in the table or GetSize() if
+  // there's no such hotel.
+  size_t Find(uint32_t featureId) const;
+
+  inline uint32_t GetFeatureId(size_t i) const { return m_featureIds[i]; }
+  hotels_filter::Description GetDescription(size_t i) const;
+
+private:
+  friend class HotelsTableBuilder;
+
+  vector<uint32_t> m_featureIds;
+  vector<uint16_t> m_ratings;
+  vector<uint8_t> m_priceRates;
+  vector<uint8_t> m_stars;
+  vector<uint32_t> m_types;
+};
+
+class HotelsTableBuilder
+{
+public:
+  void Put(uint32_t featureId, hotels_filter::Description const & description);
+  void Freeze(Writer & writer) const;
+
+private:
+  vector<pair<uint32_t, hotels_filter::Description>> m_hotels;
+};
+}  // namespace search
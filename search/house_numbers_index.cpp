@@ -0,0 +1,165 @@
+#include "search/house_numbers_index.hpp"
+
+#include "coding/file_container.hpp"
+#include "coding/reader.hpp"
+#include "coding/varint.hpp"
+#include "coding/write_to_sink.hpp"
+#include "coding/writer.hpp"
+
+#include "base/logging.hpp"
+
+#include "std/limits.hpp"
+
+#include "defines.hpp"
+
+namespace search
+{
+bool GetHouseNumberKey(vector<house_numbers::Token> const & parse, uint32_t & key)
+{
+  if (parse.empty() || parse[0].m_type != house_numbers::Token::TYPE_NUMBER)
+    return false;
+
+  uint64_t value = 0;
+  for (auto const c : parse[0].m_value)
+  {
+    if (c < '0' || c > '9')
+      return false;
+    value = value * 10 + static_cast<uint64_t>(c - '0');
+    if (value > numeric_limits<uint32_t>::max())
+    {
+      key = numeric_limits<uint32_t>::max();
+      return true;
+    }
+  }
+  key = static_cast<uint32_t>(value);
+  return true;
+}
+
+// HouseNumbersIndex -------------------------------------------------------------------------------
+// static
+uint8_t constexpr HouseNumbersIndex::kLatestVersion;
+
+// static
+unique_ptr<HouseNumbersIndex> HouseNumbersIndex::Load(FilesContainerR const & cont)
+{
+  if (!cont.IsExist(HOUSE_NUMBERS_FILE_TAG))
+    return unique_ptr<HouseNumbersIndex>();
+
+  try
+  {
+    auto reader = cont.GetReader(HOUSE_NUMBERS_FILE_TAG);
+    return Load(*reader.GetPtr());
+  }
+  catch (Reader::Exception const & e)
+  {
+    LOG(LERROR, ("Can't read house numbers index:", e.Msg()));
+  }
+  return unique_ptr<HouseNumbersIndex>();
+}
+
+// static
+unique_ptr<HouseNumbersIndex> HouseNumbersIndex::Load(Reader & reader)
+{
+  NonOwningReaderSource source(reader);
+
+  auto const version = ReadPrimitiveFromSource<uint8_t>(source);
+  if (version != kLatestVersion)
+  {
+    LOG(LWARNING, ("Unsupported version of house numbers index:", version));
+    return unique_ptr<HouseNumbersIndex>();
+  }
+
+  auto index = make_unique<HouseNumbersIndex>();
+  auto const numStreets = ReadVarUint<uint64_t>(source);
+  // Every street takes at least two bytes, so a broken size is rejected before allocations.
+  if (numStreets > source.Size())
+    return unique_ptr<HouseNumbersIndex>();
+
+  auto const size = static_cast<size_t>(numStreets);
+  index->m_streetIds.reserve(size);
+  index->m_offsets.reserve(size + 1);
+  index->m_offsets.push_back(0);
+
+  uint32_t streetId = 0;
+  uint64_t numHouses = 0;
+  for (size_t i = 0; i < size; ++i)
+  {
+    streetId += ReadVarUint<uint32_t>(source);
+    numHouses += ReadVarUint<uint32_t>(source);
+    if (numHouses > source.Size() || numHouses > numeric_limits<uint32_t>::max())
+      return unique_ptr<HouseNumbersIndex>();
+    index->m_streetIds.push_back(streetId);
+    index->m_offsets.push_back(static_cast<uint32_t>(numHouses));
+  }
+
+  index->m_keys.reserve(static_cast<size_t>(numHouses));
+  index->m_houseIds.reserve(static_cast<size_t>(numHouses));
+  for (size_t i = 0; i < size; ++i)
+  {
+    uint32_t key = 0;
+    for (uint32_t j = index->m_offsets[i]; j < index->m_offsets[i + 1]; ++j)
+    {
+      key += ReadVarUint<uint32_t>(source);
+      index->m_keys.push_back(key);
+      index->m_houseIds.push_back(ReadVarUint<uint32_t>(source));
+    }
+  }
+  return index;
+}
+
+// HouseNumbersIndexBuilder ------------------------------------------------------------------------
+bool HouseNumbersIndexBuilder::Entry::operator<(Entry const & rhs) const
+{
+  if (m_streetId != rhs.m_streetId)
+    return m_streetId < rhs.m_streetId;
+  if (m_key != rhs.m_key)
+    return m_key < rhs.m_key;
+  return m_houseId < rhs.m_houseId;
+}
+
+bool HouseNumbersIndexBuilder::Entry::operator==(Entry const & rhs) const
+{
+  return m_streetId == rhs.m_streetId && m_key == rhs.m_key && m_houseId == rhs.m_houseId;
+}
+
+void HouseNumbersIndexBuilder::Put(uint32_t streetId, uint32_t key, uint32_t houseId)
+{
+  m_entries.push_back({streetId, key, houseId});
+}
+
+void HouseNumbersIndexBuilder::Freeze(Writer & writer) const
+{
+  auto entries = m_entries;
+  sort(entries.begin(), entries.end());
+  entries.erase(unique(entries.begin(), entries.end()), entries.end());
+
+  vector<pair<uint32_t, uint32_t>> streets;
+  for (auto const & entry : entries)
+  {
+    if (streets.empty() || streets.back().first != entry.m_streetId)
+      streets.emplace_back(entry.m_streetId, 0 /* numHouses */);
+    ++streets.back().second;
+  }
+
+  WriteToSink(writer, HouseNumbersIndex::kLatestVersion);
+  WriteVarUint(writer, static_cast<uint64_t>(streets.size()));
+
+  uint32_t prevStreetId = 0;
+  for (auto const & street : streets)
+  {
+    WriteVarUint(writer, street.first - prevStreetId);
+    WriteVarUint(writer, street.second);
+    prevStreetId = street.first;
+  }
+
+  uint32_t prevKey = 0;
+  for (size_t i = 0; i < entries.size(); ++i)
+  {
+    if (i == 0 || entries[i].m_streetId != entries[i - 1].m_streetId)
+      prevKey = 0;
+    WriteVarUint(writer, entries[i].m_key - prevKey);
+    WriteVarUint(writer, entries[i].m_houseId);
+    prevKey = entries[i].m_key;
+  }
+}
+}  // namespace search
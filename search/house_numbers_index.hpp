@@ -0,0 +1,126 @@
+#pragma once
+
+#include "search/house_numbers_matcher.hpp"
+
+#include "base/assert.hpp"
+
+#include "std/algorithm.hpp"
+#include "std/cstdint.hpp"
+#include "std/unique_ptr.hpp"
+#include "std/utility.hpp"
+#include "std/vector.hpp"
+
+class FilesContainerR;
+class Reader;
+class Writer;
+
+namespace search
+{
+// Returns in |key| the leading number of a simplified house number
+// parse (see house_numbers::ParseHouseNumber() and
+// house_numbers::ParseQuery()). Numbers which don't fit uint32_t are
+// saturated. Returns false when |parse| doesn't start with a number.
+//
+// house_numbers::HouseNumbersMatch() requires the first tokens of a
+// house number and a query to be equal, so a house matches a query
+// only when their keys are equal.
+bool GetHouseNumberKey(vector<house_numbers::Token> const & parse, uint32_t & key);
+
+// A wrapper class around serialized as an mwm-section index of house
+// numbers by streets. For every street it keeps the houses which are
+// matched to the street (see HouseToStreetTable) sorted by the keys
+// of their house numbers (see GetHouseNumberKey()), so the houses with
+// a number on a street are found by a binary search, without loading
+// of all the features in the street vicinity. A house with several
+// numbers (e.g. "10-12" or "10;12") is kept once for every number.
+//
+// The index only prefilters houses. Letters and building parts
+// ("12a", "12 к2") share the key of their number, so the candidates
+// should be checked by house_numbers::HouseNumbersMatch().
+//
+// The section is serialized in the following format (integers are
+// stored little-endian, "varuint" means WriteVarUint):
+//
+// Field name         Field type
+// version            uint8_t
+// numStreets         varuint
+// streets            numStreets times, pair of varuints (streetId, numHouses),
+//                    sorted by streetId, streetIds are delta-coded
+// houses             for every street numHouses times, pair of varuints
+//                    (key, houseId), sorted by (key, houseId), keys are
+//                    delta-coded inside the street
+//
+// *NOTE* There should always be backward-compatibility. When adding
+// new versions, never change data format of old versions.
+class HouseNumbersIndex
+{
+public:
+  static uint8_t constexpr kLatestVersion = 0;
+
+  // Loads the index from the section of |cont|. Returns nullptr when
+  // there's no section or it can't be read.
+  static unique_ptr<HouseNumbersIndex> Load(FilesContainerR const & cont);
+  static unique_ptr<HouseNumbersIndex> Load(Reader & reader);
+
+  inline size_t GetNumStreets() const { return m_streetIds.size(); }
+  inline size_t GetNumHouses() const { return m_houseIds.size(); }
+
+  // Calls |fn| for every house on |streetId| whose key is in the range
+  // [|fromKey|, |toKey|]. Houses are visited in the order of keys.
+  template <typename Fn>
+  void ForEachHouseInRange(uint32_t streetId, uint32_t fromKey, uint32_t toKey, Fn && fn) const
+  {
+    if (fromKey > toKey)
+      return;
+
+    auto const it = lower_bound(m_streetIds.begin(), m_streetIds.end(), streetId);
+    if (it == m_streetIds.end() || *it != streetId)
+      return;
+
+    auto const i = static_cast<size_t>(distance(m_streetIds.begin(), it));
+    ASSERT_LESS(i + 1, m_offsets.size(), ());
+    auto const begin = m_keys.begin() + m_offsets[i];
+    auto const end = m_keys.begin() + m_offsets[i + 1];
+    auto const first = lower_bound(begin, end, fromKey);
+    auto const last = upper_bound(first, end, toKey);
+    for (auto jt = first; jt != last; ++jt)
+      fn(m_houseIds[static_cast<size_t>(distance(m_keys.begin(), jt))]);
+  }
+
+  // Calls |fn| for every house on |streetId| with |key|.
+  template <typename Fn>
+  void ForEachHouse(uint32_t streetId, uint32_t key, Fn && fn) const
+  {
+    ForEachHouseInRange(streetId, key, key, forward<Fn>(fn));
+  }
+
+private:
+  friend class HouseNumbersIndexBuilder;
+
+  vector<uint32_t> m_streetIds;
+  // Houses of the street m_streetIds[i] are in [m_offsets[i], m_offsets[i + 1]).
+  vector<uint32_t> m_offsets;
+  vector<uint32_t> m_keys;
+  vector<uint32_t> m_houseIds;
+};
+
+class HouseNumbersIndexBuilder
+{
+public:
+  void Put(uint32_t streetId, uint32_t key, uint32_t houseId);
+  void Freeze(Writer & writer) const;
+
+private:
+  struct Entry
+  {
+    bool operator<(Entry const & rhs) const;
+    bool operator==(Entry const & rhs) const;
+
+    uint32_t m_streetId;
+    uint32_t m_key;
+    uint32_t m_houseId;
+  };
+
+  vector<Entry> m_entries;
+};
+}  // namespace search
@@ -7,6 +7,8 @@
 
 #include "indexer/feature_data.hpp"
 
+#include "base/object_arena.hpp"
+
 #include "std/set.hpp"
 
 class FeatureType;
@@ -160,11 +162,14 @@ inline string DebugPrint(PreResult2 const & t)
 
 void ProcessMetadata(FeatureType const & ft, Result::Metadata & meta);
 
+// Second pass results are allocated per query, so they aren't freed
+// one by one but are destroyed all at once when the next query starts.
+using PreResult2Arena = base::ObjectArena<PreResult2>;
+
+// Doesn't own the value, which lives in a PreResult2Arena.
 class IndexedValue
 {
-  /// @todo Do not use shared_ptr for optimization issues.
-  /// Need to rewrite std::unique algorithm.
-  unique_ptr<PreResult2> m_value;
+  PreResult2 const * m_value;
 
   double m_rank;
   double m_distanceToPivot;
@@ -180,8 +185,8 @@ class IndexedValue
   }
 
 public:
-  explicit IndexedValue(unique_ptr<PreResult2> value)
-    : m_value(move(value)), m_rank(0.0), m_distanceToPivot(numeric_limits<double>::max())
+  explicit IndexedValue(PreResult2 const * value)
+    : m_value(value), m_rank(0.0), m_distanceToPivot(numeric_limits<double>::max())
   {
     if (!m_value)
       return;
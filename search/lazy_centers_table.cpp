@@ -2,14 +2,16 @@
 
 #include "indexer/index.hpp"
 
-#include "defines.hpp"
-
 namespace search
 {
 LazyCentersTable::LazyCentersTable(MwmValue & value)
-  : m_value(value)
-  , m_state(STATE_NOT_LOADED)
-  , m_reader(unique_ptr<ModelReader>())
+  : LazyCentersTable(value, MwmSet::MwmId(), nullptr /* cache */)
+{
+}
+
+LazyCentersTable::LazyCentersTable(MwmValue & value, MwmSet::MwmId const & id,
+                                   MwmTablesCache * cache)
+  : m_value(value), m_id(id), m_cache(cache), m_state(STATE_NOT_LOADED)
 {
 }
 
@@ -18,20 +20,11 @@ void LazyCentersTable::EnsureTableLoaded()
   if (m_state != STATE_NOT_LOADED)
     return;
 
-  if (!m_value.m_cont.IsExist(CENTERS_FILE_TAG))
-  {
-    m_state = STATE_FAILED;
-    return;
-  }
-
-  m_reader = m_value.m_cont.GetReader(CENTERS_FILE_TAG);
-  if (!m_reader.GetPtr())
-  {
-    m_state = STATE_FAILED;
-    return;
-  }
+  if (m_cache && m_id.IsAlive())
+    m_table = m_cache->GetCentersTable(m_id, m_value);
+  else
+    m_table = SharedCentersTable::Load(m_value);
 
-  m_table = CentersTable::Load(*m_reader.GetPtr(), m_value.GetHeader().GetDefCodingParams());
   if (m_table)
     m_state = STATE_LOADED;
   else
@@ -45,4 +38,17 @@ bool LazyCentersTable::Get(uint32_t id, m2::PointD & center)
     return false;
   return m_table->Get(id, center);
 }
+
+void LazyCentersTable::GetBatch(vector<uint32_t> const & ids, vector<m2::PointD> & centers,
+                                vector<bool> & found)
+{
+  EnsureTableLoaded();
+  if (m_state != STATE_LOADED)
+  {
+    centers.assign(ids.size(), m2::PointD());
+    found.assign(ids.size(), false);
+    return;
+  }
+  m_table->GetBatch(ids, centers, found);
+}
 }  // namespace search
@@ -1,12 +1,13 @@
 #pragma once
 
-#include "indexer/centers_table.hpp"
+#include "search/mwm_tables_cache.hpp"
 
-#include "coding/file_container.hpp"
+#include "indexer/mwm_set.hpp"
 
 #include "geometry/point2d.hpp"
 
-#include "std/unique_ptr.hpp"
+#include "std/shared_ptr.hpp"
+#include "std/vector.hpp"
 
 class MwmValue;
 
@@ -24,17 +25,25 @@ public:
 
   explicit LazyCentersTable(MwmValue & value);
 
+  // The table is taken from |cache| when it's not null, so it's
+  // shared with other users of the mwm |id|.
+  LazyCentersTable(MwmValue & value, MwmSet::MwmId const & id, MwmTablesCache * cache);
+
   inline State GetState() const { return m_state; }
 
   void EnsureTableLoaded();
 
   WARN_UNUSED_RESULT bool Get(uint32_t id, m2::PointD & center);
 
+  // See CentersTable::GetBatch().
+  void GetBatch(vector<uint32_t> const & ids, vector<m2::PointD> & centers, vector<bool> & found);
+
 private:
   MwmValue & m_value;
+  MwmSet::MwmId const m_id;
+  MwmTablesCache * const m_cache;
   State m_state;
 
-  FilesContainerR::TReader m_reader;
-  unique_ptr<CentersTable> m_table;
+  shared_ptr<SharedCentersTable> m_table;
 };
 }  // namespace search
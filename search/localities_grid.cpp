@@ -0,0 +1,190 @@
+#include "search/localities_grid.hpp"
+
+#include "coding/file_container.hpp"
+#include "coding/reader.hpp"
+#include "coding/varint.hpp"
+#include "coding/write_to_sink.hpp"
+#include "coding/writer.hpp"
+
+#include "geometry/mercator.hpp"
+#include "geometry/rect2d.hpp"
+
+#include "base/logging.hpp"
+#include "base/stl_helpers.hpp"
+
+#include "std/cmath.hpp"
+
+#include "defines.hpp"
+
+namespace search
+{
+namespace
+{
+uint8_t constexpr kMaxLevel = 30;
+
+// Localities are added to the cells intersecting a slightly larger
+// rect, so mercator distortions don't lose them.
+double constexpr kRadiusMargin = 1.1;
+
+LocalitiesGrid::CellId MakeCellId(uint32_t x, uint32_t y)
+{
+  return (static_cast<LocalitiesGrid::CellId>(y) << 32) | x;
+}
+
+uint32_t GetCellCoord(double v, double minV, double maxV, uint8_t level)
+{
+  uint32_t const numCells = 1U << level;
+  double const cell = floor((v - minV) / (maxV - minV) * numCells);
+  if (cell < 0)
+    return 0;
+  if (cell >= numCells)
+    return numCells - 1;
+  return static_cast<uint32_t>(cell);
+}
+
+uint32_t GetCellX(double x, uint8_t level)
+{
+  return GetCellCoord(x, MercatorBounds::minX, MercatorBounds::maxX, level);
+}
+
+uint32_t GetCellY(double y, uint8_t level)
+{
+  return GetCellCoord(y, MercatorBounds::minY, MercatorBounds::maxY, level);
+}
+
+// Returns the finest level which cells are not smaller than the
+// diameter of the locality rect on the equator, so every locality is
+// put into a few cells only. Mercator rects are larger at higher
+// latitudes, so there localities are put into more cells.
+uint8_t GetLevel(uint32_t radiusMeters)
+{
+  double const diameter =
+      MercatorBounds::RectByCenterXYAndSizeInMeters(m2::PointD(0, 0), radiusMeters).SizeX();
+  double const worldSize = MercatorBounds::maxX - MercatorBounds::minX;
+
+  uint8_t level = 0;
+  while (level < kMaxLevel && worldSize / (1U << (level + 1)) >= diameter)
+    ++level;
+  return level;
+}
+}  // namespace
+
+// LocalitiesGrid ----------------------------------------------------------------------------------
+// static
+uint8_t constexpr LocalitiesGrid::kLatestVersion;
+
+// static
+unique_ptr<LocalitiesGrid> LocalitiesGrid::Load(FilesContainerR const & cont)
+{
+  if (!cont.IsExist(LOCALITIES_GRID_FILE_TAG))
+    return unique_ptr<LocalitiesGrid>();
+
+  try
+  {
+    auto reader = cont.GetReader(LOCALITIES_GRID_FILE_TAG);
+    return Load(*reader.GetPtr());
+  }
+  catch (Reader::Exception const & e)
+  {
+    LOG(LERROR, ("Can't read localities grid:", e.Msg()));
+  }
+  return unique_ptr<LocalitiesGrid>();
+}
+
+// static
+unique_ptr<LocalitiesGrid> LocalitiesGrid::Load(Reader & reader)
+{
+  NonOwningReaderSource source(reader);
+
+  auto const version = ReadPrimitiveFromSource<uint8_t>(source);
+  if (version != kLatestVersion)
+  {
+    LOG(LWARNING, ("Unsupported version of localities grid:", version));
+    return unique_ptr<LocalitiesGrid>();
+  }
+
+  auto grid = make_unique<LocalitiesGrid>();
+  grid->m_level = ReadPrimitiveFromSource<uint8_t>(source);
+  grid->m_radiusMeters = ReadPrimitiveFromSource<uint32_t>(source);
+  if (grid->m_level > kMaxLevel)
+    return unique_ptr<LocalitiesGrid>();
+
+  auto const numCells = ReadVarUint<uint64_t>(source);
+  grid->m_cells.reserve(numCells);
+  grid->m_offsets.reserve(numCells + 1);
+  grid->m_offsets.push_back(0);
+
+  CellId cell = 0;
+  for (uint64_t i = 0; i < numCells; ++i)
+  {
+    cell += ReadVarUint<uint64_t>(source);
+    grid->m_cells.push_back(cell);
+
+    auto const numIds = ReadVarUint<uint32_t>(source);
+    uint32_t id = 0;
+    for (uint32_t j = 0; j < numIds; ++j)
+    {
+      id += ReadVarUint<uint32_t>(source);
+      grid->m_ids.push_back(id);
+    }
+    grid->m_offsets.push_back(static_cast<uint32_t>(grid->m_ids.size()));
+  }
+
+  return grid;
+}
+
+LocalitiesGrid::CellId LocalitiesGrid::GetCellId(m2::PointD const & p) const
+{
+  return MakeCellId(GetCellX(p.x, m_level), GetCellY(p.y, m_level));
+}
+
+// LocalitiesGridBuilder ---------------------------------------------------------------------------
+LocalitiesGridBuilder::LocalitiesGridBuilder(uint32_t radiusMeters)
+  : m_level(GetLevel(radiusMeters)), m_radiusMeters(radiusMeters)
+{
+}
+
+void LocalitiesGridBuilder::Put(uint32_t featureId, m2::PointD const & center)
+{
+  auto const rect =
+      MercatorBounds::RectByCenterXYAndSizeInMeters(center, m_radiusMeters * kRadiusMargin);
+
+  uint32_t const minX = GetCellX(rect.minX(), m_level);
+  uint32_t const maxX = GetCellX(rect.maxX(), m_level);
+  uint32_t const minY = GetCellY(rect.minY(), m_level);
+  uint32_t const maxY = GetCellY(rect.maxY(), m_level);
+
+  for (uint32_t y = minY; y <= maxY; ++y)
+  {
+    for (uint32_t x = minX; x <= maxX; ++x)
+      m_cells[MakeCellId(x, y)].push_back(featureId);
+  }
+}
+
+void LocalitiesGridBuilder::Freeze(Writer & writer) const
+{
+  WriteToSink(writer, LocalitiesGrid::kLatestVersion);
+  WriteToSink(writer, m_level);
+  WriteToSink(writer, m_radiusMeters);
+
+  WriteVarUint(writer, static_cast<uint64_t>(m_cells.size()));
+
+  LocalitiesGrid::CellId prevCell = 0;
+  for (auto const & entry : m_cells)
+  {
+    WriteVarUint(writer, entry.first - prevCell);
+    prevCell = entry.first;
+
+    auto ids = entry.second;
+    my::SortUnique(ids);
+    WriteVarUint(writer, static_cast<uint32_t>(ids.size()));
+
+    uint32_t prevId = 0;
+    for (auto const id : ids)
+    {
+      WriteVarUint(writer, id - prevId);
+      prevId = id;
+    }
+  }
+}
+}  // namespace search
@@ -0,0 +1,99 @@
+#pragma once
+
+#include "geometry/point2d.hpp"
+
+#include "base/assert.hpp"
+
+#include "std/algorithm.hpp"
+#include "std/cstdint.hpp"
+#include "std/map.hpp"
+#include "std/unique_ptr.hpp"
+#include "std/vector.hpp"
+
+class FilesContainerR;
+class Reader;
+class Writer;
+
+namespace search
+{
+// A wrapper class around serialized as an mwm-section grid of
+// localities. The world is split into square cells and every cell
+// lists ids of the localities which are closer than the radius of
+// the grid to some point of the cell. So, all localities around a
+// point are found by a lookup of a single cell instead of a scan of
+// the geometry index.
+//
+// The section is serialized in the following format (integers are
+// stored little-endian, "varuint" means WriteVarUint):
+//
+// Field name         Field type
+// version            uint8_t
+// level              uint8_t, cells are 2^-level of the world size
+// radius             uint32_t, in meters
+// numCells           varuint
+// cells              numCells times:
+//   cell id          varuint, delta from the previous cell id
+//   numIds           varuint
+//   ids              numIds times, varuint, sorted and delta-coded
+//
+// *NOTE* There should always be backward-compatibility. When adding
+// new versions, never change data format of old versions.
+class LocalitiesGrid
+{
+public:
+  using CellId = uint64_t;
+
+  static uint8_t constexpr kLatestVersion = 0;
+
+  // Loads the grid from the section of |cont|. Returns nullptr when
+  // there's no section or it can't be read.
+  static unique_ptr<LocalitiesGrid> Load(FilesContainerR const & cont);
+  static unique_ptr<LocalitiesGrid> Load(Reader & reader);
+
+  inline uint32_t GetRadiusMeters() const { return m_radiusMeters; }
+
+  CellId GetCellId(m2::PointD const & p) const;
+
+  // Calls |fn| on ids of all localities of |cell|.
+  template <typename Fn>
+  void ForEachInCell(CellId cell, Fn && fn) const
+  {
+    auto const it = lower_bound(m_cells.begin(), m_cells.end(), cell);
+    if (it == m_cells.end() || *it != cell)
+      return;
+
+    auto const i = static_cast<size_t>(distance(m_cells.begin(), it));
+    ASSERT_LESS(i + 1, m_offsets.size(), ());
+    for (uint32_t j = m_offsets[i]; j < m_offsets[i + 1]; ++j)
+      fn(m_ids[j]);
+  }
+
+private:
+  friend class LocalitiesGridBuilder;
+
+  uint8_t m_level = 0;
+  uint32_t m_radiusMeters = 0;
+
+  // Sorted ids of non-empty cells.
+  vector<CellId> m_cells;
+  // Ids of localities of the |i|-th cell are in the range
+  // [m_offsets[i], m_offsets[i + 1]) of |m_ids|.
+  vector<uint32_t> m_offsets;
+  vector<uint32_t> m_ids;
+};
+
+class LocalitiesGridBuilder
+{
+public:
+  explicit LocalitiesGridBuilder(uint32_t radiusMeters);
+
+  void Put(uint32_t featureId, m2::PointD const & center);
+  void Freeze(Writer & writer) const;
+
+private:
+  uint8_t const m_level;
+  uint32_t const m_radiusMeters;
+
+  map<LocalitiesGrid::CellId, vector<uint32_t>> m_cells;
+};
+}  // namespace search
@@ -18,9 +18,6 @@ namespace search
 {
 namespace
 {
-double const kMaxCityRadiusMeters = 30000.0;
-double const kMaxVillageRadiusMeters = 2000.0;
-
 struct Filter
 {
 public:
@@ -197,6 +194,11 @@ void LocalityFinder::Holder::Clear()
 }
 
 // LocalityFinder ----------------------------------------------------------------------------------
+// static
+double const LocalityFinder::kMaxCityRadiusMeters = 30000.0;
+// static
+double const LocalityFinder::kMaxVillageRadiusMeters = 2000.0;
+
 LocalityFinder::LocalityFinder(Index const & index, VillagesCache & villagesCache)
   : m_index(index)
   , m_villagesCache(villagesCache)
@@ -218,11 +220,13 @@ void LocalityFinder::SetLanguage(int8_t lang)
 
 void LocalityFinder::GetLocality(m2::PointD const & p, string & name)
 {
+  UpdateMaps();
+
   m2::RectD const crect = m_cities.GetRect(p);
   m2::RectD const vrect = m_villages.GetRect(p);
 
-  LoadVicinity(p, !m_cities.IsCovered(crect) /* loadCities */,
-               !m_villages.IsCovered(vrect) /* loadVillages */);
+  LoadCities(p, !m_cities.IsCovered(crect) /* scanIndex */);
+  LoadVillages(p, !m_villages.IsCovered(vrect) /* scanIndex */);
 
   LocalitySelector selector(name, p);
   m_cities.ForEachInVicinity(crect, selector);
@@ -240,47 +244,107 @@ void LocalityFinder::ClearCache()
   m_mapsLoaded = false;
 
   m_loadedIds.clear();
+
+  m_grids.clear();
+  m_loadedCells.clear();
 }
 
-void LocalityFinder::LoadVicinity(m2::PointD const & p, bool loadCities, bool loadVillages)
+void LocalityFinder::LoadCities(m2::PointD const & p, bool scanIndex)
 {
-  UpdateMaps();
-
-  if (loadCities)
+  auto const * grid = GetGrid(m_worldId, kMaxCityRadiusMeters);
+  LocalitiesGrid::CellId cell = 0;
+  if (grid)
   {
-    m2::RectD const crect = m_cities.GetDRect(p);
-    auto handle = m_index.GetMwmHandleById(m_worldId);
-    if (handle.IsAlive())
-    {
-      auto const & value = *handle.GetValue<MwmValue>();
-      if (!m_ranks)
-        m_ranks = RankTable::Load(value.m_cont);
-      if (!m_ranks)
-        m_ranks = make_unique<DummyRankTable>();
+    cell = grid->GetCellId(p);
+    if (IsCellLoaded(m_worldId, cell))
+      return;
+  }
+  else if (!scanIndex)
+  {
+    return;
+  }
 
-      MwmContext ctx(move(handle));
-      ctx.ForEachIndex(crect,
-                       LocalitiesLoader(ctx, CityFilter(*m_ranks), m_lang, m_cities, m_loadedIds));
-    }
+  auto handle = m_index.GetMwmHandleById(m_worldId);
+  if (handle.IsAlive())
+  {
+    auto const & value = *handle.GetValue<MwmValue>();
+    if (!m_ranks)
+      m_ranks = RankTable::Load(value.m_cont);
+    if (!m_ranks)
+      m_ranks = make_unique<DummyRankTable>();
+
+    MwmContext ctx(move(handle));
+    CityFilter const filter(*m_ranks);
+    LocalitiesLoader const loader(ctx, filter, m_lang, m_cities, m_loadedIds);
+    if (grid)
+      grid->ForEachInCell(cell, loader);
+    else
+      ctx.ForEachIndex(m_cities.GetDRect(p), loader);
+  }
 
+  if (grid)
+    m_loadedCells[m_worldId].insert(cell);
+  else
     m_cities.SetCovered(p);
-  }
+}
 
-  if (loadVillages)
-  {
-    m2::RectD const vrect = m_villages.GetDRect(p);
-    m_maps.ForEachInRect(m2::RectD(p, p), [&](MwmSet::MwmId const & id) {
-      auto handle = m_index.GetMwmHandleById(id);
-      if (!handle.IsAlive())
+void LocalityFinder::LoadVillages(m2::PointD const & p, bool scanIndex)
+{
+  m_maps.ForEachInRect(m2::RectD(p, p), [&](MwmSet::MwmId const & id) {
+    auto const * grid = GetGrid(id, kMaxVillageRadiusMeters);
+    LocalitiesGrid::CellId cell = 0;
+    if (grid)
+    {
+      cell = grid->GetCellId(p);
+      if (IsCellLoaded(id, cell))
         return;
+    }
+    else if (!scanIndex)
+    {
+      return;
+    }
 
+    auto handle = m_index.GetMwmHandleById(id);
+    if (handle.IsAlive())
+    {
       MwmContext ctx(move(handle));
-      ctx.ForEachIndex(vrect, LocalitiesLoader(ctx, VillageFilter(ctx, m_villagesCache), m_lang,
-                                               m_villages, m_loadedIds));
-    });
+      VillageFilter const filter(ctx, m_villagesCache);
+      LocalitiesLoader const loader(ctx, filter, m_lang, m_villages, m_loadedIds);
+      if (grid)
+        grid->ForEachInCell(cell, loader);
+      else
+        ctx.ForEachIndex(m_villages.GetDRect(p), loader);
+    }
 
+    if (grid)
+      m_loadedCells[id].insert(cell);
+  });
+
+  // Coverage is tracked for mwms without grids only.
+  if (scanIndex)
     m_villages.SetCovered(p);
+}
+
+LocalitiesGrid const * LocalityFinder::GetGrid(MwmSet::MwmId const & id, double radiusMeters)
+{
+  auto it = m_grids.find(id);
+  if (it == m_grids.end())
+  {
+    unique_ptr<LocalitiesGrid> grid;
+    auto handle = m_index.GetMwmHandleById(id);
+    if (handle.IsAlive())
+      grid = LocalitiesGrid::Load(handle.GetValue<MwmValue>()->m_cont);
+    if (grid && grid->GetRadiusMeters() < radiusMeters)
+      grid.reset();
+    it = m_grids.emplace(id, move(grid)).first;
   }
+  return it->second.get();
+}
+
+bool LocalityFinder::IsCellLoaded(MwmSet::MwmId const & id, LocalitiesGrid::CellId cell) const
+{
+  auto const it = m_loadedCells.find(id);
+  return it != m_loadedCells.end() && it->second.count(cell) != 0;
 }
 
 void LocalityFinder::UpdateMaps()
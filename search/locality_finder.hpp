@@ -1,5 +1,7 @@
 #pragma once
 
+#include "search/localities_grid.hpp"
+
 #include "indexer/mwm_set.hpp"
 #include "indexer/rank_table.hpp"
 
@@ -9,6 +11,7 @@
 
 #include "base/macros.hpp"
 
+#include "std/map.hpp"
 #include "std/unique_ptr.hpp"
 #include "std/unordered_set.hpp"
 
@@ -45,6 +48,9 @@ private:
 class LocalityFinder
 {
 public:
+  static double const kMaxCityRadiusMeters;
+  static double const kMaxVillageRadiusMeters;
+
   class Holder
   {
    public:
@@ -77,9 +83,18 @@ public:
   void ClearCache();
 
 private:
-  void LoadVicinity(m2::PointD const & p, bool loadCities, bool loadVillages);
+  // Loads localities around |p|. Localities of mwms with a grid are
+  // loaded cell by cell. Geometry index of the rest mwms is scanned
+  // only when |scanIndex| is true.
+  void LoadCities(m2::PointD const & p, bool scanIndex);
+  void LoadVillages(m2::PointD const & p, bool scanIndex);
   void UpdateMaps();
 
+  // Returns the localities grid of |id| or nullptr when the mwm
+  // doesn't have a grid suitable for |radiusMeters|.
+  LocalitiesGrid const * GetGrid(MwmSet::MwmId const & id, double radiusMeters);
+  bool IsCellLoaded(MwmSet::MwmId const & id, LocalitiesGrid::CellId cell) const;
+
   Index const & m_index;
   VillagesCache & m_villagesCache;
   int8_t m_lang;
@@ -94,5 +109,8 @@ private:
   unique_ptr<RankTable> m_ranks;
 
   map<MwmSet::MwmId, unordered_set<uint32_t>> m_loadedIds;
+
+  map<MwmSet::MwmId, unique_ptr<LocalitiesGrid>> m_grids;
+  map<MwmSet::MwmId, unordered_set<LocalitiesGrid::CellId>> m_loadedCells;
 };
 }  // namespace search
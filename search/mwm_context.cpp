@@ -10,11 +10,17 @@ void CoverRect(m2::RectD const & rect, int scale, covering::IntervalsT & result)
 }
 
 MwmContext::MwmContext(MwmSet::MwmHandle handle)
+  : MwmContext(move(handle), nullptr /* tablesCache */)
+{
+}
+
+MwmContext::MwmContext(MwmSet::MwmHandle handle, MwmTablesCache * tablesCache)
   : m_handle(move(handle))
   , m_value(*m_handle.GetValue<MwmValue>())
+  , m_tablesCache(tablesCache)
   , m_vector(m_value.m_cont, m_value.GetHeader(), m_value.m_table.get())
   , m_index(m_value.m_cont.GetReader(INDEX_FILE_TAG), m_value.m_factory)
-  , m_centers(m_value)
+  , m_centers(m_value, GetId(), tablesCache)
 {
 }
 
@@ -45,4 +51,14 @@ bool MwmContext::GetStreetIndex(uint32_t houseId, uint32_t & streetId)
   }
   return m_houseToStreetTable->Get(houseId, streetId);
 }
+
+HouseNumbersIndex const * MwmContext::GetHouseNumbersIndex()
+{
+  if (!m_houseNumbersIndexLoaded)
+  {
+    m_houseNumbersIndex = HouseNumbersIndex::Load(m_value.m_cont);
+    m_houseNumbersIndexLoaded = true;
+  }
+  return m_houseNumbersIndex.get();
+}
 }  // namespace search
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "search/house_numbers_index.hpp"
 #include "search/house_to_street_table.hpp"
 #include "search/lazy_centers_table.hpp"
 
@@ -25,10 +26,13 @@ class MwmContext
 {
 public:
   explicit MwmContext(MwmSet::MwmHandle handle);
+  // Tables of the mwm are shared through |tablesCache| when it's not null.
+  MwmContext(MwmSet::MwmHandle handle, MwmTablesCache * tablesCache);
 
   inline MwmSet::MwmId const & GetId() const { return m_handle.GetId(); }
   inline string const & GetName() const { return GetInfo()->GetCountryName(); }
   inline shared_ptr<MwmInfo> const & GetInfo() const { return GetId().GetInfo(); }
+  inline MwmTablesCache * GetTablesCache() const { return m_tablesCache; }
 
   template <typename TFn>
   void ForEachIndex(covering::IntervalsT const & intervals, uint32_t scale, TFn && fn) const
@@ -71,11 +75,20 @@ public:
 
   WARN_UNUSED_RESULT bool GetStreetIndex(uint32_t houseId, uint32_t & streetId);
 
+  // Returns nullptr when the mwm has no house numbers index.
+  HouseNumbersIndex const * GetHouseNumbersIndex();
+
   WARN_UNUSED_RESULT inline bool GetCenter(uint32_t index, m2::PointD & center)
   {
     return m_centers.Get(index, center);
   }
 
+  // Returns true if the feature was created, modified or deleted by user.
+  inline bool IsEdited(uint32_t index) const
+  {
+    return GetEditedStatus(index) != osm::Editor::FeatureStatus::Untouched;
+  }
+
   MwmSet::MwmHandle m_handle;
   MwmValue & m_value;
 
@@ -99,9 +112,12 @@ private:
           i.first, i.second, scale);
   }
 
+  MwmTablesCache * const m_tablesCache;
   FeaturesVector m_vector;
   ScaleIndex<ModelReaderPtr> m_index;
   unique_ptr<HouseToStreetTable> m_houseToStreetTable;
+  unique_ptr<HouseNumbersIndex> m_houseNumbersIndex;
+  bool m_houseNumbersIndexLoaded = false;
   LazyCentersTable m_centers;
 
   DISALLOW_COPY_AND_MOVE(MwmContext);
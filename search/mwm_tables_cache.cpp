@@ -0,0 +1,122 @@
+#include "search/mwm_tables_cache.hpp"
+
+#include "search/dummy_rank_table.hpp"
+
+#include "indexer/centers_table.hpp"
+#include "indexer/index.hpp"
+#include "indexer/rank_table.hpp"
+
+#include "defines.hpp"
+
+namespace search
+{
+// SharedCentersTable ------------------------------------------------------------------------------
+SharedCentersTable::SharedCentersTable(FilesContainerR::TReader const & reader,
+                                       unique_ptr<CentersTable> table)
+  : m_reader(reader), m_table(move(table))
+{
+}
+
+SharedCentersTable::~SharedCentersTable() = default;
+
+// static
+unique_ptr<SharedCentersTable> SharedCentersTable::Load(MwmValue const & value)
+{
+  if (!value.m_cont.IsExist(CENTERS_FILE_TAG))
+    return unique_ptr<SharedCentersTable>();
+
+  auto reader = value.m_cont.GetReader(CENTERS_FILE_TAG);
+  if (!reader.GetPtr())
+    return unique_ptr<SharedCentersTable>();
+
+  auto table = CentersTable::Load(*reader.GetPtr(), value.GetHeader().GetDefCodingParams());
+  if (!table)
+    return unique_ptr<SharedCentersTable>();
+
+  return unique_ptr<SharedCentersTable>(new SharedCentersTable(reader, move(table)));
+}
+
+bool SharedCentersTable::Get(uint32_t id, m2::PointD & center)
+{
+  lock_guard<mutex> lock(m_mu);
+  return m_table->Get(id, center);
+}
+
+void SharedCentersTable::GetBatch(vector<uint32_t> const & ids, vector<m2::PointD> & centers,
+                                  vector<bool> & found)
+{
+  lock_guard<mutex> lock(m_mu);
+  m_table->GetBatch(ids, centers, found);
+}
+
+// MwmTablesCache ----------------------------------------------------------------------------------
+shared_ptr<RankTable const> MwmTablesCache::GetRankTable(MwmSet::MwmId const & id,
+                                                         MwmValue const & value)
+{
+  return GetOrLoad(id, &Entry::m_ranks, [&value]() {
+    unique_ptr<RankTable> table = RankTable::Load(value.m_cont);
+    if (!table)
+      table = make_unique<DummyRankTable>();
+    return shared_ptr<RankTable const>(move(table));
+  });
+}
+
+shared_ptr<SharedCentersTable> MwmTablesCache::GetCentersTable(MwmSet::MwmId const & id,
+                                                               MwmValue const & value)
+{
+  return GetOrLoad(id, &Entry::m_centers, [&value]() {
+    return shared_ptr<SharedCentersTable>(SharedCentersTable::Load(value));
+  });
+}
+
+size_t MwmTablesCache::GetSize() const
+{
+  lock_guard<mutex> lock(m_mu);
+  size_t size = 0;
+  for (auto const & entry : m_entries)
+  {
+    if (!entry.second.IsExpired())
+      ++size;
+  }
+  return size;
+}
+
+template <typename Table, typename Load>
+shared_ptr<Table> MwmTablesCache::GetOrLoad(MwmSet::MwmId const & id,
+                                            weak_ptr<Table> Entry::*field, Load && load)
+{
+  {
+    lock_guard<mutex> lock(m_mu);
+    auto const it = m_entries.find(id);
+    if (it != m_entries.end())
+    {
+      if (auto table = (it->second.*field).lock())
+        return table;
+    }
+  }
+
+  // Tables are loaded without the lock, so loading of a table doesn't
+  // block the other threads.
+  auto table = load();
+  if (!table)
+    return table;
+
+  lock_guard<mutex> lock(m_mu);
+  auto & current = m_entries[id].*field;
+  // Another thread could load the table in the meantime.
+  if (auto other = current.lock())
+    return other;
+  current = table;
+
+  // Entries of mwms whose tables aren't used anymore are dropped, so
+  // the cache doesn't keep infos of deregistered mwms.
+  for (auto it = m_entries.begin(); it != m_entries.end();)
+  {
+    if (it->second.IsExpired())
+      it = m_entries.erase(it);
+    else
+      ++it;
+  }
+  return table;
+}
+}  // namespace search
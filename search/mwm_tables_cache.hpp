@@ -0,0 +1,98 @@
+#pragma once
+
+#include "indexer/mwm_set.hpp"
+
+#include "coding/file_container.hpp"
+
+#include "geometry/point2d.hpp"
+
+#include "base/macros.hpp"
+
+#include "std/cstdint.hpp"
+#include "std/map.hpp"
+#include "std/mutex.hpp"
+#include "std/shared_ptr.hpp"
+#include "std/unique_ptr.hpp"
+#include "std/vector.hpp"
+#include "std/weak_ptr.hpp"
+
+class MwmValue;
+
+namespace search
+{
+class CentersTable;
+class RankTable;
+
+// Centers table of an mwm which may be used by several threads at
+// once.
+class SharedCentersTable
+{
+public:
+  // Returns nullptr when there's no centers table in |value| or it
+  // can't be loaded.
+  static unique_ptr<SharedCentersTable> Load(MwmValue const & value);
+
+  ~SharedCentersTable();
+
+  WARN_UNUSED_RESULT bool Get(uint32_t id, m2::PointD & center);
+
+  // See CentersTable::GetBatch().
+  void GetBatch(vector<uint32_t> const & ids, vector<m2::PointD> & centers, vector<bool> & found);
+
+private:
+  SharedCentersTable(FilesContainerR::TReader const & reader, unique_ptr<CentersTable> table);
+
+  mutex m_mu;
+  // |m_table| reads from |m_reader|, so it must be declared after |m_reader|.
+  FilesContainerR::TReader m_reader;
+  // Decoded blocks of centers are cached by the table, so it's
+  // guarded by |m_mu|.
+  unique_ptr<CentersTable> m_table;
+
+  DISALLOW_COPY_AND_MOVE(SharedCentersTable);
+};
+
+// Rank and centers tables of mwms shared by the query processors, so
+// a table of an mwm searched by several threads at once is loaded and
+// kept only once.
+//
+// The cache doesn't own the tables. A table lives while it's used,
+// that is, while its users hold handles of the mwm, so the cache
+// never delays deregistration of an mwm.
+//
+// All methods are thread-safe.
+class MwmTablesCache
+{
+public:
+  MwmTablesCache() = default;
+
+  // Never returns nullptr, a dummy table is returned when the mwm
+  // has no ranks.
+  shared_ptr<RankTable const> GetRankTable(MwmSet::MwmId const & id, MwmValue const & value);
+
+  // Returns nullptr when the mwm has no centers table.
+  shared_ptr<SharedCentersTable> GetCentersTable(MwmSet::MwmId const & id,
+                                                 MwmValue const & value);
+
+  // Returns the number of mwms which have tables in use.
+  size_t GetSize() const;
+
+private:
+  struct Entry
+  {
+    bool IsExpired() const { return m_ranks.expired() && m_centers.expired(); }
+
+    weak_ptr<RankTable const> m_ranks;
+    weak_ptr<SharedCentersTable> m_centers;
+  };
+
+  template <typename Table, typename Load>
+  shared_ptr<Table> GetOrLoad(MwmSet::MwmId const & id, weak_ptr<Table> Entry::*field,
+                              Load && load);
+
+  mutable mutex m_mu;
+  map<MwmSet::MwmId, Entry> m_entries;
+
+  DISALLOW_COPY_AND_MOVE(MwmTablesCache);
+};
+}  // namespace search
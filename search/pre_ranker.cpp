@@ -2,6 +2,7 @@
 
 #include "search/dummy_rank_table.hpp"
 #include "search/lazy_centers_table.hpp"
+#include "search/mwm_tables_cache.hpp"
 #include "search/pre_ranking_info.hpp"
 
 #include "indexer/mwm_set.hpp"
@@ -13,7 +14,9 @@
 #include "base/random.hpp"
 #include "base/stl_helpers.hpp"
 
+#include "std/algorithm.hpp"
 #include "std/iterator.hpp"
+#include "std/vector.hpp"
 
 namespace search
 {
@@ -82,41 +85,72 @@ void PreRanker::Init(Params const & params)
 
 void PreRanker::FillMissingFieldsInPreResults()
 {
-  MwmSet::MwmId mwmId;
-  MwmSet::MwmHandle mwmHandle;
-  unique_ptr<RankTable> ranks = make_unique<DummyRankTable>();
-  unique_ptr<LazyCentersTable> centers;
-
   bool const fillCenters = (Size() > BatchSize());
 
   if (fillCenters)
     m_pivotFeatures.SetPosition(m_params.m_accuratePivotCenter, m_params.m_scale);
 
-  ForEach([&](PreResult1 & r) {
-    FeatureID const & id = r.GetId();
-    PreRankingInfo & info = r.GetInfo();
-    if (id.m_mwmId != mwmId)
+  // Results are sorted in the same way as by Filter(), so results of
+  // every mwm are consecutive and centers of their features are read
+  // by a batch.
+  sort(m_results.begin(), m_results.end(), ComparePreResult1());
+
+  vector<uint32_t> ids;
+  vector<m2::PointD> centers;
+  vector<bool> found;
+
+  for (size_t begin = 0; begin < m_results.size();)
+  {
+    MwmSet::MwmId const mwmId = m_results[begin].GetId().m_mwmId;
+    size_t end = begin + 1;
+    while (end < m_results.size() && m_results[end].GetId().m_mwmId == mwmId)
+      ++end;
+
+    shared_ptr<RankTable const> ranks;
+    unique_ptr<LazyCentersTable> centersTable;
+    MwmSet::MwmHandle mwmHandle = m_index.GetMwmHandleById(mwmId);
+    if (mwmHandle.IsAlive())
+    {
+      auto & value = *mwmHandle.GetValue<MwmValue>();
+      if (m_tablesCache)
+        ranks = m_tablesCache->GetRankTable(mwmId, value);
+      else
+        ranks = RankTable::Load(value.m_cont);
+      centersTable = make_unique<LazyCentersTable>(value, mwmId, m_tablesCache);
+    }
+    if (!ranks)
+      ranks = make_unique<DummyRankTable>();
+
+    if (fillCenters)
     {
-      mwmId = id.m_mwmId;
-      mwmHandle = m_index.GetMwmHandleById(mwmId);
-      ranks.reset();
-      centers.reset();
-      if (mwmHandle.IsAlive())
+      ids.clear();
+      for (size_t i = begin; i < end; ++i)
+        ids.push_back(m_results[i].GetId().m_index);
+
+      if (centersTable)
+      {
+        centersTable->GetBatch(ids, centers, found);
+      }
+      else
       {
-        ranks = RankTable::Load(mwmHandle.GetValue<MwmValue>()->m_cont);
-        centers = make_unique<LazyCentersTable>(*mwmHandle.GetValue<MwmValue>());
+        centers.assign(ids.size(), m2::PointD());
+        found.assign(ids.size(), false);
       }
-      if (!ranks)
-        ranks = make_unique<DummyRankTable>();
     }
 
-    info.m_rank = ranks->Get(id.m_index);
-
-    if (fillCenters)
+    for (size_t i = begin; i < end; ++i)
     {
-      m2::PointD center;
-      if (centers && centers->Get(id.m_index, center))
+      FeatureID const & id = m_results[i].GetId();
+      PreRankingInfo & info = m_results[i].GetInfo();
+
+      info.m_rank = ranks->Get(id.m_index);
+
+      if (!fillCenters)
+        continue;
+
+      if (found[i - begin])
       {
+        m2::PointD const & center = centers[i - begin];
         info.m_distanceToPivot =
             MercatorBounds::DistanceOnEarth(m_params.m_accuratePivotCenter, center);
         info.m_center = center;
@@ -127,11 +161,15 @@ void PreRanker::FillMissingFieldsInPreResults()
         info.m_distanceToPivot = m_pivotFeatures.GetDistanceToFeatureMeters(id);
       }
     }
-  });
+
+    begin = end;
+  }
 }
 
 void PreRanker::Filter(bool viewportSearch)
 {
+  QueryTrace::Scope scope(m_params.m_trace, QueryTrace::STAGE_PRE_RANKER_FILTER);
+
   using TSet = set<PreResult1, LessFeatureID>;
   TSet filtered;
 
@@ -153,7 +191,10 @@ void PreRanker::Filter(bool viewportSearch)
     }
     else
     {
-      sort(m_results.begin(), m_results.end(), &PreResult1::LessDistance);
+      // Only the first BatchSize() results are taken, so there's no
+      // need to sort all of them.
+      nth_element(m_results.begin(), m_results.begin() + BatchSize(), m_results.end(),
+                  &PreResult1::LessDistance);
 
       // Priority is some kind of distance from the viewport or
       // position, therefore if we have a bunch of results with the same
@@ -164,15 +205,10 @@ void PreRanker::Filter(bool viewportSearch)
 
       double const last = m_results[BatchSize()].GetDistance();
 
-      auto b = m_results.begin() + BatchSize();
-      for (; b != m_results.begin() && b->GetDistance() == last; --b)
-        ;
-      if (b->GetDistance() != last)
-        ++b;
-
-      auto e = m_results.begin() + BatchSize();
-      for (; e != m_results.end() && e->GetDistance() == last; ++e)
-        ;
+      auto const b = partition(m_results.begin(), m_results.begin() + BatchSize(),
+                               [last](PreResult1 const & r) { return r.GetDistance() != last; });
+      auto const e = partition(m_results.begin() + BatchSize(), m_results.end(),
+                               [last](PreResult1 const & r) { return r.GetDistance() == last; });
 
       // The main reason of shuffling here is to select a random subset
       // from the low-priority results. We're using a linear
@@ -203,6 +239,7 @@ void PreRanker::UpdateResults(bool lastUpdate)
   FillMissingFieldsInPreResults();
   Filter(m_viewportSearch);
   m_numSentResults += m_results.size();
+  // Ranker gives back a vector which memory is reused by the next batch.
   m_ranker.SetPreResults1(move(m_results));
   m_results.clear();
   m_ranker.UpdateResults(lastUpdate);
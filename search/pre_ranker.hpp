@@ -2,6 +2,7 @@
 
 #include "search/intermediate_result.hpp"
 #include "search/nested_rects_cache.hpp"
+#include "search/query_trace.hpp"
 #include "search/ranker.hpp"
 
 #include "indexer/index.hpp"
@@ -20,6 +21,8 @@
 
 namespace search
 {
+class MwmTablesCache;
+
 // Fast and simple pre-ranker for search results.
 class PreRanker
 {
@@ -43,6 +46,9 @@ public:
     int m_scale = 0;
 
     size_t m_batchSize = 100;
+
+    // Query trace, nullptr when tracing is disabled.
+    QueryTrace * m_trace = nullptr;
   };
 
   PreRanker(Index const & index, Ranker & ranker, size_t limit);
@@ -51,6 +57,10 @@ public:
 
   inline void SetViewportSearch(bool viewportSearch) { m_viewportSearch = viewportSearch; }
 
+  // Sets the cache of mwm tables shared by pre-rankers. |cache| may
+  // be nullptr and must outlive the pre-ranker.
+  inline void SetTablesCache(MwmTablesCache * cache) { m_tablesCache = cache; }
+
   template <typename... TArgs>
   void Emplace(TArgs &&... args)
   {
@@ -87,6 +97,7 @@ private:
 
   Index const & m_index;
   Ranker & m_ranker;
+  MwmTablesCache * m_tablesCache = nullptr;
   vector<PreResult1> m_results;
   size_t const m_limit;
   Params m_params;
@@ -185,7 +185,7 @@ Processor::Processor(Index const & index, CategoriesHolder const & categories,
   , m_viewportSearch(false)
   , m_villagesCache(static_cast<my::Cancellable const &>(*this))
   , m_ranker(index, infoGetter, m_emitter, categories, suggests, m_villagesCache,
-             static_cast<my::Cancellable const &>(*this))
+             m_preResults2Arena, static_cast<my::Cancellable const &>(*this))
   , m_preRanker(index, m_ranker, kPreResultsCount)
   , m_geocoder(index, infoGetter, m_preRanker, m_villagesCache,
                static_cast<my::Cancellable const &>(*this))
@@ -431,13 +431,19 @@ void Processor::Search(SearchParams const & params, m2::RectD const & viewport)
     Results results;
     results.SetEndMarker(true /* isCancelled */);
 
+    if (params.m_onResultsDelta)
+      params.m_onResultsDelta(results, 0 /* firstChanged */);
     if (params.m_onResults)
       params.m_onResults(results);
-    else
+    else if (!params.m_onResultsDelta)
       LOG(LERROR, ("OnResults is not set."));
     return;
   }
 
+  m_trace = params.m_onTrace ? &m_queryTrace : nullptr;
+  if (m_trace)
+    m_trace->Start();
+
   SetMode(params.m_mode);
   bool const viewportSearch = m_mode == Mode::Viewport;
 
@@ -464,12 +470,17 @@ void Processor::Search(SearchParams const & params, m2::RectD const & viewport)
   SetSuggestsEnabled(params.m_suggestsEnabled);
   m_hotelsFilter = params.m_hotelsFilter;
   m_cianMode = params.m_cianMode;
+  m_earlyEmit = params.m_earlyEmit;
 
   SetInputLocale(params.m_inputLocale);
 
-  SetQuery(params.m_query);
+  {
+    QueryTrace::Scope scope(m_trace, QueryTrace::STAGE_TOKENIZATION);
+    SetQuery(params.m_query);
+  }
   SetViewport(viewport, true /* forceUpdate */);
   SetOnResults(params.m_onResults);
+  SetOnResultsDelta(params.m_onResultsDelta);
 
   Geocoder::Params geocoderParams;
   InitGeocoder(geocoderParams);
@@ -505,6 +516,12 @@ void Processor::Search(SearchParams const & params, m2::RectD const & viewport)
 
   // Emit finish marker to client.
   m_emitter.Finish(IsCancelled());
+
+  if (m_trace)
+  {
+    m_trace->Finish();
+    params.m_onTrace(*m_trace);
+  }
 }
 
 void Processor::SearchCoordinates()
@@ -726,6 +743,7 @@ void Processor::InitGeocoder(Geocoder::Params & params)
     params.m_pivot = GetPivotRect();
   params.m_hotelsFilter = m_hotelsFilter;
   params.m_cianMode = m_cianMode;
+  params.m_trace = m_trace;
   m_geocoder.SetParams(params);
 }
 
@@ -742,6 +760,7 @@ void Processor::InitPreRanker(Geocoder::Params const & geocoderParams)
   }
   params.m_accuratePivotCenter = GetPivotPoint();
   params.m_scale = geocoderParams.GetScale();
+  params.m_trace = m_trace;
 
   m_preRanker.Init(params);
 }
@@ -774,10 +793,11 @@ void Processor::InitRanker(Geocoder::Params const & geocoderParams)
   params.m_categoryLocales = GetCategoryLocales();
   params.m_accuratePivotCenter = GetPivotPoint();
   params.m_viewportSearch = viewportSearch;
+  params.m_earlyEmit = m_earlyEmit && !viewportSearch;
   m_ranker.Init(params, geocoderParams);
 }
 
-void Processor::InitEmitter() { m_emitter.Init(m_onResults); }
+void Processor::InitEmitter() { m_emitter.Init(m_onResults, m_onResultsDelta); }
 
 void Processor::ClearCaches()
 {
@@ -788,6 +808,7 @@ void Processor::ClearCaches()
   m_villagesCache.Clear();
   m_preRanker.ClearCaches();
   m_ranker.ClearCaches();
+  m_preResults2Arena.Release();
 }
 
 m2::RectD const & Processor::GetViewport(ViewportID vID /*= DEFAULT_V*/) const
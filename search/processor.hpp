@@ -6,6 +6,7 @@
 #include "search/hotels_filter.hpp"
 #include "search/mode.hpp"
 #include "search/pre_ranker.hpp"
+#include "search/query_trace.hpp"
 #include "search/rank_table_cache.hpp"
 #include "search/ranker.hpp"
 #include "search/search_params.hpp"
@@ -80,6 +81,20 @@ public:
   /// if viewport is a part of the old cached rect.
   void SetViewport(m2::RectD const & viewport, bool forceUpdate);
   void SetPreferredLocale(string const & locale);
+  inline int8_t GetPreferredLocaleCode() const { return m_currentLocaleCode; }
+  inline void SetNumRetrievalThreads(size_t numThreads)
+  {
+    m_geocoder.SetNumRetrievalThreads(numThreads);
+  }
+  inline void SetStreetVicinityCache(StreetVicinityCache * cache)
+  {
+    m_geocoder.SetStreetVicinityCache(cache);
+  }
+  inline void SetTablesCache(MwmTablesCache * cache)
+  {
+    m_geocoder.SetTablesCache(cache);
+    m_preRanker.SetTablesCache(cache);
+  }
   void SetInputLocale(string const & locale);
   void SetQuery(string const & query);
   // TODO (@y): this function must be removed.
@@ -92,6 +107,10 @@ public:
     m_minDistanceOnMapBetweenResults = distance;
   }
   inline void SetOnResults(SearchParams::TOnResults const & onResults) { m_onResults = onResults; }
+  inline void SetOnResultsDelta(SearchParams::TOnResultsDelta const & onResultsDelta)
+  {
+    m_onResultsDelta = onResultsDelta;
+  }
   inline string const & GetPivotRegion() const { return m_region; }
   inline m2::PointD const & GetPosition() const { return m_position; }
 
@@ -167,7 +186,13 @@ protected:
   bool m_suggestsEnabled;
   shared_ptr<hotels_filter::Rule> m_hotelsFilter;
   bool m_cianMode = false;
+  bool m_earlyEmit = false;
   SearchParams::TOnResults m_onResults;
+  SearchParams::TOnResultsDelta m_onResultsDelta;
+
+  QueryTrace m_queryTrace;
+  // Points to |m_queryTrace| when the current query is traced, nullptr otherwise.
+  QueryTrace * m_trace = nullptr;
 
   /// @name Get ranking params.
   //@{
@@ -185,6 +210,9 @@ protected:
 
   VillagesCache m_villagesCache;
 
+  // Must outlive |m_ranker|.
+  PreResult2Arena m_preResults2Arena;
+
   Emitter m_emitter;
   Ranker m_ranker;
   PreRanker m_preRanker;
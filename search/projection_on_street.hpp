@@ -1,7 +1,7 @@
 #pragma once
 
-#include "geometry/distance.hpp"
 #include "geometry/point2d.hpp"
+#include "geometry/segments_batch.hpp"
 
 #include "std/vector.hpp"
 
@@ -37,7 +37,10 @@ public:
   // |proj|.
   bool GetProjection(m2::PointD const & point, ProjectionOnStreet & proj) const;
 
+  // Returns the number of bytes allocated for the segments.
+  size_t GetMemorySize() const { return m_segments.GetMemorySize(); }
+
 private:
-  vector<m2::ProjectionToSection<m2::PointD>> m_segProjs;
+  m2::SegmentsBatch m_segments;
 };
 }  // namespace search
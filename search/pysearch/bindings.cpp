@@ -22,7 +22,9 @@
 
 #include <boost/python.hpp>
 
+#include <cstddef>
 #include <limits>
+#include <map>
 #include <memory>
 #include <sstream>
 #include <string>
@@ -148,17 +150,64 @@ struct Result
   Mercator m_center;
 };
 
+// Releases the GIL while the C++ code doesn't touch Python objects, so
+// other Python threads run meanwhile.
+class ScopedGILRelease
+{
+public:
+  ScopedGILRelease() : m_state(PyEval_SaveThread()) {}
+  ~ScopedGILRelease() { PyEval_RestoreThread(m_state); }
+
+private:
+  PyThreadState * m_state;
+};
+
+search::SearchParams MakeSearchParams(Params const & params)
+{
+  search::SearchParams sp;
+  sp.m_query = params.m_query;
+  sp.m_inputLocale = params.m_locale;
+  sp.m_mode = search::Mode::Everywhere;
+  sp.SetPosition(MercatorBounds::YToLat(params.m_position.m_y),
+                 MercatorBounds::XToLon(params.m_position.m_x));
+  sp.m_suggestsEnabled = false;
+  return sp;
+}
+
+m2::RectD MakeViewport(Params const & params)
+{
+  auto const & bottomLeft = params.m_viewport.m_min;
+  auto const & topRight = params.m_viewport.m_max;
+  return m2::RectD(bottomLeft.m_x, bottomLeft.m_y, topRight.m_x, topRight.m_y);
+}
+
+boost::python::list MakeResults(vector<search::Result> const & results)
+{
+  boost::python::list list;
+  for (auto const & result : results)
+    list.append(Result(result));
+  return list;
+}
+
 struct SearchEngineProxy
 {
-  SearchEngineProxy()
+  SearchEngineProxy() : SearchEngineProxy(search::Engine::Params{}) {}
+
+  explicit SearchEngineProxy(size_t numThreads)
+    : SearchEngineProxy(search::Engine::Params("en" /* locale */, numThreads))
+  {
+  }
+
+  explicit SearchEngineProxy(search::Engine::Params const & engineParams)
   {
     CHECK(g_storage.get() != nullptr, ("init() was not called."));
+    CHECK_GREATER(engineParams.m_numThreads, 0, ());
     auto & platform = GetPlatform();
     auto infoGetter = storage::CountryInfoReader::CreateCountryInfoReader(platform);
     infoGetter->InitAffiliationsInfo(&g_storage->GetAffiliations());
 
     m_engine = make_shared<search::tests_support::TestSearchEngine>(
-        move(infoGetter), make_unique<search::ProcessorFactory>(), search::Engine::Params{});
+        move(infoGetter), make_unique<search::ProcessorFactory>(), engineParams);
 
     vector<platform::LocalCountryFile> mwms;
     platform::FindAllLocalMapsAndCleanup(numeric_limits<int64_t>::max() /* the latest version */,
@@ -172,25 +221,53 @@ struct SearchEngineProxy
 
   boost::python::list Query(Params const & params) const
   {
-    m_engine->SetLocale(params.m_locale);
-
-    search::SearchParams sp;
-    sp.m_query = params.m_query;
-    sp.m_inputLocale = params.m_locale;
-    sp.m_mode = search::Mode::Everywhere;
-    sp.SetPosition(MercatorBounds::YToLat(params.m_position.m_y),
-                   MercatorBounds::XToLon(params.m_position.m_x));
-    sp.m_suggestsEnabled = false;
-
-    auto const & bottomLeft = params.m_viewport.m_min;
-    auto const & topRight = params.m_viewport.m_max;
-    m2::RectD const viewport(bottomLeft.m_x, bottomLeft.m_y, topRight.m_x, topRight.m_y);
-    search::tests_support::TestSearchRequest request(*m_engine, sp, viewport);
-    request.Run();
+    search::tests_support::TestSearchRequest request(*m_engine, MakeSearchParams(params),
+                                                     MakeViewport(params));
+    {
+      ScopedGILRelease release;
+      m_engine->SetLocale(params.m_locale);
+      request.Run();
+    }
+    return MakeResults(request.Results());
+  }
+
+  // Runs all the |requests| concurrently on the threads of the engine
+  // and returns the list of results of every request in the order of
+  // |requests|. The locale is a setting of the whole engine, so
+  // requests are run in groups by locales.
+  boost::python::list BatchQuery(boost::python::list const & requests) const
+  {
+    vector<Params> params;
+    auto const numRequests = boost::python::len(requests);
+    params.reserve(numRequests);
+    for (decltype(boost::python::len(requests)) i = 0; i < numRequests; ++i)
+      params.push_back(boost::python::extract<Params>(requests[i]));
+
+    vector<unique_ptr<search::tests_support::TestSearchRequest>> searches(params.size());
+    {
+      ScopedGILRelease release;
+
+      map<string, vector<size_t>> byLocale;
+      for (size_t i = 0; i < params.size(); ++i)
+        byLocale[params[i].m_locale].push_back(i);
+
+      for (auto const & group : byLocale)
+      {
+        m_engine->SetLocale(group.first);
+        for (auto const i : group.second)
+        {
+          searches[i] = make_unique<search::tests_support::TestSearchRequest>(
+              *m_engine, MakeSearchParams(params[i]), MakeViewport(params[i]));
+          searches[i]->Start();
+        }
+        for (auto const i : group.second)
+          searches[i]->Wait();
+      }
+    }
 
     boost::python::list results;
-    for (auto const & result : request.Results())
-      results.append(Result(result));
+    for (auto const & search : searches)
+      results.append(MakeResults(search->Results()));
     return results;
   }
 
@@ -230,5 +307,8 @@ BOOST_PYTHON_MODULE(pysearch)
       .def_readwrite("center", &Result::m_center)
       .def("to_string", &Result::ToString);
 
-  class_<SearchEngineProxy>("SearchEngine").def("query", &SearchEngineProxy::Query);
+  class_<SearchEngineProxy>("SearchEngine")
+      .def(init<size_t>())
+      .def("query", &SearchEngineProxy::Query)
+      .def("batch_query", &SearchEngineProxy::BatchQuery);
 }
@@ -13,9 +13,58 @@ DIR = os.path.dirname(__file__)
 RESOURCE_PATH = os.path.realpath(os.path.join(DIR, '..', '..', 'data'))
 MWM_PATH = os.path.realpath(os.path.join(DIR, '..', '..', 'data'))
 PORT=8080
+THREADS=1
+
+
+def make_params(request):
+    params = pysearch.Params()
+    params.query = request['query'].encode('utf-8')
+    params.locale = request['locale'].encode('utf-8')
+    params.position = pysearch.Mercator(request['posx'], request['posy'])
+    params.viewport = pysearch.Viewport(
+        pysearch.Mercator(request['minx'], request['miny']),
+        pysearch.Mercator(request['maxx'], request['maxy']))
+    return params
+
+
+def make_responses(results):
+    return [{'name': result.name,
+             'address': result.address,
+             'has_center': result.has_center,
+             'center': {'x': result.center.x,
+                        'y': result.center.y
+                       }
+            }
+            for result in results]
 
 
 class HTTPHandler(BaseHTTPRequestHandler):
+    def do_POST(self):
+        """Runs a batch of requests concurrently.
+
+        The body is a JSON list of objects with the same fields as the
+        parameters of GET requests, the response is the list of results
+        of every request.
+        """
+        if urlparse.urlparse(self.path).path != '/batch':
+            self.send_response(404)
+            return
+
+        try:
+            length = int(self.headers.getheader('Content-Length'))
+            requests = json.loads(self.rfile.read(length))
+            params = [make_params(request) for request in requests]
+        except (KeyError, TypeError, ValueError):
+            self.send_response(400)
+            return
+
+        results = HTTPHandler.engine.batch_query(params)
+
+        self.send_response(200)
+        self.send_header("Content-Type", "application/json")
+        self.end_headers()
+        json.dump([make_responses(r) for r in results], self.wfile)
+
     def do_GET(self):
         result = urlparse.urlparse(self.path)
         query = urlparse.parse_qs(result.query)
@@ -40,14 +89,7 @@ class HTTPHandler(BaseHTTPRequestHandler):
 
         results = HTTPHandler.engine.query(params)
 
-        responses = [{'name': result.name,
-                      'address': result.address,
-                      'has_center': result.has_center,
-                      'center': {'x': result.center.x,
-                                 'y': result.center.y
-                                }
-                     }
-                     for result in results]
+        responses = make_responses(results)
 
         self.send_response(200)
         self.send_header("Content-Type", "application/json")
@@ -57,8 +99,7 @@ class HTTPHandler(BaseHTTPRequestHandler):
 
 def main(args):
     pysearch.init(args.r, args.m)
-    engine = pysearch.SearchEngine()
-    HTTPHandler.engine = pysearch.SearchEngine()
+    HTTPHandler.engine = pysearch.SearchEngine(args.t)
 
     print('Starting HTTP server on port', PORT)
     server = HTTPServer(('', args.p), HTTPHandler)
@@ -74,6 +115,8 @@ if __name__ == '__main__':
                         help='Path to mwm files.')
     parser.add_argument('-p', metavar='PORT', default=PORT,
                         help='Port for the server to listen')
+    parser.add_argument('-t', metavar='THREADS', default=THREADS, type=int,
+                        help='Number of search threads for batch requests')
     args = parser.parse_args()
 
     main(args)
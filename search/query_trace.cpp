@@ -0,0 +1,91 @@
+#include "search/query_trace.hpp"
+
+#include "base/assert.hpp"
+
+#include "std/sstream.hpp"
+
+namespace search
+{
+void QueryTrace::Start()
+{
+  for (auto & stage : m_stages)
+    stage = StageInfo();
+  m_current = STAGE_COUNT;
+  m_start = m_last = Clock::now();
+  m_totalSeconds = 0.0;
+}
+
+void QueryTrace::Finish()
+{
+  auto const now = Clock::now();
+  Charge(now);
+  m_totalSeconds = duration_cast<duration<double>>(now - m_start).count();
+}
+
+QueryTrace::StageInfo const & QueryTrace::GetStage(Stage stage) const
+{
+  ASSERT_LESS(stage, STAGE_COUNT, ());
+  return m_stages[stage];
+}
+
+double QueryTrace::GetUntrackedSeconds() const
+{
+  double tracked = 0.0;
+  for (auto const & stage : m_stages)
+    tracked += stage.m_seconds;
+  return tracked < m_totalSeconds ? m_totalSeconds - tracked : 0.0;
+}
+
+void QueryTrace::Enter(Stage stage, Stage & prev)
+{
+  ASSERT_LESS(stage, STAGE_COUNT, ());
+  Charge(Clock::now());
+  prev = m_current;
+  m_current = stage;
+  ++m_stages[stage].m_count;
+}
+
+void QueryTrace::Leave(Stage prev)
+{
+  Charge(Clock::now());
+  m_current = prev;
+}
+
+void QueryTrace::Charge(Clock::time_point const & now)
+{
+  if (m_current != STAGE_COUNT)
+    m_stages[m_current].m_seconds += duration_cast<duration<double>>(now - m_last).count();
+  m_last = now;
+}
+
+string DebugPrint(QueryTrace::Stage stage)
+{
+  switch (stage)
+  {
+  case QueryTrace::STAGE_TOKENIZATION: return "Tokenization";
+  case QueryTrace::STAGE_LOCALITIES: return "Localities";
+  case QueryTrace::STAGE_STREETS: return "Streets";
+  case QueryTrace::STAGE_POIS_AND_BUILDINGS: return "POIsAndBuildings";
+  case QueryTrace::STAGE_PATH_FINDER: return "PathFinder";
+  case QueryTrace::STAGE_PRE_RANKER_FILTER: return "PreRankerFilter";
+  case QueryTrace::STAGE_MAKE_PRE_RESULT2: return "MakePreResult2";
+  case QueryTrace::STAGE_FEATURE_LOADS: return "FeatureLoads";
+  case QueryTrace::STAGE_COUNT: return "Count";
+  }
+  return "Unknown";
+}
+
+string DebugPrint(QueryTrace const & trace)
+{
+  ostringstream os;
+  os << "QueryTrace [ total: " << trace.GetTotalSeconds() << "s";
+  for (size_t i = 0; i < QueryTrace::STAGE_COUNT; ++i)
+  {
+    auto const stage = static_cast<QueryTrace::Stage>(i);
+    auto const & info = trace.GetStage(stage);
+    os << ", " << DebugPrint(stage) << ": " << info.m_seconds << "s/" << info.m_count;
+  }
+  os << ", untracked: " << trace.GetUntrackedSeconds() << "s ]";
+  return os.str();
+}
+}  // namespace search
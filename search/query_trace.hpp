@@ -0,0 +1,97 @@
+#pragma once
+
+#include "base/macros.hpp"
+
+#include "std/chrono.hpp"
+#include "std/cstdint.hpp"
+#include "std/string.hpp"
+
+namespace search
+{
+// Latency breakdown of a single search query.
+//
+// Time of a stage is exclusive: when a stage is entered from another
+// one (e.g. PreRanker::Filter() is called from the path finder), the
+// outer stage is paused until the inner one is left. Therefore the
+// sum of all stages never exceeds the total time of the query.
+//
+// Not thread-safe, all stages must be entered on the search thread.
+class QueryTrace
+{
+public:
+  enum Stage
+  {
+    STAGE_TOKENIZATION,
+    STAGE_LOCALITIES,
+    STAGE_STREETS,
+    STAGE_POIS_AND_BUILDINGS,
+    STAGE_PATH_FINDER,
+    STAGE_PRE_RANKER_FILTER,
+    STAGE_MAKE_PRE_RESULT2,
+    STAGE_FEATURE_LOADS,
+    STAGE_COUNT
+  };
+
+  struct StageInfo
+  {
+    double m_seconds = 0.0;
+    // Number of times the stage has been entered.
+    uint64_t m_count = 0;
+  };
+
+  // Enters |stage| on construction and leaves it on destruction. Does
+  // nothing when |trace| is nullptr, so it's cheap to keep scopes in
+  // hot paths when tracing is disabled.
+  class Scope
+  {
+  public:
+    Scope(QueryTrace * trace, Stage stage) : m_trace(trace)
+    {
+      if (m_trace)
+        m_trace->Enter(stage, m_prev);
+    }
+
+    ~Scope()
+    {
+      if (m_trace)
+        m_trace->Leave(m_prev);
+    }
+
+  private:
+    QueryTrace * m_trace;
+    Stage m_prev = STAGE_COUNT;
+
+    DISALLOW_COPY_AND_MOVE(Scope);
+  };
+
+  // Resets all stages and starts the total timer.
+  void Start();
+
+  // Stops the total timer.
+  void Finish();
+
+  StageInfo const & GetStage(Stage stage) const;
+  double GetTotalSeconds() const { return m_totalSeconds; }
+
+  // Time of the query not covered by any stage.
+  double GetUntrackedSeconds() const;
+
+private:
+  using Clock = steady_clock;
+
+  void Enter(Stage stage, Stage & prev);
+  void Leave(Stage prev);
+
+  // Charges time since the last event to the current stage.
+  void Charge(Clock::time_point const & now);
+
+  StageInfo m_stages[STAGE_COUNT];
+  Stage m_current = STAGE_COUNT;
+  Clock::time_point m_start;
+  Clock::time_point m_last;
+  double m_totalSeconds = 0.0;
+};
+
+string DebugPrint(QueryTrace::Stage stage);
+string DebugPrint(QueryTrace const & trace);
+}  // namespace search
@@ -1,6 +1,7 @@
 #include "search/ranker.hpp"
 
 #include "search/emitter.hpp"
+#include "search/query_trace.hpp"
 #include "search/string_intersection.hpp"
 #include "search/token_slice.hpp"
 #include "search/utils.hpp"
@@ -12,6 +13,7 @@
 
 #include "std/algorithm.hpp"
 #include "std/iterator.hpp"
+#include "std/limits.hpp"
 #include "std/unique_ptr.hpp"
 
 namespace search
@@ -105,6 +107,39 @@ void GetStringPrefix(string const & str, string & res)
   res.assign(str.begin(), iter.base());
 }
 
+// Returns an upper bound of the linear model rank of a result made
+// from |res1|. Only the fields known before loading of the feature
+// are taken from |res1|, the best values are taken for the rest ones.
+double GetLinearModelRankUpperBound(PreResult1 const & res1)
+{
+  auto const & preInfo = res1.GetInfo();
+
+  RankingInfo info;
+  info.m_distanceToPivot = 0.0;
+  info.m_type = preInfo.m_type;
+
+  // See PreResult2Maker::NormalizeRank().
+  switch (info.m_type)
+  {
+  case Model::TYPE_VILLAGE:
+  case Model::TYPE_COUNTRY: info.m_rank = preInfo.m_rank; break;
+  case Model::TYPE_CITY: info.m_rank = numeric_limits<uint8_t>::max(); break;
+  default: info.m_rank = 0; break;
+  }
+
+  double bound = -numeric_limits<double>::max();
+  for (int falseCats = 0; falseCats <= 1; ++falseCats)
+  {
+    info.m_falseCats = falseCats != 0;
+    for (int nameScore = 0; nameScore < NAME_SCORE_COUNT; ++nameScore)
+    {
+      info.m_nameScore = static_cast<NameScore>(nameScore);
+      bound = max(bound, info.GetLinearModelRank());
+    }
+  }
+  return bound;
+}
+
 ftypes::Type GetLocalityIndex(feature::TypesHolder const & types)
 {
   using namespace ftypes;
@@ -175,9 +210,11 @@ class PreResult2Maker
 
   bool LoadFeature(FeatureID const & id, FeatureType & ft)
   {
+    QueryTrace::Scope scope(m_params.m_trace, QueryTrace::STAGE_FEATURE_LOADS);
+
     if (!m_loader || m_loader->GetId() != id.m_mwmId)
       m_loader = make_unique<Index::FeaturesLoaderGuard>(m_index, id.m_mwmId);
-    if (!m_loader->GetFeatureByIndex(id.m_index, ft))
+    if (!m_loader->GetParsedFeatureByIndex(id.m_index, ft))
       return false;
 
     ft.SetID(id);
@@ -294,7 +331,7 @@ public:
   {
   }
 
-  unique_ptr<PreResult2> operator()(PreResult1 const & res1)
+  PreResult2 * operator()(PreResult1 const & res1)
   {
     FeatureType ft;
     m2::PointD center;
@@ -302,10 +339,10 @@ public:
     string country;
 
     if (!LoadFeature(res1.GetId(), ft, center, name, country))
-      return unique_ptr<PreResult2>();
+      return nullptr;
 
-    auto res2 = make_unique<PreResult2>(ft, center, m_ranker.m_params.m_position /* pivot */, name,
-                                        country);
+    auto * res2 = m_ranker.m_preResults2Arena.Emplace(
+        ft, center, m_ranker.m_params.m_position /* pivot */, name, country);
 
     search::RankingInfo info;
     InitRankingInfo(ft, center, res1, info);
@@ -319,10 +356,13 @@ public:
 // static
 size_t const Ranker::kBatchSize = 10;
 
+// static
+double const Ranker::kMinEarlyEmitRank = -0.4;
+
 Ranker::Ranker(Index const & index, storage::CountryInfoGetter const & infoGetter,
                Emitter & emitter, CategoriesHolder const & categories,
                vector<Suggest> const & suggests, VillagesCache & villagesCache,
-               my::Cancellable const & cancellable)
+               PreResult2Arena & preResults2Arena, my::Cancellable const & cancellable)
   : m_reverseGeocoder(index)
   , m_cancellable(cancellable)
   , m_localities(index, villagesCache)
@@ -331,6 +371,7 @@ Ranker::Ranker(Index const & index, storage::CountryInfoGetter const & infoGette
   , m_emitter(emitter)
   , m_categories(categories)
   , m_suggests(suggests)
+  , m_preResults2Arena(preResults2Arena)
 {
 }
 
@@ -340,6 +381,7 @@ void Ranker::Init(Params const & params, Geocoder::Params const & geocoderParams
   m_geocoderParams = geocoderParams;
   m_preResults1.clear();
   m_tentativeResults.clear();
+  m_preResults2Arena.Clear();
 }
 
 bool Ranker::IsResultExists(PreResult2 const & p, vector<IndexedValue> const & values)
@@ -355,9 +397,18 @@ bool Ranker::IsResultExists(PreResult2 const & p, vector<IndexedValue> const & v
 
 void Ranker::MakePreResult2(Geocoder::Params const & geocoderParams, vector<IndexedValue> & cont)
 {
+  QueryTrace::Scope scope(geocoderParams.m_trace, QueryTrace::STAGE_MAKE_PRE_RESULT2);
+
+  // Features of the pre-results which can't get into the results
+  // are not loaded.
+  double const minRank = GetMinRankToEmit(cont);
+
   PreResult2Maker maker(*this, m_index, m_infoGetter, geocoderParams);
   for (auto const & r : m_preResults1)
   {
+    if (GetLinearModelRankUpperBound(r) < minRank)
+      continue;
+
     auto p = maker(r);
     if (!p)
       continue;
@@ -369,10 +420,41 @@ void Ranker::MakePreResult2(Geocoder::Params const & geocoderParams, vector<Inde
     }
 
     if (!IsResultExists(*p, cont))
-      cont.push_back(IndexedValue(move(p)));
+      cont.push_back(IndexedValue(p));
   };
 }
 
+double Ranker::GetMinRankToEmit(vector<IndexedValue> const & values) const
+{
+  double const kNoBound = -numeric_limits<double>::max();
+
+  // Viewport results are not limited, and suggestions take results
+  // out of the tentative ones regardless of their ranks.
+  if (m_params.m_viewportSearch || m_params.m_limit == 0 ||
+      (!m_params.m_prefix.empty() && m_params.m_suggestsEnabled))
+  {
+    return kNoBound;
+  }
+
+  size_t const count = m_emitter.GetResults().GetCount();
+  if (count >= m_params.m_limit)
+    return numeric_limits<double>::max();
+
+  // Tentative results are emitted in the order of ranks, so a result
+  // ranked lower than |need| tentative ones is never emitted, except
+  // the rare case when the emitter rejects better ones as duplicates.
+  size_t const need = m_params.m_limit - count;
+  if (values.size() < need)
+    return kNoBound;
+
+  vector<double> ranks;
+  ranks.reserve(values.size());
+  for (auto const & value : values)
+    ranks.push_back(value.GetRank());
+  nth_element(ranks.begin(), ranks.begin() + (need - 1), ranks.end(), greater<double>());
+  return ranks[need - 1];
+}
+
 Result Ranker::MakeResult(PreResult2 const & r) const
 {
   Result res = r.GenerateFinalResult(m_infoGetter, &m_categories, &m_params.m_preferredTypes,
@@ -551,8 +633,15 @@ void Ranker::UpdateResults(bool lastUpdate)
   size_t i = 0;
   for (; i < m_tentativeResults.size(); ++i)
   {
-    if (!lastUpdate && i >= kBatchSize && !m_params.m_viewportSearch)
-      break;
+    if (!lastUpdate && !m_params.m_viewportSearch)
+    {
+      // Tentative results are sorted by rank, so the rest ones are
+      // held until the next update.
+      if (m_params.m_earlyEmit && m_tentativeResults[i].GetRank() < kMinEarlyEmitRank)
+        break;
+      if (!m_params.m_earlyEmit && i >= kBatchSize)
+        break;
+    }
     BailIfCancelled();
 
     if (m_params.m_viewportSearch)
@@ -586,5 +675,8 @@ void Ranker::UpdateResults(bool lastUpdate)
 void Ranker::ClearCaches()
 {
   m_localities.ClearCache();
+
+  // Tentative results point to the arena which may be released.
+  m_tentativeResults.clear();
 }
 }  // namespace search
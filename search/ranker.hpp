@@ -52,6 +52,9 @@ public:
     set<uint32_t> m_preferredTypes;
     bool m_suggestsEnabled = false;
     bool m_viewportSearch = false;
+    // When true, intermediate updates emit confidently ranked results
+    // only, see kMinEarlyEmitRank.
+    bool m_earlyEmit = false;
 
     string m_query;
     buffer_vector<strings::UniString, 32> m_tokens;
@@ -72,9 +75,16 @@ public:
 
   static size_t const kBatchSize;
 
+  // Results with a linear model rank not less than this threshold
+  // (e.g. a full or prefix name match of a POI in the vicinity of the
+  // pivot, or any city) are emitted before the end of the search in
+  // the early emit mode.
+  static double const kMinEarlyEmitRank;
+
   Ranker(Index const & index, storage::CountryInfoGetter const & infoGetter, Emitter & emitter,
          CategoriesHolder const & categories, vector<Suggest> const & suggests,
-         VillagesCache & villagesCache, my::Cancellable const & cancellable);
+         VillagesCache & villagesCache, PreResult2Arena & preResults2Arena,
+         my::Cancellable const & cancellable);
   virtual ~Ranker() = default;
 
   void Init(Params const & params, Geocoder::Params const & geocoderParams);
@@ -92,7 +102,13 @@ public:
   void GetBestMatchName(FeatureType const & f, string & name) const;
   void ProcessSuggestions(vector<IndexedValue> & vec) const;
 
-  virtual void SetPreResults1(vector<PreResult1> && preResults1) { m_preResults1 = move(preResults1); }
+  // Takes |preResults1| and leaves a cleared vector in it, possibly
+  // the one with the memory of the previous batch.
+  virtual void SetPreResults1(vector<PreResult1> && preResults1)
+  {
+    m_preResults1.clear();
+    m_preResults1.swap(preResults1);
+  }
   virtual void UpdateResults(bool lastUpdate);
 
   void ClearCaches();
@@ -125,6 +141,10 @@ public:
 private:
   friend class PreResult2Maker;
 
+  // Returns the rank a new result should reach to be emitted when
+  // |values| are the tentative results.
+  double GetMinRankToEmit(vector<IndexedValue> const & values) const;
+
   Params m_params;
   Geocoder::Params m_geocoderParams;
   ReverseGeocoder const m_reverseGeocoder;
@@ -139,6 +159,8 @@ private:
   CategoriesHolder const & m_categories;
   vector<Suggest> const & m_suggests;
 
+  PreResult2Arena & m_preResults2Arena;
+
   vector<PreResult1> m_preResults1;
   vector<IndexedValue> m_tentativeResults;
 };
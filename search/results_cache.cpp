@@ -0,0 +1,186 @@
+#include "search/results_cache.hpp"
+
+#include "search/latlon_match.hpp"
+#include "search/search_params.hpp"
+
+#include "indexer/search_delimiters.hpp"
+#include "indexer/search_string_utils.hpp"
+
+#include "geometry/latlon.hpp"
+
+#include "base/assert.hpp"
+#include "base/stl_add.hpp"
+
+#include "std/algorithm.hpp"
+#include "std/cmath.hpp"
+#include "std/tuple.hpp"
+
+namespace search
+{
+namespace
+{
+// A small shift of the viewport (less than 1/8 of its size) or a
+// zoom change less than 2 times usually keeps the viewport in the
+// same cell.
+double constexpr kViewportCellsPerSize = 8.0;
+
+// Cells of about 100 meters.
+double constexpr kPositionCellsPerDegree = 1000.0;
+}  // namespace
+
+// ResultsCache::Key -------------------------------------------------------------------------------
+bool ResultsCache::Key::operator<(Key const & rhs) const
+{
+  return tie(m_tokens, m_lastTokenIsPrefix, m_inputLocale, m_preferredLocale, m_mode,
+             m_viewportLevel, m_viewportX, m_viewportY, m_validPosition, m_positionLat,
+             m_positionLon, m_suggestsEnabled, m_minDistanceOnMapBetweenResults, m_cianMode,
+             m_earlyEmit) <
+         tie(rhs.m_tokens, rhs.m_lastTokenIsPrefix, rhs.m_inputLocale, rhs.m_preferredLocale,
+             rhs.m_mode, rhs.m_viewportLevel, rhs.m_viewportX, rhs.m_viewportY,
+             rhs.m_validPosition, rhs.m_positionLat, rhs.m_positionLon, rhs.m_suggestsEnabled,
+             rhs.m_minDistanceOnMapBetweenResults, rhs.m_cianMode, rhs.m_earlyEmit);
+}
+
+// ResultsCache ------------------------------------------------------------------------------------
+// static
+bool ResultsCache::MakeKey(SearchParams const & params, m2::RectD const & viewport,
+                           int8_t preferredLocale, Key & key)
+{
+  if (params.m_mode == Mode::Viewport || params.m_hotelsFilter)
+    return false;
+
+  double lat, lon;
+  if (MatchLatLonDegree(params.m_query, lat, lon))
+    return false;
+
+  double const viewportSize = max(viewport.SizeX(), viewport.SizeY());
+  if (!viewport.IsValid() || viewportSize <= 0.0)
+    return false;
+
+  // Hashtags are kept as a part of tokens, the same way Processor
+  // does, because they change the meaning of tokens.
+  key.m_tokens.clear();
+  DelimitersWithExceptions hashtagDelims(vector<strings::UniChar>{'#'});
+  SplitUniString(NormalizeAndSimplifyString(params.m_query), MakeBackInsertFunctor(key.m_tokens),
+                 hashtagDelims);
+
+  Delimiters delims;
+  key.m_lastTokenIsPrefix =
+      !key.m_tokens.empty() && !delims(strings::LastUniChar(params.m_query));
+
+  key.m_inputLocale = params.m_inputLocale;
+  key.m_preferredLocale = preferredLocale;
+  key.m_mode = params.m_mode;
+
+  key.m_viewportLevel = static_cast<int32_t>(ceil(log2(viewportSize)));
+  double const cellSize = ldexp(1.0, key.m_viewportLevel) / kViewportCellsPerSize;
+  m2::PointD const center = viewport.Center();
+  key.m_viewportX = static_cast<int64_t>(floor(center.x / cellSize));
+  key.m_viewportY = static_cast<int64_t>(floor(center.y / cellSize));
+
+  key.m_validPosition = params.IsValidPosition();
+  if (key.m_validPosition)
+  {
+    ms::LatLon const position = params.GetPositionLatLon();
+    key.m_positionLat = static_cast<int64_t>(floor(position.lat * kPositionCellsPerDegree));
+    key.m_positionLon = static_cast<int64_t>(floor(position.lon * kPositionCellsPerDegree));
+  }
+  else
+  {
+    key.m_positionLat = key.m_positionLon = 0;
+  }
+
+  key.m_suggestsEnabled = params.m_suggestsEnabled;
+  key.m_minDistanceOnMapBetweenResults = params.m_minDistanceOnMapBetweenResults;
+  key.m_cianMode = params.m_cianMode;
+  key.m_earlyEmit = params.m_earlyEmit;
+  return true;
+}
+
+ResultsCache::ResultsCache(size_t maxSize) : m_maxSize(maxSize)
+{
+  CHECK_GREATER(m_maxSize, 0, ());
+}
+
+bool ResultsCache::Get(Key const & key, Results & results)
+{
+  lock_guard<mutex> lock(m_mu);
+  auto const it = m_index.find(key);
+  if (it == m_index.end())
+  {
+    ++m_stats.m_misses;
+    return false;
+  }
+
+  ++m_stats.m_hits;
+  m_entries.splice(m_entries.begin(), m_entries, it->second);
+  results = it->second->second;
+  return true;
+}
+
+void ResultsCache::Put(Key const & key, Results const & results, uint64_t generation)
+{
+  lock_guard<mutex> lock(m_mu);
+  if (generation != m_generation)
+    return;
+
+  auto const it = m_index.find(key);
+  if (it != m_index.end())
+  {
+    it->second->second = results;
+    m_entries.splice(m_entries.begin(), m_entries, it->second);
+    return;
+  }
+
+  if (m_entries.size() == m_maxSize)
+  {
+    m_index.erase(m_entries.back().first);
+    m_entries.pop_back();
+  }
+
+  m_entries.emplace_front(key, results);
+  m_index.emplace(key, m_entries.begin());
+}
+
+void ResultsCache::Clear()
+{
+  lock_guard<mutex> lock(m_mu);
+  m_index.clear();
+  m_entries.clear();
+  ++m_generation;
+}
+
+uint64_t ResultsCache::GetGeneration() const
+{
+  lock_guard<mutex> lock(m_mu);
+  return m_generation;
+}
+
+size_t ResultsCache::GetSize() const
+{
+  lock_guard<mutex> lock(m_mu);
+  return m_entries.size();
+}
+
+ResultsCache::Stats ResultsCache::GetStats() const
+{
+  lock_guard<mutex> lock(m_mu);
+  return m_stats;
+}
+
+void ResultsCache::OnMapRegistered(platform::LocalCountryFile const & /* localFile */)
+{
+  Clear();
+}
+
+void ResultsCache::OnMapUpdated(platform::LocalCountryFile const & /* newFile */,
+                                platform::LocalCountryFile const & /* oldFile */)
+{
+  Clear();
+}
+
+void ResultsCache::OnMapDeregistered(platform::LocalCountryFile const & /* localFile */)
+{
+  Clear();
+}
+}  // namespace search
@@ -0,0 +1,108 @@
+#pragma once
+
+#include "search/mode.hpp"
+#include "search/result.hpp"
+
+#include "indexer/mwm_set.hpp"
+
+#include "geometry/rect2d.hpp"
+
+#include "base/string_utils.hpp"
+
+#include "std/cstdint.hpp"
+#include "std/list.hpp"
+#include "std/map.hpp"
+#include "std/mutex.hpp"
+#include "std/string.hpp"
+#include "std/utility.hpp"
+#include "std/vector.hpp"
+
+namespace search
+{
+class SearchParams;
+
+// LRU cache of the final results of the recent search queries. Queries
+// which differ only in case, delimiters or a small shift of the
+// viewport and the position share the same results.
+//
+// All methods are thread-safe. The cache is cleared when maps are
+// registered, updated or deregistered, the owner must also clear it
+// when features are edited.
+class ResultsCache : public MwmSet::Observer
+{
+public:
+  struct Key
+  {
+    bool operator<(Key const & rhs) const;
+
+    vector<strings::UniString> m_tokens;
+    bool m_lastTokenIsPrefix = false;
+
+    string m_inputLocale;
+    int8_t m_preferredLocale = 0;
+    Mode m_mode = Mode::Everywhere;
+
+    // Viewport is quantized to cells which sizes are proportional to
+    // the size of the viewport.
+    int32_t m_viewportLevel = 0;
+    int64_t m_viewportX = 0;
+    int64_t m_viewportY = 0;
+
+    bool m_validPosition = false;
+    int64_t m_positionLat = 0;
+    int64_t m_positionLon = 0;
+
+    bool m_suggestsEnabled = false;
+    double m_minDistanceOnMapBetweenResults = 0.0;
+    bool m_cianMode = false;
+    // Early emit changes the order of the final results.
+    bool m_earlyEmit = false;
+  };
+
+  struct Stats
+  {
+    uint64_t m_hits = 0;
+    uint64_t m_misses = 0;
+  };
+
+  // Builds a key for |params| and |viewport|. Returns false when
+  // results of the query must not be cached: viewport search, search
+  // with a hotels filter and search of coordinates.
+  static bool MakeKey(SearchParams const & params, m2::RectD const & viewport,
+                      int8_t preferredLocale, Key & key);
+
+  explicit ResultsCache(size_t maxSize);
+
+  // Returns true and fills |results| if there are results for |key|.
+  bool Get(Key const & key, Results & results);
+
+  // Every Clear() call increments the generation. Results of a query
+  // started with an older generation are stale, so they're ignored.
+  void Put(Key const & key, Results const & results, uint64_t generation);
+
+  void Clear();
+
+  uint64_t GetGeneration() const;
+  size_t GetSize() const;
+  Stats GetStats() const;
+
+  // MwmSet::Observer overrides:
+  void OnMapRegistered(platform::LocalCountryFile const & localFile) override;
+  void OnMapUpdated(platform::LocalCountryFile const & newFile,
+                    platform::LocalCountryFile const & oldFile) override;
+  void OnMapDeregistered(platform::LocalCountryFile const & localFile) override;
+
+private:
+  using Entry = pair<Key, Results>;
+  using Entries = list<Entry>;
+
+  size_t const m_maxSize;
+
+  mutable mutex m_mu;
+  // The most recently used entry is the first one.
+  Entries m_entries;
+  map<Key, Entries::iterator> m_index;
+  uint64_t m_generation = 0;
+  Stats m_stats;
+};
+}  // namespace search
@@ -7,6 +7,7 @@
 #include "search/search_index_values.hpp"
 #include "search/search_trie.hpp"
 #include "search/token_slice.hpp"
+#include "search/types_index.hpp"
 
 #include "indexer/classificator.hpp"
 #include "indexer/feature.hpp"
@@ -158,17 +159,18 @@ bool MatchFeatureByNameAndType(FeatureType const & ft, SearchTrieRequest<DFA> co
   feature::TypesHolder th(ft);
 
   bool matched = false;
-  ft.ForEachName([&](int8_t lang, string const & name) {
-    if (name.empty() || !request.IsLangExist(lang))
-      return true /* continue ForEachName */;
+  // Names of languages which aren't requested are skipped without copying.
+  ft.ForEachNameRef([&](int8_t lang, char const * name, size_t size) {
+    if (size == 0 || !request.IsLangExist(lang))
+      return true /* continue ForEachNameRef */;
 
     vector<UniString> tokens;
-    NormalizeAndTokenizeString(name, tokens, Delimiters());
+    NormalizeAndTokenizeString(string(name, size), tokens, Delimiters());
     if (!MatchesByName(tokens, request.m_names) && !MatchesByType(th, request.m_categories))
-      return true /* continue ForEachName */;
+      return true /* continue ForEachNameRef */;
 
     matched = true;
-    return false /* break ForEachName */;
+    return false /* break ForEachNameRef */;
   });
 
   return matched;
@@ -267,6 +269,52 @@ unique_ptr<coding::CompressedBitVector> RetrieveGeometryFeaturesImpl(
   return SortFeaturesAndBuildCBV(move(features));
 }
 
+bool MatchFeatureByTypes(FeatureType const & ft, vector<uint32_t> const & types)
+{
+  feature::TypesHolder th(ft);
+  for (auto type : th)
+  {
+    // The search index keeps types truncated to two levels (see
+    // GetCategoryTypes() in search_index_builder.cpp).
+    ftype::TruncValue(type, 2);
+    if (binary_search(types.begin(), types.end(), type))
+      return true;
+  }
+  return false;
+}
+
+unique_ptr<coding::CompressedBitVector> RetrieveCategoryFeaturesImpl(
+    TypesIndex const & index, MwmContext const & context, my::Cancellable const & cancellable,
+    vector<uint32_t> types)
+{
+  my::SortUnique(types);
+
+  EditedFeaturesHolder holder(context.GetId());
+  vector<uint64_t> features;
+
+  auto const & c = classif();
+  for (auto const type : types)
+  {
+    BailIfCancelled(cancellable);
+
+    auto const cbv = index.GetFeatures(c.GetIndexForType(type));
+    if (!cbv)
+      continue;
+
+    coding::CompressedBitVectorEnumerator::ForEach(*cbv, [&](uint64_t featureIndex) {
+      if (!holder.ModifiedOrDeleted(base::asserted_cast<uint32_t>(featureIndex)))
+        features.push_back(featureIndex);
+    });
+  }
+
+  holder.ForEachModifiedOrCreated([&](FeatureType & ft, uint64_t index) {
+    if (MatchFeatureByTypes(ft, types))
+      features.push_back(index);
+  });
+
+  return SortFeaturesAndBuildCBV(move(features));
+}
+
 template <typename T>
 struct RetrieveAddressFeaturesAdaptor
 {
@@ -329,6 +377,12 @@ unique_ptr<coding::CompressedBitVector> Retrieval::RetrieveAddressFeatures(
   return Retrieve<RetrieveAddressFeaturesAdaptor>(request);
 }
 
+unique_ptr<coding::CompressedBitVector> Retrieval::RetrieveCategoryFeatures(
+    TypesIndex const & index, vector<uint32_t> const & types)
+{
+  return RetrieveCategoryFeaturesImpl(index, m_context, m_cancellable, types);
+}
+
 unique_ptr<coding::CompressedBitVector> Retrieval::RetrievePostcodeFeatures(
     TokenSlice const & slice)
 {
@@ -14,6 +14,7 @@
 #include "base/levenshtein_dfa.hpp"
 
 #include "std/unique_ptr.hpp"
+#include "std/vector.hpp"
 
 class MwmValue;
 
@@ -26,6 +27,7 @@ namespace search
 {
 class MwmContext;
 class TokenSlice;
+class TypesIndex;
 
 class Retrieval
 {
@@ -43,6 +45,13 @@ public:
   unique_ptr<coding::CompressedBitVector> RetrieveAddressFeatures(
       SearchTrieRequest<strings::PrefixDFAModifier<strings::LevenshteinDFA>> const & request);
 
+  // Retrieves from |index| all features of classificator |types|.
+  // It's the same as the search index retrieval of the categories of
+  // |types| but takes precomputed posting lists instead of the trie
+  // traversal.
+  unique_ptr<coding::CompressedBitVector> RetrieveCategoryFeatures(
+      TypesIndex const & index, vector<uint32_t> const & types);
+
   // Retrieves from the search index corresponding to |value| all
   // postcodes matching to |slice|.
   unique_ptr<coding::CompressedBitVector> RetrievePostcodeFeatures(TokenSlice const & slice);
@@ -9,9 +9,19 @@
 #include "indexer/scales.hpp"
 #include "indexer/search_string_utils.hpp"
 
+#include "base/stl_add.hpp"
 #include "base/stl_helpers.hpp"
+#include "base/thread.hpp"
 
+#include "std/algorithm.hpp"
+#include "std/atomic.hpp"
+#include "std/cmath.hpp"
+#include "std/function.hpp"
 #include "std/limits.hpp"
+#include "std/map.hpp"
+#include "std/numeric.hpp"
+
+#include <exception>
 
 namespace search
 {
@@ -21,12 +31,75 @@ size_t constexpr kSimilarityThresholdPercent = 10;
 int constexpr kQueryScale = scales::GetUpperScale();
 /// Max number of tries (nearest houses with housenumber) to check when getting point address.
 size_t constexpr kMaxNumTriesToApproxAddress = 10;
+
+/// Max number of buildings which nearby streets are cached by a batch context.
+size_t constexpr kMaxNumCachedStreets = 1024;
+
+class FunctionRoutine final : public threads::IRoutine
+{
+public:
+  explicit FunctionRoutine(function<void()> const & fn) : m_fn(fn) {}
+
+  // threads::IRoutine overrides:
+  void Do() override { m_fn(); }
+
+private:
+  function<void()> const m_fn;
+};
 } // namespace
 
+class ReverseGeocoder::BatchContext
+{
+public:
+  explicit BatchContext(ReverseGeocoder const & coder) : m_coder(coder), m_table(coder.m_index) {}
+
+  HouseTable & GetTable() { return m_table; }
+
+  vector<Street> const & GetStreets(Building const & bld)
+  {
+    auto it = m_streets.find(bld.m_id);
+    if (it != m_streets.end())
+      return it->second;
+
+    if (m_streets.size() >= kMaxNumCachedStreets)
+      m_streets.clear();
+
+    vector<Street> & streets = m_streets[bld.m_id];
+    if (!m_context || m_context->GetId() != bld.m_id.m_mwmId)
+    {
+      m_context.reset();
+      auto handle = m_coder.m_index.GetMwmHandleById(bld.m_id.m_mwmId);
+      if (!handle.IsAlive())
+        return streets;
+      m_context = make_unique<MwmContext>(move(handle));
+    }
+    m_coder.GetNearbyStreets(*m_context, bld.m_center, streets);
+    return streets;
+  }
+
+private:
+  ReverseGeocoder const & m_coder;
+  HouseTable m_table;
+
+  unique_ptr<MwmContext> m_context;
+  map<FeatureID, vector<Street>> m_streets;
+};
+
 ReverseGeocoder::ReverseGeocoder(Index const & index) : m_index(index) {}
 
 void ReverseGeocoder::GetNearbyStreets(MwmSet::MwmId const & id, m2::PointD const & center,
                                        vector<Street> & streets) const
+{
+  MwmSet::MwmHandle mwmHandle = m_index.GetMwmHandleById(id);
+  if (mwmHandle.IsAlive())
+  {
+    MwmContext context(move(mwmHandle));
+    GetNearbyStreets(context, center, streets);
+  }
+}
+
+void ReverseGeocoder::GetNearbyStreets(MwmContext & context, m2::PointD const & center,
+                                       vector<Street> & streets) const
 {
   m2::RectD const rect = GetLookupRect(center, kLookupRadiusM);
 
@@ -47,12 +120,8 @@ void ReverseGeocoder::GetNearbyStreets(MwmSet::MwmId const & id, m2::PointD cons
     streets.emplace_back(ft.GetID(), feature::GetMinDistanceMeters(ft, center), name);
   };
 
-  MwmSet::MwmHandle mwmHandle = m_index.GetMwmHandleById(id);
-  if (mwmHandle.IsAlive())
-  {
-    search::MwmContext(move(mwmHandle)).ForEachFeature(rect, addStreet);
-    sort(streets.begin(), streets.end(), my::LessBy(&Street::m_distanceMeters));
-  }
+  context.ForEachFeature(rect, addStreet);
+  sort(streets.begin(), streets.end(), my::LessBy(&Street::m_distanceMeters));
 }
 
 void ReverseGeocoder::GetNearbyStreets(FeatureType & ft, vector<Street> & streets) const
@@ -125,6 +194,131 @@ void ReverseGeocoder::GetNearbyAddress(m2::PointD const & center, Address & addr
   }
 }
 
+void ReverseGeocoder::GetNearbyAddresses(vector<m2::PointD> const & points,
+                                         vector<Address> & addrs, size_t numThreads) const
+{
+  addrs.assign(points.size(), Address());
+  if (points.empty())
+    return;
+
+  // Points are sorted by cells of the lookup radius size, so nearby
+  // points are processed together.
+  double const cellSize = GetLookupRect(m2::PointD(0, 0), kLookupRadiusM).SizeX() / 2;
+  using Cell = pair<int64_t, int64_t>;
+  vector<Cell> cells;
+  cells.reserve(points.size());
+  for (auto const & p : points)
+  {
+    cells.emplace_back(static_cast<int64_t>(floor(p.x / cellSize)),
+                       static_cast<int64_t>(floor(p.y / cellSize)));
+  }
+
+  vector<size_t> order(points.size());
+  iota(order.begin(), order.end(), 0);
+  sort(order.begin(), order.end(), [&cells](size_t lhs, size_t rhs) {
+    return cells[lhs] != cells[rhs] ? cells[lhs] < cells[rhs] : lhs < rhs;
+  });
+
+  // Points of the |i|-th group are in the range [groups[i], groups[i + 1]) of |order|.
+  vector<size_t> groups;
+  for (size_t i = 0; i < order.size(); ++i)
+  {
+    if (i == 0 || cells[order[i]] != cells[order[i - 1]])
+      groups.push_back(i);
+  }
+  groups.push_back(order.size());
+  size_t const numGroups = groups.size() - 1;
+
+  numThreads = min(numThreads, numGroups);
+  if (numThreads <= 1)
+  {
+    BatchContext context(*this);
+    for (size_t i = 0; i < numGroups; ++i)
+      GetNearbyAddresses(points, order, groups[i], groups[i + 1], context, addrs);
+    return;
+  }
+
+  atomic<size_t> next(0);
+  vector<std::exception_ptr> errors(numThreads);
+  threads::SimpleThreadPool pool(numThreads);
+  for (size_t t = 0; t < numThreads; ++t)
+  {
+    pool.Add(my::make_unique<FunctionRoutine>([&, t]() {
+      try
+      {
+        BatchContext context(*this);
+        for (size_t i = next++; i < numGroups; i = next++)
+          GetNearbyAddresses(points, order, groups[i], groups[i + 1], context, addrs);
+      }
+      catch (...)
+      {
+        errors[t] = std::current_exception();
+      }
+    }));
+  }
+  pool.Join();
+
+  for (auto const & error : errors)
+  {
+    if (error)
+      std::rethrow_exception(error);
+  }
+}
+
+void ReverseGeocoder::GetNearbyAddresses(vector<m2::PointD> const & points,
+                                         vector<size_t> const & order, size_t begin, size_t end,
+                                         BatchContext & context, vector<Address> & addrs) const
+{
+  ASSERT_LESS(begin, end, ());
+
+  vector<m2::RectD> rects;
+  m2::RectD groupRect;
+  for (size_t i = begin; i < end; ++i)
+  {
+    rects.push_back(GetLookupRect(points[order[i]], kLookupRadiusM));
+    groupRect.Add(rects.back());
+  }
+
+  // Buildings are read once for the whole group, distances are
+  // calculated for all points which lookup rects intersect them.
+  vector<vector<Building>> buildings(end - begin);
+  auto const addBuilding = [&](FeatureType & ft) {
+    if (ft.GetHouseNumber().empty())
+      return;
+
+    m2::RectD const limitRect = ft.GetLimitRect(FeatureType::BEST_GEOMETRY);
+    for (size_t i = 0; i < rects.size(); ++i)
+    {
+      if (!rects[i].IsIntersect(limitRect))
+        continue;
+      auto const & center = points[order[begin + i]];
+      buildings[i].push_back(FromFeature(ft, feature::GetMinDistanceMeters(ft, center)));
+    }
+  };
+  m_index.ForEachInRect(addBuilding, groupRect, kQueryScale);
+
+  auto const getStreets = [&context](Building const & bld) -> vector<Street> const & {
+    return context.GetStreets(bld);
+  };
+
+  for (size_t i = 0; i < buildings.size(); ++i)
+  {
+    auto & bs = buildings[i];
+    sort(bs.begin(), bs.end(), my::LessBy(&Building::m_distanceMeters));
+
+    auto & addr = addrs[order[begin + i]];
+    size_t triesCount = 0;
+    for (auto const & b : bs)
+    {
+      if (GetNearbyAddress(context.GetTable(), b, getStreets, addr) ||
+          (++triesCount == kMaxNumTriesToApproxAddress))
+      {
+        break;
+      }
+    }
+  }
+}
+
 bool ReverseGeocoder::GetExactAddress(FeatureType const & ft, Address & addr) const
 {
   if (ft.GetHouseNumber().empty())
@@ -135,6 +329,18 @@ bool ReverseGeocoder::GetExactAddress(FeatureType const & ft, Address & addr) co
 
 bool ReverseGeocoder::GetNearbyAddress(HouseTable & table, Building const & bld,
                                        Address & addr) const
+{
+  vector<Street> streets;
+  auto const getStreets = [&](Building const & b) -> vector<Street> const & {
+    GetNearbyStreets(b.m_id.m_mwmId, b.m_center, streets);
+    return streets;
+  };
+  return GetNearbyAddress(table, bld, getStreets, addr);
+}
+
+template <typename GetStreets>
+bool ReverseGeocoder::GetNearbyAddress(HouseTable & table, Building const & bld,
+                                       GetStreets && getStreets, Address & addr) const
 {
   string street;
   if (osm::Editor::Instance().GetEditedFeatureStreet(bld.m_id, street))
@@ -148,8 +354,7 @@ bool ReverseGeocoder::GetNearbyAddress(HouseTable & table, Building const & bld,
   if (!table.Get(bld.m_id, ind))
     return false;
 
-  vector<Street> streets;
-  GetNearbyStreets(bld.m_id.m_mwmId, bld.m_center, streets);
+  vector<Street> const & streets = getStreets(bld);
   if (ind < streets.size())
   {
     addr.m_building = bld;
@@ -16,6 +16,7 @@ class Index;
 
 namespace search
 {
+class MwmContext;
 
 class ReverseGeocoder
 {
@@ -41,6 +42,9 @@ class ReverseGeocoder
 public:
   /// All "Nearby" functions work in this lookup radius.
   static int constexpr kLookupRadiusM = 500;
+  /// Max distance from house to street where we do search matching
+  /// even if there is no exact street written for this house.
+  static int constexpr kMaxApproxStreetDistanceM = 100;
 
   explicit ReverseGeocoder(Index const & index);
 
@@ -89,6 +93,12 @@ public:
 
   /// @return The nearest exact address where building has house number and valid street match.
   void GetNearbyAddress(m2::PointD const & center, Address & addr) const;
+  /// Batch version of GetNearbyAddress(): |addrs[i]| is the address of |points[i]|.
+  /// Points are grouped by cells, buildings are loaded once for a group, streets and
+  /// house-to-street tables are shared by all points. Groups are processed on |numThreads|
+  /// threads.
+  void GetNearbyAddresses(vector<m2::PointD> const & points, vector<Address> & addrs,
+                          size_t numThreads = 1) const;
   /// @param addr (out) the exact address of a feature.
   /// @returns false if  can't extruct address or ft have no house number.
   bool GetExactAddress(FeatureType const & ft, Address & addr) const;
@@ -106,8 +116,25 @@ private:
     bool Get(FeatureID const & fid, uint32_t & streetIndex);
   };
 
+  /// Caches which are shared by the points of a batch in a thread.
+  class BatchContext;
+
   bool GetNearbyAddress(HouseTable & table, Building const & bld, Address & addr) const;
 
+  /// @param getStreets is called only for buildings with a known street index.
+  template <typename GetStreets>
+  bool GetNearbyAddress(HouseTable & table, Building const & bld, GetStreets && getStreets,
+                        Address & addr) const;
+
+  void GetNearbyStreets(MwmContext & context, m2::PointD const & center,
+                        vector<Street> & streets) const;
+
+  /// Fills addresses of |points[order[i]]| for all i in [begin, end). All the points
+  /// must be close to each other.
+  void GetNearbyAddresses(vector<m2::PointD> const & points, vector<size_t> const & order,
+                          size_t begin, size_t end, BatchContext & context,
+                          vector<Address> & addrs) const;
+
   /// @return Sorted by distance houses vector with valid house number.
   void GetNearbyBuildings(m2::PointD const & center, vector<Building> & buildings) const;
 
@@ -19,6 +19,7 @@ HEADERS += \
     common.hpp \
     displayed_categories.hpp \
     downloader_search_callback.hpp \
+    downloader_search_index.hpp \
     dummy_rank_table.hpp \
     editor_delegate.hpp \
     emitter.hpp \
@@ -38,7 +39,9 @@ HEADERS += \
     geometry_utils.hpp \
     hotels_classifier.hpp \
     hotels_filter.hpp \
+    hotels_table.hpp \
     house_detector.hpp \
+    house_numbers_index.hpp \
     house_numbers_matcher.hpp \
     house_to_street_table.hpp \
     intermediate_result.hpp \
@@ -48,11 +51,13 @@ HEADERS += \
     keyword_matcher.hpp \
     latlon_match.hpp \
     lazy_centers_table.hpp \
+    localities_grid.hpp \
     locality_finder.hpp \
     locality_scorer.hpp \
     mode.hpp \
     model.hpp \
     mwm_context.hpp \
+    mwm_tables_cache.hpp \
     nested_rects_cache.hpp \
     point_rect_matcher.hpp \
     pre_ranker.hpp \
@@ -62,11 +67,13 @@ HEADERS += \
     projection_on_street.hpp \
     query_params.hpp \
     query_saver.hpp \
+    query_trace.hpp \
     rank_table_cache.hpp \
     ranker.hpp \
     ranking_info.hpp \
     ranking_utils.hpp \
     result.hpp \
+    results_cache.hpp \
     retrieval.hpp \
     reverse_geocoder.hpp \
     search_index_values.hpp \
@@ -74,12 +81,15 @@ HEADERS += \
     search_trie.hpp \
     segment_tree.hpp \
     stats_cache.hpp \
+    street_vicinity_cache.hpp \
     street_vicinity_loader.hpp \
     streets_matcher.hpp \
     string_intersection.hpp \
     suggest.hpp \
+    token_features_cache.hpp \
     token_range.hpp \
     token_slice.hpp \
+    types_index.hpp \
     types_skipper.hpp \
     utils.hpp \
     viewport_search_callback.hpp \
@@ -91,6 +101,7 @@ SOURCES += \
     cbv.cpp \
     displayed_categories.cpp \
     downloader_search_callback.cpp \
+    downloader_search_index.cpp \
     dummy_rank_table.cpp \
     editor_delegate.cpp \
     engine.cpp \
@@ -107,7 +118,9 @@ SOURCES += \
     geometry_utils.cpp \
     hotels_classifier.cpp \
     hotels_filter.cpp \
+    hotels_table.cpp \
     house_detector.cpp \
+    house_numbers_index.cpp \
     house_numbers_matcher.cpp \
     house_to_street_table.cpp \
     intermediate_result.cpp \
@@ -116,11 +129,13 @@ SOURCES += \
     keyword_matcher.cpp \
     latlon_match.cpp \
     lazy_centers_table.cpp \
+    localities_grid.cpp \
     locality_finder.cpp \
     locality_scorer.cpp \
     mode.cpp \
     model.cpp \
     mwm_context.cpp \
+    mwm_tables_cache.cpp \
     nested_rects_cache.cpp \
     pre_ranker.cpp \
     pre_ranking_info.cpp \
@@ -128,18 +143,23 @@ SOURCES += \
     projection_on_street.cpp \
     query_params.cpp \
     query_saver.cpp \
+    query_trace.cpp \
     rank_table_cache.cpp \
     ranker.cpp \
     ranking_info.cpp \
     ranking_utils.cpp \
     result.cpp \
+    results_cache.cpp \
     retrieval.cpp \
     reverse_geocoder.cpp \
     search_params.cpp \
     segment_tree.cpp \
+    street_vicinity_cache.cpp \
     street_vicinity_loader.cpp \
     streets_matcher.cpp \
+    token_features_cache.cpp \
     token_slice.cpp \
+    types_index.cpp \
     types_skipper.cpp \
     utils.cpp \
     viewport_search_callback.cpp \
@@ -3,6 +3,7 @@
 #include "generator/generator_tests_support/test_feature.hpp"
 
 #include "search/downloader_search_callback.hpp"
+#include "search/downloader_search_index.hpp"
 #include "search/mode.hpp"
 #include "search/result.hpp"
 #include "search/search_integration_tests/helpers.hpp"
@@ -252,5 +253,42 @@ UNIT_CLASS_TEST(DownloaderSearchTest, Smoke)
                  storage::DownloaderSearchResult("Square Two", "Square Two capital")});
   }
 }
+
+UNIT_TEST(DownloaderSearchIndex_Smoke)
+{
+  storage::Storage storage(kCountriesTxt, make_unique<TestMapFilesDownloader>());
+  storage.SetLocaleForTesting(R"({"Square One":"Quadratum Unum", "Wonderland":"Mirabilia"})",
+                              "la");
+
+  DownloaderSearchIndex index;
+  TEST(!index.IsUpToDate(storage), ());
+  index.Build(storage);
+  TEST(index.IsUpToDate(storage), ());
+  TEST_EQUAL(index.GetNumNodes(), 6, ());
+
+  auto const search = [&index](string const & query) {
+    vector<storage::DownloaderSearchResult> results;
+    index.Search(query, results);
+    return results;
+  };
+
+  using R = storage::DownloaderSearchResult;
+  TEST_EQUAL(search("flatland"), vector<R>({R("Flatland", "Flatland")}), ());
+  TEST_EQUAL(search("quadratum"), vector<R>({R("Square One", "Quadratum Unum")}), ());
+  TEST_EQUAL(search("square one"), vector<R>({R("Square One", "Square One")}), ());
+  TEST_EQUAL(search("mirab"), vector<R>({R("Wonderland", "Mirabilia")}), ());
+  TEST_EQUAL(search("mirab "), vector<R>(), ());
+  TEST_EQUAL(search("pondville"), vector<R>(), ());
+  TEST_EQUAL(search("square t"), vector<R>({R("Square Two", "Square Two")}), ());
+  TEST_EQUAL(search("square"),
+             vector<R>({R("Square One", "Square One"), R("Square Two", "Square Two")}), ());
+  TEST_EQUAL(search("countries"), vector<R>(), ());
+
+  storage.SetLocaleForTesting(R"({"Flatland":"Planitia"})", "xx");
+  TEST(!index.IsUpToDate(storage), ());
+  index.Build(storage);
+  TEST_EQUAL(search("planitia"), vector<R>({R("Flatland", "Planitia")}), ());
+  TEST_EQUAL(search("quadratum"), vector<R>(), ());
+}
 }  // namespace
 }  // namespace search
@@ -0,0 +1,66 @@
+#include "testing/testing.hpp"
+
+#include "search/mwm_tables_cache.hpp"
+#include "search/search_integration_tests/helpers.hpp"
+
+#include "generator/generator_tests_support/test_feature.hpp"
+#include "generator/generator_tests_support/test_mwm_builder.hpp"
+
+#include "indexer/index.hpp"
+#include "indexer/mwm_set.hpp"
+#include "indexer/rank_table.hpp"
+
+#include "geometry/point2d.hpp"
+
+#include "std/shared_ptr.hpp"
+
+using namespace generator::tests_support;
+using namespace search;
+
+namespace
+{
+class MwmTablesCacheTest : public SearchTest
+{
+};
+
+UNIT_CLASS_TEST(MwmTablesCacheTest, Smoke)
+{
+  m2::PointD const center(0.5, 0.5);
+  TestPOI cafe(center, "Cafe", "en");
+  auto const id = BuildCountry("Wonderland", [&](TestMwmBuilder & builder) { builder.Add(cafe); });
+
+  MwmTablesCache cache;
+  TEST_EQUAL(cache.GetSize(), 0, ());
+
+  {
+    // Concurrent searches take different values of the same mwm.
+    auto handle1 = m_engine.GetMwmHandleById(id);
+    auto handle2 = m_engine.GetMwmHandleById(id);
+    TEST(handle1.IsAlive(), ());
+    TEST(handle2.IsAlive(), ());
+    auto const & value1 = *handle1.GetValue<MwmValue>();
+    auto const & value2 = *handle2.GetValue<MwmValue>();
+
+    auto const ranks1 = cache.GetRankTable(id, value1);
+    auto const ranks2 = cache.GetRankTable(id, value2);
+    TEST(ranks1, ());
+    TEST_EQUAL(ranks1.get(), ranks2.get(), ());
+    TEST_EQUAL(ranks1->Size(), 1, ());
+
+    auto const centers1 = cache.GetCentersTable(id, value1);
+    auto const centers2 = cache.GetCentersTable(id, value2);
+    TEST(centers1, ());
+    TEST_EQUAL(centers1.get(), centers2.get(), ());
+
+    m2::PointD actual;
+    TEST(centers1->Get(0 /* id */, actual), ());
+    TEST(actual.EqualDxDy(center, 1e-4), (actual, center));
+    TEST(!centers1->Get(1 /* id */, actual), ());
+
+    TEST_EQUAL(cache.GetSize(), 1, ());
+  }
+
+  // Tables aren't kept when nobody uses them.
+  TEST_EQUAL(cache.GetSize(), 0, ());
+}
+}  // namespace
@@ -45,10 +45,10 @@ class TestRanker : public Ranker
 {
 public:
   TestRanker(TestSearchEngine & engine, Emitter & emitter, vector<Suggest> const & suggests,
-             VillagesCache & villagesCache, my::Cancellable const & cancellable,
-             vector<PreResult1> & results)
+             VillagesCache & villagesCache, PreResult2Arena & preResults2Arena,
+             my::Cancellable const & cancellable, vector<PreResult1> & results)
     : Ranker(static_cast<Index const &>(engine), engine.GetCountryInfoGetter(), emitter,
-             GetDefaultCategories(), suggests, villagesCache, cancellable)
+             GetDefaultCategories(), suggests, villagesCache, preResults2Arena, cancellable)
     , m_results(results)
   {
   }
@@ -114,7 +114,9 @@ UNIT_CLASS_TEST(PreRankerTest, Smoke)
   vector<PreResult1> results;
   Emitter emitter;
   VillagesCache villagesCache(m_cancellable);
-  TestRanker ranker(m_engine, emitter, m_suggests, villagesCache, m_cancellable, results);
+  PreResult2Arena preResults2Arena;
+  TestRanker ranker(m_engine, emitter, m_suggests, villagesCache, preResults2Arena, m_cancellable,
+                    results);
 
   PreRanker preRanker(m_engine, ranker, pois.size());
   PreRanker::Params params;
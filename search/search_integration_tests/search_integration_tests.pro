@@ -29,6 +29,7 @@ SOURCES += \
     generate_tests.cpp \
     helpers.cpp \
     interactive_search_test.cpp \
+    mwm_tables_cache_test.cpp \
     pre_ranker_test.cpp \
     processor_test.cpp \
     search_edited_features_test.cpp \
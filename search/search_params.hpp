@@ -12,6 +12,7 @@
 
 namespace search
 {
+class QueryTrace;
 class Results;
 
 class SearchParams
@@ -20,6 +21,15 @@ public:
   using TOnStarted = function<void()>;
   using TOnResults = function<void(Results const &)>;
 
+  // Called with the same results as TOnResults, but results in the
+  // range [0, firstChanged) are guaranteed to be the same as in the
+  // previous call, so only the rest ones must be replaced or appended.
+  using TOnResultsDelta = function<void(Results const & results, size_t firstChanged)>;
+
+  // Called once at the end of the search with the latency breakdown
+  // of the query. Isn't called for results taken from the cache.
+  using TOnTrace = function<void(QueryTrace const &)>;
+
   void SetPosition(double lat, double lon);
   m2::PointD GetPositionMercator() const;
   ms::LatLon GetPositionLatLon() const;
@@ -30,6 +40,10 @@ public:
 
   TOnStarted m_onStarted;
   TOnResults m_onResults;
+  TOnResultsDelta m_onResultsDelta;
+
+  // Tracing is disabled when not set.
+  TOnTrace m_onTrace;
 
   string m_query;
   string m_inputLocale;
@@ -45,6 +59,11 @@ public:
   shared_ptr<hotels_filter::Rule> m_hotelsFilter;
   bool m_cianMode = false;
 
+  // When true, everywhere search emits confidently ranked results as
+  // soon as they're ranked, and the rest ones are held until the end
+  // of the search.
+  bool m_earlyEmit = false;
+
   friend string DebugPrint(SearchParams const & params);
 
 private:
@@ -9,6 +9,7 @@
 #include "geometry/point2d.hpp"
 
 #include "search/processor_factory.hpp"
+#include "search/query_trace.hpp"
 #include "search/ranking_info.hpp"
 #include "search/result.hpp"
 #include "search/search_quality/helpers.hpp"
@@ -35,12 +36,14 @@
 
 #include "std/algorithm.hpp"
 #include "std/cmath.hpp"
+#include "std/condition_variable.hpp"
 #include "std/cstdio.hpp"
 #include "std/fstream.hpp"
 #include "std/iomanip.hpp"
 #include "std/iostream.hpp"
 #include "std/limits.hpp"
 #include "std/map.hpp"
+#include "std/mutex.hpp"
 #include "std/numeric.hpp"
 #include "std/sstream.hpp"
 #include "std/string.hpp"
@@ -60,11 +63,15 @@ DEFINE_int32(num_threads, 1, "Number of search engine threads");
 DEFINE_string(mwm_list_path, "",
               "Path to a file containing the names of available mwms, one per line");
 DEFINE_string(mwm_path, "", "Path to mwm files (writable dir)");
-DEFINE_string(queries_path, "", "Path to the file with queries");
+DEFINE_string(queries_path, "",
+              "Path to the file with queries, one per line. A line may start with the class of "
+              "the query separated by a tab");
 DEFINE_int32(top, 1, "Number of top results to show for every query");
 DEFINE_string(viewport, "", "Viewport to use when searching (default, moscow, london, zurich)");
 DEFINE_string(check_completeness, "", "Path to the file with completeness data");
 DEFINE_string(ranking_csv_file, "", "File ranking info will be exported to");
+DEFINE_bool(latency_report, false,
+            "Print percentiles of response times and of search stages by query classes");
 
 map<string, m2::RectD> const kViewports = {
     {"default", m2::RectD(m2::PointD(0.0, 0.0), m2::PointD(1.0, 1.0))},
@@ -74,6 +81,7 @@ map<string, m2::RectD> const kViewports = {
 
 string const kDefaultQueriesPathSuffix = "/../search/search_quality/search_quality_tool/queries.txt";
 string const kEmptyResult = "<empty>";
+string const kAllQueriesClass = "all";
 
 struct CompletenessQuery
 {
@@ -85,6 +93,33 @@ struct CompletenessQuery
   double m_lon = 0;
 };
 
+// Trace of a query is delivered after its results, so it's waited for
+// separately.
+class TraceSlot
+{
+public:
+  void Set(QueryTrace const & trace)
+  {
+    lock_guard<mutex> lock(m_mu);
+    m_trace = trace;
+    m_done = true;
+    m_cv.notify_one();
+  }
+
+  QueryTrace const & Wait()
+  {
+    unique_lock<mutex> lock(m_mu);
+    m_cv.wait(lock, [this]() { return m_done; });
+    return m_trace;
+  }
+
+private:
+  mutex m_mu;
+  condition_variable m_cv;
+  bool m_done = false;
+  QueryTrace m_trace;
+};
+
 DECLARE_EXCEPTION(MalformedQueryException, RootException);
 
 void DidDownload(TCountryId const & /* countryId */,
@@ -187,6 +222,85 @@ void CalcStatistics(vector<double> const & a, double & avg, double & maximum, do
   stdDev = sqrt(var);
 }
 
+// Returns the value at |percent| percent of sorted |values| by the
+// nearest-rank method.
+double GetPercentile(vector<double> const & values, double percent)
+{
+  CHECK(!values.empty(), ());
+  ASSERT(is_sorted(values.begin(), values.end()), ());
+  auto const rank = static_cast<size_t>(ceil(percent / 100.0 * values.size()));
+  return values[rank == 0 ? 0 : rank - 1];
+}
+
+void PrintPercentiles(string const & name, vector<double> values)
+{
+  sort(values.begin(), values.end());
+  cout << "  " << std::left << setw(24) << name << std::right << " p50 " << setw(8)
+       << GetPercentile(values, 50) << "s  p90 " << setw(8) << GetPercentile(values, 90)
+       << "s  p99 " << setw(8) << GetPercentile(values, 99) << "s  max " << setw(8)
+       << values.back() << "s" << endl;
+}
+
+// Prints the latency distribution of queries of every class and of all
+// the queries, as a whole and by search stages.
+void PrintLatencyReport(vector<string> const & classes, vector<double> const & responseTimes,
+                        vector<QueryTrace> const & traces)
+{
+  map<string, vector<size_t>> byClass;
+  for (size_t i = 0; i < classes.size(); ++i)
+  {
+    byClass[kAllQueriesClass].push_back(i);
+    if (classes[i] != kAllQueriesClass)
+      byClass[classes[i]].push_back(i);
+  }
+
+  cout << fixed << setprecision(3);
+  cout << endl << "Latency report:" << endl;
+  for (auto const & entry : byClass)
+  {
+    auto const & ids = entry.second;
+    cout << "Class " << entry.first << ", " << ids.size() << " queries:" << endl;
+
+    vector<double> times;
+    for (auto const i : ids)
+      times.push_back(responseTimes[i]);
+    PrintPercentiles("response", times);
+
+    for (size_t stage = 0; stage < QueryTrace::STAGE_COUNT; ++stage)
+    {
+      times.clear();
+      for (auto const i : ids)
+        times.push_back(traces[i].GetStage(static_cast<QueryTrace::Stage>(stage)).m_seconds);
+      PrintPercentiles(DebugPrint(static_cast<QueryTrace::Stage>(stage)), times);
+    }
+
+    times.clear();
+    for (auto const i : ids)
+      times.push_back(traces[i].GetUntrackedSeconds());
+    PrintPercentiles("untracked", times);
+  }
+}
+
+// Splits a line of the queries file into the class of the query and
+// the query itself.
+void ParseQueryLine(string const & line, string & queryClass, string & query)
+{
+  auto const tab = line.find('\t');
+  if (tab == string::npos)
+  {
+    queryClass = kAllQueriesClass;
+    query = line;
+    return;
+  }
+
+  queryClass = line.substr(0, tab);
+  query = line.substr(tab + 1);
+  strings::Trim(queryClass);
+  strings::Trim(query);
+  if (queryClass.empty())
+    queryClass = kAllQueriesClass;
+}
+
 // Unlike strings::Tokenize, this function allows for empty tokens.
 void Split(string const & s, char delim, vector<string> & parts)
 {
@@ -377,8 +491,9 @@ int main(int argc, char * argv[])
 
   Engine::Params params;
   params.m_locale = FLAGS_locale;
-  params.m_numThreads = FLAGS_num_threads;
-  TestSearchEngine engine(move(infoGetter), make_unique<ProcessorFactory>(), Engine::Params{});
+  CHECK_GREATER(FLAGS_num_threads, 0, ());
+  params.m_numThreads = static_cast<size_t>(FLAGS_num_threads);
+  TestSearchEngine engine(move(infoGetter), make_unique<ProcessorFactory>(), params);
 
   vector<platform::LocalCountryFile> mwms;
   if (!FLAGS_mwm_list_path.empty())
@@ -426,18 +541,32 @@ int main(int argc, char * argv[])
     return 0;
   }
 
-  vector<string> queries;
+  vector<string> lines;
   string queriesPath = FLAGS_queries_path;
   if (queriesPath.empty())
     queriesPath = my::JoinFoldersToPath(platform.WritableDir(), kDefaultQueriesPathSuffix);
-  ReadStringsFromFile(queriesPath, queries);
+  ReadStringsFromFile(queriesPath, lines);
 
+  vector<string> classes(lines.size());
+  vector<string> queries(lines.size());
+  for (size_t i = 0; i < lines.size(); ++i)
+    ParseQueryLine(lines[i], classes[i], queries[i]);
+
+  vector<TraceSlot> traceSlots(FLAGS_latency_report ? queries.size() : 0);
   vector<unique_ptr<TestSearchRequest>> requests;
   for (size_t i = 0; i < queries.size(); ++i)
   {
+    SearchParams searchParams;
     // todo(@m) Add a bool flag to search with prefixes?
-    requests.emplace_back(make_unique<TestSearchRequest>(engine, MakePrefixFree(queries[i]),
-                                                         FLAGS_locale, Mode::Everywhere, viewport));
+    searchParams.m_query = MakePrefixFree(queries[i]);
+    searchParams.m_inputLocale = FLAGS_locale;
+    searchParams.m_mode = Mode::Everywhere;
+    if (FLAGS_latency_report)
+    {
+      auto & slot = traceSlots[i];
+      searchParams.m_onTrace = [&slot](QueryTrace const & trace) { slot.Set(trace); };
+    }
+    requests.emplace_back(make_unique<TestSearchRequest>(engine, searchParams, viewport));
   }
 
   ofstream csv;
@@ -457,10 +586,16 @@ int main(int argc, char * argv[])
     csv << endl;
   }
 
+  // All the requests are started at once, so they are processed on all
+  // the engine threads. Response time is measured from the start of the
+  // processing of a request, so waiting in the queue is not counted.
+  for (auto & request : requests)
+    request->Start();
+
   vector<double> responseTimes(queries.size());
   for (size_t i = 0; i < queries.size(); ++i)
   {
-    requests[i]->Run();
+    requests[i]->Wait();
     auto rt = duration_cast<milliseconds>(requests[i]->ResponseTime()).count();
     responseTimes[i] = static_cast<double>(rt) / 1000;
     PrintTopResults(MakePrefixFree(queries[i]), requests[i]->Results(), FLAGS_top,
@@ -488,5 +623,14 @@ int main(int argc, char * argv[])
   cout << "Average response time: " << averageTime << "s"
        << " (std. dev. " << stdDevTime << "s)" << endl;
 
+  if (FLAGS_latency_report && !queries.empty())
+  {
+    vector<QueryTrace> traces;
+    traces.reserve(traceSlots.size());
+    for (auto & slot : traceSlots)
+      traces.push_back(slot.Wait());
+    PrintLatencyReport(classes, responseTimes, traces);
+  }
+
   return 0;
 }
@@ -0,0 +1,77 @@
+#include "testing/testing.hpp"
+
+#include "search/emitter.hpp"
+#include "search/result.hpp"
+
+#include "indexer/feature_decl.hpp"
+#include "indexer/mwm_set.hpp"
+
+#include "geometry/point2d.hpp"
+
+#include "base/string_utils.hpp"
+
+#include "std/cstdint.hpp"
+#include "std/shared_ptr.hpp"
+#include "std/string.hpp"
+#include "std/vector.hpp"
+
+namespace search
+{
+namespace
+{
+// Feature ids of deregistered mwms are invalid.
+class MwmInfoMock : public MwmInfo
+{
+public:
+  MwmInfoMock() { SetStatus(STATUS_REGISTERED); }
+};
+
+Result MakeFeatureResult(MwmSet::MwmId const & mwmId, uint32_t index)
+{
+  string const name = strings::to_string(index);
+  return Result(FeatureID(mwmId, index), m2::PointD(index, index), name, "" /* address */,
+                "" /* type */, 0 /* featureType */, Result::Metadata());
+}
+
+Result MakeSuggest(string const & suggest) { return Result(suggest, suggest); }
+}  // namespace
+
+UNIT_TEST(Emitter_Delta)
+{
+  MwmSet::MwmId const mwmId(make_shared<MwmInfoMock>());
+
+  vector<size_t> deltas;
+  size_t numCalls = 0;
+
+  Emitter emitter;
+  emitter.Init([&numCalls](Results const & /* results */) { ++numCalls; },
+               [&deltas](Results const & /* results */, size_t firstChanged) {
+                 deltas.push_back(firstChanged);
+               });
+
+  TEST(emitter.AddResult(MakeFeatureResult(mwmId, 1)), ());
+  TEST(emitter.AddResult(MakeFeatureResult(mwmId, 2)), ());
+  emitter.Emit();
+
+  // Duplicates are not added, so there are no changes.
+  TEST(!emitter.AddResult(MakeFeatureResult(mwmId, 2)), ());
+  emitter.Emit();
+
+  TEST(emitter.AddResult(MakeFeatureResult(mwmId, 3)), ());
+  emitter.Emit();
+
+  // Suggests are inserted before feature results.
+  TEST(emitter.AddResult(MakeSuggest("a")), ());
+  TEST(emitter.AddResult(MakeFeatureResult(mwmId, 4)), ());
+  TEST(emitter.AddResult(MakeSuggest("b")), ());
+  emitter.Emit();
+  TEST_EQUAL(emitter.GetResults().GetCount(), 6, ());
+  TEST(emitter.GetResults()[1].IsSuggest(), ());
+
+  emitter.AddResultNoChecks(MakeFeatureResult(mwmId, 5));
+  emitter.Finish(false /* cancelled */);
+
+  TEST_EQUAL(deltas, vector<size_t>({0, 2, 0, 6}), ());
+  TEST_EQUAL(numCalls, 5, ());
+}
+}  // namespace search
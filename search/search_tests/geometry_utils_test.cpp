@@ -0,0 +1,59 @@
+#include "testing/testing.hpp"
+
+#include "search/geometry_utils.hpp"
+
+#include "geometry/rect2d.hpp"
+
+#include "base/math.hpp"
+
+#include "std/vector.hpp"
+
+namespace search
+{
+namespace
+{
+double GetArea(m2::RectD const & rect) { return rect.SizeX() * rect.SizeY(); }
+
+void TestSubtraction(m2::RectD const & rect, m2::RectD const & sub, size_t expectedNumParts)
+{
+  vector<m2::RectD> parts;
+  SubtractRect(rect, sub, parts);
+  TEST_EQUAL(parts.size(), expectedNumParts, (rect, sub, parts));
+
+  m2::RectD overlap = sub;
+  double expectedArea = GetArea(rect);
+  if (overlap.Intersect(rect))
+    expectedArea -= GetArea(overlap);
+
+  double area = 0.0;
+  for (size_t i = 0; i < parts.size(); ++i)
+  {
+    TEST(rect.IsRectInside(parts[i]), (rect, parts[i]));
+    area += GetArea(parts[i]);
+    for (size_t j = 0; j < i; ++j)
+    {
+      m2::RectD common = parts[i];
+      TEST(!common.Intersect(parts[j]) || GetArea(common) == 0.0, (parts[i], parts[j]));
+    }
+  }
+  TEST(my::AlmostEqualAbs(area, expectedArea, 1e-9), (area, expectedArea));
+}
+}  // namespace
+
+UNIT_TEST(SubtractRect_Smoke)
+{
+  m2::RectD const rect(0.0, 0.0, 10.0, 10.0);
+
+  // Panning to the right and up.
+  TestSubtraction(rect, m2::RectD(-2.0, 0.0, 8.0, 10.0), 1 /* expectedNumParts */);
+  TestSubtraction(rect, m2::RectD(-2.0, -3.0, 8.0, 7.0), 2 /* expectedNumParts */);
+
+  // Zoom in and out.
+  TestSubtraction(rect, m2::RectD(-1.0, -1.0, 11.0, 11.0), 0 /* expectedNumParts */);
+  TestSubtraction(rect, rect, 0 /* expectedNumParts */);
+  TestSubtraction(rect, m2::RectD(2.0, 2.0, 8.0, 8.0), 4 /* expectedNumParts */);
+
+  // No overlap.
+  TestSubtraction(rect, m2::RectD(20.0, 20.0, 30.0, 30.0), 1 /* expectedNumParts */);
+}
+}  // namespace search
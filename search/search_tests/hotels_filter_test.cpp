@@ -32,4 +32,30 @@ UNIT_TEST(HotelsFilter_Identity)
     TEST(!first->IdenticalTo(*second), (*first, *second));
   }
 }
+
+UNIT_TEST(HotelsFilter_BulkMatches)
+{
+  vector<Description> ds(4);
+  ds[0].m_rating = 9.0;
+  ds[0].m_priceRate = 1;
+  ds[1].m_rating = 7.0;
+  ds[1].m_priceRate = 4;
+  ds[1].m_stars = 4;
+  ds[2].m_rating = 8.5;
+  ds[2].m_priceRate = 3;
+  ds[2].m_stars = 3;
+  ds[3].m_types = 1U << static_cast<unsigned>(ftypes::IsHotelChecker::Type::Hotel);
+
+  auto const rules = {And(Or(Ge<Rating>(8.5), Lt<PriceRate>(2)), Gt<PriceRate>(0)),
+                      Or(Lt<Rating>(8.0), Eq<Stars>(3)), And(nullptr, Le<Stars>(3)),
+                      Or(Is(ftypes::IsHotelChecker::Type::Hotel), nullptr)};
+  for (auto const & rule : rules)
+  {
+    vector<bool> matches;
+    rule->Matches(ds, matches);
+    TEST_EQUAL(matches.size(), ds.size(), ());
+    for (size_t i = 0; i < ds.size(); ++i)
+      TEST_EQUAL(matches[i], rule->Matches(ds[i]), (*rule, i));
+  }
+}
 }  // namespace
@@ -0,0 +1,72 @@
+#include "testing/testing.hpp"
+
+#include "search/hotels_filter.hpp"
+#include "search/hotels_table.hpp"
+
+#include "coding/reader.hpp"
+#include "coding/writer.hpp"
+
+#include "base/math.hpp"
+
+#include "std/cstdint.hpp"
+#include "std/vector.hpp"
+
+namespace search
+{
+namespace
+{
+hotels_filter::Description MakeDescription(float rating, int priceRate, int stars, unsigned types)
+{
+  hotels_filter::Description description;
+  description.m_rating = rating;
+  description.m_priceRate = priceRate;
+  description.m_stars = stars;
+  description.m_types = types;
+  return description;
+}
+}  // namespace
+
+UNIT_TEST(HotelsTable_Smoke)
+{
+  vector<uint8_t> buffer;
+  {
+    HotelsTableBuilder builder;
+    builder.Put(10, MakeDescription(8.7f, 3, 4, 1));
+    builder.Put(3, MakeDescription(9.25f, 5, 5, 6));
+    builder.Put(7, MakeDescription(0.0f, 0, 0, 0));
+
+    MemWriter<vector<uint8_t>> writer(buffer);
+    builder.Freeze(writer);
+  }
+
+  MemReader reader(buffer.data(), buffer.size());
+  auto const table = HotelsTable::Load(reader);
+  TEST(table, ());
+  TEST_EQUAL(table->GetSize(), 3, ());
+
+  TEST_EQUAL(table->Find(1), table->GetSize(), ());
+  TEST_EQUAL(table->Find(8), table->GetSize(), ());
+  TEST_EQUAL(table->Find(100), table->GetSize(), ());
+
+  auto const i = table->Find(3);
+  TEST_EQUAL(i, 0, ());
+  TEST_EQUAL(table->GetFeatureId(i), 3, ());
+  auto const d = table->GetDescription(i);
+  TEST(my::AlmostEqualAbs(d.m_rating, 9.25f, 1e-6f), (d.m_rating));
+  TEST_EQUAL(d.m_priceRate, 5, ());
+  TEST_EQUAL(d.m_stars, 5, ());
+  TEST_EQUAL(d.m_types, 6, ());
+
+  auto const j = table->Find(10);
+  TEST_EQUAL(j, 2, ());
+  TEST(my::AlmostEqualAbs(table->GetDescription(j).m_rating, 8.7f, 1e-6f), ());
+  TEST_EQUAL(table->GetDescription(j).m_types, 1, ());
+}
+
+UNIT_TEST(HotelsTable_BadVersion)
+{
+  vector<uint8_t> const buffer = {HotelsTable::kLatestVersion + 1, 0};
+  MemReader reader(buffer.data(), buffer.size());
+  TEST(!HotelsTable::Load(reader), ());
+}
+}  // namespace search
@@ -0,0 +1,87 @@
+#include "testing/testing.hpp"
+
+#include "search/house_numbers_index.hpp"
+#include "search/house_numbers_matcher.hpp"
+
+#include "coding/reader.hpp"
+#include "coding/writer.hpp"
+
+#include "base/string_utils.hpp"
+
+#include "std/cstdint.hpp"
+#include "std/limits.hpp"
+#include "std/string.hpp"
+#include "std/vector.hpp"
+
+namespace search
+{
+namespace
+{
+bool GetQueryKey(string const & query, uint32_t & key)
+{
+  vector<house_numbers::Token> parse;
+  house_numbers::ParseQuery(strings::MakeUniString(query), false /* queryIsPrefix */, parse);
+  return GetHouseNumberKey(parse, key);
+}
+
+vector<uint32_t> GetHouses(HouseNumbersIndex const & index, uint32_t streetId, uint32_t fromKey,
+                           uint32_t toKey)
+{
+  vector<uint32_t> houses;
+  index.ForEachHouseInRange(streetId, fromKey, toKey,
+                            [&houses](uint32_t houseId) { houses.push_back(houseId); });
+  return houses;
+}
+}  // namespace
+
+UNIT_TEST(HouseNumbersIndex_Key)
+{
+  uint32_t key = 0;
+  TEST(GetQueryKey("12", key), ());
+  TEST_EQUAL(key, 12, ());
+  TEST(GetQueryKey("12a", key), ());
+  TEST_EQUAL(key, 12, ());
+  TEST(GetQueryKey("дом 7 корпус 2", key), ());
+  TEST_EQUAL(key, 7, ());
+  TEST(GetQueryKey("123456789012345", key), ());
+  TEST_EQUAL(key, numeric_limits<uint32_t>::max(), ());
+  TEST(!GetQueryKey("", key), ());
+  TEST(!GetQueryKey("a", key), ());
+}
+
+UNIT_TEST(HouseNumbersIndex_Smoke)
+{
+  vector<uint8_t> buffer;
+  {
+    HouseNumbersIndexBuilder builder;
+    builder.Put(100 /* streetId */, 12 /* key */, 5 /* houseId */);
+    builder.Put(100, 10, 3);
+    builder.Put(100, 12, 4);
+    builder.Put(100, 14, 9);
+    builder.Put(7, 12, 1);
+    builder.Put(7, 12, 1);
+    builder.Put(250, 1000000, 2);
+
+    MemWriter<vector<uint8_t>> writer(buffer);
+    builder.Freeze(writer);
+  }
+
+  MemReader reader(buffer.data(), buffer.size());
+  auto const index = HouseNumbersIndex::Load(reader);
+  TEST(index, ());
+  TEST_EQUAL(index->GetNumStreets(), 3, ());
+  TEST_EQUAL(index->GetNumHouses(), 6, ());
+
+  vector<uint32_t> houses;
+  index->ForEachHouse(100, 12, [&houses](uint32_t houseId) { houses.push_back(houseId); });
+  TEST_EQUAL(houses, vector<uint32_t>({4, 5}), ());
+
+  TEST_EQUAL(GetHouses(*index, 100, 11, 14), vector<uint32_t>({4, 5, 9}), ());
+  TEST_EQUAL(GetHouses(*index, 100, 0, 10), vector<uint32_t>({3}), ());
+  TEST_EQUAL(GetHouses(*index, 100, 15, 100), vector<uint32_t>(), ());
+  TEST_EQUAL(GetHouses(*index, 100, 14, 11), vector<uint32_t>(), ());
+  TEST_EQUAL(GetHouses(*index, 7, 12, 12), vector<uint32_t>({1}), ());
+  TEST_EQUAL(GetHouses(*index, 250, 1000000, 1000000), vector<uint32_t>({2}), ());
+  TEST_EQUAL(GetHouses(*index, 8, 0, numeric_limits<uint32_t>::max()), vector<uint32_t>(), ());
+}
+}  // namespace search
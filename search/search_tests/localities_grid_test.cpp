@@ -0,0 +1,66 @@
+#include "testing/testing.hpp"
+
+#include "search/localities_grid.hpp"
+
+#include "coding/reader.hpp"
+#include "coding/writer.hpp"
+
+#include "geometry/mercator.hpp"
+#include "geometry/point2d.hpp"
+
+#include "std/cstdint.hpp"
+#include "std/vector.hpp"
+
+namespace search
+{
+namespace
+{
+vector<uint32_t> GetIds(LocalitiesGrid const & grid, m2::PointD const & p)
+{
+  vector<uint32_t> ids;
+  grid.ForEachInCell(grid.GetCellId(p), [&ids](uint32_t id) { ids.push_back(id); });
+  return ids;
+}
+}  // namespace
+
+UNIT_TEST(LocalitiesGrid_Smoke)
+{
+  uint32_t const kRadiusMeters = 2000;
+
+  auto const moscow = MercatorBounds::FromLatLon(55.7522, 37.6156);
+  auto const nearMoscow = MercatorBounds::FromLatLon(55.7600, 37.6300);
+  auto const spb = MercatorBounds::FromLatLon(59.9386, 30.3141);
+
+  vector<uint8_t> buffer;
+  {
+    LocalitiesGridBuilder builder(kRadiusMeters);
+    builder.Put(10, moscow);
+    builder.Put(3, nearMoscow);
+    builder.Put(7, spb);
+
+    MemWriter<vector<uint8_t>> writer(buffer);
+    builder.Freeze(writer);
+  }
+
+  MemReader reader(buffer.data(), buffer.size());
+  auto const grid = LocalitiesGrid::Load(reader);
+  TEST(grid, ());
+  TEST_EQUAL(grid->GetRadiusMeters(), kRadiusMeters, ());
+
+  TEST_EQUAL(GetIds(*grid, moscow), vector<uint32_t>({3, 10}), ());
+  TEST_EQUAL(GetIds(*grid, spb), vector<uint32_t>({7}), ());
+
+  // A point at a half of the radius from Saint Petersburg.
+  auto const nearSpb = MercatorBounds::FromLatLon(59.9386, 30.3141 + 0.018);
+  TEST_EQUAL(GetIds(*grid, nearSpb), vector<uint32_t>({7}), ());
+
+  TEST(GetIds(*grid, MercatorBounds::FromLatLon(0.0, 0.0)).empty(), ());
+}
+
+UNIT_TEST(LocalitiesGrid_UnknownVersion)
+{
+  vector<uint8_t> buffer = {LocalitiesGrid::kLatestVersion + 1, 0, 0, 0, 0, 0, 0};
+  MemReader reader(buffer.data(), buffer.size());
+  TEST(!LocalitiesGrid::Load(reader), ());
+}
+}  // namespace search
@@ -0,0 +1,50 @@
+#include "testing/testing.hpp"
+
+#include "search/query_trace.hpp"
+
+#include "std/chrono.hpp"
+#include "std/thread.hpp"
+
+namespace search
+{
+namespace
+{
+void Sleep(QueryTrace * trace, QueryTrace::Stage stage)
+{
+  QueryTrace::Scope scope(trace, stage);
+  this_thread::sleep_for(milliseconds(10));
+}
+}  // namespace
+
+UNIT_TEST(QueryTrace_Smoke)
+{
+  QueryTrace trace;
+  trace.Start();
+  {
+    QueryTrace::Scope scope(&trace, QueryTrace::STAGE_PATH_FINDER);
+    Sleep(&trace, QueryTrace::STAGE_PRE_RANKER_FILTER);
+    Sleep(&trace, QueryTrace::STAGE_PRE_RANKER_FILTER);
+  }
+  Sleep(nullptr /* trace */, QueryTrace::STAGE_STREETS);
+  trace.Finish();
+
+  auto const & filter = trace.GetStage(QueryTrace::STAGE_PRE_RANKER_FILTER);
+  TEST_EQUAL(filter.m_count, 2, ());
+  TEST_GREATER_OR_EQUAL(filter.m_seconds, 0.02, ());
+
+  // Time spent in the nested stages isn't charged to the outer one.
+  auto const & finder = trace.GetStage(QueryTrace::STAGE_PATH_FINDER);
+  TEST_EQUAL(finder.m_count, 1, ());
+  TEST_LESS(finder.m_seconds, filter.m_seconds, ());
+
+  auto const & streets = trace.GetStage(QueryTrace::STAGE_STREETS);
+  TEST_EQUAL(streets.m_count, 0, ());
+  TEST_EQUAL(streets.m_seconds, 0.0, ());
+
+  TEST_GREATER_OR_EQUAL(trace.GetTotalSeconds(), 0.03, ());
+  TEST_GREATER_OR_EQUAL(trace.GetUntrackedSeconds(), 0.01 - 1e-3, ());
+
+  trace.Start();
+  TEST_EQUAL(trace.GetStage(QueryTrace::STAGE_PRE_RANKER_FILTER).m_count, 0, ());
+}
+}  // namespace search
@@ -0,0 +1,117 @@
+#include "testing/testing.hpp"
+
+#include "search/result.hpp"
+#include "search/results_cache.hpp"
+#include "search/search_params.hpp"
+
+#include "geometry/rect2d.hpp"
+
+#include "std/string.hpp"
+
+namespace search
+{
+namespace
+{
+m2::RectD const kViewport(10.0, 10.0, 12.0, 12.0);
+
+SearchParams MakeParams(string const & query)
+{
+  SearchParams params;
+  params.m_query = query;
+  params.m_inputLocale = "en";
+  params.m_mode = Mode::Everywhere;
+  return params;
+}
+
+ResultsCache::Key MakeKey(SearchParams const & params, m2::RectD const & viewport = kViewport)
+{
+  ResultsCache::Key key;
+  TEST(ResultsCache::MakeKey(params, viewport, 0 /* preferredLocale */, key), ());
+  return key;
+}
+
+Results MakeResults(string const & str)
+{
+  Results results;
+  results.AddResultNoChecks(Result(str, str /* suggest */));
+  results.SetEndMarker(false /* cancelled */);
+  return results;
+}
+
+bool Equal(ResultsCache::Key const & lhs, ResultsCache::Key const & rhs)
+{
+  return !(lhs < rhs) && !(rhs < lhs);
+}
+}  // namespace
+
+UNIT_TEST(ResultsCache_Key)
+{
+  auto const key = MakeKey(MakeParams("Cafe  Pushkin"));
+  TEST(Equal(key, MakeKey(MakeParams("cafe pushkin"))), ());
+  TEST(Equal(key, MakeKey(MakeParams("cafe pushkin"), m2::RectD(10.01, 10.01, 12.01, 12.01))),
+       ());
+
+  TEST(!Equal(key, MakeKey(MakeParams("cafe pushkin "))), ());
+  TEST(!Equal(key, MakeKey(MakeParams("#cafe pushkin"))), ());
+  TEST(!Equal(key, MakeKey(MakeParams("cafe pushkin"), m2::RectD(20.0, 20.0, 22.0, 22.0))), ());
+  TEST(!Equal(key, MakeKey(MakeParams("cafe pushkin"), m2::RectD(10.0, 10.0, 30.0, 30.0))), ());
+
+  auto params = MakeParams("cafe pushkin");
+  params.m_inputLocale = "ru";
+  TEST(!Equal(key, MakeKey(params)), ());
+
+  params = MakeParams("cafe pushkin");
+  params.SetPosition(55.75, 37.61);
+  auto const positionKey = MakeKey(params);
+  TEST(!Equal(key, positionKey), ());
+  params.SetPosition(55.7501, 37.6101);
+  TEST(Equal(positionKey, MakeKey(params)), ());
+
+  ResultsCache::Key unused;
+  params = MakeParams("cafe pushkin");
+  params.m_mode = Mode::Viewport;
+  TEST(!ResultsCache::MakeKey(params, kViewport, 0 /* preferredLocale */, unused), ());
+  TEST(!ResultsCache::MakeKey(MakeParams("55.75 37.61"), kViewport, 0 /* preferredLocale */,
+                              unused),
+       ());
+}
+
+UNIT_TEST(ResultsCache_Lru)
+{
+  ResultsCache cache(2 /* maxSize */);
+  auto const generation = cache.GetGeneration();
+
+  auto const keyA = MakeKey(MakeParams("a"));
+  auto const keyB = MakeKey(MakeParams("b"));
+  auto const keyC = MakeKey(MakeParams("c"));
+
+  Results results;
+  TEST(!cache.Get(keyA, results), ());
+
+  cache.Put(keyA, MakeResults("a"), generation);
+  cache.Put(keyB, MakeResults("b"), generation);
+  TEST(cache.Get(keyA, results), ());
+  TEST_EQUAL(results.GetCount(), 1, ());
+  TEST_EQUAL(results[0].GetString(), "a", ());
+  TEST(results.IsEndedNormal(), ());
+
+  // |keyB| is the least recently used one.
+  cache.Put(keyC, MakeResults("c"), generation);
+  TEST_EQUAL(cache.GetSize(), 2, ());
+  TEST(!cache.Get(keyB, results), ());
+  TEST(cache.Get(keyA, results), ());
+  TEST(cache.Get(keyC, results), ());
+
+  auto const stats = cache.GetStats();
+  TEST_EQUAL(stats.m_hits, 3, ());
+  TEST_EQUAL(stats.m_misses, 2, ());
+
+  // Results of the queries started before Clear() are dropped.
+  cache.Clear();
+  TEST_EQUAL(cache.GetSize(), 0, ());
+  cache.Put(keyA, MakeResults("a"), generation);
+  TEST(!cache.Get(keyA, results), ());
+  cache.Put(keyA, MakeResults("a"), cache.GetGeneration());
+  TEST(cache.Get(keyA, results), ());
+}
+}  // namespace search
@@ -25,22 +25,32 @@ win32*|linux* {
 SOURCES += \
     ../../testing/testingmain.cpp \
     algos_tests.cpp \
+    emitter_test.cpp \
+    geometry_utils_test.cpp \
     hotels_filter_test.cpp \
+    hotels_table_test.cpp \
     house_detector_tests.cpp \
+    house_numbers_index_test.cpp \
     house_numbers_matcher_test.cpp \
     interval_set_test.cpp \
     keyword_lang_matcher_test.cpp \
     keyword_matcher_test.cpp \
     latlon_match_test.cpp \
+    localities_grid_test.cpp \
     locality_finder_test.cpp \
     locality_scorer_test.cpp \
     locality_selector_test.cpp \
     point_rect_matcher_tests.cpp \
     query_saver_tests.cpp \
+    query_trace_test.cpp \
     ranking_tests.cpp \
+    results_cache_test.cpp \
     segment_tree_tests.cpp \
     string_intersection_test.cpp \
+    street_vicinity_cache_test.cpp \
     string_match_test.cpp \
+    token_features_cache_test.cpp \
+    types_index_test.cpp \
 
 HEADERS += \
     match_cost_mock.hpp \
@@ -0,0 +1,127 @@
+#include "testing/testing.hpp"
+
+#include "search/projection_on_street.hpp"
+#include "search/street_vicinity_cache.hpp"
+
+#include "indexer/mwm_set.hpp"
+
+#include "platform/country_file.hpp"
+#include "platform/local_country_file.hpp"
+
+#include "geometry/point2d.hpp"
+
+#include "std/shared_ptr.hpp"
+#include "std/unique_ptr.hpp"
+#include "std/string.hpp"
+#include "std/vector.hpp"
+
+namespace search
+{
+namespace
+{
+class TestMwmInfo : public MwmInfo
+{
+public:
+  explicit TestMwmInfo(string const & countryName)
+  {
+    m_file = platform::LocalCountryFile("/tmp" /* directory */, platform::CountryFile(countryName),
+                                        0 /* version */);
+  }
+};
+
+MwmSet::MwmId MakeMwmId(string const & countryName)
+{
+  return MwmSet::MwmId(make_shared<TestMwmInfo>(countryName));
+}
+
+shared_ptr<StreetVicinityCache::Street const> MakeStreet(size_t numFeatures)
+{
+  auto street = make_shared<StreetVicinityCache::Street>();
+  street->m_features.resize(numFeatures);
+  vector<m2::PointD> const points = {m2::PointD(0.0, 0.0), m2::PointD(1.0, 1.0)};
+  street->m_rect = m2::RectD(points[0], points[1]);
+  street->m_calculator = make_unique<ProjectionOnStreetCalculator>(points);
+  return street;
+}
+}  // namespace
+
+UNIT_TEST(StreetVicinityCache_Smoke)
+{
+  auto const mwmId = MakeMwmId("Foo");
+  auto const street = MakeStreet(10 /* numFeatures */);
+
+  StreetVicinityCache cache(1024 * 1024 /* maxMemorySize */);
+  StreetVicinityCache::Key const key(mwmId, 1 /* featureId */, 17 /* scale */);
+  TEST(!cache.Get(key), ());
+
+  cache.Put(key, street, cache.GetGeneration());
+  TEST_EQUAL(cache.Get(key), street, ());
+  TEST(!cache.Get(StreetVicinityCache::Key(mwmId, 1 /* featureId */, 16 /* scale */)), ());
+  TEST(!cache.Get(StreetVicinityCache::Key(mwmId, 2 /* featureId */, 17 /* scale */)), ());
+  TEST(!cache.Get(StreetVicinityCache::Key(MakeMwmId("Foo"), 1 /* featureId */, 17 /* scale */)),
+       ());
+
+  auto const stats = cache.GetStats();
+  TEST_EQUAL(stats.m_hits, 1, ());
+  TEST_EQUAL(stats.m_misses, 4, ());
+
+  // Streets loaded before Clear() are ignored.
+  auto const generation = cache.GetGeneration();
+  cache.Clear();
+  TEST_EQUAL(cache.GetSize(), 0, ());
+  TEST_EQUAL(cache.GetMemorySize(), 0, ());
+  cache.Put(key, street, generation);
+  TEST(!cache.Get(key), ());
+}
+
+UNIT_TEST(StreetVicinityCache_MemoryLimit)
+{
+  auto const mwmId = MakeMwmId("Foo");
+  auto const street = MakeStreet(1000 /* numFeatures */);
+  size_t const streetSize = street->GetMemorySize();
+
+  // Three streets and the entries overhead fit the limit, four don't.
+  StreetVicinityCache cache(3 * streetSize + 3 * 1024);
+  for (uint32_t i = 0; i < 3; ++i)
+    cache.Put(StreetVicinityCache::Key(mwmId, i, 17 /* scale */), street, cache.GetGeneration());
+  TEST_EQUAL(cache.GetSize(), 3, ());
+  TEST_LESS_OR_EQUAL(cache.GetMemorySize(), 3 * streetSize + 3 * 1024, ());
+
+  // Street 0 becomes the most recently used one, so street 1 is evicted.
+  TEST(cache.Get(StreetVicinityCache::Key(mwmId, 0, 17 /* scale */)), ());
+  cache.Put(StreetVicinityCache::Key(mwmId, 3, 17 /* scale */), street, cache.GetGeneration());
+  TEST_EQUAL(cache.GetSize(), 3, ());
+  TEST(cache.Get(StreetVicinityCache::Key(mwmId, 0, 17 /* scale */)), ());
+  TEST(!cache.Get(StreetVicinityCache::Key(mwmId, 1, 17 /* scale */)), ());
+  TEST(cache.Get(StreetVicinityCache::Key(mwmId, 2, 17 /* scale */)), ());
+  TEST(cache.Get(StreetVicinityCache::Key(mwmId, 3, 17 /* scale */)), ());
+
+  // A street larger than the whole cache isn't kept.
+  cache.Put(StreetVicinityCache::Key(mwmId, 4, 17 /* scale */), MakeStreet(10000 /* numFeatures */),
+            cache.GetGeneration());
+  TEST(!cache.Get(StreetVicinityCache::Key(mwmId, 4, 17 /* scale */)), ());
+  TEST_EQUAL(cache.GetSize(), 3, ());
+}
+
+UNIT_TEST(StreetVicinityCache_Deregistration)
+{
+  auto const foo = MakeMwmId("Foo");
+  auto const bar = MakeMwmId("Bar");
+  auto const street = MakeStreet(10 /* numFeatures */);
+
+  StreetVicinityCache cache(1024 * 1024 /* maxMemorySize */);
+  cache.Put(StreetVicinityCache::Key(foo, 1, 17 /* scale */), street, cache.GetGeneration());
+  cache.Put(StreetVicinityCache::Key(foo, 2, 17 /* scale */), street, cache.GetGeneration());
+  cache.Put(StreetVicinityCache::Key(bar, 1, 17 /* scale */), street, cache.GetGeneration());
+  TEST_EQUAL(cache.GetSize(), 3, ());
+
+  cache.OnMapDeregistered(foo.GetInfo()->GetLocalFile());
+  TEST_EQUAL(cache.GetSize(), 1, ());
+  TEST(!cache.Get(StreetVicinityCache::Key(foo, 1, 17 /* scale */)), ());
+  TEST(cache.Get(StreetVicinityCache::Key(bar, 1, 17 /* scale */)), ());
+
+  cache.OnMapUpdated(bar.GetInfo()->GetLocalFile() /* newFile */, bar.GetInfo()->GetLocalFile());
+  TEST_EQUAL(cache.GetSize(), 0, ());
+  TEST_EQUAL(cache.GetMemorySize(), 0, ());
+}
+}  // namespace search
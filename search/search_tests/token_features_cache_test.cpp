@@ -0,0 +1,91 @@
+#include "testing/testing.hpp"
+
+#include "search/cbv.hpp"
+#include "search/query_params.hpp"
+#include "search/token_features_cache.hpp"
+
+#include "indexer/mwm_set.hpp"
+
+#include "coding/compressed_bit_vector.hpp"
+
+#include "base/string_utils.hpp"
+
+#include "std/cstdint.hpp"
+#include "std/shared_ptr.hpp"
+#include "std/vector.hpp"
+
+namespace search
+{
+namespace
+{
+CBV MakeCBV(vector<uint64_t> const & setBits)
+{
+  return CBV(coding::CompressedBitVectorBuilder::FromBitPositions(setBits));
+}
+
+QueryParams MakeParams(string const & query, bool lastTokenIsPrefix)
+{
+  vector<strings::UniString> tokens;
+  strings::Tokenize(query, " ", [&tokens](string const & token) {
+    tokens.push_back(strings::MakeUniString(token));
+  });
+
+  QueryParams params;
+  if (lastTokenIsPrefix && !tokens.empty())
+  {
+    auto const prefix = tokens.back();
+    tokens.pop_back();
+    params.InitWithPrefix(tokens.begin(), tokens.end(), prefix);
+  }
+  else
+  {
+    params.InitNoPrefix(tokens.begin(), tokens.end());
+  }
+  return params;
+}
+}  // namespace
+
+UNIT_TEST(TokenFeaturesCache_Smoke)
+{
+  MwmSet::MwmId const mwm1(make_shared<MwmInfo>());
+  MwmSet::MwmId const mwm2(make_shared<MwmInfo>());
+
+  // "moscow" is a complete token in both queries.
+  auto const params1 = MakeParams("moscow s", true /* lastTokenIsPrefix */);
+  auto const params2 = MakeParams("moscow st", true /* lastTokenIsPrefix */);
+  TokenFeaturesCache::TokenKey const moscow1(params1, 0);
+  TokenFeaturesCache::TokenKey const moscow2(params2, 0);
+  TEST(!(moscow1 < moscow2) && !(moscow2 < moscow1), ());
+  TEST(TokenFeaturesCache::TokenKey(params1, 1) < TokenFeaturesCache::TokenKey(params2, 1) ||
+           TokenFeaturesCache::TokenKey(params2, 1) < TokenFeaturesCache::TokenKey(params1, 1),
+       ());
+
+  // A complete token differs from the prefix one.
+  auto const params3 = MakeParams("moscow", true /* lastTokenIsPrefix */);
+  TokenFeaturesCache::TokenKey const moscowPrefix(params3, 0);
+  TEST(moscow1 < moscowPrefix || moscowPrefix < moscow1, ());
+
+  TokenFeaturesCache cache;
+  cache.StartQuery();
+
+  CBV features;
+  TEST(!cache.Get(mwm1, moscow1, features), ());
+  cache.Put(mwm1, moscow1, MakeCBV({1, 5, 10}));
+  TEST(cache.Get(mwm1, moscow2, features), ());
+  TEST_EQUAL(features.PopCount(), 3, ());
+  TEST(features.HasBit(5), ());
+  TEST(!cache.Get(mwm2, moscow1, features), ());
+
+  // An entry survives kNumQueriesToKeep queries which don't use it.
+  for (uint32_t i = 0; i < TokenFeaturesCache::kNumQueriesToKeep; ++i)
+    cache.StartQuery();
+  TEST(cache.Get(mwm1, moscow1, features), ());
+  for (uint32_t i = 0; i <= TokenFeaturesCache::kNumQueriesToKeep; ++i)
+    cache.StartQuery();
+  TEST(!cache.Get(mwm1, moscow1, features), ());
+
+  cache.Put(mwm1, moscow1, MakeCBV({1}));
+  cache.Clear();
+  TEST(!cache.Get(mwm1, moscow1, features), ());
+}
+}  // namespace search
@@ -0,0 +1,76 @@
+#include "testing/testing.hpp"
+
+#include "search/types_index.hpp"
+
+#include "coding/compressed_bit_vector.hpp"
+#include "coding/reader.hpp"
+#include "coding/writer.hpp"
+
+#include "std/cstdint.hpp"
+#include "std/vector.hpp"
+
+namespace search
+{
+namespace
+{
+vector<uint64_t> GetFeatures(TypesIndex const & index, uint32_t type)
+{
+  vector<uint64_t> features;
+  auto const cbv = index.GetFeatures(type);
+  if (cbv)
+  {
+    coding::CompressedBitVectorEnumerator::ForEach(
+        *cbv, [&features](uint64_t featureId) { features.push_back(featureId); });
+  }
+  return features;
+}
+}  // namespace
+
+UNIT_TEST(TypesIndex_Smoke)
+{
+  vector<uint8_t> buffer;
+  {
+    TypesIndexBuilder builder;
+    builder.Put(7 /* type */, 10 /* featureId */);
+    builder.Put(3 /* type */, 5 /* featureId */);
+    builder.Put(7 /* type */, 2 /* featureId */);
+    builder.Put(7 /* type */, 10 /* featureId */);
+    builder.Put(100 /* type */, 100000 /* featureId */);
+
+    MemWriter<vector<uint8_t>> writer(buffer);
+    builder.Freeze(writer);
+  }
+
+  MemReader reader(buffer.data(), buffer.size());
+  auto const index = TypesIndex::Load(reader);
+  TEST(index, ());
+  TEST_EQUAL(index->GetNumTypes(), 3, ());
+
+  TEST(index->HasType(3), ());
+  TEST(index->HasType(7), ());
+  TEST(index->HasType(100), ());
+  TEST(!index->HasType(0), ());
+  TEST(!index->HasType(50), ());
+
+  TEST_EQUAL(GetFeatures(*index, 3), vector<uint64_t>({5}), ());
+  TEST_EQUAL(GetFeatures(*index, 7), vector<uint64_t>({2, 10}), ());
+  TEST_EQUAL(GetFeatures(*index, 100), vector<uint64_t>({100000}), ());
+  TEST(!index->GetFeatures(50), ());
+}
+
+UNIT_TEST(TypesIndex_Empty)
+{
+  vector<uint8_t> buffer;
+  {
+    TypesIndexBuilder builder;
+    MemWriter<vector<uint8_t>> writer(buffer);
+    builder.Freeze(writer);
+  }
+
+  MemReader reader(buffer.data(), buffer.size());
+  auto const index = TypesIndex::Load(reader);
+  TEST(index, ());
+  TEST_EQUAL(index->GetNumTypes(), 0, ());
+  TEST(!index->GetFeatures(0), ());
+}
+}  // namespace search
@@ -31,6 +31,13 @@ public:
   // Initiates the search and waits for it to finish.
   void Run();
 
+  // Initiates the search. Many requests may be started before waiting
+  // for any of them, so they run concurrently on the engine threads.
+  void Start();
+
+  // Waits for the search to finish.
+  void Wait();
+
   // Call these functions only after call to Wait().
   steady_clock::duration ResponseTime() const;
   vector<search::Result> const & Results() const;
@@ -40,12 +47,6 @@ protected:
                     Mode mode, m2::RectD const & viewport, SearchParams::TOnStarted onStarted,
                     SearchParams::TOnResults onResults);
 
-  // Initiates the search.
-  void Start();
-
-  // Waits for the search to finish.
-  void Wait();
-
   void SetUpCallbacks();
 
   void OnStarted();
@@ -0,0 +1,135 @@
+#include "search/street_vicinity_cache.hpp"
+
+#include "platform/local_country_file.hpp"
+
+#include "base/assert.hpp"
+
+namespace search
+{
+namespace
+{
+// Approximate overhead of an entry in the list and in the index.
+size_t constexpr kEntryOverhead = 128;
+}  // namespace
+
+// StreetVicinityCache::Key ------------------------------------------------------------------------
+bool StreetVicinityCache::Key::operator<(Key const & rhs) const
+{
+  if (m_mwmId != rhs.m_mwmId)
+    return m_mwmId < rhs.m_mwmId;
+  if (m_featureId != rhs.m_featureId)
+    return m_featureId < rhs.m_featureId;
+  return m_scale < rhs.m_scale;
+}
+
+// StreetVicinityCache -----------------------------------------------------------------------------
+StreetVicinityCache::StreetVicinityCache(size_t maxMemorySize) : m_maxMemorySize(maxMemorySize)
+{
+  CHECK_GREATER(m_maxMemorySize, 0, ());
+}
+
+shared_ptr<StreetVicinityCache::Street const> StreetVicinityCache::Get(Key const & key)
+{
+  lock_guard<mutex> lock(m_mu);
+  auto const it = m_index.find(key);
+  if (it == m_index.end())
+  {
+    ++m_stats.m_misses;
+    return shared_ptr<Street const>();
+  }
+
+  ++m_stats.m_hits;
+  m_entries.splice(m_entries.begin(), m_entries, it->second);
+  return it->second->m_street;
+}
+
+void StreetVicinityCache::Put(Key const & key, shared_ptr<Street const> street,
+                              uint64_t generation)
+{
+  ASSERT(street, ());
+  size_t const memorySize = street->GetMemorySize() + kEntryOverhead;
+
+  lock_guard<mutex> lock(m_mu);
+  if (generation != m_generation || memorySize > m_maxMemorySize)
+    return;
+
+  auto const it = m_index.find(key);
+  if (it != m_index.end())
+    Erase(it->second);
+
+  while (m_memorySize + memorySize > m_maxMemorySize)
+  {
+    ASSERT(!m_entries.empty(), ());
+    Erase(prev(m_entries.end()));
+  }
+
+  m_entries.push_front({key, move(street), memorySize});
+  m_index.emplace(key, m_entries.begin());
+  m_memorySize += memorySize;
+}
+
+void StreetVicinityCache::Clear()
+{
+  lock_guard<mutex> lock(m_mu);
+  m_index.clear();
+  m_entries.clear();
+  m_memorySize = 0;
+  ++m_generation;
+}
+
+uint64_t StreetVicinityCache::GetGeneration() const
+{
+  lock_guard<mutex> lock(m_mu);
+  return m_generation;
+}
+
+size_t StreetVicinityCache::GetSize() const
+{
+  lock_guard<mutex> lock(m_mu);
+  return m_entries.size();
+}
+
+size_t StreetVicinityCache::GetMemorySize() const
+{
+  lock_guard<mutex> lock(m_mu);
+  return m_memorySize;
+}
+
+StreetVicinityCache::Stats StreetVicinityCache::GetStats() const
+{
+  lock_guard<mutex> lock(m_mu);
+  return m_stats;
+}
+
+void StreetVicinityCache::OnMapUpdated(platform::LocalCountryFile const & /* newFile */,
+                                       platform::LocalCountryFile const & oldFile)
+{
+  EraseMwm(oldFile);
+}
+
+void StreetVicinityCache::OnMapDeregistered(platform::LocalCountryFile const & localFile)
+{
+  EraseMwm(localFile);
+}
+
+void StreetVicinityCache::Erase(Entries::iterator it)
+{
+  ASSERT_GREATER_OR_EQUAL(m_memorySize, it->m_memorySize, ());
+  m_memorySize -= it->m_memorySize;
+  m_index.erase(it->m_key);
+  m_entries.erase(it);
+}
+
+void StreetVicinityCache::EraseMwm(platform::LocalCountryFile const & localFile)
+{
+  lock_guard<mutex> lock(m_mu);
+  for (auto it = m_entries.begin(); it != m_entries.end();)
+  {
+    auto const & info = it->m_key.m_mwmId.GetInfo();
+    if (!info || info->GetLocalFile() == localFile)
+      Erase(it++);
+    else
+      ++it;
+  }
+}
+}  // namespace search
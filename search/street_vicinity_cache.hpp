@@ -0,0 +1,98 @@
+#pragma once
+
+#include "search/street_vicinity_loader.hpp"
+
+#include "indexer/mwm_set.hpp"
+
+#include "std/cstdint.hpp"
+#include "std/list.hpp"
+#include "std/map.hpp"
+#include "std/mutex.hpp"
+#include "std/shared_ptr.hpp"
+#include "std/utility.hpp"
+
+namespace search
+{
+// LRU cache of loaded street vicinities (see StreetVicinityLoader)
+// which is shared by the query processors and lives across queries,
+// so the address search in the same city doesn't cover the street
+// geometries again for every query. The cache is bounded by the
+// approximate memory of the streets.
+//
+// All loaders sharing a cache must use the same vicinity offset.
+//
+// All methods are thread-safe. Streets of an mwm are dropped when the
+// mwm is updated or deregistered, the owner must clear the cache when
+// features are edited.
+class StreetVicinityCache : public MwmSet::Observer
+{
+public:
+  using Street = StreetVicinityLoader::Street;
+
+  struct Key
+  {
+    Key() = default;
+    Key(MwmSet::MwmId const & mwmId, uint32_t featureId, int scale)
+      : m_mwmId(mwmId), m_featureId(featureId), m_scale(scale)
+    {
+    }
+
+    bool operator<(Key const & rhs) const;
+
+    MwmSet::MwmId m_mwmId;
+    uint32_t m_featureId = 0;
+    int m_scale = 0;
+  };
+
+  struct Stats
+  {
+    uint64_t m_hits = 0;
+    uint64_t m_misses = 0;
+  };
+
+  explicit StreetVicinityCache(size_t maxMemorySize);
+
+  // Returns nullptr when there's no street for |key|.
+  shared_ptr<Street const> Get(Key const & key);
+
+  // Every Clear() call increments the generation. Streets loaded
+  // before the call may be stale, so they're ignored. Streets which
+  // are larger than the whole cache are not kept.
+  void Put(Key const & key, shared_ptr<Street const> street, uint64_t generation);
+
+  void Clear();
+
+  uint64_t GetGeneration() const;
+  size_t GetSize() const;
+  size_t GetMemorySize() const;
+  Stats GetStats() const;
+
+  // MwmSet::Observer overrides:
+  void OnMapUpdated(platform::LocalCountryFile const & newFile,
+                    platform::LocalCountryFile const & oldFile) override;
+  void OnMapDeregistered(platform::LocalCountryFile const & localFile) override;
+
+private:
+  struct Entry
+  {
+    Key m_key;
+    shared_ptr<Street const> m_street;
+    size_t m_memorySize;
+  };
+
+  using Entries = list<Entry>;
+
+  void Erase(Entries::iterator it);
+  void EraseMwm(platform::LocalCountryFile const & localFile);
+
+  size_t const m_maxMemorySize;
+
+  mutable mutex m_mu;
+  // The most recently used entry is the first one.
+  Entries m_entries;
+  map<Key, Entries::iterator> m_index;
+  size_t m_memorySize = 0;
+  uint64_t m_generation = 0;
+  Stats m_stats;
+};
+}  // namespace search
@@ -1,5 +1,7 @@
 #include "search/street_vicinity_loader.hpp"
 
+#include "search/street_vicinity_cache.hpp"
+
 #include "indexer/feature_covering.hpp"
 #include "indexer/feature_decl.hpp"
 #include "indexer/index.hpp"
@@ -13,8 +15,22 @@
 
 namespace search
 {
+// StreetVicinityLoader::Street --------------------------------------------------------------------
+size_t StreetVicinityLoader::Street::GetMemorySize() const
+{
+  size_t size = sizeof(*this) + m_features.capacity() * sizeof(uint32_t);
+  if (m_calculator)
+    size += sizeof(*m_calculator) + m_calculator->GetMemorySize();
+  return size;
+}
+
+// StreetVicinityLoader ----------------------------------------------------------------------------
 StreetVicinityLoader::StreetVicinityLoader(int scale, double offsetMeters)
-  : m_context(nullptr), m_scale(scale), m_offsetMeters(offsetMeters), m_cache("Streets")
+  : m_context(nullptr)
+  , m_sharedCache(nullptr)
+  , m_scale(scale)
+  , m_offsetMeters(offsetMeters)
+  , m_cache("Streets")
 {
 }
 
@@ -29,16 +45,44 @@ void StreetVicinityLoader::SetContext(MwmContext * context)
   m_scale = my::clamp(m_scale, scaleRange.first, scaleRange.second);
 }
 
+void StreetVicinityLoader::SetCache(StreetVicinityCache * cache)
+{
+  if (m_sharedCache == cache)
+    return;
+  m_sharedCache = cache;
+  m_cache.Clear();
+}
+
 void StreetVicinityLoader::OnQueryFinished() { m_cache.ClearIfNeeded(); }
 
 StreetVicinityLoader::Street const & StreetVicinityLoader::GetStreet(uint32_t featureId)
 {
   auto r = m_cache.Get(featureId);
   if (!r.second)
-    return r.first;
-
-  LoadStreet(featureId, r.first);
-  return r.first;
+    return *r.first;
+
+  auto & street = r.first;
+  if (!m_sharedCache)
+  {
+    auto loaded = make_shared<Street>();
+    LoadStreet(featureId, *loaded);
+    street = move(loaded);
+    return *street;
+  }
+
+  StreetVicinityCache::Key const key(m_context->GetId(), featureId, m_scale);
+  street = m_sharedCache->Get(key);
+  if (street)
+    return *street;
+
+  // The generation is taken before loading, so the street isn't
+  // shared when the cache is cleared in the middle.
+  auto const generation = m_sharedCache->GetGeneration();
+  auto loaded = make_shared<Street>();
+  LoadStreet(featureId, *loaded);
+  street = move(loaded);
+  m_sharedCache->Put(key, street, generation);
+  return *street;
 }
 
 void StreetVicinityLoader::LoadStreet(uint32_t featureId, Street & street)
@@ -11,11 +11,13 @@
 
 #include "base/macros.hpp"
 
+#include "std/shared_ptr.hpp"
 #include "std/unordered_map.hpp"
 
 namespace search
 {
 class MwmContext;
+class StreetVicinityCache;
 
 // This class is able to load features in a street's vicinity.
 //
@@ -30,6 +32,9 @@ public:
 
     inline bool IsEmpty() const { return !m_calculator || m_rect.IsEmptyInterior(); }
 
+    // Returns the approximate number of bytes used by the street.
+    size_t GetMemorySize() const;
+
     vector<uint32_t> m_features;
     m2::RectD m_rect;
     unique_ptr<ProjectionOnStreetCalculator> m_calculator;
@@ -42,6 +47,9 @@ public:
 
   StreetVicinityLoader(int scale, double offsetMeters);
   void SetContext(MwmContext * context);
+  // Streets are looked for in |cache| before loading and are put
+  // there after loading. |cache| may be nullptr.
+  void SetCache(StreetVicinityCache * cache);
 
   // Calls |fn| on each index in |sortedIds| where sortedIds[index]
   // belongs to the street's vicinity.
@@ -84,10 +92,13 @@ private:
   void LoadStreet(uint32_t featureId, Street & street);
 
   MwmContext * m_context;
+  StreetVicinityCache * m_sharedCache;
   int m_scale;
   double const m_offsetMeters;
 
-  Cache<uint32_t, Street> m_cache;
+  // Streets are shared with |m_sharedCache|, so they're kept here
+  // by pointers.
+  Cache<uint32_t, shared_ptr<Street const>> m_cache;
 
   DISALLOW_COPY_AND_MOVE(StreetVicinityLoader);
 };
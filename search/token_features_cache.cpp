@@ -0,0 +1,94 @@
+#include "search/token_features_cache.hpp"
+
+#include "std/tuple.hpp"
+
+namespace search
+{
+// TokenFeaturesCache::TokenKey --------------------------------------------------------------------
+TokenFeaturesCache::TokenKey::TokenKey(QueryParams const & params, size_t i)
+  : m_types(params.GetTypeIndices(i)), m_prefix(params.IsPrefixToken(i))
+{
+  params.GetToken(i).ForEach([this](strings::UniString const & s) { m_names.push_back(s); });
+  for (auto const lang : params.GetLangs())
+    m_langs.push_back(lang);
+}
+
+bool TokenFeaturesCache::TokenKey::operator<(TokenKey const & rhs) const
+{
+  return tie(m_prefix, m_names, m_types, m_langs) <
+         tie(rhs.m_prefix, rhs.m_names, rhs.m_types, rhs.m_langs);
+}
+
+// TokenFeaturesCache ------------------------------------------------------------------------------
+// static
+uint32_t constexpr TokenFeaturesCache::kNumQueriesToKeep;
+// static
+uint64_t constexpr TokenFeaturesCache::kMaxNumFeatures;
+
+bool TokenFeaturesCache::Get(MwmSet::MwmId const & mwmId, TokenKey const & key, CBV & features)
+{
+  lock_guard<mutex> lock(m_mu);
+  auto const it = m_entries.find(key);
+  if (it == m_entries.end())
+    return false;
+
+  auto const jt = it->second.find(mwmId);
+  if (jt == it->second.end())
+    return false;
+
+  jt->second.m_lastQuery = m_query;
+  features = jt->second.m_features;
+  return true;
+}
+
+void TokenFeaturesCache::Put(MwmSet::MwmId const & mwmId, TokenKey const & key,
+                             CBV const & features)
+{
+  uint64_t const numFeatures = features.PopCount();
+
+  lock_guard<mutex> lock(m_mu);
+  if (m_numFeatures + numFeatures > kMaxNumFeatures)
+    return;
+
+  auto & entry = m_entries[key][mwmId];
+  m_numFeatures -= entry.m_features.PopCount();
+  m_numFeatures += numFeatures;
+  entry.m_features = features;
+  entry.m_lastQuery = m_query;
+}
+
+void TokenFeaturesCache::StartQuery()
+{
+  lock_guard<mutex> lock(m_mu);
+  ++m_query;
+
+  for (auto it = m_entries.begin(); it != m_entries.end();)
+  {
+    auto & mwmEntries = it->second;
+    for (auto jt = mwmEntries.begin(); jt != mwmEntries.end();)
+    {
+      if (jt->second.m_lastQuery + kNumQueriesToKeep < m_query)
+      {
+        m_numFeatures -= jt->second.m_features.PopCount();
+        jt = mwmEntries.erase(jt);
+      }
+      else
+      {
+        ++jt;
+      }
+    }
+
+    if (mwmEntries.empty())
+      it = m_entries.erase(it);
+    else
+      ++it;
+  }
+}
+
+void TokenFeaturesCache::Clear()
+{
+  lock_guard<mutex> lock(m_mu);
+  m_entries.clear();
+  m_numFeatures = 0;
+}
+}  // namespace search
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "search/cbv.hpp"
+#include "search/query_params.hpp"
+
+#include "indexer/mwm_set.hpp"
+
+#include "base/string_utils.hpp"
+
+#include "std/cstdint.hpp"
+#include "std/map.hpp"
+#include "std/mutex.hpp"
+#include "std/vector.hpp"
+
+namespace search
+{
+// Cache of features retrieved from search index tries for query
+// tokens. Type-ahead queries repeat most of the tokens of the previous
+// query of a session: "moscow st" follows "moscow s", so the trie is
+// walked for the last token only.
+//
+// Only the entries used by the last kNumQueriesToKeep queries are
+// kept. All methods are thread-safe.
+class TokenFeaturesCache
+{
+public:
+  // Everything a token request is built from.
+  struct TokenKey
+  {
+    TokenKey() = default;
+    TokenKey(QueryParams const & params, size_t i);
+
+    bool operator<(TokenKey const & rhs) const;
+
+    // The original token and its synonyms.
+    vector<strings::UniString> m_names;
+    QueryParams::TypeIndices m_types;
+    vector<uint64_t> m_langs;
+    bool m_prefix = false;
+  };
+
+  // A viewport search alternates with an everywhere search in the
+  // application, so entries survive one more query.
+  static uint32_t constexpr kNumQueriesToKeep = 2;
+
+  // New features are not cached when the total number of cached
+  // features exceeds this limit. A cached feature takes up to 8 bytes.
+  static uint64_t constexpr kMaxNumFeatures = 1 << 20;
+
+  // Returns false if there are no features for |key| in |mwmId|.
+  bool Get(MwmSet::MwmId const & mwmId, TokenKey const & key, CBV & features);
+  void Put(MwmSet::MwmId const & mwmId, TokenKey const & key, CBV const & features);
+
+  // Must be called before every query. Drops the entries which are
+  // not used by the last kNumQueriesToKeep queries.
+  void StartQuery();
+
+  void Clear();
+
+private:
+  struct Entry
+  {
+    CBV m_features;
+    uint64_t m_lastQuery = 0;
+  };
+
+  mutex m_mu;
+  map<TokenKey, map<MwmSet::MwmId, Entry>> m_entries;
+  uint64_t m_numFeatures = 0;
+  uint64_t m_query = 0;
+};
+}  // namespace search
@@ -0,0 +1,150 @@
+#include "search/types_index.hpp"
+
+#include "coding/compressed_bit_vector.hpp"
+#include "coding/file_container.hpp"
+#include "coding/reader.hpp"
+#include "coding/varint.hpp"
+#include "coding/write_to_sink.hpp"
+#include "coding/writer.hpp"
+
+#include "base/assert.hpp"
+#include "base/logging.hpp"
+
+#include "std/algorithm.hpp"
+
+#include "defines.hpp"
+
+namespace search
+{
+// TypesIndex --------------------------------------------------------------------------------------
+// static
+uint8_t constexpr TypesIndex::kLatestVersion;
+
+// static
+unique_ptr<TypesIndex> TypesIndex::Load(FilesContainerR const & cont)
+{
+  if (!cont.IsExist(TYPES_INDEX_FILE_TAG))
+    return unique_ptr<TypesIndex>();
+
+  try
+  {
+    auto reader = cont.GetReader(TYPES_INDEX_FILE_TAG);
+    return Load(*reader.GetPtr());
+  }
+  catch (Reader::Exception const & e)
+  {
+    LOG(LERROR, ("Can't read types index:", e.Msg()));
+  }
+  return unique_ptr<TypesIndex>();
+}
+
+// static
+unique_ptr<TypesIndex> TypesIndex::Load(Reader const & reader)
+{
+  NonOwningReaderSource source(reader);
+
+  auto const version = ReadPrimitiveFromSource<uint8_t>(source);
+  if (version != kLatestVersion)
+  {
+    LOG(LWARNING, ("Unsupported version of types index:", version));
+    return unique_ptr<TypesIndex>();
+  }
+
+  auto index = make_unique<TypesIndex>();
+  auto const numTypes = ReadVarUint<uint64_t>(source);
+  // Every type takes at least two bytes, so a broken size is rejected before allocations.
+  if (numTypes > source.Size())
+    return unique_ptr<TypesIndex>();
+
+  auto const size = static_cast<size_t>(numTypes);
+  index->m_types.reserve(size);
+  index->m_offsets.reserve(size + 1);
+
+  uint32_t type = 0;
+  vector<uint64_t> sizes;
+  sizes.reserve(size);
+  for (size_t i = 0; i < size; ++i)
+  {
+    type += ReadVarUint<uint32_t>(source);
+    index->m_types.push_back(type);
+    sizes.push_back(ReadVarUint<uint64_t>(source));
+  }
+
+  uint64_t offset = source.Pos();
+  index->m_offsets.push_back(offset);
+  for (auto const s : sizes)
+  {
+    offset += s;
+    if (offset > reader.Size())
+      return unique_ptr<TypesIndex>();
+    index->m_offsets.push_back(offset);
+  }
+
+  index->m_reader = reader.CreateSubReader(0, reader.Size());
+  return index;
+}
+
+unique_ptr<coding::CompressedBitVector> TypesIndex::GetFeatures(uint32_t type) const
+{
+  auto const i = Find(type);
+  if (i == GetNumTypes())
+    return unique_ptr<coding::CompressedBitVector>();
+
+  ASSERT_LESS(i + 1, m_offsets.size(), ());
+  ASSERT(m_reader, ());
+  auto const list = m_reader->CreateSubReader(m_offsets[i], m_offsets[i + 1] - m_offsets[i]);
+  NonOwningReaderSource source(*list);
+  return coding::CompressedBitVectorBuilder::DeserializeFromSource(source);
+}
+
+size_t TypesIndex::Find(uint32_t type) const
+{
+  auto const it = lower_bound(m_types.begin(), m_types.end(), type);
+  if (it == m_types.end() || *it != type)
+    return GetNumTypes();
+  return static_cast<size_t>(distance(m_types.begin(), it));
+}
+
+// TypesIndexBuilder -------------------------------------------------------------------------------
+void TypesIndexBuilder::Put(uint32_t type, uint32_t featureId)
+{
+  m_entries.emplace_back(type, featureId);
+}
+
+void TypesIndexBuilder::Freeze(Writer & writer) const
+{
+  auto entries = m_entries;
+  sort(entries.begin(), entries.end());
+  entries.erase(unique(entries.begin(), entries.end()), entries.end());
+
+  vector<uint32_t> types;
+  vector<vector<uint8_t>> lists;
+  for (size_t i = 0; i < entries.size();)
+  {
+    size_t j = i;
+    vector<uint64_t> features;
+    for (; j < entries.size() && entries[j].first == entries[i].first; ++j)
+      features.push_back(entries[j].second);
+
+    types.push_back(entries[i].first);
+    lists.emplace_back();
+    MemWriter<vector<uint8_t>> listWriter(lists.back());
+    coding::CompressedBitVectorBuilder::FromBitPositions(move(features))->Serialize(listWriter);
+    i = j;
+  }
+
+  WriteToSink(writer, TypesIndex::kLatestVersion);
+  WriteVarUint(writer, static_cast<uint64_t>(types.size()));
+
+  uint32_t prevType = 0;
+  for (size_t i = 0; i < types.size(); ++i)
+  {
+    WriteVarUint(writer, types[i] - prevType);
+    WriteVarUint(writer, static_cast<uint64_t>(lists[i].size()));
+    prevType = types[i];
+  }
+
+  for (auto const & list : lists)
+    writer.Write(list.data(), list.size());
+}
+}  // namespace search
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "std/cstdint.hpp"
+#include "std/unique_ptr.hpp"
+#include "std/utility.hpp"
+#include "std/vector.hpp"
+
+class FilesContainerR;
+class Reader;
+class Writer;
+
+namespace coding
+{
+class CompressedBitVector;
+}
+
+namespace search
+{
+// A wrapper class around serialized as an mwm-section index of
+// features by their category types. For every type (see
+// Classificator::GetIndexForType()) it keeps the posting list of
+// the features which are indexed in the search index under the
+// type's category token (see FeatureTypeToString()), so the features
+// of a category are read directly instead of the search trie
+// traversal.
+//
+// The headers of the posting lists are loaded into memory while the
+// posting lists themselves are read from the section on demand.
+//
+// The section is serialized in the following format (integers are
+// stored little-endian, "varuint" means WriteVarUint):
+//
+// Field name         Field type
+// version            uint8_t
+// numTypes           varuint
+// types              numTypes times, pair of varuints (type, size),
+//                    sorted by type, types are delta-coded
+// postingLists       numTypes times, serialized CompressedBitVector
+//                    of size bytes, in the same order as types
+//
+// *NOTE* There should always be backward-compatibility. When adding
+// new versions, never change data format of old versions.
+class TypesIndex
+{
+public:
+  static uint8_t constexpr kLatestVersion = 0;
+
+  // Loads the index from the section of |cont|. Returns nullptr when
+  // there's no section or it can't be read.
+  static unique_ptr<TypesIndex> Load(FilesContainerR const & cont);
+  static unique_ptr<TypesIndex> Load(Reader const & reader);
+
+  inline size_t GetNumTypes() const { return m_types.size(); }
+
+  inline bool HasType(uint32_t type) const { return Find(type) != GetNumTypes(); }
+
+  // Returns features of |type| or nullptr when there are no such
+  // features. May throw Reader::Exception.
+  unique_ptr<coding::CompressedBitVector> GetFeatures(uint32_t type) const;
+
+private:
+  friend class TypesIndexBuilder;
+
+  // Returns GetNumTypes() when there's no |type|.
+  size_t Find(uint32_t type) const;
+
+  unique_ptr<Reader> m_reader;
+  vector<uint32_t> m_types;
+  // Posting list of m_types[i] is in [m_offsets[i], m_offsets[i + 1]) of m_reader.
+  vector<uint64_t> m_offsets;
+};
+
+class TypesIndexBuilder
+{
+public:
+  void Put(uint32_t type, uint32_t featureId);
+  void Freeze(Writer & writer) const;
+
+private:
+  vector<pair<uint32_t, uint32_t>> m_entries;
+};
+}  // namespace search
@@ -1,5 +1,7 @@
 #include "search/utils.hpp"
 
+#include "base/levenshtein_dfa_cache.hpp"
+
 #include <cctype>
 
 namespace search
@@ -18,9 +20,13 @@ size_t GetMaxErrorsForToken(strings::UniString const & token)
 
 strings::LevenshteinDFA BuildLevenshteinDFA(strings::UniString const & s)
 {
+  // The same query tokens are compiled for every mwm, for every
+  // ranked feature and for every next type-ahead query.
+  static strings::LevenshteinDFACache cache;
+
   // In search we use LevenshteinDFAs for fuzzy matching. But due to
   // performance reasons, we assume that the first letter is always
   // correct.
-  return strings::LevenshteinDFA(s, 1 /* prefixCharsToKeep */, GetMaxErrorsForToken(s));
+  return cache.Get(s, 1 /* prefixCharsToKeep */, GetMaxErrorsForToken(s));
 }
 }  // namespace search
@@ -107,9 +107,8 @@ void ForEachCategoryTypeFuzzy(StringSliceBase const & slice, TLocales const & lo
   for (size_t i = 0; i < slice.Size(); ++i)
   {
     auto const & token = slice.Get(i);
-    // todo(@m, @y). We build dfa twice for each token: here and in geocoder.cpp.
-    // A possible optimization is to build each dfa once and save it. Note that
-    // dfas for the prefix tokens differ, i.e. we ignore slice.IsPrefix(i) here.
+    // Note that dfas for the prefix tokens differ, i.e. we ignore
+    // slice.IsPrefix(i) here.
     strings::LevenshteinDFA const dfa(BuildLevenshteinDFA(token));
 
     trieRootIt.ForEachMove([&](Trie::Char const & c, Trie::Iterator const & trieStartIt) {
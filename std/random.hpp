@@ -10,6 +10,7 @@ using std::default_random_engine;
 using std::minstd_rand;
 using std::mt19937;
 using std::uniform_int_distribution;
+using std::uniform_real_distribution;
 
 #ifdef DEBUG_NEW
 #define new DEBUG_NEW
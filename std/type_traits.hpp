@@ -8,6 +8,7 @@
 
 using std::conditional;
 using std::enable_if;
+using std::integral_constant;
 using std::is_arithmetic;
 using std::is_base_of;
 using std::is_constructible;
@@ -0,0 +1,186 @@
+#include "storage/country_grid.hpp"
+
+#include "geometry/mercator.hpp"
+
+#include "base/assert.hpp"
+#include "base/math.hpp"
+
+#include "std/cmath.hpp"
+#include "std/utility.hpp"
+
+namespace storage
+{
+namespace
+{
+// Cells are slightly inflated while the grid is built, so points which are close to
+// borders of cells are treated conservatively regardless of rounding.
+double constexpr kCellInflation = 1e-6;
+
+bool IsIntersected(vector<m2::RegionD> const & regions, m2::RectD const & rect)
+{
+  pair<m2::PointD, m2::PointD> const edges[] = {{rect.LeftTop(), rect.RightTop()},
+                                                {rect.RightTop(), rect.RightBottom()},
+                                                {rect.RightBottom(), rect.LeftBottom()},
+                                                {rect.LeftBottom(), rect.LeftTop()}};
+  for (auto const & region : regions)
+  {
+    if (region.Data().empty() || !region.GetRect().IsIntersect(rect))
+      continue;
+
+    // The region is inside the cell.
+    if (rect.IsPointInside(region.Data().front()))
+      return true;
+
+    // The cell is inside the region.
+    if (region.Contains(rect.Center()))
+      return true;
+
+    for (auto const & edge : edges)
+    {
+      m2::PointD result;
+      if (region.FindIntersection(edge.first, edge.second, result))
+        return true;
+    }
+  }
+  return false;
+}
+
+bool IsCovered(vector<m2::RegionD> const & regions, m2::RectD const & rect)
+{
+  pair<m2::PointD, m2::PointD> const edges[] = {{rect.LeftTop(), rect.RightTop()},
+                                                {rect.RightTop(), rect.RightBottom()},
+                                                {rect.RightBottom(), rect.LeftBottom()},
+                                                {rect.LeftBottom(), rect.LeftTop()}};
+  for (auto const & region : regions)
+  {
+    if (!region.GetRect().IsRectInside(rect))
+      continue;
+
+    // When the border of the region doesn't cross the cell, the cell is either inside
+    // the region or the border is inside the cell, and then corners are outside.
+    if (!region.Contains(rect.Center()) || !region.Contains(rect.LeftTop()))
+      continue;
+
+    bool crossed = false;
+    for (auto const & edge : edges)
+    {
+      m2::PointD result;
+      if (region.FindIntersection(edge.first, edge.second, result))
+      {
+        crossed = true;
+        break;
+      }
+    }
+    if (!crossed)
+      return true;
+  }
+  return false;
+}
+}  // namespace
+
+// static
+uint8_t constexpr CountryGrid::kLatestVersion;
+// static
+uint32_t constexpr CountryGrid::kDefaultSize;
+// static
+uint32_t constexpr CountryGrid::kMaxSize;
+
+void CountryGrid::Build(vector<vector<m2::RegionD>> const & regions, uint32_t size)
+{
+  CHECK_GREATER(size, 0, ());
+  CHECK_LESS_OR_EQUAL(size, kMaxSize, ());
+
+  Clear();
+  m_size = size;
+
+  // Regions whose bounding boxes intersect cells.
+  vector<vector<TRegionId>> candidates(size * size);
+  for (size_t id = 0; id < regions.size(); ++id)
+  {
+    m2::RectD rect;
+    for (auto const & region : regions[id])
+    {
+      if (!region.Data().empty())
+        rect.Add(region.GetRect());
+    }
+    if (!rect.IsValid())
+      continue;
+
+    uint32_t const minX = GetCellCoord(rect.minX(), MercatorBounds::minX, MercatorBounds::maxX);
+    uint32_t const maxX = GetCellCoord(rect.maxX(), MercatorBounds::minX, MercatorBounds::maxX);
+    uint32_t const minY = GetCellCoord(rect.minY(), MercatorBounds::minY, MercatorBounds::maxY);
+    uint32_t const maxY = GetCellCoord(rect.maxY(), MercatorBounds::minY, MercatorBounds::maxY);
+    // Cells of neighbouring coords are added too since coords are rounded.
+    for (uint32_t y = minY > 0 ? minY - 1 : 0; y <= maxY + 1 && y < size; ++y)
+    {
+      for (uint32_t x = minX > 0 ? minX - 1 : 0; x <= maxX + 1 && x < size; ++x)
+        candidates[y * size + x].push_back(static_cast<TRegionId>(id));
+    }
+  }
+
+  for (uint32_t y = 0; y < size; ++y)
+  {
+    for (uint32_t x = 0; x < size; ++x)
+    {
+      m2::RectD rect = GetCellRect(x, y);
+      rect.Inflate(rect.SizeX() * kCellInflation, rect.SizeY() * kCellInflation);
+
+      bool inside = false;
+      for (auto const id : candidates[y * size + x])
+      {
+        auto const & region = regions[id];
+        if (!IsIntersected(region, rect))
+          continue;
+
+        // Points of the cell may belong to the following regions too, but
+        // the lookup stops at the first one.
+        inside = m_regions.size() == m_offsets.back() && IsCovered(region, rect);
+        m_regions.push_back(id);
+        if (inside)
+          break;
+      }
+      m_inside.push_back(inside);
+      m_offsets.push_back(static_cast<uint32_t>(m_regions.size()));
+    }
+  }
+}
+
+void CountryGrid::Clear()
+{
+  m_size = 0;
+  m_offsets.assign(1, 0);
+  m_regions.clear();
+  m_inside.clear();
+}
+
+CountryGrid::Cell CountryGrid::GetCell(m2::PointD const & pt) const
+{
+  Cell cell;
+  if (IsEmpty())
+    return cell;
+
+  uint32_t const x = GetCellCoord(pt.x, MercatorBounds::minX, MercatorBounds::maxX);
+  uint32_t const y = GetCellCoord(pt.y, MercatorBounds::minY, MercatorBounds::maxY);
+  size_t const index = y * m_size + x;
+  ASSERT_LESS(index + 1, m_offsets.size(), ());
+
+  cell.m_begin = m_regions.data() + m_offsets[index];
+  cell.m_end = m_regions.data() + m_offsets[index + 1];
+  cell.m_inside = m_inside[index];
+  return cell;
+}
+
+uint32_t CountryGrid::GetCellCoord(double coord, double min, double max) const
+{
+  double const cell = floor((coord - min) / (max - min) * m_size);
+  return static_cast<uint32_t>(my::clamp(cell, 0.0, static_cast<double>(m_size - 1)));
+}
+
+m2::RectD CountryGrid::GetCellRect(uint32_t x, uint32_t y) const
+{
+  double const sizeX = (MercatorBounds::maxX - MercatorBounds::minX) / m_size;
+  double const sizeY = (MercatorBounds::maxY - MercatorBounds::minY) / m_size;
+  return m2::RectD(MercatorBounds::minX + x * sizeX, MercatorBounds::minY + y * sizeY,
+                   MercatorBounds::minX + (x + 1) * sizeX, MercatorBounds::minY + (y + 1) * sizeY);
+}
+}  // namespace storage
@@ -0,0 +1,124 @@
+#pragma once
+
+#include "geometry/point2d.hpp"
+#include "geometry/rect2d.hpp"
+#include "geometry/region2d.hpp"
+
+#include "coding/reader.hpp"
+#include "coding/varint.hpp"
+#include "coding/write_to_sink.hpp"
+
+#include "base/exception.hpp"
+
+#include "std/cstdint.hpp"
+#include "std/vector.hpp"
+
+namespace storage
+{
+// Uniform grid over the mercator world which speeds up search of a region a point
+// belongs to. Every cell keeps ids of regions having common points with the cell in
+// ascending order. When the first of them covers the whole cell the cell is marked as
+// inside the region, so no polygon tests are needed for points of the cell. Cells without
+// regions (seas and oceans) need no tests at all.
+//
+// The grid is built by the generator and stored in packed_polygons.bin.
+class CountryGrid
+{
+public:
+  using TRegionId = uint32_t;
+
+  static uint8_t constexpr kLatestVersion = 0;
+  static uint32_t constexpr kDefaultSize = 256;
+
+  // Regions which may contain a point of a cell, in ascending order.
+  struct Cell
+  {
+    TRegionId const * m_begin = nullptr;
+    TRegionId const * m_end = nullptr;
+    // True when the whole cell belongs to *m_begin.
+    bool m_inside = false;
+  };
+
+  // Builds a grid of |size| x |size| cells. |regions[id]| are polygons of the region |id|.
+  void Build(vector<vector<m2::RegionD>> const & regions, uint32_t size);
+
+  void Clear();
+  bool IsEmpty() const { return m_size == 0; }
+  uint32_t GetSize() const { return m_size; }
+
+  // Returns an empty cell for an empty grid.
+  Cell GetCell(m2::PointD const & pt) const;
+
+  template <typename TSink>
+  void Serialize(TSink & sink) const
+  {
+    WriteToSink(sink, kLatestVersion);
+    WriteVarUint(sink, m_size);
+    for (size_t cell = 0; cell + 1 < m_offsets.size(); ++cell)
+    {
+      uint32_t const count = m_offsets[cell + 1] - m_offsets[cell];
+      WriteVarUint(sink, (count << 1) | (m_inside[cell] ? 1 : 0));
+
+      TRegionId prev = 0;
+      for (uint32_t i = m_offsets[cell]; i < m_offsets[cell + 1]; ++i)
+      {
+        WriteVarUint(sink, m_regions[i] - prev);
+        prev = m_regions[i];
+      }
+    }
+  }
+
+  // Throws Reader::ReadException when the grid is broken or refers to regions
+  // which are not less than |regionsCount|.
+  template <typename TSource>
+  void Deserialize(TSource & src, size_t regionsCount)
+  {
+    Clear();
+
+    auto const version = ReadPrimitiveFromSource<uint8_t>(src);
+    if (version != kLatestVersion)
+      MYTHROW(Reader::ReadException, ("Unknown version of countries grid:", version));
+
+    uint32_t const size = ReadVarUint<uint32_t>(src);
+    if (size == 0 || size > kMaxSize)
+      MYTHROW(Reader::ReadException, ("Wrong size of countries grid:", size));
+
+    uint32_t const cellsCount = size * size;
+    m_offsets.reserve(cellsCount + 1);
+    m_inside.reserve(cellsCount);
+    for (uint32_t cell = 0; cell < cellsCount; ++cell)
+    {
+      uint32_t const header = ReadVarUint<uint32_t>(src);
+      uint32_t const count = header >> 1;
+      bool const inside = (header & 1) != 0;
+      if (inside && count == 0)
+        MYTHROW(Reader::ReadException, ("Inside cell without regions:", cell));
+
+      TRegionId id = 0;
+      for (uint32_t i = 0; i < count; ++i)
+      {
+        id += ReadVarUint<uint32_t>(src);
+        if (id >= regionsCount)
+          MYTHROW(Reader::ReadException, ("Wrong region in countries grid:", id, regionsCount));
+        m_regions.push_back(id);
+      }
+      m_inside.push_back(inside);
+      m_offsets.push_back(static_cast<uint32_t>(m_regions.size()));
+    }
+    m_size = size;
+  }
+
+private:
+  static uint32_t constexpr kMaxSize = 4096;
+
+  uint32_t GetCellCoord(double coord, double min, double max) const;
+  m2::RectD GetCellRect(uint32_t x, uint32_t y) const;
+
+  uint32_t m_size = 0;
+  // Regions of the cell |i| are m_regions[m_offsets[i], m_offsets[i + 1]).
+  // Cells are stored by rows from the bottom.
+  vector<uint32_t> m_offsets = {0};
+  vector<TRegionId> m_regions;
+  vector<bool> m_inside;
+};
+}  // namespace storage
@@ -185,10 +185,26 @@ void CountryInfoGetter::InitAffiliationsInfo(TMappingAffiliations const * affili
 
 CountryInfoGetter::TRegionId CountryInfoGetter::FindFirstCountry(m2::PointD const & pt) const
 {
-  for (size_t id = 0; id < m_countries.size(); ++id)
+  if (!m_grid.IsEmpty())
   {
-    if (m_countries[id].m_rect.IsPointInside(pt) && IsBelongToRegionImpl(id, pt))
-      return id;
+    CountryGrid::Cell const cell = m_grid.GetCell(pt);
+    if (cell.m_inside)
+      return *cell.m_begin;
+
+    for (auto it = cell.m_begin; it != cell.m_end; ++it)
+    {
+      TRegionId const id = *it;
+      if (m_countries[id].m_rect.IsPointInside(pt) && IsBelongToRegionImpl(id, pt))
+        return id;
+    }
+  }
+  else
+  {
+    for (size_t id = 0; id < m_countries.size(); ++id)
+    {
+      if (m_countries[id].m_rect.IsPointInside(pt) && IsBelongToRegionImpl(id, pt))
+        return id;
+    }
   }
 
   ms::LatLon const latLon = MercatorBounds::ToLatLon(pt);
@@ -263,6 +279,20 @@ CountryInfoReader::CountryInfoReader(ModelReaderPtr polyR, ModelReaderPtr countr
   for (size_t i = 0; i < countrySz; ++i)
     m_countryIndex[m_countries[i].m_countryId] = i;
 
+  if (m_reader.IsExist(PACKED_POLYGONS_GRID_TAG))
+  {
+    try
+    {
+      ReaderSource<ModelReaderPtr> gridSrc(m_reader.GetReader(PACKED_POLYGONS_GRID_TAG));
+      m_grid.Deserialize(gridSrc, countrySz);
+    }
+    catch (Reader::Exception const & e)
+    {
+      LOG(LWARNING, ("Can't load countries grid:", e.Msg()));
+      m_grid.Clear();
+    }
+  }
+
   string buffer;
   countryR.ReadAsString(buffer);
   LoadCountryFile2CountryInfo(buffer, m_id2info, m_isSingleMwm);
@@ -2,6 +2,7 @@
 
 #include "storage/country.hpp"
 #include "storage/country_decl.hpp"
+#include "storage/country_grid.hpp"
 
 #include "platform/platform.hpp"
 
@@ -10,6 +11,7 @@
 #include "coding/file_container.hpp"
 
 #include "base/cache.hpp"
+#include "base/cache_registry.hpp"
 
 #include "std/mutex.hpp"
 #include "std/unordered_map.hpp"
@@ -113,6 +115,8 @@ protected:
   vector<CountryDef> m_countries;
   // Maps all leaf country id (file names) to their indices in m_countries.
   unordered_map<TCountryId, TRegionId> m_countryIndex;
+  // Speeds up FindFirstCountry() when it's not empty.
+  CountryGrid m_grid;
 
   TMappingAffiliations const * m_affiliations = nullptr;
 
@@ -161,6 +165,10 @@ protected:
   FilesContainerR m_reader;
   mutable my::Cache<uint32_t, vector<m2::RegionD>> m_cache;
   mutable mutex m_cacheMutex;
+
+  base::SheddableCache m_cacheShedding{"storage.country_regions",
+                                       base::CacheRegistry::Priority::Low,
+                                       [this]() { CountryInfoReader::ClearCachesImpl(); }};
 };
 
 // This class allows users to get info about very simply rectangular
@@ -12,6 +12,7 @@
 
 #include "coding/file_name_utils.hpp"
 #include "coding/internal/file_data.hpp"
+#include "coding/section_hashes.hpp"
 #include "coding/reader.hpp"
 #include "coding/url_encode.hpp"
 
@@ -52,6 +53,22 @@ uint64_t GetLocalSize(shared_ptr<LocalCountryFile> file, MapOptions opt)
   return size;
 }
 
+// Returns false when hashes of sections of a downloaded map don't match
+// the table written by the generator. Maps without the table, e.g. ones
+// of older versions, and files which aren't containers are accepted as is.
+bool VerifyDownloadedMap(string const & path)
+{
+  try
+  {
+    return coding::SectionHashes::Verify(path) != coding::SectionHashes::Status::Corrupted;
+  }
+  catch (RootException const & e)
+  {
+    LOG(LWARNING, ("Can't verify sections of", path, ":", e.Msg()));
+    return true;
+  }
+}
+
 void DeleteCountryIndexes(LocalCountryFile const & localFile)
 {
   platform::CountryIndexes::DeleteFromDisk(localFile);
@@ -100,6 +117,7 @@ MapFilesDownloader::TProgress Storage::GetOverallProgress(TCountriesVec const &
 Storage::Storage(string const & pathToCountriesFile /* = COUNTRIES_FILE */,
                  string const & dataDir /* = string() */)
   : m_downloader(new HttpMapFilesDownloader())
+  , m_downloaderFactory([]() { return make_unique<HttpMapFilesDownloader>(); })
   , m_currentSlotId(0)
   , m_dataDir(dataDir)
   , m_downloadMapOnTheMap(nullptr)
@@ -221,6 +239,7 @@ void Storage::Clear()
   ASSERT_THREAD_CHECKER(m_threadChecker, ());
 
   m_downloader->Reset();
+  m_prefetchSessions.clear();
   m_queue.clear();
   m_justDownloaded.clear();
   m_failedCountries.clear();
@@ -237,7 +256,7 @@ void Storage::RegisterAllLocalMaps(bool enableDiffs)
   m_localFilesForFakeCountries.clear();
 
   vector<LocalCountryFile> localFiles;
-  FindAllLocalMapsAndCleanup(GetCurrentDataVersion(), m_dataDir, localFiles);
+  FindAllLocalMaps(GetCurrentDataVersion(), m_dataDir, localFiles);
 
   auto compareByCountryAndVersion = [](LocalCountryFile const & lhs, LocalCountryFile const & rhs) {
     if (lhs.GetCountryFile() != rhs.GetCountryFile())
@@ -283,6 +302,15 @@ void Storage::RegisterAllLocalMaps(bool enableDiffs)
   RestoreDownloadQueue();
 }
 
+void Storage::CleanupMapsDirectoryAsync() const
+{
+  ASSERT_THREAD_CHECKER(m_threadChecker, ());
+
+  int64_t const version = GetCurrentDataVersion();
+  string const dataDir = m_dataDir;
+  GetPlatform().RunAsync([version, dataDir]() { CleanupMapsDirectory(version, dataDir); });
+}
+
 void Storage::GetLocalMaps(vector<TLocalFilePtr> & maps) const
 {
   ASSERT_THREAD_CHECKER(m_threadChecker, ());
@@ -343,10 +371,11 @@ TLocalAndRemoteSize Storage::CountrySizeInBytes(TCountryId const & countryId, Ma
   }
 
   TLocalAndRemoteSize sizes(0, GetRemoteSize(countryFile, opt, GetCurrentDataVersion()));
-  if (!m_downloader->IsIdle() && IsCountryFirstInQueue(countryId))
+  MapFilesDownloader * downloader = GetFirstCountryDownloader();
+  if (downloader != nullptr && IsCountryFirstInQueue(countryId))
   {
     sizes.first =
-        m_downloader->GetDownloadingProgress().first +
+        downloader->GetDownloadingProgress().first +
         GetRemoteSize(countryFile, queuedCountry->GetDownloadedFilesOptions(), GetCurrentDataVersion());
   }
   return sizes;
@@ -497,9 +526,14 @@ void Storage::DownloadCountry(TCountryId const & countryId, MapOptions opt)
   m_failedCountries.erase(countryId);
   m_queue.push_back(QueuedCountry(countryId, opt));
   if (m_queue.size() == 1)
+  {
     DownloadNextCountryFromQueue();
+  }
   else
+  {
     NotifyStatusChangedForHierarchy(countryId);
+    StartPrefetching();
+  }
   SaveDownloadQueue();
 }
 
@@ -604,6 +638,8 @@ void Storage::DownloadNextCountryFromQueue()
 
   // New status for the country, "Downloading"
   NotifyStatusChangedForHierarchy(queuedCountry.GetCountryId());
+
+  StartPrefetching();
 }
 
 void Storage::DownloadNextFile(QueuedCountry const & country)
@@ -614,6 +650,16 @@ void Storage::DownloadNextFile(QueuedCountry const & country)
   string const filePath = GetFileDownloadPath(countryId, country.GetCurrentFileOptions());
   uint64_t size;
 
+  // The file may be being downloaded in advance. Let's wait for the end of the
+  // prefetch session, it is finished by OnPrefetchFileDownloadFinished().
+  auto const it = m_prefetchSessions.find(countryId);
+  if (it != m_prefetchSessions.end())
+  {
+    if (it->second.m_file == country.GetCurrentFileOptions())
+      return;
+    m_prefetchSessions.erase(it);
+  }
+
   // It may happen that the file already was downloaded, so there're
   // no need to request servers list and download file.  Let's
   // switch to next file.
@@ -820,6 +866,131 @@ void Storage::OnMapFileDownloadProgress(MapFilesDownloader::TProgress const & pr
   ReportProgressForHierarchy(m_queue.front().GetCountryId(), progress);
 }
 
+void Storage::StartPrefetching()
+{
+  ASSERT_THREAD_CHECKER(m_threadChecker, ());
+
+  // Sessions of countries which were removed from the queue are not needed anymore.
+  for (auto it = m_prefetchSessions.begin(); it != m_prefetchSessions.end();)
+  {
+    if (IsCountryInQueue(it->first))
+      ++it;
+    else
+      it = m_prefetchSessions.erase(it);
+  }
+
+  if (m_maxParallelDownloads <= 1 || !m_downloaderFactory || m_queue.size() < 2 ||
+      !m_downloadingPolicy->IsDownloadingAllowed())
+  {
+    return;
+  }
+
+  auto const activeDownloads = [this]() {
+    return m_prefetchSessions.size() + (m_downloader->IsIdle() ? 0 : 1);
+  };
+
+  for (auto it = next(m_queue.begin());
+       it != m_queue.end() && activeDownloads() < m_maxParallelDownloads; ++it)
+  {
+    TCountryId const & countryId = it->GetCountryId();
+    MapOptions const file = it->GetCurrentFileOptions();
+
+    // Diffs are not prefetched because the diff scheme may be not received yet.
+    if (file == MapOptions::Diff || m_prefetchSessions.count(countryId) != 0)
+      continue;
+
+    CountryFile const & countryFile = GetCountryFile(countryId);
+    if (!PreparePlaceForCountryFiles(GetCurrentDataVersion(), m_dataDir, countryFile))
+      continue;
+
+    uint64_t size;
+    if (GetPlatform().GetFileSizeByFullPath(GetFileDownloadPath(countryId, file), size))
+      continue;
+
+    PrefetchSession & session = m_prefetchSessions[countryId];
+    session.m_downloader = m_downloaderFactory();
+    session.m_file = file;
+    session.m_downloader->GetServersList(
+        GetCurrentDataVersion(), countryFile.GetName(),
+        bind(&Storage::OnPrefetchServerListDownloaded, this, countryId, _1));
+  }
+}
+
+void Storage::OnPrefetchServerListDownloaded(TCountryId const & countryId,
+                                             vector<string> const & urls)
+{
+  ASSERT_THREAD_CHECKER(m_threadChecker, ());
+
+  auto const it = m_prefetchSessions.find(countryId);
+  if (it == m_prefetchSessions.end())
+    return;
+
+  QueuedCountry const * queuedCountry = FindCountryInQueue(countryId);
+  if (queuedCountry == nullptr || queuedCountry->GetCurrentFileOptions() != it->second.m_file)
+  {
+    m_prefetchSessions.erase(it);
+    return;
+  }
+
+  vector<string> const & downloadingUrls =
+      m_downloadingUrlsForTesting.empty() ? urls : m_downloadingUrlsForTesting;
+  vector<string> fileUrls;
+  fileUrls.reserve(downloadingUrls.size());
+  for (string const & url : downloadingUrls)
+    fileUrls.push_back(GetFileDownloadUrl(url, *queuedCountry));
+
+  string const filePath = GetFileDownloadPath(countryId, it->second.m_file);
+  it->second.m_downloader->DownloadMapFile(
+      fileUrls, filePath, GetDownloadSize(*queuedCountry),
+      bind(&Storage::OnPrefetchFileDownloadFinished, this, countryId, _1),
+      bind(&Storage::OnPrefetchFileDownloadProgress, this, countryId, _1));
+}
+
+void Storage::OnPrefetchFileDownloadFinished(TCountryId const & countryId, bool success)
+{
+  ASSERT_THREAD_CHECKER(m_threadChecker, ());
+
+  auto const it = m_prefetchSessions.find(countryId);
+  if (it == m_prefetchSessions.end())
+    return;
+  m_prefetchSessions.erase(it);
+
+  if (!success)
+    LOG(LINFO, ("Prefetching of", countryId, "failed. It will be downloaded in its turn."));
+
+  // The first country may wait for the end of the session.
+  if (!m_queue.empty() && IsCountryFirstInQueue(countryId))
+    DownloadNextFile(m_queue.front());
+
+  StartPrefetching();
+}
+
+void Storage::OnPrefetchFileDownloadProgress(TCountryId const & countryId,
+                                             MapFilesDownloader::TProgress const & progress)
+{
+  ASSERT_THREAD_CHECKER(m_threadChecker, ());
+
+  // Progress is reported for the first country only as before.
+  if (m_queue.empty() || m_observers.empty() || !IsCountryFirstInQueue(countryId))
+    return;
+
+  ReportProgressForHierarchy(countryId, progress);
+}
+
+MapFilesDownloader * Storage::GetFirstCountryDownloader() const
+{
+  if (!m_downloader->IsIdle())
+    return m_downloader.get();
+
+  if (m_queue.empty())
+    return nullptr;
+
+  auto const it = m_prefetchSessions.find(m_queue.front().GetCountryId());
+  if (it == m_prefetchSessions.end() || it->second.m_downloader->IsIdle())
+    return nullptr;
+  return it->second.m_downloader.get();
+}
+
 void Storage::RegisterDownloadedFiles(TCountryId const & countryId, MapOptions options)
 {
   ASSERT_THREAD_CHECKER(m_threadChecker, ());
@@ -879,6 +1050,13 @@ void Storage::RegisterDownloadedFiles(TCountryId const & countryId, MapOptions o
     if (!HasOptions(options, file))
       continue;
     string const path = GetFileDownloadPath(countryId, file);
+    if (file == MapOptions::Map && !VerifyDownloadedMap(path))
+    {
+      LOG(LERROR, ("Downloaded file is corrupted:", path));
+      my::DeleteFileX(path);
+      ok = false;
+      break;
+    }
     if (!my::RenameFileX(path, localFile->GetPath(file)))
     {
       ok = false;
@@ -1045,6 +1223,20 @@ bool Storage::IsCountryFirstInQueue(TCountryId const & countryId) const
 
 void Storage::SetLocale(string const & locale) { m_countryNameGetter.SetLocale(locale); }
 string Storage::GetLocale() const { return m_countryNameGetter.GetLocale(); }
+void Storage::SetMaxParallelDownloads(size_t count)
+{
+  ASSERT_THREAD_CHECKER(m_threadChecker, ());
+
+  // Sessions which are already started are not interrupted if |count| is decreased.
+  m_maxParallelDownloads = max(count, static_cast<size_t>(1));
+  StartPrefetching();
+}
+
+void Storage::SetDownloaderFactoryForTesting(TDownloaderFactory const & factory)
+{
+  m_downloaderFactory = factory;
+}
+
 void Storage::SetDownloaderForTesting(unique_ptr<MapFilesDownloader> && downloader)
 {
   m_downloader = move(downloader);
@@ -1155,11 +1347,17 @@ bool Storage::DeleteCountryFilesFromDownloader(TCountryId const & countryId)
     return false;
 
   MapOptions const opt = queuedCountry->GetInitOptions();
-  if (IsCountryFirstInQueue(countryId))
+  bool const isFirstInQueue = IsCountryFirstInQueue(countryId);
+  // Files of the next countries may be downloaded in advance.
+  if (isFirstInQueue || m_maxParallelDownloads > 1)
   {
     // Abrupt downloading of the current file if it should be removed.
     if (HasOptions(opt, queuedCountry->GetCurrentFileOptions()))
-      m_downloader->Reset();
+    {
+      if (isFirstInQueue)
+        m_downloader->Reset();
+      m_prefetchSessions.erase(countryId);
+    }
 
     // Remove all files downloader had been created for a country.
     DeleteDownloaderFilesForCountry(GetCurrentDataVersion(), m_dataDir, GetCountryFile(countryId));
@@ -1192,6 +1390,7 @@ bool Storage::DeleteCountryFilesFromDownloader(TCountryId const & countryId)
     else
       DownloadNextCountryFromQueue();
   }
+  StartPrefetching();
   return true;
 }
 
@@ -1572,9 +1771,9 @@ void Storage::GetNodeAttrs(TCountryId const & countryId, NodeAttrs & nodeAttrs)
     TCountryId const & downloadingMwm =
         IsDownloadInProgress() ? GetCurrentDownloadingCountryId() : kInvalidCountryId;
     MapFilesDownloader::TProgress downloadingMwmProgress(0, 0);
-    if (!m_downloader->IsIdle())
+    if (MapFilesDownloader * downloader = GetFirstCountryDownloader())
     {
-      downloadingMwmProgress = m_downloader->GetDownloadingProgress();
+      downloadingMwmProgress = downloader->GetDownloadingProgress();
       // If we don't know estimated file size then we ignore its progress.
       if (downloadingMwmProgress.second == -1)
         downloadingMwmProgress = {0, 0};
@@ -146,11 +146,30 @@ public:
   using TChangeCountryFunction = function<void(TCountryId const &)>;
   using TProgressFunction = function<void(TCountryId const &, MapFilesDownloader::TProgress const &)>;
   using TQueue = list<QueuedCountry>;
+  using TDownloaderFactory = function<unique_ptr<MapFilesDownloader>()>;
 
 private:
-  /// We support only one simultaneous request at the moment
+  /// Downloads files of the first country in |m_queue|.
   unique_ptr<MapFilesDownloader> m_downloader;
 
+  /// A session which downloads the current file of a country from |m_queue| in advance,
+  /// while files of the first country are downloaded by |m_downloader|. The downloaded
+  /// file is left in the downloader directory and is picked up when the country becomes
+  /// the first in |m_queue|, so applying and registration of files stay serialized.
+  struct PrefetchSession
+  {
+    unique_ptr<MapFilesDownloader> m_downloader;
+    MapOptions m_file = MapOptions::Nothing;
+  };
+
+  map<TCountryId, PrefetchSession> m_prefetchSessions;
+
+  /// Max number of countries from |m_queue| which are downloaded at the same time.
+  size_t m_maxParallelDownloads = 1;
+
+  /// Creates downloaders for |m_prefetchSessions|. Nothing is prefetched if it's empty.
+  TDownloaderFactory m_downloaderFactory;
+
   /// Stores timestamp for update checks
   int64_t m_currentVersion;
 
@@ -272,6 +291,20 @@ private:
   /// during the downloading process.
   void OnMapFileDownloadProgress(MapFilesDownloader::TProgress const & progress);
 
+  /// Starts prefetch sessions for countries from |m_queue| after the first one
+  /// while there are less than |m_maxParallelDownloads| active downloads.
+  void StartPrefetching();
+
+  /// Called on the main thread by downloaders of |m_prefetchSessions|.
+  void OnPrefetchServerListDownloaded(TCountryId const & countryId, vector<string> const & urls);
+  void OnPrefetchFileDownloadFinished(TCountryId const & countryId, bool success);
+  void OnPrefetchFileDownloadProgress(TCountryId const & countryId,
+                                      MapFilesDownloader::TProgress const & progress);
+
+  /// \returns the downloader which downloads the current file of the first country in |m_queue|
+  /// or nullptr if there's no such downloader.
+  MapFilesDownloader * GetFirstCountryDownloader() const;
+
   void RegisterDownloadedFiles(TCountryId const & countryId, MapOptions files);
 
   void OnMapDownloadFinished(TCountryId const & countryId, bool success, MapOptions files);
@@ -302,6 +335,12 @@ public:
 
   inline void SetDownloadingPolicy(DownloadingPolicy * policy) { m_downloadingPolicy = policy; }
 
+  /// Sets max number of countries which are downloaded at the same time. Only the first
+  /// country in the queue is applied and registered, the next |count - 1| ones are only
+  /// downloaded in advance. It's 1 by default, i.e. countries are downloaded one by one.
+  void SetMaxParallelDownloads(size_t count);
+  size_t GetMaxParallelDownloads() const { return m_maxParallelDownloads; }
+
   /// @name Interface with clients (Android/iOS).
   /// \brief It represents the interface which can be used by clients (Android/iOS).
   /// The term node means an mwm or a group of mwm like a big country.
@@ -477,10 +516,15 @@ public:
 
   // Finds and registers all map files in maps directory. In the case
   // of several versions of the same map keeps only the latest one, others
-  // are deleted from disk.
+  // are deleted from disk. Other obsolete files aren't deleted, see
+  // CleanupMapsDirectoryAsync().
   // *NOTE* storage will forget all already known local maps.
   void RegisterAllLocalMaps(bool enableDiffs);
 
+  // Deletes partially downloaded maps of old versions, empty directories
+  // and other obsolete files in background, see platform::CleanupMapsDirectory().
+  void CleanupMapsDirectoryAsync() const;
+
   // Returns list of all local maps, including fake countries (World*.mwm).
   void GetLocalMaps(vector<TLocalFilePtr> & maps) const;
 
@@ -549,6 +593,7 @@ public:
 
   // for testing:
   void SetDownloaderForTesting(unique_ptr<MapFilesDownloader> && downloader);
+  void SetDownloaderFactoryForTesting(TDownloaderFactory const & factory);
   void SetCurrentDataVersionForTesting(int64_t currentVersion);
   void SetDownloadingUrlsForTesting(vector<string> const & downloadingUrls);
   void SetLocaleForTesting(string const & jsonBuffer, string const & locale);
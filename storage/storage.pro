@@ -13,6 +13,7 @@ INCLUDEPATH += $$ROOT_DIR/3party/jansson/src
 HEADERS += \
   country.hpp \
   country_decl.hpp \
+  country_grid.hpp \
   country_info_getter.hpp \
   country_name_getter.hpp \
   country_parent_getter.hpp \
@@ -34,6 +35,7 @@ HEADERS += \
 SOURCES += \
   country.cpp \
   country_decl.cpp \
+  country_grid.cpp \
   country_info_getter.cpp \
   country_name_getter.cpp \
   country_parent_getter.cpp \
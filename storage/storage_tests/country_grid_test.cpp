@@ -0,0 +1,120 @@
+#include "testing/testing.hpp"
+
+#include "storage/country_grid.hpp"
+
+#include "geometry/point2d.hpp"
+#include "geometry/region2d.hpp"
+
+#include "coding/reader.hpp"
+#include "coding/writer.hpp"
+
+#include "std/limits.hpp"
+#include "std/random.hpp"
+#include "std/vector.hpp"
+
+using namespace storage;
+
+namespace
+{
+using TRegions = vector<vector<m2::RegionD>>;
+
+uint32_t const kNotFound = numeric_limits<uint32_t>::max();
+
+m2::RegionD MakeRegion(vector<m2::PointD> const & points)
+{
+  return m2::RegionD(points.begin(), points.end());
+}
+
+uint32_t FindSlow(TRegions const & regions, m2::PointD const & pt)
+{
+  for (uint32_t id = 0; id < regions.size(); ++id)
+  {
+    for (auto const & region : regions[id])
+    {
+      if (region.Contains(pt))
+        return id;
+    }
+  }
+  return kNotFound;
+}
+
+uint32_t FindByGrid(CountryGrid const & grid, TRegions const & regions, m2::PointD const & pt)
+{
+  CountryGrid::Cell const cell = grid.GetCell(pt);
+  if (cell.m_inside)
+    return *cell.m_begin;
+
+  for (auto it = cell.m_begin; it != cell.m_end; ++it)
+  {
+    for (auto const & region : regions[*it])
+    {
+      if (region.Contains(pt))
+        return *it;
+    }
+  }
+  return kNotFound;
+}
+}  // namespace
+
+UNIT_TEST(CountryGrid_Smoke)
+{
+  TRegions regions(3);
+  // An enclave inside the second region.
+  regions[0].push_back(MakeRegion({{5, 5}, {5, 8}, {8, 8}, {8, 5}}));
+  regions[1].push_back(MakeRegion({{-60, -60}, {-60, 60}, {60, 60}, {60, -60}}));
+  // Two islands.
+  regions[2].push_back(MakeRegion({{70, -20}, {110, 50}, {150, -20}}));
+  regions[2].push_back(MakeRegion({{-100, -80}, {-100, -70}, {-90, -70}}));
+
+  CountryGrid grid;
+  TEST(grid.IsEmpty(), ());
+  TEST_EQUAL(FindByGrid(grid, regions, m2::PointD(0, 0)), kNotFound, ());
+
+  grid.Build(regions, 16 /* size */);
+  TEST_EQUAL(grid.GetSize(), 16, ());
+
+  // The cell is completely inside the second region.
+  CountryGrid::Cell cell = grid.GetCell(m2::PointD(-30, -30));
+  TEST(cell.m_inside, ());
+  TEST_EQUAL(*cell.m_begin, 1, ());
+
+  // The cell contains the enclave.
+  cell = grid.GetCell(m2::PointD(6, 6));
+  TEST(!cell.m_inside, ());
+  TEST_EQUAL(cell.m_end - cell.m_begin, 2, ());
+
+  // There are no regions in the ocean.
+  cell = grid.GetCell(m2::PointD(170, 170));
+  TEST(cell.m_begin == cell.m_end, ());
+
+  vector<char> buffer;
+  {
+    MemWriter<vector<char>> writer(buffer);
+    grid.Serialize(writer);
+  }
+
+  CountryGrid loaded;
+  {
+    MemReader reader(buffer.data(), buffer.size());
+    ReaderSource<MemReader> src(reader);
+    loaded.Deserialize(src, regions.size());
+  }
+  TEST_EQUAL(loaded.GetSize(), grid.GetSize(), ());
+
+  {
+    MemReader reader(buffer.data(), buffer.size());
+    ReaderSource<MemReader> src(reader);
+    CountryGrid broken;
+    TEST_ANY_THROW(broken.Deserialize(src, 2 /* regionsCount */), ());
+  }
+
+  mt19937 rng(0);
+  std::uniform_real_distribution<double> coord(-180.0, 180.0);
+  for (size_t i = 0; i < 100000; ++i)
+  {
+    m2::PointD const pt(coord(rng), coord(rng));
+    uint32_t const expected = FindSlow(regions, pt);
+    TEST_EQUAL(FindByGrid(grid, regions, pt), expected, (pt));
+    TEST_EQUAL(FindByGrid(loaded, regions, pt), expected, (pt));
+  }
+}
@@ -620,6 +620,35 @@ UNIT_CLASS_TEST(TwoComponentStorageTest, CountriesDownloading)
   runner.Run();
 }
 
+UNIT_CLASS_TEST(StorageTest, ParallelCountriesDownloading)
+{
+  storage.SetDownloaderFactoryForTesting([this]() {
+    return unique_ptr<MapFilesDownloader>(make_unique<FakeMapFilesDownloader>(runner));
+  });
+  storage.SetMaxParallelDownloads(2);
+
+  TCountryId const azerbaijanCountryId = storage.FindCountryIdByFile("Azerbaijan");
+  TEST(IsCountryIdValid(azerbaijanCountryId), ());
+  storage.DeleteCountry(azerbaijanCountryId, MapOptions::Map);
+  MY_SCOPE_GUARD(cleanupAzerbaijanFiles,
+                 bind(&Storage::DeleteCountry, &storage, azerbaijanCountryId, MapOptions::Map));
+
+  TCountryId const uruguayCountryId = storage.FindCountryIdByFile("Uruguay");
+  TEST(IsCountryIdValid(uruguayCountryId), ());
+  storage.DeleteCountry(uruguayCountryId, MapOptions::Map);
+  MY_SCOPE_GUARD(cleanupUruguayFiles,
+                 bind(&Storage::DeleteCountry, &storage, uruguayCountryId, MapOptions::Map));
+
+  // Uruguay is downloaded in advance but it's still in queue until Azerbaijan is registered.
+  unique_ptr<CountryDownloaderChecker> azerbaijanChecker =
+      AbsentCountryDownloaderChecker(storage, azerbaijanCountryId, MapOptions::Map);
+  unique_ptr<CountryDownloaderChecker> uruguayChecker =
+      QueuedCountryDownloaderChecker(storage, uruguayCountryId, MapOptions::Map);
+  azerbaijanChecker->StartDownload();
+  uruguayChecker->StartDownload();
+  runner.Run();
+}
+
 UNIT_TEST(StorageTest_DeleteTwoVersionsOfTheSameCountry)
 {
   Storage storage(COUNTRIES_OBSOLETE_FILE);
@@ -38,6 +38,7 @@ HEADERS += \
 
 SOURCES += \
   ../../testing/testingmain.cpp \
+  country_grid_test.cpp \
   country_info_getter_test.cpp \
   country_name_getter_test.cpp \
   fake_map_files_downloader.cpp \
@@ -74,6 +74,31 @@ private:
   shared_ptr<m4::Tree<routing::NumMwmId>> m_mwmTree;
   unordered_map<routing::NumMwmId, vector<m2::RegionD>> m_borders;
 };
+
+void SplitIntoMwms(PointToMwmId const & pointToMwmId, UserToTrack const & userToTrack,
+                   MwmToTracks & mwmToTracks)
+{
+  my::Timer timer;
+
+  for (auto const & kv : userToTrack)
+  {
+    string const & user = kv.first;
+    Track const & track = kv.second;
+
+    routing::NumMwmId mwmId = routing::kFakeNumMwmId;
+    for (DataPoint const & point : track)
+    {
+      mwmId = pointToMwmId.FindMwmId(MercatorBounds::FromLatLon(point.m_latLon), mwmId);
+      if (mwmId != routing::kFakeNumMwmId)
+        mwmToTracks[mwmId][user].push_back(point);
+      else
+        LOG(LERROR, ("Can't match mwm region for", point.m_latLon, ", user:", user));
+    }
+  }
+
+  LOG(LINFO, ("Data was split into", mwmToTracks.size(), "mwms, elapsed:", timer.ElapsedSeconds(),
+              "seconds"));
+}
 }  // namespace
 
 namespace track_analyzing
@@ -89,11 +114,47 @@ LogParser::LogParser(shared_ptr<routing::NumMwmIds> numMwmIds,
 void LogParser::Parse(string const & logFile, MwmToTracks & mwmToTracks) const
 {
   UserToTrack userToTrack;
-  ParseUserTracks(logFile, userToTrack);
-  SplitIntoMwms(userToTrack, mwmToTracks);
+  ForEachPacket(logFile, [&userToTrack](string const & userId, Track const & packet) {
+    Track & track = userToTrack[userId];
+    track.insert(track.end(), packet.cbegin(), packet.cend());
+  });
+  LOG(LINFO, ("Users with current version:", userToTrack.size()));
+
+  PointToMwmId const pointToMwmId(m_mwmTree, *m_numMwmIds, m_dataDir);
+  SplitIntoMwms(pointToMwmId, userToTrack, mwmToTracks);
+}
+
+void LogParser::ParseByBatches(string const & logFile, size_t maxPoints,
+                               MwmToTracksFn const & fn) const
+{
+  CHECK_GREATER(maxPoints, 0, ());
+
+  PointToMwmId const pointToMwmId(m_mwmTree, *m_numMwmIds, m_dataDir);
+  UserToTrack userToTrack;
+  size_t pointsCount = 0;
+
+  auto const flush = [&]() {
+    if (userToTrack.empty())
+      return;
+
+    MwmToTracks mwmToTracks;
+    SplitIntoMwms(pointToMwmId, userToTrack, mwmToTracks);
+    userToTrack.clear();
+    pointsCount = 0;
+    fn(move(mwmToTracks));
+  };
+
+  ForEachPacket(logFile, [&](string const & userId, Track const & packet) {
+    Track & track = userToTrack[userId];
+    track.insert(track.end(), packet.cbegin(), packet.cend());
+    pointsCount += packet.size();
+    if (pointsCount >= maxPoints)
+      flush();
+  });
+  flush();
 }
 
-void LogParser::ParseUserTracks(string const & logFile, UserToTrack & userToTrack) const
+void LogParser::ForEachPacket(string const & logFile, PacketFn const & fn) const
 {
   my::Timer timer;
 
@@ -126,43 +187,13 @@ void LogParser::ParseUserTracks(string const & logFile, UserToTrack & userToTrac
 
     auto const packet = ReadDataPoints(data);
     if (!packet.empty())
-    {
-      Track & track = userToTrack[userId];
-      track.insert(track.end(), packet.cbegin(), packet.cend());
-    }
+      fn(userId, packet);
 
     pointsCount += packet.size();
   };
 
   LOG(LINFO, ("Tracks parsing finished, elapsed:", timer.ElapsedSeconds(), "seconds, lines:",
               linesCount, ", points", pointsCount));
-  LOG(LINFO, ("Users with current version:", userToTrack.size(), ", old version:",
-              usersWithOldVersion.size()));
-}
-
-void LogParser::SplitIntoMwms(UserToTrack const & userToTrack, MwmToTracks & mwmToTracks) const
-{
-  my::Timer timer;
-
-  PointToMwmId const pointToMwmId(m_mwmTree, *m_numMwmIds, m_dataDir);
-
-  for (auto const & kv : userToTrack)
-  {
-    string const & user = kv.first;
-    Track const & track = kv.second;
-
-    routing::NumMwmId mwmId = routing::kFakeNumMwmId;
-    for (DataPoint const & point : track)
-    {
-      mwmId = pointToMwmId.FindMwmId(MercatorBounds::FromLatLon(point.m_latLon), mwmId);
-      if (mwmId != routing::kFakeNumMwmId)
-        mwmToTracks[mwmId][user].push_back(point);
-      else
-        LOG(LERROR, ("Can't match mwm region for", point.m_latLon, ", user:", user));
-    }
-  }
-
-  LOG(LINFO, ("Data was split into", mwmToTracks.size(), "mwms, elapsed:", timer.ElapsedSeconds(),
-              "seconds"));
+  LOG(LINFO, ("Users with old version:", usersWithOldVersion.size()));
 }
 }  // namespace track_analyzing
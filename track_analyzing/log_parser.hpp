@@ -6,6 +6,8 @@
 
 #include "geometry/tree4d.hpp"
 
+#include <cstddef>
+#include <functional>
 #include <memory>
 #include <string>
 
@@ -17,11 +19,20 @@ public:
   LogParser(std::shared_ptr<routing::NumMwmIds> numMwmIds,
             std::unique_ptr<m4::Tree<routing::NumMwmId>> mwmTree, std::string const & dataDir);
 
+  using MwmToTracksFn = std::function<void(MwmToTracks && mwmToTracks)>;
+
   void Parse(std::string const & logFile, MwmToTracks & mwmToTracks) const;
 
+  // Parses |logFile| line by line. Tracks are split into mwms and passed to |fn| every time when
+  // parsed tracks reach |maxPoints| points, and at the end of the file. So tracks of a user may
+  // be split into several batches.
+  void ParseByBatches(std::string const & logFile, size_t maxPoints,
+                      MwmToTracksFn const & fn) const;
+
 private:
-  void ParseUserTracks(std::string const & logFile, UserToTrack & userToTrack) const;
-  void SplitIntoMwms(UserToTrack const & userToTrack, MwmToTracks & mwmToTracks) const;
+  using PacketFn = std::function<void(std::string const & userId, Track const & packet)>;
+
+  void ForEachPacket(std::string const & logFile, PacketFn const & fn) const;
 
   std::shared_ptr<routing::NumMwmIds> m_numMwmIds;
   std::shared_ptr<m4::Tree<routing::NumMwmId>> m_mwmTree;
@@ -18,8 +18,15 @@
 #include "base/logging.hpp"
 #include "base/timer.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <utility>
+#include <vector>
 
 using namespace routing;
 using namespace std;
@@ -28,63 +35,105 @@ using namespace track_analyzing;
 namespace
 {
 void MatchTracks(MwmToTracks const & mwmToTracks, storage::Storage const & storage,
-                 NumMwmIds const & numMwmIds, MwmToMatchedTracks & mwmToMatchedTracks)
+                 NumMwmIds const & numMwmIds, TrackMatcher::Mode mode, size_t numThreads,
+                 MwmToMatchedTracks & mwmToMatchedTracks)
 {
   my::Timer timer;
 
-  uint64_t tracksCount = 0;
-  uint64_t pointsCount = 0;
-  uint64_t nonMatchedPointsCount = 0;
+  struct MwmTracks
+  {
+    string m_mwmName;
+    storage::TLocalFilePtr m_localFile;
+    UserToTrack const * m_userToTrack;
+  };
 
-  auto processMwm = [&](string const & mwmName, UserToTrack const & userToTrack) {
-    auto const countryFile = platform::CountryFile(mwmName);
-    auto const mwmId = numMwmIds.GetId(countryFile);
-    TrackMatcher matcher(storage, mwmId, countryFile);
+  // Storage isn't thread-safe, so local files are found before matching.
+  vector<MwmTracks> mwms;
+  ForTracksSortedByMwmName(mwmToTracks, numMwmIds,
+                           [&](string const & mwmName, UserToTrack const & userToTrack) {
+                             auto localFile =
+                                 storage.GetLatestLocalFile(platform::CountryFile(mwmName));
+                             CHECK(localFile, ("Can't find latest country file for", mwmName));
+                             mwms.push_back({mwmName, localFile, &userToTrack});
+                           });
+
+  atomic<size_t> nextMwm(0);
+  atomic<uint64_t> tracksCount(0);
+  atomic<uint64_t> pointsCount(0);
+  atomic<uint64_t> nonMatchedPointsCount(0);
+  mutex resultMutex;
+
+  // Every mwm is matched by one thread, the matcher keeps the index graph of the mwm.
+  auto processMwms = [&]() {
+    for (size_t i = nextMwm++; i < mwms.size(); i = nextMwm++)
+    {
+      string const & mwmName = mwms[i].m_mwmName;
+      UserToTrack const & userToTrack = *mwms[i].m_userToTrack;
 
-    auto & userToMatchedTracks = mwmToMatchedTracks[mwmId];
+      auto const mwmId = numMwmIds.GetId(platform::CountryFile(mwmName));
+      TrackMatcher matcher(*mwms[i].m_localFile, mwmId, mode);
 
-    for (auto const & it : userToTrack)
-    {
-      string const & user = it.first;
-      auto & matchedTracks = userToMatchedTracks[user];
-      try
-      {
-        matcher.MatchTrack(it.second, matchedTracks);
-      }
-      catch (RootException const & e)
+      UserToMatchedTracks userToMatchedTracks;
+      for (auto const & it : userToTrack)
       {
-        LOG(LERROR, ("Can't match track for mwm:", mwmName, ", user:", user));
-        LOG(LERROR, ("  ", e.what()));
+        string const & user = it.first;
+        vector<MatchedTrack> matchedTracks;
+        try
+        {
+          matcher.MatchTrack(it.second, matchedTracks);
+        }
+        catch (RootException const & e)
+        {
+          LOG(LERROR, ("Can't match track for mwm:", mwmName, ", user:", user));
+          LOG(LERROR, ("  ", e.what()));
+        }
+
+        if (!matchedTracks.empty())
+          userToMatchedTracks[user] = move(matchedTracks);
       }
 
-      if (matchedTracks.empty())
-        userToMatchedTracks.erase(user);
-    }
-
-    if (userToMatchedTracks.empty())
-      mwmToMatchedTracks.erase(mwmId);
+      tracksCount += matcher.GetTracksCount();
+      pointsCount += matcher.GetPointsCount();
+      nonMatchedPointsCount += matcher.GetNonMatchedPointsCount();
 
-    tracksCount += matcher.GetTracksCount();
-    pointsCount += matcher.GetPointsCount();
-    nonMatchedPointsCount += matcher.GetNonMatchedPointsCount();
+      LOG(LINFO, (mwmName, ", users:", userToTrack.size(), ", tracks:", matcher.GetTracksCount(),
+                  ", points:", matcher.GetPointsCount(),
+                  ", non matched points:", matcher.GetNonMatchedPointsCount()));
 
-    LOG(LINFO, (numMwmIds.GetFile(mwmId).GetName(), ", users:", userToTrack.size(), ", tracks:",
-                matcher.GetTracksCount(), ", points:", matcher.GetPointsCount(),
-                ", non matched points:", matcher.GetNonMatchedPointsCount()));
+      if (!userToMatchedTracks.empty())
+      {
+        lock_guard<mutex> lock(resultMutex);
+        mwmToMatchedTracks[mwmId] = move(userToMatchedTracks);
+      }
+    }
   };
 
-  ForTracksSortedByMwmName(mwmToTracks, numMwmIds, processMwm);
-
-  LOG(LINFO,
-      ("Matching finished, elapsed:", timer.ElapsedSeconds(), "seconds, tracks:", tracksCount,
-       ", points:", pointsCount, ", non matched points:", nonMatchedPointsCount));
+  numThreads = max(min(numThreads, mwms.size()), static_cast<size_t>(1));
+  vector<thread> workers;
+  for (size_t i = 1; i < numThreads; ++i)
+    workers.emplace_back(processMwms);
+  processMwms();
+  for (auto & worker : workers)
+    worker.join();
+
+  double const elapsed = timer.ElapsedSeconds();
+  uint64_t const points = pointsCount.load();
+  uint64_t const nonMatchedPoints = nonMatchedPointsCount.load();
+  LOG(LINFO, ("Matching finished, elapsed:", elapsed, "seconds, tracks:", tracksCount.load(),
+              ", points:", points, ", non matched points:", nonMatchedPoints));
+  if (elapsed > 0.0 && points > 0)
+  {
+    LOG(LINFO, ("Points per second:", static_cast<double>(points) / elapsed,
+                ", matched points:",
+                100.0 * static_cast<double>(points - nonMatchedPoints) / points, "%"));
+  }
 }
-
 }  // namespace
 
 namespace track_analyzing
 {
-void CmdMatch(string const & logFile, string const & trackFile)
+void CmdMatch(string const & logFile, string const & trackFile, TrackMatcher::Mode mode,
+              size_t numThreads, size_t batchPoints)
 {
   LOG(LINFO, ("Matching", logFile));
 
@@ -99,16 +148,25 @@ void CmdMatch(string const & logFile, string const & trackFile)
       storage::CountryInfoReader::CreateCountryInfoReader(platform);
   unique_ptr<m4::Tree<NumMwmId>> mwmTree = MakeNumMwmTree(*numMwmIds, *countryInfoGetter);
 
+  FileWriter writer(trackFile, FileWriter::OP_WRITE_TRUNCATE);
+  MwmToMatchedTracksSerializer serializer(numMwmIds);
+
+  // Logs are parsed, matched and written by batches of points, so the memory
+  // doesn't depend on the size of the log.
   LogParser parser(numMwmIds, move(mwmTree), dataDir);
-  MwmToTracks mwmToTracks;
-  parser.Parse(logFile, mwmToTracks);
+  size_t batchesCount = 0;
+  parser.ParseByBatches(logFile, batchPoints, [&](MwmToTracks && mwmToTracks) {
+    MwmToMatchedTracks mwmToMatchedTracks;
+    MatchTracks(mwmToTracks, storage, *numMwmIds, mode, numThreads, mwmToMatchedTracks);
+    mwmToTracks.clear();
 
-  MwmToMatchedTracks mwmToMatchedTracks;
-  MatchTracks(mwmToTracks, storage, *numMwmIds, mwmToMatchedTracks);
+    if (mwmToMatchedTracks.empty())
+      return;
 
-  FileWriter writer(trackFile, FileWriter::OP_WRITE_TRUNCATE);
-  MwmToMatchedTracksSerializer serializer(numMwmIds);
-  serializer.Serialize(mwmToMatchedTracks, writer);
-  LOG(LINFO, ("Matched tracks were saved to", trackFile));
+    serializer.Serialize(mwmToMatchedTracks, writer);
+    ++batchesCount;
+  });
+
+  LOG(LINFO, ("Matched tracks were saved to", trackFile, ", batches:", batchesCount));
 }
 }  // namespace track_analyzing
@@ -1,5 +1,6 @@
 #include "track_analyzing/exceptions.hpp"
 #include "track_analyzing/track.hpp"
+#include "track_analyzing/track_matcher.hpp"
 #include "track_analyzing/utils.hpp"
 
 #include "indexer/classificator.hpp"
@@ -7,6 +8,8 @@
 
 #include "3party/gflags/src/gflags/gflags.h"
 
+#include <algorithm>
+
 using namespace std;
 using namespace track_analyzing;
 
@@ -41,6 +44,11 @@ DEFINE_double(min_speed, 15.0, "minimum track average speed in km/hour");
 DEFINE_double(max_speed, 110.0, "maximum track average speed in km/hour");
 DEFINE_bool(ignore_traffic, true, "ignore tracks with traffic data");
 
+DEFINE_string(matching_mode, "greedy", "track matching mode: greedy, hmm");
+DEFINE_int32(num_threads, 1, "number of threads to match tracks");
+DEFINE_uint64(batch_points, 10 * 1000 * 1000,
+              "number of log points parsed and matched at once, bounds the memory");
+
 size_t Checked_track()
 {
   if (FLAGS_track < 0)
@@ -49,6 +57,16 @@ size_t Checked_track()
   return static_cast<size_t>(FLAGS_track);
 }
 
+TrackMatcher::Mode Checked_matching_mode()
+{
+  if (FLAGS_matching_mode == "greedy")
+    return TrackMatcher::Mode::Greedy;
+  if (FLAGS_matching_mode == "hmm")
+    return TrackMatcher::Mode::Hmm;
+
+  MYTHROW(MessageException, ("Unknown --matching_mode", FLAGS_matching_mode));
+}
+
 StringFilter MakeFilter(string const & filter)
 {
   return [&](string const & value) {
@@ -65,7 +83,8 @@ namespace track_analyzing
 void CmdCppTrack(string const & trackFile, string const & mwmName, string const & user,
                  size_t trackIdx);
 // Match raw gps logs to tracks.
-void CmdMatch(string const & logFile, string const & trackFile);
+void CmdMatch(string const & logFile, string const & trackFile, TrackMatcher::Mode mode,
+              size_t numThreads, size_t batchPoints);
 // Print aggregated tracks to csv table.
 void CmdTagsTable(string const & filepath, string const & trackExtension,
                   StringFilter mwmIsFiltered, StringFilter userFilter);
@@ -91,7 +110,10 @@ int main(int argc, char ** argv)
     if (cmd == "match")
     {
       string const & logFile = Checked_in();
-      CmdMatch(logFile, FLAGS_out.empty() ? logFile + ".track" : FLAGS_out);
+      CmdMatch(logFile, FLAGS_out.empty() ? logFile + ".track" : FLAGS_out,
+               Checked_matching_mode(),
+               static_cast<size_t>(max(FLAGS_num_threads, 1)),
+               max(static_cast<size_t>(FLAGS_batch_points), static_cast<size_t>(1)));
     }
     else if (cmd == "tracks")
     {
@@ -10,6 +10,13 @@
 
 #include <geometry/distance.hpp>
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <queue>
+#include <utility>
+
 using namespace routing;
 using namespace std;
 using namespace track_analyzing;
@@ -19,6 +26,26 @@ namespace
 // Matching range in meters.
 double constexpr kMatchingRange = 20.0;
 
+// Hmm mode parameters.
+// Standard deviation of gps error in meters.
+double constexpr kGpsSigma = 5.0;
+// Scale of difference between route and great circle distances in meters.
+double constexpr kTransitionBeta = 10.0;
+// Routes between candidates longer than kMaxDetourFactor * great circle distance + kMaxDetour
+// aren't considered.
+double constexpr kMaxDetourFactor = 2.0;
+double constexpr kMaxDetour = 2.0 * kMatchingRange + 100.0;
+// Number of the most probable states kept for every step.
+size_t constexpr kBeamWidth = 16;
+
+storage::TLocalFilePtr CheckedLatestLocalFile(storage::Storage const & storage,
+                                              platform::CountryFile const & countryFile)
+{
+  auto localCountryFile = storage.GetLatestLocalFile(countryFile);
+  CHECK(localCountryFile, ("Can't find latest country file for", countryFile.GetName()));
+  return localCountryFile;
+}
+
 // Mercator distance from segment to point in meters.
 double DistanceToSegment(m2::PointD const & segmentBegin, m2::PointD const & segmentEnd,
                          m2::PointD const & point)
@@ -45,25 +72,132 @@ bool EdgesContain(vector<SegmentEdge> const & edges, Segment const & segment)
 
   return false;
 }
+
+m2::PointD const & GetSegmentPoint(Segment const & segment, bool front, IndexGraph & graph)
+{
+  return graph.GetGeometry().GetPoint(segment.GetRoadPoint(front));
+}
+
+m2::PointD Project(Segment const & segment, m2::PointD const & point, IndexGraph & graph)
+{
+  m2::ProjectionToSection<m2::PointD> projection;
+  projection.SetBounds(GetSegmentPoint(segment, false /* front */, graph),
+                       GetSegmentPoint(segment, true /* front */, graph));
+  return projection(point);
+}
+
+// Finds distances in meters from the end of |source| to the beginnings of segments reachable
+// within |maxDistance| by Dijkstra algorithm.
+void FindRouteDistances(Segment const & source, double maxDistance, IndexGraph & graph,
+                        map<Segment, double> & distances)
+{
+  using State = pair<double, Segment>;
+  priority_queue<State, vector<State>, greater<State>> queue;
+  map<Segment, double> reached;
+  vector<SegmentEdge> edges;
+
+  distances.clear();
+  reached[source] = 0.0;
+  queue.emplace(0.0, source);
+
+  while (!queue.empty())
+  {
+    State const state = queue.top();
+    queue.pop();
+
+    double const distance = state.first;
+    Segment const & segment = state.second;
+    if (distance > reached[segment])
+      continue;
+
+    edges.clear();
+    graph.GetEdgeList(segment, true /* isOutgoing */, edges);
+    for (SegmentEdge const & edge : edges)
+    {
+      Segment const & target = edge.GetTarget();
+      auto const it = distances.find(target);
+      if (it == distances.end() || distance < it->second)
+        distances[target] = distance;
+
+      double const targetDistance =
+          distance + MercatorBounds::DistanceOnEarth(GetSegmentPoint(target, false, graph),
+                                                     GetSegmentPoint(target, true, graph));
+      if (targetDistance > maxDistance)
+        continue;
+
+      auto const reachedIt = reached.find(target);
+      if (reachedIt != reached.end() && reachedIt->second <= targetDistance)
+        continue;
+
+      reached[target] = targetDistance;
+      queue.emplace(targetDistance, target);
+    }
+  }
+}
+
+double EmissionCost(double distance)
+{
+  double const x = distance / kGpsSigma;
+  return 0.5 * x * x;
+}
+
+double TransitionCost(double routeDistance, double greatCircleDistance)
+{
+  return fabs(routeDistance - greatCircleDistance) / kTransitionBeta;
+}
+
+struct HmmState
+{
+  HmmState(size_t candidate, double cost, size_t parent)
+    : m_candidate(candidate), m_cost(cost), m_parent(parent)
+  {
+  }
+
+  bool operator<(HmmState const & rhs) const { return m_cost < rhs.m_cost; }
+
+  // Index of the candidate of the step.
+  size_t m_candidate;
+  // Negative log probability of the most probable path to the state.
+  double m_cost;
+  // Index of the previous state in the previous layer.
+  size_t m_parent;
+};
+
+void PruneStates(vector<HmmState> & states)
+{
+  if (states.size() <= kBeamWidth)
+    return;
+
+  nth_element(states.begin(), states.begin() + kBeamWidth - 1, states.end());
+  states.erase(states.begin() + kBeamWidth, states.end());
+}
 }  // namespace
 
 namespace track_analyzing
 {
 // TrackMatcher ------------------------------------------------------------------------------------
 TrackMatcher::TrackMatcher(storage::Storage const & storage, NumMwmId mwmId,
-                           platform::CountryFile const & countryFile)
+                           platform::CountryFile const & countryFile, Mode mode)
+  : TrackMatcher(*CheckedLatestLocalFile(storage, countryFile), mwmId, mode)
+{
+}
+
+TrackMatcher::TrackMatcher(platform::LocalCountryFile const & localCountryFile, NumMwmId mwmId,
+                           Mode mode)
   : m_mwmId(mwmId)
-  , m_vehicleModel(CarModelFactory({}).GetVehicleModelForCountry(countryFile.GetName()))
+  , m_mode(mode)
+  , m_vehicleModel(CarModelFactory({}).GetVehicleModelForCountry(
+        localCountryFile.GetCountryFile().GetName()))
 {
-  auto localCountryFile = storage.GetLatestLocalFile(countryFile);
-  CHECK(localCountryFile, ("Can't find latest country file for", countryFile.GetName()));
-  auto registerResult = m_index.Register(*localCountryFile);
+  auto const & countryFile = localCountryFile.GetCountryFile();
+  auto registerResult = m_index.Register(localCountryFile);
   CHECK_EQUAL(registerResult.second, MwmSet::RegResult::Success,
               ("Can't register mwm", countryFile.GetName()));
 
   MwmSet::MwmHandle const handle = m_index.GetMwmHandleByCountryFile(countryFile);
   m_graph = make_unique<IndexGraph>(
-      GeometryLoader::Create(m_index, handle, m_vehicleModel, false /* loadAltitudes */),
+      GeometryLoader::Create(m_index, handle, m_vehicleModel, nullptr /* roadSpeeds */,
+                             false /* loadAltitudes */),
       EdgeEstimator::Create(VehicleType::Car, m_vehicleModel->GetMaxSpeed(),
                             nullptr /* trafficStash */));
 
@@ -79,18 +213,18 @@ void TrackMatcher::MatchTrack(vector<DataPoint> const & track, vector<MatchedTra
   for (auto const & routePoint : track)
     steps.emplace_back(routePoint);
 
-  for (size_t trackBegin = 0; trackBegin < steps.size();)
+  switch (m_mode)
   {
-    for (; trackBegin < steps.size(); ++trackBegin)
-    {
-      steps[trackBegin].FillCandidatesWithNearbySegments(m_index, *m_graph, *m_vehicleModel,
-                                                         m_mwmId);
-      if (steps[trackBegin].HasCandidates())
-        break;
-
-      ++m_nonMatchedPointsCount;
-    }
+  case Mode::Greedy: MatchTrackGreedy(steps, matchedTracks); break;
+  case Mode::Hmm: MatchTrackHmm(steps, matchedTracks); break;
+  }
+}
 
+void TrackMatcher::MatchTrackGreedy(vector<Step> & steps, vector<MatchedTrack> & matchedTracks)
+{
+  for (size_t trackBegin = 0; trackBegin < steps.size();)
+  {
+    trackBegin = SkipNonMatchedSteps(steps, trackBegin);
     if (trackBegin >= steps.size())
       break;
 
@@ -109,20 +243,157 @@ void TrackMatcher::MatchTrack(vector<DataPoint> const & track, vector<MatchedTra
     for (size_t i = trackEnd; i > trackBegin; --i)
       steps[i - 1].ChooseSegment(steps[i], *m_graph);
 
-    ++m_tracksCount;
+    AddMatchedTrack(steps, trackBegin, trackEnd, matchedTracks);
+    trackBegin = trackEnd + 1;
+  }
+}
+
+void TrackMatcher::MatchTrackHmm(vector<Step> & steps, vector<MatchedTrack> & matchedTracks)
+{
+  // layers[i] keeps the most probable states of the step trackBegin + i.
+  vector<vector<HmmState>> layers;
+  map<Segment, double> routeDistances;
+
+  for (size_t trackBegin = 0; trackBegin < steps.size();)
+  {
+    trackBegin = SkipNonMatchedSteps(steps, trackBegin);
+    if (trackBegin >= steps.size())
+      break;
 
-    matchedTracks.push_back({});
-    MatchedTrack & matchedTrack = matchedTracks.back();
-    for (size_t i = trackBegin; i <= trackEnd; ++i)
+    layers.clear();
+    layers.emplace_back();
+    auto const & firstCandidates = steps[trackBegin].GetCandidates();
+    for (size_t i = 0; i < firstCandidates.size(); ++i)
     {
-      Step const & step = steps[i];
-      matchedTrack.emplace_back(step.GetDataPoint(), step.GetSegment());
+      layers.back().emplace_back(i, EmissionCost(firstCandidates[i].GetDistance()),
+                                 numeric_limits<size_t>::max());
     }
+    PruneStates(layers.back());
 
+    size_t trackEnd = trackBegin;
+    for (; trackEnd + 1 < steps.size(); ++trackEnd)
+    {
+      Step const & prevStep = steps[trackEnd];
+      Step & nextStep = steps[trackEnd + 1];
+      nextStep.FillCandidatesWithNearbySegments(m_index, *m_graph, *m_vehicleModel, m_mwmId);
+      if (!nextStep.HasCandidates())
+        break;
+
+      auto const & prevCandidates = prevStep.GetCandidates();
+      auto const & nextCandidates = nextStep.GetCandidates();
+      double const greatCircleDistance =
+          MercatorBounds::DistanceOnEarth(prevStep.GetPoint(), nextStep.GetPoint());
+      double const maxDistance = kMaxDetourFactor * greatCircleDistance + kMaxDetour;
+
+      vector<HmmState> nextLayer;
+      vector<HmmState> const & prevLayer = layers.back();
+      for (size_t i = 0; i < nextCandidates.size(); ++i)
+        nextLayer.emplace_back(i, numeric_limits<double>::max(), numeric_limits<size_t>::max());
+
+      vector<m2::PointD> nextProjections;
+      for (auto const & candidate : nextCandidates)
+        nextProjections.push_back(Project(candidate.GetSegment(), nextStep.GetPoint(), *m_graph));
+
+      for (size_t prevIdx = 0; prevIdx < prevLayer.size(); ++prevIdx)
+      {
+        HmmState const & prevState = prevLayer[prevIdx];
+        Segment const & source = prevCandidates[prevState.m_candidate].GetSegment();
+        m2::PointD const sourceProjection = Project(source, prevStep.GetPoint(), *m_graph);
+        double const toSourceEnd = MercatorBounds::DistanceOnEarth(
+            sourceProjection, GetSegmentPoint(source, true /* front */, *m_graph));
+
+        FindRouteDistances(source, maxDistance, *m_graph, routeDistances);
+
+        for (size_t nextIdx = 0; nextIdx < nextCandidates.size(); ++nextIdx)
+        {
+          Segment const & target = nextCandidates[nextIdx].GetSegment();
+          double routeDistance = 0.0;
+          if (target == source)
+          {
+            routeDistance =
+                MercatorBounds::DistanceOnEarth(sourceProjection, nextProjections[nextIdx]);
+          }
+          else
+          {
+            auto const it = routeDistances.find(target);
+            if (it == routeDistances.end())
+              continue;
+
+            routeDistance = toSourceEnd + it->second +
+                            MercatorBounds::DistanceOnEarth(
+                                GetSegmentPoint(target, false /* front */, *m_graph),
+                                nextProjections[nextIdx]);
+          }
+
+          double const cost = prevState.m_cost +
+                              TransitionCost(routeDistance, greatCircleDistance) +
+                              EmissionCost(nextCandidates[nextIdx].GetDistance());
+          if (cost < nextLayer[nextIdx].m_cost)
+          {
+            nextLayer[nextIdx].m_cost = cost;
+            nextLayer[nextIdx].m_parent = prevIdx;
+          }
+        }
+      }
+
+      nextLayer.erase(remove_if(nextLayer.begin(), nextLayer.end(),
+                                [](HmmState const & state) {
+                                  return state.m_parent == numeric_limits<size_t>::max();
+                                }),
+                      nextLayer.end());
+      // The track is broken when no candidate is reachable, the next step starts a new track.
+      if (nextLayer.empty())
+        break;
+
+      PruneStates(nextLayer);
+      layers.push_back(move(nextLayer));
+    }
+
+    CHECK_EQUAL(layers.size(), trackEnd - trackBegin + 1, ());
+    size_t stateIdx = static_cast<size_t>(
+        min_element(layers.back().begin(), layers.back().end()) - layers.back().begin());
+    for (size_t i = layers.size(); i > 0; --i)
+    {
+      HmmState const & state = layers[i - 1][stateIdx];
+      Step & step = steps[trackBegin + i - 1];
+      step.SetSegment(step.GetCandidates()[state.m_candidate].GetSegment());
+      stateIdx = state.m_parent;
+    }
+
+    AddMatchedTrack(steps, trackBegin, trackEnd, matchedTracks);
     trackBegin = trackEnd + 1;
   }
 }
 
+size_t TrackMatcher::SkipNonMatchedSteps(vector<Step> & steps, size_t trackBegin)
+{
+  for (; trackBegin < steps.size(); ++trackBegin)
+  {
+    Step & step = steps[trackBegin];
+    if (!step.HasCandidates())
+      step.FillCandidatesWithNearbySegments(m_index, *m_graph, *m_vehicleModel, m_mwmId);
+    if (step.HasCandidates())
+      break;
+
+    ++m_nonMatchedPointsCount;
+  }
+  return trackBegin;
+}
+
+void TrackMatcher::AddMatchedTrack(vector<Step> const & steps, size_t trackBegin,
+                                   size_t trackEnd, vector<MatchedTrack> & matchedTracks)
+{
+  ++m_tracksCount;
+
+  matchedTracks.push_back({});
+  MatchedTrack & matchedTrack = matchedTracks.back();
+  for (size_t i = trackBegin; i <= trackEnd; ++i)
+  {
+    Step const & step = steps[i];
+    matchedTrack.emplace_back(step.GetDataPoint(), step.GetSegment());
+  }
+}
+
 // TrackMatcher::Step ------------------------------------------------------------------------------
 TrackMatcher::Step::Step(DataPoint const & dataPoint)
   : m_dataPoint(dataPoint), m_point(MercatorBounds::FromLatLon(dataPoint.m_latLon))
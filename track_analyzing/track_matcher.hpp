@@ -21,8 +21,20 @@ namespace track_analyzing
 class TrackMatcher final
 {
 public:
+  enum class Mode
+  {
+    // Every point is matched to the nearest segment connected with the segment of the next point.
+    Greedy,
+    // Hidden Markov model: the most probable sequence of segments is found by Viterbi algorithm,
+    // transitions are weighted by difference between route and great circle distances.
+    Hmm
+  };
+
   TrackMatcher(storage::Storage const & storage, routing::NumMwmId mwmId,
-               platform::CountryFile const & countryFile);
+               platform::CountryFile const & countryFile, Mode mode = Mode::Greedy);
+  // Doesn't use storage, so matchers of different mwms may be created on different threads.
+  TrackMatcher(platform::LocalCountryFile const & localCountryFile, routing::NumMwmId mwmId,
+               Mode mode = Mode::Greedy);
 
   void MatchTrack(std::vector<DataPoint> const & track, std::vector<MatchedTrack> & matchedTracks);
 
@@ -31,6 +43,16 @@ public:
   uint64_t GetNonMatchedPointsCount() const { return m_nonMatchedPointsCount; }
 
 private:
+  class Step;
+
+  void MatchTrackGreedy(std::vector<Step> & steps, std::vector<MatchedTrack> & matchedTracks);
+  void MatchTrackHmm(std::vector<Step> & steps, std::vector<MatchedTrack> & matchedTracks);
+  // Finds candidate segments for steps starting from |trackBegin|, returns the index of the
+  // first step with candidates.
+  size_t SkipNonMatchedSteps(std::vector<Step> & steps, size_t trackBegin);
+  void AddMatchedTrack(std::vector<Step> const & steps, size_t trackBegin, size_t trackEnd,
+                       std::vector<MatchedTrack> & matchedTracks);
+
   class Candidate final
   {
   public:
@@ -54,8 +76,11 @@ private:
     explicit Step(DataPoint const & dataPoint);
 
     DataPoint const & GetDataPoint() const { return m_dataPoint; }
+    m2::PointD const & GetPoint() const { return m_point; }
     routing::Segment const & GetSegment() const { return m_segment; }
+    std::vector<Candidate> const & GetCandidates() const { return m_candidates; }
     bool HasCandidates() const { return !m_candidates.empty(); }
+    void SetSegment(routing::Segment const & segment) { m_segment = segment; }
     void FillCandidatesWithNearbySegments(Index const & index, routing::IndexGraph const & graph,
                                           routing::VehicleModelInterface const & vehicleModel,
                                           routing::NumMwmId mwmId);
@@ -74,6 +99,7 @@ private:
   };
 
   routing::NumMwmId const m_mwmId;
+  Mode const m_mode;
   Index m_index;
   std::shared_ptr<routing::VehicleModelInterface> m_vehicleModel;
   std::unique_ptr<routing::IndexGraph> m_graph;
@@ -8,7 +8,9 @@
 
 #include "coding/file_name_utils.hpp"
 
+#include <algorithm>
 #include <cstdint>
+#include <iterator>
 
 using namespace routing;
 using namespace std;
@@ -55,7 +57,23 @@ void ReadTracks(shared_ptr<NumMwmIds> numMwmIds, string const & filename,
   FileReader reader(filename);
   ReaderSource<FileReader> src(reader);
   MwmToMatchedTracksSerializer serializer(numMwmIds);
-  serializer.Deserialize(mwmToMatchedTracks, src);
+
+  // Tracks are written by batches, tracks of the same mwm and user may be in several batches.
+  mwmToMatchedTracks.clear();
+  MwmToMatchedTracks batch;
+  while (src.Size() > 0)
+  {
+    serializer.Deserialize(batch, src);
+    for (auto & mwmIt : batch)
+    {
+      UserToMatchedTracks & userToMatchedTracks = mwmToMatchedTracks[mwmIt.first];
+      for (auto & userIt : mwmIt.second)
+      {
+        vector<MatchedTrack> & tracks = userToMatchedTracks[userIt.first];
+        move(userIt.second.begin(), userIt.second.end(), back_inserter(tracks));
+      }
+    }
+  }
 }
 
 MatchedTrack const & GetMatchedTrack(MwmToMatchedTracks const & mwmToMatchedTracks,
@@ -55,12 +55,12 @@ void Connection::Shutdown()
 }
 
 // TODO: implement historical
-bool Connection::Send(boost::circular_buffer<DataPoint> const & points)
+bool Connection::Send(boost::circular_buffer<DataPoint> const & points, Protocol::PacketType type)
 {
   if (!m_socket)
     return false;
 
-  auto packet = Protocol::CreateDataPacket(points, tracking::Protocol::PacketType::CurrentData);
+  auto packet = Protocol::CreateDataPacket(points, type);
   return m_socket->Write(packet.data(), static_cast<uint32_t>(packet.size()));
 }
 }  // namespace tracking
@@ -33,6 +33,8 @@ public:
     AuthV0 = 0x81,
     DataV0 = 0x82,
     DataV1 = 0x92,
+    // Points of DataV1 compressed by zlib. It's worth for big batches only.
+    DataV2 = 0xA2,
 
     CurrentAuth = AuthV0,
     CurrentData = DataV1
@@ -4,11 +4,16 @@
 #include "platform/platform.hpp"
 #include "platform/socket.hpp"
 
+#include "coding/file_reader.hpp"
+#include "coding/file_writer.hpp"
+#include "coding/internal/file_data.hpp"
+
 #include "3party/Alohalytics/src/alohalytics.h"
 
 #include "base/logging.hpp"
 #include "base/timer.hpp"
 
+#include "std/algorithm.hpp"
 #include "std/target_os.hpp"
 
 namespace
@@ -18,6 +23,73 @@ double constexpr kMinDelaySeconds = 1.0;
 double constexpr kReconnectDelaySeconds = 60.0;
 double constexpr kNotChargingEventPeriod = 5 * 60.0;
 size_t constexpr kRealTimeBufferSize = 60;
+
+// Reads points saved by WriteSpool. Returns false when there is no consistent spool at |path|.
+bool ReadSpool(string const & path, tracking::Protocol::DataElementsVec & points)
+{
+  using tracking::Protocol;
+
+  if (!Platform::IsFileExistsByFullPath(path))
+    return false;
+
+  vector<uint8_t> data;
+  try
+  {
+    FileReader reader(path);
+    data.resize(static_cast<size_t>(reader.Size()));
+    reader.Read(0 /* pos */, data.data(), data.size());
+  }
+  catch (RootException const & e)
+  {
+    LOG(LWARNING, ("Can't read tracking spool", path, e.Msg()));
+    return false;
+  }
+
+  if (data.size() < sizeof(uint32_t /* header */))
+    return false;
+
+  auto const header = Protocol::DecodeHeader(data);
+  if (header.first != Protocol::PacketType::DataV1 ||
+      header.second != data.size() - sizeof(uint32_t /* header */))
+  {
+    LOG(LWARNING, ("Tracking spool", path, "is corrupted"));
+    return false;
+  }
+
+  data.erase(data.begin(), data.begin() + sizeof(uint32_t /* header */));
+  points = Protocol::DecodeDataPacket(header.first, data);
+  return true;
+}
+
+// Points are saved as a DataV1 packet. A temporary file is renamed to |path|,
+// so the spool is consistent even if the app is killed while writing.
+void WriteSpool(string const & path, boost::circular_buffer<tracking::DataPoint> const & points)
+{
+  using tracking::Protocol;
+
+  if (points.empty())
+  {
+    if (Platform::IsFileExistsByFullPath(path))
+      my::DeleteFileX(path);
+    return;
+  }
+
+  auto const packet = Protocol::CreateDataPacket(points, Protocol::PacketType::DataV1);
+  string const tmpPath = path + ".tmp";
+  try
+  {
+    FileWriter writer(tmpPath);
+    writer.Write(packet.data(), packet.size());
+  }
+  catch (RootException const & e)
+  {
+    LOG(LWARNING, ("Can't write tracking spool", tmpPath, e.Msg()));
+    return;
+  }
+
+  if (!my::RenameFileX(tmpPath, path))
+    LOG(LWARNING, ("Can't rename", tmpPath, "to", path));
+}
 } // namespace
 
 namespace tracking
@@ -76,6 +148,36 @@ void Reporter::AddLocation(location::GpsInfo const & info, traffic::SpeedGroup t
                 static_cast<std::underlying_type<traffic::SpeedGroup>::type>(traffic)));
 }
 
+void Reporter::SetBatching(size_t minPoints, milliseconds maxDelay)
+{
+  lock_guard<mutex> lg(m_mutex);
+  m_minBatchPoints = max(minPoints, static_cast<size_t>(1));
+  m_maxBatchDelay = maxDelay;
+}
+
+void Reporter::SetDataPacketType(Protocol::PacketType type)
+{
+  ASSERT(type != Protocol::PacketType::AuthV0, ());
+  lock_guard<mutex> lg(m_mutex);
+  m_dataPacketType = type;
+}
+
+void Reporter::SetSpoolPath(string const & path)
+{
+  Protocol::DataElementsVec points;
+  bool const hasSpool = ReadSpool(path, points);
+
+  lock_guard<mutex> lg(m_mutex);
+  m_spoolPath = path;
+  if (!hasSpool)
+    return;
+
+  LOG(LINFO, ("Tracking points from spool:", points.size()));
+  m_input.insert(m_input.begin(), points.begin(), points.end());
+  if (!points.empty())
+    m_lastGpsTime = max(m_lastGpsTime, static_cast<double>(points.back().m_timestamp));
+}
+
 void Reporter::Run()
 {
   LOG(LINFO, ("Tracking Reporter started"));
@@ -86,20 +188,40 @@ void Reporter::Run()
   {
     auto const startTime = steady_clock::now();
 
+    if (m_points.capacity() < m_minBatchPoints)
+      m_points.set_capacity(m_minBatchPoints);
+
     // Fetch input.
-    m_points.insert(m_points.end(), m_input.begin(), m_input.end());
-    m_input.clear();
+    if (!m_input.empty())
+    {
+      if (m_points.empty())
+        m_batchStartTime = startTime;
+      m_points.insert(m_points.end(), m_input.begin(), m_input.end());
+      m_input.clear();
+      m_spoolChanged = true;
+    }
+
+    size_t const minBatchPoints = m_minBatchPoints;
+    milliseconds const maxBatchDelay = m_maxBatchDelay;
+    Protocol::PacketType const dataPacketType = m_dataPacketType;
+    string const spoolPath = m_spoolPath;
 
     lock.unlock();
     if (m_points.empty() && m_idleFn)
     {
       m_idleFn();
     }
-    else
+    else if (IsBatchReady(minBatchPoints, maxBatchDelay))
     {
-      if (SendPoints())
+      if (SendPoints(dataPacketType))
+      {
         m_points.clear();
+        m_spoolChanged = true;
+      }
     }
+
+    if (!spoolPath.empty())
+      UpdateSpool(spoolPath);
     lock.lock();
 
     auto const passedMs = duration_cast<milliseconds>(steady_clock::now() - startTime);
@@ -107,10 +229,36 @@ void Reporter::Run()
       m_cv.wait_for(lock, m_pushDelay - passedMs, [this]{return m_isFinished;});
   }
 
+  // Points which are collected after the last iteration are kept till the next start.
+  if (!m_spoolPath.empty())
+  {
+    m_points.insert(m_points.end(), m_input.begin(), m_input.end());
+    m_spoolChanged = m_spoolChanged || !m_input.empty();
+    m_input.clear();
+    UpdateSpool(m_spoolPath);
+  }
+
   LOG(LINFO, ("Tracking Reporter finished"));
 }
 
-bool Reporter::SendPoints()
+bool Reporter::IsBatchReady(size_t minPoints, milliseconds maxDelay) const
+{
+  if (m_points.empty())
+    return false;
+
+  return m_points.size() >= minPoints || steady_clock::now() - m_batchStartTime >= maxDelay;
+}
+
+void Reporter::UpdateSpool(string const & path)
+{
+  if (!m_spoolChanged)
+    return;
+
+  WriteSpool(path, m_points);
+  m_spoolChanged = false;
+}
+
+bool Reporter::SendPoints(Protocol::PacketType type)
 {
   if (!m_allowSendingPoints)
   {
@@ -126,7 +274,7 @@ bool Reporter::SendPoints()
     return true;
 
   if (m_wasConnected)
-    m_wasConnected = m_realtimeSender.Send(m_points);
+    m_wasConnected = m_realtimeSender.Send(m_points, type);
 
   if (m_wasConnected)
     return true;
@@ -141,7 +289,7 @@ bool Reporter::SendPoints()
   if (!m_wasConnected)
     return false;
 
-  m_wasConnected = m_realtimeSender.Send(m_points);
+  m_wasConnected = m_realtimeSender.Send(m_points, type);
   return m_wasConnected;
 }
 }  // namespace tracking
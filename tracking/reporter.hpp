@@ -1,6 +1,7 @@
 #pragma once
 
 #include "tracking/connection.hpp"
+#include "tracking/protocol.hpp"
 
 #include "traffic/speed_groups.hpp"
 
@@ -43,11 +44,28 @@ public:
 
   void SetAllowSendingPoints(bool allow) { m_allowSendingPoints = allow; }
 
+  // Points are sent by batches: when at least |minPoints| points are collected or when
+  // the first collected point waits for |maxDelay|. Up to max(|minPoints|, 60) last points
+  // are kept while they can't be sent. By default every point is sent as soon as possible.
+  void SetBatching(size_t minPoints, milliseconds maxDelay);
+
+  // Sets type of data packets, e.g. Protocol::PacketType::DataV2 to compress big batches.
+  void SetDataPacketType(Protocol::PacketType type);
+
+  // Points which are not sent yet are kept in the file at |path|, so they are sent after
+  // restart of the app. Points of the file are sent first.
+  void SetSpoolPath(string const & path);
+
   inline void SetIdleFunc(function<void()> fn) { m_idleFn = fn; }
 
 private:
   void Run();
-  bool SendPoints();
+  bool SendPoints(Protocol::PacketType type);
+  bool IsBatchReady(size_t minPoints, milliseconds maxDelay) const;
+
+  // Rewrites the spool file with the points which are not sent yet,
+  // removes the file when there are no such points.
+  void UpdateSpool(string const & path);
 
   atomic<bool> m_allowSendingPoints;
   Connection m_realtimeSender;
@@ -62,6 +80,16 @@ private:
   vector<DataPoint> m_input;
   // Last collected points, sends periodically to server.
   boost::circular_buffer<DataPoint> m_points;
+  // Time when the first point of |m_points| was collected.
+  steady_clock::time_point m_batchStartTime;
+  // True when the spool file doesn't correspond to |m_points|.
+  bool m_spoolChanged = false;
+
+  // Settings of the worker thread, they're guarded by |m_mutex|.
+  size_t m_minBatchPoints = 1;
+  milliseconds m_maxBatchDelay = milliseconds(0);
+  Protocol::PacketType m_dataPacketType = Protocol::PacketType::CurrentData;
+  string m_spoolPath;
   double m_lastGpsTime = 0.0;
   bool m_isFinished = false;
   mutex m_mutex;
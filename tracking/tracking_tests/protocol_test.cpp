@@ -104,4 +104,25 @@ UNIT_TEST(Protocol_DecodeDataPacket)
 
   DecodeDataPacketVersionTest(points, Protocol::PacketType::DataV0);
   DecodeDataPacketVersionTest(points, Protocol::PacketType::DataV1);
+  DecodeDataPacketVersionTest(points, Protocol::PacketType::DataV2);
+}
+
+UNIT_TEST(Protocol_CompressedDataPacket)
+{
+  using Container = Protocol::DataElementsVec;
+
+  // Points of a vehicle moving along a line, they're compressed well.
+  Container points;
+  for (uint64_t i = 0; i < 1000; ++i)
+    points.push_back(Container::value_type(i * 5, ms::LatLon(55.0 + i * 1e-4, 37.0), 1));
+
+  auto const packetV1 = Protocol::CreateDataPacket(points, Protocol::PacketType::DataV1);
+  auto const packetV2 = Protocol::CreateDataPacket(points, Protocol::PacketType::DataV2);
+  TEST_LESS(packetV2.size(), packetV1.size(), ());
+
+  auto const header = Protocol::DecodeHeader(packetV2);
+  TEST_EQUAL(header.first, Protocol::PacketType::DataV2, ());
+  TEST_EQUAL(header.second, packetV2.size() - sizeof(uint32_t /* header */), ());
+
+  DecodeDataPacketVersionTest(points, Protocol::PacketType::DataV2);
 }
@@ -6,12 +6,18 @@
 #include "coding/traffic.hpp"
 
 #include "platform/location.hpp"
+#include "platform/platform.hpp"
 #include "platform/platform_tests_support/test_socket.hpp"
 #include "platform/socket.hpp"
 
+#include "coding/file_name_utils.hpp"
+#include "coding/file_writer.hpp"
+
 #include "base/math.hpp"
+#include "base/scope_guard.hpp"
 #include "base/thread.hpp"
 
+#include "std/bind.hpp"
 #include "std/cmath.hpp"
 
 using namespace tracking;
@@ -20,7 +26,7 @@ using namespace platform::tests_support;
 namespace
 {
 void TransferLocation(Reporter & reporter, TestSocket & testSocket, double timestamp,
-                      double latidute, double longtitude)
+                      double latidute, double longtitude, size_t pointsCount = 1)
 {
   location::GpsInfo gpsInfo;
   gpsInfo.m_timestamp = timestamp;
@@ -48,6 +54,7 @@ void TransferLocation(Reporter & reporter, TestSocket & testSocket, double times
     }
     case Packet::DataV0:
     case Packet::DataV1:
+    case Packet::DataV2:
     {
       readSize = 0;
       break;
@@ -63,8 +70,8 @@ void TransferLocation(Reporter & reporter, TestSocket & testSocket, double times
   coding::TrafficGPSEncoder::DeserializeDataPoints(coding::TrafficGPSEncoder::kLatestVersion, src,
                                                    points);
 
-  TEST_EQUAL(points.size(), 1, ());
-  auto const & point = points[0];
+  TEST_EQUAL(points.size(), pointsCount, ());
+  auto const & point = points.back();
   TEST_EQUAL(point.m_timestamp, timestamp, ());
   TEST(my::AlmostEqualAbs(point.m_latLon.lat, latidute, 0.001), ());
   TEST(my::AlmostEqualAbs(point.m_latLon.lon, longtitude, 0.001), ());
@@ -97,3 +104,37 @@ UNIT_TEST(Reporter_TransferLocations)
   TransferLocation(reporter, testSocket, 4.0, 5.0, 6.0);
   TransferLocation(reporter, testSocket, 7.0, 8.0, 9.0);
 }
+
+UNIT_TEST(Reporter_Spool)
+{
+  string const path =
+      my::JoinFoldersToPath(GetPlatform().WritableDir(), "reporter_spool_test.dat");
+  MY_SCOPE_GUARD(deleter, bind(&FileWriter::DeleteFileX, path));
+
+  location::GpsInfo gpsInfo;
+  gpsInfo.m_timestamp = 1.0;
+  gpsInfo.m_latitude = 2.0;
+  gpsInfo.m_longitude = 3.0;
+  gpsInfo.m_horizontalAccuracy = 1.0;
+
+  {
+    // Points can't be sent without a socket, so they are kept in the spool.
+    unique_ptr<platform::Socket> socket;
+    Reporter reporter(move(socket), "localhost", 0, milliseconds(10) /* pushDelay */);
+    reporter.SetSpoolPath(path);
+    reporter.AddLocation(gpsInfo, traffic::SpeedGroup::Unknown);
+  }
+  TEST(Platform::IsFileExistsByFullPath(path), ());
+
+  // The spooled point is sent after restart and the spool is removed.
+  auto socket = make_unique<TestSocket>();
+  TestSocket & testSocket = *socket.get();
+  {
+    Reporter reporter(move(socket), "localhost", 0, milliseconds(10) /* pushDelay */);
+    // The spooled point and the new one are sent by one batch.
+    reporter.SetBatching(2 /* minPoints */, milliseconds(60000) /* maxDelay */);
+    reporter.SetSpoolPath(path);
+    TransferLocation(reporter, testSocket, 4.0, 5.0, 6.0, 2 /* pointsCount */);
+  }
+  TEST(!Platform::IsFileExistsByFullPath(path), ());
+}
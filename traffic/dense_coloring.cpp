@@ -0,0 +1,79 @@
+#include "traffic/dense_coloring.hpp"
+
+#include "base/assert.hpp"
+
+#include <algorithm>
+
+namespace traffic
+{
+DenseColoring::DenseColoring(TrafficInfo::Coloring const & coloring)
+{
+  if (coloring.empty())
+    return;
+
+  // The coloring is ordered by feature ids.
+  m_minFid = coloring.cbegin()->first.GetFid();
+  uint32_t const maxFid = coloring.crbegin()->first.GetFid();
+  size_t const numFeatures = static_cast<size_t>(maxFid - m_minFid) + 1;
+
+  // Numbers of segments and directions of features.
+  std::vector<uint32_t> numSegs(numFeatures, 0);
+  m_twoWay.assign(numFeatures, false);
+  for (auto const & kv : coloring)
+  {
+    auto const & id = kv.first;
+    size_t const i = id.GetFid() - m_minFid;
+    numSegs[i] = std::max(numSegs[i], static_cast<uint32_t>(id.GetIdx()) + 1);
+    if (id.GetDir() == TrafficInfo::RoadSegmentId::kReverseDirection)
+      m_twoWay[i] = true;
+  }
+
+  m_offsets.resize(numFeatures + 1);
+  m_offsets[0] = 0;
+  for (size_t i = 0; i < numFeatures; ++i)
+    m_offsets[i + 1] = m_offsets[i] + numSegs[i] * (m_twoWay[i] ? 2 : 1);
+  m_size = m_offsets.back();
+
+  // Unknown is the greatest speed group, so all bits are set.
+  static_assert(static_cast<uint8_t>(SpeedGroup::Unknown) == 7, "");
+  m_values.assign((m_size + kValuesPerWord - 1) / kValuesPerWord,
+                  (uint64_t{1} << (3 * kValuesPerWord)) - 1);
+
+  for (auto const & kv : coloring)
+  {
+    auto const & id = kv.first;
+    size_t const i = id.GetFid() - m_minFid;
+    Set(m_offsets[i] + (m_twoWay[i] ? id.GetIdx() * 2 + id.GetDir() : id.GetIdx()), kv.second);
+  }
+}
+
+SpeedGroup DenseColoring::GetSpeedGroup(uint32_t fid, uint32_t idx, uint8_t dir) const
+{
+  if (fid < m_minFid || fid - m_minFid + 1 >= m_offsets.size())
+    return SpeedGroup::Unknown;
+
+  size_t const i = fid - m_minFid;
+  size_t index = m_offsets[i];
+  if (m_twoWay[i])
+    index += static_cast<size_t>(idx) * 2 + dir;
+  else if (dir == TrafficInfo::RoadSegmentId::kForwardDirection)
+    index += idx;
+  else
+    return SpeedGroup::Unknown;
+
+  if (index >= m_offsets[i + 1])
+    return SpeedGroup::Unknown;
+
+  size_t const shift = 3 * (index % kValuesPerWord);
+  return static_cast<SpeedGroup>((m_values[index / kValuesPerWord] >> shift) & 0x7);
+}
+
+void DenseColoring::Set(size_t index, SpeedGroup speedGroup)
+{
+  ASSERT_LESS(index, m_size, ());
+  size_t const shift = 3 * (index % kValuesPerWord);
+  uint64_t & word = m_values[index / kValuesPerWord];
+  word &= ~(uint64_t{0x7} << shift);
+  word |= static_cast<uint64_t>(speedGroup) << shift;
+}
+}  // namespace traffic
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "traffic/speed_groups.hpp"
+#include "traffic/traffic_info.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace traffic
+{
+// Speed groups of an mwm in the order of traffic keys (see TrafficInfo::ExtractTrafficKeys).
+// Segments of every feature take a dense range of indices, the range is found by an offset
+// table by feature id, so a lookup is O(1). Speed groups are packed by 3 bits.
+// Unlike TrafficInfo::Coloring, the memory doesn't depend on the number of known segments
+// but on the number of segments of features from the coloring. So it's intended for cities
+// with almost full traffic coverage.
+class DenseColoring final
+{
+public:
+  DenseColoring() = default;
+  explicit DenseColoring(TrafficInfo::Coloring const & coloring);
+
+  SpeedGroup GetSpeedGroup(uint32_t fid, uint32_t idx, uint8_t dir) const;
+  SpeedGroup GetSpeedGroup(TrafficInfo::RoadSegmentId const & id) const
+  {
+    return GetSpeedGroup(id.GetFid(), id.GetIdx(), id.GetDir());
+  }
+
+  // Number of segments, known and unknown.
+  size_t GetSize() const { return m_size; }
+  bool IsEmpty() const { return m_size == 0; }
+
+private:
+  // 21 speed groups of 3 bits in a 64 bit word.
+  static size_t constexpr kValuesPerWord = 21;
+
+  void Set(size_t index, SpeedGroup speedGroup);
+
+  uint32_t m_minFid = 0;
+  // Begin of the segments of the feature m_minFid + i is m_offsets[i], the end is m_offsets[i + 1].
+  std::vector<uint32_t> m_offsets;
+  // Features with reverse segments take two indices per segment: forward and reverse ones.
+  std::vector<bool> m_twoWay;
+  std::vector<uint64_t> m_values;
+  size_t m_size = 0;
+};
+}  // namespace traffic
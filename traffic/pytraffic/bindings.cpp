@@ -152,6 +152,19 @@ vector<uint8_t> GenerateTrafficValuesFromBinary(vector<uint8_t> const & keysBlob
   return GenerateTrafficValues(keys, segmentMappingDict);
 }
 
+vector<uint8_t> GenerateTrafficValuesDeltaFromBinary(vector<uint8_t> const & baseValuesBlob,
+                                                     vector<uint8_t> const & valuesBlob)
+{
+  vector<traffic::SpeedGroup> baseValues;
+  traffic::TrafficInfo::DeserializeTrafficValues(baseValuesBlob, baseValues);
+  vector<traffic::SpeedGroup> values;
+  traffic::TrafficInfo::DeserializeTrafficValues(valuesBlob, values);
+
+  vector<uint8_t> buf;
+  traffic::TrafficInfo::SerializeTrafficValuesDelta(baseValues, values, buf);
+  return buf;
+}
+
 void LoadClassificator(string const & classifPath)
 {
   GetPlatform().SetResourceDir(classifPath);
@@ -199,4 +212,5 @@ BOOST_PYTHON_MODULE(pytraffic)
   def("generate_traffic_keys", GenerateTrafficKeys);
   def("generate_traffic_values_from_list", GenerateTrafficValuesFromList);
   def("generate_traffic_values_from_binary", GenerateTrafficValuesFromBinary);
+  def("generate_traffic_values_delta_from_binary", GenerateTrafficValuesDeltaFromBinary);
 }
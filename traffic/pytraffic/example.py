@@ -4,6 +4,7 @@ from pytraffic import (RoadSegmentId,
                        load_classificator,
                        generate_traffic_keys,
                        generate_traffic_values_from_binary,
+                       generate_traffic_values_delta_from_binary,
                        generate_traffic_values_from_list)
 import argparse
 
@@ -45,3 +46,8 @@ buf1 = generate_traffic_values_from_list(keys, mapping)
 
 with open(options.path_to_keys, "rb") as bin_data:
   buf2 = generate_traffic_values_from_binary(bin_data.read(), {})
+
+mapping[RoadSegmentId(1, 0, 0)] = SegmentSpeeds(1.0, 1.0, 1.0)
+buf3 = generate_traffic_values_from_list(keys, mapping)
+# A client which has |buf1| needs only the changed values of |buf3|.
+delta = generate_traffic_values_delta_from_binary(buf1, buf3)
@@ -7,11 +7,13 @@ ROOT_DIR = ..
 include($$ROOT_DIR/common.pri)
 
 SOURCES += \
+    dense_coloring.cpp \
     speed_groups.cpp \
     traffic_cache.cpp \
     traffic_info.cpp \
 
 HEADERS += \
+    dense_coloring.hpp \
     speed_groups.hpp \
     traffic_cache.hpp \
     traffic_info.hpp \
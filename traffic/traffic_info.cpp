@@ -1,6 +1,7 @@
 #include "traffic/traffic_info.hpp"
 
 #include "platform/http_client.hpp"
+#include "platform/network_scheduler.hpp"
 
 #include "routing_common/car_model.hpp"
 
@@ -39,6 +40,8 @@ namespace
 {
 bool ReadRemoteFile(string const & url, vector<uint8_t> & contents, int & errorCode)
 {
+  // Traffic is needed during navigation, so it's not delayed by map downloads.
+  platform::NetworkScheduler::ForegroundRequest const foreground;
   platform::HttpClient request(url);
   if (!request.RunHttpRequest())
   {
@@ -75,7 +78,142 @@ string MakeRemoteURL(string const & name, uint64_t version)
   return ss.str();
 }
 
+// Keys of this version are gamma coded.
+uint8_t constexpr kGammaCodedKeysVersion = 0;
+
 char const kETag[] = "etag";
+// The header with ETag of the base coloring, the server may respond with a delta against it.
+char const kDeltaBaseHeader[] = "X-Traffic-Delta-Base";
+
+// Writes |keys| in the layout of TrafficInfo::KeysView.
+void SerializeKeys(vector<TrafficInfo::RoadSegmentId> const & keys, vector<uint32_t> & result)
+{
+  CHECK_LESS_OR_EQUAL(keys.size(), numeric_limits<uint32_t>::max(), ());
+
+  vector<uint32_t> fids;
+  vector<uint32_t> firstKeys;
+  vector<uint32_t> oneWay;
+  for (size_t i = 0; i < keys.size();)
+  {
+    size_t j = i;
+    bool ow = true;
+    for (; j < keys.size() && keys[i].m_fid == keys[j].m_fid; ++j)
+    {
+      if (keys[j].m_dir == TrafficInfo::RoadSegmentId::kReverseDirection)
+        ow = false;
+    }
+    CHECK_EQUAL((j - i) % (ow ? 1 : 2), 0, (keys[i]));
+
+    if (fids.size() % 32 == 0)
+      oneWay.push_back(0);
+    if (ow)
+      oneWay.back() |= uint32_t{1} << (fids.size() % 32);
+    fids.push_back(keys[i].m_fid);
+    firstKeys.push_back(static_cast<uint32_t>(i));
+    i = j;
+  }
+  firstKeys.push_back(static_cast<uint32_t>(keys.size()));
+
+  result.clear();
+  result.reserve(2 + fids.size() + firstKeys.size() + oneWay.size());
+  result.push_back(TrafficInfo::kLatestKeysVersion);
+  result.push_back(static_cast<uint32_t>(fids.size()));
+  result.insert(result.end(), fids.begin(), fids.end());
+  result.insert(result.end(), firstKeys.begin(), firstKeys.end());
+  result.insert(result.end(), oneWay.begin(), oneWay.end());
+  for (auto & word : result)
+    word = SwapIfBigEndian(word);
+}
+
+void DeserializeGammaCodedKeys(uint8_t const * data, size_t size,
+                               vector<TrafficInfo::RoadSegmentId> & result)
+{
+  MemReaderWithExceptions memReader(data, size);
+  ReaderSource<decltype(memReader)> src(memReader);
+  auto const version = ReadPrimitiveFromSource<uint8_t>(src);
+  CHECK_EQUAL(version, kGammaCodedKeysVersion, ());
+  auto const n = static_cast<size_t>(ReadVarUint<uint64_t>(src));
+
+  vector<uint32_t> fids(n);
+  vector<size_t> numSegs(n);
+  vector<bool> oneWay(n);
+
+  {
+    BitReader<decltype(src)> bitReader(src);
+    uint32_t prevFid = 0;
+    for (size_t i = 0; i < n; ++i)
+    {
+      prevFid += coding::GammaCoder::Decode(bitReader) - 1;
+      fids[i] = prevFid;
+    }
+
+    for (size_t i = 0; i < n; ++i)
+      numSegs[i] = coding::GammaCoder::Decode(bitReader) - 1;
+
+    for (size_t i = 0; i < n; ++i)
+      oneWay[i] = bitReader.Read(1) > 0;
+  }
+
+  ASSERT_EQUAL(src.Size(), 0, ());
+
+  result.clear();
+  for (size_t i = 0; i < n; ++i)
+  {
+    auto const fid = fids[i];
+    uint8_t numDirs = oneWay[i] ? 1 : 2;
+    for (size_t j = 0; j < numSegs[i]; ++j)
+    {
+      for (uint8_t dir = 0; dir < numDirs; ++dir)
+      {
+        TrafficInfo::RoadSegmentId key(fid, j, dir);
+        result.push_back(key);
+      }
+    }
+  }
+}
+
+template <typename Source>
+void DeserializeValues(uint8_t version, Source & src, vector<SpeedGroup> & result)
+{
+  CHECK_EQUAL(version, TrafficInfo::kLatestValuesVersion,
+              ("Unsupported version of traffic values."));
+
+  auto const n = ReadVarUint<uint32_t>(src);
+  result.resize(n);
+  BitReader<Source> bitReader(src);
+  for (size_t i = 0; i < static_cast<size_t>(n); ++i)
+  {
+    // SpeedGroup's values fit into 3 bits.
+    result[i] = static_cast<SpeedGroup>(bitReader.Read(3));
+  }
+}
+
+template <typename Source>
+void DeserializeValuesDelta(uint8_t version, Source & src, TrafficInfo::ValuesDelta & result)
+{
+  CHECK_EQUAL(version, TrafficInfo::kLatestValuesDeltaVersion,
+              ("Unsupported version of traffic values delta."));
+
+  result.m_valuesCount = ReadVarUint<uint32_t>(src);
+  auto const numRuns = ReadVarUint<uint32_t>(src);
+  result.m_changes.clear();
+
+  BitReader<Source> bitReader(src);
+  uint64_t index = 0;
+  for (uint32_t run = 0; run < numRuns; ++run)
+  {
+    index += coding::GammaCoder::Decode(bitReader) - 1;
+    uint64_t const length = coding::GammaCoder::Decode(bitReader);
+    if (index + length > result.m_valuesCount)
+      MYTHROW(Reader::Exception, ("Traffic values delta is out of range:", index, length));
+
+    for (uint64_t i = 0; i < length; ++i, ++index)
+    {
+      result.m_changes.emplace_back(static_cast<uint32_t>(index),
+                                    static_cast<SpeedGroup>(bitReader.Read(3)));
+    }
+  }
+}
 }  // namespace
 
 // TrafficInfo::RoadSegmentId -----------------------------------------------------------------
@@ -86,11 +224,82 @@ TrafficInfo::RoadSegmentId::RoadSegmentId(uint32_t fid, uint16_t idx, uint8_t di
 {
 }
 
+// TrafficInfo::KeysView ----------------------------------------------------------------------
+TrafficInfo::KeysView::KeysView(void const * data, size_t size)
+{
+  if (reinterpret_cast<uintptr_t>(data) % sizeof(uint32_t) != 0 || size % sizeof(uint32_t) != 0)
+    MYTHROW(Reader::Exception, ("Traffic keys are not aligned:", size));
+
+  auto const * words = static_cast<uint32_t const *>(data);
+  uint64_t const numWords = size / sizeof(uint32_t);
+  if (numWords < 2 || static_cast<uint8_t>(Get(words, 0)) != kLatestKeysVersion)
+    MYTHROW(Reader::Exception, ("Unsupported version or size of traffic keys:", size));
+
+  uint64_t const numFeatures = Get(words, 1);
+  if (numWords != 2 + 2 * numFeatures + 1 + (numFeatures + 31) / 32)
+    MYTHROW(Reader::Exception, ("Wrong size of traffic keys:", size, numFeatures));
+
+  m_numFeatures = static_cast<uint32_t>(numFeatures);
+  m_fids = words + 2;
+  m_firstKeys = m_fids + m_numFeatures;
+  m_oneWay = m_firstKeys + m_numFeatures + 1;
+
+  // The data isn't trusted, so the invariants of the layout are checked once here.
+  if (Get(m_firstKeys, 0) != 0)
+    MYTHROW(Reader::Exception, ("Wrong first key of traffic keys."));
+  for (uint32_t i = 0; i < m_numFeatures; ++i)
+  {
+    uint32_t const begin = Get(m_firstKeys, i);
+    uint32_t const end = Get(m_firstKeys, i + 1);
+    uint32_t const numDirs = IsOneWay(i) ? 1 : 2;
+    if ((i != 0 && Get(m_fids, i - 1) >= Get(m_fids, i)) || end < begin ||
+        (end - begin) % numDirs != 0 || (end - begin) / numDirs > (1 << 15))
+    {
+      MYTHROW(Reader::Exception, ("Wrong keys of the feature", i, "in traffic keys."));
+    }
+  }
+  m_numKeys = Get(m_firstKeys, m_numFeatures);
+}
+
+TrafficInfo::RoadSegmentId TrafficInfo::KeysView::operator[](size_t index) const
+{
+  ASSERT_LESS(index, m_numKeys, ());
+
+  // The feature is the last one whose first key is not greater than |index|.
+  uint32_t lo = 0;
+  uint32_t hi = m_numFeatures;
+  while (hi - lo > 1)
+  {
+    uint32_t const mid = lo + (hi - lo) / 2;
+    if (Get(m_firstKeys, mid) <= index)
+      lo = mid;
+    else
+      hi = mid;
+  }
+
+  auto const j = static_cast<uint32_t>(index - Get(m_firstKeys, lo));
+  uint8_t const numDirs = IsOneWay(lo) ? 1 : 2;
+  return RoadSegmentId(Get(m_fids, lo), static_cast<uint16_t>(j / numDirs),
+                       static_cast<uint8_t>(j % numDirs));
+}
+
+// TrafficInfo::KeysData ----------------------------------------------------------------------
+struct TrafficInfo::KeysData
+{
+  // A mapped section of an mwm.
+  FilesMappingContainer m_container;
+  FilesMappingContainer::Handle m_handle;
+
+  // Keys which are converted from other versions or copied to be aligned.
+  vector<uint32_t> m_buffer;
+};
+
 // TrafficInfo --------------------------------------------------------------------------------
 
 // static
-uint8_t const TrafficInfo::kLatestKeysVersion = 0;
+uint8_t const TrafficInfo::kLatestKeysVersion = 1;
 uint8_t const TrafficInfo::kLatestValuesVersion = 0;
+uint8_t const TrafficInfo::kLatestValuesDeltaVersion = 1;
 
 TrafficInfo::TrafficInfo(MwmSet::MwmId const & mwmId, int64_t currentDataVersion)
   : m_mwmId(mwmId)
@@ -104,16 +313,18 @@ TrafficInfo::TrafficInfo(MwmSet::MwmId const & mwmId, int64_t currentDataVersion
   string const mwmPath = mwmId.GetInfo()->GetLocalFile().GetPath(MapOptions::Map);
   try
   {
-    FilesContainerR rcont(mwmPath);
-    if (rcont.IsExist(TRAFFIC_KEYS_FILE_TAG))
+    auto keysData = make_shared<KeysData>();
+    keysData->m_container.Open(mwmPath);
+    if (keysData->m_container.IsExist(TRAFFIC_KEYS_FILE_TAG))
     {
-      auto reader = rcont.GetReader(TRAFFIC_KEYS_FILE_TAG);
-      vector<uint8_t> buf(reader.Size());
-      reader.Read(0, buf.data(), buf.size());
+      auto & handle = keysData->m_handle;
+      handle.Assign(keysData->m_container.Map(TRAFFIC_KEYS_FILE_TAG));
       LOG(LINFO, ("Reading keys for", mwmId, "from section"));
       try
       {
-        DeserializeTrafficKeys(buf, m_keys);
+        auto const * data = handle.GetData<uint8_t>();
+        auto const size = static_cast<size_t>(handle.GetSize());
+        SetKeys(move(keysData), data, size);
       }
       catch (Reader::Exception const & e)
       {
@@ -149,18 +360,31 @@ TrafficInfo TrafficInfo::BuildForTesting(Coloring && coloring)
 
 void TrafficInfo::SetTrafficKeysForTesting(vector<RoadSegmentId> const & keys)
 {
-  m_keys = keys;
+  auto keysData = make_shared<KeysData>();
+  SerializeKeys(keys, keysData->m_buffer);
+  auto const * data = reinterpret_cast<uint8_t const *>(keysData->m_buffer.data());
+  auto const size = keysData->m_buffer.size() * sizeof(uint32_t);
+  SetKeys(move(keysData), data, size);
   m_availability = Availability::IsAvailable;
 }
 
 bool TrafficInfo::ReceiveTrafficData(string & etag)
 {
   vector<SpeedGroup> values;
-  switch (ReceiveTrafficValues(etag, values))
+  ValuesDelta delta;
+  bool isDelta = false;
+  switch (ReceiveTrafficValues(etag, values, delta, isDelta))
   {
   case ServerDataStatus::New:
-    return UpdateTrafficData(values);
+    if (!isDelta)
+      return UpdateTrafficData(values);
+    if (UpdateTrafficData(delta))
+      return true;
+    // The base coloring is inconsistent with the delta, all values are requested next time.
+    etag.clear();
+    return false;
   case ServerDataStatus::NotChanged:
+    m_coloring.clear();
     return true;
   case ServerDataStatus::NotFound:
   case ServerDataStatus::Error:
@@ -231,125 +455,49 @@ void TrafficInfo::CombineColorings(vector<TrafficInfo::RoadSegmentId> const & ke
 // static
 void TrafficInfo::SerializeTrafficKeys(vector<RoadSegmentId> const & keys, vector<uint8_t> & result)
 {
-  vector<uint32_t> fids;
-  vector<size_t> numSegs;
-  vector<bool> oneWay;
-  for (size_t i = 0; i < keys.size();)
-  {
-    size_t j = i;
-    while (j < keys.size() && keys[i].m_fid == keys[j].m_fid)
-      ++j;
-
-    bool ow = true;
-    for (size_t k = i; k < j; ++k)
-    {
-      if (keys[k].m_dir == RoadSegmentId::kReverseDirection)
-      {
-        ow = false;
-        break;
-      }
-    }
-
-    auto const numDirs = ow ? 1 : 2;
-    size_t numSegsForThisFid = j - i;
-    CHECK_GREATER(numDirs, 0, ());
-    CHECK_EQUAL(numSegsForThisFid % numDirs, 0, ());
-    numSegsForThisFid /= numDirs;
-
-    fids.push_back(keys[i].m_fid);
-    numSegs.push_back(numSegsForThisFid);
-    oneWay.push_back(ow);
-
-    i = j;
-  }
-
-  MemWriter<vector<uint8_t>> memWriter(result);
-  WriteToSink(memWriter, kLatestKeysVersion);
-  WriteVarUint(memWriter, fids.size());
-
-  {
-    BitWriter<decltype(memWriter)> bitWriter(memWriter);
-
-    uint32_t prevFid = 0;
-    for (auto const & fid : fids)
-    {
-      uint64_t const fidDiff = static_cast<uint64_t>(fid - prevFid);
-      bool ok = coding::GammaCoder::Encode(bitWriter, fidDiff + 1);
-      ASSERT(ok, ());
-      UNUSED_VALUE(ok);
-      prevFid = fid;
-    }
-
-    for (auto const & s : numSegs)
-    {
-      bool ok = coding::GammaCoder::Encode(bitWriter, s + 1);
-      ASSERT(ok, ());
-      UNUSED_VALUE(ok);
-    }
-
-    for (auto const & val : oneWay)
-      bitWriter.Write(val ? 1 : 0, 1 /* numBits */);
-  }
+  vector<uint32_t> words;
+  SerializeKeys(keys, words);
+  result.resize(words.size() * sizeof(uint32_t));
+  if (!words.empty())
+    memcpy(result.data(), words.data(), result.size());
 }
 
 // static
 void TrafficInfo::DeserializeTrafficKeys(vector<uint8_t> const & data,
                                          vector<TrafficInfo::RoadSegmentId> & result)
 {
-  MemReaderWithExceptions memReader(data.data(), data.size());
-  ReaderSource<decltype(memReader)> src(memReader);
-  auto const version = ReadPrimitiveFromSource<uint8_t>(src);
-  CHECK_EQUAL(version, kLatestKeysVersion, ("Unsupported version of traffic values."));
-  auto const n = static_cast<size_t>(ReadVarUint<uint64_t>(src));
-
-  vector<uint32_t> fids(n);
-  vector<size_t> numSegs(n);
-  vector<bool> oneWay(n);
+  if (data.empty())
+    MYTHROW(Reader::Exception, ("Empty traffic keys."));
 
+  if (data.front() == kGammaCodedKeysVersion)
   {
-    BitReader<decltype(src)> bitReader(src);
-    uint32_t prevFid = 0;
-    for (size_t i = 0; i < n; ++i)
-    {
-      prevFid += coding::GammaCoder::Decode(bitReader) - 1;
-      fids[i] = prevFid;
-    }
-
-    for (size_t i = 0; i < n; ++i)
-      numSegs[i] = coding::GammaCoder::Decode(bitReader) - 1;
-
-    for (size_t i = 0; i < n; ++i)
-      oneWay[i] = bitReader.Read(1) > 0;
+    DeserializeGammaCodedKeys(data.data(), data.size(), result);
+    return;
   }
 
-  ASSERT_EQUAL(src.Size(), 0, ());
+  vector<uint32_t> words((data.size() + sizeof(uint32_t) - 1) / sizeof(uint32_t));
+  memcpy(words.data(), data.data(), data.size());
+  KeysView const view(words.data(), data.size());
 
   result.clear();
-  for (size_t i = 0; i < n; ++i)
-  {
-    auto const fid = fids[i];
-    uint8_t numDirs = oneWay[i] ? 1 : 2;
-    for (size_t j = 0; j < numSegs[i]; ++j)
-    {
-      for (uint8_t dir = 0; dir < numDirs; ++dir)
-      {
-        RoadSegmentId key(fid, j, dir);
-        result.push_back(key);
-      }
-    }
-  }
+  result.reserve(view.GetSize());
+  view.ForEach([&result](RoadSegmentId const & key) { result.push_back(key); });
 }
 
 // static
 void TrafficInfo::SerializeTrafficValues(vector<SpeedGroup> const & values,
                                          vector<uint8_t> & result)
 {
-  vector<uint8_t> buf;
-  MemWriter<vector<uint8_t>> memWriter(buf);
-  WriteToSink(memWriter, kLatestValuesVersion);
-  WriteVarUint(memWriter, values.size());
+  using Deflate = coding::ZLib::Deflate;
+
+  result.clear();
+  MemWriter<vector<uint8_t>> memWriter(result);
+  coding::ZLib::DeflateWriter deflateWriter(memWriter, Deflate::Format::ZLib,
+                                            Deflate::Level::BestCompression);
+  WriteToSink(deflateWriter, kLatestValuesVersion);
+  WriteVarUint(deflateWriter, values.size());
   {
-    BitWriter<decltype(memWriter)> bitWriter(memWriter);
+    BitWriter<decltype(deflateWriter)> bitWriter(deflateWriter);
     auto const numSpeedGroups = static_cast<uint8_t>(SpeedGroup::Count);
     static_assert(numSpeedGroups <= 8, "A speed group's value may not fit into 3 bits");
     for (auto const & v : values)
@@ -360,39 +508,122 @@ void TrafficInfo::SerializeTrafficValues(vector<SpeedGroup> const & values,
     }
   }
 
-  using Deflate = coding::ZLib::Deflate;
-  Deflate deflate(Deflate::Format::ZLib, Deflate::Level::BestCompression);
-
-  deflate(buf.data(), buf.size(), back_inserter(result));
+  deflateWriter.Finish();
 }
 
 // static
 void TrafficInfo::DeserializeTrafficValues(vector<uint8_t> const & data,
                                            vector<SpeedGroup> & result)
 {
-  using Inflate = coding::ZLib::Inflate;
+  MemReaderWithExceptions memReader(data.data(), data.size());
+  coding::ZLib::InflateSource src(memReader, coding::ZLib::Inflate::Format::ZLib);
+  auto const version = ReadPrimitiveFromSource<uint8_t>(src);
+  DeserializeValues(version, src, result);
+}
+
+// static
+void TrafficInfo::SerializeTrafficValuesDelta(vector<SpeedGroup> const & baseValues,
+                                              vector<SpeedGroup> const & values,
+                                              vector<uint8_t> & result)
+{
+  CHECK_EQUAL(baseValues.size(), values.size(), ());
+
+  // Runs of changed values as (begin, end) pairs.
+  vector<pair<size_t, size_t>> runs;
+  for (size_t i = 0; i < values.size(); ++i)
+  {
+    if (values[i] == baseValues[i])
+      continue;
 
-  vector<uint8_t> decompressedData;
+    if (!runs.empty() && runs.back().second == i)
+      runs.back().second = i + 1;
+    else
+      runs.emplace_back(i, i + 1);
+  }
 
-  Inflate inflate(Inflate::Format::ZLib);
-  inflate(data.data(), data.size(), back_inserter(decompressedData));
+  using Deflate = coding::ZLib::Deflate;
 
-  MemReaderWithExceptions memReader(decompressedData.data(), decompressedData.size());
-  ReaderSource<decltype(memReader)> src(memReader);
+  result.clear();
+  MemWriter<vector<uint8_t>> memWriter(result);
+  coding::ZLib::DeflateWriter deflateWriter(memWriter, Deflate::Format::ZLib,
+                                            Deflate::Level::BestCompression);
+  WriteToSink(deflateWriter, kLatestValuesDeltaVersion);
+  WriteVarUint(deflateWriter, values.size());
+  WriteVarUint(deflateWriter, runs.size());
+  {
+    BitWriter<decltype(deflateWriter)> bitWriter(deflateWriter);
+    auto const numSpeedGroups = static_cast<uint8_t>(SpeedGroup::Count);
+    size_t prevEnd = 0;
+    for (auto const & run : runs)
+    {
+      bool ok = coding::GammaCoder::Encode(bitWriter, run.first - prevEnd + 1);
+      ASSERT(ok, ());
+      ok = coding::GammaCoder::Encode(bitWriter, run.second - run.first);
+      ASSERT(ok, ());
+      UNUSED_VALUE(ok);
 
+      for (size_t i = run.first; i < run.second; ++i)
+      {
+        uint8_t const u = static_cast<uint8_t>(values[i]);
+        CHECK_LESS(u, numSpeedGroups, ());
+        bitWriter.Write(u, 3);
+      }
+      prevEnd = run.second;
+    }
+  }
+
+  deflateWriter.Finish();
+}
+
+// static
+void TrafficInfo::DeserializeTrafficValuesDelta(vector<uint8_t> const & data,
+                                                ValuesDelta & result)
+{
+  MemReaderWithExceptions memReader(data.data(), data.size());
+  coding::ZLib::InflateSource src(memReader, coding::ZLib::Inflate::Format::ZLib);
   auto const version = ReadPrimitiveFromSource<uint8_t>(src);
-  CHECK_EQUAL(version, kLatestValuesVersion, ("Unsupported version of traffic keys."));
+  DeserializeValuesDelta(version, src, result);
+}
 
-  auto const n = ReadVarUint<uint32_t>(src);
-  result.resize(n);
-  BitReader<decltype(src)> bitReader(src);
-  for (size_t i = 0; i < static_cast<size_t>(n); ++i)
+// static
+bool TrafficInfo::ApplyTrafficValuesDelta(ValuesDelta const & delta, vector<SpeedGroup> & values)
+{
+  if (delta.m_valuesCount != values.size())
+    return false;
+
+  for (auto const & change : delta.m_changes)
   {
-    // SpeedGroup's values fit into 3 bits.
-    result[i] = static_cast<SpeedGroup>(bitReader.Read(3));
+    CHECK_LESS(change.first, values.size(), ());
+    values[change.first] = change.second;
   }
+  return true;
+}
 
-  ASSERT_EQUAL(src.Size(), 0, ());
+void TrafficInfo::SetKeys(shared_ptr<KeysData> keysData, uint8_t const * data, size_t size)
+{
+  if (size == 0)
+    MYTHROW(Reader::Exception, ("Empty traffic keys."));
+
+  auto & buffer = keysData->m_buffer;
+  if (data[0] == kGammaCodedKeysVersion)
+  {
+    vector<RoadSegmentId> keys;
+    DeserializeGammaCodedKeys(data, size, keys);
+    SerializeKeys(keys, buffer);
+    data = reinterpret_cast<uint8_t const *>(buffer.data());
+    size = buffer.size() * sizeof(uint32_t);
+    // The mapped section isn't needed anymore.
+    keysData->m_handle.Unmap();
+  }
+  else if (reinterpret_cast<uintptr_t>(data) % sizeof(uint32_t) != 0)
+  {
+    buffer.resize((size + sizeof(uint32_t) - 1) / sizeof(uint32_t));
+    memcpy(buffer.data(), data, size);
+    data = reinterpret_cast<uint8_t const *>(buffer.data());
+  }
+
+  m_keys = KeysView(data, size);
+  m_keysData = move(keysData);
 }
 
 // todo(@m) This is a temporary method. Do not refactor it.
@@ -419,10 +650,10 @@ bool TrafficInfo::ReceiveTrafficKeys()
     return false;
   }
 
-  vector<RoadSegmentId> keys;
   try
   {
-    DeserializeTrafficKeys(contents, keys);
+    auto keysData = make_shared<KeysData>();
+    SetKeys(move(keysData), contents.data(), contents.size());
   }
   catch (Reader::Exception const & e)
   {
@@ -430,11 +661,13 @@ bool TrafficInfo::ReceiveTrafficKeys()
                 "Version:", info->GetVersion()));
     return false;
   }
-  m_keys.swap(keys);
   return true;
 }
 
-TrafficInfo::ServerDataStatus TrafficInfo::ReceiveTrafficValues(string & etag, vector<SpeedGroup> & values)
+TrafficInfo::ServerDataStatus TrafficInfo::ReceiveTrafficValues(string & etag,
+                                                                vector<SpeedGroup> & values,
+                                                                ValuesDelta & delta,
+                                                                bool & isDelta)
 {
   if (!m_mwmId.IsAlive())
     return ServerDataStatus::Error;
@@ -449,17 +682,27 @@ TrafficInfo::ServerDataStatus TrafficInfo::ReceiveTrafficValues(string & etag, v
   if (url.empty())
     return ServerDataStatus::Error;
 
+  platform::NetworkScheduler::ForegroundRequest const foreground;
   platform::HttpClient request(url);
   request.LoadHeaders(true);
   request.SetRawHeader("If-None-Match", etag);
+  if (!etag.empty() && !m_coloring.empty())
+    request.SetRawHeader(kDeltaBaseHeader, etag);
 
   if (!request.RunHttpRequest() || request.ErrorCode() != 200)
     return ProcessFailure(request, version);
   try
   {
     string const & response = request.ServerResponse();
-    vector<uint8_t> contents(response.cbegin(), response.cend());
-    DeserializeTrafficValues(contents, values);
+    MemReaderWithExceptions memReader(response.data(), response.size());
+    coding::ZLib::InflateSource src(memReader, coding::ZLib::Inflate::Format::ZLib);
+
+    auto const version = ReadPrimitiveFromSource<uint8_t>(src);
+    isDelta = version == kLatestValuesDeltaVersion;
+    if (isDelta)
+      DeserializeValuesDelta(version, src, delta);
+    else
+      DeserializeValues(version, src, values);
   }
   catch (Reader::Exception const & e)
   {
@@ -488,23 +731,49 @@ bool TrafficInfo::UpdateTrafficData(vector<SpeedGroup> const & values)
 {
   m_coloring.clear();
 
-  if (m_keys.size() != values.size())
+  if (m_keys.GetSize() != values.size())
   {
     LOG(LWARNING,
         ("The number of received traffic values does not correspond to the number of keys:",
-         m_keys.size(), "keys", values.size(), "values."));
+         m_keys.GetSize(), "keys", values.size(), "values."));
     alohalytics::LogEvent(
         "$TrafficUpdateError",
-        alohalytics::TStringMap({{"keysCount", strings::to_string(m_keys.size())},
+        alohalytics::TStringMap({{"keysCount", strings::to_string(m_keys.GetSize())},
                                  {"valuesCount", strings::to_string(values.size())}}));
     m_availability = Availability::NoData;
     return false;
   }
 
-  for (size_t i = 0; i < m_keys.size(); ++i)
+  // Keys are sorted, so each of them is inserted to the end of the map.
+  size_t i = 0;
+  m_keys.ForEach([&](RoadSegmentId const & key)
   {
     if (values[i] != SpeedGroup::Unknown)
-      m_coloring.emplace(m_keys[i], values[i]);
+      m_coloring.emplace_hint(m_coloring.end(), key, values[i]);
+    ++i;
+  });
+
+  return true;
+}
+
+bool TrafficInfo::UpdateTrafficData(ValuesDelta const & delta)
+{
+  if (m_keys.GetSize() != delta.m_valuesCount || m_coloring.empty())
+  {
+    LOG(LWARNING, ("The traffic values delta does not correspond to the keys:", m_keys.GetSize(),
+                   "keys", delta.m_valuesCount, "values, base coloring size:", m_coloring.size()));
+    m_coloring.clear();
+    m_availability = Availability::NoData;
+    return false;
+  }
+
+  for (auto const & change : delta.m_changes)
+  {
+    RoadSegmentId const key = m_keys[change.first];
+    if (change.second == SpeedGroup::Unknown)
+      m_coloring.erase(key);
+    else
+      m_coloring[key] = change.second;
   }
 
   return true;
@@ -4,9 +4,12 @@
 
 #include "indexer/mwm_set.hpp"
 
+#include "coding/endianness.hpp"
+
 #include "std/cstdint.hpp"
 #include "std/map.hpp"
 #include "std/shared_ptr.hpp"
+#include "std/utility.hpp"
 #include "std/vector.hpp"
 
 namespace platform
@@ -24,6 +27,7 @@ class TrafficInfo
 public:
   static uint8_t const kLatestKeysVersion;
   static uint8_t const kLatestValuesVersion;
+  static uint8_t const kLatestValuesDeltaVersion;
 
   enum class Availability
   {
@@ -73,9 +77,72 @@ public:
     uint8_t m_dir : 1;
   };
 
+  // Keys in the layout of kLatestKeysVersion. The layout is read in place, so
+  // it may be used directly from a mapped section of an mwm or from a buffer.
+  // The layout is a sequence of 32-bit little-endian words:
+  // * the version in the lowest byte of the first word;
+  // * the number of features F;
+  // * F ids of features in increasing order;
+  // * F + 1 indices of the first keys of features, the last one is the number of keys;
+  // * (F + 31) / 32 words of flags of one-way features.
+  // Keys of a feature are sorted by segments and then by directions.
+  class KeysView
+  {
+  public:
+    KeysView() = default;
+
+    // |data| must be aligned by 4 bytes and must outlive the view.
+    // Throws Reader::Exception if |data| isn't the layout of the latest version.
+    KeysView(void const * data, size_t size);
+
+    size_t GetSize() const { return m_numKeys; }
+
+    // Complexity is O(log(number of features)).
+    RoadSegmentId operator[](size_t index) const;
+
+    // Calls |fn| for all keys in the order of their indices.
+    template <typename Fn>
+    void ForEach(Fn && fn) const
+    {
+      for (uint32_t i = 0; i < m_numFeatures; ++i)
+      {
+        uint32_t const fid = Get(m_fids, i);
+        uint32_t const numKeys = Get(m_firstKeys, i + 1) - Get(m_firstKeys, i);
+        uint8_t const numDirs = IsOneWay(i) ? 1 : 2;
+        for (uint32_t j = 0; j < numKeys; ++j)
+        {
+          fn(RoadSegmentId(fid, static_cast<uint16_t>(j / numDirs),
+                           static_cast<uint8_t>(j % numDirs)));
+        }
+      }
+    }
+
+  private:
+    static uint32_t Get(uint32_t const * words, size_t i) { return SwapIfBigEndian(words[i]); }
+    bool IsOneWay(uint32_t feature) const
+    {
+      return ((Get(m_oneWay, feature / 32) >> (feature % 32)) & 1) != 0;
+    }
+
+    uint32_t m_numFeatures = 0;
+    uint32_t m_numKeys = 0;
+    uint32_t const * m_fids = nullptr;
+    uint32_t const * m_firstKeys = nullptr;
+    uint32_t const * m_oneWay = nullptr;
+  };
+
   // todo(@m) unordered_map?
   using Coloring = map<RoadSegmentId, SpeedGroup>;
 
+  // Changes of traffic values against the values of some previous version.
+  struct ValuesDelta
+  {
+    // Number of all values, i.e. of the keys of an mwm.
+    uint32_t m_valuesCount = 0;
+    // Indices of changed values in the order of keys and new values.
+    vector<pair<uint32_t, SpeedGroup>> m_changes;
+  };
+
   TrafficInfo() = default;
 
   TrafficInfo(MwmSet::MwmId const & mwmId, int64_t currentDataVersion);
@@ -91,6 +158,12 @@ public:
   // *NOTE* This method must not be called on the UI thread.
   bool ReceiveTrafficData(string & etag);
 
+  // Sets the coloring which was received with |etag| passed to ReceiveTrafficData.
+  // Then the server may send only the changed values which are applied to the coloring.
+  // When the data isn't changed at all the coloring is cleared by ReceiveTrafficData,
+  // so the caller should keep its own copy.
+  void SetBaseColoring(Coloring const & coloring) { m_coloring = coloring; }
+
   // Returns the latest known speed group by a feature segment's id
   // or SpeedGroup::Unknown if there is no information about the segment.
   SpeedGroup GetSpeedGroup(RoadSegmentId const & id) const;
@@ -108,18 +181,31 @@ public:
                                TrafficInfo::Coloring const & knownColors,
                                TrafficInfo::Coloring & result);
 
-  // Serializes the keys of the coloring map to |result|.
+  // Serializes the keys of the coloring map to |result| in the layout of KeysView.
   // The keys are road segments ids which do not change during
   // an mwm's lifetime so there's no point in downloading them every time.
-  // todo(@m) Document the format.
   static void SerializeTrafficKeys(vector<RoadSegmentId> const & keys, vector<uint8_t> & result);
 
+  // Reads keys of any supported version.
   static void DeserializeTrafficKeys(vector<uint8_t> const & data, vector<RoadSegmentId> & result);
 
   static void SerializeTrafficValues(vector<SpeedGroup> const & values, vector<uint8_t> & result);
 
   static void DeserializeTrafficValues(vector<uint8_t> const & data, vector<SpeedGroup> & result);
 
+  // Serializes changes of |values| against |baseValues|. Both vectors should have the same size.
+  // Changes are stored as runs of changed values, which are separated by numbers of unchanged
+  // values. Numbers are gamma coded and values are packed by 3 bits like in
+  // SerializeTrafficValues, and the whole data is deflated too.
+  static void SerializeTrafficValuesDelta(vector<SpeedGroup> const & baseValues,
+                                          vector<SpeedGroup> const & values,
+                                          vector<uint8_t> & result);
+
+  static void DeserializeTrafficValuesDelta(vector<uint8_t> const & data, ValuesDelta & result);
+
+  // Applies |delta| to |values|. Returns false if |delta| is made for another number of values.
+  static bool ApplyTrafficValuesDelta(ValuesDelta const & delta, vector<SpeedGroup> & values);
+
 private:
   enum class ServerDataStatus
   {
@@ -129,7 +215,16 @@ private:
     Error,
   };
 
+  // Owner of the memory of keys.
+  struct KeysData;
+
   friend void UnitTest_TrafficInfo_UpdateTrafficData();
+  friend void UnitTest_TrafficInfo_UpdateTrafficDataByDelta();
+
+  // Sets the keys of any supported version from |data|, which belongs to |keysData|.
+  // Keys of the latest version are used in place when it's possible, the other
+  // ones are converted to a buffer of |keysData|.
+  void SetKeys(shared_ptr<KeysData> keysData, uint8_t const * data, size_t size);
 
   // todo(@m) A temporary method. Remove it once the keys are added
   // to the generator and the data is regenerated.
@@ -138,10 +233,15 @@ private:
   // Tries to read the values of the Coloring map from server into |values|.
   // Returns result of communicating with server as ServerDataStatus.
   // Otherwise, returns false and does not change m_coloring.
-  ServerDataStatus ReceiveTrafficValues(string & etag, vector<SpeedGroup> & values);
+  // When the server sends changes against the base coloring they're read into |delta|
+  // and |isDelta| is set.
+  ServerDataStatus ReceiveTrafficValues(string & etag, vector<SpeedGroup> & values,
+                                        ValuesDelta & delta, bool & isDelta);
 
   // Updates the coloring and changes the availability status if needed.
   bool UpdateTrafficData(vector<SpeedGroup> const & values);
+  // Applies the changes to the base coloring in place.
+  bool UpdateTrafficData(ValuesDelta const & delta);
 
   ServerDataStatus ProcessFailure(platform::HttpClient const & request, int64_t const mwmVersion);
 
@@ -152,7 +252,8 @@ private:
   // and combined with the keys to form m_coloring.
   // *NOTE* The values must be received in the exact same order that the
   // keys are saved in.
-  vector<RoadSegmentId> m_keys;
+  KeysView m_keys;
+  shared_ptr<KeysData const> m_keysData;
 
   MwmSet::MwmId m_mwmId;
   Availability m_availability = Availability::Unknown;
@@ -0,0 +1,54 @@
+#include "testing/testing.hpp"
+
+#include "traffic/dense_coloring.hpp"
+#include "traffic/speed_groups.hpp"
+#include "traffic/traffic_info.hpp"
+
+#include <cstdint>
+
+using namespace traffic;
+
+namespace
+{
+using RoadSegmentId = TrafficInfo::RoadSegmentId;
+
+UNIT_TEST(DenseColoring_Empty)
+{
+  DenseColoring const dense((TrafficInfo::Coloring()));
+  TEST(dense.IsEmpty(), ());
+  TEST_EQUAL(dense.GetSpeedGroup(RoadSegmentId(0, 0, 0)), SpeedGroup::Unknown, ());
+}
+
+UNIT_TEST(DenseColoring_Smoke)
+{
+  TrafficInfo::Coloring coloring = {
+      {RoadSegmentId(10, 0, 0), SpeedGroup::G0},
+      {RoadSegmentId(10, 1, 1), SpeedGroup::G1},
+      {RoadSegmentId(12, 0, 0), SpeedGroup::G2},
+      {RoadSegmentId(12, 2, 0), SpeedGroup::TempBlock},
+      {RoadSegmentId(15, 0, 1), SpeedGroup::G5},
+  };
+
+  // A lot of segments to make the values take several words.
+  for (uint16_t idx = 0; idx < 100; ++idx)
+    coloring[RoadSegmentId(20, idx, 0)] = static_cast<SpeedGroup>(idx % 7);
+
+  DenseColoring const dense(coloring);
+  // Feature 10: 2 segments in both directions, 12: 3 one way segments, 15: 1 segment in both
+  // directions, 20: 100 one way segments.
+  TEST_EQUAL(dense.GetSize(), 4 + 3 + 2 + 100, ());
+
+  for (auto const & kv : coloring)
+    TEST_EQUAL(dense.GetSpeedGroup(kv.first), kv.second, (kv.first));
+
+  TEST_EQUAL(dense.GetSpeedGroup(RoadSegmentId(10, 0, 1)), SpeedGroup::Unknown, ());
+  TEST_EQUAL(dense.GetSpeedGroup(RoadSegmentId(10, 1, 0)), SpeedGroup::Unknown, ());
+  TEST_EQUAL(dense.GetSpeedGroup(RoadSegmentId(10, 2, 0)), SpeedGroup::Unknown, ());
+  TEST_EQUAL(dense.GetSpeedGroup(RoadSegmentId(12, 1, 0)), SpeedGroup::Unknown, ());
+  TEST_EQUAL(dense.GetSpeedGroup(RoadSegmentId(12, 0, 1)), SpeedGroup::Unknown, ());
+  TEST_EQUAL(dense.GetSpeedGroup(RoadSegmentId(11, 0, 0)), SpeedGroup::Unknown, ());
+  TEST_EQUAL(dense.GetSpeedGroup(RoadSegmentId(9, 0, 0)), SpeedGroup::Unknown, ());
+  TEST_EQUAL(dense.GetSpeedGroup(RoadSegmentId(21, 0, 0)), SpeedGroup::Unknown, ());
+  TEST_EQUAL(dense.GetSpeedGroup(RoadSegmentId(20, 100, 0)), SpeedGroup::Unknown, ());
+}
+}  // namespace
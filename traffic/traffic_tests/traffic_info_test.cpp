@@ -10,6 +10,7 @@
 
 #include "std/algorithm.hpp"
 #include "std/cstdint.hpp"
+#include "std/cstring.hpp"
 #include "std/vector.hpp"
 
 namespace traffic
@@ -111,6 +112,46 @@ UNIT_TEST(TrafficInfo_Serialization)
   }
 }
 
+UNIT_TEST(TrafficInfo_KeysView)
+{
+  vector<TrafficInfo::RoadSegmentId> const keys = {
+      TrafficInfo::RoadSegmentId(0, 0, 0),
+
+      TrafficInfo::RoadSegmentId(1, 0, 0), TrafficInfo::RoadSegmentId(1, 0, 1),
+
+      TrafficInfo::RoadSegmentId(5, 0, 0), TrafficInfo::RoadSegmentId(5, 0, 1),
+      TrafficInfo::RoadSegmentId(5, 1, 0), TrafficInfo::RoadSegmentId(5, 1, 1),
+
+      TrafficInfo::RoadSegmentId(7, 0, 0), TrafficInfo::RoadSegmentId(7, 1, 0),
+  };
+
+  vector<uint8_t> buf;
+  TrafficInfo::SerializeTrafficKeys(keys, buf);
+  TEST_EQUAL(buf.size() % sizeof(uint32_t), 0, ());
+
+  vector<uint32_t> words(buf.size() / sizeof(uint32_t));
+  memcpy(words.data(), buf.data(), buf.size());
+  TrafficInfo::KeysView const view(words.data(), buf.size());
+  TEST_EQUAL(view.GetSize(), keys.size(), ());
+  for (size_t i = 0; i < keys.size(); ++i)
+    TEST_EQUAL(view[i], keys[i], (i));
+
+  vector<TrafficInfo::RoadSegmentId> visited;
+  view.ForEach([&visited](TrafficInfo::RoadSegmentId const & key) { visited.push_back(key); });
+  TEST_EQUAL(visited, keys, ());
+
+  // Malformed data.
+  TEST_ANY_THROW(TrafficInfo::KeysView(words.data(), buf.size() - sizeof(uint32_t)), ());
+  words[2] = words[3];
+  TEST_ANY_THROW(TrafficInfo::KeysView(words.data(), buf.size()), ());
+
+  // The previous gamma coded version of the same keys.
+  vector<uint8_t> const gammaCoded = {0x00, 0x04, 0xC5, 0x2C, 0xD9, 0x09};
+  vector<TrafficInfo::RoadSegmentId> deserializedKeys;
+  TrafficInfo::DeserializeTrafficKeys(gammaCoded, deserializedKeys);
+  TEST_EQUAL(deserializedKeys, keys, ());
+}
+
 UNIT_TEST(TrafficInfo_UpdateTrafficData)
 {
   vector<TrafficInfo::RoadSegmentId> const keys = {
@@ -138,4 +179,74 @@ UNIT_TEST(TrafficInfo_UpdateTrafficData)
   for (size_t i = 0; i < keys.size(); ++i)
     TEST_EQUAL(info.GetSpeedGroup(keys[i]), values2[i], ());
 }
+
+UNIT_TEST(TrafficInfo_ValuesDeltaSerialization)
+{
+  vector<SpeedGroup> const baseValues = {
+      SpeedGroup::G0, SpeedGroup::G1, SpeedGroup::G2, SpeedGroup::G3, SpeedGroup::G4,
+      SpeedGroup::G5, SpeedGroup::TempBlock, SpeedGroup::Unknown, SpeedGroup::G0, SpeedGroup::G1,
+  };
+
+  vector<SpeedGroup> values = baseValues;
+  values[0] = SpeedGroup::Unknown;
+  values[3] = SpeedGroup::G5;
+  values[4] = SpeedGroup::G0;
+  values[9] = SpeedGroup::TempBlock;
+
+  vector<uint8_t> buf;
+  TrafficInfo::SerializeTrafficValuesDelta(baseValues, values, buf);
+
+  TrafficInfo::ValuesDelta delta;
+  TrafficInfo::DeserializeTrafficValuesDelta(buf, delta);
+  TEST_EQUAL(delta.m_valuesCount, values.size(), ());
+  TEST_EQUAL(delta.m_changes.size(), 4, ());
+
+  vector<SpeedGroup> updatedValues = baseValues;
+  TEST(TrafficInfo::ApplyTrafficValuesDelta(delta, updatedValues), ());
+  TEST_EQUAL(updatedValues, values, ());
+
+  vector<SpeedGroup> wrongValues(baseValues.size() + 1, SpeedGroup::G0);
+  TEST(!TrafficInfo::ApplyTrafficValuesDelta(delta, wrongValues), ());
+
+  buf.clear();
+  TrafficInfo::SerializeTrafficValuesDelta(values, values, buf);
+  TrafficInfo::DeserializeTrafficValuesDelta(buf, delta);
+  TEST_EQUAL(delta.m_valuesCount, values.size(), ());
+  TEST(delta.m_changes.empty(), ());
+}
+
+UNIT_TEST(TrafficInfo_UpdateTrafficDataByDelta)
+{
+  vector<TrafficInfo::RoadSegmentId> const keys = {
+      TrafficInfo::RoadSegmentId(0, 0, 0),
+
+      TrafficInfo::RoadSegmentId(1, 0, 0), TrafficInfo::RoadSegmentId(1, 0, 1),
+  };
+
+  vector<SpeedGroup> const values1 = {
+      SpeedGroup::G1, SpeedGroup::G2, SpeedGroup::Unknown,
+  };
+
+  vector<SpeedGroup> const values2 = {
+      SpeedGroup::G1, SpeedGroup::Unknown, SpeedGroup::G3,
+  };
+
+  TrafficInfo info;
+  info.SetTrafficKeysForTesting(keys);
+  TEST(info.UpdateTrafficData(values1), ());
+
+  vector<uint8_t> buf;
+  TrafficInfo::SerializeTrafficValuesDelta(values1, values2, buf);
+  TrafficInfo::ValuesDelta delta;
+  TrafficInfo::DeserializeTrafficValuesDelta(buf, delta);
+
+  TEST(info.UpdateTrafficData(delta), ());
+  for (size_t i = 0; i < keys.size(); ++i)
+    TEST_EQUAL(info.GetSpeedGroup(keys[i]), values2[i], ());
+  TEST_EQUAL(info.GetColoring().size(), 2, ());
+
+  delta.m_valuesCount = static_cast<uint32_t>(keys.size() + 1);
+  TEST(!info.UpdateTrafficData(delta), ());
+  TEST(info.GetColoring().empty(), ());
+}
 }  // namespace traffic
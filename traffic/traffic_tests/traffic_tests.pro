@@ -26,4 +26,5 @@ win*|linux* {
 
 SOURCES += \
     $$ROOT_DIR/testing/testingmain.cpp \
+    dense_coloring_test.cpp \
     traffic_info_test.cpp \
@@ -17,7 +17,10 @@ Time FromDaysAgo(Time time, uint32_t days)
 }
 }  // namespace
 
-Api::Api(Index const & index, std::string const & filename) : m_index(index), m_storage(filename) {}
+Api::Api(Index const & index, std::string const & filename) : m_index(index), m_storage(filename)
+{
+  m_thread.Push([this] { m_storage.Load(); });
+}
 
 void Api::GetUGC(FeatureID const & id, UGCCallback callback)
 {
@@ -31,7 +34,7 @@ void Api::GetUGCUpdate(FeatureID const & id, UGCUpdateCallback callback)
 
 void Api::SetUGCUpdate(FeatureID const & id, UGCUpdate const & ugc)
 {
-  m_thread.Push([=] { SetUGCUpdate(id, ugc); });
+  m_thread.Push([=] { SetUGCUpdateImpl(id, ugc); });
 }
 
 // static
@@ -96,13 +99,13 @@ void Api::GetUGCImpl(FeatureID const & id, UGCCallback callback)
   GetPlatform().RunOnGuiThread([ugc, callback] { callback(ugc); });
 }
 
-void Api::GetUGCUpdateImpl(FeatureID const & /* id */, UGCUpdateCallback callback)
+void Api::GetUGCUpdateImpl(FeatureID const & id, UGCUpdateCallback callback)
 {
-  // TODO (@y, @mgsergio): retrieve dynamic UGC
   UGCUpdate ugc(Rating({}, {}),
                 Attribute({}, {}),
                 ReviewAbuse({}, {}),
                 ReviewFeedback({}, {}));
+  m_storage.GetUGCUpdate(id, ugc);
   GetPlatform().RunOnGuiThread([ugc, callback] { callback(ugc); });
 }
 
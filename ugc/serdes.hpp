@@ -167,26 +167,50 @@ private:
   Source & m_source;
 };
 
-template <typename Sink>
-void Serialize(Sink & sink, UGC const & ugc)
+template <typename Sink, typename T>
+void SerializeVersioned(Sink & sink, T const & t)
 {
   WriteToSink(sink, static_cast<uint8_t>(Version::Latest));
   Serializer<Sink> ser(sink);
-  ser(ugc);
+  ser(t);
 }
 
-template <typename Source>
-void Deserialize(Source & source, UGC & ugc)
+template <typename Source, typename T>
+void DeserializeVersioned(Source & source, T & t)
 {
   uint8_t version = 0;
   ReadPrimitiveFromSource(source, version);
   if (version == static_cast<uint8_t>(Version::V0))
   {
     DeserializerV0<Source> des(source);
-    des(ugc);
+    des(t);
     return;
   }
 
   MYTHROW(BadBlob, ("Unknown data version:", static_cast<int>(version)));
 }
+
+template <typename Sink>
+void Serialize(Sink & sink, UGC const & ugc)
+{
+  SerializeVersioned(sink, ugc);
+}
+
+template <typename Source>
+void Deserialize(Source & source, UGC & ugc)
+{
+  DeserializeVersioned(source, ugc);
+}
+
+template <typename Sink>
+void Serialize(Sink & sink, UGCUpdate const & ugc)
+{
+  SerializeVersioned(sink, ugc);
+}
+
+template <typename Source>
+void Deserialize(Source & source, UGCUpdate & ugc)
+{
+  DeserializeVersioned(source, ugc);
+}
 }  // namespace ugc
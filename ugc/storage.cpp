@@ -1,33 +1,247 @@
 #include "ugc/storage.hpp"
 
+#include "ugc/serdes.hpp"
+
 #include "indexer/feature_decl.hpp"
 
+#include "platform/platform.hpp"
+
+#include "coding/file_reader.hpp"
+#include "coding/file_writer.hpp"
+#include "coding/internal/file_data.hpp"
+#include "coding/reader.hpp"
+#include "coding/varint.hpp"
+#include "coding/writer.hpp"
+
+#include "base/logging.hpp"
+
+#include <algorithm>
+#include <vector>
+
+using namespace std;
+
 namespace ugc
 {
-Storage::Storage(std::string const & filename)
-  : m_filename(filename)
+namespace
 {
-  Load();
+// Compaction doesn't start until there are at least so many obsolete records.
+size_t const kMinObsoleteRecordsToCompact = 100;
+
+// Record of the file: varuint size of the body and the body. The body is the country name,
+// the mwm version, the feature index and the serialized update.
+template <typename Sink>
+void WriteRecord(Sink & sink, string const & countryName, int64_t version, uint32_t index,
+                 vector<uint8_t> const & update)
+{
+  vector<uint8_t> body;
+  {
+    MemWriter<vector<uint8_t>> writer(body);
+    rw::Write(writer, countryName);
+    WriteVarInt(writer, version);
+    WriteVarUint(writer, index);
+  }
+  body.insert(body.end(), update.begin(), update.end());
+
+  WriteVarUint(sink, static_cast<uint32_t>(body.size()));
+  sink.Write(body.data(), body.size());
 }
+}  // namespace
 
-UGCUpdate const * Storage::GetUGCUpdate(FeatureID const & id) const
+Storage::Storage(string const & filename) : m_filename(filename) {}
+
+bool Storage::GetUGCUpdate(FeatureID const & id, UGCUpdate & ugc) const
 {
-  auto const it = m_ugc.find(id);
-  if (it != end(m_ugc))
-    return &it->second;
-  return nullptr;
+  Key key;
+  if (!MakeKey(id, key))
+    return false;
+
+  auto const it = m_index.find(key);
+  if (it == m_index.cend())
+    return false;
+  return ReadUpdate(it->second, ugc);
 }
 
 void Storage::SetUGCUpdate(FeatureID const & id, UGCUpdate const & ugc)
 {
-  m_ugc[id] = ugc;
+  Key key;
+  if (!MakeKey(id, key))
+  {
+    LOG(LWARNING, ("Can't save ugc update of", id));
+    return;
+  }
+
+  vector<uint8_t> update;
+  {
+    MemWriter<vector<uint8_t>> writer(update);
+    Serialize(writer, ugc);
+  }
+
+  try
+  {
+    FileWriter writer(m_filename, FileWriter::OP_APPEND);
+    uint64_t const recordOffset = writer.Pos();
+    WriteRecord(writer, key.m_countryName, key.m_version, key.m_index, update);
+    uint64_t const end = writer.Pos();
+
+    Record record;
+    record.m_size = static_cast<uint32_t>(update.size());
+    record.m_offset = end - record.m_size;
+    ASSERT_GREATER(record.m_offset, recordOffset, ());
+
+    auto const res = m_index.emplace(key, record);
+    if (!res.second)
+    {
+      res.first->second = record;
+      ++m_obsoleteRecords;
+    }
+  }
+  catch (RootException const & e)
+  {
+    LOG(LWARNING, ("Can't write ugc update to", m_filename, e.Msg()));
+    return;
+  }
+
+  if (NeedsCompaction())
+    Compact();
 }
 
 void Storage::Load()
 {
+  m_index.clear();
+  m_obsoleteRecords = 0;
+
+  if (!GetPlatform().IsFileExistsByFullPath(m_filename))
+    return;
+
+  uint64_t validSize = 0;
+  uint64_t fileSize = 0;
+  try
+  {
+    FileReader reader(m_filename);
+    ReaderSource<FileReader> src(reader);
+    fileSize = reader.Size();
+    while (src.Size() > 0)
+    {
+      auto const bodySize = ReadVarUint<uint32_t>(src);
+      uint64_t const bodyOffset = src.Pos();
+      if (bodySize > src.Size())
+        break;
+
+      Key key;
+      rw::Read(src, key.m_countryName);
+      key.m_version = ReadVarInt<int64_t>(src);
+      key.m_index = ReadVarUint<uint32_t>(src);
+
+      uint64_t const headerSize = src.Pos() - bodyOffset;
+      if (headerSize > bodySize)
+        break;
+
+      Record record;
+      record.m_offset = src.Pos();
+      record.m_size = static_cast<uint32_t>(bodySize - headerSize);
+      src.Skip(record.m_size);
+
+      auto const res = m_index.emplace(key, record);
+      if (!res.second)
+      {
+        res.first->second = record;
+        ++m_obsoleteRecords;
+      }
+      validSize = src.Pos();
+    }
+  }
+  catch (RootException const & e)
+  {
+    LOG(LWARNING, ("Can't read ugc updates from", m_filename, e.Msg()));
+  }
+
+  // A tail which is written partially is dropped.
+  if (validSize != fileSize)
+  {
+    LOG(LWARNING, ("Ugc updates file", m_filename, "is truncated from", fileSize, "to", validSize));
+    Compact();
+  }
 }
 
 void Storage::Save()
 {
+  if (NeedsCompaction())
+    Compact();
+}
+
+// static
+bool Storage::MakeKey(FeatureID const & id, Key & key)
+{
+  if (!id.IsValid())
+    return false;
+
+  auto const info = id.m_mwmId.GetInfo();
+  if (!info)
+    return false;
+
+  key = Key(info->GetCountryName(), info->GetVersion(), id.m_index);
+  return true;
+}
+
+bool Storage::ReadUpdate(Record const & record, UGCUpdate & ugc) const
+{
+  try
+  {
+    FileReader reader(m_filename);
+    ReaderSource<FileReader> src(reader.SubReader(record.m_offset, record.m_size));
+    Deserialize(src, ugc);
+    return true;
+  }
+  catch (RootException const & e)
+  {
+    LOG(LWARNING, ("Can't read ugc update from", m_filename, e.Msg()));
+  }
+  return false;
+}
+
+bool Storage::NeedsCompaction() const
+{
+  return m_obsoleteRecords >= max(kMinObsoleteRecordsToCompact, m_index.size());
+}
+
+void Storage::Compact()
+{
+  string const tmpFilename = m_filename + ".tmp";
+  map<Key, Record> index;
+  try
+  {
+    FileReader reader(m_filename);
+    FileWriter writer(tmpFilename);
+    vector<uint8_t> update;
+    for (auto const & kv : m_index)
+    {
+      Record const & old = kv.second;
+      update.resize(old.m_size);
+      reader.Read(old.m_offset, update.data(), update.size());
+
+      WriteRecord(writer, kv.first.m_countryName, kv.first.m_version, kv.first.m_index, update);
+
+      Record record;
+      record.m_size = old.m_size;
+      record.m_offset = writer.Pos() - record.m_size;
+      index.emplace(kv.first, record);
+    }
+  }
+  catch (RootException const & e)
+  {
+    LOG(LWARNING, ("Can't compact ugc updates file", m_filename, e.Msg()));
+    my::DeleteFileX(tmpFilename);
+    return;
+  }
+
+  if (!my::RenameFileX(tmpFilename, m_filename))
+  {
+    LOG(LWARNING, ("Can't rename", tmpFilename, "to", m_filename));
+    my::DeleteFileX(tmpFilename);
+    return;
+  }
+
+  m_index.swap(index);
+  m_obsoleteRecords = 0;
 }
 }  // namespace ugc
@@ -2,26 +2,76 @@
 
 #include "ugc/types.hpp"
 
+#include <cstddef>
+#include <cstdint>
 #include <map>
 #include <string>
+#include <tuple>
 
 struct FeatureID;
 
 namespace ugc
 {
+// Storage of ugc updates made by the user. Updates are kept in an append-only binary file:
+// every SetUGCUpdate() appends a record and an update replaces an older one of the same feature.
+// Only an index of offsets is kept in memory, updates are read from the file on demand. The file
+// is rewritten by live records when obsolete records prevail.
+//
+// *NOTE* This class is not thread-safe.
 class Storage
 {
 public:
   explicit Storage(std::string const & filename);
 
-  UGCUpdate const * GetUGCUpdate(FeatureID const & id) const;
+  // Returns false when there is no update for |id|.
+  bool GetUGCUpdate(FeatureID const & id, UGCUpdate & ugc) const;
   void SetUGCUpdate(FeatureID const & id, UGCUpdate const & ugc);
 
-  void Save();
+  // Reads the index of records. Doesn't read updates.
   void Load();
+  // Compacts the file when it's needed.
+  void Save();
+
+  size_t GetNumUpdates() const { return m_index.size(); }
+  size_t GetNumObsoleteRecords() const { return m_obsoleteRecords; }
 
 private:
-  std::string m_filename;
-  std::map<FeatureID, UGCUpdate> m_ugc;
+  struct Key
+  {
+    Key() = default;
+    Key(std::string const & countryName, int64_t version, uint32_t index)
+      : m_countryName(countryName), m_version(version), m_index(index)
+    {
+    }
+
+    bool operator<(Key const & rhs) const
+    {
+      return std::tie(m_countryName, m_version, m_index) <
+             std::tie(rhs.m_countryName, rhs.m_version, rhs.m_index);
+    }
+
+    std::string m_countryName;
+    int64_t m_version = 0;
+    uint32_t m_index = 0;
+  };
+
+  // Position of a serialized update in the file.
+  struct Record
+  {
+    uint64_t m_offset = 0;
+    uint32_t m_size = 0;
+  };
+
+  static bool MakeKey(FeatureID const & id, Key & key);
+
+  bool ReadUpdate(Record const & record, UGCUpdate & ugc) const;
+  bool NeedsCompaction() const;
+  // Rewrites the file by live records only.
+  void Compact();
+
+  std::string const m_filename;
+  std::map<Key, Record> m_index;
+  // Number of records in the file which are replaced by newer ones.
+  size_t m_obsoleteRecords = 0;
 };
 }  // namespace ugc
@@ -308,6 +308,21 @@ struct ReviewFeedback
   {
   }
 
+  DECLARE_VISITOR(visitor(m_sentiment, "sentiment"), visitor(m_time, "time"))
+
+  bool operator==(ReviewFeedback const & rhs) const
+  {
+    return m_sentiment == rhs.m_sentiment && m_time == rhs.m_time;
+  }
+
+  friend std::string DebugPrint(ReviewFeedback const & feedback)
+  {
+    std::ostringstream os;
+    os << "ReviewFeedback [ sentiment:" << DebugPrint(feedback.m_sentiment)
+       << ", days since epoch:" << ToDaysSinceEpoch(feedback.m_time) << " ]";
+    return os.str();
+  }
+
   Sentiment m_sentiment{};
   Time m_time{};
 };
@@ -317,6 +332,21 @@ struct ReviewAbuse
   ReviewAbuse() = default;
   ReviewAbuse(std::string const & reason, Time const & time) : m_reason(reason), m_time(time) {}
 
+  DECLARE_VISITOR(visitor(m_reason, "reason"), visitor(m_time, "time"))
+
+  bool operator==(ReviewAbuse const & rhs) const
+  {
+    return m_reason == rhs.m_reason && m_time == rhs.m_time;
+  }
+
+  friend std::string DebugPrint(ReviewAbuse const & abuse)
+  {
+    std::ostringstream os;
+    os << "ReviewAbuse [ reason:" << abuse.m_reason
+       << ", days since epoch:" << ToDaysSinceEpoch(abuse.m_time) << " ]";
+    return os.str();
+  }
+
   std::string m_reason{};
   Time m_time{};
 };
@@ -329,6 +359,26 @@ struct UGCUpdate
   {
   }
 
+  DECLARE_VISITOR(visitor(m_ratings, "ratings"), visitor(m_attribute, "attribute"),
+                  visitor(m_abuses, "abuses"), visitor(m_feedbacks, "feedbacks"))
+
+  bool operator==(UGCUpdate const & rhs) const
+  {
+    return m_ratings == rhs.m_ratings && m_attribute == rhs.m_attribute &&
+           m_abuses == rhs.m_abuses && m_feedbacks == rhs.m_feedbacks;
+  }
+
+  friend std::string DebugPrint(UGCUpdate const & ugcUpdate)
+  {
+    std::ostringstream os;
+    os << "UGCUpdate [ ";
+    os << "ratings:" << DebugPrint(ugcUpdate.m_ratings) << ", ";
+    os << "attribute:" << DebugPrint(ugcUpdate.m_attribute) << ", ";
+    os << "abuses:" << DebugPrint(ugcUpdate.m_abuses) << ", ";
+    os << "feedbacks:" << DebugPrint(ugcUpdate.m_feedbacks) << " ]";
+    return os.str();
+  }
+
   Rating m_ratings;
   Attribute m_attribute;
 
@@ -0,0 +1,158 @@
+#include "testing/testing.hpp"
+
+#include "ugc/storage.hpp"
+#include "ugc/types.hpp"
+
+#include "indexer/feature_decl.hpp"
+#include "indexer/mwm_set.hpp"
+
+#include "platform/local_country_file.hpp"
+#include "platform/platform.hpp"
+
+#include "coding/file_name_utils.hpp"
+#include "coding/file_writer.hpp"
+#include "coding/internal/file_data.hpp"
+
+#include "base/scope_guard.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+
+using namespace std;
+using namespace ugc;
+
+namespace
+{
+string const kTestFileName = "ugc_storage_test.bin";
+
+class TestMwmSet : public MwmSet
+{
+protected:
+  // MwmSet overrides:
+  unique_ptr<MwmInfo> CreateInfo(platform::LocalCountryFile const & localFile) const override
+  {
+    unique_ptr<MwmInfo> info(new MwmInfo());
+    info->m_version.SetFormat(version::Format::lastFormat);
+    return info;
+  }
+
+  unique_ptr<MwmValueBase> CreateValue(MwmInfo &) const override
+  {
+    return make_unique<MwmValueBase>();
+  }
+};
+
+UGCUpdate MakeTestUpdate(float value, string const & reason)
+{
+  Rating rating;
+  rating.m_ratings.emplace_back("food" /* key */, value);
+  rating.m_aggValue = value;
+  // Time must be in whole days to prevent lose of precision during serialization.
+  Time const time(chrono::hours(24 * 100));
+  return UGCUpdate(rating, Attribute("best-drink", "Coffee"), ReviewAbuse(reason, time),
+                   ReviewFeedback(Sentiment::Positive, time));
+}
+}  // namespace
+
+UNIT_TEST(UGCStorage_Smoke)
+{
+  string const path = my::JoinFoldersToPath(GetPlatform().WritableDir(), kTestFileName);
+  my::DeleteFileX(path);
+  MY_SCOPE_GUARD(deleter, bind(&FileWriter::DeleteFileX, path));
+
+  TestMwmSet mwmSet;
+  auto const r = mwmSet.Register(platform::LocalCountryFile::MakeForTesting("ugc_storage_test"));
+  TEST_EQUAL(r.second, MwmSet::RegResult::Success, ());
+  FeatureID const id1(r.first, 1 /* index */);
+  FeatureID const id2(r.first, 2 /* index */);
+
+  auto const update1 = MakeTestUpdate(4.0, "spam");
+  auto const update2 = MakeTestUpdate(5.0, "offensive");
+  auto const update3 = MakeTestUpdate(3.0, "fake");
+
+  {
+    Storage storage(path);
+    storage.Load();
+
+    UGCUpdate ugc;
+    TEST(!storage.GetUGCUpdate(id1, ugc), ());
+    TEST(!storage.GetUGCUpdate(FeatureID(), ugc), ());
+
+    storage.SetUGCUpdate(id1, update1);
+    storage.SetUGCUpdate(id2, update2);
+    storage.SetUGCUpdate(id1, update3);
+    TEST_EQUAL(storage.GetNumUpdates(), 2, ());
+    TEST_EQUAL(storage.GetNumObsoleteRecords(), 1, ());
+
+    TEST(storage.GetUGCUpdate(id1, ugc), ());
+    TEST_EQUAL(ugc, update3, ());
+    storage.Save();
+  }
+
+  {
+    Storage storage(path);
+    storage.Load();
+    TEST_EQUAL(storage.GetNumUpdates(), 2, ());
+    TEST_EQUAL(storage.GetNumObsoleteRecords(), 1, ());
+
+    UGCUpdate ugc;
+    TEST(storage.GetUGCUpdate(id1, ugc), ());
+    TEST_EQUAL(ugc, update3, ());
+    TEST(storage.GetUGCUpdate(id2, ugc), ());
+    TEST_EQUAL(ugc, update2, ());
+  }
+
+  // A partially written record is dropped.
+  {
+    FileWriter writer(path, FileWriter::OP_APPEND);
+    uint8_t const tail[] = {100, 1, 2};
+    writer.Write(tail, sizeof(tail));
+  }
+  {
+    Storage storage(path);
+    storage.Load();
+    TEST_EQUAL(storage.GetNumUpdates(), 2, ());
+    TEST_EQUAL(storage.GetNumObsoleteRecords(), 0, ());
+
+    UGCUpdate ugc;
+    TEST(storage.GetUGCUpdate(id2, ugc), ());
+    TEST_EQUAL(ugc, update2, ());
+  }
+}
+
+UNIT_TEST(UGCStorage_Compaction)
+{
+  string const path = my::JoinFoldersToPath(GetPlatform().WritableDir(), kTestFileName);
+  my::DeleteFileX(path);
+  MY_SCOPE_GUARD(deleter, bind(&FileWriter::DeleteFileX, path));
+
+  TestMwmSet mwmSet;
+  auto const r = mwmSet.Register(platform::LocalCountryFile::MakeForTesting("ugc_storage_test"));
+  FeatureID const id(r.first, 7 /* index */);
+
+  auto const update = MakeTestUpdate(4.0, "spam");
+  uint64_t sizeAfterFirst = 0;
+  {
+    Storage storage(path);
+    storage.Load();
+    storage.SetUGCUpdate(id, update);
+    TEST(my::GetFileSize(path, sizeAfterFirst), ());
+
+    for (size_t i = 0; i < 1000; ++i)
+      storage.SetUGCUpdate(id, update);
+    TEST_LESS(storage.GetNumObsoleteRecords(), 1000, ());
+  }
+
+  uint64_t size = 0;
+  TEST(my::GetFileSize(path, size), ());
+  TEST_LESS(size, sizeAfterFirst * 200, ());
+
+  Storage storage(path);
+  storage.Load();
+  UGCUpdate ugc;
+  TEST(storage.GetUGCUpdate(id, ugc), ());
+  TEST_EQUAL(ugc, update, ());
+}
@@ -22,3 +22,4 @@ SOURCES += \
   ../../testing/testingmain.cpp \
   serdes_binary_tests.cpp \
   serdes_tests.cpp \
+  storage_tests.cpp \